@@ -59,12 +59,12 @@ public class TensorFieldProcessor extends Processor {
 
     private boolean isTensorTypeThatSupportsDirectStore(ImmutableSDField field) {
         var type = ((TensorDataType)field.getDataType()).getTensorType();
-        // Tensors with only sparse dimensions can be "direct"
+        // Tensors with at least one sparse dimension (sparse or mixed) can be "direct"
         // (currenty triggered by fast-search flag)
         for (var dim : type.dimensions()) {
-            if (dim.isIndexed()) return false;
+            if ( ! dim.isIndexed()) return true;
         }
-        return true;
+        return false;
     }
 
     private String tensorTypeToString(ImmutableSDField field) {
@@ -54,6 +54,12 @@ public class TensorFieldTestCase {
         }
     }
 
+    @Test
+    public void requireThatSparseAndMixedTensorAttributesCanBeFastSearch() throws ParseException {
+        createFromString(getSd("field f1 type tensor(x{}) { indexing: attribute \n attribute: fast-search }"));
+        createFromString(getSd("field f1 type tensor(x{},y[3]) { indexing: attribute \n attribute: fast-search }"));
+    }
+
     @Test
     public void requireThatIllegalTensorTypeSpecThrowsException() throws ParseException {
         try {
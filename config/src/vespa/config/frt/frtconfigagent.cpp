@@ -47,23 +47,26 @@ FRTConfigAgent::handleOKResponse(const ConfigRequest & request, ConfigResponse::
 
     ConfigState newState = response->getConfigState();
     if ( ! request.verifyState(newState)) {
-        handleUpdatedGeneration(response->getKey(), newState, response->getValue());
+        handleUpdatedGeneration(response->getKey(), newState, *response);
     }
     setWaitTime(_timingValues.successDelay, 1);
     _nextTimeout = _timingValues.successTimeout;
 }
 
 void
-FRTConfigAgent::handleUpdatedGeneration(const ConfigKey & key, const ConfigState & newState, const ConfigValue & configValue)
+FRTConfigAgent::handleUpdatedGeneration(const ConfigKey & key, const ConfigState & newState, const ConfigResponse & response)
 {
     if (LOG_WOULD_LOG(spam)) {
         LOG(spam, "new generation %" PRId64 " md5:%s for key %s", newState.generation, newState.md5.c_str(), key.toString().c_str());
-        LOG(spam, "Old config: md5:%s \n%s", _latest.getMd5().c_str(), _latest.asJson().c_str());
-        LOG(spam, "New config: md5:%s \n%s", configValue.getMd5().c_str(), configValue.asJson().c_str());
     }
+    // The payload is only decoded when its checksum differs from the one we have
     bool changed = false;
-    if (_latest.getMd5() != configValue.getMd5()) {
-        _latest = configValue;
+    if (_latest.getMd5() != newState.md5) {
+        if (LOG_WOULD_LOG(spam)) {
+            LOG(spam, "Old config: md5:%s \n%s", _latest.getMd5().c_str(), _latest.asJson().c_str());
+            LOG(spam, "New config: md5:%s \n%s", response.getValue().getMd5().c_str(), response.getValue().asJson().c_str());
+        }
+        _latest = response.getValue();
         changed = true;
     }
     _configState = newState;
@@ -17,6 +17,8 @@ SlimeConfigResponse::SlimeConfigResponse(FRT_RPCRequest * request)
     : FRTConfigResponse(request),
       _key(),
       _value(),
+      _valueRead(false),
+      _state(),
       _trace(),
       _filled(false)
 {
@@ -37,7 +39,6 @@ SlimeConfigResponse::fill()
     _data = std::move(data);
     _key = readKey();
     _state = readState();
-    _value = readConfigValue();
     readTrace();
     _filled = true;
     if (LOG_WOULD_LOG(debug)) {
@@ -45,6 +46,18 @@ SlimeConfigResponse::fill()
     }
 }
 
+const ConfigValue &
+SlimeConfigResponse::getValue() const
+{
+    // Decompressing and parsing the payload is deferred until the value is
+    // needed, since most responses carry a config we already have.
+    if (!_valueRead) {
+        _value = readConfigValue();
+        _valueRead = true;
+    }
+    return _value;
+}
+
 void
 SlimeConfigResponse::readTrace()
 {
@@ -25,7 +25,7 @@ public:
     ~SlimeConfigResponse() override;
 
     const ConfigKey & getKey() const override { return _key; }
-    const ConfigValue & getValue() const override { return _value; }
+    const ConfigValue & getValue() const override;
     const ConfigState & getConfigState() const override { return _state; }
     const Trace & getTrace() const override { return _trace; }
 
@@ -39,7 +39,8 @@ protected:
 
 private:
     ConfigKey _key;
-    ConfigValue _value;
+    mutable ConfigValue _value;
+    mutable bool _valueRead;
     ConfigState _state;
     Trace _trace;
     bool _filled;
@@ -606,6 +606,23 @@ TEST_F(DocumentSelectParserTest, regex_matching_is_not_susceptible_to_catastroph
     PARSE(R"(testdoctype1.hstringval =~ ".*")", *doc, True);
 }
 
+TEST_F(DocumentSelectParserTest, constant_operands_are_evaluated_once_but_documents_are_not) {
+    createDocs();
+    for (const char *expr : {"testdoctype1.content = \"b*r\"",
+                             "testdoctype1.content =~ \"^b.r$\"",
+                             "testdoctype1.headerval == 20 + 2 * 2",
+                             "\"BAR\".lowercase() == testdoctype1.content"})
+    {
+        std::unique_ptr<select::Node> root(_parser->parse(expr));
+        EXPECT_EQ(select::ResultList(select::Result::True), root->contains(*_doc[0])) << expr;
+        EXPECT_EQ(select::ResultList(select::Result::False), root->contains(*_doc[1])) << expr;
+        EXPECT_EQ(select::ResultList(select::Result::True), root->contains(*_doc[0])) << expr;
+    }
+    // Glob and regex on non-string field values are still handled by the operators.
+    PARSE("testdoctype1.headerval = \"2*\"", *_doc[0], Invalid);
+    PARSE("testdoctype1.headerval =~ \"^2\"", *_doc[0], Invalid);
+}
+
 TEST_F(DocumentSelectParserTest, operators_1)
 {
     createDocs();
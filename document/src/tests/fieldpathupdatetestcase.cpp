@@ -1041,6 +1041,29 @@ TEST_F(FieldPathUpdateTestCase, testSerializeAssignMath)
     testSerialize(*_repo, docUp);
 }
 
+TEST_F(FieldPathUpdateTestCase, deserialized_update_can_be_applied_to_many_documents)
+{
+    DocumentUpdate docUp(*_repo, _foobar_type, DocumentId("id:ns:foobar::barbar:foofoo"));
+    docUp.addFieldPathUpdate(FieldPathUpdate::CP(new AssignFieldPathUpdate("num", "foobar.num > 10", "$value * 2")));
+    auto stream = serializeHEAD(docUp);
+    DocumentUpdate::UP deserialized(DocumentUpdate::createHEAD(*_repo, stream));
+
+    // Documents of the repo's own type, which the update was resolved against.
+    const DocumentType &type = *_repo->getDocumentType("foobar");
+    Document big(type, DocumentId("id:ns:foobar::barbar:foofoo"));
+    big.setRepo(*_repo);
+    big.setValue("num", IntFieldValue(34));
+    Document small(type, DocumentId("id:ns:foobar::barbar:foofoo"));
+    small.setRepo(*_repo);
+    small.setValue("num", IntFieldValue(3));
+    for (int i = 0; i < 2; ++i) {
+        deserialized->applyTo(big);
+        deserialized->applyTo(small);
+    }
+    EXPECT_EQ(136, big.getValue("num")->getAsInt());
+    EXPECT_EQ(3, small.getValue("num")->getAsInt());
+}
+
 DocumentUpdate::UP
 FieldPathUpdateTestCase::createDocumentUpdateForSerialization(const DocumentTypeRepo& repo)
 {
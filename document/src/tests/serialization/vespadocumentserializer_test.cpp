@@ -40,6 +40,7 @@
 #include <vespa/eval/tensor/default_tensor_engine.h>
 #include <vespa/vespalib/io/fileutil.h>
 #include <vespa/vespalib/objects/nbostream.h>
+#include <vespa/vespalib/util/stringfmt.h>
 #include <vespa/vespalib/testkit/testapp.h>
 #include <vespa/document/base/exceptions.h>
 
@@ -422,6 +423,31 @@ TEST("requireThatWeightedSetFieldValueCanBeSerialized") {
     EXPECT_EQUAL(3u, weight);
 }
 
+TEST("requireThatDeserializedWeightedSetCanBeLookedUpAndModified") {
+    WeightedSetDataType ws_type(*DataType::STRING, false, false);
+    WeightedSetFieldValue value(ws_type);
+    for (int i = 0; i < 100; ++i) {
+        value.add(vespalib::make_string("key%d", i), i - 50);
+    }
+    nbostream stream;
+    VespaDocumentSerializer serializer(stream);
+    serializer.write(value);
+
+    WeightedSetFieldValue read_value(ws_type);
+    read_value.add("stale", 7);
+    VespaDocumentDeserializer deserializer(repo, stream, serialization_version);
+    deserializer.read(read_value);
+    EXPECT_EQUAL(0u, stream.size());
+    EXPECT_EQUAL(value, read_value);
+    EXPECT_EQUAL(100u, read_value.size());
+    EXPECT_FALSE(read_value.containsValue(StringFieldValue("stale")));
+    EXPECT_EQUAL(-50, read_value.get(StringFieldValue("key0")));
+    EXPECT_EQUAL(49, read_value.get(StringFieldValue("key99")));
+    read_value.increment(StringFieldValue("key99"), 1);
+    EXPECT_EQUAL(50, read_value.get(StringFieldValue("key99")));
+    EXPECT_EQUAL(100u, read_value.size());
+}
+
 const Field field1("field1", *DataType::INT);
 const Field field2("field2", *DataType::STRING);
 
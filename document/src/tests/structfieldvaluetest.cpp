@@ -9,6 +9,7 @@
 #include <vespa/document/util/bytebuffer.h>
 #include <gtest/gtest.h>
 #include <gmock/gmock.h>
+#include <algorithm>
 
 using vespalib::nbostream;
 using document::config_builder::Struct;
@@ -189,5 +190,45 @@ TEST_F(StructFieldValueTest, testStruct)
     }
 }
 
-} // document
+TEST_F(StructFieldValueTest, fields_are_found_regardless_of_insertion_order)
+{
+    FixedTypeRepo repo(doc_repo, *doc_repo.getDocumentType(42));
+    const DataType &type = *repo.getDataType("test.header");
+    StructFieldValue value(type);
+    const Field &intF = value.getField("int");
+    const Field &longF = value.getField("long");
+    const Field &strF = value.getField("content");
+
+    // Field ids are hashed from names, so insert in both id orders.
+    std::vector<const Field *> fields({&intF, &longF, &strF});
+    std::sort(fields.begin(), fields.end(), [](auto a, auto b) { return a->getId() > b->getId(); });
+    for (auto order : {fields, std::vector<const Field *>(fields.rbegin(), fields.rend())}) {
+        StructFieldValue v(type);
+        for (const Field *f : order) {
+            if (f == &intF) {
+                v.setValue(*f, IntFieldValue(1));
+            } else if (f == &longF) {
+                v.setValue(*f, LongFieldValue(2));
+            } else {
+                v.setValue(*f, StringFieldValue("foo"));
+            }
+        }
+        v.setValue(intF, IntFieldValue(7));
+        EXPECT_EQ(7, v.getValue(intF)->getAsInt());
+        EXPECT_EQ(2, v.getValue(longF)->getAsInt());
+        EXPECT_EQ(vespalib::string("foo"), v.getValue(strF)->getAsString());
+
+        nbostream buffer(v.serialize());
+        StructFieldValue v2(type);
+        deserialize(buffer, v2, repo);
+        EXPECT_EQ(v, v2);
+        EXPECT_EQ(7, v2.getValue(intF)->getAsInt());
+        v2.remove(longF);
+        EXPECT_FALSE(v2.hasValue(longF));
+        EXPECT_TRUE(v2.hasValue(intF));
+        EXPECT_TRUE(v2.hasValue(strF));
+        EXPECT_EQ(vespalib::string("foo"), v2.getValue(strF)->getAsString());
+    }
+}
 
+} // document
@@ -31,6 +31,7 @@ SerializableArray::set(EntryMap entries, ByteBuffer buffer,
                        CompressionConfig::Type comp_type, uint32_t uncompressed_length)
 {
     _entries = std::move(entries);
+    _sorted = std::is_sorted(_entries.begin(), _entries.end());
     if (CompressionConfig::isCompressed(comp_type)) {
         _unlikely = std::make_unique<RarelyUsedBuffers>();
         _unlikely->_compSerData = std::move(buffer);
@@ -77,6 +78,7 @@ SerializableArray::RarelyUsedBuffers::RarelyUsedBuffers(const RarelyUsedBuffers
 
 SerializableArray::SerializableArray(const SerializableArray& rhs)
     : _entries(rhs._entries),
+      _sorted(rhs._sorted),
       _uncompSerData(rhs._uncompSerData),
       _unlikely(rhs._unlikely ? new RarelyUsedBuffers(*rhs._unlikely) : nullptr)
 {
@@ -105,6 +107,7 @@ SerializableArray::operator=(const SerializableArray &rhs)
 void SerializableArray::clear()
 {
     _entries.clear();
+    _sorted = true;
     _uncompSerData = ByteBuffer(nullptr, 0);
     _unlikely.reset();
 }
@@ -126,6 +129,9 @@ SerializableArray::set(int id, ByteBuffer buffer)
     ensure(ensure(_unlikely)._owned)[id] = std::move(buffer);
     auto it = find(id);
     if (it == _entries.end()) {
+        if (_sorted && !_entries.empty() && (id < _entries.back().id())) {
+            _sorted = false;
+        }
         _entries.push_back(e);
     } else {
         *it = e;
@@ -138,16 +144,31 @@ void SerializableArray::set(int id, const char* value, int len)
     set(id, ByteBuffer::copyBuffer(value,len));
 }
 
+namespace {
+
+template <typename It>
+It
+findEntry(It begin, It end, int id, bool sorted)
+{
+    if (sorted) {
+        It it = std::lower_bound(begin, end, id, [](const auto& e, int key){ return e.id() < key; });
+        return ((it != end) && (it->id() == id)) ? it : end;
+    }
+    return std::find_if(begin, end, [id](const auto& e){ return e.id() == id; });
+}
+
+}
+
 SerializableArray::EntryMap::const_iterator
 SerializableArray::find(int id) const
 {
-    return std::find_if(_entries.begin(), _entries.end(), [id](const auto& e){ return e.id() == id; });
+    return findEntry(_entries.begin(), _entries.end(), id, _sorted);
 }
 
 SerializableArray::EntryMap::iterator
 SerializableArray::find(int id)
 {
-    return std::find_if(_entries.begin(), _entries.end(), [id](const auto& e){ return e.id() == id; });
+    return findEntry(_entries.begin(), _entries.end(), id, _sorted);
 }
 
 bool
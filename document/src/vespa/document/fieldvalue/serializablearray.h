@@ -174,6 +174,12 @@ private:
     };
     /** Contains the stored attributes, with reference to the real data.. */
     EntryMap                  _entries;
+    /**
+     * Whether _entries is ordered by id, allowing binary search. The order
+     * of deserialized entries must match the layout of _uncompSerData, so
+     * entries are never reordered, only inspected.
+     */
+    bool                      _sorted = true;
     /** Data we deserialized from, if applicable. */
     ByteBuffer                _uncompSerData;
     std::unique_ptr<RarelyUsedBuffers> _unlikely;
@@ -2,15 +2,34 @@
 
 #include "compare.h"
 #include "valuenode.h"
-#include "compare.h"
+#include "context.h"
 #include "visitor.h"
 #include <vespa/document/datatype/datatype.h>
 #include <vespa/document/fieldvalue/document.h>
 #include <vespa/document/util/stringutil.h>
+#include <vespa/vespalib/regex/regex.h>
 #include <ostream>
 
 namespace document::select {
 
+namespace {
+
+// Errors (like division by zero) are left to be reported when evaluating.
+std::unique_ptr<Value>
+evaluateConstant(const ValueNode &node)
+{
+    if ( ! node.isConstant()) {
+        return {};
+    }
+    try {
+        return node.getValue(Context());
+    } catch (const std::exception &) {
+        return {};
+    }
+}
+
+}
+
 Compare::Compare(std::unique_ptr<ValueNode> left,
                  const Operator& op,
                  std::unique_ptr<ValueNode> right,
@@ -19,8 +38,29 @@ Compare::Compare(std::unique_ptr<ValueNode> left,
       _left(std::move(left)),
       _right(std::move(right)),
       _operator(op),
-      _bucketIdFactory(bucketIdFactory)
+      _bucketIdFactory(bucketIdFactory),
+      _leftConstant(),
+      _rightConstant(),
+      _regex()
 {
+    _leftConstant = evaluateConstant(*_left);
+    _rightConstant = evaluateConstant(*_right);
+    if (_rightConstant && (_rightConstant->getType() == Value::String)) {
+        const vespalib::string &pattern = static_cast<const StringValue &>(*_rightConstant).getValue();
+        vespalib::string regex;
+        if (&_operator == &GlobOperator::GLOB) {
+            regex = GlobOperator::convertToRegex(pattern);
+        } else if (&_operator == &RegexOperator::REGEX) {
+            regex = pattern;
+        }
+        // An empty pattern matches anything, which the operator handles itself.
+        if ( ! regex.empty()) {
+            auto compiled = vespalib::Regex::from_pattern(std::string_view(regex.data(), regex.size()));
+            if (compiled.parsed_ok()) {
+                _regex = std::make_unique<vespalib::Regex>(std::move(compiled));
+            }
+        }
+    }
 }
 
 Compare::~Compare() = default;
@@ -36,23 +76,19 @@ Compare::clone() const
 
 namespace {
 
-    template<typename T>
-    ResultList containsValue(const T& value, const ValueNode& l, const ValueNode& r,
-                         const Operator& op)
+    ResultList containsValue(const Value& left, const Value& right, const Operator& op)
     {
-        std::unique_ptr<Value> left(l.getValue(value));
-        std::unique_ptr<Value> right(r.getValue(value));
-        if (left->getType() == Value::Bucket
-            || right->getType() == Value::Bucket)
+        if (left.getType() == Value::Bucket
+            || right.getType() == Value::Bucket)
         {
-            Value& bVal(left->getType() == Value::Bucket ? *left : *right);
-            Value& nVal(left->getType() == Value::Bucket ? *right : *left);
+            const Value& bVal(left.getType() == Value::Bucket ? left : right);
+            const Value& nVal(left.getType() == Value::Bucket ? right : left);
             if (nVal.getType() == Value::Integer
                 && (op == FunctionOperator::EQ || op == FunctionOperator::NE
                     || op == GlobOperator::GLOB))
             {
-                document::BucketId b( static_cast<IntegerValue&>(bVal).getValue());
-                document::BucketId s( static_cast<IntegerValue&>(nVal).getValue());
+                document::BucketId b( static_cast<const IntegerValue&>(bVal).getValue());
+                document::BucketId s( static_cast<const IntegerValue&>(nVal).getValue());
 
                 ResultList resultList(Result::get(s.contains(b)));
 
@@ -64,7 +100,7 @@ namespace {
                 return ResultList(Result::Invalid);
             }
         }
-        return op.compare(*left, *right);
+        return op.compare(left, right);
     }
 
     template<typename T>
@@ -119,7 +155,15 @@ namespace {
 ResultList
 Compare::contains(const Context& context) const
 {
-    return containsValue<Context>(context, *_left, *_right, _operator);
+    std::unique_ptr<Value> leftValue;
+    std::unique_ptr<Value> rightValue;
+    const Value &left = _leftConstant ? *_leftConstant : *(leftValue = _left->getValue(context));
+    if (_regex && (left.getType() == Value::String)) {
+        const vespalib::string &str = static_cast<const StringValue &>(left).getValue();
+        return ResultList(Result::get(_regex->partial_match(std::string_view(str.data(), str.size()))));
+    }
+    const Value &right = _rightConstant ? *_rightConstant : *(rightValue = _right->getValue(context));
+    return containsValue(left, right, _operator);
 }
 
 ResultList
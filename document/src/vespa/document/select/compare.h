@@ -17,9 +17,12 @@
 #include "operator.h"
 #include <vespa/document/bucket/bucketidfactory.h>
 
+namespace vespalib { class Regex; }
+
 namespace document::select {
 
 class ValueNode;
+class Value;
 
 class Compare : public Node
 {
@@ -28,6 +31,11 @@ private:
     std::unique_ptr<ValueNode> _right;
     const Operator& _operator;
     const BucketIdFactory& _bucketIdFactory;
+    // Sides that do not depend on the context are evaluated once, and
+    // a constant regex or glob pattern is compiled once.
+    std::unique_ptr<Value> _leftConstant;
+    std::unique_ptr<Value> _rightConstant;
+    std::unique_ptr<vespalib::Regex> _regex;
 
     bool isLeafNode() const override { return false; }
 public:
@@ -45,6 +45,11 @@ public:
     virtual void visit(Visitor&) const = 0;
     virtual ValueNode::UP clone() const = 0;
     virtual std::unique_ptr<Value> traceValue(const Context &context, std::ostream &out) const;
+    /**
+     * Returns true if the value does not depend on the context it is
+     * evaluated in, so that it can be evaluated once up front.
+     */
+    virtual bool isConstant() const { return false; }
 private:
     uint32_t _max_depth;
     bool _parentheses; // Set to true if parentheses was used around this part
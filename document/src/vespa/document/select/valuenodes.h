@@ -30,6 +30,7 @@ public:
     ValueNode::UP clone() const override {
         return wrapParens(new InvalidValueNode(_name));
     }
+    bool isConstant() const override { return true; }
 };
 
 class NullValueNode : public ValueNode
@@ -48,6 +49,7 @@ public:
     ValueNode::UP clone() const override {
         return wrapParens(new NullValueNode());
     }
+    bool isConstant() const override { return true; }
 };
 
 class StringValueNode : public ValueNode
@@ -68,6 +70,7 @@ public:
     ValueNode::UP clone() const override {
         return wrapParens(new StringValueNode(_value));
     }
+    bool isConstant() const override { return true; }
 };
 
 class IntegerValueNode : public ValueNode
@@ -90,6 +93,7 @@ public:
     ValueNode::UP clone() const override {
         return wrapParens(new IntegerValueNode(_value, _isBucketValue));
     }
+    bool isConstant() const override { return true; }
 };
 
 class CurrentTimeValueNode : public ValueNode
@@ -145,6 +149,7 @@ public:
     ValueNode::UP clone() const override {
         return wrapParens(new FloatValueNode(_value));
     }
+    bool isConstant() const override { return true; }
 };
 
 class FieldValueNode : public ValueNode
@@ -300,6 +305,7 @@ public:
     ValueNode::UP clone() const override {
         return wrapParens(new FunctionValueNode(_funcname, _source->clone()));
     }
+    bool isConstant() const override { return _source->isConstant(); }
 
     const ValueNode& getChild() const { return *_source; }
 
@@ -343,6 +349,7 @@ public:
                                                   getOperatorName(),
                                                   _right->clone()));
     }
+    bool isConstant() const override { return _left->isConstant() && _right->isConstant(); }
 
     const ValueNode& getLeft() const { return *_left; }
     const ValueNode& getRight() const { return *_right; }
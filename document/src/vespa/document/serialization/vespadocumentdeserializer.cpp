@@ -344,13 +344,12 @@ void VespaDocumentDeserializer::read(WeightedSetFieldValue &value) {
     value.clear();
     readValue<uint32_t>(_stream);  // skip type id
     uint32_t size = readValue<uint32_t>(_stream);
-    value.reserve(size);
-    for (uint32_t i = 0; i < size; ++i) {
+    // Decode keys and weights in place, instead of allocating both per entry.
+    value.resize(size);
+    for (auto & pair : value) {
         readValue<uint32_t>(_stream);  // skip element size
-        FieldValue::UP child = value.createNested();
-        child->accept(*this);  // Double dispatch to call the correct read()
-        uint32_t weight = readValue<uint32_t>(_stream);
-        value.push_back(std::move(child), weight);
+        pair.first->accept(*this);  // Double dispatch to call the correct read()
+        pair.second->accept(*this);  // weight
     }
 }
 
@@ -40,9 +40,24 @@ parseDocumentSelection(vespalib::stringref query, const DocumentTypeRepo& repo)
 
 }  // namespace
 
+struct FieldPathUpdate::Resolved {
+    const DataType                &type;
+    const DocumentTypeRepo        &repo;
+    FieldPath                      path;
+    std::unique_ptr<select::Node>  whereClause;
+
+    Resolved(const DataType &type_in, const DocumentTypeRepo &repo_in)
+        : type(type_in), repo(repo_in), path(), whereClause()
+    { }
+    bool matches(const Document &doc) const {
+        return (&type == doc.getDataType()) && (&repo == doc.getRepo());
+    }
+};
+
 FieldPathUpdate::FieldPathUpdate() :
     _originalFieldPath(),
-    _originalWhereClause()
+    _originalWhereClause(),
+    _resolved()
 { }
 
 FieldPathUpdate::FieldPathUpdate(const FieldPathUpdate &) = default;
@@ -50,7 +65,8 @@ FieldPathUpdate & FieldPathUpdate::operator =(const FieldPathUpdate &) = default
 
 FieldPathUpdate::FieldPathUpdate(stringref fieldPath, stringref whereClause) :
     _originalFieldPath(fieldPath),
-    _originalWhereClause(whereClause)
+    _originalWhereClause(whereClause),
+    _resolved()
 { }
 
 FieldPathUpdate::~FieldPathUpdate() = default;
@@ -67,13 +83,21 @@ FieldPathUpdate::applyTo(Document& doc) const
 {
     std::unique_ptr<IteratorHandler> handler(getIteratorHandler(doc, *doc.getRepo()));
 
-    FieldPath path;
-    doc.getDataType()->buildFieldPath(path, _originalFieldPath);
+    const bool useResolved = _resolved && _resolved->matches(doc);
+    FieldPath builtPath;
+    if ( ! useResolved) {
+        doc.getDataType()->buildFieldPath(builtPath, _originalFieldPath);
+    }
+    const FieldPath &path = useResolved ? _resolved->path : builtPath;
     if (_originalWhereClause.empty()) {
         doc.iterateNested(path, *handler);
     } else {
-        std::unique_ptr<select::Node> whereClause = parseDocumentSelection(_originalWhereClause, *doc.getRepo());
-        select::ResultList results = whereClause->contains(doc);
+        std::unique_ptr<select::Node> parsedWhereClause;
+        if ( ! useResolved) {
+            parsedWhereClause = parseDocumentSelection(_originalWhereClause, *doc.getRepo());
+        }
+        const select::Node &whereClause = useResolved ? *_resolved->whereClause : *parsedWhereClause;
+        select::ResultList results = whereClause.contains(doc);
         for (select::ResultList::const_reverse_iterator i = results.rbegin(); i != results.rend(); ++i) {
             LOG(spam, "vars = %s", handler->getVariables().toString().c_str());
             if (*i->second == select::Result::True) {
@@ -126,10 +150,28 @@ FieldPathUpdate::getString(nbostream & stream)
 }
 
 void
-FieldPathUpdate::deserialize(const DocumentTypeRepo&, const DataType&, nbostream & stream)
+FieldPathUpdate::deserialize(const DocumentTypeRepo& repo, const DataType& type, nbostream & stream)
 {
     _originalFieldPath = getString(stream);
     _originalWhereClause = getString(stream);
+    resolve(repo, type);
+}
+
+void
+FieldPathUpdate::resolve(const DocumentTypeRepo& repo, const DataType& type)
+{
+    auto resolved = std::make_shared<Resolved>(type, repo);
+    try {
+        type.buildFieldPath(resolved->path, _originalFieldPath);
+        if ( ! _originalWhereClause.empty()) {
+            resolved->whereClause = parseDocumentSelection(_originalWhereClause, repo);
+        }
+    } catch (const vespalib::Exception &) {
+        // Leave it to applyTo() to report errors as before.
+        _resolved.reset();
+        return;
+    }
+    _resolved = std::move(resolved);
 }
 
 std::unique_ptr<FieldPathUpdate>
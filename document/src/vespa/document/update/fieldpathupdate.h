@@ -85,8 +85,17 @@ private:
     // TODO: rename to createIteratorHandler?
     virtual std::unique_ptr<fieldvalue::IteratorHandler> getIteratorHandler(Document& doc, const DocumentTypeRepo & repo) const = 0;
 
+    /**
+     * Field path and where clause resolved against the document type and
+     * repo the update was deserialized with, reused when applying the update
+     * to documents of that type. Shared between copies since it is immutable.
+     */
+    struct Resolved;
+    void resolve(const DocumentTypeRepo& repo, const DataType& type);
+
     vespalib::string _originalFieldPath;
     vespalib::string _originalWhereClause;
+    std::shared_ptr<const Resolved> _resolved;
 };
 
 }
@@ -23,8 +23,6 @@ using vespalib::tensor::Tensor;
 using vespalib::make_string;
 using vespalib::eval::ValueType;
 
-using join_fun_t = double (*)(double, double);
-
 namespace document {
 
 namespace {
@@ -35,23 +33,6 @@ replace(double, double b)
     return b;
 }
     
-join_fun_t
-getJoinFunction(TensorModifyUpdate::Operation operation)
-{
-    using Operation = TensorModifyUpdate::Operation;
-    
-    switch (operation) {
-    case Operation::REPLACE:
-        return replace;
-    case Operation::ADD:
-        return vespalib::eval::operation::Add::f;
-    case Operation::MULTIPLY:
-        return vespalib::eval::operation::Mul::f;
-    default:
-        throw IllegalArgumentException("Bad operation", VESPA_STRLOC);
-    }
-}
-
 vespalib::string
 getJoinFunctionName(TensorModifyUpdate::Operation operation)
 {
@@ -83,6 +64,21 @@ convertToCompatibleType(const TensorDataType &tensorType)
 
 IMPLEMENT_IDENTIFIABLE(TensorModifyUpdate, ValueUpdate);
 
+TensorModifyUpdate::join_fun_t
+TensorModifyUpdate::getJoinFunction(Operation operation)
+{
+    switch (operation) {
+    case Operation::REPLACE:
+        return replace;
+    case Operation::ADD:
+        return vespalib::eval::operation::Add::f;
+    case Operation::MULTIPLY:
+        return vespalib::eval::operation::Mul::f;
+    default:
+        throw IllegalArgumentException("Bad operation", VESPA_STRLOC);
+    }
+}
+
 TensorModifyUpdate::TensorModifyUpdate()
     : _operation(Operation::MAX_NUM_OPERATIONS),
       _tensorType(),
@@ -1,12 +1,15 @@
 // Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 #include <vespa/vespalib/testkit/test_kit.h>
 #include <vespa/eval/eval/llvm/compile_cache.h>
+#include <vespa/eval/eval/llvm/disk_object_cache.h>
 #include <vespa/eval/eval/key_gen.h>
 #include <vespa/eval/eval/test/eval_spec.h>
 #include <vespa/vespalib/util/time.h>
 #include <vespa/vespalib/util/threadstackexecutor.h>
 #include <vespa/vespalib/util/blockingthreadstackexecutor.h>
 #include <vespa/vespalib/util/stringfmt.h>
+#include <vespa/vespalib/io/fileutil.h>
+#include <vespa/vespalib/test/insertion_operators.h>
 #include <thread>
 #include <set>
 
@@ -160,6 +163,21 @@ TEST("require that cache usage works") {
     TEST_DO(verify_cache(0, 0));
 }
 
+TEST("require that cell loop functions are cached by loop size") {
+    auto function = Function::parse({"x", "y"}, "x+y");
+    CompileCache::Token::UP token_a = CompileCache::compile_cell_loop(*function, {2, 3});
+    CompileCache::Token::UP token_b = CompileCache::compile_cell_loop(*function, {2, 3});
+    CompileCache::Token::UP token_c = CompileCache::compile_cell_loop(*function, {3, 2});
+    CompileCache::Token::UP token_d = CompileCache::compile(*function, PassParams::ARRAY);
+    TEST_DO(verify_cache(3, 4));
+    std::vector<double> params(2, 0.0);
+    std::vector<double> cells(6, 0.0);
+    token_b->get().get_cell_loop_function()(&params[0], &cells[0]);
+    EXPECT_EQUAL(cells, std::vector<double>({0.0, 1.0, 2.0, 1.0, 2.0, 3.0}));
+    token_c->get().get_cell_loop_function()(&params[0], &cells[0]);
+    EXPECT_EQUAL(cells, std::vector<double>({0.0, 1.0, 1.0, 2.0, 2.0, 3.0}));
+}
+
 TEST("require that async cache usage works") {
     auto executor = std::make_shared<ThreadStackExecutor>(8, 256*1024);
     auto binding = CompileCache::bind(executor);
@@ -347,4 +365,64 @@ TEST_MT_FF("require that deadlock is avoided with blocking executor", 8, std::sh
 
 //-----------------------------------------------------------------------------
 
+struct DiskCacheFixture {
+    vespalib::string dir;
+    DiskCacheFixture() : dir("disk_object_cache_dir") { vespalib::rmdir(dir, true); }
+    ~DiskCacheFixture() {
+        CompileCache::set_disk_cache(std::shared_ptr<DiskObjectCache>());
+        vespalib::rmdir(dir, true);
+    }
+    std::shared_ptr<DiskObjectCache> make_cache() {
+        auto cache = std::make_shared<DiskObjectCache>(dir);
+        CompileCache::set_disk_cache(cache);
+        return cache;
+    }
+    double eval(const vespalib::string &expr) {
+        auto token = CompileCache::compile(*Function::parse(expr), PassParams::ARRAY);
+        std::vector<double> params({2.0, 3.0, 4.0});
+        return token->get().get_function()(&params[0]);
+    }
+};
+
+TEST_F("require that compiled functions are stored in the disk cache", DiskCacheFixture()) {
+    auto cache = f1.make_cache();
+    EXPECT_EQUAL(10.0, f1.eval("a*b+c"));
+    EXPECT_EQUAL(1u, cache->num_misses());
+    EXPECT_EQUAL(1u, cache->num_stored());
+    EXPECT_EQUAL(0u, cache->num_hits());
+    EXPECT_EQUAL(14.0, f1.eval("a*c+b*2"));
+    EXPECT_EQUAL(2u, cache->num_misses());
+    EXPECT_EQUAL(2u, cache->num_stored());
+    EXPECT_EQUAL(0u, cache->num_hits());
+}
+
+TEST_F("require that compiled functions are loaded from the disk cache", DiskCacheFixture()) {
+    auto first = f1.make_cache();
+    EXPECT_EQUAL(10.0, f1.eval("a*b+c"));
+    EXPECT_EQUAL(1u, first->num_stored());
+    EXPECT_EQUAL(0u, CompileCache::num_cached());
+    auto second = f1.make_cache();
+    EXPECT_EQUAL(10.0, f1.eval("a*b+c"));
+    EXPECT_EQUAL(1u, second->num_hits());
+    EXPECT_EQUAL(0u, second->num_misses());
+    EXPECT_EQUAL(0u, second->num_stored());
+}
+
+TEST_F("require that the disk cache is not used when disabled", DiskCacheFixture()) {
+    auto cache = f1.make_cache();
+    CompileCache::set_disk_cache(std::shared_ptr<DiskObjectCache>());
+    EXPECT_EQUAL(10.0, f1.eval("a*b+c"));
+    EXPECT_EQUAL(0u, cache->num_misses());
+    EXPECT_EQUAL(0u, cache->num_stored());
+}
+
+TEST("require that disk cache target id contains llvm version and host cpu") {
+    auto id = DiskObjectCache::target_id();
+    EXPECT_TRUE(id.find("llvm:") == 0);
+    EXPECT_TRUE(id.find(";cpu:") != vespalib::string::npos);
+    EXPECT_TRUE(id.find(";features:") != vespalib::string::npos);
+}
+
+//-----------------------------------------------------------------------------
+
 TEST_MAIN() { TEST_RUN_ALL(); }
@@ -46,6 +46,26 @@ TEST("require that lazy parameter passing works") {
     EXPECT_EQUAL(45.0, lazy_fun(my_resolve, &std::vector<double>({9.0, 8.0, 7.0, 6.0, 5.0, 4.0, 3.0, 2.0, 1.0, 0.0})[0]));
 }
 
+TEST("require that cell loop functions evaluate all cells") {
+    CompiledFunction cf(*Function::parse({"x", "y", "a"}, "x*10+y+a"), {3, 2});
+    auto fun = cf.get_cell_loop_function();
+    std::vector<double> params({0.0, 0.0, 0.5});
+    std::vector<double> cells(6, 0.0);
+    fun(&params[0], &cells[0]);
+    EXPECT_EQUAL(cells, std::vector<double>({0.5, 1.5, 10.5, 11.5, 20.5, 21.5}));
+}
+
+TEST("require that cell loop functions handle branches and large loops") {
+    CompiledFunction cf(*Function::parse({"x", "a"}, "if(x<a,x,a)"), {1000});
+    auto fun = cf.get_cell_loop_function();
+    std::vector<double> params({0.0, 500.0});
+    std::vector<double> cells(1000, 0.0);
+    fun(&params[0], &cells[0]);
+    for (size_t i = 0; i < cells.size(); ++i) {
+        EXPECT_EQUAL(cells[i], std::min(double(i), 500.0));
+    }
+}
+
 //-----------------------------------------------------------------------------
 
 std::vector<vespalib::string> unsupported = {
@@ -0,0 +1,87 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/eval/eval/fast_value.h>
+#include <vespa/vespalib/gtest/gtest.h>
+
+using namespace vespalib::eval;
+
+std::unique_ptr<NewValue> make_value() {
+    ValueType type = ValueType::from_spec("tensor<float>(x{},y[2],z{})");
+    FastValueBuilderFactory factory;
+    std::unique_ptr<ValueBuilder<float>> builder = factory.create_value_builder<float>(type);
+    float seq = 0.0;
+    for (vespalib::string x: {"a", "b", "c"}) {
+        for (vespalib::string z: {"aa", "bb"}) {
+            auto subspace = builder->add_subspace({x, z});
+            EXPECT_EQ(subspace.size(), 2);
+            subspace[0] = seq + 1.0;
+            subspace[1] = seq + 5.0;
+            seq += 10.0;
+        }
+        seq += 100.0;
+    }
+    return builder->build(std::move(builder));
+}
+
+TEST(FastValueTest, fast_value_can_be_built_and_inspected) {
+    auto value = make_value();
+    EXPECT_EQ(value->index().size(), 6);
+    auto cells = value->cells().typify<float>();
+    ASSERT_EQ(cells.size(), 12);
+    EXPECT_EQ(cells[4], 121.0);
+    EXPECT_EQ(cells[5], 125.0);
+}
+
+TEST(FastValueTest, full_scan_view_visits_subspaces_in_insertion_order) {
+    auto value = make_value();
+    auto view = value->index().create_view({});
+    vespalib::stringref x;
+    vespalib::stringref z;
+    size_t subspace;
+    view->lookup({});
+    std::vector<vespalib::string> seen;
+    for (size_t expect = 0; view->next_result({&x, &z}, subspace); ++expect) {
+        EXPECT_EQ(subspace, expect);
+        seen.push_back(x + ":" + z);
+    }
+    EXPECT_EQ(seen, std::vector<vespalib::string>({"a:aa", "a:bb", "b:aa", "b:bb", "c:aa", "c:bb"}));
+}
+
+TEST(FastValueTest, partial_view_finds_all_matching_subspaces) {
+    auto value = make_value();
+    auto view = value->index().create_view({1});
+    vespalib::stringref query = "bb";
+    vespalib::stringref label;
+    size_t subspace;
+    view->lookup({&query});
+    EXPECT_TRUE(view->next_result({&label}, subspace));
+    EXPECT_EQ(label, "a");
+    EXPECT_EQ(subspace, 1);
+    EXPECT_TRUE(view->next_result({&label}, subspace));
+    EXPECT_EQ(label, "b");
+    EXPECT_EQ(subspace, 3);
+    EXPECT_TRUE(view->next_result({&label}, subspace));
+    EXPECT_EQ(label, "c");
+    EXPECT_EQ(subspace, 5);
+    EXPECT_FALSE(view->next_result({&label}, subspace));
+    query = "cc";
+    view->lookup({&query});
+    EXPECT_FALSE(view->next_result({&label}, subspace));
+}
+
+TEST(FastValueTest, direct_view_finds_single_subspace) {
+    auto value = make_value();
+    auto view = value->index().create_view({0, 1});
+    vespalib::stringref x = "b";
+    vespalib::stringref z = "aa";
+    size_t subspace;
+    view->lookup({&x, &z});
+    EXPECT_TRUE(view->next_result({}, subspace));
+    EXPECT_EQ(subspace, 2);
+    EXPECT_FALSE(view->next_result({}, subspace));
+    z = "a";
+    view->lookup({&x, &z});
+    EXPECT_FALSE(view->next_result({}, subspace));
+}
+
+GTEST_MAIN_RUN_ALL_TESTS()
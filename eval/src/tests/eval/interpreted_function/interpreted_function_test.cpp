@@ -5,20 +5,40 @@
 #include <vespa/eval/eval/operation.h>
 #include <vespa/eval/eval/interpreted_function.h>
 #include <vespa/eval/eval/test/eval_spec.h>
+#include <vespa/eval/eval/test/tensor_model.hpp>
 #include <vespa/eval/eval/basic_nodes.h>
 #include <vespa/eval/eval/simple_tensor_engine.h>
 #include <vespa/eval/tensor/default_tensor_engine.h>
 #include <vespa/vespalib/util/stringfmt.h>
 #include <vespa/vespalib/util/stash.h>
 #include <vespa/vespalib/test/insertion_operators.h>
+#include <atomic>
+#include <cstdlib>
 #include <iostream>
+#include <new>
 
 using namespace vespalib::eval;
+using namespace vespalib::eval::test;
 using vespalib::Stash;
 using vespalib::tensor::DefaultTensorEngine;
 
 //-----------------------------------------------------------------------------
 
+// count all heap allocations made by this program
+std::atomic<size_t> alloc_count(0);
+
+void *operator new(size_t size) {
+    alloc_count.fetch_add(1, std::memory_order_relaxed);
+    if (void *ptr = malloc(size ? size : 1)) {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+void operator delete(void *ptr) noexcept { free(ptr); }
+void operator delete(void *ptr, size_t) noexcept { free(ptr); }
+
+//-----------------------------------------------------------------------------
+
 struct MyEvalTest : test::EvalSpec::EvalTest {
     size_t pass_cnt = 0;
     size_t fail_cnt = 0;
@@ -171,4 +191,49 @@ TEST("require that functions with non-compilable lambdas cannot be interpreted")
 
 //-----------------------------------------------------------------------------
 
+size_t count_allocs_per_eval(const vespalib::string &expr, const std::vector<TensorSpec> &param_specs) {
+    constexpr size_t num_evals = 8;
+    const auto &engine = DefaultTensorEngine::ref();
+    std::vector<vespalib::string> param_names({"a", "b"});
+    param_names.resize(param_specs.size());
+    auto function = Function::parse(param_names, expr);
+    ASSERT_TRUE(!function->has_error());
+    std::vector<ValueType> param_types;
+    std::vector<Value::UP> values;
+    SimpleObjectParams params({});
+    for (const auto &spec: param_specs) {
+        param_types.push_back(ValueType::from_spec(spec.type()));
+        values.push_back(engine.from_spec(spec));
+        params.params.push_back(*values.back());
+    }
+    NodeTypes types(*function, param_types);
+    InterpretedFunction ifun(engine, *function, types);
+    InterpretedFunction::Context ctx(ifun);
+    ifun.eval(ctx, params); // warm-up
+    size_t before = alloc_count.load(std::memory_order_relaxed);
+    for (size_t i = 0; i < num_evals; ++i) {
+        ifun.eval(ctx, params);
+    }
+    size_t after = alloc_count.load(std::memory_order_relaxed);
+    return (after - before) / num_evals;
+}
+
+TEST("require that steady-state evaluation of dense tensor expressions does not allocate heap memory") {
+    EXPECT_EQUAL(0u, count_allocs_per_eval("reduce(a*b,sum)", {spec(x(16), N()), spec(x(16), N())}));
+    EXPECT_EQUAL(0u, count_allocs_per_eval("reduce(a*b,sum,y)", {spec({x(3),y(4)}, N()), spec({y(4),z(5)}, N())}));
+    EXPECT_EQUAL(0u, count_allocs_per_eval("reduce(a*b+1,max,y)", {spec({x(3),y(64)}, N()), spec({x(3),y(64)}, N())}));
+    EXPECT_EQUAL(0u, count_allocs_per_eval("map(a,f(x)(x*x))+a", {spec(x(8), N())}));
+    EXPECT_EQUAL(0u, count_allocs_per_eval("tensor(x[10])(x+a)", {spec(0.5)}));
+    EXPECT_EQUAL(0u, count_allocs_per_eval("tensor(y[8])(a{x:1,y:(y)})", {spec({x(4),y(8)}, N())}));
+    // results larger than the default stash chunk size
+    EXPECT_EQUAL(0u, count_allocs_per_eval("a*b+a", {spec(x(4096), N()), spec(x(4096), N())}));
+    EXPECT_EQUAL(0u, count_allocs_per_eval("reduce(a,sum,x)", {spec({x(64),y(1024)}, N())}));
+}
+
+TEST("require that steady-state evaluation of scalar expressions does not allocate heap memory") {
+    EXPECT_EQUAL(0u, count_allocs_per_eval("if(a<b,a+b,a*b)", {spec(2.0), spec(3.0)}));
+}
+
+//-----------------------------------------------------------------------------
+
 TEST_MAIN() { TEST_RUN_ALL(); }
@@ -0,0 +1,89 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/eval/eval/parallel_loop.h>
+#include <vespa/vespalib/util/simple_thread_bundle.h>
+#include <vespa/vespalib/gtest/gtest.h>
+#include <algorithm>
+#include <mutex>
+
+using namespace vespalib;
+using namespace vespalib::eval;
+
+struct MyThreadBundle : ThreadBundle {
+    SimpleThreadBundle bundle;
+    size_t num_runs;
+    size_t num_targets;
+    MyThreadBundle(size_t size) : bundle(size), num_runs(0), num_targets(0) {}
+    size_t size() const override { return bundle.size(); }
+    void run(const std::vector<Runnable*> &targets) override {
+        ++num_runs;
+        num_targets = targets.size();
+        bundle.run(targets);
+    }
+};
+
+struct Ranges {
+    std::mutex lock;
+    std::vector<std::pair<size_t,size_t>> list;
+    void add(size_t begin, size_t end) {
+        std::lock_guard<std::mutex> guard(lock);
+        list.emplace_back(begin, end);
+    }
+    void verify_cover(size_t num_items) {
+        std::sort(list.begin(), list.end());
+        size_t pos = 0;
+        for (const auto &range: list) {
+            EXPECT_EQ(range.first, pos);
+            EXPECT_LT(range.first, range.second);
+            pos = range.second;
+        }
+        EXPECT_EQ(pos, num_items);
+    }
+};
+
+TEST(ParallelLoopTest, loop_is_run_by_calling_thread_without_thread_bundle) {
+    Ranges ranges;
+    parallel_loop(nullptr, 1000, min_parallel_work, [&](size_t begin, size_t end){ ranges.add(begin, end); });
+    ASSERT_EQ(ranges.list.size(), 1u);
+    ranges.verify_cover(1000);
+}
+
+TEST(ParallelLoopTest, small_loops_are_not_split) {
+    MyThreadBundle thread_bundle(4);
+    Ranges ranges;
+    parallel_loop(&thread_bundle, 1000, (min_parallel_work / 1000), [&](size_t begin, size_t end){ ranges.add(begin, end); });
+    EXPECT_EQ(thread_bundle.num_runs, 0u);
+    ASSERT_EQ(ranges.list.size(), 1u);
+    ranges.verify_cover(1000);
+}
+
+TEST(ParallelLoopTest, each_part_gets_at_least_minimal_work) {
+    MyThreadBundle thread_bundle(4);
+    Ranges ranges;
+    parallel_loop(&thread_bundle, 999, ((3 * min_parallel_work) / 999) + 1, [&](size_t begin, size_t end){ ranges.add(begin, end); });
+    EXPECT_EQ(thread_bundle.num_runs, 1u);
+    EXPECT_EQ(thread_bundle.num_targets, 3u);
+    ASSERT_EQ(ranges.list.size(), 3u);
+    ranges.verify_cover(999);
+}
+
+TEST(ParallelLoopTest, large_loops_are_split_across_all_threads) {
+    MyThreadBundle thread_bundle(4);
+    Ranges ranges;
+    parallel_loop(&thread_bundle, 1001, min_parallel_work, [&](size_t begin, size_t end){ ranges.add(begin, end); });
+    EXPECT_EQ(thread_bundle.num_runs, 1u);
+    EXPECT_EQ(thread_bundle.num_targets, 4u);
+    ASSERT_EQ(ranges.list.size(), 4u);
+    ranges.verify_cover(1001);
+}
+
+TEST(ParallelLoopTest, loops_are_not_split_into_more_parts_than_items) {
+    MyThreadBundle thread_bundle(4);
+    Ranges ranges;
+    parallel_loop(&thread_bundle, 2, 10 * min_parallel_work, [&](size_t begin, size_t end){ ranges.add(begin, end); });
+    EXPECT_EQ(thread_bundle.num_targets, 2u);
+    ASSERT_EQ(ranges.list.size(), 2u);
+    ranges.verify_cover(2);
+}
+
+GTEST_MAIN_RUN_ALL_TESTS()
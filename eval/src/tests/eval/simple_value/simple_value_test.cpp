@@ -1,12 +1,17 @@
 // Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 
 #include <vespa/eval/eval/simple_value.h>
+#include <vespa/eval/eval/fast_value.h>
 #include <vespa/eval/eval/test/tensor_model.hpp>
+#include <vespa/vespalib/util/stash.h>
+#include <vespa/vespalib/util/stringfmt.h>
 #include <vespa/vespalib/gtest/gtest.h>
 
 using namespace vespalib::eval;
 using namespace vespalib::eval::test;
 
+using vespalib::Stash;
+
 std::vector<Layout> layouts = {
     {},
     {x(3)},
@@ -28,6 +33,7 @@ TEST(SimpleValueTest, simple_values_can_be_converted_from_and_to_tensor_spec) {
         std::unique_ptr<NewValue> value = new_value_from_spec(expect, SimpleValueBuilderFactory());
         TensorSpec actual = spec_from_new_value(*value);
         EXPECT_EQ(actual, expect);
+        EXPECT_EQ(spec_from_new_value(*new_value_from_spec(expect, FastValueBuilderFactory())), expect);
     }
 }
 
@@ -62,4 +68,109 @@ TEST(SimpleValueTest, simple_value_can_be_built_and_inspected) {
     EXPECT_FALSE(view->next_result({&label}, subspace));
 }
 
+std::vector<Layout> join_layouts = {
+    {},                                                 {},
+    {x(5)},                                             {x(5)},
+    {x(5)},                                             {y(5)},
+    {x(5)},                                             {x(5),y(5)},
+    {y(3)},                                             {x(2),z(3)},
+    {x(3),y(5)},                                        {y(5),z(7)},
+    float_cells({x(3),y(5)}),                           {y(5),z(7)},
+    {x(3),y(5)},                                        float_cells({y(5),z(7)}),
+    float_cells({x(3),y(5)}),                           float_cells({y(5),z(7)}),
+    {x({"a","b","c"})},                                 {x({"a","b","c"})},
+    {x({"a","b","c"})},                                 {x({"a","b"})},
+    {x({"a","b","c"})},                                 {y({"foo","bar","baz"})},
+    {x({"a","b","c"})},                                 {x({"a","b","c"}),y({"foo","bar","baz"})},
+    {x({"a","b"}),y({"foo","bar","baz"})},              {x({"a","b","c"}),y({"foo","bar"})},
+    {x({"a","b"}),y({"foo","bar","baz"})},              {y({"foo","bar"}),z({"i","j","k","l"})},
+    float_cells({x({"a","b"}),y({"foo","bar","baz"})}), {y({"foo","bar"}),z({"i","j","k","l"})},
+    {x({"a","b"}),y({"foo","bar","baz"})},              float_cells({y({"foo","bar"}),z({"i","j","k","l"})}),
+    {x(3),y({"foo", "bar"})},                           {y({"foo", "bar"}),z(7)},
+    {x({"a","b","c"}),y(5)},                            {y(5),z({"i","j","k","l"})},
+    float_cells({x({"a","b","c"}),y(5)}),               {y(5),z({"i","j","k","l"})},
+    {x({"a","b","c"}),y(5)},                            float_cells({y(5),z({"i","j","k","l"})})
+};
+
+TensorSpec reference_join(const TensorSpec &a, const TensorSpec &b, join_fun_t function) {
+    const auto &engine = SimpleTensorEngine::ref();
+    Stash stash;
+    auto lhs = engine.from_spec(a);
+    auto rhs = engine.from_spec(b);
+    return engine.to_spec(engine.join(*lhs, *rhs, function, stash));
+}
+
+TensorSpec perform_new_join(const TensorSpec &a, const TensorSpec &b, join_fun_t function,
+                            const ValueBuilderFactory &factory)
+{
+    auto lhs = new_value_from_spec(a, factory);
+    auto rhs = new_value_from_spec(b, factory);
+    auto result = new_join(*lhs, *rhs, function, factory);
+    EXPECT_TRUE(result);
+    return spec_from_new_value(*result);
+}
+
+TEST(SimpleValueTest, new_generic_join_works_for_simple_values) {
+    ASSERT_TRUE((join_layouts.size() % 2) == 0);
+    for (size_t i = 0; i < join_layouts.size(); i += 2) {
+        TensorSpec lhs = spec(join_layouts[i], Div16(N()));
+        TensorSpec rhs = spec(join_layouts[i + 1], Div16(N()));
+        for (auto fun: {operation::Add::f, operation::Sub::f, operation::Mul::f, operation::Max::f}) {
+            SCOPED_TRACE(vespalib::make_string("\n===\nLHS: %s\nRHS: %s\n===\n", lhs.to_string().c_str(), rhs.to_string().c_str()));
+            auto expect = reference_join(lhs, rhs, fun);
+            EXPECT_EQ(perform_new_join(lhs, rhs, fun, SimpleValueBuilderFactory()), expect);
+            EXPECT_EQ(perform_new_join(lhs, rhs, fun, FastValueBuilderFactory()), expect);
+        }
+    }
+}
+
+TEST(SimpleValueTest, new_generic_join_works_across_value_implementations) {
+    TensorSpec lhs = spec({x({"a","b","c"}),y(3)}, N());
+    TensorSpec rhs = spec({x({"a","c","d"}),z({"i","j"})}, Div16(N()));
+    auto expect = reference_join(lhs, rhs, operation::Mul::f);
+    auto simple = new_value_from_spec(lhs, SimpleValueBuilderFactory());
+    auto fast = new_value_from_spec(rhs, FastValueBuilderFactory());
+    EXPECT_EQ(spec_from_new_value(*new_join(*simple, *fast, operation::Mul::f, FastValueBuilderFactory())), expect);
+    EXPECT_EQ(spec_from_new_value(*new_join(*fast, *simple, operation::Mul::f, SimpleValueBuilderFactory())),
+              reference_join(rhs, lhs, operation::Mul::f));
+}
+
+TensorSpec reference_reduce(const TensorSpec &a, Aggr aggr, const std::vector<vespalib::string> &dims) {
+    const auto &engine = SimpleTensorEngine::ref();
+    Stash stash;
+    auto lhs = engine.from_spec(a);
+    return engine.to_spec(engine.reduce(*lhs, aggr, dims, stash));
+}
+
+TensorSpec perform_new_reduce(const TensorSpec &a, Aggr aggr, const std::vector<vespalib::string> &dims,
+                              const ValueBuilderFactory &factory)
+{
+    auto lhs = new_value_from_spec(a, factory);
+    auto result = new_reduce(*lhs, aggr, dims, factory);
+    EXPECT_TRUE(result);
+    return spec_from_new_value(*result);
+}
+
+TEST(SimpleValueTest, new_generic_reduce_works_for_simple_values) {
+    for (const auto &layout: layouts) {
+        TensorSpec input = spec(layout, Div16(N()));
+        std::vector<std::vector<vespalib::string>> dim_lists = {{}};
+        for (const auto &domain: layout.domains) {
+            dim_lists.push_back({domain.dimension});
+        }
+        if (layout.domains.size() > 1) {
+            dim_lists.push_back({layout.domains.front().dimension, layout.domains.back().dimension});
+        }
+        for (Aggr aggr: {Aggr::SUM, Aggr::AVG, Aggr::COUNT, Aggr::MAX, Aggr::MIN, Aggr::PROD}) {
+            for (const auto &dims: dim_lists) {
+                SCOPED_TRACE(vespalib::make_string("\n===\nINPUT: %s\nAGGR: %s, DIMS: %zu\n===\n",
+                                                   input.to_string().c_str(), AggrNames::name_of(aggr)->c_str(), dims.size()));
+                auto expect = reference_reduce(input, aggr, dims);
+                EXPECT_EQ(perform_new_reduce(input, aggr, dims, SimpleValueBuilderFactory()), expect);
+                EXPECT_EQ(perform_new_reduce(input, aggr, dims, FastValueBuilderFactory()), expect);
+            }
+        }
+    }
+}
+
 GTEST_MAIN_RUN_ALL_TESTS()
@@ -137,6 +137,8 @@ TEST("require that value type can make spec") {
     EXPECT_EQUAL("tensor<float>(x{})", ValueType::tensor_type({{"x"}}, CellType::FLOAT).to_spec());
     EXPECT_EQUAL("tensor<float>(y[10])", ValueType::tensor_type({{"y", 10}}, CellType::FLOAT).to_spec());
     EXPECT_EQUAL("tensor<float>(x{},y[10],z[5])", ValueType::tensor_type({{"x"}, {"y", 10}, {"z", 5}}, CellType::FLOAT).to_spec());
+    EXPECT_EQUAL("tensor<int8>(y[10])", ValueType::tensor_type({{"y", 10}}, CellType::INT8).to_spec());
+    EXPECT_EQUAL("tensor<bfloat16>(y[10])", ValueType::tensor_type({{"y", 10}}, CellType::BFLOAT16).to_spec());
 }
 
 //-----------------------------------------------------------------------------
@@ -149,6 +151,8 @@ TEST("require that value type spec can be parsed") {
     EXPECT_EQUAL(ValueType::tensor_type({{"x"}, {"y", 10}, {"z", 5}}), ValueType::from_spec("tensor(x{},y[10],z[5])"));
     EXPECT_EQUAL(ValueType::tensor_type({{"y", 10}}), ValueType::from_spec("tensor<double>(y[10])"));
     EXPECT_EQUAL(ValueType::tensor_type({{"y", 10}}, CellType::FLOAT), ValueType::from_spec("tensor<float>(y[10])"));
+    EXPECT_EQUAL(ValueType::tensor_type({{"y", 10}}, CellType::INT8), ValueType::from_spec("tensor<int8>(y[10])"));
+    EXPECT_EQUAL(ValueType::tensor_type({{"y", 10}}, CellType::BFLOAT16), ValueType::from_spec("tensor<bfloat16>(y[10])"));
 }
 
 TEST("require that value type spec can be parsed with extra whitespace") {
@@ -258,6 +262,15 @@ TEST("require that value types preserve cell type") {
     EXPECT_TRUE(type("tensor(x[10])").cell_type() == CellType::DOUBLE);
     EXPECT_TRUE(type("tensor<double>(x[10])").cell_type() == CellType::DOUBLE);
     EXPECT_TRUE(type("tensor<float>(x[10])").cell_type() == CellType::FLOAT);
+    EXPECT_TRUE(type("tensor<int8>(x[10])").cell_type() == CellType::INT8);
+    EXPECT_TRUE(type("tensor<bfloat16>(x[10])").cell_type() == CellType::BFLOAT16);
+}
+
+TEST("require that cell size is known for all cell types") {
+    EXPECT_EQUAL(ValueType::cell_size(CellType::DOUBLE), 8u);
+    EXPECT_EQUAL(ValueType::cell_size(CellType::FLOAT), 4u);
+    EXPECT_EQUAL(ValueType::cell_size(CellType::BFLOAT16), 2u);
+    EXPECT_EQUAL(ValueType::cell_size(CellType::INT8), 1u);
 }
 
 TEST("require that dimension names can be obtained") {
@@ -398,6 +411,21 @@ TEST("require that cell type is handled correctly for join") {
     TEST_DO(verify_join(type("tensor<float>(x{})"), type("double"), type("tensor<float>(x{})")));
 }
 
+TEST("require that storage cell types are promoted to float by computation") {
+    EXPECT_EQUAL(type("tensor<int8>(x[10])").map(), type("tensor<float>(x[10])"));
+    EXPECT_EQUAL(type("tensor<bfloat16>(x{})").map(), type("tensor<float>(x{})"));
+    EXPECT_EQUAL(type("tensor<float>(x[10])").map(), type("tensor<float>(x[10])"));
+    EXPECT_EQUAL(type("tensor(x[10])").map(), type("tensor(x[10])"));
+    EXPECT_EQUAL(type("tensor<int8>(x[10],y[5])").reduce({"y"}), type("tensor<float>(x[10])"));
+    EXPECT_EQUAL(type("tensor<bfloat16>(x[10],y[5])").reduce({}), type("double"));
+    EXPECT_EQUAL(type("tensor<int8>(x[10])").rename({"x"}, {"y"}), type("tensor<int8>(y[10])"));
+    TEST_DO(verify_join(type("tensor<int8>(x[10])"), type("double"), type("tensor<float>(x[10])")));
+    TEST_DO(verify_join(type("tensor<int8>(x[10])"), type("tensor<bfloat16>(x[10])"), type("tensor<float>(x[10])")));
+    TEST_DO(verify_join(type("tensor<int8>(x[10])"), type("tensor<int8>(y{})"), type("tensor<float>(x[10],y{})")));
+    TEST_DO(verify_join(type("tensor<bfloat16>(x[10])"), type("tensor(x[10])"), type("tensor(x[10])")));
+    EXPECT_EQUAL(ValueType::merge(type("tensor<int8>(x[5])"), type("tensor<int8>(x[5])")), type("tensor<float>(x[5])"));
+}
+
 void verify_not_joinable(const ValueType &a, const ValueType &b) {
     EXPECT_TRUE(ValueType::join(a, b).is_error());
     EXPECT_TRUE(ValueType::join(b, a).is_error());
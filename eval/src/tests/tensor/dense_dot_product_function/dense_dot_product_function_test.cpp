@@ -104,6 +104,8 @@ EvalFixture::ParamRepo make_params() {
         .add("v06_x5", spec({x(5)}, MyVecSeq(7.0)))
         .add("v07_x5f", spec(float_cells({x(5)}), MyVecSeq(7.0)))
         .add("v08_x5f", spec(float_cells({x(5)}), MyVecSeq(6.0)))
+        .add("v09_x5i", spec(int8_cells({x(5)}), MyVecSeq(7.0)))
+        .add("v10_x5b", spec(bfloat16_cells({x(5)}), MyVecSeq(6.0)))
         .add("m01_x3y3", spec({x(3),y(3)}, MyVecSeq(1.0)))
         .add("m02_x3y3", spec({x(3),y(3)}, MyVecSeq(2.0)));
 }
@@ -200,6 +202,14 @@ TEST("require that optimization also works for tensors with non-double cells") {
     TEST_DO(assertOptimized("reduce(v07_x5f*v08_x5f,sum)"));
 }
 
+TEST("require that optimization also works for tensors with int8 and bfloat16 cells") {
+    TEST_DO(assertOptimized("reduce(v09_x5i*v10_x5b,sum)"));
+    TEST_DO(assertOptimized("reduce(v10_x5b*v09_x5i,sum)"));
+    TEST_DO(assertOptimized("reduce(v09_x5i*v09_x5i,sum)"));
+    TEST_DO(assertOptimized("reduce(v10_x5b*v08_x5f,sum)"));
+    TEST_DO(assertOptimized("reduce(v05_x5*v09_x5i,sum)"));
+}
+
 //-----------------------------------------------------------------------------
 
 TEST_MAIN() { TEST_RUN_ALL(); }
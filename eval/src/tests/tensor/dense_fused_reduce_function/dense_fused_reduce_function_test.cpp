@@ -0,0 +1,138 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/vespalib/testkit/test_kit.h>
+#include <vespa/eval/eval/tensor_function.h>
+#include <vespa/eval/eval/simple_tensor.h>
+#include <vespa/eval/eval/simple_tensor_engine.h>
+#include <vespa/eval/tensor/default_tensor_engine.h>
+#include <vespa/eval/tensor/dense/dense_fused_reduce_function.h>
+#include <vespa/eval/tensor/dense/dense_dot_product_function.h>
+#include <vespa/eval/tensor/dense/dense_tensor.h>
+#include <vespa/eval/eval/test/tensor_model.hpp>
+#include <vespa/eval/eval/test/eval_fixture.h>
+
+#include <vespa/vespalib/util/stringfmt.h>
+#include <vespa/vespalib/util/stash.h>
+
+using namespace vespalib;
+using namespace vespalib::eval;
+using namespace vespalib::eval::test;
+using namespace vespalib::tensor;
+using namespace vespalib::eval::tensor_function;
+
+const TensorEngine &prod_engine = DefaultTensorEngine::ref();
+
+EvalFixture::ParamRepo make_params() {
+    return EvalFixture::ParamRepo()
+        .add("a", spec(1.5))
+        .add("x5", spec({x(5)}, N()))
+        .add("x5b", spec({x(5)}, Div16(N())))
+        .add("x5y3", spec({x(5),y(3)}, N()))
+        .add("x5y3b", spec({x(5),y(3)}, Div16(N())))
+        .add("x5y3f", spec(float_cells({x(5),y(3)}), N()))
+        .add("x5y3bf", spec(float_cells({x(5),y(3)}), Div16(N())))
+        .add("x10y20", spec({x(10),y(20)}, N()))
+        .add("x10y20b", spec({x(10),y(20)}, Div16(N())))
+        .add("x5y3_mixed", spec({x(5),y({"a", "b", "c"})}, N()));
+}
+EvalFixture::ParamRepo param_repo = make_params();
+
+void verify_optimized(const vespalib::string &expr, size_t num_inputs, size_t num_steps,
+                      size_t outer_size, size_t reduce_size)
+{
+    EvalFixture slow_fixture(prod_engine, expr, param_repo, false);
+    EvalFixture fixture(prod_engine, expr, param_repo, true);
+    EXPECT_EQUAL(fixture.result(), EvalFixture::ref(expr, param_repo));
+    EXPECT_EQUAL(fixture.result(), slow_fixture.result());
+    auto info = fixture.find_all<DenseFusedReduceFunction>();
+    ASSERT_EQUAL(info.size(), 1u);
+    EXPECT_TRUE(info[0]->result_is_mutable());
+    EXPECT_EQUAL(info[0]->num_inputs(), num_inputs);
+    EXPECT_EQUAL(info[0]->program().size(), num_steps);
+    EXPECT_EQUAL(info[0]->outer_size(), outer_size);
+    EXPECT_EQUAL(info[0]->reduce_size(), reduce_size);
+}
+
+void verify_not_optimized(const vespalib::string &expr) {
+    EvalFixture slow_fixture(prod_engine, expr, param_repo, false);
+    EvalFixture fixture(prod_engine, expr, param_repo, true);
+    EXPECT_EQUAL(fixture.result(), EvalFixture::ref(expr, param_repo));
+    EXPECT_EQUAL(fixture.result(), slow_fixture.result());
+    auto info = fixture.find_all<DenseFusedReduceFunction>();
+    EXPECT_TRUE(info.empty());
+}
+
+TEST("require that reduce of join is fused") {
+    TEST_DO(verify_optimized("reduce(x5y3*x5y3b,max)", 2, 3, 1, 15));
+    TEST_DO(verify_optimized("reduce(join(x5y3,x5y3b,f(x,y)(x*y*3)),sum)", 2, 3, 1, 15));
+}
+
+TEST("require that reduce of chained maps and joins is fused") {
+    TEST_DO(verify_optimized("reduce(map(x5y3-x5y3b,f(x)(x*x)),sum)", 2, 4, 1, 15));
+    TEST_DO(verify_optimized("reduce((x5y3-x5y3b)*(x5y3+x5y3b)/x5y3,sum)", 5, 9, 1, 15));
+}
+
+TEST("require that numbers can be used as inputs") {
+    TEST_DO(verify_optimized("reduce(x5y3*a,sum)", 2, 3, 1, 15));
+    TEST_DO(verify_optimized("reduce((a+x5y3)-x5y3b,sum)", 3, 5, 1, 15));
+}
+
+TEST("require that all aggregators work") {
+    TEST_DO(verify_optimized("reduce(x5y3-x5y3b,avg)", 2, 3, 1, 15));
+    TEST_DO(verify_optimized("reduce(x5y3-x5y3b,count)", 2, 3, 1, 15));
+    TEST_DO(verify_optimized("reduce(x5y3-x5y3b,prod)", 2, 3, 1, 15));
+    TEST_DO(verify_optimized("reduce(x5y3-x5y3b,sum)", 2, 3, 1, 15));
+    TEST_DO(verify_optimized("reduce(x5y3-x5y3b,max)", 2, 3, 1, 15));
+    TEST_DO(verify_optimized("reduce(x5y3-x5y3b,min)", 2, 3, 1, 15));
+}
+
+TEST("require that innermost dimensions can be reduced") {
+    TEST_DO(verify_optimized("reduce(x5y3*x5y3b,sum,y)", 2, 3, 5, 3));
+    TEST_DO(verify_optimized("reduce(x5y3*x5y3b,max,x,y)", 2, 3, 1, 15));
+}
+
+TEST("require that outer dimensions are not reduced") {
+    TEST_DO(verify_not_optimized("reduce(x5y3*x5y3b,sum,x)"));
+}
+
+TEST("require that cells are streamed in multiple blocks") {
+    TEST_DO(verify_optimized("reduce(x10y20-x10y20b,sum)", 2, 3, 1, 200));
+    TEST_DO(verify_optimized("reduce(x10y20*x10y20b,sum,y)", 2, 3, 10, 20));
+}
+
+TEST("require that float cells work") {
+    TEST_DO(verify_optimized("reduce(x5y3f+x5y3bf,sum)", 2, 3, 1, 15));
+    TEST_DO(verify_optimized("reduce(x5y3f*x5y3bf,sum,y)", 2, 3, 5, 3));
+    TEST_DO(verify_optimized("reduce(x5y3f*x5y3b,sum,y)", 2, 3, 5, 3));
+    TEST_DO(verify_optimized("reduce(map(x5y3f,f(x)(x/3)),sum)", 1, 2, 1, 15));
+}
+
+TEST("require that non-elementwise sub-expressions become inputs") {
+    TEST_DO(verify_optimized("reduce((x5*x5y3)-x5y3b,sum)", 2, 3, 1, 15));
+}
+
+TEST("require that plain reduce is not fused") {
+    TEST_DO(verify_not_optimized("reduce(x5y3,sum)"));
+}
+
+TEST("require that broadcasting join is not fused") {
+    TEST_DO(verify_not_optimized("reduce(x5*x5y3,sum)"));
+}
+
+void verify_dot_product(const vespalib::string &expr) {
+    EvalFixture fixture(prod_engine, expr, param_repo, true);
+    EXPECT_EQUAL(fixture.result(), EvalFixture::ref(expr, param_repo));
+    EXPECT_EQUAL(fixture.find_all<DenseDotProductFunction>().size(), 1u);
+    EXPECT_EQUAL(fixture.find_all<DenseFusedReduceFunction>().size(), 0u);
+}
+
+TEST("require that dot product is still optimized as such") {
+    TEST_DO(verify_dot_product("reduce(x5*x5b,sum)"));
+    TEST_DO(verify_dot_product("reduce(x5y3*x5y3b,sum)"));
+}
+
+TEST("require that non-dense tensors are not fused") {
+    TEST_DO(verify_not_optimized("reduce(x5y3_mixed*x5y3_mixed,sum)"));
+}
+
+TEST_MAIN() { TEST_RUN_ALL(); }
@@ -30,7 +30,9 @@ EvalFixture::ParamRepo make_params() {
         .add_matrix("b", 5, "c", 2)  // outer/outer
         .add_matrix("a", 2, "c", 3)  // not matching
         //------------------------------------------
-        .add_matrix("b", 5, "d", 3); // fixed param
+        .add_matrix("b", 5, "d", 3)  // fixed param
+        .add("a2d3i", spec(int8_cells({{"a", 2}, {"d", 3}}), N()))
+        .add("b5d3b", spec(bfloat16_cells({{"b", 5}, {"d", 3}}), N()));
 }
 EvalFixture::ParamRepo param_repo = make_params();
 
@@ -65,6 +67,13 @@ TEST("require that matmul can be optimized") {
     TEST_DO(verify_optimized("reduce(a2d3*b5d3,sum,d)", 2, 3, 5, true, true));
 }
 
+TEST("require that matmul works with int8 and bfloat16 cells") {
+    TEST_DO(verify_optimized("reduce(a2d3i*b5d3b,sum,d)", 2, 3, 5, true, true));
+    TEST_DO(verify_optimized("reduce(a2d3i*b5d3,sum,d)", 2, 3, 5, true, true));
+    TEST_DO(verify_optimized("reduce(a2d3f*b5d3b,sum,d)", 2, 3, 5, true, true));
+    TEST_DO(verify_optimized("reduce(b5d3b*a2d3i,sum,d)", 2, 3, 5, true, true));
+}
+
 TEST("require that matmul with lambda can be optimized") {
     TEST_DO(verify_optimized("reduce(join(a2d3,b5d3,f(x,y)(x*y)),sum,d)", 2, 3, 5, true, true));
 }
@@ -12,6 +12,7 @@
 #include <vespa/eval/eval/test/tensor_model.hpp>
 #include <vespa/eval/eval/test/eval_fixture.h>
 
+#include <vespa/vespalib/util/simple_thread_bundle.h>
 #include <vespa/vespalib/util/stringfmt.h>
 #include <vespa/vespalib/util/stash.h>
 
@@ -73,6 +74,20 @@ TEST("require that multi matmul can be optimized") {
     TEST_DO(verify_optimized("reduce(A2B1C3a2d3*A2B1C3b5d3,sum,d)", 2, 3, 5, 6, true, true));
 }
 
+TEST("require that large multi matmul gives the same result when split across threads") {
+    SimpleThreadBundle thread_bundle(4);
+    auto repo = EvalFixture::ParamRepo()
+        .add_dense({{"A", 8}, {"a", 64}, {"d", 64}})
+        .add_dense({{"A", 8}, {"b", 64}, {"d", 64}});
+    for (vespalib::string expr: {"reduce(A8a64d64*A8b64d64,sum,d)", "reduce(A8a64d64f*A8b64d64f,sum,d)"}) {
+        TEST_STATE(expr.c_str());
+        EvalFixture single_fixture(prod_engine, expr, repo, true);
+        EvalFixture multi_fixture(prod_engine, expr, repo, true, false, &thread_bundle);
+        EXPECT_EQUAL(multi_fixture.result(), single_fixture.result());
+        EXPECT_EQUAL(multi_fixture.find_all<DenseMultiMatMulFunction>().size(), 1u);
+    }
+}
+
 TEST("require that single multi matmul can be optimized") {
     TEST_DO(verify_optimized("reduce(A1a2d3*A1b5d3,sum,d)", 2, 3, 5, 1, true, true));
 }
@@ -12,6 +12,7 @@
 #include <vespa/eval/eval/test/tensor_model.hpp>
 #include <vespa/eval/eval/test/eval_fixture.h>
 
+#include <vespa/vespalib/util/simple_thread_bundle.h>
 #include <vespa/vespalib/util/stringfmt.h>
 #include <vespa/vespalib/util/stash.h>
 
@@ -42,6 +43,8 @@ void add_vector(EvalFixture::ParamRepo &repo, const char *d1, size_t s1) {
     auto layout = Layout({{d1, s1}});
     repo.add(name, spec(layout, MyVecSeq()));
     repo.add(name + "f", spec(float_cells(layout), MyVecSeq()));
+    repo.add(name + "i", spec(int8_cells(layout), MyVecSeq()));
+    repo.add(name + "b", spec(bfloat16_cells(layout), MyVecSeq()));
 }
 
 void add_matrix(EvalFixture::ParamRepo &repo, const char *d1, size_t s1, const char *d2, size_t s2) {
@@ -128,6 +131,28 @@ TEST("require that xw product gives same results as reference join/reduce") {
     TEST_DO(verify_optimized_multi("y16", "y16z5", "y", 16, 5, false));
 }
 
+TEST("require that xw product works with int8 and bfloat16 vectors") {
+    TEST_DO(verify_optimized("reduce(y3i*x2y3,sum,y)", 3, 2, true));
+    TEST_DO(verify_optimized("reduce(y3b*x2y3f,sum,y)", 3, 2, true));
+    TEST_DO(verify_optimized("reduce(y5z8*y5i,sum,y)", 5, 8, false));
+    TEST_DO(verify_optimized("reduce(y16z5f*y16b,sum,y)", 16, 5, false));
+}
+
+TEST("require that large xw product gives the same result when split across threads") {
+    SimpleThreadBundle thread_bundle(4);
+    EvalFixture::ParamRepo repo;
+    repo.add_vector("y", 512).add_matrix("x", 2048, "y", 512).add_matrix("y", 512, "z", 2048);
+    for (vespalib::string expr: {"reduce(y512*x2048y512,sum,y)", "reduce(y512*y512z2048,sum,y)",
+                                 "reduce(y512f*x2048y512,sum,y)", "reduce(y512f*y512z2048,sum,y)"})
+    {
+        TEST_STATE(expr.c_str());
+        EvalFixture single_fixture(prod_engine, expr, repo, true);
+        EvalFixture multi_fixture(prod_engine, expr, repo, true, false, &thread_bundle);
+        EXPECT_EQUAL(multi_fixture.result(), single_fixture.result());
+        EXPECT_EQUAL(multi_fixture.find_all<DenseXWProductFunction>().size(), 1u);
+    }
+}
+
 TEST("require that various variants of xw product can be optimized") {
     TEST_DO(verify_optimized("reduce(join(y3,x2y3,f(x,y)(x*y)),sum,y)", 3, 2, true));
 }
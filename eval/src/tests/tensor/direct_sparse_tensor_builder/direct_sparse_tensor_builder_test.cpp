@@ -98,7 +98,7 @@ TEST("Test sparse tensor address combiner") {
 TEST("Test essential object sizes") {
     EXPECT_EQUAL(16u, sizeof(SparseTensorAddressRef));
     EXPECT_EQUAL(24u, sizeof(std::pair<SparseTensorAddressRef, double>));
-    EXPECT_EQUAL(32u, sizeof(vespalib::hash_node<std::pair<SparseTensorAddressRef, double>>));
+    EXPECT_EQUAL(24u, sizeof(SparseTensor::Cells::value_type));
     Tensor::UP tensor = buildTensor();
     size_t used = tensor->get_memory_usage().usedBytes();
     EXPECT_GREATER(used, sizeof(SparseTensor));
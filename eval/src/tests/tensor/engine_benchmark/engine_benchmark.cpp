@@ -0,0 +1,252 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+// Microbenchmark comparing tensor engines and value implementations
+// on a fixed catalog of representative tensor operations at several
+// sizes. Reports the minimal time per operation and the number of
+// heap allocations per operation.
+//
+// usage: eval_engine_benchmark_app [budget seconds per measurement]
+
+#include <vespa/eval/eval/function.h>
+#include <vespa/eval/eval/node_types.h>
+#include <vespa/eval/eval/interpreted_function.h>
+#include <vespa/eval/eval/simple_tensor_engine.h>
+#include <vespa/eval/eval/simple_value.h>
+#include <vespa/eval/eval/fast_value.h>
+#include <vespa/eval/eval/lazy_params.h>
+#include <vespa/eval/eval/operation.h>
+#include <vespa/eval/eval/test/tensor_model.hpp>
+#include <vespa/eval/tensor/default_tensor_engine.h>
+#include <vespa/vespalib/util/benchmark_timer.h>
+#include <vespa/vespalib/util/stringfmt.h>
+#include <atomic>
+#include <cstdlib>
+#include <functional>
+#include <new>
+
+using namespace vespalib::eval;
+using namespace vespalib::eval::test;
+using vespalib::BenchmarkTimer;
+using vespalib::make_string;
+using vespalib::tensor::DefaultTensorEngine;
+
+//-----------------------------------------------------------------------------
+
+// count all heap allocations made by this program
+std::atomic<size_t> alloc_count(0);
+
+void *operator new(size_t size) {
+    alloc_count.fetch_add(1, std::memory_order_relaxed);
+    if (void *ptr = malloc(size ? size : 1)) {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+void operator delete(void *ptr) noexcept { free(ptr); }
+void operator delete(void *ptr, size_t) noexcept { free(ptr); }
+
+//-----------------------------------------------------------------------------
+
+Domain mapped(const vespalib::string &dim, size_t size, size_t offset = 0) {
+    std::vector<vespalib::string> keys;
+    for (size_t i = 0; i < size; ++i) {
+        keys.push_back(make_string("%zu", offset + i));
+    }
+    return Domain(dim, keys);
+}
+
+Domain indexed(const vespalib::string &dim, size_t size) {
+    return Domain(dim, size);
+}
+
+using NewParams = std::vector<const NewValue *>;
+using new_op_t = std::function<std::unique_ptr<NewValue>(const NewParams &, const ValueBuilderFactory &)>;
+
+struct Case {
+    vespalib::string name;
+    vespalib::string expr;
+    std::vector<TensorSpec> params;
+    new_op_t new_op; // empty if not expressible with the new value api
+    Case(const vespalib::string &name_in, const vespalib::string &expr_in,
+         std::vector<TensorSpec> params_in, new_op_t new_op_in)
+        : name(name_in), expr(expr_in), params(std::move(params_in)), new_op(std::move(new_op_in)) {}
+};
+
+std::vector<Case> make_cases() {
+    std::vector<Case> list;
+    auto dot_product = [](const NewParams &p, const ValueBuilderFactory &factory) {
+        return new_reduce(*new_join(*p[0], *p[1], operation::Mul::f, factory), Aggr::SUM, {}, factory);
+    };
+    auto mixed_reduce = [](const NewParams &p, const ValueBuilderFactory &factory) {
+        return new_reduce(*p[0], Aggr::SUM, {"y"}, factory);
+    };
+    auto matmul = [](const NewParams &p, const ValueBuilderFactory &factory) {
+        return new_reduce(*new_join(*p[0], *p[1], operation::Mul::f, factory), Aggr::SUM, {"y"}, factory);
+    };
+    for (size_t n: {16, 256, 4096}) {
+        list.emplace_back(make_string("sparse dot product [x{%zu}]", n), "reduce(a*b,sum)",
+                          std::vector<TensorSpec>({spec({mapped("x", n)}, N()), spec({mapped("x", n)}, N())}),
+                          dot_product);
+    }
+    for (size_t n: {16, 256}) {
+        list.emplace_back(make_string("mixed reduce [x{%zu},y[32]]", n), "reduce(a,sum,y)",
+                          std::vector<TensorSpec>({spec({mapped("x", n), indexed("y", 32)}, N())}),
+                          mixed_reduce);
+    }
+    for (size_t n: {16, 64, 128}) {
+        list.emplace_back(make_string("dense matmul [%zux%zu]", n, n), "reduce(a*b,sum,y)",
+                          std::vector<TensorSpec>({spec({indexed("x", n), indexed("y", n)}, N()),
+                                                   spec({indexed("y", n), indexed("z", n)}, N())}),
+                          matmul);
+    }
+    for (size_t n: {16, 256, 4096}) {
+        list.emplace_back(make_string("mixed peek [x{%zu},y[16]]", n), "a{x:1}",
+                          std::vector<TensorSpec>({spec({mapped("x", n), indexed("y", 16)}, N())}),
+                          new_op_t());
+    }
+    for (size_t n: {16, 256, 4096}) {
+        list.emplace_back(make_string("sparse merge [x{%zu}]", n), "merge(a,b,f(x,y)(x+y))",
+                          std::vector<TensorSpec>({spec({mapped("x", n)}, N()), spec({mapped("x", n, n / 2)}, N())}),
+                          new_op_t());
+    }
+    return list;
+}
+
+//-----------------------------------------------------------------------------
+
+struct Evaluator {
+    using UP = std::unique_ptr<Evaluator>;
+    virtual void eval() = 0;
+    virtual TensorSpec result() = 0;
+    virtual ~Evaluator() = default;
+};
+
+struct Impl {
+    virtual vespalib::string name() const = 0;
+    // returns nullptr if the case is not supported
+    virtual Evaluator::UP prepare(const Case &c) const = 0;
+    virtual ~Impl() = default;
+};
+
+struct EngineEvaluator : Evaluator {
+    const TensorEngine &engine;
+    std::shared_ptr<Function const> function;
+    NodeTypes types;
+    InterpretedFunction ifun;
+    InterpretedFunction::Context ctx;
+    std::vector<Value::UP> values;
+    SimpleObjectParams params;
+    EngineEvaluator(const TensorEngine &engine_in, std::shared_ptr<Function const> function_in,
+                    NodeTypes types_in, std::vector<Value::UP> values_in)
+        : engine(engine_in), function(std::move(function_in)), types(std::move(types_in)),
+          ifun(engine, *function, types), ctx(ifun), values(std::move(values_in)), params({})
+    {
+        for (const auto &value: values) {
+            params.params.push_back(*value);
+        }
+    }
+    void eval() override { ifun.eval(ctx, params); }
+    TensorSpec result() override { return engine.to_spec(ifun.eval(ctx, params)); }
+};
+
+struct EngineImpl : Impl {
+    vespalib::string my_name;
+    const TensorEngine &engine;
+    EngineImpl(const vespalib::string &name_in, const TensorEngine &engine_in)
+        : my_name(name_in), engine(engine_in) {}
+    vespalib::string name() const override { return my_name; }
+    Evaluator::UP prepare(const Case &c) const override {
+        std::vector<vespalib::string> param_names({"a", "b"});
+        param_names.resize(c.params.size());
+        auto function = Function::parse(param_names, c.expr);
+        assert(!function->has_error());
+        std::vector<ValueType> param_types;
+        std::vector<Value::UP> values;
+        for (const auto &spec: c.params) {
+            param_types.push_back(ValueType::from_spec(spec.type()));
+            values.push_back(engine.from_spec(spec));
+        }
+        NodeTypes types(*function, param_types);
+        assert(types.errors().empty());
+        return std::make_unique<EngineEvaluator>(engine, std::move(function), std::move(types), std::move(values));
+    }
+};
+
+struct NewValueEvaluator : Evaluator {
+    const ValueBuilderFactory &factory;
+    const new_op_t &op;
+    std::vector<std::unique_ptr<NewValue>> values;
+    NewParams params;
+    NewValueEvaluator(const ValueBuilderFactory &factory_in, const new_op_t &op_in,
+                      std::vector<std::unique_ptr<NewValue>> values_in)
+        : factory(factory_in), op(op_in), values(std::move(values_in)), params()
+    {
+        for (const auto &value: values) {
+            params.push_back(value.get());
+        }
+    }
+    void eval() override { op(params, factory); }
+    TensorSpec result() override { return spec_from_new_value(*op(params, factory)); }
+};
+
+struct NewValueImpl : Impl {
+    vespalib::string my_name;
+    const ValueBuilderFactory &factory;
+    NewValueImpl(const vespalib::string &name_in, const ValueBuilderFactory &factory_in)
+        : my_name(name_in), factory(factory_in) {}
+    vespalib::string name() const override { return my_name; }
+    Evaluator::UP prepare(const Case &c) const override {
+        if (!c.new_op) {
+            return Evaluator::UP();
+        }
+        std::vector<std::unique_ptr<NewValue>> values;
+        for (const auto &spec: c.params) {
+            values.push_back(new_value_from_spec(spec, factory));
+        }
+        return std::make_unique<NewValueEvaluator>(factory, c.new_op, std::move(values));
+    }
+};
+
+//-----------------------------------------------------------------------------
+
+double allocs_per_op(Evaluator &evaluator) {
+    constexpr size_t num_ops = 16;
+    evaluator.eval(); // warm-up
+    size_t before = alloc_count.load(std::memory_order_relaxed);
+    for (size_t i = 0; i < num_ops; ++i) {
+        evaluator.eval();
+    }
+    size_t after = alloc_count.load(std::memory_order_relaxed);
+    return double(after - before) / num_ops;
+}
+
+int main(int argc, char **argv) {
+    double budget = (argc > 1) ? strtod(argv[1], nullptr) : 0.5;
+    SimpleValueBuilderFactory simple_factory;
+    FastValueBuilderFactory fast_factory;
+    std::vector<std::unique_ptr<Impl>> impls;
+    impls.push_back(std::make_unique<EngineImpl>("SimpleTensorEngine", SimpleTensorEngine::ref()));
+    impls.push_back(std::make_unique<EngineImpl>("DefaultTensorEngine", DefaultTensorEngine::ref()));
+    impls.push_back(std::make_unique<NewValueImpl>("SimpleValue", simple_factory));
+    impls.push_back(std::make_unique<NewValueImpl>("FastValue", fast_factory));
+    bool mismatch = false;
+    for (const Case &c: make_cases()) {
+        fprintf(stderr, "%s: %s\n", c.name.c_str(), c.expr.c_str());
+        // the reference engine supports all cases
+        TensorSpec expect = impls[0]->prepare(c)->result();
+        for (const auto &impl: impls) {
+            auto evaluator = impl->prepare(c);
+            if (!evaluator) {
+                fprintf(stderr, "    %-20s %16s\n", impl->name().c_str(), "n/a");
+                continue;
+            }
+            TensorSpec actual = evaluator->result();
+            double ns = BenchmarkTimer::benchmark([&evaluator](){ evaluator->eval(); }, budget) * 1000.0 * 1000.0 * 1000.0;
+            double allocs = allocs_per_op(*evaluator);
+            fprintf(stderr, "    %-20s %13.1f ns/op %10.1f allocs/op%s\n", impl->name().c_str(), ns, allocs,
+                    (actual == expect) ? "" : " (result mismatch)");
+            mismatch |= !(actual == expect);
+        }
+    }
+    return mismatch ? 1 : 0;
+}
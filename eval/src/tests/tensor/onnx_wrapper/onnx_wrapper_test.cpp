@@ -308,4 +308,69 @@ TEST(OnnxTest, we_guess_batch_dimension_size_when_inference_fails) {
     //-------------------------------------------------------------------------
 }
 
+TEST(OnnxTest, batch_dimension_is_detected_when_all_inputs_and_outputs_have_it) {
+    Onnx simple(simple_model, Onnx::Optimize::DISABLE);
+    Onnx dynamic(dynamic_model, Onnx::Optimize::DISABLE);
+    Onnx guess_batch(guess_batch_model, Onnx::Optimize::DISABLE);
+    Onnx::WirePlanner simple_planner;
+    Onnx::WirePlanner dynamic_planner;
+    Onnx::WirePlanner guess_1_planner;
+    Onnx::WirePlanner guess_3_planner;
+    EXPECT_TRUE(simple_planner.bind_input_type(ValueType::from_spec("tensor<float>(a[1],b[4])"), simple.inputs()[0]));
+    EXPECT_TRUE(simple_planner.bind_input_type(ValueType::from_spec("tensor<float>(a[4],b[1])"), simple.inputs()[1]));
+    EXPECT_TRUE(simple_planner.bind_input_type(ValueType::from_spec("tensor<float>(a[1],b[1])"), simple.inputs()[2]));
+    EXPECT_TRUE(dynamic_planner.bind_input_type(ValueType::from_spec("tensor<float>(a[1],b[4])"), dynamic.inputs()[0]));
+    EXPECT_TRUE(dynamic_planner.bind_input_type(ValueType::from_spec("tensor<float>(a[4],b[1])"), dynamic.inputs()[1]));
+    EXPECT_TRUE(dynamic_planner.bind_input_type(ValueType::from_spec("tensor<float>(a[1],b[2])"), dynamic.inputs()[2]));
+    EXPECT_TRUE(guess_1_planner.bind_input_type(ValueType::from_spec("tensor<float>(a[1])"), guess_batch.inputs()[0]));
+    EXPECT_TRUE(guess_1_planner.bind_input_type(ValueType::from_spec("tensor<float>(a[1])"), guess_batch.inputs()[1]));
+    EXPECT_TRUE(guess_3_planner.bind_input_type(ValueType::from_spec("tensor<float>(a[3])"), guess_batch.inputs()[0]));
+    EXPECT_TRUE(guess_3_planner.bind_input_type(ValueType::from_spec("tensor<float>(a[3])"), guess_batch.inputs()[1]));
+    EXPECT_FALSE(simple_planner.get_wire_info(simple).has_batch_dimension);
+    EXPECT_FALSE(dynamic_planner.get_wire_info(dynamic).has_batch_dimension);
+    EXPECT_TRUE(guess_1_planner.get_wire_info(guess_batch).has_batch_dimension);
+    EXPECT_FALSE(guess_3_planner.get_wire_info(guess_batch).has_batch_dimension);
+}
+
+TEST(OnnxTest, batch_of_inputs_can_be_evaluated_with_a_single_model_invocation) {
+    Onnx model(guess_batch_model, Onnx::Optimize::ENABLE);
+    Onnx::WirePlanner planner;
+
+    ValueType in_type = ValueType::from_spec("tensor<float>(a[1])");
+    EXPECT_TRUE(planner.bind_input_type(in_type, model.inputs()[0]));
+    EXPECT_TRUE(planner.bind_input_type(in_type, model.inputs()[1]));
+    Onnx::WireInfo wire_info = planner.get_wire_info(model);
+    ASSERT_TRUE(wire_info.has_batch_dimension);
+
+    Onnx::BatchEvalContext ctx(model, wire_info, 3);
+    EXPECT_EQ(ctx.batch_size(), 3);
+    EXPECT_EQ(ctx.num_params(), 2);
+    EXPECT_EQ(ctx.num_results(), 1);
+    std::vector<std::vector<float>> in_values({{1.0}, {2.0}, {3.0}});
+    std::vector<DenseTensorView> in;
+    for (const auto &values: in_values) {
+        in.emplace_back(in_type, TypedCells(values));
+    }
+    //-------------------------------------------------------------------------
+    for (size_t idx = 0; idx < 3; ++idx) {
+        ctx.bind_param(idx, 0, in[idx]);
+        ctx.bind_param(idx, 1, in[2 - idx]);
+    }
+    ctx.eval();
+    for (size_t idx = 0; idx < 3; ++idx) {
+        EXPECT_EQ(TensorSpec::from_value(ctx.get_result(idx, 0)),
+                  TensorSpec::from_expr("tensor<float>(d0[1]):[4]"));
+    }
+    //-------------------------------------------------------------------------
+    for (size_t idx = 0; idx < 3; ++idx) {
+        ctx.bind_param(idx, 0, in[idx]);
+        ctx.bind_param(idx, 1, in[idx]);
+    }
+    ctx.eval();
+    EXPECT_EQ(TensorSpec::from_value(ctx.get_result(0, 0)), TensorSpec::from_expr("tensor<float>(d0[1]):[2]"));
+    EXPECT_EQ(TensorSpec::from_value(ctx.get_result(1, 0)), TensorSpec::from_expr("tensor<float>(d0[1]):[4]"));
+    EXPECT_EQ(TensorSpec::from_value(ctx.get_result(2, 0)), TensorSpec::from_expr("tensor<float>(d0[1]):[6]"));
+    //-------------------------------------------------------------------------
+}
+
 GTEST_MAIN_RUN_ALL_TESTS()
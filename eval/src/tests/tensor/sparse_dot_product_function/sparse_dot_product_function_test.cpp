@@ -0,0 +1,78 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/vespalib/testkit/test_kit.h>
+#include <vespa/eval/eval/tensor_function.h>
+#include <vespa/eval/tensor/default_tensor_engine.h>
+#include <vespa/eval/tensor/sparse/sparse_dot_product_function.h>
+#include <vespa/eval/eval/test/tensor_model.hpp>
+#include <vespa/eval/eval/test/eval_fixture.h>
+
+using namespace vespalib;
+using namespace vespalib::eval;
+using namespace vespalib::eval::test;
+using namespace vespalib::tensor;
+
+const TensorEngine &prod_engine = DefaultTensorEngine::ref();
+
+EvalFixture::ParamRepo make_params() {
+    return EvalFixture::ParamRepo()
+        .add("x3", spec({x({"a","b","c"})}, N()))
+        .add("x4", spec({x({"b","c","d","e"})}, N()))
+        .add("x0", spec({x(std::vector<vespalib::string>())}, N()))
+        .add("x3f", spec(float_cells({x({"a","b","c"})}), N()))
+        .add("y3", spec({y({"a","b","c"})}, N()))
+        .add("x3y2", spec({x({"a","b","c"}),y({"foo","bar"})}, N()))
+        .add("x2y2", spec({x({"b","c"}),y({"bar","baz"})}, N()))
+        .add("x3y2m", spec({x({"a","b","c"}),y(2)}, N()))
+        .add("x3d", spec({x(3)}, N()));
+}
+EvalFixture::ParamRepo param_repo = make_params();
+
+void assert_optimized(const vespalib::string &expr) {
+    EvalFixture slow_fixture(prod_engine, expr, param_repo, false);
+    EvalFixture fixture(prod_engine, expr, param_repo, true);
+    EXPECT_EQUAL(fixture.result(), EvalFixture::ref(expr, param_repo));
+    EXPECT_EQUAL(fixture.result(), slow_fixture.result());
+    auto info = fixture.find_all<SparseDotProductFunction>();
+    EXPECT_EQUAL(info.size(), 1u);
+}
+
+void assert_not_optimized(const vespalib::string &expr) {
+    EvalFixture fixture(prod_engine, expr, param_repo, true);
+    EXPECT_EQUAL(fixture.result(), EvalFixture::ref(expr, param_repo));
+    auto info = fixture.find_all<SparseDotProductFunction>();
+    EXPECT_TRUE(info.empty());
+}
+
+TEST("require that sparse dot product is optimized") {
+    TEST_DO(assert_optimized("reduce(x3*x4,sum)"));
+    TEST_DO(assert_optimized("reduce(x4*x3,sum)"));
+    TEST_DO(assert_optimized("reduce(x3*x3,sum)"));
+    TEST_DO(assert_optimized("reduce(x3*x4,sum,x)"));
+    TEST_DO(assert_optimized("reduce(join(x3,x4,f(a,b)(a*b)),sum)"));
+}
+
+TEST("require that empty and non-overlapping sparse dot products are optimized") {
+    TEST_DO(assert_optimized("reduce(x3*x0,sum)"));
+    TEST_DO(assert_optimized("reduce(x0*x0,sum)"));
+}
+
+TEST("require that sparse dot product works with float cells") {
+    TEST_DO(assert_optimized("reduce(x3f*x4,sum)"));
+    TEST_DO(assert_optimized("reduce(x3f*x3f,sum)"));
+}
+
+TEST("require that multi-dimensional sparse dot product is optimized") {
+    TEST_DO(assert_optimized("reduce(x3y2*x2y2,sum)"));
+}
+
+TEST("require that other shapes are not optimized") {
+    TEST_DO(assert_not_optimized("reduce(x3*y3,sum)"));
+    TEST_DO(assert_not_optimized("reduce(x3*x4,max)"));
+    TEST_DO(assert_not_optimized("reduce(x3+x4,sum)"));
+    TEST_DO(assert_not_optimized("reduce(x3y2*x2y2,sum,x)"));
+    TEST_DO(assert_not_optimized("reduce(x3y2m*x3y2m,sum)"));
+    TEST_DO(assert_not_optimized("reduce(x3d*x3d,sum)"));
+}
+
+TEST_MAIN() { TEST_RUN_ALL(); }
@@ -0,0 +1,136 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/eval/eval/operation.h>
+#include <vespa/eval/eval/tensor_spec.h>
+#include <vespa/eval/tensor/cell_values.h>
+#include <vespa/eval/tensor/sparse/sparse_tensor.h>
+#include <vespa/eval/tensor/sparse/sparse_tensor_label_dictionary.h>
+#include <vespa/eval/tensor/test/test_utils.h>
+#include <vespa/vespalib/util/stringfmt.h>
+#include <vespa/vespalib/gtest/gtest.h>
+#include <thread>
+
+using vespalib::eval::TensorSpec;
+namespace operation = vespalib::eval::operation;
+using vespalib::tensor::test::makeTensor;
+using namespace vespalib::tensor;
+
+using Dictionary = SparseTensorLabelDictionary;
+
+Dictionary &dict() { return Dictionary::instance(); }
+
+TEST(SparseTensorLabelDictionaryTest, empty_label_is_undefined) {
+    EXPECT_EQ(dict().intern(""), Dictionary::UNDEFINED);
+    EXPECT_EQ(dict().label(Dictionary::UNDEFINED), "");
+    dict().release(Dictionary::UNDEFINED);
+    EXPECT_EQ(dict().label(Dictionary::UNDEFINED), "");
+}
+
+TEST(SparseTensorLabelDictionaryTest, labels_are_interned) {
+    size_t old_size = dict().size();
+    auto foo = dict().intern("foo");
+    auto bar = dict().intern("bar");
+    EXPECT_NE(foo, bar);
+    EXPECT_NE(foo, Dictionary::UNDEFINED);
+    EXPECT_EQ(dict().intern("foo"), foo);
+    EXPECT_EQ(dict().label(foo), "foo");
+    EXPECT_EQ(dict().label(bar), "bar");
+    EXPECT_EQ(dict().size(), old_size + 2);
+    dict().release(foo);
+    dict().release(foo);
+    dict().release(bar);
+    EXPECT_EQ(dict().size(), old_size);
+}
+
+TEST(SparseTensorLabelDictionaryTest, label_is_kept_until_last_reference_is_released) {
+    size_t old_size = dict().size();
+    auto foo = dict().intern("foo");
+    dict().copy(foo);
+    dict().release(foo);
+    EXPECT_EQ(dict().size(), old_size + 1);
+    EXPECT_EQ(dict().label(foo), "foo");
+    dict().release(foo);
+    EXPECT_EQ(dict().size(), old_size);
+}
+
+TEST(SparseTensorLabelDictionaryTest, sparse_tensors_reference_their_labels) {
+    size_t old_size = dict().size();
+    auto tensor = makeTensor<Tensor>(TensorSpec("tensor(x{},y{})")
+                                     .add({{"x","label_a"},{"y","label_b"}}, 2)
+                                     .add({{"x","label_c"},{"y","label_b"}}, 3));
+    EXPECT_EQ(dict().size(), old_size + 3);
+    auto copy = tensor->clone();
+    auto to_remove = makeTensor<SparseTensor>(TensorSpec("tensor(x{},y{})").add({{"x","label_c"},{"y","label_b"}}, 1));
+    auto modified = tensor->remove(CellValues(*to_remove));
+    to_remove.reset();
+    tensor.reset();
+    EXPECT_EQ(dict().size(), old_size + 3);
+    EXPECT_EQ(copy->toSpec(), TensorSpec("tensor(x{},y{})")
+                                     .add({{"x","label_a"},{"y","label_b"}}, 2)
+                                     .add({{"x","label_c"},{"y","label_b"}}, 3));
+    copy.reset();
+    EXPECT_EQ(dict().size(), old_size + 2);
+    EXPECT_EQ(modified->toSpec(), TensorSpec("tensor(x{},y{})").add({{"x","label_a"},{"y","label_b"}}, 2));
+    modified.reset();
+    EXPECT_EQ(dict().size(), old_size);
+}
+
+TEST(SparseTensorLabelDictionaryTest, sparse_tensor_operations_do_not_leak_labels) {
+    size_t old_size = dict().size();
+    {
+        auto lhs = makeTensor<Tensor>(TensorSpec("tensor(x{},y{})")
+                                      .add({{"x","label_a"},{"y","label_b"}}, 2)
+                                      .add({{"x","label_c"},{"y","label_d"}}, 3));
+        auto rhs = makeTensor<Tensor>(TensorSpec("tensor(y{},z{})")
+                                      .add({{"y","label_b"},{"z","label_e"}}, 5)
+                                      .add({{"y","label_f"},{"z","label_g"}}, 7));
+        auto same = makeTensor<Tensor>(TensorSpec("tensor(x{},y{})")
+                                       .add({{"x","label_a"},{"y","label_b"}}, 11)
+                                       .add({{"x","label_h"},{"y","label_b"}}, 13));
+        EXPECT_EQ(dict().size(), old_size + 8);
+        auto join = lhs->join(operation::Mul::f, *rhs);
+        EXPECT_EQ(join->toSpec(), TensorSpec("tensor(x{},y{},z{})").add({{"x","label_a"},{"y","label_b"},{"z","label_e"}}, 10));
+        auto match = lhs->join(operation::Mul::f, *same);
+        EXPECT_EQ(match->toSpec(), TensorSpec("tensor(x{},y{})").add({{"x","label_a"},{"y","label_b"}}, 22));
+        auto reduce = lhs->reduce(operation::Add::f, {"x"});
+        EXPECT_EQ(reduce->toSpec(), TensorSpec("tensor(y{})").add({{"y","label_b"}}, 2).add({{"y","label_d"}}, 3));
+        auto merge = lhs->merge(operation::Add::f, *same);
+        EXPECT_EQ(merge->toSpec().cells().size(), 3u);
+        auto add = lhs->add(*same);
+        EXPECT_EQ(add->toSpec().cells().size(), 3u);
+        auto modify = lhs->modify(operation::Add::f, CellValues(dynamic_cast<const SparseTensor &>(*same)));
+        EXPECT_EQ(modify->toSpec(), TensorSpec("tensor(x{},y{})")
+                  .add({{"x","label_a"},{"y","label_b"}}, 13)
+                  .add({{"x","label_c"},{"y","label_d"}}, 3));
+        EXPECT_EQ(dict().size(), old_size + 8);
+    }
+    EXPECT_EQ(dict().size(), old_size);
+}
+
+TEST(SparseTensorLabelDictionaryTest, labels_can_be_interned_and_released_by_multiple_threads) {
+    size_t old_size = dict().size();
+    auto work = [](size_t thread_id) {
+        for (size_t round = 0; round < 100; ++round) {
+            std::vector<Dictionary::label_t> ids;
+            for (size_t i = 0; i < 100; ++i) {
+                vespalib::string label = vespalib::make_string("label_%zu", (i + thread_id) % 150);
+                auto id = dict().intern(label);
+                ASSERT_EQ(dict().label(id), label);
+                ids.push_back(id);
+            }
+            for (auto id: ids) {
+                dict().release(id);
+            }
+        }
+    };
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < 8; ++i) {
+        threads.emplace_back(work, i);
+    }
+    for (auto &thread: threads) {
+        thread.join();
+    }
+    EXPECT_EQ(dict().size(), old_size);
+}
+
+GTEST_MAIN_RUN_ALL_TESTS()
@@ -8,6 +8,7 @@
 #include <vespa/eval/tensor/serialization/sparse_binary_format.h>
 #include <vespa/vespalib/objects/nbostream.h>
 #include <vespa/vespalib/objects/hexdump.h>
+#include <vespa/vespalib/util/exceptions.h>
 #include <ostream>
 #include <vespa/eval/tensor/dense/dense_tensor_view.h>
 
@@ -111,6 +112,15 @@ TEST("test float cells from sparse tensor") {
                               .add({{"x", "1"}, {"y", ""}}, 3)));
 }
 
+TEST("test bfloat16 cells from sparse tensor") {
+    TEST_DO(verify_serialized({ 0x05, 0x02,
+                                0x02, 0x01, 0x78, 0x01, 0x79,
+                                0x01, 0x01, 0x31, 0x00,
+                                0x40, 0x40 },
+                              TensorSpec("tensor<bfloat16>(x{},y{})")
+                              .add({{"x", "1"}, {"y", ""}}, 3)));
+}
+
 TEST("test tensor serialization for DenseTensor") {
     TEST_DO(verify_serialized({0x02, 0x00,
                                0x00, 0x00, 0x00, 0x00,
@@ -218,4 +228,38 @@ TEST("test float cells for dense tensor") {
                               .add({{"x", 2}, {"y", 4}}, 3)));
 }
 
+TEST("test int8 cells for dense tensor") {
+    TEST_DO(verify_serialized({0x06, 0x03, 0x01, 0x01, 0x78, 0x03,
+                               0x01, 0xff, 0x7f },
+                              TensorSpec("tensor<int8>(x[3])")
+                              .add({{"x", 0}}, 1)
+                              .add({{"x", 1}}, -1)
+                              .add({{"x", 2}}, 127)));
+}
+
+TEST("test bfloat16 cells for dense tensor") {
+    TEST_DO(verify_serialized({0x06, 0x02, 0x01, 0x01, 0x78, 0x02,
+                               0x40, 0x40, 0xbf, 0x80 },
+                              TensorSpec("tensor<bfloat16>(x[2])")
+                              .add({{"x", 0}}, 3)
+                              .add({{"x", 1}}, -1)));
+}
+
+void verify_truncated(const ExpBuffer &buf) {
+    auto &engine = DefaultTensorEngine::ref();
+    nbostream input(&buf[0], buf.size());
+    EXPECT_EXCEPTION(engine.decode(input), vespalib::IllegalStateException, "Stream too small");
+    nbostream cells_input(&buf[0], buf.size());
+    std::vector<double> cells;
+    EXPECT_EXCEPTION(TypedBinaryFormat::deserializeCellsOnlyFromDenseTensors(cells_input, cells),
+                     vespalib::IllegalStateException, "Stream too small");
+}
+
+TEST("require that truncated dense tensor cells are detected") {
+    TEST_DO(verify_truncated({0x02, 0x01, 0x01, 0x78, 0x02,
+                              0x40, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 }));
+    TEST_DO(verify_truncated({0x06, 0x01, 0x01, 0x01, 0x78, 0xff, 0xff, 0xff, 0xff,
+                              0x40, 0x40, 0x00, 0x00 }));
+}
+
 TEST_MAIN() { TEST_RUN_ALL(); }
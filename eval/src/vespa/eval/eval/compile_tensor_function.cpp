@@ -2,6 +2,7 @@
 
 #include "compile_tensor_function.h"
 #include "tensor_function.h"
+#include <algorithm>
 
 namespace vespalib::eval {
 
@@ -74,6 +75,10 @@ struct ProgramCompiler {
     }
 };
 
+// rough upper bound on the stash memory used for value objects and
+// cleanup hooks by the instruction of a single node
+constexpr size_t node_overhead = 64;
+
 } // namespace vespalib::eval::<unnamed>
 
 std::vector<Instruction> compile_tensor_function(const TensorEngine &engine, const TensorFunction &function, Stash &stash) {
@@ -81,4 +86,29 @@ std::vector<Instruction> compile_tensor_function(const TensorEngine &engine, con
     return compiler.compile(function);
 }
 
+size_t estimate_stash_chunk_size(const TensorFunction &function) {
+    size_t total = 0;
+    size_t largest = 0;
+    std::vector<Frame> stack;
+    stack.emplace_back(function);
+    while (!stack.empty()) {
+        if (stack.back().has_next_child()) {
+            stack.emplace_back(stack.back().next_child());
+        } else {
+            const ValueType &type = stack.back().node.result_type();
+            size_t bytes = node_overhead;
+            if (type.is_dense() && !type.is_double()) {
+                size_t cells_size = type.dense_subspace_size() * ValueType::cell_size(type.cell_type());
+                largest = std::max(largest, cells_size);
+                bytes += cells_size;
+            }
+            total += bytes;
+            stack.pop_back();
+        }
+    }
+    // the stash only serves allocations smaller than a quarter of the
+    // chunk size from its chunks
+    return std::max({Stash().get_chunk_size(), total, 4 * (largest + node_overhead)});
+}
+
 } // namespace vespalib::eval
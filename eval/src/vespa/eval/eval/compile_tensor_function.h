@@ -14,4 +14,13 @@ struct TensorEngine;
 
 std::vector<InterpretedFunction::Instruction> compile_tensor_function(const TensorEngine &engine, const TensorFunction &function, Stash &stash);
 
+/**
+ * Estimate the stash chunk size needed to keep all intermediate
+ * results of a single evaluation of the given tensor function inside
+ * one chunk. Result cells of dense tensors are allocated in the stash
+ * of the evaluation context; sizing the stash up front avoids heap
+ * allocations for these in the steady state.
+ **/
+size_t estimate_stash_chunk_size(const TensorFunction &function);
+
 } // namespace vespalib::eval
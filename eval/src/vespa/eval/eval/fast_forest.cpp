@@ -8,6 +8,8 @@
 #include <vespa/vespalib/util/benchmark_timer.h>
 #include <algorithm>
 #include <cassert>
+#include <cstring>
+#include <limits>
 #include <arpa/inet.h>
 
 namespace vespalib::eval::gbdt {
@@ -143,10 +145,16 @@ template <> vespalib::string fixed_impl_name<uint64_t>() { return "ff-fixed<64>"
 template <typename T>
 constexpr size_t max_leafs() { return (sizeof(T) * bits_per_byte); }
 
+// number of documents evaluated in parallel by eval_batch
+constexpr size_t num_lanes = 16;
+
 template <typename T>
 struct FixedContext : FastForest::Context {
     std::vector<T> masks;
-    FixedContext(size_t num_trees) : masks(num_trees) {}
+    std::vector<T> lane_masks;      // [tree][lane]
+    std::vector<float> lane_params; // [param][lane]
+    FixedContext(size_t num_trees, size_t num_params)
+        : masks(num_trees), lane_masks(num_trees * num_lanes), lane_params(num_params * num_lanes) {}
 };
 
 template <typename T>
@@ -197,9 +205,14 @@ struct FixedForest : FastForest {
     static void apply_masks(T *ctx_masks, const DMask *pos, const DMask *end);
     double get_result(const T *ctx_masks) const;
 
+    static void apply_lane_masks(T *lane_masks, const float *lane_params, const Mask *pos, const Mask *end);
+    double get_lane_result(const T *lane_masks, size_t lane) const;
+
     vespalib::string impl_name() const override { return fixed_impl_name<T>(); }
     Context::UP create_context() const override;
     double eval(Context &context, const float *params) const override;
+    void eval_batch(Context &context, const float *params, size_t num_params,
+                    size_t num_docs, double *results) const override;
 };
 
 template <typename T>
@@ -306,11 +319,53 @@ FixedForest<T>::get_result(const T *ctx_masks) const
     return (result1 + result2);
 }
 
+template <typename T>
+void
+FixedForest<T>::apply_lane_masks(T *lane_masks, const float *lane_params, const Mask *pos, const Mask *end)
+{
+    // masks are sorted on value; stop when no lane can match (NaN lanes never match)
+    float limit = -std::numeric_limits<float>::infinity();
+    for (size_t lane = 0; lane < num_lanes; ++lane) {
+        limit = (lane_params[lane] > limit) ? lane_params[lane] : limit;
+    }
+    for (; (pos < end) && !(limit < pos->value); ++pos) {
+        T *dst = lane_masks + (pos->tree * num_lanes);
+        float value = pos->value;
+        T bits = pos->bits;
+        for (size_t lane = 0; lane < num_lanes; ++lane) {
+            dst[lane] &= (value <= lane_params[lane]) ? bits : T(~T(0));
+        }
+    }
+}
+
+template <typename T>
+double
+FixedForest<T>::get_lane_result(const T *lane_masks, size_t lane) const
+{
+    // same summation order as get_result
+    double result1 = 0.0;
+    double result2 = 0.0;
+    const T *ctx_masks = lane_masks + lane;
+    const T *ctx_end = ctx_masks + (_num_trees * num_lanes);
+    const float *leafs = &_padded_leafs[0];
+    size_t leaf_cnt = _max_leafs;
+    for (; (ctx_masks + (3 * num_lanes)) < ctx_end; ctx_masks += (4 * num_lanes), leafs += (leaf_cnt * 4)) {
+        result1 += leafs[(0 * leaf_cnt) + get_lsb(ctx_masks[0 * num_lanes])];
+        result2 += leafs[(1 * leaf_cnt) + get_lsb(ctx_masks[1 * num_lanes])];
+        result1 += leafs[(2 * leaf_cnt) + get_lsb(ctx_masks[2 * num_lanes])];
+        result2 += leafs[(3 * leaf_cnt) + get_lsb(ctx_masks[3 * num_lanes])];
+    }
+    for (; ctx_masks < ctx_end; ctx_masks += num_lanes, leafs += leaf_cnt) {
+        result1 += leafs[get_lsb(*ctx_masks)];
+    }
+    return (result1 + result2);
+}
+
 template <typename T>
 FastForest::Context::UP
 FixedForest<T>::create_context() const
 {
-    return std::make_unique<FixedContext<T>>(_num_trees);
+    return std::make_unique<FixedContext<T>>(_num_trees, _mask_sizes.size());
 }
 
 template <typename T>
@@ -335,6 +390,47 @@ FixedForest<T>::eval(Context &context, const float *params) const
     return get_result(ctx_masks);
 }
 
+template <typename T>
+void
+FixedForest<T>::eval_batch(Context &context, const float *params, size_t num_params,
+                           size_t num_docs, double *results) const
+{
+    assert(num_params == _mask_sizes.size());
+    auto &ctx = static_cast<FixedContext<T>&>(context);
+    T *lane_masks = &ctx.lane_masks[0];
+    float *lane_params = &ctx.lane_params[0];
+    for (size_t first = 0; first < num_docs; first += num_lanes) {
+        size_t used_lanes = std::min(num_lanes, num_docs - first);
+        const float *doc_params = params + (first * num_params);
+        for (size_t i = 0; i < num_params; ++i) {
+            for (size_t lane = 0; lane < num_lanes; ++lane) {
+                lane_params[(i * num_lanes) + lane] = (lane < used_lanes)
+                    ? doc_params[(lane * num_params) + i]
+                    : std::numeric_limits<float>::quiet_NaN();
+            }
+        }
+        memset(lane_masks, 0xff, _num_trees * num_lanes * sizeof(T));
+        const Mask *mask_pos = &_masks[0];
+        for (size_t i = 0; i < num_params; ++i) {
+            const float *feature = lane_params + (i * num_lanes);
+            apply_lane_masks(lane_masks, feature, mask_pos, mask_pos + _mask_sizes[i]);
+            mask_pos += _mask_sizes[i];
+            for (size_t lane = 0; lane < used_lanes; ++lane) {
+                if (__builtin_expect(std::isnan(feature[lane]), false)) {
+                    const DMask *pos = &_default_masks[_default_offsets[i]];
+                    const DMask *end = &_default_masks[_default_offsets[i + 1]];
+                    for (; pos < end; ++pos) {
+                        lane_masks[(pos->tree * num_lanes) + lane] &= pos->bits;
+                    }
+                }
+            }
+        }
+        for (size_t lane = 0; lane < used_lanes; ++lane) {
+            results[first + lane] = get_lane_result(lane_masks, lane);
+        }
+    }
+}
+
 //-----------------------------------------------------------------------------
 // implementation using multiple words for each tree
 //-----------------------------------------------------------------------------
@@ -661,6 +757,15 @@ FastForest::try_convert(const Function &fun, size_t min_fixed, size_t max_fixed)
     return FastForest::UP();
 }
 
+void
+FastForest::eval_batch(Context &context, const float *params, size_t num_params,
+                       size_t num_docs, double *results) const
+{
+    for (size_t i = 0; i < num_docs; ++i) {
+        results[i] = eval(context, params + (i * num_params));
+    }
+}
+
 double
 FastForest::estimate_cost_us(const std::vector<double> &params, double budget) const
 {
@@ -36,6 +36,17 @@ public:
     virtual vespalib::string impl_name() const = 0;
     virtual Context::UP create_context() const = 0;
     virtual double eval(Context &context, const float *params) const = 0;
+
+    /**
+     * Evaluate the forest for multiple documents. The parameters for
+     * document i start at params[i * num_params] and the result for
+     * document i is stored in results[i]. The default implementation
+     * simply evaluates each document separately, while
+     * implementations able to evaluate multiple documents in
+     * parallel (in separate SIMD lanes) override it.
+     **/
+    virtual void eval_batch(Context &context, const float *params, size_t num_params,
+                            size_t num_docs, double *results) const;
     double estimate_cost_us(const std::vector<double> &params, double budget = 5.0) const;
 };
 
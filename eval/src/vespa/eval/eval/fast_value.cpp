@@ -0,0 +1,276 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "fast_value.h"
+#include <vespa/vespalib/stllike/hash_map.hpp>
+#include <vespa/vespalib/util/typify.h>
+
+namespace vespalib::eval {
+
+//-----------------------------------------------------------------------------
+
+namespace {
+
+struct CreateFastValueBuilderBase {
+    template <typename T> static std::unique_ptr<ValueBuilderBase> invoke(const ValueType &type,
+            size_t num_mapped_in, size_t subspace_size_in, size_t expect_subspaces)
+    {
+        assert(check_cell_type<T>(type.cell_type()));
+        return std::make_unique<FastValue<T>>(type, num_mapped_in, subspace_size_in, expect_subspaces);
+    }
+};
+
+void extract_labels(const FastValueIndex &index, size_t subspace, const std::vector<size_t> &dims,
+                    const std::vector<vespalib::stringref*> &addr_out)
+{
+    assert(addr_out.size() == dims.size());
+    const uint32_t *addr = index.addr(subspace);
+    for (size_t i = 0; i < dims.size(); ++i) {
+        *addr_out[i] = index.label(addr[dims[i]]);
+    }
+}
+
+// iterate all subspaces in the order they were added
+class FastFullScanView : public NewValue::Index::View {
+private:
+    const FastValueIndex &_index;
+    std::vector<size_t>   _all_dims;
+    size_t                _pos;
+public:
+    FastFullScanView(const FastValueIndex &index)
+        : _index(index), _all_dims(), _pos(index.size())
+    {
+        for (size_t i = 0; i < _index.num_mapped(); ++i) {
+            _all_dims.push_back(i);
+        }
+    }
+    void lookup(const std::vector<const vespalib::stringref*> &addr) override {
+        assert(addr.empty());
+        _pos = 0;
+    }
+    bool next_result(const std::vector<vespalib::stringref*> &addr_out, size_t &idx_out) override {
+        if (_pos < _index.size()) {
+            extract_labels(_index, _pos, _all_dims, addr_out);
+            idx_out = _pos++;
+            return true;
+        }
+        return false;
+    }
+};
+
+// look up a single subspace using all mapped dimensions
+class FastDirectView : public NewValue::Index::View {
+private:
+    const FastValueIndex &_index;
+    vespalib::string      _key;
+    uint32_t              _result;
+public:
+    FastDirectView(const FastValueIndex &index)
+        : _index(index), _key(), _result(FastValueIndex::npos) {}
+    void lookup(const std::vector<const vespalib::stringref*> &addr) override {
+        assert(addr.size() == _index.num_mapped());
+        _key.clear();
+        _result = FastValueIndex::npos;
+        for (const vespalib::stringref *label: addr) {
+            uint32_t label_id = _index.find_label(*label);
+            if (label_id == FastValueIndex::npos) {
+                return;
+            }
+            FastValueIndex::append_key(_key, label_id);
+        }
+        _result = _index.find_subspace(_key);
+    }
+    bool next_result(const std::vector<vespalib::stringref*> &addr_out, size_t &idx_out) override {
+        assert(addr_out.empty());
+        if (_result != FastValueIndex::npos) {
+            idx_out = _result;
+            _result = FastValueIndex::npos;
+            return true;
+        }
+        return false;
+    }
+};
+
+// look up subspaces matching a partial address using a hash map
+// (built up front) from the partial address to the first matching
+// subspace, where each subspace links to the next matching one
+class FastPartialView : public NewValue::Index::View {
+private:
+    const FastValueIndex                  &_index;
+    std::vector<size_t>                    _match_dims;
+    std::vector<size_t>                    _extract_dims;
+    hash_map<vespalib::string, uint32_t>   _first;
+    std::vector<uint32_t>                  _next;
+    vespalib::string                       _key;
+    uint32_t                               _pos;
+
+    void make_key(vespalib::string &key, size_t subspace) const {
+        key.clear();
+        const uint32_t *addr = _index.addr(subspace);
+        for (size_t dim: _match_dims) {
+            FastValueIndex::append_key(key, addr[dim]);
+        }
+    }
+
+public:
+    FastPartialView(const FastValueIndex &index, const std::vector<size_t> &match_dims)
+        : _index(index), _match_dims(match_dims), _extract_dims(), _first(),
+          _next(index.size(), FastValueIndex::npos), _key(), _pos(FastValueIndex::npos)
+    {
+        auto pos = _match_dims.begin();
+        for (size_t i = 0; i < _index.num_mapped(); ++i) {
+            if ((pos == _match_dims.end()) || (*pos != i)) {
+                _extract_dims.push_back(i);
+            } else {
+                ++pos;
+            }
+        }
+        assert(pos == _match_dims.end());
+        // insert backwards to make each chain start with the first subspace
+        for (size_t subspace = _index.size(); subspace-- > 0; ) {
+            make_key(_key, subspace);
+            auto res = _first.insert(std::make_pair(_key, uint32_t(subspace)));
+            if (!res.second) {
+                _next[subspace] = res.first->second;
+                res.first->second = subspace;
+            }
+        }
+    }
+    void lookup(const std::vector<const vespalib::stringref*> &addr) override {
+        assert(addr.size() == _match_dims.size());
+        _key.clear();
+        _pos = FastValueIndex::npos;
+        for (const vespalib::stringref *label: addr) {
+            uint32_t label_id = _index.find_label(*label);
+            if (label_id == FastValueIndex::npos) {
+                return;
+            }
+            FastValueIndex::append_key(_key, label_id);
+        }
+        auto pos = _first.find(_key);
+        if (pos != _first.end()) {
+            _pos = pos->second;
+        }
+    }
+    bool next_result(const std::vector<vespalib::stringref*> &addr_out, size_t &idx_out) override {
+        if (_pos != FastValueIndex::npos) {
+            extract_labels(_index, _pos, _extract_dims, addr_out);
+            idx_out = _pos;
+            _pos = _next[_pos];
+            return true;
+        }
+        return false;
+    }
+};
+
+}
+
+//-----------------------------------------------------------------------------
+
+FastValueIndex::FastValueIndex(size_t num_mapped_in, size_t expect_subspaces)
+    : _num_mapped(num_mapped_in),
+      _size(0),
+      _labels(),
+      _label_ids(),
+      _addr(),
+      _map(expect_subspaces * 2)
+{
+    _addr.reserve(_num_mapped * expect_subspaces);
+}
+
+FastValueIndex::~FastValueIndex() = default;
+
+uint32_t
+FastValueIndex::intern(vespalib::stringref label)
+{
+    auto res = _label_ids.insert(std::make_pair(vespalib::string(label), uint32_t(_labels.size())));
+    if (res.second) {
+        _labels.emplace_back(label);
+    }
+    return res.first->second;
+}
+
+uint32_t
+FastValueIndex::find_label(vespalib::stringref label) const
+{
+    auto pos = _label_ids.find(vespalib::string(label));
+    return (pos != _label_ids.end()) ? pos->second : npos;
+}
+
+uint32_t
+FastValueIndex::find_subspace(const vespalib::string &key) const
+{
+    auto pos = _map.find(key);
+    return (pos != _map.end()) ? pos->second : npos;
+}
+
+size_t
+FastValueIndex::add_mapping(const std::vector<vespalib::stringref> &addr)
+{
+    assert(addr.size() == _num_mapped);
+    vespalib::string key;
+    for (const auto &label: addr) {
+        uint32_t label_id = intern(label);
+        _addr.push_back(label_id);
+        append_key(key, label_id);
+    }
+    size_t subspace = _size++;
+    auto res = _map.insert(std::make_pair(key, uint32_t(subspace)));
+    assert(res.second);
+    return subspace;
+}
+
+std::unique_ptr<NewValue::Index::View>
+FastValueIndex::create_view(const std::vector<size_t> &dims) const
+{
+    if (dims.empty()) {
+        return std::make_unique<FastFullScanView>(*this);
+    } else if (dims.size() == _num_mapped) {
+        return std::make_unique<FastDirectView>(*this);
+    } else {
+        return std::make_unique<FastPartialView>(*this, dims);
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+template <typename T>
+FastValue<T>::FastValue(const ValueType &type, size_t num_mapped_in, size_t subspace_size_in, size_t expect_subspaces)
+    : _type(type),
+      _subspace_size(subspace_size_in),
+      _index(num_mapped_in, expect_subspaces),
+      _cells()
+{
+    assert(_type.count_mapped_dimensions() == num_mapped_in);
+    assert(_type.dense_subspace_size() == _subspace_size);
+    _cells.reserve(_subspace_size * expect_subspaces);
+}
+
+template <typename T>
+FastValue<T>::~FastValue() = default;
+
+template <typename T>
+ArrayRef<T>
+FastValue<T>::add_subspace(const std::vector<vespalib::stringref> &addr)
+{
+    size_t old_size = _cells.size();
+    size_t subspace = _index.add_mapping(addr);
+    assert(old_size == (subspace * _subspace_size));
+    _cells.resize(old_size + _subspace_size);
+    return ArrayRef<T>(&_cells[old_size], _subspace_size);
+}
+
+template class FastValue<float>;
+template class FastValue<double>;
+
+//-----------------------------------------------------------------------------
+
+std::unique_ptr<ValueBuilderBase>
+FastValueBuilderFactory::create_value_builder_base(const ValueType &type,
+                                                   size_t num_mapped_in, size_t subspace_size_in, size_t expect_subspaces) const
+{
+    return typify_invoke<1,TypifyCellType,CreateFastValueBuilderBase>(type.cell_type(), type, num_mapped_in, subspace_size_in, expect_subspaces);
+}
+
+//-----------------------------------------------------------------------------
+
+}
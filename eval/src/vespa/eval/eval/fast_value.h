@@ -0,0 +1,99 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include "simple_value.h"
+#include <vespa/vespalib/stllike/hash_map.h>
+
+namespace vespalib::eval {
+
+/**
+ * Index structure for FastValue. Labels are interned per value, and
+ * the address of each dense subspace is stored as a sequence of label
+ * ids. Full addresses are mapped to dense subspace indexes through a
+ * hash map keyed on the packed label ids. Views for partial addresses
+ * build a secondary hash map from the packed label ids of the looked
+ * up dimensions to a chain of matching subspaces.
+ **/
+class FastValueIndex : public NewValue::Index
+{
+private:
+    using LabelMap = hash_map<vespalib::string, uint32_t>;
+    using AddrMap = hash_map<vespalib::string, uint32_t>;
+
+    size_t                        _num_mapped;
+    size_t                        _size;
+    std::vector<vespalib::string> _labels;
+    LabelMap                      _label_ids;
+    std::vector<uint32_t>         _addr;
+    AddrMap                       _map;
+
+    uint32_t intern(vespalib::stringref label);
+
+public:
+    static constexpr uint32_t npos = -1;
+
+    FastValueIndex(size_t num_mapped_in, size_t expect_subspaces);
+    ~FastValueIndex() override;
+
+    // add the given address as a new subspace, returning its index
+    size_t add_mapping(const std::vector<vespalib::stringref> &addr);
+
+    // label id for the given label, or npos if not present in this value
+    uint32_t find_label(vespalib::stringref label) const;
+
+    // look up the subspace with the given packed label ids, or npos
+    uint32_t find_subspace(const vespalib::string &key) const;
+
+    size_t num_mapped() const { return _num_mapped; }
+    const vespalib::string &label(uint32_t id) const { return _labels[id]; }
+    const uint32_t *addr(size_t subspace) const { return &_addr[subspace * _num_mapped]; }
+
+    static void append_key(vespalib::string &key, uint32_t label_id) {
+        key.append(reinterpret_cast<const char *>(&label_id), sizeof(label_id));
+    }
+
+    size_t size() const override { return _size; }
+    std::unique_ptr<View> create_view(const std::vector<size_t> &dims) const override;
+};
+
+/**
+ * A generic value implementation focusing on speed, using
+ * FastValueIndex to map addresses to dense subspaces. Cells are
+ * stored as concatenated dense subspaces in a single array. A value
+ * is also able to build itself.
+ **/
+template <typename T>
+class FastValue : public NewValue, public ValueBuilder<T>
+{
+private:
+    ValueType      _type;
+    size_t         _subspace_size;
+    FastValueIndex _index;
+    std::vector<T> _cells;
+public:
+    FastValue(const ValueType &type, size_t num_mapped_in, size_t subspace_size_in, size_t expect_subspaces);
+    ~FastValue() override;
+    const ValueType &type() const override { return _type; }
+    const NewValue::Index &index() const override { return _index; }
+    TypedCells cells() const override { return TypedCells(ConstArrayRef<T>(_cells)); }
+    ArrayRef<T> add_subspace(const std::vector<vespalib::stringref> &addr) override;
+    std::unique_ptr<NewValue> build(std::unique_ptr<ValueBuilder<T>> self) override {
+        ValueBuilder<T>* me = this;
+        assert(me == self.get());
+        self.release();
+        return std::unique_ptr<NewValue>(this);
+    }
+};
+
+/**
+ * ValueBuilderFactory implementation for FastValue.
+ **/
+struct FastValueBuilderFactory : ValueBuilderFactory {
+    ~FastValueBuilderFactory() override {}
+protected:
+    std::unique_ptr<ValueBuilderBase> create_value_builder_base(const ValueType &type,
+            size_t num_mapped_in, size_t subspace_size_in, size_t expect_subspaces) const override;
+};
+
+}
@@ -32,13 +32,14 @@ const Function *get_lambda(const nodes::Node &node) {
 } // namespace vespalib::<unnamed>
 
 
-InterpretedFunction::State::State(const TensorEngine &engine_in)
+InterpretedFunction::State::State(const TensorEngine &engine_in, ThreadBundle *thread_bundle_in, size_t stash_chunk_size)
     : engine(engine_in),
       params(nullptr),
-      stash(),
+      stash(stash_chunk_size),
       stack(),
       program_offset(0),
-      if_cnt(0)
+      if_cnt(0),
+      thread_bundle(thread_bundle_in)
 {
 }
 
@@ -47,21 +48,29 @@ InterpretedFunction::State::~State() = default;
 void
 InterpretedFunction::State::init(const LazyParams &params_in) {
     params = &params_in;
-    stash.clear();
+    size_t allocated = stash.get_memory_usage().allocatedBytes();
+    if (allocated > stash.get_chunk_size()) {
+        // the previous evaluation did not fit in a single chunk; grow
+        // the stash to let later evaluations run without allocating
+        stash = Stash(4 * allocated);
+    } else {
+        stash.clear();
+    }
     stack.clear();
     program_offset = 0;
     if_cnt = 0;
 }
 
-InterpretedFunction::Context::Context(const InterpretedFunction &ifun)
-    : _state(ifun._tensor_engine)
+InterpretedFunction::Context::Context(const InterpretedFunction &ifun, ThreadBundle *thread_bundle)
+    : _state(ifun._tensor_engine, thread_bundle, ifun._stash_chunk_size)
 {
 }
 
 InterpretedFunction::InterpretedFunction(const TensorEngine &engine, const TensorFunction &function)
     : _program(),
       _stash(),
-      _tensor_engine(engine)
+      _tensor_engine(engine),
+      _stash_chunk_size(estimate_stash_chunk_size(function))
 {
     _program = compile_tensor_function(engine, function, _stash);
 }
@@ -69,11 +78,13 @@ InterpretedFunction::InterpretedFunction(const TensorEngine &engine, const Tenso
 InterpretedFunction::InterpretedFunction(const TensorEngine &engine, const nodes::Node &root, const NodeTypes &types)
     : _program(),
       _stash(),
-      _tensor_engine(engine)
+      _tensor_engine(engine),
+      _stash_chunk_size(0)
 {
     const TensorFunction &plain_fun = make_tensor_function(engine, root, types, _stash);
     const TensorFunction &optimized = engine.optimize(plain_fun, _stash);
     _program = compile_tensor_function(engine, optimized, _stash);
+    _stash_chunk_size = estimate_stash_chunk_size(optimized);
 }
 
 InterpretedFunction::~InterpretedFunction() = default;
@@ -7,6 +7,8 @@
 #include "lazy_params.h"
 #include <vespa/vespalib/util/stash.h>
 
+namespace vespalib { struct ThreadBundle; }
+
 namespace vespalib::eval {
 
 namespace nodes { struct Node; }
@@ -22,7 +24,13 @@ class TensorSpec;
  * run-time state related to the evaluation of an interpreted
  * function. The result of an evaluation is only valid until either
  * the context is destructed or the context is re-used to perform
- * another evaluation.
+ * another evaluation. The stash of a context is sized to hold all
+ * dense intermediate results of an evaluation, and grows if an
+ * evaluation did not fit, so that evaluations with dense tensors do
+ * not allocate heap memory once the context has been warmed up. A
+ * context may be given a thread bundle that will be used to split
+ * large dense tensor operations (like matrix multiplication) across
+ * multiple threads.
  **/
 class InterpretedFunction
 {
@@ -34,8 +42,9 @@ public:
         std::vector<Value::CREF> stack;
         uint32_t                 program_offset;
         uint32_t                 if_cnt;
+        ThreadBundle            *thread_bundle;
 
-        State(const TensorEngine &engine_in);
+        State(const TensorEngine &engine_in, ThreadBundle *thread_bundle_in, size_t stash_chunk_size);
         ~State();
 
         void init(const LazyParams &params_in);
@@ -59,7 +68,7 @@ public:
     private:
         State _state;
     public:
-        explicit Context(const InterpretedFunction &ifun);
+        explicit Context(const InterpretedFunction &ifun, ThreadBundle *thread_bundle = nullptr);
         uint32_t if_cnt() const { return _state.if_cnt; }
     };
     using op_function = void (*)(State &, uint64_t);
@@ -88,6 +97,7 @@ private:
     std::vector<Instruction> _program;
     Stash                    _stash;
     const TensorEngine      &_tensor_engine;
+    size_t                   _stash_chunk_size;
 
 public:
     typedef std::unique_ptr<InterpretedFunction> UP;
@@ -1,6 +1,7 @@
 // Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 
 #include "compile_cache.h"
+#include "disk_object_cache.h"
 #include <vespa/eval/eval/key_gen.h>
 #include <thread>
 
@@ -47,13 +48,13 @@ CompileCache::detach_executor(uint64_t tag)
                list.end());
 };
 
+template <typename... Args>
 CompileCache::Token::UP
-CompileCache::compile(const Function &function, PassParams pass_params)
+CompileCache::compile(Key key, const Function &function, Args &&...args)
 {
     Token::UP token;
     Executor::Task::UP task;
     std::shared_ptr<Executor> executor;
-    vespalib::string key = gen_key(function, pass_params);
     {
         std::lock_guard<std::mutex> guard(_lock);
         auto pos = _cached.find(key);
@@ -64,7 +65,7 @@ CompileCache::compile(const Function &function, PassParams pass_params)
             auto res = _cached.emplace(std::move(key), Value::ctor_tag());
             assert(res.second);
             token = std::make_unique<Token>(res.first, Token::ctor_tag());
-            task = std::make_unique<CompileTask>(function, pass_params, res.first->second.result);
+            task = std::make_unique<CompileTask>(function, std::forward<Args>(args)..., res.first->second.result);
             if (!_executor_stack.empty()) {
                 executor = _executor_stack.back().second;
             }
@@ -79,6 +80,26 @@ CompileCache::compile(const Function &function, PassParams pass_params)
     return token;
 }
 
+CompileCache::Token::UP
+CompileCache::compile(const Function &function, PassParams pass_params)
+{
+    return compile(gen_key(function, pass_params), function, pass_params);
+}
+
+CompileCache::Token::UP
+CompileCache::compile_cell_loop(const Function &function, const std::vector<size_t> &loop_cnt)
+{
+    vespalib::string key = "cell_loop:";
+    key.append(std::to_string(loop_cnt.size()));
+    for (size_t cnt: loop_cnt) {
+        key.append(",");
+        key.append(std::to_string(cnt));
+    }
+    key.append(":");
+    key.append(gen_key(function, PassParams::ARRAY));
+    return compile(std::move(key), function, loop_cnt);
+}
+
 void
 CompileCache::wait_pending()
 {
@@ -100,6 +121,12 @@ CompileCache::wait_pending()
     }
 }
 
+void
+CompileCache::set_disk_cache(std::shared_ptr<DiskObjectCache> cache)
+{
+    LLVMWrapper::set_object_cache(std::move(cache));
+}
+
 size_t
 CompileCache::num_cached()
 {
@@ -141,7 +168,9 @@ CompileCache::count_pending()
 void
 CompileCache::CompileTask::run()
 {
-    auto compiled = std::make_unique<CompiledFunction>(*function, pass_params);
+    auto compiled = cell_loop
+                    ? std::make_unique<CompiledFunction>(*function, loop_cnt)
+                    : std::make_unique<CompiledFunction>(*function, pass_params);
     std::lock_guard<std::mutex> guard(result->lock);
     result->compiled_function = std::move(compiled);
     result->cf.store(result->compiled_function.get(), std::memory_order_release);
@@ -11,6 +11,8 @@
 namespace vespalib {
 namespace eval {
 
+class DiskObjectCache;
+
 /**
  * A compilation cache used to reduce application configuration cost
  * by not having to compile equivalent expressions multiple times. The
@@ -90,10 +92,23 @@ public:
     };
 
     static Token::UP compile(const Function &function, PassParams pass_params);
+    /**
+     * Compile a function evaluating all cells of a dense tensor with
+     * the given dimension sizes (see CompiledFunction). The dimension
+     * sizes are part of the cache key.
+     **/
+    static Token::UP compile_cell_loop(const Function &function, const std::vector<size_t> &loop_cnt);
     static void wait_pending();
     static ExecutorBinding::UP bind(std::shared_ptr<Executor> executor) {
         return std::make_unique<ExecutorBinding>(std::move(executor), ExecutorBinding::ctor_tag());
     }
+    /**
+     * Use the given persistent cache of machine code when compiling
+     * functions, or stop using it when given an empty pointer. This
+     * makes it possible to skip the expensive code generation step
+     * for functions compiled by an earlier run of the process.
+     **/
+    static void set_disk_cache(std::shared_ptr<DiskObjectCache> cache);
     static size_t num_cached();
     static size_t num_bound();
     static size_t count_refs();
@@ -103,11 +118,19 @@ private:
     struct CompileTask : public Executor::Task {
         std::shared_ptr<Function const> function;
         PassParams pass_params;
+        bool cell_loop;
+        std::vector<size_t> loop_cnt;
         Result::SP result;
         CompileTask(const Function &function_in, PassParams pass_params_in, Result::SP result_in)
-            : function(function_in.shared_from_this()), pass_params(pass_params_in), result(std::move(result_in)) {}
+            : function(function_in.shared_from_this()), pass_params(pass_params_in),
+              cell_loop(false), loop_cnt(), result(std::move(result_in)) {}
+        CompileTask(const Function &function_in, const std::vector<size_t> &loop_cnt_in, Result::SP result_in)
+            : function(function_in.shared_from_this()), pass_params(PassParams::ARRAY),
+              cell_loop(true), loop_cnt(loop_cnt_in), result(std::move(result_in)) {}
         void run() override;
     };
+    template <typename... Args>
+    static Token::UP compile(Key key, const Function &function, Args &&...args);
 };
 
 } // namespace vespalib::eval
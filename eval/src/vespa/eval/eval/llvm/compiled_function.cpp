@@ -36,7 +36,8 @@ CompiledFunction::CompiledFunction(const nodes::Node &root_in, size_t num_params
     : _llvm_wrapper(),
       _address(nullptr),
       _num_params(num_params_in),
-      _pass_params(pass_params_in)
+      _pass_params(pass_params_in),
+      _cell_loop(false)
 {
     size_t id = _llvm_wrapper.make_function(num_params_in,
                                             _pass_params,
@@ -46,11 +47,24 @@ CompiledFunction::CompiledFunction(const nodes::Node &root_in, size_t num_params
     _address = _llvm_wrapper.get_function_address(id);
 }
 
+CompiledFunction::CompiledFunction(const Function &function_in, const std::vector<size_t> &loop_cnt)
+    : _llvm_wrapper(),
+      _address(nullptr),
+      _num_params(function_in.num_params()),
+      _pass_params(PassParams::ARRAY),
+      _cell_loop(true)
+{
+    size_t id = _llvm_wrapper.make_cell_loop_function(_num_params, loop_cnt, function_in.root());
+    _llvm_wrapper.compile();
+    _address = _llvm_wrapper.get_function_address(id);
+}
+
 CompiledFunction::CompiledFunction(CompiledFunction &&rhs)
     : _llvm_wrapper(std::move(rhs._llvm_wrapper)),
       _address(rhs._address),
       _num_params(rhs._num_params),
-      _pass_params(rhs._pass_params)
+      _pass_params(rhs._pass_params),
+      _cell_loop(rhs._cell_loop)
 {
     rhs._address = nullptr;
 }
@@ -59,6 +73,7 @@ double
 CompiledFunction::estimate_cost_us(const std::vector<double> &params, double budget) const
 {
     assert(params.size() == _num_params);
+    assert(!_cell_loop);
     if (_pass_params == PassParams::ARRAY) {
         auto function = get_function();
         auto empty = empty_array_function;
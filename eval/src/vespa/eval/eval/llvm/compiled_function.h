@@ -30,11 +30,15 @@ public:
     using resolve_function = LazyParams::resolve_function;
     using lazy_function = double (*)(resolve_function, void *ctx);
 
+    // evaluate all cells of a dense tensor (see cell loop constructor)
+    using cell_loop_function = void (*)(const double *params, double *dst);
+
 private:
     LLVMWrapper _llvm_wrapper;
     void       *_address;
     size_t      _num_params;
     PassParams  _pass_params;
+    bool        _cell_loop;
 
 public:
     typedef std::unique_ptr<CompiledFunction> UP;
@@ -46,6 +50,13 @@ public:
         : CompiledFunction(root_in, num_params_in, pass_params_in, gbdt::Optimize::best) {}
     CompiledFunction(const Function &function_in, PassParams pass_params_in)
         : CompiledFunction(function_in.root(), function_in.num_params(), pass_params_in, gbdt::Optimize::best) {}
+    /**
+     * Compile a function evaluating the given expression for all
+     * cells of a dense tensor with the given dimension sizes. The
+     * first loop_cnt.size() parameters are the cell labels, the rest
+     * are passed in an array (using their normal index).
+     **/
+    CompiledFunction(const Function &function_in, const std::vector<size_t> &loop_cnt);
     CompiledFunction(CompiledFunction &&rhs);
     size_t num_params() const { return _num_params; }
     PassParams pass_params() const { return _pass_params; }
@@ -57,8 +68,13 @@ public:
     }
     array_function get_function() const {
         assert(_pass_params == PassParams::ARRAY);
+        assert(!_cell_loop);
         return ((array_function)_address);
     }
+    cell_loop_function get_cell_loop_function() const {
+        assert(_cell_loop);
+        return ((cell_loop_function)_address);
+    }
     lazy_function get_lazy_function() const {
         assert(_pass_params == PassParams::LAZY);
         return ((lazy_function)_address);
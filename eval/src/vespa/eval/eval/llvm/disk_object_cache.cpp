@@ -0,0 +1,143 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "disk_object_cache.h"
+#include <vespa/vespalib/io/fileutil.h>
+#include <vespa/vespalib/stllike/hash_fun.h>
+#include <vespa/vespalib/util/stringfmt.h>
+#include <llvm/Config/llvm-config.h>
+#include <llvm/IR/Module.h>
+#include <llvm/Support/Host.h>
+#include <llvm/Support/MemoryBuffer.h>
+#include <llvm/Support/raw_ostream.h>
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <unistd.h>
+
+#include <vespa/log/log.h>
+LOG_SETUP(".eval.eval.llvm.disk_object_cache");
+
+namespace vespalib::eval {
+
+namespace {
+
+// file layout: <key size (uint64_t)> <key> <object>
+bool read_file(const vespalib::string &name, std::string &data) {
+    std::ifstream in(name.c_str(), std::ios::in | std::ios::binary);
+    if (!in) {
+        return false;
+    }
+    std::ostringstream buf;
+    buf << in.rdbuf();
+    data = buf.str();
+    return !in.bad();
+}
+
+bool write_file(const vespalib::string &name, const vespalib::string &key, llvm::StringRef obj) {
+    std::ofstream out(name.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+    uint64_t key_size = key.size();
+    out.write(reinterpret_cast<const char *>(&key_size), sizeof(key_size));
+    out.write(key.data(), key.size());
+    out.write(obj.data(), obj.size());
+    out.close();
+    return !out.fail();
+}
+
+} // namespace vespalib::eval::<unnamed>
+
+DiskObjectCache::DiskObjectCache(const vespalib::string &dir)
+    : _dir(dir),
+      _num_hits(0),
+      _num_misses(0),
+      _num_stored(0),
+      _tmp_cnt(0)
+{
+    try {
+        vespalib::mkdir(_dir, true);
+    } catch (const std::exception &e) {
+        LOG(warning, "could not create compiled expression cache directory '%s': %s", _dir.c_str(), e.what());
+    }
+}
+
+DiskObjectCache::~DiskObjectCache() = default;
+
+vespalib::string
+DiskObjectCache::target_id()
+{
+    vespalib::string id = "llvm:" LLVM_VERSION_STRING;
+    id += ";cpu:";
+    id += llvm::sys::getHostCPUName().str();
+    id += ";features:";
+    llvm::StringMap<bool> host_features;
+    if (llvm::sys::getHostCPUFeatures(host_features)) {
+        std::vector<std::string> features;
+        for (const auto &entry: host_features) {
+            if (entry.getValue()) {
+                features.push_back(entry.getKey().str());
+            }
+        }
+        std::sort(features.begin(), features.end());
+        for (const auto &feature: features) {
+            id += feature;
+            id += ",";
+        }
+    }
+    return id;
+}
+
+vespalib::string
+DiskObjectCache::make_key(const llvm::Module &module)
+{
+    std::string ir;
+    llvm::raw_string_ostream os(ir);
+    module.print(os, nullptr);
+    os.flush();
+    vespalib::string key = target_id();
+    key += "\n";
+    key += ir;
+    return key;
+}
+
+vespalib::string
+DiskObjectCache::file_name(const vespalib::string &key) const
+{
+    return vespalib::make_string("%s/%016zx.o", _dir.c_str(), vespalib::hashValue(key.data(), key.size()));
+}
+
+void
+DiskObjectCache::notifyObjectCompiled(const llvm::Module *module, llvm::MemoryBufferRef obj)
+{
+    vespalib::string key = make_key(*module);
+    vespalib::string name = file_name(key);
+    vespalib::string tmp_name = vespalib::make_string("%s.%d.%zu.tmp", name.c_str(), getpid(),
+                                                      _tmp_cnt.fetch_add(1, std::memory_order_relaxed));
+    if (write_file(tmp_name, key, obj.getBuffer()) && (std::rename(tmp_name.c_str(), name.c_str()) == 0)) {
+        _num_stored.fetch_add(1, std::memory_order_relaxed);
+    } else {
+        LOG(warning, "could not store compiled expression in '%s'", name.c_str());
+        std::remove(tmp_name.c_str());
+    }
+}
+
+std::unique_ptr<llvm::MemoryBuffer>
+DiskObjectCache::getObject(const llvm::Module *module)
+{
+    vespalib::string key = make_key(*module);
+    std::string data;
+    if (read_file(file_name(key), data) && (data.size() >= (sizeof(uint64_t) + key.size()))) {
+        uint64_t key_size;
+        memcpy(&key_size, data.data(), sizeof(key_size));
+        if ((key_size == key.size()) && (memcmp(data.data() + sizeof(key_size), key.data(), key.size()) == 0)) {
+            _num_hits.fetch_add(1, std::memory_order_relaxed);
+            size_t offset = sizeof(key_size) + key.size();
+            return llvm::MemoryBuffer::getMemBufferCopy(llvm::StringRef(data.data() + offset, data.size() - offset),
+                                                        module->getModuleIdentifier());
+        }
+    }
+    _num_misses.fetch_add(1, std::memory_order_relaxed);
+    return std::unique_ptr<llvm::MemoryBuffer>();
+}
+
+}
@@ -0,0 +1,60 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <vespa/vespalib/stllike/string.h>
+#include <llvm/ExecutionEngine/ObjectCache.h>
+#include <atomic>
+
+namespace vespalib::eval {
+
+/**
+ * Persistent cache of machine code produced by LLVM, used to avoid
+ * compiling the same ranking expressions again after a restart.
+ *
+ * Each compiled module is stored in a separate file inside the cache
+ * directory. The file name is a hash of the cache key, which is the
+ * textual IR of the module combined with the LLVM version and the
+ * host cpu name and features. The full key is stored together with
+ * the machine code and verified on lookup, so hash collisions and
+ * files produced by other builds or other hardware are treated as
+ * cache misses. Files are written to a temporary name and renamed
+ * into place, making it safe for multiple threads and processes to
+ * share the same cache directory.
+ *
+ * Only modules without references to process local state (like
+ * injected pointers to optimized forests) may be cached; this is
+ * checked by LLVMWrapper before using the cache.
+ **/
+class DiskObjectCache : public llvm::ObjectCache
+{
+private:
+    vespalib::string    _dir;
+    std::atomic<size_t> _num_hits;
+    std::atomic<size_t> _num_misses;
+    std::atomic<size_t> _num_stored;
+    std::atomic<size_t> _tmp_cnt;
+
+    static vespalib::string make_key(const llvm::Module &module);
+    vespalib::string file_name(const vespalib::string &key) const;
+
+public:
+    DiskObjectCache(const vespalib::string &dir);
+    ~DiskObjectCache() override;
+
+    /**
+     * Identify the LLVM version and the host cpu that machine code
+     * is produced for.
+     **/
+    static vespalib::string target_id();
+
+    void notifyObjectCompiled(const llvm::Module *module, llvm::MemoryBufferRef obj) override;
+    std::unique_ptr<llvm::MemoryBuffer> getObject(const llvm::Module *module) override;
+
+    const vespalib::string &dir() const { return _dir; }
+    size_t num_hits() const { return _num_hits.load(std::memory_order_relaxed); }
+    size_t num_misses() const { return _num_misses.load(std::memory_order_relaxed); }
+    size_t num_stored() const { return _num_stored.load(std::memory_order_relaxed); }
+};
+
+}
@@ -12,6 +12,10 @@
 #include <llvm/Analysis/Passes.h>
 #include <llvm/IR/DataLayout.h>
 #include <llvm/Transforms/Scalar.h>
+#include <llvm/IR/LegacyPassManager.h>
+#include <llvm/Analysis/TargetTransformInfo.h>
+#include <llvm/Support/Host.h>
+#include <llvm/Target/TargetMachine.h>
 #if LLVM_VERSION_MAJOR >= 9 && defined(__clang__)
 // Avoid reference to undefined symbol llvm::cfg::Update<llvm::BasicBlock*>::dump() const
 #define NDEBUG
@@ -84,6 +88,7 @@ struct FunctionBuilder : public NodeVisitor, public NodeTraverser {
     llvm::Module             &module;
     llvm::IRBuilder<>         builder;
     std::vector<llvm::Value*> params;
+    std::vector<llvm::Value*> loop_params;
     std::vector<llvm::Value*> values;
     llvm::Function           *function;
     size_t                    num_params;
@@ -149,11 +154,13 @@ struct FunctionBuilder : public NodeVisitor, public NodeTraverser {
                     PassParams pass_params_in,
                     const gbdt::Optimize::Chain &forest_optimizers_in,
                     std::vector<gbdt::Forest::UP> &forests_out,
-                    std::vector<PluginState::UP> &plugin_state_out)
+                    std::vector<PluginState::UP> &plugin_state_out,
+                    bool cell_loop = false)
         : context(context_in),
           module(module_in),
           builder(context),
           params(),
+          loop_params(),
           values(),
           function(nullptr),
           num_params(num_params_in),
@@ -165,7 +172,14 @@ struct FunctionBuilder : public NodeVisitor, public NodeTraverser {
           plugin_state(plugin_state_out)
     {
         std::vector<llvm::Type*> param_types;
-        if (pass_params == PassParams::SEPARATE) {
+        llvm::Type *result_type = builder.getDoubleTy();
+        if (cell_loop) {
+            // void (const double *params, double *dst)
+            assert(pass_params == PassParams::ARRAY);
+            param_types.push_back(builder.getDoubleTy()->getPointerTo());
+            param_types.push_back(builder.getDoubleTy()->getPointerTo());
+            result_type = builder.getVoidTy();
+        } else if (pass_params == PassParams::SEPARATE) {
             param_types.resize(num_params_in, builder.getDoubleTy());
         } else if (pass_params == PassParams::ARRAY) {
             param_types.push_back(builder.getDoubleTy()->getPointerTo());
@@ -174,9 +188,15 @@ struct FunctionBuilder : public NodeVisitor, public NodeTraverser {
             param_types.push_back(make_resolve_param_funptr_t());
             param_types.push_back(builder.getVoidTy()->getPointerTo());
         }
-        llvm::FunctionType *function_type = llvm::FunctionType::get(builder.getDoubleTy(), param_types, false);
+        llvm::FunctionType *function_type = llvm::FunctionType::get(result_type, param_types, false);
         function = llvm::Function::Create(function_type, llvm::Function::ExternalLinkage, name_in.c_str(), &module);
         function->addFnAttr(llvm::Attribute::AttrKind::NoInline);
+        if (cell_loop) {
+            // parameters are never written and cells are never read
+            function->addParamAttr(0, llvm::Attribute::AttrKind::NoAlias);
+            function->addParamAttr(0, llvm::Attribute::AttrKind::ReadOnly);
+            function->addParamAttr(1, llvm::Attribute::AttrKind::NoAlias);
+        }
         llvm::BasicBlock *block = llvm::BasicBlock::Create(context, "entry", function);
         builder.SetInsertPoint(block);
         for (llvm::Function::arg_iterator itr = function->arg_begin(); itr != function->arg_end(); ++itr) {
@@ -189,11 +209,14 @@ struct FunctionBuilder : public NodeVisitor, public NodeTraverser {
 
     llvm::Value *get_param(size_t idx) {
         assert(idx < num_params);
+        if (idx < loop_params.size()) {
+            return loop_params[idx];
+        }
         if (pass_params == PassParams::SEPARATE) {
             assert(idx < params.size());
             return params[idx];
         } else if (pass_params == PassParams::ARRAY) {
-            assert(params.size() == 1);
+            assert(!params.empty());
             llvm::Value *param_array = params[0];
             llvm::Value *addr = builder.CreateGEP(param_array, builder.getInt64(idx));
             return builder.CreateLoad(addr);
@@ -315,6 +338,42 @@ struct FunctionBuilder : public NodeVisitor, public NodeTraverser {
         inside_forest = false;
     }
 
+    // one nested loop per dimension; the innermost loop stores the
+    // value of the expression for each cell (row-major order)
+    void build_cell_loop(const Node &node, const std::vector<size_t> &loop_cnt, size_t dim, llvm::Value *offset) {
+        if (dim == loop_cnt.size()) {
+            node.traverse(*this);
+            llvm::Value *addr = builder.CreateGEP(params[1], offset);
+            builder.CreateStore(pop_double(), addr);
+            return;
+        }
+        llvm::BasicBlock *pre_block = builder.GetInsertBlock();
+        llvm::BasicBlock *loop_block = llvm::BasicBlock::Create(context, "loop", function);
+        llvm::BasicBlock *done_block = llvm::BasicBlock::Create(context, "loop_done", function);
+        builder.CreateBr(loop_block);
+        builder.SetInsertPoint(loop_block);
+        llvm::PHINode *idx = builder.CreatePHI(builder.getInt64Ty(), 2, "idx");
+        idx->addIncoming(builder.getInt64(0), pre_block);
+        loop_params[dim] = builder.CreateUIToFP(idx, builder.getDoubleTy(), "label");
+        llvm::Value *my_offset = builder.CreateAdd(builder.CreateMul(offset, builder.getInt64(loop_cnt[dim])), idx, "offset");
+        build_cell_loop(node, loop_cnt, dim + 1, my_offset);
+        llvm::Value *next = builder.CreateAdd(idx, builder.getInt64(1), "next_idx");
+        idx->addIncoming(next, builder.GetInsertBlock());
+        builder.CreateCondBr(builder.CreateICmpULT(next, builder.getInt64(loop_cnt[dim])), loop_block, done_block);
+        builder.SetInsertPoint(done_block);
+    }
+
+    llvm::Function *build_cell_loop(const Node &node, const std::vector<size_t> &loop_cnt) {
+        assert(loop_cnt.size() <= num_params);
+        assert(params.size() == 2);
+        loop_params.resize(loop_cnt.size(), nullptr);
+        build_cell_loop(node, loop_cnt, 0, builder.getInt64(0));
+        builder.CreateRetVoid();
+        assert(values.empty());
+        llvm::verifyFunction(*function);
+        return function;
+    }
+
     llvm::Function *build() {
         builder.CreateRet(pop_double());
         assert(values.empty());
@@ -655,6 +714,31 @@ struct FunctionBuilder : public NodeVisitor, public NodeTraverser {
 
 FunctionBuilder::~FunctionBuilder() { }
 
+// run the standard optimization pipeline with target specific cost
+// information, enabling the loop and slp vectorizers
+void optimize_module(llvm::Module &module, llvm::TargetMachine *target) {
+    llvm::legacy::FunctionPassManager function_passes(&module);
+    llvm::legacy::PassManager module_passes;
+    if (target != nullptr) {
+        function_passes.add(llvm::createTargetTransformInfoWrapperPass(target->getTargetIRAnalysis()));
+        module_passes.add(llvm::createTargetTransformInfoWrapperPass(target->getTargetIRAnalysis()));
+    }
+    llvm::PassManagerBuilder pass_builder;
+    pass_builder.OptLevel = 3;
+    pass_builder.LoopVectorize = true;
+    pass_builder.SLPVectorize = true;
+    pass_builder.populateFunctionPassManager(function_passes);
+    pass_builder.populateModulePassManager(module_passes);
+    function_passes.doInitialization();
+    for (llvm::Function &fun: module) {
+        if (!fun.isDeclaration()) {
+            function_passes.run(fun);
+        }
+    }
+    function_passes.doFinalization();
+    module_passes.run(module);
+}
+
 } // namespace vespalib::eval::<unnamed>
 
 struct InitializeNativeTarget {
@@ -675,13 +759,24 @@ struct InitializeNativeTarget {
     }
 } initialize_native_target;
 
+std::mutex LLVMWrapper::_object_cache_lock{};
+std::shared_ptr<llvm::ObjectCache> LLVMWrapper::_shared_object_cache{};
+
+void
+LLVMWrapper::set_object_cache(std::shared_ptr<llvm::ObjectCache> cache)
+{
+    std::lock_guard<std::mutex> guard(_object_cache_lock);
+    _shared_object_cache = std::move(cache);
+}
+
 LLVMWrapper::LLVMWrapper()
     : _context(),
       _module(),
       _engine(),
       _functions(),
       _forests(),
-      _plugin_state()
+      _plugin_state(),
+      _object_cache()
 {
     _context = std::make_unique<llvm::LLVMContext>();
     _module = std::make_unique<llvm::Module>("LLVMWrapper", *_context);
@@ -701,6 +796,18 @@ LLVMWrapper::make_function(size_t num_params, PassParams pass_params, const Node
     return function_id;
 }
 
+size_t
+LLVMWrapper::make_cell_loop_function(size_t num_params, const std::vector<size_t> &loop_cnt, const Node &root)
+{
+    size_t function_id = _functions.size();
+    FunctionBuilder builder(*_context, *_module,
+                            vespalib::make_string("f%zu", function_id),
+                            num_params, PassParams::ARRAY,
+                            gbdt::Optimize::none, _forests, _plugin_state, true);
+    _functions.push_back(builder.build_cell_loop(root, loop_cnt));
+    return function_id;
+}
+
 size_t
 LLVMWrapper::make_forest_fragment(size_t num_params, const std::vector<const Node *> &fragment)
 {
@@ -720,8 +827,21 @@ LLVMWrapper::compile(llvm::raw_ostream * dumpStream)
     if (dumpStream) {
         _module->print(*dumpStream, nullptr);
     }
-    _engine.reset(llvm::EngineBuilder(std::move(_module)).setOptLevel(llvm::CodeGenOpt::Aggressive).create());
+    llvm::Module *module = _module.get();
+    _engine.reset(llvm::EngineBuilder(std::move(_module))
+                  .setOptLevel(llvm::CodeGenOpt::Aggressive)
+                  .setMCPU(llvm::sys::getHostCPUName())
+                  .create());
     assert(_engine && "llvm jit not available for your platform");
+    optimize_module(*module, _engine->getTargetMachine());
+    if (_forests.empty() && _plugin_state.empty()) {
+        // generated code does not contain any process local pointers
+        std::lock_guard<std::mutex> guard(_object_cache_lock);
+        _object_cache = _shared_object_cache;
+    }
+    if (_object_cache) {
+        _engine->setObjectCache(_object_cache.get());
+    }
     _engine->finalizeObject();
 }
 
@@ -736,6 +856,7 @@ LLVMWrapper::~LLVMWrapper() {
     _forests.clear();
     _functions.clear();
     _engine.reset();
+    _object_cache.reset();
     _module.reset();
     _context.reset();
 }
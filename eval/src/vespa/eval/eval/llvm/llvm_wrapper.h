@@ -8,6 +8,7 @@
 #include <llvm/IR/LLVMContext.h>
 #include <llvm/IR/Module.h>
 #include <llvm/ExecutionEngine/ExecutionEngine.h>
+#include <llvm/ExecutionEngine/ObjectCache.h>
 #include <mutex>
 
 extern "C" {
@@ -48,14 +49,38 @@ private:
     std::vector<llvm::Function*>           _functions;
     std::vector<gbdt::Forest::UP>          _forests;
     std::vector<PluginState::UP>           _plugin_state;
+    std::shared_ptr<llvm::ObjectCache>     _object_cache;
+
+    static std::mutex                         _object_cache_lock;
+    static std::shared_ptr<llvm::ObjectCache> _shared_object_cache;
 
     void compile(llvm::raw_ostream * dumpStream);
 public:
+    /**
+     * Set the object cache used to look up previously produced
+     * machine code before compiling and to store newly produced
+     * machine code. Use an empty pointer to disable caching. Only
+     * functions that do not reference process local state (optimized
+     * forests or plugin state) will be cached.
+     **/
+    static void set_object_cache(std::shared_ptr<llvm::ObjectCache> cache);
+
     LLVMWrapper();
     LLVMWrapper(LLVMWrapper &&rhs) = default;
 
     size_t make_function(size_t num_params, PassParams pass_params, const nodes::Node &root,
                          const gbdt::Optimize::Chain &forest_optimizers);
+    /**
+     * Make a function with the signature 'void(const double *params,
+     * double *dst)' that evaluates the expression for all cells of a
+     * dense tensor with the given dimension sizes, storing the
+     * results in 'dst' in row-major order. The first loop_cnt.size()
+     * parameters of the expression are bound to the cell labels; the
+     * remaining ones are read from 'params' (using their normal
+     * index). Generating the cell loop together with the expression
+     * lets the optimizer vectorize across cells.
+     **/
+    size_t make_cell_loop_function(size_t num_params, const std::vector<size_t> &loop_cnt, const nodes::Node &root);
     size_t make_forest_fragment(size_t num_params, const std::vector<const nodes::Node *> &fragment);
     const std::vector<gbdt::Forest::UP> &get_forests() const { return _forests; }
     void compile(llvm::raw_ostream & dumpStream) { compile(&dumpStream); }
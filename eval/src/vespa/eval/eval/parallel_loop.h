@@ -0,0 +1,59 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <vespa/vespalib/util/runnable.h>
+#include <vespa/vespalib/util/thread_bundle.h>
+#include <algorithm>
+#include <type_traits>
+#include <vector>
+
+namespace vespalib::eval {
+
+/**
+ * Minimal amount of work (typically multiply-add operations) that
+ * needs to be done by each thread for a loop to be split across a
+ * thread bundle.
+ **/
+constexpr size_t min_parallel_work = 256 * 1024;
+
+/**
+ * Perform fun(begin, end) for consecutive non-overlapping ranges
+ * covering [0, num_items). The range is split across the given
+ * thread bundle (which may be nullptr) only if each part will
+ * perform at least min_parallel_work; otherwise fun(0, num_items)
+ * is called directly by the calling thread. 'fun' may be called by
+ * multiple threads at the same time and must only write to state
+ * that is specific to its range.
+ **/
+template <typename F>
+void parallel_loop(ThreadBundle *thread_bundle, size_t num_items, size_t work_per_item, F &&fun) {
+    size_t num_parts = 1;
+    if ((thread_bundle != nullptr) && (num_items > 1)) {
+        size_t total_work = num_items * work_per_item;
+        num_parts = std::min({thread_bundle->size(), num_items, total_work / min_parallel_work});
+    }
+    if (num_parts <= 1) {
+        fun(size_t(0), num_items);
+        return;
+    }
+    using Fun = std::remove_reference_t<F>;
+    struct Part : Runnable {
+        Fun *fun;
+        size_t begin;
+        size_t end;
+        Part(Fun *fun_in, size_t begin_in, size_t end_in) : fun(fun_in), begin(begin_in), end(end_in) {}
+        void run() override { (*fun)(begin, end); }
+    };
+    std::vector<Part> parts;
+    std::vector<Runnable*> targets;
+    parts.reserve(num_parts);
+    targets.reserve(num_parts);
+    for (size_t i = 0; i < num_parts; ++i) {
+        parts.emplace_back(&fun, (num_items * i) / num_parts, (num_items * (i + 1)) / num_parts);
+        targets.push_back(&parts.back());
+    }
+    thread_bundle->run(targets);
+}
+
+}
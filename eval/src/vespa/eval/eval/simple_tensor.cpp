@@ -24,11 +24,15 @@ namespace {
 
 constexpr uint32_t DOUBLE_CELL_TYPE = 0;
 constexpr uint32_t FLOAT_CELL_TYPE = 1;
+constexpr uint32_t BFLOAT16_CELL_TYPE = 2;
+constexpr uint32_t INT8_CELL_TYPE = 3;
 
 uint32_t cell_type_to_id(CellType cell_type) {
     switch (cell_type) {
     case CellType::DOUBLE: return DOUBLE_CELL_TYPE;
     case CellType::FLOAT: return FLOAT_CELL_TYPE;
+    case CellType::BFLOAT16: return BFLOAT16_CELL_TYPE;
+    case CellType::INT8: return INT8_CELL_TYPE;
     }
     abort();
 }
@@ -37,6 +41,8 @@ CellType id_to_cell_type(uint32_t id) {
     switch (id) {
     case DOUBLE_CELL_TYPE: return CellType::DOUBLE;
     case FLOAT_CELL_TYPE: return CellType::FLOAT;
+    case BFLOAT16_CELL_TYPE: return CellType::BFLOAT16;
+    case INT8_CELL_TYPE: return CellType::INT8;
     }
     abort();
 }
@@ -527,6 +533,26 @@ size_t maybe_decode_num_blocks(nbostream &input, const TypeMeta &meta, const For
     return 1;
 }
 
+void encode_cell(nbostream &output, CellType cell_type, double value) {
+    switch (cell_type) {
+    case CellType::DOUBLE: output << value; return;
+    case CellType::FLOAT: output << (float) value; return;
+    case CellType::INT8: output << (int8_t) value; return;
+    case CellType::BFLOAT16: output << BFloat16(value); return;
+    }
+    abort();
+}
+
+double decode_cell(nbostream &input, CellType cell_type) {
+    switch (cell_type) {
+    case CellType::DOUBLE: return input.readValue<double>();
+    case CellType::FLOAT: return input.readValue<float>();
+    case CellType::INT8: return input.readValue<int8_t>();
+    case CellType::BFLOAT16: return input.readValue<BFloat16>();
+    }
+    abort();
+}
+
 void decode_mapped_labels(nbostream &input, const TypeMeta &meta, Address &addr) {
     for (size_t idx: meta.mapped) {
         vespalib::string name;
@@ -545,10 +571,7 @@ void decode_cells(nbostream &input, const ValueType &type, const TypeMeta meta,
             decode_cells(input, type, meta, address, n + 1, builder);
         }
     } else {
-        double value = (meta.cell_type == CellType::FLOAT)
-                       ? input.readValue<float>()
-                       : input.readValue<double>();
-        builder.set(address, value);
+        builder.set(address, decode_cell(input, meta.cell_type));
     }
 }
 
@@ -601,7 +624,7 @@ SimpleTensor::map(map_fun_t function) const
     for (auto &cell: cells) {
         cell.value = function(cell.value);
     }
-    return std::make_unique<SimpleTensor>(_type, std::move(cells));
+    return std::make_unique<SimpleTensor>(_type.map(), std::move(cells));
 }
 
 std::unique_ptr<SimpleTensor>
@@ -744,11 +767,7 @@ SimpleTensor::encode(const SimpleTensor &tensor, nbostream &output)
         encode_mapped_labels(output, meta, block.begin()->get().address);
         View subview(block, meta.indexed);
         for (auto cell = subview.first_range(); !cell.empty(); cell = subview.next_range(cell)) {
-            if (meta.cell_type == CellType::FLOAT) {
-                output << (float) cell.begin()->get().value;
-            } else {
-                output << cell.begin()->get().value;
-            }
+            encode_cell(output, meta.cell_type, cell.begin()->get().value);
         }
     }
 }
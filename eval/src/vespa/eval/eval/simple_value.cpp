@@ -4,6 +4,9 @@
 #include "tensor_spec.h"
 #include <vespa/vespalib/util/stash.h>
 #include <vespa/vespalib/util/typify.h>
+#include <vespa/vespalib/util/overload.h>
+#include <vespa/vespalib/util/visit_ranges.h>
+#include <algorithm>
 
 #include <vespa/log/log.h>
 LOG_SETUP(".eval.simple_value");
@@ -41,7 +44,7 @@ struct CreateValueFromTensorSpec {
                     dense_key = (dense_key * dim.size) + pos->second.index;
                 }
             }
-            map[sparse_key][dense_key] = entry.second;
+            map[sparse_key][dense_key] = entry.second.value;
         }
         auto builder = factory.create_value_builder<T>(type, type.count_mapped_dimensions(), type.dense_subspace_size(), map.size());
         for (const auto &entry: map) {
@@ -166,6 +169,303 @@ public:
     }
 };
 
+using Dimension = ValueType::Dimension;
+
+std::vector<Dimension> select_dimensions(const ValueType &type, bool mapped) {
+    std::vector<Dimension> result;
+    for (const auto &dim: type.dimensions()) {
+        if (dim.is_mapped() == mapped) {
+            result.push_back(dim);
+        }
+    }
+    return result;
+}
+
+// Run nested loops over two dense subspaces at the same time, calling
+// f with the index of each cell pair.
+template <typename F>
+void run_nested_loop(size_t idx, size_t a, size_t b, const std::vector<size_t> &loop_cnt,
+                     const std::vector<size_t> &a_stride, const std::vector<size_t> &b_stride, const F &f)
+{
+    if (idx == loop_cnt.size()) {
+        f(a, b);
+    } else if ((idx + 1) == loop_cnt.size()) {
+        for (size_t i = 0; i < loop_cnt[idx]; ++i, a += a_stride[idx], b += b_stride[idx]) {
+            f(a, b);
+        }
+    } else {
+        for (size_t i = 0; i < loop_cnt[idx]; ++i, a += a_stride[idx], b += b_stride[idx]) {
+            run_nested_loop(idx + 1, a, b, loop_cnt, a_stride, b_stride, f);
+        }
+    }
+}
+
+// Describes how the dense subspaces of the join result are calculated
+// from the dense subspaces of the inputs. Dimensions present in the
+// same inputs are combined into a single loop, and dimensions missing
+// from an input get stride 0 for that input.
+struct DenseJoinPlan {
+    size_t lhs_size;
+    size_t rhs_size;
+    size_t out_size;
+    std::vector<size_t> loop_cnt;
+    std::vector<size_t> lhs_stride;
+    std::vector<size_t> rhs_stride;
+    DenseJoinPlan(const ValueType &lhs_type, const ValueType &rhs_type);
+    ~DenseJoinPlan();
+    template <typename F> void execute(size_t lhs, size_t rhs, const F &f) const {
+        run_nested_loop(0, lhs, rhs, loop_cnt, lhs_stride, rhs_stride, f);
+    }
+};
+
+DenseJoinPlan::DenseJoinPlan(const ValueType &lhs_type, const ValueType &rhs_type)
+    : lhs_size(1), rhs_size(1), out_size(1), loop_cnt(), lhs_stride(), rhs_stride()
+{
+    enum class Case { NONE, LHS, RHS, BOTH };
+    Case prev_case = Case::NONE;
+    auto update_plan = [&](Case my_case, size_t my_size, size_t in_lhs, size_t in_rhs) {
+        if (my_case == prev_case) {
+            assert(!loop_cnt.empty());
+            loop_cnt.back() *= my_size;
+        } else {
+            loop_cnt.push_back(my_size);
+            lhs_stride.push_back(in_lhs);
+            rhs_stride.push_back(in_rhs);
+            prev_case = my_case;
+        }
+    };
+    auto visitor = overload
+                   {
+                       [&](visit_ranges_first, const auto &a) { update_plan(Case::LHS, a.size, 1, 0); },
+                       [&](visit_ranges_second, const auto &b) { update_plan(Case::RHS, b.size, 0, 1); },
+                       [&](visit_ranges_both, const auto &a, const auto &) { update_plan(Case::BOTH, a.size, 1, 1); }
+                   };
+    auto lhs_dims = select_dimensions(lhs_type, false);
+    auto rhs_dims = select_dimensions(rhs_type, false);
+    visit_ranges(visitor, lhs_dims.begin(), lhs_dims.end(), rhs_dims.begin(), rhs_dims.end(),
+                 [](const auto &a, const auto &b){ return (a.name < b.name); });
+    for (size_t i = loop_cnt.size(); i-- > 0; ) {
+        out_size *= loop_cnt[i];
+        if (lhs_stride[i] != 0) {
+            lhs_stride[i] = lhs_size;
+            lhs_size *= loop_cnt[i];
+        }
+        if (rhs_stride[i] != 0) {
+            rhs_stride[i] = rhs_size;
+            rhs_size *= loop_cnt[i];
+        }
+    }
+}
+
+DenseJoinPlan::~DenseJoinPlan() = default;
+
+// Describes how the mapped dimensions of the join result are
+// assembled from the mapped dimensions of the inputs. Subspaces of
+// the left input are visited with a full scan, and matching subspaces
+// of the right input are found by looking up the overlapping
+// dimensions.
+struct SparseJoinPlan {
+    enum class Source { LHS, RHS, BOTH };
+    std::vector<Source> sources;
+    std::vector<size_t> lhs_overlap;
+    std::vector<size_t> rhs_overlap;
+    SparseJoinPlan(const ValueType &lhs_type, const ValueType &rhs_type);
+    ~SparseJoinPlan();
+};
+
+SparseJoinPlan::SparseJoinPlan(const ValueType &lhs_type, const ValueType &rhs_type)
+    : sources(), lhs_overlap(), rhs_overlap()
+{
+    size_t lhs_idx = 0;
+    size_t rhs_idx = 0;
+    auto visitor = overload
+                   {
+                       [&](visit_ranges_first, const auto &) {
+                           sources.push_back(Source::LHS);
+                           ++lhs_idx;
+                       },
+                       [&](visit_ranges_second, const auto &) {
+                           sources.push_back(Source::RHS);
+                           ++rhs_idx;
+                       },
+                       [&](visit_ranges_both, const auto &, const auto &) {
+                           sources.push_back(Source::BOTH);
+                           lhs_overlap.push_back(lhs_idx++);
+                           rhs_overlap.push_back(rhs_idx++);
+                       }
+                   };
+    auto lhs_dims = select_dimensions(lhs_type, true);
+    auto rhs_dims = select_dimensions(rhs_type, true);
+    visit_ranges(visitor, lhs_dims.begin(), lhs_dims.end(), rhs_dims.begin(), rhs_dims.end(),
+                 [](const auto &a, const auto &b){ return (a.name < b.name); });
+}
+
+SparseJoinPlan::~SparseJoinPlan() = default;
+
+struct GenericJoin {
+    template <typename LCT, typename RCT, typename OCT>
+    static std::unique_ptr<NewValue> invoke(const NewValue &a, const NewValue &b, const ValueType &res_type,
+                                            const SparseJoinPlan &sparse_plan, const DenseJoinPlan &dense_plan,
+                                            join_fun_t function, const ValueBuilderFactory &factory)
+    {
+        auto lhs_cells = a.cells().typify<LCT>();
+        auto rhs_cells = b.cells().typify<RCT>();
+        size_t num_lhs_mapped = a.type().count_mapped_dimensions();
+        size_t num_rhs_mapped = b.type().count_mapped_dimensions();
+        size_t num_rhs_extract = (num_rhs_mapped - sparse_plan.rhs_overlap.size());
+        auto builder = factory.create_value_builder<OCT>(res_type, sparse_plan.sources.size(), dense_plan.out_size,
+                                                         std::max(a.index().size(), b.index().size()));
+        std::vector<vespalib::stringref> lhs_addr(num_lhs_mapped);
+        std::vector<vespalib::stringref*> lhs_addr_refs;
+        for (auto &label: lhs_addr) {
+            lhs_addr_refs.push_back(&label);
+        }
+        std::vector<const vespalib::stringref*> rhs_query;
+        for (size_t idx: sparse_plan.lhs_overlap) {
+            rhs_query.push_back(&lhs_addr[idx]);
+        }
+        std::vector<vespalib::stringref> rhs_addr(num_rhs_extract);
+        std::vector<vespalib::stringref*> rhs_addr_refs;
+        for (auto &label: rhs_addr) {
+            rhs_addr_refs.push_back(&label);
+        }
+        std::vector<vespalib::stringref> res_addr(sparse_plan.sources.size());
+        auto outer = a.index().create_view({});
+        auto inner = b.index().create_view(sparse_plan.rhs_overlap);
+        size_t lhs_subspace;
+        size_t rhs_subspace;
+        outer->lookup({});
+        while (outer->next_result(lhs_addr_refs, lhs_subspace)) {
+            inner->lookup(rhs_query);
+            while (inner->next_result(rhs_addr_refs, rhs_subspace)) {
+                size_t lhs_idx = 0;
+                size_t rhs_idx = 0;
+                for (size_t i = 0; i < res_addr.size(); ++i) {
+                    switch (sparse_plan.sources[i]) {
+                    case SparseJoinPlan::Source::LHS:
+                    case SparseJoinPlan::Source::BOTH:
+                        res_addr[i] = lhs_addr[lhs_idx++];
+                        break;
+                    case SparseJoinPlan::Source::RHS:
+                        res_addr[i] = rhs_addr[rhs_idx++];
+                        break;
+                    }
+                }
+                OCT *dst = builder->add_subspace(res_addr).begin();
+                dense_plan.execute(lhs_subspace * dense_plan.lhs_size, rhs_subspace * dense_plan.rhs_size,
+                                   [&](size_t lhs_idx_in, size_t rhs_idx_in) {
+                                       *dst++ = function(lhs_cells[lhs_idx_in], rhs_cells[rhs_idx_in]);
+                                   });
+            }
+        }
+        return builder->build(std::move(builder));
+    }
+};
+
+// Describes how the cells of a dense subspace are reduced into the
+// cells of the dense subspace of the result. Dimensions that are
+// either all kept or all reduced are combined into a single loop, and
+// reduced dimensions get output stride 0.
+struct DenseReducePlan {
+    size_t in_size;
+    size_t out_size;
+    std::vector<size_t> loop_cnt;
+    std::vector<size_t> in_stride;
+    std::vector<size_t> out_stride;
+    DenseReducePlan(const ValueType &type, const ValueType &res_type);
+    ~DenseReducePlan();
+    template <typename F> void execute(size_t in, const F &f) const {
+        run_nested_loop(0, in, 0, loop_cnt, in_stride, out_stride, f);
+    }
+};
+
+DenseReducePlan::DenseReducePlan(const ValueType &type, const ValueType &res_type)
+    : in_size(1), out_size(1), loop_cnt(), in_stride(), out_stride()
+{
+    std::vector<bool> keep;
+    for (const auto &dim: select_dimensions(type, false)) {
+        bool my_keep = (res_type.dimension_index(dim.name) != ValueType::Dimension::npos);
+        if (!keep.empty() && (keep.back() == my_keep)) {
+            loop_cnt.back() *= dim.size;
+        } else {
+            keep.push_back(my_keep);
+            loop_cnt.push_back(dim.size);
+        }
+    }
+    in_stride.resize(loop_cnt.size());
+    out_stride.resize(loop_cnt.size());
+    for (size_t i = loop_cnt.size(); i-- > 0; ) {
+        in_stride[i] = in_size;
+        in_size *= loop_cnt[i];
+        if (keep[i]) {
+            out_stride[i] = out_size;
+            out_size *= loop_cnt[i];
+        } else {
+            out_stride[i] = 0;
+        }
+    }
+}
+
+DenseReducePlan::~DenseReducePlan() = default;
+
+struct GenericReduce {
+    template <typename ICT, typename OCT, typename AGGR>
+    static std::unique_ptr<NewValue> invoke(const NewValue &a, const ValueType &res_type,
+                                            const std::vector<size_t> &keep_dims, const DenseReducePlan &dense_plan,
+                                            const ValueBuilderFactory &factory)
+    {
+        using MyAggr = typename AGGR::template templ<double>;
+        using SparseKey = std::vector<vespalib::stringref>;
+        auto cells = a.cells().typify<ICT>();
+        size_t num_mapped = a.type().count_mapped_dimensions();
+        std::vector<vespalib::stringref> addr(num_mapped);
+        std::vector<vespalib::stringref*> addr_refs;
+        for (auto &label: addr) {
+            addr_refs.push_back(&label);
+        }
+        // group input subspaces on the labels of the kept dimensions
+        std::map<SparseKey,std::vector<size_t>> groups;
+        SparseKey key(keep_dims.size());
+        size_t subspace;
+        auto view = a.index().create_view({});
+        view->lookup({});
+        while (view->next_result(addr_refs, subspace)) {
+            for (size_t i = 0; i < keep_dims.size(); ++i) {
+                key[i] = addr[keep_dims[i]];
+            }
+            groups[key].push_back(subspace);
+        }
+        auto builder = factory.create_value_builder<OCT>(res_type, keep_dims.size(), dense_plan.out_size,
+                                                         std::max(groups.size(), size_t(1)));
+        std::vector<MyAggr> aggrs(dense_plan.out_size);
+        std::vector<bool> seen(dense_plan.out_size);
+        for (const auto &group: groups) {
+            std::fill(seen.begin(), seen.end(), false);
+            for (size_t my_subspace: group.second) {
+                dense_plan.execute(my_subspace * dense_plan.in_size, [&](size_t in_idx, size_t out_idx) {
+                                       if (seen[out_idx]) {
+                                           aggrs[out_idx].next(cells[in_idx]);
+                                       } else {
+                                           aggrs[out_idx].first(cells[in_idx]);
+                                           seen[out_idx] = true;
+                                       }
+                                   });
+            }
+            auto dst = builder->add_subspace(group.first);
+            for (size_t i = 0; i < dst.size(); ++i) {
+                dst[i] = aggrs[i].result();
+            }
+        }
+        if (groups.empty() && keep_dims.empty()) {
+            // reducing an empty value into a value without mapped
+            // dimensions still produces a single (zero) subspace
+            auto dst = builder->add_subspace({});
+            std::fill(dst.begin(), dst.end(), OCT(0.0));
+        }
+        return builder->build(std::move(builder));
+    }
+};
+
 }
 
 //-----------------------------------------------------------------------------
@@ -235,11 +535,32 @@ SimpleValueBuilderFactory::create_value_builder_base(const ValueType &type,
 //-----------------------------------------------------------------------------
 
 std::unique_ptr<NewValue> new_join(const NewValue &a, const NewValue &b, join_fun_t function, const ValueBuilderFactory &factory) {
-    (void) a;
-    (void) b;
-    (void) function;
-    (void) factory;
-    return std::unique_ptr<NewValue>(nullptr);
+    ValueType res_type = ValueType::join(a.type(), b.type());
+    assert(!res_type.is_error());
+    SparseJoinPlan sparse_plan(a.type(), b.type());
+    DenseJoinPlan dense_plan(a.type(), b.type());
+    return typify_invoke<3,TypifyCellType,GenericJoin>(a.type().cell_type(), b.type().cell_type(), res_type.cell_type(),
+                                                       a, b, res_type, sparse_plan, dense_plan, function, factory);
+}
+
+//-----------------------------------------------------------------------------
+
+std::unique_ptr<NewValue> new_reduce(const NewValue &a, Aggr aggr, const std::vector<vespalib::string> &dimensions, const ValueBuilderFactory &factory) {
+    ValueType res_type = a.type().reduce(dimensions);
+    assert(!res_type.is_error());
+    std::vector<size_t> keep_dims;
+    size_t mapped_idx = 0;
+    for (const auto &dim: a.type().dimensions()) {
+        if (dim.is_mapped()) {
+            if (res_type.dimension_index(dim.name) != ValueType::Dimension::npos) {
+                keep_dims.push_back(mapped_idx);
+            }
+            ++mapped_idx;
+        }
+    }
+    DenseReducePlan dense_plan(a.type(), res_type);
+    return typify_invoke<3,TypifyValue<TypifyCellType,TypifyAggr>,GenericReduce>(a.type().cell_type(), res_type.cell_type(), aggr,
+                                                                                  a, res_type, keep_dims, dense_plan, factory);
 }
 
 //-----------------------------------------------------------------------------
@@ -4,6 +4,7 @@
 
 #include "value.h"
 #include "value_type.h"
+#include "aggr.h"
 #include <vespa/eval/tensor/dense/typed_cells.h>
 #include <vespa/vespalib/stllike/string.h>
 #include <vector>
@@ -201,6 +202,13 @@ protected:
 using join_fun_t = double (*)(double, double);
 std::unique_ptr<NewValue> new_join(const NewValue &a, const NewValue &b, join_fun_t function, const ValueBuilderFactory &factory);
 
+/**
+ * Generic reduce operation treating the value as a mixed
+ * tensor. Reducing all dimensions (by giving an empty list of
+ * dimensions) results in a value of type double.
+ **/
+std::unique_ptr<NewValue> new_reduce(const NewValue &a, Aggr aggr, const std::vector<vespalib::string> &dimensions, const ValueBuilderFactory &factory);
+
 /**
  * Make a value from a tensor spec using a value builder factory
  * interface, making it work with any value implementation.
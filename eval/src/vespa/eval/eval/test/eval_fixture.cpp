@@ -195,7 +195,8 @@ EvalFixture::EvalFixture(const TensorEngine &engine,
                          const vespalib::string &expr,
                          const ParamRepo &param_repo,
                          bool optimized,
-                         bool allow_mutable)
+                         bool allow_mutable,
+                         ThreadBundle *thread_bundle)
     : _engine(engine),
       _stash(),
       _function(verify_function(Function::parse(expr))),
@@ -205,7 +206,7 @@ EvalFixture::EvalFixture(const TensorEngine &engine,
       _patched_tensor_function(maybe_patch(allow_mutable, _plain_tensor_function, _mutable_set, _stash)),
       _tensor_function(optimized ? _engine.optimize(_patched_tensor_function, _stash) : _patched_tensor_function),
       _ifun(_engine, _tensor_function),
-      _ictx(_ifun),
+      _ictx(_ifun, thread_bundle),
       _param_values(make_params(_engine, *_function, param_repo)),
       _params(get_refs(_param_values)),
       _result(_engine.to_spec(_ifun.eval(_ictx, _params)))
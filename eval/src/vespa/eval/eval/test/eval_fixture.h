@@ -75,7 +75,7 @@ private:
 
 public:
     EvalFixture(const TensorEngine &engine, const vespalib::string &expr, const ParamRepo &param_repo,
-                bool optimized = true, bool allow_mutable = false);
+                bool optimized = true, bool allow_mutable = false, ThreadBundle *thread_bundle = nullptr);
     ~EvalFixture() {}
     template <typename T>
     std::vector<const T *> find_all() {
@@ -23,6 +23,8 @@ CellType unify(CellType b) {
     switch (b) {
     case CellType::DOUBLE: return unify<A,double>();
     case CellType::FLOAT: return unify<A,float>();
+    case CellType::INT8: return unify<A,int8_t>();
+    case CellType::BFLOAT16: return unify<A,BFloat16>();
     }
     abort();
 }
@@ -31,6 +33,8 @@ CellType unify(CellType a, CellType b) {
     switch (a) {
     case CellType::DOUBLE: return unify<double>(b);
     case CellType::FLOAT: return unify<float>(b);
+    case CellType::INT8: return unify<int8_t>(b);
+    case CellType::BFLOAT16: return unify<BFloat16>(b);
     }
     abort();
 }
@@ -223,6 +227,27 @@ ValueType::dimension_names() const
     return result;
 }
 
+size_t
+ValueType::cell_size(CellType cell_type)
+{
+    switch (cell_type) {
+    case CellType::DOUBLE: return sizeof(double);
+    case CellType::FLOAT: return sizeof(float);
+    case CellType::INT8: return sizeof(int8_t);
+    case CellType::BFLOAT16: return sizeof(BFloat16);
+    }
+    abort();
+}
+
+ValueType
+ValueType::map() const
+{
+    if (is_storage_cell_type(_cell_type)) {
+        return ValueType(_type, decay_cell_type(_cell_type), std::vector<Dimension>(_dimensions));
+    }
+    return *this;
+}
+
 ValueType
 ValueType::reduce(const std::vector<vespalib::string> &dimensions_in) const
 {
@@ -243,7 +268,7 @@ ValueType::reduce(const std::vector<vespalib::string> &dimensions_in) const
     if (removed != dimensions_in.size()) {
         return error_type();
     }
-    return tensor_type(std::move(result), _cell_type);
+    return tensor_type(std::move(result), decay_cell_type(_cell_type));
 }
 
 ValueType
@@ -301,9 +326,9 @@ ValueType::join(const ValueType &lhs, const ValueType &rhs)
     if (lhs.is_error() || rhs.is_error()) {
         return error_type();
     } else if (lhs.is_double()) {
-        return rhs;
+        return rhs.map();
     } else if (rhs.is_double()) {
-        return lhs;
+        return lhs.map();
     }
     MyJoin result(lhs._dimensions, rhs._dimensions);
     if (result.mismatch) {
@@ -329,9 +354,9 @@ ValueType::merge(const ValueType &lhs, const ValueType &rhs)
 CellType
 ValueType::unify_cell_types(const ValueType &a, const ValueType &b) {
     if (a.is_double()) {
-        return b.cell_type();
+        return decay_cell_type(b.cell_type());
     } else if (b.is_double()) {
-        return a.cell_type();
+        return decay_cell_type(a.cell_type());
     }
     return unify(a.cell_type(), b.cell_type());
 }
@@ -2,6 +2,7 @@
 
 #pragma once
 
+#include <vespa/vespalib/util/bfloat16.h>
 #include <vespa/vespalib/util/typify.h>
 #include <vespa/vespalib/stllike/string.h>
 #include <vector>
@@ -17,7 +18,9 @@ class ValueType
 {
 public:
     enum class Type { ERROR, DOUBLE, TENSOR };
-    enum class CellType : char { FLOAT, DOUBLE };
+    // INT8 and BFLOAT16 are storage-only cell types; computing with
+    // them (map, join, reduce, ...) produces float cells.
+    enum class CellType : char { FLOAT, DOUBLE, INT8, BFLOAT16 };
     struct Dimension {
         using size_type = uint32_t;
         static constexpr size_type npos = -1;
@@ -73,6 +76,15 @@ public:
     }
     bool operator!=(const ValueType &rhs) const { return !(*this == rhs); }
 
+    static bool is_storage_cell_type(CellType cell_type) {
+        return ((cell_type == CellType::INT8) || (cell_type == CellType::BFLOAT16));
+    }
+    static CellType decay_cell_type(CellType cell_type) {
+        return is_storage_cell_type(cell_type) ? CellType::FLOAT : cell_type;
+    }
+    static size_t cell_size(CellType cell_type);
+
+    ValueType map() const;
     ValueType reduce(const std::vector<vespalib::string> &dimensions_in) const;
     ValueType rename(const std::vector<vespalib::string> &from,
                      const std::vector<vespalib::string> &to) const;
@@ -97,8 +109,18 @@ std::ostream &operator<<(std::ostream &os, const ValueType &type);
 template <typename CT> inline bool check_cell_type(ValueType::CellType type);
 template <> inline bool check_cell_type<double>(ValueType::CellType type) { return (type == ValueType::CellType::DOUBLE); }
 template <> inline bool check_cell_type<float>(ValueType::CellType type) { return (type == ValueType::CellType::FLOAT); }
+template <> inline bool check_cell_type<int8_t>(ValueType::CellType type) { return (type == ValueType::CellType::INT8); }
+template <> inline bool check_cell_type<BFloat16>(ValueType::CellType type) { return (type == ValueType::CellType::BFLOAT16); }
+
+// storage-only cell types are promoted to float before computing
+template <typename CT> struct DecayCellType { using type = CT; };
+template <> struct DecayCellType<int8_t>   { using type = float; };
+template <> struct DecayCellType<BFloat16> { using type = float; };
 
-template <typename LCT, typename RCT> struct UnifyCellTypes{};
+template <typename LCT, typename RCT> struct UnifyCellTypes {
+    using type = typename UnifyCellTypes<typename DecayCellType<LCT>::type,
+                                         typename DecayCellType<RCT>::type>::type;
+};
 template <> struct UnifyCellTypes<double, double> { using type = double; };
 template <> struct UnifyCellTypes<double, float>  { using type = double; };
 template <> struct UnifyCellTypes<float,  double> { using type = double; };
@@ -107,13 +129,32 @@ template <> struct UnifyCellTypes<float,  float>  { using type = float; };
 template <typename CT> inline ValueType::CellType get_cell_type();
 template <> inline ValueType::CellType get_cell_type<double>() { return ValueType::CellType::DOUBLE; }
 template <> inline ValueType::CellType get_cell_type<float>() { return ValueType::CellType::FLOAT; }
+template <> inline ValueType::CellType get_cell_type<int8_t>() { return ValueType::CellType::INT8; }
+template <> inline ValueType::CellType get_cell_type<BFloat16>() { return ValueType::CellType::BFLOAT16; }
 
+// all cell types
 struct TypifyCellType {
     template <typename T> using Result = TypifyResultType<T>;
     template <typename F> static decltype(auto) resolve(ValueType::CellType value, F &&f) {
         switch(value) {
         case ValueType::CellType::DOUBLE: return f(Result<double>());
         case ValueType::CellType::FLOAT:  return f(Result<float>());
+        case ValueType::CellType::INT8:   return f(Result<int8_t>());
+        case ValueType::CellType::BFLOAT16: return f(Result<BFloat16>());
+        }
+        abort();
+    }
+};
+
+// only the cell types produced by computation (float and double);
+// used by optimizations that do not handle storage-only cell types
+struct TypifyComputeCellType {
+    template <typename T> using Result = TypifyResultType<T>;
+    template <typename F> static decltype(auto) resolve(ValueType::CellType value, F &&f) {
+        switch(value) {
+        case ValueType::CellType::DOUBLE: return f(Result<double>());
+        case ValueType::CellType::FLOAT:  return f(Result<float>());
+        default: break;
         }
         abort();
     }
@@ -12,6 +12,7 @@
 #include "dense/dense_xw_product_function.h"
 #include "dense/dense_matmul_function.h"
 #include "dense/dense_multi_matmul_function.h"
+#include "dense/dense_fused_reduce_function.h"
 #include "dense/dense_fast_rename_optimizer.h"
 #include "dense/dense_add_dimension_optimizer.h"
 #include "dense/dense_single_reduce_function.h"
@@ -26,6 +27,7 @@
 #include "dense/vector_from_doubles_function.h"
 #include "dense/dense_tensor_create_function.h"
 #include "dense/dense_tensor_peek_function.h"
+#include "sparse/sparse_dot_product_function.h"
 #include <vespa/eval/eval/value.h>
 #include <vespa/eval/eval/tensor_spec.h>
 #include <vespa/eval/eval/tensor_spec.h>
@@ -187,7 +189,7 @@ struct CallDenseTensorBuilder {
             if (cell_idx == UNDEFINED_IDX) {
                 bad_spec(spec);
             }
-            builder.insertCell(cell_idx, cell.second);
+            builder.insertCell(cell_idx, cell.second.value);
         }
         return builder.build();
     }
@@ -276,9 +278,11 @@ DefaultTensorEngine::optimize(const TensorFunction &expr, Stash &stash) const
         while (!nodes.empty()) {
             const Child &child = nodes.back().get();
             child.set(DenseDotProductFunction::optimize(child.get(), stash));
+            child.set(SparseDotProductFunction::optimize(child.get(), stash));
             child.set(DenseXWProductFunction::optimize(child.get(), stash));
             child.set(DenseMatMulFunction::optimize(child.get(), stash));
             child.set(DenseMultiMatMulFunction::optimize(child.get(), stash));
+            child.set(DenseFusedReduceFunction::optimize(child.get(), stash));
             nodes.pop_back();
         }
     }
@@ -32,34 +32,38 @@ void my_dot_product_op(eval::InterpretedFunction::State &state, uint64_t) {
     state.pop_pop_push(state.stash.create<eval::DoubleValue>(result));
 }
 
-void my_cblas_double_dot_product_op(eval::InterpretedFunction::State &state, uint64_t) {
-    auto lhs_cells = DenseTensorView::typify_cells<double>(state.peek(1));
-    auto rhs_cells = DenseTensorView::typify_cells<double>(state.peek(0));
-    double result = cblas_ddot(lhs_cells.size(), lhs_cells.cbegin(), 1, rhs_cells.cbegin(), 1);
-    state.pop_pop_push(state.stash.create<eval::DoubleValue>(result));
+double my_cblas_dot_product(const double *lhs, const double *rhs, size_t size) {
+    return cblas_ddot(size, lhs, 1, rhs, 1);
+}
+
+double my_cblas_dot_product(const float *lhs, const float *rhs, size_t size) {
+    return cblas_sdot(size, lhs, 1, rhs, 1);
 }
 
-void my_cblas_float_dot_product_op(eval::InterpretedFunction::State &state, uint64_t) {
-    auto lhs_cells = DenseTensorView::typify_cells<float>(state.peek(1));
-    auto rhs_cells = DenseTensorView::typify_cells<float>(state.peek(0));
-    double result = cblas_sdot(lhs_cells.size(), lhs_cells.cbegin(), 1, rhs_cells.cbegin(), 1);
+// int8 and bfloat16 cells are promoted to float (or double) before using cblas
+template <typename LCT, typename RCT>
+void my_cblas_dot_product_op(eval::InterpretedFunction::State &state, uint64_t) {
+    using PCT = typename eval::UnifyCellTypes<LCT,RCT>::type;
+    auto lhs_cells = DenseTensorView::promote_cells<PCT,LCT>(state.peek(1), state.stash);
+    auto rhs_cells = DenseTensorView::promote_cells<PCT,RCT>(state.peek(0), state.stash);
+    double result = my_cblas_dot_product(lhs_cells.cbegin(), rhs_cells.cbegin(), lhs_cells.size());
     state.pop_pop_push(state.stash.create<eval::DoubleValue>(result));
 }
 
 struct MyDotProductOp {
     template <typename LCT, typename RCT>
-    static auto invoke() { return my_dot_product_op<LCT,RCT>; }
+    static auto invoke() {
+        constexpr bool mixed_float_double = (std::is_same_v<LCT,float> && std::is_same_v<RCT,double>) ||
+                                            (std::is_same_v<LCT,double> && std::is_same_v<RCT,float>);
+        if constexpr (mixed_float_double) {
+            return my_dot_product_op<LCT,RCT>;
+        } else {
+            return my_cblas_dot_product_op<LCT,RCT>;
+        }
+    }
 };
 
 eval::InterpretedFunction::op_function my_select(CellType lct, CellType rct) {
-    if (lct == rct) {
-        if (lct == ValueType::CellType::DOUBLE) {
-            return my_cblas_double_dot_product_op;
-        }
-        if (lct == ValueType::CellType::FLOAT) {
-            return my_cblas_float_dot_product_op;
-        }
-    }
     using MyTypify = eval::TypifyCellType;
     return typify_invoke<2,MyTypify,MyDotProductOp>(lct, rct);
 }
@@ -0,0 +1,271 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "dense_fused_reduce_function.h"
+#include "dense_tensor_view.h"
+#include <vespa/vespalib/objects/objectvisitor.h>
+#include <vespa/vespalib/util/typify.h>
+#include <vespa/eval/eval/value.h>
+#include <algorithm>
+
+namespace vespalib::tensor {
+
+using eval::Aggr;
+using eval::DoubleValue;
+using eval::InterpretedFunction;
+using eval::TensorEngine;
+using eval::TensorFunction;
+using eval::Value;
+using eval::ValueType;
+using eval::TypifyComputeCellType;
+using eval::TypifyAggr;
+using eval::as;
+
+using namespace eval::tensor_function;
+
+using Step = DenseFusedReduceFunction::Step;
+using Kind = DenseFusedReduceFunction::Step::Kind;
+using State = InterpretedFunction::State;
+
+namespace {
+
+// number of cells streamed through the program at a time
+constexpr size_t block_size = 64;
+
+struct Input {
+    TypedCells cells;
+    double number;
+    bool is_number;
+    Input() : cells(), number(0.0), is_number(false) {}
+};
+
+void load_cells(double *dst, const Input &input, size_t offset, size_t n) {
+    if (input.is_number) {
+        std::fill(dst, dst + n, input.number);
+    } else if (input.cells.type == CellType::DOUBLE) {
+        const double *src = input.cells.unsafe_typify<double>().cbegin() + offset;
+        std::copy(src, src + n, dst);
+    } else if (input.cells.type == CellType::FLOAT) {
+        const float *src = input.cells.unsafe_typify<float>().cbegin() + offset;
+        std::copy(src, src + n, dst);
+    } else {
+        for (size_t i = 0; i < n; ++i) {
+            dst[i] = input.cells.get(offset + i);
+        }
+    }
+}
+
+// run the program for n (<= block_size) cells starting at offset;
+// the result is left in the first block of the stack
+void run_block(const std::vector<Step> &program, const Input *inputs, size_t offset, size_t n, double *stack) {
+    double *top = stack - block_size;
+    for (const Step &step: program) {
+        switch (step.kind) {
+        case Kind::INPUT:
+            top += block_size;
+            load_cells(top, inputs[step.input], offset, n);
+            break;
+        case Kind::MAP:
+            for (size_t i = 0; i < n; ++i) {
+                top[i] = step.map_fun(top[i]);
+            }
+            break;
+        case Kind::JOIN:
+            top -= block_size;
+            for (size_t i = 0; i < n; ++i) {
+                top[i] = step.join_fun(top[i], top[i + block_size]);
+            }
+            break;
+        }
+        if (step.round_to_float) {
+            for (size_t i = 0; i < n; ++i) {
+                top[i] = float(top[i]);
+            }
+        }
+    }
+    assert(top == stack);
+}
+
+template <typename OCT, typename AGGR>
+void my_fused_reduce_op(State &state, uint64_t param) {
+    const auto &self = *(const DenseFusedReduceFunction *)(param);
+    const size_t num_inputs = self.num_inputs();
+    auto inputs = state.stash.create_array<Input>(num_inputs);
+    for (size_t i = 0; i < num_inputs; ++i) {
+        const Value &value = state.peek(num_inputs - 1 - i);
+        if (value.is_double()) {
+            inputs[i].number = value.as_double();
+            inputs[i].is_number = true;
+        } else {
+            inputs[i].cells = static_cast<const DenseTensorView &>(value).cellsRef();
+        }
+    }
+    auto stack = state.stash.create_array<double>(self.max_depth() * block_size);
+    auto dst_cells = state.stash.create_array<OCT>(self.outer_size());
+    size_t offset = 0;
+    for (OCT &dst: dst_cells) {
+        AGGR aggr;
+        for (size_t done = 0; done < self.reduce_size(); done += block_size) {
+            size_t n = std::min(block_size, self.reduce_size() - done);
+            run_block(self.program(), &inputs[0], offset, n, &stack[0]);
+            size_t i = 0;
+            if (done == 0) {
+                aggr.first(stack[i++]);
+            }
+            for (; i < n; ++i) {
+                aggr.next(stack[i]);
+            }
+            offset += n;
+        }
+        dst = aggr.result();
+    }
+    if (self.result_type().is_double()) {
+        state.pop_n_push(num_inputs, state.stash.create<DoubleValue>(dst_cells[0]));
+    } else {
+        state.pop_n_push(num_inputs, state.stash.create<DenseTensorView>(self.result_type(), TypedCells(dst_cells)));
+    }
+}
+
+struct MyGetFun {
+    template <typename R1, typename R2> static auto invoke() {
+        return my_fused_reduce_op<R1, typename R2::template templ<double>>;
+    }
+};
+
+using MyTypify = TypifyValue<TypifyComputeCellType,TypifyAggr>;
+
+// can the node be part of the elementwise program for the given type
+bool is_fused_op(const TensorFunction &node, const ValueType &type) {
+    const ValueType &node_type = node.result_type();
+    if (!node_type.is_dense() || (node_type.dimensions() != type.dimensions())) {
+        return false;
+    }
+    auto check_input = [&](const TensorFunction &input) {
+        return (input.result_type().is_double() || (input.result_type().dimensions() == type.dimensions()));
+    };
+    if (auto map = as<Map>(node)) {
+        return check_input(map->child());
+    }
+    if (auto join = as<Join>(node)) {
+        return (check_input(join->lhs()) && check_input(join->rhs()));
+    }
+    return false;
+}
+
+struct ProgramBuilder {
+    const ValueType &type;
+    std::vector<TensorFunction::Child> inputs;
+    std::vector<Step> program;
+    ProgramBuilder(const ValueType &type_in) : type(type_in), inputs(), program() {}
+    void add(const TensorFunction &node) {
+        bool round_to_float = (node.result_type().cell_type() == CellType::FLOAT);
+        if (is_fused_op(node, type)) {
+            if (auto map = as<Map>(node)) {
+                add(map->child());
+                program.emplace_back(Kind::MAP, 0, map->function(), nullptr, round_to_float);
+            } else {
+                auto join = as<Join>(node);
+                assert(join);
+                add(join->lhs());
+                add(join->rhs());
+                program.emplace_back(Kind::JOIN, 0, nullptr, join->function(), round_to_float);
+            }
+        } else {
+            program.emplace_back(Kind::INPUT, inputs.size(), nullptr, nullptr, false);
+            inputs.emplace_back(node);
+        }
+    }
+};
+
+} // namespace vespalib::tensor::<unnamed>
+
+DenseFusedReduceFunction::DenseFusedReduceFunction(const ValueType &result_type,
+                                                   std::vector<Child> inputs,
+                                                   std::vector<Step> program,
+                                                   size_t outer_size, size_t reduce_size,
+                                                   Aggr aggr)
+    : TensorFunction(),
+      _result_type(result_type),
+      _inputs(std::move(inputs)),
+      _program(std::move(program)),
+      _max_depth(0),
+      _outer_size(outer_size),
+      _reduce_size(reduce_size),
+      _aggr(aggr)
+{
+    size_t depth = 0;
+    for (const Step &step: _program) {
+        if (step.kind == Step::Kind::INPUT) {
+            _max_depth = std::max(_max_depth, ++depth);
+        } else if (step.kind == Step::Kind::JOIN) {
+            --depth;
+        }
+    }
+    assert(depth == 1);
+}
+
+DenseFusedReduceFunction::~DenseFusedReduceFunction() = default;
+
+void
+DenseFusedReduceFunction::push_children(std::vector<Child::CREF> &children) const
+{
+    for (const Child &input: _inputs) {
+        children.emplace_back(input);
+    }
+}
+
+InterpretedFunction::Instruction
+DenseFusedReduceFunction::compile_self(const TensorEngine &, Stash &) const
+{
+    CellType cell_type = _result_type.is_double() ? CellType::DOUBLE : _result_type.cell_type();
+    auto op = typify_invoke<2,MyTypify,MyGetFun>(cell_type, _aggr);
+    static_assert(sizeof(uint64_t) == sizeof(this));
+    return InterpretedFunction::Instruction(op, (uint64_t)this);
+}
+
+void
+DenseFusedReduceFunction::visit_self(vespalib::ObjectVisitor &visitor) const
+{
+    TensorFunction::visit_self(visitor);
+    visitor.visitInt("num_steps", _program.size());
+    visitor.visitInt("outer_size", _outer_size);
+    visitor.visitInt("reduce_size", _reduce_size);
+    visitor.visitString("aggr", *eval::AggrNames::name_of(_aggr));
+}
+
+const TensorFunction &
+DenseFusedReduceFunction::optimize(const TensorFunction &expr, Stash &stash)
+{
+    auto reduce = as<Reduce>(expr);
+    if (!reduce) {
+        return expr;
+    }
+    const ValueType &type = reduce->child().result_type();
+    if (!is_fused_op(reduce->child(), type)) {
+        return expr;
+    }
+    // reduced dimensions must be the innermost ones
+    size_t num_outer = type.dimensions().size() - reduce->dimensions().size();
+    if (reduce->dimensions().empty()) {
+        num_outer = 0;
+    }
+    if (expr.result_type().dimensions().size() != num_outer) {
+        return expr;
+    }
+    for (const auto &dim: reduce->dimensions()) {
+        size_t idx = type.dimension_index(dim);
+        if ((idx == ValueType::Dimension::npos) || (idx < num_outer)) {
+            return expr;
+        }
+    }
+    size_t outer_size = 1;
+    size_t reduce_size = 1;
+    for (size_t i = 0; i < type.dimensions().size(); ++i) {
+        ((i < num_outer) ? outer_size : reduce_size) *= type.dimensions()[i].size;
+    }
+    ProgramBuilder builder(type);
+    builder.add(reduce->child());
+    return stash.create<DenseFusedReduceFunction>(expr.result_type(), std::move(builder.inputs), std::move(builder.program),
+                                                  outer_size, reduce_size, reduce->aggr());
+}
+
+} // namespace vespalib::tensor
@@ -0,0 +1,63 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <vespa/eval/eval/tensor_function.h>
+
+namespace vespalib::tensor {
+
+/**
+ * Tensor function reducing the result of a chain of elementwise maps
+ * and joins over dense tensors with the same dimensions. The cells
+ * are streamed through the chain in small blocks and aggregated
+ * directly, avoiding intermediate tensors. The inputs of the chain
+ * (dense tensors of the same type as the joined result, or numbers)
+ * are the children of this function. Reduced dimensions must be the
+ * innermost dimensions; all dimensions may be reduced.
+ **/
+class DenseFusedReduceFunction : public eval::TensorFunction
+{
+public:
+    // one step of the elementwise program, in postfix order
+    struct Step {
+        enum class Kind : uint8_t { INPUT, MAP, JOIN };
+        Kind kind;
+        size_t input;
+        eval::tensor_function::map_fun_t map_fun;
+        eval::tensor_function::join_fun_t join_fun;
+        bool round_to_float;
+        Step(Kind kind_in, size_t input_in, eval::tensor_function::map_fun_t map_fun_in,
+             eval::tensor_function::join_fun_t join_fun_in, bool round_to_float_in)
+            : kind(kind_in), input(input_in), map_fun(map_fun_in), join_fun(join_fun_in),
+              round_to_float(round_to_float_in) {}
+    };
+private:
+    eval::ValueType    _result_type;
+    std::vector<Child> _inputs;
+    std::vector<Step>  _program;
+    size_t             _max_depth;
+    size_t             _outer_size;
+    size_t             _reduce_size;
+    eval::Aggr         _aggr;
+public:
+    DenseFusedReduceFunction(const eval::ValueType &result_type,
+                             std::vector<Child> inputs,
+                             std::vector<Step> program,
+                             size_t outer_size, size_t reduce_size,
+                             eval::Aggr aggr);
+    ~DenseFusedReduceFunction() override;
+    const eval::ValueType &result_type() const override { return _result_type; }
+    size_t num_inputs() const { return _inputs.size(); }
+    const std::vector<Step> &program() const { return _program; }
+    size_t max_depth() const { return _max_depth; }
+    size_t outer_size() const { return _outer_size; }
+    size_t reduce_size() const { return _reduce_size; }
+    eval::Aggr aggr() const { return _aggr; }
+    bool result_is_mutable() const override { return true; }
+    void push_children(std::vector<Child::CREF> &children) const override;
+    eval::InterpretedFunction::Instruction compile_self(const eval::TensorEngine &engine, Stash &stash) const override;
+    void visit_self(vespalib::ObjectVisitor &visitor) const override;
+    static const eval::TensorFunction &optimize(const eval::TensorFunction &expr, Stash &stash);
+};
+
+} // namespace vespalib::tensor
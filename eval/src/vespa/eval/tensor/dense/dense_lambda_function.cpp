@@ -14,7 +14,6 @@ using eval::CompileCache;
 using eval::CompiledFunction;
 using eval::InterpretedFunction;
 using eval::LazyParams;
-using eval::PassParams;
 using eval::TensorEngine;
 using eval::TensorFunction;
 using eval::Value;
@@ -61,6 +60,15 @@ struct ParamProxy : public LazyParams {
 
 //-----------------------------------------------------------------------------
 
+std::vector<size_t> make_loop_cnt(const ValueType &type) {
+    std::vector<size_t> loop_cnt;
+    for (const auto &dim: type.dimensions()) {
+        loop_cnt.push_back(dim.size);
+    }
+    return loop_cnt;
+}
+
+// the lambda is compiled together with the loop over all cells
 struct CompiledParams {
     const ValueType &result_type;
     const std::vector<size_t> &bindings;
@@ -70,7 +78,7 @@ struct CompiledParams {
         : result_type(lambda.result_type()),
           bindings(lambda.bindings()),
           num_cells(result_type.dense_subspace_size()),
-          token(CompileCache::compile(lambda.lambda(), PassParams::ARRAY))
+          token(CompileCache::compile_cell_loop(lambda.lambda(), make_loop_cnt(result_type)))
     {
         assert(lambda.lambda().num_params() == (result_type.dimensions().size() + bindings.size()));
     }
@@ -79,17 +87,22 @@ struct CompiledParams {
 template <typename CT>
 void my_compiled_lambda_op(eval::InterpretedFunction::State &state, uint64_t param) {
     const CompiledParams &params = *(const CompiledParams*)param;
-    std::vector<double> args(params.result_type.dimensions().size() + params.bindings.size(), 0.0);
+    auto args = state.stash.create_array<double>(params.result_type.dimensions().size() + params.bindings.size(), 0.0);
     double *bind_next = &args[params.result_type.dimensions().size()];
     for (size_t binding: params.bindings) {
         *bind_next++ = state.params->resolve(binding, state.stash).as_double();
     }
-    auto fun = params.token->get().get_function();
+    auto fun = params.token->get().get_cell_loop_function();
     ArrayRef<CT> dst_cells = state.stash.create_array<CT>(params.num_cells);
-    CT *dst = &dst_cells[0];
-    do {
-        *dst++ = fun(&args[0]);
-    } while (step_labels(&args[0], params.result_type));
+    if constexpr (std::is_same_v<CT,double>) {
+        fun(&args[0], &dst_cells[0]);
+    } else {
+        ArrayRef<double> tmp_cells = state.stash.create_array<double>(params.num_cells);
+        fun(&args[0], &tmp_cells[0]);
+        for (size_t i = 0; i < params.num_cells; ++i) {
+            dst_cells[i] = tmp_cells[i];
+        }
+    }
     state.stack.push_back(state.stash.create<DenseTensorView>(params.result_type, TypedCells(dst_cells)));
 }
 
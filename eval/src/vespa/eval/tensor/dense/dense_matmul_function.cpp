@@ -53,30 +53,32 @@ void my_matmul_op(eval::InterpretedFunction::State &state, uint64_t param) {
 }
 
 template <bool lhs_common_inner, bool rhs_common_inner>
-void my_cblas_double_matmul_op(eval::InterpretedFunction::State &state, uint64_t param) {
-    const DenseMatMulFunction::Self &self = *((const DenseMatMulFunction::Self *)(param));
-    auto lhs_cells = DenseTensorView::typify_cells<double>(state.peek(1));
-    auto rhs_cells = DenseTensorView::typify_cells<double>(state.peek(0));
-    auto dst_cells = state.stash.create_array<double>(self.lhs_size * self.rhs_size);
+void my_cblas_matmul(const DenseMatMulFunction::Self &self, const double *lhs, const double *rhs, double *dst) {
     cblas_dgemm(CblasRowMajor, lhs_common_inner ? CblasNoTrans : CblasTrans, rhs_common_inner ? CblasTrans : CblasNoTrans,
                 self.lhs_size, self.rhs_size, self.common_size, 1.0,
-                lhs_cells.cbegin(), lhs_common_inner ? self.common_size : self.lhs_size,
-                rhs_cells.cbegin(), rhs_common_inner ? self.common_size : self.rhs_size,
-                0.0, dst_cells.begin(), self.rhs_size);
-    state.pop_pop_push(state.stash.create<DenseTensorView>(self.result_type, TypedCells(dst_cells)));
+                lhs, lhs_common_inner ? self.common_size : self.lhs_size,
+                rhs, rhs_common_inner ? self.common_size : self.rhs_size,
+                0.0, dst, self.rhs_size);
 }
 
 template <bool lhs_common_inner, bool rhs_common_inner>
-void my_cblas_float_matmul_op(eval::InterpretedFunction::State &state, uint64_t param) {
-    const DenseMatMulFunction::Self &self = *((const DenseMatMulFunction::Self *)(param));
-    auto lhs_cells = DenseTensorView::typify_cells<float>(state.peek(1));
-    auto rhs_cells = DenseTensorView::typify_cells<float>(state.peek(0));
-    auto dst_cells = state.stash.create_array<float>(self.lhs_size * self.rhs_size);
+void my_cblas_matmul(const DenseMatMulFunction::Self &self, const float *lhs, const float *rhs, float *dst) {
     cblas_sgemm(CblasRowMajor, lhs_common_inner ? CblasNoTrans : CblasTrans, rhs_common_inner ? CblasTrans : CblasNoTrans,
                 self.lhs_size, self.rhs_size, self.common_size, 1.0,
-                lhs_cells.cbegin(), lhs_common_inner ? self.common_size : self.lhs_size,
-                rhs_cells.cbegin(), rhs_common_inner ? self.common_size : self.rhs_size,
-                0.0, dst_cells.begin(), self.rhs_size);
+                lhs, lhs_common_inner ? self.common_size : self.lhs_size,
+                rhs, rhs_common_inner ? self.common_size : self.rhs_size,
+                0.0, dst, self.rhs_size);
+}
+
+// int8 and bfloat16 cells are promoted to the result cell type before using cblas
+template <typename LCT, typename RCT, bool lhs_common_inner, bool rhs_common_inner>
+void my_cblas_matmul_op(eval::InterpretedFunction::State &state, uint64_t param) {
+    const DenseMatMulFunction::Self &self = *((const DenseMatMulFunction::Self *)(param));
+    using OCT = typename eval::UnifyCellTypes<LCT,RCT>::type;
+    auto lhs_cells = DenseTensorView::promote_cells<OCT,LCT>(state.peek(1), state.stash);
+    auto rhs_cells = DenseTensorView::promote_cells<OCT,RCT>(state.peek(0), state.stash);
+    auto dst_cells = state.stash.create_array<OCT>(self.lhs_size * self.rhs_size);
+    my_cblas_matmul<lhs_common_inner,rhs_common_inner>(self, lhs_cells.cbegin(), rhs_cells.cbegin(), dst_cells.begin());
     state.pop_pop_push(state.stash.create<DenseTensorView>(self.result_type, TypedCells(dst_cells)));
 }
 
@@ -121,12 +123,12 @@ const TensorFunction &create_matmul(const TensorFunction &a, const TensorFunctio
 
 struct MyGetFun {
     template<typename R1, typename R2, typename R3, typename R4> static auto invoke() {
-        if (std::is_same_v<R1,double> && std::is_same_v<R2,double>) {
-            return my_cblas_double_matmul_op<R3::value, R4::value>;
-        } else if (std::is_same_v<R1,float> && std::is_same_v<R2,float>) {
-            return my_cblas_float_matmul_op<R3::value, R4::value>;
-        } else {
+        constexpr bool mixed_float_double = (std::is_same_v<R1,float> && std::is_same_v<R2,double>) ||
+                                            (std::is_same_v<R1,double> && std::is_same_v<R2,float>);
+        if constexpr (mixed_float_double) {
             return my_matmul_op<R1, R2, R3::value, R4::value>;
+        } else {
+            return my_cblas_matmul_op<R1, R2, R3::value, R4::value>;
         }
     }
 };
@@ -5,6 +5,7 @@
 #include <vespa/vespalib/objects/objectvisitor.h>
 #include <vespa/eval/eval/value.h>
 #include <vespa/eval/eval/operation.h>
+#include <vespa/eval/eval/parallel_loop.h>
 #include <cassert>
 
 #include <cblas.h>
@@ -32,17 +33,22 @@ void my_cblas_double_multi_matmul_op(InterpretedFunction::State &state, uint64_t
     size_t rhs_block_size = self.rhs_size() * self.common_size();
     size_t dst_block_size = self.lhs_size() * self.rhs_size();
     size_t num_blocks = self.matmul_cnt();
-    const CT *lhs = DenseTensorView::typify_cells<CT>(state.peek(1)).cbegin();
-    const CT *rhs = DenseTensorView::typify_cells<CT>(state.peek(0)).cbegin();
+    const CT *lhs_cells = DenseTensorView::typify_cells<CT>(state.peek(1)).cbegin();
+    const CT *rhs_cells = DenseTensorView::typify_cells<CT>(state.peek(0)).cbegin();
     auto dst_cells = state.stash.create_array<CT>(dst_block_size * num_blocks);
-    CT *dst = dst_cells.begin();
-    for (size_t i = 0; i < num_blocks; ++i, lhs += lhs_block_size, rhs += rhs_block_size, dst += dst_block_size) {
-        cblas_dgemm(CblasRowMajor, self.lhs_common_inner() ? CblasNoTrans : CblasTrans, self.rhs_common_inner() ? CblasTrans : CblasNoTrans,
-                    self.lhs_size(), self.rhs_size(), self.common_size(), 1.0,
-                    lhs, self.lhs_common_inner() ? self.common_size() : self.lhs_size(),
-                    rhs, self.rhs_common_inner() ? self.common_size() : self.rhs_size(),
-                    0.0, dst, self.rhs_size());
-    }
+    auto matmul_blocks = [&](size_t begin, size_t end) {
+        const CT *lhs = lhs_cells + (begin * lhs_block_size);
+        const CT *rhs = rhs_cells + (begin * rhs_block_size);
+        CT *dst = dst_cells.begin() + (begin * dst_block_size);
+        for (size_t i = begin; i < end; ++i, lhs += lhs_block_size, rhs += rhs_block_size, dst += dst_block_size) {
+            cblas_dgemm(CblasRowMajor, self.lhs_common_inner() ? CblasNoTrans : CblasTrans, self.rhs_common_inner() ? CblasTrans : CblasNoTrans,
+                        self.lhs_size(), self.rhs_size(), self.common_size(), 1.0,
+                        lhs, self.lhs_common_inner() ? self.common_size() : self.lhs_size(),
+                        rhs, self.rhs_common_inner() ? self.common_size() : self.rhs_size(),
+                        0.0, dst, self.rhs_size());
+        }
+    };
+    eval::parallel_loop(state.thread_bundle, num_blocks, dst_block_size * self.common_size(), matmul_blocks);
     state.pop_pop_push(state.stash.create<DenseTensorView>(self.result_type(), TypedCells(dst_cells)));
 }
 
@@ -53,17 +59,22 @@ void my_cblas_float_multi_matmul_op(InterpretedFunction::State &state, uint64_t
     size_t rhs_block_size = self.rhs_size() * self.common_size();
     size_t dst_block_size = self.lhs_size() * self.rhs_size();
     size_t num_blocks = self.matmul_cnt();
-    const CT *lhs = DenseTensorView::typify_cells<CT>(state.peek(1)).cbegin();
-    const CT *rhs = DenseTensorView::typify_cells<CT>(state.peek(0)).cbegin();
+    const CT *lhs_cells = DenseTensorView::typify_cells<CT>(state.peek(1)).cbegin();
+    const CT *rhs_cells = DenseTensorView::typify_cells<CT>(state.peek(0)).cbegin();
     auto dst_cells = state.stash.create_array<CT>(dst_block_size * num_blocks);
-    CT *dst = dst_cells.begin();
-    for (size_t i = 0; i < num_blocks; ++i, lhs += lhs_block_size, rhs += rhs_block_size, dst += dst_block_size) {
-        cblas_sgemm(CblasRowMajor, self.lhs_common_inner() ? CblasNoTrans : CblasTrans, self.rhs_common_inner() ? CblasTrans : CblasNoTrans,
-                    self.lhs_size(), self.rhs_size(), self.common_size(), 1.0,
-                    lhs, self.lhs_common_inner() ? self.common_size() : self.lhs_size(),
-                    rhs, self.rhs_common_inner() ? self.common_size() : self.rhs_size(),
-                    0.0, dst, self.rhs_size());
-    }
+    auto matmul_blocks = [&](size_t begin, size_t end) {
+        const CT *lhs = lhs_cells + (begin * lhs_block_size);
+        const CT *rhs = rhs_cells + (begin * rhs_block_size);
+        CT *dst = dst_cells.begin() + (begin * dst_block_size);
+        for (size_t i = begin; i < end; ++i, lhs += lhs_block_size, rhs += rhs_block_size, dst += dst_block_size) {
+            cblas_sgemm(CblasRowMajor, self.lhs_common_inner() ? CblasNoTrans : CblasTrans, self.rhs_common_inner() ? CblasTrans : CblasNoTrans,
+                        self.lhs_size(), self.rhs_size(), self.common_size(), 1.0,
+                        lhs, self.lhs_common_inner() ? self.common_size() : self.lhs_size(),
+                        rhs, self.rhs_common_inner() ? self.common_size() : self.rhs_size(),
+                        0.0, dst, self.rhs_size());
+        }
+    };
+    eval::parallel_loop(state.thread_bundle, num_blocks, dst_block_size * self.common_size(), matmul_blocks);
     state.pop_pop_push(state.stash.create<DenseTensorView>(self.result_type(), TypedCells(dst_cells)));
 }
 
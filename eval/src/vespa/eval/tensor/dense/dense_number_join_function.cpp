@@ -15,7 +15,7 @@ using eval::Value;
 using eval::ValueType;
 using eval::TensorFunction;
 using eval::TensorEngine;
-using eval::TypifyCellType;
+using eval::TypifyComputeCellType;
 using eval::as;
 
 using namespace eval::operation;
@@ -62,7 +62,7 @@ struct MyGetFun {
     }
 };
 
-using MyTypify = TypifyValue<TypifyCellType,TypifyOp2,TypifyBool>;
+using MyTypify = TypifyValue<TypifyComputeCellType,TypifyOp2,TypifyBool>;
 
 bool is_dense(const TensorFunction &tf) { return tf.result_type().is_dense(); }
 bool is_double(const TensorFunction &tf) { return tf.result_type().is_double(); }
@@ -109,11 +109,10 @@ DenseNumberJoinFunction::optimize(const TensorFunction &expr, Stash &stash)
     if (auto join = as<Join>(expr)) {
         const TensorFunction &lhs = join->lhs();
         const TensorFunction &rhs = join->rhs();
-        if (is_dense(lhs) && is_double(rhs)) {
-            assert(cell_type(expr) == cell_type(lhs));
+        // int8 and bfloat16 tensors produce float results; not handled here
+        if (is_dense(lhs) && is_double(rhs) && (cell_type(expr) == cell_type(lhs))) {
             return stash.create<DenseNumberJoinFunction>(join->result_type(), lhs, rhs, join->function(), Primary::LHS);
-        } else if (is_double(lhs) && is_dense(rhs)) {
-            assert(cell_type(expr) == cell_type(rhs));
+        } else if (is_double(lhs) && is_dense(rhs) && (cell_type(expr) == cell_type(rhs))) {
             return stash.create<DenseNumberJoinFunction>(join->result_type(), lhs, rhs, join->function(), Primary::RHS);
         }
     }
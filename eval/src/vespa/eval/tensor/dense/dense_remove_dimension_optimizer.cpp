@@ -43,9 +43,9 @@ DenseRemoveDimensionOptimizer::optimize(const eval::TensorFunction &expr, Stash
         if (expr.result_type().is_dense() &&
             child.result_type().is_dense() &&
             is_ident_aggr(reduce->aggr()) &&
-            is_trivial_dim_list(child.result_type(), reduce->dimensions()))
+            is_trivial_dim_list(child.result_type(), reduce->dimensions()) &&
+            (expr.result_type().cell_type() == child.result_type().cell_type()))
         {
-            assert(expr.result_type().cell_type() == child.result_type().cell_type());
             return DenseReplaceTypeFunction::create_compact(expr.result_type(), child, stash);
         }
     }
@@ -18,7 +18,7 @@ using eval::Value;
 using eval::ValueType;
 using eval::TensorFunction;
 using eval::TensorEngine;
-using eval::TypifyCellType;
+using eval::TypifyComputeCellType;
 using eval::as;
 
 using namespace eval::operation;
@@ -67,7 +67,7 @@ struct MyGetFun {
     }
 };
 
-using MyTypify = TypifyValue<TypifyCellType,TypifyOp2,TypifyBool>;
+using MyTypify = TypifyValue<TypifyComputeCellType,TypifyOp2,TypifyBool>;
 
 //-----------------------------------------------------------------------------
 
@@ -119,7 +119,10 @@ DenseSimpleExpandFunction::optimize(const TensorFunction &expr, Stash &stash)
     if (auto join = as<Join>(expr)) {
         const TensorFunction &lhs = join->lhs();
         const TensorFunction &rhs = join->rhs();
-        if (lhs.result_type().is_dense() && rhs.result_type().is_dense()) {
+        if (lhs.result_type().is_dense() && rhs.result_type().is_dense() &&
+            !ValueType::is_storage_cell_type(lhs.result_type().cell_type()) &&
+            !ValueType::is_storage_cell_type(rhs.result_type().cell_type()))
+        {
             if (std::optional<Inner> inner = detect_simple_expand(lhs, rhs)) {
                 assert(expr.result_type().dense_subspace_size() ==
                        (lhs.result_type().dense_subspace_size() *
@@ -18,7 +18,7 @@ using eval::Value;
 using eval::ValueType;
 using eval::TensorFunction;
 using eval::TensorEngine;
-using eval::TypifyCellType;
+using eval::TypifyComputeCellType;
 using eval::as;
 
 using namespace eval::operation;
@@ -102,7 +102,7 @@ struct MyGetFun {
     }
 };
 
-using MyTypify = TypifyValue<TypifyCellType,TypifyOp2,TypifyBool,TypifyOverlap>;
+using MyTypify = TypifyValue<TypifyComputeCellType,TypifyOp2,TypifyBool,TypifyOverlap>;
 
 //-----------------------------------------------------------------------------
 
@@ -207,7 +207,10 @@ DenseSimpleJoinFunction::optimize(const TensorFunction &expr, Stash &stash)
     if (auto join = as<Join>(expr)) {
         const TensorFunction &lhs = join->lhs();
         const TensorFunction &rhs = join->rhs();
-        if (lhs.result_type().is_dense() && rhs.result_type().is_dense()) {
+        if (lhs.result_type().is_dense() && rhs.result_type().is_dense() &&
+            !ValueType::is_storage_cell_type(lhs.result_type().cell_type()) &&
+            !ValueType::is_storage_cell_type(rhs.result_type().cell_type()))
+        {
             Primary primary = select_primary(lhs, rhs, join->result_type().cell_type());
             std::optional<Overlap> overlap = detect_overlap(lhs, rhs, primary);
             if (overlap.has_value()) {
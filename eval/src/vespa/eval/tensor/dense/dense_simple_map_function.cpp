@@ -15,7 +15,7 @@ using eval::Value;
 using eval::ValueType;
 using eval::TensorFunction;
 using eval::TensorEngine;
-using eval::TypifyCellType;
+using eval::TypifyComputeCellType;
 using eval::as;
 
 using namespace eval::operation;
@@ -56,7 +56,7 @@ struct MyGetFun {
     }
 };
 
-using MyTypify = TypifyValue<TypifyCellType,TypifyOp1,TypifyBool>;
+using MyTypify = TypifyValue<TypifyComputeCellType,TypifyOp1,TypifyBool>;
 
 } // namespace vespalib::tensor::<unnamed>
 
@@ -83,7 +83,8 @@ const TensorFunction &
 DenseSimpleMapFunction::optimize(const TensorFunction &expr, Stash &stash)
 {
     if (auto map = as<Map>(expr)) {
-        if (map->child().result_type().is_dense()) {
+        const ValueType &child_type = map->child().result_type();
+        if (child_type.is_dense() && (child_type.cell_type() == map->result_type().cell_type())) {
             return stash.create<DenseSimpleMapFunction>(map->result_type(), map->child(), map->function());
         }
     }
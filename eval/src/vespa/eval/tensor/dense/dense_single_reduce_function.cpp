@@ -13,7 +13,7 @@ using eval::TensorEngine;
 using eval::TensorFunction;
 using eval::Value;
 using eval::ValueType;
-using eval::TypifyCellType;
+using eval::TypifyComputeCellType;
 using eval::TypifyAggr;
 using eval::as;
 
@@ -75,7 +75,7 @@ struct MyGetFun {
     }
 };
 
-using MyTypify = TypifyValue<TypifyCellType,TypifyAggr>;
+using MyTypify = TypifyValue<TypifyComputeCellType,TypifyAggr>;
 
 bool check_input_type(const ValueType &type) {
     return (type.is_dense() && ((type.cell_type() == CellType::FLOAT) || (type.cell_type() == CellType::DOUBLE)));
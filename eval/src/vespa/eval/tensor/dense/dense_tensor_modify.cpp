@@ -38,5 +38,7 @@ DenseTensorModify<CT>::build()
 
 template class DenseTensorModify<float>;
 template class DenseTensorModify<double>;
+template class DenseTensorModify<int8_t>;
+template class DenseTensorModify<BFloat16>;
 
 } // namespace
@@ -38,7 +38,7 @@ void my_tensor_peek_op(eval::InterpretedFunction::State &state, uint64_t param)
     }
     auto cells = DenseTensorView::typify_cells<CT>(state.peek(0));
     state.stack.pop_back();
-    const Value &result = state.stash.create<DoubleValue>(valid ? cells[idx] : 0.0);
+    const Value &result = state.stash.create<DoubleValue>(valid ? double(cells[idx]) : 0.0);
     state.stack.emplace_back(result);
 }
 
@@ -5,6 +5,7 @@
 #include "typed_cells.h"
 #include "dense_tensor_cells_iterator.h"
 #include <vespa/eval/tensor/tensor.h>
+#include <vespa/vespalib/util/stash.h>
 
 namespace vespalib::tensor {
 
@@ -55,6 +56,19 @@ public:
     template <typename T> static ConstArrayRef<T> unsafe_typify_cells(const eval::Value &self) {
         return static_cast<const DenseTensorView &>(self).cellsRef().unsafe_typify<T>();
     }
+    // cells of type CT converted to type T; copied into the stash when the types differ
+    template <typename T, typename CT> static ConstArrayRef<T> promote_cells(const eval::Value &self, Stash &stash) {
+        auto cells = typify_cells<CT>(self);
+        if constexpr (std::is_same_v<T,CT>) {
+            return cells;
+        } else {
+            ArrayRef<T> dst = stash.create_array<T>(cells.size());
+            for (size_t i = 0; i < cells.size(); ++i) {
+                dst[i] = cells[i];
+            }
+            return dst;
+        }
+    }
 protected:
     explicit DenseTensorView(const eval::ValueType &type_in)
         : _typeRef(type_in),
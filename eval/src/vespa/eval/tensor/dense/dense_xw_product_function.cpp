@@ -5,6 +5,7 @@
 #include <vespa/vespalib/objects/objectvisitor.h>
 #include <vespa/eval/eval/value.h>
 #include <vespa/eval/eval/operation.h>
+#include <vespa/eval/eval/parallel_loop.h>
 #include <cassert>
 
 #include <cblas.h>
@@ -39,40 +40,56 @@ void my_xw_product_op(eval::InterpretedFunction::State &state, uint64_t param) {
     auto vector_cells = DenseTensorView::typify_cells<LCT>(state.peek(1));
     auto matrix_cells = DenseTensorView::typify_cells<RCT>(state.peek(0));
     auto dst_cells = state.stash.create_array<OCT>(self.result_size);
-    OCT *dst = dst_cells.begin();
-    const RCT *matrix = matrix_cells.cbegin();
-    for (size_t i = 0; i < self.result_size; ++i) {
-        *dst++ = my_dot_product<LCT,RCT,common_inner>(vector_cells.cbegin(), matrix, self.vector_size, self.result_size);
-        matrix += (common_inner ? self.vector_size : 1);
-    }
+    auto xw_product = [&](size_t begin, size_t end) {
+        OCT *dst = dst_cells.begin() + begin;
+        const RCT *matrix = matrix_cells.cbegin() + (common_inner ? (begin * self.vector_size) : begin);
+        for (size_t i = begin; i < end; ++i) {
+            *dst++ = my_dot_product<LCT,RCT,common_inner>(vector_cells.cbegin(), matrix, self.vector_size, self.result_size);
+            matrix += (common_inner ? self.vector_size : 1);
+        }
+    };
+    eval::parallel_loop(state.thread_bundle, self.result_size, self.vector_size, xw_product);
     state.pop_pop_push(state.stash.create<DenseTensorView>(self.result_type, TypedCells(dst_cells)));
 }
 
+// calculate result cells [begin, end)
 template <bool common_inner>
-void my_cblas_double_xw_product_op(eval::InterpretedFunction::State &state, uint64_t param) {
-    const DenseXWProductFunction::Self &self = *((const DenseXWProductFunction::Self *)(param));
-    auto vector_cells = DenseTensorView::typify_cells<double>(state.peek(1));
-    auto matrix_cells = DenseTensorView::typify_cells<double>(state.peek(0));
-    auto dst_cells = state.stash.create_array<double>(self.result_size);
+void my_cblas_xw_product(const DenseXWProductFunction::Self &self, const double *vector, const double *matrix, double *dst,
+                         size_t begin, size_t end)
+{
     cblas_dgemv(CblasRowMajor, common_inner ? CblasNoTrans : CblasTrans,
-                common_inner ? self.result_size : self.vector_size,
-                common_inner ? self.vector_size : self.result_size,
-                1.0, matrix_cells.cbegin(), common_inner ? self.vector_size : self.result_size, vector_cells.cbegin(), 1,
-                0.0, dst_cells.begin(), 1);
-    state.pop_pop_push(state.stash.create<DenseTensorView>(self.result_type, TypedCells(dst_cells)));
+                common_inner ? (end - begin) : self.vector_size,
+                common_inner ? self.vector_size : (end - begin),
+                1.0, matrix + (common_inner ? (begin * self.vector_size) : begin),
+                common_inner ? self.vector_size : self.result_size, vector, 1,
+                0.0, dst + begin, 1);
 }
 
+// calculate result cells [begin, end)
 template <bool common_inner>
-void my_cblas_float_xw_product_op(eval::InterpretedFunction::State &state, uint64_t param) {
-    const DenseXWProductFunction::Self &self = *((const DenseXWProductFunction::Self *)(param));
-    auto vector_cells = DenseTensorView::typify_cells<float>(state.peek(1));
-    auto matrix_cells = DenseTensorView::typify_cells<float>(state.peek(0));
-    auto dst_cells = state.stash.create_array<float>(self.result_size);
+void my_cblas_xw_product(const DenseXWProductFunction::Self &self, const float *vector, const float *matrix, float *dst,
+                         size_t begin, size_t end)
+{
     cblas_sgemv(CblasRowMajor, common_inner ? CblasNoTrans : CblasTrans,
-                common_inner ? self.result_size : self.vector_size,
-                common_inner ? self.vector_size : self.result_size,
-                1.0, matrix_cells.cbegin(), common_inner ? self.vector_size : self.result_size, vector_cells.cbegin(), 1,
-                0.0, dst_cells.begin(), 1);
+                common_inner ? (end - begin) : self.vector_size,
+                common_inner ? self.vector_size : (end - begin),
+                1.0, matrix + (common_inner ? (begin * self.vector_size) : begin),
+                common_inner ? self.vector_size : self.result_size, vector, 1,
+                0.0, dst + begin, 1);
+}
+
+// int8 and bfloat16 cells are promoted to the result cell type before using cblas
+template <typename LCT, typename RCT, bool common_inner>
+void my_cblas_xw_product_op(eval::InterpretedFunction::State &state, uint64_t param) {
+    const DenseXWProductFunction::Self &self = *((const DenseXWProductFunction::Self *)(param));
+    using OCT = typename eval::UnifyCellTypes<LCT,RCT>::type;
+    auto vector_cells = DenseTensorView::promote_cells<OCT,LCT>(state.peek(1), state.stash);
+    auto matrix_cells = DenseTensorView::promote_cells<OCT,RCT>(state.peek(0), state.stash);
+    auto dst_cells = state.stash.create_array<OCT>(self.result_size);
+    auto xw_product = [&](size_t begin, size_t end) {
+        my_cblas_xw_product<common_inner>(self, vector_cells.cbegin(), matrix_cells.cbegin(), dst_cells.begin(), begin, end);
+    };
+    eval::parallel_loop(state.thread_bundle, self.result_size, self.vector_size, xw_product);
     state.pop_pop_push(state.stash.create<DenseTensorView>(self.result_type, TypedCells(dst_cells)));
 }
 
@@ -107,12 +124,12 @@ const TensorFunction &createDenseXWProduct(const ValueType &res, const TensorFun
 
 struct MyXWProductOp {
     template<typename R1, typename R2, typename R3> static auto invoke() {
-        if (std::is_same_v<R1,double> && std::is_same_v<R2,double>) {
-            return my_cblas_double_xw_product_op<R3::value>;
-        } else if (std::is_same_v<R1,float> && std::is_same_v<R2,float>) {
-            return my_cblas_float_xw_product_op<R3::value>;
-        } else {
+        constexpr bool mixed_float_double = (std::is_same_v<R1,float> && std::is_same_v<R2,double>) ||
+                                            (std::is_same_v<R1,double> && std::is_same_v<R2,float>);
+        if constexpr (mixed_float_double) {
             return my_xw_product_op<R1, R2, R3::value>;
+        } else {
+            return my_cblas_xw_product_op<R1, R2, R3::value>;
         }
     }
 };
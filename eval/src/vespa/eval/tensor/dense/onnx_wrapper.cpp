@@ -69,13 +69,13 @@ struct CreateOnnxTensor {
 };
 
 struct CreateVespaTensorRef {
-    template <typename T> static eval::Value::UP invoke(const eval::ValueType &type_ref, Ort::Value &value) {
+    template <typename T> static eval::Value::UP invoke(const eval::ValueType &type_ref, Ort::Value &value, size_t idx) {
         size_t num_cells = type_ref.dense_subspace_size();
-        ConstArrayRef<T> cells(value.GetTensorMutableData<T>(), num_cells);
+        ConstArrayRef<T> cells(value.GetTensorMutableData<T>() + (idx * num_cells), num_cells);
         return std::make_unique<DenseTensorView>(type_ref, TypedCells(cells));
     }
-    eval::Value::UP operator()(const eval::ValueType &type_ref, Ort::Value &value) {
-        return typify_invoke<1,MyTypify,CreateVespaTensorRef>(type_ref.cell_type(), type_ref, value);
+    eval::Value::UP operator()(const eval::ValueType &type_ref, Ort::Value &value, size_t idx = 0) {
+        return typify_invoke<1,MyTypify,CreateVespaTensorRef>(type_ref.cell_type(), type_ref, value, idx);
     }
 };
 
@@ -210,6 +210,56 @@ std::vector<int64_t> extract_sizes(const eval::ValueType &type) {
     return sizes;
 }
 
+std::vector<int64_t> with_batch_size(std::vector<int64_t> sizes, size_t batch_size) {
+    assert(!sizes.empty());
+    sizes[0] = batch_size;
+    return sizes;
+}
+
+// a dynamic outer dimension that has been wired with size 1
+bool is_batch_dimension(const Onnx::TensorInfo &onnx, const eval::ValueType &vespa) {
+    return (!onnx.dimensions.empty() && !onnx.dimensions[0].is_known() &&
+            (vespa.dimensions().size() == onnx.dimensions.size()) &&
+            (vespa.dimensions()[0].size == 1));
+}
+
+// the batch dimension may not be tied to any other dimension
+bool is_free_batch_dimension(const Onnx::TensorInfo &onnx, const std::set<vespalib::string> &inner_symbols) {
+    return (!onnx.dimensions[0].is_symbolic() || (inner_symbols.count(onnx.dimensions[0].name) == 0));
+}
+
+bool has_batch_dimension(const Onnx &model, const Onnx::WireInfo &info) {
+    std::set<vespalib::string> inner_symbols;
+    for (const auto *list: {&model.inputs(), &model.outputs()}) {
+        for (const auto &tensor: *list) {
+            for (size_t i = 1; i < tensor.dimensions.size(); ++i) {
+                if (tensor.dimensions[i].is_symbolic()) {
+                    inner_symbols.insert(tensor.dimensions[i].name);
+                }
+            }
+        }
+    }
+    for (size_t i = 0; i < model.inputs().size(); ++i) {
+        const auto &input = model.inputs()[i];
+        if (!is_batch_dimension(input, info.vespa_inputs[i]) || !is_free_batch_dimension(input, inner_symbols)) {
+            return false;
+        }
+    }
+    for (size_t i = 0; i < model.outputs().size(); ++i) {
+        const auto &output = model.outputs()[i];
+        if (!is_batch_dimension(output, info.vespa_outputs[i]) || !is_free_batch_dimension(output, inner_symbols)) {
+            return false;
+        }
+        // unknown inner output sizes are guessed, possibly based on the batch size
+        for (size_t d = 1; d < output.dimensions.size(); ++d) {
+            if (!output.dimensions[d].is_known() && !output.dimensions[d].is_symbolic()) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
 }
 
 vespalib::string
@@ -238,6 +288,15 @@ Onnx::TensorInfo::~TensorInfo() = default;
 
 //-----------------------------------------------------------------------------
 
+Onnx::WireInfo::WireInfo()
+    : vespa_inputs(),
+      onnx_inputs(),
+      onnx_outputs(),
+      vespa_outputs(),
+      has_batch_dimension(false)
+{
+}
+
 Onnx::WireInfo::~WireInfo() = default;
 
 Onnx::WirePlanner::~WirePlanner() = default;
@@ -335,6 +394,7 @@ Onnx::WirePlanner::get_wire_info(const Onnx &model) const
                 type_name(info.vespa_outputs.back().cell_type()).c_str());
         }
     }
+    info.has_batch_dimension = has_batch_dimension(model, info);
     return info;
 }
 
@@ -346,10 +406,16 @@ template <typename T>
 void
 Onnx::EvalContext::adapt_param(EvalContext &self, size_t idx, const eval::Value &param)
 {
-    const auto &cells_ref = static_cast<const DenseTensorView &>(param).cellsRef();
-    auto cells = unconstify(cells_ref.typify<T>());
-    const auto &sizes = self._wire_info.onnx_inputs[idx].dimensions;
-    self._param_values[idx] = Ort::Value::CreateTensor<T>(self._cpu_memory, cells.begin(), cells.size(), sizes.data(), sizes.size());
+    if constexpr (std::is_same_v<T,BFloat16>) {
+        // there is no onnx element type matching bfloat16 cells; they are always converted
+        (void) self; (void) idx; (void) param;
+        abort();
+    } else {
+        const auto &cells_ref = static_cast<const DenseTensorView &>(param).cellsRef();
+        auto cells = unconstify(cells_ref.typify<T>());
+        const auto &sizes = self._wire_info.onnx_inputs[idx].dimensions;
+        self._param_values[idx] = Ort::Value::CreateTensor<T>(self._cpu_memory, cells.begin(), cells.size(), sizes.data(), sizes.size());
+    }
 }
 
 template <typename SRC, typename DST>
@@ -475,6 +541,130 @@ Onnx::EvalContext::get_result(size_t i) const
 
 //-----------------------------------------------------------------------------
 
+Ort::AllocatorWithDefaultOptions Onnx::BatchEvalContext::_alloc;
+
+template <typename SRC, typename DST>
+void
+Onnx::BatchEvalContext::convert_param(BatchEvalContext &self, size_t idx, size_t i, const eval::Value &param)
+{
+    auto cells = static_cast<const DenseTensorView &>(param).cellsRef().typify<SRC>();
+    size_t n = cells.size();
+    assert(n == self._wire_info.vespa_inputs[i].dense_subspace_size());
+    const SRC *src = cells.begin();
+    DST *dst = self._param_values[i].GetTensorMutableData<DST>() + (idx * n);
+    for (size_t j = 0; j < n; ++j) {
+        dst[j] = DST(src[j]);
+    }
+}
+
+template <typename SRC, typename DST>
+void
+Onnx::BatchEvalContext::convert_result(BatchEvalContext &self, size_t i)
+{
+    size_t num_results = self._result_values.size();
+    const SRC *src = self._result_values[i].GetTensorMutableData<SRC>();
+    for (size_t idx = 0; idx < self._batch_size; ++idx) {
+        const auto &cells_ref = static_cast<const DenseTensorView &>(*self._results[(idx * num_results) + i]).cellsRef();
+        auto cells = unconstify(cells_ref.typify<DST>());
+        size_t n = cells.size();
+        DST *dst = cells.begin();
+        for (size_t j = 0; j < n; ++j) {
+            dst[j] = DST(src[j]);
+        }
+        src += n;
+    }
+}
+
+struct Onnx::BatchEvalContext::SelectConvertParam {
+    template <typename ...Ts> static auto invoke() { return convert_param<Ts...>; }
+    auto operator()(eval::ValueType::CellType ct, Onnx::ElementType et) {
+        return typify_invoke<2,MyTypify,SelectConvertParam>(ct, et);
+    }
+};
+
+struct Onnx::BatchEvalContext::SelectConvertResult {
+    template <typename ...Ts> static auto invoke() { return convert_result<Ts...>; }
+    auto operator()(Onnx::ElementType et, eval::ValueType::CellType ct) {
+        return typify_invoke<2,MyTypify,SelectConvertResult>(et, ct);
+    }
+};
+
+Onnx::BatchEvalContext::BatchEvalContext(const Onnx &model, const WireInfo &wire_info, size_t batch_size)
+    : _model(model),
+      _wire_info(wire_info),
+      _batch_size(batch_size),
+      _param_values(),
+      _result_values(),
+      _results(),
+      _param_binders(),
+      _result_converters()
+{
+    assert(_wire_info.has_batch_dimension);
+    assert(_batch_size > 0);
+    _param_values.reserve(_model.inputs().size());
+    _result_values.reserve(_model.outputs().size());
+    _results.reserve(_batch_size * _model.outputs().size());
+    auto result_guard = _result_values.begin();
+    for (size_t i = 0; i < _model.inputs().size(); ++i) {
+        const auto &vespa = _wire_info.vespa_inputs[i];
+        const auto &onnx = _wire_info.onnx_inputs[i];
+        TensorType batch_type(onnx.elements, with_batch_size(onnx.dimensions, _batch_size));
+        _param_values.push_back(CreateOnnxTensor()(batch_type, _alloc));
+        _param_binders.push_back(SelectConvertParam()(vespa.cell_type(), onnx.elements));
+    }
+    for (size_t i = 0; i < _model.outputs().size(); ++i) {
+        const auto &vespa = _wire_info.vespa_outputs[i];
+        const auto &onnx = _wire_info.onnx_outputs[i];
+        TensorType batch_type(onnx.elements, with_batch_size(onnx.dimensions, _batch_size));
+        _result_values.push_back(CreateOnnxTensor()(batch_type, _alloc));
+        if (!is_same_type(vespa.cell_type(), onnx.elements)) {
+            _result_converters.emplace_back(i, SelectConvertResult()(onnx.elements, vespa.cell_type()));
+        }
+    }
+    for (size_t idx = 0; idx < _batch_size; ++idx) {
+        for (size_t i = 0; i < _model.outputs().size(); ++i) {
+            const auto &vespa = _wire_info.vespa_outputs[i];
+            if (is_same_type(vespa.cell_type(), _wire_info.onnx_outputs[i].elements)) {
+                _results.push_back(CreateVespaTensorRef()(vespa, _result_values[i], idx));
+            } else {
+                _results.push_back(CreateVespaTensor()(vespa));
+            }
+        }
+    }
+    // make sure references to Ort::Value inside _result_values are safe
+    assert(result_guard == _result_values.begin());
+}
+
+Onnx::BatchEvalContext::~BatchEvalContext() = default;
+
+void
+Onnx::BatchEvalContext::bind_param(size_t idx, size_t i, const eval::Value &param)
+{
+    assert(idx < _batch_size);
+    _param_binders[i](*this, idx, i, param);
+}
+
+void
+Onnx::BatchEvalContext::eval()
+{
+    Ort::Session &session = const_cast<Ort::Session&>(_model._session);
+    Ort::RunOptions run_opts(nullptr);
+    session.Run(run_opts,
+                _model._input_name_refs.data(), _param_values.data(), _param_values.size(),
+                _model._output_name_refs.data(), _result_values.data(), _result_values.size());
+    for (const auto &entry: _result_converters) {
+        entry.second(*this, entry.first);
+    }
+}
+
+const eval::Value &
+Onnx::BatchEvalContext::get_result(size_t idx, size_t i) const
+{
+    return *_results[(idx * _result_values.size()) + i];
+}
+
+//-----------------------------------------------------------------------------
+
 Onnx::Shared::Shared()
     : _env(ORT_LOGGING_LEVEL_WARNING, "vespa-onnx-wrapper")
 {
@@ -32,6 +32,13 @@ namespace vespalib::tensor {
  * plan. Bind actual vespa values to the model inputs, invoke eval and
  * inspect the results. See the unit test (tests/tensor/onnx_wrapper)
  * for some examples.
+ *
+ * If all model inputs and outputs have a dynamic outer (batch)
+ * dimension and are wired with a size of 1 for that dimension, the
+ * wire info is marked as having a batch dimension. An
+ * Onnx::BatchEvalContext may then be used to calculate the results
+ * for multiple sets of inputs (typically one per document) with a
+ * single model invocation.
  **/
 class Onnx {
 public:
@@ -76,6 +83,8 @@ public:
         std::vector<Onnx::TensorType> onnx_inputs;
         std::vector<Onnx::TensorType> onnx_outputs;
         std::vector<eval::ValueType>  vespa_outputs;
+        bool                          has_batch_dimension;
+        WireInfo();
         ~WireInfo();
     };
 
@@ -135,6 +144,46 @@ public:
         const eval::Value &get_result(size_t i) const;
     };
 
+    // evaluation context for a batch of input sets; the wire info
+    // must have a batch dimension. Input values are bound per batch
+    // entry and are copied into the model input tensors. Results are
+    // views of the model output tensors, one per batch entry.
+    class BatchEvalContext {
+    private:
+        using param_fun_t = void (*)(BatchEvalContext &, size_t idx, size_t i, const eval::Value &);
+        using result_fun_t = void (*)(BatchEvalContext &, size_t i);
+
+        static Ort::AllocatorWithDefaultOptions _alloc;
+
+        const Onnx                  &_model;
+        const WireInfo              &_wire_info;
+        size_t                       _batch_size;
+        std::vector<Ort::Value>      _param_values;
+        std::vector<Ort::Value>      _result_values;
+        std::vector<eval::Value::UP> _results;
+        std::vector<param_fun_t>     _param_binders;
+        std::vector<std::pair<size_t,result_fun_t>> _result_converters;
+
+        template <typename SRC, typename DST>
+        static void convert_param(BatchEvalContext &self, size_t idx, size_t i, const eval::Value &param);
+
+        template <typename SRC, typename DST>
+        static void convert_result(BatchEvalContext &self, size_t i);
+
+    public:
+        struct SelectConvertParam;
+        struct SelectConvertResult;
+
+        BatchEvalContext(const Onnx &model, const WireInfo &wire_info, size_t batch_size);
+        ~BatchEvalContext();
+        size_t batch_size() const { return _batch_size; }
+        size_t num_params() const { return _param_values.size(); }
+        size_t num_results() const { return _result_values.size(); }
+        void bind_param(size_t idx, size_t i, const eval::Value &param);
+        void eval();
+        const eval::Value &get_result(size_t idx, size_t i) const;
+    };
+
 private:
     // common stuff shared between model sessions
     class Shared {
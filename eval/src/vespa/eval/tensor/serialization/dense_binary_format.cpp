@@ -4,7 +4,9 @@
 #include <vespa/eval/tensor/dense/dense_tensor.h>
 #include <vespa/vespalib/objects/nbostream.h>
 #include <vespa/vespalib/util/exceptions.h>
+#include <vespa/vespalib/util/stringfmt.h>
 #include <cassert>
+#include <cstring>
 
 using vespalib::nbostream;
 using vespalib::eval::ValueType;
@@ -50,12 +52,34 @@ size_t decodeDimensions(nbostream & stream, std::vector<Dimension> & dimensions)
     return cellsSize;
 }
 
+// cells are stored in network byte order; convert a single cell
+template <typename T>
+T decodeCell(const char *src) {
+    T value;
+    memcpy(&value, src, sizeof(T));
+    return nbo::n2h(value);
+}
+
+template <>
+BFloat16 decodeCell<BFloat16>(const char *src) {
+    return BFloat16::from_bits(decodeCell<uint16_t>(src));
+}
+
+// decode all cells directly from the stream buffer instead of
+// extracting them one at a time
 template<typename T, typename V>
 void decodeCells(nbostream &stream, size_t cellsSize, V &cells) {
-    T cellValue = 0.0;
+    if (cellsSize > (stream.size() / sizeof(T))) {
+        throw IllegalStateException(make_string("Stream too small for %zu cells: %zu bytes left",
+                                                cellsSize, stream.size()), VESPA_STRLOC);
+    }
+    const char *src = stream.peek();
+    stream.adjustReadPos(cellsSize * sizeof(T));
+    size_t offset = cells.size();
+    cells.resize(offset + cellsSize);
+    auto *dst = &cells[offset];
     for (size_t i = 0; i < cellsSize; ++i) {
-        stream >> cellValue;
-        cells.emplace_back(cellValue);
+        dst[i] = decodeCell<T>(src + (i * sizeof(T)));
     }
 }
 
@@ -68,6 +92,12 @@ void decodeCells(CellType cell_type, nbostream &stream, size_t cellsSize, V &cel
     case CellType::FLOAT:
         decodeCells<float>(stream, cellsSize, cells);
         break;
+    case CellType::INT8:
+        decodeCells<int8_t>(stream, cellsSize, cells);
+        break;
+    case CellType::BFLOAT16:
+        decodeCells<BFloat16>(stream, cellsSize, cells);
+        break;
     }
 }
 
@@ -86,6 +116,12 @@ DenseBinaryFormat::serialize(nbostream &stream, const DenseTensorView &tensor)
     case CellType::FLOAT:
         encodeCells<float>(stream, cells);
         break;
+    case CellType::INT8:
+        encodeCells<int8_t>(stream, cells);
+        break;
+    case CellType::BFLOAT16:
+        encodeCells<BFloat16>(stream, cells);
+        break;
     }
 }
 
@@ -94,7 +130,6 @@ struct CallDecodeCells {
     static std::unique_ptr<DenseTensorView>
     invoke(nbostream &stream, size_t numCells, ValueType &&newType) {
         std::vector<CT> newCells;
-        newCells.reserve(numCells);
         decodeCells<CT>(stream, numCells, newCells);
         return std::make_unique<DenseTensor<CT>>(std::move(newType), std::move(newCells));
     }
@@ -117,7 +152,6 @@ DenseBinaryFormat::deserializeCellsOnly(nbostream &stream, std::vector<T> &cells
     std::vector<Dimension> dimensions;
     size_t cellsSize = decodeDimensions(stream, dimensions);
     cells.clear();
-    cells.reserve(cellsSize);
     decodeCells(cell_type, stream, cellsSize, cells);
 }
 
@@ -94,13 +94,19 @@ size_t encodeCells(nbostream &stream, const Tensor &tensor, CellType cell_type)
     case CellType::FLOAT:
         return encodeCells<float>(stream, tensor);
         break;
+    case CellType::INT8:
+        return encodeCells<int8_t>(stream, tensor);
+        break;
+    case CellType::BFLOAT16:
+        return encodeCells<BFloat16>(stream, tensor);
+        break;
     }
     return 0;
 }
 
 template<typename T>
 void decodeCells(nbostream &stream, size_t dimensionsSize, size_t cellsSize, DirectSparseTensorBuilder &builder) {
-    T cellValue = 0.0;
+    T cellValue = T();
     vespalib::string str;
     SparseTensorAddressBuilder address;
     for (size_t cellIdx = 0; cellIdx < cellsSize; ++cellIdx) {
@@ -126,6 +132,12 @@ void decodeCells(CellType cell_type, nbostream &stream, size_t dimensionsSize, s
     case CellType::FLOAT:
         decodeCells<float>(stream, dimensionsSize, cellsSize, builder);
         break;
+    case CellType::INT8:
+        decodeCells<int8_t>(stream, dimensionsSize, cellsSize, builder);
+        break;
+    case CellType::BFLOAT16:
+        decodeCells<BFloat16>(stream, dimensionsSize, cellsSize, builder);
+        break;
     }
 }
 
@@ -7,10 +7,16 @@ namespace vespalib::tensor {
 void
 DirectSparseTensorBuilder::copyCells(const Cells &cells_in)
 {
+    auto &dictionary = SparseTensorLabelDictionary::instance();
     for (const auto &cell : cells_in) {
         SparseTensorAddressRef oldRef = cell.first;
-        SparseTensorAddressRef newRef(oldRef, _stash);
-        _cells[newRef] = cell.second;
+        auto res = _cells.insert(std::make_pair(oldRef, cell.second));
+        if (res.second) {
+            res.first->first = SparseTensorAddressRef(oldRef, _stash);
+            dictionary.copy_labels(res.first->first);
+        } else {
+            res.first->second = cell.second;
+        }
     }
 }
 
@@ -36,15 +42,20 @@ DirectSparseTensorBuilder::DirectSparseTensorBuilder(const eval::ValueType &type
     copyCells(cells_in);
 }
 
-DirectSparseTensorBuilder::~DirectSparseTensorBuilder() = default;
+DirectSparseTensorBuilder::~DirectSparseTensorBuilder()
+{
+    SparseTensor::releaseCells(_cells);
+}
 
 Tensor::UP
 DirectSparseTensorBuilder::build() {
-    return std::make_unique<SparseTensor>(std::move(_type), std::move(_cells), std::move(_stash));
+    auto result = std::make_unique<SparseTensor>(std::move(_type), std::move(_cells), std::move(_stash));
+    _cells = Cells();
+    return result;
 }
 
 void DirectSparseTensorBuilder::reserve(uint32_t estimatedCells) {
-    _cells.resize(estimatedCells*2);
+    _cells.resize(estimatedCells);
 }
 
 }
\ No newline at end of file
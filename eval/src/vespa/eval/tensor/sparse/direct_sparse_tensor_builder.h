@@ -5,12 +5,14 @@
 #include <vespa/vespalib/util/hdr_abort.h>
 #include "sparse_tensor.h"
 #include "sparse_tensor_address_builder.h"
+#include "sparse_tensor_label_dictionary.h"
 
 namespace vespalib::tensor {
 
 /**
  * Utility class to build tensors of type SparseTensor, to be used by
- * tensor operations.
+ * tensor operations. Addresses of inserted cells hold a reference to
+ * their labels; these are handed over to the built tensor.
  */
 class DirectSparseTensorBuilder
 {
@@ -38,8 +40,9 @@ public:
     {
         auto res = _cells.insert(std::make_pair(address, value));
         if (res.second) {
-            // Replace key with own copy
+            // Replace key with own copy, referencing its labels
             res.first->first = SparseTensorAddressRef(address, _stash);
+            SparseTensorLabelDictionary::instance().copy_labels(res.first->first);
         } else {
             res.first->second = func(res.first->second, value);
         }
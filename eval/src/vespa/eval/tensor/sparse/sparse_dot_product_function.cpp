@@ -0,0 +1,89 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "sparse_dot_product_function.h"
+#include "sparse_tensor.h"
+#include <vespa/eval/eval/operation.h>
+#include <vespa/eval/eval/value.h>
+#include <vespa/eval/eval/tensor_engine.h>
+
+namespace vespalib::tensor {
+
+using eval::Value;
+using eval::ValueType;
+using eval::TensorFunction;
+using eval::TensorEngine;
+using eval::as;
+using eval::Aggr;
+using namespace eval::tensor_function;
+using namespace eval::operation;
+
+namespace {
+
+double sparse_dot_product(const SparseTensor::Cells &small, const SparseTensor::Cells &large) {
+    double result = 0.0;
+    for (const auto &cell: small) {
+        auto pos = large.find(cell.first);
+        if (pos != large.end()) {
+            result += (cell.second * pos->second);
+        }
+    }
+    return result;
+}
+
+void my_sparse_dot_product_op(eval::InterpretedFunction::State &state, uint64_t) {
+    const Value &lhs = state.peek(1);
+    const Value &rhs = state.peek(0);
+    auto lhs_tensor = dynamic_cast<const SparseTensor *>(lhs.as_tensor());
+    auto rhs_tensor = dynamic_cast<const SparseTensor *>(rhs.as_tensor());
+    if (lhs_tensor && rhs_tensor) {
+        const auto &lhs_cells = lhs_tensor->cells();
+        const auto &rhs_cells = rhs_tensor->cells();
+        double result = (lhs_cells.size() <= rhs_cells.size())
+                        ? sparse_dot_product(lhs_cells, rhs_cells)
+                        : sparse_dot_product(rhs_cells, lhs_cells);
+        state.pop_pop_push(state.stash.create<eval::DoubleValue>(result));
+    } else {
+        // other tensor implementations use generic evaluation
+        const Value &product = state.engine.join(lhs, rhs, Mul::f, state.stash);
+        state.pop_pop_push(state.engine.reduce(product, Aggr::SUM, {}, state.stash));
+    }
+}
+
+} // namespace vespalib::tensor::<unnamed>
+
+SparseDotProductFunction::SparseDotProductFunction(const eval::TensorFunction &lhs_in,
+                                                   const eval::TensorFunction &rhs_in)
+    : eval::tensor_function::Op2(eval::ValueType::double_type(), lhs_in, rhs_in)
+{
+}
+
+eval::InterpretedFunction::Instruction
+SparseDotProductFunction::compile_self(const TensorEngine &, Stash &) const
+{
+    return eval::InterpretedFunction::Instruction(my_sparse_dot_product_op);
+}
+
+bool
+SparseDotProductFunction::compatible_types(const ValueType &res, const ValueType &lhs, const ValueType &rhs)
+{
+    return (res.is_double() && lhs.is_sparse() && (rhs.dimensions() == lhs.dimensions()));
+}
+
+const TensorFunction &
+SparseDotProductFunction::optimize(const eval::TensorFunction &expr, Stash &stash)
+{
+    auto reduce = as<Reduce>(expr);
+    if (reduce && (reduce->aggr() == Aggr::SUM)) {
+        auto join = as<Join>(reduce->child());
+        if (join && (join->function() == Mul::f)) {
+            const TensorFunction &lhs = join->lhs();
+            const TensorFunction &rhs = join->rhs();
+            if (compatible_types(expr.result_type(), lhs.result_type(), rhs.result_type())) {
+                return stash.create<SparseDotProductFunction>(lhs, rhs);
+            }
+        }
+    }
+    return expr;
+}
+
+} // namespace vespalib::tensor
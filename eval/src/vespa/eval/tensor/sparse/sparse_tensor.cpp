@@ -3,6 +3,7 @@
 #include "sparse_tensor.h"
 #include "sparse_tensor_add.h"
 #include "sparse_tensor_address_builder.h"
+#include "sparse_tensor_label_dictionary.h"
 #include "sparse_tensor_apply.hpp"
 #include "sparse_tensor_match.h"
 #include "sparse_tensor_modify.h"
@@ -14,8 +15,7 @@
 #include <vespa/eval/tensor/tensor_address_builder.h>
 #include <vespa/eval/tensor/tensor_apply.h>
 #include <vespa/eval/tensor/tensor_visitor.h>
-#include <vespa/vespalib/stllike/hash_map.hpp>
-#include <vespa/vespalib/stllike/hash_map_equal.hpp>
+#include <vespa/vespalib/stllike/flat_hash_map.hpp>
 #include <vespa/vespalib/util/array_equal.hpp>
 
 #include <vespa/log/log.h>
@@ -25,13 +25,10 @@ using vespalib::eval::TensorSpec;
 
 namespace vespalib::tensor {
 
-namespace {
-
-using Cells = SparseTensor::Cells;
-
 void
-copyCells(Cells &cells, const Cells &cells_in, Stash &stash)
+SparseTensor::copyCells(Cells &cells, const Cells &cells_in, Stash &stash)
 {
+    auto &dictionary = SparseTensorLabelDictionary::instance();
     // copy the exact hashtable structure:
     cells = cells_in;
     // copy the actual contents of the addresses,
@@ -40,10 +37,18 @@ copyCells(Cells &cells, const Cells &cells_in, Stash &stash)
     for (auto &cell : cells) {
         SparseTensorAddressRef oldRef = cell.first;
         SparseTensorAddressRef newRef(oldRef, stash);
+        dictionary.copy_labels(newRef);
         cell.first = newRef;
     }
 }
 
+void
+SparseTensor::releaseCells(const Cells &cells)
+{
+    auto &dictionary = SparseTensorLabelDictionary::instance();
+    for (const auto &cell : cells) {
+        dictionary.release_labels(cell.first);
+    }
 }
 
 SparseTensor::SparseTensor(const eval::ValueType &type_in, const Cells &cells_in)
@@ -61,7 +66,10 @@ SparseTensor::SparseTensor(eval::ValueType &&type_in, Cells &&cells_in, Stash &&
       _stash(std::move(stash_in))
 { }
 
-SparseTensor::~SparseTensor() = default;
+SparseTensor::~SparseTensor()
+{
+    releaseCells(_cells);
+}
 
 bool
 SparseTensor::operator==(const SparseTensor &rhs) const
@@ -278,4 +286,4 @@ SparseTensor::get_memory_usage() const
 
 }
 
-VESPALIB_HASH_MAP_INSTANTIATE(vespalib::tensor::SparseTensorAddressRef, double);
+VESPALIB_FLAT_HASH_MAP_INSTANTIATE(vespalib::tensor::SparseTensorAddressRef, double);
@@ -7,7 +7,7 @@
 #include <vespa/eval/tensor/tensor.h>
 #include <vespa/eval/tensor/tensor_address.h>
 #include <vespa/eval/tensor/types.h>
-#include <vespa/vespalib/stllike/hash_map.h>
+#include <vespa/vespalib/stllike/flat_hash_map.h>
 #include <vespa/vespalib/stllike/string.h>
 #include <vespa/vespalib/util/stash.h>
 
@@ -17,12 +17,15 @@ namespace vespalib::tensor {
  * A tensor implementation using serialized tensor addresses to
  * improve CPU cache and TLB hit ratio, relative to SimpleTensor
  * implementation.
+ *
+ * Addresses are sequences of label ids from
+ * SparseTensorLabelDictionary. Each cell address holds a reference
+ * to its labels, which is released when the tensor is destructed.
  */
 class SparseTensor : public Tensor
 {
 public:
-    using Cells = hash_map<SparseTensorAddressRef, double, hash<SparseTensorAddressRef>,
-                           std::equal_to<>, hashtable_base::and_modulator>;
+    using Cells = flat_hash_map<SparseTensorAddressRef, double, hash<SparseTensorAddressRef>, std::equal_to<>>;
 
     static constexpr size_t STASH_CHUNK_SIZE = 16384u;
 
@@ -35,6 +38,10 @@ public:
     explicit SparseTensor(const eval::ValueType &type_in, const Cells &cells_in);
     SparseTensor(eval::ValueType &&type_in, Cells &&cells_in, Stash &&stash_in);
     ~SparseTensor() override;
+    // copy cells (and the addresses they refer to) into the given stash
+    static void copyCells(Cells &cells, const Cells &cells_in, Stash &stash);
+    // release the labels referenced by all cell addresses
+    static void releaseCells(const Cells &cells);
     const Cells &cells() const { return _cells; }
     const eval::ValueType &fast_type() const { return _type; }
     bool operator==(const SparseTensor &rhs) const;
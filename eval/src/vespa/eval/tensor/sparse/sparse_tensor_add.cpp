@@ -1,6 +1,7 @@
 // Copyright 2019 Oath Inc. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 
 #include "sparse_tensor_add.h"
+#include "sparse_tensor_label_dictionary.h"
 
 namespace vespalib::tensor {
 
@@ -12,22 +13,32 @@ SparseTensorAdd::SparseTensorAdd(const eval::ValueType &type, Cells &&cells, Sta
 {
 }
 
-SparseTensorAdd::~SparseTensorAdd() = default;
+SparseTensorAdd::~SparseTensorAdd()
+{
+    SparseTensor::releaseCells(_cells);
+}
 
 void
 SparseTensorAdd::visit(const TensorAddress &address, double value)
 {
     _addressBuilder.populate(_type, address);
     auto addressRef = _addressBuilder.getAddressRef();
-    // Make a persistent copy of the tensor address (owned by _stash) as the cell to insert might not already exist.
-    auto  persistentAddress = SparseTensorAddressRef(addressRef, _stash);
-    _cells[persistentAddress] = value;
+    auto res = _cells.insert(std::make_pair(addressRef, value));
+    if (res.second) {
+        // Make a persistent copy of the tensor address (owned by _stash), referencing its labels.
+        res.first->first = SparseTensorAddressRef(addressRef, _stash);
+        SparseTensorLabelDictionary::instance().copy_labels(res.first->first);
+    } else {
+        res.first->second = value;
+    }
 }
 
 std::unique_ptr<Tensor>
 SparseTensorAdd::build()
 {
-    return std::make_unique<SparseTensor>(std::move(_type), std::move(_cells), std::move(_stash));
+    auto result = std::make_unique<SparseTensor>(std::move(_type), std::move(_cells), std::move(_stash));
+    _cells = Cells();
+    return result;
 }
 
 }
@@ -8,10 +8,26 @@
 namespace vespalib::tensor {
 
 SparseTensorAddressBuilder::SparseTensorAddressBuilder()
-    : _address()
+    : _address(),
+      _owned()
 {
 }
 
+SparseTensorAddressBuilder::~SparseTensorAddressBuilder()
+{
+    release_owned();
+}
+
+void
+SparseTensorAddressBuilder::release_owned()
+{
+    auto &dictionary = SparseTensorLabelDictionary::instance();
+    for (label_t label: _owned) {
+        dictionary.release(label);
+    }
+    _owned.clear();
+}
+
 void
 SparseTensorAddressBuilder::populate(const eval::ValueType &type, const TensorAddress &address)
 {
@@ -3,6 +3,8 @@
 #pragma once
 
 #include "sparse_tensor_address_ref.h"
+#include "sparse_tensor_label_dictionary.h"
+#include <vector>
 #include <vespa/vespalib/stllike/string.h>
 
 namespace vespalib::eval { class ValueType; }
@@ -17,18 +19,26 @@ class TensorAddress;
  * All dimensions in the tensors are present, empty label is the "undefined"
  * value.
  *
- * Format: (labelStr NUL)*
+ * Format: (label id)*, using label ids from SparseTensorLabelDictionary.
+ *
+ * Labels added as strings are interned, and the builder holds a
+ * reference to them until it is cleared. Label ids appended directly
+ * must be kept alive by the caller (typically by the tensor the
+ * label ids are copied from).
  */
 class SparseTensorAddressBuilder
 {
+public:
+    using label_t = SparseTensorLabelDictionary::label_t;
 private:
-    vespalib::Array<char> _address;
+    vespalib::Array<label_t> _address;
+    std::vector<label_t>     _owned;
+
+    void release_owned();
 
 protected:
-    void append(vespalib::stringref str) {
-        for (size_t i(0); i < str.size() + 1; i++) {
-            _address.push_back_fast(str[i]);
-        }
+    void append(label_t label) {
+        _address.push_back_fast(label);
     }
     void ensure_room(size_t additional) {
         if (_address.capacity() < (_address.size() + additional)) {
@@ -37,12 +47,23 @@ protected:
     }
 public:
     SparseTensorAddressBuilder();
+    SparseTensorAddressBuilder(const SparseTensorAddressBuilder &) = delete;
+    SparseTensorAddressBuilder &operator=(const SparseTensorAddressBuilder &) = delete;
+    ~SparseTensorAddressBuilder();
     void add(vespalib::stringref label) {
-        ensure_room(label.size()+1);
-        append(label);
+        label_t id = SparseTensorLabelDictionary::instance().intern(label);
+        if (id != SparseTensorLabelDictionary::UNDEFINED) {
+            _owned.push_back(id);
+        }
+        _address.push_back(id);
+    }
+    void addUndefined() { _address.push_back(SparseTensorLabelDictionary::UNDEFINED); }
+    void clear() {
+        _address.clear();
+        if (!_owned.empty()) {
+            release_owned();
+        }
     }
-    void addUndefined() { _address.push_back('\0'); }
-    void clear() { _address.clear(); }
     void set(std::initializer_list<vespalib::stringref> labels) {
         clear();
         for (const auto &label: labels) {
@@ -50,7 +71,7 @@ public:
         }
     }
     SparseTensorAddressRef getAddressRef() const {
-        return SparseTensorAddressRef(&_address[0], _address.size());
+        return SparseTensorAddressRef(&_address[0], _address.size() * sizeof(label_t));
     }
     bool empty() const { return _address.empty(); }
     void populate(const eval::ValueType &type, const TensorAddress &address);
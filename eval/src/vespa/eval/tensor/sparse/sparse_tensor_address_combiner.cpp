@@ -39,20 +39,20 @@ TensorAddressCombiner::combine(SparseTensorAddressRef lhsRef,
                                SparseTensorAddressRef rhsRef)
 {
     clear();
-    ensure_room(lhsRef.size() + rhsRef.size());
+    ensure_room(_ops.size());
     SparseTensorAddressDecoder lhs(lhsRef);
     SparseTensorAddressDecoder rhs(rhsRef);
     for (auto op : _ops) {
         switch (op) {
         case AddressOp::LHS:
-            append(lhs.decodeLabel());
+            append(lhs.decodeLabelId());
             break;
         case AddressOp::RHS:
-            append(rhs.decodeLabel());
+            append(rhs.decodeLabelId());
             break;
         case AddressOp::BOTH:
-            auto lhsLabel(lhs.decodeLabel());
-            auto rhsLabel(rhs.decodeLabel());
+            auto lhsLabel(lhs.decodeLabelId());
+            auto rhsLabel(rhs.decodeLabelId());
             if (lhsLabel != rhsLabel) {
                 return false;
             }
@@ -4,6 +4,7 @@
 
 #include <vespa/vespalib/stllike/string.h>
 #include "sparse_tensor_address_ref.h"
+#include "sparse_tensor_label_dictionary.h"
 
 namespace vespalib::tensor {
 
@@ -12,27 +13,22 @@ namespace vespalib::tensor {
  */
 class SparseTensorAddressDecoder
 {
-    const char *_cur;
-    const char *_end;
+    using label_t = SparseTensorLabelDictionary::label_t;
+    const label_t *_cur;
+    const label_t *_end;
 public:
     SparseTensorAddressDecoder(SparseTensorAddressRef ref)
-        : _cur(static_cast<const char *>(ref.start())),
-          _end(_cur + ref.size())
+        : _cur(static_cast<const label_t *>(ref.start())),
+          _end(_cur + (ref.size() / sizeof(label_t)))
     {
     }
 
     bool valid() const { return _cur != _end; }
 
-    void skipLabel() {
-        while (*_cur != '\0') {
-            ++_cur;
-        }
-        ++_cur;
-    }
+    void skipLabel() { ++_cur; }
+    label_t decodeLabelId() { return *_cur++; }
     vespalib::stringref decodeLabel() {
-        const char *base = _cur;
-        skipLabel();
-        return vespalib::stringref(base, _cur - base - 1);
+        return SparseTensorLabelDictionary::instance().label(*_cur++);
     }
 
 };
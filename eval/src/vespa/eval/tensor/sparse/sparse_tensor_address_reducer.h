@@ -30,6 +30,7 @@ public:
     void reduce(SparseTensorAddressRef ref)
     {
         clear();
+        ensure_room(_ops.size());
         SparseTensorAddressDecoder decoder(ref);
         for (auto op : _ops) {
             switch (op) {
@@ -37,7 +38,7 @@ public:
                 decoder.skipLabel();
                 break;
             case AddressOp::COPY:
-                add(decoder.decodeLabel());
+                append(decoder.decodeLabelId());
             }
         }
         assert(!decoder.valid());
@@ -0,0 +1,156 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "sparse_tensor_label_dictionary.h"
+#include <vespa/vespalib/stllike/hash_fun.h>
+#include <cassert>
+
+namespace vespalib::tensor {
+
+size_t
+SparseTensorLabelDictionary::LabelHash::operator()(const vespalib::string &label) const
+{
+    return hashValue(label.data(), label.size());
+}
+
+SparseTensorLabelDictionary::Partition::Partition()
+    : _lock(),
+      _map(),
+      _chunks(),
+      _size(0),
+      _free(FREE)
+{
+    for (auto &chunk: _chunks) {
+        chunk.store(nullptr, std::memory_order_relaxed);
+    }
+}
+
+SparseTensorLabelDictionary::Partition::~Partition()
+{
+    for (auto &chunk: _chunks) {
+        delete[] chunk.load(std::memory_order_relaxed);
+    }
+}
+
+uint32_t
+SparseTensorLabelDictionary::Partition::alloc_entry()
+{
+    if (_free != FREE) {
+        uint32_t idx = _free;
+        _free = entry(idx).next_free;
+        return idx;
+    }
+    assert(_size < MAX_ENTRIES);
+    uint32_t idx = _size++;
+    uint32_t chunk = chunk_of(idx);
+    if (_chunks[chunk].load(std::memory_order_relaxed) == nullptr) {
+        _chunks[chunk].store(new Entry[1u << (chunk + FIRST_CHUNK_BITS)], std::memory_order_release);
+    }
+    return idx;
+}
+
+uint32_t
+SparseTensorLabelDictionary::Partition::intern(const vespalib::string &label)
+{
+    std::lock_guard guard(_lock);
+    auto pos = _map.find(label);
+    if (pos != _map.end()) {
+        entry(pos->second).ref_cnt.fetch_add(1, std::memory_order_relaxed);
+        return pos->second;
+    }
+    uint32_t idx = alloc_entry();
+    auto res = _map.emplace(label, idx);
+    assert(res.second);
+    Entry &e = entry(idx);
+    e.label = &res.first->first;
+    e.ref_cnt.store(1, std::memory_order_relaxed);
+    return idx;
+}
+
+void
+SparseTensorLabelDictionary::Partition::release(uint32_t idx)
+{
+    Entry &e = entry(idx);
+    if (e.ref_cnt.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        std::lock_guard guard(_lock);
+        // the label may have been interned again (or already been
+        // removed by a later release) before we got the lock
+        if (e.ref_cnt.load(std::memory_order_relaxed) == 0) {
+            auto pos = _map.find(*e.label);
+            assert((pos != _map.end()) && (pos->second == idx));
+            _map.erase(pos);
+            e.label = nullptr;
+            e.ref_cnt.store(FREE, std::memory_order_relaxed);
+            e.next_free = _free;
+            _free = idx;
+        }
+    }
+}
+
+size_t
+SparseTensorLabelDictionary::Partition::size()
+{
+    std::lock_guard guard(_lock);
+    return _map.size();
+}
+
+SparseTensorLabelDictionary::SparseTensorLabelDictionary()
+    : _parts()
+{
+    // reserve the first id of the first partition for the empty label
+    uint32_t idx = _parts[0].intern("");
+    assert(idx == UNDEFINED);
+}
+
+SparseTensorLabelDictionary::~SparseTensorLabelDictionary() = default;
+
+SparseTensorLabelDictionary &
+SparseTensorLabelDictionary::instance()
+{
+    // never destructed, since tensors with static storage duration
+    // may release their labels after this object would be destructed
+    static SparseTensorLabelDictionary *dictionary = new SparseTensorLabelDictionary();
+    return *dictionary;
+}
+
+SparseTensorLabelDictionary::label_t
+SparseTensorLabelDictionary::intern(vespalib::stringref label)
+{
+    if (label.empty()) {
+        return UNDEFINED;
+    }
+    vespalib::string str(label);
+    uint32_t part = (hashValue(str.data(), str.size()) >> 32) & PART_MASK;
+    return ((_parts[part].intern(str) << PART_BITS) | part);
+}
+
+void
+SparseTensorLabelDictionary::copy_labels(SparseTensorAddressRef address)
+{
+    const label_t *pos = static_cast<const label_t *>(address.start());
+    const label_t *end = pos + (address.size() / sizeof(label_t));
+    for (; pos < end; ++pos) {
+        copy(*pos);
+    }
+}
+
+void
+SparseTensorLabelDictionary::release_labels(SparseTensorAddressRef address)
+{
+    const label_t *pos = static_cast<const label_t *>(address.start());
+    const label_t *end = pos + (address.size() / sizeof(label_t));
+    for (; pos < end; ++pos) {
+        release(*pos);
+    }
+}
+
+size_t
+SparseTensorLabelDictionary::size()
+{
+    size_t result = 0;
+    for (auto &part: _parts) {
+        result += part.size();
+    }
+    return result;
+}
+
+}
@@ -0,0 +1,132 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include "sparse_tensor_address_ref.h"
+#include <vespa/vespalib/stllike/string.h>
+#include <atomic>
+#include <mutex>
+#include <unordered_map>
+
+namespace vespalib::tensor {
+
+/**
+ * Process wide dictionary of the labels used in sparse tensor
+ * addresses. Each unique label is stored once and identified by a
+ * fixed-width label id, making sparse tensor addresses sequences of
+ * label ids that are cheap to hash, compare and copy.
+ *
+ * Labels are reference counted. Interning a label gives a reference
+ * to it, and each address stored as a cell key in a sparse tensor (or
+ * in a builder of one) holds a reference to each of its labels. When
+ * the last reference is released the label is removed and its id may
+ * be reused. The empty label, used for undefined dimensions, always
+ * has id 0 and is not reference counted.
+ *
+ * The dictionary is partitioned on label hash to reduce lock
+ * contention. Only interning a label and releasing its last reference
+ * needs to lock a partition; adding references and looking up the
+ * string for a label id are lock-free.
+ **/
+class SparseTensorLabelDictionary
+{
+public:
+    using label_t = uint32_t;
+    static constexpr label_t UNDEFINED = 0;
+
+private:
+    static constexpr uint32_t PART_BITS = 6;
+    static constexpr uint32_t NUM_PARTS = (1u << PART_BITS);
+    static constexpr uint32_t PART_MASK = (NUM_PARTS - 1);
+    // entries are stored in chunks of doubling size, the first one
+    // holding 2^FIRST_CHUNK_BITS entries
+    static constexpr uint32_t FIRST_CHUNK_BITS = 8;
+    static constexpr uint32_t MAX_CHUNKS = (32 - PART_BITS - FIRST_CHUNK_BITS + 1);
+    static constexpr uint32_t MAX_ENTRIES = (1u << (32 - PART_BITS));
+    static constexpr uint32_t FREE = -1;
+
+    struct Entry {
+        const vespalib::string *label;
+        std::atomic<uint32_t>   ref_cnt;
+        uint32_t                next_free;
+        Entry() : label(nullptr), ref_cnt(FREE), next_free(FREE) {}
+    };
+
+    struct LabelHash {
+        size_t operator()(const vespalib::string &label) const;
+    };
+
+    class Partition {
+    private:
+        using Map = std::unordered_map<vespalib::string, uint32_t, LabelHash>;
+        std::mutex          _lock;
+        Map                 _map;
+        std::atomic<Entry*> _chunks[MAX_CHUNKS];
+        uint32_t            _size;
+        uint32_t            _free;
+
+        static uint32_t chunk_of(uint32_t idx) {
+            return (31 - __builtin_clz((idx >> FIRST_CHUNK_BITS) + 1));
+        }
+        static uint32_t chunk_start(uint32_t chunk) {
+            return (((1u << chunk) - 1) << FIRST_CHUNK_BITS);
+        }
+        uint32_t alloc_entry();
+
+    public:
+        Partition();
+        ~Partition();
+        Entry &entry(uint32_t idx) const {
+            uint32_t chunk = chunk_of(idx);
+            return _chunks[chunk].load(std::memory_order_acquire)[idx - chunk_start(chunk)];
+        }
+        uint32_t intern(const vespalib::string &label);
+        void release(uint32_t idx);
+        size_t size();
+    };
+
+    Partition _parts[NUM_PARTS];
+
+    SparseTensorLabelDictionary();
+    ~SparseTensorLabelDictionary();
+
+    const Partition &part_of(label_t label) const { return _parts[label & PART_MASK]; }
+    Partition &part_of(label_t label) { return _parts[label & PART_MASK]; }
+
+public:
+    SparseTensorLabelDictionary(const SparseTensorLabelDictionary &) = delete;
+    SparseTensorLabelDictionary &operator=(const SparseTensorLabelDictionary &) = delete;
+
+    static SparseTensorLabelDictionary &instance();
+
+    // obtain the id of the given label, adding a reference to it
+    label_t intern(vespalib::stringref label);
+
+    // add a reference to a label the caller already holds a reference to
+    void copy(label_t label) {
+        if (label != UNDEFINED) {
+            part_of(label).entry(label >> PART_BITS).ref_cnt.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    // release a reference to a label
+    void release(label_t label) {
+        if (label != UNDEFINED) {
+            part_of(label).release(label >> PART_BITS);
+        }
+    }
+
+    // the string for a label the caller holds a reference to
+    const vespalib::string &label(label_t label) const {
+        return *part_of(label).entry(label >> PART_BITS).label;
+    }
+
+    // add or release a reference to all labels in an address
+    void copy_labels(SparseTensorAddressRef address);
+    void release_labels(SparseTensorAddressRef address);
+
+    // number of labels currently in the dictionary
+    size_t size();
+};
+
+}
@@ -2,7 +2,7 @@
 
 #include "sparse_tensor_match.h"
 #include "sparse_tensor_address_decoder.h"
-#include <vespa/vespalib/stllike/hash_map.hpp>
+#include <vespa/vespalib/stllike/flat_hash_map.hpp>
 #include <vespa/vespalib/util/overload.h>
 #include <vespa/vespalib/util/visit_ranges.h>
 #include <assert.h>
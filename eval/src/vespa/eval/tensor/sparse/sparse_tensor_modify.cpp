@@ -14,7 +14,10 @@ SparseTensorModify::SparseTensorModify(join_fun_t op, const eval::ValueType &typ
 {
 }
 
-SparseTensorModify::~SparseTensorModify() = default;
+SparseTensorModify::~SparseTensorModify()
+{
+    SparseTensor::releaseCells(_cells);
+}
 
 void
 SparseTensorModify::visit(const TensorAddress &address, double value)
@@ -30,7 +33,9 @@ SparseTensorModify::visit(const TensorAddress &address, double value)
 std::unique_ptr<Tensor>
 SparseTensorModify::build()
 {
-    return std::make_unique<SparseTensor>(std::move(_type), std::move(_cells), std::move(_stash));
+    auto result = std::make_unique<SparseTensor>(std::move(_type), std::move(_cells), std::move(_stash));
+    _cells = Cells();
+    return result;
 }
 
 }
@@ -1,6 +1,7 @@
 // Copyright 2019 Oath Inc. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 
 #include "sparse_tensor_remove.h"
+#include "sparse_tensor_label_dictionary.h"
 #include <vespa/eval/tensor/tensor_address_element_iterator.h>
 
 namespace vespalib::tensor {
@@ -13,7 +14,10 @@ SparseTensorRemove::SparseTensorRemove(const eval::ValueType &type, Cells &&cell
 {
 }
 
-SparseTensorRemove::~SparseTensorRemove() = default;
+SparseTensorRemove::~SparseTensorRemove()
+{
+    SparseTensor::releaseCells(_cells);
+}
 
 void
 SparseTensorRemove::visit(const TensorAddress &address, double value)
@@ -21,13 +25,19 @@ SparseTensorRemove::visit(const TensorAddress &address, double value)
     (void) value;
     _addressBuilder.populate(_type, address);
     auto addressRef = _addressBuilder.getAddressRef();
-    _cells.erase(addressRef);
+    auto itr = _cells.find(addressRef);
+    if (itr != _cells.end()) {
+        SparseTensorLabelDictionary::instance().release_labels(itr->first);
+        _cells.erase(itr);
+    }
 }
 
 std::unique_ptr<Tensor>
 SparseTensorRemove::build()
 {
-    return std::make_unique<SparseTensor>(std::move(_type), std::move(_cells), std::move(_stash));
+    auto result = std::make_unique<SparseTensor>(std::move(_type), std::move(_cells), std::move(_stash));
+    _cells = Cells();
+    return result;
 }
 
 }
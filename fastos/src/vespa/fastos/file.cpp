@@ -502,6 +502,15 @@ void FastOS_FileInterface::dropFromCache() const
 {
 }
 
+void FastOS_FileInterface::willNeed(int64_t, size_t) const
+{
+}
+
+bool FastOS_FileInterface::preallocate(int64_t, size_t)
+{
+    return false;
+}
+
 FastOS_DirectoryScanInterface::FastOS_DirectoryScanInterface(const char *path)
     : _searchPath(strdup(path))
 {
@@ -604,6 +604,26 @@ public:
      **/
     virtual void dropFromCache() const;
 
+    /**
+     * Hint that the given range of the file will be read soon. Starts
+     * reading it into the FS cache (or the memory map) without blocking.
+     *
+     * @param offset Start of range
+     * @param len    Length of range
+     **/
+    virtual void willNeed(int64_t offset, size_t len) const;
+
+    /**
+     * Ask the file system to allocate disk space for the given range
+     * without changing the file size, so later writes to the range
+     * do not have to extend the file allocation. Best effort.
+     *
+     * @param offset Start of range
+     * @param len    Length of range
+     * @return       true if the space was allocated
+     **/
+    virtual bool preallocate(int64_t offset, size_t len);
+
     enum Error
     {
         ERR_ZERO = 1,   // No error                       New style
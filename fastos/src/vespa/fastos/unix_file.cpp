@@ -8,6 +8,7 @@
 *****************************************************************************/
 
 #include "file.h"
+#include <algorithm>
 #include <sstream>
 #include <cassert>
 #include <cstring>
@@ -333,6 +334,38 @@ void FastOS_UNIX_File::dropFromCache() const
 #endif
 }
 
+void FastOS_UNIX_File::willNeed(int64_t offset, size_t len) const
+{
+    if ((offset < 0) || (len == 0)) {
+        return;
+    }
+    if (_mmapbase != nullptr) {
+        if (size_t(offset) >= _mmaplen) {
+            return;
+        }
+        size_t pageSize = getpagesize();
+        size_t start = size_t(offset) & ~(pageSize - 1);
+        size_t end = std::min(size_t(offset) + len, _mmaplen);
+        posix_madvise(static_cast<char *>(_mmapbase) + start, end - start, POSIX_MADV_WILLNEED);
+    } else if (_filedes >= 0) {
+#ifdef __linux__
+        posix_fadvise(_filedes, offset, len, POSIX_FADV_WILLNEED);
+#endif
+    }
+}
+
+bool FastOS_UNIX_File::preallocate(int64_t offset, size_t len)
+{
+    if ((offset < 0) || (len == 0) || (_filedes < 0)) {
+        return false;
+    }
+#ifdef __linux__
+    return (fallocate(_filedes, FALLOC_FL_KEEP_SIZE, offset, len) == 0);
+#else
+    return false;
+#endif
+}
+
 
 bool
 FastOS_UNIX_File::Close(void)
@@ -90,6 +90,8 @@ public:
     bool Sync() override;
     bool SetSize(int64_t newSize) override;
     void dropFromCache() const override;
+    void willNeed(int64_t offset, size_t len) const override;
+    bool preallocate(int64_t offset, size_t len) override;
 
     static bool Delete(const char *filename);
     static int GetLastOSError() { return errno; }
@@ -5,6 +5,7 @@
 #include <util/clientstatus.h>
 #include <httpclient/httpclient.h>
 #include <util/filereader.h>
+#include <algorithm>
 #include <cassert>
 #include <cstring>
 #include <iostream>
@@ -18,6 +19,7 @@ Client::Client(vespalib::CryptoEngine::SP engine, ClientArguments *args)
       _reqTimer(new Timer()),
       _cycleTimer(new Timer()),
       _masterTimer(new Timer()),
+      _scheduleTimer(new Timer()),
       _http(new HTTPClient(std::move(engine), _args->_hostname, _args->_port,
                            _args->_keepAlive, _args->_headerBenchmarkdataCoverage,
                            _args->_extraHeaders, _args->_authority)),
@@ -197,10 +199,18 @@ Client::run()
 
     UrlReader urlSource(*_reader, *_args);
     size_t urlNumber = 0;
+    double scheduled = 0.0;
+    _scheduleTimer->Start();
 
     // run queries
     while (!_stop) {
 
+        if (_args->_openLoop) {
+            double remaining = scheduled - _scheduleTimer->GetCurrent();
+            if (remaining > 0) {
+                std::this_thread::sleep_for(std::chrono::microseconds(int64_t(remaining * 1000.0)));
+            }
+        }
         _cycleTimer->Start();
 
         linelen = urlSource.nextUrl(_linebuf, _linebufsize);
@@ -233,6 +243,7 @@ Client::run()
                 cLen = base64_decoded.size();
             }
                         
+            double behind = _args->_openLoop ? std::max(0.0, _scheduleTimer->GetCurrent() - scheduled) : 0.0;
             _reqTimer->Start();
             auto fetch_status = _http->Fetch(_linebuf, _output.get(), _args->_usePostMode, content, cLen);
             _reqTimer->Stop();
@@ -253,7 +264,7 @@ Client::run()
             }
             if (fetch_status.ResultSize() >= _args->_byteLimit) {
                 if (_args->_ignoreCount == 0)
-                    _status->ResponseTime(_reqTimer->GetTimespan());
+                    _status->ResponseTime(_reqTimer->GetTimespan() + behind);
             } else {
                 if (_args->_ignoreCount == 0)
                     _status->RequestFailed();
@@ -263,7 +274,12 @@ Client::run()
                 _status->SkippedRequest();
         }
         _cycleTimer->Stop();
-        if (_args->_cycle < 0) {
+        if (_args->_openLoop) {
+            scheduled += _args->_cycle;
+            if ((_scheduleTimer->GetCurrent() > scheduled) && (_args->_ignoreCount == 0)) {
+                _status->OverTime();
+            }
+        } else if (_args->_cycle < 0) {
             std::this_thread::sleep_for(std::chrono::milliseconds(int(_reqTimer->GetTimespan())));
         } else {
             if (_cycleTimer->GetRemaining() > 0) {
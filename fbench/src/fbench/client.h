@@ -104,6 +104,15 @@ struct ClientArguments
     /** Whether we should use POST in requests */
     bool        _usePostMode;
 
+    /**
+     * Indicate whether requests should be sent on a fixed schedule,
+     * one each cycle, regardless of how long earlier requests took.
+     * Response times are then measured from when each request was
+     * scheduled to be sent, so that time spent waiting behind slow
+     * requests is included.
+     **/
+    bool        _openLoop;
+
     /**
      * Indicate whether to add benchmark data coverage headers
      **/
@@ -127,7 +136,7 @@ struct ClientArguments
                     bool headerBenchmarkdataCoverage,
                     uint64_t queryfileOffset, uint64_t queryfileEndOffset, bool singleQueryFile,
                     const std::string & queryStringToAppend, const std::string & extraHeaders,
-                    const std::string &authority, bool postMode)
+                    const std::string &authority, bool postMode, bool openLoop)
         : _myNum(myNum),
           _totNum(totNum),
           _filenamePattern(filenamePattern),
@@ -143,6 +152,7 @@ struct ClientArguments
           _keepAlive(keepAlive),
           _base64Decode(base64Decode),
           _usePostMode(postMode),
+          _openLoop(openLoop),
           _headerBenchmarkdataCoverage(headerBenchmarkdataCoverage),
           _queryfileOffset(queryfileOffset),
           _queryfileEndOffset(queryfileEndOffset),
@@ -177,6 +187,7 @@ private:
     std::unique_ptr<Timer>           _reqTimer;
     std::unique_ptr<Timer>           _cycleTimer;
     std::unique_ptr<Timer>           _masterTimer;
+    std::unique_ptr<Timer>           _scheduleTimer;
     std::unique_ptr<HTTPClient>      _http;
     std::unique_ptr<FileReader>      _reader;
     std::unique_ptr<std::ofstream>   _output;
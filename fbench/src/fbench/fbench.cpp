@@ -48,6 +48,7 @@ FBench::FBench()
       _maxLineSize(0),
       _keepAlive(true),
       _usePostMode(false),
+      _openLoop(false),
       _headerBenchmarkdataCoverage(false),
       _seconds(60),
       _singleQueryFile(false)
@@ -114,7 +115,7 @@ FBench::InitBenchmark(int numClients, int ignoreCount, int cycle,
                       bool keepAlive, bool base64Decode,
                       bool headerBenchmarkdataCoverage, int seconds,
                       bool singleQueryFile, const std::string & queryStringToAppend, const std::string & extraHeaders,
-                      const std::string &authority, bool postMode)
+                      const std::string &authority, bool postMode, bool openLoop)
 {
     _clients.resize(numClients);
     _ignoreCount     = ignoreCount;
@@ -134,6 +135,7 @@ FBench::InitBenchmark(int numClients, int ignoreCount, int cycle,
     _keepAlive       = keepAlive;
     _base64Decode    = base64Decode;
     _usePostMode     = postMode;
+    _openLoop        = openLoop;
     _headerBenchmarkdataCoverage = headerBenchmarkdataCoverage;
     _seconds = seconds;
     _singleQueryFile = singleQueryFile;
@@ -161,7 +163,7 @@ FBench::CreateClients()
                                 _keepAlive, _base64Decode,
                                 _headerBenchmarkdataCoverage,
                                 off_beg, off_end,
-                                _singleQueryFile, _queryStringToAppend, _extraHeaders, _authority, _usePostMode));
+                                _singleQueryFile, _queryStringToAppend, _extraHeaders, _authority, _usePostMode, _openLoop));
         ++i;
     }
 }
@@ -257,7 +259,7 @@ FBench::PrintSummary()
     printf("***************** Benchmark Summary *****************\n");
     printf("clients:                %8ld\n", _clients.size());
     printf("ran for:                %8d seconds\n", _seconds);
-    printf("cycle time:             %8d ms\n", _cycle);
+    printf("cycle time:             %8d ms%s\n", _cycle, _openLoop ? " (open loop)" : "");
     printf("lower response limit:   %8d bytes\n", _byteLimit);
     printf("skipped requests:       %8ld\n", status._skipCnt);
     printf("failed requests:        %8ld\n", status._failCnt);
@@ -289,7 +291,7 @@ FBench::Usage()
 {
     printf("usage: vespa-fbench [-H extraHeader] [-a queryStringToAppend ] [-n numClients] [-c cycleTime] [-l limit] [-i ignoreCount]\n");
     printf("              [-s seconds] [-q queryFilePattern] [-o outputFilePattern]\n");
-    printf("              [-r restartLimit] [-m maxLineSize] [-k] <hostname> <port>\n\n");
+    printf("              [-r restartLimit] [-m maxLineSize] [-k] [-O] <hostname> <port>\n\n");
     printf(" -H <str> : append extra header to each get request.\n");
     printf(" -A <str> : assign autority.  <str> should be hostname:port format. Overrides Host: header sent.\n");
     printf(" -P       : use POST for requests instead of GET.\n");
@@ -309,6 +311,9 @@ FBench::Usage()
     printf("            Can not be less than the minimum [1024].\n");
     printf(" -p <num> : print summary every <num> seconds.\n");
     printf(" -k       : disable HTTP keep-alive.\n");
+    printf(" -O       : open loop. Each client sends a request every <num> milliseconds given\n");
+    printf("            by -c, even if earlier requests are late, and response times are\n");
+    printf("            measured from when requests were scheduled to be sent.\n");
     printf(" -d       : Base64 decode POST request content.\n");
     printf(" -y       : write data on coverage to output file.\n");
     printf(" -z       : use single query file to be distributed between clients.\n");
@@ -357,6 +362,7 @@ FBench::Main(int argc, char *argv[])
     bool base64Decode = false;
     bool headerBenchmarkdataCoverage = false;
     bool usePostMode = false;
+    bool openLoop = false;
 
     bool singleQueryFile = false;
     std::string authority;
@@ -371,7 +377,7 @@ FBench::Main(int argc, char *argv[])
 
     idx = 1;
     optError = false;
-    while((opt = GetOpt(argc, argv, "H:A:T:C:K:Da:n:c:l:i:s:q:o:r:m:p:kdxyzP", arg, idx)) != -1) {
+    while((opt = GetOpt(argc, argv, "H:A:T:C:K:Da:n:c:l:i:s:q:o:r:m:p:kdxyzPO", arg, idx)) != -1) {
         switch(opt) {
         case 'A':
             authority = arg;
@@ -431,6 +437,9 @@ FBench::Main(int argc, char *argv[])
         case 'P':
             usePostMode = true;
             break;
+        case 'O':
+            openLoop = true;
+            break;
         case 'p':
             printInterval = atoi(arg);
             if (printInterval < 0)
@@ -458,6 +467,10 @@ FBench::Main(int argc, char *argv[])
         }
     }
 
+    if (openLoop && cycleTime <= 0) {
+        fprintf(stderr, "Open loop (-O) requires a positive cycle time (-c)\n");
+        optError = true;
+    }
     if ( argc < (idx + 2) || optError) {
         Usage();
         return -1;
@@ -532,7 +545,7 @@ FBench::Main(int argc, char *argv[])
                   keepAlive, base64Decode,
                   headerBenchmarkdataCoverage, seconds,
                   singleQueryFile, queryStringToAppend, extraHeaders,
-                  authority, usePostMode);
+                  authority, usePostMode, openLoop);
 
     CreateClients();
     StartClients();
@@ -25,6 +25,7 @@ private:
     bool                _keepAlive;
     bool                _base64Decode;
     bool                _usePostMode;
+    bool                _openLoop;
     bool                _headerBenchmarkdataCoverage;
     int                 _seconds;
     std::vector<uint64_t> _queryfileOffset;
@@ -45,7 +46,7 @@ private:
                        bool keepAlive, bool base64Decode,
                        bool headerBenchmarkdataCoverage, int seconds,
                        bool singleQueryFile, const std::string & queryStringToAppend, const std::string & extraHeaders,
-                       const std::string &authority, bool postMode);
+                       const std::string &authority, bool postMode, bool openLoop);
 
     void CreateClients();
     void StartClients();
@@ -9,6 +9,7 @@
 #include "config.h"
 #include "transport_thread.h"
 #include "transport.h"
+#include "transport_statistics.h"
 #include <vespa/vespalib/net/socket_spec.h>
 
 #include <vespa/log/log.h>
@@ -419,6 +420,7 @@ FNET_Connection::Write()
 
     if ((_output.GetDataLen() > 0)) {
         ++my_write_work;
+        fnet::TransportStatistics::get().inc_blocked_writes();
     }
 
     if (res >= 0) { // flush output pipeline
@@ -453,8 +455,7 @@ FNET_Connection::Write()
     bool writePending = (_writeWork > 0);
 
     guard.unlock();
-    if (!writePending)
-        EnableWriteEvent(false);
+    EnableWriteEvent(writePending);
 
     return !broken;
 }
@@ -116,6 +116,9 @@ FNET_IOComponent::detach_selector()
 void
 FNET_IOComponent::EnableReadEvent(bool enabled)
 {
+    if (_flags._ioc_readEnabled == enabled) {
+        return;
+    }
     _flags._ioc_readEnabled = enabled;
     if (_ioc_selector != nullptr) {
         _ioc_selector->update(_ioc_socket_fd, *this, _flags._ioc_readEnabled, _flags._ioc_writeEnabled);
@@ -126,6 +129,9 @@ FNET_IOComponent::EnableReadEvent(bool enabled)
 void
 FNET_IOComponent::EnableWriteEvent(bool enabled)
 {
+    if (_flags._ioc_writeEnabled == enabled) {
+        return;
+    }
     _flags._ioc_writeEnabled = enabled;
     if (_ioc_selector != nullptr) {
         _ioc_selector->update(_ioc_socket_fd, *this, _flags._ioc_readEnabled, _flags._ioc_writeEnabled);
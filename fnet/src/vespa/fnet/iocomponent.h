@@ -170,7 +170,8 @@ public:
     void detach_selector();
 
     /**
-     * Enable or disable read events.
+     * Enable or disable read events. The attached selector is only
+     * updated if this changes the set of enabled events.
      *
      * @param enabled enabled(true)/disabled(false).
      **/
@@ -178,7 +179,8 @@ public:
 
 
     /**
-     * Enable or disable write events.
+     * Enable or disable write events. The attached selector is only
+     * updated if this changes the set of enabled events.
      *
      * @param enabled enabled(true)/disabled(false).
      **/
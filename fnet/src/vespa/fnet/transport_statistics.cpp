@@ -0,0 +1,33 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "transport_statistics.h"
+
+namespace fnet {
+
+TransportStatistics TransportStatistics::instance = {};
+
+TransportStatistics::Snapshot
+TransportStatistics::snapshot() const noexcept
+{
+    Snapshot s;
+    s.event_loop_iterations = event_loop_iterations.load(std::memory_order_relaxed);
+    s.event_loop_busy_us    = event_loop_busy_us.load(std::memory_order_relaxed);
+    s.event_queue_flushes   = event_queue_flushes.load(std::memory_order_relaxed);
+    s.event_queue_delay_us  = event_queue_delay_us.load(std::memory_order_relaxed);
+    s.blocked_writes        = blocked_writes.load(std::memory_order_relaxed);
+    return s;
+}
+
+TransportStatistics::Snapshot
+TransportStatistics::Snapshot::subtract(const Snapshot &rhs) const noexcept
+{
+    Snapshot s;
+    s.event_loop_iterations = event_loop_iterations - rhs.event_loop_iterations;
+    s.event_loop_busy_us    = event_loop_busy_us    - rhs.event_loop_busy_us;
+    s.event_queue_flushes   = event_queue_flushes   - rhs.event_queue_flushes;
+    s.event_queue_delay_us  = event_queue_delay_us  - rhs.event_queue_delay_us;
+    s.blocked_writes        = blocked_writes        - rhs.blocked_writes;
+    return s;
+}
+
+}
@@ -0,0 +1,60 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+namespace fnet {
+
+/**
+ * Low-level process-wide statistics sampled by all transport threads
+ * and connections. The counters only increase; users are expected to
+ * take snapshots periodically and report the difference between them.
+ *
+ * Fully thread safe.
+ **/
+struct TransportStatistics {
+
+    // Number of event loop iterations performed
+    std::atomic<uint64_t> event_loop_iterations = 0;
+    // Time spent handling events (not waiting for them) in the event loop
+    std::atomic<uint64_t> event_loop_busy_us    = 0;
+    // Number of times posted events were picked up by a transport thread
+    std::atomic<uint64_t> event_queue_flushes   = 0;
+    // Time from the first event of a batch was posted until it was picked up
+    std::atomic<uint64_t> event_queue_delay_us  = 0;
+    // Number of connection writes that left data in the output buffer
+    std::atomic<uint64_t> blocked_writes        = 0;
+
+    void add_event_loop_iteration(uint64_t busy_us) noexcept {
+        event_loop_iterations.fetch_add(1, std::memory_order_relaxed);
+        event_loop_busy_us.fetch_add(busy_us, std::memory_order_relaxed);
+    }
+    void add_event_queue_flush(uint64_t delay_us) noexcept {
+        event_queue_flushes.fetch_add(1, std::memory_order_relaxed);
+        event_queue_delay_us.fetch_add(delay_us, std::memory_order_relaxed);
+    }
+    void inc_blocked_writes() noexcept {
+        blocked_writes.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    struct Snapshot {
+        uint64_t event_loop_iterations = 0;
+        uint64_t event_loop_busy_us    = 0;
+        uint64_t event_queue_flushes   = 0;
+        uint64_t event_queue_delay_us  = 0;
+        uint64_t blocked_writes        = 0;
+
+        Snapshot subtract(const Snapshot &rhs) const noexcept;
+    };
+
+    // Acquires a snapshot of statistics that is expected to be reasonably up to date.
+    // Thread safe.
+    Snapshot snapshot() const noexcept;
+
+    static TransportStatistics instance;
+    static TransportStatistics &get() noexcept { return instance; }
+};
+
+}
@@ -7,6 +7,7 @@
 #include "connector.h"
 #include "connection.h"
 #include "transport.h"
+#include "transport_statistics.h"
 #include <vespa/vespalib/util/sync.h>
 #include <vespa/vespalib/net/socket_spec.h>
 #include <vespa/vespalib/net/server_socket.h>
@@ -122,6 +123,9 @@ FNET_TransportThread::PostEvent(FNET_ControlPacket *cpacket,
             return false;
         }
         wasEmpty = _queue.IsEmpty_NoLock();
+        if (wasEmpty) {
+            _queue_start = clock::now();
+        }
         _queue.QueuePacket_NoLock(cpacket, context);
     }
     if (wasEmpty) {
@@ -223,7 +227,8 @@ FNET_TransportThread::FNET_TransportThread(FNET_Transport &owner_in)
       _started(false),
       _shutdown(false),
       _finished(false),
-      _waitFinished(false)
+      _waitFinished(false),
+      _queue_start()
 {
     trapsigpipe();
 }
@@ -401,10 +406,18 @@ FNET_TransportThread::InitEventLoop()
 void
 FNET_TransportThread::handle_wakeup()
 {
+    bool flushed = false;
+    time_point queue_start;
     {
         std::lock_guard<std::mutex> guard(_lock);
+        flushed = !_queue.IsEmpty_NoLock();
+        queue_start = _queue_start;
         _queue.FlushPackets_NoLock(&_myQueue);
     }
+    if (flushed) {
+        auto delay = std::chrono::duration_cast<std::chrono::microseconds>(_now - queue_start);
+        fnet::TransportStatistics::get().add_event_queue_flush(std::max(delay.count(), int64_t(0)));
+    }
 
     FNET_Context context;
     FNET_Packet *packet = nullptr;
@@ -425,7 +438,8 @@ FNET_TransportThread::handle_wakeup()
             handle_add_cmd(context._value.IOC);
             break;
         case FNET_ControlPacket::FNET_CMD_IOC_ENABLE_WRITE:
-            context._value.IOC->EnableWriteEvent(true);
+            // try writing right away; write events are only enabled
+            // if the output could not be written in full.
             if (context._value.IOC->HandleWriteEvent()) {
                 context._value.IOC->SubRef();
             } else {
@@ -501,6 +515,9 @@ FNET_TransportThread::EventLoopIteration()
 
         // perform scheduled delete operations
         FlushDeleteList();
+
+        auto busy = std::chrono::duration_cast<std::chrono::microseconds>(clock::now() - _now);
+        fnet::TransportStatistics::get().add_event_loop_iteration(busy.count());
     }                      // -- END OF MAIN EVENT LOOP --
 
     if (!IsShutDown())
@@ -316,6 +316,46 @@ void MatchObjectTest::testParams()
 }
 
 
+/** Test the quick check for texts that cannot contain any query term
+ */
+
+void MatchObjectTest::testMayMatch()
+{
+    {
+        TestQuery q("AND(juniper,search)");
+        MatchObject* mo = q._qhandle.MatchObj(0);
+        std::string hit("A text about Juniper and nothing else");
+        std::string prefix("Junipers are searched for");
+        std::string miss("A text about something else entirely");
+        std::string folded("A text about r\xC3\xA9sum\xC3\xA9s");
+        _test(mo->MayMatch(hit.c_str(), hit.size()));
+        _test(mo->MayMatch(prefix.c_str(), prefix.size()));
+        _test(!mo->MayMatch(miss.c_str(), miss.size()));
+        _test(!mo->MayMatch("", 0));
+        // Non-ascii text might fold into a query term
+        _test(mo->MayMatch(folded.c_str(), folded.size()));
+    }
+    {
+        // Terms that cannot be checked always report a possible match
+        TestQuery q("AND(juniper,S\xC3\xB8k)");
+        MatchObject* mo = q._qhandle.MatchObj(0);
+        std::string miss("A text about something else entirely");
+        _test(mo->MayMatch(miss.c_str(), miss.size()));
+    }
+    {
+        // A text without any query term gives the same teaser as before
+        TestQuery q("juniper");
+        std::string miss("A text about something else entirely");
+        _test(!q._qhandle.MatchObj(0)->MayMatch(miss.c_str(), miss.size()));
+        juniper::Result res(juniper::TestConfig, &q._qhandle, miss.c_str(), miss.size(), 0);
+        juniper::Summary* sum = res.GetTeaser(NULL);
+        _test(sum != NULL);
+        res.Scan();
+        _test(res._matcher->TotalHits() == 0);
+    }
+}
+
+
 /*************************************************************************
  *                      Test administration methods
  *************************************************************************/
@@ -353,6 +393,8 @@ void MatchObjectTest::init() {
         &MatchObjectTest::testCombined;
     test_methods_["testParams"] =
         &MatchObjectTest::testParams;
+    test_methods_["testMayMatch"] =
+        &MatchObjectTest::testMayMatch;
 }
 
 /*************************************************************************
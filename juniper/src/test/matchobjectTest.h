@@ -56,6 +56,10 @@ class MatchObjectTest : public Test {
      */
     void testParams();
 
+    /** Test the quick check for texts without any query term
+     */
+    void testMayMatch();
+
 
     /*************************************************************************
      *                      Test administration methods
@@ -6,6 +6,7 @@
 #include "result.h"
 #include "charutil.h"
 #include <vespa/fastlib/util/wildcard_match.h>
+#include <cstring>
 #include <stack>
 #include <vespa/log/log.h>
 LOG_SETUP(".juniper.matchobject");
@@ -147,12 +148,15 @@ MatchObject::MatchObject(QueryExpr* query, bool has_reductions) :
     _match_overlap(false), _max_arity(0),
     _has_reductions(has_reductions),
     _qt_byname(),
-    _reduce_matchers()
+    _reduce_matchers(),
+    _use_prefilter(false),
+    _prefilter_terms()
 {
     LOG(debug, "MatchObject(default)");
     traverser tr(*this);
     query->Accept(tr); // Initialize structure for the query
     _max_arity = query->MaxArity();
+    init_prefilter();
 }
 
 
@@ -165,7 +169,9 @@ MatchObject::MatchObject(QueryExpr* query,  bool has_reductions, uint32_t langid
     _max_arity(0),
     _has_reductions(has_reductions),
     _qt_byname(),
-    _reduce_matchers()
+    _reduce_matchers(),
+    _use_prefilter(false),
+    _prefilter_terms()
 {
     LOG(debug, "MatchObject(language %d)", langid);
     query_expander qe(*this, langid);
@@ -179,6 +185,7 @@ MatchObject::MatchObject(QueryExpr* query,  bool has_reductions, uint32_t langid
             langid, s.c_str());
     }
     _max_arity = _query->MaxArity();
+    init_prefilter();
 }
 
 
@@ -190,6 +197,82 @@ MatchObject::~MatchObject()
 }
 
 
+namespace {
+
+constexpr uint64_t ascii_ones = 0x0101010101010101ul;
+constexpr uint64_t ascii_high = 0x8080808080808080ul;
+
+// Lower case an ascii word (8 bytes at a time), no carry between bytes
+// since all bytes are < 0x80:
+inline uint64_t ascii_lower(uint64_t w)
+{
+    uint64_t ge_A = w + (0x80 - 'A') * ascii_ones;
+    uint64_t gt_Z = w + (0x80 - 'Z' - 1) * ascii_ones;
+    return w | (((ge_A ^ gt_Z) & ascii_high) >> 2);
+}
+
+// Create a lower case copy of text, return false if text is not pure ascii
+bool ascii_lower_copy(const char* text, size_t len, std::string& dst)
+{
+    dst.resize(len);
+    char* out = &dst[0];
+    size_t i = 0;
+    for (; i + 8 <= len; i += 8) {
+        uint64_t w;
+        memcpy(&w, text + i, sizeof(w));
+        if (w & ascii_high) return false;
+        w = ascii_lower(w);
+        memcpy(out + i, &w, sizeof(w));
+    }
+    for (; i < len; ++i) {
+        unsigned char c = text[i];
+        if (c & 0x80) return false;
+        out[i] = ((c >= 'A' && c <= 'Z') ? (c | 0x20) : c);
+    }
+    return true;
+}
+
+bool is_plain_ascii_term(const char* term, size_t len)
+{
+    if (len == 0) return false;
+    for (size_t i = 0; i < len; ++i) {
+        char c = term[i];
+        if (!((c >= 'a' && c <= 'z') || (c >= '0' && c <= '9'))) return false;
+    }
+    return true;
+}
+
+}
+
+
+void MatchObject::init_prefilter()
+{
+    // Any term matching a token in a pure ascii text is a substring of the
+    // lower cased text, as long as the term is plain lower case ascii
+    _use_prefilter = false;
+    _prefilter_terms.clear();
+    if (_has_reductions || _qt.empty()) return;
+    for (QueryTerm* q : _qt) {
+        if (q->is_wildcard() || q->isSpecialToken() || q->reduce_matcher) return;
+        if (!is_plain_ascii_term(q->term(), q->len)) return;
+        _prefilter_terms.emplace_back(q->term(), q->len);
+    }
+    _use_prefilter = true;
+}
+
+
+bool MatchObject::MayMatch(const char* text, size_t len) const
+{
+    if (!_use_prefilter) return true;
+    std::string lower;
+    if (!ascii_lower_copy(text, len, lower)) return true;
+    for (const std::string& term : _prefilter_terms) {
+        if (lower.find(term) != std::string::npos) return true;
+    }
+    return false;
+}
+
+
 bool MatchObject::Match(MatchObject::iterator& mi, Token& token, unsigned& options)
 {
     QueryTerm* q = mi.first_match(token);
@@ -7,6 +7,8 @@
 #include <vespa/fastlib/text/unicodeutil.h>
 #include "reducematcher.h"
 #include "ITokenProcessor.h"
+#include <string>
+#include <vector>
 
 typedef juniper::Result Result;
 typedef ITokenProcessor::Token Token;
@@ -95,12 +97,25 @@ public:
     inline QueryExpr* Query() { return _query; }
     inline bool HasReductions() { return _has_reductions; }
 
+    /** Quick check used to avoid tokenizing texts that cannot contain any
+     *  query term. Only plain query terms consisting of lower case ascii
+     *  letters and digits can be checked this way, other queries (and texts
+     *  containing non-ascii characters, that might fold into ascii) always
+     *  report a possible match.
+     * @param text the (utf8) text to check
+     * @param len the length of the text in bytes
+     * @return false if no token in the text can match any query term
+     */
+    bool MayMatch(const char* text, size_t len) const;
+
     // internal use only..
     void add_queryterm(QueryTerm* term);
     void add_nonterm(QueryNode* n);
     void add_reduction_term(QueryTerm* term, juniper::Rewriter*);
 private:
     friend class match_iterator;
+    void init_prefilter();
+
     QueryExpr* _query;
     std::vector<QueryTerm*> _qt; // fast lookup by index
     std::vector<QueryNode*> _nonterms;
@@ -109,6 +124,8 @@ private:
     bool _has_reductions; // query contains terms that reqs reduction of tokens before matching
     queryterm_hashtable _qt_byname; // fast lookup by name
     juniper::ReduceMatcher _reduce_matchers;
+    bool _use_prefilter; // all query terms can be checked by MayMatch
+    std::vector<std::string> _prefilter_terms;
 
     MatchObject(MatchObject &);
     MatchObject &operator=(MatchObject &);
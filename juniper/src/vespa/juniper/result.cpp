@@ -122,8 +122,9 @@ Summary* Result::GetTeaser(const Config* alt_config)
     else
         _dynsum_len = _qhandle->_dynsum_len;
     SummaryImpl *sum = NULL;
-    // Avoid overhead when being called with an empty stack
-    if (_mo && _mo->Query()) {
+    // Avoid overhead when being called with an empty stack, or when no
+    // query term can occur in the text (it would only give the fallback)
+    if (_mo && _mo->Query() && (_scan_done || _mo->MayMatch(_docsum, _docsum_len))) {
         Scan();
         if (_qhandle->_max_matches < 0)
             _max_matches = dsp.MaxMatches();
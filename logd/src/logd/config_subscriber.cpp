@@ -120,7 +120,7 @@ ConfigSubscriber::make_forwarder(Metrics& metrics)
     std::unique_ptr<Forwarder> result;
     if (_use_logserver) {
         result = std::make_unique<RpcForwarder>(metrics, _forward_filter, _server.supervisor(), _logserver_host,
-                                                _logserver_rpc_port, 60.0, 100);
+                                                _logserver_rpc_port, 60.0, 100, 100);
     } else {
         result = std::make_unique<EmptyForwarder>(metrics);
     }
@@ -9,7 +9,11 @@ Metrics::Metrics(std::shared_ptr<MetricsManager> m)
       loglevel(metrics->dimension("loglevel")),
       servicename(metrics->dimension("service")),
       loglines(metrics->counter("logd.processed.lines",
-                                "how many log lines have been processed"))
+                                "how many log lines have been processed")),
+      suppressedlines(metrics->counter("logd.suppressed.lines",
+                                       "how many repeated log lines have not been forwarded to the logserver")),
+      forwardlag(metrics->gauge("logd.forward.lag",
+                                "seconds from the oldest log line in a forwarded batch was logged until it was sent"))
 {}
 
 Metrics::~Metrics() = default;
@@ -23,4 +27,19 @@ Metrics::countLine(const vespalib::string &level, const vespalib::string &servic
     loglines.add(1, p);
 }
 
+void
+Metrics::countSuppressedLine(const vespalib::string &level, const vespalib::string &service) const
+{
+    Point p = metrics->pointBuilder()
+            .bind(loglevel, level)
+            .bind(servicename, service);
+    suppressedlines.add(1, p);
+}
+
+void
+Metrics::sampleForwardLag(double seconds) const
+{
+    forwardlag.sample(seconds);
+}
+
 }
@@ -7,22 +7,28 @@ namespace logdemon {
 
 using vespalib::metrics::Dimension;
 using vespalib::metrics::Counter;
+using vespalib::metrics::Gauge;
 using vespalib::metrics::MetricsManager;
 using vespalib::metrics::Point;
 
 /**
- * Tracks metrics for number of processed log lines.
+ * Tracks metrics for number of processed log lines,
+ * and for the forwarding of log lines to the logserver.
  */
 struct Metrics {
     std::shared_ptr<MetricsManager> metrics;
     const Dimension loglevel;
     const Dimension servicename;
     const Counter loglines;
+    const Counter suppressedlines;
+    const Gauge forwardlag;
 
     Metrics(std::shared_ptr<MetricsManager> m);
     ~Metrics();
 
     void countLine(const vespalib::string &level, const vespalib::string &service) const;
+    void countSuppressedLine(const vespalib::string &level, const vespalib::string &service) const;
+    void sampleForwardLag(double seconds) const;
 };
 
 } // namespace logdemon
@@ -7,6 +7,7 @@
 #include <vespa/log/exceptions.h>
 #include <vespa/vespalib/util/buffer.h>
 #include <vespa/vespalib/util/stringfmt.h>
+#include <algorithm>
 
 #include <vespa/log/log.h>
 LOG_SETUP(".logd.rpc_forwarder");
@@ -52,15 +53,18 @@ RpcForwarder::ping_logserver()
 
 RpcForwarder::RpcForwarder(Metrics& metrics, const ForwardMap& forward_filter, FRT_Supervisor& supervisor,
                            const vespalib::string &hostname, int rpc_port,
-                           double rpc_timeout_secs, size_t max_messages_per_request)
+                           double rpc_timeout_secs, size_t max_messages_per_request, size_t max_repeated_messages)
     : _metrics(metrics),
       _connection_spec(make_string("tcp/%s:%d", hostname.c_str(), rpc_port)),
       _rpc_timeout_secs(rpc_timeout_secs),
       _max_messages_per_request(max_messages_per_request),
+      _max_repeated_messages(max_repeated_messages),
       _target(supervisor.GetTarget(_connection_spec.c_str())),
       _messages(),
       _bad_lines(0),
-      _forward_filter(forward_filter)
+      _forward_filter(forward_filter),
+      _repeat_counts(),
+      _repeat_window_start(vespalib::steady_clock::now())
 {
     ping_logserver();
 }
@@ -101,6 +105,27 @@ should_forward_log_message(const LogMessage& message, const ForwardMap& filter)
     return false;
 }
 
+constexpr vespalib::duration repeat_window = 1s;
+constexpr size_t max_tracked_messages = 10000;
+
+}
+
+bool
+RpcForwarder::is_repeated_too_often(const LogMessage& message)
+{
+    if (_max_repeated_messages == 0) {
+        return false;
+    }
+    auto now = vespalib::steady_clock::now();
+    if ((now - _repeat_window_start >= repeat_window) || (_repeat_counts.size() >= max_tracked_messages)) {
+        _repeat_counts.clear();
+        _repeat_window_start = now;
+    }
+    vespalib::string key = make_string("%d\t%s\t%s\t", static_cast<int>(message.level()),
+                                       message.service().c_str(), message.component().c_str());
+    key.append(message.payload());
+    uint32_t& count = _repeat_counts[key];
+    return (++count > _max_repeated_messages);
 }
 
 void
@@ -116,6 +141,10 @@ RpcForwarder::forwardLine(std::string_view line)
     }
     _metrics.countLine(ns_log::Logger::logLevelNames[message.level()], message.service());
     if (should_forward_log_message(message, _forward_filter)) {
+        if (is_repeated_too_often(message)) {
+            _metrics.countSuppressedLine(ns_log::Logger::logLevelNames[message.level()], message.service());
+            return;
+        }
         _messages.push_back(std::move(message));
         if (_messages.size() == _max_messages_per_request) {
             flush();
@@ -129,6 +158,12 @@ RpcForwarder::flush()
     if (_messages.empty()) {
         return;
     }
+    int64_t oldest_time_nanos = _messages.front().time_nanos();
+    for (const auto& message : _messages) {
+        oldest_time_nanos = std::min(oldest_time_nanos, message.time_nanos());
+    }
+    auto now_nanos = vespalib::count_ns(vespalib::system_clock::now().time_since_epoch());
+    _metrics.sampleForwardLag(std::max(int64_t(0), now_nanos - oldest_time_nanos) / 1e9);
     ProtoConverter::ProtoLogRequest proto_request;
     ProtoConverter::log_messages_to_proto(_messages, proto_request);
     GuardedRequest request;
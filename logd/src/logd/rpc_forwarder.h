@@ -6,6 +6,8 @@
 #include "proto_converter.h"
 #include <vespa/log/log_message.h>
 #include <vespa/fnet/frt/frt.h>
+#include <vespa/vespalib/stllike/hash_map.h>
+#include <vespa/vespalib/util/time.h>
 #include <memory>
 #include <vector>
 
@@ -22,6 +24,10 @@ using RpcTargetGuard = std::unique_ptr<FRT_Target, RpcTargetSubRef>;
 
 /**
  * Implementation of the Forwarder interface that uses RPC to send protobuf encoded log messages to the logserver.
+ *
+ * If a log message (same level, service, component and payload) is repeated more than
+ * max_repeated_messages times within a second, the extra copies are not forwarded
+ * (they are still in the local log file). Zero means no limit.
  */
 class RpcForwarder : public Forwarder {
 private:
@@ -29,17 +35,21 @@ private:
     vespalib::string _connection_spec;
     double _rpc_timeout_secs;
     size_t _max_messages_per_request;
+    size_t _max_repeated_messages;
     RpcTargetGuard _target;
     std::vector<ns_log::LogMessage> _messages;
     int _bad_lines;
     ForwardMap _forward_filter;
+    vespalib::hash_map<vespalib::string, uint32_t> _repeat_counts;
+    vespalib::steady_time _repeat_window_start;
 
     void ping_logserver();
+    bool is_repeated_too_often(const ns_log::LogMessage& message);
 
 public:
     RpcForwarder(Metrics& metrics, const ForwardMap& forward_filter, FRT_Supervisor& supervisor,
                  const vespalib::string& logserver_host, int logserver_rpc_port,
-                 double rpc_timeout_secs, size_t max_messages_per_request);
+                 double rpc_timeout_secs, size_t max_messages_per_request, size_t max_repeated_messages);
     ~RpcForwarder() override;
 
     // Implements Forwarder
@@ -125,7 +125,7 @@ struct RpcForwarderTest : public ::testing::Test {
         : server(),
           metrics_mgr(std::make_shared<MockMetricsManager>()),
           metrics(metrics_mgr),
-          forwarder(metrics, make_forward_filter(), supervisor.get(), "localhost", server.get_listen_port(), 60.0, 3)
+          forwarder(metrics, make_forward_filter(), supervisor.get(), "localhost", server.get_listen_port(), 60.0, 3, 2)
     {
     }
     void forward_line(const std::string& payload) {
@@ -229,6 +229,20 @@ TEST_F(RpcForwarderTest, log_messages_are_filtered_on_log_level)
     EXPECT_EQ(9, metrics_mgr->add_count);
 }
 
+TEST_F(RpcForwarderTest, repeated_log_messages_are_suppressed)
+{
+    forward_line("a");
+    forward_line("a");
+    forward_line("b");
+    forward_line("a");
+    forward_line("error", "a");
+    forward_line("a");
+    flush();
+    expect_messages(2, {"a", "a", "b", "a"});
+    // 6 processed lines and 2 suppressed lines
+    EXPECT_EQ(8, metrics_mgr->add_count);
+}
+
 TEST_F(RpcForwarderTest, throws_when_rpc_reply_contains_errors)
 {
     server.reply_with_error = true;
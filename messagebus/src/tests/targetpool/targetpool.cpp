@@ -3,6 +3,7 @@
 #include <vespa/messagebus/testlib/slobrok.h>
 #include <vespa/messagebus/testlib/testserver.h>
 #include <vespa/vespalib/testkit/testapp.h>
+#include <thread>
 
 #include <vespa/log/log.h>
 LOG_SETUP("targetpool_test");
@@ -37,7 +38,7 @@ TEST("targetpool_test") {
     FRT_Supervisor & orb = server.supervisor();
     std::unique_ptr<PoolTimer> ptr(new PoolTimer());
     PoolTimer &timer = *ptr;
-    RPCTargetPool pool(std::move(ptr), 0.666);
+    RPCTargetPool pool(std::move(ptr), 0.666, 1);
 
     // Assert that all connections expire.
     RPCTarget::SP target;
@@ -88,4 +89,35 @@ TEST("targetpool_test") {
     EXPECT_EQUAL(0u, pool.size());
 }
 
+TEST("require that each thread keeps using the same of several targets") {
+    Slobrok slobrok;
+    TestServer srv1(Identity("srv1"), RoutingSpec(), slobrok);
+    RPCServiceAddress adr1("", srv1.mb.getConnectionSpec());
+
+    fnet::frt::StandaloneFRT server;
+    FRT_Supervisor & orb = server.supervisor();
+    auto ptr = std::make_unique<PoolTimer>();
+    PoolTimer &timer = *ptr;
+    RPCTargetPool pool(std::move(ptr), 0.666, 3);
+
+    RPCTarget::SP target = pool.getTarget(orb, adr1);
+    ASSERT_TRUE(target);
+    for (int i = 0; i < 10; ++i) {
+        EXPECT_EQUAL(target.get(), pool.getTarget(orb, adr1).get());
+    }
+    RPCTarget::SP other;
+    std::thread([&]() { other = pool.getTarget(orb, adr1); }).join();
+    ASSERT_TRUE(other);
+    EXPECT_EQUAL(1u, pool.size());
+
+    target.reset();
+    timer.millis += 999;
+    pool.flushTargets(false);
+    EXPECT_EQUAL(1u, pool.size());
+    other.reset();
+    timer.millis += 999;
+    pool.flushTargets(false);
+    EXPECT_EQUAL(0u, pool.size());
+}
+
 TEST_MAIN() { TEST_RUN_ALL(); }
\ No newline at end of file
@@ -3,6 +3,7 @@
 #include <vespa/vespalib/testkit/testapp.h>
 #include <vespa/messagebus/destinationsession.h>
 #include <vespa/messagebus/dynamicthrottlepolicy.h>
+#include <vespa/messagebus/latencythrottlepolicy.h>
 #include <vespa/messagebus/routablequeue.h>
 #include <vespa/messagebus/routing/retrytransienterrorspolicy.h>
 #include <vespa/messagebus/routing/routingspec.h>
@@ -74,6 +75,7 @@ bool waitPending(SourceSession& session, uint32_t size)
 class Test : public vespalib::TestApp {
 private:
     uint32_t getWindowSize(DynamicThrottlePolicy &policy, DynamicTimer &timer, uint32_t maxPending);
+    uint32_t getWindowSize(LatencyThrottlePolicy &policy, DynamicTimer &timer, uint32_t capacity);
 
 protected:
     void testMaxPendingCount();
@@ -83,6 +85,9 @@ protected:
     void testIdleTimePeriod();
     void testMinWindowSize();
     void testMaxWindowSize();
+    void testLatencyWindowSize();
+    void testLatencyMaxWindowSize();
+    void testLatencyIdleTimePeriod();
 
 public:
     int Main() override;
@@ -100,6 +105,9 @@ Test::Main()
     testIdleTimePeriod();    TEST_FLUSH();
     testMinWindowSize();     TEST_FLUSH();
     testMaxWindowSize();     TEST_FLUSH();
+    testLatencyWindowSize(); TEST_FLUSH();
+    testLatencyMaxWindowSize(); TEST_FLUSH();
+    testLatencyIdleTimePeriod(); TEST_FLUSH();
 
     TEST_DONE();
 }
@@ -332,6 +340,97 @@ Test::testMaxWindowSize()
 
 }
 
+void
+Test::testLatencyWindowSize()
+{
+    auto ptr = std::make_unique<DynamicTimer>();
+    DynamicTimer *timer = ptr.get();
+    LatencyThrottlePolicy policy(std::move(ptr));
+
+    policy.setWindowSizeIncrement(5);
+
+    double windowSize = getWindowSize(policy, *timer, 100);
+    ASSERT_TRUE(windowSize >= 100 && windowSize <= 115);
+    EXPECT_APPROX(1000.0, policy.getMinRtt(), 0.01);
+    EXPECT_TRUE(policy.getRtt() >= 1000.0 && policy.getRtt() <= 1150.0);
+
+    windowSize = getWindowSize(policy, *timer, 200);
+    ASSERT_TRUE(windowSize >= 200 && windowSize <= 215);
+
+    windowSize = getWindowSize(policy, *timer, 50);
+    ASSERT_TRUE(windowSize >= 50 && windowSize <= 65);
+
+    windowSize = getWindowSize(policy, *timer, 500);
+    ASSERT_TRUE(windowSize >= 500 && windowSize <= 515);
+
+    windowSize = getWindowSize(policy, *timer, 100);
+    ASSERT_TRUE(windowSize >= 100 && windowSize <= 115);
+}
+
+void
+Test::testLatencyMaxWindowSize()
+{
+    auto ptr = std::make_unique<DynamicTimer>();
+    DynamicTimer *timer = ptr.get();
+    LatencyThrottlePolicy policy(std::move(ptr));
+
+    policy.setWindowSizeIncrement(5);
+    policy.setMaxWindowSize(50);
+    EXPECT_EQUAL(50u, getWindowSize(policy, *timer, 100));
+
+    policy.setMaxPendingCount(15);
+    EXPECT_EQUAL(15u, getWindowSize(policy, *timer, 100));
+}
+
+void
+Test::testLatencyIdleTimePeriod()
+{
+    auto ptr = std::make_unique<DynamicTimer>();
+    DynamicTimer *timer = ptr.get();
+    LatencyThrottlePolicy policy(std::move(ptr));
+
+    policy.setWindowSizeIncrement(5);
+
+    double windowSize = getWindowSize(policy, *timer, 100);
+    ASSERT_TRUE(windowSize >= 100 && windowSize <= 115);
+
+    SimpleMessage msg("foo");
+    timer->_millis += 30001;
+    ASSERT_TRUE(policy.canSend(msg, 0));
+    EXPECT_TRUE(policy.getMinRtt() > 0);
+
+    timer->_millis += 60001;
+    ASSERT_TRUE(policy.canSend(msg, 50));
+    EXPECT_EQUAL(55u, policy.getMaxPendingCount());
+    EXPECT_EQUAL(0.0, policy.getMinRtt());
+}
+
+uint32_t
+Test::getWindowSize(LatencyThrottlePolicy &policy, DynamicTimer &timer, uint32_t capacity)
+{
+    SimpleMessage msg("foo");
+    SimpleReply reply("bar");
+
+    for (uint32_t i = 0; i < 999; ++i) {
+        uint32_t numPending = 0;
+        while (policy.canSend(msg, numPending)) {
+            policy.processMessage(msg);
+            ++numPending;
+        }
+
+        // Messages above the capacity of the receiver are queued, increasing latency
+        uint64_t tripTime = (numPending <= capacity) ? 1000 : (1000 * numPending) / capacity;
+        timer._millis += tripTime;
+
+        for( ; numPending > 0 ; --numPending) {
+            policy.processReply(reply);
+        }
+    }
+    uint32_t ret = policy.getMaxPendingCount();
+    printf("getWindowSize() = %d\n", ret);
+    return ret;
+}
+
 uint32_t
 Test::getWindowSize(DynamicThrottlePolicy &policy, DynamicTimer &timer, uint32_t maxPending)
 {
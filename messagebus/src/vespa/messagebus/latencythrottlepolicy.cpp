@@ -0,0 +1,186 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#include "latencythrottlepolicy.h"
+#include "steadytimer.h"
+#include <algorithm>
+#include <climits>
+#include <cmath>
+
+#include <vespa/log/log.h>
+LOG_SETUP(".latencythrottlepolicy");
+
+namespace mbus {
+
+LatencyThrottlePolicy::LatencyThrottlePolicy() :
+    LatencyThrottlePolicy(std::make_unique<SteadyTimer>())
+{ }
+
+LatencyThrottlePolicy::LatencyThrottlePolicy(ITimer::UP timer) :
+    _timer(std::move(timer)),
+    _numSent(0),
+    _numOk(0),
+    _numPending(0),
+    _resizeRate(3),
+    _resizeTime(_timer->getMilliTime()),
+    _lastEventTime(_resizeTime),
+    _timeOfLastMessage(_resizeTime),
+    _idleTimePeriod(60000),
+    _pendingTime(0),
+    _alpha(3),
+    _beta(6),
+    _windowSizeIncrement(20),
+    _windowSize(_windowSizeIncrement),
+    _maxWindowSize(INT_MAX),
+    _minWindowSize(_windowSizeIncrement),
+    _rtt(0),
+    _minRtt(0)
+{ }
+
+LatencyThrottlePolicy::~LatencyThrottlePolicy() = default;
+
+LatencyThrottlePolicy &
+LatencyThrottlePolicy::setAlpha(double alpha)
+{
+    _alpha = alpha;
+    return *this;
+}
+
+LatencyThrottlePolicy &
+LatencyThrottlePolicy::setBeta(double beta)
+{
+    _beta = beta;
+    return *this;
+}
+
+LatencyThrottlePolicy &
+LatencyThrottlePolicy::setWindowSizeIncrement(double windowSizeIncrement)
+{
+    _windowSizeIncrement = windowSizeIncrement;
+    return *this;
+}
+
+LatencyThrottlePolicy &
+LatencyThrottlePolicy::setResizeRate(uint32_t resizeRate)
+{
+    _resizeRate = resizeRate;
+    return *this;
+}
+
+LatencyThrottlePolicy &
+LatencyThrottlePolicy::setIdleTimePeriod(uint64_t period)
+{
+    _idleTimePeriod = period;
+    return *this;
+}
+
+LatencyThrottlePolicy &
+LatencyThrottlePolicy::setMaxWindowSize(double max)
+{
+    _maxWindowSize = max;
+    return *this;
+}
+
+LatencyThrottlePolicy &
+LatencyThrottlePolicy::setMinWindowSize(double min)
+{
+    _minWindowSize = min;
+    return *this;
+}
+
+LatencyThrottlePolicy &
+LatencyThrottlePolicy::setMaxPendingCount(uint32_t maxCount)
+{
+    StaticThrottlePolicy::setMaxPendingCount(maxCount);
+    _maxWindowSize = maxCount;
+    return *this;
+}
+
+bool
+LatencyThrottlePolicy::canSend(const Message &msg, uint32_t pendingCount)
+{
+    if (!StaticThrottlePolicy::canSend(msg, pendingCount)) {
+        return false;
+    }
+    uint64_t time = _timer->getMilliTime();
+    if (time - _timeOfLastMessage > _idleTimePeriod) {
+        _windowSize = std::max(_minWindowSize, std::min(_windowSize, (double) pendingCount + _windowSizeIncrement));
+        // The receivers may have changed while we were idle.
+        _minRtt = 0;
+    }
+    _timeOfLastMessage = time;
+    return pendingCount < _windowSize;
+}
+
+void
+LatencyThrottlePolicy::accumulatePendingTime(uint64_t time)
+{
+    if (time > _lastEventTime) {
+        _pendingTime += (double)_numPending * (time - _lastEventTime);
+        _lastEventTime = time;
+    }
+}
+
+void
+LatencyThrottlePolicy::resize(uint64_t time)
+{
+    double elapsed = time - _resizeTime;
+    double pendingTime = _pendingTime;
+    uint32_t numOk = _numOk;
+    _resizeTime = time;
+    _numSent = 0;
+    _numOk = 0;
+    _pendingTime = 0;
+    if ((numOk == 0) || (elapsed <= 0) || (pendingTime <= 0)) {
+        return;
+    }
+
+    // Little's law: the average time a message is pending is the time weighted number of pending messages
+    // divided by the number of messages completed. Failed messages count as pending without completing,
+    // adding to the round trip time.
+    _rtt = pendingTime / numOk;
+    if ((_minRtt == 0) || (_rtt < _minRtt)) {
+        _minRtt = _rtt;
+    }
+    double avgPending = pendingTime / elapsed;
+    double queued = avgPending * (1 - _minRtt / _rtt);
+    double scale = std::max(1.0, std::log10(_windowSize));
+    double alpha = _alpha * scale;
+    double beta = _beta * scale;
+    LOG(debug, "WindowSize = %.2f, Rtt = %.2f, MinRtt = %.2f, Pending = %.2f, Queued = %.2f",
+        _windowSize, _rtt, _minRtt, avgPending, queued);
+
+    if (queued < alpha) {
+        _windowSize += _windowSizeIncrement;
+    } else if (queued > beta) {
+        _windowSize = std::max(_windowSize / 2, _windowSize - (queued - beta));
+    }
+    _windowSize = std::max(_minWindowSize, _windowSize);
+    _windowSize = std::min(_maxWindowSize, _windowSize);
+}
+
+void
+LatencyThrottlePolicy::processMessage(Message &msg)
+{
+    StaticThrottlePolicy::processMessage(msg);
+    uint64_t time = _timer->getMilliTime();
+    accumulatePendingTime(time);
+    ++_numPending;
+    if (++_numSent < _windowSize * _resizeRate) {
+        return;
+    }
+    resize(time);
+}
+
+void
+LatencyThrottlePolicy::processReply(Reply &reply)
+{
+    StaticThrottlePolicy::processReply(reply);
+    accumulatePendingTime(_timer->getMilliTime());
+    if (_numPending > 0) {
+        --_numPending;
+    }
+    if (!reply.hasErrors()) {
+        ++_numOk;
+    }
+}
+
+} // namespace mbus
@@ -0,0 +1,166 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#pragma once
+
+#include "itimer.h"
+#include "staticthrottlepolicy.h"
+
+namespace mbus {
+
+/**
+ * This is an implementation of the {@link ThrottlePolicy} that sizes the window of pending messages a
+ * {@link SourceSession} is allowed to have from the measured round trip time of messages, in the style of
+ * TCP Vegas.
+ *
+ * The round trip time is derived from the time weighted number of pending messages and the number of
+ * replies received during each resize period (Little's law), so no per message bookkeeping is needed. The
+ * number of messages queued at the receivers is then estimated from the window size and the ratio between
+ * the minimum round trip time seen and the current one. The window grows while fewer than alpha messages
+ * are estimated to be queued, and shrinks towards beta queued messages when more than beta are. Both limits
+ * scale with the base 10 logarithm of the window size, to tolerate more measurement noise for large
+ * windows. Unlike the {@link DynamicThrottlePolicy}, this backs off as soon as queueing starts to increase
+ * latency, instead of waiting until throughput stops increasing.
+ *
+ * <b>NOTE:</b> By context, "pending" is refering to the number of sent messages that have not been replied to
+ * yet.
+ */
+class LatencyThrottlePolicy : public StaticThrottlePolicy {
+private:
+    ITimer::UP _timer;
+    uint32_t   _numSent;
+    uint32_t   _numOk;
+    uint32_t   _numPending;
+    uint32_t   _resizeRate;
+    uint64_t   _resizeTime;
+    uint64_t   _lastEventTime;
+    uint64_t   _timeOfLastMessage;
+    uint64_t   _idleTimePeriod;
+    double     _pendingTime;
+    double     _alpha;
+    double     _beta;
+    double     _windowSizeIncrement;
+    double     _windowSize;
+    double     _maxWindowSize;
+    double     _minWindowSize;
+    double     _rtt;
+    double     _minRtt;
+
+    void accumulatePendingTime(uint64_t time);
+    void resize(uint64_t time);
+
+public:
+    /**
+     * Convenience typedefs.
+     */
+    typedef std::unique_ptr<LatencyThrottlePolicy> UP;
+    typedef std::shared_ptr<LatencyThrottlePolicy> SP;
+
+    /**
+     * Constructs a new instance of this policy and sets the appropriate default values of member data.
+     */
+    LatencyThrottlePolicy();
+
+    /**
+     * Constructs a new instance of this class using the given clock to measure round trip time.
+     *
+     * @param timer The timer to use.
+     */
+    LatencyThrottlePolicy(ITimer::UP timer);
+    ~LatencyThrottlePolicy() override;
+
+    /**
+     * Sets the estimated number of messages queued at the receivers below which the window size is
+     * increased, as a factor of the base 10 logarithm of the window size.
+     *
+     * @param alpha The factor to set.
+     * @return This, to allow chaining.
+     */
+    LatencyThrottlePolicy &setAlpha(double alpha);
+
+    /**
+     * Sets the estimated number of messages queued at the receivers above which the window size is
+     * decreased, as a factor of the base 10 logarithm of the window size.
+     *
+     * @param beta The factor to set.
+     * @return This, to allow chaining.
+     */
+    LatencyThrottlePolicy &setBeta(double beta);
+
+    /**
+     * Sets the step size used when increasing window size.
+     *
+     * @param windowSizeIncrement The step size to set.
+     * @return This, to allow chaining.
+     */
+    LatencyThrottlePolicy &setWindowSizeIncrement(double windowSizeIncrement);
+
+    /**
+     * Sets the rate at which the window size is updated, as the number of windows of messages sent
+     * between each update.
+     *
+     * @param resizeRate The rate to set.
+     * @return This, to allow chaining.
+     */
+    LatencyThrottlePolicy &setResizeRate(uint32_t resizeRate);
+
+    /**
+     * Sets the idle time period for this client. If nothing is sent throughout this time period, the
+     * window will retract, and the minimum round trip time is measured anew.
+     *
+     * @param period The time period to set.
+     * @return This, to allow chaining.
+     */
+    LatencyThrottlePolicy &setIdleTimePeriod(uint64_t period);
+
+    /**
+     * Sets the maximium number of pending operations allowed at any time.
+     *
+     * @param max The max to set.
+     * @return This, to allow chaining.
+     */
+    LatencyThrottlePolicy &setMaxWindowSize(double max);
+
+    /**
+     * Sets the minimium number of pending operations allowed at any time.
+     *
+     * @param min The min to set.
+     * @return This, to allow chaining.
+     */
+    LatencyThrottlePolicy &setMinWindowSize(double min);
+
+    /**
+     * Sets the maximum number of pending messages allowed.
+     *
+     * @param maxCount The max count.
+     * @return This, to allow chaining.
+     */
+    LatencyThrottlePolicy &setMaxPendingCount(uint32_t maxCount);
+
+    /**
+     * Returns the maximum number of pending messages allowed.
+     *
+     * @return The max limit.
+     */
+    uint32_t getMaxPendingCount() const { return (uint32_t)_windowSize; }
+
+    /**
+     * Returns the current window size, for reporting.
+     */
+    double getWindowSize() const { return _windowSize; }
+
+    /**
+     * Returns the round trip time in milliseconds measured in the last resize period, or 0 if not yet
+     * measured.
+     */
+    double getRtt() const { return _rtt; }
+
+    /**
+     * Returns the minimum round trip time in milliseconds measured, or 0 if not yet measured.
+     */
+    double getMinRtt() const { return _minRtt; }
+
+    bool canSend(const Message &msg, uint32_t pendingCount) override;
+    void processMessage(Message &msg) override;
+    void processReply(Reply &reply) override;
+};
+
+} // namespace mbus
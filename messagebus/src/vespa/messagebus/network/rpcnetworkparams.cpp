@@ -15,6 +15,8 @@ RPCNetworkParams::RPCNetworkParams(config::ConfigUri configUri) :
     _maxInputBufferSize(256*1024),
     _maxOutputBufferSize(256*1024),
     _numThreads(4),
+    _numNetworkThreads(1),
+    _numRpcTargets(1),
     _tcpNoDelay(true),
     _dispatchOnEncode(true),
     _dispatchOnDecode(false),
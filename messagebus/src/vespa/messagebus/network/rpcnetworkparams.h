@@ -20,6 +20,8 @@ private:
     uint32_t          _maxInputBufferSize;
     uint32_t          _maxOutputBufferSize;
     uint32_t          _numThreads;
+    uint32_t          _numNetworkThreads;
+    uint32_t          _numRpcTargets;
     bool              _tcpNoDelay;
     bool              _dispatchOnEncode;
     bool              _dispatchOnDecode;
@@ -105,6 +107,34 @@ public:
 
     uint32_t getNumThreads() const { return _numThreads; }
 
+    /**
+     * Sets number of network (FNET) threads serving the connections.
+     *
+     * @param numNetworkThreads number of network threads
+     * @return This, to allow chaining.
+     */
+    RPCNetworkParams &setNumNetworkThreads(uint32_t numNetworkThreads) {
+        _numNetworkThreads = numNetworkThreads;
+        return *this;
+    }
+
+    uint32_t getNumNetworkThreads() const { return _numNetworkThreads; }
+
+    /**
+     * Sets number of connections kept towards each target. Using more than
+     * one lets traffic to a single busy peer be handled by several network
+     * threads.
+     *
+     * @param numRpcTargets number of connections per target
+     * @return This, to allow chaining.
+     */
+    RPCNetworkParams &setNumRpcTargets(uint32_t numRpcTargets) {
+        _numRpcTargets = numRpcTargets;
+        return *this;
+    }
+
+    uint32_t getNumRpcTargets() const { return _numRpcTargets; }
+
     RPCNetworkParams &setTcpNoDelay(bool tcpNoDelay) {
         _tcpNoDelay = tcpNoDelay;
         return *this;
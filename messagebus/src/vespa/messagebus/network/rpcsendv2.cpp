@@ -96,6 +96,32 @@ private:
     }
     DataBuffer _buf;
 };
+
+/**
+ * Adds the encoding, uncompressed size and (possibly compressed) payload of an encoded slime.
+ * Compression is only attempted for payloads of at least the configured minimum size. When the
+ * payload is sent uncompressed, the encoded buffer is handed over as is instead of being copied,
+ * which is the common case for small messages and replies.
+ */
+void
+addPayload(FRT_Values & values, const CompressionConfig & config, DataBuffer & encoded)
+{
+    ConstBufferRef toCompress(encoded.getData(), encoded.getDataLen());
+    CompressionConfig::Type type = CompressionConfig::NONE;
+    DataBuffer compressed(0);
+    if (toCompress.size() >= config.minSize) {
+        // Allowing swap makes an uncompressed result reference the encoded buffer instead of copying it.
+        type = compress(config, toCompress, compressed, true);
+    }
+    DataBuffer & payload = ((type == CompressionConfig::NONE) || (type == CompressionConfig::NONE_MULTI))
+                           ? encoded : compressed;
+    values.AddInt8(type);
+    values.AddInt32(toCompress.size());
+    const auto bufferLength = payload.getDataLen();
+    assert(bufferLength <= INT32_MAX);
+    values.AddData(payload.stealBuffer(), bufferLength);
+}
+
 }
 
 void
@@ -125,15 +151,7 @@ RPCSendV2::encodeRequest(FRT_RPCRequest &req, const Version &version, const Rout
 
     OutputBuf rBuf(8192);
     BinaryFormat::encode(slime, rBuf);
-    ConstBufferRef toCompress(rBuf.getBuf().getData(), rBuf.getBuf().getDataLen());
-    DataBuffer buf(vespalib::roundUp2inN(rBuf.getBuf().getDataLen()));
-    CompressionConfig::Type type = compress(_net->getCompressionConfig(), toCompress, buf, false);
-
-    args.AddInt8(type);
-    args.AddInt32(toCompress.size());
-    const auto bufferLength = buf.getDataLen();
-    assert(bufferLength <= INT32_MAX);
-    args.AddData(buf.stealBuffer(), bufferLength);
+    addPayload(args, _net->getCompressionConfig(), rBuf.getBuf());
 }
 
 namespace {
@@ -255,16 +273,7 @@ RPCSendV2::createResponse(FRT_Values & ret, const string & version, Reply & repl
 
     OutputBuf rBuf(8192);
     BinaryFormat::encode(slime, rBuf);
-    ConstBufferRef toCompress(rBuf.getBuf().getData(), rBuf.getBuf().getDataLen());
-    DataBuffer buf(vespalib::roundUp2inN(rBuf.getBuf().getDataLen()));
-    CompressionConfig::Type type = compress(_net->getCompressionConfig(), toCompress, buf, false);
-
-    ret.AddInt8(type);
-    ret.AddInt32(toCompress.size());
-    const auto bufferLength = buf.getDataLen();
-    assert(bufferLength <= INT32_MAX);
-    ret.AddData(buf.stealBuffer(), bufferLength);
-
+    addPayload(ret, _net->getCompressionConfig(), rBuf.getBuf());
 }
 
 } // namespace mbus
@@ -1,26 +1,51 @@
 // Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 #include "rpctargetpool.h"
 #include <vespa/messagebus/steadytimer.h>
+#include <algorithm>
+#include <thread>
 
 namespace mbus {
 
-RPCTargetPool::Entry::Entry(RPCTarget::SP target, uint64_t lastUse) :
-    _target(target),
-    _lastUse(lastUse)
+RPCTargetPool::Entry::Entry(std::vector<RPCTarget::SP> targets, uint64_t lastUse)
+    : _targets(std::move(targets)),
+      _lastUse(lastUse)
 { }
 
-RPCTargetPool::RPCTargetPool(double expireSecs) :
-    _lock(),
-    _targets(),
-    _timer(new SteadyTimer()),
-    _expireMillis(static_cast<uint64_t>(expireSecs * 1000))
+RPCTargetPool::Entry::~Entry() = default;
+
+RPCTarget::SP
+RPCTargetPool::Entry::getTarget(const LockGuard &, uint64_t now)
+{
+    size_t idx = std::hash<std::thread::id>()(std::this_thread::get_id()) % _targets.size();
+    RPCTarget::SP & target = _targets[idx];
+    if ( ! target->isValid()) {
+        return RPCTarget::SP();
+    }
+    _lastUse = now;
+    return target;
+}
+
+bool
+RPCTargetPool::Entry::inUse(const LockGuard &) const
+{
+    for (const auto & target : _targets) {
+        if (target.use_count() > 1) {
+            return true;
+        }
+    }
+    return false;
+}
+
+RPCTargetPool::RPCTargetPool(double expireSecs, size_t numTargetsPerSpec)
+    : RPCTargetPool(std::make_unique<SteadyTimer>(), expireSecs, numTargetsPerSpec)
 { }
 
-RPCTargetPool::RPCTargetPool(ITimer::UP timer, double expireSecs) :
+RPCTargetPool::RPCTargetPool(ITimer::UP timer, double expireSecs, size_t numTargetsPerSpec) :
     _lock(),
     _targets(),
     _timer(std::move(timer)),
-    _expireMillis(static_cast<uint64_t>(expireSecs * 1000))
+    _expireMillis(static_cast<uint64_t>(expireSecs * 1000)),
+    _numTargetsPerSpec(std::max(size_t(1), numTargetsPerSpec))
 { }
 
 RPCTargetPool::~RPCTargetPool()
@@ -36,17 +61,15 @@ RPCTargetPool::flushTargets(bool force)
     TargetMap::iterator it = _targets.begin();
     while (it != _targets.end()) {
         Entry &entry = it->second;
-        if (entry._target.get() != nullptr) {
-            if (entry._target.use_count() > 1) {
-                entry._lastUse = currentTime;
+        if (entry.inUse(guard)) {
+            entry._lastUse = currentTime;
+            ++it;
+            continue; // someone is using this
+        }
+        if (!force) {
+            if (entry._lastUse + _expireMillis > currentTime) {
                 ++it;
-                continue; // someone is using this
-            }
-            if (!force) {
-                if (entry._lastUse + _expireMillis > currentTime) {
-                    ++it;
-                    continue; // not sufficiently idle
-                }
+                continue; // not sufficiently idle
             }
         }
         _targets.erase(it++); // postfix increment to move the iterator
@@ -68,16 +91,19 @@ RPCTargetPool::getTarget(FRT_Supervisor &orb, const RPCServiceAddress &address)
     LockGuard guard(_lock);
     auto it = _targets.find(spec);
     if (it != _targets.end()) {
-        Entry &entry = it->second;
-        if (entry._target->isValid()) {
-            entry._lastUse = currentTime;
-            return entry._target;
+        RPCTarget::SP target = it->second.getTarget(guard, currentTime);
+        if (target) {
+            return target;
         }
         _targets.erase(it);
     }
-    auto ret = std::make_shared<RPCTarget>(spec, orb);
-    _targets.insert(TargetMap::value_type(spec, Entry(ret, currentTime)));
-    return ret;
+    std::vector<RPCTarget::SP> targets;
+    targets.reserve(_numTargetsPerSpec);
+    for (size_t i = 0; i < _numTargetsPerSpec; ++i) {
+        targets.push_back(std::make_shared<RPCTarget>(spec, orb));
+    }
+    auto result = _targets.emplace(spec, Entry(std::move(targets), currentTime));
+    return result.first->second.getTarget(guard, currentTime);
 }
 
 } // namespace mbus
@@ -6,6 +6,7 @@
 #include <vespa/messagebus/itimer.h>
 #include <vespa/vespalib/util/sync.h>
 #include <map>
+#include <vector>
 
 class FRT_Supervisor;
 
@@ -17,24 +18,28 @@ namespace mbus {
  */
 class RPCTargetPool {
 private:
+    using LockGuard = std::lock_guard<std::mutex>;
     /**
      * Implements a helper class holds the necessary reference and token counter
      * for a JRT target to keep connections open as long as they get used from
      * time to time.
      */
     struct Entry {
-        RPCTarget::SP _target;
-        uint64_t      _lastUse;
+        std::vector<RPCTarget::SP> _targets;
+        uint64_t                   _lastUse;
 
-        Entry(RPCTarget::SP target, uint64_t lastUse);
+        Entry(std::vector<RPCTarget::SP> targets, uint64_t lastUse);
+        ~Entry();
+        RPCTarget::SP getTarget(const LockGuard & guard, uint64_t now);
+        bool inUse(const LockGuard & guard) const;
     };
     using TargetMap = std::map<string, Entry>;
-    using LockGuard = std::lock_guard<std::mutex>;
 
     std::mutex     _lock;
     TargetMap      _targets;
     ITimer::UP     _timer;
     uint64_t       _expireMillis;
+    size_t         _numTargetsPerSpec;
 
 public:
     RPCTargetPool(const RPCTargetPool &) = delete;
@@ -46,8 +51,10 @@ public:
      *
      * @param expireSecs The number of seconds until an idle connection is
      *                   closed.
+     * @param numTargetsPerSpec The number of connections to open towards
+     *                   each address.
      */
-    RPCTargetPool(double expireSecs);
+    RPCTargetPool(double expireSecs, size_t numTargetsPerSpec);
 
     /**
      * Constructs a new instance of this class, using the given {@link Timer}
@@ -57,8 +64,10 @@ public:
      * @param timer      The timer to use for connection expiration.
      * @param expireSecs The number of seconds until an idle connection is
      *                   closed.
+     * @param numTargetsPerSpec The number of connections to open towards
+     *                   each address.
      */
-    RPCTargetPool(ITimer::UP timer, double expireSecs);
+    RPCTargetPool(ITimer::UP timer, double expireSecs, size_t numTargetsPerSpec);
 
     /**
      * Destructor. Frees any allocated resources.
@@ -69,7 +78,10 @@ public:
      * This method will return a target for the given address. If a target does
      * not currently exist for the given address, it will be created and added
      * to the internal map. Each target is also reference counted so that the
-     * tokens of targets that are currently active is never decremented.
+     * tokens of targets that are currently active is never decremented. When
+     * several connections are kept per address, the calling thread always
+     * gets the same one, spreading the load of different threads across the
+     * network threads serving the connections.
      *
      * @param orb     The supervisor to use to connect to the target.
      * @param address The address to resolve to a target.
@@ -0,0 +1,64 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/metrics/sharded_accumulator.h>
+#include <vespa/metrics/countmetric.hpp>
+#include <vespa/metrics/valuemetric.hpp>
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+
+namespace metrics {
+
+TEST(ShardedAccumulatorTest, counts_from_many_threads_are_flushed_into_count_metric)
+{
+    ShardedCountAccumulator<uint64_t> acc;
+    LongCountMetric metric("test", {}, "description");
+    std::vector<std::thread> threads;
+    for (uint32_t t = 0; t < 8; ++t) {
+        threads.emplace_back([&acc]() {
+            for (uint32_t i = 0; i < 10000; ++i) {
+                acc.inc();
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    EXPECT_EQ(uint64_t(80000), acc.getValue());
+    EXPECT_EQ(uint64_t(0), metric.getValue());
+    acc.flushTo(metric);
+    EXPECT_EQ(uint64_t(0), acc.getValue());
+    EXPECT_EQ(uint64_t(80000), metric.getValue());
+    acc.inc(5);
+    acc.flushTo(metric);
+    EXPECT_EQ(uint64_t(80005), metric.getValue());
+}
+
+TEST(ShardedAccumulatorTest, values_from_many_threads_are_flushed_as_one_batch)
+{
+    ShardedValueAccumulator<int64_t, int64_t> acc;
+    LongValueMetric metric("test", {}, "description");
+    std::vector<std::thread> threads;
+    for (int64_t t = 0; t < 4; ++t) {
+        threads.emplace_back([&acc, t]() {
+            for (int64_t i = 1; i <= 100; ++i) {
+                acc.addValue(t * 100 + i);
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    acc.flushTo(metric);
+    EXPECT_EQ(int64_t(400), metric.getLongValue("count"));
+    EXPECT_EQ(int64_t(1), metric.getLongValue("min"));
+    EXPECT_EQ(int64_t(400), metric.getLongValue("max"));
+    EXPECT_EQ(int64_t(80200), metric.getLongValue("total"));
+    EXPECT_DOUBLE_EQ(200.5, metric.getAverage());
+
+    // nothing left to flush
+    acc.flushTo(metric);
+    EXPECT_EQ(int64_t(400), metric.getLongValue("count"));
+}
+
+}
@@ -0,0 +1,20 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "sharded_accumulator.h"
+
+namespace metrics::sharded {
+
+namespace {
+
+std::atomic<size_t> _nextThreadShard(0);
+
+}
+
+size_t
+thisThreadShard()
+{
+    thread_local size_t shard = _nextThreadShard.fetch_add(1, std::memory_order_relaxed) % NUM_SHARDS;
+    return shard;
+}
+
+}
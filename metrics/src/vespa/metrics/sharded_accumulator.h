@@ -0,0 +1,133 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+/**
+ * \class ShardedCountAccumulator
+ * \ingroup metrics
+ *
+ * \brief Per-thread sharded accumulators for metrics updated from hot paths.
+ *
+ * Updating a CountMetric or ValueMetric from many threads makes the cache
+ * lines holding its MetricValueSet bounce between cores. The accumulators
+ * in this file keep one cache line aligned shard per thread (threads are
+ * spread over a fixed number of shards), so concurrent updates mostly touch
+ * different cache lines.
+ *
+ * The accumulated values are moved into a regular metric with flushTo(),
+ * typically from an update hook that the metric manager calls before taking
+ * snapshots. Snapshot, reset and reporting semantics are thus those of the
+ * target metric.
+ */
+#pragma once
+
+#include "countmetric.h"
+#include "valuemetric.h"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <limits>
+#include <mutex>
+
+namespace metrics {
+
+namespace sharded {
+
+constexpr size_t NUM_SHARDS = 16;
+
+/** Returns the shard used by the calling thread. */
+size_t thisThreadShard();
+
+}
+
+template <typename T>
+class ShardedCountAccumulator {
+    struct alignas(64) Shard {
+        std::atomic<T> value;
+        Shard() : value(0) {}
+    };
+    std::array<Shard, sharded::NUM_SHARDS> _shards;
+
+public:
+    ShardedCountAccumulator() : _shards() {}
+    ShardedCountAccumulator(const ShardedCountAccumulator &) = delete;
+    ShardedCountAccumulator & operator=(const ShardedCountAccumulator &) = delete;
+
+    void inc(T value = 1) {
+        _shards[sharded::thisThreadShard()].value.fetch_add(value, std::memory_order_relaxed);
+    }
+
+    /** Sum of all values accumulated since the last flush. */
+    T getValue() const {
+        T sum = 0;
+        for (const auto &shard : _shards) {
+            sum += shard.value.load(std::memory_order_relaxed);
+        }
+        return sum;
+    }
+
+    /** Moves all accumulated values into the given metric. */
+    template <bool SumOnAdd>
+    void flushTo(CountMetric<T, SumOnAdd> &metric) {
+        T sum = 0;
+        for (auto &shard : _shards) {
+            sum += shard.value.exchange(0, std::memory_order_relaxed);
+        }
+        if (sum != 0) {
+            metric.inc(sum);
+        }
+    }
+};
+
+template <typename AvgVal, typename TotVal>
+class ShardedValueAccumulator {
+    struct alignas(64) Shard {
+        std::mutex lock;
+        TotVal     sum;
+        uint32_t   count;
+        AvgVal     min;
+        AvgVal     max;
+        Shard() : lock(), sum(0), count(0), min(std::numeric_limits<AvgVal>::max()),
+                  max(std::numeric_limits<AvgVal>::lowest()) {}
+    };
+    std::array<Shard, sharded::NUM_SHARDS> _shards;
+
+public:
+    ShardedValueAccumulator() : _shards() {}
+    ShardedValueAccumulator(const ShardedValueAccumulator &) = delete;
+    ShardedValueAccumulator & operator=(const ShardedValueAccumulator &) = delete;
+
+    void addValue(AvgVal value) {
+        Shard &shard = _shards[sharded::thisThreadShard()];
+        std::lock_guard<std::mutex> guard(shard.lock);
+        shard.sum += value;
+        ++shard.count;
+        shard.min = std::min(shard.min, value);
+        shard.max = std::max(shard.max, value);
+    }
+
+    /** Moves all accumulated values into the given metric as a single batch. */
+    template <bool SumOnAdd>
+    void flushTo(ValueMetric<AvgVal, TotVal, SumOnAdd> &metric) {
+        TotVal sum = 0;
+        uint32_t count = 0;
+        AvgVal min = std::numeric_limits<AvgVal>::max();
+        AvgVal max = std::numeric_limits<AvgVal>::lowest();
+        for (auto &shard : _shards) {
+            std::lock_guard<std::mutex> guard(shard.lock);
+            if (shard.count == 0) {
+                continue;
+            }
+            sum += shard.sum;
+            count += shard.count;
+            min = std::min(min, shard.min);
+            max = std::max(max, shard.max);
+            shard.sum = 0;
+            shard.count = 0;
+            shard.min = std::numeric_limits<AvgVal>::max();
+            shard.max = std::numeric_limits<AvgVal>::lowest();
+        }
+        if (count != 0) {
+            metric.addTotalValueBatch(sum, count, min, max);
+        }
+    }
+};
+
+} // metrics
@@ -90,4 +90,20 @@ PersistenceProvider::updateAsync(const Bucket &bucket, Timestamp timestamp, Docu
     onComplete->onComplete(std::make_unique<UpdateResult>(result));
 }
 
+void
+PersistenceProvider::getAsync(const Bucket &bucket, const document::FieldSet &fieldSet, const DocumentId &docId,
+                              Context &context, OperationComplete::UP onComplete) const
+{
+    GetResult result = get(bucket, fieldSet, docId, context);
+    onComplete->onComplete(std::make_unique<GetResult>(result));
+}
+
+void
+PersistenceProvider::iterateAsync(IteratorId id, uint64_t maxByteSize, Context &context,
+                                  OperationComplete::UP onComplete) const
+{
+    IterateResult result = iterate(id, maxByteSize, context);
+    onComplete->onComplete(std::make_unique<IterateResult>(std::move(result)));
+}
+
 }
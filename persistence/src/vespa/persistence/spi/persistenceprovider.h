@@ -229,6 +229,15 @@ struct PersistenceProvider
      */
     virtual GetResult get(const Bucket&, const document::FieldSet& fieldSet, const DocumentId& id, Context&) const = 0;
 
+    /**
+     * Asynchronous version of get(). The default implementation calls
+     * get() and completes the operation before returning. Providers able
+     * to do lookups without blocking the calling thread should override
+     * this. The result given to onComplete is a GetResult.
+     */
+    virtual void getAsync(const Bucket&, const document::FieldSet& fieldSet, const DocumentId& id, Context&,
+                          OperationComplete::UP onComplete) const;
+
     /**
      * Create an iterator for a given bucket and selection criteria, returning
      * a unique, non-zero iterator identifier that can be used by the caller as
@@ -324,6 +333,13 @@ struct PersistenceProvider
      */
     virtual IterateResult iterate(IteratorId id, uint64_t maxByteSize, Context&) const = 0;
 
+    /**
+     * Asynchronous version of iterate(). The default implementation calls
+     * iterate() and completes the operation before returning. The result
+     * given to onComplete is an IterateResult.
+     */
+    virtual void iterateAsync(IteratorId id, uint64_t maxByteSize, Context&, OperationComplete::UP onComplete) const;
+
     /**
      * Destroys the iterator specified by the given id.
      * <p/>
@@ -14,6 +14,9 @@ Config::Config() :
     _isFilter(false),
     _fastAccess(false),
     _mutable(false),
+    _paged(false),
+    _compressed(false),
+    _huge_page_policy(vespalib::alloc::HugePagePolicy::DEFAULT),
     _growStrategy(),
     _compactionStrategy(),
     _predicateParams(),
@@ -33,6 +36,9 @@ Config::Config(BasicType bt, CollectionType ct, bool fastSearch_, bool huge_)
       _isFilter(false),
       _fastAccess(false),
       _mutable(false),
+      _paged(false),
+      _compressed(false),
+      _huge_page_policy(vespalib::alloc::HugePagePolicy::DEFAULT),
       _growStrategy(),
       _compactionStrategy(),
       _predicateParams(),
@@ -60,6 +66,9 @@ Config::operator==(const Config &b) const
            _isFilter == b._isFilter &&
            _fastAccess == b._fastAccess &&
            _mutable == b._mutable &&
+           _paged == b._paged &&
+           _compressed == b._compressed &&
+           _huge_page_policy == b._huge_page_policy &&
            _growStrategy == b._growStrategy &&
            _compactionStrategy == b._compactionStrategy &&
            _predicateParams == b._predicateParams &&
@@ -60,6 +60,27 @@ public:
      */
     bool fastAccess() const { return _fastAccess; }
 
+    /**
+     * Check if the data of this attribute should be stored in memory mapped files
+     * instead of anonymous memory, so the page cache can swap it out.
+     * Supported for dense tensor attributes, single value numeric attributes,
+     * single value enum indexes and the unique values of enumerated attributes.
+     */
+    bool paged() const { return _paged; }
+
+    /**
+     * Check if the values of this attribute should be stored bit packed,
+     * using only as many bits as needed by the local value range.
+     * Currently only supported for single value integer attributes without fast search.
+     */
+    bool compressed() const { return _compressed; }
+
+    /**
+     * Huge page policy for the memory mapped buffers of this attribute, i.e. the attribute vector,
+     * enum store and tensor buffers. Ignored when the attribute is paged.
+     */
+    vespalib::alloc::HugePagePolicy huge_page_policy() const { return _huge_page_policy; }
+
     const GrowStrategy & getGrowStrategy() const { return _growStrategy; }
     const CompactionStrategy &getCompactionStrategy() const { return _compactionStrategy; }
     Config & setHuge(bool v)                         { _huge = v; return *this;}
@@ -110,6 +131,9 @@ public:
 
     Config & setMutable(bool isMutable) { _mutable = isMutable; return *this; }
     Config & setFastAccess(bool v) { _fastAccess = v; return *this; }
+    Config & setPaged(bool v) { _paged = v; return *this; }
+    Config & setCompressed(bool v) { _compressed = v; return *this; }
+    Config & set_huge_page_policy(vespalib::alloc::HugePagePolicy v) { _huge_page_policy = v; return *this; }
     Config & setGrowStrategy(const GrowStrategy &gs) { _growStrategy = gs; return *this; }
     Config &setCompactionStrategy(const CompactionStrategy &compactionStrategy) { _compactionStrategy = compactionStrategy; return *this; }
     bool operator!=(const Config &b) const { return !(operator==(b)); }
@@ -125,6 +149,9 @@ private:
     bool           _isFilter;
     bool           _fastAccess;
     bool           _mutable;
+    bool           _paged;
+    bool           _compressed;
+    vespalib::alloc::HugePagePolicy _huge_page_policy;
     GrowStrategy   _growStrategy;
     CompactionStrategy _compactionStrategy;
     PredicateParams    _predicateParams;
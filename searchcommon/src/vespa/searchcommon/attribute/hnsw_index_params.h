@@ -3,6 +3,7 @@
 #pragma once
 
 #include "distance_metric.h"
+#include <vespa/vespalib/util/alloc.h>
 
 namespace search::attribute {
 
@@ -17,28 +18,40 @@ private:
     // This is always the same as in the attribute config, and is duplicated here to simplify usage.
     DistanceMetric _distance_metric;
     bool _multi_threaded_indexing;
+    // Documents with modified vectors are only re-linked in the graph when the distance moved is above this.
+    double _relink_distance_threshold;
+    // Huge page policy used for the memory of the graph (node and link stores).
+    vespalib::alloc::HugePagePolicy _huge_page_policy;
 
 public:
     HnswIndexParams(uint32_t max_links_per_node_in,
                     uint32_t neighbors_to_explore_at_insert_in,
                     DistanceMetric distance_metric_in,
-                    bool multi_threaded_indexing_in = false)
+                    bool multi_threaded_indexing_in = false,
+                    double relink_distance_threshold_in = 0.0,
+                    vespalib::alloc::HugePagePolicy huge_page_policy_in = vespalib::alloc::HugePagePolicy::DEFAULT)
             : _max_links_per_node(max_links_per_node_in),
               _neighbors_to_explore_at_insert(neighbors_to_explore_at_insert_in),
               _distance_metric(distance_metric_in),
-              _multi_threaded_indexing(multi_threaded_indexing_in)
+              _multi_threaded_indexing(multi_threaded_indexing_in),
+              _relink_distance_threshold(relink_distance_threshold_in),
+              _huge_page_policy(huge_page_policy_in)
     {}
 
     uint32_t max_links_per_node() const { return _max_links_per_node; }
     uint32_t neighbors_to_explore_at_insert() const { return _neighbors_to_explore_at_insert; }
     DistanceMetric distance_metric() const { return _distance_metric; }
     bool multi_threaded_indexing() const { return _multi_threaded_indexing; }
+    double relink_distance_threshold() const { return _relink_distance_threshold; }
+    vespalib::alloc::HugePagePolicy huge_page_policy() const { return _huge_page_policy; }
 
     bool operator==(const HnswIndexParams& rhs) const {
         return (_max_links_per_node == rhs._max_links_per_node &&
                 _neighbors_to_explore_at_insert == rhs._neighbors_to_explore_at_insert &&
                 _distance_metric == rhs._distance_metric &&
-                _multi_threaded_indexing == rhs._multi_threaded_indexing);
+                _multi_threaded_indexing == rhs._multi_threaded_indexing &&
+                _relink_distance_threshold == rhs._relink_distance_threshold &&
+                _huge_page_policy == rhs._huge_page_policy);
     }
 };
 
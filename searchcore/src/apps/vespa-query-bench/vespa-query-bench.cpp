@@ -0,0 +1,365 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/fnet/frt/frt.h>
+#include <vespa/searchlib/engine/proto_rpc_adapter.h>
+#include <vespa/searchlib/query/tree/querybuilder.h>
+#include <vespa/searchlib/query/tree/simplequery.h>
+#include <vespa/searchlib/query/tree/stackdumpcreator.h>
+#include <vespa/vespalib/text/stringtokenizer.h>
+#include <vespa/vespalib/util/time.h>
+#include <vespa/fastos/app.h>
+#include <algorithm>
+#include <atomic>
+#include <cinttypes>
+#include <fstream>
+#include <thread>
+
+#include <vespa/log/log.h>
+LOG_SETUP("vespa-query-bench");
+
+using search::engine::ProtoRpcAdapter;
+using search::query::QueryBuilder;
+using search::query::SimpleQueryNodeTypes;
+using search::query::StackDumpCreator;
+using search::query::Weight;
+using vespalib::steady_clock;
+using vespalib::steady_time;
+
+namespace {
+
+/**
+ * A query from the query log. Each line holds a list of terms that
+ * are and'ed together. A term is either 'word' (searched in the
+ * default index) or 'index:word'.
+ **/
+struct Query {
+    vespalib::string line;
+    vespalib::string stack_dump;
+};
+
+vespalib::string
+make_stack_dump(const vespalib::string &line)
+{
+    std::vector<std::pair<vespalib::string, vespalib::string>> terms;
+    vespalib::StringTokenizer tokens(line, " \t");
+    tokens.removeEmptyTokens();
+    for (const auto &token: tokens) {
+        auto pos = token.find(':');
+        if (pos == vespalib::stringref::npos) {
+            terms.emplace_back("default", token);
+        } else {
+            terms.emplace_back(token.substr(0, pos), token.substr(pos + 1));
+        }
+    }
+    if (terms.empty()) {
+        return vespalib::string();
+    }
+    QueryBuilder<SimpleQueryNodeTypes> builder;
+    if (terms.size() > 1) {
+        builder.addAnd(terms.size());
+    }
+    int32_t id = 0;
+    for (const auto &term: terms) {
+        builder.addStringTerm(term.second, term.first, ++id, Weight(100));
+    }
+    return StackDumpCreator::create(*builder.build());
+}
+
+struct Params {
+    vespalib::string spec;
+    vespalib::string document_type;
+    vespalib::string rank_profile;
+    vespalib::string summary_class;
+    uint32_t threads;
+    uint32_t hits;
+    uint32_t timeout_ms;
+    uint32_t passes;
+    Params() : spec(), document_type(), rank_profile("default"), summary_class(),
+               threads(1), hits(10), timeout_ms(5000), passes(1) {}
+};
+
+/**
+ * Latencies (in seconds) and other per-thread counters.
+ **/
+struct Result {
+    std::vector<double> search_latency;
+    std::vector<double> docsum_latency;
+    uint64_t total_hits;
+    uint64_t failed;
+    Result() : search_latency(), docsum_latency(), total_hits(0), failed(0) {}
+    void merge(const Result &rhs) {
+        search_latency.insert(search_latency.end(), rhs.search_latency.begin(), rhs.search_latency.end());
+        docsum_latency.insert(docsum_latency.end(), rhs.docsum_latency.begin(), rhs.docsum_latency.end());
+        total_hits += rhs.total_hits;
+        failed += rhs.failed;
+    }
+};
+
+/**
+ * Issues queries from a shared query list over the search protocol
+ * (and fetches docsums for the hits if a summary class is given)
+ * until all queries have been run the requested number of passes.
+ **/
+class Worker
+{
+private:
+    const Params              &_params;
+    const std::vector<Query>  &_queries;
+    std::atomic<size_t>       &_next;
+    FRT_Target                *_target;
+    Result                     _result;
+
+    bool search(const Query &query, ProtoRpcAdapter::ProtoSearchReply &reply);
+    void docsum(const Query &query, const ProtoRpcAdapter::ProtoSearchReply &hits);
+
+public:
+    Worker(const Params &params, const std::vector<Query> &queries, std::atomic<size_t> &next, FRT_Target *target)
+        : _params(params), _queries(queries), _next(next), _target(target), _result() {}
+    void run();
+    const Result &result() const { return _result; }
+};
+
+bool
+Worker::search(const Query &query, ProtoRpcAdapter::ProtoSearchReply &reply)
+{
+    ProtoRpcAdapter::ProtoSearchRequest req;
+    req.set_hits(_params.hits);
+    req.set_timeout(_params.timeout_ms);
+    req.set_document_type(_params.document_type);
+    req.set_rank_profile(_params.rank_profile);
+    req.set_query_tree_blob(query.stack_dump);
+    auto *rpc = new FRT_RPCRequest();
+    ProtoRpcAdapter::encode_search_request(req, *rpc);
+    steady_time start = steady_clock::now();
+    _target->InvokeSync(rpc, _params.timeout_ms / 1000.0);
+    bool ok = ProtoRpcAdapter::decode_search_reply(*rpc, reply);
+    if (ok) {
+        _result.search_latency.push_back(vespalib::to_s(steady_clock::now() - start));
+        _result.total_hits += reply.total_hit_count();
+    } else {
+        LOG(debug, "search failed for query '%s': %s", query.line.c_str(), rpc->GetErrorMessage());
+        ++_result.failed;
+    }
+    rpc->SubRef();
+    return ok;
+}
+
+void
+Worker::docsum(const Query &query, const ProtoRpcAdapter::ProtoSearchReply &hits)
+{
+    if (hits.hits_size() == 0) {
+        return;
+    }
+    ProtoRpcAdapter::ProtoDocsumRequest req;
+    req.set_timeout(_params.timeout_ms);
+    req.set_document_type(_params.document_type);
+    req.set_rank_profile(_params.rank_profile);
+    req.set_summary_class(_params.summary_class);
+    req.set_query_tree_blob(query.stack_dump);
+    for (const auto &hit: hits.hits()) {
+        req.add_global_ids(hit.global_id());
+    }
+    auto *rpc = new FRT_RPCRequest();
+    ProtoRpcAdapter::encode_docsum_request(req, *rpc);
+    steady_time start = steady_clock::now();
+    _target->InvokeSync(rpc, _params.timeout_ms / 1000.0);
+    ProtoRpcAdapter::ProtoDocsumReply reply;
+    if (ProtoRpcAdapter::decode_docsum_reply(*rpc, reply)) {
+        _result.docsum_latency.push_back(vespalib::to_s(steady_clock::now() - start));
+    } else {
+        LOG(debug, "docsum failed for query '%s': %s", query.line.c_str(), rpc->GetErrorMessage());
+        ++_result.failed;
+    }
+    rpc->SubRef();
+}
+
+void
+Worker::run()
+{
+    size_t limit = _queries.size() * _params.passes;
+    for (size_t i = _next++; i < limit; i = _next++) {
+        const Query &query = _queries[i % _queries.size()];
+        ProtoRpcAdapter::ProtoSearchReply reply;
+        if (search(query, reply) && !_params.summary_class.empty()) {
+            docsum(query, reply);
+        }
+    }
+}
+
+double
+percentile(const std::vector<double> &sorted, double pct)
+{
+    if (sorted.empty()) {
+        return 0.0;
+    }
+    size_t idx = std::min(sorted.size() - 1, size_t(pct / 100.0 * sorted.size()));
+    return sorted[idx];
+}
+
+void
+print_latency(const char *name, std::vector<double> &latency, double elapsed)
+{
+    std::sort(latency.begin(), latency.end());
+    double sum = 0.0;
+    for (double value: latency) {
+        sum += value;
+    }
+    fprintf(stdout, "%s: count=%zu, qps=%.2f, avg=%.3f ms, 50%%=%.3f ms, 90%%=%.3f ms, "
+            "99%%=%.3f ms, 99.9%%=%.3f ms, max=%.3f ms\n",
+            name, latency.size(), latency.size() / elapsed,
+            latency.empty() ? 0.0 : (sum * 1000.0 / latency.size()),
+            percentile(latency, 50.0) * 1000.0, percentile(latency, 90.0) * 1000.0,
+            percentile(latency, 99.0) * 1000.0, percentile(latency, 99.9) * 1000.0,
+            latency.empty() ? 0.0 : (latency.back() * 1000.0));
+}
+
+} // namespace <unnamed>
+
+class App : public FastOS_Application
+{
+private:
+    Params _params;
+
+    int usage();
+    bool load_queries(const char *file_name, std::vector<Query> &queries);
+    bool warmup(FRT_Target *target);
+
+public:
+    int Main() override;
+};
+
+int
+App::usage()
+{
+    fprintf(stderr, "usage: %s [options] <port|spec> <query-file>\n", _argv[0]);
+    fprintf(stderr, "\n");
+    fprintf(stderr, "Replays a query log directly against the search protocol rpc\n");
+    fprintf(stderr, "interface of a running proton, bypassing the container.\n");
+    fprintf(stderr, "Each line in the query file is a list of terms ('word' or\n");
+    fprintf(stderr, "'index:word') that are and'ed together.\n");
+    fprintf(stderr, "\n");
+    fprintf(stderr, "  -t <num>     : number of client threads [1]\n");
+    fprintf(stderr, "  -p <num>     : number of passes through the query file [1]\n");
+    fprintf(stderr, "  -n <num>     : number of hits to request [10]\n");
+    fprintf(stderr, "  -d <name>    : document type to search\n");
+    fprintf(stderr, "  -r <name>    : rank profile [default]\n");
+    fprintf(stderr, "  -s <name>    : fetch docsums for the hits using this summary class\n");
+    fprintf(stderr, "  -T <ms>      : request timeout in milliseconds [5000]\n");
+    return 1;
+}
+
+bool
+App::load_queries(const char *file_name, std::vector<Query> &queries)
+{
+    std::ifstream file(file_name);
+    if (!file) {
+        fprintf(stderr, "could not open query file '%s'\n", file_name);
+        return false;
+    }
+    std::string line;
+    while (std::getline(file, line)) {
+        Query query;
+        query.line = line;
+        query.stack_dump = make_stack_dump(query.line);
+        if (!query.stack_dump.empty()) {
+            queries.push_back(std::move(query));
+        }
+    }
+    if (queries.empty()) {
+        fprintf(stderr, "no queries found in '%s'\n", file_name);
+        return false;
+    }
+    return true;
+}
+
+bool
+App::warmup(FRT_Target *target)
+{
+    auto *rpc = new FRT_RPCRequest();
+    ProtoRpcAdapter::encode_monitor_request(ProtoRpcAdapter::ProtoMonitorRequest(), *rpc);
+    target->InvokeSync(rpc, 60.0);
+    ProtoRpcAdapter::ProtoMonitorReply reply;
+    bool ok = ProtoRpcAdapter::decode_monitor_reply(*rpc, reply);
+    if (!ok) {
+        fprintf(stderr, "ping failed: %s\n", rpc->GetErrorMessage());
+    } else if (!reply.online()) {
+        fprintf(stderr, "search node is not online\n");
+        ok = false;
+    } else {
+        fprintf(stdout, "search node is online with %" PRId64 " active documents\n", reply.active_docs());
+    }
+    rpc->SubRef();
+    return ok;
+}
+
+int
+App::Main()
+{
+    int optIndex = 1;
+    const char *optArg = nullptr;
+    int opt;
+    while ((opt = GetOpt("t:p:n:d:r:s:T:", optArg, optIndex)) != -1) {
+        switch (opt) {
+        case 't': _params.threads = std::max(1, atoi(optArg)); break;
+        case 'p': _params.passes = std::max(1, atoi(optArg)); break;
+        case 'n': _params.hits = atoi(optArg); break;
+        case 'd': _params.document_type = optArg; break;
+        case 'r': _params.rank_profile = optArg; break;
+        case 's': _params.summary_class = optArg; break;
+        case 'T': _params.timeout_ms = std::max(1, atoi(optArg)); break;
+        default: return usage();
+        }
+    }
+    if ((_argc - optIndex) != 2) {
+        return usage();
+    }
+    _params.spec = _argv[optIndex];
+    if (_params.spec.find('/') == vespalib::string::npos) {
+        _params.spec = "tcp/localhost:" + _params.spec;
+    }
+    std::vector<Query> queries;
+    if (!load_queries(_argv[optIndex + 1], queries)) {
+        return 1;
+    }
+    fnet::frt::StandaloneFRT server;
+    FRT_Target *target = server.supervisor().GetTarget(_params.spec.c_str());
+    if (!warmup(target)) {
+        target->SubRef();
+        return 1;
+    }
+    std::atomic<size_t> next(0);
+    std::vector<std::unique_ptr<Worker>> workers;
+    std::vector<std::thread> threads;
+    for (uint32_t i = 0; i < _params.threads; ++i) {
+        workers.push_back(std::make_unique<Worker>(_params, queries, next, target));
+    }
+    steady_time start = steady_clock::now();
+    for (auto &worker: workers) {
+        threads.emplace_back(&Worker::run, worker.get());
+    }
+    for (auto &thread: threads) {
+        thread.join();
+    }
+    double elapsed = vespalib::to_s(steady_clock::now() - start);
+    target->SubRef();
+    Result result;
+    for (const auto &worker: workers) {
+        result.merge(worker->result());
+    }
+    fprintf(stdout, "%zu queries, %u threads, %.3f seconds, %" PRIu64 " failed requests\n",
+            queries.size() * _params.passes, _params.threads, elapsed, result.failed);
+    if (!result.search_latency.empty()) {
+        fprintf(stdout, "avg total hits: %.2f\n", double(result.total_hits) / result.search_latency.size());
+    }
+    print_latency("search", result.search_latency, elapsed);
+    if (!_params.summary_class.empty()) {
+        print_latency("docsum", result.docsum_latency, elapsed);
+    }
+    return (result.failed == 0) ? 0 : 1;
+}
+
+int main(int argc, char **argv)
+{
+    App app;
+    return app.Entry(argc, argv);
+}
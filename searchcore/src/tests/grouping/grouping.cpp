@@ -245,6 +245,21 @@ TEST_F("testGroupingManager", DoomFixture()) {
     ASSERT_TRUE(!manager.empty());
 }
 
+TEST_F("require that grouping manager knows when relevance order is needed", DoomFixture()) {
+    Grouping ordered;
+    ordered.setRoot(Group().addResult(SumAggregationResult().setExpression(MU<AttributeNode>("attr0"))));
+    Grouping unordered;
+    unordered.setRoot(Group().addResult(SumAggregationResult().setExpression(MU<AttributeNode>("attr0")))
+                             .addOrderBy(MU<AttributeNode>("attr1"), false));
+
+    GroupingContext context(f1.clock, f1.timeOfDoom);
+    context.addGrouping(std::make_shared<Grouping>(unordered));
+    GroupingManager manager(context);
+    EXPECT_FALSE(manager.needRelevanceOrder());
+    context.addGrouping(std::make_shared<Grouping>(ordered));
+    EXPECT_TRUE(manager.needRelevanceOrder());
+}
+
 TEST_F("testGroupingSession", DoomFixture()) {
     MyWorld world;
     world.basicSetup();
@@ -466,6 +481,101 @@ TEST_F("test grouping fork/join", DoomFixture()) {
     EXPECT_EQUAL(expect.asString(), list[0]->asString());
 }
 
+TEST_F("test session manager memory limit", DoomFixture()) {
+    MyWorld world;
+    world.basicSetup();
+    Grouping request;
+    request.setFirstLevel(0)
+           .setLastLevel(0)
+           .addLevel(createGL(MU<AttributeNode>("attr1"), MU<AttributeNode>("attr2")))
+           .addLevel(createGL(MU<AttributeNode>("attr2"), MU<AttributeNode>("attr3")));
+    GroupingContext initContext(f1.clock, f1.timeOfDoom);
+    initContext.addGrouping(std::make_shared<Grouping>(request));
+    size_t bytes = GroupingSession(SessionId("foo"), initContext, world.attributeContext).getMemoryUsage();
+    EXPECT_LESS(sizeof(GroupingSession), bytes);
+
+    SessionManager mgr(10, bytes * 5 / 2);
+    mgr.insert(std::make_unique<GroupingSession>(SessionId("foo"), initContext, world.attributeContext));
+    mgr.insert(std::make_unique<GroupingSession>(SessionId("bar"), initContext, world.attributeContext));
+    mgr.insert(std::make_unique<GroupingSession>(SessionId("baz"), initContext, world.attributeContext));
+    SessionManager::Stats stats = mgr.getGroupingStats();
+    EXPECT_EQUAL(3u, stats.numInsert);
+    EXPECT_EQUAL(1u, stats.numDropped);
+    EXPECT_EQUAL(2u, stats.numCached);
+    EXPECT_EQUAL(2 * bytes, stats.memoryUsage);
+    EXPECT_FALSE(mgr.pickGrouping(SessionId("foo")));
+    EXPECT_TRUE(mgr.pickGrouping(SessionId("bar")));
+    stats = mgr.getGroupingStats();
+    EXPECT_EQUAL(bytes, stats.memoryUsage);
+
+    SessionManager tiny(10, bytes / 2);
+    tiny.insert(std::make_unique<GroupingSession>(SessionId("foo"), initContext, world.attributeContext));
+    stats = tiny.getGroupingStats();
+    EXPECT_EQUAL(0u, stats.numCached);
+    EXPECT_EQUAL(1u, stats.numDropped);
+}
+
+TEST_F("test session keeping results serves later passes", DoomFixture()) {
+    MyWorld world;
+    world.basicSetup();
+    Grouping request;
+    request.setRoot(Group().addResult(SumAggregationResult().setExpression(MU<AttributeNode>("attr0"))))
+           .addLevel(createGL(3, MU<AttributeNode>("attr0")))
+           .setFirstLevel(0)
+           .setLastLevel(0);
+    auto owner = std::make_shared<int>(1);
+    GroupingContext context(f1.clock, f1.timeOfDoom);
+    context.addGrouping(std::make_shared<Grouping>(request));
+    GroupingSession session(SessionId("foo"), context, world.attributeContext, owner);
+    std::vector<RankedHit> hits;
+    hits.push_back(RankedHit(12, 30.0));
+    hits.push_back(RankedHit(22, 150.0));
+    hits.push_back(RankedHit(32, 100.0));
+    hits.push_back(RankedHit(42, 4.0));
+    session.getGroupingManager().groupInRelevanceOrder(&hits[0], hits.size());
+    session.getGroupingManager().prune();
+    session.continueExecution(context);
+    ASSERT_EQUAL(1u, context.getGroupingList().size());
+    vespalib::string expect = context.getGroupingList()[0]->asString();
+    EXPECT_EQUAL(3u, context.getGroupingList()[0]->getRoot().getChildrenSize());
+    EXPECT_FALSE(session.finished());
+
+    for (int pass = 0; pass < 2; ++pass) {
+        GroupingContext again(f1.clock, f1.timeOfDoom + duration(pass + 1));
+        again.addGrouping(std::make_shared<Grouping>(request));
+        EXPECT_TRUE(session.canContinue(again, owner));
+        session.continueExecution(again);
+        EXPECT_EQUAL(expect, again.getGroupingList()[0]->asString());
+        EXPECT_FALSE(session.finished());
+        EXPECT_EQUAL(f1.timeOfDoom + duration(pass + 1), session.getTimeOfDoom());
+    }
+
+    GroupingContext otherOwner(f1.clock, f1.timeOfDoom);
+    otherOwner.addGrouping(std::make_shared<Grouping>(request));
+    EXPECT_FALSE(session.canContinue(otherOwner, std::make_shared<int>(1)));
+
+    Grouping moreGroups(request);
+    moreGroups.levels()[0].setMaxGroups(5);
+    GroupingContext more(f1.clock, f1.timeOfDoom);
+    more.addGrouping(std::make_shared<Grouping>(moreGroups));
+    EXPECT_FALSE(session.canContinue(more, owner));
+
+    Grouping allLevels(request);
+    allLevels.setLastLevel(1);
+    GroupingContext all(f1.clock, f1.timeOfDoom);
+    all.addGrouping(std::make_shared<Grouping>(allLevels));
+    EXPECT_FALSE(session.canContinue(all, owner));
+
+    Grouping otherId(request);
+    otherId.setId(7);
+    GroupingContext other(f1.clock, f1.timeOfDoom);
+    other.addGrouping(std::make_shared<Grouping>(otherId));
+    EXPECT_FALSE(session.canContinue(other, owner));
+
+    GroupingSession plain(SessionId("bar"), context, world.attributeContext);
+    EXPECT_TRUE(plain.canContinue(other, owner));
+}
+
 TEST_F("test session timeout", DoomFixture()) {
     MyWorld world;
     world.basicSetup();
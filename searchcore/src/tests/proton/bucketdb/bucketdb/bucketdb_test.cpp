@@ -265,6 +265,46 @@ verifyChecksumCompliance(ChecksumAggregator::ChecksumType type) {
     return ckaggr->getChecksum();
 }
 
+void
+verifyStateChecksumCombination(ChecksumAggregator::ChecksumType type) {
+    BucketState::setChecksumType(type);
+    GlobalId gid1("aaaaaaaaaaaa");
+    GlobalId gid2("bbbbbbbbbbbb");
+    Timestamp t1(0x123456789);
+    Timestamp t2(0xfedcba987);
+    BucketState a;
+    a.add(gid1, t1, DOCSIZE_1, SDT::READY);
+    BucketState b;
+    b.add(gid2, t2, DOCSIZE_2, SDT::NOTREADY);
+    BucketState both;
+    both.add(gid1, t1, DOCSIZE_1, SDT::READY);
+    both.add(gid2, t2, DOCSIZE_2, SDT::NOTREADY);
+    auto ckaggr = ChecksumAggregator::create(type, BucketChecksum(0));
+    ckaggr->addDoc(gid1, t1).addDoc(gid2, t2);
+    EXPECT_EQUAL(ckaggr->getChecksum(), both.getChecksum());
+
+    BucketState sum(a);
+    sum += b;
+    EXPECT_EQUAL(both.getChecksum(), sum.getChecksum());
+    EXPECT_EQUAL(BucketState::addChecksum(a.getChecksum(), b.getChecksum()), sum.getChecksum());
+    sum -= b;
+    EXPECT_EQUAL(a.getChecksum(), sum.getChecksum());
+    sum -= a;
+    EXPECT_TRUE(sum.empty());
+
+    a.remove(gid1, t1, DOCSIZE_1, SDT::READY);
+    b.remove(gid2, t2, DOCSIZE_2, SDT::NOTREADY);
+    both.remove(gid1, t1, DOCSIZE_1, SDT::READY);
+    both.remove(gid2, t2, DOCSIZE_2, SDT::NOTREADY);
+    EXPECT_TRUE(a.empty() && b.empty() && both.empty());
+    BucketState::setChecksumType(ChecksumAggregator::ChecksumType::LEGACY);
+}
+
+TEST("require that bucket state checksums combine like checksum aggregators") {
+    TEST_DO(verifyStateChecksumCombination(ChecksumAggregator::ChecksumType::LEGACY));
+    TEST_DO(verifyStateChecksumCombination(ChecksumAggregator::ChecksumType::XXHASH64));
+}
+
 TEST("test that legacy checksum complies") {
     BucketChecksum cksum = verifyChecksumCompliance(ChecksumAggregator::ChecksumType::LEGACY);
     EXPECT_EQUAL(0x24242423u, cksum);
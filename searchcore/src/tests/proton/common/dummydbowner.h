@@ -22,6 +22,7 @@ struct DummyDBOwner : IDocumentDBOwner {
     std::shared_ptr<IDocumentDBReferenceRegistry> getDocumentDBReferenceRegistry() const override {
         return _registry;
     }
+    void reportTransactionLogReplay(uint64_t, vespalib::duration) override { }
 };
 
 } // namespace proton
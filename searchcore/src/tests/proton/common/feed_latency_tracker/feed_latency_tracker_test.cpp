@@ -0,0 +1,80 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/searchcore/proton/common/feed_latency_tracker.h>
+#include <vespa/vespalib/gtest/gtest.h>
+#include <vespa/vespalib/util/time.h>
+
+#include <vespa/log/log.h>
+LOG_SETUP("feed_latency_tracker_test");
+
+using namespace proton;
+using vespalib::from_s;
+
+FeedStageTimes
+make_times(vespalib::steady_time received, double queue, double log, double apply, double total)
+{
+    FeedStageTimes times;
+    times.received = received;
+    times.started = received + from_s(queue);
+    times.logged = times.started + from_s(log);
+    times.applied = times.started + from_s(apply);
+    times.acked = received + from_s(total);
+    times.opType = 1;
+    return times;
+}
+
+class FeedLatencyTrackerTest : public ::testing::Test {
+protected:
+    vespalib::steady_time now;
+    FeedLatencyTracker tracker;
+    FeedLatencyTrackerTest()
+        : now(vespalib::steady_clock::now()),
+          tracker(from_s(1.0), 2)
+    {
+    }
+};
+
+TEST_F(FeedLatencyTrackerTest, stage_latencies_are_aggregated_until_sampled)
+{
+    tracker.report(make_times(now, 0.1, 0.2, 0.3, 0.5));
+    tracker.report(make_times(now, 0.3, 0.4, 0.1, 0.7));
+    auto stats = tracker.sampleStats();
+    EXPECT_EQ(2u, stats.queue.count());
+    EXPECT_DOUBLE_EQ(0.2, stats.queue.average());
+    EXPECT_DOUBLE_EQ(0.3, stats.log.average());
+    EXPECT_DOUBLE_EQ(0.2, stats.apply.average());
+    EXPECT_DOUBLE_EQ(0.5, stats.total.min());
+    EXPECT_DOUBLE_EQ(0.7, stats.total.max());
+    EXPECT_EQ(0u, tracker.sampleStats().total.count());
+}
+
+TEST_F(FeedLatencyTrackerTest, stages_not_reached_are_not_aggregated)
+{
+    auto times = make_times(now, 0.1, 0.2, 0.3, 0.5);
+    times.logged = vespalib::steady_time();
+    tracker.report(times);
+    times.started = vespalib::steady_time();
+    tracker.report(times);
+    auto stats = tracker.sampleStats();
+    EXPECT_EQ(1u, stats.queue.count());
+    EXPECT_EQ(0u, stats.log.count());
+    EXPECT_EQ(1u, stats.apply.count());
+    EXPECT_EQ(1u, stats.total.count());
+}
+
+TEST_F(FeedLatencyTrackerTest, most_recent_slow_operations_are_kept)
+{
+    tracker.report(make_times(now, 0.1, 0.2, 0.3, 0.5));
+    tracker.report(make_times(now, 0.9, 0.1, 0.1, 1.0));
+    tracker.report(make_times(now, 0.1, 1.5, 0.1, 2.0));
+    tracker.report(make_times(now, 0.1, 0.1, 2.9, 3.0));
+    auto slow = tracker.getSlowOperations();
+    ASSERT_EQ(2u, slow.size());
+    EXPECT_DOUBLE_EQ(2.0, slow[0].total);
+    EXPECT_DOUBLE_EQ(1.5, slow[0].log);
+    EXPECT_DOUBLE_EQ(3.0, slow[1].total);
+    EXPECT_DOUBLE_EQ(2.9, slow[1].apply);
+    EXPECT_EQ(1u, slow[1].opType);
+}
+
+GTEST_MAIN_RUN_ALL_TESTS()
@@ -0,0 +1,59 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/searchcore/proton/common/hw_counter_sampler.h>
+#include <vespa/vespalib/testkit/testapp.h>
+#include <thread>
+
+using proton::HwCounterSampler;
+
+namespace {
+
+uint64_t busy_work(uint64_t rounds)
+{
+    volatile uint64_t sum = 0;
+    for (uint64_t i = 0; i < rounds; ++i) {
+        sum = sum + i * i;
+    }
+    return sum;
+}
+
+}
+
+TEST("require that empty sample gives zero ratios")
+{
+    HwCounterSampler::Sample sample;
+    EXPECT_EQUAL(0.0, sample.ipc());
+    EXPECT_EQUAL(0.0, sample.cacheMissesPerKiloInstruction());
+    EXPECT_EQUAL(0.0, sample.branchMissesPerKiloInstruction());
+}
+
+TEST("require that ratios are derived from counters")
+{
+    HwCounterSampler::Sample sample;
+    sample.cycles = 1000;
+    sample.instructions = 2000;
+    sample.cacheMisses = 10;
+    sample.branchMisses = 4;
+    EXPECT_EQUAL(2.0, sample.ipc());
+    EXPECT_EQUAL(5.0, sample.cacheMissesPerKiloInstruction());
+    EXPECT_EQUAL(2.0, sample.branchMissesPerKiloInstruction());
+}
+
+TEST("require that work in threads created after the sampler is counted")
+{
+    HwCounterSampler sampler;
+    if (!sampler.available()) {
+        fprintf(stderr, "hardware performance counters not available, skipping test\n");
+        EXPECT_EQUAL(0u, sampler.sample().instructions);
+        return;
+    }
+    std::thread worker([]() { busy_work(10000000); });
+    worker.join();
+    HwCounterSampler::Sample sample = sampler.sample();
+    EXPECT_GREATER(sample.instructions, 10000000u);
+    EXPECT_GREATER(sample.cycles, 0u);
+    EXPECT_GREATER(sample.ipc(), 0.0);
+    EXPECT_EQUAL(sample.instructions, sampler.lastSample().instructions);
+}
+
+TEST_MAIN() { TEST_RUN_ALL(); }
@@ -2,6 +2,7 @@
 
 #include <tests/proton/common/dummydbowner.h>
 #include <vespa/config/helper/configgetter.hpp>
+#include <vespa/eval/eval/value_cache/constant_tensor_loader.h>
 #include <vespa/eval/tensor/tensor.h>
 #include <vespa/eval/tensor/default_tensor_engine.h>
 #include <vespa/eval/tensor/serialization/typed_binary_format.h>
@@ -34,6 +35,8 @@
 #include <vespa/vespalib/data/slime/slime.h>
 #include <vespa/vespalib/data/simple_buffer.h>
 #include <vespa/vespalib/encoding/base64.h>
+#include <vespa/vespalib/util/simple_thread_bundle.h>
+#include <vespa/vespalib/util/stringfmt.h>
 #include <vespa/config-bucketspaces.h>
 #include <vespa/vespalib/testkit/testapp.h>
 #include <regex>
@@ -177,6 +180,7 @@ public:
     bool _mkdirOk;
     matching::QueryLimiter _queryLimiter;
     vespalib::Clock _clock;
+    vespalib::eval::ConstantTensorLoader _constantValueFactory;
     DummyWireService _dummy;
     config::DirSpec _spec;
     DocumentDBConfigHelper _configMgr;
@@ -196,6 +200,7 @@ public:
           _mkdirOk(FastOS_File::MakeDirectory("tmpdb")),
           _queryLimiter(),
           _clock(),
+          _constantValueFactory(DefaultTensorEngine::ref()),
           _dummy(),
           _spec(TEST_PATH("")),
           _configMgr(_spec, getDocTypeName()),
@@ -219,6 +224,7 @@ public:
             LOG_ABORT("should not be reached");
         }
         _ddb.reset(new DocumentDB("tmpdb", _configMgr.getConfig(), "tcp/localhost:9013", _queryLimiter, _clock,
+                                  _constantValueFactory,
                                   DocTypeName(docTypeName), makeBucketSpace(),
 				  *b->getProtonConfigSP(), *this, _summaryExecutor, _summaryExecutor,
                                   _tls, _dummy, _fileHeaderContext, ConfigStore::UP(new MemoryConfigStore),
@@ -303,7 +309,9 @@ private:
     void requireThatAdapterHandlesAllFieldTypes();
     void requireThatAdapterHandlesMultipleDocuments();
     void requireThatAdapterHandlesDocumentIdField();
+    void requireThatAdapterOnlyConvertsFieldsInOutputClass();
     void requireThatDocsumRequestIsProcessed();
+    void requireThatLargeDocsumRequestIsProcessedInParallel();
     void requireThatRewritersAreUsed();
     void requireThatAttributesAreUsed();
     void requireThatSummaryAdapterHandlesPutAndRemove();
@@ -535,6 +543,32 @@ Test::requireThatAdapterHandlesDocumentIdField()
 }
 
 
+void
+Test::requireThatAdapterOnlyConvertsFieldsInOutputClass()
+{
+    Schema s;
+    s.addSummaryField(Schema::SummaryField("a", schema::DataType::INT8));
+    s.addSummaryField(Schema::SummaryField("g", schema::DataType::STRING));
+    BuildContext bc(s);
+    bc._bld.startDocument("id:ns:searchdocument::0");
+    bc._bld.startSummaryField("a").addInt(255).endField();
+    bc._bld.startSummaryField("g").addStr("foo").endField();
+    bc.endDocument(0);
+    DocumentStoreAdapter dsa(bc._str, *bc._repo, getResultConfig(), "class0",
+                             bc.createFieldCacheRepo(getResultConfig())->getFieldCache("class0"),
+                             getMarkupFields());
+    const ResultClass *outputClass = getResultConfig().LookupResultClass(getResultConfig().LookupResultClassId("class1"));
+    ASSERT_TRUE(outputClass != nullptr);
+    DocsumStoreValue docsum = dsa.getMappedDocsum(0, *outputClass);
+    ASSERT_TRUE(docsum.pt() != nullptr);
+    GeneralResult res(dsa.getResultClass());
+    ASSERT_TRUE(res.unpack(docsum.pt() + 4, docsum.len() - 4));
+    EXPECT_EQUAL(255u, res.GetEntry("a")->_intval);
+    EXPECT_EQUAL(0u, res.GetEntry("g")->_stringlen);
+    EXPECT_TRUE(assertString("foo", "g", dsa, 0));
+}
+
+
 GlobalId gid1 = DocumentId("id:ns:searchdocument::1").getGlobalId(); // lid 1
 GlobalId gid2 = DocumentId("id:ns:searchdocument::2").getGlobalId(); // lid 2
 GlobalId gid3 = DocumentId("id:ns:searchdocument::3").getGlobalId(); // lid 3
@@ -600,6 +634,41 @@ Test::requireThatDocsumRequestIsProcessed()
 }
 
 
+void
+Test::requireThatLargeDocsumRequestIsProcessedInParallel()
+{
+    Schema s;
+    s.addSummaryField(Schema::SummaryField("a", schema::DataType::INT32));
+
+    BuildContext bc(s);
+    DBContext dc(bc._repo, getDocTypeName());
+    constexpr uint32_t numDocs = 300;
+    DocsumRequest req;
+    req.resultClassName = "class1";
+    for (uint32_t i = 1; i <= numDocs; ++i) {
+        vespalib::string id = vespalib::make_string("id:ns:searchdocument::%u", i);
+        dc.put(*bc._bld.startDocument(id).
+               startSummaryField("a").
+               addInt(i * 10).
+               endField().
+               endDocument(),
+               i);
+        req.hits.push_back(DocsumRequest::Hit(DocumentId(id).getGlobalId()));
+    }
+    req.hits.push_back(DocsumRequest::Hit(gid9));
+    vespalib::SimpleThreadBundle threadBundle(4);
+    DocsumReply::UP rep = dc._ddb->getDocsums(req, threadBundle);
+
+    ASSERT_EQUAL(numDocs + 1, rep->docsums.size());
+    for (uint32_t i = 0; i < numDocs; ++i) {
+        EXPECT_EQUAL(req.hits[i].gid, rep->docsums[i].gid);
+        EXPECT_TRUE(assertSlime(vespalib::make_string("{a:%u}", (i + 1) * 10), *rep, i, false));
+    }
+    EXPECT_EQUAL(search::endDocId, rep->docsums[numDocs].docid);
+    EXPECT_TRUE(rep->docsums[numDocs].data.get() == nullptr);
+}
+
+
 void
 Test::requireThatRewritersAreUsed()
 {
@@ -1260,7 +1329,9 @@ Test::Main()
     TEST_DO(requireThatAdapterHandlesAllFieldTypes());
     TEST_DO(requireThatAdapterHandlesMultipleDocuments());
     TEST_DO(requireThatAdapterHandlesDocumentIdField());
+    TEST_DO(requireThatAdapterOnlyConvertsFieldsInOutputClass());
     TEST_DO(requireThatDocsumRequestIsProcessed());
+    TEST_DO(requireThatLargeDocsumRequestIsProcessedInParallel());
     TEST_DO(requireThatRewritersAreUsed());
     TEST_DO(requireThatAttributesAreUsed());
     TEST_DO(requireThatAnnotationsAreUsed());
@@ -188,6 +188,22 @@ struct VisitRecordingUnitDR : UnitDR {
     }
 };
 
+struct StoredSizeUnitDR : UnitDR {
+    size_t stored_size;
+
+    StoredSizeUnitDR(document::Document::UP d, Timestamp t, Bucket b, size_t storedSize)
+        : UnitDR(std::move(d), t, b, false),
+          stored_size(storedSize)
+    {
+    }
+
+    void visitDocuments(const LidVector &lids, search::IDocumentVisitor &visitor, ReadConsistency) const override {
+        for (uint32_t lid : lids) {
+            visitor.visit(lid, getFullDocument(lid), stored_size);
+        }
+    }
+};
+
 struct AttrUnitDR : public UnitDR
 {
     MockAttributeManager _amgr;
@@ -783,6 +799,26 @@ bool contains(const Container& c, const T& value) {
 }
 }
 
+TEST("require that stored document size is used when all fields are returned") {
+    DocumentIterator itr(bucket(5), std::make_shared<document::AllFields>(), selectAll(), docV(), -1, false);
+    itr.add(std::make_shared<StoredSizeUnitDR>(std::make_unique<Document>(*DataType::DOCUMENT, DocumentId("id:ns:document::1")),
+                                               Timestamp(2), bucket(5), 1000));
+    IterateResult res = itr.iterate(largeNum);
+    EXPECT_TRUE(res.isCompleted());
+    ASSERT_EQUAL(1u, res.getEntries().size());
+    EXPECT_EQUAL(1000u + getSize(), res.getEntries()[0]->getSize());
+}
+
+TEST("require that stored document size is ignored when fields are stripped") {
+    DocumentIterator itr(bucket(5), std::make_shared<document::DocIdOnly>(), selectAll(), docV(), -1, false);
+    itr.add(std::make_shared<StoredSizeUnitDR>(std::make_unique<Document>(*DataType::DOCUMENT, DocumentId("id:ns:document::1")),
+                                               Timestamp(2), bucket(5), 1000));
+    IterateResult res = itr.iterate(largeNum);
+    EXPECT_TRUE(res.isCompleted());
+    ASSERT_EQUAL(1u, res.getEntries().size());
+    EXPECT_EQUAL(getSize(Document(*DataType::DOCUMENT, DocumentId("id:ns:document::1"))), res.getEntries()[0]->getSize());
+}
+
 TEST("require that userdoc-constrained selections pre-filter on GIDs") {
     DocumentIterator itr(bucket(5), std::make_shared<document::AllFields>(), selectDocs("id.user=1234"), newestV(), -1, false);
     VisitRecordingUnitDR::VisitedLIDs visited_lids;
@@ -612,6 +612,48 @@ TEST_F("require that we can reconfigure matchers", Fixture)
     }
 }
 
+namespace {
+
+RankProfilesConfigBuilder::Rankprofile
+make_rank_profile(const vespalib::string &name, const vespalib::string &heap_size)
+{
+    RankProfilesConfigBuilder::Rankprofile profile;
+    profile.name = name;
+    RankProfilesConfigBuilder::Rankprofile::Fef::Property property;
+    property.name = "vespa.hitcollector.heapsize";
+    property.value = heap_size;
+    profile.fef.property.push_back(property);
+    return profile;
+}
+
+}
+
+TEST_F("require that matchers for unchanged rank profiles are reused", Fixture)
+{
+    RankProfilesConfigBuilder cfg;
+    cfg.rankprofile.push_back(make_rank_profile("default", "100"));
+    cfg.rankprofile.push_back(make_rank_profile("first", "200"));
+    cfg.rankprofile.push_back(make_rank_profile("second", "300"));
+    auto schema = std::make_shared<Schema>();
+    auto old_matchers = f._configurer->createMatchers(schema, cfg, OnnxModels());
+    cfg.rankprofile[1] = make_rank_profile("first", "250");
+    auto new_matchers = f._configurer->createMatchers(schema, cfg, OnnxModels(), old_matchers.get());
+    EXPECT_EQUAL(old_matchers->lookup("default").get(), new_matchers->lookup("default").get());
+    EXPECT_NOT_EQUAL(old_matchers->lookup("first").get(), new_matchers->lookup("first").get());
+    EXPECT_EQUAL(old_matchers->lookup("second").get(), new_matchers->lookup("second").get());
+    auto rebuilt_matchers = f._configurer->createMatchers(schema, cfg, OnnxModels());
+    EXPECT_NOT_EQUAL(new_matchers->lookup("default").get(), rebuilt_matchers->lookup("default").get());
+    EXPECT_NOT_EQUAL(new_matchers->lookup("second").get(), rebuilt_matchers->lookup("second").get());
+}
+
+TEST("require that unchanged matchers can only be reused when nothing but rank profiles changed")
+{
+    EXPECT_TRUE(ReconfigParams(CCR().setRankProfilesChanged(true)).canReuseUnchangedMatchers());
+    EXPECT_FALSE(ReconfigParams(CCR().setRankProfilesChanged(true).setRankingConstantsChanged(true)).canReuseUnchangedMatchers());
+    EXPECT_FALSE(ReconfigParams(CCR().setRankProfilesChanged(true).setOnnxModelsChanged(true)).canReuseUnchangedMatchers());
+    EXPECT_FALSE(ReconfigParams(CCR().setRankProfilesChanged(true).setSchemaChanged(true)).canReuseUnchangedMatchers());
+}
+
 TEST("require that attribute manager (imported attributes) should change when imported fields has changed")
 {
     ReconfigParams params(CCR().setImportedFieldsChanged(true));
@@ -276,7 +276,7 @@ TEST_F("require that we can move all documents", MoveFixture)
     f.moveDocuments(5);
     EXPECT_TRUE(f._mover.bucketDone());
     EXPECT_EQUAL(5u, f._handler._moves.size());
-    EXPECT_EQUAL(5u, f._limiter.beginOpCount);
+    EXPECT_EQUAL(1u, f._limiter.beginOpCount); // the moves are handled as one batch
     for (size_t i = 0; i < 5u; ++i) {
         assertEqual(f._source.bucket(1), f._source.docs(1)[0], 6, 9, f._handler._moves[0]);
     }
@@ -185,6 +185,8 @@ struct MyFeedView : public test::DummyFeedView {
     int prune_removed_count;
     int update_count;
     SerialNum update_serial;
+    DocumentUpdate::SP last_update;
+    bool attribute_only_updates;
     const DocumentType *documentType;
     MyFeedView(const std::shared_ptr<const DocumentTypeRepo> &dtr,
                const DocTypeName &docTypeName);
@@ -227,7 +229,9 @@ struct MyFeedView : public test::DummyFeedView {
         EXPECT_EQUAL(documentType, &op.getUpdate()->getType());
         ++update_count;
         update_serial = op.getSerialNum();
+        last_update = op.getUpdate();
     }
+    bool isAttributeOnlyUpdate(const UpdateOperation &) const override { return attribute_only_updates; }
     void handleRemove(FeedToken token, const RemoveOperation &) override {
         (void) token;
         ++remove_count;
@@ -260,6 +264,8 @@ MyFeedView::MyFeedView(const std::shared_ptr<const DocumentTypeRepo> &dtr, const
       prune_removed_count(0),
       update_count(0),
       update_serial(0),
+      last_update(),
+      attribute_only_updates(false),
       documentType(dtr->getDocumentType(docTypeName.getName()))
 {}
 MyFeedView::~MyFeedView() = default;
@@ -429,11 +435,16 @@ struct PutHandler {
 
 struct MyTlsWriter : TlsWriter {
     int store_count;
+    int store_batch_count;
     int erase_count;
     bool erase_return;
 
-    MyTlsWriter() : store_count(0), erase_count(0), erase_return(true) {}
+    MyTlsWriter() : store_count(0), store_batch_count(0), erase_count(0), erase_return(true) {}
     void storeOperation(const FeedOperation &, DoneCallback) override { ++store_count; }
+    void storeOperations(const std::vector<const FeedOperation *> &ops, DoneCallback) override {
+        ++store_batch_count;
+        store_count += ops.size();
+    }
     bool erase(SerialNum) override { ++erase_count; return erase_return; }
 
     SerialNum sync(SerialNum syncTo) override {
@@ -565,6 +576,21 @@ TEST_F("require that handleMove calls FeedView", FeedHandlerFixture)
     EXPECT_EQUAL(1, f.tls_writer.store_count);
 }
 
+TEST_F("require that handleMoveBatch calls FeedView and stores the moves as one commit", FeedHandlerFixture)
+{
+    DocumentContext doc_context1("id:ns:searchdocument::foo", *f.schema.builder);
+    DocumentContext doc_context2("id:ns:searchdocument::bar", *f.schema.builder);
+    MoveOperation op1(doc_context1.bucketId, Timestamp(2), doc_context1.doc, DbDocumentId(0, 2), 1);
+    op1.setDbDocumentId(DbDocumentId(1, 2));
+    MoveOperation op2(doc_context2.bucketId, Timestamp(3), doc_context2.doc, DbDocumentId(0, 3), 1);
+    op2.setDbDocumentId(DbDocumentId(1, 3));
+    f.runAsMaster([&]() { f.handler.handleMoveBatch({&op1, &op2}, IDestructorCallback::SP()); });
+    EXPECT_EQUAL(2, f.feedView.move_count);
+    EXPECT_EQUAL(2, f.tls_writer.store_count);
+    EXPECT_EQUAL(1, f.tls_writer.store_batch_count);
+    EXPECT_LESS(op1.getSerialNum(), op2.getSerialNum());
+}
+
 TEST_F("require that performPruneRemovedDocuments calls FeedView",
        FeedHandlerFixture)
 {
@@ -805,6 +831,55 @@ TEST_F("require that put with different document type repo is ok", FeedHandlerFi
     EXPECT_EQUAL(1, f.tls_writer.store_count);
 }
 
+void
+feedQueuedUpdates(FeedHandlerFixture &f, FeedTokenContext *tokens, uint32_t numUpdates)
+{
+    f.handler.changeToNormalFeedState();
+    f.handler.setMaxCoalescedUpdates(10);
+    f.handler.setSerialNum(15);
+    DocumentId docId("id:test:searchdocument::foo");
+    f.feedView.metaStore.insert(docId.getGlobalId(), MyDocumentMetaStore::Entry(5, 5, Timestamp(9)));
+    f.feedView.metaStore.allocate(docId.getGlobalId());
+    vespalib::Gate gate;
+    f.writeService.master().execute(makeLambdaTask([&gate]() { gate.await(); }));
+    for (uint32_t i = 0; i < numUpdates; ++i) {
+        UpdateContext updCtx(docId.toString(), *f.schema.builder);
+        updCtx.addFieldUpdate("i1");
+        auto op = std::make_unique<UpdateOperation>(updCtx.bucketId, Timestamp(10 + i), updCtx.update);
+        f.handler.handleOperation(std::move(tokens[i].token), std::move(op));
+    }
+    gate.countDown();
+    f.syncMaster();
+}
+
+TEST_F("require that queued attribute only updates to the same document are coalesced", FeedHandlerFixture)
+{
+    FeedTokenContext tokens[3];
+    f.feedView.attribute_only_updates = true;
+    feedQueuedUpdates(f, tokens, 3);
+    TEST_DO(f.feedView.checkCounts(1, 16u, 0, 0u));
+    EXPECT_EQUAL(1, f.tls_writer.store_count);
+    ASSERT_EQUAL(1u, f.feedView.last_update->getUpdates().size());
+    EXPECT_EQUAL(3u, f.feedView.last_update->getUpdates()[0].size());
+    for (uint32_t i = 0; i < 3; ++i) {
+        ASSERT_TRUE(tokens[i].await());
+        const auto *result = dynamic_cast<const UpdateResult *>(tokens[i].getResult());
+        ASSERT_TRUE(result != nullptr);
+        EXPECT_FALSE(result->hasError());
+        EXPECT_EQUAL(Timestamp(9 + i), result->getExistingTimestamp());
+        EXPECT_TRUE(tokens[i].transport.documentWasFound);
+    }
+}
+
+TEST_F("require that queued updates are not coalesced when not attribute only", FeedHandlerFixture)
+{
+    FeedTokenContext tokens[3];
+    feedQueuedUpdates(f, tokens, 3);
+    TEST_DO(f.feedView.checkCounts(3, 18u, 0, 0u));
+    EXPECT_EQUAL(3, f.tls_writer.store_count);
+    EXPECT_EQUAL(1u, f.feedView.last_update->getUpdates()[0].size());
+}
+
 }  // namespace
 
 TEST_MAIN()
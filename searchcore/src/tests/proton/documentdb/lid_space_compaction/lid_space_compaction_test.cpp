@@ -281,7 +281,8 @@ struct JobTestBase : public ::testing::Test {
               double resourceLimitFactor = RESOURCE_LIMIT_FACTOR,
               vespalib::duration interval = JOB_DELAY,
               bool nodeRetired = false,
-              uint32_t maxOutstandingMoveOps = MAX_OUTSTANDING_MOVE_OPS)
+              uint32_t maxOutstandingMoveOps = MAX_OUTSTANDING_MOVE_OPS,
+              uint32_t maxDocsToMovePerBatch = 1)
     {
         _handler = std::make_unique<MyHandler>(maxOutstandingMoveOps != MAX_OUTSTANDING_MOVE_OPS);
         _job = std::make_unique<LidSpaceCompactionJob>(DocumentDBLidSpaceCompactionConfig(interval, allowedLidBloat,
@@ -290,7 +291,8 @@ struct JobTestBase : public ::testing::Test {
                                                                                           REMOVE_BLOCK_RATE,
                                                                                           false, maxDocsToScan),
                                                        *_handler, _storer, _frozenHandler, _diskMemUsageNotifier,
-                                                       BlockableMaintenanceJobConfig(resourceLimitFactor, maxOutstandingMoveOps),
+                                                       BlockableMaintenanceJobConfig(resourceLimitFactor, maxOutstandingMoveOps,
+                                                                                     maxDocsToMovePerBatch),
                                                        _clusterStateHandler, nodeRetired);
     }
     ~JobTestBase() override;
@@ -386,8 +388,10 @@ struct JobTest : public JobTestBase {
               double resourceLimitFactor = RESOURCE_LIMIT_FACTOR,
               vespalib::duration interval = JOB_DELAY,
               bool nodeRetired = false,
-              uint32_t maxOutstandingMoveOps = MAX_OUTSTANDING_MOVE_OPS) {
-        JobTestBase::init(allowedLidBloat, allowedLidBloatFactor, maxDocsToScan, resourceLimitFactor, interval, nodeRetired, maxOutstandingMoveOps);
+              uint32_t maxOutstandingMoveOps = MAX_OUTSTANDING_MOVE_OPS,
+              uint32_t maxDocsToMovePerBatch = 1) {
+        JobTestBase::init(allowedLidBloat, allowedLidBloatFactor, maxDocsToScan, resourceLimitFactor, interval, nodeRetired,
+                          maxOutstandingMoveOps, maxDocsToMovePerBatch);
         _jobRunner = std::make_unique<MyDirectJobRunner>(*_job);
     }
     void init_with_interval(vespalib::duration interval) {
@@ -396,6 +400,10 @@ struct JobTest : public JobTestBase {
     void init_with_node_retired(bool retired) {
         init(ALLOWED_LID_BLOAT, ALLOWED_LID_BLOAT_FACTOR, MAX_DOCS_TO_SCAN, RESOURCE_LIMIT_FACTOR, JOB_DELAY, retired);
     }
+    void init_with_batch_size(uint32_t maxDocsToMovePerBatch) {
+        init(ALLOWED_LID_BLOAT, ALLOWED_LID_BLOAT_FACTOR, MAX_DOCS_TO_SCAN, RESOURCE_LIMIT_FACTOR, JOB_DELAY, false,
+             MAX_OUTSTANDING_MOVE_OPS, maxDocsToMovePerBatch);
+    }
 };
 
 struct HandlerTest : public ::testing::Test {
@@ -467,6 +475,18 @@ TEST_F(JobTest, job_returns_false_when_multiple_move_operations_or_compaction_ar
     assertJobContext(4, 7, 3, 7, 1);
 }
 
+TEST_F(JobTest, several_documents_are_moved_per_run_when_batching_is_enabled)
+{
+    init_with_batch_size(2);
+    setupThreeDocumentsToCompact();
+    EXPECT_FALSE(run());
+    assertJobContext(3, 8, 2, 0, 0);
+    EXPECT_FALSE(run()); // moves the last document and ends the scan
+    assertJobContext(4, 7, 3, 0, 0);
+    compact();
+    assertJobContext(4, 7, 3, 7, 1);
+}
+
 TEST_F(JobTest, job_is_blocked_if_trying_to_move_document_for_frozen_bucket)
 {
     _frozenHandler._bucket = BUCKET_ID_1;
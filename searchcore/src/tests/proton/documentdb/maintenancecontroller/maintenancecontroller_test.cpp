@@ -18,12 +18,14 @@
 #include <vespa/searchcore/proton/feedoperation/removeoperation.h>
 #include <vespa/searchcore/proton/server/blockable_maintenance_job.h>
 #include <vespa/searchcore/proton/server/executor_thread_service.h>
+#include <vespa/searchcore/proton/server/i_feed_backlog_sampler.h>
 #include <vespa/searchcore/proton/server/i_operation_storer.h>
 #include <vespa/searchcore/proton/server/ibucketmodifiedhandler.h>
 #include <vespa/searchcore/proton/server/idocumentmovehandler.h>
 #include <vespa/searchcore/proton/server/iheartbeathandler.h>
 #include <vespa/searchcore/proton/server/ipruneremoveddocumentshandler.h>
 #include <vespa/searchcore/proton/server/maintenance_controller_explorer.h>
+#include <vespa/searchcore/proton/server/maintenance_job_pacer.h>
 #include <vespa/searchcore/proton/server/maintenance_jobs_injector.h>
 #include <vespa/searchcore/proton/server/maintenancecontroller.h>
 #include <vespa/searchcore/proton/test/buckethandler.h>
@@ -1347,6 +1349,53 @@ TEST_F("require that delay for prune removed documents is set based on interval
     assertPruneRemovedDocumentsConfig(299s, 299s, 299s, f);
 }
 
+struct MyFeedBacklogSampler : public IFeedBacklogSampler {
+    size_t _backlog;
+    MyFeedBacklogSampler() : _backlog(0) {}
+    size_t sampleFeedBacklog() const override { return _backlog; }
+};
+
+struct MyHeartBeatLikeJob : public IMaintenanceJob {
+    MyHeartBeatLikeJob() : IMaintenanceJob("my_heart_beat", 1s, 1s) {}
+    bool run() override { return true; }
+};
+
+TEST("require that pacer defers deferrable jobs while feed backlog is above limit")
+{
+    MyFeedBacklogSampler sampler;
+    MaintenanceJobPacer pacer(sampler, MaintenanceJobPacingConfig(10, 2));
+    MySimpleJob job(1s, 1s, 0);
+    MyHeartBeatLikeJob heartBeat;
+    EXPECT_FALSE(pacer.shouldDefer(job, 0));
+    sampler._backlog = 10;
+    EXPECT_FALSE(pacer.shouldDefer(job, 0));
+    sampler._backlog = 11;
+    EXPECT_TRUE(pacer.shouldDefer(job, 0));
+    EXPECT_TRUE(pacer.shouldDefer(job, 1));
+    EXPECT_FALSE(pacer.shouldDefer(job, 2));
+    EXPECT_FALSE(pacer.shouldDefer(heartBeat, 0));
+}
+
+TEST("require that pacer is disabled by default")
+{
+    MyFeedBacklogSampler sampler;
+    sampler._backlog = 1000;
+    MaintenanceJobPacer pacer(sampler, MaintenanceJobPacingConfig());
+    MySimpleJob job(1s, 1s, 0);
+    EXPECT_FALSE(pacer.shouldDefer(job, 0));
+}
+
+TEST_F("require that resource consuming maintenance jobs are deferrable", MaintenanceControllerFixture)
+{
+    f.injectMaintenanceJobs();
+    auto jobs = f._mc.getJobList();
+    EXPECT_FALSE(findJob(jobs, "heart_beat")->getJob().isDeferrable());
+    EXPECT_FALSE(findJob(jobs, "prune_session_cache")->getJob().isDeferrable());
+    EXPECT_TRUE(findJob(jobs, "prune_removed_documents.searchdocument")->getJob().isDeferrable());
+    EXPECT_TRUE(findJob(jobs, "move_buckets.searchdocument")->getJob().isDeferrable());
+    EXPECT_TRUE(findJob(jobs, "sample_attribute_usage.searchdocument")->getJob().isDeferrable());
+}
+
 TEST_MAIN()
 {
     TEST_RUN_ALL();
@@ -759,6 +759,37 @@ TEST(DocumentMetaStoreTest, can_sort_gids)
     }
 }
 
+TEST(DocumentMetaStoreTest, gids_sharing_bucket_order_prefix_are_sorted_and_found)
+{
+    DocumentMetaStore dms(createBucketDB());
+    dms.constructFreeList();
+    // Gids only differing outside, or late inside, the bytes compared
+    // first in bucket order.
+    std::vector<GlobalId> gids;
+    for (uint32_t i = 0; i < 200; ++i) {
+        unsigned char raw[GlobalId::LENGTH] = { 0x12, 0x34, 0x56, 0x78, 0, 0, 0, 0, 0x9a, 0xbc, 0xde, 0xf0 };
+        raw[4 + (i % 4)] = i;
+        raw[11] = i % 3;
+        gids.emplace_back(raw);
+    }
+    std::sort(gids.begin(), gids.end());
+    gids.erase(std::unique(gids.begin(), gids.end()), gids.end());
+    for (const auto &gid : gids) {
+        addGid(dms, gid, Timestamp(1u));
+    }
+    std::vector<GlobalId> sorted;
+    for (DocumentMetaStore::ConstIterator it = dms.beginFrozen(); it.valid(); ++it) {
+        sorted.push_back(dms.getRawMetaData(it.getKey()).getGid());
+    }
+    ASSERT_EQ(gids.size(), sorted.size());
+    EXPECT_TRUE(std::is_sorted(sorted.begin(), sorted.end(), GlobalId::BucketOrderCmp()));
+    for (const auto &gid : gids) {
+        uint32_t lid = 0;
+        EXPECT_TRUE(dms.getLid(gid, lid));
+        EXPECT_EQ(gid, dms.getRawMetaData(lid).getGid());
+    }
+}
+
 template <typename ChecksumType>
 void
 requireThatBasicBucketInfoWorks()
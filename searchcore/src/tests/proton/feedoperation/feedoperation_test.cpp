@@ -271,13 +271,19 @@ TEST_F("require that we can serialize and deserialize put operations", Fixture)
         op.setDbDocumentId({1, 2});
         op.setPrevDbDocumentId({3, 4});
         EXPECT_EQUAL(0u, op.getSerializedDocSize());
+        EXPECT_TRUE(!op.getSerializedDocument());
         op.serialize(stream);
         EXPECT_EQUAL(expSerializedDocSize, op.getSerializedDocSize());
+        ASSERT_TRUE(op.getSerializedDocument());
+        vespalib::nbostream docStream(op.getSerializedDocument()->peek(), op.getSerializedDocument()->size());
+        EXPECT_EQUAL(expSerializedDocSize, docStream.size());
+        EXPECT_EQUAL(*doc, Document(*f._repo, docStream));
     }
     {
         PutOperation op;
         op.deserialize(stream, *f._repo);
         EXPECT_EQUAL(*doc, *op.getDocument());
+        EXPECT_TRUE(!op.getSerializedDocument());
         TEST_DO(assertDocumentOperation(op, bucket, expSerializedDocSize));
     }
 }
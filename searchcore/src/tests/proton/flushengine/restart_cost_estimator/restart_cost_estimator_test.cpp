@@ -0,0 +1,113 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#include <vespa/vespalib/testkit/testapp.h>
+
+#include <vespa/searchcore/proton/flushengine/restart_cost_estimator.h>
+#include <vespa/searchcore/proton/flushengine/tls_stats_map.h>
+#include <vespa/searchcore/proton/test/dummy_flush_handler.h>
+#include <vespa/searchcore/proton/test/dummy_flush_target.h>
+
+using namespace proton;
+using proton::flushengine::RestartCostEstimator;
+using proton::flushengine::TlsStats;
+using proton::flushengine::TlsStatsMap;
+using search::SerialNum;
+using searchcorespi::IFlushTarget;
+using Config = PrepareRestartFlushStrategy::Config;
+using std::chrono::seconds;
+
+struct SimpleFlushTarget : public test::DummyFlushTarget
+{
+    SerialNum flushedSerial;
+    SimpleFlushTarget(const vespalib::string &name, const Type &type, SerialNum flushedSerial_)
+        : test::DummyFlushTarget(name, type, Component::OTHER),
+          flushedSerial(flushedSerial_)
+    {}
+    SerialNum getFlushedSerialNum() const override { return flushedSerial; }
+};
+
+struct Fixture
+{
+    RestartCostEstimator estimator;
+    FlushContext::List targets;
+    TlsStatsMap::Map tlsStats;
+    std::map<vespalib::string, IFlushHandler::SP> handlers;
+
+    Fixture() : estimator(), targets(), tlsStats(), handlers() {}
+    Fixture &add(const vespalib::string &handlerName, const vespalib::string &targetName,
+                 SerialNum flushedSerial, IFlushTarget::Type type = IFlushTarget::Type::FLUSH) {
+        IFlushHandler::SP &handler = handlers[handlerName];
+        if (!handler) {
+            handler = std::make_shared<test::DummyFlushHandler>(handlerName);
+        }
+        targets.push_back(std::make_shared<FlushContext>(handler, std::make_shared<SimpleFlushTarget>(targetName, type, flushedSerial), 0));
+        return *this;
+    }
+    Fixture &tls(const vespalib::string &handlerName, uint64_t numBytes, SerialNum first, SerialNum last) {
+        tlsStats[handlerName] = TlsStats(numBytes, first, last);
+        return *this;
+    }
+    double predictReplaySeconds() const {
+        TlsStatsMap::Map map(tlsStats);
+        return vespalib::to_s(estimator.predictReplayTime(targets, TlsStatsMap(std::move(map))));
+    }
+};
+
+TEST_F("require that speeds are unknown until observed", Fixture)
+{
+    EXPECT_EQUAL(0.0, f.estimator.getWriteBytesPerSecond());
+    EXPECT_EQUAL(0.0, f.estimator.getReplayBytesPerSecond());
+    f.estimator.addFlushSample(0, seconds(1));
+    f.estimator.addReplaySample(1000, seconds(0));
+    EXPECT_EQUAL(0.0, f.estimator.getWriteBytesPerSecond());
+    EXPECT_EQUAL(0.0, f.estimator.getReplayBytesPerSecond());
+}
+
+TEST_F("require that speeds are moving averages of observed samples", Fixture)
+{
+    f.estimator.addFlushSample(4000, seconds(2));
+    EXPECT_EQUAL(2000.0, f.estimator.getWriteBytesPerSecond());
+    f.estimator.addFlushSample(12000, seconds(2));
+    EXPECT_APPROX(2800.0, f.estimator.getWriteBytesPerSecond(), 0.001);
+    f.estimator.addReplaySample(500, seconds(1));
+    EXPECT_EQUAL(500.0, f.estimator.getReplayBytesPerSecond());
+}
+
+TEST_F("require that config is unchanged until both speeds are observed", Fixture)
+{
+    Config cfg(2.0, 3.0, 4.0);
+    f.estimator.addFlushSample(1000, seconds(1));
+    Config adjusted = f.estimator.adjustConfig(cfg);
+    EXPECT_EQUAL(2.0, adjusted.tlsReplayByteCost);
+    EXPECT_EQUAL(3.0, adjusted.tlsReplayOperationCost);
+    EXPECT_EQUAL(4.0, adjusted.flushTargetWriteCost);
+}
+
+TEST_F("require that write cost is relative to observed replay speed", Fixture)
+{
+    Config cfg(2.0, 3.0, 4.0);
+    f.estimator.addFlushSample(10000, seconds(1));
+    f.estimator.addReplaySample(1000, seconds(1));
+    Config adjusted = f.estimator.adjustConfig(cfg);
+    EXPECT_EQUAL(2.0, adjusted.tlsReplayByteCost);
+    EXPECT_EQUAL(3.0, adjusted.tlsReplayOperationCost);
+    EXPECT_APPROX(0.2, adjusted.flushTargetWriteCost, 0.00001);
+}
+
+TEST_F("require that replay time is unknown until replay speed is observed", Fixture)
+{
+    f.add("handler1", "a", 10).tls("handler1", 1000, 1, 100);
+    EXPECT_EQUAL(0.0, f.predictReplaySeconds());
+}
+
+TEST_F("require that replay time is predicted from oldest flushed serial per handler", Fixture)
+{
+    f.estimator.addReplaySample(100, seconds(1));
+    f.add("handler1", "a", 50).add("handler1", "b", 90).add("handler1", "gc", 0, IFlushTarget::Type::GC)
+     .add("handler2", "c", 0)
+     .tls("handler1", 1000, 1, 100)
+     .tls("handler2", 300, 1, 30);
+    // handler1: 50 of 100 entries at 10 bytes each, handler2: all 300 bytes
+    EXPECT_APPROX(8.0, f.predictReplaySeconds(), 0.001);
+}
+
+TEST_MAIN() { TEST_RUN_ALL(); }
@@ -1,5 +1,6 @@
 // Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 #include <vespa/searchcore/proton/matchengine/matchengine.h>
+#include <vespa/searchcore/proton/matching/load_adapted_thread_bundle.h>
 #include <vespa/vespalib/data/slime/slime.h>
 #include <vespa/searchlib/engine/docsumreply.h>
 #include <vespa/vespalib/testkit/test_kit.h>
@@ -11,6 +12,7 @@ using namespace proton;
 using namespace search::engine;
 using namespace vespalib::slime;
 using vespalib::Slime;
+using namespace std::chrono_literals;
 
 class MySearchHandler : public ISearchHandler {
     size_t _numHits;
@@ -117,13 +119,15 @@ TEST("requireThatCorrectHandlerIsUsed")
 struct ObserveBundleMatchHandler : MySearchHandler {
     typedef std::shared_ptr<ObserveBundleMatchHandler> SP;
     mutable size_t bundleSize;
-    ObserveBundleMatchHandler() : bundleSize(0) {}
+    mutable size_t targetThreads;
+    ObserveBundleMatchHandler() : bundleSize(0), targetThreads(0) {}
 
     search::engine::SearchReply::UP match(
             const search::engine::SearchRequest &,
             vespalib::ThreadBundle &threadBundle) const override
     {
         bundleSize = threadBundle.size();
+        targetThreads = proton::matching::LoadAdaptedThreadBundle::targetThreads(threadBundle);
         return std::make_unique<SearchReply>();
     }
 };
@@ -145,6 +149,44 @@ TEST("requireThatBundlesAreUsed")
     EXPECT_EQUAL(5u, handler->bundleSize);
 }
 
+TEST("requireThatNumaAwareBundlesAreUsed")
+{
+    MatchEngine engine(15, 5, 7);
+    engine.enableNumaAwareThreadBundles({{0}});
+    EXPECT_EQUAL(1u, engine.getNumThreadBundlePools());
+    engine.enableNumaAwareThreadBundles({{0}, {0}});
+    EXPECT_EQUAL(2u, engine.getNumThreadBundlePools());
+    engine.setNodeUp(true);
+
+    auto handler = std::make_shared<ObserveBundleMatchHandler>();
+    engine.putSearchHandler(DocTypeName("foo"), handler);
+    for (size_t i = 0; i < 3; ++i) {
+        LocalSearchClient client;
+        engine.search(SearchRequest::Source(new SearchRequest()), client);
+        SearchReply::UP reply = client.getReply(10000);
+        ASSERT_TRUE(reply);
+        EXPECT_EQUAL(5u, handler->bundleSize);
+    }
+}
+
+TEST("requireThatAdaptiveBundlesUseAllThreadsWhenLoadIsLow")
+{
+    MatchEngine engine(15, 5, 7, true);
+    engine.setNodeUp(true);
+
+    auto handler = std::make_shared<ObserveBundleMatchHandler>();
+    DocTypeName dtnvfoo("foo");
+    engine.putSearchHandler(dtnvfoo, handler);
+
+    LocalSearchClient client;
+    SearchRequest::Source request(new SearchRequest());
+    engine.search(std::move(request), client);
+    SearchReply::UP reply = client.getReply(10000);
+    EXPECT_EQUAL(5u, handler->bundleSize);
+    EXPECT_EQUAL(5u, handler->targetThreads);
+    EXPECT_EQUAL(0u, engine.getNumActiveSearches());
+}
+
 TEST("requireThatHandlersCanBeRemoved")
 {
     MatchEngine engine(1, 1, 7);
@@ -195,4 +237,92 @@ TEST("requireThatStateIsReported")
             slime.toString());
 }
 
+SearchRequest::Source
+makeRequest(vespalib::duration timeout, const vespalib::string &priority = "")
+{
+    auto request = std::make_unique<SearchRequest>();
+    request->setTimeout(timeout);
+    if (!priority.empty()) {
+        request->propertiesMap.lookupCreate(search::MapNames::MODEL).add("vespa.admission.priority", priority);
+    }
+    return SearchRequest::Source(std::move(request));
+}
+
+TEST("requireThatAdmissionQueuePopsHighestPriorityFirst")
+{
+    LocalSearchClient client;
+    SearchAdmissionQueue queue(0.0);
+    queue.push(makeRequest(60s), client, 0);
+    queue.push(makeRequest(60s), client, 2);
+    queue.push(makeRequest(60s), client, 1);
+    queue.push(makeRequest(60s), client, 2);
+    EXPECT_EQUAL(4u, queue.size());
+    std::vector<uint32_t> priorities;
+    SearchAdmissionQueue::Decision decision;
+    while (auto entry = queue.pop(decision)) {
+        EXPECT_TRUE(decision == SearchAdmissionQueue::Decision::ADMIT);
+        priorities.push_back(entry->priority);
+    }
+    ASSERT_EQUAL(4u, priorities.size());
+    EXPECT_EQUAL(2u, priorities[0]);
+    EXPECT_EQUAL(2u, priorities[1]);
+    EXPECT_EQUAL(1u, priorities[2]);
+    EXPECT_EQUAL(0u, priorities[3]);
+    auto stats = queue.getStats();
+    EXPECT_EQUAL(4u, stats.admitted);
+    EXPECT_EQUAL(0u, stats.queued);
+}
+
+TEST("requireThatAdmissionQueueShedsExpiredAndTooExpensiveSearches")
+{
+    LocalSearchClient client;
+    SearchAdmissionQueue queue(1.0);
+    queue.reportSearchTime(1, 10s);
+    EXPECT_EQUAL(vespalib::duration(10s), queue.getExpectedSearchTime(1));
+    queue.push(makeRequest(0s), client, 0);
+    queue.push(makeRequest(5s), client, 1);
+    queue.push(makeRequest(5s), client, 0);
+    SearchAdmissionQueue::Decision decision;
+    EXPECT_TRUE(queue.pop(decision));
+    EXPECT_TRUE(decision == SearchAdmissionQueue::Decision::SHED_COST);
+    EXPECT_TRUE(queue.pop(decision));
+    EXPECT_TRUE(decision == SearchAdmissionQueue::Decision::SHED_EXPIRED);
+    EXPECT_TRUE(queue.pop(decision));
+    EXPECT_TRUE(decision == SearchAdmissionQueue::Decision::ADMIT);
+    EXPECT_FALSE(queue.pop(decision));
+    auto stats = queue.getStats();
+    EXPECT_EQUAL(1u, stats.admitted);
+    EXPECT_EQUAL(1u, stats.shedExpired);
+    EXPECT_EQUAL(1u, stats.shedCost);
+}
+
+TEST("requireThatSearchesAreAdmittedOrShedWhenAdmissionControlIsEnabled")
+{
+    MatchEngine engine(1, 1, 7);
+    engine.enableAdmissionControl(1.0);
+    engine.setNodeUp(true);
+    auto handler = std::make_shared<MySearchHandler>(3);
+    engine.putSearchHandler(DocTypeName("foo"), handler);
+    {
+        LocalSearchClient client;
+        engine.search(makeRequest(60s, "1"), client);
+        SearchReply::UP reply = client.getReply(10000);
+        ASSERT_TRUE(reply);
+        EXPECT_EQUAL(3u, reply->hits.size());
+    }
+    {
+        LocalSearchClient client;
+        engine.search(makeRequest(0s), client);
+        SearchReply::UP reply = client.getReply(10000);
+        ASSERT_TRUE(reply);
+        EXPECT_EQUAL(0u, reply->hits.size());
+        EXPECT_TRUE(reply->coverage.wasDegradedByTimeout());
+        EXPECT_EQUAL(7u, reply->getDistributionKey());
+    }
+    auto stats = engine.getAdmissionStats();
+    EXPECT_EQUAL(1u, stats.admitted);
+    EXPECT_EQUAL(1u, stats.shedExpired);
+    EXPECT_EQUAL(0u, engine.getNumActiveSearches());
+}
+
 TEST_MAIN() { TEST_RUN_ALL(); }
@@ -0,0 +1,120 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/searchcore/proton/matching/global_filter_cache.h>
+#include <vespa/searchlib/common/bitvector.h>
+#include <vespa/searchlib/engine/docsumreply.h>
+#include <vespa/searchlib/engine/docsumrequest.h>
+#include <vespa/searchlib/engine/searchreply.h>
+#include <vespa/searchlib/engine/searchrequest.h>
+#include <vespa/vespalib/testkit/test_kit.h>
+#include <vespa/vespalib/util/stringfmt.h>
+
+#include <vespa/log/log.h>
+LOG_SETUP("global_filter_cache_test");
+
+using namespace proton;
+using namespace proton::matching;
+using search::BitVector;
+using search::engine::DocsumReply;
+using search::engine::DocsumRequest;
+using search::engine::SearchReply;
+using search::engine::SearchRequest;
+using vespalib::steady_time;
+
+namespace {
+
+struct MySearchHandler : ISearchHandler {
+    DocsumReply::UP getDocsums(const DocsumRequest &) override {
+        return DocsumReply::UP();
+    }
+    SearchReply::UP match(const SearchRequest &, vespalib::ThreadBundle &) const override {
+        return SearchReply::UP();
+    }
+};
+
+GlobalFilterCache::BitVectorSP
+make_filter(uint32_t docid_limit) {
+    GlobalFilterCache::BitVectorSP filter(BitVector::create(docid_limit).release());
+    filter->setBit(docid_limit / 2);
+    filter->invalidateCachedCount();
+    return filter;
+}
+
+struct Fixture {
+    std::shared_ptr<const ISearchHandler> view;
+    GlobalFilterCache cache;
+    steady_time now;
+    vespalib::string key;
+    Fixture(size_t max_bytes = 1000000)
+        : view(std::make_shared<MySearchHandler>()),
+          cache(max_bytes, 1s),
+          now(vespalib::steady_clock::now()),
+          key(GlobalFilterCache::make_key("foo", ""))
+    {}
+};
+
+}
+
+TEST("require that key depends on query and location") {
+    vespalib::string key = GlobalFilterCache::make_key("foo", "");
+    EXPECT_EQUAL(key, GlobalFilterCache::make_key("foo", ""));
+    EXPECT_NOT_EQUAL(key, GlobalFilterCache::make_key("bar", ""));
+    EXPECT_NOT_EQUAL(key, GlobalFilterCache::make_key("foo", "(2,10,10,5,0,1,0)"));
+}
+
+TEST_F("require that cached filter is shared", Fixture) {
+    EXPECT_TRUE(f.cache.lookup(f.key, f.view, 1000, f.now).get() == nullptr);
+    auto filter = make_filter(1000);
+    f.cache.insert(f.key, f.view, 1000, f.now, filter);
+    EXPECT_EQUAL(filter.get(), f.cache.lookup(f.key, f.view, 1000, f.now + 500ms).get());
+    EXPECT_TRUE(f.cache.lookup(GlobalFilterCache::make_key("bar", ""), f.view, 1000, f.now).get() == nullptr);
+    auto stats = f.cache.get_stats();
+    EXPECT_EQUAL(1u, stats.numEntries);
+    EXPECT_EQUAL(1u, stats.numHits);
+    EXPECT_EQUAL(2u, stats.numMisses);
+    EXPECT_LESS_EQUAL(125u, stats.memoryUsage);
+}
+
+TEST_F("require that filter is not used with another docid limit", Fixture) {
+    f.cache.insert(f.key, f.view, 1000, f.now, make_filter(1000));
+    EXPECT_TRUE(f.cache.lookup(f.key, f.view, 1001, f.now).get() == nullptr);
+    auto filter = make_filter(1001);
+    f.cache.insert(f.key, f.view, 1001, f.now, filter);
+    EXPECT_EQUAL(filter.get(), f.cache.lookup(f.key, f.view, 1001, f.now).get());
+    EXPECT_EQUAL(1u, f.cache.get_stats().numEntries);
+}
+
+TEST_F("require that old filters are not used", Fixture) {
+    f.cache.insert(f.key, f.view, 1000, f.now, make_filter(1000));
+    EXPECT_TRUE(f.cache.lookup(f.key, f.view, 1000, f.now + 2s).get() == nullptr);
+}
+
+TEST_F("require that filters are dropped when search view changes", Fixture) {
+    f.cache.insert(f.key, f.view, 1000, f.now, make_filter(1000));
+    std::shared_ptr<const ISearchHandler> new_view = std::make_shared<MySearchHandler>();
+    EXPECT_TRUE(f.cache.lookup(f.key, new_view, 1000, f.now).get() == nullptr);
+    EXPECT_EQUAL(0u, f.cache.get_stats().numEntries);
+    EXPECT_TRUE(f.cache.lookup(f.key, f.view, 1000, f.now).get() == nullptr);
+}
+
+TEST_F("require that memory usage is bounded", Fixture(3000)) {
+    for (uint32_t i = 0; i < 10; ++i) {
+        f.cache.insert(GlobalFilterCache::make_key(vespalib::make_string("q%u", i), ""), f.view, 8000,
+                       f.now, make_filter(8000));
+        EXPECT_GREATER_EQUAL(3000u, f.cache.get_stats().memoryUsage);
+    }
+    EXPECT_LESS(0u, f.cache.get_stats().numEntries);
+    f.cache.insert(GlobalFilterCache::make_key("huge", ""), f.view, 100000, f.now, make_filter(100000));
+    EXPECT_TRUE(f.cache.lookup(GlobalFilterCache::make_key("huge", ""), f.view, 100000, f.now).get() == nullptr);
+}
+
+TEST_F("require that binding uses key, view and time of the query", Fixture) {
+    GlobalFilterCache::Binding binding(f.cache, f.key, f.view, f.now);
+    EXPECT_TRUE(binding.lookup(1000).get() == nullptr);
+    auto filter = make_filter(1000);
+    binding.insert(1000, filter);
+    EXPECT_EQUAL(filter.get(), f.cache.lookup(f.key, f.view, 1000, f.now).get());
+    EXPECT_EQUAL(filter.get(), binding.lookup(1000).get());
+}
+
+TEST_MAIN() { TEST_RUN_ALL(); }
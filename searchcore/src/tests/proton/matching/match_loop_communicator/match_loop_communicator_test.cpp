@@ -2,6 +2,8 @@
 #include <vespa/vespalib/testkit/test_kit.h>
 #include <vespa/searchcore/proton/matching/match_loop_communicator.h>
 #include <vespa/vespalib/util/box.h>
+#include <vespa/vespalib/util/clock.h>
+#include <vespa/vespalib/util/doom.h>
 
 using namespace proton::matching;
 
@@ -79,6 +81,38 @@ TEST_F("require that selectBest gives appropriate results for single thread with
     TEST_DO(equal(3u, make_box<Hit>({1, 5}, {3, 3}, {5, 1}), selectBest(f1, make_box<Hit>({1, 5}, {2, 4}, {3, 3}, {4, 2}, {5, 1}, {6, 0}))));
 }
 
+struct DoomFixture {
+    vespalib::Clock clock;
+    vespalib::Doom soft_doomed;
+    vespalib::Doom not_doomed;
+    DoomFixture()
+        : clock(),
+          soft_doomed(clock, vespalib::steady_time::min(), vespalib::steady_time::max(), false),
+          not_doomed(clock, vespalib::steady_time::max())
+    {}
+};
+
+TEST_FF("require that selectBest selects fewer hits when soft doomed",
+        DoomFixture(), MatchLoopCommunicator(num_threads, 3, std::unique_ptr<search::queryeval::IDiversifier>(),
+                                             &f1.soft_doomed, 1))
+{
+    TEST_DO(equal(1u, make_box<Hit>({1, 5}), selectBest(f2, make_box<Hit>({1, 5}, {2, 4}, {3, 3}))));
+}
+
+TEST_FF("require that selectBest selects all hits when not soft doomed",
+        DoomFixture(), MatchLoopCommunicator(num_threads, 3, std::unique_ptr<search::queryeval::IDiversifier>(),
+                                             &f1.not_doomed, 1))
+{
+    TEST_DO(equal(3u, make_box<Hit>({1, 5}, {2, 4}, {3, 3}), selectBest(f2, make_box<Hit>({1, 5}, {2, 4}, {3, 3}, {4, 2}))));
+}
+
+TEST_MT_FF("require that all threads agree on soft doomed selection", 5,
+           DoomFixture(), MatchLoopCommunicator(num_threads, 13, std::unique_ptr<search::queryeval::IDiversifier>(),
+                                                &f1.soft_doomed, 5))
+{
+    TEST_DO(equal(1u, makeScores(thread_id), selectBest(f2, makeScores(thread_id))));
+}
+
 TEST_MT_F("require that selectBest works with no hits", 10, MatchLoopCommunicator(num_threads, 10)) {
     EXPECT_TRUE(selectBest(f1, Box<Hit>()).empty());
 }
@@ -169,4 +203,18 @@ TEST_MT_F("require that count_matches will count hits and docs across threads",
     EXPECT_APPROX(freq, f1.estimate_match_frequency(Matches(thread_id, thread_id + 10)), 0.00001);
 }
 
+TEST_F("require that shared score threshold only increases", MatchLoopCommunicator(num_threads, 5)) {
+    EXPECT_EQUAL(-HUGE_VAL, f1.share_score_threshold(-HUGE_VAL));
+    EXPECT_EQUAL(2.0, f1.share_score_threshold(2.0));
+    EXPECT_EQUAL(2.0, f1.share_score_threshold(1.0));
+    EXPECT_EQUAL(3.0, f1.share_score_threshold(3.0));
+    EXPECT_EQUAL(3.0, f1.share_score_threshold(-HUGE_VAL));
+}
+
+TEST_MT_F("require that shared score threshold is the highest threshold from any thread", 10, MatchLoopCommunicator(num_threads, 5)) {
+    f1.share_score_threshold(double(thread_id));
+    TEST_BARRIER();
+    EXPECT_EQUAL(9.0, f1.share_score_threshold(-HUGE_VAL));
+}
+
 TEST_MAIN() { TEST_RUN_ALL(); }
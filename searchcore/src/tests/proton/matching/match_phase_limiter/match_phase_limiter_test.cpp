@@ -4,6 +4,8 @@
 #include <vespa/searchlib/queryeval/termasstring.h>
 #include <vespa/searchlib/queryeval/andsearchstrict.h>
 #include <vespa/searchlib/queryeval/fake_requestcontext.h>
+#include <vespa/searchlib/queryeval/leaf_blueprints.h>
+#include <vespa/searchlib/queryeval/simplesearch.h>
 #include <vespa/searchlib/fef/termfieldmatchdataarray.h>
 #include <vespa/searchlib/engine/trace.h>
 #include <vespa/vespalib/data/slime/slime.h>
@@ -14,6 +16,9 @@ using search::queryeval::SearchIterator;
 using search::queryeval::Searchable;
 using search::queryeval::Blueprint;
 using search::queryeval::SimpleLeafBlueprint;
+using search::queryeval::SimpleBlueprint;
+using search::queryeval::SimpleResult;
+using search::queryeval::SimpleSearch;
 using search::queryeval::FieldSpec;
 using search::queryeval::FieldSpecBaseList;
 using search::queryeval::AndSearchStrict;
@@ -88,6 +93,27 @@ struct MockSearchable : Searchable {
     }
 };
 
+// Searchable for an attribute where the value of each document is its docid
+struct OrderedSearchable : Searchable {
+    uint32_t num_docs;
+    size_t create_cnt = 0;
+    OrderedSearchable(uint32_t num_docs_in) : num_docs(num_docs_in) {}
+    Blueprint::UP createBlueprint(const search::queryeval::IRequestContext &,
+                                  const FieldSpec &,
+                                  const search::query::Node &term) override
+    {
+        ++create_cnt;
+        vespalib::string range = termAsString(term);
+        EXPECT_EQUAL("[;;-", range.substr(0, 4));
+        uint32_t limit = atoi(range.c_str() + 4);
+        SimpleResult result;
+        for (uint32_t docid = (limit < num_docs) ? (num_docs - limit + 1) : 1; docid <= num_docs; ++docid) {
+            result.addHit(docid);
+        }
+        return std::make_unique<SimpleBlueprint>(result);
+    }
+};
+
 //-----------------------------------------------------------------------------
 
 TEST("require that match phase limit calculator gives expert values") {
@@ -399,4 +425,48 @@ TEST("require that the match phase limiter can use strict diversity") {
     verifyDiversity(AttributeLimiter::STRICT);
 }
 
+TEST("require that the match phase limiter can evaluate the query in attribute order") {
+    FakeRequestContext requestContext;
+    OrderedSearchable searchable(1000);
+    MatchPhaseLimiter yes_limiter(1001, searchable, requestContext,
+                                  DegradationParams("limiter_attribute", 20, true, 1.0, 0.2, 1.0, true),
+                                  DiversityParams("", 1, 10.0, AttributeLimiter::LOOSE));
+    MaybeMatchPhaseLimiter &limiter = yes_limiter;
+    SimpleResult matching;
+    for (uint32_t docid = 10; docid <= 1000; docid += 10) {
+        matching.addHit(docid);
+    }
+    // too high hit rate estimate; the first 128 documents give only 13 hits
+    SearchIterator::UP search = limiter.maybe_limit(prepare(new SimpleSearch(matching)), 0.4, 1000, nullptr);
+    EXPECT_TRUE(limiter.was_limited());
+    EXPECT_EQUAL(2u, searchable.create_cnt);
+    SimpleResult expect;
+    for (uint32_t docid = 750; docid <= 1000; docid += 10) {
+        expect.addHit(docid);
+    }
+    EXPECT_EQUAL(expect, SimpleResult().searchStrict(*search, 1001));
+    limiter.updateDocIdSpaceEstimate(0, 1001);
+    EXPECT_EQUAL(256u, limiter.getDocIdSpaceEstimate());
+
+    // other threads share the hits found by the first one
+    SearchIterator::UP search2 = limiter.maybe_limit(prepare(new SimpleSearch(matching)), 0.4, 1000, nullptr);
+    EXPECT_EQUAL(2u, searchable.create_cnt);
+    EXPECT_EQUAL(expect, SimpleResult().searchStrict(*search2, 1001));
+}
+
+TEST("require that ordered evaluation stops when all documents with a value are evaluated") {
+    FakeRequestContext requestContext;
+    OrderedSearchable searchable(300);
+    MatchPhaseLimiter yes_limiter(1001, searchable, requestContext,
+                                  DegradationParams("limiter_attribute", 50, true, 1.0, 0.2, 1.0, true),
+                                  DiversityParams("", 1, 10.0, AttributeLimiter::LOOSE));
+    SimpleResult matching;
+    for (uint32_t docid = 100; docid <= 1000; docid += 100) {
+        matching.addHit(docid);
+    }
+    SearchIterator::UP search = yes_limiter.maybe_limit(prepare(new SimpleSearch(matching)), 0.4, 1000, nullptr);
+    EXPECT_EQUAL(3u, searchable.create_cnt);
+    EXPECT_EQUAL(SimpleResult().addHit(100).addHit(200).addHit(300), SimpleResult().searchStrict(*search, 1001));
+}
+
 TEST_MAIN() { TEST_RUN_ALL(); }
@@ -42,6 +42,16 @@ TEST("requireThatDocCountsAddUp") {
     EXPECT_EQUAL(2u, stats.limited_queries());
 }
 
+TEST("requireThatResultCacheCountsAddUp") {
+    MatchingStats stats;
+    EXPECT_EQUAL(0u, stats.resultCacheHits());
+    EXPECT_EQUAL(0u, stats.resultCacheMisses());
+    stats.add(MatchingStats().resultCacheHits(3).resultCacheMisses(1));
+    stats.add(MatchingStats().resultCacheHits(2).resultCacheMisses(4));
+    EXPECT_EQUAL(5u, stats.resultCacheHits());
+    EXPECT_EQUAL(5u, stats.resultCacheMisses());
+}
+
 TEST("requireThatAverageTimesAreRecorded") {
     MatchingStats stats;
     EXPECT_APPROX(0.0, stats.matchTimeAvg(), 0.00001);
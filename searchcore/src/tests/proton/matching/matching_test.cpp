@@ -313,6 +313,23 @@ struct MyWorld {
         return match_tools->match_data().get_termwise_limit();
     }
 
+    // whether the single query term needs normal features after setting up first and second phase
+    std::pair<bool, bool> get_term_needs_normal_features_per_phase() {
+        Matcher::SP matcher = createMatcher();
+        SearchRequest::SP request = createSimpleRequest("f1", "spread");
+        search::fef::Properties overrides;
+        MatchToolsFactory::UP match_tools_factory = matcher->create_match_tools_factory(
+                *request, searchContext, attributeContext, metaStore, overrides);
+        MatchTools::UP match_tools = match_tools_factory->createMatchTools();
+        std::pair<bool, bool> result;
+        match_tools->setup_first_phase();
+        ASSERT_EQUAL(1u, match_tools->match_data().getNumTermFields());
+        result.first = match_tools->match_data().resolveTermField(0)->needs_normal_features();
+        match_tools->setup_second_phase();
+        result.second = match_tools->match_data().resolveTermField(0)->needs_normal_features();
+        return result;
+    }
+
     SearchReply::UP performSearch(SearchRequest::SP req, size_t threads) {
         Matcher::SP matcher = createMatcher();
         SearchSession::OwnershipBundle owned_objects;
@@ -776,6 +793,55 @@ TEST("require that getSummaryFeatures prefers cached query setup") {
     ASSERT_EQUAL(2u, fs->numDocs());  // "foo" has two hits
 }
 
+TEST("require that summary features calculated by second phase ranking are captured in cached search session") {
+    MyWorld world;
+    world.basicSetup();
+    world.basicResults();
+    world.setupSecondPhaseRanking();
+    world.set_property(indexproperties::summary::Feature::NAME, "attribute(a2)");
+    SearchRequest::SP request = world.createSimpleRequest("f1", "foo");
+    request->propertiesMap.lookupCreate(search::MapNames::CACHES).add("query", "true");
+    request->sessionId.push_back('a');
+    world.performSearch(request, 1);
+
+    SearchSession::SP session = world.sessionManager->pickSearch("a");
+    ASSERT_TRUE(session.get());
+    const FeatureSet *captured = session->getSummaryFeatures();
+    ASSERT_TRUE(captured != nullptr);
+    ASSERT_EQUAL(1u, captured->numFeatures());
+    EXPECT_EQUAL("attribute(a2)", captured->getNames()[0]);
+    EXPECT_EQUAL(3u, captured->numDocs());
+
+    DocsumRequest::SP docsum_request = MyWorld::create_docsum_request("", {10, 30});
+    docsum_request->sessionId = request->sessionId;
+    docsum_request->propertiesMap.lookupCreate(search::MapNames::CACHES).add("query", "true");
+    FeatureSet::SP fs = world.getSummaryFeatures(docsum_request);
+    ASSERT_EQUAL(1u, fs->numFeatures());
+    EXPECT_EQUAL("attribute(a2)", fs->getNames()[0]);
+    ASSERT_EQUAL(2u, fs->numDocs());
+    const auto *f = fs->getFeaturesByDocId(10);
+    ASSERT_TRUE(f);
+    EXPECT_EQUAL(20, f[0].as_double());
+    f = fs->getFeaturesByDocId(30);
+    ASSERT_TRUE(f);
+    EXPECT_EQUAL(60, f[0].as_double());
+}
+
+TEST("require that summary features are not captured when not calculated by second phase ranking") {
+    MyWorld world;
+    world.basicSetup();
+    world.basicResults();
+    world.setupSecondPhaseRanking();
+    SearchRequest::SP request = world.createSimpleRequest("f1", "foo");
+    request->propertiesMap.lookupCreate(search::MapNames::CACHES).add("query", "true");
+    request->sessionId.push_back('a');
+    world.performSearch(request, 1);
+
+    SearchSession::SP session = world.sessionManager->pickSearch("a");
+    ASSERT_TRUE(session.get());
+    EXPECT_TRUE(session->getSummaryFeatures() == nullptr);
+}
+
 TEST("require that match params are set up straight with ranking on") {
     MatchParams p(1, 2, 4, 0.7, 0, 1, true, true);
     ASSERT_EQUAL(1u, p.numDocs);
@@ -890,6 +956,27 @@ TEST("require that termwise limit is set correctly for first phase ranking progr
     EXPECT_EQUAL(0.02, world.get_first_phase_termwise_limit());
 }
 
+TEST("require that positional data only used by second phase ranking is not unpacked during first phase") {
+    MyWorld world;
+    world.basicSetup();
+    world.basicResults();
+    world.set_property(indexproperties::rank::SecondPhase::NAME, "fieldTermMatch(f1,0).firstPosition");
+    auto needs = world.get_term_needs_normal_features_per_phase();
+    EXPECT_FALSE(needs.first);
+    EXPECT_TRUE(needs.second);
+}
+
+TEST("require that positional data used by first phase ranking is unpacked in both phases") {
+    MyWorld world;
+    world.basicSetup();
+    world.basicResults();
+    world.set_property(indexproperties::rank::FirstPhase::NAME, "fieldTermMatch(f1,0).firstPosition");
+    world.set_property(indexproperties::rank::SecondPhase::NAME, "attribute(a2)");
+    auto needs = world.get_term_needs_normal_features_per_phase();
+    EXPECT_TRUE(needs.first);
+    EXPECT_TRUE(needs.second);
+}
+
 TEST("require that fields are tagged with data type") {
     MyWorld world;
     world.basicSetup();
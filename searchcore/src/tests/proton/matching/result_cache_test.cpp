@@ -0,0 +1,147 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/searchcore/proton/matching/result_cache.h>
+#include <vespa/searchlib/engine/docsumreply.h>
+#include <vespa/searchlib/engine/searchreply.h>
+#include <vespa/searchlib/engine/searchrequest.h>
+#include <vespa/vespalib/testkit/test_kit.h>
+
+#include <vespa/log/log.h>
+LOG_SETUP("result_cache_test");
+
+using namespace proton;
+using namespace proton::matching;
+using search::engine::DocsumReply;
+using search::engine::DocsumRequest;
+using search::engine::SearchReply;
+using search::engine::SearchRequest;
+using vespalib::steady_time;
+
+namespace {
+
+struct MySearchHandler : ISearchHandler {
+    DocsumReply::UP getDocsums(const DocsumRequest &) override {
+        return DocsumReply::UP();
+    }
+    SearchReply::UP match(const SearchRequest &, vespalib::ThreadBundle &) const override {
+        return SearchReply::UP();
+    }
+};
+
+std::unique_ptr<SearchRequest>
+make_request(const vespalib::string &query) {
+    auto request = std::make_unique<SearchRequest>();
+    request->ranking = "default";
+    request->stackDump.assign(query.begin(), query.end());
+    request->offset = 0;
+    request->maxhits = 10;
+    return request;
+}
+
+SearchReply
+make_reply(uint32_t num_hits) {
+    SearchReply reply;
+    reply.totalHitCount = num_hits;
+    reply.hits.resize(num_hits);
+    for (uint32_t i = 0; i < num_hits; ++i) {
+        reply.hits[i].metric = i;
+    }
+    return reply;
+}
+
+struct Fixture {
+    std::shared_ptr<const ISearchHandler> view;
+    ResultCache cache;
+    steady_time now;
+    Fixture(size_t max_bytes = 1000000)
+        : view(std::make_shared<MySearchHandler>()),
+          cache(max_bytes, 1s),
+          now(vespalib::steady_clock::now())
+    {}
+};
+
+}
+
+TEST("require that key depends on query, window and properties") {
+    auto a = make_request("foo");
+    auto b = make_request("bar");
+    vespalib::string key_a = ResultCache::make_key(*a);
+    EXPECT_FALSE(key_a.empty());
+    EXPECT_NOT_EQUAL(key_a, ResultCache::make_key(*b));
+    EXPECT_EQUAL(key_a, ResultCache::make_key(*make_request("foo")));
+    a->offset = 10;
+    EXPECT_NOT_EQUAL(key_a, ResultCache::make_key(*a));
+    a->offset = 0;
+    a->propertiesMap.lookupCreate(search::MapNames::RANK).add("foo", "1");
+    vespalib::string key_props = ResultCache::make_key(*a);
+    EXPECT_NOT_EQUAL(key_a, key_props);
+    a->propertiesMap.lookupCreate(search::MapNames::RANK).add("bar", "2");
+    auto c = make_request("foo");
+    c->propertiesMap.lookupCreate(search::MapNames::RANK).add("bar", "2");
+    c->propertiesMap.lookupCreate(search::MapNames::RANK).add("foo", "1");
+    EXPECT_EQUAL(ResultCache::make_key(*a), ResultCache::make_key(*c));
+}
+
+TEST("require that grouping, cached sessions and tracing are not cached") {
+    auto request = make_request("foo");
+    request->groupSpec.push_back('x');
+    EXPECT_TRUE(ResultCache::make_key(*request).empty());
+    request = make_request("foo");
+    request->propertiesMap.lookupCreate(search::MapNames::CACHES).add("query", "true");
+    EXPECT_TRUE(ResultCache::make_key(*request).empty());
+    request = make_request("foo");
+    request->setTraceLevel(1);
+    EXPECT_TRUE(ResultCache::make_key(*request).empty());
+}
+
+TEST_F("require that cached reply is returned", Fixture) {
+    vespalib::string key = ResultCache::make_key(*make_request("foo"));
+    EXPECT_TRUE(f1.cache.lookup(key, f1.view, f1.now).get() == nullptr);
+    f1.cache.insert(key, f1.view, f1.now, make_reply(3));
+    auto reply = f1.cache.lookup(key, f1.view, f1.now);
+    ASSERT_TRUE(reply.get() != nullptr);
+    EXPECT_EQUAL(3u, reply->totalHitCount);
+    EXPECT_EQUAL(3u, reply->hits.size());
+    EXPECT_EQUAL(2.0, reply->hits[2].metric);
+    EXPECT_EQUAL(1u, f1.cache.get_stats().numEntries);
+}
+
+TEST_F("require that cache is invalidated when search view changes", Fixture) {
+    vespalib::string key = ResultCache::make_key(*make_request("foo"));
+    f1.cache.insert(key, f1.view, f1.now, make_reply(3));
+    std::shared_ptr<const ISearchHandler> new_view = std::make_shared<MySearchHandler>();
+    EXPECT_TRUE(f1.cache.lookup(key, new_view, f1.now).get() == nullptr);
+    EXPECT_EQUAL(0u, f1.cache.get_stats().numEntries);
+    EXPECT_EQUAL(0u, f1.cache.get_stats().memoryUsage);
+    EXPECT_EQUAL(1u, f1.cache.get_stats().numInvalidations);
+    EXPECT_TRUE(f1.cache.lookup(key, f1.view, f1.now).get() == nullptr);
+}
+
+TEST_F("require that old entries are not returned", Fixture) {
+    vespalib::string key = ResultCache::make_key(*make_request("foo"));
+    f1.cache.insert(key, f1.view, f1.now, make_reply(3));
+    EXPECT_TRUE(f1.cache.lookup(key, f1.view, f1.now + 500ms).get() != nullptr);
+    EXPECT_TRUE(f1.cache.lookup(key, f1.view, f1.now + 2s).get() == nullptr);
+    EXPECT_EQUAL(0u, f1.cache.get_stats().numEntries);
+}
+
+TEST_F("require that cache is bounded by memory", Fixture(ResultCache::estimate_bytes(vespalib::string(), make_reply(10)) * 3)) {
+    std::vector<vespalib::string> keys;
+    for (const char *query : {"a", "b", "c", "d"}) {
+        keys.push_back(ResultCache::make_key(*make_request(query)));
+        f1.cache.insert(keys.back(), f1.view, f1.now, make_reply(10));
+    }
+    auto stats = f1.cache.get_stats();
+    EXPECT_LESS(stats.numEntries, 4u);
+    EXPECT_LESS_EQUAL(stats.memoryUsage, ResultCache::estimate_bytes(vespalib::string(), make_reply(10)) * 3);
+    EXPECT_TRUE(f1.cache.lookup(keys[0], f1.view, f1.now).get() == nullptr);
+    EXPECT_TRUE(f1.cache.lookup(keys[3], f1.view, f1.now).get() != nullptr);
+}
+
+TEST_F("require that too large replies are not cached", Fixture(100)) {
+    vespalib::string key = ResultCache::make_key(*make_request("foo"));
+    f1.cache.insert(key, f1.view, f1.now, make_reply(100));
+    EXPECT_EQUAL(0u, f1.cache.get_stats().numEntries);
+}
+
+TEST_MAIN() { TEST_RUN_ALL(); }
@@ -289,6 +289,23 @@ TEST_FF("require that documentdb config manager builds schema with imported attr
     }
 }
 
+TEST_FF("require that documentdb config manager reuses unchanged sub configs",
+        ConfigTestFixture("search"),
+        DocumentDBConfigManager(f1.configId + "/typea", "typea"))
+{
+    f1.addDocType("typea");
+    auto config1 = getDocumentDBConfig(f1, f2);
+    auto config2 = getDocumentDBConfig(f1, f2);
+    EXPECT_TRUE(config1.get() != config2.get());
+    EXPECT_EQUAL(config1->getAttributesConfigSP().get(), config2->getAttributesConfigSP().get());
+    EXPECT_EQUAL(config1->getSummaryConfigSP().get(), config2->getSummaryConfigSP().get());
+    EXPECT_EQUAL(config1->getSummarymapConfigSP().get(), config2->getSummarymapConfigSP().get());
+    EXPECT_EQUAL(config1->getJuniperrcConfigSP().get(), config2->getJuniperrcConfigSP().get());
+    EXPECT_EQUAL(config1->getImportedFieldsConfigSP().get(), config2->getImportedFieldsConfigSP().get());
+    EXPECT_EQUAL(config1->getSchemaSP().get(), config2->getSchemaSP().get());
+    EXPECT_TRUE(*config1 == *config2);
+}
+
 TEST_FFF("require that proton config fetcher follows changes to bootstrap",
          ConfigTestFixture("search"),
          ProtonConfigOwner(),
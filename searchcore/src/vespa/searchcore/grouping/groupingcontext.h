@@ -73,6 +73,7 @@ public:
      * @return a list of groupings.
      **/
     GroupingList &getGroupingList() { return _groupingList; }
+    const GroupingList &getGroupingList() const { return _groupingList; }
 
     /**
      * Serialize the grouping expressions in this context.
@@ -62,6 +62,18 @@ GroupingManager::init(const IAttributeContext &attrCtx)
     std::swap(list, groupingList);
 }
 
+bool
+GroupingManager::needRelevanceOrder() const
+{
+    const GroupingContext::GroupingList &groupingList(_groupingContext.getGroupingList());
+    for (const auto &grouping : groupingList) {
+        if ( ! grouping->needResort() ) {
+            return true;
+        }
+    }
+    return false;
+}
+
 void
 GroupingManager::groupInRelevanceOrder(const RankedHit *searchResults, uint32_t binSize)
 {
@@ -50,6 +50,12 @@ public:
      **/
     void init(const attribute::IAttributeContext &attrCtx);
 
+    /**
+     * @return true if any grouping must see the results in relevance
+     *         order (see groupInRelevanceOrder).
+     **/
+    bool needRelevanceOrder() const;
+
     /**
      * Perform actual grouping on the given results.
      * The results must be in relevance sort order.
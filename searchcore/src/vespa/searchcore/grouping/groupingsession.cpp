@@ -3,6 +3,9 @@
 #include "groupingsession.h"
 #include "groupingmanager.h"
 #include "groupingcontext.h"
+#include <vespa/searchlib/aggregation/grouping.h>
+#include <vespa/vespalib/objects/nboserializer.h>
+#include <algorithm>
 
 #include <vespa/log/log.h>
 LOG_SETUP(".groupingsession");
@@ -16,11 +19,14 @@ using search::attribute::IAttributeContext;
 
 GroupingSession::GroupingSession(const SessionId &sessionId,
                                  GroupingContext & groupingContext,
-                                 const IAttributeContext &attrCtx)
+                                 const IAttributeContext &attrCtx,
+                                 const std::shared_ptr<const void> &owner)
     : _sessionId(sessionId),
       _mgrContext(std::make_unique<GroupingContext>(groupingContext)),
       _groupingManager(std::make_unique<GroupingManager>(*_mgrContext)),
-      _timeOfDoom(groupingContext.getTimeOfDoom())
+      _timeOfDoom(groupingContext.getTimeOfDoom()),
+      _keepResults(bool(owner)),
+      _owner(owner)
 {
     init(groupingContext, attrCtx);
 }
@@ -84,17 +90,83 @@ GroupingSession::continueExecution(GroupingContext & groupingContext)
         Grouping &origGrouping(*groupingPtr);
         auto found = _groupingMap.find(origGrouping.getId());
         if (found != _groupingMap.end()) {
-            Grouping &cachedGrouping(*found->second);
-            cachedGrouping.prune(origGrouping);
-            origGrouping.mergePartial(cachedGrouping);
-            // No use in keeping it for the next round
-            if (origGrouping.getLastLevel() == cachedGrouping.getLastLevel()) {
-                _groupingMap.erase(origGrouping.getId());
+            if (_keepResults) {
+                // Prune a copy to keep all groups for later passes
+                Grouping cachedGrouping(*found->second);
+                cachedGrouping.prune(origGrouping);
+                origGrouping.mergePartial(cachedGrouping);
+            } else {
+                Grouping &cachedGrouping(*found->second);
+                cachedGrouping.prune(origGrouping);
+                origGrouping.mergePartial(cachedGrouping);
+                // No use in keeping it for the next round
+                if (origGrouping.getLastLevel() == cachedGrouping.getLastLevel()) {
+                    _groupingMap.erase(origGrouping.getId());
+                }
             }
         }
         LOG(debug, "Continue execution result: %s", origGrouping.asString().c_str());
     }
+    if (_keepResults) {
+        _timeOfDoom = std::max(_timeOfDoom, groupingContext.getTimeOfDoom());
+    }
     groupingContext.serialize();
 }
 
+namespace {
+
+bool
+isCoveredBy(int64_t requested, int64_t collected)
+{
+    return (collected < 0) || ((requested >= 0) && (requested <= collected));
+}
+
+}
+
+bool
+GroupingSession::canContinue(GroupingContext & groupingContext, const std::shared_ptr<const void> &owner) const
+{
+    if (!_keepResults) {
+        return true;
+    }
+    if (_owner.lock() != owner) {
+        return false;
+    }
+    for (const auto & groupingPtr : groupingContext.getGroupingList()) {
+        const Grouping &origGrouping(*groupingPtr);
+        auto found = _groupingMap.find(origGrouping.getId());
+        if (found == _groupingMap.end()) {
+            return false;
+        }
+        // kept groupings are merged into the request one level at a time
+        const Grouping &cachedGrouping(*found->second);
+        if ((origGrouping.getFirstLevel() != origGrouping.getLastLevel()) ||
+            (origGrouping.getLevels().size() != cachedGrouping.getLevels().size()) ||
+            !isCoveredBy(origGrouping.getTopN(), cachedGrouping.getTopN()))
+        {
+            return false;
+        }
+        for (size_t i = 0; i < origGrouping.getLevels().size(); ++i) {
+            if (!isCoveredBy(origGrouping.getLevels()[i].getMaxGroups(),
+                             cachedGrouping.getLevels()[i].getMaxGroups()))
+            {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+size_t
+GroupingSession::getMemoryUsage() const
+{
+    vespalib::nbostream os;
+    vespalib::NBOSerializer nos(os);
+    for (const auto & entry : _groupingMap) {
+        entry.second->serialize(nos);
+    }
+    return sizeof(GroupingSession) + _sessionId.size() + os.size() +
+        _groupingMap.size() * (sizeof(GroupingMap::value_type) + sizeof(Grouping));
+}
+
 }
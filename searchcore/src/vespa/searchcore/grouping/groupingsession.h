@@ -31,6 +31,8 @@ private:
     std::unique_ptr<GroupingManager> _groupingManager;
     GroupingMap                      _groupingMap;
     vespalib::steady_time            _timeOfDoom;
+    bool                             _keepResults;
+    std::weak_ptr<const void>        _owner;
 
 public:
     typedef std::unique_ptr<GroupingSession> UP;
@@ -41,10 +43,15 @@ public:
      * @param sessionId The session id of this session.
      * @param groupingContext grouping context.
      * @param attrCtx attribute context.
+     * @param owner if set, the results of all levels are kept after
+     *        they have been delivered, so that later passes (like
+     *        continuation pages) can be served by this session as long
+     *        as they are done against the same owner (search view).
      **/
     GroupingSession(const SessionId & sessionId,
                     GroupingContext & groupingContext,
-                    const attribute::IAttributeContext &attrCtx);
+                    const attribute::IAttributeContext &attrCtx,
+                    const std::shared_ptr<const void> &owner = std::shared_ptr<const void>());
     GroupingSession(const GroupingSession &) = delete;
     GroupingSession &operator=(const GroupingSession &) = delete;
 
@@ -100,11 +107,30 @@ public:
      **/
     void continueExecution(GroupingContext & context);
 
+    /**
+     * Checks whether the pass described by the given context can be
+     * served by this session. Sessions not keeping their results can
+     * serve any pass. Sessions keeping their results can only serve
+     * single level passes of groupings collected by the first pass,
+     * against the same owner and not asking for more groups than what
+     * was collected.
+     *
+     * @param context The grouping context of the pass.
+     * @param owner The owner (search view) used by the pass.
+     **/
+    bool canContinue(GroupingContext & context, const std::shared_ptr<const void> &owner) const;
+
     /**
      * Checks whether or not the session is finished.
      **/
     bool finished() const { return _groupingMap.empty(); }
 
+    /**
+     * Estimate of the memory used by the cached groupings of this
+     * session.
+     **/
+    size_t getMemoryUsage() const;
+
     /**
      * Get this sessions timeout.
      */
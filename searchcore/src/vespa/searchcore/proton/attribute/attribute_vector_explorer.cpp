@@ -85,6 +85,10 @@ convertMultiValueToSlime(const MultiValueMappingBase &multiValue, Cursor &object
 {
     object.setLong("totalValueCnt", multiValue.getTotalValueCnt());
     convertMemoryUsageToSlime(multiValue.getMemoryUsage(), object.setObject("memoryUsage"));
+    Cursor &compaction = object.setObject("compaction");
+    compaction.setBool("inProgress", multiValue.compactionInProgress());
+    compaction.setLong("nextDocId", multiValue.getCompactNextDocId());
+    compaction.setLong("docIdLimit", multiValue.size());
 }
 
 void
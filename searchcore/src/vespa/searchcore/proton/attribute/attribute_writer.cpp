@@ -17,6 +17,7 @@
 #include <vespa/vespalib/stllike/hash_map.hpp>
 #include <vespa/vespalib/util/threadexecutor.h>
 #include <future>
+#include <mutex>
 
 #include <vespa/log/log.h>
 LOG_SETUP(".proton.attribute.attribute_writer");
@@ -313,6 +314,9 @@ public:
     PutTask(const AttributeWriter::WriteContext &wc, SerialNum serialNum, std::shared_ptr<DocumentFieldExtractor> fieldExtractor, uint32_t lid, bool immediateCommit, bool allAttributes, AttributeWriter::OnWriteDoneType onWriteDone);
     ~PutTask() override;
     void run() override;
+    void apply(bool immediateCommit);
+    SerialNum getSerialNum() const { return _serialNum; }
+    bool getImmediateCommit() const { return _immediateCommit; }
 };
 
 PutTask::PutTask(const AttributeWriter::WriteContext &wc, SerialNum serialNum, std::shared_ptr<DocumentFieldExtractor> fieldExtractor, uint32_t lid, bool immediateCommit, bool allAttributes, AttributeWriter::OnWriteDoneType onWriteDone)
@@ -339,6 +343,12 @@ PutTask::~PutTask() = default;
 
 void
 PutTask::run()
+{
+    apply(_immediateCommit);
+}
+
+void
+PutTask::apply(bool immediateCommit)
 {
     uint32_t fieldId = 0;
     const auto &fields = _wc.getFields();
@@ -346,7 +356,7 @@ PutTask::run()
         if (_allAttributes || field.isStructFieldAttribute()) {
             AttributeVector &attr = field.getAttribute();
             if (attr.getStatus().getLastSyncToken() < _serialNum) {
-                applyPutToAttribute(_serialNum, _fieldValues[fieldId], _lid, _immediateCommit, attr, _onWriteDone);
+                applyPutToAttribute(_serialNum, _fieldValues[fieldId], _lid, immediateCommit, attr, _onWriteDone);
             }
             ++fieldId;
         }
@@ -447,6 +457,80 @@ CompletePutTask::run()
     }
 }
 
+}
+
+/*
+ * Put tasks for a write context that are waiting for the same task in
+ * the attribute field writer. Puts arriving while the task is queued
+ * join the batch, so under load the attributes are written in tight
+ * loops with one commit per batch instead of one task and one commit
+ * per document.
+ */
+class AttributeWriter::PutBatch
+{
+    std::mutex _lock;
+    std::vector<std::unique_ptr<PutTask>> _tasks;
+    bool _drained;
+public:
+    PutBatch() : _lock(), _tasks(), _drained(false) {}
+    bool add(std::unique_ptr<PutTask> &task) {
+        std::lock_guard guard(_lock);
+        if (_drained) {
+            return false;
+        }
+        _tasks.emplace_back(std::move(task));
+        return true;
+    }
+    std::vector<std::unique_ptr<PutTask>> drain() {
+        std::lock_guard guard(_lock);
+        _drained = true;
+        return std::move(_tasks);
+    }
+};
+
+namespace {
+
+class PutBatchTask : public vespalib::Executor::Task
+{
+    const AttributeWriter::WriteContext &_wc;
+    std::shared_ptr<AttributeWriter::PutBatch> _batch;
+public:
+    PutBatchTask(const AttributeWriter::WriteContext &wc, std::shared_ptr<AttributeWriter::PutBatch> batch)
+        : _wc(wc),
+          _batch(std::move(batch))
+    {}
+    ~PutBatchTask() override;
+    void run() override;
+};
+
+PutBatchTask::~PutBatchTask() = default;
+
+void
+PutBatchTask::run()
+{
+    auto tasks = _batch->drain();
+    if (tasks.size() == 1) {
+        tasks.front()->run();
+        return;
+    }
+    bool immediateCommit = false;
+    SerialNum serialNum = 0;
+    for (auto &task : tasks) {
+        task->apply(false);
+        immediateCommit = immediateCommit || task->getImmediateCommit();
+        serialNum = std::max(serialNum, task->getSerialNum());
+    }
+    if (immediateCommit) {
+        for (const auto &field : _wc.getFields()) {
+            AttributeVector &attr = field.getAttribute();
+            if (attr.getStatus().getLastSyncToken() < serialNum) {
+                attr.commit(serialNum, serialNum);
+            }
+        }
+    }
+    // The done callbacks of the puts are released when the tasks are destroyed
+}
+
 class RemoveTask : public vespalib::Executor::Task
 {
     const AttributeWriter::WriteContext  &_wc;
@@ -614,16 +698,30 @@ AttributeWriter::internalPut(SerialNum serialNum, const Document &doc, DocumentI
             if (allAttributes || wc.hasStructFieldAttribute()) {
                 auto putTask = std::make_unique<PutTask>(wc, serialNum, extractor, lid, immediateCommit, allAttributes,
                                                          onWriteDone);
-                _attributeFieldWriter.executeTask(wc.getExecutorId(), std::move(putTask));
+                auto &batch = _putBatches[&wc - &_writeContexts[0]];
+                if (!batch || !batch->add(putTask)) {
+                    batch = std::make_shared<PutBatch>();
+                    batch->add(putTask);
+                    _attributeFieldWriter.executeTask(wc.getExecutorId(), std::make_unique<PutBatchTask>(wc, batch));
+                }
             }
         }
     }
 }
 
+void
+AttributeWriter::closePutBatches()
+{
+    for (auto &batch : _putBatches) {
+        batch.reset();
+    }
+}
+
 void
 AttributeWriter::internalRemove(SerialNum serialNum, DocumentIdT lid, bool immediateCommit,
                                 OnWriteDoneType onWriteDone)
 {
+    closePutBatches();
     for (const auto &wc : _writeContexts) {
         auto removeTask = std::make_unique<RemoveTask>(wc, serialNum, lid, immediateCommit, onWriteDone);
         _attributeFieldWriter.executeTask(wc.getExecutorId(), std::move(removeTask));
@@ -637,10 +735,12 @@ AttributeWriter::AttributeWriter(proton::IAttributeManager::SP mgr)
       _writeContexts(),
       _dataType(nullptr),
       _hasStructFieldAttribute(false),
-      _attrMap()
+      _attrMap(),
+      _putBatches()
 {
     setupWriteContexts();
     setupAttriuteMapping();
+    _putBatches.resize(_writeContexts.size());
 }
 
 void AttributeWriter::setupAttriuteMapping() {
@@ -698,6 +798,7 @@ void
 AttributeWriter::remove(const LidVector &lidsToRemove, SerialNum serialNum,
                         bool immediateCommit, OnWriteDoneType onWriteDone)
 {
+    closePutBatches();
     for (const auto &writeCtx : _writeContexts) {
         auto removeTask = std::make_unique<BatchRemoveTask>(writeCtx, serialNum, lidsToRemove, immediateCommit, onWriteDone);
         _attributeFieldWriter.executeTask(writeCtx.getExecutorId(), std::move(removeTask));
@@ -709,6 +810,7 @@ AttributeWriter::update(SerialNum serialNum, const DocumentUpdate &upd, Document
                         bool immediateCommit, OnWriteDoneType onWriteDone, IFieldUpdateCallback & onUpdate)
 {
     LOG(debug, "Inspecting update for document %d.", lid);
+    closePutBatches();
     std::vector<std::unique_ptr<BatchUpdateTask>> args;
     uint32_t numExecutors = _attributeFieldWriter.getNumExecutors();
     args.reserve(numExecutors);
@@ -747,6 +849,7 @@ AttributeWriter::update(SerialNum serialNum, const DocumentUpdate &upd, Document
 void
 AttributeWriter::heartBeat(SerialNum serialNum)
 {
+    closePutBatches();
     for (auto entry : _attrMap) {
         _attributeFieldWriter.execute(entry.second.second,
                                       [serialNum, attr=entry.second.first]()
@@ -765,6 +868,7 @@ AttributeWriter::forceCommit(SerialNum serialNum, OnWriteDoneType onWriteDone)
             attr->clearSearchCache();
         }
     }
+    closePutBatches();
     for (const auto &wc : _writeContexts) {
         auto commitTask = std::make_unique<CommitTask>(wc, serialNum, onWriteDone);
         _attributeFieldWriter.executeTask(wc.getExecutorId(), std::move(commitTask));
@@ -775,6 +879,7 @@ AttributeWriter::forceCommit(SerialNum serialNum, OnWriteDoneType onWriteDone)
 void
 AttributeWriter::onReplayDone(uint32_t docIdLimit)
 {
+    closePutBatches();
     for (auto entry : _attrMap) {
         _attributeFieldWriter.execute(entry.second.second,
                                       [docIdLimit, attr = entry.second.first]()
@@ -787,6 +892,7 @@ AttributeWriter::onReplayDone(uint32_t docIdLimit)
 void
 AttributeWriter::compactLidSpace(uint32_t wantedLidLimit, SerialNum serialNum)
 {
+    closePutBatches();
     for (auto entry : _attrMap) {
         _attributeFieldWriter.
             execute(entry.second.second,
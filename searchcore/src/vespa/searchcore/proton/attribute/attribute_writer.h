@@ -67,6 +67,7 @@ public:
         bool hasStructFieldAttribute() const { return _hasStructFieldAttribute; }
         bool use_two_phase_put() const { return _use_two_phase_put; }
     };
+    class PutBatch;
 private:
     using AttrWithId = std::pair<search::AttributeVector *, ExecutorId>;
     using AttrMap = vespalib::hash_map<vespalib::string, AttrWithId>;
@@ -74,6 +75,8 @@ private:
     const DataType           *_dataType;
     bool                      _hasStructFieldAttribute;
     AttrMap                   _attrMap;
+    // Open put batch per write context, closed before any other operation is scheduled
+    std::vector<std::shared_ptr<PutBatch>> _putBatches;
 
     void setupWriteContexts();
     void setupAttriuteMapping();
@@ -82,6 +85,7 @@ private:
                      bool immediateCommit, bool allAttributes, OnWriteDoneType onWriteDone);
     void internalRemove(SerialNum serialNum, DocumentIdT lid,
                         bool immediateCommit, OnWriteDoneType onWriteDone);
+    void closePutBatches();
 
 public:
     AttributeWriter(proton::IAttributeManager::SP mgr);
@@ -3,7 +3,6 @@
 #include "bucketstate.h"
 #include "checksumaggregators.h"
 #include <cassert>
-#include <xxhash.h>
 
 namespace proton::bucketdb {
 
@@ -18,11 +17,6 @@ toIdx(SubDbType subDbType) {
 
 BucketState::ChecksumType  BucketState::_checksumType = BucketState::ChecksumType::LEGACY;
 
-std::unique_ptr<ChecksumAggregator>
-BucketState::createChecksum(BucketChecksum seed) {
-    return ChecksumAggregator::create(_checksumType, seed);
-}
-
 void
 BucketState::setChecksumType(ChecksumType type) {
     _checksumType = type;
@@ -36,7 +30,7 @@ BucketState & BucketState::operator=(BucketState && rhs) noexcept = default;
 BucketState::BucketState()
     : _docCount(),
       _docSizes(),
-      _checksum(createChecksum(BucketChecksum(0))),
+      _checksum(0),
       _active(false)
 {
     for (uint32_t i = 0; i < COUNTS; ++i) {
@@ -47,7 +41,39 @@ BucketState::BucketState()
 
 BucketState::BucketChecksum
 BucketState::addChecksum(BucketChecksum a, BucketChecksum b) {
-    return createChecksum(a)->addChecksum(*createChecksum(b)).getChecksum();
+    if (_checksumType == ChecksumType::LEGACY) {
+        return BucketChecksum(uint32_t(a) + uint32_t(b));
+    }
+    return BucketChecksum(uint32_t(a) ^ uint32_t(b));
+}
+
+void
+BucketState::addDoc(const GlobalId &gid, const Timestamp &timestamp)
+{
+    if (_checksumType == ChecksumType::LEGACY) {
+        _checksum = LegacyChecksumAggregator::addDoc(gid, timestamp, _checksum);
+    } else {
+        _checksum = XXH64ChecksumAggregator::update(gid, timestamp, _checksum);
+    }
+}
+
+void
+BucketState::removeDoc(const GlobalId &gid, const Timestamp &timestamp)
+{
+    if (_checksumType == ChecksumType::LEGACY) {
+        _checksum = LegacyChecksumAggregator::removeDoc(gid, timestamp, _checksum);
+    } else {
+        _checksum = XXH64ChecksumAggregator::update(gid, timestamp, _checksum);
+    }
+}
+
+BucketState::BucketChecksum
+BucketState::getChecksum() const
+{
+    if (_checksumType == ChecksumType::LEGACY) {
+        return BucketChecksum(_checksum);
+    }
+    return XXH64ChecksumAggregator::get(_checksum);
 }
 
 void
@@ -55,7 +81,7 @@ BucketState::add(const GlobalId &gid, const Timestamp &timestamp, uint32_t docSi
 {
     assert(subDbType < SubDbType::COUNT);
     if (subDbType != SubDbType::REMOVED) {
-        _checksum->addDoc(gid, timestamp);
+        addDoc(gid, timestamp);
     }
     uint32_t subDbTypeIdx = toIdx(subDbType);
     ++_docCount[subDbTypeIdx];
@@ -70,7 +96,7 @@ BucketState::remove(const GlobalId &gid, const Timestamp &timestamp, uint32_t do
     assert(_docCount[subDbTypeIdx] > 0);
     assert(_docSizes[subDbTypeIdx] >= docSize);
     if (subDbType != SubDbType::REMOVED) {
-        _checksum->removeDoc(gid, timestamp);
+        removeDoc(gid, timestamp);
     }
     --_docCount[subDbTypeIdx];
     _docSizes[subDbTypeIdx] -= docSize;
@@ -87,8 +113,8 @@ BucketState::modify(const GlobalId &gid,
     assert(_docCount[subDbTypeIdx] > 0);
     assert(_docSizes[subDbTypeIdx] >= oldDocSize);
     if (subDbType != SubDbType::REMOVED) {
-        _checksum->removeDoc(gid, oldTimestamp);
-        _checksum->addDoc(gid, newTimestamp);
+        removeDoc(gid, oldTimestamp);
+        addDoc(gid, newTimestamp);
     }
     _docSizes[subDbTypeIdx] = _docSizes[subDbTypeIdx] + newDocSize - oldDocSize;
 }
@@ -99,7 +125,7 @@ BucketState::empty() const
     if (getReadyCount() != 0 || getRemovedCount() != 0 ||
         getNotReadyCount() != 0)
         return false;
-    assert(_checksum->empty());
+    assert(_checksum == 0);
     for (uint32_t i = 0; i < COUNTS; ++i) {
         assert(_docSizes[i] == 0);
     }
@@ -115,7 +141,11 @@ BucketState::operator+=(const BucketState &rhs)
     for (uint32_t i = 0; i < COUNTS; ++i) {
         _docSizes[i] += rhs._docSizes[i];
     }
-    _checksum->addChecksum(*rhs._checksum);
+    if (_checksumType == ChecksumType::LEGACY) {
+        _checksum = uint32_t(_checksum + rhs._checksum);
+    } else {
+        _checksum ^= rhs._checksum;
+    }
     return *this;
 }
 
@@ -134,7 +164,11 @@ BucketState::operator-=(const BucketState &rhs)
     for (uint32_t i = 0; i < COUNTS; ++i) {
         _docSizes[i] -= rhs._docSizes[i];
     }
-    _checksum->removeChecksum(*rhs._checksum);
+    if (_checksumType == ChecksumType::LEGACY) {
+        _checksum = uint32_t(_checksum - rhs._checksum);
+    } else {
+        _checksum ^= rhs._checksum;
+    }
     return *this;
 }
 
@@ -4,14 +4,15 @@
 
 #include "checksumaggregator.h"
 #include <vespa/searchcore/proton/common/subdbtype.h>
-#include <vespa/vespalib/util/memory.h>
 
 namespace proton::bucketdb {
 
-class ChecksumAggregator;
-
 /**
  * Class BucketState represent the known state of a bucket in raw form.
+ *
+ * The checksum is aggregated in place, with the checksum type selected
+ * for the process, so that bucket states are plain values that are
+ * cheap to copy and to combine during bucket splits and joins.
  */
 class BucketState
 {
@@ -28,11 +29,12 @@ private:
     static constexpr uint32_t COUNTS = static_cast<uint32_t>(SubDbType::COUNT);
     uint32_t _docCount[COUNTS];
     size_t   _docSizes[COUNTS];
-    vespalib::CloneablePtr<ChecksumAggregator>  _checksum;
+    uint64_t _checksum;
     bool     _active;
 
     static ChecksumType _checksumType;
-    static std::unique_ptr<ChecksumAggregator> createChecksum(BucketChecksum seed);
+    void addDoc(const GlobalId &gid, const Timestamp &timestamp);
+    void removeDoc(const GlobalId &gid, const Timestamp &timestamp);
 
 public:
     static void setChecksumType(ChecksumType checksum);
@@ -67,7 +69,7 @@ public:
     size_t getNotReadyDocSizes() const { return _docSizes[NOTREADY]; }
     uint32_t getDocumentCount() const { return getReadyCount() + getNotReadyCount(); }
     uint32_t getEntryCount() const { return getDocumentCount() + getRemovedCount(); }
-    BucketChecksum getChecksum() const { return _checksum->getChecksum(); }
+    BucketChecksum getChecksum() const;
     bool empty() const;
     BucketState &operator+=(const BucketState &rhs);
     BucketState &operator-=(const BucketState &rhs);
@@ -41,12 +41,12 @@ LegacyChecksumAggregator::clone() const {
 }
 LegacyChecksumAggregator &
 LegacyChecksumAggregator::addDoc(const GlobalId &gid, const Timestamp &timestamp) {
-    _checksum += calcChecksum(gid, timestamp);
+    _checksum = addDoc(gid, timestamp, _checksum);
     return *this;
 }
 LegacyChecksumAggregator &
 LegacyChecksumAggregator::removeDoc(const GlobalId &gid, const Timestamp &timestamp) {
-    _checksum -= calcChecksum(gid, timestamp);
+    _checksum = removeDoc(gid, timestamp, _checksum);
     return *this;
 }
 LegacyChecksumAggregator &
@@ -65,6 +65,14 @@ LegacyChecksumAggregator::getChecksum() const {
 }
 bool
 LegacyChecksumAggregator::empty() const { return _checksum == 0; }
+uint32_t
+LegacyChecksumAggregator::addDoc(const GlobalId &gid, const Timestamp &timestamp, uint32_t checksum) {
+    return checksum + calcChecksum(gid, timestamp);
+}
+uint32_t
+LegacyChecksumAggregator::removeDoc(const GlobalId &gid, const Timestamp &timestamp, uint32_t checksum) {
+    return checksum - calcChecksum(gid, timestamp);
+}
 
 
 
@@ -74,12 +82,12 @@ XXH64ChecksumAggregator::clone() const {
 }
 XXH64ChecksumAggregator &
 XXH64ChecksumAggregator::addDoc(const GlobalId &gid, const Timestamp &timestamp) {
-    _checksum ^= compute(gid, timestamp);
+    _checksum = update(gid, timestamp, _checksum);
     return *this;
 }
 XXH64ChecksumAggregator &
 XXH64ChecksumAggregator::removeDoc(const GlobalId &gid, const Timestamp &timestamp) {
-    _checksum ^= compute(gid, timestamp);
+    _checksum = update(gid, timestamp, _checksum);
     return *this;
 }
 XXH64ChecksumAggregator &
@@ -94,7 +102,7 @@ XXH64ChecksumAggregator::removeChecksum(const ChecksumAggregator & rhs) {
 }
 BucketChecksum
 XXH64ChecksumAggregator::getChecksum() const {
-    return BucketChecksum((_checksum >> 32) ^ (_checksum & 0xffffffffL));
+    return get(_checksum);
 }
 bool
 XXH64ChecksumAggregator::empty() const { return _checksum == 0; }
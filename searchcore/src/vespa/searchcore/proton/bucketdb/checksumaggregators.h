@@ -17,6 +17,8 @@ public:
     LegacyChecksumAggregator & removeChecksum(const ChecksumAggregator & rhs) override;
     BucketChecksum getChecksum() const override;
     bool empty() const override;
+    static uint32_t addDoc(const GlobalId &gid, const Timestamp &timestamp, uint32_t checksum);
+    static uint32_t removeDoc(const GlobalId &gid, const Timestamp &timestamp, uint32_t checksum);
 private:
     uint32_t _checksum;
 };
@@ -34,6 +36,12 @@ public:
     XXH64ChecksumAggregator & removeChecksum(const ChecksumAggregator & rhs) override;
     BucketChecksum getChecksum() const override;
     bool empty() const override;
+    static uint64_t update(const GlobalId &gid, const Timestamp &timestamp, uint64_t checksum) {
+        return checksum ^ compute(gid, timestamp);
+    }
+    static BucketChecksum get(uint64_t checksum) {
+        return BucketChecksum((checksum >> 32) ^ (checksum & 0xffffffffL));
+    }
 private:
     static uint64_t compute(const GlobalId &gid, const Timestamp &timestamp);
     uint64_t _checksum;
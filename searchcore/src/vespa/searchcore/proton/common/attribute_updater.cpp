@@ -17,6 +17,7 @@
 #include <vespa/document/update/tensor_add_update.h>
 #include <vespa/document/update/tensor_modify_update.h>
 #include <vespa/document/update/tensor_remove_update.h>
+#include <vespa/eval/tensor/cell_values.h>
 #include <vespa/eval/tensor/tensor.h>
 #include <vespa/searchlib/attribute/attributevector.hpp>
 #include <vespa/searchlib/attribute/changevector.hpp>
@@ -224,6 +225,22 @@ applyTensorUpdate(TensorAttribute &vec, uint32_t lid, const TensorUpdateType &up
     }
 }
 
+/*
+ * Lets the attribute modify the cells of the existing tensor directly,
+ * avoiding building a new tensor for the document.
+ */
+bool
+modifyTensorCells(TensorAttribute &vec, uint32_t lid, const TensorModifyUpdate &update)
+{
+    const auto &cellsTensor = update.getTensor().getAsTensorPtr();
+    if (!cellsTensor) {
+        return false;
+    }
+    // Cells tensor being sparse was validated during deserialize().
+    vespalib::tensor::CellValues cellValues(static_cast<const vespalib::tensor::SparseTensor &>(*cellsTensor));
+    return vec.modify_tensor(lid, TensorModifyUpdate::getJoinFunction(update.getOperation()), cellValues);
+}
+
 }
 
 template <>
@@ -240,7 +257,10 @@ AttributeUpdater::handleUpdate(TensorAttribute &vec, uint32_t lid, const ValueUp
             updateValue(vec, lid, assign.getValue());
         }
     } else if (op == ValueUpdate::TensorModifyUpdate) {
-        applyTensorUpdate(vec, lid, static_cast<const TensorModifyUpdate &>(upd), false);
+        const auto &modify = static_cast<const TensorModifyUpdate &>(upd);
+        if (!modifyTensorCells(vec, lid, modify)) {
+            applyTensorUpdate(vec, lid, modify, false);
+        }
     } else if (op == ValueUpdate::TensorAddUpdate) {
         applyTensorUpdate(vec, lid, static_cast<const TensorAddUpdate &>(upd), true);
     } else if (op == ValueUpdate::TensorRemoveUpdate) {
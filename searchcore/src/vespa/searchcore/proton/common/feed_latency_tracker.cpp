@@ -0,0 +1,101 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "feed_latency_tracker.h"
+
+namespace proton {
+
+namespace {
+
+bool reached(vespalib::steady_time time) {
+    return time != vespalib::steady_time();
+}
+
+double
+stage_latency(vespalib::steady_time start, vespalib::steady_time end)
+{
+    if (!reached(start) || !reached(end)) {
+        return 0.0;
+    }
+    return vespalib::to_s(end - start);
+}
+
+void
+add_stage_latency(FeedLatencyTracker::Latency &latency, vespalib::steady_time start, vespalib::steady_time end)
+{
+    if (reached(start) && reached(end)) {
+        latency.add(vespalib::to_s(end - start));
+    }
+}
+
+}
+
+FeedStageTimes::FeedStageTimes()
+    : received(),
+      started(),
+      logged(),
+      applied(),
+      acked(),
+      opType(0)
+{
+}
+
+FeedLatencyTracker::Stats::Stats()
+    : queue(),
+      log(),
+      apply(),
+      total()
+{
+}
+
+FeedLatencyTracker::FeedLatencyTracker(vespalib::duration slowLimit, size_t maxSlowOperations)
+    : _lock(),
+      _stats(),
+      _slowLimit(slowLimit),
+      _maxSlowOperations(maxSlowOperations),
+      _slowOperations()
+{
+}
+
+FeedLatencyTracker::~FeedLatencyTracker() = default;
+
+void
+FeedLatencyTracker::report(const FeedStageTimes &times)
+{
+    if (!reached(times.started)) {
+        return; // Not handled by the document db (e.g. rejected)
+    }
+    bool slow = (_maxSlowOperations > 0) && ((times.acked - times.received) >= _slowLimit);
+    std::lock_guard guard(_lock);
+    add_stage_latency(_stats.queue, times.received, times.started);
+    add_stage_latency(_stats.log, times.started, times.logged);
+    add_stage_latency(_stats.apply, times.started, times.applied);
+    add_stage_latency(_stats.total, times.received, times.acked);
+    if (slow) {
+        if (_slowOperations.size() >= _maxSlowOperations) {
+            _slowOperations.pop_front();
+        }
+        _slowOperations.push_back({vespalib::to_utc(times.acked), times.opType,
+                                   stage_latency(times.received, times.started),
+                                   stage_latency(times.started, times.logged),
+                                   stage_latency(times.started, times.applied),
+                                   stage_latency(times.received, times.acked)});
+    }
+}
+
+FeedLatencyTracker::Stats
+FeedLatencyTracker::sampleStats()
+{
+    Stats result;
+    std::lock_guard guard(_lock);
+    std::swap(result, _stats);
+    return result;
+}
+
+std::vector<FeedLatencyTracker::SlowOperation>
+FeedLatencyTracker::getSlowOperations() const
+{
+    std::lock_guard guard(_lock);
+    return {_slowOperations.begin(), _slowOperations.end()};
+}
+
+}
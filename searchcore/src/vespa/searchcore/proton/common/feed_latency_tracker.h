@@ -0,0 +1,77 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <vespa/vespalib/util/executor_stats.h>
+#include <vespa/vespalib/util/time.h>
+#include <deque>
+#include <mutex>
+#include <vector>
+
+namespace proton {
+
+/**
+ * Timestamps of the stages a feed operation passes through in a document db.
+ * Stages not reached by the operation (e.g. an ignored put is never logged)
+ * have a default constructed timestamp.
+ */
+struct FeedStageTimes {
+    vespalib::steady_time received; // feed token created
+    vespalib::steady_time started;  // master write thread started handling the operation
+    vespalib::steady_time logged;   // operation committed to the transaction log
+    vespalib::steady_time applied;  // operation applied to document store, attributes and index
+    vespalib::steady_time acked;    // reply sent
+    uint32_t              opType;   // FeedOperation::Type
+
+    FeedStageTimes();
+};
+
+/**
+ * Aggregates the latency of the stages of feed operations in a document db,
+ * and keeps the stage breakdown of the most recent slow operations.
+ *
+ * Latencies are in seconds. The queue stage is the time waiting for the
+ * master write thread. The log and apply stages run concurrently, and are
+ * both measured from when the master write thread started handling the
+ * operation.
+ */
+class FeedLatencyTracker {
+public:
+    using Latency = vespalib::AggregatedAverage<double>;
+    struct Stats {
+        Latency queue;
+        Latency log;
+        Latency apply;
+        Latency total;
+        Stats();
+    };
+    struct SlowOperation {
+        vespalib::system_time acked;
+        uint32_t              opType;
+        double                queue;
+        double                log;
+        double                apply;
+        double                total;
+    };
+
+private:
+    mutable std::mutex        _lock;
+    Stats                     _stats;
+    const vespalib::duration  _slowLimit;
+    const size_t              _maxSlowOperations;
+    std::deque<SlowOperation> _slowOperations;
+
+public:
+    FeedLatencyTracker(vespalib::duration slowLimit, size_t maxSlowOperations);
+    ~FeedLatencyTracker();
+
+    void report(const FeedStageTimes &times);
+
+    /**
+     * Returns the stats aggregated since the previous call.
+     */
+    Stats sampleStats();
+    std::vector<SlowOperation> getSlowOperations() const;
+};
+
+}
@@ -9,8 +9,11 @@ State::State(ITransport & transport) :
     _transport(transport),
     _result(std::make_unique<storage::spi::Result>()),
     _documentWasFound(false),
-    _alreadySent(false)
+    _alreadySent(false),
+    _times(),
+    _latencyTracker()
 {
+    _times.received = vespalib::steady_clock::now();
 }
 
 State::~State()
@@ -23,10 +26,22 @@ State::ack()
 {
     bool alreadySent = _alreadySent.exchange(true);
     if ( !alreadySent ) {
+        if (_latencyTracker) {
+            _times.acked = vespalib::steady_clock::now();
+            _latencyTracker->report(_times);
+        }
         _transport.send(std::move(_result), _documentWasFound);
     }
 }
 
+void
+State::trackLatency(std::shared_ptr<FeedLatencyTracker> tracker, uint32_t opType)
+{
+    _latencyTracker = std::move(tracker);
+    _times.started = vespalib::steady_clock::now();
+    _times.opType = opType;
+}
+
 void
 State::setResult(ResultUP result, bool documentWasFound) {
     _documentWasFound = documentWasFound;
@@ -1,8 +1,10 @@
 // Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 #pragma once
 
+#include "feed_latency_tracker.h"
 #include <vespa/searchlib/common/idestructorcallback.h>
 #include <atomic>
+#include <memory>
 
 namespace storage::spi { class Result; }
 namespace proton {
@@ -35,13 +37,30 @@ public:
     void fail();
     void setResult(ResultUP result, bool documentWasFound);
     const storage::spi::Result &getResult() { return *_result; }
+
+    /**
+     * Start tracking the stage latencies of this operation, which is
+     * reported to the given tracker when the operation is acked.
+     * Called when the master write thread starts handling the operation.
+     */
+    void trackLatency(std::shared_ptr<FeedLatencyTracker> tracker, uint32_t opType);
+    void markLogged() { markStage(_times.logged); }
+    void markApplied() { markStage(_times.applied); }
 protected:
     void ack();
 private:
+    void markStage(vespalib::steady_time &stage) {
+        if (_latencyTracker) {
+            stage = vespalib::steady_clock::now();
+        }
+    }
+
     ITransport           &_transport;
     ResultUP              _result;
     bool                  _documentWasFound;
     std::atomic<bool>     _alreadySent;
+    FeedStageTimes        _times;
+    std::shared_ptr<FeedLatencyTracker> _latencyTracker;
 };
 
 /**
@@ -0,0 +1,132 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "hw_counter_sampler.h"
+#include <vespa/vespalib/util/time.h>
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+
+#include <vespa/log/log.h>
+LOG_SETUP(".proton.common.hw_counter_sampler");
+
+namespace proton {
+
+namespace {
+
+int
+openCounter(uint64_t config)
+{
+    perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.config = config;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.inherit = 1;
+    attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+    return syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0);
+}
+
+double
+now_seconds()
+{
+    return vespalib::to_s(vespalib::steady_clock::now().time_since_epoch());
+}
+
+}
+
+uint64_t
+HwCounterSampler::read(Counter counter) const
+{
+    uint64_t values[3] = {0, 0, 0}; // value, time enabled, time running
+    if (::read(_fds[counter], values, sizeof(values)) != sizeof(values)) {
+        return 0;
+    }
+    if ((values[2] != 0) && (values[2] < values[1])) {
+        // the counters are multiplexed on the hardware, scale up
+        return uint64_t(double(values[0]) * values[1] / values[2]);
+    }
+    return values[0];
+}
+
+HwCounterSampler::HwCounterSampler()
+    : _fds(),
+      _prev(),
+      _prevSeconds(now_seconds()),
+      _lastSample(),
+      _lock()
+{
+    const uint64_t configs[NUM_COUNTERS] = {
+        PERF_COUNT_HW_CPU_CYCLES,
+        PERF_COUNT_HW_INSTRUCTIONS,
+        PERF_COUNT_HW_CACHE_MISSES,
+        PERF_COUNT_HW_BRANCH_MISSES
+    };
+    _fds.fill(-1);
+    _prev.fill(0);
+    for (uint32_t i = 0; i < NUM_COUNTERS; ++i) {
+        _fds[i] = openCounter(configs[i]);
+        if (_fds[i] < 0) {
+            LOG(warning, "Hardware performance counters are not available: %s", strerror(errno));
+            for (int &fd : _fds) {
+                if (fd >= 0) {
+                    close(fd);
+                }
+                fd = -1;
+            }
+            return;
+        }
+    }
+}
+
+HwCounterSampler::~HwCounterSampler()
+{
+    for (int fd : _fds) {
+        if (fd >= 0) {
+            close(fd);
+        }
+    }
+}
+
+bool
+HwCounterSampler::available() const
+{
+    return (_fds[CYCLES] >= 0);
+}
+
+HwCounterSampler::Sample
+HwCounterSampler::sample()
+{
+    std::lock_guard<std::mutex> guard(_lock);
+    if (!available()) {
+        return _lastSample;
+    }
+    std::array<uint64_t, NUM_COUNTERS> values;
+    for (uint32_t i = 0; i < NUM_COUNTERS; ++i) {
+        values[i] = read(Counter(i));
+    }
+    double seconds = now_seconds();
+    auto delta = [&](Counter counter) {
+        return (values[counter] > _prev[counter]) ? (values[counter] - _prev[counter]) : 0;
+    };
+    _lastSample.cycles = delta(CYCLES);
+    _lastSample.instructions = delta(INSTRUCTIONS);
+    _lastSample.cacheMisses = delta(CACHE_MISSES);
+    _lastSample.branchMisses = delta(BRANCH_MISSES);
+    _lastSample.seconds = seconds - _prevSeconds;
+    _prev = values;
+    _prevSeconds = seconds;
+    return _lastSample;
+}
+
+HwCounterSampler::Sample
+HwCounterSampler::lastSample() const
+{
+    std::lock_guard<std::mutex> guard(_lock);
+    return _lastSample;
+}
+
+}
@@ -0,0 +1,68 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <mutex>
+
+namespace proton {
+
+/*
+ * Class sampling hardware performance counters (cycles, instructions,
+ * last level cache misses and branch misses) for this process using
+ * perf events. The counters are inherited by threads created after
+ * the sampler, so it should be created before the thread pools.
+ *
+ * If perf events are not available (e.g. not permitted by
+ * kernel.perf_event_paranoid), the sampler is not available and all
+ * samples are empty.
+ */
+class HwCounterSampler
+{
+public:
+    struct Sample {
+        uint64_t cycles;
+        uint64_t instructions;
+        uint64_t cacheMisses;
+        uint64_t branchMisses;
+        double seconds;
+
+        Sample() : cycles(0), instructions(0), cacheMisses(0), branchMisses(0), seconds(0.0) {}
+        double ipc() const { return (cycles != 0) ? (double(instructions) / cycles) : 0.0; }
+        double cacheMissesPerKiloInstruction() const { return perKiloInstruction(cacheMisses); }
+        double branchMissesPerKiloInstruction() const { return perKiloInstruction(branchMisses); }
+    private:
+        double perKiloInstruction(uint64_t count) const {
+            return (instructions != 0) ? (count * 1000.0 / instructions) : 0.0;
+        }
+    };
+
+private:
+    enum Counter { CYCLES = 0, INSTRUCTIONS, CACHE_MISSES, BRANCH_MISSES, NUM_COUNTERS };
+
+    std::array<int, NUM_COUNTERS> _fds;
+    std::array<uint64_t, NUM_COUNTERS> _prev;
+    double _prevSeconds;
+    Sample _lastSample;
+    mutable std::mutex _lock;
+
+    uint64_t read(Counter counter) const;
+
+public:
+    HwCounterSampler();
+    HwCounterSampler(const HwCounterSampler &) = delete;
+    HwCounterSampler &operator=(const HwCounterSampler &) = delete;
+    ~HwCounterSampler();
+
+    bool available() const;
+
+    /*
+     * Returns the counter deltas since the previous call and stores
+     * them as the last sample.
+     */
+    Sample sample();
+    Sample lastSample() const;
+};
+
+}
@@ -6,7 +6,9 @@
 #include <vespa/searchlib/attribute/iattributemanager.h>
 #include <vespa/searchlib/common/location.h>
 #include <vespa/searchlib/common/matching_elements.h>
+#include <vespa/vespalib/data/slime/inject.h>
 #include <vespa/vespalib/data/slime/slime.h>
+#include <vespa/vespalib/util/thread_bundle.h>
 #include <vespa/vespalib/util/stringfmt.h>
 
 #include <vespa/log/log.h>
@@ -45,50 +47,91 @@ Memory TIMEOUT("timeout");
 
 }
 
+struct DocsumContext::Batch : vespalib::Runnable {
+    DocsumContext                   &context;
+    std::unique_ptr<IDocsumStore>    ownedStore;
+    IDocsumStore                    &store;
+    GetDocsumsState                  state;
+    uint32_t                         begin;
+    search::engine::DocsumReply     *reply;
+    std::unique_ptr<vespalib::Slime> slime;
+    uint32_t                         numDone;
+
+    Batch(DocsumContext &context_in, std::unique_ptr<IDocsumStore> ownedStore_in, IDocsumStore &store_in,
+          uint32_t begin_in, uint32_t end_in, DocsumReply *reply_in)
+        : context(context_in),
+          ownedStore(std::move(ownedStore_in)),
+          store(store_in),
+          state(context_in),
+          begin(begin_in),
+          reply(reply_in),
+          slime(),
+          numDone(0)
+    {
+        context.initState(state, begin_in, end_in);
+    }
+    void run() override {
+        context._docsumWriter.InitState(context._attrMgr, &state);
+        if (reply != nullptr) {
+            context.fillReply(state, store, begin, *reply);
+        } else {
+            slime = std::make_unique<Slime>();
+            numDone = context.fillSlime(state, store, *slime, slime->setArray());
+        }
+    }
+};
+
 void
-DocsumContext::initState()
+DocsumContext::initState(GetDocsumsState &state, uint32_t begin, uint32_t end)
 {
     const DocsumRequest & req = _request;
-    _docsumState._args.initFromDocsumRequest(req);
-    _docsumState._docsumcnt = req.hits.size();
+    state._args.initFromDocsumRequest(req);
+    state._docsumcnt = end - begin;
 
-    _docsumState._docsumbuf = (_docsumState._docsumcnt > 0)
-                              ? (uint32_t*)malloc(sizeof(uint32_t) * _docsumState._docsumcnt)
-                              : nullptr;
+    state._docsumbuf = (state._docsumcnt > 0)
+                       ? (uint32_t*)malloc(sizeof(uint32_t) * state._docsumcnt)
+                       : nullptr;
 
-    for (uint32_t i = 0; i < _docsumState._docsumcnt; i++) {
-        _docsumState._docsumbuf[i] = req.hits[i].docid;
+    for (uint32_t i = 0; i < state._docsumcnt; i++) {
+        state._docsumbuf[i] = req.hits[begin + i].docid;
     }
 }
 
-DocsumReply::UP
-DocsumContext::createReply()
+void
+DocsumContext::fillReply(GetDocsumsState &state, IDocsumStore &store, uint32_t begin, DocsumReply &reply)
 {
-    auto reply = std::make_unique<DocsumReply>();
     search::RawBuf buf(4096);
-    _docsumWriter.InitState(_attrMgr, &_docsumState);
-    reply->docsums.resize(_docsumState._docsumcnt);
     SymbolTable::UP symbols = std::make_unique<SymbolTable>();
-    IDocsumWriter::ResolveClassInfo rci = _docsumWriter.resolveClassInfo(_docsumState._args.getResultClassName(), _docsumStore.getSummaryClassId());
-    for (uint32_t i = 0; i < _docsumState._docsumcnt; ++i) {
+    IDocsumWriter::ResolveClassInfo rci = _docsumWriter.resolveClassInfo(state._args.getResultClassName(), store.getSummaryClassId());
+    for (uint32_t i = 0; i < state._docsumcnt; ++i) {
         buf.reset();
-        uint32_t docId = _docsumState._docsumbuf[i];
-        reply->docsums[i].docid = docId;
+        uint32_t docId = state._docsumbuf[i];
+        DocsumReply::Docsum &docsum = reply.docsums[begin + i];
+        docsum.docid = docId;
         if (docId != search::endDocId && !rci.mustSkip) {
             Slime slime(Slime::Params(std::move(symbols)));
             vespalib::slime::SlimeInserter inserter(slime);
             if (_request.expired()) {
                 inserter.insertString(make_string("Timed out with %" PRId64 "us left.", vespalib::count_us(_request.getTimeLeft())));
             } else {
-                _docsumWriter.insertDocsum(rci, docId, &_docsumState, &_docsumStore, slime, inserter);
+                _docsumWriter.insertDocsum(rci, docId, &state, &store, slime, inserter);
             }
             uint32_t docsumLen = (slime.get().type().getId() != NIX::ID)
                                    ? IDocsumWriter::slime2RawBuf(slime, buf)
                                    : 0;
-            reply->docsums[i].setData(buf.GetDrainPos(), docsumLen);
+            docsum.setData(buf.GetDrainPos(), docsumLen);
             symbols = Slime::reclaimSymbols(std::move(slime));
         }
     }
+}
+
+DocsumReply::UP
+DocsumContext::createReply()
+{
+    auto reply = std::make_unique<DocsumReply>();
+    _docsumWriter.InitState(_attrMgr, &_docsumState);
+    reply->docsums.resize(_docsumState._docsumcnt);
+    fillReply(_docsumState, _docsumStore, 0, *reply);
     return reply;
 }
 
@@ -103,6 +146,34 @@ makeSlimeParams(size_t chunkSize) {
 
 }
 
+uint32_t
+DocsumContext::fillSlime(GetDocsumsState &state, IDocsumStore &store, Slime &slime, Cursor &array)
+{
+    const Symbol docsumSym = slime.insert(DOCSUM);
+    IDocsumWriter::ResolveClassInfo rci = _docsumWriter.resolveClassInfo(state._args.getResultClassName(),
+                                                                         store.getSummaryClassId());
+    uint32_t i(0);
+    for (i = 0; (i < state._docsumcnt) && !_request.expired(); ++i) {
+        uint32_t docId = state._docsumbuf[i];
+        Cursor & docSumC = array.addObject();
+        ObjectSymbolInserter inserter(docSumC, docsumSym);
+        if ((docId != search::endDocId) && !rci.mustSkip) {
+            _docsumWriter.insertDocsum(rci, docId, &state, &store, slime, inserter);
+        }
+    }
+    return i;
+}
+
+void
+DocsumContext::addTimeoutError(Cursor &root, uint32_t numTimedOut)
+{
+    Cursor & errors = root.setArray(ERRORS);
+    Cursor & timeout = errors.addObject();
+    timeout.setString(TYPE, TIMEOUT);
+    timeout.setString(MESSAGE, make_string("Timed out %d summaries with %" PRId64 "us left.",
+                                           numTimedOut, vespalib::count_us(_request.getTimeLeft())));
+}
+
 vespalib::Slime::UP
 DocsumContext::createSlimeReply()
 {
@@ -111,25 +182,33 @@ DocsumContext::createSlimeReply()
     vespalib::Slime::UP response(std::make_unique<vespalib::Slime>(makeSlimeParams(estimatedChunkSize)));
     Cursor & root = response->setObject();
     Cursor & array = root.setArray(DOCSUMS);
-    const Symbol docsumSym = response->insert(DOCSUM);
-    IDocsumWriter::ResolveClassInfo rci = _docsumWriter.resolveClassInfo(_docsumState._args.getResultClassName(),
-                                                                         _docsumStore.getSummaryClassId());
-    uint32_t i(0);
-    for (i = 0; (i < _docsumState._docsumcnt) && !_request.expired(); ++i) {
-        uint32_t docId = _docsumState._docsumbuf[i];
-        Cursor & docSumC = array.addObject();
-        ObjectSymbolInserter inserter(docSumC, docsumSym);
-        if ((docId != search::endDocId) && !rci.mustSkip) {
-            _docsumWriter.insertDocsum(rci, docId, &_docsumState, &_docsumStore, *response, inserter);
+    uint32_t numDone = fillSlime(_docsumState, _docsumStore, *response, array);
+    if (numDone != _docsumState._docsumcnt) {
+        addTimeoutError(root, _docsumState._docsumcnt - numDone);
+    }
+    return response;
+}
+
+vespalib::Slime::UP
+DocsumContext::mergeSlimeReplies(const std::vector<std::unique_ptr<Batch>> &batches)
+{
+    const size_t estimatedChunkSize(std::min(0x200000ul, _docsumState._docsumcnt*0x400ul));
+    vespalib::Slime::UP response(std::make_unique<vespalib::Slime>(makeSlimeParams(estimatedChunkSize)));
+    Cursor & root = response->setObject();
+    Cursor & array = root.setArray(DOCSUMS);
+    uint32_t numDone = 0;
+    for (const auto &batch : batches) {
+        const vespalib::slime::Inspector &docsums = batch->slime->get();
+        for (size_t i = 0; i < docsums.entries(); ++i) {
+            vespalib::slime::inject(docsums[i], vespalib::slime::ArrayInserter(array));
+        }
+        numDone += batch->numDone;
+        if (batch->numDone != batch->state._docsumcnt) {
+            break;
         }
     }
-    if (i != _docsumState._docsumcnt) {
-        const uint32_t numTimedOut = _docsumState._docsumcnt - i;
-        Cursor & errors = root.setArray(ERRORS);
-        Cursor & timeout = errors.addObject();
-        timeout.setString(TYPE, TIMEOUT);
-        timeout.setString(MESSAGE, make_string("Timed out %d summaries with %" PRId64 "us left.",
-                                               numTimedOut, vespalib::count_us(_request.getTimeLeft())));
+    if (numDone != _docsumState._docsumcnt) {
+        addTimeoutError(root, _docsumState._docsumcnt - numDone);
     }
     return response;
 }
@@ -146,11 +225,14 @@ DocsumContext::DocsumContext(const DocsumRequest & request, IDocsumWriter & docs
     _attrCtx(attrCtx),
     _attrMgr(attrMgr),
     _docsumState(*this),
-    _sessionMgr(sessionMgr)
+    _sessionMgr(sessionMgr),
+    _lock()
 {
-    initState();
+    initState(_docsumState, 0, request.hits.size());
 }
 
+DocsumContext::~DocsumContext() = default;
+
 DocsumReply::UP
 DocsumContext::getDocsums()
 {
@@ -160,30 +242,66 @@ DocsumContext::getDocsums()
     return createReply();
 }
 
+DocsumReply::UP
+DocsumContext::getDocsums(vespalib::ThreadBundle &threadBundle, const DocsumStoreFactory &storeFactory)
+{
+    uint32_t numHits = _docsumState._docsumcnt;
+    uint32_t numBatches = std::min(uint32_t(threadBundle.size()), numHits / MIN_HITS_PER_BATCH);
+    if (numBatches <= 1) {
+        return getDocsums();
+    }
+    std::unique_ptr<DocsumReply> reply;
+    if ( ! _request.useRootSlime()) {
+        reply = std::make_unique<DocsumReply>();
+        reply->docsums.resize(numHits);
+    }
+    std::vector<std::unique_ptr<Batch>> batches;
+    std::vector<vespalib::Runnable *> targets;
+    for (uint32_t i = 0; i < numBatches; ++i) {
+        uint32_t begin = (uint64_t(numHits) * i) / numBatches;
+        uint32_t end = (uint64_t(numHits) * (i + 1)) / numBatches;
+        std::unique_ptr<IDocsumStore> store = (i == 0) ? std::unique_ptr<IDocsumStore>() : storeFactory();
+        IDocsumStore &batchStore = store ? *store : _docsumStore;
+        batches.push_back(std::make_unique<Batch>(*this, std::move(store), batchStore, begin, end, reply.get()));
+        targets.push_back(batches.back().get());
+    }
+    threadBundle.run(targets);
+    if (reply) {
+        return reply;
+    }
+    return std::make_unique<DocsumReply>(mergeSlimeReplies(batches));
+}
+
 void
 DocsumContext::FillSummaryFeatures(search::docsummary::GetDocsumsState * state, search::docsummary::IDocsumEnvironment *)
 {
-    assert(&_docsumState == state);
-    if (_matcher->canProduceSummaryFeatures()) {
-        state->_summaryFeatures = _matcher->getSummaryFeatures(_request, _searchCtx, _attrCtx, _sessionMgr);
+    // the features are calculated for all hits in the request, and shared by all batches
+    std::lock_guard<std::mutex> guard(_lock);
+    if (!_docsumState._summaryFeatures && _matcher->canProduceSummaryFeatures()) {
+        _docsumState._summaryFeatures = _matcher->getSummaryFeatures(_request, _searchCtx, _attrCtx, _sessionMgr);
     }
+    state->_summaryFeatures = _docsumState._summaryFeatures;
     state->_summaryFeaturesCached = false;
 }
 
 void
 DocsumContext::FillRankFeatures(search::docsummary::GetDocsumsState * state, search::docsummary::IDocsumEnvironment *)
 {
-    assert(&_docsumState == state);
     // check if we are allowed to run
     if ( ! state->_args.dumpFeatures()) {
         return;
     }
-    state->_rankFeatures = _matcher->getRankFeatures(_request, _searchCtx, _attrCtx, _sessionMgr);
+    std::lock_guard<std::mutex> guard(_lock);
+    if (!_docsumState._rankFeatures) {
+        _docsumState._rankFeatures = _matcher->getRankFeatures(_request, _searchCtx, _attrCtx, _sessionMgr);
+    }
+    state->_rankFeatures = _docsumState._rankFeatures;
 }
 
 std::unique_ptr<MatchingElements>
 DocsumContext::fill_matching_elements(const MatchingElementsFields &fields)
 {
+    std::lock_guard<std::mutex> guard(_lock);
     if (_matcher) {
         return _matcher->get_matching_elements(_request, _searchCtx, _attrCtx, _sessionMgr, fields);
     }
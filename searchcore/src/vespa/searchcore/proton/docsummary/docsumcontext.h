@@ -6,6 +6,10 @@
 #include <vespa/searchsummary/docsummary/docsumwriter.h>
 #include <vespa/searchlib/engine/docsumrequest.h>
 #include <vespa/searchlib/engine/docsumreply.h>
+#include <functional>
+#include <mutex>
+
+namespace vespalib { struct ThreadBundle; }
 
 namespace proton {
 
@@ -21,6 +25,10 @@ namespace matching {
  **/
 class DocsumContext : public search::docsummary::GetDocsumsStateCallback {
 private:
+    struct Batch;
+    using GetDocsumsState = search::docsummary::GetDocsumsState;
+    using IDocsumStore = search::docsummary::IDocsumStore;
+
     const search::engine::DocsumRequest  & _request;
     search::docsummary::IDocsumWriter    & _docsumWriter;
     search::docsummary::IDocsumStore     & _docsumStore;
@@ -30,13 +38,24 @@ private:
     search::IAttributeManager            & _attrMgr;
     search::docsummary::GetDocsumsState    _docsumState;
     matching::SessionManager             & _sessionMgr;
+    // serializes callbacks from docsum states used by parallel batches
+    std::mutex                             _lock;
 
-    void initState();
+    void initState(GetDocsumsState &state, uint32_t begin, uint32_t end);
+    void fillReply(GetDocsumsState &state, IDocsumStore &store, uint32_t begin, search::engine::DocsumReply &reply);
+    uint32_t fillSlime(GetDocsumsState &state, IDocsumStore &store, vespalib::Slime &slime,
+                       vespalib::slime::Cursor &array);
+    void addTimeoutError(vespalib::slime::Cursor &root, uint32_t numTimedOut);
     search::engine::DocsumReply::UP createReply();
     std::unique_ptr<vespalib::Slime> createSlimeReply();
+    std::unique_ptr<vespalib::Slime> mergeSlimeReplies(const std::vector<std::unique_ptr<Batch>> &batches);
 
 public:
     typedef std::unique_ptr<DocsumContext> UP;
+    using DocsumStoreFactory = std::function<std::unique_ptr<IDocsumStore>()>;
+
+    // large requests are split in batches of at least this many hits
+    static constexpr uint32_t MIN_HITS_PER_BATCH = 128;
 
     DocsumContext(const search::engine::DocsumRequest & request,
                   search::docsummary::IDocsumWriter & docsumWriter,
@@ -46,9 +65,19 @@ public:
                   search::attribute::IAttributeContext & attrCtx,
                   search::IAttributeManager & attrMgr,
                   matching::SessionManager & sessionMgr);
+    ~DocsumContext() override;
 
     search::engine::DocsumReply::UP getDocsums();
 
+    /**
+     * Produce the docsums of a large request in batches of hits run
+     * in parallel by the given thread bundle. Each batch uses its own
+     * docsum state and a docsum store created by the given factory.
+     * The results are merged in hit order.
+     **/
+    search::engine::DocsumReply::UP getDocsums(vespalib::ThreadBundle &threadBundle,
+                                               const DocsumStoreFactory &storeFactory);
+
     // Implements GetDocsumsStateCallback
     void FillSummaryFeatures(search::docsummary::GetDocsumsState * state, search::docsummary::IDocsumEnvironment * env) override;
     void FillRankFeatures(search::docsummary::GetDocsumsState * state, search::docsummary::IDocsumEnvironment * env) override;
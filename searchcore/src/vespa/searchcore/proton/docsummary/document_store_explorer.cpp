@@ -7,6 +7,7 @@ using vespalib::slime::Cursor;
 using vespalib::slime::Inserter;
 using search::DataStoreFileChunkStats;
 using search::DataStoreStorageStats;
+using search::IoThrottleStats;
 
 namespace proton {
 
@@ -27,6 +28,18 @@ setMemoryUsage(Cursor &object, const vespalib::MemoryUsage &usage)
     memory.setLong("onHoldBytes", usage.allocatedBytesOnHold());
 }
 
+void
+setCompactionThrottle(Cursor &object, const IoThrottleStats &stats)
+{
+    Cursor &throttle = object.setObject("compactionThrottle");
+    throttle.setLong("rateLimit", stats.rateLimit());
+    throttle.setLong("currentRate", stats.currentRate());
+    throttle.setLong("bytesRead", stats.bytes());
+    throttle.setDouble("throttledTime", vespalib::to_s(stats.throttledTime()));
+    throttle.setDouble("readLatency", vespalib::to_s(stats.readLatency()));
+    throttle.setBool("throttling", stats.throttling());
+}
+
 }
 
 void
@@ -42,6 +55,7 @@ DocumentStoreExplorer::get_state(const Inserter &inserter, bool full) const
     object.setLong("lastSerialNum", storageStats.lastSerialNum());
     object.setLong("docIdLimit", storageStats.docIdLimit());
     setMemoryUsage(object, store.getMemoryUsage());
+    setCompactionThrottle(object, store.getCompactionThrottleStats());
     if (full) {
         const vespalib::string &baseDir = store.getBaseDir();
         std::vector<DataStoreFileChunkStats> chunks;
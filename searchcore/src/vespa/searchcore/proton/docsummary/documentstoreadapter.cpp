@@ -2,6 +2,13 @@
 
 #include "documentstoreadapter.h"
 #include <vespa/searchsummary/docsummary/summaryfieldconverter.h>
+#include <vespa/document/fieldvalue/boolfieldvalue.h>
+#include <vespa/document/fieldvalue/doublefieldvalue.h>
+#include <vespa/document/fieldvalue/floatfieldvalue.h>
+#include <vespa/document/fieldvalue/intfieldvalue.h>
+#include <vespa/document/fieldvalue/longfieldvalue.h>
+#include <vespa/document/fieldvalue/rawfieldvalue.h>
+#include <vespa/document/fieldvalue/shortfieldvalue.h>
 #include <vespa/document/fieldvalue/stringfieldvalue.h>
 #include <vespa/eval/tensor/tensor.h>
 #include <vespa/eval/tensor/serialization/typed_binary_format.h>
@@ -21,6 +28,26 @@ namespace {
 
 const vespalib::string DOCUMENT_ID_FIELD("documentid");
 
+/*
+ * Primitive values that SummaryFieldConverter would only copy can be
+ * written directly from the document, avoiding a copy of each value.
+ */
+bool
+isPassThrough(const FieldValue &value, bool markup)
+{
+    uint32_t classId = value.getClass().id();
+    if (classId == StringFieldValue::classId) {
+        return !markup;
+    }
+    return ((classId == IntFieldValue::classId) ||
+            (classId == LongFieldValue::classId) ||
+            (classId == ShortFieldValue::classId) ||
+            (classId == BoolFieldValue::classId) ||
+            (classId == DoubleFieldValue::classId) ||
+            (classId == FloatFieldValue::classId) ||
+            (classId == RawFieldValue::classId));
+}
+
 }
 
 bool
@@ -102,10 +129,14 @@ DocumentStoreAdapter::writeField(const FieldValue &value, ResType type)
 
 
 void
-DocumentStoreAdapter::convertFromSearchDoc(Document &doc, uint32_t docId)
+DocumentStoreAdapter::convertFromSearchDoc(Document &doc, uint32_t docId, const ResultClass *outputClass)
 {
     for (size_t i = 0; i < _resultClass->GetNumEntries(); ++i) {
         const ResConfigEntry * entry = _resultClass->GetEntry(i);
+        if ((outputClass != nullptr) && (outputClass->GetIndexFromEnumValue(entry->_enumValue) < 0)) {
+            _resultPacker.AddEmpty();
+            continue;
+        }
         const vespalib::string fieldName(entry->_bindname);
         bool markup = _markupFields.find(fieldName) != _markupFields.end();
         if (fieldName == DOCUMENT_ID_FIELD) {
@@ -130,6 +161,12 @@ DocumentStoreAdapter::convertFromSearchDoc(Document &doc, uint32_t docId)
             continue;
         }
         LOG(spam, "writeField(%s): value(%s), type(%d)", fieldName.c_str(), fieldValue->toString().c_str(), entry->_type);
+        if (isPassThrough(*fieldValue, markup)) {
+            if (!writeField(*fieldValue, entry->_type)) {
+                LOG(warning, "Error while writing field '%s' for docId %u", fieldName.c_str(), docId);
+            }
+            continue;
+        }
         FieldValue::UP convertedFieldValue = SummaryFieldConverter::convertSummaryField(markup, *fieldValue);
         if (convertedFieldValue) {
             if (!writeField(*convertedFieldValue, entry->_type)) {
@@ -165,6 +202,18 @@ DocumentStoreAdapter::~DocumentStoreAdapter() = default;
 
 DocsumStoreValue
 DocumentStoreAdapter::getMappedDocsum(uint32_t docId)
+{
+    return getMappedDocsum(docId, nullptr);
+}
+
+DocsumStoreValue
+DocumentStoreAdapter::getMappedDocsum(uint32_t docId, const ResultClass &outputClass)
+{
+    return getMappedDocsum(docId, &outputClass);
+}
+
+DocsumStoreValue
+DocumentStoreAdapter::getMappedDocsum(uint32_t docId, const ResultClass *outputClass)
 {
     if (!_resultPacker.Init(getSummaryClassId())) {
         LOG(warning, "Error during init of result class '%s' with class id %u", _resultClass->GetClassName(), getSummaryClassId());
@@ -176,7 +225,7 @@ DocumentStoreAdapter::getMappedDocsum(uint32_t docId)
         return DocsumStoreValue();
     }
     LOG(spam, "getMappedDocSum(%u): document={\n%s\n}", docId, document->toString(true).c_str());
-    convertFromSearchDoc(*document, docId);
+    convertFromSearchDoc(*document, docId, outputClass);
     const char * buf;
     uint32_t buflen;
     if (!_resultPacker.GetDocsumBlob(&buf, &buflen)) {
@@ -32,7 +32,11 @@ private:
                search::docsummary::ResType type);
 
     void
-    convertFromSearchDoc(document::Document &doc, uint32_t docId);
+    convertFromSearchDoc(document::Document &doc, uint32_t docId,
+                         const search::docsummary::ResultClass *outputClass);
+
+    search::docsummary::DocsumStoreValue
+    getMappedDocsum(uint32_t docId, const search::docsummary::ResultClass *outputClass);
 
 public:
     DocumentStoreAdapter(const search::IDocumentStore &docStore,
@@ -49,6 +53,8 @@ public:
 
     uint32_t getNumDocs() const override { return _docStore.getDocIdLimit(); }
     search::docsummary::DocsumStoreValue getMappedDocsum(uint32_t docId) override;
+    search::docsummary::DocsumStoreValue getMappedDocsum(uint32_t docId,
+                                                         const search::docsummary::ResultClass &outputClass) override;
     uint32_t getSummaryClassId() const override { return _resultClass->GetClassID(); }
 
 };
@@ -2,18 +2,31 @@
 
 #include "lid_gid_key_comparator.h"
 #include <limits>
+#include <typeinfo>
 
 namespace proton::documentmetastore {
 
 const search::IDocumentMetaStore::DocId
 LidGidKeyComparator::FIND_DOC_ID = std::numeric_limits<DocId>::max();
 
+namespace {
+
+// The default bucket order is compared inline on prefix keys instead of
+// through the virtual gid comparator.
+bool isDefaultBucketOrder(const IGidCompare &gidCompare) {
+    return typeid(gidCompare) == typeid(DefaultGidCompare);
+}
+
+}
+
 LidGidKeyComparator::LidGidKeyComparator(const document::GlobalId &gid,
                                          const MetaDataStore &metaDataStore,
                                          const IGidCompare &gidCompare)
     : _gid(gid),
       _metaDataStore(metaDataStore),
-      _gidCompare(gidCompare)
+      _gidCompare(gidCompare),
+      _bucketOrder(isDefaultBucketOrder(gidCompare)),
+      _gidBucketOrderKey(getBucketOrderKey(gid))
 {
 }
 
@@ -22,7 +35,9 @@ LidGidKeyComparator::LidGidKeyComparator(const RawDocumentMetaData &metaData,
                                          const IGidCompare &gidCompare)
     : _gid(metaData.getGid()),
       _metaDataStore(metaDataStore),
-      _gidCompare(gidCompare)
+      _gidCompare(gidCompare),
+      _bucketOrder(isDefaultBucketOrder(gidCompare)),
+      _gidBucketOrderKey(getBucketOrderKey(metaData.getGid()))
 {
 }
 
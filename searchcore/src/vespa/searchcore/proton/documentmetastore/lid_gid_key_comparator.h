@@ -7,6 +7,7 @@
 #include <vespa/document/base/globalid.h>
 #include <vespa/searchlib/common/idocumentmetastore.h>
 #include <vespa/vespalib/util/rcuvector.h>
+#include <cstring>
 
 namespace proton::documentmetastore {
 
@@ -26,6 +27,8 @@ private:
     const document::GlobalId &_gid;
     const MetaDataStore      &_metaDataStore;
     const IGidCompare        &_gidCompare;
+    const bool                _bucketOrder;
+    const uint64_t            _gidBucketOrderKey;
 
     const document::GlobalId &getGid(DocId lid) const {
         if (lid != FIND_DOC_ID) {
@@ -34,6 +37,17 @@ private:
         return _gid;
     }
 
+    bool lessInBucketOrder(DocId lhs, DocId rhs) const {
+        const document::GlobalId &lhsGid = getGid(lhs);
+        const document::GlobalId &rhsGid = getGid(rhs);
+        uint64_t lhsKey = (lhs != FIND_DOC_ID) ? getBucketOrderKey(lhsGid) : _gidBucketOrderKey;
+        uint64_t rhsKey = (rhs != FIND_DOC_ID) ? getBucketOrderKey(rhsGid) : _gidBucketOrderKey;
+        if (lhsKey != rhsKey) {
+            return lhsKey < rhsKey;
+        }
+        return lhsGid < rhsGid;
+    }
+
 public:
     /**
      * Creates a comparator that returns the given gid if
@@ -48,8 +62,31 @@ public:
                         const MetaDataStore &metaDataStore,
                         const IGidCompare &gidCompare);
 
+    /**
+     * Returns the 8 bytes of the gid that document::GlobalId::BucketOrderCmp
+     * compares first, as one integer with the same ordering. Gids with equal
+     * keys are ordered by plain gid comparison.
+     **/
+    static uint64_t getBucketOrderKey(const document::GlobalId &gid) {
+        const unsigned char *buf = gid.get();
+        uint32_t lo;
+        uint32_t hi;
+        memcpy(&lo, buf, sizeof(lo));
+        memcpy(&hi, buf + 8, sizeof(hi));
+        // Reversing all bits of the little endian word reverses the bits
+        // of each byte and puts the first byte in the most significant place.
+        uint64_t key = (uint64_t(hi) << 32) | lo;
+        key = ((key >> 1) & 0x5555555555555555ul) | ((key & 0x5555555555555555ul) << 1);
+        key = ((key >> 2) & 0x3333333333333333ul) | ((key & 0x3333333333333333ul) << 2);
+        key = ((key >> 4) & 0x0f0f0f0f0f0f0f0ful) | ((key & 0x0f0f0f0f0f0f0f0ful) << 4);
+        return __builtin_bswap64(key);
+    }
+
     bool operator()(const DocId &lhs, const DocId &rhs) const {
-            return _gidCompare(getGid(lhs), getGid(rhs));
+        if (_bucketOrder) {
+            return lessInBucketOrder(lhs, rhs);
+        }
+        return _gidCompare(getGid(lhs), getGid(rhs));
     }
 
 };
@@ -2,6 +2,7 @@
 
 #include "putoperation.h"
 #include <vespa/document/fieldvalue/document.h>
+#include <vespa/vespalib/objects/nbostream.h>
 
 using document::BucketId;
 using document::Document;
@@ -13,13 +14,15 @@ namespace proton {
 
 PutOperation::PutOperation()
     : DocumentOperation(FeedOperation::PUT),
-      _doc()
+      _doc(),
+      _serializedDoc()
 { }
 
 
 PutOperation::PutOperation(BucketId bucketId, Timestamp timestamp, Document::SP doc)
     : DocumentOperation(FeedOperation::PUT, bucketId, timestamp),
-      _doc(std::move(doc))
+      _doc(std::move(doc)),
+      _serializedDoc()
 { }
 
 PutOperation::~PutOperation() = default;
@@ -29,9 +32,13 @@ PutOperation::serialize(vespalib::nbostream &os) const
 {
     assertValidBucketId(_doc->getId());
     DocumentOperation::serialize(os);
-    size_t oldSize = os.size();
-    _doc->serialize(os);
-    _serializedDocSize = os.size() - oldSize;
+    if ( ! _serializedDoc) {
+        auto stream = std::make_shared<vespalib::nbostream>();
+        _doc->serialize(*stream);
+        _serializedDoc = std::move(stream);
+    }
+    os.write(_serializedDoc->peek(), _serializedDoc->size());
+    _serializedDocSize = _serializedDoc->size();
 }
 
 
@@ -41,6 +48,7 @@ PutOperation::deserialize(vespalib::nbostream &is, const DocumentTypeRepo &repo)
     DocumentOperation::deserialize(is, repo);
     size_t oldSize = is.size();
     _doc.reset(new Document(repo, is));
+    _serializedDoc.reset();
     _serializedDocSize = oldSize - is.size();
 }
 
@@ -51,6 +59,7 @@ PutOperation::deserializeDocument(const DocumentTypeRepo &repo)
     _doc->serialize(stream);
     auto fixedDoc = std::make_shared<Document>(repo, stream);
     _doc = std::move(fixedDoc);
+    _serializedDoc.reset();
 }
 
 vespalib::string
@@ -7,8 +7,12 @@ namespace proton {
 
 class PutOperation : public DocumentOperation
 {
+public:
+    using SerializedDocument = std::shared_ptr<const vespalib::nbostream>;
+private:
     using DocumentSP = std::shared_ptr<document::Document>;
     DocumentSP _doc;
+    mutable SerializedDocument _serializedDoc; // Set by serialize(), reused when storing the document
 
 public:
     PutOperation();
@@ -17,6 +21,11 @@ public:
                  DocumentSP doc);
     ~PutOperation() override;
     const DocumentSP &getDocument() const { return _doc; }
+    /**
+     * The document as serialized to the transaction log, or empty if
+     * the operation has not been serialized.
+     */
+    const SerializedDocument &getSerializedDocument() const { return _serializedDoc; }
     void assertValid() const;
     void serialize(vespalib::nbostream &os) const override;
     void deserialize(vespalib::nbostream &is, const document::DocumentTypeRepo &repo) override;
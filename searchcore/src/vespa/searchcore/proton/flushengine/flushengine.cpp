@@ -60,7 +60,8 @@ FlushEngine::FlushMeta::~FlushMeta() = default;
 
 FlushEngine::FlushInfo::FlushInfo()
     : FlushMeta("", 0),
-      _target()
+      _target(),
+      _bytesToWrite(0)
 {
 }
 
@@ -69,7 +70,8 @@ FlushEngine::FlushInfo::~FlushInfo() = default;
 
 FlushEngine::FlushInfo::FlushInfo(uint32_t taskId, const IFlushTarget::SP &target, const vespalib::string & destination)
     : FlushMeta(destination, taskId),
-      _target(target)
+      _target(target),
+      _bytesToWrite(target->getApproxBytesToWriteToDisk())
 {
 }
 
@@ -91,7 +93,9 @@ FlushEngine::FlushEngine(std::shared_ptr<flushengine::ITlsStatsFactory> tlsStats
       _strategyLock(),
       _strategyCond(),
       _tlsStatsFactory(std::move(tlsStatsFactory)),
-      _pendingPrune()
+      _pendingPrune(),
+      _restartCostEstimator(),
+      _predictedReplayTime(0)
 { }
 
 FlushEngine::~FlushEngine()
@@ -256,6 +260,9 @@ FlushEngine::getSortedTargetList()
 {
     FlushContext::List unsortedTargets = getTargetList(false);
     flushengine::TlsStatsMap tlsStatsMap(_tlsStatsFactory->create());
+    // Targets currently being flushed are left out, as their flushed serial is about to move.
+    _predictedReplayTime.store(_restartCostEstimator.predictReplayTime(unsortedTargets, tlsStatsMap).count(),
+                               std::memory_order_relaxed);
     std::lock_guard<std::mutex> strategyGuard(_strategyLock);
     std::pair<FlushContext::List, bool> ret;
     if (_priorityStrategy) {
@@ -349,10 +356,13 @@ void
 FlushEngine::flushDone(const FlushContext &ctx, uint32_t taskId)
 {
     vespalib::duration duration = vespalib::duration::zero();
+    uint64_t bytesToWrite = 0;
     {
         std::lock_guard<std::mutex> guard(_lock);
         duration = _flushing[taskId].elapsed();
+        bytesToWrite = _flushing[taskId]._bytesToWrite;
     }
+    _restartCostEstimator.addFlushSample(bytesToWrite, duration);
     if (LOG_WOULD_LOG(event)) {
         FlushStats stats = ctx.getTarget()->getLastFlushStats();
         EventLogger::flushComplete(ctx.getName(), vespalib::count_ms(duration), ctx.getTarget()->getFlushedSerialNum(),
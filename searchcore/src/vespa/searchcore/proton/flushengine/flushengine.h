@@ -3,11 +3,13 @@
 
 #include "flushcontext.h"
 #include "iflushstrategy.h"
+#include "restart_cost_estimator.h"
 #include <vespa/searchcore/proton/common/handlermap.hpp>
 #include <vespa/searchcore/proton/common/doctypename.h>
 #include <vespa/vespalib/util/threadstackexecutor.h>
 #include <vespa/vespalib/util/time.h>
 #include <vespa/fastos/thread.h>
+#include <atomic>
 #include <set>
 #include <mutex>
 #include <condition_variable>
@@ -43,6 +45,7 @@ private:
         ~FlushInfo();
 
         IFlushTarget::SP  _target;
+        uint64_t          _bytesToWrite;
     };
     typedef std::map<uint32_t, FlushInfo> FlushMap;
     typedef HandlerMap<IFlushHandler> FlushHandlerMap;
@@ -63,6 +66,8 @@ private:
     std::condition_variable        _strategyCond;
     std::shared_ptr<flushengine::ITlsStatsFactory> _tlsStatsFactory;
     std::set<IFlushHandler::SP>    _pendingPrune;
+    flushengine::RestartCostEstimator _restartCostEstimator;
+    std::atomic<vespalib::duration::rep> _predictedReplayTime;
 
     FlushContext::List getTargetList(bool includeFlushingTargets) const;
     std::pair<FlushContext::List,bool> getSortedTargetList();
@@ -161,6 +166,20 @@ public:
     FlushMetaSet getCurrentlyFlushingSet() const;
 
     void setStrategy(IFlushStrategy::SP strategy);
+
+    /**
+     * Returns the estimator learning flush write and transaction log
+     * replay speeds, used to plan flushing before a restart.
+     */
+    flushengine::RestartCostEstimator &getRestartCostEstimator() { return _restartCostEstimator; }
+
+    /**
+     * Returns the transaction log replay time predicted the last time
+     * flush targets were considered, or zero if not known yet.
+     */
+    vespalib::duration getPredictedReplayTime() const {
+        return vespalib::duration(_predictedReplayTime.load(std::memory_order_relaxed));
+    }
 };
 
 } // namespace proton
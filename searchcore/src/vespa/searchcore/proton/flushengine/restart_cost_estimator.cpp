@@ -0,0 +1,122 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "restart_cost_estimator.h"
+#include "tls_stats_map.h"
+#include <vespa/vespalib/stllike/hash_map.h>
+
+namespace proton::flushengine {
+
+using search::SerialNum;
+using searchcorespi::IFlushTarget;
+
+namespace {
+
+uint64_t
+estimateBytesToReplay(const TlsStats &tlsStats, SerialNum flushedSerial)
+{
+    if (flushedSerial < tlsStats.getFirstSerial()) {
+        return tlsStats.getNumBytes();
+    }
+    if (flushedSerial >= tlsStats.getLastSerial()) {
+        return 0u;
+    }
+    double numEntries = tlsStats.getLastSerial() - tlsStats.getFirstSerial() + 1;
+    double bytesPerEntry = tlsStats.getNumBytes() / numEntries;
+    return bytesPerEntry * (tlsStats.getLastSerial() - flushedSerial);
+}
+
+}
+
+RestartCostEstimator::RestartCostEstimator()
+    : _lock(),
+      _writeBytesPerSecond(0.0),
+      _replayBytesPerSecond(0.0)
+{
+}
+
+RestartCostEstimator::~RestartCostEstimator() = default;
+
+double
+RestartCostEstimator::addSample(double average, uint64_t bytes, vespalib::duration elapsed)
+{
+    double seconds = vespalib::to_s(elapsed);
+    if (bytes == 0 || seconds <= 0.0) {
+        return average;
+    }
+    double bytesPerSecond = bytes / seconds;
+    if (average == 0.0) {
+        return bytesPerSecond;
+    }
+    return average + sampleWeight * (bytesPerSecond - average);
+}
+
+void
+RestartCostEstimator::addFlushSample(uint64_t bytesWritten, vespalib::duration elapsed)
+{
+    std::lock_guard<std::mutex> guard(_lock);
+    _writeBytesPerSecond = addSample(_writeBytesPerSecond, bytesWritten, elapsed);
+}
+
+void
+RestartCostEstimator::addReplaySample(uint64_t bytesReplayed, vespalib::duration elapsed)
+{
+    std::lock_guard<std::mutex> guard(_lock);
+    _replayBytesPerSecond = addSample(_replayBytesPerSecond, bytesReplayed, elapsed);
+}
+
+double
+RestartCostEstimator::getWriteBytesPerSecond() const
+{
+    std::lock_guard<std::mutex> guard(_lock);
+    return _writeBytesPerSecond;
+}
+
+double
+RestartCostEstimator::getReplayBytesPerSecond() const
+{
+    std::lock_guard<std::mutex> guard(_lock);
+    return _replayBytesPerSecond;
+}
+
+PrepareRestartFlushStrategy::Config
+RestartCostEstimator::adjustConfig(const PrepareRestartFlushStrategy::Config &cfg) const
+{
+    std::lock_guard<std::mutex> guard(_lock);
+    if (_writeBytesPerSecond == 0.0 || _replayBytesPerSecond == 0.0) {
+        return cfg;
+    }
+    return PrepareRestartFlushStrategy::Config(cfg.tlsReplayByteCost,
+                                               cfg.tlsReplayOperationCost,
+                                               cfg.tlsReplayByteCost * _replayBytesPerSecond / _writeBytesPerSecond);
+}
+
+vespalib::duration
+RestartCostEstimator::predictReplayTime(const FlushContext::List &targetList,
+                                        const TlsStatsMap &tlsStatsMap) const
+{
+    double replayBytesPerSecond = getReplayBytesPerSecond();
+    if (replayBytesPerSecond == 0.0) {
+        return vespalib::duration::zero();
+    }
+    vespalib::hash_map<vespalib::string, SerialNum> oldestFlushed;
+    for (const auto &ctx : targetList) {
+        const IFlushTarget &target = *ctx->getTarget();
+        if (target.getType() == IFlushTarget::Type::GC) {
+            continue;
+        }
+        const vespalib::string &handlerName = ctx->getHandler()->getName();
+        auto itr = oldestFlushed.find(handlerName);
+        if (itr == oldestFlushed.end()) {
+            oldestFlushed[handlerName] = target.getFlushedSerialNum();
+        } else if (target.getFlushedSerialNum() < itr->second) {
+            itr->second = target.getFlushedSerialNum();
+        }
+    }
+    uint64_t bytesToReplay = 0;
+    for (const auto &entry : oldestFlushed) {
+        bytesToReplay += estimateBytesToReplay(tlsStatsMap.getTlsStats(entry.first), entry.second);
+    }
+    return vespalib::from_s(bytesToReplay / replayBytesPerSecond);
+}
+
+}
@@ -0,0 +1,61 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#pragma once
+
+#include "flushcontext.h"
+#include "prepare_restart_flush_strategy.h"
+#include <vespa/vespalib/util/time.h>
+#include <mutex>
+
+namespace proton::flushengine {
+
+class TlsStatsMap;
+
+/**
+ * Learns how fast flush targets are written to disk and how fast the
+ * transaction log is replayed on startup, and uses this to predict how
+ * long the transaction log replay would take if proton was restarted now.
+ *
+ * Speeds are tracked as exponentially weighted moving averages of the
+ * observed samples. Until both speeds have been observed, the
+ * configured prepare restart cost factors are used unchanged.
+ */
+class RestartCostEstimator
+{
+private:
+    mutable std::mutex _lock;
+    double             _writeBytesPerSecond;
+    double             _replayBytesPerSecond;
+
+    static double addSample(double average, uint64_t bytes, vespalib::duration elapsed);
+
+public:
+    // Weight of a new sample in the moving averages.
+    static constexpr double sampleWeight = 0.2;
+
+    RestartCostEstimator();
+    ~RestartCostEstimator();
+
+    void addFlushSample(uint64_t bytesWritten, vespalib::duration elapsed);
+    void addReplaySample(uint64_t bytesReplayed, vespalib::duration elapsed);
+
+    // Returns 0 until a sample has been observed.
+    double getWriteBytesPerSecond() const;
+    double getReplayBytesPerSecond() const;
+
+    /**
+     * Returns the given prepare restart config with the flush write cost
+     * replaced by one relative to the observed replay speed, such that
+     * writing a byte costs what replaying the same time would cost.
+     */
+    PrepareRestartFlushStrategy::Config adjustConfig(const PrepareRestartFlushStrategy::Config &cfg) const;
+
+    /**
+     * Predicts the time needed to replay the transaction log of all
+     * handlers, from the oldest flushed serial number of each handler.
+     * Returns zero until the replay speed has been observed.
+     */
+    vespalib::duration predictReplayTime(const FlushContext::List &targetList,
+                                         const TlsStatsMap &tlsStatsMap) const;
+};
+
+}
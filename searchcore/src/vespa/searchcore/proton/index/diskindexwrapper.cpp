@@ -12,25 +12,29 @@ namespace proton {
 
 DiskIndexWrapper::DiskIndexWrapper(const vespalib::string &indexDir,
                                    const TuneFileSearch &tuneFileSearch,
-                                   size_t cacheSize)
+                                   size_t cacheSize,
+                                   uint32_t asyncReadThreads)
     : _index(indexDir, cacheSize),
       _serialNum(0)
 {
     bool setupIndexOk = _index.setup(tuneFileSearch);
     assert(setupIndexOk);
     (void) setupIndexOk;
+    _index.enableAsyncReads(asyncReadThreads);
     _serialNum = IndexReadUtilities::readSerialNum(indexDir);
 }
 
 DiskIndexWrapper::DiskIndexWrapper(const DiskIndexWrapper &oldIndex,
                                    const TuneFileSearch &tuneFileSearch,
-                                   size_t cacheSize)
+                                   size_t cacheSize,
+                                   uint32_t asyncReadThreads)
     : _index(oldIndex._index.getIndexDir(), cacheSize),
       _serialNum(0)
 {
     bool setupIndexOk = _index.setup(tuneFileSearch, oldIndex._index);
     assert(setupIndexOk);
     (void) setupIndexOk;
+    _index.enableAsyncReads(asyncReadThreads);
     _serialNum = oldIndex.getSerialNum();
 }
 
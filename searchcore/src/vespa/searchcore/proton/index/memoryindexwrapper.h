@@ -22,6 +22,7 @@ private:
     std::atomic<SerialNum> _serialNum;
     const search::common::FileHeaderContext &_fileHeaderContext;
     const search::TuneFileIndexing _tuneFileIndexing;
+    vespalib::ThreadExecutor &_flushExecutor;
 
 public:
     MemoryIndexWrapper(const search::index::Schema& schema,
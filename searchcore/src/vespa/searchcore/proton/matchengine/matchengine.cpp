@@ -1,6 +1,7 @@
 // Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 #include "matchengine.h"
 #include <vespa/searchcore/proton/common/state_reporter_utils.h>
+#include <vespa/searchcore/proton/matching/load_adapted_thread_bundle.h>
 #include <vespa/searchlib/fef/indexproperties.h>
 #include <vespa/vespalib/data/slime/cursor.h>
 #include <vespa/vespalib/data/smart_buffer.h>
@@ -35,21 +36,44 @@ public:
 };
 
 
+class AdmissionTask : public vespalib::Executor::Task {
+private:
+    proton::MatchEngine &_engine;
+
+public:
+    AdmissionTask(proton::MatchEngine &engine)
+        : _engine(engine)
+    {
+    }
+
+    void run() override {
+        _engine.performNextSearch();
+    }
+};
+
 } // namespace anon
 
 namespace proton {
 
 using namespace vespalib::slime;
 
-MatchEngine::MatchEngine(size_t numThreads, size_t threadsPerSearch, uint32_t distributionKey)
+MatchEngine::MatchEngine(size_t numThreads, size_t threadsPerSearch, uint32_t distributionKey,
+                         bool adaptiveThreadsPerSearch)
     : _lock(),
       _distributionKey(distributionKey),
       _closed(false),
       _handlers(),
       _executor(std::max(size_t(1), numThreads / threadsPerSearch), 256 * 1024),
-      _threadBundlePool(std::max(size_t(1), threadsPerSearch)),
-      _nodeUp(false)
+      _threadsPerSearch(std::max(size_t(1), threadsPerSearch)),
+      _threadBundlePools(),
+      _numaNodes(),
+      _nextNumaNode(0),
+      _nodeUp(false),
+      _adaptiveThreadsPerSearch(adaptiveThreadsPerSearch),
+      _activeSearches(0),
+      _admissionQueue()
 {
+    _threadBundlePools.push_back(std::make_unique<vespalib::SimpleThreadBundle::Pool>(_threadsPerSearch));
 }
 
 MatchEngine::~MatchEngine()
@@ -104,10 +128,87 @@ MatchEngine::search(search::engine::SearchRequest::Source request,
 
         return ret;
     }
-    _executor.execute(std::make_unique<SearchTask>(*this, std::move(request), client));
+    _activeSearches.fetch_add(1, std::memory_order_relaxed);
+    if (_admissionQueue) {
+        const search::engine::SearchRequest *searchRequest = request.get();
+        uint32_t priority = (searchRequest != nullptr)
+                            ? search::fef::indexproperties::admission::Priority::lookup(searchRequest->propertiesMap.modelOverrides())
+                            : search::fef::indexproperties::admission::Priority::DEFAULT_VALUE;
+        _admissionQueue->push(std::move(request), client, priority);
+        _executor.execute(std::make_unique<AdmissionTask>(*this));
+    } else {
+        _executor.execute(std::make_unique<SearchTask>(*this, std::move(request), client));
+    }
     return search::engine::SearchReply::UP();
 }
 
+void
+MatchEngine::enableAdmissionControl(double costFactor)
+{
+    _admissionQueue = std::make_unique<SearchAdmissionQueue>(costFactor);
+}
+
+void
+MatchEngine::enableNumaAwareThreadBundles(std::vector<vespalib::NumaTopology::CpuList> nodes)
+{
+    if (nodes.size() < 2) {
+        return;
+    }
+    _threadBundlePools.clear();
+    for (const auto &cpus : nodes) {
+        _threadBundlePools.push_back(std::make_unique<vespalib::SimpleThreadBundle::Pool>(_threadsPerSearch, cpus));
+    }
+    _numaNodes = std::move(nodes);
+    LOG(info, "Using NUMA aware thread bundles for %zu nodes", _numaNodes.size());
+}
+
+SearchAdmissionQueue::Stats
+MatchEngine::getAdmissionStats()
+{
+    return _admissionQueue ? _admissionQueue->getStats() : SearchAdmissionQueue::Stats();
+}
+
+void
+MatchEngine::performNextSearch()
+{
+    SearchAdmissionQueue::Decision decision = SearchAdmissionQueue::Decision::ADMIT;
+    auto entry = _admissionQueue->pop(decision);
+    if (!entry) {
+        return;
+    }
+    if (decision != SearchAdmissionQueue::Decision::ADMIT) {
+        shedSearch(std::move(entry->request), entry->client);
+        return;
+    }
+    vespalib::steady_time start = vespalib::steady_clock::now();
+    performSearch(std::move(entry->request), entry->client);
+    _admissionQueue->reportSearchTime(entry->priority, vespalib::steady_clock::now() - start);
+}
+
+void
+MatchEngine::shedSearch(search::engine::SearchRequest::Source req, search::engine::SearchClient &client)
+{
+    auto ret = std::make_unique<search::engine::SearchReply>();
+    ret->coverage.degradeTimeout();
+    ret->request = req.release();
+    ret->setDistributionKey(_distributionKey);
+    _activeSearches.fetch_sub(1, std::memory_order_relaxed);
+    client.searchDone(std::move(ret));
+}
+
+size_t
+MatchEngine::loadTargetThreads(size_t threadsPerSearch) const
+{
+    // Share the search threads evenly between active searches when
+    // there are more of them than searches executed concurrently.
+    size_t active = getNumActiveSearches();
+    size_t concurrent = _executor.getNumThreads();
+    if (active <= concurrent) {
+        return threadsPerSearch;
+    }
+    return std::max(size_t(1), (threadsPerSearch * concurrent) / active);
+}
+
 void
 MatchEngine::performSearch(search::engine::SearchRequest::Source req,
                            search::engine::SearchClient &client)
@@ -119,14 +220,26 @@ MatchEngine::performSearch(search::engine::SearchRequest::Source req,
         // 3 is the minimum level required for backend tracing.
         searchRequest->setTraceLevel(search::fef::indexproperties::trace::Level::lookup(searchRequest->propertiesMap.modelOverrides(), searchRequest->getTraceLevel()), 3);
         ISearchHandler::SP searchHandler;
-        vespalib::SimpleThreadBundle::UP threadBundle = _threadBundlePool.obtain();
+        size_t node = 0;
+        if (!_numaNodes.empty()) {
+            node = _nextNumaNode.fetch_add(1, std::memory_order_relaxed) % _numaNodes.size();
+            vespalib::NumaTopology::pinCurrentThread(_numaNodes[node]);
+        }
+        vespalib::SimpleThreadBundle::Pool &threadBundlePool = *_threadBundlePools[node];
+        vespalib::SimpleThreadBundle::UP threadBundle = threadBundlePool.obtain();
         { // try to find the match handler corresponding to the specified search doc type
             DocTypeName docTypeName(*searchRequest);
             std::lock_guard<std::mutex> guard(_lock);
             searchHandler = _handlers.getHandler(docTypeName);
         }
+        std::unique_ptr<matching::LoadAdaptedThreadBundle> adapted;
+        vespalib::ThreadBundle *bundle = threadBundle.get();
+        if (_adaptiveThreadsPerSearch) {
+            adapted = std::make_unique<matching::LoadAdaptedThreadBundle>(*threadBundle, loadTargetThreads(threadBundle->size()));
+            bundle = adapted.get();
+        }
         if (searchHandler) {
-            ret = searchHandler->match(*searchRequest, *threadBundle);
+            ret = searchHandler->match(*searchRequest, *bundle);
         } else {
             HandlerMap<ISearchHandler>::Snapshot snapshot;
             {
@@ -134,10 +247,11 @@ MatchEngine::performSearch(search::engine::SearchRequest::Source req,
                 snapshot = _handlers.snapshot();
             }
             if (snapshot.valid()) {
-                ret = snapshot.get()->match(*searchRequest, *threadBundle); // use the first handler
+                ret = snapshot.get()->match(*searchRequest, *bundle); // use the first handler
             }
         }
-        _threadBundlePool.release(std::move(threadBundle));
+        adapted.reset();
+        threadBundlePool.release(std::move(threadBundle));
     }
     ret->request = req.release();
     ret->setDistributionKey(_distributionKey);
@@ -149,6 +263,7 @@ MatchEngine::performSearch(search::engine::SearchRequest::Source req,
         vespalib::slime::BinaryFormat::encode(ret->request->trace().getSlime(), output);
         trace.add("slime", output.obtain().make_stringref());
     }
+    _activeSearches.fetch_sub(1, std::memory_order_relaxed);
     client.searchDone(std::move(ret));
 }
 
@@ -1,6 +1,7 @@
 // Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 #pragma once
 
+#include "search_admission_queue.h"
 #include <vespa/searchcore/proton/summaryengine/isearchhandler.h>
 #include <vespa/searchcore/proton/common/doctypename.h>
 #include <vespa/searchcore/proton/common/handlermap.hpp>
@@ -9,6 +10,7 @@
 #include <vespa/vespalib/net/state_explorer.h>
 #include <vespa/vespalib/util/threadstackexecutor.h>
 #include <vespa/vespalib/util/simple_thread_bundle.h>
+#include <atomic>
 #include <mutex>
 
 namespace proton {
@@ -22,8 +24,17 @@ private:
     bool                               _closed;
     HandlerMap<ISearchHandler>         _handlers;
     vespalib::ThreadStackExecutor      _executor;
-    vespalib::SimpleThreadBundle::Pool _threadBundlePool;
+    const size_t                       _threadsPerSearch;
+    std::vector<std::unique_ptr<vespalib::SimpleThreadBundle::Pool>> _threadBundlePools;
+    std::vector<vespalib::NumaTopology::CpuList> _numaNodes;
+    std::atomic<size_t>                _nextNumaNode;
     bool                               _nodeUp;
+    const bool                         _adaptiveThreadsPerSearch;
+    std::atomic<size_t>                _activeSearches;
+    std::unique_ptr<SearchAdmissionQueue> _admissionQueue;
+
+    size_t loadTargetThreads(size_t threadsPerSearch) const;
+    void shedSearch(search::engine::SearchRequest::Source req, search::engine::SearchClient &client);
 
 public:
     /**
@@ -43,8 +54,12 @@ public:
      * @param numThreads Number of threads allocated for handling search requests.
      * @param threadsPerSearch number of threads used for each search
      * @param distributionKey distributionkey of this node.
+     * @param adaptiveThreadsPerSearch reduce the number of threads used
+     *                                 for each search when more searches
+     *                                 are active than there are search threads.
      */
-    MatchEngine(size_t numThreads, size_t threadsPerSearch, uint32_t distributionKey);
+    MatchEngine(size_t numThreads, size_t threadsPerSearch, uint32_t distributionKey,
+                bool adaptiveThreadsPerSearch = false);
 
     /**
      * Frees any allocated resources. this will also stop all internal threads
@@ -59,6 +74,36 @@ public:
      **/
     vespalib::ThreadStackExecutor::Stats getExecutorStats() { return _executor.getStats(); }
 
+    /**
+     * Returns the number of searches that are queued or being performed.
+     **/
+    size_t getNumActiveSearches() const { return _activeSearches.load(std::memory_order_relaxed); }
+
+    /**
+     * Queue searches by priority instead of arrival order, and shed
+     * searches that have timed out or whose remaining time is shorter
+     * than costFactor times the average search time of their priority
+     * while waiting in the queue. Must be called before searching.
+     **/
+    void enableAdmissionControl(double costFactor);
+
+    /**
+     * Observe and reset admission stats. Returns empty stats when
+     * admission control is not enabled.
+     **/
+    SearchAdmissionQueue::Stats getAdmissionStats();
+
+    /**
+     * Keep one thread bundle pool per NUMA node, with the bundle threads
+     * pinned to the CPUs of that node. Each search is performed with a
+     * bundle from a single node (round robin), and the search thread is
+     * pinned to the same node while performing it. Nothing is changed
+     * when there are less than two nodes. Must be called before
+     * searching.
+     **/
+    void enableNumaAwareThreadBundles(std::vector<vespalib::NumaTopology::CpuList> nodes);
+    size_t getNumThreadBundlePools() const { return _threadBundlePools.size(); }
+
     /**
      * Closes the request handler interface. This will prevent any more data
      * from entering this object, allowing you to flush all pending operations
@@ -112,6 +157,13 @@ public:
     void performSearch(search::engine::SearchRequest::Source req,
                        search::engine::SearchClient &client);
 
+    /**
+     * Performs or sheds the most urgent search waiting in the admission
+     * queue. This method is used by the internal worker threads when
+     * admission control is enabled.
+     */
+    void performNextSearch();
+
     /** obtain current online status */
     bool isOnline() const;
 
@@ -0,0 +1,115 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "search_admission_queue.h"
+
+using search::engine::SearchClient;
+using search::engine::SearchRequest;
+
+namespace proton {
+
+namespace {
+
+// weight of the latest search when updating the average search time
+constexpr double searchTimeWeight = 0.1;
+
+}
+
+SearchAdmissionQueue::SearchAdmissionQueue(double costFactor)
+    : _lock(),
+      _queues(),
+      _searchTime(),
+      _costFactor(costFactor),
+      _stats()
+{
+}
+
+SearchAdmissionQueue::~SearchAdmissionQueue() = default;
+
+void
+SearchAdmissionQueue::push(SearchRequest::Source request, SearchClient &client, uint32_t priority)
+{
+    auto entry = std::make_unique<Entry>(std::move(request), client, priority);
+    std::lock_guard<std::mutex> guard(_lock);
+    _queues[priority].push_back(std::move(entry));
+}
+
+std::unique_ptr<SearchAdmissionQueue::Entry>
+SearchAdmissionQueue::pop(Decision &decision)
+{
+    std::lock_guard<std::mutex> guard(_lock);
+    auto itr = _queues.begin();
+    if (itr == _queues.end()) {
+        return std::unique_ptr<Entry>();
+    }
+    std::unique_ptr<Entry> entry = std::move(itr->second.front());
+    itr->second.pop_front();
+    if (itr->second.empty()) {
+        _queues.erase(itr);
+    }
+    const SearchRequest *request = entry->request.get();
+    decision = Decision::ADMIT;
+    if (request != nullptr) {
+        vespalib::duration timeLeft = request->getTimeLeft();
+        auto searchTime = _searchTime.find(entry->priority);
+        if (timeLeft <= vespalib::duration::zero()) {
+            decision = Decision::SHED_EXPIRED;
+        } else if ((_costFactor > 0.0) && (searchTime != _searchTime.end()) &&
+                   (timeLeft < std::chrono::duration_cast<vespalib::duration>(searchTime->second * _costFactor)))
+        {
+            decision = Decision::SHED_COST;
+        }
+    }
+    switch (decision) {
+    case Decision::ADMIT:        ++_stats.admitted; break;
+    case Decision::SHED_EXPIRED: ++_stats.shedExpired; break;
+    case Decision::SHED_COST:    ++_stats.shedCost; break;
+    }
+    return entry;
+}
+
+void
+SearchAdmissionQueue::reportSearchTime(uint32_t priority, vespalib::duration searchTime)
+{
+    std::lock_guard<std::mutex> guard(_lock);
+    auto itr = _searchTime.find(priority);
+    if (itr == _searchTime.end()) {
+        _searchTime[priority] = searchTime;
+    } else {
+        itr->second = std::chrono::duration_cast<vespalib::duration>(itr->second * (1.0 - searchTimeWeight) +
+                                                                     searchTime * searchTimeWeight);
+    }
+}
+
+vespalib::duration
+SearchAdmissionQueue::getExpectedSearchTime(uint32_t priority) const
+{
+    std::lock_guard<std::mutex> guard(_lock);
+    auto itr = _searchTime.find(priority);
+    return (itr != _searchTime.end()) ? itr->second : vespalib::duration::zero();
+}
+
+size_t
+SearchAdmissionQueue::size() const
+{
+    std::lock_guard<std::mutex> guard(_lock);
+    size_t result = 0;
+    for (const auto &queue : _queues) {
+        result += queue.second.size();
+    }
+    return result;
+}
+
+SearchAdmissionQueue::Stats
+SearchAdmissionQueue::getStats()
+{
+    Stats result;
+    {
+        std::lock_guard<std::mutex> guard(_lock);
+        result = _stats;
+        _stats = Stats();
+    }
+    result.queued = size();
+    return result;
+}
+
+}
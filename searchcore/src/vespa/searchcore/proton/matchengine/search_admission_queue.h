@@ -0,0 +1,90 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <vespa/searchlib/engine/searchapi.h>
+#include <vespa/vespalib/util/time.h>
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+
+namespace proton {
+
+/**
+ * Queue of search requests waiting for a search thread. Requests with
+ * higher priority are dequeued first, requests with the same priority
+ * in arrival order. The queue also tracks the average time used by
+ * searches of each priority, which is used to shed searches that cannot
+ * complete before their timeout.
+ */
+class SearchAdmissionQueue
+{
+public:
+    struct Entry {
+        search::engine::SearchRequest::Source  request;
+        search::engine::SearchClient          &client;
+        uint32_t                               priority;
+
+        Entry(search::engine::SearchRequest::Source request_in,
+              search::engine::SearchClient &client_in, uint32_t priority_in)
+            : request(std::move(request_in)),
+              client(client_in),
+              priority(priority_in)
+        { }
+    };
+
+    struct Stats {
+        uint64_t admitted;
+        uint64_t shedExpired;
+        uint64_t shedCost;
+        size_t   queued;
+        Stats() : admitted(0), shedExpired(0), shedCost(0), queued(0) { }
+    };
+
+    enum class Decision { ADMIT, SHED_EXPIRED, SHED_COST };
+
+private:
+    using Queue = std::deque<std::unique_ptr<Entry>>;
+
+    mutable std::mutex                                        _lock;
+    std::map<uint32_t, Queue, std::greater<uint32_t>>         _queues;
+    std::map<uint32_t, vespalib::duration>                    _searchTime;
+    const double                                              _costFactor;
+    Stats                                                     _stats;
+
+public:
+    /**
+     * @param costFactor searches with less time left than this factor
+     *                   times the average search time of their priority
+     *                   are shed (0 disables cost based shedding).
+     */
+    explicit SearchAdmissionQueue(double costFactor);
+    ~SearchAdmissionQueue();
+
+    void push(search::engine::SearchRequest::Source request,
+              search::engine::SearchClient &client, uint32_t priority);
+
+    /**
+     * Returns the most urgent queued request, or an empty pointer if the
+     * queue is empty. The decision tells whether the request should be
+     * performed or shed.
+     */
+    std::unique_ptr<Entry> pop(Decision &decision);
+
+    /**
+     * Reports the time used to perform a search with the given priority.
+     */
+    void reportSearchTime(uint32_t priority, vespalib::duration searchTime);
+
+    vespalib::duration getExpectedSearchTime(uint32_t priority) const;
+    size_t size() const;
+
+    /**
+     * Observe and reset admission stats.
+     */
+    Stats getStats();
+};
+
+}
@@ -5,6 +5,7 @@
 #include <vespa/searchlib/fef/matchdatalayout.h>
 #include <vespa/searchlib/query/tree/range.h>
 #include <vespa/searchlib/query/tree/simplequery.h>
+#include <algorithm>
 
 using namespace search::queryeval;
 using namespace search::query;
@@ -28,6 +29,8 @@ AttributeLimiter::AttributeLimiter(Searchable &searchable_attributes,
       _lock(),
       _match_datas(),
       _blueprint(),
+      _ordered_hits(),
+      _ordered_rounds(0),
       _estimatedHits(-1),
       _diversityCutoffFactor(diversityCutoffFactor),
       _diversityCutoffStrategy(diversityCutoffStrategy)
@@ -41,6 +44,37 @@ namespace {
 vespalib::string STRICT_STR("strict");
 vespalib::string LOOSE_STR("loose");
 
+/**
+ * Strict iterator over a sorted list of document ids.
+ **/
+class OrderedHitsSearch : public SearchIterator
+{
+private:
+    using Hits = std::vector<uint32_t>;
+    std::shared_ptr<const Hits> _hits;
+    Hits::const_iterator        _pos;
+
+public:
+    OrderedHitsSearch(std::shared_ptr<const Hits> hits)
+        : _hits(std::move(hits)),
+          _pos(_hits->begin())
+    {}
+    void initRange(uint32_t begin, uint32_t end) override {
+        SearchIterator::initRange(begin, end);
+        _pos = std::lower_bound(_hits->begin(), _hits->end(), begin);
+    }
+    void doSeek(uint32_t docid) override {
+        _pos = std::lower_bound(_pos, _hits->end(), docid);
+        if ((_pos == _hits->end()) || isAtEnd(*_pos)) {
+            setAtEnd();
+        } else {
+            setDocId(*_pos);
+        }
+    }
+    void doUnpack(uint32_t) override {}
+    vespalib::Trinary is_strict() const override { return vespalib::Trinary::True; }
+};
+
 }
 
 AttributeLimiter::DiversityCutoffStrategy
@@ -55,6 +89,29 @@ AttributeLimiter::toString(DiversityCutoffStrategy strategy)
     return (strategy == DiversityCutoffStrategy::STRICT) ? STRICT_STR : LOOSE_STR;
 }
 
+Blueprint::UP
+AttributeLimiter::create_blueprint(size_t want_hits, size_t max_group_size, bool strictSearch,
+                                   search::fef::TermFieldHandle handle)
+{
+    const uint32_t my_field_id = 0;
+    const uint32_t no_unique_id = 0;
+    string range_spec = make_string("[;;%s%zu", (_descending)? "-" : "", want_hits);
+    if (max_group_size < want_hits) {
+        size_t cutoffGroups = (_diversityCutoffFactor*want_hits)/max_group_size;
+        range_spec.append(make_string(";%s;%zu;%zu;%s]", _diversity_attribute.c_str(), max_group_size,
+                                      cutoffGroups, toString(_diversityCutoffStrategy).c_str()));
+    } else {
+        range_spec.push_back(']');
+    }
+    Range range(range_spec);
+    SimpleRangeTerm node(range, _attribute_name, no_unique_id, Weight(0));
+    FieldSpecList field; // single field API is protected
+    field.add(FieldSpec(_attribute_name, my_field_id, handle));
+    Blueprint::UP blueprint = _searchable_attributes.createBlueprint(_requestContext, field, node);
+    blueprint->fetchPostings(ExecuteInfo::create(strictSearch));
+    return blueprint;
+}
+
 SearchIterator::UP
 AttributeLimiter::create_search(size_t want_hits, size_t max_group_size, bool strictSearch)
 {
@@ -63,21 +120,7 @@ AttributeLimiter::create_search(size_t want_hits, size_t max_group_size, bool st
     search::fef::MatchDataLayout layout;
     auto my_handle = layout.allocTermField(my_field_id);
     if ( ! _blueprint ) {
-        const uint32_t no_unique_id = 0;
-        string range_spec = make_string("[;;%s%zu", (_descending)? "-" : "", want_hits);
-        if (max_group_size < want_hits) {
-            size_t cutoffGroups = (_diversityCutoffFactor*want_hits)/max_group_size;
-            range_spec.append(make_string(";%s;%zu;%zu;%s]", _diversity_attribute.c_str(), max_group_size,
-                                          cutoffGroups, toString(_diversityCutoffStrategy).c_str()));
-        } else {
-            range_spec.push_back(']');
-        }
-        Range range(range_spec);
-        SimpleRangeTerm node(range, _attribute_name, no_unique_id, Weight(0));
-        FieldSpecList field; // single field API is protected
-        field.add(FieldSpec(_attribute_name, my_field_id, my_handle));
-        _blueprint = _searchable_attributes.createBlueprint(_requestContext, field, node);
-        _blueprint->fetchPostings(ExecuteInfo::create(strictSearch));
+        _blueprint = create_blueprint(want_hits, max_group_size, strictSearch, my_handle);
         _estimatedHits = _blueprint->getState().estimate().estHits;
         _blueprint->freeze();
     }
@@ -85,4 +128,42 @@ AttributeLimiter::create_search(size_t want_hits, size_t max_group_size, bool st
     return _blueprint->createSearch(*_match_datas.back(), strictSearch);
 }
 
+SearchIterator::UP
+AttributeLimiter::create_ordered_search(SearchIterator &query, size_t want_hits, size_t first_docs,
+                                        size_t max_docs, uint32_t docid_limit)
+{
+    std::lock_guard<std::mutex> guard(_lock);
+    if ( ! _ordered_hits ) {
+        const uint32_t my_field_id = 0;
+        auto hits = std::make_shared<std::vector<uint32_t>>();
+        size_t num_docs = std::max(size_t(1), std::min(first_docs, max_docs));
+        for (;;) {
+            search::fef::MatchDataLayout layout;
+            auto my_handle = layout.allocTermField(my_field_id);
+            Blueprint::UP blueprint = create_blueprint(num_docs, num_docs, true, my_handle);
+            blueprint->freeze();
+            auto match_data = layout.createMatchData();
+            SearchIterator::UP docs = blueprint->createSearch(*match_data, true);
+            docs->initRange(1, docid_limit);
+            query.initRange(1, docid_limit);
+            hits->clear();
+            size_t evaluated = 0;
+            for (uint32_t docid = docs->seekFirst(1); !docs->isAtEnd(docid); docid = docs->seekNext(docid + 1)) {
+                ++evaluated;
+                if (query.seek(docid)) {
+                    hits->push_back(docid);
+                }
+            }
+            ++_ordered_rounds;
+            _estimatedHits = evaluated;
+            if ((hits->size() >= want_hits) || (evaluated < num_docs) || (num_docs >= max_docs)) {
+                break;
+            }
+            num_docs = std::min(num_docs * 2, max_docs);
+        }
+        _ordered_hits = std::move(hits);
+    }
+    return std::make_unique<OrderedHitsSearch>(_ordered_hits);
+}
+
 }
@@ -32,11 +32,29 @@ public:
                      DiversityCutoffStrategy diversityCutoffStrategy);
     ~AttributeLimiter();
     search::queryeval::SearchIterator::UP create_search(size_t want_hits, size_t max_group_size, bool strictSearch);
-    bool was_used() const { return ((!_match_datas.empty()) || (_blueprint.get() != nullptr)); }
+
+    /**
+     * Create a strict search iterator over the documents matched by
+     * the given query among the documents ordered first by the
+     * attribute. The documents are evaluated in attribute order in
+     * rounds of doubling size, starting with first_docs documents,
+     * until at least want_hits matches are found, max_docs documents
+     * have been evaluated or there are no more documents with a
+     * value. The first thread asking does the evaluation using its
+     * query iterator (which must be initialized again after this
+     * call), other threads share the matches found.
+     **/
+    search::queryeval::SearchIterator::UP create_ordered_search(search::queryeval::SearchIterator &query,
+                                                                size_t want_hits, size_t first_docs,
+                                                                size_t max_docs, uint32_t docid_limit);
+    bool was_used() const { return ((!_match_datas.empty()) || (_blueprint.get() != nullptr) || _ordered_hits); }
     ssize_t getEstimatedHits() const { return _estimatedHits; }
+    size_t getOrderedRounds() const { return _ordered_rounds; }
     static DiversityCutoffStrategy toDiversityCutoffStrategy(vespalib::stringref strategy);
 private:
     const vespalib::string & toString(DiversityCutoffStrategy strategy);
+    search::queryeval::Blueprint::UP create_blueprint(size_t want_hits, size_t max_group_size, bool strictSearch,
+                                                      search::fef::TermFieldHandle handle);
     search::queryeval::Searchable            & _searchable_attributes;
     const search::queryeval::IRequestContext & _requestContext;
     vespalib::string                           _attribute_name;
@@ -45,6 +63,8 @@ private:
     std::mutex                                 _lock;
     std::vector<search::fef::MatchData::UP>    _match_datas;
     search::queryeval::Blueprint::UP           _blueprint;
+    std::shared_ptr<const std::vector<uint32_t>> _ordered_hits;
+    size_t                                     _ordered_rounds;
     ssize_t                                    _estimatedHits;
     double                                     _diversityCutoffFactor;
     DiversityCutoffStrategy                    _diversityCutoffStrategy;
@@ -92,6 +92,25 @@ get_feature_set(const MatchToolsFactory &mtf,
     return retval;
 }
 
+FeatureSet::UP
+get_captured_feature_set(const MatchToolsFactory &mtf,
+                         const FeatureSet &captured,
+                         const std::vector<uint32_t> &docs)
+{
+    auto retval = std::make_unique<FeatureSet>(captured.getNames(), docs.size());
+    for (uint32_t docId : docs) {
+        const auto *src = captured.getFeaturesByDocId(docId);
+        auto * f = retval->getFeaturesByIndex(retval->addDocId(docId));
+        for (uint32_t j = 0; j < captured.numFeatures(); ++j) {
+            f[j] = src[j];
+        }
+    }
+    if (auto onSummaryTask = mtf.createOnSummaryTask()) {
+        onSummaryTask->run(docs);
+    }
+    return retval;
+}
+
 template<typename T>
 const T *as(const Blueprint &bp) { return dynamic_cast<const T *>(&bp); }
 
@@ -189,6 +208,12 @@ DocsumMatcher::get_summary_features() const
     if (!_mtf) {
         return std::make_unique<FeatureSet>();
     }
+    if (_from_session) {
+        const FeatureSet *captured = _from_session->getSummaryFeatures();
+        if ((captured != nullptr) && captured->contains(_docs)) {
+            return get_captured_feature_set(*_mtf, *captured, _docs);
+        }
+    }
     return get_feature_set(*_mtf, _docs, true);
 }
 
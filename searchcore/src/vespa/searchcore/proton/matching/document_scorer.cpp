@@ -1,6 +1,7 @@
 // Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 
 #include "document_scorer.h"
+#include <algorithm>
 #include <cassert>
 
 using search::feature_t;
@@ -25,15 +26,63 @@ extractScoreFeature(const RankProgram &rankProgram)
 
 DocumentScorer::DocumentScorer(RankProgram &rankProgram,
                                SearchIterator &searchItr)
-    : _searchItr(searchItr),
-      _scoreFeature(extractScoreFeature(rankProgram))
+    : _rankProgram(rankProgram),
+      _searchItr(searchItr),
+      _scoreFeature(extractScoreFeature(rankProgram)),
+      _capturedFeatures(),
+      _captured()
 {
 }
 
+DocumentScorer::~DocumentScorer() = default;
+
+bool
+DocumentScorer::capture_features(const std::vector<vespalib::string> &names)
+{
+    FeatureResolver resolver(_rankProgram.get_all_features(false));
+    std::vector<LazyValue> features;
+    for (const auto &name : names) {
+        size_t i = 0;
+        while ((i < resolver.num_features()) && (resolver.name_of(i) != name)) {
+            ++i;
+        }
+        if ((i == resolver.num_features()) || resolver.is_object(i)) {
+            return false;
+        }
+        features.push_back(resolver.resolve(i));
+    }
+    _capturedFeatures = std::move(features);
+    _captured = std::make_unique<CapturedFeatures>();
+    return true;
+}
+
 feature_t
 DocumentScorer::score(uint32_t docId)
 {
     return doScore(docId);
 }
 
+void
+DocumentScorer::scoreHits(vespalib::ArrayRef<Hit> hits)
+{
+    if (!_rankProgram.can_prefetch()) {
+        for (auto &hit : hits) {
+            hit.second = doScore(hit.first);
+        }
+        return;
+    }
+    for (size_t begin = 0; begin < hits.size(); begin += RankProgram::BATCH_SIZE) {
+        size_t end = std::min(hits.size(), begin + RankProgram::BATCH_SIZE);
+        _rankProgram.start_prefetch(end - begin);
+        for (size_t i = begin; i < end; ++i) {
+            _searchItr.unpack(hits[i].first);
+            _rankProgram.prefetch(i - begin, hits[i].first);
+        }
+        _rankProgram.finish_prefetch();
+        for (size_t i = begin; i < end; ++i) {
+            hits[i].second = doScore(hits[i].first);
+        }
+    }
+}
+
 }
@@ -8,27 +8,71 @@
 
 namespace proton::matching {
 
+/**
+ * Feature values captured by a DocumentScorer; the values for the
+ * i'th document are stored in values[i * num_features, (i + 1) * num_features>.
+ **/
+struct CapturedFeatures {
+    std::vector<uint32_t> docids;
+    std::vector<search::feature_t> values;
+};
+
 /**
  * Class used to calculate the rank score for a set of documents using
  * a rank program for calculation and a search iterator for unpacking match data.
  * The calculateScore() function is always called in increasing docId order.
+ * If the rank program contains executors that can be prefetched (like
+ * onnx models with a batch dimension), hits are scored in blocks where
+ * all documents in a block are prefetched before being scored.
+ *
+ * Optionally, the values of a set of features calculated by the rank
+ * program may be captured for each scored document, to avoid having
+ * to calculate them again later (like when producing summary
+ * features).
  */
 class DocumentScorer : public search::queryeval::HitCollector::DocumentScorer
 {
 private:
+    search::fef::RankProgram &_rankProgram;
     search::queryeval::SearchIterator &_searchItr;
     search::fef::LazyValue _scoreFeature;
+    std::vector<search::fef::LazyValue> _capturedFeatures;
+    std::unique_ptr<CapturedFeatures> _captured;
+
+    using Hit = search::queryeval::HitCollector::Hit;
+
+    void capture(uint32_t docId) {
+        _captured->docids.push_back(docId);
+        for (const auto &feature : _capturedFeatures) {
+            _captured->values.push_back(feature.as_number(docId));
+        }
+    }
 
 public:
     DocumentScorer(search::fef::RankProgram &rankProgram,
                    search::queryeval::SearchIterator &searchItr);
+    ~DocumentScorer() override;
+
+    /**
+     * Capture the values of the given features for all documents
+     * scored from now on. Returns false (and captures nothing) if any
+     * of the features is not calculated by the rank program or is not
+     * a number.
+     **/
+    bool capture_features(const std::vector<vespalib::string> &names);
+    std::unique_ptr<CapturedFeatures> extract_captured_features() { return std::move(_captured); }
 
     search::feature_t doScore(uint32_t docId) {
         _searchItr.unpack(docId);
-        return _scoreFeature.as_number(docId);
+        search::feature_t score = _scoreFeature.as_number(docId);
+        if (_captured) {
+            capture(docId);
+        }
+        return score;
     }
 
     virtual search::feature_t score(uint32_t docId) override;
+    void scoreHits(vespalib::ArrayRef<Hit> hits) override;
 };
 
 }
@@ -0,0 +1,112 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "global_filter_cache.h"
+#include <vespa/searchlib/common/bitvector.h>
+#include <vespa/searchlib/common/i_document_meta_store_context.h>
+#include <vespa/vespalib/objects/nbostream.h>
+
+namespace proton::matching {
+
+GlobalFilterCache::Binding::Binding(GlobalFilterCache &cache, vespalib::string key, ViewSP view,
+                                    vespalib::steady_time now)
+    : _cache(cache),
+      _key(std::move(key)),
+      _view(std::move(view)),
+      _now(now)
+{
+}
+
+GlobalFilterCache::Binding::~Binding() = default;
+
+GlobalFilterCache::BitVectorSP
+GlobalFilterCache::Binding::lookup(uint32_t docIdLimit) const
+{
+    return _cache.lookup(_key, _view, docIdLimit, _now);
+}
+
+void
+GlobalFilterCache::Binding::insert(uint32_t docIdLimit, BitVectorSP bitVector) const
+{
+    _cache.insert(_key, _view, docIdLimit, _now, std::move(bitVector));
+}
+
+GlobalFilterCache::GlobalFilterCache(size_t maxBytes, vespalib::duration maxAge)
+    : _lock(),
+      _cache(),
+      _owner(),
+      _maxBytes(maxBytes),
+      _maxAge(maxAge),
+      _numHits(0),
+      _numMisses(0)
+{
+}
+
+GlobalFilterCache::~GlobalFilterCache() = default;
+
+vespalib::string
+GlobalFilterCache::make_key(vespalib::stringref queryStack, const vespalib::string &location)
+{
+    vespalib::nbostream os;
+    os << location << queryStack;
+    return vespalib::string(os.peek(), os.size());
+}
+
+void
+GlobalFilterCache::adjust_owner(const ViewSP &view)
+{
+    if (_owner.lock() != view) {
+        _cache.clear();
+        _owner = view;
+    }
+}
+
+GlobalFilterCache::BitVectorSP
+GlobalFilterCache::lookup(const vespalib::string &key, const ViewSP &view, uint32_t docIdLimit,
+                          vespalib::steady_time now)
+{
+    std::lock_guard<std::mutex> guard(_lock);
+    adjust_owner(view);
+    Entry::SP entry = _cache.find(key);
+    if (!entry || (entry->docIdLimit != docIdLimit) || (entry->created + _maxAge < now)) {
+        ++_numMisses;
+        return BitVectorSP();
+    }
+    ++_numHits;
+    return entry->bitVector;
+}
+
+void
+GlobalFilterCache::insert(const vespalib::string &key, const ViewSP &view, uint32_t docIdLimit,
+                          vespalib::steady_time now, BitVectorSP bitVector)
+{
+    auto entry = std::make_shared<Entry>(search::IDocumentMetaStoreContext::IReadGuard::UP(),
+                                         std::move(bitVector), docIdLimit, now);
+    size_t bytes = entry->memoryUsage();
+    std::lock_guard<std::mutex> guard(_lock);
+    adjust_owner(view);
+    _cache.erase(key);
+    if (bytes > _maxBytes) {
+        return;
+    }
+    if (_cache.memoryUsage() + bytes > _maxBytes) {
+        _cache.removeOlderThan(now - _maxAge);
+    }
+    if (_cache.memoryUsage() + bytes > _maxBytes) {
+        _cache.clear();
+    }
+    _cache.insert(key, std::move(entry));
+}
+
+GlobalFilterCache::Stats
+GlobalFilterCache::get_stats() const
+{
+    std::lock_guard<std::mutex> guard(_lock);
+    Stats stats;
+    stats.numEntries = _cache.size();
+    stats.memoryUsage = _cache.memoryUsage();
+    stats.numHits = _numHits;
+    stats.numMisses = _numMisses;
+    return stats;
+}
+
+}
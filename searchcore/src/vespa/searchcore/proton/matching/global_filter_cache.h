@@ -0,0 +1,101 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <vespa/searchcore/proton/summaryengine/isearchhandler.h>
+#include <vespa/searchlib/attribute/bitvector_search_cache.h>
+#include <vespa/vespalib/stllike/string.h>
+#include <vespa/vespalib/util/time.h>
+#include <memory>
+#include <mutex>
+
+namespace search { class BitVector; }
+
+namespace proton::matching {
+
+/**
+ * Cache of global filters (as bit vectors) for a single rank profile,
+ * keyed on the serialized query tree and location. Concurrent queries
+ * with the same filter terms (like nearest neighbor queries where
+ * only the query tensor differs) can then share the global filter
+ * instead of evaluating it from scratch.
+ *
+ * Like the result cache, cached filters are only valid for the search
+ * view (search handler) that produced them, and are dropped when the
+ * cache is used through another search view. Filters older than a
+ * configured max age or created with another docid limit than the
+ * current one are never returned, putting an upper bound on the
+ * staleness caused by documents being fed without the search view
+ * changing.
+ **/
+class GlobalFilterCache
+{
+public:
+    using BitVectorSP = search::attribute::BitVectorSearchCache::BitVectorSP;
+    using ViewSP = std::shared_ptr<const ISearchHandler>;
+
+    /**
+     * The cache as seen by a single query.
+     **/
+    class Binding {
+    private:
+        GlobalFilterCache    &_cache;
+        vespalib::string      _key;
+        ViewSP                _view;
+        vespalib::steady_time _now;
+    public:
+        Binding(GlobalFilterCache &cache, vespalib::string key, ViewSP view, vespalib::steady_time now);
+        ~Binding();
+        BitVectorSP lookup(uint32_t docIdLimit) const;
+        void insert(uint32_t docIdLimit, BitVectorSP bitVector) const;
+    };
+
+    struct Stats {
+        size_t numEntries;
+        size_t memoryUsage;
+        size_t numHits;
+        size_t numMisses;
+        Stats() : numEntries(0), memoryUsage(0), numHits(0), numMisses(0) {}
+    };
+
+private:
+    using Entry = search::attribute::BitVectorSearchCache::Entry;
+
+    mutable std::mutex                    _lock;
+    search::attribute::BitVectorSearchCache _cache;
+    std::weak_ptr<const ISearchHandler>   _owner;
+    size_t                                _maxBytes;
+    vespalib::duration                    _maxAge;
+    size_t                                _numHits;
+    size_t                                _numMisses;
+
+    void adjust_owner(const ViewSP &view);
+
+public:
+    GlobalFilterCache(size_t maxBytes, vespalib::duration maxAge);
+    ~GlobalFilterCache();
+
+    /**
+     * Create the cache key for the given query.
+     **/
+    static vespalib::string make_key(vespalib::stringref queryStack, const vespalib::string &location);
+
+    /**
+     * Look up a cached global filter.
+     *
+     * @return the cached bit vector, or an empty pointer on cache miss.
+     **/
+    BitVectorSP lookup(const vespalib::string &key, const ViewSP &view, uint32_t docIdLimit,
+                       vespalib::steady_time now);
+
+    /**
+     * Insert a global filter into the cache. Filters too large for
+     * the cache are not inserted.
+     **/
+    void insert(const vespalib::string &key, const ViewSP &view, uint32_t docIdLimit,
+                vespalib::steady_time now, BitVectorSP bitVector);
+
+    Stats get_stats() const;
+};
+
+}
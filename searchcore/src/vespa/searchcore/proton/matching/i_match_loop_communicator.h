@@ -28,6 +28,10 @@ struct IMatchLoopCommunicator {
         }
     };
     virtual double estimate_match_frequency(const Matches &matches) = 0;
+    // publish the lowest score needed to enter the top hits of the
+    // calling thread and get the highest such score published by
+    // any thread so far; never blocks
+    virtual search::feature_t share_score_threshold(search::feature_t threshold) = 0;
     virtual Hits selectBest(SortedHitSequence sortedHits) = 0;
     virtual RangePair rangeCover(const RangePair &ranges) = 0;
     virtual ~IMatchLoopCommunicator() {}
@@ -0,0 +1,42 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <vespa/vespalib/util/thread_bundle.h>
+
+namespace proton::matching {
+
+/**
+ * Thread bundle wrapper used by the match engine to tell the matcher how
+ * many threads a search should use given the current search load. All
+ * threads of the wrapped bundle are still available, so the matcher can
+ * use more threads than the load target to honor the rank profile minimum.
+ */
+class LoadAdaptedThreadBundle final : public vespalib::ThreadBundle
+{
+private:
+    vespalib::ThreadBundle &_threadBundle;
+    const size_t            _targetThreads;
+
+public:
+    LoadAdaptedThreadBundle(vespalib::ThreadBundle &threadBundle, size_t targetThreads)
+        : _threadBundle(threadBundle),
+          _targetThreads(targetThreads)
+    { }
+    size_t size() const override { return _threadBundle.size(); }
+    void run(const std::vector<vespalib::Runnable*> &targets) override {
+        _threadBundle.run(targets);
+    }
+    size_t getTargetThreads() const { return _targetThreads; }
+
+    /**
+     * Returns the load target of the given thread bundle, or its size if
+     * it is not load adapted.
+     */
+    static size_t targetThreads(const vespalib::ThreadBundle &threadBundle) {
+        const auto *adapted = dynamic_cast<const LoadAdaptedThreadBundle *>(&threadBundle);
+        return (adapted != nullptr) ? adapted->getTargetThreads() : threadBundle.size();
+    }
+};
+
+}
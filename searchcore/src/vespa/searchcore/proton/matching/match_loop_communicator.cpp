@@ -2,6 +2,7 @@
 
 #include "match_loop_communicator.h"
 #include <vespa/vespalib/util/priority_queue.h>
+#include <cmath>
 
 namespace proton:: matching {
 
@@ -9,9 +10,14 @@ MatchLoopCommunicator::MatchLoopCommunicator(size_t threads, size_t topN)
     : MatchLoopCommunicator(threads, topN, std::unique_ptr<IDiversifier>())
 {}
 MatchLoopCommunicator::MatchLoopCommunicator(size_t threads, size_t topN, std::unique_ptr<IDiversifier> diversifier)
-    : _best_dropped(),
+    : MatchLoopCommunicator(threads, topN, std::move(diversifier), nullptr, topN)
+{}
+MatchLoopCommunicator::MatchLoopCommunicator(size_t threads, size_t topN, std::unique_ptr<IDiversifier> diversifier,
+                                             const vespalib::Doom *doom, size_t softDoomedTopN)
+    : _score_threshold(-HUGE_VAL),
+      _best_dropped(),
       _estimate_match_frequency(threads),
-      _selectBest(threads, topN, _best_dropped, std::move(diversifier)),
+      _selectBest(threads, topN, _best_dropped, std::move(diversifier), doom, softDoomedTopN),
       _rangeCover(threads, _best_dropped)
 {}
 MatchLoopCommunicator::~MatchLoopCommunicator() = default;
@@ -33,11 +39,14 @@ MatchLoopCommunicator::EstimateMatchFrequency::mingle()
     }
 }
 
-MatchLoopCommunicator::SelectBest::SelectBest(size_t n, size_t topN_in, BestDropped &best_dropped_in, std::unique_ptr<IDiversifier> diversifier)
+MatchLoopCommunicator::SelectBest::SelectBest(size_t n, size_t topN_in, BestDropped &best_dropped_in, std::unique_ptr<IDiversifier> diversifier,
+                                              const vespalib::Doom *doom, size_t softDoomedTopN)
     : vespalib::Rendezvous<SortedHitSequence, Hits>(n),
       topN(topN_in),
       best_dropped(best_dropped_in),
-      _diversifier(std::move(diversifier))
+      _diversifier(std::move(diversifier)),
+      _doom(doom),
+      _softDoomedTopN(softDoomedTopN)
 {}
 MatchLoopCommunicator::SelectBest::~SelectBest() = default;
 
@@ -68,6 +77,10 @@ MatchLoopCommunicator::SelectBest::mingle(Q &queue, F &&accept)
 void
 MatchLoopCommunicator::SelectBest::mingle()
 {
+    // decided here, so that all threads agree on it
+    if ((_doom != nullptr) && _doom->soft_doom()) {
+        topN = std::min(topN, _softDoomedTopN);
+    }
     size_t est_out = (topN / size()) + 16;
     vespalib::PriorityQueue<uint32_t, SelectCmp> queue(SelectCmp(*this));
     for (size_t i = 0; i < size(); ++i) {
@@ -4,7 +4,10 @@
 
 #include "i_match_loop_communicator.h"
 #include <vespa/searchlib/queryeval/idiversifier.h>
+#include <vespa/vespalib/util/doom.h>
 #include <vespa/vespalib/util/rendezvous.h>
+#include <algorithm>
+#include <atomic>
 
 namespace proton::matching {
 
@@ -24,7 +27,10 @@ private:
         size_t topN;
         BestDropped &best_dropped;
         std::unique_ptr<IDiversifier> _diversifier;
-        SelectBest(size_t n, size_t topN_in, BestDropped &best_dropped_in, std::unique_ptr<IDiversifier>);
+        const vespalib::Doom *_doom;
+        size_t _softDoomedTopN;
+        SelectBest(size_t n, size_t topN_in, BestDropped &best_dropped_in, std::unique_ptr<IDiversifier>,
+                   const vespalib::Doom *doom, size_t softDoomedTopN);
         ~SelectBest() override;
         void mingle() override;
         template<typename Q, typename F>
@@ -47,6 +53,7 @@ private:
         void mingle() override;
     };
 
+    std::atomic<search::feature_t> _score_threshold;
     BestDropped                   _best_dropped;
     EstimateMatchFrequency        _estimate_match_frequency;
     SelectBest                    _selectBest;
@@ -55,11 +62,24 @@ private:
 public:
     MatchLoopCommunicator(size_t threads, size_t topN);
     MatchLoopCommunicator(size_t threads, size_t topN, std::unique_ptr<IDiversifier>);
+    /**
+     * When the soft timeout has been reached before the hits for
+     * second phase ranking are selected, only the best softDoomedTopN
+     * hits are selected, to cut the time spent after the soft timeout.
+     **/
+    MatchLoopCommunicator(size_t threads, size_t topN, std::unique_ptr<IDiversifier>,
+                          const vespalib::Doom *doom, size_t softDoomedTopN);
     ~MatchLoopCommunicator();
 
     double estimate_match_frequency(const Matches &matches) override {
         return _estimate_match_frequency.rendezvous(matches);
     }
+    search::feature_t share_score_threshold(search::feature_t threshold) override {
+        search::feature_t current = _score_threshold.load(std::memory_order_relaxed);
+        while ((threshold > current) &&
+               !_score_threshold.compare_exchange_weak(current, threshold, std::memory_order_relaxed));
+        return std::max(current, threshold);
+    }
     Hits selectBest(SortedHitSequence sortedHits) override {
         return _selectBest.rendezvous(sortedHits);
     }
@@ -2,9 +2,11 @@
 
 #include "match_master.h"
 #include "docid_range_scheduler.h"
+#include "document_scorer.h"
 #include "match_loop_communicator.h"
 #include "match_thread.h"
 #include "match_tools.h"
+#include <vespa/searchlib/common/featureset.h>
 #include <vespa/searchlib/engine/trace.h>
 #include <vespa/vespalib/util/thread_bundle.h>
 #include <vespa/vespalib/data/slime/inserter.h>
@@ -12,6 +14,7 @@
 #include <vespa/vespalib/data/slime/cursor.h>
 #include <vespa/eval/eval/tensor_engine.h>
 #include <vespa/vespalib/objects/nbostream.h>
+#include <algorithm>
 
 #include <vespa/log/log.h>
 LOG_SETUP(".proton.matching.match_master");
@@ -32,6 +35,9 @@ struct TimedMatchLoopCommunicator : IMatchLoopCommunicator {
     double estimate_match_frequency(const Matches &matches) override {
         return communicator.estimate_match_frequency(matches);
     }
+    search::feature_t share_score_threshold(search::feature_t threshold) override {
+        return communicator.share_score_threshold(threshold);
+    }
     Hits selectBest(SortedHitSequence sortedHits) override {
         auto result = communicator.selectBest(sortedHits);
         timer = vespalib::Timer();
@@ -56,8 +62,45 @@ createScheduler(uint32_t numThreads, uint32_t numSearchPartitions, uint32_t numD
     return std::make_unique<TaskDocidRangeScheduler>(numThreads, numSearchPartitions, numDocs);
 }
 
+std::unique_ptr<FeatureSet>
+merge_captured_features(const std::vector<vespalib::string> &names,
+                        const std::vector<std::unique_ptr<CapturedFeatures>> &captured)
+{
+    struct Ref {
+        uint32_t docid;
+        const search::feature_t *values;
+        bool operator<(const Ref &rhs) const { return (docid < rhs.docid); }
+    };
+    std::vector<Ref> refs;
+    for (const auto &part : captured) {
+        if (!part) {
+            return std::unique_ptr<FeatureSet>();
+        }
+        for (size_t i = 0; i < part->docids.size(); ++i) {
+            refs.push_back(Ref{part->docids[i], &part->values[i * names.size()]});
+        }
+    }
+    std::sort(refs.begin(), refs.end());
+    auto result = std::make_unique<FeatureSet>(names, refs.size());
+    for (const auto &ref : refs) {
+        FeatureSet::Value *dst = result->getFeaturesByIndex(result->addDocId(ref.docid));
+        for (size_t i = 0; i < names.size(); ++i) {
+            dst[i].set_double(ref.values[i]);
+        }
+    }
+    return result;
+}
+
 } // namespace proton::matching::<unnamed>
 
+MatchMaster::MatchMaster()
+    : _stats(),
+      _captured_features()
+{
+}
+
+MatchMaster::~MatchMaster() = default;
+
 ResultProcessor::Result::UP
 MatchMaster::match(search::engine::Trace & trace,
                    const MatchParams &params,
@@ -69,7 +112,8 @@ MatchMaster::match(search::engine::Trace & trace,
 {
     vespalib::Timer query_latency_time;
     vespalib::DualMergeDirector mergeDirector(threadBundle.size());
-    MatchLoopCommunicator communicator(threadBundle.size(), params.heapSize, mtf.createDiversifier(params.heapSize));
+    MatchLoopCommunicator communicator(threadBundle.size(), params.heapSize, mtf.createDiversifier(params.heapSize),
+                                       &mtf.getRequestContext().getDoom(), params.offset + params.hits);
     TimedMatchLoopCommunicator timedCommunicator(communicator);
     DocidRangeScheduler::UP scheduler = createScheduler(threadBundle.size(), numSearchPartitions, params.numDocs);
 
@@ -110,6 +154,13 @@ MatchMaster::match(search::engine::Trace & trace,
     if (mtf.match_limiter().was_limited()) {
         _stats.limited_queries(1);        
     }
+    if (!mtf.captured_feature_names().empty()) {
+        std::vector<std::unique_ptr<CapturedFeatures>> captured;
+        for (const auto &matchThread : threadState) {
+            captured.push_back(matchThread->extract_captured_features());
+        }
+        _captured_features = merge_captured_features(mtf.captured_feature_names(), captured);
+    }
     return reply;
 }
 
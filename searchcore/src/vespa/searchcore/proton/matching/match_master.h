@@ -4,6 +4,7 @@
 
 #include "result_processor.h"
 #include "matching_stats.h"
+#include <memory>
 
 namespace vespalib { struct ThreadBundle; }
 namespace search { class FeatureSet; }
@@ -21,8 +22,11 @@ class MatchMaster
 {
 private:
     MatchingStats _stats;
+    std::unique_ptr<search::FeatureSet> _captured_features;
 
 public:
+    MatchMaster();
+    ~MatchMaster();
     const MatchingStats & getStats() const { return _stats; }
     ResultProcessor::Result::UP match(search::engine::Trace & trace,
                                       const MatchParams &params,
@@ -32,6 +36,13 @@ public:
                                       uint32_t distributionKey,
                                       uint32_t numSearchPartitions);
 
+    /**
+     * Obtain the features captured by all match threads during second
+     * phase ranking (see MatchToolsFactory::capture_summary_features),
+     * or nullptr if they could not be captured.
+     **/
+    std::unique_ptr<search::FeatureSet> extract_captured_features() { return std::move(_captured_features); }
+
     static MatchingStats getStats(MatchMaster && rhs) { return std::move(rhs._stats); }
 };
 
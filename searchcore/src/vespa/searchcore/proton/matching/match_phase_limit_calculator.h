@@ -33,6 +33,7 @@ public:
         _min_groups(std::max(size_t(1), min_groups)),
         _sample_hits(max_hits * sample)
     {}
+    size_t max_hits() const { return _max_hits; }
     size_t sample_hits_per_thread(size_t num_threads) const {
         return std::max(size_t(1), std::max(128 / num_threads, _sample_hits / num_threads));
     }
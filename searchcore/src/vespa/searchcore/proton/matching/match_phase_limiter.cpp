@@ -73,6 +73,8 @@ MatchPhaseLimiter::MatchPhaseLimiter(uint32_t docIdLimit, Searchable &searchable
                                      DegradationParams degradation, DiversityParams diversity)
     : _postFilterMultiplier(degradation.post_filter_multiplier),
       _maxFilterCoverage(degradation.max_filter_coverage),
+      _ordered(degradation.ordered && !diversity.enabled()),
+      _docIdLimit(docIdLimit),
       _calculator(degradation.max_hits, diversity.min_groups, degradation.sample_percentage),
       _limiter_factory(searchable_attributes, requestContext, degradation.attribute, degradation.descending,
                        diversity.attribute, diversity.cutoff_factor, diversity.cutoff_strategy),
@@ -120,6 +122,24 @@ MatchPhaseLimiter::maybe_limit(SearchIterator::UP search, double match_freq, siz
     }
     uint32_t current_id = search->getDocId();
     uint32_t end_id = search->getEndId();
+    if (_ordered) {
+        SearchIterator::UP limiter = _limiter_factory.create_ordered_search(*search, _calculator.max_hits(),
+                                                                            wanted_num_docs, upper_limited_corpus_size,
+                                                                            _docIdLimit);
+        if (trace) {
+            trace->setString("action", "Will limit with ordered evaluation");
+            trace->setLong("ordered_rounds", _limiter_factory.getOrderedRounds());
+            trace->setLong("evaluated_docs", _limiter_factory.getEstimatedHits());
+            trace->setLong("current_docid", current_id);
+            trace->setLong("end_docid", end_id);
+        }
+        LOG(debug, "Will do ordered evaluation: maybe_limit(hit_rate=%g, num_docs=%zu, max_filter_docs=%zu) = wanted_num_docs=%zu,"
+            " evaluated_docs=%zd, rounds=%zu", match_freq, num_docs, max_filter_docs, wanted_num_docs,
+            _limiter_factory.getEstimatedHits(), _limiter_factory.getOrderedRounds());
+        search = std::make_unique<LimitedSearchT<true>>(std::move(limiter), std::move(search));
+        search->initRange(current_id + 1, end_id);
+        return search;
+    }
     size_t total_query_hits = _calculator.estimated_hits(match_freq, num_docs);
     size_t max_group_size = _calculator.max_group_size(wanted_num_docs);
     bool use_pre_filter = (wanted_num_docs < (total_query_hits * _postFilterMultiplier));
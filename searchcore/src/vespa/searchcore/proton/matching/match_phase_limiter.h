@@ -88,13 +88,15 @@ struct DiversityParams {
 
 struct DegradationParams {
     DegradationParams(const vespalib::string &attribute_, size_t max_hits_, bool descending_,
-                      double max_filter_coverage_, double sample_percentage_, double post_filter_multiplier_)
+                      double max_filter_coverage_, double sample_percentage_, double post_filter_multiplier_,
+                      bool ordered_ = false)
         : attribute(attribute_),
           max_hits(max_hits_),
           descending(descending_),
           max_filter_coverage(max_filter_coverage_),
           sample_percentage(sample_percentage_),
-          post_filter_multiplier(post_filter_multiplier_)
+          post_filter_multiplier(post_filter_multiplier_),
+          ordered(ordered_)
     { }
     bool enabled() const { return !attribute.empty() && (max_hits > 0); }
     vespalib::string attribute;
@@ -103,6 +105,7 @@ struct DegradationParams {
     double           max_filter_coverage;
     double           sample_percentage;
     double           post_filter_multiplier;
+    bool             ordered; // evaluate the query in attribute order until max hits are found
 };
 
 /**
@@ -131,6 +134,8 @@ private:
     };
     const double              _postFilterMultiplier;
     const double              _maxFilterCoverage;
+    const bool                _ordered;
+    const uint32_t            _docIdLimit;
     MatchPhaseLimitCalculator _calculator;
     AttributeLimiter          _limiter_factory;
     Coverage                  _coverage;
@@ -6,14 +6,18 @@
 #include <vespa/searchcore/grouping/groupingmanager.h>
 #include <vespa/searchcore/grouping/groupingcontext.h>
 #include <vespa/searchlib/engine/trace.h>
+#include <vespa/searchlib/fef/feature_profiler.h>
+#include <vespa/searchlib/queryeval/search_profiler.h>
 #include <vespa/searchlib/attribute/attribute_operation.h>
 #include <vespa/searchlib/common/bitvector.h>
 #include <vespa/searchlib/queryeval/multibitvectoriterator.h>
+#include <vespa/searchlib/queryeval/galloping_and_search.h>
 #include <vespa/searchlib/queryeval/andnotsearch.h>
 #include <vespa/vespalib/util/closure.h>
 #include <vespa/vespalib/util/thread_bundle.h>
 #include <vespa/vespalib/data/slime/cursor.h>
 #include <vespa/vespalib/data/slime/inserter.h>
+#include <limits>
 
 #include <vespa/log/log.h>
 LOG_SETUP(".proton.matching.match_thread");
@@ -61,6 +65,10 @@ struct FastBlackListingStrategy {
     }
 };
 
+// number of ranked hits between each time a match thread shares its
+// score threshold with the other match threads
+constexpr uint32_t SHARE_SCORE_THRESHOLD_INTERVAL = 256;
+
 LazyValue get_score_feature(const RankProgram &rankProgram) {
     FeatureResolver resolver(rankProgram.get_seeds());
     assert(resolver.num_features() == 1u);
@@ -71,21 +79,56 @@ LazyValue get_score_feature(const RankProgram &rankProgram) {
 
 //-----------------------------------------------------------------------------
 
-MatchThread::Context::Context(double rankDropLimit, MatchTools &tools, HitCollector &hits, uint32_t num_threads)
+MatchThread::Context::Context(double rankDropLimit, MatchTools &tools, HitCollector &hits, uint32_t num_threads,
+                              IMatchLoopCommunicator *threshold_communicator)
     : matches(0),
       _matches_limit(tools.match_limiter().sample_hits_per_thread(num_threads)),
+      _share_countdown(threshold_communicator ? SHARE_SCORE_THRESHOLD_INTERVAL : std::numeric_limits<uint32_t>::max()),
+      _threshold_communicator(threshold_communicator),
       _score_feature(get_score_feature(tools.rank_program())),
       _ranking(tools.rank_program()),
       _rankDropLimit(rankDropLimit),
       _hits(hits),
-      _doom(tools.getDoom())
+      _doom(tools.getDoom()),
+      _useBatch(_ranking.can_batch()),
+      _batch()
 {
+    if (_useBatch) {
+        _batch.reserve(RankProgram::BATCH_SIZE);
+    }
 }
 
 template <bool use_rank_drop_limit>
 void
 MatchThread::Context::rankHit(uint32_t docId) {
-    double score = _score_feature.as_number(docId);
+    addScore<use_rank_drop_limit>(docId, _score_feature.as_number(docId));
+}
+
+template <bool use_rank_drop_limit>
+void
+MatchThread::Context::batchHit(uint32_t docId) {
+    _batch.push_back(docId);
+    if (__builtin_expect(_batch.size() == RankProgram::BATCH_SIZE, false)) {
+        flushBatch<use_rank_drop_limit>();
+    }
+}
+
+template <bool use_rank_drop_limit>
+void
+MatchThread::Context::flushBatch() {
+    if (_batch.empty()) {
+        return;
+    }
+    auto scores = _ranking.run_batch(_batch);
+    for (size_t i = 0; i < _batch.size(); ++i) {
+        addScore<use_rank_drop_limit>(_batch[i], scores[i]);
+    }
+    _batch.clear();
+}
+
+template <bool use_rank_drop_limit>
+void
+MatchThread::Context::addScore(uint32_t docId, double score) {
     // convert NaN and Inf scores to -Inf
     if (__builtin_expect(std::isnan(score) || std::isinf(score), false)) {
         score = -HUGE_VAL;
@@ -97,6 +140,20 @@ MatchThread::Context::rankHit(uint32_t docId) {
     } else {
         _hits.addHit(docId, score);
     }
+    if (__builtin_expect(--_share_countdown == 0, false)) {
+        share_score_threshold();
+    }
+}
+
+void
+MatchThread::Context::share_score_threshold()
+{
+    if (_threshold_communicator != nullptr) {
+        _hits.setScoreThreshold(_threshold_communicator->share_score_threshold(_hits.getLowestRankedScore()));
+        _share_countdown = SHARE_SCORE_THRESHOLD_INTERVAL;
+    } else {
+        _share_countdown = std::numeric_limits<uint32_t>::max();
+    }
 }
 
 //-----------------------------------------------------------------------------
@@ -159,8 +216,13 @@ MatchThread::inner_match_loop(Context &context, MatchTools &tools, DocidRange &d
     uint32_t docId = search->seekFirst(docid_range.begin);
     while ((docId < docid_range.end) && !context.atSoftDoom()) {
         if (do_rank) {
-            search->unpack(docId);
-            context.rankHit<use_rank_drop_limit>(docId);
+            if (context.useBatch()) {
+                // first phase ranking does not use match data
+                context.batchHit<use_rank_drop_limit>(docId);
+            } else {
+                search->unpack(docId);
+                context.rankHit<use_rank_drop_limit>(docId);
+            }
         } else {
             context.addHit(docId);
         }
@@ -175,6 +237,9 @@ MatchThread::inner_match_loop(Context &context, MatchTools &tools, DocidRange &d
             docId = Strategy::seek_next(*search, docId + 1);
         }
     }
+    if (do_rank) {
+        context.flushBatch<use_rank_drop_limit>();
+    }
     return docId;
 }
 
@@ -185,7 +250,8 @@ MatchThread::match_loop(MatchTools &tools, HitCollector &hits)
     bool softDoomed = false;
     uint32_t docsCovered = 0;
     vespalib::duration overtime(vespalib::duration::zero());
-    Context context(matchParams.rankDropLimit, tools, hits, num_threads);
+    Context context(matchParams.rankDropLimit, tools, hits, num_threads,
+                    share_score_threshold ? &communicator : nullptr);
     for (DocidRange docid_range = scheduler.first_range(thread_id);
          !docid_range.empty();
          docid_range = scheduler.next_range(thread_id))
@@ -282,8 +348,13 @@ MatchThread::findMatches(MatchTools &tools)
         LOG(spam, "SearchIterator: %s", tools.search().asString().c_str());
     }
     tools.give_back_search(search::queryeval::MultiBitVectorIteratorBase::optimize(tools.borrow_search()));
+    tools.give_back_search(search::queryeval::GallopingAndSearch::optimize(tools.borrow_search()));
+    uint32_t adaptive_reorder_seeks = tools.adaptive_reorder_seeks();
+    if (adaptive_reorder_seeks > 0) {
+        tools.give_back_search(search::queryeval::MultiSearch::enable_adaptive_reorder(tools.borrow_search(), adaptive_reorder_seeks));
+    }
     if (isFirstThread()) {
-        LOG(debug, "SearchIterator after MultiBitVectorIteratorBase::optimize(): %s", tools.search().asString().c_str());
+        LOG(debug, "SearchIterator after MultiBitVectorIteratorBase::optimize() and GallopingAndSearch::optimize(): %s", tools.search().asString().c_str());
         if (trace->shouldTrace(7)) {
             vespalib::slime::ObjectInserter inserter(trace->createCursor("iterator"), "optimized");
             tools.search().asSlime(inserter);
@@ -292,24 +363,34 @@ MatchThread::findMatches(MatchTools &tools)
     HitCollector hits(matchParams.numDocs, matchParams.arraySize);
     trace->addEvent(4, "Start match and first phase rank");
     match_loop_helper(tools, hits);
+    if (isFirstThread() && (adaptive_reorder_seeks > 0) && trace->shouldTrace(7)) {
+        vespalib::slime::ObjectInserter inserter(trace->createCursor("iterator"), "after_match");
+        tools.search().asSlime(inserter);
+    }
     if (tools.has_second_phase_rank()) {
         { // 2nd phase ranking
             trace->addEvent(4, "Start second phase rerank");
             tools.setup_second_phase();
             DocidRange docid_range = scheduler.total_span(thread_id);
             tools.search().initRange(docid_range.begin, docid_range.end);
-            auto sorted_hit_seq = matchToolsFactory.should_diversify()
-                                  ? hits.getSortedHitSequence(matchParams.arraySize)
+            auto thread_diversifier = matchToolsFactory.createThreadDiversifier(matchParams.heapSize, matchParams.arraySize);
+            auto sorted_hit_seq = thread_diversifier
+                                  ? hits.getSortedHitSequence(matchParams.arraySize, *thread_diversifier)
                                   : hits.getSortedHitSequence(matchParams.heapSize);
             trace->addEvent(5, "Synchronize before second phase rerank");
             WaitTimer select_best_timer(wait_time_s);
             auto kept_hits = communicator.selectBest(sorted_hit_seq);
             select_best_timer.done();
             DocumentScorer scorer(tools.rank_program(), tools.search());
+            const auto &capture_names = matchToolsFactory.captured_feature_names();
+            if (!capture_names.empty() && !scorer.capture_features(capture_names)) {
+                LOG(debug, "Unable to capture summary features while re-ranking");
+            }
             if (tools.getDoom().hard_doom()) {
                 kept_hits.clear();
             }
             uint32_t reRanked = hits.reRank(scorer, std::move(kept_hits));
+            captured_features = scorer.extract_captured_features();
             if (auto onReRankTask = matchToolsFactory.createOnReRankTask()) {
                 onReRankTask->run(hits.getReRankedHits());
             }
@@ -347,15 +428,18 @@ MatchThread::processResult(const Doom & doom,
         bits->andNotWithT(search::RankedHitIterator(hits, numHits));
     }
     if (doom.hard_doom()) return;
+    bool groupInRelevanceOrder = false;
     if (hasGrouping) {
         search::grouping::GroupingManager man(*context.grouping);
         man.groupUnordered(hits, numHits, bits);
+        groupInRelevanceOrder = man.needRelevanceOrder();
     }
     if (doom.hard_doom()) return;
-    size_t sortLimit = hasGrouping ? numHits : context.result->maxSize();
+    // only sort all hits when some grouping needs them in relevance order
+    size_t sortLimit = groupInRelevanceOrder ? numHits : context.result->maxSize();
     result->sort(*context.sort->sorter, sortLimit);
     if (doom.hard_doom()) return;
-    if (hasGrouping) {
+    if (groupInRelevanceOrder) {
         search::grouping::GroupingManager man(*context.grouping);
         man.groupInRelevanceOrder(hits, numHits);
     }
@@ -418,10 +502,20 @@ MatchThread::MatchThread(size_t thread_id_in,
     match_time_s(0.0),
     wait_time_s(0.0),
     match_with_ranking(mtf.has_first_phase_rank() && mp.save_rank_scores()),
-    trace(std::make_unique<Trace>(relativeTime, traceLevel))
+    share_score_threshold(match_with_ranking && (num_threads_in > 1) && !mtf.should_diversify() && !rp.needs_all_scores()),
+    trace(std::make_unique<Trace>(relativeTime, traceLevel)),
+    captured_features()
 {
 }
 
+MatchThread::~MatchThread() = default;
+
+std::unique_ptr<CapturedFeatures>
+MatchThread::extract_captured_features()
+{
+    return std::move(captured_features);
+}
+
 void
 MatchThread::run()
 {
@@ -431,6 +525,12 @@ MatchThread::run()
     MatchTools::UP matchTools = matchToolsFactory.createMatchTools();
     search::ResultSet::UP result = findMatches(*matchTools);
     match_time_s = vespalib::to_s(match_time.elapsed());
+    if (const auto *profiler = matchTools->feature_profiler()) {
+        profiler->report(trace->createCursor("feature_profile"));
+    }
+    if (const auto *profiler = matchTools->search_profiler()) {
+        profiler->report(trace->createCursor("search_profile"));
+    }
     resultContext = resultProcessor.createThreadContext(matchTools->getDoom(), thread_id, _distributionKey);
     {
         trace->addEvent(5, "Wait for result processing token");
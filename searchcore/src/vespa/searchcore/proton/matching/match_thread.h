@@ -28,6 +28,7 @@ namespace proton::matching {
 
 class MatchTools;
 class MatchToolsFactory;
+struct CapturedFeatures;
 
 /**
  * Runs a single match thread and keeps track of local state.
@@ -62,14 +63,21 @@ private:
     double                        match_time_s;
     double                        wait_time_s;
     bool                          match_with_ranking;
+    bool                          share_score_threshold;
     std::unique_ptr<Trace>        trace;
+    std::unique_ptr<CapturedFeatures> captured_features;
 
     class Context {
     public:
         Context(double rankDropLimit, MatchTools &tools, HitCollector &hits,
-                uint32_t num_threads) __attribute__((noinline));
+                uint32_t num_threads, IMatchLoopCommunicator *threshold_communicator) __attribute__((noinline));
         template <bool use_rank_drop_limit>
         void rankHit(uint32_t docId);
+        template <bool use_rank_drop_limit>
+        void batchHit(uint32_t docId);
+        template <bool use_rank_drop_limit>
+        void flushBatch();
+        bool useBatch() const { return _useBatch; }
         void addHit(uint32_t docId) { _hits.addHit(docId, search::zero_rank_value); }
         bool isBelowLimit() const { return matches < _matches_limit; }
         bool    isAtLimit() const { return matches == _matches_limit; }
@@ -77,12 +85,19 @@ private:
         vespalib::duration timeLeft() const { return _doom.soft_left(); }
         uint32_t        matches;
     private:
+        template <bool use_rank_drop_limit>
+        void addScore(uint32_t docId, double score);
+        void share_score_threshold() __attribute__((noinline));
         uint32_t        _matches_limit;
+        uint32_t        _share_countdown;
+        IMatchLoopCommunicator *_threshold_communicator;
         LazyValue       _score_feature;
         RankProgram    &_ranking;
         double          _rankDropLimit;
         HitCollector   &_hits;
         const Doom     &_doom;
+        bool            _useBatch;
+        std::vector<uint32_t> _batch;
     };
 
     double estimate_match_frequency(uint32_t matches, uint32_t searchedSoFar) __attribute__((noinline));
@@ -124,10 +139,13 @@ public:
                 uint32_t distributionKey,
                 const RelativeTime & relativeTime,
                 uint32_t traceLevel);
+    ~MatchThread() override;
     void run() override;
     const MatchingStats::Partition &get_thread_stats() const { return thread_stats; }
     double get_match_time() const { return match_time_s; }
     PartialResult::UP extract_result() { return std::move(resultContext->result); }
+    // only available when capturing features was requested and possible
+    std::unique_ptr<CapturedFeatures> extract_captured_features();
     const Trace & getTrace() const { return *trace; }
 };
 
@@ -3,6 +3,9 @@
 #include "match_tools.h"
 #include "querynodes.h"
 #include <vespa/searchcorespi/index/indexsearchable.h>
+#include <vespa/searchlib/fef/featurenameparser.h>
+#include <vespa/searchlib/fef/feature_profiler.h>
+#include <vespa/searchlib/queryeval/search_profiler.h>
 #include <vespa/searchlib/fef/indexproperties.h>
 #include <vespa/searchlib/fef/ranksetup.h>
 #include <vespa/searchlib/engine/trace.h>
@@ -11,6 +14,7 @@
 #include <vespa/searchlib/attribute/attribute_operation.h>
 #include <vespa/searchlib/attribute/attribute_blueprint_params.h>
 #include <vespa/searchlib/common/bitvector.h>
+#include <algorithm>
 
 #include <vespa/log/log.h>
 LOG_SETUP(".proton.matching.match_tools");
@@ -18,6 +22,8 @@ LOG_SETUP(".proton.matching.match_tools");
 using search::attribute::IAttributeContext;
 using search::queryeval::IRequestContext;
 using search::queryeval::IDiversifier;
+using search::queryeval::SearchProfiler;
+using search::queryeval::SearchIterator;
 using search::attribute::diversity::DiversityFilter;
 using search::attribute::BasicType;
 using search::attribute::AttributeBlueprintParams;
@@ -32,6 +38,9 @@ namespace proton::matching {
 
 namespace {
 
+// Iterator trees are usually a few kB, larger ones just use more chunks.
+constexpr size_t SEARCH_ARENA_CHUNK_SIZE = 16 * 1024;
+
 bool contains_all(const HandleRecorder::HandleMap &old_map,
                   const HandleRecorder::HandleMap &new_map)
 {
@@ -53,7 +62,8 @@ extractDegradationParams(const RankSetup &rankSetup, const Properties &rankPrope
                              !DegradationAscendingOrder::lookup(rankProperties, rankSetup.isDegradationOrderAscending()),
                              DegradationMaxFilterCoverage::lookup(rankProperties, rankSetup.getDegradationMaxFilterCoverage()),
                              DegradationSamplePercentage::lookup(rankProperties, rankSetup.getDegradationSamplePercentage()),
-                             DegradationPostFilterMultiplier::lookup(rankProperties, rankSetup.getDegradationPostFilterMultiplier()));
+                             DegradationPostFilterMultiplier::lookup(rankProperties, rankSetup.getDegradationPostFilterMultiplier()),
+                             DegradationOrderedEvaluation::lookup(rankProperties, rankSetup.isDegradationOrderedEvaluation()));
 
 }
 
@@ -69,7 +79,8 @@ extractDiversityParams(const RankSetup &rankSetup, const Properties &rankPropert
 AttributeBlueprintParams
 extractAttributeBlueprintParams(const RankSetup& rank_setup, const Properties &rankProperties)
 {
-    return AttributeBlueprintParams(NearestNeighborBruteForceLimit::lookup(rankProperties, rank_setup.get_nearest_neighbor_brute_force_limit()));
+    return AttributeBlueprintParams(NearestNeighborBruteForceLimit::lookup(rankProperties, rank_setup.get_nearest_neighbor_brute_force_limit()),
+                                    NearestNeighborExtendedExplorationLimit::lookup(rankProperties, rank_setup.get_nearest_neighbor_extended_exploration_limit()));
 }
 
 } // namespace proton::matching::<unnamed>
@@ -80,18 +91,26 @@ MatchTools::setup(search::fef::RankProgram::UP rank_program, double termwise_lim
     if (_search) {
         _match_data->soft_reset();
     }
+    if (_rank_program) {
+        _rankSetup.recycle_program(std::move(_rank_program));
+    }
     _rank_program = std::move(rank_program);
     HandleRecorder recorder;
     {
         HandleRecorder::Binder bind(recorder);
-        _rank_program->setup(*_match_data, _queryEnv, _featureOverrides);
+        _rank_program->setup(*_match_data, _queryEnv, _featureOverrides, _feature_profiler.get());
     }
     bool can_reuse_search = (_search && !_search_has_changed &&
             contains_all(_used_handles, recorder.get_handles()));
     if (!can_reuse_search) {
         recorder.tag_match_data(*_match_data);
         _match_data->set_termwise_limit(termwise_limit);
-        _search = _query.createSearch(*_match_data);
+        SearchIterator::ArenaScope arena_scope(_search_arena);
+        if (_search_profiler) {
+            _search = _search_profiler->create_search(*_query.peekRoot(), *_match_data, true);
+        } else {
+            _search = _query.createSearch(*_match_data);
+        }
         _used_handles = recorder.get_handles();
         _search_has_changed = false;
     }
@@ -113,20 +132,41 @@ MatchTools::MatchTools(QueryLimiter & queryLimiter,
       _rankSetup(rankSetup),
       _featureOverrides(featureOverrides),
       _match_data(mdl.createMatchData()),
+      _feature_profiler(),
+      _search_profiler(),
       _rank_program(),
+      _search_arena(SEARCH_ARENA_CHUNK_SIZE),
       _search(),
       _used_handles(),
       _search_has_changed(false)
 {
+    uint32_t profile_sample_interval = trace::ProfileFeatures::lookup(queryEnv.getProperties());
+    if (profile_sample_interval > 0) {
+        _feature_profiler = std::make_unique<FeatureProfiler>(profile_sample_interval);
+    }
+    uint32_t search_sample_interval = trace::ProfileSearch::lookup(queryEnv.getProperties());
+    if (search_sample_interval > 0) {
+        _search_profiler = std::make_unique<SearchProfiler>(search_sample_interval);
+    }
 }
 
-MatchTools::~MatchTools() = default;
+MatchTools::~MatchTools()
+{
+    if (_rank_program) {
+        _rankSetup.recycle_program(std::move(_rank_program));
+    }
+}
 
 bool
 MatchTools::has_second_phase_rank() const {
     return !_rankSetup.getSecondPhaseRank().empty();
 }
 
+uint32_t
+MatchTools::adaptive_reorder_seeks() const {
+    return AdaptiveReorderSeeks::lookup(_queryEnv.getProperties());
+}
+
 void
 MatchTools::setup_first_phase()
 {
@@ -167,7 +207,8 @@ MatchToolsFactory(QueryLimiter               & queryLimiter,
                   const IIndexEnvironment    & indexEnv,
                   const RankSetup            & rankSetup,
                   const Properties           & rankProperties,
-                  const Properties           & featureOverrides)
+                  const Properties           & featureOverrides,
+                  const GlobalFilterCache::Binding *globalFilterCache)
     : _queryLimiter(queryLimiter),
       _requestContext(doom, attributeContext, rankProperties, extractAttributeBlueprintParams(rankSetup, rankProperties)),
       _query(),
@@ -177,6 +218,7 @@ MatchToolsFactory(QueryLimiter               & queryLimiter,
       _rankSetup(rankSetup),
       _featureOverrides(featureOverrides),
       _diversityParams(),
+      _captured_feature_names(),
       _valid(false)
 {
     trace.addEvent(4, "MTF: Start");
@@ -195,7 +237,7 @@ MatchToolsFactory(QueryLimiter               & queryLimiter,
         _query.fetchPostings();
         trace.addEvent(5, "MTF: Handle Global Filters");
         double global_filter_limit = GlobalFilterLimit::lookup(rankProperties, rankSetup.get_global_filter_limit());
-        _query.handle_global_filters(searchContext.getDocIdLimit(), global_filter_limit);
+        _query.handle_global_filters(searchContext.getDocIdLimit(), global_filter_limit, globalFilterCache);
         _query.freeze();
         trace.addEvent(5, "MTF: prepareSharedState");
         _rankSetup.prepareSharedState(_queryEnv, _queryEnv.getObjectStore());
@@ -240,6 +282,21 @@ MatchToolsFactory::createDiversifier(uint32_t heapSize) const
                                    _diversityParams.cutoff_strategy == DiversityParams::CutoffStrategy::STRICT);
 }
 
+std::unique_ptr<IDiversifier>
+MatchToolsFactory::createThreadDiversifier(uint32_t heapSize, uint32_t arraySize) const
+{
+    if ( !_diversityParams.enabled() ) {
+        return std::unique_ptr<IDiversifier>();
+    }
+    auto attr = _requestContext.getAttribute(_diversityParams.attribute);
+    if ( !attr) {
+        return std::unique_ptr<IDiversifier>();
+    }
+    size_t max_per_group = heapSize/_diversityParams.min_groups;
+    // A thread never sees more groups than hits, so the group cutoff never kicks in.
+    return DiversityFilter::create(*attr, arraySize, max_per_group, arraySize, true);
+}
+
 std::unique_ptr<AttributeOperationTask>
 MatchToolsFactory::createTask(vespalib::stringref attribute, vespalib::stringref operation) const {
     return (!attribute.empty() && ! operation.empty())
@@ -267,6 +324,23 @@ MatchToolsFactory::has_first_phase_rank() const {
     return !_rankSetup.getFirstPhaseRank().empty();
 }
 
+void
+MatchToolsFactory::capture_summary_features()
+{
+    // use the same names and order as the seeds of the summary program
+    std::vector<vespalib::string> names;
+    for (const auto &feature : _rankSetup.getSummaryFeatures()) {
+        FeatureNameParser parser(feature);
+        if (!parser.valid()) {
+            return;
+        }
+        names.push_back(parser.featureName());
+    }
+    std::sort(names.begin(), names.end());
+    names.erase(std::unique(names.begin(), names.end()), names.end());
+    _captured_feature_names = std::move(names);
+}
+
 AttributeOperationTask::AttributeOperationTask(const RequestContext & requestContext,
                                                vespalib::stringref attribute, vespalib::stringref operation)
     : _requestContext(requestContext),
@@ -16,10 +16,14 @@
 #include <vespa/searchlib/queryeval/idiversifier.h>
 #include <vespa/vespalib/util/doom.h>
 #include <vespa/vespalib/util/clock.h>
+#include <vespa/vespalib/util/stash.h>
 
 namespace search::engine { class Trace; }
 
+namespace search::queryeval { class SearchProfiler; }
+
 namespace search::fef {
+    class FeatureProfiler;
     class RankProgram;
     class RankSetup;
 }
@@ -37,10 +41,20 @@ private:
     const search::fef::RankSetup          &_rankSetup;
     const search::fef::Properties         &_featureOverrides;
     std::unique_ptr<search::fef::MatchData>     _match_data;
+    std::unique_ptr<search::fef::FeatureProfiler> _feature_profiler;
+    std::unique_ptr<search::queryeval::SearchProfiler> _search_profiler;
     std::unique_ptr<search::fef::RankProgram>   _rank_program;
+    // Backs the iterators of _search (also earlier searches replaced
+    // by setup), released when the match tools are destroyed.
+    vespalib::Stash                        _search_arena;
     search::queryeval::SearchIterator::UP  _search;
     HandleRecorder::HandleMap              _used_handles;
     bool                                   _search_has_changed;
+    // Match data is only unpacked for the term fields used by the
+    // current rank program. The search is re-created when a later
+    // program (like second phase) needs to unpack more than the
+    // current search does, so that data only needed for re-ranking
+    // is only unpacked for the re-ranked hits.
     void setup(std::unique_ptr<search::fef::RankProgram>, double termwise_limit = 1.0);
 public:
     typedef std::unique_ptr<MatchTools> UP;
@@ -59,8 +73,13 @@ public:
     QueryLimiter & getQueryLimiter() { return _queryLimiter; }
     MaybeMatchPhaseLimiter &match_limiter() { return _match_limiter; }
     bool has_second_phase_rank() const;
+    uint32_t adaptive_reorder_seeks() const;
     const search::fef::MatchData &match_data() const { return *_match_data; }
     search::fef::RankProgram &rank_program() { return *_rank_program; }
+    // only available when profiling of rank features is requested
+    const search::fef::FeatureProfiler *feature_profiler() const { return _feature_profiler.get(); }
+    // only available when profiling of the search iterator tree is requested
+    const search::queryeval::SearchProfiler *search_profiler() const { return _search_profiler.get(); }
     search::queryeval::SearchIterator &search() { return *_search; }
     search::queryeval::SearchIterator::UP borrow_search() { return std::move(_search); }
     void give_back_search(search::queryeval::SearchIterator::UP search_in) { _search = std::move(search_in); }
@@ -99,6 +118,7 @@ private:
     const search::fef::RankSetup    & _rankSetup;
     const search::fef::Properties   & _featureOverrides;
     DiversityParams                   _diversityParams;
+    std::vector<vespalib::string>     _captured_feature_names;
     bool                              _valid;
 
     std::unique_ptr<AttributeOperationTask>
@@ -119,19 +139,35 @@ public:
                       const search::fef::IIndexEnvironment &indexEnv,
                       const search::fef::RankSetup &rankSetup,
                       const search::fef::Properties &rankProperties,
-                      const search::fef::Properties &featureOverrides);
+                      const search::fef::Properties &featureOverrides,
+                      const GlobalFilterCache::Binding *globalFilterCache = nullptr);
     ~MatchToolsFactory();
     bool valid() const { return _valid; }
     const MaybeMatchPhaseLimiter &match_limiter() const { return *_match_limiter; }
     MatchTools::UP createMatchTools() const;
     bool should_diversify() const { return _diversityParams.enabled(); }
     std::unique_ptr<search::queryeval::IDiversifier> createDiversifier(uint32_t heapSize) const;
+    /**
+     * Diversifier used by each match thread to drop hits exceeding the
+     * per-group limit among its own best hits, before they are merged
+     * and diversified with the diversifier above.
+     **/
+    std::unique_ptr<search::queryeval::IDiversifier> createThreadDiversifier(uint32_t heapSize, uint32_t arraySize) const;
     search::queryeval::Blueprint::HitEstimate estimate() const { return _query.estimate(); }
     bool has_first_phase_rank() const;
     std::unique_ptr<AttributeOperationTask> createOnMatchTask() const;
     std::unique_ptr<AttributeOperationTask> createOnReRankTask() const;
     std::unique_ptr<AttributeOperationTask> createOnSummaryTask() const;
 
+    /**
+     * Request that the summary features are captured while ranking the
+     * hits in the second phase, so that they can be reused when
+     * producing docsums from the search session. Empty
+     * captured_feature_names means nothing should be captured.
+     **/
+    void capture_summary_features();
+    const std::vector<vespalib::string> &captured_feature_names() const { return _captured_feature_names; }
+
     const Query & query() const { return _query; }
     const RequestContext & getRequestContext() const { return _requestContext; }
 };
@@ -1,11 +1,13 @@
 // Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 
 #include "isearchcontext.h"
+#include "load_adapted_thread_bundle.h"
 #include "match_master.h"
 #include "match_context.h"
 #include "match_tools.h"
 #include "match_params.h"
 #include "matcher.h"
+#include "result_cache.h"
 #include "sessionmanager.h"
 #include <vespa/searchcore/grouping/groupingcontext.h>
 #include <vespa/searchlib/engine/docsumrequest.h>
@@ -16,6 +18,7 @@
 #include <vespa/searchlib/fef/ranksetup.h>
 #include <vespa/searchlib/fef/test/plugin/setup.h>
 #include <vespa/vespalib/data/slime/inserter.h>
+#include <vespa/vespalib/util/stringfmt.h>
 
 #include <vespa/log/log.h>
 LOG_SETUP(".proton.matching.matcher");
@@ -87,6 +90,7 @@ bool willNotNeedRanking(const SearchRequest & request, const GroupingContext & g
 SearchReply::UP
 handleGroupingSession(SessionManager &sessionMgr, GroupingContext & groupingContext, GroupingSession::UP groupingSession)
 {
+    // sessions keeping their results are never finished
     auto reply = std::make_unique<SearchReply>();
     groupingSession->continueExecution(groupingContext);
     groupingContext.getResult().swap(reply->groupResult);
@@ -109,7 +113,9 @@ Matcher::Matcher(const search::index::Schema &schema, const Properties &props, c
       _startTime(my_clock::now()),
       _clock(clock),
       _queryLimiter(queryLimiter),
-      _distributionKey(distributionKey)
+      _distributionKey(distributionKey),
+      _resultCache(),
+      _globalFilterCache()
 {
     search::features::setup_search_features(_blueprintFactory);
     search::fef::test::setup_fef_test_plugin(_blueprintFactory);
@@ -118,8 +124,20 @@ Matcher::Matcher(const search::index::Schema &schema, const Properties &props, c
     if (!_rankSetup->compile()) {
         throw vespalib::IllegalArgumentException("failed to compile rank setup", VESPA_STRLOC);
     }
+    uint32_t resultCacheMaxBytes = ResultCacheMaxBytes::lookup(props);
+    if (resultCacheMaxBytes > 0) {
+        _resultCache = std::make_unique<ResultCache>(resultCacheMaxBytes,
+                                                     vespalib::from_s(ResultCacheMaxAge::lookup(props)));
+    }
+    uint32_t globalFilterCacheMaxBytes = GlobalFilterCacheMaxBytes::lookup(props);
+    if (globalFilterCacheMaxBytes > 0) {
+        _globalFilterCache = std::make_unique<GlobalFilterCache>(globalFilterCacheMaxBytes,
+                                                                 vespalib::from_s(GlobalFilterCacheMaxAge::lookup(props)));
+    }
 }
 
+Matcher::~Matcher() = default;
+
 MatchingStats
 Matcher::getStats()
 {
@@ -136,7 +154,8 @@ using search::fef::indexproperties::softtimeout::Factor;
 std::unique_ptr<MatchToolsFactory>
 Matcher::create_match_tools_factory(const search::engine::Request &request, ISearchContext &searchContext,
                                     IAttributeContext &attrContext, const search::IDocumentMetaStore &metaStore,
-                                    const Properties &feature_overrides) const
+                                    const Properties &feature_overrides,
+                                    const GlobalFilterCache::Binding *global_filter_cache) const
 {
     const Properties & rankProperties = request.propertiesMap.rankProperties();
     bool softTimeoutEnabled = Enabled::lookup(rankProperties, _rankSetup->getSoftTimeoutEnabled());
@@ -156,17 +175,20 @@ Matcher::create_match_tools_factory(const search::engine::Request &request, ISea
     return std::make_unique<MatchToolsFactory>(_queryLimiter, doom, searchContext, attrContext,
                                                request.trace(), request.getStackRef(), request.location,
                                                _viewResolver, metaStore, _indexEnv, *_rankSetup,
-                                               rankProperties, feature_overrides);
+                                               rankProperties, feature_overrides, global_filter_cache);
 }
 
 size_t
-Matcher::computeNumThreadsPerSearch(Blueprint::HitEstimate hits, const Properties & rankProperties) const {
+Matcher::computeNumThreadsPerSearch(Blueprint::HitEstimate hits, const Properties & rankProperties,
+                                    size_t loadTargetThreads) const {
     size_t threads = NumThreadsPerSearch::lookup(rankProperties, _rankSetup->getNumThreadsPerSearch());
     uint32_t minHitsPerThread = MinHitsPerThread::lookup(rankProperties, _rankSetup->getMinHitsPerThread());
     if ((threads > 1) && (minHitsPerThread > 0)) {
         threads = (hits.empty) ? 1 : std::min(threads, numThreads(hits.estHits, minHitsPerThread));
     }
-    return threads;
+    // Search load only reduces the number of threads down to the rank profile minimum
+    size_t minThreads = MinThreadsPerSearch::lookup(rankProperties, _rankSetup->getMinThreadsPerSearch());
+    return std::min(threads, std::max(loadTargetThreads, minThreads));
 }
 
 namespace {
@@ -186,6 +208,21 @@ Matcher::match(const SearchRequest &request, vespalib::ThreadBundle &threadBundl
                const search::IDocumentMetaStore &metaStore, SearchSession::OwnershipBundle &&owned_objects)
 {
     vespalib::Timer total_matching_time;
+    vespalib::string resultCacheKey;
+    std::shared_ptr<const ISearchHandler> resultCacheView = owned_objects.search_handler;
+    if (_resultCache && resultCacheView) {
+        resultCacheKey = ResultCache::make_key(request);
+    }
+    if (!resultCacheKey.empty()) {
+        SearchReply::UP cached = _resultCache->lookup(resultCacheKey, resultCacheView, request.getStartTime());
+        std::lock_guard<std::mutex> guard(_statsLock);
+        if (cached) {
+            _stats.add(MatchingStats().queries(1).resultCacheHits(1)
+                               .queryLatency(vespalib::to_s(total_matching_time.elapsed())));
+            return cached;
+        }
+        _stats.resultCacheMisses(_stats.resultCacheMisses() + 1);
+    }
     MatchingStats my_stats;
     SearchReply::UP reply = std::make_unique<SearchReply>();
     size_t covered = 0;
@@ -204,7 +241,7 @@ Matcher::match(const SearchRequest &request, vespalib::ThreadBundle &threadBundl
             shouldCacheSearchSession = cache_props.lookup("query").found();
             if (shouldCacheGroupingSession) {
                 GroupingSession::UP session(sessionMgr.pickGrouping(sessionId));
-                if (session) {
+                if (session && session->canContinue(groupingContext, owned_objects.search_handler)) {
                     return handleGroupingSession(sessionMgr, groupingContext, std::move(session));
                 }
             }
@@ -215,13 +252,22 @@ Matcher::match(const SearchRequest &request, vespalib::ThreadBundle &threadBundl
             feature_overrides = owned_objects.feature_overrides.get();
         }
 
+        std::unique_ptr<GlobalFilterCache::Binding> globalFilterCache;
+        if (_globalFilterCache && owned_objects.search_handler) {
+            globalFilterCache = std::make_unique<GlobalFilterCache::Binding>(
+                    *_globalFilterCache, GlobalFilterCache::make_key(request.getStackRef(), request.location),
+                    owned_objects.search_handler, request.getStartTime());
+        }
         MatchToolsFactory::UP mtf = create_match_tools_factory(request, searchContext, attrContext,
-                                                               metaStore, *feature_overrides);
+                                                               metaStore, *feature_overrides, globalFilterCache.get());
         isDoomExplicit = mtf->getRequestContext().getDoom().isExplicitSoftDoom();
         traceQuery(6, request.trace(), mtf->query());
         if (!mtf->valid()) {
             return reply;
         }
+        if (shouldCacheSearchSession) {
+            mtf->capture_summary_features();
+        }
 
         const Properties & rankProperties = request.propertiesMap.rankProperties();
         uint32_t heapSize = HeapSize::lookup(rankProperties, _rankSetup->getHeapSize());
@@ -230,15 +276,26 @@ Matcher::match(const SearchRequest &request, vespalib::ThreadBundle &threadBundl
                            _rankSetup->getRankScoreDropLimit(), request.offset, request.maxhits,
                            !_rankSetup->getSecondPhaseRank().empty(), !willNotNeedRanking(request, groupingContext));
 
+        std::shared_ptr<const void> groupingOwner;
+        if (shouldCacheGroupingSession && sessionMgr.keepGroupingResults()) {
+            groupingOwner = owned_objects.search_handler;
+        }
         ResultProcessor rp(attrContext, metaStore, sessionMgr, groupingContext, sessionId,
-                           request.sortSpec, params.offset, params.hits);
+                           request.sortSpec, params.offset, params.hits, groupingOwner);
 
-        size_t numThreadsPerSearch = computeNumThreadsPerSearch(mtf->estimate(), rankProperties);
+        size_t loadTargetThreads = LoadAdaptedThreadBundle::targetThreads(threadBundle);
+        size_t numThreadsPerSearch = computeNumThreadsPerSearch(mtf->estimate(), rankProperties, loadTargetThreads);
         LimitedThreadBundleWrapper limitedThreadBundle(threadBundle, numThreadsPerSearch);
+        if (request.trace().shouldTrace(4)) {
+            request.trace().addEvent(4, vespalib::make_string("Using %zu of %zu threads (load target %zu, estimated hits %u)",
+                                                              numThreadsPerSearch, threadBundle.size(),
+                                                              loadTargetThreads, mtf->estimate().estHits));
+        }
         MatchMaster master;
         uint32_t numParts = NumSearchPartitions::lookup(rankProperties, _rankSetup->getNumSearchPartitions());
         ResultProcessor::Result::UP result = master.match(request.trace(), params, limitedThreadBundle, *mtf, rp,
                                                           _distributionKey, numParts);
+        auto summary_features = master.extract_captured_features();
         my_stats = MatchMaster::getStats(std::move(master));
 
         bool wasLimited = mtf->match_limiter().was_limited();
@@ -249,6 +306,7 @@ Matcher::match(const SearchRequest &request, vespalib::ThreadBundle &threadBundl
         if (shouldCacheSearchSession && ((result->_numFs4Hits != 0) || shouldCacheGroupingSession)) {
             auto session = std::make_shared<SearchSession>(sessionId, request.getStartTime(), request.getTimeOfDoom(),
                                                            std::move(mtf), std::move(owned_objects));
+            session->setSummaryFeatures(std::move(summary_features));
             session->releaseEnumGuards();
             sessionMgr.insert(std::move(session));
         }
@@ -283,6 +341,9 @@ Matcher::match(const SearchRequest &request, vespalib::ThreadBundle &threadBundl
             coverage.degradeTimeout();
             LOG(debug, "soft doomed, degraded from timeout covered = %" PRIu64, coverage.getCovered());
         }
+        if (!resultCacheKey.empty() && !my_stats.softDoomed()) {
+            _resultCache->insert(resultCacheKey, resultCacheView, request.getStartTime(), *reply);
+        }
         LOG(debug, "numThreadsPerSearch = %zu. Configured = %d, estimated hits=%d, totalHits=%" PRIu64 ", rankprofile=%s",
             numThreadsPerSearch, _rankSetup->getNumThreadsPerSearch(), estHits, reply->totalHitCount,
             request.ranking.c_str());
@@ -8,6 +8,7 @@
 #include "search_session.h"
 #include "viewresolver.h"
 #include "docsum_matcher.h"
+#include "global_filter_cache.h"
 #include <vespa/searchcore/proton/matching/querylimiter.h>
 #include <vespa/searchcommon/attribute/i_attribute_functor.h>
 #include <vespa/searchlib/fef/blueprintfactory.h>
@@ -42,6 +43,7 @@ namespace proton::matching {
 class ISearchContext;
 class SessionManager;
 class MatchToolsFactory;
+class ResultCache;
 
 /**
  * The Matcher is responsible for performing searches.
@@ -66,9 +68,11 @@ private:
     const vespalib::Clock        &_clock;
     QueryLimiter                 &_queryLimiter;
     uint32_t                      _distributionKey;
+    std::unique_ptr<ResultCache>  _resultCache;
+    std::unique_ptr<GlobalFilterCache> _globalFilterCache;
 
     size_t computeNumThreadsPerSearch(search::queryeval::Blueprint::HitEstimate hits,
-                                      const Properties & rankProperties) const;
+                                      const Properties & rankProperties, size_t loadTargetThreads) const;
 public:
     /**
      * Convenience typedefs.
@@ -91,6 +95,7 @@ public:
             const vespalib::Clock &clock, QueryLimiter &queryLimiter,
             const IConstantValueRepo &constantValueRepo, OnnxModels onnxModels,
             uint32_t distributionKey);
+    ~Matcher();
 
     const search::fef::IIndexEnvironment &get_index_env() const { return _indexEnv; }
 
@@ -108,7 +113,8 @@ public:
     std::unique_ptr<MatchToolsFactory>
     create_match_tools_factory(const search::engine::Request &request, ISearchContext &searchContext,
                                IAttributeContext &attrContext, const search::IDocumentMetaStore &metaStore,
-                               const Properties &feature_overrides) const;
+                               const Properties &feature_overrides,
+                               const GlobalFilterCache::Binding *global_filter_cache = nullptr) const;
 
     /**
      * Perform a search against this matcher.
@@ -120,6 +126,10 @@ public:
      * @param attrContext abstract view of attribute data
      * @param sessionManager multilevel grouping session cache
      * @param metaStore the document meta store used to map from lid to gid
+     *
+     * If the rank profile has a result cache, replies are cached per
+     * search handler in owned_objects and returned for identical
+     * requests until the search handler changes or they get too old.
      **/
     std::unique_ptr<search::engine::SearchReply>
     match(const SearchRequest &request, vespalib::ThreadBundle &threadBundle,
@@ -27,6 +27,8 @@ MatchingStats::MatchingStats()
       _docsRanked(0),
       _docsReRanked(0),
       _softDoomed(0),
+      _resultCacheHits(0),
+      _resultCacheMisses(0),
       _doomOvertime(),
       _softDoomFactor(INITIAL_SOFT_DOOM_FACTOR),
       _queryCollateralTime(), // TODO: Remove in Vespa 8
@@ -68,6 +70,8 @@ MatchingStats::add(const MatchingStats &rhs)
     _docsRanked += rhs._docsRanked;
     _docsReRanked += rhs._docsReRanked;
     _softDoomed += rhs.softDoomed();
+    _resultCacheHits += rhs._resultCacheHits;
+    _resultCacheMisses += rhs._resultCacheMisses;
     _doomOvertime.add(rhs._doomOvertime);
 
     _queryCollateralTime.add(rhs._queryCollateralTime); // TODO: Remove in Vespa 8
@@ -123,6 +123,8 @@ private:
     size_t                 _docsRanked;
     size_t                 _docsReRanked;
     size_t                 _softDoomed;
+    size_t                 _resultCacheHits;
+    size_t                 _resultCacheMisses;
     Avg                    _doomOvertime;
     double                 _softDoomFactor;
     Avg                    _queryCollateralTime; // TODO: Remove in Vespa 8
@@ -163,6 +165,12 @@ public:
     MatchingStats &softDoomed(size_t value) { _softDoomed = value; return *this; }
     size_t softDoomed() const { return _softDoomed; }
 
+    MatchingStats &resultCacheHits(size_t value) { _resultCacheHits = value; return *this; }
+    size_t resultCacheHits() const { return _resultCacheHits; }
+
+    MatchingStats &resultCacheMisses(size_t value) { _resultCacheMisses = value; return *this; }
+    size_t resultCacheMisses() const { return _resultCacheMisses; }
+
     vespalib::duration doomOvertime() const { return vespalib::from_s(_doomOvertime.max()); }
 
     MatchingStats &softDoomFactor(double value) { _softDoomFactor = value; return *this; }
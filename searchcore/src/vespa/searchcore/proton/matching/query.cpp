@@ -238,16 +238,26 @@ Query::fetchPostings()
 }
 
 void
-Query::handle_global_filters(uint32_t docid_limit, double global_filter_limit)
+Query::handle_global_filters(uint32_t docid_limit, double global_filter_limit,
+                             const GlobalFilterCache::Binding *global_filter_cache)
 {
     using search::queryeval::GlobalFilter;
     double estimated_hit_ratio = _blueprint->getState().hit_ratio(docid_limit);
     if (_blueprint->getState().want_global_filter() && estimated_hit_ratio >= global_filter_limit) {
-        auto constraint = Blueprint::FilterConstraint::UPPER_BOUND;
-        bool strict = true;
-        auto filter_iterator = _blueprint->createFilterSearch(strict, constraint);
-        filter_iterator->initRange(1, docid_limit);
-        auto white_list = filter_iterator->get_hits(1);
+        GlobalFilterCache::BitVectorSP white_list;
+        if (global_filter_cache != nullptr) {
+            white_list = global_filter_cache->lookup(docid_limit);
+        }
+        if (!white_list) {
+            auto constraint = Blueprint::FilterConstraint::UPPER_BOUND;
+            bool strict = true;
+            auto filter_iterator = _blueprint->createFilterSearch(strict, constraint);
+            filter_iterator->initRange(1, docid_limit);
+            white_list = filter_iterator->get_hits(1);
+            if (global_filter_cache != nullptr) {
+                global_filter_cache->insert(docid_limit, white_list);
+            }
+        }
         auto global_filter = GlobalFilter::create(std::move(white_list));
         _blueprint->set_global_filter(*global_filter);
         // optimized order may change after accounting for global filter:
@@ -2,6 +2,7 @@
 
 #pragma once
 
+#include "global_filter_cache.h"
 #include <vespa/searchlib/common/geo_location_spec.h>
 #include <vespa/searchlib/fef/itermdata.h>
 #include <vespa/searchlib/fef/matchdatalayout.h>
@@ -92,7 +93,14 @@ public:
      **/
     void optimize();
     void fetchPostings();
-    void handle_global_filters(uint32_t docidLimit, double global_filter_limit);
+    /**
+     * Calculate the global filter (white list of documents that may
+     * become hits) and pass it to the blueprints that want it. When a
+     * global filter cache is given, a cached filter is used if
+     * available, and a newly calculated filter is inserted.
+     **/
+    void handle_global_filters(uint32_t docidLimit, double global_filter_limit,
+                               const GlobalFilterCache::Binding *global_filter_cache = nullptr);
     void freeze();
 
     /**
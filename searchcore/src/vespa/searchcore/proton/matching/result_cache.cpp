@@ -0,0 +1,194 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "result_cache.h"
+#include <vespa/searchlib/engine/searchrequest.h>
+#include <vespa/searchlib/engine/searchreply.h>
+#include <vespa/vespalib/objects/nbostream.h>
+#include <vespa/vespalib/stllike/lrucache_map.hpp>
+#include <vespa/vespalib/stllike/hash_map.hpp>
+#include <algorithm>
+
+using search::engine::SearchRequest;
+using search::engine::SearchReply;
+using search::fef::Properties;
+using search::fef::Property;
+
+namespace proton::matching {
+
+namespace {
+
+class SortedPropertiesCollector : public search::fef::IPropertiesVisitor {
+public:
+    std::vector<std::pair<vespalib::string, Property::Values>> entries;
+
+    void visitProperty(const Property::Value &key, const Property &values) override {
+        Property::Values copy;
+        copy.reserve(values.size());
+        for (uint32_t i = 0; i < values.size(); ++i) {
+            copy.push_back(values.getAt(i));
+        }
+        entries.emplace_back(key, std::move(copy));
+    }
+};
+
+void
+serialize(vespalib::nbostream &os, const Properties &props)
+{
+    SortedPropertiesCollector collector;
+    props.visitProperties(collector);
+    std::sort(collector.entries.begin(), collector.entries.end(),
+              [](const auto &a, const auto &b) { return a.first < b.first; });
+    os << uint32_t(collector.entries.size());
+    for (const auto &entry : collector.entries) {
+        os << entry.first << uint32_t(entry.second.size());
+        for (const auto &value : entry.second) {
+            os << value;
+        }
+    }
+}
+
+}
+
+ResultCache::Entry::Entry()
+    : reply(),
+      created(),
+      bytes(0)
+{
+}
+
+ResultCache::Entry::Entry(std::unique_ptr<SearchReply> reply_, vespalib::steady_time created_, size_t bytes_)
+    : reply(std::move(reply_)),
+      created(created_),
+      bytes(bytes_)
+{
+}
+
+ResultCache::Entry::Entry(Entry &&) noexcept = default;
+ResultCache::Entry & ResultCache::Entry::operator = (Entry &&) noexcept = default;
+ResultCache::Entry::~Entry() = default;
+
+ResultCache::Lru::Lru(size_t maxBytes)
+    : vespalib::lrucache_map<LruParam>(UNLIMITED),
+      _maxBytes(maxBytes),
+      _bytes(0)
+{
+}
+
+ResultCache::Lru::~Lru() = default;
+
+bool
+ResultCache::Lru::removeOldest(const LruParam::value_type &v)
+{
+    if (_bytes > _maxBytes) {
+        _bytes -= v.second._value.bytes;
+        return true;
+    }
+    return false;
+}
+
+ResultCache::ResultCache(size_t maxBytes, vespalib::duration maxAge)
+    : _lock(),
+      _lru(maxBytes),
+      _owner(),
+      _maxAge(maxAge),
+      _numInvalidations(0)
+{
+}
+
+ResultCache::~ResultCache() = default;
+
+vespalib::string
+ResultCache::make_key(const SearchRequest &request)
+{
+    const auto &cache_props = request.propertiesMap.cacheProperties();
+    if (!request.groupSpec.empty() || cache_props.lookup("query").found() || cache_props.lookup("grouping").found() ||
+        request.dumpFeatures || (request.getTraceLevel() > 0))
+    {
+        return vespalib::string();
+    }
+    vespalib::nbostream os;
+    os << request.ranking << request.location << request.sortSpec;
+    os << request.offset << request.maxhits;
+    os << vespalib::stringref(request.getStackRef());
+    serialize(os, request.propertiesMap.rankProperties());
+    serialize(os, request.propertiesMap.featureOverrides());
+    serialize(os, request.propertiesMap.matchProperties());
+    serialize(os, request.propertiesMap.modelOverrides());
+    return vespalib::string(os.peek(), os.size());
+}
+
+size_t
+ResultCache::estimate_bytes(const vespalib::string &key, const SearchReply &reply)
+{
+    return sizeof(Entry) + sizeof(SearchReply) + key.size() +
+        reply.hits.size() * sizeof(SearchReply::Hit) +
+        reply.sortIndex.size() * sizeof(uint32_t) +
+        reply.sortData.size() + reply.groupResult.size();
+}
+
+void
+ResultCache::adjust_owner(const ViewSP &view)
+{
+    if (_owner.lock() != view) {
+        if (!_lru.empty()) {
+            ++_numInvalidations;
+        }
+        for (auto itr = _lru.begin(); itr != _lru.end(); ) {
+            itr = _lru.erase(itr);
+        }
+        _lru._bytes = 0;
+        _owner = view;
+    }
+}
+
+void
+ResultCache::erase(const vespalib::string &key)
+{
+    _lru._bytes -= _lru.get(key).bytes;
+    _lru.erase(key);
+}
+
+std::unique_ptr<SearchReply>
+ResultCache::lookup(const vespalib::string &key, const ViewSP &view, vespalib::steady_time now)
+{
+    std::lock_guard<std::mutex> guard(_lock);
+    adjust_owner(view);
+    Entry *entry = _lru.findAndRef(key);
+    if (entry == nullptr) {
+        return std::unique_ptr<SearchReply>();
+    }
+    if (entry->created + _maxAge < now) {
+        erase(key);
+        return std::unique_ptr<SearchReply>();
+    }
+    return std::make_unique<SearchReply>(*entry->reply);
+}
+
+void
+ResultCache::insert(const vespalib::string &key, const ViewSP &view, vespalib::steady_time now, const SearchReply &reply)
+{
+    size_t bytes = estimate_bytes(key, reply);
+    std::lock_guard<std::mutex> guard(_lock);
+    adjust_owner(view);
+    if (bytes > _lru._maxBytes) {
+        return;
+    }
+    if (_lru.hasKey(key)) {
+        erase(key);
+    }
+    _lru._bytes += bytes;
+    _lru.insert(key, Entry(std::make_unique<SearchReply>(reply), now, bytes));
+}
+
+ResultCache::Stats
+ResultCache::get_stats() const
+{
+    std::lock_guard<std::mutex> guard(_lock);
+    Stats stats;
+    stats.numEntries = _lru.size();
+    stats.memoryUsage = _lru._bytes;
+    stats.numInvalidations = _numInvalidations;
+    return stats;
+}
+
+}
@@ -0,0 +1,109 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <vespa/searchcore/proton/summaryengine/isearchhandler.h>
+#include <vespa/vespalib/stllike/lrucache_map.h>
+#include <vespa/vespalib/stllike/string.h>
+#include <vespa/vespalib/util/time.h>
+#include <memory>
+#include <mutex>
+
+namespace search::engine {
+    class SearchRequest;
+    class SearchReply;
+}
+
+namespace proton::matching {
+
+/**
+ * Cache of search replies for a single rank profile, keyed on the
+ * serialized query tree, the request properties and the requested
+ * window of hits.
+ *
+ * Cached replies are only valid for the search view (search handler)
+ * that produced them. When a lookup or insert is done with another
+ * search view than the one currently owning the cache, all entries
+ * are dropped. In addition, entries older than a configured max age
+ * are never returned, putting an upper bound on the staleness caused
+ * by documents being fed without the search view changing.
+ **/
+class ResultCache
+{
+public:
+    using SearchRequest = search::engine::SearchRequest;
+    using SearchReply = search::engine::SearchReply;
+    using ViewSP = std::shared_ptr<const ISearchHandler>;
+
+    struct Stats {
+        size_t numEntries;
+        size_t memoryUsage;
+        size_t numInvalidations;
+        Stats() : numEntries(0), memoryUsage(0), numInvalidations(0) {}
+    };
+
+private:
+    struct Entry {
+        std::unique_ptr<SearchReply> reply;
+        vespalib::steady_time        created;
+        size_t                       bytes;
+        Entry();
+        Entry(std::unique_ptr<SearchReply> reply_, vespalib::steady_time created_, size_t bytes_);
+        Entry(Entry &&) noexcept;
+        Entry & operator = (Entry &&) noexcept;
+        ~Entry();
+    };
+    using LruParam = vespalib::LruParam<vespalib::string, Entry>;
+
+    class Lru : public vespalib::lrucache_map<LruParam> {
+    public:
+        Lru(size_t maxBytes);
+        ~Lru() override;
+        bool removeOldest(const LruParam::value_type &v) override;
+        size_t _maxBytes;
+        size_t _bytes;
+    };
+
+    mutable std::mutex       _lock;
+    Lru                      _lru;
+    std::weak_ptr<const ISearchHandler> _owner;
+    vespalib::duration       _maxAge;
+    size_t                   _numInvalidations;
+
+    void adjust_owner(const ViewSP &view);
+    void erase(const vespalib::string &key);
+
+public:
+    ResultCache(size_t maxBytes, vespalib::duration maxAge);
+    ~ResultCache();
+
+    /**
+     * Create the cache key for the given request.
+     *
+     * @return the cache key, or an empty string if the reply for the
+     *         request can not be cached (grouping, cached search
+     *         sessions, tracing or feature dumping).
+     **/
+    static vespalib::string make_key(const SearchRequest &request);
+
+    /**
+     * Estimate the number of bytes used to cache the given reply.
+     **/
+    static size_t estimate_bytes(const vespalib::string &key, const SearchReply &reply);
+
+    /**
+     * Look up a cached reply.
+     *
+     * @return a copy of the cached reply, or nullptr on cache miss.
+     **/
+    std::unique_ptr<SearchReply> lookup(const vespalib::string &key, const ViewSP &view, vespalib::steady_time now);
+
+    /**
+     * Insert a copy of the given reply into the cache.
+     **/
+    void insert(const vespalib::string &key, const ViewSP &view, vespalib::steady_time now, const SearchReply &reply);
+
+    Stats get_stats() const;
+};
+
+}
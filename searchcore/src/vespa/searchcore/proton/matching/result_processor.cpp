@@ -61,7 +61,8 @@ ResultProcessor::ResultProcessor(IAttributeContext &attrContext,
                                  GroupingContext &groupingContext,
                                  const vespalib::string &sessionId,
                                  const vespalib::string &sortSpec,
-                                 size_t offset, size_t hits)
+                                 size_t offset, size_t hits,
+                                 const std::shared_ptr<const void> &groupingOwner)
     : _attrContext(attrContext),
       _metaStore(metaStore),
       _sessionMgr(sessionMgr),
@@ -73,12 +74,18 @@ ResultProcessor::ResultProcessor(IAttributeContext &attrContext,
       _wasMerged(false)
 {
     if (!_groupingContext.empty()) {
-        _groupingSession = std::make_unique<GroupingSession>(sessionId, _groupingContext, attrContext);
+        _groupingSession = std::make_unique<GroupingSession>(sessionId, _groupingContext, attrContext, groupingOwner);
     }
 }
 
 ResultProcessor::~ResultProcessor() = default;
 
+bool
+ResultProcessor::needs_all_scores() const
+{
+    return (!_groupingContext.empty() || !_sortSpec.empty());
+}
+
 void
 ResultProcessor::prepareThreadContextCreation(size_t num_threads)
 {
@@ -91,15 +91,24 @@ private:
     bool                                   _wasMerged;
 
 public:
+    /**
+     * @param groupingOwner if set, the grouping session keeps its
+     *        results for later passes against the same owner (search
+     *        view). See GroupingSession.
+     **/
     ResultProcessor(IAttributeContext &attrContext,
                     const search::IDocumentMetaStore & metaStore,
                     SessionManager & sessionMgr,
                     GroupingContext & groupingContext,
                     const vespalib::string & sessionId,
                     const vespalib::string & sortSpec,
-                    size_t offset, size_t hits);
+                    size_t offset, size_t hits,
+                    const std::shared_ptr<const void> &groupingOwner = std::shared_ptr<const void>());
     ~ResultProcessor();
 
+    // true if first phase scores of all hits are needed (grouping or sorting)
+    bool needs_all_scores() const;
+
     size_t countFS4Hits();
     void prepareThreadContextCreation(size_t num_threads);
     Context::UP createThreadContext(const vespalib::Doom & hardDoom, size_t thread_id, uint32_t distributionKey);
@@ -2,6 +2,7 @@
 #include "search_session.h"
 #include "match_tools.h"
 #include "match_context.h"
+#include <vespa/searchlib/common/featureset.h>
 
 namespace proton::matching {
 
@@ -12,15 +13,35 @@ SearchSession::SearchSession(const SessionId &id, vespalib::steady_time create_t
       _create_time(create_time),
       _time_of_doom(time_of_doom),
       _owned_objects(std::move(owned_objects)),
-      _match_tools_factory(std::move(match_tools_factory))
+      _match_tools_factory(std::move(match_tools_factory)),
+      _summary_features()
 {
 }
 
+void
+SearchSession::setSummaryFeatures(std::unique_ptr<search::FeatureSet> summary_features) {
+    _summary_features = std::move(summary_features);
+}
+
 void
 SearchSession::releaseEnumGuards() {
     _owned_objects.context->releaseEnumGuards();
 }
 
+size_t
+SearchSession::getMemoryUsage() const {
+    size_t bytes = sizeof(SearchSession) + _session_id.size();
+    if (_summary_features) {
+        const search::FeatureSet &features = *_summary_features;
+        bytes += sizeof(search::FeatureSet) + features.numDocs() * sizeof(uint32_t) +
+                 features.numDocs() * features.numFeatures() * sizeof(search::FeatureSet::Value);
+        for (const auto &name : features.getNames()) {
+            bytes += sizeof(name) + name.size();
+        }
+    }
+    return bytes;
+}
+
 SearchSession::~SearchSession() = default;
 
 SearchSession::OwnershipBundle::OwnershipBundle() = default;
@@ -8,6 +8,7 @@
 #include <vespa/vespalib/util/time.h>
 #include <memory>
 
+namespace search { class FeatureSet; }
 namespace search::fef { class Properties; }
 
 namespace proton::matching {
@@ -39,6 +40,7 @@ private:
     vespalib::steady_time _time_of_doom;
     OwnershipBundle       _owned_objects;
     std::unique_ptr<MatchToolsFactory> _match_tools_factory;
+    std::unique_ptr<search::FeatureSet> _summary_features;
 
 public:
     typedef std::shared_ptr<SearchSession> SP;
@@ -62,6 +64,20 @@ public:
     vespalib::steady_time getTimeOfDoom() const { return _time_of_doom; }
 
     MatchToolsFactory &getMatchToolsFactory() { return *_match_tools_factory; }
+
+    /**
+     * Summary features captured while matching, to be used instead of
+     * calculating them again when producing docsums. May be nullptr,
+     * and only contains (some of) the hits ranked in the second phase.
+     */
+    void setSummaryFeatures(std::unique_ptr<search::FeatureSet> summary_features);
+    const search::FeatureSet *getSummaryFeatures() const { return _summary_features.get(); }
+
+    /**
+     * Estimate of the memory used by this session, not including the
+     * shared search view and the objects owned by the match tools.
+     */
+    size_t getMemoryUsage() const;
 };
 
 }
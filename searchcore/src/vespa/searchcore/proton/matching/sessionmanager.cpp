@@ -20,24 +20,62 @@ protected:
     Stats _stats;
     mutable std::mutex _lock;
 
-    void entryDropped(const SessionId &id);
     ~SessionCacheBase() {}
 };
 
 template <typename T>
 struct SessionCache : SessionCacheBase {
     typedef typename T::UP EntryUP;
-    vespalib::lrucache_map<vespalib::LruParam<SessionId, EntryUP> > _cache;
+    struct Entry {
+        EntryUP session;
+        size_t  bytes;
+        Entry() : session(), bytes(0) {}
+        Entry(EntryUP session_, size_t bytes_) : session(std::move(session_)), bytes(bytes_) {}
+    };
+    using LruParam = vespalib::LruParam<SessionId, Entry>;
 
-    SessionCache(uint32_t max_size) : _cache(max_size) {}
+    // drops the least recently used sessions when either the number
+    // of sessions or their estimated memory usage is above the limit
+    class Lru : public vespalib::lrucache_map<LruParam> {
+    public:
+        Lru(size_t maxSize, size_t maxBytes, Stats &stats)
+            : vespalib::lrucache_map<LruParam>(maxSize),
+              _maxBytes(maxBytes),
+              _bytes(0),
+              _stats(stats)
+        {}
+        bool removeOldest(const typename LruParam::value_type &v) override {
+            if ((this->size() > this->capacity()) || ((_maxBytes > 0) && (_bytes > _maxBytes))) {
+                LOG(debug, "Session cache is full, dropping session '%s'", v.first.c_str());
+                _bytes -= v.second._value.bytes;
+                _stats.numDropped++;
+                return true;
+            }
+            return false;
+        }
+        size_t _maxBytes;
+        size_t _bytes;
+        Stats &_stats;
+    };
+    Lru _cache;
+
+    SessionCache(uint32_t max_size, size_t max_bytes) : _cache(max_size, max_bytes, _stats) {}
 
     void insert(EntryUP session) {
+        size_t bytes = session->getMemoryUsage();
         std::lock_guard<std::mutex> guard(_lock);
-        const SessionId &id(session->getSessionId());
-        if (_cache.size() >= _cache.capacity()) {
-            entryDropped(id);
+        const SessionId id(session->getSessionId());
+        if ((_cache._maxBytes > 0) && (bytes > _cache._maxBytes)) {
+            LOG(debug, "Session '%s' is too large to be cached (%zu bytes)", id.c_str(), bytes);
+            _stats.numDropped++;
+            return;
+        }
+        if (_cache.hasKey(id)) {
+            _cache._bytes -= _cache.get(id).bytes;
+            _cache.erase(id);
         }
-        _cache.insert(id, std::move(session));
+        _cache._bytes += bytes;
+        _cache.insert(id, Entry(std::move(session), bytes));
         _stats.numInsert++;
     }
     EntryUP pick(const SessionId & id) {
@@ -45,7 +83,9 @@ struct SessionCache : SessionCacheBase {
         EntryUP ret;
         if (_cache.hasKey(id)) {
             _stats.numPick++;
-            ret = std::move(_cache[id]);
+            Entry &entry = _cache[id];
+            ret = std::move(entry.session);
+            _cache._bytes -= entry.bytes;
             _cache.erase(id);
         }
         return ret;
@@ -59,9 +99,10 @@ struct SessionCache : SessionCacheBase {
         std::lock_guard<std::mutex> guard(_lock);
         toDestruct.reserve(_cache.size());
         for (auto it(_cache.begin()), mt(_cache.end()); it != mt;) {
-            auto &session = *it;
-            if (session->getTimeOfDoom() < currentTime) {
-                toDestruct.push_back(std::move(session));
+            auto &entry = *it;
+            if (entry.session->getTimeOfDoom() < currentTime) {
+                _cache._bytes -= entry.bytes;
+                toDestruct.push_back(std::move(entry.session));
                 it = _cache.erase(it);
                 _stats.numTimedout++;
             } else {
@@ -74,6 +115,7 @@ struct SessionCache : SessionCacheBase {
         std::lock_guard<std::mutex> guard(_lock);
         Stats stats = _stats;
         stats.numCached = _cache.size();
+        stats.memoryUsage = _cache._bytes;
         _stats = Stats();
         return stats;
     }
@@ -131,6 +173,9 @@ struct SessionMap : SessionCacheBase {
         std::lock_guard<std::mutex> guard(_lock);
         Stats stats = _stats;
         stats.numCached = _map.size();
+        for (const auto &entry: _map) {
+            stats.memoryUsage += entry.second->getMemoryUsage();
+        }
         _stats = Stats();
         return stats;
     }
@@ -151,11 +196,6 @@ struct SessionMap : SessionCacheBase {
     }
 };
 
-void SessionCacheBase::entryDropped(const SessionId &id) {
-    LOG(debug, "Session cache is full, dropping entry to fit session '%s'", id.c_str());
-    _stats.numDropped++;
-}
-
 }
 
 struct GroupingSessionCache : public SessionCache<search::grouping::GroupingSession> {
@@ -168,9 +208,11 @@ struct SearchSessionCache : public SessionMap<SearchSession> {
 };
 
 
-SessionManager::SessionManager(uint32_t maxSize)
-    : _grouping_cache(std::make_unique<GroupingSessionCache>(maxSize)),
-      _search_map(std::make_unique<SearchSessionCache>()) {
+SessionManager::SessionManager(uint32_t maxSize, size_t maxBytesGrouping, bool keepGroupingResults)
+    : _grouping_cache(std::make_unique<GroupingSessionCache>(maxSize, maxBytesGrouping)),
+      _search_map(std::make_unique<SearchSessionCache>()),
+      _keepGroupingResults(keepGroupingResults)
+{
 }
 
 SessionManager::~SessionManager() { }
@@ -22,13 +22,15 @@ public:
               numPick(0),
               numDropped(0),
               numCached(0),
-              numTimedout(0)
+              numTimedout(0),
+              memoryUsage(0)
         {}
         uint32_t numInsert;
         uint32_t numPick;
         uint32_t numDropped;
         uint32_t numCached;
         uint32_t numTimedout;
+        size_t   memoryUsage; // estimated bytes used by cached sessions
     };
 
     struct SearchSessionInfo {
@@ -44,14 +46,25 @@ public:
 private:
     std::unique_ptr<GroupingSessionCache> _grouping_cache;
     std::unique_ptr<SearchSessionCache> _search_map;
+    bool _keepGroupingResults;
 
 public:
     typedef std::unique_ptr<SessionManager> UP;
     typedef std::shared_ptr<SessionManager> SP;
 
-    SessionManager(uint32_t maxSizeGrouping);
+    /**
+     * @param maxSizeGrouping max number of cached grouping sessions.
+     * @param maxBytesGrouping max estimated bytes used by cached
+     *        grouping sessions, 0 means no limit.
+     * @param keepGroupingResults keep the results of grouping sessions
+     *        after all levels have been delivered, so continuation
+     *        passes can be served without matching again.
+     **/
+    SessionManager(uint32_t maxSizeGrouping, size_t maxBytesGrouping = 0, bool keepGroupingResults = false);
     ~SessionManager() override;
 
+    bool keepGroupingResults() const { return _keepGroupingResults; }
+
     void insert(search::grouping::GroupingSession::UP session);
     search::grouping::GroupingSession::UP pickGrouping(const SessionId &id);
     Stats getGroupingStats();
@@ -17,11 +17,44 @@ ContentProtonMetrics::ProtonExecutorMetrics::ProtonExecutorMetrics(metrics::Metr
 
 ContentProtonMetrics::ProtonExecutorMetrics::~ProtonExecutorMetrics() = default;
 
+ContentProtonMetrics::SearchAdmissionMetrics::SearchAdmissionMetrics(metrics::MetricSet *parent)
+    : metrics::MetricSet("admission", {}, "Metrics for search admission control in the match engine", parent),
+      admitted("admitted", {}, "Number of searches admitted from the admission queue", this),
+      shedExpired("shed_expired", {}, "Number of searches shed because they timed out while queued", this),
+      shedCost("shed_cost", {}, "Number of searches shed because their remaining time was shorter than their expected search time", this),
+      queueSize("queue_size", {}, "Number of searches waiting in the admission queue", this)
+{
+}
+
+ContentProtonMetrics::SearchAdmissionMetrics::~SearchAdmissionMetrics() = default;
+
+void
+ContentProtonMetrics::SearchAdmissionMetrics::update(const SearchAdmissionQueue::Stats &stats)
+{
+    admitted.inc(stats.admitted);
+    shedExpired.inc(stats.shedExpired);
+    shedCost.inc(stats.shedCost);
+    queueSize.set(stats.queued);
+}
+
+ContentProtonMetrics::RestartMetrics::RestartMetrics(metrics::MetricSet *parent)
+    : metrics::MetricSet("restart", {}, "Metrics used to predict the duration of a restart", parent),
+      predictedReplayTime("predicted_replay_time", {}, "Predicted time (in seconds) to replay the transaction log if restarted now", this),
+      replayBytesPerSecond("replay_bytes_per_second", {}, "Observed transaction log replay speed", this),
+      flushWriteBytesPerSecond("flush_write_bytes_per_second", {}, "Observed speed of writing flush targets to disk", this)
+{
+}
+
+ContentProtonMetrics::RestartMetrics::~RestartMetrics() = default;
+
 ContentProtonMetrics::ContentProtonMetrics()
     : metrics::MetricSet("content.proton", {}, "Search engine metrics", nullptr),
       transactionLog(this),
       resourceUsage(this),
-      executor(this)
+      executor(this),
+      admission(this),
+      hwCounters(this),
+      restart(this)
 {
 }
 
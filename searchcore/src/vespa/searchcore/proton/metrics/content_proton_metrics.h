@@ -3,9 +3,11 @@
 #pragma once
 
 #include "executor_metrics.h"
+#include "hw_counter_metrics.h"
 #include "resource_usage_metrics.h"
 #include "trans_log_server_metrics.h"
 #include <vespa/metrics/metrics.h>
+#include <vespa/searchcore/proton/matchengine/search_admission_queue.h>
 
 namespace proton {
 
@@ -32,9 +34,34 @@ struct ContentProtonMetrics : metrics::MetricSet
         ~ProtonExecutorMetrics();
     };
 
+    struct SearchAdmissionMetrics : metrics::MetricSet {
+
+        metrics::LongCountMetric admitted;
+        metrics::LongCountMetric shedExpired;
+        metrics::LongCountMetric shedCost;
+        metrics::LongValueMetric queueSize;
+
+        void update(const SearchAdmissionQueue::Stats &stats);
+        SearchAdmissionMetrics(metrics::MetricSet *parent);
+        ~SearchAdmissionMetrics();
+    };
+
+    struct RestartMetrics : metrics::MetricSet {
+
+        metrics::DoubleValueMetric predictedReplayTime;
+        metrics::DoubleValueMetric replayBytesPerSecond;
+        metrics::DoubleValueMetric flushWriteBytesPerSecond;
+
+        RestartMetrics(metrics::MetricSet *parent);
+        ~RestartMetrics();
+    };
+
     TransLogServerMetrics transactionLog;
     ResourceUsageMetrics resourceUsage;
     ProtonExecutorMetrics executor;
+    SearchAdmissionMetrics admission;
+    HwCounterMetrics hwCounters;
+    RestartMetrics restart;
 
     ContentProtonMetrics();
     ~ContentProtonMetrics();
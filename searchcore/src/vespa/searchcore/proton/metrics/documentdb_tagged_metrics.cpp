@@ -54,13 +54,16 @@ DocumentDBTaggedMetrics::SubDBMetrics::LidSpaceMetrics::LidSpaceMetrics(MetricSe
 
 DocumentDBTaggedMetrics::SubDBMetrics::LidSpaceMetrics::~LidSpaceMetrics() = default;
 
-DocumentDBTaggedMetrics::SubDBMetrics::DocumentStoreMetrics::CacheMetrics::CacheMetrics(MetricSet *parent)
-    : MetricSet("cache", {}, "Document store cache metrics", parent),
+DocumentDBTaggedMetrics::SubDBMetrics::DocumentStoreMetrics::CacheMetrics::CacheMetrics(const vespalib::string &name,
+                                                                                    const vespalib::string &description,
+                                                                                    MetricSet *parent)
+    : MetricSet(name, {}, description, parent),
       memoryUsage("memory_usage", {}, "Memory usage of the cache (in bytes)", this),
       elements("elements", {}, "Number of elements in the cache", this),
       hitRate("hit_rate", {}, "Rate of hits in the cache compared to number of lookups", this),
       lookups("lookups", {}, "Number of lookups in the cache (hits + misses)", this),
-      invalidations("invalidations", {}, "Number of invalidations (erased elements) in the cache. ", this)
+      invalidations("invalidations", {}, "Number of invalidations (erased elements) in the cache. ", this),
+      rejections("rejections", {}, "Number of elements read from disk that the admission filter did not insert in the cache", this)
 {
 }
 
@@ -72,7 +75,9 @@ DocumentDBTaggedMetrics::SubDBMetrics::DocumentStoreMetrics::DocumentStoreMetric
       diskBloat("disk_bloat", {}, "Disk space bloat in bytes", this),
       maxBucketSpread("max_bucket_spread", {}, "Max bucket spread in underlying files (sum(unique buckets in each chunk)/unique buckets in file)", this),
       memoryUsage(this),
-      cache(this)
+      cache("cache", "Document store cache metrics", this),
+      lookupCache("lookup_cache", "Document store cache metrics for single document lookups", this),
+      visitCache("visit_cache", "Document store cache metrics for visiting sets of documents", this)
 {
 }
 
@@ -150,6 +155,8 @@ DocumentDBTaggedMetrics::MatchingMetrics::RankProfileMetrics::RankProfileMetrics
       queries("queries", {}, "Number of queries executed", this),
       limitedQueries("limited_queries", {}, "Number of queries limited in match phase", this),
       softDoomedQueries("soft_doomed_queries", {}, "Number of queries hitting the soft timeout", this),
+      resultCacheHits("result_cache_hits", {}, "Number of queries answered from the result cache", this),
+      resultCacheMisses("result_cache_misses", {}, "Number of cacheable queries not found in the result cache", this),
       softDoomFactor("soft_doom_factor", {}, "Factor used to compute soft-timeout", this),
       matchTime("match_time", {}, "Average time (sec) for matching a query (1st phase)", this),
       groupingTime("grouping_time", {}, "Average time (sec) spent on grouping", this),
@@ -199,6 +206,8 @@ DocumentDBTaggedMetrics::MatchingMetrics::RankProfileMetrics::update(const Match
     queries.inc(stats.queries());
     limitedQueries.inc(stats.limited_queries());
     softDoomedQueries.inc(stats.softDoomed());
+    resultCacheHits.inc(stats.resultCacheHits());
+    resultCacheMisses.inc(stats.resultCacheMisses());
     softDoomFactor.set(stats.softDoomFactor());
     matchTime.addValueBatch(stats.matchTimeAvg(), stats.matchTimeCount(),
                             stats.matchTimeMin(), stats.matchTimeMax());
@@ -245,6 +254,19 @@ DocumentDBTaggedMetrics::DocumentsMetrics::DocumentsMetrics(metrics::MetricSet *
 
 DocumentDBTaggedMetrics::DocumentsMetrics::~DocumentsMetrics() = default;
 
+DocumentDBTaggedMetrics::FeedingMetrics::FeedingMetrics(metrics::MetricSet *parent)
+    : metrics::MetricSet("feeding", {}, "Metrics for feed operations in this document db", parent),
+      queueLatency("queue_latency", {}, "Time (in seconds) a feed operation waits for the master write thread", this),
+      logLatency("log_latency", {}, "Time (in seconds) from the master write thread starts handling a feed operation "
+                 "until it is committed to the transaction log", this),
+      applyLatency("apply_latency", {}, "Time (in seconds) from the master write thread starts handling a feed operation "
+                   "until it is applied to document store, attributes and index", this),
+      totalLatency("total_latency", {}, "Time (in seconds) from a feed operation is received until it is acked", this)
+{
+}
+
+DocumentDBTaggedMetrics::FeedingMetrics::~FeedingMetrics() = default;
+
 DocumentDBTaggedMetrics::DocumentDBTaggedMetrics(const vespalib::string &docTypeName, size_t maxNumThreads_)
     : MetricSet("documentdb", {{"documenttype", docTypeName}}, "Document DB metrics", nullptr),
       job(this),
@@ -257,6 +279,7 @@ DocumentDBTaggedMetrics::DocumentDBTaggedMetrics(const vespalib::string &docType
       matching(this),
       sessionCache(this),
       documents(this),
+      feeding(this),
       totalMemoryUsage(this),
       totalDiskUsage("disk_usage", {}, "The total disk usage (in bytes) for this document db", this),
       maxNumThreads(maxNumThreads_)
@@ -57,8 +57,9 @@ struct DocumentDBTaggedMetrics : metrics::MetricSet
                 metrics::LongAverageMetric hitRate;
                 metrics::LongCountMetric lookups;
                 metrics::LongCountMetric invalidations;
+                metrics::LongCountMetric rejections;
 
-                CacheMetrics(metrics::MetricSet *parent);
+                CacheMetrics(const vespalib::string &name, const vespalib::string &description, metrics::MetricSet *parent);
                 ~CacheMetrics() override;
             };
 
@@ -67,6 +68,8 @@ struct DocumentDBTaggedMetrics : metrics::MetricSet
             metrics::DoubleValueMetric maxBucketSpread;
             MemoryUsageMetrics memoryUsage;
             CacheMetrics cache;
+            CacheMetrics lookupCache;
+            CacheMetrics visitCache;
 
             DocumentStoreMetrics(metrics::MetricSet *parent);
             ~DocumentStoreMetrics() override;
@@ -141,6 +144,8 @@ struct DocumentDBTaggedMetrics : metrics::MetricSet
             metrics::LongCountMetric     queries;
             metrics::LongCountMetric     limitedQueries;
             metrics::LongCountMetric     softDoomedQueries;
+            metrics::LongCountMetric     resultCacheHits;
+            metrics::LongCountMetric     resultCacheMisses;
             metrics::DoubleValueMetric   softDoomFactor;
             metrics::DoubleAverageMetric matchTime;
             metrics::DoubleAverageMetric groupingTime;
@@ -183,6 +188,16 @@ struct DocumentDBTaggedMetrics : metrics::MetricSet
         ~DocumentsMetrics() override;
     };
 
+    struct FeedingMetrics : metrics::MetricSet {
+        metrics::DoubleAverageMetric queueLatency;
+        metrics::DoubleAverageMetric logLatency;
+        metrics::DoubleAverageMetric applyLatency;
+        metrics::DoubleAverageMetric totalLatency;
+
+        FeedingMetrics(metrics::MetricSet *parent);
+        ~FeedingMetrics() override;
+    };
+
     JobMetrics job;
     AttributeMetrics attribute;
     IndexMetrics index;
@@ -193,6 +208,7 @@ struct DocumentDBTaggedMetrics : metrics::MetricSet
     MatchingMetrics matching;
     SessionCacheMetrics sessionCache;
     DocumentsMetrics documents;
+    FeedingMetrics feeding;
     MemoryUsageMetrics totalMemoryUsage;
     metrics::LongValueMetric totalDiskUsage;
     size_t maxNumThreads;
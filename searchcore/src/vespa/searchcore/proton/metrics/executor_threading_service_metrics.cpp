@@ -2,6 +2,8 @@
 
 #include "executor_threading_service_metrics.h"
 #include "executor_threading_service_stats.h"
+#include <algorithm>
+#include <numeric>
 
 namespace proton {
 
@@ -12,7 +14,9 @@ ExecutorThreadingServiceMetrics::ExecutorThreadingServiceMetrics(const std::stri
       summary("summary", this),
       indexFieldInverter("index_field_inverter", this),
       indexFieldWriter("index_field_writer", this),
-      attributeFieldWriter("attribute_field_writer", this)
+      attributeFieldWriter("attribute_field_writer", this),
+      attributeFieldWriterMaxStrandShare("attribute_field_writer_max_strand_share", {},
+                                         "Share of the attribute field writer tasks handled by the busiest executor id (strand)", this)
 {
 }
 
@@ -27,6 +31,11 @@ ExecutorThreadingServiceMetrics::update(const ExecutorThreadingServiceStats &sta
     indexFieldInverter.update(stats.getIndexFieldInverterExecutorStats());
     indexFieldWriter.update(stats.getIndexFieldWriterExecutorStats());
     attributeFieldWriter.update(stats.getAttributeFieldWriterExecutorStats());
+    const auto &tasks = stats.getAttributeFieldWriterTasksPerExecutorId();
+    size_t total = std::accumulate(tasks.begin(), tasks.end(), size_t(0));
+    if (total > 0) {
+        attributeFieldWriterMaxStrandShare.set(double(*std::max_element(tasks.begin(), tasks.end())) / total);
+    }
 }
 
 }
@@ -20,6 +20,7 @@ struct ExecutorThreadingServiceMetrics : metrics::MetricSet
     ExecutorMetrics indexFieldInverter;
     ExecutorMetrics indexFieldWriter;
     ExecutorMetrics attributeFieldWriter;
+    metrics::DoubleValueMetric attributeFieldWriterMaxStrandShare;
 
     void update(const ExecutorThreadingServiceStats &stats);
     ExecutorThreadingServiceMetrics(const std::string &name, metrics::MetricSet *parent);
@@ -10,14 +10,16 @@ ExecutorThreadingServiceStats::ExecutorThreadingServiceStats(Stats masterExecuto
                                                              Stats sharedExecutorStats,
                                                              Stats indexFieldInverterExecutorStats,
                                                              Stats indexFieldWriterExecutorStats,
-                                                             Stats attributeFieldWriterExecutorStats)
+                                                             Stats attributeFieldWriterExecutorStats,
+                                                             std::vector<size_t> attributeFieldWriterTasksPerExecutorId)
     : _masterExecutorStats(masterExecutorStats),
       _indexExecutorStats(indexExecutorStats),
       _summaryExecutorStats(summaryExecutorStats),
       _sharedExecutorStats(sharedExecutorStats),
       _indexFieldInverterExecutorStats(indexFieldInverterExecutorStats),
       _indexFieldWriterExecutorStats(indexFieldWriterExecutorStats),
-      _attributeFieldWriterExecutorStats(attributeFieldWriterExecutorStats)
+      _attributeFieldWriterExecutorStats(attributeFieldWriterExecutorStats),
+      _attributeFieldWriterTasksPerExecutorId(std::move(attributeFieldWriterTasksPerExecutorId))
 {
 }
 
@@ -3,6 +3,7 @@
 
 #include <cstddef>
 #include <vespa/vespalib/util/executor_stats.h>
+#include <vector>
 
 namespace proton {
 
@@ -22,6 +23,7 @@ private:
     Stats _indexFieldInverterExecutorStats;
     Stats _indexFieldWriterExecutorStats;
     Stats _attributeFieldWriterExecutorStats;
+    std::vector<size_t> _attributeFieldWriterTasksPerExecutorId;
 public:
     ExecutorThreadingServiceStats(Stats masterExecutorStats,
                                   Stats indexExecutorStats,
@@ -29,7 +31,8 @@ public:
                                   Stats sharedExecutorStats,
                                   Stats indexFieldInverterExecutorStats,
                                   Stats indexFieldWriterExecutorStats,
-                                  Stats attributeFieldWriterExecutorStats);
+                                  Stats attributeFieldWriterExecutorStats,
+                                  std::vector<size_t> attributeFieldWriterTasksPerExecutorId);
     ~ExecutorThreadingServiceStats();
 
     const Stats &getMasterExecutorStats() const { return _masterExecutorStats; }
@@ -39,6 +42,7 @@ public:
     const Stats &getIndexFieldInverterExecutorStats() const { return _indexFieldInverterExecutorStats; }
     const Stats &getIndexFieldWriterExecutorStats() const { return _indexFieldWriterExecutorStats; }
     const Stats &getAttributeFieldWriterExecutorStats() const { return _attributeFieldWriterExecutorStats; }
+    const std::vector<size_t> &getAttributeFieldWriterTasksPerExecutorId() const { return _attributeFieldWriterTasksPerExecutorId; }
 };
 
 }
@@ -0,0 +1,19 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "hw_counter_metrics.h"
+
+namespace proton {
+
+HwCounterMetrics::HwCounterMetrics(metrics::MetricSet *parent)
+    : MetricSet("hw_counters", {}, "Metrics derived from hardware performance counters for this process", parent),
+      ipc("ipc", {}, "Instructions retired per cpu cycle", this),
+      cacheMissesPerKiloInstruction("cache_misses_per_kilo_instruction", {}, "Last level cache misses per 1000 instructions", this),
+      branchMissesPerKiloInstruction("branch_misses_per_kilo_instruction", {}, "Branch mispredictions per 1000 instructions", this),
+      cycles("cycles", {}, "Number of cpu cycles used by this process", this),
+      instructions("instructions", {}, "Number of instructions retired by this process", this)
+{
+}
+
+HwCounterMetrics::~HwCounterMetrics() = default;
+
+} // namespace proton
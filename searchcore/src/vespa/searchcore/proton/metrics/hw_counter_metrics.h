@@ -0,0 +1,24 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <vespa/metrics/metrics.h>
+
+namespace proton {
+
+/**
+ * Metrics derived from hardware performance counters sampled for this process.
+ */
+struct HwCounterMetrics : metrics::MetricSet
+{
+    metrics::DoubleValueMetric ipc;
+    metrics::DoubleValueMetric cacheMissesPerKiloInstruction;
+    metrics::DoubleValueMetric branchMissesPerKiloInstruction;
+    metrics::LongCountMetric cycles;
+    metrics::LongCountMetric instructions;
+
+    HwCounterMetrics(metrics::MetricSet *parent);
+    ~HwCounterMetrics();
+};
+
+} // namespace proton
@@ -11,7 +11,8 @@ SessionManagerMetrics::SessionManagerMetrics(const vespalib::string &name, metri
       numPick("num_pick", {}, "Number if picked sessions", this),
       numDropped("num_dropped", {}, "Number of dropped cached sessions", this),
       numCached("num_cached", {}, "Number of currently cached sessions", this),
-      numTimedout("num_timedout", {}, "Number of timed out sessions", this)
+      numTimedout("num_timedout", {}, "Number of timed out sessions", this),
+      memoryUsage("memory_usage", {}, "Estimated memory used by cached sessions (bytes)", this)
 {
 }
 
@@ -25,6 +26,7 @@ SessionManagerMetrics::update(const proton::matching::SessionManager::Stats &sta
     numDropped.inc(stats.numDropped);
     numCached.set(stats.numCached);
     numTimedout.inc(stats.numTimedout);
+    memoryUsage.set(stats.memoryUsage);
 }
 
 }
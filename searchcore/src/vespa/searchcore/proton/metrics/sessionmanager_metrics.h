@@ -19,6 +19,7 @@ struct SessionManagerMetrics : metrics::MetricSet
     metrics::LongCountMetric numDropped;
     metrics::LongValueMetric numCached;
     metrics::LongCountMetric numTimedout;
+    metrics::LongValueMetric memoryUsage;
 
     void update(const proton::matching::SessionManager::Stats &stats);
     SessionManagerMetrics(const vespalib::string &name, metrics::MetricSet *parent);
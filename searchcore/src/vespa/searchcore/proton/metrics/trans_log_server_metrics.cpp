@@ -13,7 +13,12 @@ TransLogServerMetrics::DomainMetrics::DomainMetrics(metrics::MetricSet *parent,
             "Transaction log metrics for a document type", parent),
       entries("entries", {}, "The current number of entries in the transaction log", this),
       diskUsage("disk_usage", {}, "The disk usage (in bytes) of the transaction log", this),
-      replayTime("replay_time", {}, "The replay time (in seconds) of the transaction log during start-up", this)
+      replayTime("replay_time", {}, "The replay time (in seconds) of the transaction log during start-up", this),
+      commitBatchSize("commit_batch_size", {}, "The number of commits written and synced together in group commit mode", this),
+      syncLatency("sync_latency", {}, "The latency (in seconds) of syncing a group commit batch to disk", this),
+      _lastNumCommitBatches(0),
+      _lastNumBatchedCommits(0),
+      _lastBatchSyncTime(0.0)
 {
 }
 
@@ -25,6 +30,15 @@ TransLogServerMetrics::DomainMetrics::update(const DomainInfo &stats)
     entries.set(stats.numEntries);
     diskUsage.set(stats.byteSize);
     replayTime.set(stats.maxSessionRunTime.count());
+    // the domain only tracks totals, so report the average over the batches since the last update
+    size_t numBatches = stats.numCommitBatches - _lastNumCommitBatches;
+    if (numBatches > 0) {
+        commitBatchSize.addTotalValueWithCount(stats.numBatchedCommits - _lastNumBatchedCommits, numBatches);
+        syncLatency.addTotalValueWithCount(stats.batchSyncTime.count() - _lastBatchSyncTime, numBatches);
+    }
+    _lastNumCommitBatches = stats.numCommitBatches;
+    _lastNumBatchedCommits = stats.numBatchedCommits;
+    _lastBatchSyncTime = stats.batchSyncTime.count();
 }
 
 void
@@ -18,6 +18,11 @@ public:
         metrics::LongValueMetric entries;
         metrics::LongValueMetric diskUsage;
         metrics::DoubleValueMetric replayTime;
+        metrics::LongAverageMetric commitBatchSize;
+        metrics::DoubleAverageMetric syncLatency;
+        size_t _lastNumCommitBatches;
+        size_t _lastNumBatchedCommits;
+        double _lastBatchSyncTime;
 
         typedef std::unique_ptr<DomainMetrics> UP;
         DomainMetrics(metrics::MetricSet *parent, const vespalib::string &documentType);
@@ -206,14 +206,12 @@ public:
     { }
     MatchVisitor & allowVisitCaching(bool allow) { _allowVisitCaching = allow; return *this; }
     void visit(uint32_t lid, document::Document::UP doc) override {
-        const search::DocumentMetaData & meta = _metaData[_lidIndexMap[lid]];
-        assert(lid == meta.lid);
-        if (_matcher.match(meta, doc.get())) {
-            if (doc && _fields) {
-                document::FieldSet::stripFields(*doc, *_fields);
-            }
-            _list.emplace_back(createDocEntry(meta.timestamp, meta.removed, std::move(doc), _defaultSerializedSize));
-        }
+        process(lid, std::move(doc), _defaultSerializedSize);
+    }
+    void visit(uint32_t lid, document::Document::UP doc, size_t serializedSize) override {
+        // The stored size is only valid when no fields are stripped away
+        bool allFields = (!_fields || (_fields->getType() == document::FieldSet::Type::ALL));
+        process(lid, std::move(doc), (allFields && (_defaultSerializedSize < 0)) ? ssize_t(serializedSize) : _defaultSerializedSize);
     }
 
     bool allowVisitCaching() const override {
@@ -226,8 +224,19 @@ private:
     const LidIndexMap                      & _lidIndexMap;
     const document::FieldSet               * _fields;
     IterateResult::List                    & _list;
-    size_t                                   _defaultSerializedSize;
+    ssize_t                                  _defaultSerializedSize;
     bool                                     _allowVisitCaching;
+
+    void process(uint32_t lid, document::Document::UP doc, ssize_t serializedSize) {
+        const search::DocumentMetaData & meta = _metaData[_lidIndexMap[lid]];
+        assert(lid == meta.lid);
+        if (_matcher.match(meta, doc.get())) {
+            if (doc && _fields) {
+                document::FieldSet::stripFields(*doc, *_fields);
+            }
+            _list.emplace_back(createDocEntry(meta.timestamp, meta.removed, std::move(doc), serializedSize));
+        }
+    }
 };
 
 }
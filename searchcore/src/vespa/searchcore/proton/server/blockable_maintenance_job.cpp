@@ -43,7 +43,8 @@ BlockableMaintenanceJob::BlockableMaintenanceJob(const vespalib::string &name,
       _blocked(false),
       _runner(nullptr),
       _resourceLimitFactor(config.getResourceLimitFactor()),
-      _moveOpsLimiter(std::make_shared<MoveOperationLimiter>(this, config.getMaxOutstandingMoveOps()))
+      _moveOpsLimiter(std::make_shared<MoveOperationLimiter>(this, config.getMaxOutstandingMoveOps())),
+      _maxDocsToMovePerBatch(config.getMaxDocsToMovePerBatch())
 {
 }
 
@@ -32,6 +32,7 @@ private:
 
 protected:
     MoveOperationLimiter::SP _moveOpsLimiter;
+    uint32_t                 _maxDocsToMovePerBatch;
 
     void internalNotifyDiskMemUsage(const DiskMemUsageState &state);
 
@@ -53,6 +54,7 @@ public:
     void setBlocked(BlockedReason reason) override;
     void unBlock(BlockedReason reason) override;
     bool isBlocked() const override;
+    bool isDeferrable() const override { return true; }
     void registerRunner(IMaintenanceJobRunner *runner) override { _runner = runner; }
 
 };
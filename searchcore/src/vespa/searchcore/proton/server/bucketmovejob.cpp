@@ -334,7 +334,7 @@ BucketMoveJob::run()
     if (isBlocked()) {
         return true; // indicate work is done, since node state is bad
     }
-    scanAndMove(200, 1);
+    scanAndMove(200, _maxDocsToMovePerBatch);
     if (isBlocked(BlockedReason::OUTSTANDING_OPS)) {
         return true;
     }
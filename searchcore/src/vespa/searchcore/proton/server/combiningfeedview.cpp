@@ -143,6 +143,12 @@ CombiningFeedView::handleUpdate(FeedToken token, const UpdateOperation &updOp)
     _views[subDbId]->handleUpdate(std::move(token), updOp);
 }
 
+bool
+CombiningFeedView::isAttributeOnlyUpdate(const UpdateOperation &updOp) const
+{
+    return updOp.getValidDbdId() && _views[updOp.getSubDbId()]->isAttributeOnlyUpdate(updOp);
+}
+
 void
 CombiningFeedView::prepareRemove(RemoveOperation &rmOp)
 {
@@ -69,6 +69,7 @@ public:
     void handlePut(FeedToken token, const PutOperation &putOp) override;
     void prepareUpdate(UpdateOperation &updOp) override;
     void handleUpdate(FeedToken token, const UpdateOperation &updOp) override;
+    bool isAttributeOnlyUpdate(const UpdateOperation &updOp) const override;
     void prepareRemove(RemoveOperation &rmOp) override;
     void handleRemove(FeedToken token, const RemoveOperation &rmOp) override;
     void prepareDeleteBucket(DeleteBucketOperation &delOp) override;
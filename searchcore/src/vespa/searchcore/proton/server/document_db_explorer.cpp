@@ -4,6 +4,8 @@
 
 #include "document_meta_store_read_guards.h"
 #include "document_subdb_collection_explorer.h"
+#include "feed_latency_explorer.h"
+#include "feedhandler.h"
 #include "maintenance_controller_explorer.h"
 #include <vespa/searchcore/proton/common/state_reporter_utils.h>
 #include <vespa/searchcore/proton/bucketdb/bucket_db_explorer.h>
@@ -45,11 +47,12 @@ const vespalib::string SUB_DB = "subdb";
 const vespalib::string BUCKET_DB = "bucketdb";
 const vespalib::string MAINTENANCE_CONTROLLER = "maintenancecontroller";
 const vespalib::string SESSION = "session";
+const vespalib::string FEEDING = "feeding";
 
 std::vector<vespalib::string>
 DocumentDBExplorer::get_children_names() const
 {
-    return {SUB_DB, BUCKET_DB, MAINTENANCE_CONTROLLER, SESSION};
+    return {SUB_DB, BUCKET_DB, MAINTENANCE_CONTROLLER, SESSION, FEEDING};
 }
 
 std::unique_ptr<StateExplorer>
@@ -68,6 +71,8 @@ DocumentDBExplorer::get_child(vespalib::stringref name) const
     } else if (name == SESSION) {
         return std::unique_ptr<StateExplorer>
             (new matching::SessionManagerExplorer(_docDb->session_manager()));
+    } else if (name == FEEDING) {
+        return std::make_unique<FeedLatencyExplorer>(_docDb->getFeedHandler().getLatencyTracker());
     }
     return std::unique_ptr<StateExplorer>(nullptr);
 }
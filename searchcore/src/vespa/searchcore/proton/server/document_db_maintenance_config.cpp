@@ -1,6 +1,7 @@
 // Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 
 #include "document_db_maintenance_config.h"
+#include <algorithm>
 
 namespace proton {
 
@@ -99,20 +100,41 @@ DocumentDBLidSpaceCompactionConfig::operator==(const DocumentDBLidSpaceCompactio
 
 BlockableMaintenanceJobConfig::BlockableMaintenanceJobConfig()
     : _resourceLimitFactor(1.0),
-      _maxOutstandingMoveOps(10)
+      _maxOutstandingMoveOps(10),
+      _maxDocsToMovePerBatch(1)
 {}
 
 BlockableMaintenanceJobConfig::BlockableMaintenanceJobConfig(double resourceLimitFactor,
-                                                             uint32_t maxOutstandingMoveOps)
+                                                             uint32_t maxOutstandingMoveOps,
+                                                             uint32_t maxDocsToMovePerBatch)
     : _resourceLimitFactor(resourceLimitFactor),
-      _maxOutstandingMoveOps(maxOutstandingMoveOps)
+      _maxOutstandingMoveOps(maxOutstandingMoveOps),
+      _maxDocsToMovePerBatch(std::max(1u, maxDocsToMovePerBatch))
 {}
 
 bool
 BlockableMaintenanceJobConfig::operator==(const BlockableMaintenanceJobConfig &rhs) const
 {
     return _resourceLimitFactor == rhs._resourceLimitFactor &&
-           _maxOutstandingMoveOps == rhs._maxOutstandingMoveOps;
+           _maxOutstandingMoveOps == rhs._maxOutstandingMoveOps &&
+           _maxDocsToMovePerBatch == rhs._maxDocsToMovePerBatch;
+}
+
+MaintenanceJobPacingConfig::MaintenanceJobPacingConfig()
+    : _maxFeedBacklog(0),
+      _maxDeferredRuns(4)
+{}
+
+MaintenanceJobPacingConfig::MaintenanceJobPacingConfig(uint32_t maxFeedBacklog, uint32_t maxDeferredRuns)
+    : _maxFeedBacklog(maxFeedBacklog),
+      _maxDeferredRuns(maxDeferredRuns)
+{}
+
+bool
+MaintenanceJobPacingConfig::operator==(const MaintenanceJobPacingConfig &rhs) const
+{
+    return _maxFeedBacklog == rhs._maxFeedBacklog &&
+           _maxDeferredRuns == rhs._maxDeferredRuns;
 }
 
 DocumentDBMaintenanceConfig::DocumentDBMaintenanceConfig()
@@ -124,7 +146,8 @@ DocumentDBMaintenanceConfig::DocumentDBMaintenanceConfig()
       _attributeUsageFilterConfig(),
       _attributeUsageSampleInterval(60s),
       _blockableJobConfig(),
-      _flushConfig()
+      _flushConfig(),
+      _pacingConfig()
 {
 }
 
@@ -139,7 +162,8 @@ DocumentDBMaintenanceConfig(const DocumentDBPruneRemovedDocumentsConfig &pruneRe
                             const AttributeUsageFilterConfig &attributeUsageFilterConfig,
                             vespalib::duration attributeUsageSampleInterval,
                             const BlockableMaintenanceJobConfig &blockableJobConfig,
-                            const DocumentDBFlushConfig &flushConfig)
+                            const DocumentDBFlushConfig &flushConfig,
+                            const MaintenanceJobPacingConfig &pacingConfig)
     : _pruneRemovedDocuments(pruneRemovedDocuments),
       _heartBeat(heartBeat),
       _sessionCachePruneInterval(groupingSessionPruneInterval),
@@ -148,7 +172,8 @@ DocumentDBMaintenanceConfig(const DocumentDBPruneRemovedDocumentsConfig &pruneRe
       _attributeUsageFilterConfig(attributeUsageFilterConfig),
       _attributeUsageSampleInterval(attributeUsageSampleInterval),
       _blockableJobConfig(blockableJobConfig),
-      _flushConfig(flushConfig)
+      _flushConfig(flushConfig),
+      _pacingConfig(pacingConfig)
 {
 }
 
@@ -164,7 +189,8 @@ operator==(const DocumentDBMaintenanceConfig &rhs) const
         _attributeUsageFilterConfig == rhs._attributeUsageFilterConfig &&
         _attributeUsageSampleInterval == rhs._attributeUsageSampleInterval &&
         _blockableJobConfig == rhs._blockableJobConfig &&
-        _flushConfig == rhs._flushConfig;
+        _flushConfig == rhs._flushConfig &&
+        _pacingConfig == rhs._pacingConfig;
 }
 
 } // namespace proton
@@ -78,14 +78,31 @@ class BlockableMaintenanceJobConfig {
 private:
     double _resourceLimitFactor;
     uint32_t _maxOutstandingMoveOps;
+    uint32_t _maxDocsToMovePerBatch;
 
 public:
     BlockableMaintenanceJobConfig();
     BlockableMaintenanceJobConfig(double resourceLimitFactor,
-                                  uint32_t maxOutstandingMoveOps);
+                                  uint32_t maxOutstandingMoveOps,
+                                  uint32_t maxDocsToMovePerBatch = 1);
     bool operator==(const BlockableMaintenanceJobConfig &rhs) const;
     double getResourceLimitFactor() const { return _resourceLimitFactor; }
     uint32_t getMaxOutstandingMoveOps() const { return _maxOutstandingMoveOps; }
+    uint32_t getMaxDocsToMovePerBatch() const { return _maxDocsToMovePerBatch; }
+};
+
+class MaintenanceJobPacingConfig {
+private:
+    uint32_t _maxFeedBacklog;
+    uint32_t _maxDeferredRuns;
+
+public:
+    MaintenanceJobPacingConfig();
+    MaintenanceJobPacingConfig(uint32_t maxFeedBacklog, uint32_t maxDeferredRuns);
+    bool operator==(const MaintenanceJobPacingConfig &rhs) const;
+    bool isEnabled() const { return _maxFeedBacklog > 0 && _maxDeferredRuns > 0; }
+    uint32_t getMaxFeedBacklog() const { return _maxFeedBacklog; }
+    uint32_t getMaxDeferredRuns() const { return _maxDeferredRuns; }
 };
 
 class DocumentDBMaintenanceConfig
@@ -103,6 +120,7 @@ private:
     vespalib::duration                    _attributeUsageSampleInterval;
     BlockableMaintenanceJobConfig         _blockableJobConfig;
     DocumentDBFlushConfig                 _flushConfig;
+    MaintenanceJobPacingConfig            _pacingConfig;
 
 public:
     DocumentDBMaintenanceConfig();
@@ -114,7 +132,8 @@ public:
                                 const AttributeUsageFilterConfig &attributeUsageFilterConfig,
                                 vespalib::duration attributeUsageSampleInterval,
                                 const BlockableMaintenanceJobConfig &blockableJobConfig,
-                                const DocumentDBFlushConfig &flushConfig);
+                                const DocumentDBFlushConfig &flushConfig,
+                                const MaintenanceJobPacingConfig &pacingConfig = MaintenanceJobPacingConfig());
 
     DocumentDBMaintenanceConfig(const DocumentDBMaintenanceConfig &) = delete;
     DocumentDBMaintenanceConfig & operator = (const DocumentDBMaintenanceConfig &) = delete;
@@ -148,6 +167,7 @@ public:
         return _blockableJobConfig;
     }
     const DocumentDBFlushConfig &getFlushConfig() const { return _flushConfig; }
+    const MaintenanceJobPacingConfig &getPacingConfig() const { return _pacingConfig; }
 };
 
 } // namespace proton
@@ -19,23 +19,33 @@ namespace proton {
 
 typedef IDocumentMetaStore::Iterator Iterator;
 
-void
-DocumentBucketMover::moveDocument(DocumentIdT lid,
-                                  const document::GlobalId &gid,
-                                  Timestamp timestamp)
+std::unique_ptr<MoveOperation>
+DocumentBucketMover::createMoveOperation(DocumentIdT lid,
+                                         const document::GlobalId &gid,
+                                         Timestamp timestamp)
 {
     Document::SP doc(_source->retriever()->getFullDocument(lid).release());
     if (!doc || doc->getId().getGlobalId() != gid)
-        return; // Failed to retrieve document, removed or changed identity
+        return std::unique_ptr<MoveOperation>(); // Failed to retrieve document, removed or changed identity
     // TODO(geirst): what if doc is NULL?
     BucketId bucketId = _bucket.stripUnused();
-    MoveOperation op(bucketId, timestamp, doc, DbDocumentId(_source->sub_db_id(), lid), _targetSubDbId);
+    return std::make_unique<MoveOperation>(bucketId, timestamp, doc, DbDocumentId(_source->sub_db_id(), lid), _targetSubDbId);
+}
 
-    // We cache the bucket for the document we are going to move to avoid getting
+void
+DocumentBucketMover::moveBatch(const std::vector<std::unique_ptr<MoveOperation>> &ops)
+{
+    std::vector<MoveOperation *> batch;
+    batch.reserve(ops.size());
+    for (const auto &op : ops) {
+        batch.push_back(op.get());
+    }
+    // We cache the bucket for the documents we are going to move to avoid getting
     // inconsistent bucket info (getBucketInfo()) while moving between ready and not-ready
     // sub dbs as the bucket info is not updated atomically in this case.
-    _bucketDb->takeGuard()->cacheBucket(bucketId);
-    _handler->handleMove(op, _limiter.beginOperation());
+    _bucketDb->takeGuard()->cacheBucket(_bucket.stripUnused());
+    // The batch counts as a single operation towards the limit of outstanding move operations.
+    _handler->handleMoveBatch(batch, _limiter.beginOperation());
     _bucketDb->takeGuard()->uncacheBucket();
 }
 
@@ -130,8 +140,16 @@ DocumentBucketMover::moveDocuments(size_t maxDocsToMove)
     if (itr == end) {
         setBucketDone();
     }
+    std::vector<std::unique_ptr<MoveOperation>> ops;
+    ops.reserve(toMove.size());
     for (const MoveKey & key : toMove) {
-        moveDocument(key._lid, key._gid, key._timestamp);
+        auto op = createMoveOperation(key._lid, key._gid, key._timestamp);
+        if (op) {
+            ops.push_back(std::move(op));
+        }
+    }
+    if (!ops.empty()) {
+        moveBatch(ops);
     }
 }
 
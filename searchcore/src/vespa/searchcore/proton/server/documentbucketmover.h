@@ -7,6 +7,7 @@
 #include <vespa/searchlib/query/base.h>
 #include <persistence/spi/types.h>
 #include "ifrozenbuckethandler.h"
+#include <memory>
 
 namespace proton {
 
@@ -14,6 +15,7 @@ class BucketDBOwner;
 struct IDocumentMoveHandler;
 struct IMoveOperationLimiter;
 class MaintenanceDocumentSubDB;
+class MoveOperation;
 
 /**
  * Class used to move all documents in a bucket from a source sub database
@@ -33,9 +35,10 @@ private:
     document::GlobalId              _lastGid;
     bool                            _lastGidValid;
 
-    void moveDocument(search::DocumentIdT lid,
-                      const document::GlobalId &gid,
-                      storage::spi::Timestamp timestamp);
+    std::unique_ptr<MoveOperation> createMoveOperation(search::DocumentIdT lid,
+                                                       const document::GlobalId &gid,
+                                                       storage::spi::Timestamp timestamp);
+    void moveBatch(const std::vector<std::unique_ptr<MoveOperation>> &ops);
 
     void setBucketDone();
 public:
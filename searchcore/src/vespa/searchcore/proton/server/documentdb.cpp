@@ -86,7 +86,8 @@ makeSubDBConfig(const ProtonConfig::Distribution & distCfg, const Allocation & a
 
 index::IndexConfig
 makeIndexConfig(const ProtonConfig::Index & cfg) {
-    return index::IndexConfig(WarmupConfig(vespalib::from_s(cfg.warmup.time), cfg.warmup.unpack), cfg.maxflushed, cfg.cache.size);
+    return index::IndexConfig(WarmupConfig(vespalib::from_s(cfg.warmup.time), cfg.warmup.unpack), cfg.maxflushed, cfg.cache.size,
+                              cfg.postinglist.asyncread.threads);
 }
 
 ProtonConfig::Documentdb _G_defaultProtonDocumentDBConfig;
@@ -114,6 +115,7 @@ DocumentDB::DocumentDB(const vespalib::string &baseDir,
                        const vespalib::string &tlsSpec,
                        matching::QueryLimiter &queryLimiter,
                        const vespalib::Clock &clock,
+                       const vespalib::eval::ConstantValueFactory &constantValueFactory,
                        const DocTypeName &docTypeName,
                        document::BucketSpace bucketSpace,
                        const ProtonConfig &protonCfg,
@@ -156,7 +158,9 @@ DocumentDB::DocumentDB(const vespalib::string &baseDir,
       _bucketHandler(_writeService.master()),
       _indexCfg(makeIndexConfig(protonCfg.index)),
       _config_store(std::move(config_store)),
-      _sessionManager(std::make_shared<matching::SessionManager>(protonCfg.grouping.sessionmanager.maxentries)),
+      _sessionManager(std::make_shared<matching::SessionManager>(protonCfg.grouping.sessionmanager.maxentries,
+                                                                 protonCfg.grouping.sessionmanager.maxbytes,
+                                                                 protonCfg.grouping.sessionmanager.keepresults)),
       _metricsWireService(metricsWireService),
       _metricsHook(*this, _docTypeName.getName(), protonCfg.numthreadspersearch),
       _feedView(),
@@ -170,16 +174,16 @@ DocumentDB::DocumentDB(const vespalib::string &baseDir,
       _feedHandler(std::make_unique<FeedHandler>(_writeService, tlsSpec, docTypeName, *this, _writeFilter, *this, tlsWriterFactory)),
       _visibility(*_feedHandler, _writeService, _feedView),
       _subDBs(*this, *this, *_feedHandler, _docTypeName, _writeService, warmupExecutor, fileHeaderContext,
-              metricsWireService, getMetrics(), queryLimiter, clock, _configMutex, _baseDir,
+              metricsWireService, getMetrics(), queryLimiter, clock, constantValueFactory, _configMutex, _baseDir,
               makeSubDBConfig(protonCfg.distribution,
                               findDocumentDB(protonCfg.documentdb, docTypeName.getName())->allocation,
                               protonCfg.numsearcherthreads),
               hwInfo),
-      _maintenanceController(_writeService.master(), sharedExecutor, _docTypeName),
+      _maintenanceController(_writeService.master(), sharedExecutor, _docTypeName, &_writeService),
       _lidSpaceCompactionHandlers(),
       _jobTrackers(),
       _calc(),
-      _metricsUpdater(_subDBs, _writeService, _jobTrackers, *_sessionManager, _writeFilter, _state)
+      _metricsUpdater(_subDBs, _writeService, _jobTrackers, *_sessionManager, _writeFilter, *_feedHandler, _state)
 {
     assert(configSnapshot);
 
@@ -187,6 +191,12 @@ DocumentDB::DocumentDB(const vespalib::string &baseDir,
 
     _feedHandler->init(_config_store->getOldestSerialNum());
     _feedHandler->setBucketDBHandler(&_subDBs.getBucketDBHandler());
+    const auto &feedingCfg = findDocumentDB(protonCfg.documentdb, docTypeName.getName())->feeding;
+    _feedHandler->setMaxCoalescedUpdates(feedingCfg.maxcoalescedupdates);
+    if (feedingCfg.latency.enabled) {
+        _feedHandler->setLatencyTracker(std::make_shared<FeedLatencyTracker>(vespalib::from_s(feedingCfg.latency.slowlimit),
+                                                                             feedingCfg.latency.maxslowoperations));
+    }
     saveInitialConfig(*configSnapshot);
     resumeSaveConfig();
     SerialNum configSerial = _config_store->getPrevValidSerial(_feedHandler->getPrunedSerialNum() + 1);
@@ -665,6 +675,7 @@ DocumentDB::onTransactionLogReplayDone()
 {
     // Called by executor thread
     _subDBs.onReplayDone();
+    _owner.reportTransactionLogReplay(_feedHandler->getReplayedBytes(), _feedHandler->getReplayTime());
     if (!_owner.isInitializing()) {
         // This document db is added when system is up,
         // must signal that all existing buckets must be checked.
@@ -771,6 +782,13 @@ DocumentDB::getDocsums(const DocsumRequest & request)
     return view->getDocsums(request);
 }
 
+std::unique_ptr<DocsumReply>
+DocumentDB::getDocsums(const DocsumRequest & request, vespalib::ThreadBundle &threadBundle)
+{
+    ISearchHandler::SP view(_subDBs.getReadySubDB()->getSearchView());
+    return view->getDocsums(request, threadBundle);
+}
+
 IFlushTarget::List
 DocumentDB::getFlushTargets()
 {
@@ -44,6 +44,7 @@ namespace search {
 }
 
 namespace vespa::config::search::core::internal { class InternalProtonType; }
+namespace vespalib::eval { struct ConstantValueFactory; }
 
 namespace proton {
 class AttributeConfigInspector;
@@ -247,6 +248,7 @@ public:
                const vespalib::string &tlsSpec,
                matching::QueryLimiter &queryLimiter,
                const vespalib::Clock &clock,
+               const vespalib::eval::ConstantValueFactory &constantValueFactory,
                const DocTypeName &docTypeName,
                document::BucketSpace bucketSpace,
                const ProtonConfig &protonCfg,
@@ -378,6 +380,9 @@ public:
     std::unique_ptr<search::engine::DocsumReply>
     getDocsums(const search::engine::DocsumRequest & request);
 
+    std::unique_ptr<search::engine::DocsumReply>
+    getDocsums(const search::engine::DocsumRequest & request, vespalib::ThreadBundle &threadBundle);
+
     IFlushTargetList getFlushTargets();
     void flushDone(SerialNum flushedSerial);
     virtual SerialNum getCurrentSerialNumber() const;
@@ -5,6 +5,7 @@
 #include "documentdb_metrics_updater.h"
 #include "documentsubdbcollection.h"
 #include "executorthreadingservice.h"
+#include "feedhandler.h"
 #include "idocumentsubdb.h"
 #include <vespa/searchcommon/attribute/status.h>
 #include <vespa/searchcore/proton/attribute/attribute_usage_filter.h>
@@ -35,12 +36,14 @@ DocumentDBMetricsUpdater::DocumentDBMetricsUpdater(const DocumentSubDBCollection
                                                    DocumentDBJobTrackers &jobTrackers,
                                                    matching::SessionManager &sessionManager,
                                                    const AttributeUsageFilter &writeFilter,
+                                                   const FeedHandler &feedHandler,
                                                    [[maybe_unused]] const DDBState &state)
     : _subDBs(subDBs),
       _writeService(writeService),
       _jobTrackers(jobTrackers),
       _sessionManager(sessionManager),
-      _writeFilter(writeFilter)
+      _writeFilter(writeFilter),
+      _feedHandler(feedHandler)
 {
 }
 
@@ -235,10 +238,23 @@ updateCountMetric(uint64_t currVal, uint64_t lastVal, metrics::LongCountMetric &
     metric.inc(delta);
 }
 
+void
+updateDocumentStoreCacheMetrics(DocumentDBTaggedMetrics::SubDBMetrics::DocumentStoreMetrics::CacheMetrics &metrics,
+                                const CacheStats &cacheStats, CacheStats &lastCacheStats)
+{
+    metrics.memoryUsage.set(cacheStats.memory_used);
+    metrics.elements.set(cacheStats.elements);
+    updateDocumentStoreCacheHitRate(cacheStats, lastCacheStats, metrics.hitRate);
+    updateCountMetric(cacheStats.lookups(), lastCacheStats.lookups(), metrics.lookups);
+    updateCountMetric(cacheStats.invalidations, lastCacheStats.invalidations, metrics.invalidations);
+    updateCountMetric(cacheStats.rejections, lastCacheStats.rejections, metrics.rejections);
+    lastCacheStats = cacheStats;
+}
+
 void
 updateDocumentStoreMetrics(DocumentDBTaggedMetrics::SubDBMetrics::DocumentStoreMetrics &metrics,
                            const IDocumentSubDB *subDb,
-                           CacheStats &lastCacheStats,
+                           DocumentDBMetricsUpdater::SubDbCacheStats &lastCacheStats,
                            TotalStats &totalStats)
 {
     const ISummaryManager::SP &summaryMgr = subDb->getSummaryManager();
@@ -251,12 +267,9 @@ updateDocumentStoreMetrics(DocumentDBTaggedMetrics::SubDBMetrics::DocumentStoreM
 
     search::CacheStats cacheStats = backingStore.getCacheStats();
     totalStats.memoryUsage.incAllocatedBytes(cacheStats.memory_used);
-    metrics.cache.memoryUsage.set(cacheStats.memory_used);
-    metrics.cache.elements.set(cacheStats.elements);
-    updateDocumentStoreCacheHitRate(cacheStats, lastCacheStats, metrics.cache.hitRate);
-    updateCountMetric(cacheStats.lookups(), lastCacheStats.lookups(), metrics.cache.lookups);
-    updateCountMetric(cacheStats.invalidations, lastCacheStats.invalidations, metrics.cache.invalidations);
-    lastCacheStats = cacheStats;
+    updateDocumentStoreCacheMetrics(metrics.cache, cacheStats, lastCacheStats.total);
+    updateDocumentStoreCacheMetrics(metrics.lookupCache, backingStore.getLookupCacheStats(), lastCacheStats.lookup);
+    updateDocumentStoreCacheMetrics(metrics.visitCache, backingStore.getVisitCacheStats(), lastCacheStats.visit);
 }
 
 void
@@ -281,6 +294,28 @@ updateLidSpaceMetrics(MetricSetType &metrics, const search::IDocumentMetaStore &
     metrics.lidFragmentationFactor.set(stats.getLidFragmentationFactor());
 }
 
+void
+updateLatencyMetric(metrics::DoubleAverageMetric &metric, const FeedLatencyTracker::Latency &latency)
+{
+    if (latency.count() > 0) {
+        metric.addValueBatch(latency.average(), latency.count(), latency.min(), latency.max());
+    }
+}
+
+void
+updateFeedingMetrics(DocumentDBTaggedMetrics::FeedingMetrics &metrics, const FeedHandler &feedHandler)
+{
+    const auto &tracker = feedHandler.getLatencyTracker();
+    if (!tracker) {
+        return;
+    }
+    FeedLatencyTracker::Stats stats = tracker->sampleStats();
+    updateLatencyMetric(metrics.queueLatency, stats.queue);
+    updateLatencyMetric(metrics.logLatency, stats.log);
+    updateLatencyMetric(metrics.applyLatency, stats.apply);
+    updateLatencyMetric(metrics.totalLatency, stats.total);
+}
+
 }
 
 void
@@ -295,6 +330,7 @@ DocumentDBMetricsUpdater::updateMetrics(DocumentDBTaggedMetrics &metrics)
     updateDocumentsMetrics(metrics, _subDBs);
     updateDocumentStoreMetrics(metrics, _subDBs, _lastDocStoreCacheStats, totalStats);
     updateMiscMetrics(metrics, threadingServiceStats);
+    updateFeedingMetrics(metrics.feeding, _feedHandler);
 
     metrics.totalMemoryUsage.update(totalStats.memoryUsage);
     metrics.totalDiskUsage.set(totalStats.diskUsage);
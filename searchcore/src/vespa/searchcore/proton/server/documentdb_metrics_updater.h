@@ -14,6 +14,7 @@ class DocumentDBJobTrackers;
 class DocumentSubDBCollection;
 class ExecutorThreadingService;
 class ExecutorThreadingServiceStats;
+class FeedHandler;
 
 /**
  * Class used to update metrics for a document db.
@@ -21,10 +22,16 @@ class ExecutorThreadingServiceStats;
 class DocumentDBMetricsUpdater {
 public:
 
+    struct SubDbCacheStats {
+        search::CacheStats total;
+        search::CacheStats lookup;
+        search::CacheStats visit;
+        SubDbCacheStats() : total(), lookup(), visit() {}
+    };
     struct DocumentStoreCacheStats {
-        search::CacheStats readySubDb;
-        search::CacheStats notReadySubDb;
-        search::CacheStats removedSubDb;
+        SubDbCacheStats readySubDb;
+        SubDbCacheStats notReadySubDb;
+        SubDbCacheStats removedSubDb;
         DocumentStoreCacheStats() : readySubDb(), notReadySubDb(), removedSubDb() {}
     };
 
@@ -34,6 +41,7 @@ private:
     DocumentDBJobTrackers &_jobTrackers;
     matching::SessionManager &_sessionManager;
     const AttributeUsageFilter &_writeFilter;
+    const FeedHandler &_feedHandler;
     // Last updated document store cache statistics. Necessary due to metrics implementation is upside down.
     DocumentStoreCacheStats _lastDocStoreCacheStats;
 
@@ -46,6 +54,7 @@ public:
                              DocumentDBJobTrackers &jobTrackers,
                              matching::SessionManager &sessionManager,
                              const AttributeUsageFilter &writeFilter,
+                             const FeedHandler &feedHandler,
                              const DDBState &state);
     ~DocumentDBMetricsUpdater();
 
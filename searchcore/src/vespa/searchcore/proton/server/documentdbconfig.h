@@ -133,6 +133,9 @@ private:
     template <typename T>
     bool equals(const T * lhs, const T * rhs) const
     {
+        if (lhs == rhs) {
+            return true;
+        }
         if (lhs == NULL) {
             return rhs == NULL;
         }
@@ -141,6 +144,9 @@ private:
     template <typename T, typename Func>
     bool equals(const T *lhs, const T *rhs, Func isEqual) const
     {
+        if (lhs == rhs) {
+            return true;
+        }
         if (lhs == NULL) {
             return rhs == NULL;
         }
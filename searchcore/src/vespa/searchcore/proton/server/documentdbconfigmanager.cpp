@@ -146,10 +146,14 @@ buildMaintenanceConfig(const BootstrapConfig::SP &bootstrapConfig,
             vespalib::from_s(proton.writefilter.sampleinterval),
             BlockableMaintenanceJobConfig(
                     proton.maintenancejobs.resourcelimitfactor,
-                    proton.maintenancejobs.maxoutstandingmoveops),
+                    proton.maintenancejobs.maxoutstandingmoveops,
+                    proton.maintenancejobs.maxdocstomoveperbatch),
             DocumentDBFlushConfig(
                     proton.index.maxflushed,
-                    proton.index.maxflushedretired));
+                    proton.index.maxflushedretired),
+            MaintenanceJobPacingConfig(
+                    proton.maintenancejobs.pacing.maxfeedbacklog,
+                    proton.maintenancejobs.pacing.maxdeferredruns));
 }
 
 template<typename T>
@@ -184,6 +188,7 @@ getStoreConfig(const ProtonConfig::Summary::Cache & cache, const HwInfo & hwInfo
                       : cache.maxbytes;
     return DocumentStore::Config(deriveCompression(cache.compression), maxBytes, cache.initialentries)
             .allowVisitCaching(cache.allowvisitcaching)
+            .cacheAdmissionFilter(cache.admissionfilter)
             .updateStrategy(derive(cache.updateStrategy));
 }
 
@@ -193,12 +198,17 @@ deriveConfig(const ProtonConfig::Summary & summary, const ProtonConfig::Flush::M
     const ProtonConfig::Summary::Log & log(summary.log);
     const ProtonConfig::Summary::Log::Chunk & chunk(log.chunk);
     WriteableFileChunk::Config fileConfig(deriveCompression(chunk.compression), chunk.maxbytes);
+    fileConfig.setGroupCommit(chunk.groupcommit.minbytes, vespalib::from_s(chunk.groupcommit.maxdelay));
     LogDataStore::Config logConfig;
     logConfig.setMaxFileSize(log.maxfilesize)
             .setMaxNumLids(log.maxnumlids)
             .setMaxDiskBloatFactor(std::min(flush.diskbloatfactor, flush.each.diskbloatfactor))
             .setMaxBucketSpread(log.maxbucketspread).setMinFileSizeFactor(log.minfilesizefactor)
+            .setMaxBucketSpreadWhenVisited(log.maxbucketspreadwhenvisited)
             .compactCompression(deriveCompression(log.compact.compression))
+            .setCompactDictionarySize(log.compact.dictionarysize)
+            .setCompactIoRateLimit(log.compact.ioratelimit)
+            .setCompactIoLatencyTarget(vespalib::from_s(log.compact.iolatencytarget))
             .setFileConfig(fileConfig).disableCrcOnRead(chunk.skipcrconread);
     return LogDocumentStore::Config(config, logConfig);
 }
@@ -211,6 +221,17 @@ using AttributesConfigSP = DocumentDBConfig::AttributesConfigSP;
 using AttributesConfigBuilder = vespa::config::search::AttributesConfigBuilder;
 using AttributesConfigBuilderSP = std::shared_ptr<AttributesConfigBuilder>;
 
+template <typename ConfigType>
+std::shared_ptr<ConfigType>
+reuseOrGet(const config::ConfigSnapshot &snapshot, const vespalib::string &configId,
+           std::shared_ptr<ConfigType> current, int64_t currentGeneration)
+{
+    if (current && !snapshot.isChanged<ConfigType>(configId, currentGeneration)) {
+        return current;
+    }
+    return snapshot.getConfig<ConfigType>(configId);
+}
+
 AttributesConfigSP
 filterImportedAttributes(const AttributesConfigSP &attrCfg)
 {
@@ -333,13 +354,36 @@ DocumentDBConfigManager::update(const ConfigSnapshot &snapshot)
             LOG_ABORT("Cannot use bad index schema, validation failed");
         }
     }
-    AttributesConfigSP newAttributesConfig = snapshot.getConfig<AttributesConfig>(_configId);
-    SummaryConfigSP newSummaryConfig = snapshot.getConfig<SummaryConfig>(_configId);
-    SummarymapConfigSP newSummarymapConfig = snapshot.getConfig<SummarymapConfig>(_configId);
-    JuniperrcConfigSP newJuniperrcConfig = snapshot.getConfig<JuniperrcConfig>(_configId);
-    ImportedFieldsConfigSP newImportedFieldsConfig = snapshot.getConfig<ImportedFieldsConfig>(_configId);
-
-    Schema::SP schema(buildSchema(*newAttributesConfig, *newSummaryConfig, *newIndexschemaConfig));
+    // Sub configs that did not change since the current snapshot are reused
+    // as is, avoiding both parsing them again and comparing them in depth.
+    SummaryConfigSP newSummaryConfig = reuseOrGet<SummaryConfig>(snapshot, _configId,
+                                                    current ? current->getSummaryConfigSP() : SummaryConfigSP(),
+                                                    currentGeneration);
+    SummarymapConfigSP newSummarymapConfig = reuseOrGet<SummarymapConfig>(snapshot, _configId,
+                                                    current ? current->getSummarymapConfigSP() : SummarymapConfigSP(),
+                                                    currentGeneration);
+    JuniperrcConfigSP newJuniperrcConfig = reuseOrGet<JuniperrcConfig>(snapshot, _configId,
+                                                    current ? current->getJuniperrcConfigSP() : JuniperrcConfigSP(),
+                                                    currentGeneration);
+    ImportedFieldsConfigSP newImportedFieldsConfig = reuseOrGet<ImportedFieldsConfig>(snapshot, _configId,
+                                                    current ? current->getImportedFieldsConfigSP() : ImportedFieldsConfigSP(),
+                                                    currentGeneration);
+
+    AttributesConfigSP newAttributesConfig;
+    Schema::SP schema;
+    if (current &&
+        !snapshot.isChanged<AttributesConfig>(_configId, currentGeneration) &&
+        !snapshot.isChanged<SummaryConfig>(_configId, currentGeneration) &&
+        !snapshot.isChanged<IndexschemaConfig>(_configId, currentGeneration))
+    {
+        // the stored attributes config is already filtered
+        newAttributesConfig = current->getAttributesConfigSP();
+        schema = current->getSchemaSP();
+    } else {
+        AttributesConfigSP attributesConfig = snapshot.getConfig<AttributesConfig>(_configId);
+        schema = buildSchema(*attributesConfig, *newSummaryConfig, *newIndexschemaConfig);
+        newAttributesConfig = filterImportedAttributes(attributesConfig);
+    }
     newMaintenanceConfig = buildMaintenanceConfig(_bootstrapConfig, _docTypeName);
     search::LogDocumentStore::Config storeConfig = buildStoreConfig(_bootstrapConfig->getProtonConfig(),
                                                                     _bootstrapConfig->getHwInfo());
@@ -351,7 +395,7 @@ DocumentDBConfigManager::update(const ConfigSnapshot &snapshot)
                                  newRankingConstants,
                                  newOnnxModels,
                                  newIndexschemaConfig,
-                                 filterImportedAttributes(newAttributesConfig),
+                                 newAttributesConfig,
                                  newSummaryConfig,
                                  newSummarymapConfig,
                                  newJuniperrcConfig,
@@ -210,6 +210,12 @@ public:
             _visitor.visit(lid, std::move(doc));
         }
     }
+    void visit(uint32_t lid, document::Document::UP doc, size_t serializedSize) override {
+        if (doc) {
+            _retriever.populate(lid, *doc);
+            _visitor.visit(lid, std::move(doc), serializedSize);
+        }
+    }
 
     bool allowVisitCaching() const override {
         return _visitor.allowVisitCaching();
@@ -40,6 +40,7 @@ DocumentSubDBCollection::DocumentSubDBCollection(
         DocumentDBTaggedMetrics &metrics,
         matching::QueryLimiter &queryLimiter,
         const vespalib::Clock &clock,
+        const vespalib::eval::ConstantValueFactory &constantValueFactory,
         std::mutex &configMutex,
         const vespalib::string &baseDir,
         const Config & cfg,
@@ -72,7 +73,7 @@ DocumentSubDBCollection::DocumentSubDBCollection(
                     cfg.getNumSearchThreads()),
                 SearchableDocSubDB::Context(
                         FastAccessDocSubDB::Context(context, metrics.ready.attributes, metricsWireService),
-                        queryLimiter, clock, warmupExecutor)));
+                        queryLimiter, clock, warmupExecutor, constantValueFactory)));
 
     _subDBs.push_back
         (new StoreOnlyDocSubDB(
@@ -16,6 +16,8 @@ namespace vespalib {
     class ThreadStackExecutorBase;
 }
 
+namespace vespalib::eval { struct ConstantValueFactory; }
+
 namespace search {
     namespace common { class FileHeaderContext; }
     namespace transactionlog { class SyncProxy; }
@@ -110,6 +112,7 @@ public:
             DocumentDBTaggedMetrics &metrics,
             matching::QueryLimiter & queryLimiter,
             const vespalib::Clock &clock,
+            const vespalib::eval::ConstantValueFactory &constantValueFactory,
             std::mutex &configMutex,
             const vespalib::string &baseDir,
             const Config & cfg,
@@ -46,7 +46,8 @@ ExecutorThreadingService::ExecutorThreadingService(vespalib::SyncableThreadExecu
       _indexFieldInverter(SequencedTaskExecutor::create(cfg.indexingThreads(), cfg.defaultTaskLimit())),
       _indexFieldWriter(SequencedTaskExecutor::create(cfg.indexingThreads(), cfg.defaultTaskLimit())),
       _attributeFieldWriter(SequencedTaskExecutor::create(cfg.indexingThreads(), cfg.defaultTaskLimit(), cfg.optimize(),
-                                                          cfg.kindOfwatermark(), cfg.reactionTime()))
+                                                          cfg.kindOfwatermark(), cfg.reactionTime(),
+                                                          cfg.strandsPerThread()))
 {
 }
 
@@ -103,7 +104,8 @@ ExecutorThreadingService::getStats()
                                          _sharedExecutor.getStats(),
                                          _indexFieldInverter->getStats(),
                                          _indexFieldWriter->getStats(),
-                                         _attributeFieldWriter->getStats());
+                                         _attributeFieldWriter->getStats(),
+                                         _attributeFieldWriter->getAcceptedTasksPerExecutorId());
 }
 
 vespalib::ISequencedTaskExecutor &
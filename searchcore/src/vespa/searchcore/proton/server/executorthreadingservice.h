@@ -2,6 +2,7 @@
 #pragma once
 
 #include "executor_thread_service.h"
+#include "i_feed_backlog_sampler.h"
 #include <vespa/searchcorespi/index/ithreadingservice.h>
 #include <vespa/vespalib/util/threadstackexecutor.h>
 
@@ -14,7 +15,8 @@ class ThreadingServiceConfig;
  * Implementation of IThreadingService using 2 underlying thread stack executors
  * with 1 thread each.
  */
-class ExecutorThreadingService : public searchcorespi::index::IThreadingService
+class ExecutorThreadingService : public searchcorespi::index::IThreadingService,
+                                 public IFeedBacklogSampler
 {
 private:
     vespalib::SyncableThreadExecutor                   & _sharedExecutor;
@@ -82,6 +84,11 @@ public:
     vespalib::ISequencedTaskExecutor &indexFieldWriter() override;
     vespalib::ISequencedTaskExecutor &attributeFieldWriter() override;
     ExecutorThreadingServiceStats getStats();
+
+    // Implements IFeedBacklogSampler
+    size_t sampleFeedBacklog() const override {
+        return _masterExecutor.num_pending_tasks();
+    }
 };
 
 } // namespace proton
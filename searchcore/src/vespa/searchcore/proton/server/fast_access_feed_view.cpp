@@ -5,11 +5,14 @@
 #include "operationdonecontext.h"
 #include "removedonecontext.h"
 #include "putdonecontext.h"
+#include <vespa/searchcore/proton/attribute/attribute_utils.h>
 #include <vespa/searchcore/proton/feedoperation/operations.h>
+#include <vespa/searchlib/attribute/attributevector.h>
 #include <vespa/vespalib/util/isequencedtaskexecutor.h>
 
 using document::Document;
 using document::DocumentUpdate;
+using proton::attribute::isUpdateableInMemoryOnly;
 using search::index::Schema;
 
 namespace proton {
@@ -68,6 +71,13 @@ FastAccessFeedView::heartBeatAttributes(SerialNum serialNum)
     _attributeWriter->heartBeat(serialNum);
 }
 
+bool
+FastAccessFeedView::isUpdateableAttributeField(const vespalib::string &fieldName) const
+{
+    const search::AttributeVector *attr = _attributeWriter->getWritableAttribute(fieldName);
+    return (attr != nullptr) && isUpdateableInMemoryOnly(attr->getName(), attr->getConfig());
+}
+
 FastAccessFeedView::FastAccessFeedView(const StoreOnlyFeedView::Context &storeOnlyCtx,
                                        const PersistentParams &params, const Context &ctx)
     : Parent(storeOnlyCtx, params),
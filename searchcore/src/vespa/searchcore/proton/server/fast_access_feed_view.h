@@ -50,6 +50,7 @@ private:
                           bool immediateCommit, OnWriteDoneType onWriteDone) override;
 
     void heartBeatAttributes(SerialNum serialNum) override;
+    bool isUpdateableAttributeField(const vespalib::string &fieldName) const override;
 
 protected:
     void forceCommit(SerialNum serialNum, OnForceCommitDoneType onCommitDone) override;
@@ -0,0 +1,62 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "feed_latency_explorer.h"
+#include <vespa/searchcore/proton/common/feed_latency_tracker.h>
+#include <vespa/searchcore/proton/feedoperation/feedoperation.h>
+#include <vespa/vespalib/data/slime/cursor.h>
+
+using vespalib::slime::Cursor;
+using vespalib::slime::Inserter;
+
+namespace proton {
+
+namespace {
+
+const char *
+operationTypeName(uint32_t opType)
+{
+    switch (opType) {
+    case FeedOperation::PUT:
+        return "put";
+    case FeedOperation::REMOVE:
+    case FeedOperation::REMOVE_GID:
+        return "remove";
+    case FeedOperation::UPDATE_42:
+    case FeedOperation::UPDATE:
+        return "update";
+    default:
+        return "other";
+    }
+}
+
+}
+
+FeedLatencyExplorer::FeedLatencyExplorer(std::shared_ptr<const FeedLatencyTracker> tracker)
+    : _tracker(std::move(tracker))
+{
+}
+
+FeedLatencyExplorer::~FeedLatencyExplorer() = default;
+
+void
+FeedLatencyExplorer::get_state(const Inserter &inserter, bool full) const
+{
+    (void) full;
+    Cursor &object = inserter.insertObject();
+    object.setBool("enabled", static_cast<bool>(_tracker));
+    if (!_tracker) {
+        return;
+    }
+    Cursor &array = object.setArray("slowOperations");
+    for (const auto &op : _tracker->getSlowOperations()) {
+        Cursor &entry = array.addObject();
+        entry.setDouble("acked", vespalib::to_s(op.acked.time_since_epoch()));
+        entry.setString("type", operationTypeName(op.opType));
+        entry.setDouble("queue", op.queue);
+        entry.setDouble("log", op.log);
+        entry.setDouble("apply", op.apply);
+        entry.setDouble("total", op.total);
+    }
+}
+
+}
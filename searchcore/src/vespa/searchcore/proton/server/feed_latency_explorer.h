@@ -0,0 +1,27 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <vespa/vespalib/net/state_explorer.h>
+#include <memory>
+
+namespace proton {
+
+class FeedLatencyTracker;
+
+/**
+ * Class used to explore the stage latencies of recent slow feed operations.
+ */
+class FeedLatencyExplorer : public vespalib::StateExplorer
+{
+private:
+    std::shared_ptr<const FeedLatencyTracker> _tracker;
+
+public:
+    FeedLatencyExplorer(std::shared_ptr<const FeedLatencyTracker> tracker);
+    ~FeedLatencyExplorer() override;
+
+    void get_state(const vespalib::slime::Inserter &inserter, bool full) const override;
+};
+
+}
@@ -10,6 +10,7 @@
 #include <vespa/document/datatype/documenttype.h>
 #include <vespa/document/repo/documenttyperepo.h>
 #include <vespa/document/update/documentupdate.h>
+#include <vespa/document/update/fieldupdate.h>
 #include <vespa/document/fieldvalue/document.h>
 #include <vespa/searchcore/proton/bucketdb/ibucketdbhandler.h>
 #include <vespa/searchcore/proton/persistenceengine/i_resource_write_filter.h>
@@ -21,6 +22,7 @@
 #include <vespa/searchlib/transactionlog/client_session.h>
 #include <vespa/vespalib/util/exceptions.h>
 #include <vespa/vespalib/util/lambdatask.h>
+#include <algorithm>
 #include <unistd.h>
 
 #include <vespa/log/log.h>
@@ -29,6 +31,9 @@ LOG_SETUP(".proton.server.feedhandler");
 using document::BucketId;
 using document::Document;
 using document::DocumentTypeRepo;
+using document::DocumentUpdate;
+using document::FieldUpdate;
+using document::ValueUpdate;
 using storage::spi::PartitionId;
 using storage::spi::RemoveResult;
 using storage::spi::Result;
@@ -53,6 +58,17 @@ ignoreOperation(const DocumentOperation &op) {
     return (op.getPrevTimestamp() != 0) && (op.getTimestamp() < op.getPrevTimestamp());
 }
 
+/**
+ * Marks a tracked feed operation as logged when the transaction log
+ * commit containing it is done.
+ */
+class LoggedCallback : public search::IDestructorCallback {
+    FeedToken _token;
+public:
+    explicit LoggedCallback(FeedToken token) : _token(std::move(token)) {}
+    ~LoggedCallback() override { _token->markLogged(); }
+};
+
 class TlsMgrWriter : public TlsWriter {
     TransactionLogManager &_tls_mgr;
     std::shared_ptr<search::transactionlog::Writer> _writer;
@@ -63,6 +79,7 @@ public:
             _writer(factory.getWriter(tls_mgr.getDomainName()))
     { }
     void storeOperation(const FeedOperation &op, DoneCallback onDone) override;
+    void storeOperations(const std::vector<const FeedOperation *> &ops, DoneCallback onDone) override;
     bool erase(SerialNum oldest_to_keep) override;
     SerialNum sync(SerialNum syncTo) override;
 };
@@ -79,6 +96,20 @@ void TlsMgrWriter::storeOperation(const FeedOperation &op, DoneCallback onDone)
     packet.add(entry);
     _writer->commit(packet, std::move(onDone));
 }
+
+void TlsMgrWriter::storeOperations(const std::vector<const FeedOperation *> &ops, DoneCallback onDone) {
+    using Packet = search::transactionlog::Packet;
+    Packet packet(0);
+    vespalib::nbostream stream;
+    for (const FeedOperation *op : ops) {
+        stream.clear();
+        op->serialize(stream);
+        LOG(debug, "storeOperations(): serialNum(%" PRIu64 "), type(%u), size(%zu)",
+            op->getSerialNum(), (uint32_t)op->getType(), stream.size());
+        packet.add(Packet::Entry(op->getSerialNum(), op->getType(), vespalib::ConstBufferRef(stream.data(), stream.size())));
+    }
+    _writer->commit(packet, std::move(onDone));
+}
 bool TlsMgrWriter::erase(SerialNum oldest_to_keep) {
     return _tls_mgr.getSession()->erase(oldest_to_keep);
 }
@@ -104,16 +135,135 @@ TlsMgrWriter::sync(SerialNum syncTo)
     throw IllegalStateException(make_string("Failed to sync TLS to token %" PRIu64 ".", syncTo));
 }
 
+/*
+ * Transport for the token of an update operation merged from several
+ * updates. The tokens of the merged updates are kept until the merged
+ * operation is done, and get its result if it fails.
+ */
+class CoalescedUpdatesTransport : public feedtoken::ITransport {
+    std::vector<FeedToken> _tokens;
+public:
+    CoalescedUpdatesTransport(std::vector<FeedToken> tokens)
+        : _tokens(std::move(tokens))
+    { }
+    void send(ResultUP result, bool) override {
+        if (result->hasError()) {
+            for (auto &token : _tokens) {
+                if (token) {
+                    token->setResult(make_unique<UpdateResult>(result->getErrorCode(), result->getErrorMessage()), false);
+                    token->fail();
+                }
+            }
+        }
+        _tokens.clear();
+    }
+};
+
 }  // namespace
 
+/**
+ * Updates to the same document that are waiting for the master write
+ * thread, in the order they were received.
+ */
+class FeedHandler::PendingUpdates {
+public:
+    using Entry = std::pair<FeedToken, FeedOperationUP>;
+private:
+    document::GlobalId _gid;
+    std::vector<Entry> _updates;
+public:
+    PendingUpdates(const document::GlobalId &gid)
+        : _gid(gid),
+          _updates()
+    { }
+    const document::GlobalId &getGid() const { return _gid; }
+    std::vector<Entry> &getUpdates() { return _updates; }
+};
+
 void
 FeedHandler::doHandleOperation(FeedToken token, FeedOperation::UP op)
 {
     assert(_writeService.master().isCurrentThread());
+    if (token && _latencyTracker) {
+        token->trackLatency(_latencyTracker, op->getType());
+    }
     // Since _feedState is only modified in the master thread we can skip the lock here.
     _feedState->handleOperation(std::move(token), std::move(op));
 }
 
+void
+FeedHandler::doHandlePendingUpdates(const PendingUpdatesSP &pending)
+{
+    assert(_writeService.master().isCurrentThread());
+    std::vector<PendingUpdates::Entry> updates;
+    {
+        std::lock_guard guard(_pendingUpdatesLock);
+        auto itr = _pendingUpdates.find(pending->getGid());
+        if ((itr != _pendingUpdates.end()) && (itr->second == pending)) {
+            _pendingUpdates.erase(itr);
+        }
+        updates.swap(pending->getUpdates());
+    }
+    if ((updates.size() > 1) && (_feedState->getType() == FeedState::NORMAL) && performCoalescedUpdates(updates)) {
+        return;
+    }
+    for (auto &entry : updates) {
+        doHandleOperation(std::move(entry.first), std::move(entry.second));
+    }
+}
+
+bool
+FeedHandler::canCoalesceUpdate(const FeedOperation &op) const
+{
+    if (op.getType() != FeedOperation::UPDATE) {
+        return false;
+    }
+    const auto &upd = static_cast<const UpdateOperation &>(op).getUpdate();
+    if (!upd || upd->getCreateIfNonExistent() || !upd->getFieldPathUpdates().empty()) {
+        return false;
+    }
+    for (const auto &fieldUpdate : upd->getUpdates()) {
+        for (const auto &valueUpdate : fieldUpdate.getUpdates()) {
+            ValueUpdate::ValueUpdateType type = valueUpdate->getType();
+            if ((type != ValueUpdate::Arithmetic) && (type != ValueUpdate::Assign)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+void
+FeedHandler::closePendingUpdates(const FeedOperation &op)
+{
+    if (_pendingUpdates.empty()) {
+        return;
+    }
+    switch (op.getType()) {
+    case FeedOperation::PUT:
+        if (static_cast<const PutOperation &>(op).getDocument()) {
+            _pendingUpdates.erase(static_cast<const PutOperation &>(op).getDocument()->getId().getGlobalId());
+            return;
+        }
+        break;
+    case FeedOperation::UPDATE_42:
+    case FeedOperation::UPDATE:
+        if (static_cast<const UpdateOperation &>(op).getUpdate()) {
+            _pendingUpdates.erase(static_cast<const UpdateOperation &>(op).getUpdate()->getId().getGlobalId());
+            return;
+        }
+        break;
+    case FeedOperation::REMOVE:
+    case FeedOperation::REMOVE_GID:
+        _pendingUpdates.erase(static_cast<const RemoveOperation &>(op).getGlobalId());
+        return;
+    default:
+        break;
+    }
+    // Bucket operations affect many documents, let them close all pending updates.
+    _pendingUpdates.clear();
+}
+
 void FeedHandler::performPut(FeedToken token, PutOperation &op) {
     op.assertValid();
     _activeFeedView->preparePut(op);
@@ -191,6 +341,57 @@ FeedHandler::createNonExistingDocument(FeedToken token, const UpdateOperation &o
     latch.await();
 }
 
+bool
+FeedHandler::performCoalescedUpdates(std::vector<std::pair<FeedToken, FeedOperationUP>> &updates)
+{
+    const DocumentUpdate &firstUpd = *static_cast<const UpdateOperation &>(*updates.front().second).getUpdate();
+    std::vector<FieldUpdate> fieldUpdates;
+    for (const auto &entry : updates) {
+        const DocumentUpdate &upd = *static_cast<const UpdateOperation &>(*entry.second).getUpdate();
+        if (&upd.getType() != &firstUpd.getType()) {
+            return false;
+        }
+        for (const auto &fieldUpdate : upd.getUpdates()) {
+            auto itr = std::find_if(fieldUpdates.begin(), fieldUpdates.end(), [&fieldUpdate](const FieldUpdate &merged)
+                                    { return merged.getField().getName() == fieldUpdate.getField().getName(); });
+            if (itr == fieldUpdates.end()) {
+                fieldUpdates.push_back(fieldUpdate);
+            } else {
+                for (const auto &valueUpdate : fieldUpdate.getUpdates()) {
+                    itr->addUpdate(*valueUpdate);
+                }
+            }
+        }
+    }
+    auto mergedUpd = make_shared<DocumentUpdate>(*_activeFeedView->getDocumentTypeRepo(), firstUpd.getType(), firstUpd.getId());
+    for (const auto &fieldUpdate : fieldUpdates) {
+        mergedUpd->addUpdate(fieldUpdate);
+    }
+    const auto &lastOp = static_cast<const UpdateOperation &>(*updates.back().second);
+    UpdateOperation op(lastOp.getBucketId(), lastOp.getTimestamp(), std::move(mergedUpd));
+    _activeFeedView->prepareUpdate(op);
+    if (!op.getPrevDbDocumentId().valid() || op.getPrevMarkedAsRemoved() || !_activeFeedView->isAttributeOnlyUpdate(op)) {
+        return false;
+    }
+    // Each update sees the document as left by the previous one.
+    Timestamp prevTimestamp = op.getPrevTimestamp();
+    std::vector<FeedToken> tokens;
+    tokens.reserve(updates.size());
+    for (auto &entry : updates) {
+        if (entry.first) {
+            entry.first->setResult(make_unique<UpdateResult>(prevTimestamp), true);
+        }
+        prevTimestamp = static_cast<const UpdateOperation &>(*entry.second).getTimestamp();
+        tokens.push_back(std::move(entry.first));
+    }
+    FeedToken token = feedtoken::make(std::make_unique<CoalescedUpdatesTransport>(std::move(tokens)));
+    if (considerWriteOperationForRejection(token, op) || considerUpdateOperationForRejection(token, op)) {
+        return true;
+    }
+    performInternalUpdate(std::move(token), op);
+    return true;
+}
+
 
 void FeedHandler::performRemove(FeedToken token, RemoveOperation &op) {
     _activeFeedView->prepareRemove(op);
@@ -271,6 +472,7 @@ FeedHandler::performEof()
     assert(_writeService.master().isCurrentThread());
     _writeService.sync();
     LOG(debug, "Visiting done for transaction log domain '%s', eof received", _tlsMgr.getDomainName().c_str());
+    _replayTime = vespalib::steady_clock::now() - _replayStartTime;
     _owner.onTransactionLogReplayDone();
     _tlsMgr.replayDone();
     changeToNormalFeedState();
@@ -372,6 +574,9 @@ FeedHandler::FeedHandler(IThreadingService &writeService,
       _tlsMgrWriter(),
       _tlsWriter(tlsWriter),
       _tlsReplayProgress(),
+      _replayStartTime(),
+      _replayTime(vespalib::duration::zero()),
+      _replayedBytes(0),
       _serialNum(0),
       _prunedSerialNum(0),
       _delayedPrune(false),
@@ -383,7 +588,11 @@ FeedHandler::FeedHandler(IThreadingService &writeService,
       _bucketDBHandler(nullptr),
       _syncLock(),
       _syncedSerialNum(0),
-      _allowSync(false)
+      _allowSync(false),
+      _pendingUpdatesLock(),
+      _pendingUpdates(),
+      _maxCoalescedUpdates(0),
+      _latencyTracker()
 { }
 
 
@@ -422,7 +631,8 @@ FeedHandler::replayTransactionLog(SerialNum flushedIndexMgrSerial, SerialNum flu
     assert(_activeFeedView);
     assert(_bucketDBHandler);
     auto state = make_shared<ReplayTransactionLogState>
-                          (getDocTypeName(), _activeFeedView, *_bucketDBHandler, _replayConfig, config_store);
+                          (getDocTypeName(), _activeFeedView, *_bucketDBHandler, _replayConfig, config_store,
+                           _writeService.shared());
     changeFeedState(state);
     // Resurrected attribute vector might cause oldestFlushedSerial to
     // be lower than _prunedSerialNum, so don't warn for now.
@@ -432,6 +642,8 @@ FeedHandler::replayTransactionLog(SerialNum flushedIndexMgrSerial, SerialNum flu
     TransactionLogManager::prepareReplay(_tlsMgr.getClient(), _docTypeName.getName(),
                                          flushedIndexMgrSerial, flushedSummaryMgrSerial, config_store);
 
+    _replayStartTime = vespalib::steady_clock::now();
+    _replayedBytes = 0;
     _tlsReplayProgress = _tlsMgr.startReplay(_prunedSerialNum, _serialNum, *this);
 }
 
@@ -474,6 +686,25 @@ FeedHandler::storeOperation(const FeedOperation &op, TlsWriter::DoneCallback onD
     _tlsWriter->storeOperation(op, std::move(onDone));
 }
 
+void
+FeedHandler::storeOperation(const FeedOperation &op, const FeedToken &token) {
+    if (token && _latencyTracker) {
+        storeOperation(op, std::make_shared<LoggedCallback>(token));
+    } else {
+        storeOperation(op, TlsWriter::DoneCallback(token));
+    }
+}
+
+void
+FeedHandler::storeOperations(const std::vector<const FeedOperation *> &ops, TlsWriter::DoneCallback onDone) {
+    for (const FeedOperation *op : ops) {
+        if (!op->getSerialNum()) {
+            const_cast<FeedOperation &>(*op).setSerialNum(incSerialNum());
+        }
+    }
+    _tlsWriter->storeOperations(ops, std::move(onDone));
+}
+
 void
 FeedHandler::storeOperationSync(const FeedOperation &op) {
     vespalib::Gate gate;
@@ -622,6 +853,32 @@ FeedHandler::performOperation(FeedToken token, FeedOperation::UP op)
 void
 FeedHandler::handleOperation(FeedToken token, FeedOperation::UP op)
 {
+    if (_maxCoalescedUpdates > 0) {
+        PendingUpdatesSP pending;
+        {
+            std::lock_guard guard(_pendingUpdatesLock);
+            if (!canCoalesceUpdate(*op)) {
+                closePendingUpdates(*op);
+            } else {
+                document::GlobalId gid = static_cast<const UpdateOperation &>(*op).getUpdate()->getId().getGlobalId();
+                auto itr = _pendingUpdates.find(gid);
+                if ((itr != _pendingUpdates.end()) && (itr->second->getUpdates().size() < _maxCoalescedUpdates)) {
+                    itr->second->getUpdates().emplace_back(std::move(token), std::move(op));
+                    return;
+                }
+                pending = std::make_shared<PendingUpdates>(gid);
+                pending->getUpdates().emplace_back(std::move(token), std::move(op));
+                _pendingUpdates[gid] = pending;
+            }
+        }
+        if (pending) {
+            // The master write thread must not be waited for while holding the lock
+            _writeService.master().execute(makeLambdaTask([this, pending = std::move(pending)]() {
+                doHandlePendingUpdates(pending);
+            }));
+            return;
+        }
+    }
     _writeService.master().execute(makeLambdaTask([this, token = std::move(token), op = std::move(op)]() mutable {
         doHandleOperation(std::move(token), std::move(op));
     }));
@@ -639,6 +896,29 @@ FeedHandler::handleMove(MoveOperation &op, std::shared_ptr<search::IDestructorCa
     _activeFeedView->handleMove(op, std::move(moveDoneCtx));
 }
 
+void
+FeedHandler::handleMoveBatch(const std::vector<MoveOperation *> &ops, std::shared_ptr<search::IDestructorCallback> moveDoneCtx)
+{
+    assert(_writeService.master().isCurrentThread());
+    std::vector<const FeedOperation *> toStore;
+    toStore.reserve(ops.size());
+    for (MoveOperation *op : ops) {
+        // The target lid is selected by prepareMove(), so each move is
+        // handled before the next one is prepared. The serialized moves
+        // are still committed to the transaction log as one packet.
+        _activeFeedView->prepareMove(*op);
+        assert(op->getValidDbdId());
+        assert(op->getValidPrevDbdId());
+        assert(op->getSubDbId() != op->getPrevSubDbId());
+        op->setSerialNum(incSerialNum());
+        _activeFeedView->handleMove(*op, moveDoneCtx);
+        toStore.push_back(op);
+    }
+    if (!toStore.empty()) {
+        storeOperations(toStore, std::move(moveDoneCtx));
+    }
+}
+
 void
 FeedHandler::heartBeat()
 {
@@ -660,6 +940,9 @@ FeedHandler::receive(const Packet &packet)
     // (by fnet thread).  Called via DocumentDB::recoverPacket() when
     // recovering from another node.
     FeedStateSP state = getFeedState();
+    if (state->getType() == FeedState::REPLAY_TRANSACTION_LOG) {
+        _replayedBytes += packet.sizeBytes();
+    }
     auto wrap = make_shared<PacketWrapper>(packet, _tlsReplayProgress.get());
     state->receive(wrap, _writeService.master());
     wrap->gate.await();
@@ -10,10 +10,14 @@
 #include "tlswriter.h"
 #include "transactionlogmanager.h"
 #include <persistence/spi/types.h>
+#include <vespa/document/base/globalid.h>
 #include <vespa/document/bucket/bucketid.h>
 #include <vespa/searchcore/proton/common/doctypename.h>
 #include <vespa/searchcore/proton/common/feedtoken.h>
 #include <vespa/searchlib/transactionlog/client_common.h>
+#include <vespa/vespalib/stllike/hash_map.h>
+#include <vespa/vespalib/util/time.h>
+#include <mutex>
 #include <shared_mutex>
 
 namespace searchcorespi::index { struct IThreadingService; }
@@ -62,6 +66,9 @@ private:
     using WriteGuard = std::unique_lock<std::shared_mutex>;
     using IThreadingService = searchcorespi::index::IThreadingService;
     using TlsWriterFactory = search::transactionlog::WriterFactory;
+    class PendingUpdates;
+    using PendingUpdatesSP = std::shared_ptr<PendingUpdates>;
+    using PendingUpdatesMap = vespalib::hash_map<document::GlobalId, PendingUpdatesSP, document::GlobalId::hash>;
 
     IThreadingService                     &_writeService;
     DocTypeName                            _docTypeName;
@@ -73,6 +80,9 @@ private:
     std::unique_ptr<TlsWriter>             _tlsMgrWriter;
     TlsWriter                             *_tlsWriter;
     TlsReplayProgress::UP                  _tlsReplayProgress;
+    vespalib::steady_time                  _replayStartTime;
+    vespalib::duration                     _replayTime;
+    uint64_t                               _replayedBytes;
     // the serial num of the last message in the transaction log
     SerialNum                              _serialNum;
     SerialNum                              _prunedSerialNum;
@@ -87,12 +97,21 @@ private:
     std::mutex                             _syncLock;
     SerialNum                              _syncedSerialNum; 
     bool                                   _allowSync; // Sanity check
+    // updates waiting for the master write thread that later updates to the same document can join
+    std::mutex                             _pendingUpdatesLock;
+    PendingUpdatesMap                      _pendingUpdates;
+    uint32_t                               _maxCoalescedUpdates;
+    std::shared_ptr<FeedLatencyTracker>    _latencyTracker;
 
     /**
      * Delayed handling of feed operations, in master write thread.
      * The current feed state is sampled here.
      */
     void doHandleOperation(FeedToken token, FeedOperationUP op);
+    void doHandlePendingUpdates(const PendingUpdatesSP &pending);
+
+    bool canCoalesceUpdate(const FeedOperation &op) const;
+    void closePendingUpdates(const FeedOperation &op);
 
     bool considerWriteOperationForRejection(FeedToken & token, const FeedOperation &op);
     bool considerUpdateOperationForRejection(FeedToken &token, UpdateOperation &op);
@@ -106,6 +125,7 @@ private:
     void performUpdate(FeedToken token, UpdateOperation &op);
     void performInternalUpdate(FeedToken token, UpdateOperation &op);
     void createNonExistingDocument(FeedToken, const UpdateOperation &op);
+    bool performCoalescedUpdates(std::vector<std::pair<FeedToken, FeedOperationUP>> &updates);
 
     void performRemove(FeedToken token, RemoveOperation &op);
     void performGarbageCollect(FeedToken token);
@@ -200,6 +220,20 @@ public:
         _bucketDBHandler = bucketDBHandler;
     }
 
+    /**
+     * Set the max number of partial updates to the same document that
+     * are merged into one update operation while waiting for the
+     * master write thread. 0 disables merging. Must be set before
+     * feeding starts.
+     */
+    void setMaxCoalescedUpdates(uint32_t maxCoalescedUpdates) { _maxCoalescedUpdates = maxCoalescedUpdates; }
+    /**
+     * Track feed stage latencies of operations with a feed token. Must be
+     * set before feeding starts.
+     */
+    void setLatencyTracker(std::shared_ptr<FeedLatencyTracker> tracker) { _latencyTracker = std::move(tracker); }
+    const std::shared_ptr<FeedLatencyTracker> &getLatencyTracker() const { return _latencyTracker; }
+
     void setSerialNum(SerialNum serialNum) { _serialNum = serialNum; }
     SerialNum incSerialNum() { return ++_serialNum; }
     SerialNum getSerialNum() const override { return _serialNum; }
@@ -210,6 +244,9 @@ public:
         return _tlsReplayProgress ? _tlsReplayProgress->getProgress() : 0;
     }
     bool getTransactionLogReplayDone() const;
+    // Size and duration of the last transaction log replay, valid when replay is done.
+    uint64_t getReplayedBytes() const { return _replayedBytes; }
+    vespalib::duration getReplayTime() const { return _replayTime; }
     vespalib::string getDocTypeName() const { return _docTypeName.getName(); }
     void tlsPrune(SerialNum oldest_to_keep);
 
@@ -217,6 +254,7 @@ public:
     void handleOperation(FeedToken token, FeedOperationUP op);
 
     void handleMove(MoveOperation &op, std::shared_ptr<search::IDestructorCallback> moveDoneCtx) override;
+    void handleMoveBatch(const std::vector<MoveOperation *> &ops, std::shared_ptr<search::IDestructorCallback> moveDoneCtx) override;
     void heartBeat() override;
 
     void sync();
@@ -226,7 +264,10 @@ public:
     void performPruneRemovedDocuments(PruneRemovedDocumentsOperation &pruneOp) override;
     void syncTls(SerialNum syncTo);
     void storeOperation(const FeedOperation &op, DoneCallback onDone) override;
+    void storeOperations(const std::vector<const FeedOperation *> &ops, DoneCallback onDone) override;
     void storeOperationSync(const FeedOperation & op);
+    // Stores the operation and marks the feed token as logged when committed
+    void storeOperation(const FeedOperation &op, const FeedToken &token);
     void considerDelayedPrune();
 };
 
@@ -9,8 +9,10 @@
 #include <vespa/searchcore/proton/feedoperation/operations.h>
 #include <vespa/searchcore/proton/common/eventlogger.h>
 #include <vespa/searchlib/common/idestructorcallback.h>
-#include <vespa/vespalib/util/closuretask.h>
+#include <vespa/vespalib/util/count_down_latch.h>
 #include <vespa/vespalib/util/lambdatask.h>
+#include <vespa/vespalib/util/threadexecutor.h>
+#include <exception>
 
 #include <vespa/log/log.h>
 LOG_SETUP(".proton.server.feedstates");
@@ -19,18 +21,16 @@ using search::transactionlog::Packet;
 using search::transactionlog::client::RPC;
 using search::SerialNum;
 using vespalib::Executor;
-using vespalib::makeClosure;
 using vespalib::makeLambdaTask;
-using vespalib::makeTask;
 using vespalib::make_string;
 using proton::bucketdb::IBucketDBHandler;
 
 namespace proton {
 
 namespace {
-typedef vespalib::Closure1<const Packet::Entry &>::UP EntryHandler;
-
 const search::SerialNum REPLAY_PROGRESS_INTERVAL = 50000;
+// runs of entries shorter than this are decoded by the replaying thread
+constexpr size_t MIN_ENTRIES_PER_DECODE_TASK = 16;
 
 void
 handleProgress(TlsReplayProgress &progress, SerialNum currentSerial)
@@ -47,22 +47,6 @@ handleProgress(TlsReplayProgress &progress, SerialNum currentSerial)
     }
 }
 
-void
-handlePacket(PacketWrapper & wrap, EntryHandler entryHandler)
-{
-    vespalib::nbostream_longlivedbuf handle(wrap.packet.getHandle().data(), wrap.packet.getHandle().size());
-    while ( !handle.empty() ) {
-        Packet::Entry entry;
-        entry.deserialize(handle);
-        entryHandler->call(entry);
-        if (wrap.progress != nullptr) {
-            handleProgress(*wrap.progress, entry.serial());
-        }
-    }
-    wrap.result = RPC::OK;
-    wrap.gate.countDown();
-}
-
 class TransactionLogReplayPacketHandler : public IReplayPacketHandler {
     IFeedView *& _feed_view_ptr;  // Pointer can be changed in executor thread.
     IBucketDBHandler &_bucketDBHandler;
@@ -133,13 +117,108 @@ public:
     }
 };
 
-void startDispatch(IReplayPacketHandler *packet_handler, const Packet::Entry &entry) {
-    // Called by handlePacket() in executor thread.
-    LOG(spam, "replay packet entry: entrySerial(%" PRIu64 "), entryType(%u)", entry.serial(), entry.type());
+using FeedOperationUP = std::unique_ptr<FeedOperation>;
 
-    ReplayPacketDispatcher dispatcher(*packet_handler);
-    dispatcher.replayEntry(entry);
-    packet_handler->optionalCommit(entry.serial());
+/*
+ * Decode entries [begin, end) into ops, splitting the work between
+ * the threads of the decode executor.
+ */
+void
+decodeEntries(const std::vector<Packet::Entry> &entries, size_t begin, size_t end,
+              const document::DocumentTypeRepo &repo, vespalib::ThreadExecutor &executor,
+              std::vector<FeedOperationUP> &ops)
+{
+    size_t numEntries = end - begin;
+    size_t numTasks = std::min(executor.getNumThreads(), numEntries / MIN_ENTRIES_PER_DECODE_TASK);
+    if (numTasks <= 1) {
+        for (size_t i = begin; i < end; ++i) {
+            ops[i] = ReplayPacketDispatcher::decodeEntry(entries[i], repo);
+        }
+        return;
+    }
+    std::vector<std::exception_ptr> failures(numTasks);
+    vespalib::CountDownLatch latch(numTasks);
+    for (size_t task = 0; task < numTasks; ++task) {
+        size_t taskBegin = begin + (numEntries * task) / numTasks;
+        size_t taskEnd = begin + (numEntries * (task + 1)) / numTasks;
+        auto decodeTask = makeLambdaTask([&, taskBegin, taskEnd, task]() {
+            try {
+                for (size_t i = taskBegin; i < taskEnd; ++i) {
+                    ops[i] = ReplayPacketDispatcher::decodeEntry(entries[i], repo);
+                }
+            } catch (...) {
+                failures[task] = std::current_exception();
+            }
+            latch.countDown();
+        });
+        auto rejected = executor.execute(std::move(decodeTask));
+        if (rejected) {
+            rejected->run();
+        }
+    }
+    latch.await();
+    for (const auto &failure : failures) {
+        if (failure) {
+            std::rethrow_exception(failure);
+        }
+    }
+}
+
+void
+replayOperation(ReplayPacketDispatcher &dispatcher, IReplayPacketHandler &packet_handler,
+                const FeedOperation &op, TlsReplayProgress *progress)
+{
+    LOG(spam, "replay operation: serial(%" PRIu64 "), type(%u)", op.getSerialNum(), op.getType());
+    dispatcher.replayOperation(op);
+    packet_handler.optionalCommit(op.getSerialNum());
+    if (progress != nullptr) {
+        handleProgress(*progress, op.getSerialNum());
+    }
+}
+
+/*
+ * Called in executor thread. Decodes runs of entries between new
+ * config operations in parallel and replays all entries in serial
+ * number order, so the feed view sees the same sequence of operations
+ * as when replaying one entry at a time.
+ */
+void
+handleReplayPacket(PacketWrapper & wrap, IReplayPacketHandler &packet_handler, vespalib::ThreadExecutor &decode_executor)
+{
+    std::vector<Packet::Entry> entries;
+    entries.reserve(wrap.packet.size());
+    vespalib::nbostream_longlivedbuf handle(wrap.packet.getHandle().data(), wrap.packet.getHandle().size());
+    while ( !handle.empty() ) {
+        entries.emplace_back();
+        entries.back().deserialize(handle);
+    }
+    ReplayPacketDispatcher dispatcher(packet_handler);
+    std::vector<FeedOperationUP> ops(entries.size());
+    size_t begin = 0;
+    while (begin < entries.size()) {
+        size_t end = begin;
+        while ((end < entries.size()) && ReplayPacketDispatcher::canDecodeSeparately(entries[end])) {
+            ++end;
+        }
+        decodeEntries(entries, begin, end, packet_handler.getDeserializeRepo(), decode_executor, ops);
+        for (size_t i = begin; i < end; ++i) {
+            replayOperation(dispatcher, packet_handler, *ops[i], wrap.progress);
+            ops[i].reset();
+        }
+        if (end < entries.size()) {
+            const Packet::Entry &entry = entries[end];
+            LOG(spam, "replay packet entry: entrySerial(%" PRIu64 "), entryType(%u)", entry.serial(), entry.type());
+            dispatcher.replayEntry(entry);
+            packet_handler.optionalCommit(entry.serial());
+            if (wrap.progress != nullptr) {
+                handleProgress(*wrap.progress, entry.serial());
+            }
+            ++end;
+        }
+        begin = end;
+    }
+    wrap.result = RPC::OK;
+    wrap.gate.countDown();
 }
 
 }  // namespace
@@ -149,18 +228,19 @@ ReplayTransactionLogState::ReplayTransactionLogState(
         IFeedView *& feed_view_ptr,
         IBucketDBHandler &bucketDBHandler,
         IReplayConfig &replay_config,
-        FeedConfigStore &config_store)
+        FeedConfigStore &config_store,
+        vespalib::ThreadExecutor &decode_executor)
     : FeedState(REPLAY_TRANSACTION_LOG),
       _doc_type_name(name),
-      _packet_handler(std::make_unique<TransactionLogReplayPacketHandler>(feed_view_ptr, bucketDBHandler, replay_config, config_store))
+      _packet_handler(std::make_unique<TransactionLogReplayPacketHandler>(feed_view_ptr, bucketDBHandler, replay_config, config_store)),
+      _decode_executor(decode_executor)
 { }
 
 ReplayTransactionLogState::~ReplayTransactionLogState() = default;
 
 void
 ReplayTransactionLogState::receive(const PacketWrapper::SP &wrap, Executor &executor) {
-    EntryHandler closure = makeClosure(&startDispatch, _packet_handler.get());
-    executor.execute(makeLambdaTask([wrap = wrap, dispatch = std::move(closure)] () mutable { handlePacket(*wrap, std::move(dispatch)); }));
+    executor.execute(makeLambdaTask([this, wrap = wrap] () { handleReplayPacket(*wrap, *_packet_handler, _decode_executor); }));
 }
 
 }  // namespace proton
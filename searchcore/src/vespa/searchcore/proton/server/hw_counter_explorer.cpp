@@ -0,0 +1,41 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "hw_counter_explorer.h"
+#include <vespa/searchcore/proton/common/hw_counter_sampler.h>
+#include <vespa/vespalib/data/slime/cursor.h>
+
+using vespalib::slime::Cursor;
+using vespalib::slime::Inserter;
+
+namespace proton {
+
+HwCounterExplorer::HwCounterExplorer(const HwCounterSampler *sampler)
+    : _sampler(sampler)
+{
+}
+
+HwCounterExplorer::~HwCounterExplorer() = default;
+
+void
+HwCounterExplorer::get_state(const Inserter &inserter, bool full) const
+{
+    Cursor &object = inserter.insertObject();
+    object.setBool("enabled", _sampler != nullptr);
+    object.setBool("available", (_sampler != nullptr) && _sampler->available());
+    if ((_sampler == nullptr) || !_sampler->available()) {
+        return;
+    }
+    HwCounterSampler::Sample sample = _sampler->lastSample();
+    object.setDouble("ipc", sample.ipc());
+    object.setDouble("cacheMissesPerKiloInstruction", sample.cacheMissesPerKiloInstruction());
+    object.setDouble("branchMissesPerKiloInstruction", sample.branchMissesPerKiloInstruction());
+    if (full) {
+        object.setDouble("seconds", sample.seconds);
+        object.setLong("cycles", sample.cycles);
+        object.setLong("instructions", sample.instructions);
+        object.setLong("cacheMisses", sample.cacheMisses);
+        object.setLong("branchMisses", sample.branchMisses);
+    }
+}
+
+}
@@ -0,0 +1,26 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <vespa/vespalib/net/state_explorer.h>
+
+namespace proton {
+
+class HwCounterSampler;
+
+/**
+ * Class used to explore the most recent sample of hardware performance counters.
+ */
+class HwCounterExplorer : public vespalib::StateExplorer
+{
+private:
+    const HwCounterSampler *_sampler;
+
+public:
+    HwCounterExplorer(const HwCounterSampler *sampler);
+    ~HwCounterExplorer() override;
+
+    void get_state(const vespalib::slime::Inserter &inserter, bool full) const override;
+};
+
+}
@@ -0,0 +1,18 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <cstddef>
+
+namespace proton {
+
+/**
+ * Interface for sampling the feed backlog of a document db, i.e. the
+ * number of write tasks queued for or running in the master write thread.
+ */
+struct IFeedBacklogSampler {
+    virtual ~IFeedBacklogSampler() = default;
+    virtual size_t sampleFeedBacklog() const = 0;
+};
+
+}
@@ -39,6 +39,12 @@ public:
     virtual bool isBlocked() const { return false; }
     virtual IBlockableMaintenanceJob *asBlockable() { return nullptr; }
 
+    /**
+     * Returns whether scheduled runs of this job can be skipped while
+     * the document db has a high feed backlog (cf. MaintenanceJobPacer).
+     */
+    virtual bool isDeferrable() const { return false; }
+
     /**
      * Register maintenance job runner, in case event passed to the
      * job causes it to want to be run again.
@@ -3,6 +3,7 @@
 #pragma once
 
 #include <vespa/searchlib/transactionlog/common.h>
+#include <vector>
 
 namespace proton {
 
@@ -20,6 +21,16 @@ struct IOperationStorer
      * Assign serial number to (if not set) and store the given operation.
      */
     virtual void storeOperation(const FeedOperation &op, DoneCallback onDone) = 0;
+
+    /**
+     * Assign serial numbers to (if not set) and store the given operations.
+     * Implementations may store all the operations as a single commit.
+     */
+    virtual void storeOperations(const std::vector<const FeedOperation *> &ops, DoneCallback onDone) {
+        for (const FeedOperation *op : ops) {
+            storeOperation(*op, onDone);
+        }
+    }
 };
 
 } // namespace proton
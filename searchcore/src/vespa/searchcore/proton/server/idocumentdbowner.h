@@ -2,6 +2,7 @@
 
 #pragma once
 
+#include <vespa/vespalib/util/time.h>
 #include <memory>
 #include <cstdint>
 
@@ -17,6 +18,8 @@ public:
     virtual bool isInitializing() const = 0;
     virtual uint32_t getDistributionKey() const = 0;
     virtual std::shared_ptr<IDocumentDBReferenceRegistry> getDocumentDBReferenceRegistry() const = 0;
+    // Called when a document db has replayed its transaction log on startup.
+    virtual void reportTransactionLogReplay(uint64_t replayedBytes, vespalib::duration replayTime) = 0;
 };
 
 } // namespace proton
@@ -3,6 +3,7 @@
 #pragma once
 
 #include <memory>
+#include <vector>
 
 namespace search { class IDestructorCallback; }
 
@@ -11,11 +12,21 @@ namespace proton {
 class MoveOperation;
 
 /**
- * Interface used by DocumentBucketMover to handle the moving of a single document.
+ * Interface used by DocumentBucketMover to handle the moving of documents.
  */
 struct IDocumentMoveHandler
 {
     virtual void handleMove(MoveOperation &op, std::shared_ptr<search::IDestructorCallback> moveDoneCtx) = 0;
+
+    /**
+     * Handle the moving of several documents, in the given order.
+     * Implementations may store all the moves as a single commit.
+     */
+    virtual void handleMoveBatch(const std::vector<MoveOperation *> &ops, std::shared_ptr<search::IDestructorCallback> moveDoneCtx) {
+        for (MoveOperation *op : ops) {
+            handleMove(*op, moveDoneCtx);
+        }
+    }
     virtual ~IDocumentMoveHandler() {}
 };
 
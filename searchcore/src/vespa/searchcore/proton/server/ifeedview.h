@@ -51,6 +51,12 @@ public:
     virtual void handlePut(FeedToken token, const PutOperation &putOp) = 0;
     virtual void prepareUpdate(UpdateOperation &updOp) = 0;
     virtual void handleUpdate(FeedToken token, const UpdateOperation &updOp) = 0;
+    /**
+     * Returns true if the prepared update only changes attribute
+     * fields that can be updated in memory, without touching the
+     * index or the document store.
+     */
+    virtual bool isAttributeOnlyUpdate(const UpdateOperation &updOp) const = 0;
     virtual void prepareRemove(RemoveOperation &rmOp) = 0;
     virtual void handleRemove(FeedToken token, const RemoveOperation &rmOp) = 0;
     virtual void prepareDeleteBucket(DeleteBucketOperation &delOp) = 0;
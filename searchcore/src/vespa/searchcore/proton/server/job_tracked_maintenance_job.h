@@ -24,6 +24,7 @@ public:
     // Implements IMaintenanceJob
     virtual bool isBlocked() const override { return _job->isBlocked(); }
     virtual IBlockableMaintenanceJob *asBlockable() override { return _job->asBlockable(); }
+    virtual bool isDeferrable() const override { return _job->isDeferrable(); }
     virtual void registerRunner(IMaintenanceJobRunner *runner) override {
         _job->registerRunner(runner);
     }
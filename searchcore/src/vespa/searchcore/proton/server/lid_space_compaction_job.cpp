@@ -46,23 +46,34 @@ bool
 LidSpaceCompactionJob::scanDocuments(const LidUsageStats &stats)
 {
     if (_scanItr->valid()) {
-        DocumentMetaData document = getNextDocument(stats);
-        if (document.valid()) {
+        // The moves in a batch count as a single operation towards the limit of outstanding move operations.
+        search::IDestructorCallback::SP context;
+        LidUsageStats currentStats = stats;
+        for (uint32_t moved = 0; (moved < _maxDocsToMovePerBatch) && _scanItr->valid(); ++moved) {
+            DocumentMetaData document = getNextDocument(currentStats);
+            if (!document.valid()) {
+                break;
+            }
             IFrozenBucketHandler::ExclusiveBucketGuard::UP bucketGuard = _frozenHandler.acquireExclusiveBucket(document.bucketId);
             if ( ! bucketGuard ) {
                 // the job is blocked until the bucket for this document is thawed
                 setBlocked(BlockedReason::FROZEN_BUCKET);
                 _retryFrozenDocument = true;
                 return true;
-            } else {
-                MoveOperation::UP op = _handler.createMoveOperation(document, stats.getLowestFreeLid());
-                search::IDestructorCallback::SP context = _moveOpsLimiter->beginOperation();
-                _opStorer.storeOperation(*op, context);
-                _handler.handleMove(*op, std::move(context));
-                if (isBlocked(BlockedReason::OUTSTANDING_OPS)) {
-                    return true;
-                }
             }
+            if (!context) {
+                context = _moveOpsLimiter->beginOperation();
+            }
+            MoveOperation::UP op = _handler.createMoveOperation(document, currentStats.getLowestFreeLid());
+            _opStorer.storeOperation(*op, context);
+            _handler.handleMove(*op, context);
+            if ((moved + 1) < _maxDocsToMovePerBatch) {
+                currentStats = _handler.getLidStatus();
+            }
+        }
+        context.reset();
+        if (isBlocked(BlockedReason::OUTSTANDING_OPS)) {
+            return true;
         }
     }
     if (!_scanItr->valid()){
@@ -0,0 +1,24 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "maintenance_job_pacer.h"
+#include "i_feed_backlog_sampler.h"
+#include "i_maintenance_job.h"
+
+namespace proton {
+
+MaintenanceJobPacer::MaintenanceJobPacer(const IFeedBacklogSampler &sampler, const MaintenanceJobPacingConfig &config)
+    : _sampler(sampler),
+      _config(config)
+{
+}
+
+bool
+MaintenanceJobPacer::shouldDefer(const IMaintenanceJob &job, uint32_t deferredRuns) const
+{
+    if (!_config.isEnabled() || !job.isDeferrable() || (deferredRuns >= _config.getMaxDeferredRuns())) {
+        return false;
+    }
+    return (_sampler.sampleFeedBacklog() > _config.getMaxFeedBacklog());
+}
+
+}
@@ -0,0 +1,36 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include "document_db_maintenance_config.h"
+
+namespace proton {
+
+class IMaintenanceJob;
+struct IFeedBacklogSampler;
+
+/**
+ * Decides whether a scheduled run of a maintenance job should be skipped
+ * because the document db is busy handling feed.
+ *
+ * Only deferrable jobs are paced, and a job is never deferred more than
+ * the configured number of consecutive runs, so it cannot starve. A job
+ * that has been deferred runs as soon as the feed backlog drops again,
+ * and is then run repeatedly until it reports that it is finished.
+ */
+class MaintenanceJobPacer {
+private:
+    const IFeedBacklogSampler  &_sampler;
+    MaintenanceJobPacingConfig  _config;
+
+public:
+    MaintenanceJobPacer(const IFeedBacklogSampler &sampler, const MaintenanceJobPacingConfig &config);
+
+    /**
+     * Returns true if this scheduled run of the given job should be skipped,
+     * given the number of consecutive runs that have already been skipped.
+     */
+    bool shouldDefer(const IMaintenanceJob &job, uint32_t deferredRuns) const;
+};
+
+}
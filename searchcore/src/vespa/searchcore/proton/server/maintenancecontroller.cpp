@@ -2,6 +2,7 @@
 
 #include "maintenancecontroller.h"
 #include "maintenancejobrunner.h"
+#include "maintenance_job_pacer.h"
 #include "document_db_maintenance_config.h"
 #include "i_blockable_maintenance_job.h"
 #include <vespa/searchcorespi/index/i_thread_service.h>
@@ -25,23 +26,41 @@ namespace {
 class JobWrapperTask : public Executor::Task
 {
 private:
-    MaintenanceJobRunner *_job;
+    MaintenanceJobRunner      *_job;
+    const MaintenanceJobPacer *_pacer;
+    uint32_t                   _deferredRuns;
 public:
-    JobWrapperTask(MaintenanceJobRunner *job) : _job(job) {}
-    virtual void run() override { _job->run(); }
+    JobWrapperTask(MaintenanceJobRunner *job, const MaintenanceJobPacer *pacer)
+        : _job(job),
+          _pacer(pacer),
+          _deferredRuns(0)
+    {}
+    void run() override {
+        if (_pacer != nullptr && _pacer->shouldDefer(_job->getJob(), _deferredRuns)) {
+            ++_deferredRuns;
+            LOG(debug, "Deferring run of job '%s' due to feed backlog (deferred runs=%u)",
+                _job->getJob().getName().c_str(), _deferredRuns);
+            return;
+        }
+        _deferredRuns = 0;
+        _job->run();
+    }
 };
 
 }
 
 MaintenanceController::MaintenanceController(IThreadService &masterThread,
                                              vespalib::SyncableThreadExecutor & defaultExecutor,
-                                             const DocTypeName &docTypeName)
+                                             const DocTypeName &docTypeName,
+                                             const IFeedBacklogSampler *feedBacklogSampler)
     : IBucketFreezeListener(),
       _masterThread(masterThread),
       _defaultExecutor(defaultExecutor),
       _readySubDB(),
       _remSubDB(),
       _notReadySubDB(),
+      _feedBacklogSampler(feedBacklogSampler),
+      _pacer(),
       _periodicTimer(),
       _config(),
       _frozenBuckets(masterThread),
@@ -149,6 +168,10 @@ MaintenanceController::restart()
     if (!_started || _stopping || !_readySubDB.valid()) {
         return;
     }
+    _periodicTimer.reset(); // Stop tasks referencing the old pacer
+    if (_feedBacklogSampler != nullptr) {
+        _pacer = std::make_unique<MaintenanceJobPacer>(*_feedBacklogSampler, _config->getPacingConfig());
+    }
     _periodicTimer = std::make_unique<vespalib::ScheduledExecutor>();
 
     addJobsToPeriodicTimer();
@@ -166,7 +189,7 @@ MaintenanceController::addJobsToPeriodicTimer()
             jw->run();
             continue;
         }
-        _periodicTimer->scheduleAtFixedRate(std::make_unique<JobWrapperTask>(jw.get()),
+        _periodicTimer->scheduleAtFixedRate(std::make_unique<JobWrapperTask>(jw.get(), _pacer.get()),
                                             job.getDelay(), job.getInterval());
     }
 }
@@ -20,12 +20,17 @@ namespace searchcorespi { namespace index { struct IThreadService; }}
 namespace proton {
 
 class MaintenanceJobRunner;
+class MaintenanceJobPacer;
 class DocumentDBMaintenanceConfig;
+struct IFeedBacklogSampler;
 
 /**
  * Class that controls the bucket moving between ready and notready sub databases
  * and a set of maintenance jobs for a document db.
  * The maintenance jobs are independent of the controller.
+ *
+ * If a feed backlog sampler is given, scheduled runs of deferrable jobs
+ * are paced according to the feed backlog (cf. MaintenanceJobPacer).
  */
 class MaintenanceController : public IBucketFreezeListener
 {
@@ -35,7 +40,8 @@ public:
     using JobList = std::vector<std::shared_ptr<MaintenanceJobRunner>>;
     using UP = std::unique_ptr<MaintenanceController>;
 
-    MaintenanceController(IThreadService &masterThread, vespalib::SyncableThreadExecutor & defaultExecutor, const DocTypeName &docTypeName);
+    MaintenanceController(IThreadService &masterThread, vespalib::SyncableThreadExecutor & defaultExecutor, const DocTypeName &docTypeName,
+                          const IFeedBacklogSampler *feedBacklogSampler = nullptr);
 
     virtual ~MaintenanceController();
     void registerJobInMasterThread(IMaintenanceJob::UP job);
@@ -78,6 +84,8 @@ private:
     MaintenanceDocumentSubDB          _readySubDB;
     MaintenanceDocumentSubDB          _remSubDB;
     MaintenanceDocumentSubDB          _notReadySubDB;
+    const IFeedBacklogSampler        *_feedBacklogSampler;
+    std::unique_ptr<MaintenanceJobPacer>          _pacer;
     std::unique_ptr<vespalib::ScheduledExecutor>  _periodicTimer;
     DocumentDBMaintenanceConfigSP     _config;
     FrozenBuckets                     _frozenBuckets;
@@ -55,4 +55,14 @@ Matchers::lookup(const vespalib::string &name) const
     //TODO add warning log message when not found, may want to use "_fallback" in most cases here
 }
 
+matching::Matcher::SP
+Matchers::lookup_unchanged(const vespalib::string &name, const search::fef::Properties &properties) const
+{
+    Map::const_iterator found(_rpmap.find(name));
+    if ((found != _rpmap.end()) && (found->second->get_index_env().getProperties() == properties)) {
+        return found->second;
+    }
+    return matching::Matcher::SP();
+}
+
 } // namespace proton
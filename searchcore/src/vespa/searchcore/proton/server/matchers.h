@@ -6,6 +6,7 @@
 #include <vespa/vespalib/stllike/hash_map.h>
 
 namespace vespalib { class Clock; }
+namespace search::fef { class Properties; }
 
 namespace proton {
 
@@ -32,6 +33,12 @@ public:
     matching::MatchingStats getStats() const;
     matching::MatchingStats getStats(const vespalib::string &name) const;
     std::shared_ptr<matching::Matcher> lookup(const vespalib::string &name) const;
+    /**
+     * Returns the matcher for the given rank profile if it was set up
+     * from the same properties, otherwise an empty pointer.
+     **/
+    std::shared_ptr<matching::Matcher> lookup_unchanged(const vespalib::string &name,
+                                                        const search::fef::Properties &properties) const;
 };
 
 } // namespace proton
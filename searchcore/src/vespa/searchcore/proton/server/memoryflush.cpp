@@ -122,6 +122,23 @@ computeGain(const IFlushTarget::DiskGain & gain) {
     return std::max(INT64_C(100000000), std::max(gain.getBefore(), gain.getAfter()));
 }
 
+// Targets writing less than this are considered equally cheap to flush,
+// so that small targets are ordered by memory gain alone.
+static constexpr uint64_t minBytesToWrite = UINT64_C(16) * UINT64_C(1024) * UINT64_C(1024);
+
+/*
+ * Memory freed per byte written to disk when flushing the target.
+ * Used to prefer the targets that relieve memory pressure at the
+ * lowest disk bandwidth cost.
+ */
+double
+memoryGainPerWrittenByte(const IFlushTarget &target)
+{
+    int64_t mgain = std::max(INT64_C(0), target.getApproxMemoryGain().gain());
+    uint64_t bytesToWrite = std::max(minBytesToWrite, target.getApproxBytesToWriteToDisk());
+    return static_cast<double>(mgain) / bytesToWrite;
+}
+
 }
 
 FlushContext::List
@@ -170,7 +187,7 @@ MemoryFlush::getFlushTargets(const FlushContext::List &targetList,
         }
         LOG(debug,
             "getFlushTargets(): target(%s), totalMemoryGain(%" PRIu64 "), memoryGain(%" PRIu64 "), "
-            "totalDiskGain(%" PRId64 "), diskGain(%" PRId64 "), "
+            "totalDiskGain(%" PRId64 "), diskGain(%" PRId64 "), bytesToWrite(%" PRIu64 "), "
             "tlsSize(%" PRIu64 "), tlsSizeNeeded(%" PRIu64 "), "
             "flushedSerial(%" PRIu64 "), localLastSerial(%" PRIu64 "), serialDiff(%" PRId64 "), "
             "lastFlushTime(%fs), nowTime(%fs), timeDiff(%fs), order(%s)",
@@ -179,6 +196,7 @@ MemoryFlush::getFlushTargets(const FlushContext::List &targetList,
             mgain,
             totalDisk.gain(),
             dgain.gain(),
+            target.getApproxBytesToWriteToDisk(),
             tlsStats.getNumBytes(),
             estimateNeededTlsSizeForFlushTarget(tlsStats, target.getFlushedSerialNum()),
             target.getFlushedSerialNum(),
@@ -230,8 +248,14 @@ MemoryFlush::CompareTarget::operator()(const FlushContext::SP &lfc, const FlushC
     }
 
     switch (_order) {
-    case MEMORY:
+    case MEMORY: {
+        double lhsGainPerByte = memoryGainPerWrittenByte(lhs);
+        double rhsGainPerByte = memoryGainPerWrittenByte(rhs);
+        if (lhsGainPerByte != rhsGainPerByte) {
+            return (lhsGainPerByte > rhsGainPerByte);
+        }
         return (lhs.getApproxMemoryGain().gain() > rhs.getApproxMemoryGain().gain());
+    }
     case TLSSIZE: {
         const flushengine::TlsStats &lhsTlsStats = _tlsStatsMap.getTlsStats(lfc->getHandler()->getName());
         const flushengine::TlsStats &rhsTlsStats = _tlsStatsMap.getTlsStats(rfc->getHandler()->getName());
@@ -18,6 +18,9 @@ OperationDoneContext::~OperationDoneContext()
 void
 OperationDoneContext::ack()
 {
+    if (_token) {
+        _token->markApplied();
+    }
     _token.reset();
 }
 
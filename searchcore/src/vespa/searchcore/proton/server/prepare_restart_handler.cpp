@@ -50,7 +50,8 @@ PrepareRestartHandler::performPrepareRestart(const ProtonConfig &protonCfg, std:
 {
     _running = true;
     lock.unlock();
-    _flushEngine.setStrategy(std::make_shared<PrepareRestartFlushStrategy>(createPrepareRestartConfig(protonCfg)));
+    auto cfg = _flushEngine.getRestartCostEstimator().adjustConfig(createPrepareRestartConfig(protonCfg));
+    _flushEngine.setStrategy(std::make_shared<PrepareRestartFlushStrategy>(cfg));
     lock.lock();
     _running = false;
     _cond.notify_all();
@@ -4,6 +4,7 @@
 #include "document_db_explorer.h"
 #include "fileconfigmanager.h"
 #include "flushhandlerproxy.h"
+#include "hw_counter_explorer.h"
 #include "memoryflush.h"
 #include "persistencehandlerproxy.h"
 #include "prepare_restart_handler.h"
@@ -17,6 +18,7 @@
 #include <vespa/searchcore/proton/flushengine/flushengine.h>
 #include <vespa/searchcore/proton/flushengine/flush_engine_explorer.h>
 #include <vespa/searchcore/proton/flushengine/tls_stats_factory.h>
+#include <vespa/searchcore/proton/common/hw_counter_sampler.h>
 #include <vespa/searchcore/proton/reference/document_db_reference_registry.h>
 #include <vespa/searchcore/proton/summaryengine/summaryengine.h>
 #include <vespa/searchcore/proton/summaryengine/docsum_by_slime.h>
@@ -26,11 +28,14 @@
 #include <vespa/searchlib/util/fileheadertk.h>
 #include <vespa/searchlib/common/packets.h>
 #include <vespa/document/base/exceptions.h>
+#include <vespa/eval/eval/llvm/disk_object_cache.h>
+#include <vespa/eval/tensor/default_tensor_engine.h>
 #include <vespa/document/datatype/documenttype.h>
 #include <vespa/document/repo/documenttyperepo.h>
 #include <vespa/vespalib/io/fileutil.h>
 #include <vespa/vespalib/util/lambdatask.h>
 #include <vespa/vespalib/util/host_name.h>
+#include <vespa/vespalib/util/mmap_file_allocator.h>
 #include <vespa/vespalib/util/random.h>
 #include <vespa/vespalib/net/state_server.h>
 #include <vespa/vespalib/util/blockingthreadstackexecutor.h>
@@ -112,6 +117,22 @@ derive_shared_threads(const ProtonConfig &proton,
     return std::max(scaledCores, proton.documentdb.size() + proton.flush.maxconcurrent + 1);
 }
 
+size_t
+derive_initialize_threads(const ProtonConfig &proton, const HwInfo &hwInfo) {
+    if (proton.initialize.threads > 0) {
+        return proton.initialize.threads;
+    }
+    // Share the threads between document databases, so that the ones with
+    // most data to load can use the threads left idle by the others.
+    // Slow disks gain little from loading more structures concurrently
+    // than there are document databases.
+    size_t minThreads = proton.documentdb.size() + 1;
+    if (hwInfo.disk().slow()) {
+        return minThreads;
+    }
+    return std::max(minThreads, size_t(hwInfo.cpu().cores()));
+}
+
 const vespalib::string CUSTOM_COMPONENT_API_PATH = "/state/v1/custom/component";
 
 VESPA_THREAD_STACK_TAG(proton_shared_executor)
@@ -191,6 +212,7 @@ Proton::Proton(const config::ConfigUri & configUri,
       _fileHeaderContext(*this, progName),
       _tls(),
       _diskMemUsageSampler(),
+      _hwCounterSampler(),
       _persistenceEngine(),
       _documentDBMap(),
       _matchEngine(),
@@ -216,6 +238,8 @@ Proton::Proton(const config::ConfigUri & configUri,
       _compile_cache_executor_binding(),
       _queryLimiter(),
       _clock(0.001),
+      _tensorLoader(vespalib::tensor::DefaultTensorEngine::ref()),
+      _constantValueCache(_tensorLoader),
       _threadPool(128 * 1024),
       _distributionKey(-1),
       _isInitializing(true),
@@ -258,15 +282,27 @@ Proton::init(const BootstrapConfig::SP & configSnapshot)
     setFS4Compression(protonConfig);
     _diskMemUsageSampler = std::make_unique<DiskMemUsageSampler>(protonConfig.basedir,
                                                                  diskMemUsageSamplerConfig(protonConfig, hwInfo));
+    if (protonConfig.hwcounters.enabled) {
+        // created before the thread pools, as only threads created later are counted
+        _hwCounterSampler = std::make_unique<HwCounterSampler>();
+    }
 
     _tls = std::make_unique<TLS>(_configUri.createWithNewId(protonConfig.tlsconfigid), _fileHeaderContext);
     _metricsEngine->addMetricsHook(_metricsHook);
     _fileHeaderContext.setClusterName(protonConfig.clustername, protonConfig.basedir);
     _matchEngine = std::make_unique<MatchEngine>(protonConfig.numsearcherthreads,
                                                  protonConfig.numthreadspersearch,
-                                                 protonConfig.distributionkey);
+                                                 protonConfig.distributionkey,
+                                                 protonConfig.adaptivethreadspersearch);
+    if (protonConfig.numaawarethreadspersearch) {
+        _matchEngine->enableNumaAwareThreadBundles(vespalib::NumaTopology::getNodeCpus());
+    }
+    if (protonConfig.search.admission.enabled) {
+        _matchEngine->enableAdmissionControl(protonConfig.search.admission.costfactor);
+    }
     _distributionKey = protonConfig.distributionkey;
-    _summaryEngine= std::make_unique<SummaryEngine>(protonConfig.numsummarythreads);
+    _summaryEngine= std::make_unique<SummaryEngine>(protonConfig.numsummarythreads,
+                                                    protonConfig.numthreadspersummary);
     _docsumBySlime = std::make_unique<DocsumBySlime>(*_summaryEngine);
 
     IFlushStrategy::SP strategy;
@@ -287,6 +323,7 @@ Proton::init(const BootstrapConfig::SP & configSnapshot)
     }
     _protonDiskLayout = std::make_unique<ProtonDiskLayout>(protonConfig.basedir, protonConfig.tlsspec);
     vespalib::chdir(protonConfig.basedir);
+    vespalib::alloc::MmapFileAllocatorFactory::instance().setup(protonConfig.basedir + "/swapdirs");
     _tls->start();
     _flushEngine = std::make_unique<FlushEngine>(std::make_shared<flushengine::TlsStatsFactory>(_tls->getTransLogServer()),
                                                  strategy, flush.maxconcurrent, flush.idleinterval*1000);
@@ -306,11 +343,13 @@ Proton::init(const BootstrapConfig::SP & configSnapshot)
     const size_t sharedThreads = derive_shared_threads(protonConfig, hwInfo.cpu());
     _sharedExecutor = std::make_shared<vespalib::BlockingThreadStackExecutor>(sharedThreads, 128*1024, sharedThreads*16, proton_shared_executor);
     _compile_cache_executor_binding = vespalib::eval::CompileCache::bind(_sharedExecutor);
-    InitializeThreads initializeThreads;
-    if (protonConfig.initialize.threads > 0) {
-        initializeThreads = std::make_shared<vespalib::ThreadStackExecutor>(protonConfig.initialize.threads, 128 * 1024, initialize_executor);
-        _initDocumentDbsInSequence = (protonConfig.initialize.threads == 1);
+    if (protonConfig.rankingexpression.diskcache.enabled) {
+        vespalib::eval::CompileCache::set_disk_cache(
+                std::make_shared<vespalib::eval::DiskObjectCache>(protonConfig.basedir + "/llvm-cache"));
     }
+    const size_t initializeThreadCount = derive_initialize_threads(protonConfig, hwInfo);
+    InitializeThreads initializeThreads = std::make_shared<vespalib::ThreadStackExecutor>(initializeThreadCount, 128 * 1024, initialize_executor);
+    _initDocumentDbsInSequence = (initializeThreadCount == 1);
     _protonConfigurer.applyInitialConfig(initializeThreads);
     initializeThreads.reset();
 
@@ -451,6 +490,7 @@ Proton::~Proton()
     _tls.reset();
     _warmupExecutor.reset();
     _compile_cache_executor_binding.reset();
+    vespalib::eval::CompileCache::set_disk_cache(std::shared_ptr<vespalib::eval::DiskObjectCache>());
     _sharedExecutor.reset();
     _clock.stop();
     LOG(debug, "Explicit destructor done");
@@ -580,13 +620,12 @@ Proton::addDocumentDB(const document::DocumentType &docType,
                                                             docTypeName.getName());
     config_store->setProtonConfig(bootstrapConfig->getProtonConfigSP());
     if (!initializeThreads) {
-        // If configured value for initialize threads was 0, or we
-        // are performing a reconfig after startup has completed, then use
-        // 1 thread per document type.
+        // If we are performing a reconfig after startup has completed,
+        // then use 1 thread per document type.
         initializeThreads = std::make_shared<vespalib::ThreadStackExecutor>(1, 128 * 1024);
     }
     auto ret = std::make_shared<DocumentDB>(config.basedir + "/documents", documentDBConfig, config.tlsspec,
-                                            _queryLimiter, _clock, docTypeName, bucketSpace, config, *this,
+                                            _queryLimiter, _clock, _constantValueCache, docTypeName, bucketSpace, config, *this,
                                             *_warmupExecutor, *_sharedExecutor, *_tls->getTransLogServer(),
                                             *_metricsEngine, _fileHeaderContext, std::move(config_store),
                                             initializeThreads, bootstrapConfig->getHwInfo());
@@ -732,15 +771,29 @@ Proton::updateMetrics(const vespalib::MonitorGuard &)
         metrics.resourceUsage.memoryMappings.set(usageFilter.getMemoryStats().getMappingsCount());
         metrics.resourceUsage.openFileDescriptors.set(FastOS_File::count_open_files());
         metrics.resourceUsage.feedingBlocked.set((usageFilter.acceptWriteOperation() ? 0.0 : 1.0));
+        if (_hwCounterSampler && _hwCounterSampler->available()) {
+            HwCounterSampler::Sample sample = _hwCounterSampler->sample();
+            metrics.hwCounters.ipc.set(sample.ipc());
+            metrics.hwCounters.cacheMissesPerKiloInstruction.set(sample.cacheMissesPerKiloInstruction());
+            metrics.hwCounters.branchMissesPerKiloInstruction.set(sample.branchMissesPerKiloInstruction());
+            metrics.hwCounters.cycles.inc(sample.cycles);
+            metrics.hwCounters.instructions.inc(sample.instructions);
+        }
     }
     {
         ContentProtonMetrics::ProtonExecutorMetrics &metrics = _metricsEngine->root().executor;
         updateExecutorMetrics(metrics.proton, _executor.getStats());
         if (_flushEngine) {
             updateExecutorMetrics(metrics.flush, _flushEngine->getExecutorStats());
+            ContentProtonMetrics::RestartMetrics &restart = _metricsEngine->root().restart;
+            const auto &estimator = _flushEngine->getRestartCostEstimator();
+            restart.predictedReplayTime.set(vespalib::to_s(_flushEngine->getPredictedReplayTime()));
+            restart.replayBytesPerSecond.set(estimator.getReplayBytesPerSecond());
+            restart.flushWriteBytesPerSecond.set(estimator.getWriteBytesPerSecond());
         }
         if (_matchEngine) {
             updateExecutorMetrics(metrics.match, _matchEngine->getExecutorStats());
+            _metricsEngine->root().admission.update(_matchEngine->getAdmissionStats());
         }
         if (_summaryEngine) {
             updateExecutorMetrics(metrics.docsum, _summaryEngine->getExecutorStats());
@@ -835,6 +888,7 @@ const vespalib::string DOCUMENT_DB = "documentdb";
 const vespalib::string FLUSH_ENGINE = "flushengine";
 const vespalib::string TLS_NAME = "tls";
 const vespalib::string RESOURCE_USAGE = "resourceusage";
+const vespalib::string HW_COUNTERS = "hwcounters";
 
 struct StateExplorerProxy : vespalib::StateExplorer {
     const StateExplorer &explorer;
@@ -880,7 +934,7 @@ Proton::get_state(const vespalib::slime::Inserter &, bool) const
 std::vector<vespalib::string>
 Proton::get_children_names() const
 {
-    std::vector<vespalib::string> names({DOCUMENT_DB, MATCH_ENGINE, FLUSH_ENGINE, TLS_NAME, RESOURCE_USAGE});
+    std::vector<vespalib::string> names({DOCUMENT_DB, MATCH_ENGINE, FLUSH_ENGINE, TLS_NAME, RESOURCE_USAGE, HW_COUNTERS});
     return names;
 }
 
@@ -898,6 +952,8 @@ Proton::get_child(vespalib::stringref name) const
         return std::make_unique<search::transactionlog::TransLogServerExplorer>(_tls->getTransLogServer());
     } else if (name == RESOURCE_USAGE && _diskMemUsageSampler) {
         return std::make_unique<ResourceUsageExplorer>(_diskMemUsageSampler->writeFilter());
+    } else if (name == HW_COUNTERS) {
+        return std::make_unique<HwCounterExplorer>(_hwCounterSampler.get());
     }
     return Explorer_UP(nullptr);
 }
@@ -908,4 +964,12 @@ Proton::getDocumentDBReferenceRegistry() const
     return _documentDBReferenceRegistry;
 }
 
+void
+Proton::reportTransactionLogReplay(uint64_t replayedBytes, vespalib::duration replayTime)
+{
+    if (_flushEngine) {
+        _flushEngine->getRestartCostEstimator().addReplaySample(replayedBytes, replayTime);
+    }
+}
+
 } // namespace proton
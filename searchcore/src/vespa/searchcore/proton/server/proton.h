@@ -26,6 +26,8 @@
 #include <vespa/vespalib/net/state_explorer.h>
 #include <vespa/vespalib/util/varholder.h>
 #include <vespa/eval/eval/llvm/compile_cache.h>
+#include <vespa/eval/eval/value_cache/constant_tensor_loader.h>
+#include <vespa/eval/eval/value_cache/constant_value_cache.h>
 #include <mutex>
 #include <shared_mutex>
 
@@ -34,6 +36,7 @@ namespace search::transactionlog { class TransLogServerApp; }
 namespace proton {
 
 class DiskMemUsageSampler;
+class HwCounterSampler;
 class IDocumentDBReferenceRegistry;
 class IProtonDiskLayout;
 class PrepareRestartHandler;
@@ -92,6 +95,7 @@ private:
     ProtonFileHeaderContext         _fileHeaderContext;
     std::unique_ptr<TLS>            _tls;
     std::unique_ptr<DiskMemUsageSampler> _diskMemUsageSampler;
+    std::unique_ptr<HwCounterSampler> _hwCounterSampler;
     PersistenceEngine::UP           _persistenceEngine;
     DocumentDBMap                   _documentDBMap;
     std::unique_ptr<MatchEngine>   _matchEngine;
@@ -115,6 +119,9 @@ private:
     vespalib::eval::CompileCache::ExecutorBinding::UP _compile_cache_executor_binding;
     matching::QueryLimiter          _queryLimiter;
     vespalib::Clock                 _clock;
+    // shared by all document dbs, so that each constant is only loaded once
+    vespalib::eval::ConstantTensorLoader _tensorLoader;
+    vespalib::eval::ConstantValueCache   _constantValueCache;
     FastOS_ThreadPool               _threadPool;
     uint32_t                        _distributionKey;
     bool                            _isInitializing;
@@ -149,6 +156,7 @@ private:
     uint32_t getDistributionKey() const override { return _distributionKey; }
     BootstrapConfig::SP getActiveConfigSnapshot() const;
     std::shared_ptr<IDocumentDBReferenceRegistry> getDocumentDBReferenceRegistry() const override;
+    void reportTransactionLogReplay(uint64_t replayedBytes, vespalib::duration replayTime) override;
     bool updateNodeUp(BucketSpace bucketSpace, bool nodeUpInBucketSpace);
     void closeDocumentDBs(vespalib::ThreadStackExecutorBase & executor);
 public:
@@ -42,6 +42,12 @@ ReconfigParams::shouldMatchersChange() const
     return _res.rankProfilesChanged || _res.rankingConstantsChanged || _res.onnxModelsChanged || shouldSchemaChange();
 }
 
+bool
+ReconfigParams::canReuseUnchangedMatchers() const
+{
+    return !_res.rankingConstantsChanged && !_res.onnxModelsChanged && !shouldSchemaChange();
+}
+
 bool
 ReconfigParams::shouldIndexManagerChange() const
 {
@@ -18,6 +18,8 @@ public:
     bool configHasChanged() const;
     bool shouldSchemaChange() const;
     bool shouldMatchersChange() const;
+    // matchers for unchanged rank profiles can be kept when only rank profiles changed
+    bool canReuseUnchangedMatchers() const;
     bool shouldIndexManagerChange() const;
     bool shouldAttributeManagerChange() const;
     bool shouldSummaryManagerChange() const;
@@ -9,14 +9,37 @@ using vespalib::IllegalStateException;
 
 namespace proton {
 
+namespace {
+
+void
+checkAllDataConsumed(const vespalib::nbostream &is, const search::transactionlog::Packet::Entry &entry)
+{
+    if ( ! is.empty()) {
+        throw document::DeserializeException
+            (make_string("Too much data in packet entry (type id '%u', %ld bytes)",
+                         entry.type(), is.size()));
+    }
+}
+
+}
+
+template <typename OperationType>
+std::unique_ptr<FeedOperation>
+ReplayPacketDispatcher::decode(vespalib::nbostream &is, const Packet::Entry &entry,
+                               const document::DocumentTypeRepo &repo)
+{
+    auto op = std::make_unique<OperationType>();
+    op->deserialize(is, repo);
+    op->setSerialNum(entry.serial());
+    return op;
+}
+
 template <typename OperationType>
 void
-ReplayPacketDispatcher::replay(OperationType &op, vespalib::nbostream &is, const Packet::Entry &entry)
+ReplayPacketDispatcher::replay(const FeedOperation &op)
 {
-    op.deserialize(is, _handler.getDeserializeRepo());
-    op.setSerialNum(entry.serial());
     store(op);
-    _handler.replay(op);
+    _handler.replay(static_cast<const OperationType &>(op));
 }
 
 
@@ -28,70 +51,119 @@ ReplayPacketDispatcher::ReplayPacketDispatcher(IReplayPacketHandler &handler)
 
 void
 ReplayPacketDispatcher::replayEntry(const Packet::Entry &entry)
+{
+    if (canDecodeSeparately(entry)) {
+        replayOperation(*decodeEntry(entry, _handler.getDeserializeRepo()));
+    } else {
+        vespalib::nbostream is(entry.data().c_str(), entry.data().size());
+        NewConfigOperation op(entry.serial(), _handler.getNewConfigStreamHandler());
+        op.deserialize(is, _handler.getDeserializeRepo());
+        _handler.replay(op);
+        checkAllDataConsumed(is, entry);
+    }
+}
+
+
+bool
+ReplayPacketDispatcher::canDecodeSeparately(const Packet::Entry &entry)
+{
+    // A new config operation changes the repo used to decode the following entries
+    return (entry.type() != FeedOperation::NEW_CONFIG);
+}
+
+
+std::unique_ptr<FeedOperation>
+ReplayPacketDispatcher::decodeEntry(const Packet::Entry &entry, const document::DocumentTypeRepo &repo)
 {
     vespalib::nbostream is(entry.data().c_str(), entry.data().size());
+    std::unique_ptr<FeedOperation> op;
     switch (entry.type()) {
-    case FeedOperation::PUT: {
-        PutOperation op;
-        replay(op, is, entry);
+    case FeedOperation::PUT:
+        op = decode<PutOperation>(is, entry, repo);
         break;
-    } case FeedOperation::REMOVE: {
-        RemoveOperationWithDocId op;
-        replay(op, is, entry);
+    case FeedOperation::REMOVE:
+        op = decode<RemoveOperationWithDocId>(is, entry, repo);
         break;
-    } case FeedOperation::REMOVE_GID: {
-        RemoveOperationWithGid op;
-        replay(op, is, entry);
+    case FeedOperation::REMOVE_GID:
+        op = decode<RemoveOperationWithGid>(is, entry, repo);
         break;
-    } case FeedOperation::UPDATE: {
-        UpdateOperation op(static_cast<FeedOperation::Type>(entry.type()));
-        replay(op, is, entry);
+    case FeedOperation::UPDATE:
+        op = decode<UpdateOperation>(is, entry, repo);
         break;
-    } case FeedOperation::NOOP: {
-        NoopOperation op;
-        replay(op, is, entry);
+    case FeedOperation::NOOP:
+        op = decode<NoopOperation>(is, entry, repo);
         break;
-    } case FeedOperation::NEW_CONFIG: {
-        NewConfigOperation op(entry.serial(), _handler.getNewConfigStreamHandler());
-        op.deserialize(is, _handler.getDeserializeRepo());
-        _handler.replay(op);
+    case FeedOperation::DELETE_BUCKET:
+        op = decode<DeleteBucketOperation>(is, entry, repo);
         break;
-    } case FeedOperation::DELETE_BUCKET: {
-        DeleteBucketOperation op;
-        replay(op, is, entry);
+    case FeedOperation::SPLIT_BUCKET:
+        op = decode<SplitBucketOperation>(is, entry, repo);
         break;
-    } case FeedOperation::SPLIT_BUCKET: {
-        SplitBucketOperation op;
-        replay(op, is, entry);
+    case FeedOperation::JOIN_BUCKETS:
+        op = decode<JoinBucketsOperation>(is, entry, repo);
         break;
-    } case FeedOperation::JOIN_BUCKETS: {
-        JoinBucketsOperation op;
-        replay(op, is, entry);
+    case FeedOperation::PRUNE_REMOVED_DOCUMENTS:
+        op = decode<PruneRemovedDocumentsOperation>(is, entry, repo);
         break;
-    } case FeedOperation::PRUNE_REMOVED_DOCUMENTS: {
-        PruneRemovedDocumentsOperation op;
-        replay(op, is, entry);
+    case FeedOperation::MOVE:
+        op = decode<MoveOperation>(is, entry, repo);
         break;
-    } case FeedOperation::MOVE: {
-        MoveOperation op;
-        replay(op, is, entry);
+    case FeedOperation::CREATE_BUCKET:
+        op = decode<CreateBucketOperation>(is, entry, repo);
         break;
-    } case FeedOperation::CREATE_BUCKET: {
-        CreateBucketOperation op;
-        replay(op, is, entry);
+    case FeedOperation::COMPACT_LID_SPACE:
+        op = decode<CompactLidSpaceOperation>(is, entry, repo);
         break;
-    } case FeedOperation::COMPACT_LID_SPACE: {
-        CompactLidSpaceOperation op;
-        replay(op, is, entry);
-        break;
-    } default:
+    default:
         throw IllegalStateException
             (make_string("Got packet entry with unknown type id '%u' from TLS", entry.type()));
     }
-    if ( ! is.empty()) {
-        throw document::DeserializeException
-            (make_string("Too much data in packet entry (type id '%u', %ld bytes)",
-                         entry.type(), is.size()));
+    checkAllDataConsumed(is, entry);
+    return op;
+}
+
+
+void
+ReplayPacketDispatcher::replayOperation(const FeedOperation &op)
+{
+    switch (op.getType()) {
+    case FeedOperation::PUT:
+        replay<PutOperation>(op);
+        break;
+    case FeedOperation::REMOVE:
+    case FeedOperation::REMOVE_GID:
+        replay<RemoveOperation>(op);
+        break;
+    case FeedOperation::UPDATE:
+        replay<UpdateOperation>(op);
+        break;
+    case FeedOperation::NOOP:
+        replay<NoopOperation>(op);
+        break;
+    case FeedOperation::DELETE_BUCKET:
+        replay<DeleteBucketOperation>(op);
+        break;
+    case FeedOperation::SPLIT_BUCKET:
+        replay<SplitBucketOperation>(op);
+        break;
+    case FeedOperation::JOIN_BUCKETS:
+        replay<JoinBucketsOperation>(op);
+        break;
+    case FeedOperation::PRUNE_REMOVED_DOCUMENTS:
+        replay<PruneRemovedDocumentsOperation>(op);
+        break;
+    case FeedOperation::MOVE:
+        replay<MoveOperation>(op);
+        break;
+    case FeedOperation::CREATE_BUCKET:
+        replay<CreateBucketOperation>(op);
+        break;
+    case FeedOperation::COMPACT_LID_SPACE:
+        replay<CompactLidSpaceOperation>(op);
+        break;
+    default:
+        throw IllegalStateException
+            (make_string("Cannot replay feed operation with type id '%u'", op.getType()));
     }
 }
 
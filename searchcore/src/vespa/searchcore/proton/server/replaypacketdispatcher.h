@@ -5,6 +5,8 @@
 #include "ireplaypackethandler.h"
 #include <vespa/searchlib/transactionlog/common.h>
 
+namespace document { class DocumentTypeRepo; }
+
 namespace proton {
 
 class FeedOperation;
@@ -12,6 +14,9 @@ class FeedOperation;
  * Utility class that deserializes packet entries into feed operations
  * during replay from the transaction log and dispatches the feed operations
  * to a given handler class.
+ *
+ * Entries other than new config operations can be decoded separately
+ * (e.g. by other threads) and later dispatched in serial number order.
  */
 class ReplayPacketDispatcher
 {
@@ -20,7 +25,10 @@ private:
     IReplayPacketHandler &_handler;
 
     template <typename OperationType>
-    void replay(OperationType &op, vespalib::nbostream &is, const Packet::Entry &entry);
+    static std::unique_ptr<FeedOperation> decode(vespalib::nbostream &is, const Packet::Entry &entry,
+                                                 const document::DocumentTypeRepo &repo);
+    template <typename OperationType>
+    void replay(const FeedOperation &op);
 
 protected:
     virtual void store(const FeedOperation &op);
@@ -30,6 +38,11 @@ public:
     virtual ~ReplayPacketDispatcher();
 
     void replayEntry(const Packet::Entry &entry);
+
+    static bool canDecodeSeparately(const Packet::Entry &entry);
+    static std::unique_ptr<FeedOperation> decodeEntry(const Packet::Entry &entry,
+                                                      const document::DocumentTypeRepo &repo);
+    void replayOperation(const FeedOperation &op);
 };
 
 } // namespace proton
@@ -36,6 +36,7 @@ public:
     ~SampleAttributeUsageJob() override;
 
     bool run() override;
+    bool isDeferrable() const override { return true; }
 };
 
 } // namespace proton
@@ -10,6 +10,12 @@
 #include <vespa/searchcore/proton/reference/i_document_db_reference_resolver.h>
 #include <vespa/searchcore/proton/reprocessing/attribute_reprocessing_initializer.h>
 #include <vespa/eval/eval/llvm/compile_cache.h>
+#include <vespa/vespalib/util/lambdatask.h>
+#include <vespa/vespalib/util/threadstackexecutor.h>
+#include <thread>
+
+#include <vespa/log/log.h>
+LOG_SETUP(".proton.server.searchable_doc_subdb_configurer");
 
 using namespace vespa::config::search;
 using namespace config;
@@ -25,6 +31,8 @@ using matching::OnnxModels;
 
 typedef AttributeReprocessingInitializer::Config ARIConfig;
 
+VESPA_THREAD_STACK_TAG(matcher_setup_executor)
+
 void
 SearchableDocSubDBConfigurer::reconfigureFeedView(const SearchView::SP &searchView)
 {
@@ -124,18 +132,57 @@ SearchableDocSubDBConfigurer::~SearchableDocSubDBConfigurer() = default;
 Matchers::UP
 SearchableDocSubDBConfigurer::createMatchers(const Schema::SP &schema,
                                              const RankProfilesConfig &cfg,
-                                             const OnnxModels &onnxModels)
+                                             const OnnxModels &onnxModels,
+                                             const Matchers *unchanged)
 {
-    auto newMatchers = std::make_unique<Matchers>(_clock, _queryLimiter, _constantValueRepo);
-    for (const auto &profile : cfg.rankprofile) {
-        vespalib::string name = profile.name;
-        search::fef::Properties properties;
-        for (const auto &property : profile.fef.property) {
-            properties.add(property.name, property.value);
+    size_t numProfiles = cfg.rankprofile.size();
+    std::vector<search::fef::Properties> properties(numProfiles);
+    std::vector<Matcher::SP> matchers(numProfiles);
+    std::vector<size_t> toCreate;
+    for (size_t i = 0; i < numProfiles; ++i) {
+        for (const auto &property : cfg.rankprofile[i].fef.property) {
+            properties[i].add(property.name, property.value);
         }
-        // schema instance only used during call.
-        auto profptr = std::make_shared<Matcher>(*schema, properties, _clock, _queryLimiter, _constantValueRepo, onnxModels, _distributionKey);
-        newMatchers->add(name, profptr);
+        if (unchanged != nullptr) {
+            matchers[i] = unchanged->lookup_unchanged(cfg.rankprofile[i].name, properties[i]);
+        }
+        if ( ! matchers[i]) {
+            toCreate.push_back(i);
+        }
+    }
+    LOG(debug, "%s: setting up %zu of %zu rank profiles", _subDbName.c_str(), toCreate.size(), numProfiles);
+    // schema instance only used during call.
+    auto createMatcher = [&](size_t i) {
+        matchers[i] = std::make_shared<Matcher>(*schema, properties[i], _clock, _queryLimiter, _constantValueRepo,
+                                                onnxModels, _distributionKey);
+    };
+    size_t numThreads = std::min(toCreate.size(), size_t(std::max(std::thread::hardware_concurrency(), 1u)));
+    if (numThreads <= 1) {
+        for (size_t i : toCreate) {
+            createMatcher(i);
+        }
+    } else {
+        std::vector<std::exception_ptr> failures(toCreate.size());
+        vespalib::ThreadStackExecutor executor(numThreads, 128 * 1024, matcher_setup_executor);
+        for (size_t task = 0; task < toCreate.size(); ++task) {
+            executor.execute(vespalib::makeLambdaTask([&, task]() {
+                try {
+                    createMatcher(toCreate[task]);
+                } catch (...) {
+                    failures[task] = std::current_exception();
+                }
+            }));
+        }
+        executor.sync();
+        for (const auto &failure : failures) {
+            if (failure) {
+                std::rethrow_exception(failure);
+            }
+        }
+    }
+    auto newMatchers = std::make_unique<Matchers>(_clock, _queryLimiter, _constantValueRepo);
+    for (size_t i = 0; i < numProfiles; ++i) {
+        newMatchers->add(cfg.rankprofile[i].name, std::move(matchers[i]));
     }
     return newMatchers;
 }
@@ -204,7 +251,8 @@ SearchableDocSubDBConfigurer::reconfigure(const DocumentDBConfig &newConfig,
         _constantValueRepo.reconfigure(newConfig.getRankingConstants());
         Matchers::SP newMatchers = createMatchers(newConfig.getSchemaSP(),
                                                   newConfig.getRankProfilesConfig(),
-                                                  newConfig.getOnnxModels());
+                                                  newConfig.getOnnxModels(),
+                                                  params.canReuseUnchangedMatchers() ? matchers.get() : nullptr);
         matchers = newMatchers;
         shouldMatchViewChange = true;
     }
@@ -79,9 +79,15 @@ public:
                                  uint32_t distributionKey);
     ~SearchableDocSubDBConfigurer();
 
+    /**
+     * Create matchers for all rank profiles. Matchers in 'unchanged'
+     * set up from the same rank profile properties are reused, the
+     * rest are set up in parallel.
+     **/
     Matchers::UP createMatchers(const search::index::Schema::SP &schema,
                                 const vespa::config::search::RankProfilesConfig &cfg,
-                                const proton::matching::OnnxModels &onnxModels);
+                                const proton::matching::OnnxModels &onnxModels,
+                                const Matchers *unchanged = nullptr);
 
     void reconfigureIndexSearchable();
 
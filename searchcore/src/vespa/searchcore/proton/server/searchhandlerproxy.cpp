@@ -24,6 +24,12 @@ SearchHandlerProxy::getDocsums(const DocsumRequest & request)
     return _documentDB->getDocsums(request);
 }
 
+std::unique_ptr<search::engine::DocsumReply>
+SearchHandlerProxy::getDocsums(const DocsumRequest & request, ThreadBundle &threadBundle)
+{
+    return _documentDB->getDocsums(request, threadBundle);
+}
+
 std::unique_ptr<search::engine::SearchReply>
 SearchHandlerProxy::match(const SearchRequest &req, vespalib::ThreadBundle &threadBundle) const
 {
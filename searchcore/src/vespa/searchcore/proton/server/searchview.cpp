@@ -119,6 +119,18 @@ SearchView::~SearchView() = default;
 
 DocsumReply::UP
 SearchView::getDocsums(const DocsumRequest & req)
+{
+    return produceDocsums(req, nullptr);
+}
+
+DocsumReply::UP
+SearchView::getDocsums(const DocsumRequest & req, vespalib::ThreadBundle &threadBundle)
+{
+    return produceDocsums(req, &threadBundle);
+}
+
+DocsumReply::UP
+SearchView::produceDocsums(const DocsumRequest & req, vespalib::ThreadBundle *threadBundle)
 {
     LOG(spam, "getDocsums(): resultClass(%s), numHits(%zu)", req.resultClassName.c_str(), req.hits.size());
     if (_summarySetup->getResultConfig().  LookupResultClassId(req.resultClassName.c_str()) == ResultConfig::NoClassID()) {
@@ -126,10 +138,10 @@ SearchView::getDocsums(const DocsumRequest & req)
                      req.resultClassName.c_str(), req.hits.size());
         return createEmptyReply(req);
     }
-    SearchView::InternalDocsumReply reply = getDocsumsInternal(req);
+    SearchView::InternalDocsumReply reply = getDocsumsInternal(req, threadBundle);
     while ( ! reply.second ) {
         LOG(debug, "Must refetch docsums since the lids have moved.");
-        reply = getDocsumsInternal(req);
+        reply = getDocsumsInternal(req, threadBundle);
     }
     if ( ! req.useRootSlime()) {
         convertLidsToGids(*reply.first, req);
@@ -138,7 +150,7 @@ SearchView::getDocsums(const DocsumRequest & req)
 }
 
 SearchView::InternalDocsumReply
-SearchView::getDocsumsInternal(const DocsumRequest & req)
+SearchView::getDocsumsInternal(const DocsumRequest & req, vespalib::ThreadBundle *threadBundle)
 {
     IDocumentMetaStoreContext::IReadGuard::UP readGuard = _matchView->getDocumentMetaStore()->getReadGuard();
     const search::IDocumentMetaStore & metaStore = readGuard->get();
@@ -151,7 +163,12 @@ SearchView::getDocsumsInternal(const DocsumRequest & req)
     auto ctx = std::make_unique<DocsumContext>(req, _summarySetup->getDocsumWriter(), *store, _matchView->getMatcher(req.ranking),
                                                mctx->getSearchContext(), mctx->getAttributeContext(),
                                                *_summarySetup->getAttributeManager(), *getSessionManager());
-    SearchView::InternalDocsumReply reply(ctx->getDocsums(), true);
+    SearchView::InternalDocsumReply reply((threadBundle != nullptr)
+                                          ? ctx->getDocsums(*threadBundle, [this, &req]() {
+                                                return _summarySetup->createDocsumStore(req.resultClassName);
+                                            })
+                                          : ctx->getDocsums(),
+                                          true);
     uint64_t endGeneration = readGuard->get().getCurrentGeneration();
     if (startGeneration != endGeneration) {
         if (requestHasLidAbove(req, std::min(numUsedLids, metaStore.getNumUsedLids()))) {
@@ -34,10 +34,12 @@ public:
     matching::MatchingStats getMatcherStats(const vespalib::string &rankProfile) const { return _matchView->getMatcherStats(rankProfile); }
 
     std::unique_ptr<DocsumReply> getDocsums(const DocsumRequest & req) override;
+    std::unique_ptr<DocsumReply> getDocsums(const DocsumRequest & req, vespalib::ThreadBundle &threadBundle) override;
     std::unique_ptr<SearchReply> match(const SearchRequest &req, vespalib::ThreadBundle &threadBundle) const override;
 private:
     SearchView(ISummaryManager::ISummarySetup::SP summarySetup, MatchView::SP matchView);
-    InternalDocsumReply getDocsumsInternal(const DocsumRequest & req);
+    std::unique_ptr<DocsumReply> produceDocsums(const DocsumRequest & req, vespalib::ThreadBundle *threadBundle);
+    InternalDocsumReply getDocsumsInternal(const DocsumRequest & req, vespalib::ThreadBundle *threadBundle);
     ISummaryManager::ISummarySetup::SP _summarySetup;
     MatchView::SP                      _matchView;
 };
@@ -331,7 +331,12 @@ StoreOnlyFeedView::internalPut(FeedToken token, const PutOperation &putOp)
             createPutDoneContext(std::move(token), std::move(uncommitted),
                                  _gidToLidChangeHandler, doc, gid, putOp.getLid(), serialNum,
                                  putOp.changedDbdId() && useDocumentMetaStore(serialNum));
-        putSummary(serialNum, putOp.getLid(), doc, onWriteDone);
+        if (putOp.getSerializedDocument()) {
+            // Reuse the document as serialized to the transaction log.
+            putSummary(serialNum, putOp.getLid(), putOp.getSerializedDocument(), onWriteDone);
+        } else {
+            putSummary(serialNum, putOp.getLid(), doc, onWriteDone);
+        }
         putAttributes(serialNum, putOp.getLid(), *doc, immediateCommit, onWriteDone);
         putIndexedFields(serialNum, putOp.getLid(), doc, immediateCommit, onWriteDone);
     }
@@ -354,6 +359,12 @@ StoreOnlyFeedView::heartBeatIndexedFields(SerialNum ) {}
 void
 StoreOnlyFeedView::heartBeatAttributes(SerialNum ) {}
 
+bool
+StoreOnlyFeedView::isUpdateableAttributeField(const vespalib::string &) const
+{
+    return false;
+}
+
 void
 StoreOnlyFeedView::updateAttributes(SerialNum, Lid, const DocumentUpdate & upd, bool,
                                     OnOperationDoneType, IFieldUpdateCallback & onUpdate)
@@ -390,6 +401,22 @@ StoreOnlyFeedView::handleUpdate(FeedToken token, const UpdateOperation &updOp)
     internalUpdate(std::move(token), updOp);
 }
 
+bool
+StoreOnlyFeedView::isAttributeOnlyUpdate(const UpdateOperation &updOp) const
+{
+    const DocumentUpdate *upd = updOp.getUpdate().get();
+    if (upd == nullptr || !upd->getFieldPathUpdates().empty()) {
+        return false;
+    }
+    for (const auto & fieldUpdate : upd->getUpdates()) {
+        const vespalib::string &fieldName = fieldUpdate.getField().getName();
+        if (_schema->isIndexField(fieldName) || !isUpdateableAttributeField(fieldName)) {
+            return false;
+        }
+    }
+    return true;
+}
+
 void StoreOnlyFeedView::putSummary(SerialNum serialNum, Lid lid,
                                    FutureStream futureStream, OnOperationDoneType onDone)
 {
@@ -419,6 +446,18 @@ void StoreOnlyFeedView::putSummary(SerialNum serialNum, Lid lid, Document::SP do
             }));
 #pragma GCC diagnostic pop
 }
+void StoreOnlyFeedView::putSummary(SerialNum serialNum, Lid lid, PutOperation::SerializedDocument doc, OnOperationDoneType onDone)
+{
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Winline" // Avoid spurious inlining warning from GCC related to lambda destructor.
+    summaryExecutor().execute(
+            makeLambdaTask([serialNum, doc = std::move(doc), trackerToken = _pendingLidsForDocStore.produce(lid), onDone, lid, this] {
+                (void) onDone;
+                (void) trackerToken;
+                _summaryAdapter->put(serialNum, lid, *doc);
+            }));
+#pragma GCC diagnostic pop
+}
 void StoreOnlyFeedView::removeSummary(SerialNum serialNum, Lid lid, OnWriteDoneType onDone) {
     summaryExecutor().execute(
             makeLambdaTask([serialNum, lid, onDone, trackerToken = _pendingLidsForDocStore.produce(lid), this] {
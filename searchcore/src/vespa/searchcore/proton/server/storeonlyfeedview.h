@@ -159,6 +159,7 @@ private:
     }
     void putSummary(SerialNum serialNum,  Lid lid, FutureStream doc, OnOperationDoneType onDone);
     void putSummary(SerialNum serialNum,  Lid lid, DocumentSP doc, OnOperationDoneType onDone);
+    void putSummary(SerialNum serialNum,  Lid lid, PutOperation::SerializedDocument doc, OnOperationDoneType onDone);
     void removeSummary(SerialNum serialNum,  Lid lid, OnWriteDoneType onDone);
     void heartBeatSummary(SerialNum serialNum);
     bool needCommit() const;
@@ -198,6 +199,7 @@ protected:
     virtual void internalDeleteBucket(const DeleteBucketOperation &delOp);
     virtual void heartBeatIndexedFields(SerialNum serialNum);
     virtual void heartBeatAttributes(SerialNum serialNum);
+    virtual bool isUpdateableAttributeField(const vespalib::string &fieldName) const;
 
 private:
     virtual void putAttributes(SerialNum serialNum, Lid lid, const Document &doc,
@@ -245,6 +247,7 @@ public:
     void handlePut(FeedToken token, const PutOperation &putOp) override;
     void prepareUpdate(UpdateOperation &updOp) override;
     void handleUpdate(FeedToken token, const UpdateOperation &updOp) override;
+    bool isAttributeOnlyUpdate(const UpdateOperation &updOp) const override;
     void prepareRemove(RemoveOperation &rmOp) override;
     void handleRemove(FeedToken token, const RemoveOperation &rmOp) override;
     void prepareDeleteBucket(DeleteBucketOperation &delOp) override;
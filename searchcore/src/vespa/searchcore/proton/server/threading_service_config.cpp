@@ -15,13 +15,15 @@ ThreadingServiceConfig::ThreadingServiceConfig(uint32_t indexingThreads_,
                                                uint32_t semiUnboundTaskLimit_,
                                                OptimizeFor optimize_,
                                                uint32_t kindOfWatermark_,
-                                               vespalib::duration reactionTime_)
+                                               vespalib::duration reactionTime_,
+                                               uint32_t strandsPerThread_)
     : _indexingThreads(indexingThreads_),
       _defaultTaskLimit(defaultTaskLimit_),
       _semiUnboundTaskLimit(semiUnboundTaskLimit_),
       _optimize(optimize_),
       _kindOfWatermark(kindOfWatermark_),
-      _reactionTime(reactionTime_)
+      _reactionTime(reactionTime_),
+      _strandsPerThread(strandsPerThread_)
 {
 }
 
@@ -63,12 +65,13 @@ ThreadingServiceConfig::make(const ProtonConfig &cfg, double concurrency, const
                                   (cfg.indexing.semiunboundtasklimit / indexingThreads),
                                   selectOptimization(cfg.indexing.optimize),
                                   cfg.indexing.kindOfWatermark,
-                                  vespalib::from_s(cfg.indexing.reactiontime));
+                                  vespalib::from_s(cfg.indexing.reactiontime),
+                                  std::max(1, cfg.indexing.strandsPerThread));
 }
 
 ThreadingServiceConfig
 ThreadingServiceConfig::make(uint32_t indexingThreads) {
-    return ThreadingServiceConfig(indexingThreads, 100, 1000, OptimizeFor::LATENCY, 0, 10ms);
+    return ThreadingServiceConfig(indexingThreads, 100, 1000, OptimizeFor::LATENCY, 0, 10ms, 1);
 }
 
 }
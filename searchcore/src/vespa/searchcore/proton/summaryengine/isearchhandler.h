@@ -37,6 +37,15 @@ public:
      */
     virtual std::unique_ptr<DocsumReply> getDocsums(const DocsumRequest & request) = 0;
 
+    /**
+     * @return Use the request and produce the document summary result,
+     *         using the thread bundle to split large requests.
+     */
+    virtual std::unique_ptr<DocsumReply> getDocsums(const DocsumRequest & request, ThreadBundle &threadBundle) {
+        (void) threadBundle;
+        return getDocsums(request);
+    }
+
     virtual std::unique_ptr<SearchReply>
     match(const SearchRequest &req, ThreadBundle &threadBundle) const = 0;
 };
@@ -56,11 +56,12 @@ SummaryEngine::DocsumMetrics::DocsumMetrics()
 
 SummaryEngine::DocsumMetrics::~DocsumMetrics() = default;
 
-SummaryEngine::SummaryEngine(size_t numThreads)
+SummaryEngine::SummaryEngine(size_t numThreads, size_t threadsPerSummary)
     : _lock(),
       _closed(false),
       _handlers(),
       _executor(numThreads, 128 * 1024),
+      _threadBundlePool(std::max(size_t(1), threadsPerSummary)),
       _metrics(std::make_unique<DocsumMetrics>())
 { }
 
@@ -125,8 +126,9 @@ SummaryEngine::getDocsums(DocsumRequest::UP req)
 
     if (req) {
         ISearchHandler::SP searchHandler = getSearchHandler(DocTypeName(*req));
+        vespalib::SimpleThreadBundle::UP threadBundle = _threadBundlePool.obtain();
         if (searchHandler) {
-            reply = searchHandler->getDocsums(*req);
+            reply = searchHandler->getDocsums(*req, *threadBundle);
         } else {
             HandlerMap<ISearchHandler>::Snapshot snapshot;
             {
@@ -134,9 +136,10 @@ SummaryEngine::getDocsums(DocsumRequest::UP req)
                 snapshot = _handlers.snapshot();
             }
             if (snapshot.valid()) {
-                reply = snapshot.get()->getDocsums(*req); // use the first handler
+                reply = snapshot.get()->getDocsums(*req, *threadBundle); // use the first handler
             }
         }
+        _threadBundlePool.release(std::move(threadBundle));
         updateDocsumMetrics(vespalib::to_s(req->getTimeUsed()), getNumDocs(*reply));
     }
     reply->request = std::move(req);
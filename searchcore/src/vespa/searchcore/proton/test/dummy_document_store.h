@@ -36,6 +36,8 @@ struct DummyDocumentStore : public search::IDocumentStore
     size_t getDiskBloat() const override { return 0; }
     size_t getMaxCompactGain() const override { return getDiskBloat(); }
     search::CacheStats getCacheStats() const override { return search::CacheStats(); }
+    search::CacheStats getLookupCacheStats() const override { return search::CacheStats(); }
+    search::CacheStats getVisitCacheStats() const override { return search::CacheStats(); }
     const vespalib::string &getBaseDir() const override { return _baseDir; }
     void accept(search::IDocumentStoreReadVisitor &,
                 search::IDocumentStoreVisitorProgress &,
@@ -22,6 +22,7 @@ struct DummyFeedView : public IFeedView
     void handlePut(FeedToken, const PutOperation &) override {}
     void prepareUpdate(UpdateOperation &) override {}
     void handleUpdate(FeedToken, const UpdateOperation &) override {}
+    bool isAttributeOnlyUpdate(const UpdateOperation &) const override { return false; }
     void prepareRemove(RemoveOperation &) override {}
     void handleRemove(FeedToken, const RemoveOperation &) override {}
     void prepareDeleteBucket(DeleteBucketOperation &) override {}
@@ -248,6 +248,40 @@ TEST("require that StandardDeviationAggregationResult aggregates multi-value exp
     EXPECT_APPROX(41.5, aggr.getRank().getFloat(), 0.1);
 }
 
+TEST("require that QuantileAggregationResult estimates quantiles of merged results") {
+    QuantileAggregationResult aggr1;
+    aggr1.addQuantile(0.5).addQuantile(0.99);
+    QuantileAggregationResult aggr2(aggr1);
+    for (int64_t i = 1; i <= 10000; ++i) {
+        QuantileAggregationResult &aggr = (i % 2 == 0) ? aggr1 : aggr2;
+        aggr.setExpression(MU<ConstantNode>(MU<Int64ResultNode>(i))).aggregate(DocId(i), HitRank(0));
+    }
+    aggr1.merge(aggr2);
+    EXPECT_EQUAL(10000u, aggr1.getSketch().getCount());
+    EXPECT_APPROX(5000.0, aggr1.getQuantile(0.5), 150.0);
+    EXPECT_APPROX(9900.0, aggr1.getQuantile(0.99), 150.0);
+    EXPECT_APPROX(5000.0, aggr1.getRank().getFloat(), 150.0);
+}
+
+TEST("require that QuantileAggregationResult can be serialized") {
+    QuantileAggregationResult aggr1;
+    aggr1.addQuantile(0.9);
+    aggr1.setExpression(createVectorFloat(std::vector<double>({1.5, 100.25, 30.125}))).
+            aggregate(DocId(42), HitRank(21));
+
+    nbostream os;
+    NBOSerializer nos(os);
+    nos << aggr1;
+    Identifiable::UP obj = Identifiable::create(nos);
+    auto *aggr2 = dynamic_cast<QuantileAggregationResult *>(obj.get());
+    ASSERT_TRUE(aggr2);
+    EXPECT_TRUE(os.empty());
+    EXPECT_EQUAL(1u, aggr2->getQuantiles().size());
+    EXPECT_EQUAL(3u, aggr2->getSketch().getCount());
+    EXPECT_EQUAL(100.25, aggr2->getQuantile(0.9));
+    EXPECT_EQUAL(1.5, aggr2->getQuantile(0.0));
+}
+
 void testAdd(const ResultNode &a, const ResultNode &b, const ResultNode &c) {
     AddFunctionNode func;
     func.appendArg(MU<ConstantNode>(ResultNode::UP(a.clone())))
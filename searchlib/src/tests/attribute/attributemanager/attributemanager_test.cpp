@@ -328,6 +328,17 @@ AttributeManagerTest::testConfigConvert()
         auto out = ConfigConverter::convert(a);
         EXPECT_FALSE(out.hnsw_index_params().has_value());
     }
+    { // huge page policies
+        using vespalib::alloc::HugePagePolicy;
+        CACA a;
+        EXPECT_TRUE(CC::convert(a).huge_page_policy() == HugePagePolicy::DEFAULT);
+        a.hugepages = AttributesConfig::Attribute::Hugepages::MADVISE;
+        a.index.hnsw.enabled = true;
+        a.index.hnsw.hugepages = AttributesConfig::Attribute::Index::Hnsw::Hugepages::HUGETLB;
+        auto out = ConfigConverter::convert(a);
+        EXPECT_TRUE(out.huge_page_policy() == HugePagePolicy::MADVISE);
+        EXPECT_TRUE(out.hnsw_index_params().value().huge_page_policy() == HugePagePolicy::HUGETLB);
+    }
 }
 
 bool gt_attribute(const attribute::IAttributeVector * a, const attribute::IAttributeVector * b) {
@@ -563,6 +563,38 @@ TEST_F("Test bitvectors with weighted set value int32", BitVectorTest)
                                        "int32_sv");
 }
 
+TEST_F("Test that btrees alongside bitvectors follow ranked term usage", BitVectorTest)
+{
+    Config cfg(BasicType::INT32, CollectionType::SINGLE);
+    BitVectorTest::AttributePtr v = f.make(cfg, "int32_sv_adaptive", true, true, false, false);
+    f.addDocs(v, 1024);
+    IntegerAttribute &iv = f.asInt(v);
+    f.populate(iv, 2, 1023, true);
+    auto rankedUsesBitVector = [&]() {
+        SearchContextPtr sc = f.template getSearch<IntegerAttribute>(iv, false);
+        TermFieldMatchData md;
+        sc->fetchPostings(search::queryeval::ExecuteInfo::TRUE);
+        SearchBasePtr sb = sc->createIterator(&md, true);
+        return (dynamic_cast<BitVectorIterator *>(sb.get()) != nullptr);
+    };
+    EXPECT_FALSE(rankedUsesBitVector());
+    // posting changes without ranked term lookups drop the btrees
+    for (uint32_t round = 0; round < 200; ++round) {
+        for (uint32_t docId = 3; docId < 1024; docId += 5) {
+            EXPECT_TRUE(iv.update(docId, -43 - (round % 2)));
+        }
+        iv.commit();
+    }
+    EXPECT_TRUE(rankedUsesBitVector());
+    f.checkSearch(v, f.template getSearch<IntegerAttribute>(iv, false), 2, 1022, 205, false, true);
+    // a ranked term lookup brings them back
+    EXPECT_TRUE(iv.update(3, -45));
+    iv.commit();
+    EXPECT_FALSE(rankedUsesBitVector());
+    f.checkSearch(v, f.template getSearch<IntegerAttribute>(iv, false), 2, 1022, 205, false, true);
+    f.checkSearch(v, f.template getSearch<IntegerAttribute>(iv, true), 2, 1022, 205, false, true);
+}
+
 TEST_F("Test bitvectors with single value double", BitVectorTest)
 {
     f.template test<FloatingPointAttribute,
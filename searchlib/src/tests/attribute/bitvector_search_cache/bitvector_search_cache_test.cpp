@@ -7,6 +7,7 @@
 
 using namespace search;
 using namespace search::attribute;
+using namespace std::chrono_literals;
 
 using BitVectorSP = BitVectorSearchCache::BitVectorSP;
 using Entry = BitVectorSearchCache::Entry;
@@ -17,6 +18,13 @@ makeEntry()
     return std::make_shared<Entry>(IDocumentMetaStoreContext::IReadGuard::UP(), BitVector::create(5), 10);
 }
 
+Entry::SP
+makeEntry(vespalib::steady_time created)
+{
+    return std::make_shared<Entry>(IDocumentMetaStoreContext::IReadGuard::UP(), BitVector::create(1000), 1000,
+                                   created);
+}
+
 struct Fixture {
     BitVectorSearchCache cache;
     Entry::SP entry1;
@@ -60,4 +68,43 @@ TEST_F("require that cache can be cleared", Fixture)
     EXPECT_TRUE(f.cache.find("bar").get() == nullptr);
 }
 
+TEST_F("require that single bit vectors can be erased", Fixture)
+{
+    f.cache.insert("foo", f.entry1);
+    f.cache.erase("foo");
+    f.cache.erase("bar");
+    EXPECT_EQUAL(0u, f.cache.size());
+    f.cache.insert("foo", f.entry2);
+    EXPECT_EQUAL(f.entry2, f.cache.find("foo"));
+}
+
+TEST_F("require that memory usage of cached bit vectors is tracked", Fixture)
+{
+    EXPECT_EQUAL(0u, f.cache.memoryUsage());
+    f.cache.insert("foo", f.entry1);
+    size_t bytes = f.entry1->memoryUsage();
+    EXPECT_LESS(0u, bytes);
+    EXPECT_EQUAL(bytes, f.cache.memoryUsage());
+    f.cache.insert("foo", f.entry2);
+    EXPECT_EQUAL(bytes, f.cache.memoryUsage());
+    f.cache.insert("bar", f.entry2);
+    EXPECT_EQUAL(2 * bytes, f.cache.memoryUsage());
+    f.cache.clear();
+    EXPECT_EQUAL(0u, f.cache.memoryUsage());
+}
+
+TEST_F("require that old entries can be removed", Fixture)
+{
+    vespalib::steady_time now = vespalib::steady_clock::now();
+    auto old_entry = makeEntry(now - 10s);
+    auto new_entry = makeEntry(now);
+    f.cache.insert("old", old_entry);
+    f.cache.insert("new", new_entry);
+    f.cache.removeOlderThan(now - 5s);
+    EXPECT_EQUAL(1u, f.cache.size());
+    EXPECT_TRUE(f.cache.find("old").get() == nullptr);
+    EXPECT_EQUAL(new_entry, f.cache.find("new"));
+    EXPECT_EQUAL(new_entry->memoryUsage(), f.cache.memoryUsage());
+}
+
 TEST_MAIN() { TEST_RUN_ALL(); }
@@ -0,0 +1,268 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/document/update/arithmeticvalueupdate.h>
+#include <vespa/searchlib/attribute/attributefactory.h>
+#include <vespa/searchlib/attribute/attributeguard.h>
+#include <vespa/searchlib/attribute/integerbase.h>
+#include <vespa/searchlib/attribute/singlecompressedintegerattribute.h>
+#include <vespa/searchlib/fef/termfieldmatchdata.h>
+#include <vespa/searchlib/query/query_term_simple.h>
+#include <vespa/searchlib/queryeval/searchiterator.h>
+#include <vespa/searchcommon/attribute/search_context_params.h>
+#include <vespa/vespalib/gtest/gtest.h>
+#include <random>
+
+#include <vespa/log/log.h>
+LOG_SETUP("compressed_integer_attribute_test");
+
+using search::AttributeFactory;
+using search::AttributeGuard;
+using search::AttributeVector;
+using search::IntegerAttribute;
+using search::IntegerAttributeTemplate;
+using search::QueryTermSimple;
+using search::SingleValueCompressedIntegerAttribute;
+using search::attribute::BasicType;
+using search::attribute::CollectionType;
+using search::attribute::Config;
+using search::attribute::SearchContextParams;
+using search::fef::TermFieldMatchData;
+
+using CompressedInt64Attribute = SingleValueCompressedIntegerAttribute<IntegerAttributeTemplate<int64_t>>;
+
+constexpr int64_t undefined = std::numeric_limits<int64_t>::min();
+
+Config make_config(bool compressed) {
+    Config cfg(BasicType::INT64, CollectionType::SINGLE);
+    cfg.setCompressed(compressed);
+    return cfg;
+}
+
+class CompressedIntegerAttributeTest : public ::testing::Test {
+protected:
+    std::shared_ptr<AttributeVector> _compressed;
+    std::shared_ptr<AttributeVector> _plain;
+    std::mt19937 _rnd;
+
+    CompressedIntegerAttributeTest()
+        : _compressed(AttributeFactory::createAttribute("compressed", make_config(true))),
+          _plain(AttributeFactory::createAttribute("plain", make_config(false))),
+          _rnd(42)
+    {
+    }
+
+    IntegerAttribute &compressed() { return static_cast<IntegerAttribute &>(*_compressed); }
+    IntegerAttribute &plain() { return static_cast<IntegerAttribute &>(*_plain); }
+
+    void add_docs(uint32_t num_docs) {
+        _compressed->addDocs(num_docs);
+        _plain->addDocs(num_docs);
+        commit();
+    }
+
+    void update(uint32_t doc, int64_t value) {
+        compressed().update(doc, value);
+        plain().update(doc, value);
+    }
+
+    void clear(uint32_t doc) {
+        _compressed->clearDoc(doc);
+        _plain->clearDoc(doc);
+    }
+
+    void commit() {
+        _compressed->commit();
+        _plain->commit();
+    }
+
+    void fill_random(int64_t min_value, int64_t max_value) {
+        std::uniform_int_distribution<int64_t> dist(min_value, max_value);
+        for (uint32_t doc = 1; doc < _plain->getNumDocs(); ++doc) {
+            update(doc, dist(_rnd));
+        }
+        commit();
+    }
+
+    void expect_same_values() {
+        ASSERT_EQ(_plain->getNumDocs(), _compressed->getNumDocs());
+        for (uint32_t doc = 0; doc < _plain->getNumDocs(); ++doc) {
+            ASSERT_EQ(_plain->getInt(doc), _compressed->getInt(doc)) << "doc " << doc;
+        }
+    }
+
+    std::vector<uint32_t> search(AttributeVector &attr, const vespalib::string &term, bool strict) {
+        auto ctx = attr.getSearch(std::make_unique<QueryTermSimple>(term, QueryTermSimple::WORD),
+                                  SearchContextParams());
+        TermFieldMatchData tfmd;
+        auto itr = ctx->createIterator(&tfmd, strict);
+        std::vector<uint32_t> hits;
+        itr->initRange(1, attr.getCommittedDocIdLimit());
+        if (strict) {
+            for (itr->seek(1); !itr->isAtEnd(); itr->seek(itr->getDocId() + 1)) {
+                hits.push_back(itr->getDocId());
+            }
+        } else {
+            for (uint32_t doc = 1; doc < attr.getCommittedDocIdLimit(); ++doc) {
+                if (itr->seek(doc)) {
+                    hits.push_back(doc);
+                }
+            }
+        }
+        return hits;
+    }
+
+    void expect_same_search_result(const vespalib::string &term) {
+        for (bool strict: {false, true}) {
+            auto expect = search(*_plain, term, strict);
+            auto actual = search(*_compressed, term, strict);
+            EXPECT_EQ(expect, actual) << "term " << term << (strict ? " (strict)" : " (non-strict)");
+        }
+    }
+};
+
+TEST_F(CompressedIntegerAttributeTest, compressed_attribute_is_created_when_configured)
+{
+    EXPECT_TRUE(dynamic_cast<CompressedInt64Attribute *>(_compressed.get()) != nullptr);
+    EXPECT_TRUE(dynamic_cast<CompressedInt64Attribute *>(_plain.get()) == nullptr);
+}
+
+TEST_F(CompressedIntegerAttributeTest, new_documents_have_undefined_value)
+{
+    add_docs(100);
+    for (uint32_t doc = 0; doc < 100; ++doc) {
+        EXPECT_EQ(undefined, compressed().getInt(doc));
+        EXPECT_TRUE(compressed().isUndefined(doc));
+    }
+}
+
+TEST_F(CompressedIntegerAttributeTest, values_are_kept_when_value_ranges_change)
+{
+    add_docs(1000);
+    fill_random(0, 10);
+    expect_same_values();
+    fill_random(1000000, 1000100);
+    expect_same_values();
+    fill_random(-5, 5);
+    expect_same_values();
+    update(17, std::numeric_limits<int64_t>::max());
+    update(18, undefined + 1);
+    update(300, -1);
+    clear(19);
+    clear(400);
+    commit();
+    expect_same_values();
+    fill_random(std::numeric_limits<int64_t>::min() + 1, std::numeric_limits<int64_t>::max());
+    expect_same_values();
+}
+
+TEST_F(CompressedIntegerAttributeTest, arithmetic_updates_are_applied)
+{
+    add_docs(200);
+    fill_random(0, 100);
+    for (uint32_t doc = 1; doc < 200; doc += 3) {
+        compressed().apply(doc, document::ArithmeticValueUpdate(document::ArithmeticValueUpdate::Add, 1000));
+        plain().apply(doc, document::ArithmeticValueUpdate(document::ArithmeticValueUpdate::Add, 1000));
+    }
+    commit();
+    expect_same_values();
+}
+
+TEST_F(CompressedIntegerAttributeTest, small_value_ranges_use_less_memory)
+{
+    add_docs(64 * 1024);
+    fill_random(0, 1000);
+    expect_same_values();
+    uint64_t compressed_bytes = _compressed->getStatus().getUsed();
+    uint64_t plain_bytes = _plain->getStatus().getUsed();
+    LOG(info, "memory used: compressed=%" PRIu64 ", plain=%" PRIu64, compressed_bytes, plain_bytes);
+    EXPECT_LT(compressed_bytes * 3, plain_bytes);
+}
+
+TEST_F(CompressedIntegerAttributeTest, search_gives_same_result_as_plain_attribute)
+{
+    add_docs(5000);
+    fill_random(0, 400);
+    for (uint32_t doc = 1; doc < 5000; doc += 7) {
+        clear(doc);
+    }
+    commit();
+    expect_same_search_result("42");
+    expect_same_search_result("[10;20]");
+    expect_same_search_result("<100");
+    expect_same_search_result(">390");
+    expect_same_search_result("[-5;-1]");
+}
+
+TEST_F(CompressedIntegerAttributeTest, replaced_blocks_are_compacted)
+{
+    add_docs(64 * 1024);
+    fill_random(0, 3);
+    uint64_t used_before = _compressed->getStatus().getUsed();
+    AttributeGuard guard(_compressed);
+    // widen the value range of every block a few times
+    for (int64_t range: {100, 10000, 1000000}) {
+        for (uint32_t doc = 1; doc < _plain->getNumDocs(); doc += 64) {
+            update(doc, range);
+        }
+        commit();
+        if (range == 10000) {
+            guard = AttributeGuard();
+        }
+    }
+    expect_same_values();
+    _compressed->commit(true);
+    auto status = _compressed->getStatus();
+    LOG(info, "memory used: before=%" PRIu64 ", after=%" PRIu64 ", dead=%" PRIu64,
+        used_before, status.getUsed(), status.getDead());
+    EXPECT_LT(status.getDead(), status.getUsed() / 2);
+}
+
+TEST_F(CompressedIntegerAttributeTest, saved_attribute_can_be_loaded_as_plain_attribute_and_back)
+{
+    add_docs(1000);
+    fill_random(-100, 100);
+    clear(500);
+    commit();
+    EXPECT_TRUE(_compressed->save("compressed_saved"));
+    auto loaded_plain = AttributeFactory::createAttribute("compressed_saved", make_config(false));
+    EXPECT_TRUE(loaded_plain->load());
+    EXPECT_TRUE(_plain->save("plain_saved"));
+    auto loaded_compressed = AttributeFactory::createAttribute("plain_saved", make_config(true));
+    EXPECT_TRUE(loaded_compressed->load());
+    _compressed = loaded_compressed;
+    _plain = loaded_plain;
+    expect_same_values();
+    fill_random(0, 1000);
+    expect_same_values();
+}
+
+TEST_F(CompressedIntegerAttributeTest, saved_attribute_contains_values_of_repacked_blocks)
+{
+    add_docs(10000);
+    fill_random(0, 10);
+    for (uint32_t doc = 1; doc < 10000; doc += 100) {
+        update(doc, 1000000 + doc);
+    }
+    commit();
+    EXPECT_TRUE(_compressed->save("repacked_saved"));
+    auto loaded_plain = AttributeFactory::createAttribute("repacked_saved", make_config(false));
+    EXPECT_TRUE(loaded_plain->load());
+    _compressed = loaded_plain;
+    expect_same_values();
+}
+
+TEST_F(CompressedIntegerAttributeTest, lid_space_can_be_shrunk_and_grown)
+{
+    add_docs(200);
+    fill_random(0, 50);
+    for (auto attr: {_compressed, _plain}) {
+        attr->compactLidSpace(100);
+        attr->shrinkLidSpace();
+        EXPECT_EQ(100u, attr->getNumDocs());
+    }
+    add_docs(100);
+    expect_same_values();
+    EXPECT_EQ(undefined, compressed().getInt(150));
+}
+
+GTEST_MAIN_RUN_ALL_TESTS()
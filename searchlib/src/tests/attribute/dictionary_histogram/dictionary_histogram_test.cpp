@@ -0,0 +1,83 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/vespalib/testkit/testapp.h>
+#include <vespa/searchlib/attribute/dictionary_histogram.h>
+#include <vector>
+
+using search::attribute::DictionaryHistogram;
+
+namespace {
+
+DictionaryHistogram make_histogram(const std::vector<uint64_t> &counts) {
+    uint64_t total = 0;
+    for (uint64_t count : counts) {
+        total += count;
+    }
+    DictionaryHistogram histogram(counts.size(), total);
+    for (uint64_t count : counts) {
+        histogram.add(count);
+    }
+    histogram.done();
+    return histogram;
+}
+
+uint64_t exact(const std::vector<uint64_t> &counts, uint32_t lower, uint32_t upper) {
+    uint64_t result = 0;
+    for (uint32_t i = lower; i < upper && i < counts.size(); ++i) {
+        result += counts[i];
+    }
+    return result;
+}
+
+}
+
+TEST("require that small histogram gives exact estimates") {
+    std::vector<uint64_t> counts({5, 1, 100, 0, 7});
+    auto histogram = make_histogram(counts);
+    EXPECT_EQUAL(5u, histogram.num_ranks());
+    EXPECT_EQUAL(113u, histogram.total_count());
+    for (uint32_t lower = 0; lower <= 5; ++lower) {
+        for (uint32_t upper = lower; upper <= 6; ++upper) {
+            EXPECT_EQUAL(exact(counts, lower, upper), histogram.estimate(lower, upper));
+        }
+    }
+    EXPECT_EQUAL(0u, histogram.estimate(3, 1));
+}
+
+TEST("require that empty histogram gives zero estimates") {
+    auto histogram = make_histogram({});
+    EXPECT_EQUAL(0u, histogram.estimate(0, 10));
+}
+
+TEST("require that number of samples is bounded") {
+    std::vector<uint64_t> counts(1000000, 3);
+    auto histogram = make_histogram(counts);
+    EXPECT_LESS_EQUAL(histogram.num_samples(), 3 * DictionaryHistogram::TARGET_SAMPLES + 2);
+    EXPECT_EQUAL(3000000u, histogram.total_count());
+    EXPECT_EQUAL(300000u, histogram.estimate(100000, 200000));
+    EXPECT_EQUAL(30u, histogram.estimate(500003, 500013));
+}
+
+TEST("require that skewed distribution is tracked") {
+    // few values in the middle of the dictionary hold most postings
+    std::vector<uint64_t> counts(100000, 1);
+    for (uint32_t i = 50000; i < 50010; ++i) {
+        counts[i] = 1000000;
+    }
+    auto histogram = make_histogram(counts);
+    uint64_t total = histogram.total_count();
+    uint64_t slack = total / DictionaryHistogram::TARGET_SAMPLES;
+    for (uint32_t lower : {0u, 20000u, 49990u, 50000u, 50005u, 50010u}) {
+        for (uint32_t upper : {lower + 5, lower + 10, lower + 1000, 100000u}) {
+            uint64_t expected = exact(counts, lower, upper);
+            uint64_t estimate = histogram.estimate(lower, upper);
+            EXPECT_LESS_EQUAL(estimate, expected + slack);
+            EXPECT_GREATER_EQUAL(estimate + slack, expected);
+        }
+    }
+    // uniform assumption would give about 1000 for this range
+    EXPECT_GREATER(histogram.estimate(49000, 51000), 9000000u);
+    EXPECT_LESS(histogram.estimate(10000, 12000), 3000u);
+}
+
+TEST_MAIN() { TEST_RUN_ALL(); }
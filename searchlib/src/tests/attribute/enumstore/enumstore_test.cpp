@@ -2,6 +2,8 @@
 
 #include <vespa/searchlib/attribute/enumstore.hpp>
 #include <vespa/vespalib/gtest/gtest.h>
+#include <vespa/vespalib/util/threadstackexecutor.h>
+#include <random>
 
 #include <vespa/log/log.h>
 LOG_SETUP("enumstore_test");
@@ -479,6 +481,44 @@ TYPED_TEST(LoaderTest, store_is_instantiated_with_enumerated_postings_loader)
     this->expect_values_in_store();
 }
 
+void
+expect_sorted_by_enum(const attribute::LoadedEnumAttributeVector& loaded, size_t expected_size)
+{
+    ASSERT_EQ(expected_size, loaded.size());
+    attribute::LoadedEnumAttribute::EnumCompare cmp;
+    for (size_t i = 1; i < loaded.size(); ++i) {
+        ASSERT_TRUE(cmp(loaded[i - 1], loaded[i])) << "at " << i;
+    }
+}
+
+attribute::LoadedEnumAttributeVector
+make_loaded_enums(uint32_t num_docs, uint32_t num_enums)
+{
+    std::mt19937 rnd(42);
+    std::uniform_int_distribution<uint32_t> dist(0, num_enums - 1);
+    attribute::LoadedEnumAttributeVector loaded;
+    for (uint32_t doc = 0; doc < num_docs; ++doc) {
+        // skewed distribution with one very common value
+        loaded.push_back(attribute::LoadedEnumAttribute(((doc % 3) == 0) ? 7 : dist(rnd), doc, 1));
+    }
+    return loaded;
+}
+
+TEST(LoadedEnumSortTest, loaded_enums_are_sorted_with_and_without_executor)
+{
+    vespalib::ThreadStackExecutor executor(4, 128 * 1024);
+    for (uint32_t num_enums : {1u, 10u, 1000u, 1000000u}) {
+        for (uint32_t num_docs : {0u, 1000u, 1000000u}) {
+            auto loaded = make_loaded_enums(num_docs, num_enums);
+            auto expected = loaded;
+            attribute::sortLoadedByEnum(expected, nullptr);
+            expect_sorted_by_enum(expected, num_docs);
+            attribute::sortLoadedByEnum(loaded, &executor);
+            expect_sorted_by_enum(loaded, num_docs);
+        }
+    }
+}
+
 TYPED_TEST(LoaderTest, store_is_instantiated_with_non_enumerated_loader)
 {
     auto loader = this->store.make_non_enumerated_loader();
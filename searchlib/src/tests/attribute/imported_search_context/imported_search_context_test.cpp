@@ -207,6 +207,27 @@ TEST_F("Non-strict iterator unpacks target match data for weighted set hit", Wse
     EXPECT_TRUE(is_hit_with_weight(*iter, match, DocId(6), 42));
 }
 
+TEST_F("Non-strict iterator handles consecutive documents referring to the same target document", Fixture) {
+    std::vector<WeightedString> doc3_values{{WeightedString("foo", 5)}};
+    std::vector<WeightedString> doc7_values{{WeightedString("bar", 7)}};
+    reset_with_wset_value_reference_mappings<StringAttribute, WeightedString>(
+            f, BasicType::STRING,
+            {{DocId(1), dummy_gid(3), DocId(3), doc3_values},
+             {DocId(2), dummy_gid(3), DocId(3), doc3_values},
+             {DocId(3), dummy_gid(7), DocId(7), doc7_values},
+             {DocId(4), dummy_gid(7), DocId(7), doc7_values},
+             {DocId(5), dummy_gid(3), DocId(3), doc3_values}});
+    auto ctx = f.create_context(word_term("foo"));
+    TermFieldMatchData match;
+    auto iter = f.create_non_strict_iterator(*ctx, match);
+
+    EXPECT_TRUE(is_hit_with_weight(*iter, match, DocId(1), 5));
+    EXPECT_TRUE(is_hit_with_weight(*iter, match, DocId(2), 5));
+    EXPECT_FALSE(iter->seek(DocId(3)));
+    EXPECT_FALSE(iter->seek(DocId(4)));
+    EXPECT_TRUE(is_hit_with_weight(*iter, match, DocId(5), 5));
+}
+
 TEST_F("Strict iterator is marked as strict", Fixture) {
     auto ctx = f.create_context(word_term("5678"));
     ctx->fetchPostings(queryeval::ExecuteInfo::TRUE);
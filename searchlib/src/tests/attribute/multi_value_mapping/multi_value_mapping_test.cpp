@@ -348,4 +348,44 @@ TEST_F(CompactionIntMappingTest, test_that_compaction_works)
     EXPECT_LT(bufferCountAfter, bufferCountBefore);
 }
 
+TEST_F(CompactionIntMappingTest, test_that_incremental_compaction_works)
+{
+    setup(3, 64, 512, 129);
+    uint32_t addDocs = 10;
+    uint32_t bufferCountBefore = 0;
+    do {
+        addRandomDocs(addDocs);
+        addDocs *= 2;
+        bufferCountBefore = countBuffers();
+    } while (bufferCountBefore < 10);
+    uint32_t clearLimit = size() / 2;
+    for (uint32_t docId = 0; docId < clearLimit; ++docId) {
+        clearDoc(docId);
+    }
+    constexpr uint32_t docsPerStep = 100;
+    uint32_t bufferCountAfter = bufferCountBefore;
+    for (uint32_t compactIter = 0; compactIter < 10; ++compactIter) {
+        _mvMapping->startCompactWorst(true, false);
+        uint32_t steps = 0;
+        while (_mvMapping->compactionInProgress()) {
+            uint32_t nextDocId = _mvMapping->getCompactNextDocId();
+            _mvMapping->compactStep(docsPerStep);
+            EXPECT_TRUE(!_mvMapping->compactionInProgress() ||
+                        _mvMapping->getCompactNextDocId() == nextDocId + docsPerStep);
+            // feed is interleaved with the compaction steps
+            addRandomDoc();
+            clearDoc(clearLimit + (steps % (size() - clearLimit)));
+            checkRefMapping();
+            ++steps;
+        }
+        EXPECT_LE(size() / docsPerStep, steps);
+        _attr->commit();
+        _attr->incGeneration();
+        bufferCountAfter = countBuffers();
+        checkRefMapping();
+        LOG(info, "Have %u buffers after compacting in %u steps", bufferCountAfter, steps);
+    }
+    EXPECT_LT(bufferCountAfter, bufferCountBefore);
+}
+
 GTEST_MAIN_RUN_ALL_TESTS()
@@ -1383,7 +1383,7 @@ SearchContextTest::testRegexSearch(const AttributePtr & ptr)
     addDocs(*ptr.get(), numDocs);
 
     const char * strings [] = {"abc1def", "abc2Def", "abc2def", "abc4def", "abc5def", "abc6def"};
-    std::vector<const char *> terms = { "abc", "bc2de" };
+    std::vector<const char *> terms = { "abc", "bc2de", "c[15]d", "4d", "^abc2", "xyz" };
 
     for (uint32_t doc = 1; doc < numDocs + 1; ++doc) {
         ASSERT_TRUE(doc < vec.getNumDocs());
@@ -1402,6 +1402,19 @@ SearchContextTest::testRegexSearch(const AttributePtr & ptr)
         uint32_t docs[] = {2, 3};
         expected.emplace_back(docs, docs + 2); // "bc2de"
     }
+    {
+        uint32_t docs[] = {1, 5};
+        expected.emplace_back(docs, docs + 2); // "c[15]d"
+    }
+    {
+        uint32_t docs[] = {4};
+        expected.emplace_back(docs, docs + 1); // "4d"
+    }
+    {
+        uint32_t docs[] = {2, 3};
+        expected.emplace_back(docs, docs + 2); // "^abc2"
+    }
+    expected.push_back(empty); // "xyz"
 
     for (uint32_t i = 0; i < terms.size(); ++i) {
         performSearch(vec, terms[i], expected[i], QueryTermSimple::REGEXP);
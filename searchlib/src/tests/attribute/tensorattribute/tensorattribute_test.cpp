@@ -1,12 +1,18 @@
 // Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 
 #include <vespa/document/base/exceptions.h>
+#include <vespa/eval/eval/operation.h>
+#include <vespa/eval/tensor/cell_values.h>
 #include <vespa/eval/tensor/default_tensor_engine.h>
 #include <vespa/eval/tensor/dense/dense_tensor.h>
+#include <vespa/eval/tensor/sparse/sparse_tensor.h>
 #include <vespa/eval/tensor/tensor.h>
 #include <vespa/fastos/file.h>
+#include <vespa/searchlib/fef/termfieldmatchdata.h>
+#include <vespa/searchlib/fef/termfieldmatchdataarray.h>
 #include <vespa/searchlib/attribute/attribute_read_guard.h>
 #include <vespa/searchlib/attribute/attributeguard.h>
+#include <vespa/searchlib/queryeval/executeinfo.h>
 #include <vespa/searchlib/queryeval/nearest_neighbor_blueprint.h>
 #include <vespa/searchlib/tensor/default_nearest_neighbor_index_factory.h>
 #include <vespa/searchlib/tensor/dense_tensor_attribute.h>
@@ -24,6 +30,7 @@
 #include <vespa/vespalib/io/fileutil.h>
 #include <vespa/vespalib/test/insertion_operators.h>
 #include <vespa/vespalib/testkit/test_kit.h>
+#include <vespa/vespalib/util/threadstackexecutor.h>
 #include <vespa/searchlib/util/bufferwriter.h>
 
 #include <vespa/log/log.h>
@@ -36,6 +43,7 @@ using search::attribute::DistanceMetric;
 using search::attribute::HnswIndexParams;
 using search::queryeval::GlobalFilter;
 using search::queryeval::NearestNeighborBlueprint;
+using search::queryeval::SearchIterator;
 using search::tensor::DefaultNearestNeighborIndexFactory;
 using search::tensor::DenseTensorAttribute;
 using search::tensor::DirectTensorAttribute;
@@ -172,6 +180,12 @@ public:
     void expect_complete_add(uint32_t exp_docid, const DoubleVector& exp_vector) const {
         expect_entry(exp_docid, exp_vector, _complete_adds);
     }
+    void expect_prepare_adds(const EntryVector &exp_adds) const {
+        EXPECT_EQUAL(exp_adds, _prepare_adds);
+    }
+    void expect_complete_adds(const EntryVector &exp_adds) const {
+        EXPECT_EQUAL(exp_adds, _complete_adds);
+    }
     generation_t get_transfer_gen() const { return _transfer_gen; }
     generation_t get_trim_gen() const { return _trim_gen; }
     size_t memory_usage_cnt() const { return _memory_usage_cnt; }
@@ -414,6 +428,14 @@ struct Fixture {
         _attr->commit();
     }
 
+    bool modify_tensor(uint32_t docid, TensorAttribute::join_fun_t op, const TensorSpec& cells_spec) {
+        auto cells = createTensor(cells_spec);
+        bool result = _tensorAttr->modify_tensor(docid, op,
+                                                 vespalib::tensor::CellValues(dynamic_cast<const vespalib::tensor::SparseTensor&>(*cells)));
+        _attr->commit();
+        return result;
+    }
+
     void set_empty_tensor(uint32_t docid) {
         set_tensor_internal(docid, *_tensorAttr->getEmptyTensor());
     }
@@ -459,6 +481,13 @@ struct Fixture {
         EXPECT_TRUE(loadok);
     }
 
+    void load_with_executor(vespalib::Executor& executor) {
+        _tensorAttr = makeAttr();
+        _attr = _tensorAttr;
+        bool loadok = _attr->load(&executor);
+        EXPECT_TRUE(loadok);
+    }
+
     TensorSpec expDenseTensor3() const {
         return TensorSpec(denseSpec)
                 .add({{"x", 0}, {"y", 1}}, 11)
@@ -808,6 +837,23 @@ TEST_F("clearDoc() updates nearest neighbor index", DenseTensorAttributeMockInde
     index.expect_empty_add();
 }
 
+TEST_F("modify_tensor() updates cells and nearest neighbor index", DenseTensorAttributeMockIndex)
+{
+    auto& index = f.mock_index();
+    auto add = vespalib::eval::operation::Add::f;
+
+    // Nothing to modify.
+    EXPECT_FALSE(f.modify_tensor(1, add, TensorSpec("tensor(x{})").add({{"x", "1"}}, 1)));
+    index.expect_empty_add();
+
+    f.set_tensor(1, vec_2d(3, 5));
+    index.clear();
+    EXPECT_TRUE(f.modify_tensor(1, add, TensorSpec("tensor(x{})").add({{"x", "1"}}, 1)));
+    f.assertGetTensor(vec_2d(3, 6), 1);
+    index.expect_remove(1, {3, 5});
+    index.expect_add(1, {3, 6});
+}
+
 TEST_F("commit() ensures transfer and trim hold lists on nearest neighbor index", DenseTensorAttributeMockIndex)
 {
     auto& index = f.mock_index();
@@ -866,6 +912,18 @@ TEST_F("onLoad() reconstructs nearest neighbor index if save file does not exist
     index.expect_adds({{1, {3, 5}}, {2, {7, 9}}});
 }
 
+TEST_F("onLoad() reconstructs nearest neighbor index using two-phase adds when given an executor", DenseTensorAttributeMockIndex)
+{
+    f.set_example_tensors();
+    f.save();
+    vespalib::ThreadStackExecutor executor(1, 128 * 1024);
+    f.load_with_executor(executor);
+    auto& index = f.mock_index();
+    index.expect_adds({});
+    index.expect_prepare_adds({{1, {3, 5}}, {2, {7, 9}}});
+    index.expect_complete_adds({{1, {3, 5}}, {2, {7, 9}}});
+}
+
 TEST_F("onLoads() ignores saved nearest neighbor index if not enabled in config", DenseTensorAttributeMockIndex)
 {
     f.save_example_tensors_with_mock_index();
@@ -930,17 +988,40 @@ public:
         return std::unique_ptr<QueryTensor>(tensor);
     }
 
-    std::unique_ptr<NearestNeighborBlueprint> make_blueprint(double brute_force_limit = 0.05) {
+    std::unique_ptr<NearestNeighborBlueprint> make_blueprint(double brute_force_limit = 0.05,
+                                                             double extended_exploration_limit = 0.2) {
         search::queryeval::FieldSpec field("foo", 0, 0);
         auto bp = std::make_unique<NearestNeighborBlueprint>(
             field,
             as_dense_tensor(),
             createDenseTensor(vec_2d(17, 42)),
-            3, true, 5, brute_force_limit);
+            3, true, 5, brute_force_limit, extended_exploration_limit);
         EXPECT_EQUAL(11u, bp->getState().estimate().estHits);
         EXPECT_TRUE(bp->may_approximate());
         return bp;
     }
+
+    std::unique_ptr<NearestNeighborBlueprint> make_batch_blueprint(const TensorSpec &query_spec) {
+        search::queryeval::FieldSpec field("foo", 0, 0);
+        return std::make_unique<NearestNeighborBlueprint>(
+            field,
+            as_dense_tensor(),
+            createDenseTensor(query_spec),
+            2, false, 5, 0.05, 0.2);
+    }
+
+    std::vector<uint32_t> get_hits(const NearestNeighborBlueprint &bp) {
+        search::fef::TermFieldMatchData tfmd;
+        search::fef::TermFieldMatchDataArray tfmda;
+        tfmda.add(&tfmd);
+        auto itr = bp.createLeafSearch(tfmda, true);
+        itr->initRange(1, 11);
+        std::vector<uint32_t> result;
+        for (itr->seek(1); !itr->isAtEnd(); itr->seek(itr->getDocId() + 1)) {
+            result.push_back(itr->getDocId());
+        }
+        return result;
+    }
 };
 
 TEST_F("NN blueprint handles empty filter", NearestNeighborBlueprintFixture)
@@ -979,6 +1060,7 @@ TEST_F("NN blueprint handles weak filter", NearestNeighborBlueprintFixture)
     bp->set_global_filter(*weak_filter);
     EXPECT_EQUAL(3u, bp->getState().estimate().estHits);
     EXPECT_TRUE(bp->may_approximate());
+    EXPECT_EQUAL(NearestNeighborBlueprint::Algorithm::INDEX_TOP_K, bp->get_algorithm());
 }
 
 TEST_F("NN blueprint handles strong filter triggering brute force search", NearestNeighborBlueprintFixture)
@@ -991,6 +1073,52 @@ TEST_F("NN blueprint handles strong filter triggering brute force search", Neare
     bp->set_global_filter(*strong_filter);
     EXPECT_EQUAL(11u, bp->getState().estimate().estHits);
     EXPECT_FALSE(bp->may_approximate());
+    EXPECT_EQUAL(NearestNeighborBlueprint::Algorithm::EXACT_FALLBACK, bp->get_algorithm());
+}
+
+TEST_F("NN blueprint handles strong filter triggering extended exploration", NearestNeighborBlueprintFixture)
+{
+    auto bp = f.make_blueprint(0.05, 0.5);
+    auto filter = search::BitVector::create(11);
+    filter->setBit(3);
+    filter->setBit(5);
+    filter->invalidateCachedCount();
+    auto strong_filter = GlobalFilter::create(std::move(filter));
+    bp->set_global_filter(*strong_filter);
+    EXPECT_EQUAL(2u, bp->getState().estimate().estHits);
+    EXPECT_TRUE(bp->may_approximate());
+    EXPECT_EQUAL(NearestNeighborBlueprint::Algorithm::INDEX_TOP_K_EXTENDED, bp->get_algorithm());
+    EXPECT_EQUAL(8u, bp->get_explore_k());
+}
+
+TEST_F("NN blueprint handles batch of query points", NearestNeighborBlueprintFixture)
+{
+    auto bp = f.make_batch_blueprint(TensorSpec("tensor(q[2],x[2])")
+                                     .add({{"q", 0}, {"x", 0}}, 1.2).add({{"q", 0}, {"x", 1}}, 1.2)
+                                     .add({{"q", 1}, {"x", 0}}, 8.9).add({{"q", 1}, {"x", 1}}, 8.9));
+    EXPECT_TRUE(bp->is_batch());
+    EXPECT_EQUAL(2u, bp->get_batch_size());
+    bp->fetchPostings(search::queryeval::ExecuteInfo::create(true, 1.0));
+    EXPECT_EQUAL(4u, bp->getState().estimate().estHits);
+    EXPECT_EQUAL(std::vector<uint32_t>({1, 2, 8, 9}), f.get_hits(*bp));
+}
+
+TEST_F("NN blueprint handles batch of query points with batch dimension after vector dimension", NearestNeighborBlueprintFixture)
+{
+    auto bp = f.make_batch_blueprint(TensorSpec("tensor(x[2],y[2])")
+                                     .add({{"x", 0}, {"y", 0}}, 1.2).add({{"x", 1}, {"y", 0}}, 1.2)
+                                     .add({{"x", 0}, {"y", 1}}, 8.9).add({{"x", 1}, {"y", 1}}, 8.9));
+    EXPECT_EQUAL(2u, bp->get_batch_size());
+    auto filter = search::BitVector::create(11);
+    filter->setBit(2);
+    filter->setBit(3);
+    filter->setBit(5);
+    filter->setBit(9);
+    filter->invalidateCachedCount();
+    auto global_filter = GlobalFilter::create(std::move(filter));
+    bp->set_global_filter(*global_filter);
+    EXPECT_EQUAL(4u, bp->getState().estimate().estHits);
+    EXPECT_EQUAL(std::vector<uint32_t>({2, 3, 5, 9}), f.get_hits(*bp));
 }
 
 TEST_MAIN() { TEST_RUN_ALL(); }
@@ -0,0 +1,106 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#include <vespa/vespalib/testkit/testapp.h>
+#include <vespa/searchlib/common/bitvectorcache.h>
+#include <map>
+
+using search::BitVectorCache;
+using search::PopulateInterface;
+using vespalib::GenerationHolder;
+
+namespace {
+
+constexpr uint32_t docIdLimit = 200;
+
+// Key k is set for documents k and k + 100.
+struct MyPopulator : PopulateInterface {
+    struct MyIterator : Iterator {
+        std::vector<int32_t> docs;
+        size_t pos;
+        explicit MyIterator(std::vector<int32_t> docs_in) : docs(std::move(docs_in)), pos(0) {}
+        int32_t getNext() override { return (pos < docs.size()) ? docs[pos++] : -1; }
+    };
+    Iterator::UP lookup(uint64_t key) const override {
+        return std::make_unique<MyIterator>(std::vector<int32_t>{int32_t(key), int32_t(key + 100)});
+    }
+};
+
+BitVectorCache::KeyAndCountSet
+keys(uint64_t from, uint64_t to) {
+    BitVectorCache::KeyAndCountSet result;
+    for (uint64_t key = from; key <= to; ++key) {
+        result.emplace_back(key, 2);
+    }
+    return result;
+}
+
+void
+assertKeyBits(const BitVectorCache &cache, uint64_t key) {
+    for (uint32_t docId = 0; docId < docIdLimit; ++docId) {
+        bool expected = (docId == key) || (docId == key + 100);
+        EXPECT_EQUAL(expected, cache.get(key, docId));
+    }
+}
+
+}
+
+TEST("require that most costly keys are cached after enough lookups")
+{
+    GenerationHolder genHolder;
+    BitVectorCache cache(genHolder);
+    MyPopulator populator;
+    cache.lookupCachedSet(keys(1, 40));
+    EXPECT_FALSE(cache.needPopulation());
+    for (size_t i = 1; i < 2000; ++i) {
+        cache.lookupCachedSet(keys(1, 32));
+    }
+    EXPECT_TRUE(cache.needPopulation());
+    cache.populate(docIdLimit, populator);
+    EXPECT_FALSE(cache.needPopulation());
+    for (uint64_t key = 1; key <= 32; ++key) {
+        TEST_DO(assertKeyBits(cache, key));
+    }
+    EXPECT_FALSE(cache.get(40, 40));
+    EXPECT_EQUAL(32u, cache.lookupCachedSet(keys(1, 40)).size());
+}
+
+TEST("require that repopulation keeps cached keys consistent with their bits")
+{
+    GenerationHolder genHolder;
+    BitVectorCache cache(genHolder);
+    MyPopulator populator;
+    cache.lookupCachedSet(keys(1, 40));
+    for (size_t i = 1; i < 2000; ++i) {
+        cache.lookupCachedSet(keys(1, 32));
+    }
+    cache.populate(docIdLimit, populator);
+    // Make keys 33..40 the most frequent ones until cost is checked again.
+    for (size_t i = 2000; i < 0x100000; ++i) {
+        cache.lookupCachedSet(keys(33, 40));
+    }
+    EXPECT_TRUE(cache.needPopulation());
+    cache.populate(docIdLimit, populator);
+    auto cached = cache.lookupCachedSet(keys(1, 40));
+    EXPECT_EQUAL(32u, cached.size());
+    for (uint64_t key = 1; key <= 40; ++key) {
+        if (cached.find(key) != cached.end()) {
+            TEST_DO(assertKeyBits(cache, key));
+        } else {
+            EXPECT_FALSE(cache.get(key, key));
+        }
+    }
+    for (uint64_t key = 33; key <= 40; ++key) {
+        EXPECT_TRUE(cached.find(key) != cached.end());
+    }
+    BitVectorCache::KeySet countKeys;
+    countKeys.insert(33);
+    countKeys.insert(34);
+    std::vector<uint8_t> counts(docIdLimit);
+    BitVectorCache::CountVector countVector(&counts[0], counts.size());
+    cache.computeCountVector(countKeys, countVector);
+    for (uint32_t docId = 0; docId < docIdLimit; ++docId) {
+        bool expected = (docId == 33) || (docId == 34) || (docId == 133) || (docId == 134);
+        EXPECT_EQUAL(expected ? 1u : 0u, uint32_t(counts[docId]));
+    }
+}
+
+TEST_MAIN() { TEST_RUN_ALL(); }
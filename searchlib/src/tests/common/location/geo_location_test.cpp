@@ -358,6 +358,25 @@ TEST(GeoLocationTest, point_radius_and_aspect) {
     EXPECT_FALSE(location.inside_limit(Point{minus_inf,minus_inf}));
 }
 
+TEST(GeoLocationTest, box_may_be_inside_circle) {
+    GeoLocation location(Point{300,-400}, 500);
+    EXPECT_TRUE(location.may_be_inside_limit(Box{Range{250,350},Range{-450,-350}}));
+    EXPECT_TRUE(location.may_be_inside_limit(Box{Range{-200,-100},Range{-450,-350}}));
+    EXPECT_TRUE(location.may_be_inside_limit(Box{Range{0,0},Range{0,0}}));
+    EXPECT_TRUE(location.may_be_inside_limit(Box{Range{minus_inf,plus_inf},Range{minus_inf,plus_inf}}));
+    EXPECT_FALSE(location.may_be_inside_limit(Box{Range{-200,-100},Range{0,100}}));
+    EXPECT_FALSE(location.may_be_inside_limit(Box{Range{-200,-1},Range{1,100}}));
+    EXPECT_FALSE(location.may_be_inside_limit(Box{Range{900,1000},Range{-450,-350}}));
+
+    GeoLocation wide(Point{1200,400}, 500, Aspect{0.25});
+    EXPECT_TRUE(wide.may_be_inside_limit(Box{Range{2300,2400},Range{350,450}}));
+    EXPECT_FALSE(wide.may_be_inside_limit(Box{Range{2300,2400},Range{850,950}}));
+
+    GeoLocation box_only(Box{Range{300,350},Range{400,450}});
+    EXPECT_TRUE(box_only.may_be_inside_limit(Box{Range{340,360},Range{440,460}}));
+    EXPECT_FALSE(box_only.may_be_inside_limit(Box{Range{351,360},Range{440,460}}));
+}
+
 TEST(GeoLocationTest, box_location) {
     Box mybox{Range{300,350},Range{400,450}};
     GeoLocation location(mybox);
@@ -62,6 +62,7 @@ private:
     void requireThatBlueprintIsCreated();
     void requireThatBlueprintCanCreateSearchIterators();
     void requireThatSearchIteratorsConforms();
+    void requireThatAsyncReadsAreWorking();
 public:
     Test();
     ~Test();
@@ -303,6 +304,38 @@ Test::requireThatBlueprintCanCreateSearchIterators()
     }
 }
 
+void
+Test::requireThatAsyncReadsAreWorking()
+{
+    _index->enableAsyncReads(2);
+    EXPECT_TRUE(_index->hasAsyncReads());
+    TermFieldMatchData md;
+    TermFieldMatchDataArray mda;
+    mda.add(&md);
+    { // posting list read ahead of fetchPostings
+        Blueprint::UP b = _index->createBlueprint(_requestContext, FieldSpec("f1", 0, 0), makeTerm("w1"));
+        EXPECT_EQUAL(1u, _index->getAsyncReadStats().issued);
+        b->fetchPostings(queryeval::ExecuteInfo::TRUE);
+        EXPECT_EQUAL(0u, _index->getAsyncReadStats().inFlight);
+        SearchIterator::UP s = (dynamic_cast<LeafBlueprint *>(b.get()))->createLeafSearch(mda, true);
+        s->initFullRange();
+        EXPECT_EQUAL("1,3", toString(*s));
+    }
+    { // bit vector read ahead of fetchPostings
+        Blueprint::UP b = _index->createBlueprint(_requestContext, FieldSpec("f2", 0, 0, true), makeTerm("w2"));
+        EXPECT_EQUAL(2u, _index->getAsyncReadStats().issued);
+        b->fetchPostings(queryeval::ExecuteInfo::TRUE);
+        SearchIterator::UP s = (dynamic_cast<LeafBlueprint *>(b.get()))->createLeafSearch(mda, true);
+        EXPECT_TRUE(dynamic_cast<BitVectorIterator *>(s.get()) != NULL);
+    }
+    { // blueprint dropped without fetching postings
+        Blueprint::UP b = _index->createBlueprint(_requestContext, FieldSpec("f1", 0, 0), makeTerm("w1"));
+        EXPECT_EQUAL(3u, _index->getAsyncReadStats().issued);
+    }
+    _index->enableAsyncReads(0);
+    EXPECT_FALSE(_index->hasAsyncReads());
+}
+
 Test::Test() = default;
 
 Test::~Test() = default;
@@ -364,6 +397,7 @@ Test::Main()
     TEST_DO(requireThatBlueprintIsCreated());
     TEST_DO(requireThatBlueprintCanCreateSearchIterators());
     TEST_DO(requireThatSearchIteratorsConforms());
+    TEST_DO(requireThatAsyncReadsAreWorking());
 
     TEST_DONE();
 }
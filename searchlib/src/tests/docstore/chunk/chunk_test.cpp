@@ -8,11 +8,14 @@
 #include <vespa/searchlib/docstore/chunkformats.h>
 #include <vespa/vespalib/objects/hexdump.h>
 #include <vespa/vespalib/stllike/string.h>
+#include <vespa/vespalib/util/stringfmt.h>
+#include <vespa/vespalib/util/zstdcompressor.h>
 
 LOG_SETUP("chunk_test");
 
 using namespace search;
 using vespalib::compression::CompressionConfig;
+using vespalib::compression::ZStdDictionary;
 
 TEST("require that Chunk obey limits")
 {
@@ -98,4 +101,32 @@ TEST("require that V2 can create and handle lz4, zstd, and none") {
     verifyChunkCompression(CompressionConfig::ZSTD, MY_LONG_STRING, strlen(MY_LONG_STRING), 282);
 }
 
+TEST("require that V2 can use a trained zstd dictionary") {
+    std::vector<vespalib::string> docs;
+    std::vector<vespalib::ConstBufferRef> samples;
+    for (size_t i(0); i < 1000; i++) {
+        docs.push_back(vespalib::make_string("%s Sample number %zu.", MY_LONG_STRING, i));
+    }
+    for (const auto & doc : docs) {
+        samples.emplace_back(doc.data(), doc.size());
+    }
+    ZStdDictionary::SP dictionary = ZStdDictionary::train(samples, 2048);
+    ASSERT_TRUE(dictionary);
+    Chunk plainChunk(0, Chunk::Config(1000));
+    Chunk dictionaryChunk(0, Chunk::Config(1000));
+    plainChunk.append(1, docs[7].data(), docs[7].size());
+    dictionaryChunk.append(1, docs[7].data(), docs[7].size());
+    vespalib::DataBuffer plain;
+    vespalib::DataBuffer withDictionary;
+    CompressionConfig cfg(CompressionConfig::ZSTD);
+    plainChunk.pack(7, plain, cfg);
+    dictionaryChunk.pack(7, withDictionary, cfg, dictionary.get());
+    EXPECT_LESS(withDictionary.getDataLen(), plain.getDataLen());
+    Chunk deserialized(0, withDictionary.getData(), withDictionary.getDataLen(), false, dictionary.get());
+    vespalib::ConstBufferRef doc = deserialized.getLid(1);
+    EXPECT_EQUAL(docs[7], vespalib::string(doc.c_str(), doc.size()));
+    EXPECT_EQUAL(7u, deserialized.getLastSerial());
+    EXPECT_EXCEPTION(Chunk(0, withDictionary.getData(), withDictionary.getDataLen()), std::runtime_error, "Missing zstd dictionary");
+}
+
 TEST_MAIN() { TEST_RUN_ALL(); }
@@ -63,6 +63,18 @@ TEST_FFF("require that cached docstore lookups are counted",
     EXPECT_EQUAL(1u, f3.getCacheStats().misses);
 }
 
+TEST("require that lookup and visit cache stats add up to total cache stats") {
+    NullDataStore store;
+    DocumentStore docStore(DocumentStore::Config(CompressionConfig::NONE, 100000, 100)
+                                   .allowVisitCaching(true).cacheAdmissionFilter(true), store);
+    docStore.read(1, repo);
+    docStore.read(2, repo);
+    EXPECT_EQUAL(2u, docStore.getLookupCacheStats().misses);
+    EXPECT_EQUAL(0u, docStore.getVisitCacheStats().misses);
+    EXPECT_EQUAL(2u, docStore.getCacheStats().misses);
+    EXPECT_EQUAL(0u, docStore.getCacheStats().rejections);
+}
+
 TEST("require that DocumentStore::Config equality operator detects inequality") {
     using C = DocumentStore::Config;
     EXPECT_TRUE(C() == C());
@@ -70,6 +82,7 @@ TEST("require that DocumentStore::Config equality operator detects inequality")
     EXPECT_FALSE(C(CompressionConfig::NONE, 100000, 100) == C(CompressionConfig::NONE, 100000, 99));
     EXPECT_FALSE(C(CompressionConfig::NONE, 100000, 100) == C(CompressionConfig::NONE, 100001, 100));
     EXPECT_FALSE(C(CompressionConfig::NONE, 100000, 100) == C(CompressionConfig::LZ4, 100000, 100));
+    EXPECT_FALSE(C(CompressionConfig::NONE, 100000, 100) == C(CompressionConfig::NONE, 100000, 100).cacheAdmissionFilter(true));
 }
 
 TEST("require that LogDocumentStore::Config equality operator detects inequality") {
@@ -119,7 +119,8 @@ struct WriteFixture : public FixtureBase {
 
     WriteFixture(const vespalib::string &baseName,
                  uint32_t docIdLimit,
-                 bool dirCleanup = true)
+                 bool dirCleanup = true,
+                 const WriteableFileChunk::Config &config = WriteableFileChunk::Config(CompressionConfig(), 0x1000))
         : FixtureBase(baseName, dirCleanup),
           chunk(executor,
                 FileChunk::FileId(0),
@@ -127,7 +128,7 @@ struct WriteFixture : public FixtureBase {
                 baseName,
                 serialNum,
                 docIdLimit,
-                WriteableFileChunk::Config(CompressionConfig(), 0x1000),
+                config,
                 tuneFile,
                 fileHeaderCtx,
                 &bucketizer,
@@ -239,6 +240,32 @@ TEST("require that entries with lid >= docIdLimit are skipped in updateLidMap()"
 
 using vespalib::compression::CompressionConfig;
 
+TEST("require that chunks combined by group commit are written and can be read back")
+{
+    WriteableFileChunk::Config config(CompressionConfig(), 256);
+    config.setGroupCommit(0x4000, std::chrono::milliseconds(50));
+    {
+        WriteFixture f("tmp", 2000, false, config);
+        f.updateLidMap(2000);
+        for (uint32_t lid = 1; lid < 1000; ++lid) {
+            f.append(lid);
+        }
+        f.flush();
+        EXPECT_EQUAL(999u, f.chunk.getNumLids());
+        EXPECT_TRUE(f.chunk.getNumChunks() > 10u);
+    }
+    {
+        ReadFixture f("tmp", true);
+        f.updateLidMap(2000);
+        EXPECT_EQUAL(999u, f.chunk.getNumLids());
+        std::vector<uint32_t> expLids;
+        for (uint32_t lid = 1; lid < 1000; ++lid) {
+            expLids.push_back(lid);
+        }
+        f.assertLidMap(expLids);
+    }
+}
+
 TEST("require that operator == detects inequality") {
     using C = WriteableFileChunk::Config;
     EXPECT_TRUE(C() == C());
@@ -246,6 +273,9 @@ TEST("require that operator == detects inequality") {
     EXPECT_FALSE(C({}, 2) == C({}, 1));
     EXPECT_FALSE(C({}, 1) == C({}, 2));
     EXPECT_FALSE(C({CompressionConfig::LZ4, 9, 60}, 2) == C({}, 2));
+    EXPECT_FALSE(C({}, 2).setGroupCommit(0x10000, std::chrono::milliseconds(10)) == C({}, 2));
+    EXPECT_FALSE(C({}, 2).setGroupCommit(0x10000, std::chrono::milliseconds(10)) ==
+                 C({}, 2).setGroupCommit(0x10000, std::chrono::milliseconds(20)));
 }
 
 TEST_MAIN() { TEST_RUN_ALL(); }
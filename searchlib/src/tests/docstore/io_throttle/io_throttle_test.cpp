@@ -0,0 +1,78 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/vespalib/testkit/test_kit.h>
+#include <vespa/searchlib/docstore/io_throttle.h>
+
+#include <vespa/log/log.h>
+LOG_SETUP("io_throttle_test");
+
+using namespace search;
+using namespace search::docstore;
+using namespace std::chrono_literals;
+
+TEST("require that unlimited throttle does not block")
+{
+    IoThrottle throttle;
+    vespalib::steady_time start = vespalib::steady_clock::now();
+    for (size_t i = 0; i < 1000; ++i) {
+        throttle.acquire(1024*1024);
+    }
+    EXPECT_TRUE((vespalib::steady_clock::now() - start) < 1s);
+    IoThrottleStats stats = throttle.getStats();
+    EXPECT_EQUAL(0u, stats.rateLimit());
+    EXPECT_EQUAL(1000u*1024*1024, stats.bytes());
+    EXPECT_TRUE(stats.throttledTime() == vespalib::duration::zero());
+    EXPECT_FALSE(stats.throttling());
+}
+
+TEST("require that reads are limited to configured rate")
+{
+    IoThrottle throttle;
+    throttle.setRateLimit(1000000, vespalib::duration::zero());
+    vespalib::steady_time start = vespalib::steady_clock::now();
+    for (size_t i = 0; i < 5; ++i) {
+        throttle.acquire(50000);
+    }
+    // The first read is free, the following four wait 50ms each
+    EXPECT_TRUE((vespalib::steady_clock::now() - start) >= 200ms);
+    IoThrottleStats stats = throttle.getStats();
+    EXPECT_EQUAL(1000000u, stats.rateLimit());
+    EXPECT_EQUAL(1000000u, stats.currentRate());
+    EXPECT_EQUAL(250000u, stats.bytes());
+    EXPECT_TRUE(stats.throttledTime() >= 150ms);
+}
+
+TEST("require that rate adapts to observed read latency")
+{
+    IoThrottle throttle;
+    throttle.setRateLimit(1600000, 10ms);
+    for (size_t i = 0; i < 100; ++i) {
+        throttle.reportReadLatency(100ms);
+    }
+    IoThrottleStats stats = throttle.getStats();
+    EXPECT_EQUAL(100000u, stats.currentRate());
+    EXPECT_TRUE(stats.readLatency() > 90ms);
+    for (size_t i = 0; i < 200; ++i) {
+        throttle.reportReadLatency(1ms);
+    }
+    stats = throttle.getStats();
+    EXPECT_EQUAL(1600000u, stats.currentRate());
+    EXPECT_TRUE(stats.readLatency() < 10ms);
+}
+
+TEST("require that changing rate limit resets current rate")
+{
+    IoThrottle throttle;
+    throttle.setRateLimit(1600000, 10ms);
+    throttle.reportReadLatency(1s);
+    EXPECT_TRUE(throttle.getStats().currentRate() < 1600000u);
+    throttle.setRateLimit(3200000, 10ms);
+    EXPECT_EQUAL(3200000u, throttle.getStats().currentRate());
+}
+
+TEST("require that low io priority guard can be used")
+{
+    LowIoPriorityGuard guard;
+}
+
+TEST_MAIN() { TEST_RUN_ALL(); }
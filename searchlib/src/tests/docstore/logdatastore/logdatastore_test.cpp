@@ -1051,10 +1051,13 @@ TEST("require that config equality operator detects inequality") {
     EXPECT_FALSE(C() == C().setMaxFileSize(1));
     EXPECT_FALSE(C() == C().setMaxDiskBloatFactor(0.3));
     EXPECT_FALSE(C() == C().setMaxBucketSpread(0.3));
+    EXPECT_FALSE(C() == C().setMaxBucketSpreadWhenVisited(1.2));
     EXPECT_FALSE(C() == C().setMinFileSizeFactor(0.3));
     EXPECT_FALSE(C() == C().setFileConfig(WriteableFileChunk::Config({}, 70)));
     EXPECT_FALSE(C() == C().disableCrcOnRead(true));
     EXPECT_FALSE(C() == C().compactCompression({CompressionConfig::ZSTD}));
+    EXPECT_FALSE(C() == C().setCompactIoRateLimit(1000000));
+    EXPECT_FALSE(C() == C().setCompactIoLatencyTarget(std::chrono::milliseconds(10)));
 }
 
 TEST_MAIN() {
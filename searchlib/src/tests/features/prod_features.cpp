@@ -41,6 +41,9 @@
 #include <vespa/searchlib/fef/queryproperties.h>
 #include <vespa/searchlib/fef/test/plugin/setup.h>
 #include <vespa/searchlib/fef/test/dummy_dependency_handler.h>
+#include <vespa/eval/eval/tensor_spec.h>
+#include <vespa/eval/tensor/default_tensor_engine.h>
+#include <vespa/vespalib/objects/nbostream.h>
 #include <vespa/vespalib/util/rand48.h>
 #include <vespa/vespalib/util/stringfmt.h>
 #include <vespa/vespalib/geo/zcurve.h>
@@ -1285,6 +1288,24 @@ Test::testDotProduct()
             assertDotProduct(17, "(0:1,3:4,50:97)", 1, "arrfloat");
         }
 
+        { // weighted set attributes with sparse query tensor
+            using vespalib::eval::TensorSpec;
+            assertDotProductTensor(0,  TensorSpec("tensor(x{})"));
+            assertDotProductTensor(0,  TensorSpec("tensor(x{})").add({{"x", "f"}}, 5));
+            assertDotProductTensor(-5, TensorSpec("tensor(x{})").add({{"x", "a"}}, -5));
+            assertDotProductTensor(55, TensorSpec("tensor(x{})").add({{"x", "a"}}, 1).add({{"x", "b"}}, 2)
+                                   .add({{"x", "c"}}, 3).add({{"x", "d"}}, 4).add({{"x", "e"}}, 5));
+            assertDotProductTensor(550, TensorSpec("tensor(x{})").add({{"x", "a"}}, 1).add({{"x", "b"}}, 2)
+                                   .add({{"x", "c"}}, 3).add({{"x", "d"}}, 4).add({{"x", "e"}}, 5), 1, "wsextstr");
+            for (const char * name : {"wsbyte", "wsint", "wsint_fast"}) {
+                TEST_DO(assertDotProductTensor(18, TensorSpec("tensor(x{})").add({{"x", "4"}}, 4.5), 1, name));
+                TEST_DO(assertDotProductTensor(57, TensorSpec("tensor(x{})").add({{"x", "1"}}, 1).add({{"x", "2"}}, 2)
+                                               .add({{"x", "3"}}, 3).add({{"x", "4"}}, 4.5).add({{"x", "5"}}, 5), 1, name));
+            }
+            // not a single sparse dimension
+            assertDotProductTensor(0, TensorSpec("tensor(x{},y{})").add({{"x", "a"}, {"y", "a"}}, 1));
+        }
+
         assertDotProduct(0, "(0:1,3:4,50:97)", 1, "sint"); // attribute of the wrong type
         assertDotProduct(17, "(0:1,3:4,50:97)", 1, "sint", "arrfloat"); // attribute override
         assertDotProduct(0, "(0:1,3:4,50:97)", 1, "sint", "arrfloat_non_existing"); // incorrect attribute override
@@ -1314,6 +1335,22 @@ Test::assertDotProduct(feature_t exp, const vespalib::string & vector, uint32_t
     ASSERT_TRUE(ft.execute(rr, docId));
 }
 
+void
+Test::assertDotProductTensor(feature_t exp, const vespalib::eval::TensorSpec & vector, uint32_t docId,
+                             const vespalib::string & attribute)
+{
+    RankResult rr;
+    rr.addScore("dotProduct(" + attribute + ",vector)", exp);
+    FtFeatureTest ft(_factory, rr.getKeys());
+    setupForDotProductTest(ft);
+    const auto &engine = vespalib::tensor::DefaultTensorEngine::ref();
+    vespalib::nbostream stream;
+    engine.encode(*engine.from_spec(vector), stream);
+    ft.getQueryEnv().getProperties().add("dotProduct.vector.tensor", vespalib::stringref(stream.peek(), stream.size()));
+    ASSERT_TRUE(ft.setup());
+    ASSERT_TRUE(ft.execute(rr, docId));
+}
+
 void
 Test::setupForDotProductTest(FtFeatureTest & ft)
 {
@@ -5,6 +5,7 @@
 #include <vespa/searchlib/features/distancetopathfeature.h>
 #include <vespa/searchlib/features/termdistancefeature.h>
 #include <vespa/searchlib/fef/test/ftlib.h>
+#include <vespa/eval/eval/tensor_spec.h>
 
 class Test : public FtTestApp
 {
@@ -93,6 +94,8 @@ private:
                               feature_t traveled = 1, feature_t product = 0);
     void assertDotProduct(feature_t exp, const vespalib::string & vector, uint32_t docId = 1,
                           const vespalib::string & attribute = "wsstr", const vespalib::string & attributeOverride="");
+    void assertDotProductTensor(feature_t exp, const vespalib::eval::TensorSpec & vector, uint32_t docId = 1,
+                                const vespalib::string & attribute = "wsstr");
 
     void assertFieldMatch(const vespalib::string & spec, const vespalib::string & query, const vespalib::string & field,
                           const search::features::fieldmatch::Params * params = nullptr, uint32_t totalTermWeight = 0, feature_t totalSignificance = 0.0f);
@@ -92,11 +92,13 @@ struct ExecFixture
         std::vector<AttributePtr> attrs;
         attrs.push_back(createTensorAttribute("tensorattr", "tensor(x{})"));
         attrs.push_back(createTensorAttribute("directattr", "tensor(x{})", true));
+        attrs.push_back(createTensorAttribute("directmixed", "tensor(x{},y[2])", true));
         attrs.push_back(createStringAttribute("singlestr"));
         attrs.push_back(createTensorAttribute("wrongtype", "tensor(y{})"));
         addAttributeField("null");
         setAttributeTensorType("tensorattr", "tensor(x{})");
         setAttributeTensorType("directattr", "tensor(x{})");
+        setAttributeTensorType("directmixed", "tensor(x{},y[2])");
         setAttributeTensorType("wrongtype", "tensor(x{})");
         setAttributeTensorType("null", "tensor(x{})");
 
@@ -113,6 +115,9 @@ struct ExecFixture
             dynamic_cast<TensorAttribute *>(attrs[0].get());
         DirectTensorAttribute *directAttr =
             dynamic_cast<DirectTensorAttribute *>(attrs[1].get());
+        DirectTensorAttribute *directMixedAttr =
+            dynamic_cast<DirectTensorAttribute *>(attrs[2].get());
+        ASSERT_TRUE(directMixedAttr != nullptr);
 
         auto doc_tensor = makeTensor<Tensor>(TensorSpec("tensor(x{})")
                                              .add({{"x", "a"}}, 3)
@@ -120,6 +125,11 @@ struct ExecFixture
                                              .add({{"x", "c"}}, 7));
         tensorAttr->setTensor(1, *doc_tensor);
         directAttr->set_tensor(1, std::move(doc_tensor));
+        directMixedAttr->set_tensor(1, makeTensor<Tensor>(TensorSpec("tensor(x{},y[2])")
+                                                          .add({{"x", "a"}, {"y", 0}}, 3)
+                                                          .add({{"x", "a"}, {"y", 1}}, 5)
+                                                          .add({{"x", "b"}, {"y", 0}}, 7)
+                                                          .add({{"x", "b"}, {"y", 1}}, 11)));
 
         for (const auto &attr : attrs) {
             attr->commit();
@@ -179,6 +189,16 @@ TEST_F("require that direct tensor attribute can be extracted in attribute featu
                                      .add({{"x", "a"}}, 3)), f.execute());
 }
 
+TEST_F("require that direct mixed tensor attribute can be extracted in attribute feature",
+       ExecFixture("attribute(directmixed)"))
+{
+    EXPECT_EQUAL(*makeTensor<Tensor>(TensorSpec("tensor(x{},y[2])")
+                                     .add({{"x", "b"}, {"y", 1}}, 11)
+                                     .add({{"x", "a"}, {"y", 0}}, 3)
+                                     .add({{"x", "b"}, {"y", 0}}, 7)
+                                     .add({{"x", "a"}, {"y", 1}}, 5)), f.execute());
+}
+
 TEST_F("require that tensor from query can be extracted as tensor in query feature",
        ExecFixture("query(tensorquery)"))
 {
@@ -216,6 +236,11 @@ TEST_F("require that empty tensor with correct type is returned by direct tensor
     EXPECT_EQUAL(*make_empty("tensor(x{})"), f.execute(2));
 }
 
+TEST_F("require that empty tensor with correct type is returned by direct mixed tensor attribute",
+       ExecFixture("attribute(directmixed)")) {
+    EXPECT_EQUAL(*make_empty("tensor(x{},y[2])"), f.execute(2));
+}
+
 TEST_F("require that wrong tensor type from query tensor gives empty tensor",
        ExecFixture("query(mappedtensorquery)")) {
     EXPECT_EQUAL(*makeTensor<Tensor>(TensorSpec("tensor(x[2])")
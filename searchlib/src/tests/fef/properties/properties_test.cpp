@@ -303,6 +303,15 @@ TEST("test stuff") {
             EXPECT_EQUAL(matching::NumThreadsPerSearch::lookup(p), 50u);
         }
 
+        { // vespa.matching.minthreadspersearch
+            EXPECT_EQUAL(matching::MinThreadsPerSearch::NAME, vespalib::string("vespa.matching.minthreadspersearch"));
+            EXPECT_EQUAL(matching::MinThreadsPerSearch::DEFAULT_VALUE, 1u);
+            Properties p;
+            EXPECT_EQUAL(matching::MinThreadsPerSearch::lookup(p), 1u);
+            p.add("vespa.matching.minthreadspersearch", "4");
+            EXPECT_EQUAL(matching::MinThreadsPerSearch::lookup(p), 4u);
+        }
+
         { // vespa.matching.minhitsperthread
             EXPECT_EQUAL(matching::MinHitsPerThread::NAME, vespalib::string("vespa.matching.minhitsperthread"));
             EXPECT_EQUAL(matching::MinHitsPerThread::DEFAULT_VALUE, 0u);
@@ -319,6 +328,46 @@ TEST("test stuff") {
             p.add("vespa.matching.numsearchpartitions", "50");
             EXPECT_EQUAL(matching::NumSearchPartitions::lookup(p), 50u);
         }
+        { // vespa.matching.adaptive_reorder_seeks
+            EXPECT_EQUAL(matching::AdaptiveReorderSeeks::NAME, vespalib::string("vespa.matching.adaptive_reorder_seeks"));
+            EXPECT_EQUAL(matching::AdaptiveReorderSeeks::DEFAULT_VALUE, 0u);
+            Properties p;
+            EXPECT_EQUAL(matching::AdaptiveReorderSeeks::lookup(p), 0u);
+            p.add("vespa.matching.adaptive_reorder_seeks", "1000");
+            EXPECT_EQUAL(matching::AdaptiveReorderSeeks::lookup(p), 1000u);
+        }
+        { // vespa.matching.result_cache.max_bytes
+            EXPECT_EQUAL(matching::ResultCacheMaxBytes::NAME, vespalib::string("vespa.matching.result_cache.max_bytes"));
+            EXPECT_EQUAL(matching::ResultCacheMaxBytes::DEFAULT_VALUE, 0u);
+            Properties p;
+            EXPECT_EQUAL(matching::ResultCacheMaxBytes::lookup(p), 0u);
+            p.add("vespa.matching.result_cache.max_bytes", "1048576");
+            EXPECT_EQUAL(matching::ResultCacheMaxBytes::lookup(p), 1048576u);
+        }
+        { // vespa.matching.result_cache.max_age
+            EXPECT_EQUAL(matching::ResultCacheMaxAge::NAME, vespalib::string("vespa.matching.result_cache.max_age"));
+            EXPECT_EQUAL(matching::ResultCacheMaxAge::DEFAULT_VALUE, 1.0);
+            Properties p;
+            EXPECT_EQUAL(matching::ResultCacheMaxAge::lookup(p), 1.0);
+            p.add("vespa.matching.result_cache.max_age", "2.5");
+            EXPECT_EQUAL(matching::ResultCacheMaxAge::lookup(p), 2.5);
+        }
+        { // vespa.matching.global_filter_cache.max_bytes
+            EXPECT_EQUAL(matching::GlobalFilterCacheMaxBytes::NAME, vespalib::string("vespa.matching.global_filter_cache.max_bytes"));
+            EXPECT_EQUAL(matching::GlobalFilterCacheMaxBytes::DEFAULT_VALUE, 0u);
+            Properties p;
+            EXPECT_EQUAL(matching::GlobalFilterCacheMaxBytes::lookup(p), 0u);
+            p.add("vespa.matching.global_filter_cache.max_bytes", "1048576");
+            EXPECT_EQUAL(matching::GlobalFilterCacheMaxBytes::lookup(p), 1048576u);
+        }
+        { // vespa.matching.global_filter_cache.max_age
+            EXPECT_EQUAL(matching::GlobalFilterCacheMaxAge::NAME, vespalib::string("vespa.matching.global_filter_cache.max_age"));
+            EXPECT_EQUAL(matching::GlobalFilterCacheMaxAge::DEFAULT_VALUE, 1.0);
+            Properties p;
+            EXPECT_EQUAL(matching::GlobalFilterCacheMaxAge::lookup(p), 1.0);
+            p.add("vespa.matching.global_filter_cache.max_age", "0.5");
+            EXPECT_EQUAL(matching::GlobalFilterCacheMaxAge::lookup(p), 0.5);
+        }
         { // vespa.matchphase.degradation.attribute
             EXPECT_EQUAL(matchphase::DegradationAttribute::NAME, vespalib::string("vespa.matchphase.degradation.attribute"));
             EXPECT_EQUAL(matchphase::DegradationAttribute::DEFAULT_VALUE, "");
@@ -367,6 +416,14 @@ TEST("test stuff") {
             p.add("vespa.matchphase.degradation.postfiltermultiplier", "0.9");
             EXPECT_EQUAL(matchphase::DegradationPostFilterMultiplier::lookup(p), 0.9);
         }
+        { // vespa.matchphase.degradation.orderedevaluation
+            EXPECT_EQUAL(matchphase::DegradationOrderedEvaluation::NAME, vespalib::string("vespa.matchphase.degradation.orderedevaluation"));
+            EXPECT_EQUAL(matchphase::DegradationOrderedEvaluation::DEFAULT_VALUE, false);
+            Properties p;
+            EXPECT_EQUAL(matchphase::DegradationOrderedEvaluation::lookup(p), false);
+            p.add("vespa.matchphase.degradation.orderedevaluation", "true");
+            EXPECT_EQUAL(matchphase::DegradationOrderedEvaluation::lookup(p), true);
+        }
         { // vespa.matchphase.diversity.attribute
             EXPECT_EQUAL(matchphase::DiversityAttribute::NAME, vespalib::string("vespa.matchphase.diversity.attribute"));
             EXPECT_EQUAL(matchphase::DiversityAttribute::DEFAULT_VALUE, "");
@@ -383,6 +440,14 @@ TEST("test stuff") {
             p.add("vespa.matchphase.diversity.mingroups", "5");
             EXPECT_EQUAL(matchphase::DiversityMinGroups::lookup(p), 5u);
         }
+        { // vespa.admission.priority
+            EXPECT_EQUAL(admission::Priority::NAME, vespalib::string("vespa.admission.priority"));
+            EXPECT_EQUAL(admission::Priority::DEFAULT_VALUE, 0u);
+            Properties p;
+            EXPECT_EQUAL(admission::Priority::lookup(p), 0u);
+            p.add("vespa.admission.priority", "3");
+            EXPECT_EQUAL(admission::Priority::lookup(p), 3u);
+        }
         { // vespa.hitcollector.heapsize
             EXPECT_EQUAL(hitcollector::HeapSize::NAME, vespalib::string("vespa.hitcollector.heapsize"));
             EXPECT_EQUAL(hitcollector::HeapSize::DEFAULT_VALUE, 100u);
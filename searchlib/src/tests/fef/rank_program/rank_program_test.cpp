@@ -1,10 +1,12 @@
 // Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 #include <vespa/vespalib/testkit/test_kit.h>
+#include <vespa/vespalib/test/insertion_operators.h>
 #include <vespa/vespalib/stllike/string.h>
 #include <vespa/vespalib/util/stringfmt.h>
 #include <vespa/searchlib/features/valuefeature.h>
 #include <vespa/searchlib/features/rankingexpressionfeature.h>
 #include <vespa/searchlib/fef/blueprintfactory.h>
+#include <vespa/searchlib/fef/feature_profiler.h>
 #include <vespa/searchlib/fef/indexproperties.h>
 #include <vespa/searchlib/fef/matchdatalayout.h>
 #include <vespa/searchlib/fef/test/indexenvironment.h>
@@ -13,6 +15,7 @@
 #include <vespa/searchlib/fef/test/plugin/double.h>
 #include <vespa/searchlib/fef/rank_program.h>
 #include <vespa/searchlib/fef/test/test_features.h>
+#include <vespa/vespalib/data/slime/slime.h>
 
 using namespace search::fef;
 using namespace search::fef::test;
@@ -71,15 +74,18 @@ struct Fixture {
     BlueprintResolver::SP resolver;
     Properties overrides;
     MatchData::UP match_data;
+    std::unique_ptr<FeatureProfiler> profiler;
     RankProgram program;
     size_t track_cnt;
+    size_t prefetch_miss_cnt;
     Fixture() : factory(), indexEnv(), resolver(new BlueprintResolver(factory, indexEnv)),
-                overrides(), match_data(), program(resolver), track_cnt(0)
+                overrides(), match_data(), profiler(), program(resolver), track_cnt(0), prefetch_miss_cnt(0)
     {
         factory.addPrototype(Blueprint::SP(new BoxingBlueprint()));
         factory.addPrototype(Blueprint::SP(new DocidBlueprint()));
         factory.addPrototype(Blueprint::SP(new DoubleBlueprint()));
         factory.addPrototype(Blueprint::SP(new ImpureValueBlueprint()));
+        factory.addPrototype(Blueprint::SP(new PrefetchBlueprint(prefetch_miss_cnt)));
         factory.addPrototype(Blueprint::SP(new RankingExpressionBlueprint()));
         factory.addPrototype(Blueprint::SP(new SumBlueprint()));
         factory.addPrototype(Blueprint::SP(new TrackingBlueprint(track_cnt)));        
@@ -109,14 +115,33 @@ struct Fixture {
         overrides.add(feature, vespalib::make_string("%g", value));
         return *this;
     }
+    Fixture &profile(uint32_t sample_interval) {
+        profiler = std::make_unique<FeatureProfiler>(sample_interval);
+        return *this;
+    }
     Fixture &compile() {
         ASSERT_TRUE(resolver->compile());
         MatchDataLayout mdl;
         QueryEnvironment queryEnv(&indexEnv);
         match_data = mdl.createMatchData();
-        program.setup(*match_data, queryEnv, overrides);
+        program.setup(*match_data, queryEnv, overrides, profiler.get());
         return *this;
     }
+    Fixture &reset_and_setup() {
+        program.reset();
+        QueryEnvironment queryEnv(&indexEnv);
+        program.setup(*match_data, queryEnv, overrides, profiler.get());
+        return *this;
+    }
+    uint32_t profile_id(const vespalib::string &name) const {
+        for (uint32_t id = 0; id < profiler->num_features(); ++id) {
+            if (profiler->name(id) == name) {
+                return id;
+            }
+        }
+        TEST_FATAL(vespalib::make_string("feature not profiled: %s", name.c_str()).c_str());
+        return 0;
+    }
     vespalib::string final_executor_name() const {
         size_t n = program.num_executors();
         ASSERT_TRUE(n > 0);
@@ -144,8 +169,39 @@ struct Fixture {
         }
         return result_map;
     }
+    std::vector<double> batch(const std::vector<uint32_t> &docids) {
+        ASSERT_TRUE(program.can_batch());
+        auto values = program.run_batch(docids);
+        std::vector<double> result;
+        for (size_t i = 0; i < docids.size(); ++i) {
+            result.push_back(values[i]);
+        }
+        return result;
+    }
+    void prefetch(const std::vector<uint32_t> &docids) {
+        program.start_prefetch(docids.size());
+        for (size_t i = 0; i < docids.size(); ++i) {
+            program.prefetch(i, docids[i]);
+        }
+        program.finish_prefetch();
+    }
+    std::vector<double> per_doc(const std::vector<uint32_t> &docids) {
+        std::vector<double> result;
+        for (uint32_t docid: docids) {
+            result.push_back(get(docid));
+        }
+        return result;
+    }
 };
 
+std::vector<uint32_t> make_docids(uint32_t first, uint32_t num) {
+    std::vector<uint32_t> docids;
+    for (uint32_t i = 0; i < num; ++i) {
+        docids.push_back(first + (i * 3));
+    }
+    return docids;
+}
+
 TEST_F("require that simple program works", Fixture()) {
     EXPECT_EQUAL(15.0, f1.add("mysum(value(10),ivalue(5))").compile().get());
     EXPECT_EQUAL(3u, f1.program.num_executors());
@@ -391,4 +447,147 @@ TEST_F("require that fast-forest gbdt evaluation is pure", Fixture()) {
     EXPECT_EQUAL(f1.final_executor_name(), "search::features::FastForestExecutor");
 }
 
+TEST_F("require that a reset rank program can be set up again", Fixture()) {
+    f1.add("mysum(value(10),docid)").compile();
+    size_t num_executors = f1.program.num_executors();
+    EXPECT_TRUE(f1.program.can_batch());
+    EXPECT_EQUAL(15.0, f1.get(5));
+    f1.program.reset();
+    EXPECT_EQUAL(0u, f1.program.num_executors());
+    EXPECT_FALSE(f1.program.can_batch());
+    f1.override("value(10)", 20.0).reset_and_setup();
+    EXPECT_EQUAL(num_executors, f1.program.num_executors());
+    EXPECT_EQUAL(25.0, f1.get(5));
+    f1.overrides.clear();
+    f1.reset_and_setup();
+    EXPECT_TRUE(f1.program.can_batch());
+    EXPECT_EQUAL(f1.batch({5, 6}), std::vector<double>({15.0, 16.0}));
+}
+
+TEST_F("require that batch execution calculates the same values as per document execution", Fixture()) {
+    f1.add("mysum(value(10),docid,mysum(docid,value(1)))").compile();
+    EXPECT_TRUE(f1.program.can_batch());
+    auto docids = make_docids(5, RankProgram::BATCH_SIZE);
+    EXPECT_EQUAL(f1.per_doc(docids), f1.batch(docids));
+    docids = make_docids(7, 3);
+    EXPECT_EQUAL(f1.batch(docids), std::vector<double>({25.0, 31.0, 37.0}));
+    EXPECT_EQUAL(f1.get(7), 25.0);
+}
+
+TEST_F("require that batch execution works for const seeds", Fixture()) {
+    f1.add("mysum(value(1),value(2))").compile();
+    EXPECT_TRUE(f1.program.can_batch());
+    EXPECT_EQUAL(f1.batch({1, 2, 3}), std::vector<double>({3.0, 3.0, 3.0}));
+}
+
+TEST_F("require that batch execution works for compiled ranking expressions", Fixture()) {
+    f1.lazy_expressions(false).add_expr("rank", "docid*2+value(3)").compile();
+    EXPECT_TRUE(f1.program.can_batch());
+    auto docids = make_docids(1, 10);
+    EXPECT_EQUAL(f1.per_doc(docids), f1.batch(docids));
+}
+
+TEST_F("require that batch execution is not used when an executor does not support it", Fixture()) {
+    f1.add("mysum(docid,ivalue(5))").compile();
+    EXPECT_FALSE(f1.program.can_batch());
+}
+
+TEST_F("require that batch execution is not used for overridden features", Fixture()) {
+    f1.add("mysum(docid,value(1))").override("docid", 10.0).compile();
+    EXPECT_FALSE(f1.program.can_batch());
+}
+
+TEST_F("require that batch execution is not used with multiple seeds", Fixture()) {
+    f1.add("docid").add("mysum(docid,value(1))").compile();
+    EXPECT_FALSE(f1.program.can_batch());
+}
+
+TEST_F("require that batch execution is not used for object seeds", Fixture()) {
+    f1.add("box(docid)").compile();
+    EXPECT_FALSE(f1.program.can_batch());
+}
+
+TEST_F("require that prefetched documents use prefetched values", Fixture()) {
+    f1.add("mysum(prefetch(docid),value(1))").compile();
+    EXPECT_TRUE(f1.program.can_prefetch());
+    auto docids = make_docids(5, 3);
+    f1.prefetch(docids);
+    EXPECT_EQUAL(f1.per_doc(docids), std::vector<double>({6.0, 9.0, 12.0}));
+    EXPECT_EQUAL(f1.prefetch_miss_cnt, 0u);
+    EXPECT_EQUAL(f1.get(6), 7.0);
+    EXPECT_EQUAL(f1.prefetch_miss_cnt, 1u);
+}
+
+TEST_F("require that executors depending on prefetched executors are not prefetched", Fixture()) {
+    f1.add("prefetch(prefetch(docid))").compile();
+    EXPECT_TRUE(f1.program.can_prefetch());
+    auto docids = make_docids(5, 3);
+    f1.prefetch(docids);
+    EXPECT_EQUAL(f1.per_doc(docids), std::vector<double>({5.0, 8.0, 11.0}));
+    EXPECT_EQUAL(f1.prefetch_miss_cnt, 3u);
+}
+
+TEST_F("require that const executors are not prefetched", Fixture()) {
+    f1.add("prefetch(value(5))").compile();
+    EXPECT_FALSE(f1.program.can_prefetch());
+    EXPECT_EQUAL(f1.get(), 5.0);
+}
+
+TEST_F("require that programs without prefetching executors can not prefetch", Fixture()) {
+    f1.add("mysum(docid,value(1))").compile();
+    EXPECT_FALSE(f1.program.can_prefetch());
+}
+
+TEST_F("require that profiling collects time spent in each non-const feature", Fixture()) {
+    f1.profile(1).add("mysum(docid,ivalue(5),value(1))").compile();
+    EXPECT_EQUAL(f1.get(1), 7.0);
+    EXPECT_EQUAL(f1.get(2), 8.0);
+    EXPECT_EQUAL(f1.get(2), 8.0);
+    EXPECT_EQUAL(f1.get(3), 9.0);
+    EXPECT_EQUAL(f1.profiler->num_features(), 3u);
+    uint32_t sum = f1.profile_id("mysum(docid,ivalue(5),value(1))");
+    uint32_t docid = f1.profile_id("docid");
+    uint32_t ivalue = f1.profile_id("ivalue(5)");
+    for (uint32_t id: {sum, docid, ivalue}) {
+        EXPECT_EQUAL(f1.profiler->count(id), 3u);
+        EXPECT_TRUE(f1.profiler->self_time(id) <= f1.profiler->total_time(id));
+    }
+    EXPECT_TRUE(f1.profiler->self_time(docid) == f1.profiler->total_time(docid));
+    EXPECT_TRUE(f1.profiler->total_time(sum) ==
+                (f1.profiler->self_time(sum) + f1.profiler->total_time(docid) + f1.profiler->total_time(ivalue)));
+}
+
+TEST_F("require that profiling only samples some documents", Fixture()) {
+    f1.profile(3).add("mysum(docid,value(1))").compile();
+    for (uint32_t docid = 1; docid <= 10; ++docid) {
+        EXPECT_EQUAL(f1.get(docid), docid + 1.0);
+    }
+    EXPECT_EQUAL(f1.profiler->count(f1.profile_id("docid")), 3u);
+}
+
+TEST_F("require that profiled programs can still use batch execution", Fixture()) {
+    f1.profile(1).add("mysum(value(10),docid,mysum(docid,value(1)))").compile();
+    EXPECT_TRUE(f1.program.can_batch());
+    auto docids = make_docids(5, 10);
+    EXPECT_EQUAL(f1.per_doc(docids), f1.batch(docids));
+    EXPECT_EQUAL(f1.profiler->count(f1.profile_id("docid")), 11u);
+}
+
+TEST_F("require that profiling results can be reported", Fixture()) {
+    f1.profile(1).add("mysum(docid,ivalue(5),value(1))").compile();
+    EXPECT_EQUAL(f1.get(1), 7.0);
+    vespalib::Slime slime;
+    f1.profiler->report(slime.setObject());
+    EXPECT_EQUAL(slime.get()["sample_interval"].asLong(), 1);
+    const auto &features = slime.get()["features"];
+    ASSERT_EQUAL(features.entries(), 3u);
+    for (size_t i = 0; i < features.entries(); ++i) {
+        EXPECT_EQUAL(features[i]["count"].asLong(), 1);
+        EXPECT_TRUE(features[i]["self_time_ms"].asDouble() <= features[i]["total_time_ms"].asDouble());
+        if (i > 0) {
+            EXPECT_TRUE(features[i]["self_time_ms"].asDouble() <= features[i - 1]["self_time_ms"].asDouble());
+        }
+    }
+}
+
 TEST_MAIN() { TEST_RUN_ALL(); }
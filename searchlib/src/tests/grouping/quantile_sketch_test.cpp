@@ -0,0 +1,97 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+// Unit tests for quantile sketch.
+
+#include <vespa/log/log.h>
+LOG_SETUP("quantile_sketch_test");
+
+#include <vespa/searchlib/grouping/quantile_sketch.h>
+#include <vespa/vespalib/objects/nboserializer.h>
+#include <vespa/vespalib/objects/nbostream.h>
+#include <vespa/vespalib/testkit/testapp.h>
+#include <algorithm>
+#include <random>
+
+using vespalib::NBOSerializer;
+using vespalib::nbostream;
+using namespace search;
+
+namespace {
+
+TEST("require that empty sketch gives zero") {
+    QuantileSketch sketch;
+    EXPECT_EQUAL(0u, sketch.getCount());
+    EXPECT_EQUAL(0.0, sketch.quantile(0.5));
+}
+
+TEST("require that small inputs give exact quantiles") {
+    QuantileSketch sketch;
+    for (int i = 10; i >= 1; --i) {
+        sketch.add(i);
+    }
+    EXPECT_EQUAL(10u, sketch.getCount());
+    EXPECT_EQUAL(1.0, sketch.quantile(0.0));
+    EXPECT_EQUAL(5.0, sketch.quantile(0.5));
+    EXPECT_EQUAL(10.0, sketch.quantile(1.0));
+}
+
+TEST("require that sketch size is bounded") {
+    QuantileSketch sketch(100);
+    for (int i = 0; i < 1000000; ++i) {
+        sketch.add(i);
+    }
+    EXPECT_EQUAL(1000000u, sketch.getCount());
+    EXPECT_LESS(sketch.getNumRetained(), 400u);
+}
+
+TEST("require that quantiles are estimated within rank error") {
+    std::mt19937 rnd(42);
+    std::vector<double> values;
+    QuantileSketch sketch;
+    for (int i = 0; i < 100000; ++i) {
+        values.push_back(std::uniform_real_distribution<double>(0.0, 1000.0)(rnd));
+        sketch.add(values.back());
+    }
+    std::sort(values.begin(), values.end());
+    for (double q : {0.01, 0.25, 0.5, 0.75, 0.99}) {
+        double estimate = sketch.quantile(q);
+        double rank = double(std::lower_bound(values.begin(), values.end(), estimate) - values.begin()) / values.size();
+        EXPECT_APPROX(q, rank, 0.02);
+    }
+}
+
+TEST("require that merged sketches estimate quantiles of all values") {
+    QuantileSketch a;
+    QuantileSketch b;
+    for (int i = 0; i < 50000; ++i) {
+        a.add(i);
+        b.add(50000 + i);
+    }
+    a.merge(b);
+    EXPECT_EQUAL(100000u, a.getCount());
+    EXPECT_APPROX(50000.0, a.quantile(0.5), 2000.0);
+    EXPECT_APPROX(99000.0, a.quantile(0.99), 2000.0);
+    EXPECT_LESS(a.getNumRetained(), 700u);
+}
+
+TEST("require that sketch can be (de)serialized") {
+    QuantileSketch sketch(50);
+    for (int i = 0; i < 10000; ++i) {
+        sketch.add(i % 97);
+    }
+    nbostream stream;
+    NBOSerializer serializer(stream);
+    sketch.serialize(serializer);
+    QuantileSketch copy;
+    copy.deserialize(serializer);
+    EXPECT_TRUE(stream.empty());
+    EXPECT_EQUAL(sketch.getK(), copy.getK());
+    EXPECT_EQUAL(sketch.getCount(), copy.getCount());
+    EXPECT_EQUAL(sketch.getNumRetained(), copy.getNumRetained());
+    for (double q : {0.0, 0.3, 0.5, 0.9, 1.0}) {
+        EXPECT_EQUAL(sketch.quantile(q), copy.quantile(q));
+    }
+}
+
+}  // namespace
+
+TEST_MAIN() { TEST_RUN_ALL(); }
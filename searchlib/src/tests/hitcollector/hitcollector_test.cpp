@@ -4,6 +4,7 @@
 #include <vespa/searchlib/common/bitvector.h>
 #include <vespa/searchlib/fef/fef.h>
 #include <vespa/searchlib/queryeval/hitcollector.h>
+#include <vespa/searchlib/queryeval/idiversifier.h>
 
 #include <vespa/log/log.h>
 LOG_SETUP("hitcollector_test");
@@ -248,6 +249,36 @@ TEST_F("require that hits for 2nd phase candidates can be retrieved", Descending
     EXPECT_EQUAL(96, scores[4].second);
 }
 
+struct EvenDiversifier : IDiversifier {
+    size_t left;
+    std::vector<uint32_t> asked;
+    explicit EvenDiversifier(size_t max_accepted) : left(max_accepted), asked() {}
+    bool accepted(uint32_t docId) override {
+        asked.push_back(docId);
+        if ((left > 0) && ((docId % 2) == 0)) {
+            --left;
+            return true;
+        }
+        return false;
+    }
+};
+
+TEST_F("require that 2nd phase candidates can be diversified", DescendingScoreFixture)
+{
+    f.addHits();
+    EvenDiversifier diversifier(3);
+    std::vector<HitCollector::Hit> scores = extract(f.hc.getSortedHitSequence(8, diversifier));
+    EXPECT_TRUE(std::vector<uint32_t>({0, 1, 2, 3, 4, 5, 6, 7}) == diversifier.asked);
+    ASSERT_EQUAL(3u, scores.size());
+    EXPECT_EQUAL(0u, scores[0].first);
+    EXPECT_EQUAL(100, scores[0].second);
+    EXPECT_EQUAL(2u, scores[1].first);
+    EXPECT_EQUAL(98, scores[1].second);
+    EXPECT_EQUAL(4u, scores[2].first);
+    EXPECT_EQUAL(96, scores[2].second);
+    EXPECT_EQUAL(5u, extract(f.hc.getSortedHitSequence(5)).size());
+}
+
 TEST("require that score ranges can be read and set.") {
     std::pair<Scores, Scores> ranges = std::make_pair(Scores(1.0, 2.0), Scores(3.0, 4.0));
     HitCollector hc(20, 10);
@@ -527,4 +558,27 @@ TEST("require that hits can be added out of order only after passing array limit
     TEST_DO(checkResult(*rs, nullptr));
 }
 
+TEST("require that score threshold limits which hits replace ranked hits") {
+    HitCollector hc(10000, 10);
+    for (uint32_t i = 0; i < 10; ++i) {
+        hc.addHit(i, i);
+        EXPECT_EQUAL(-HUGE_VAL, hc.getLowestRankedScore());
+    }
+    hc.addHit(10, 10);
+    EXPECT_EQUAL(1.0, hc.getLowestRankedScore());
+    hc.setScoreThreshold(15);
+    for (uint32_t i = 11; i < 16; ++i) {
+        hc.addHit(i, i);
+    }
+    EXPECT_EQUAL(2.0, hc.getLowestRankedScore());
+    std::vector<RankedHit> expRh;
+    for (uint32_t i = 0; i < 16; ++i) {
+        expRh.emplace_back();
+        expRh.back()._docId = i;
+        expRh.back()._rankValue = ((i < 2) || ((i > 10) && (i < 15))) ? default_rank_value : i;
+    }
+    std::unique_ptr<ResultSet> rs = hc.getResultSet();
+    TEST_DO(checkResult(*rs, expRh));
+}
+
 TEST_MAIN() { TEST_RUN_ALL(); }
@@ -0,0 +1,47 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/searchlib/index/field_length_norm.h>
+#include <vespa/vespalib/gtest/gtest.h>
+
+namespace search::index {
+
+TEST(FieldLengthNormTest, small_field_lengths_are_exact)
+{
+    for (uint32_t len = 0; len < 32; ++len) {
+        EXPECT_EQ(len, FieldLengthNorm::decode(FieldLengthNorm::encode(len)));
+    }
+}
+
+TEST(FieldLengthNormTest, large_field_lengths_have_bounded_relative_error)
+{
+    for (uint32_t len = 32; len < 507904; len += (len / 7) + 1) {
+        uint32_t decoded = FieldLengthNorm::decode(FieldLengthNorm::encode(len));
+        EXPECT_LE(decoded, len);
+        EXPECT_LT((len - decoded) * 16, len);
+    }
+}
+
+TEST(FieldLengthNormTest, codes_are_monotonic)
+{
+    uint32_t prev_code = 0;
+    for (uint32_t len = 0; len < 1000000; ++len) {
+        uint32_t code = FieldLengthNorm::encode(len);
+        EXPECT_GE(code, prev_code);
+        prev_code = code;
+    }
+    for (uint32_t code = 1; code <= FieldLengthNorm::max_code; ++code) {
+        EXPECT_LT(FieldLengthNorm::decode(code - 1), FieldLengthNorm::decode(code));
+        EXPECT_EQ(code, FieldLengthNorm::encode(FieldLengthNorm::decode(code)));
+    }
+}
+
+TEST(FieldLengthNormTest, too_large_field_lengths_are_capped)
+{
+    EXPECT_EQ(FieldLengthNorm::max_code, FieldLengthNorm::encode(507904));
+    EXPECT_EQ(FieldLengthNorm::max_code, FieldLengthNorm::encode(10000000));
+    EXPECT_EQ(507904u, FieldLengthNorm::decode(FieldLengthNorm::max_code));
+}
+
+}
+
+GTEST_MAIN_RUN_ALL_TESTS()
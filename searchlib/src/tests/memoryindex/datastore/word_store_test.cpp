@@ -62,6 +62,24 @@ TEST(WordStoreTest, add_word_triggers_change_of_buffer)
     EXPECT_EQ(4u, lastId);
 }
 
+TEST(WordStoreTest, shared_word_store_stores_each_word_once)
+{
+    WordStore ws(true);
+    EXPECT_TRUE(ws.isShared());
+    EXPECT_FALSE(WordStore().isShared());
+    EntryRef r1 = ws.addWord("title");
+    EntryRef r2 = ws.addWord("body");
+    auto usage = ws.getMemoryUsage();
+    EXPECT_EQ(r1, ws.addWord("title"));
+    EXPECT_EQ(r2, ws.addWord("body"));
+    EXPECT_EQ(usage.usedBytes(), ws.getMemoryUsage().usedBytes());
+    EntryRef r3 = ws.addWord("titles");
+    EXPECT_NE(r1, r3);
+    EXPECT_EQ(std::string("title"), ws.getWord(r1));
+    EXPECT_EQ(std::string("body"), ws.getWord(r2));
+    EXPECT_EQ(std::string("titles"), ws.getWord(r3));
+}
+
 }
 
 GTEST_MAIN_RUN_ALL_TESTS()
@@ -1,5 +1,6 @@
 // Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 
+#include <vespa/searchlib/common/idestructorcallback.h>
 #include <vespa/searchlib/index/docbuilder.h>
 #include <vespa/searchlib/index/field_length_calculator.h>
 #include <vespa/searchlib/memoryindex/document_inverter.h>
@@ -9,6 +10,7 @@
 #include <vespa/searchlib/memoryindex/word_store.h>
 #include <vespa/searchlib/test/memoryindex/ordered_field_index_inserter.h>
 #include <vespa/vespalib/util/sequencedtaskexecutor.h>
+#include <vespa/vespalib/util/stringfmt.h>
 
 #include <vespa/vespalib/gtest/gtest.h>
 
@@ -300,6 +302,72 @@ TEST_F(DocumentInverterTest, require_that_empty_document_can_be_inverted)
               _inserter.toStr());
 }
 
+struct ShardedDocumentInverterTest : public ::testing::Test {
+    Schema _schema;
+    DocBuilder _b;
+    std::unique_ptr<ISequencedTaskExecutor> _invertThreads;
+    std::unique_ptr<ISequencedTaskExecutor> _pushThreads;
+    WordStore                       _word_store;
+    FieldIndexRemover               _remover;
+    test::OrderedFieldIndexInserter _inserter;
+    FieldLengthCalculator           _calculator;
+    MockFieldIndexCollection        _fic;
+    DocumentInverter                _inv;
+
+    static Schema makeSchema() {
+        Schema schema;
+        schema.addIndexField(Schema::IndexField("f0", DataType::STRING));
+        return schema;
+    }
+
+    ShardedDocumentInverterTest()
+        : _schema(makeSchema()),
+          _b(_schema),
+          _invertThreads(SequencedTaskExecutor::create(4)),
+          _pushThreads(SequencedTaskExecutor::create(2)),
+          _word_store(),
+          _remover(_word_store),
+          _inserter(),
+          _calculator(),
+          _fic(_remover, _inserter, _calculator),
+          _inv(_schema, *_invertThreads, *_pushThreads, _fic)
+    {
+    }
+
+    void invertDocument(uint32_t docId, const vespalib::string &w1, const vespalib::string &w2) {
+        _b.startDocument(vespalib::make_string("id:ns:searchdocument::%u", docId));
+        _b.startIndexField("f0").addStr(w1).addStr(w2).endField();
+        _inv.invertDocument(docId, *_b.endDocument());
+    }
+
+    void pushDocuments() {
+        _invertThreads->sync();
+        _inv.pushDocuments(std::shared_ptr<IDestructorCallback>());
+        _pushThreads->sync();
+    }
+};
+
+TEST_F(ShardedDocumentInverterTest, require_that_field_is_split_into_shards_when_there_are_spare_invert_threads)
+{
+    EXPECT_EQ(4u, DocumentInverter::numShards(4, 1));
+    EXPECT_EQ(2u, DocumentInverter::numShards(4, 2));
+    EXPECT_EQ(1u, DocumentInverter::numShards(2, 4));
+    EXPECT_EQ(8u, DocumentInverter::numShards(32, 1));
+}
+
+TEST_F(ShardedDocumentInverterTest, require_that_all_shards_are_pushed)
+{
+    invertDocument(10, "a", "b");
+    invertDocument(11, "a", "c");
+    invertDocument(14, "a", "d");
+    pushDocuments();
+    EXPECT_EQ("f=0,w=a,a=10,a=14,w=b,a=10,w=d,a=14,"
+              "f=0,w=a,a=11,w=c,a=11",
+              _inserter.toStr());
+    EXPECT_DOUBLE_EQ(2.0, _calculator.get_average_field_length());
+    EXPECT_EQ(3u, _calculator.get_num_samples());
+}
+
 }
 }
 
@@ -19,6 +19,7 @@
 #include <vespa/vespalib/btree/btreenodeallocator.hpp>
 #include <vespa/vespalib/btree/btreeroot.hpp>
 #include <vespa/vespalib/util/sequencedtaskexecutor.h>
+#include <vespa/vespalib/util/threadstackexecutor.h>
 
 #include <vespa/vespalib/gtest/gtest.h>
 
@@ -136,6 +137,56 @@ public:
     }
 };
 
+/**
+ * Builder handing out a separate builder per field, used to verify that
+ * fields dumped in parallel get the same contents.
+ */
+class MyParallelBuilder : public IndexBuilder {
+private:
+    class FieldBuilder : public IndexBuilder {
+        MyBuilder &_builder;
+    public:
+        FieldBuilder(const Schema &schema, MyBuilder &builder) : IndexBuilder(schema), _builder(builder) {}
+        void startWord(vespalib::stringref word) override { _builder.startWord(word); }
+        void endWord() override { _builder.endWord(); }
+        void startField(uint32_t fieldId) override { _builder.startField(fieldId); }
+        void endField() override { _builder.endField(); }
+        void add_document(const DocIdAndFeatures &features) override { _builder.add_document(features); }
+    };
+    std::vector<std::unique_ptr<MyBuilder>> _fieldBuilders;
+
+public:
+    MyParallelBuilder(const Schema &schema)
+        : IndexBuilder(schema),
+          _fieldBuilders()
+    {
+        for (uint32_t fieldId = 0; fieldId < schema.getNumIndexFields(); ++fieldId) {
+            _fieldBuilders.push_back(std::make_unique<MyBuilder>(schema));
+        }
+    }
+
+    void startWord(vespalib::stringref) override { abort(); }
+    void endWord() override { abort(); }
+    void startField(uint32_t) override { abort(); }
+    void endField() override { abort(); }
+    void add_document(const DocIdAndFeatures &) override { abort(); }
+
+    std::unique_ptr<IndexBuilder> startFieldBuilder(uint32_t fieldId) override {
+        return std::make_unique<FieldBuilder>(_schema, *_fieldBuilders[fieldId]);
+    }
+
+    std::string toStr() const {
+        std::string result;
+        for (const auto &fieldBuilder : _fieldBuilders) {
+            if (!result.empty()) {
+                result += ",";
+            }
+            result += fieldBuilder->toStr();
+        }
+        return result;
+    }
+};
+
 struct SimpleMatchData {
     TermFieldMatchData term;
     TermFieldMatchDataArray array;
@@ -695,6 +746,55 @@ TEST_F(FieldIndexInterleavedFeaturesTest, interleaved_features_are_capped)
     EXPECT_EQ(std::numeric_limits<uint16_t>::max(), entry.get_field_length());
 }
 
+struct FieldIndexFieldLengthNormsTest : public FieldIndexTest<FieldIndex<false>> {
+    SimpleMatchData match_data;
+    FieldIndexFieldLengthNormsTest()
+        : FieldIndexTest<FieldIndex<false>>()
+    {
+        WrapInserter(idx).word("a").add(10, getFeatures(5, 2)).add(11, getFeatures(1000, 3)).flush();
+    }
+    SearchIterator::UP search_with_norms(const vespalib::stringref word) {
+        return make_search_iterator<false>(idx.find(word), idx.getFeatureStore(), 0, match_data.array,
+                                           &idx.get_field_length_norms());
+    }
+};
+
+TEST_F(FieldIndexFieldLengthNormsTest, field_lengths_are_stored_per_document)
+{
+    const auto& norms = idx.get_field_length_norms();
+    EXPECT_EQ(5u, norms.get(10));
+    EXPECT_EQ(FieldLengthNorm::decode(FieldLengthNorm::encode(1000)), norms.get(11));
+    EXPECT_EQ(0u, norms.get(12));
+    EXPECT_EQ(0u, norms.get(1000000));
+}
+
+TEST_F(FieldIndexFieldLengthNormsTest, interleaved_features_are_unpacked_from_normal_features_and_norms)
+{
+    match_data.term.setNeedNormalFeatures(false);
+    match_data.term.setNeedInterleavedFeatures(true);
+    auto itr = search_with_norms("a");
+    itr->initFullRange();
+    EXPECT_EQ(10u, itr->getDocId());
+    itr->unpack(10);
+    EXPECT_EQ(2, match_data.term.getNumOccs());
+    EXPECT_EQ(5, match_data.term.getFieldLength());
+    EXPECT_TRUE(itr->seek(11));
+    itr->unpack(11);
+    EXPECT_EQ(3, match_data.term.getNumOccs());
+    EXPECT_EQ(FieldLengthNorm::decode(FieldLengthNorm::encode(1000)), match_data.term.getFieldLength());
+}
+
+TEST_F(FieldIndexFieldLengthNormsTest, interleaved_features_are_not_unpacked_without_norms)
+{
+    match_data.term.setNeedNormalFeatures(false);
+    match_data.term.setNeedInterleavedFeatures(true);
+    auto itr = search("a");
+    itr->initFullRange();
+    itr->unpack(10);
+    EXPECT_EQ(0, match_data.term.getNumOccs());
+    EXPECT_EQ(0, match_data.term.getFieldLength());
+}
+
 Schema
 make_multi_field_schema()
 {
@@ -735,6 +835,23 @@ TEST_F(FieldIndexCollectionTest, require_that_multiple_posting_lists_across_mult
     EXPECT_TRUE(assertPostingList("[]", find("c", 0)));
 }
 
+TEST(FieldIndexCollectionSharedWordStoreTest, require_that_fields_can_share_word_store)
+{
+    Schema schema(make_multi_field_schema());
+    FieldIndexCollection fic(schema, MockFieldLengthInspector(), true);
+    WrapInserter(fic, 0).word("a").add(10).word("b").add(11).add(15).flush();
+    WrapInserter(fic, 1).word("a").add(5).word("c").add(12).flush();
+    EXPECT_EQ(4u, fic.getNumUniqueWords());
+    const WordStore &wordStore = fic.getFieldIndex(0)->getWordStore();
+    EXPECT_TRUE(wordStore.isShared());
+    EXPECT_EQ(&wordStore, &fic.getFieldIndex(1)->getWordStore());
+    EXPECT_TRUE(assertPostingList("[10]", find_in_field_index<false>("a", 0, fic)));
+    EXPECT_TRUE(assertPostingList("[5]", find_in_field_index<false>("a", 1, fic)));
+    EXPECT_TRUE(assertPostingList("[11,15]", find_in_field_index<false>("b", 0, fic)));
+    EXPECT_TRUE(assertPostingList("[12]", find_in_field_index<false>("c", 1, fic)));
+    EXPECT_TRUE(assertPostingList("[]", find_in_field_index<false>("c", 0, fic)));
+}
+
 TEST_F(FieldIndexCollectionTest, require_that_multiple_insert_and_remove_works)
 {
     MyInserter inserter(schema);
@@ -844,6 +961,13 @@ TEST_F(FieldIndexCollectionTest, require_that_dumping_of_multiple_fields_to_inde
               "f=3[w=a[d=5[e=0,w=12,l=8[0],e=1,w=13,l=9[0,1]],"
               "d=7[e=0,w=14,l=10[0],e=1,w=15,l=11[0,1]]]]",
               b.toStr());
+    MyParallelBuilder pb(schema);
+    vespalib::ThreadStackExecutor executor(2, 128 * 1024);
+    fic.dump(pb, &executor);
+    EXPECT_EQ(b.toStr(), pb.toStr());
+    MyBuilder sb(schema);
+    fic.dump(sb, &executor);
+    EXPECT_EQ(b.toStr(), sb.toStr());
 }
 
 TEST_F(FieldIndexCollectionTest, require_that_dumping_words_with_no_docs_to_index_builder_is_working)
@@ -866,6 +990,16 @@ TEST_F(FieldIndexCollectionTest, require_that_dumping_words_with_no_docs_to_inde
         fic.dump(b);
         b.close();
     }
+    {
+        search::diskindex::IndexBuilder b(schema);
+        b.setPrefix("paralleldump");
+        TuneFileIndexing tuneFileIndexing;
+        DummyFileHeaderContext fileHeaderContext;
+        vespalib::ThreadStackExecutor executor(2, 128 * 1024);
+        b.open(5, 2, MockFieldLengthInspector(), tuneFileIndexing, fileHeaderContext);
+        fic.dump(b, &executor);
+        b.close();
+    }
 }
 
 
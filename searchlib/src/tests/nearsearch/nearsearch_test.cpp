@@ -116,6 +116,7 @@ public:
     int Main() override;
     void testBasicNear();
     void testRepeatedTerms();
+    void testTermWithoutPositions();
 };
 
 int
@@ -125,6 +126,7 @@ Test::Main()
 
     testBasicNear();     TEST_FLUSH();
     testRepeatedTerms(); TEST_FLUSH();
+    testTermWithoutPositions(); TEST_FLUSH();
 
     TEST_DONE();
 }
@@ -211,6 +213,21 @@ Test::testRepeatedTerms()
     }
 }
 
+void
+Test::testTermWithoutPositions()
+{
+    MyTerm foo(UIntList().add(69),
+               UIntList().add(6).add(11));
+    MyTerm bar(UIntList().add(69),
+               UIntList());
+    for (uint32_t i = 0; i <= 10; i += 5) {
+        TEST_DO(testNearSearch(MyQuery(false, i).addTerm(foo).addTerm(bar), 0));
+        TEST_DO(testNearSearch(MyQuery(false, i).addTerm(bar).addTerm(foo), 0));
+        TEST_DO(testNearSearch(MyQuery(true,  i).addTerm(foo).addTerm(bar), 0));
+        TEST_DO(testNearSearch(MyQuery(true,  i).addTerm(bar).addTerm(foo), 0));
+    }
+}
+
 bool
 Test::testNearSearch(MyQuery &query, uint32_t matchId)
 {
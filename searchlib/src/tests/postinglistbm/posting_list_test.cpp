@@ -1,5 +1,6 @@
 // Copyright 2019 Oath Inc. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 
+#include <vespa/searchlib/diskindex/zcpostingiterators.h>
 #include <vespa/searchlib/test/fakedata/fake_match_loop.h>
 #include <vespa/searchlib/test/fakedata/fakeposting.h>
 #include <vespa/searchlib/test/fakedata/fakeword.h>
@@ -7,8 +8,10 @@
 #include <vespa/searchlib/test/fakedata/fpfactory.h>
 #include <vespa/vespalib/util/rand48.h>
 #include <vespa/vespalib/gtest/gtest.h>
+#include <algorithm>
 #include <cinttypes>
 
+using search::diskindex::ZcPostingIteratorBase;
 using search::fef::TermFieldMatchData;
 using search::fef::TermFieldMatchDataArray;
 using search::queryeval::SearchIterator;
@@ -57,6 +60,135 @@ test_fake(const std::string& posting_type,
     validate_posting_list_for_word(*posting, word);
 }
 
+void
+validate_block_max_features_for_word(const std::string& posting_type,
+                                      const Schema& schema,
+                                      const FakeWord& word)
+{
+    std::unique_ptr<FPFactory> factory(getFPFactory(posting_type, schema));
+    std::vector<const FakeWord *> words;
+    words.push_back(&word);
+    factory->setup(words);
+    auto posting = factory->make(word);
+    TermFieldMatchData md;
+    TermFieldMatchDataArray tfmda;
+    tfmda.add(&md);
+    md.setNeedNormalFeatures(posting->enable_unpack_normal_features());
+    md.setNeedInterleavedFeatures(posting->enable_unpack_interleaved_features());
+    std::unique_ptr<SearchIterator> iterator(posting->createIterator(tfmda));
+    auto *zc_iterator = dynamic_cast<ZcPostingIteratorBase *>(iterator.get());
+    ASSERT_TRUE(zc_iterator != nullptr);
+    ASSERT_TRUE(zc_iterator->has_block_max_features());
+    iterator->initFullRange();
+    uint32_t block_last_doc_id = zc_iterator->get_block_last_doc_id();
+    uint32_t block_max_num_occs = zc_iterator->get_block_max_num_occs();
+    uint32_t block_min_field_length = zc_iterator->get_block_min_field_length();
+    uint32_t seen_max_num_occs = 0;
+    uint32_t seen_min_field_length = std::numeric_limits<uint32_t>::max();
+    uint32_t blocks = 0;
+    for (const auto &doc : word._postings) {
+        ASSERT_TRUE(iterator->seek(doc._docId));
+        if (doc._docId > block_last_doc_id) {
+            // The previous block has been passed, its bounds must have been exact
+            EXPECT_EQ(block_max_num_occs, seen_max_num_occs);
+            EXPECT_EQ(block_min_field_length, seen_min_field_length);
+            block_last_doc_id = zc_iterator->get_block_last_doc_id();
+            block_max_num_occs = zc_iterator->get_block_max_num_occs();
+            block_min_field_length = zc_iterator->get_block_min_field_length();
+            seen_max_num_occs = 0;
+            seen_min_field_length = std::numeric_limits<uint32_t>::max();
+            ++blocks;
+        }
+        EXPECT_LE(doc._docId, block_last_doc_id);
+        iterator->unpack(doc._docId);
+        EXPECT_LE(md.getNumOccs(), block_max_num_occs);
+        EXPECT_GE(md.getFieldLength(), block_min_field_length);
+        seen_max_num_occs = std::max(seen_max_num_occs, uint32_t(md.getNumOccs()));
+        seen_min_field_length = std::min(seen_min_field_length, uint32_t(md.getFieldLength()));
+    }
+    EXPECT_EQ(block_max_num_occs, seen_max_num_occs);
+    EXPECT_EQ(block_min_field_length, seen_min_field_length);
+    EXPECT_LT(1u, blocks);
+}
+
+void
+validate_docid_blocks_for_word(const std::string& posting_type,
+                               const Schema& schema,
+                               const FakeWord& word,
+                               uint32_t block_size)
+{
+    std::unique_ptr<FPFactory> factory(getFPFactory(posting_type, schema));
+    std::vector<const FakeWord *> words;
+    words.push_back(&word);
+    factory->setup(words);
+    auto posting = factory->make(word);
+    TermFieldMatchData md;
+    TermFieldMatchDataArray tfmda;
+    tfmda.add(&md);
+    md.setNeedNormalFeatures(posting->enable_unpack_normal_features());
+    md.setNeedInterleavedFeatures(posting->enable_unpack_interleaved_features());
+    std::unique_ptr<SearchIterator> iterator(posting->createIterator(tfmda));
+    iterator->initFullRange();
+    std::vector<uint32_t> expect;
+    for (const auto &doc : word._postings) {
+        expect.push_back(doc._docId);
+    }
+    std::vector<uint32_t> actual;
+    std::vector<uint32_t> block(block_size);
+    uint32_t begin_id = 1;
+    for (;;) {
+        uint32_t num_docids = iterator->fill_docid_block(begin_id, block.data(), block_size);
+        if (num_docids == 0) {
+            break;
+        }
+        actual.insert(actual.end(), block.begin(), block.begin() + num_docids);
+        begin_id = block[num_docids - 1] + 1;
+    }
+    EXPECT_EQ(expect, actual) << posting_type << ", block size " << block_size;
+}
+
+uint32_t
+count_common_docs(const FakeWord& word1, const FakeWord& word2)
+{
+    std::vector<uint32_t> docs1;
+    for (const auto &doc : word1._postings) {
+        docs1.push_back(doc._docId);
+    }
+    uint32_t common = 0;
+    for (const auto &doc : word2._postings) {
+        if (std::binary_search(docs1.begin(), docs1.end(), doc._docId)) {
+            ++common;
+        }
+    }
+    return common;
+}
+
+void
+validate_match_loops_for_words(const std::string& posting_type,
+                               const Schema& schema,
+                               const FakeWord& word1,
+                               const FakeWord& word2,
+                               uint32_t doc_id_limit)
+{
+    std::unique_ptr<FPFactory> factory(getFPFactory(posting_type, schema));
+    std::vector<const FakeWord *> words;
+    words.push_back(&word1);
+    words.push_back(&word2);
+    factory->setup(words);
+    auto posting1 = factory->make(word1);
+    auto posting2 = factory->make(word2);
+    int common = count_common_docs(word1, word2);
+    int all = word1._postings.size() + word2._postings.size() - common;
+    EXPECT_EQ(common, FakeMatchLoop::and_pair_posting_scan(*posting1, *posting2, doc_id_limit)) << posting_type;
+    EXPECT_EQ(all, FakeMatchLoop::or_pair_posting_scan(*posting1, *posting2, doc_id_limit)) << posting_type;
+    int weak_and_hits = FakeMatchLoop::weak_and_pair_posting_scan_with_unpack(*posting1, *posting2, doc_id_limit);
+    EXPECT_LE(common, weak_and_hits) << posting_type;
+    EXPECT_GE(all, weak_and_hits) << posting_type;
+    if (posting1->hasWordPositions() && posting1->enable_unpack_normal_features()) {
+        EXPECT_GE(common, FakeMatchLoop::phrase_pair_posting_scan_with_unpack(*posting1, *posting2, doc_id_limit)) << posting_type;
+    }
+}
+
 struct PostingListTest : public ::testing::Test {
     uint32_t num_docs;
     std::vector<std::string> posting_types;
@@ -139,4 +271,35 @@ TEST_F(PostingListTest, verify_posting_list_iterators_over_weighted_set_field)
     run();
 }
 
+TEST_F(PostingListTest, block_max_features_bound_interleaved_features_in_skip_blocks)
+{
+    setup(true, false);
+    for (const auto& type : {"Zc4SkipPosOccBE.cf", "Zc4SkipPosOccLE.cf"}) {
+        validate_block_max_features_for_word(type, word_set.getSchema(), *word2);
+        validate_block_max_features_for_word(type, word_set.getSchema(), *word3);
+        validate_block_max_features_for_word(type, word_set.getSchema(), *word4);
+    }
+}
+
+TEST_F(PostingListTest, docid_blocks_contain_all_documents)
+{
+    setup(true, false);
+    for (const auto& type : posting_types) {
+        for (uint32_t block_size : {1u, 7u, 128u}) {
+            validate_docid_blocks_for_word(type, word_set.getSchema(), *word1, block_size);
+            validate_docid_blocks_for_word(type, word_set.getSchema(), *word3, block_size);
+            validate_docid_blocks_for_word(type, word_set.getSchema(), *word4, block_size);
+        }
+    }
+}
+
+TEST_F(PostingListTest, match_loops_over_posting_list_pairs)
+{
+    setup(false, false);
+    for (const auto& type : posting_types) {
+        validate_match_loops_for_words(type, word_set.getSchema(), *word4, *word5, num_docs);
+        validate_match_loops_for_words(type, word_set.getSchema(), *word1, *word3, num_docs);
+    }
+}
+
 GTEST_MAIN_RUN_ALL_TESTS()
@@ -33,6 +33,8 @@ private:
     uint32_t _mediumDocFreq;
     uint32_t _rareDocFreq;
     uint32_t _numWordsPerClass;
+    double _zipfExponent;
+    uint32_t _numZipfWords;
     std::vector<std::string> _postingTypes;
     StressRunner::OperatorType _operatorType;
     uint32_t _loops;
@@ -63,9 +65,11 @@ usage()
            "[-l <numLoops>] "
            "[-s <stride>] "
            "[-t <postingType>] "
-           "[-o {direct, and, or}] "
+           "[-o {direct, and, or, weakand, phrase}] "
            "[-u] "
-           "[-w <numWordsPerClass>]\n");
+           "[-w <numWordsPerClass>] "
+           "[-z <zipfExponent>] "
+           "[-Z <numZipfWords>]\n");
 }
 
 void
@@ -92,6 +96,8 @@ PostingListBM::PostingListBM()
       _mediumDocFreq(1000),
       _rareDocFreq(10),
       _numWordsPerClass(100),
+      _zipfExponent(0.0),
+      _numZipfWords(1000),
       _postingTypes(),
       _operatorType(StressRunner::OperatorType::And),
       _loops(1),
@@ -116,7 +122,7 @@ PostingListBM::Main()
     bool hasElements = false;
     bool hasElementWeights = false;
 
-    while ((c = GetOpt("C:c:m:r:d:l:s:t:o:uw:T:q", optArg, argi)) != -1) {
+    while ((c = GetOpt("C:c:m:r:d:l:s:t:o:uw:z:Z:T:q", optArg, argi)) != -1) {
         switch(c) {
         case 'C':
             _skipCommonPairsRate = atoi(optArg);
@@ -179,9 +185,13 @@ PostingListBM::Main()
                _operatorType = StressRunner::OperatorType::And;
            } else if (operatorType == "or") {
                _operatorType = StressRunner::OperatorType::Or;
+           } else if (operatorType == "weakand") {
+               _operatorType = StressRunner::OperatorType::WeakAnd;
+           } else if (operatorType == "phrase") {
+               _operatorType = StressRunner::OperatorType::Phrase;
            } else {
                printf("Bad operator type: '%s'\n", operatorType.c_str());
-               printf("Supported types: direct, and, or\n");
+               printf("Supported types: direct, and, or, weakand, phrase\n");
                return 1;
            }
            break;
@@ -192,6 +202,12 @@ PostingListBM::Main()
         case 'w':
             _numWordsPerClass = atoi(optArg);
             break;
+        case 'z':
+            _zipfExponent = atof(optArg);
+            break;
+        case 'Z':
+            _numZipfWords = atoi(optArg);
+            break;
         default:
             usage();
             return 1;
@@ -211,7 +227,13 @@ PostingListBM::Main()
         _postingTypes = getPostingTypes();
     }
 
-    _wordSet.setupWords(_rnd, _numDocs, _commonDocFreq, _mediumDocFreq, _rareDocFreq, _numWordsPerClass);
+    if (_zipfExponent > 0.0) {
+        // the most frequent word gets commonDocFreq documents
+        _wordSet.setupZipfianWords(_rnd, _numDocs, _commonDocFreq, _mediumDocFreq, _rareDocFreq,
+                                   _zipfExponent, _numZipfWords);
+    } else {
+        _wordSet.setupWords(_rnd, _numDocs, _commonDocFreq, _mediumDocFreq, _rareDocFreq, _numWordsPerClass);
+    }
 
     StressRunner::run(_rnd,
                       _wordSet,
@@ -128,6 +128,22 @@ public:
     OrStressWorker(StressMaster& master, uint32_t id);
 };
 
+class WeakAndStressWorker : public StressWorker {
+private:
+    void run_task(const FakePosting& f1, const FakePosting& f2, uint32_t doc_id_limit, bool unpack) override;
+
+public:
+    WeakAndStressWorker(StressMaster& master, uint32_t id);
+};
+
+class PhraseStressWorker : public StressWorker {
+private:
+    void run_task(const FakePosting& f1, const FakePosting& f2, uint32_t doc_id_limit, bool unpack) override;
+
+public:
+    PhraseStressWorker(StressMaster& master, uint32_t id);
+};
+
 
 StressMaster::StressMaster(vespalib::Rand48 &rnd,
                            FakeWordSet &wordSet,
@@ -256,14 +272,25 @@ StressMaster::setupTasks(uint32_t numTasks)
     uint32_t word1idx;
     uint32_t word2idx;
 
+    // a zipfian word set might leave some word classes empty
+    std::vector<uint32_t> wordclasses;
+    for (uint32_t i = 0; i < _postings.size(); ++i) {
+        if (!_postings[i].empty()) {
+            wordclasses.push_back(i);
+        }
+    }
+    if (wordclasses.empty()) {
+        return;
+    }
     for (uint32_t i = 0; i < numTasks; ++i) {
-        wordclass1 = _rnd.lrand48() % _postings.size();
-        wordclass2 = _rnd.lrand48() % _postings.size();
+        wordclass1 = wordclasses[_rnd.lrand48() % wordclasses.size()];
+        wordclass2 = wordclasses[_rnd.lrand48() % wordclasses.size()];
         while (wordclass1 == FakeWordSet::COMMON_WORD &&
                wordclass2 == FakeWordSet::COMMON_WORD &&
+               wordclasses.size() > 1 &&
                (_rnd.lrand48() % _skipCommonPairsRate) != 0) {
-            wordclass1 = _rnd.lrand48() % _postings.size();
-            wordclass2 = _rnd.lrand48() % _postings.size();
+            wordclass1 = wordclasses[_rnd.lrand48() % wordclasses.size()];
+            wordclass2 = wordclasses[_rnd.lrand48() % wordclasses.size()];
         }
         word1idx = _rnd.lrand48() % _postings[wordclass1].size();
         word2idx = _rnd.lrand48() % _postings[wordclass2].size();
@@ -324,6 +351,10 @@ StressMaster::runWorkers(const std::string &postingFormat)
             _workers.push_back(std::make_unique<AndStressWorker>(*this, i));
         } else if (_operatorType == StressRunner::OperatorType::Or) {
             _workers.push_back(std::make_unique<OrStressWorker>(*this, i));
+        } else if (_operatorType == StressRunner::OperatorType::WeakAnd) {
+            _workers.push_back(std::make_unique<WeakAndStressWorker>(*this, i));
+        } else if (_operatorType == StressRunner::OperatorType::Phrase) {
+            _workers.push_back(std::make_unique<PhraseStressWorker>(*this, i));
         }
     }
 
@@ -419,6 +450,40 @@ OrStressWorker::run_task(const FakePosting& f1, const FakePosting& f2, uint32_t
     }
 }
 
+WeakAndStressWorker::WeakAndStressWorker(StressMaster& master, uint32_t id)
+    : StressWorker(master, id)
+{
+}
+
+void
+WeakAndStressWorker::run_task(const FakePosting& f1, const FakePosting& f2, uint32_t doc_id_limit, bool unpack)
+{
+    if (unpack) {
+        FakeMatchLoop::weak_and_pair_posting_scan_with_unpack(f1, f2, doc_id_limit);
+    } else {
+        FakeMatchLoop::weak_and_pair_posting_scan(f1, f2, doc_id_limit);
+    }
+}
+
+PhraseStressWorker::PhraseStressWorker(StressMaster& master, uint32_t id)
+    : StressWorker(master, id)
+{
+}
+
+void
+PhraseStressWorker::run_task(const FakePosting& f1, const FakePosting& f2, uint32_t doc_id_limit, bool unpack)
+{
+    if (!f1.hasWordPositions() || !f1.enable_unpack_normal_features() ||
+        !f2.hasWordPositions() || !f2.enable_unpack_normal_features()) {
+        // posting format without positions, fall back to plain intersection
+        FakeMatchLoop::and_pair_posting_scan(f1, f2, doc_id_limit);
+    } else if (unpack) {
+        FakeMatchLoop::phrase_pair_posting_scan_with_unpack(f1, f2, doc_id_limit);
+    } else {
+        FakeMatchLoop::phrase_pair_posting_scan(f1, f2, doc_id_limit);
+    }
+}
+
 void
 StressRunner::run(vespalib::Rand48 &rnd,
                   FakeWordSet &wordSet,
@@ -15,7 +15,9 @@ public:
     enum class OperatorType {
         Direct,
         And,
-        Or
+        Or,
+        WeakAnd,
+        Phrase
     };
 
     static void run(vespalib::Rand48 &rnd,
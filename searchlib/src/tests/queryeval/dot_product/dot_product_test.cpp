@@ -215,10 +215,13 @@ private:
 };
 
 class WeightIteratorChildrenVerifier : public search::test::DwaIteratorChildrenVerifier {
+public:
+    WeightIteratorChildrenVerifier(bool use_flat_merge) : _use_flat_merge(use_flat_merge) {}
 private:
     SearchIterator::UP create(std::vector<DocumentWeightIterator> && children) const override {
-        return SearchIterator::UP(DotProductSearch::create(_tfmd, _weights, std::move(children)));
+        return SearchIterator::UP(DotProductSearch::create(_tfmd, _weights, std::move(children), _use_flat_merge));
     }
+    bool _use_flat_merge;
 };
 
 TEST("verify search iterator conformance with search iterator children") {
@@ -227,8 +230,45 @@ TEST("verify search iterator conformance with search iterator children") {
 }
 
 TEST("verify search iterator conformance with document weight iterator children") {
-    WeightIteratorChildrenVerifier verifier;
+    WeightIteratorChildrenVerifier verifier(false);
     verifier.verify();
 }
 
+TEST("verify search iterator conformance with document weight iterator children using flat merge") {
+    WeightIteratorChildrenVerifier verifier(true);
+    verifier.verify();
+}
+
+std::vector<std::pair<uint32_t, feature_t>>
+score_all(const DocumentWeightAttributeHelper &helper, bool use_flat_merge, uint32_t num_children, uint32_t doc_id_limit) {
+    std::vector<DocumentWeightIterator> children;
+    std::vector<int32_t> weights;
+    for (uint32_t i = 0; i < num_children; ++i) {
+        auto dict_entry = helper.dwa().lookup(vespalib::make_string("%u", i).c_str(), helper.dwa().get_dictionary_snapshot());
+        helper.dwa().create(dict_entry.posting_idx, children);
+        weights.push_back(i + 1);
+    }
+    TermFieldMatchData tfmd;
+    auto search = DotProductSearch::create(tfmd, weights, std::move(children), use_flat_merge);
+    std::vector<std::pair<uint32_t, feature_t>> hits;
+    search->initRange(1, doc_id_limit);
+    for (uint32_t docid = search->seekFirst(1); docid < doc_id_limit; docid = search->seekNext(docid + 1)) {
+        search->unpack(docid);
+        hits.emplace_back(docid, tfmd.getRawScore());
+    }
+    return hits;
+}
+
+TEST("require that flat merge gives the same hits and scores as heap merge") {
+    DocumentWeightAttributeHelper helper;
+    helper.add_docs(5000);
+    for (uint32_t docid = 1; docid < 5000; ++docid) {
+        helper.set_doc(docid, docid % 300, docid);
+    }
+    auto heap_hits = score_all(helper, false, 300, 5000);
+    auto flat_hits = score_all(helper, true, 300, 5000);
+    EXPECT_EQUAL(4999u, heap_hits.size());
+    EXPECT_TRUE(heap_hits == flat_hits);
+}
+
 TEST_MAIN() { TEST_RUN_ALL(); }
@@ -0,0 +1,204 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/vespalib/gtest/gtest.h>
+#include <vespa/searchlib/queryeval/andsearch.h>
+#include <vespa/searchlib/queryeval/galloping_and_search.h>
+#include <vespa/searchlib/queryeval/simplesearch.h>
+#include <vespa/searchlib/queryeval/unpackinfo.h>
+#define ENABLE_GTEST_MIGRATION
+#include <vespa/searchlib/test/searchiteratorverifier.h>
+#include <algorithm>
+#include <random>
+#include <set>
+
+using namespace search::queryeval;
+using vespalib::Trinary;
+
+namespace {
+
+using DocIds = std::vector<uint32_t>;
+
+/**
+ * Strict search over a fixed list of docids that claims fast docid
+ * blocks, to mimic posting list iterators.
+ */
+class BlockSearch : public SearchIterator
+{
+    DocIds _docids;
+    size_t _pos;
+public:
+    explicit BlockSearch(DocIds docids) : _docids(std::move(docids)), _pos(0) {}
+    void initRange(uint32_t begin_id, uint32_t end_id) override {
+        SearchIterator::initRange(begin_id, end_id);
+        _pos = std::lower_bound(_docids.begin(), _docids.end(), begin_id) - _docids.begin();
+    }
+    void doSeek(uint32_t docid) override {
+        while ((_pos < _docids.size()) && (_docids[_pos] < docid)) {
+            ++_pos;
+        }
+        if (_pos < _docids.size()) {
+            setDocId(_docids[_pos]);
+        } else {
+            setAtEnd();
+        }
+    }
+    void doUnpack(uint32_t docid) override { (void) docid; }
+    bool has_fast_docid_block() const override { return true; }
+    Trinary is_strict() const override { return Trinary::True; }
+};
+
+DocIds
+make_docids(uint32_t docid_limit, double density, uint32_t seed)
+{
+    std::mt19937 rnd(seed);
+    std::uniform_real_distribution<double> dist(0.0, 1.0);
+    DocIds docids;
+    for (uint32_t docid = 1; docid < docid_limit; ++docid) {
+        if (dist(rnd) < density) {
+            docids.push_back(docid);
+        }
+    }
+    return docids;
+}
+
+MultiSearch::Children
+make_children(const std::vector<DocIds> &inputs)
+{
+    MultiSearch::Children children;
+    for (const auto &docids : inputs) {
+        children.push_back(std::make_unique<BlockSearch>(docids));
+    }
+    return children;
+}
+
+DocIds
+intersect(const std::vector<DocIds> &inputs, uint32_t begin_id, uint32_t end_id)
+{
+    DocIds result;
+    for (uint32_t docid : inputs[0]) {
+        if ((docid < begin_id) || (docid >= end_id)) {
+            continue;
+        }
+        bool all = std::all_of(inputs.begin() + 1, inputs.end(), [docid](const DocIds &docids)
+                               { return std::binary_search(docids.begin(), docids.end(), docid); });
+        if (all) {
+            result.push_back(docid);
+        }
+    }
+    return result;
+}
+
+DocIds
+search_strict(SearchIterator &search, uint32_t begin_id, uint32_t end_id)
+{
+    DocIds result;
+    search.initRange(begin_id, end_id);
+    for (search.seek(begin_id); !search.isAtEnd(); search.seek(search.getDocId() + 1)) {
+        result.push_back(search.getDocId());
+    }
+    return result;
+}
+
+DocIds
+search_non_strict(SearchIterator &search, uint32_t begin_id, uint32_t end_id)
+{
+    DocIds result;
+    search.initRange(begin_id, end_id);
+    for (uint32_t docid = begin_id; !search.isAtEnd(docid); ++docid) {
+        if (search.seek(docid)) {
+            result.push_back(docid);
+        }
+    }
+    return result;
+}
+
+}
+
+TEST(GallopingAndSearchTest, gives_same_hits_as_plain_intersection_across_many_blocks)
+{
+    constexpr uint32_t docid_limit = 100000;
+    std::vector<DocIds> inputs;
+    inputs.push_back(make_docids(docid_limit, 0.1, 1));
+    inputs.push_back(make_docids(docid_limit, 0.5, 2));
+    inputs.push_back(make_docids(docid_limit, 0.3, 3));
+    auto expect = intersect(inputs, 1, docid_limit);
+    EXPECT_GT(expect.size(), GallopingAndSearch::block_size);
+
+    GallopingAndSearch search(make_children(inputs));
+    EXPECT_EQ(expect, search_strict(search, 1, docid_limit));
+    EXPECT_EQ(expect, search_non_strict(search, 1, docid_limit));
+}
+
+TEST(GallopingAndSearchTest, respects_sub_ranges)
+{
+    constexpr uint32_t docid_limit = 20000;
+    std::vector<DocIds> inputs;
+    inputs.push_back(make_docids(docid_limit, 0.4, 4));
+    inputs.push_back(make_docids(docid_limit, 0.6, 5));
+    GallopingAndSearch search(make_children(inputs));
+    for (uint32_t begin : {1u, 777u, 10000u}) {
+        uint32_t end = begin + 5000;
+        EXPECT_EQ(intersect(inputs, begin, end), search_strict(search, begin, end));
+    }
+}
+
+TEST(GallopingAndSearchTest, optimize_steals_block_children_of_strict_and)
+{
+    auto children = make_children({{3, 5, 7}, {5, 7, 9}});
+    children.push_back(std::make_unique<SimpleSearch>(SimpleResult().addHit(5)));
+    UnpackInfo unpack_info;
+    SearchIterator::UP search = AndSearch::create(std::move(children), true, unpack_info);
+    search = GallopingAndSearch::optimize(std::move(search));
+    auto &and_search = dynamic_cast<MultiSearch &>(*search);
+    ASSERT_EQ(2u, and_search.getChildren().size());
+    auto *galloping = dynamic_cast<GallopingAndSearch *>(and_search.getChildren()[0].get());
+    ASSERT_TRUE(galloping != nullptr);
+    EXPECT_EQ(2u, galloping->getChildren().size());
+    EXPECT_EQ(DocIds({5}), search_strict(*search, 1, 10));
+}
+
+TEST(GallopingAndSearchTest, optimize_replaces_and_when_all_children_are_stolen)
+{
+    SearchIterator::UP search = AndSearch::create(make_children({{3, 5}, {5, 7}}), true, UnpackInfo());
+    search = GallopingAndSearch::optimize(std::move(search));
+    EXPECT_TRUE(dynamic_cast<GallopingAndSearch *>(search.get()) != nullptr);
+}
+
+TEST(GallopingAndSearchTest, optimize_keeps_children_needing_unpack_and_non_strict_and)
+{
+    std::vector<DocIds> inputs({{3, 5}, {5, 7}, {5, 9}});
+    UnpackInfo unpack_info;
+    unpack_info.add(1);
+    SearchIterator::UP search = AndSearch::create(make_children(inputs), true, unpack_info);
+    search = GallopingAndSearch::optimize(std::move(search));
+    auto &and_search = dynamic_cast<MultiSearch &>(*search);
+    ASSERT_EQ(2u, and_search.getChildren().size());
+    EXPECT_TRUE(dynamic_cast<GallopingAndSearch *>(and_search.getChildren()[0].get()) != nullptr);
+    EXPECT_TRUE(dynamic_cast<BlockSearch *>(and_search.getChildren()[1].get()) != nullptr);
+
+    search = GallopingAndSearch::optimize(AndSearch::create(make_children(inputs), false, UnpackInfo()));
+    EXPECT_EQ(3u, dynamic_cast<MultiSearch &>(*search).getChildren().size());
+}
+
+class Verifier : public search::test::SearchIteratorVerifier {
+public:
+    SearchIterator::UP create(bool strict) const override {
+        (void) strict;
+        std::set<uint32_t> superset;
+        for (uint32_t docid : getExpectedDocIds()) {
+            superset.insert(docid);
+            if (docid + 1 < getDocIdLimit()) {
+                superset.insert(docid + 1);
+            }
+        }
+        return std::make_unique<GallopingAndSearch>(make_children({getExpectedDocIds(), DocIds(superset.begin(), superset.end())}));
+    }
+};
+
+TEST(GallopingAndSearchTest, iterator_conformance)
+{
+    Verifier verifier;
+    verifier.verify();
+}
+
+GTEST_MAIN_RUN_ALL_TESTS()
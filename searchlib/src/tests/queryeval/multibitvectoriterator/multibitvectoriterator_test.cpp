@@ -10,6 +10,7 @@
 #include <vespa/searchlib/fef/termfieldmatchdata.h>
 #include <vespa/searchlib/fef/termfieldmatchdataarray.h>
 #include <vespa/searchlib/test/searchiteratorverifier.h>
+#include <vespa/vespalib/test/insertion_operators.h>
 #include <random>
 
 #include <vespa/log/log.h>
@@ -33,6 +34,9 @@ public:
     void testOr();
     void testAndWith(bool invert);
     void testEndGuard(bool invert);
+    template <typename T>
+    void testTermwiseHits(bool invert);
+    void testSkipEmptyRegions();
     void testIteratorConformance();
     void testUnpackOfOr();
     template<typename T>
@@ -562,6 +566,73 @@ Test::testOptimizeAndOr(bool invert)
     }
 }
 
+H
+toHits(const BitVector & bv)
+{
+    H h;
+    bv.foreach_truebit([&h](uint32_t docId) { h.push_back(docId); });
+    return h;
+}
+
+template <typename T>
+void
+Test::testTermwiseHits(bool invert)
+{
+    TermFieldMatchData tfmd;
+    MultiSearch::Children children;
+    for (size_t i(0); i < 3; i++) {
+        children.push_back(createIter(i, invert, tfmd, false));
+    }
+    SearchIterator::UP s = T::create(std::move(children), false);
+    s = MultiBitVectorIteratorBase::optimize(std::move(s));
+    EXPECT_TRUE(dynamic_cast<const MultiBitVectorIteratorBase *>(s.get()) != nullptr);
+    uint32_t docIdLimit = _bvs[0]->size();
+    s->initRange(1, docIdLimit);
+    H expected = seekNoReset(*s, 1, docIdLimit);
+    EXPECT_LESS(0u, expected.size());
+
+    s->initRange(1, docIdLimit);
+    EXPECT_EQUAL(expected, toHits(*s->get_hits(1)));
+
+    s->initRange(1, docIdLimit);
+    BitVector::UP result = BitVector::create(1, docIdLimit);
+    s->or_hits_into(*result, 1);
+    EXPECT_EQUAL(expected, toHits(*result));
+
+    s->initRange(1, docIdLimit);
+    result = BitVector::create(1, docIdLimit);
+    result->setInterval(1, docIdLimit);
+    s->and_hits_into(*result, 1);
+    EXPECT_EQUAL(expected, toHits(*result));
+}
+
+void
+Test::testSkipEmptyRegions()
+{
+    uint32_t docIdLimit = 100000;
+    BitVector::UP sparse = BitVector::create(docIdLimit);
+    BitVector::UP dense = BitVector::create(docIdLimit);
+    dense->setInterval(1, docIdLimit);
+    dense->clearBit(70001);
+    H expected;
+    for (uint32_t docId : {3u, 511u, 512u, 20000u, 70001u, 70002u, 99999u}) {
+        sparse->setBit(docId);
+        if (docId != 70001u) {
+            expected.push_back(docId);
+        }
+    }
+    for (bool strict : {false, true}) {
+        TermFieldMatchData tfmd;
+        MultiSearch::Children children;
+        children.push_back(BitVectorIterator::create(sparse.get(), tfmd, strict));
+        children.push_back(BitVectorIterator::create(dense.get(), tfmd, strict));
+        SearchIterator::UP s = AndSearch::create(std::move(children), strict);
+        s = MultiBitVectorIteratorBase::optimize(std::move(s));
+        EXPECT_TRUE(dynamic_cast<const MultiBitVectorIteratorBase *>(s.get()) != nullptr);
+        EXPECT_EQUAL(expected, seek(*s, docIdLimit));
+    }
+}
+
 void
 Test::testEndGuard(bool invert)
 {
@@ -661,6 +732,13 @@ Test::Main()
     TEST_FLUSH();
     testIteratorConformance();
     TEST_FLUSH();
+    for (bool invert : {false, true}) {
+        testTermwiseHits<AndSearch>(invert);
+        testTermwiseHits<OrSearch>(invert);
+    }
+    TEST_FLUSH();
+    testSkipEmptyRegions();
+    TEST_FLUSH();
     TEST_DONE();
 }
 
@@ -204,6 +204,29 @@ TEST("require that NearestNeighborIterator returns filtered results") {
     TEST_DO(verify_iterator_returns_filtered_results(denseSpecFloat, denseSpecFloat));
 }
 
+TEST("require that strict NearestNeighborIterator gives same results as non-strict across many blocks") {
+    for (const auto &spec : {denseSpecDouble, denseSpecFloat}) {
+        Fixture fixture(spec);
+        uint32_t num_docs = 200;
+        fixture.ensureSpace(num_docs);
+        std::vector<uint32_t> filter_docs;
+        for (uint32_t docid = 1; docid <= num_docs; ++docid) {
+            fixture.setTensor(docid, double(docid % 17), double(docid % 11));
+            if ((docid % 3) != 0) {
+                filter_docs.push_back(docid);
+            }
+        }
+        auto qtv = createTensor(spec, 7.0, 5.0);
+        SimpleResult strict_result = find_matches<true>(fixture, *qtv);
+        SimpleResult result = find_matches<false>(fixture, *qtv);
+        EXPECT_EQUAL(strict_result, result);
+        fixture.setFilter(filter_docs);
+        strict_result = find_matches<true>(fixture, *qtv);
+        result = find_matches<false>(fixture, *qtv);
+        EXPECT_EQUAL(strict_result, result);
+    }
+}
+
 template <bool strict>
 std::vector<feature_t> get_rawscores(Fixture &env, const DenseTensorView &qtv) {
     auto md = MatchData::makeTestInstance(2, 2);
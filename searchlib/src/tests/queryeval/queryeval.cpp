@@ -21,6 +21,7 @@
 #include <vespa/searchlib/queryeval/isourceselector.h>
 #include <vespa/searchlib/fef/fef.h>
 #include <vespa/vespalib/data/slime/slime.h>
+#include <vespa/vespalib/util/stash.h>
 
 #include <vespa/log/log.h>
 LOG_SETUP("query_eval_test");
@@ -842,5 +843,144 @@ TEST("Test andnotsearchstrict iterators adheres to initRange") {
                                               ir.createIterator(inverted, false) }, true)));
 }
 
+SimpleResult every_nth(uint32_t n, uint32_t docid_limit) {
+    SimpleResult result;
+    for (uint32_t docid = n; docid < docid_limit; docid += n) {
+        result.addHit(docid);
+    }
+    return result;
+}
+
+SimpleResult expected_and(const SimpleResult &a, const SimpleResult &b, uint32_t docid_limit) {
+    MultiSearch::Children children;
+    children.emplace_back(new SimpleSearch(a));
+    children.emplace_back(new SimpleSearch(b));
+    auto search = AndSearch::create(std::move(children), false);
+    SimpleResult result;
+    result.search(*search, docid_limit);
+    return result;
+}
+
+TEST("require that adaptive reorder moves the most rejecting children of AND first") {
+    constexpr uint32_t docid_limit = 1000;
+    for (bool strict : {false, true}) {
+        MultiSearch::Children children;
+        children.emplace_back(new SimpleSearch(every_nth(1, docid_limit)));
+        children.emplace_back(new SimpleSearch(every_nth(2, docid_limit)));
+        children.emplace_back(new SimpleSearch(every_nth(7, docid_limit)));
+        std::vector<const SearchIterator *> child_ptrs;
+        for (const auto &child : children) {
+            child_ptrs.push_back(child.get());
+        }
+        SearchIterator::UP search = MultiSearch::enable_adaptive_reorder(AndSearch::create(std::move(children), strict), 50);
+        SimpleResult result;
+        if (strict) {
+            result.search(*search);
+        } else {
+            result.search(*search, docid_limit);
+        }
+        EXPECT_EQUAL(expected_and(every_nth(2, docid_limit), every_nth(7, docid_limit), docid_limit), result);
+        const auto &reordered = dynamic_cast<MultiSearch &>(*search).getChildren();
+        if (strict) {
+            EXPECT_EQUAL(child_ptrs[0], reordered[0].get());
+            EXPECT_EQUAL(child_ptrs[2], reordered[1].get());
+            EXPECT_EQUAL(child_ptrs[1], reordered[2].get());
+        } else {
+            EXPECT_EQUAL(child_ptrs[2], reordered[0].get());
+            EXPECT_EQUAL(child_ptrs[1], reordered[1].get());
+            EXPECT_EQUAL(child_ptrs[0], reordered[2].get());
+        }
+        std::string dump = search->asString();
+        expect_match(dump, "child_seeks");
+        expect_match(dump, "child_rejects");
+        expect_match(dump, "reordered: true");
+    }
+}
+
+TEST("require that adaptive reorder moves the most matching negative children of ANDNOT first") {
+    constexpr uint32_t docid_limit = 1000;
+    for (bool strict : {false, true}) {
+        MultiSearch::Children children;
+        children.emplace_back(new SimpleSearch(every_nth(1, docid_limit)));
+        children.emplace_back(new SimpleSearch(every_nth(7, docid_limit)));
+        children.emplace_back(new SimpleSearch(every_nth(2, docid_limit)));
+        std::vector<const SearchIterator *> child_ptrs;
+        for (const auto &child : children) {
+            child_ptrs.push_back(child.get());
+        }
+        SearchIterator::UP search = MultiSearch::enable_adaptive_reorder(AndNotSearch::create(std::move(children), strict), 50);
+        SimpleResult result;
+        if (strict) {
+            result.search(*search);
+        } else {
+            result.search(*search, docid_limit);
+        }
+        SimpleResult expect;
+        for (uint32_t docid = 1; docid < docid_limit; ++docid) {
+            if ((docid % 7 != 0) && (docid % 2 != 0)) {
+                expect.addHit(docid);
+            }
+        }
+        EXPECT_EQUAL(expect, result);
+        const auto &reordered = dynamic_cast<MultiSearch &>(*search).getChildren();
+        EXPECT_EQUAL(child_ptrs[0], reordered[0].get());
+        EXPECT_EQUAL(child_ptrs[2], reordered[1].get());
+        EXPECT_EQUAL(child_ptrs[1], reordered[2].get());
+    }
+}
+
+TEST("require that adaptive reorder keeps selective unpack in sync with children") {
+    constexpr uint32_t docid_limit = 100;
+    TermFieldMatchData tfmd;
+    MultiSearch::Children children;
+    children.emplace_back(new SimpleSearch(every_nth(1, docid_limit)));
+    children.emplace_back(new TrueSearch(tfmd));
+    children.emplace_back(new SimpleSearch(every_nth(3, docid_limit)));
+    UnpackInfo unpack_info;
+    unpack_info.add(1);
+    SearchIterator::UP search = MultiSearch::enable_adaptive_reorder(AndSearch::create(std::move(children), false, unpack_info), 10);
+    SimpleResult result;
+    result.search(*search, docid_limit);
+    EXPECT_EQUAL(every_nth(3, docid_limit), result);
+    auto &multi = dynamic_cast<MultiSearch &>(*search);
+    ASSERT_TRUE(dynamic_cast<const TrueSearch *>(multi.getChildren()[2].get()) != nullptr);
+    EXPECT_FALSE(multi.needUnpack(0));
+    EXPECT_FALSE(multi.needUnpack(1));
+    EXPECT_TRUE(multi.needUnpack(2));
+}
+
+TEST("Test adaptive reorder of and/andnot search adheres to initRange") {
+    InitRangeVerifier ir;
+    for (bool strict : {false, true}) {
+        TEST_DO(ir.verify(MultiSearch::enable_adaptive_reorder(
+                AndSearch::create({ ir.createIterator(ir.getExpectedDocIds(), strict),
+                                    ir.createFullIterator(),
+                                    ir.createIterator(ir.getExpectedDocIds(), false) }, strict), 7)));
+        auto inverted = InitRangeVerifier::invert(ir.getExpectedDocIds(), ir.getDocIdLimit());
+        TEST_DO(ir.verify(MultiSearch::enable_adaptive_reorder(
+                AndNotSearch::create({ ir.createFullIterator(),
+                                       ir.createEmptyIterator(),
+                                       ir.createIterator(inverted, false) }, strict), 7)));
+    }
+}
+
+TEST("require that search iterators are allocated from the arena in scope") {
+    vespalib::Stash stash;
+    SearchIterator::UP heap_search(simple("heap"));
+    EXPECT_EQUAL(0u, stash.count_used());
+    {
+        SearchIterator::ArenaScope scope(stash);
+        SearchIterator::UP search(OrSearch::create(search2("a", "b"), false));
+        size_t used = stash.count_used();
+        EXPECT_LESS(2 * sizeof(SimpleSearch), used);
+        search->initFullRange();
+        EXPECT_TRUE(search->isAtEnd());
+        search.reset();
+        EXPECT_EQUAL(used, stash.count_used());
+    }
+    size_t used = stash.count_used();
+    SearchIterator::UP after_scope(simple("heap"));
+    EXPECT_EQUAL(used, stash.count_used());
+}
 
 TEST_MAIN() { TEST_RUN_ALL(); }
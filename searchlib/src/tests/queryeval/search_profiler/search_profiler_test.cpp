@@ -0,0 +1,123 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/searchlib/queryeval/search_profiler.h>
+#include <vespa/searchlib/queryeval/intermediate_blueprints.h>
+#include <vespa/searchlib/queryeval/leaf_blueprints.h>
+#include <vespa/searchlib/queryeval/simpleresult.h>
+#include <vespa/searchlib/fef/matchdatalayout.h>
+#include <vespa/vespalib/data/slime/slime.h>
+#include <vespa/vespalib/gtest/gtest.h>
+
+using namespace search::queryeval;
+using search::fef::MatchData;
+using search::fef::MatchDataLayout;
+using vespalib::Slime;
+
+constexpr uint32_t docid_limit = 1001;
+
+SimpleResult every(uint32_t step) {
+    SimpleResult result;
+    for (uint32_t docid = step; docid < docid_limit; docid += step) {
+        result.addHit(docid);
+    }
+    return result;
+}
+
+struct SearchProfilerTest : ::testing::Test {
+    Blueprint::UP blueprint;
+    MatchData::UP md;
+    SearchProfilerTest()
+        : blueprint(),
+          md(MatchDataLayout().createMatchData())
+    {
+        auto and_bp = std::make_unique<AndBlueprint>();
+        and_bp->addChild(std::make_unique<SimpleBlueprint>(every(2)));
+        auto or_bp = std::make_unique<OrBlueprint>();
+        or_bp->addChild(std::make_unique<SimpleBlueprint>(every(3)));
+        or_bp->addChild(std::make_unique<SimpleBlueprint>(every(5)));
+        and_bp->addChild(std::move(or_bp));
+        blueprint = std::move(and_bp);
+        blueprint->setDocIdLimit(docid_limit);
+        blueprint->fetchPostings(ExecuteInfo::TRUE);
+        blueprint->freeze();
+    }
+    ~SearchProfilerTest() override;
+};
+
+SearchProfilerTest::~SearchProfilerTest() = default;
+
+TEST_F(SearchProfilerTest, profiled_search_gives_same_result_as_plain_search)
+{
+    SearchProfiler profiler(1);
+    auto plain = blueprint->createSearch(*md, true);
+    auto profiled = profiler.create_search(*blueprint, *md, true);
+    SimpleResult expect = SimpleResult().searchStrict(*plain, docid_limit);
+    EXPECT_EQ(233u, expect.getHitCount());
+    EXPECT_EQ(expect, SimpleResult().searchStrict(*profiled, docid_limit));
+}
+
+TEST_F(SearchProfilerTest, seeks_and_unpacks_are_counted_for_each_iterator)
+{
+    SearchProfiler profiler(1);
+    auto search = profiler.create_search(*blueprint, *md, true);
+    SimpleResult().searchStrict(*search, docid_limit);
+    ASSERT_EQ(5u, profiler.num_nodes());
+    EXPECT_EQ(234u, profiler.seeks(0));
+    EXPECT_EQ(233u, profiler.unpacks(0));
+    for (uint32_t id = 0; id < profiler.num_nodes(); ++id) {
+        EXPECT_GT(profiler.seeks(id), 0u) << "node " << id;
+        EXPECT_EQ(profiler.seeks(id) + profiler.unpacks(id), profiler.sampled_calls(id)) << "node " << id;
+    }
+}
+
+TEST_F(SearchProfilerTest, only_a_sample_of_the_calls_are_timed)
+{
+    SearchProfiler profiler(10);
+    auto search = profiler.create_search(*blueprint, *md, true);
+    SimpleResult().searchStrict(*search, docid_limit);
+    size_t root_calls = profiler.seeks(0) + profiler.unpacks(0);
+    EXPECT_EQ(root_calls / 10, profiler.sampled_calls(0));
+    for (uint32_t id = 1; id < profiler.num_nodes(); ++id) {
+        EXPECT_LT(profiler.sampled_calls(id), profiler.seeks(id) + profiler.unpacks(id)) << "node " << id;
+    }
+}
+
+TEST_F(SearchProfilerTest, profile_is_reported_as_a_tree_with_estimates)
+{
+    SearchProfiler profiler(5);
+    auto search = profiler.create_search(*blueprint, *md, true);
+    SimpleResult().searchStrict(*search, docid_limit);
+    Slime slime;
+    profiler.report(slime.setObject());
+    const auto &root = slime.get()["roots"][0];
+    EXPECT_EQ(5, slime.get()["sample_interval"].asLong());
+    EXPECT_EQ(1u, slime.get()["roots"].entries());
+    EXPECT_EQ("search::queryeval::AndBlueprint", root["blueprint"].asString().make_string());
+    EXPECT_TRUE(root["strict"].asBool());
+    EXPECT_EQ(234, root["seeks"].asLong());
+    EXPECT_EQ(233, root["unpacks"].asLong());
+    ASSERT_EQ(2u, root["children"].entries());
+    EXPECT_EQ(500, root["children"][0]["estimate"].asLong());
+    EXPECT_TRUE(root["children"][0]["strict"].asBool());
+    const auto &or_node = root["children"][1];
+    EXPECT_EQ("search::queryeval::OrBlueprint", or_node["blueprint"].asString().make_string());
+    EXPECT_FALSE(or_node["strict"].asBool());
+    EXPECT_EQ(333, or_node["estimate"].asLong());
+    ASSERT_EQ(2u, or_node["children"].entries());
+    EXPECT_EQ(333, or_node["children"][0]["estimate"].asLong());
+    EXPECT_EQ(200, or_node["children"][1]["estimate"].asLong());
+    EXPECT_GE(root["total_time_ms"].asDouble(), root["self_time_ms"].asDouble());
+}
+
+TEST_F(SearchProfilerTest, each_created_search_adds_a_root)
+{
+    SearchProfiler profiler(1);
+    auto first = profiler.create_search(*blueprint, *md, true);
+    auto second = profiler.create_search(*blueprint, *md, true);
+    EXPECT_EQ(10u, profiler.num_nodes());
+    Slime slime;
+    profiler.report(slime.setObject());
+    EXPECT_EQ(2u, slime.get()["roots"].entries());
+}
+
+GTEST_MAIN_RUN_ALL_TESTS()
@@ -43,6 +43,7 @@ class Test : public vespalib::TestApp {
     void requireThatIteratorFindsSimplePhrase(bool useBlueprint);
     void requireThatIteratorFindsLongPhrase(bool useBlueprint);
     void requireThatStrictIteratorFindsNextMatch(bool useBlueprint);
+    void requireThatStrictIteratorIsDrivenByRarestTerm(bool useBlueprint);
     void requireThatPhrasesAreUnpacked(bool useBlueprint, bool unpack_normal_features, bool unpack_interleaved_features);
     void requireThatTermsCanBeEvaluatedInPriorityOrder();
     void requireThatBlueprintExposesFieldWithEstimate();
@@ -63,6 +64,7 @@ Test::Main()
     TEST_DO(requireThatIteratorFindsSimplePhrase(false));
     TEST_DO(requireThatIteratorFindsLongPhrase(false));
     TEST_DO(requireThatStrictIteratorFindsNextMatch(false));
+    TEST_DO(requireThatStrictIteratorIsDrivenByRarestTerm(false));
     TEST_DO(requireThatPhrasesAreUnpacked(false, true, false));
     TEST_DO(requireThatPhrasesAreUnpacked(false, true, true));
     TEST_DO(requireThatPhrasesAreUnpacked(false, false, false));
@@ -72,6 +74,7 @@ Test::Main()
     TEST_DO(requireThatIteratorFindsSimplePhrase(true));
     TEST_DO(requireThatIteratorFindsLongPhrase(true));
     TEST_DO(requireThatStrictIteratorFindsNextMatch(true));
+    TEST_DO(requireThatStrictIteratorIsDrivenByRarestTerm(true));
     TEST_DO(requireThatPhrasesAreUnpacked(true, true, false));
     TEST_DO(requireThatPhrasesAreUnpacked(true, true, true));
     TEST_DO(requireThatPhrasesAreUnpacked(true, false, false));
@@ -276,6 +279,24 @@ void Test::requireThatStrictIteratorFindsNextMatch(bool useBlueprint) {
     EXPECT_TRUE(search->isAtEnd());
 }
 
+void Test::requireThatStrictIteratorIsDrivenByRarestTerm(bool useBlueprint) {
+    PhraseSearchTest test;
+    test.setStrict(true);
+    test.addTerm("the", FakeResult()
+                 .doc(10).pos(1).doc(20).pos(1).doc(30).pos(3)
+                 .doc(doc_match).pos(4).doc(doc_no_match).pos(1).doc(50).pos(1));
+    test.addTerm("who", FakeResult()
+                 .doc(30).pos(1).doc(doc_match).pos(5).doc(60).pos(2));
+    test.setOrder({1, 0});
+
+    test.fetchPostings(useBlueprint);
+    unique_ptr<SearchIterator> search(test.createSearch(useBlueprint));
+    EXPECT_TRUE(!search->seek(1u));
+    EXPECT_EQUAL(doc_match, search->getDocId());
+    EXPECT_TRUE(!search->seek(doc_match + 1));
+    EXPECT_TRUE(search->isAtEnd());
+}
+
 void Test::requireThatPhrasesAreUnpacked(bool useBlueprint, bool unpack_normal_features, bool unpack_interleaved_features) {
     PhraseSearchTest test;
     test.addTerm("foo", FakeResult()
@@ -140,6 +140,62 @@ TEST("test full sourceblender search") {
     EXPECT_EQUAL(expect_unpacked_c, uc->getUnpacked());
 }
 
+/**
+ * Proxy search used to verify seek pattern
+ **/
+class SeekChecker : public SearchIterator
+{
+private:
+    SearchIterator::UP    _search;
+    std::vector<uint32_t> _seeks;
+
+protected:
+    void doSeek(uint32_t docid) override {
+        _seeks.push_back(docid);
+        _search->seek(docid);
+        setDocId(_search->getDocId());
+    }
+    void doUnpack(uint32_t docid) override {
+        _search->unpack(docid);
+    }
+
+public:
+    SeekChecker(SearchIterator *search) : _search(search), _seeks() {}
+    const std::vector<uint32_t> &getSeeks() const { return _seeks; }
+};
+
+TEST("require that strict children only seek documents from their own source") {
+    SimpleResult a;
+    SimpleResult b;
+    SimpleResult expect_result;
+    for (uint32_t docid = 1; docid < 100; ++docid) {
+        if ((docid % 2) == 0) {
+            a.addHit(docid);
+        }
+        b.addHit(docid);
+        if (((docid % 2) == 0) || (docid == 51)) {
+            expect_result.addHit(docid);
+        }
+    }
+    SeekChecker *sa = new SeekChecker(new SimpleSearch(a));
+    SeekChecker *sb = new SeekChecker(new SimpleSearch(b));
+    auto sel = make_unique<MySelector>(1);
+    sel->set(51, 2).set(99, 1);
+    SourceBlenderSearch::Children ab;
+    ab.push_back(SourceBlenderSearch::Child(sa, 1));
+    ab.push_back(SourceBlenderSearch::Child(sb, 2));
+
+    SearchIterator::UP blend(SourceBlenderSearch::create(sel->createIterator(), ab, true));
+    SimpleResult result;
+    result.search(*blend);
+
+    EXPECT_EQUAL(expect_result, result);
+    EXPECT_FALSE(sb->getSeeks().empty());
+    for (uint32_t docid : sb->getSeeks()) {
+        EXPECT_TRUE((docid == 51) || (docid >= 100));
+    }
+}
+
 using search::test::SearchIteratorVerifier;
 
 class Verifier : public SearchIteratorVerifier {
@@ -10,6 +10,8 @@
 #include <vespa/searchlib/queryeval/weighted_set_term_blueprint.h>
 #include <vespa/searchlib/queryeval/fake_result.h>
 #include <vespa/searchlib/queryeval/emptysearch.h>
+#include <vespa/searchlib/queryeval/simpleresult.h>
+#include <vespa/searchlib/queryeval/simplesearch.h>
 #include <vespa/searchlib/queryeval/fake_searchable.h>
 #include <vespa/searchlib/queryeval/fake_requestcontext.h>
 #include <vespa/searchlib/test/weightedchildrenverifiers.h>
@@ -192,29 +194,79 @@ TEST_F("test Eager Matching Child", MockFixture(5)) {
 }
 
 class IteratorChildrenVerifier : public search::test::IteratorChildrenVerifier {
+public:
+    IteratorChildrenVerifier(bool use_flat_merge) : _use_flat_merge(use_flat_merge) {}
 private:
     SearchIterator::UP create(const std::vector<SearchIterator*> &children) const override {
-        return SearchIterator::UP(WeightedSetTermSearch::create(children, _tfmd, _weights, MatchData::UP(nullptr)));
+        return SearchIterator::UP(WeightedSetTermSearch::create(children, _tfmd, _weights, MatchData::UP(nullptr), _use_flat_merge));
     }
+    bool _use_flat_merge;
 };
 
 class WeightIteratorChildrenVerifier : public search::test::DwaIteratorChildrenVerifier {
+public:
+    WeightIteratorChildrenVerifier(bool use_flat_merge) : _use_flat_merge(use_flat_merge) {}
 private:
     SearchIterator::UP create(std::vector<DocumentWeightIterator> && children) const override {
-        return SearchIterator::UP(WeightedSetTermSearch::create(_tfmd, _weights, std::move(children)));
+        return SearchIterator::UP(WeightedSetTermSearch::create(_tfmd, _weights, std::move(children), _use_flat_merge));
     }
+    bool _use_flat_merge;
 };
 
 TEST("verify search iterator conformance with search iterator children") {
-    IteratorChildrenVerifier verifier;
+    IteratorChildrenVerifier verifier(false);
     verifier.verify();
 }
 
 TEST("verify search iterator conformance with document weight iterator children") {
-    WeightIteratorChildrenVerifier verifier;
+    WeightIteratorChildrenVerifier verifier(false);
     verifier.verify();
 }
 
+TEST("verify search iterator conformance with search iterator children using flat merge") {
+    IteratorChildrenVerifier verifier(true);
+    verifier.verify();
+}
+
+TEST("verify search iterator conformance with document weight iterator children using flat merge") {
+    WeightIteratorChildrenVerifier verifier(true);
+    verifier.verify();
+}
+
+std::vector<std::pair<uint32_t, std::vector<int32_t>>>
+unpack_all(bool use_flat_merge, uint32_t num_children, uint32_t doc_id_limit) {
+    std::vector<SearchIterator*> children;
+    std::vector<int32_t> weights;
+    for (uint32_t i = 0; i < num_children; ++i) {
+        SimpleResult result;
+        for (uint32_t docid = i + 1; docid < doc_id_limit; docid += (i + 1)) {
+            result.addHit(docid);
+        }
+        children.push_back(new SimpleSearch(result));
+        weights.push_back(i * 3 % 11);
+    }
+    TermFieldMatchData tfmd;
+    auto search = WeightedSetTermSearch::create(children, tfmd, weights, MatchData::UP(nullptr), use_flat_merge);
+    std::vector<std::pair<uint32_t, std::vector<int32_t>>> hits;
+    search->initRange(1, doc_id_limit);
+    for (uint32_t docid = search->seekFirst(1); docid < doc_id_limit; docid = search->seekNext(docid + 1)) {
+        search->unpack(docid);
+        std::vector<int32_t> matched;
+        for (auto itr = tfmd.getIterator(); itr.valid(); itr.next()) {
+            matched.push_back(itr.getElementWeight());
+        }
+        hits.emplace_back(docid, std::move(matched));
+    }
+    return hits;
+}
+
+TEST("require that flat merge gives the same hits and weights as heap merge") {
+    auto heap_hits = unpack_all(false, 300, 100000);
+    auto flat_hits = unpack_all(true, 300, 100000);
+    EXPECT_EQUAL(99999u, heap_hits.size());
+    EXPECT_TRUE(heap_hits == flat_hits);
+}
+
 struct VerifyMatchData {
     struct MyBlueprint : search::queryeval::SimpleLeafBlueprint {
         VerifyMatchData &vmd;
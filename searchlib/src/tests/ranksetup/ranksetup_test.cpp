@@ -243,6 +243,7 @@ private:
                        const vespalib::string & finalRank = "", feature_t finalScore = 0.0f, uint32_t docId = 1);
     void testExecution();
     void testFeatureDump();
+    void testProgramRecycling();
 
     void checkFeatures(std::map<vespalib::string, feature_t> &exp, std::map<vespalib::string, feature_t> &actual);
     void testFeatureNormalization();
@@ -506,6 +507,7 @@ void RankSetupTest::testRankSetup()
     env.getProperties().add(dump::Feature::NAME, "foo");
     env.getProperties().add(dump::Feature::NAME, "bar");
     env.getProperties().add(matching::NumThreadsPerSearch::NAME, "3");
+    env.getProperties().add(matching::MinThreadsPerSearch::NAME, "2");
     env.getProperties().add(matching::MinHitsPerThread::NAME, "8");
     env.getProperties().add(matchphase::DegradationAttribute::NAME, "mystaticrankattr");
     env.getProperties().add(matchphase::DegradationAscendingOrder::NAME, "true");
@@ -513,6 +515,7 @@ void RankSetupTest::testRankSetup()
     env.getProperties().add(matchphase::DegradationMaxFilterCoverage::NAME, "0.19");
     env.getProperties().add(matchphase::DegradationSamplePercentage::NAME, "0.9");
     env.getProperties().add(matchphase::DegradationPostFilterMultiplier::NAME, "0.7");
+    env.getProperties().add(matchphase::DegradationOrderedEvaluation::NAME, "true");
     env.getProperties().add(matchphase::DiversityAttribute::NAME, "mycategoryattr");
     env.getProperties().add(matchphase::DiversityMinGroups::NAME, "37");
     env.getProperties().add(matchphase::DiversityCutoffFactor::NAME, "7.1");
@@ -531,6 +534,7 @@ void RankSetupTest::testRankSetup()
     EXPECT_EQUAL(rs.getDumpFeatures()[0], vespalib::string("foo"));
     EXPECT_EQUAL(rs.getDumpFeatures()[1], vespalib::string("bar"));
     EXPECT_EQUAL(rs.getNumThreadsPerSearch(), 3u);
+    EXPECT_EQUAL(rs.getMinThreadsPerSearch(), 2u);
     EXPECT_EQUAL(rs.getMinHitsPerThread(), 8u);
     EXPECT_EQUAL(rs.getDegradationAttribute(), "mystaticrankattr");
     EXPECT_EQUAL(rs.isDegradationOrderAscending(), true);
@@ -538,6 +542,7 @@ void RankSetupTest::testRankSetup()
     EXPECT_EQUAL(rs.getDegradationSamplePercentage(), 0.9);
     EXPECT_EQUAL(rs.getDegradationMaxFilterCoverage(), 0.19);
     EXPECT_EQUAL(rs.getDegradationPostFilterMultiplier(), 0.7);
+    EXPECT_EQUAL(rs.isDegradationOrderedEvaluation(), true);
     EXPECT_EQUAL(rs.getDiversityAttribute(), "mycategoryattr");
     EXPECT_EQUAL(rs.getDiversityMinGroups(), 37u);
     EXPECT_EQUAL(rs.getDiversityCutoffFactor(), 7.1);
@@ -666,6 +671,45 @@ RankSetupTest::testExecution()
     }
 }
 
+void
+RankSetupTest::testProgramRecycling()
+{
+    RankSetup rs(_factory, _indexEnv);
+    rs.setFirstPhaseRank("value(2)");
+    rs.setSecondPhaseRank("value(3)");
+    ASSERT_TRUE(rs.compile());
+    MatchDataLayout layout;
+    MatchData::UP match_data = layout.createMatchData();
+
+    RankProgram::UP first = rs.create_first_phase_program();
+    first->setup(*match_data, _queryEnv);
+    EXPECT_EQUAL(2.0, Utils::getScoreFeature(*first, 1));
+    const RankProgram *first_ptr = first.get();
+    rs.recycle_program(std::move(first));
+
+    RankProgram::UP second = rs.create_second_phase_program();
+    EXPECT_TRUE(second.get() != first_ptr);
+    second->setup(*match_data, _queryEnv);
+    EXPECT_EQUAL(3.0, Utils::getScoreFeature(*second, 1));
+
+    RankProgram::UP again = rs.create_first_phase_program();
+    EXPECT_TRUE(again.get() == first_ptr);
+    EXPECT_EQUAL(0u, again->num_executors());
+    again->setup(*match_data, _queryEnv);
+    EXPECT_EQUAL(2.0, Utils::getScoreFeature(*again, 1));
+    rs.recycle_program(std::move(again));
+    rs.recycle_program(std::move(second));
+
+    // programs for other tasks are not kept
+    RankProgram::UP dump = rs.create_dump_program();
+    const RankProgram *dump_ptr = dump.get();
+    rs.recycle_program(std::move(dump));
+    RankProgram::UP first_again = rs.create_first_phase_program();
+    RankProgram::UP second_again = rs.create_second_phase_program();
+    EXPECT_TRUE(first_again.get() == first_ptr);
+    EXPECT_TRUE(second_again.get() != dump_ptr);
+}
+
 void
 RankSetupTest::testFeatureDump()
 {
@@ -936,6 +980,7 @@ RankSetupTest::Main()
     testRankSetup();
     testExecution();
     testFeatureDump();
+    testProgramRecycling();
     testFeatureNormalization();
 
     TEST_DONE();
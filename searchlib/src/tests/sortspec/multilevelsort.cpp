@@ -428,4 +428,37 @@ TEST("test that [docid] translates to [lid][paritionid]") {
     EXPECT_EQUAL(0, memcmp(SECOND_DESC, sr2.first, 6));
 }
 
+TEST("require that only the best hits need to be sorted") {
+    vespalib::Clock clock;
+    vespalib::Doom doom(clock, vespalib::steady_time::max());
+    search::uca::UcaConverterFactory ucaFactory;
+    search::AttributeManager mgr;
+    search::AttributeContext ac(mgr);
+    constexpr uint32_t num = 1000;
+    constexpr uint32_t topn = 10;
+    for (int method = 0; method <= 2; ++method) {
+        std::vector<RankedHit> hits;
+        for (uint32_t i = 0; i < num; ++i) {
+            hits.emplace_back((i * 7919) % num, 0.0);
+        }
+        FastS_SortSpec sorter(7, doom, ucaFactory, method);
+        EXPECT_TRUE(sorter.Init("-[docid]", ac));
+        sorter.sortResults(&hits[0], num, topn);
+        std::vector<uint32_t> docids;
+        for (const RankedHit &hit : hits) {
+            docids.push_back(hit.getDocId());
+        }
+        for (uint32_t i = 0; i < topn; ++i) {
+            EXPECT_EQUAL(num - 1 - i, docids[i]);
+            auto ref = sorter.getSortRef(i);
+            EXPECT_EQUAL(6u, ref.second);
+            EXPECT_EQUAL(uint8_t(255 - (docids[i] & 0xff)), uint8_t(ref.first[3]));
+        }
+        std::sort(docids.begin(), docids.end());
+        for (uint32_t i = 0; i < num; ++i) {
+            EXPECT_EQUAL(i, docids[i]);
+        }
+    }
+}
+
 TEST_MAIN() { TEST_RUN_ALL(); }
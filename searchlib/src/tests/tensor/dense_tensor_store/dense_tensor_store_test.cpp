@@ -8,6 +8,7 @@ LOG_SETUP("dense_tensor_store_test");
 #include <vespa/eval/tensor/default_tensor_engine.h>
 #include <vespa/eval/tensor/tensor.h>
 #include <vespa/eval/tensor/dense/mutable_dense_tensor_view.h>
+#include <vespa/vespalib/util/mmap_file_allocator.h>
 
 using search::tensor::DenseTensorStore;
 using vespalib::eval::TensorSpec;
@@ -15,6 +16,7 @@ using vespalib::eval::ValueType;
 using vespalib::tensor::MutableDenseTensorView;
 using vespalib::tensor::Tensor;
 using vespalib::tensor::DefaultTensorEngine;
+using vespalib::alloc::MmapFileAllocator;
 
 using EntryRef = DenseTensorStore::EntryRef;
 
@@ -28,8 +30,9 @@ makeTensor(const TensorSpec &spec)
 struct Fixture
 {
     DenseTensorStore store;
-    Fixture(const vespalib::string &tensorType)
-        : store(ValueType::from_spec(tensorType))
+    Fixture(const vespalib::string &tensorType,
+            std::unique_ptr<vespalib::alloc::MemoryAllocator> allocator = {})
+        : store(ValueType::from_spec(tensorType), std::move(allocator))
     {}
     void assertSetAndGetTensor(const TensorSpec &tensorSpec) {
         Tensor::UP expTensor = makeTensor(tensorSpec);
@@ -68,6 +71,22 @@ TEST_F("require that correct empty tensor is returned for 1d bound tensor", Fixt
                                    add({{"x", 2}}, 0));
 }
 
+TEST_F("require that tensors can be stored in file backed buffers",
+       Fixture("tensor(x[3])", std::make_unique<MmapFileAllocator>("dense-tensor-store-swapdir")))
+{
+    EXPECT_TRUE(f.store.has_custom_allocator());
+    for (uint32_t i = 0; i < 2000; ++i) {
+        f.assertSetAndGetTensor(TensorSpec("tensor(x[3])").
+                                           add({{"x", 0}}, i).
+                                           add({{"x", 1}}, i + 1).
+                                           add({{"x", 2}}, i + 2));
+    }
+    EntryRef ref = f.store.setTensor(*makeTensor(TensorSpec("tensor(x[3])").add({{"x", 1}}, 7)));
+    f.store.prefetch(ref);
+    auto cells = f.store.get_typed_cells(ref).template typify<double>();
+    EXPECT_EQUAL(7.0, cells[1]);
+}
+
 void
 assertArraySize(const vespalib::string &tensorType, uint32_t expArraySize) {
     Fixture f(tensorType);
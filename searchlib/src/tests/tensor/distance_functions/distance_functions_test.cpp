@@ -52,6 +52,59 @@ TEST(DistanceFunctionsTest, euclidean_gives_expected_score)
     EXPECT_DOUBLE_EQ(euclid->to_rawscore(d12), 1.0/(1.0 + sqrt(2.0)));
 }
 
+TEST(DistanceFunctionsTest, euclidean_with_limit_stops_early_but_is_exact_below_limit)
+{
+    auto ct = vespalib::eval::ValueType::CellType::DOUBLE;
+
+    auto euclid = make_distance_function(DistanceMetric::Euclidean, ct);
+
+    std::vector<double> p0(1000, 0.0);
+    std::vector<double> p1(1000, 1.0);
+    double d01 = euclid->calc(t(p0), t(p1));
+    EXPECT_EQ(d01, 1000.0);
+    EXPECT_EQ(euclid->calc_with_limit(t(p0), t(p1), 1000.0), 1000.0);
+    double limited = euclid->calc_with_limit(t(p0), t(p1), 10.0);
+    EXPECT_GT(limited, 10.0);
+    EXPECT_LT(limited, 1000.0);
+}
+
+TEST(DistanceFunctionsTest, int8_and_bfloat16_cells_are_promoted_to_float)
+{
+    using CellType = vespalib::eval::ValueType::CellType;
+    using vespalib::BFloat16;
+    using vespalib::ConstArrayRef;
+
+    std::vector<int8_t> i1{1, 2, 3};
+    std::vector<int8_t> i2{-1, 0, 7};
+    std::vector<BFloat16> b1{1.0f, 2.0f, 3.0f};
+    std::vector<BFloat16> b2{-1.0f, 0.0f, 7.0f};
+    std::vector<int8_t> i3{0, -1, 0};
+    std::vector<float> f2{-1.0f, 0.0f, 7.0f};
+    TypedCells ti1{ConstArrayRef<int8_t>(i1)};
+    TypedCells ti2{ConstArrayRef<int8_t>(i2)};
+    TypedCells ti3{ConstArrayRef<int8_t>(i3)};
+    TypedCells tb1{ConstArrayRef<BFloat16>(b1)};
+    TypedCells tb2{ConstArrayRef<BFloat16>(b2)};
+    TypedCells tf2{ConstArrayRef<float>(f2)};
+
+    auto euclid_i = make_distance_function(DistanceMetric::Euclidean, CellType::INT8);
+    auto euclid_b = make_distance_function(DistanceMetric::Euclidean, CellType::BFLOAT16);
+    EXPECT_EQ(euclid_i->calc(ti1, ti2), 24.0);
+    EXPECT_EQ(euclid_b->calc(tb1, tb2), 24.0);
+    EXPECT_EQ(euclid_b->calc(tb1, tf2), 24.0);
+    EXPECT_EQ(euclid_i->calc_with_limit(ti1, ti2, 100.0), 24.0);
+    EXPECT_DOUBLE_EQ(euclid_i->to_rawscore(24.0), 1.0/(1.0 + sqrt(24.0)));
+
+    auto innerproduct = make_distance_function(DistanceMetric::InnerProduct, CellType::INT8);
+    EXPECT_EQ(innerproduct->calc(ti1, ti3), 3.0);
+
+    TypedCells rhs[2] = {ti2, ti1};
+    double result[2];
+    euclid_i->calc_batch(ti1, rhs, 2, result);
+    EXPECT_EQ(result[0], 24.0);
+    EXPECT_EQ(result[1], 0.0);
+}
+
 TEST(DistanceFunctionsTest, angular_gives_expected_score)
 {
     auto ct = vespalib::eval::ValueType::CellType::DOUBLE;
@@ -142,6 +195,34 @@ TEST(DistanceFunctionsTest, innerproduct_gives_expected_score)
     EXPECT_LT(i44, 0.000001);
 }
 
+TEST(DistanceFunctionsTest, calc_batch_gives_same_distances_as_calc)
+{
+    auto ct = vespalib::eval::ValueType::CellType::DOUBLE;
+
+    std::vector<double> q{1.0, 2.0, 2.0};
+    std::vector<std::vector<double>>
+        points{{0.0, 0.0, 0.0},
+               {1.0, 0.0, 0.0},
+               {0.0, 1.0, 1.0},
+               {0.5, 0.5, 0.707107},
+               {0.0,-1.0, 1.0},
+               {1.0, 2.0, 2.0}};
+    std::vector<TypedCells> cells;
+    for (const auto & p : points) {
+        cells.push_back(t(p));
+    }
+    for (auto metric : {DistanceMetric::Euclidean, DistanceMetric::Angular,
+                        DistanceMetric::InnerProduct, DistanceMetric::Hamming})
+    {
+        auto dist_fun = make_distance_function(metric, ct);
+        std::vector<double> result(cells.size());
+        dist_fun->calc_batch(t(q), cells.data(), cells.size(), result.data());
+        for (size_t i = 0; i < cells.size(); ++i) {
+            EXPECT_DOUBLE_EQ(result[i], dist_fun->calc(t(q), cells[i]));
+        }
+    }
+}
+
 TEST(DistanceFunctionsTest, hamming_gives_expected_score)
 {
     auto ct = vespalib::eval::ValueType::CellType::DOUBLE;
@@ -0,0 +1,378 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/eval/tensor/dense/typed_cells.h>
+#include <vespa/fastos/app.h>
+#include <vespa/searchlib/tensor/distance_functions.h>
+#include <vespa/searchlib/tensor/doc_vector_access.h>
+#include <vespa/searchlib/tensor/hnsw_index.h>
+#include <vespa/searchlib/tensor/inv_log_level_generator.h>
+#include <vespa/vespalib/stllike/string.h>
+#include <vespa/vespalib/util/exceptions.h>
+#include <vespa/vespalib/util/stringfmt.h>
+#include <algorithm>
+#include <chrono>
+#include <cinttypes>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <queue>
+#include <thread>
+#include <vector>
+
+#include <vespa/log/log.h>
+LOG_SETUP("hnsw_benchmark");
+
+using namespace search::tensor;
+using vespalib::make_string;
+
+namespace {
+
+using clock = std::chrono::steady_clock;
+
+double seconds_since(clock::time_point start) {
+    return std::chrono::duration<double>(clock::now() - start).count();
+}
+
+/**
+ * A set of vectors of the same size, read from a file in the fvecs, bvecs or ivecs format.
+ * Each vector is stored as a 4 byte little endian dimension count followed by the cells
+ * (float, uint8 or int32).
+ */
+template <typename T>
+class VectorFile {
+private:
+    uint32_t _dims;
+    std::vector<T> _cells;
+public:
+    VectorFile() : _dims(0), _cells() {}
+    uint32_t dims() const { return _dims; }
+    uint32_t size() const { return (_dims > 0) ? (_cells.size() / _dims) : 0; }
+    const T *get(uint32_t idx) const { return &_cells[size_t(idx) * _dims]; }
+
+    template <typename CellType>
+    void read(const vespalib::string &file_name, uint32_t max_vectors) {
+        std::ifstream in(file_name.c_str(), std::ios::binary);
+        if (!in) {
+            throw vespalib::IllegalArgumentException(make_string("Cannot open '%s'", file_name.c_str()));
+        }
+        std::vector<CellType> buf;
+        int32_t dims = 0;
+        while (((max_vectors == 0) || (size() < max_vectors)) &&
+               in.read(reinterpret_cast<char *>(&dims), sizeof(dims)))
+        {
+            if ((dims <= 0) || ((_dims != 0) && (uint32_t(dims) != _dims))) {
+                throw vespalib::IllegalArgumentException(make_string("Bad dimension count %d in '%s'", dims, file_name.c_str()));
+            }
+            _dims = dims;
+            buf.resize(dims);
+            if (!in.read(reinterpret_cast<char *>(buf.data()), dims * sizeof(CellType))) {
+                throw vespalib::IllegalArgumentException(make_string("Truncated vector in '%s'", file_name.c_str()));
+            }
+            _cells.insert(_cells.end(), buf.begin(), buf.end());
+        }
+    }
+};
+
+using FloatVectors = VectorFile<float>;
+
+void
+read_vectors(FloatVectors &vectors, const vespalib::string &file_name, uint32_t max_vectors)
+{
+    if (file_name.size() >= 6 && file_name.substr(file_name.size() - 6) == ".bvecs") {
+        vectors.read<uint8_t>(file_name, max_vectors);
+    } else {
+        vectors.read<float>(file_name, max_vectors);
+    }
+}
+
+/**
+ * Gives the hnsw index access to the base vectors, using docid = index + 1.
+ */
+class BaseVectors : public DocVectorAccess {
+private:
+    const FloatVectors &_vectors;
+public:
+    BaseVectors(const FloatVectors &vectors) : _vectors(vectors) {}
+    vespalib::tensor::TypedCells get_vector(uint32_t docid) const override {
+        if ((docid == 0) || (docid > _vectors.size())) {
+            return vespalib::tensor::TypedCells(vespalib::ConstArrayRef<float>());
+        }
+        return vespalib::tensor::TypedCells(vespalib::ConstArrayRef<float>(_vectors.get(docid - 1), _vectors.dims()));
+    }
+    void prefetch_vector(uint32_t docid) const override {
+        __builtin_prefetch(_vectors.get(docid - 1));
+    }
+};
+
+std::vector<uint32_t>
+parse_list(const char *arg)
+{
+    std::vector<uint32_t> result;
+    vespalib::string str(arg);
+    size_t pos = 0;
+    while (pos < str.size()) {
+        size_t end = str.find(',', pos);
+        if (end == vespalib::string::npos) {
+            end = str.size();
+        }
+        result.push_back(atoi(str.substr(pos, end - pos).c_str()));
+        pos = end + 1;
+    }
+    return result;
+}
+
+vespalib::string
+format_list(const std::vector<uint32_t> &list)
+{
+    vespalib::string result;
+    for (uint32_t value : list) {
+        if (!result.empty()) {
+            result.append(",");
+        }
+        result.append(make_string("%u", value));
+    }
+    return result;
+}
+
+class HnswBenchmark : public FastOS_Application
+{
+private:
+    vespalib::string _base_file;
+    vespalib::string _query_file;
+    vespalib::string _ground_truth_file;
+    vespalib::string _distance;
+    uint32_t _max_base;
+    uint32_t _max_queries;
+    uint32_t _k;
+    std::vector<uint32_t> _max_links_at_level_0;
+    std::vector<uint32_t> _neighbors_to_explore_at_insert;
+    std::vector<uint32_t> _explore_k;
+    std::vector<uint32_t> _threads;
+    FloatVectors _base;
+    FloatVectors _queries;
+    std::vector<std::vector<uint32_t>> _ground_truth;
+
+    void usage();
+    bool parse_args();
+    std::unique_ptr<DistanceFunction> make_distance_function() const;
+    void calc_ground_truth(uint32_t num_threads);
+    void run_config(uint32_t max_links_at_level_0, uint32_t neighbors_to_explore_at_insert);
+public:
+    HnswBenchmark();
+    ~HnswBenchmark() override;
+    int Main() override;
+};
+
+HnswBenchmark::HnswBenchmark()
+    : _base_file(),
+      _query_file(),
+      _ground_truth_file(),
+      _distance("euclidean"),
+      _max_base(0),
+      _max_queries(0),
+      _k(10),
+      _max_links_at_level_0({16, 32}),
+      _neighbors_to_explore_at_insert({100, 200}),
+      _explore_k({10, 20, 50, 100, 200}),
+      _threads({1}),
+      _base(),
+      _queries(),
+      _ground_truth()
+{
+}
+
+HnswBenchmark::~HnswBenchmark() = default;
+
+void
+HnswBenchmark::usage()
+{
+    std::cerr << "usage: hnsw_benchmark -b base.{fvecs,bvecs} -q queries.{fvecs,bvecs} [-g groundtruth.ivecs]" << std::endl;
+    std::cerr << "                      [-n maxBaseVectors] [-Q maxQueries] [-k targetHits]" << std::endl;
+    std::cerr << "                      [-d euclidean|angular|innerproduct]" << std::endl;
+    std::cerr << "                      [-m maxLinksAtLevel0,...] [-c neighborsToExploreAtInsert,...]" << std::endl;
+    std::cerr << "                      [-e exploreK,...] [-t readerThreads,...]" << std::endl;
+    std::cerr << "Prints one JSON object per line for each index config and search parameter combination." << std::endl;
+    std::cerr << "Ground truth is calculated by brute force when not given." << std::endl;
+}
+
+bool
+HnswBenchmark::parse_args()
+{
+    int idx = 1;
+    char opt;
+    const char *arg;
+    while ((opt = GetOpt("b:q:g:n:Q:k:d:m:c:e:t:", arg, idx)) != -1) {
+        switch (opt) {
+        case 'b': _base_file = arg; break;
+        case 'q': _query_file = arg; break;
+        case 'g': _ground_truth_file = arg; break;
+        case 'n': _max_base = atoi(arg); break;
+        case 'Q': _max_queries = atoi(arg); break;
+        case 'k': _k = atoi(arg); break;
+        case 'd': _distance = arg; break;
+        case 'm': _max_links_at_level_0 = parse_list(arg); break;
+        case 'c': _neighbors_to_explore_at_insert = parse_list(arg); break;
+        case 'e': _explore_k = parse_list(arg); break;
+        case 't': _threads = parse_list(arg); break;
+        default:
+            return false;
+        }
+    }
+    return !_base_file.empty() && !_query_file.empty() && (_k > 0) &&
+           (_distance == "euclidean" || _distance == "angular" || _distance == "innerproduct");
+}
+
+std::unique_ptr<DistanceFunction>
+HnswBenchmark::make_distance_function() const
+{
+    if (_distance == "angular") {
+        return std::make_unique<AngularDistance<float>>();
+    } else if (_distance == "innerproduct") {
+        return std::make_unique<InnerProductDistance<float>>();
+    }
+    return std::make_unique<SquaredEuclideanDistance<float>>();
+}
+
+void
+HnswBenchmark::calc_ground_truth(uint32_t num_threads)
+{
+    auto dist_fun = make_distance_function();
+    _ground_truth.resize(_queries.size());
+    auto calc = [&](uint32_t thread_id) {
+        using DistDocid = std::pair<double, uint32_t>;
+        for (uint32_t q = thread_id; q < _queries.size(); q += num_threads) {
+            vespalib::tensor::TypedCells query(vespalib::ConstArrayRef<float>(_queries.get(q), _queries.dims()));
+            std::priority_queue<DistDocid> best;
+            for (uint32_t i = 0; i < _base.size(); ++i) {
+                vespalib::tensor::TypedCells vector(vespalib::ConstArrayRef<float>(_base.get(i), _base.dims()));
+                double dist = dist_fun->calc(query, vector);
+                if (best.size() < _k) {
+                    best.emplace(dist, i);
+                } else if (dist < best.top().first) {
+                    best.pop();
+                    best.emplace(dist, i);
+                }
+            }
+            auto &truth = _ground_truth[q];
+            while (!best.empty()) {
+                truth.push_back(best.top().second);
+                best.pop();
+            }
+        }
+    };
+    std::vector<std::thread> threads;
+    for (uint32_t t = 0; t < num_threads; ++t) {
+        threads.emplace_back(calc, t);
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+}
+
+void
+HnswBenchmark::run_config(uint32_t max_links_at_level_0, uint32_t neighbors_to_explore_at_insert)
+{
+    BaseVectors vectors(_base);
+    HnswIndex::Config cfg(max_links_at_level_0, std::max(1u, max_links_at_level_0 / 2), neighbors_to_explore_at_insert, 0, true);
+    HnswIndex index(vectors, make_distance_function(), std::make_unique<InvLogLevelGenerator>(cfg.max_links_on_inserts()), cfg);
+    auto start = clock::now();
+    for (uint32_t docid = 1; docid <= _base.size(); ++docid) {
+        index.add_document(docid);
+    }
+    double insert_seconds = seconds_since(start);
+    auto memory = index.memory_usage();
+    double vector_bytes = double(_base.dims()) * sizeof(float);
+    for (uint32_t explore_k : _explore_k) {
+        for (uint32_t num_threads : _threads) {
+            std::vector<double> recall(num_threads, 0.0);
+            std::vector<double> latency(num_threads, 0.0);
+            auto search = [&](uint32_t thread_id) {
+                for (uint32_t q = thread_id; q < _queries.size(); q += num_threads) {
+                    vespalib::tensor::TypedCells query(vespalib::ConstArrayRef<float>(_queries.get(q), _queries.dims()));
+                    auto query_start = clock::now();
+                    auto hits = index.find_top_k(_k, query, explore_k);
+                    latency[thread_id] += seconds_since(query_start);
+                    const auto &truth = _ground_truth[q];
+                    uint32_t num_truth = std::min(_k, uint32_t(truth.size()));
+                    uint32_t found = 0;
+                    for (const auto &hit : hits) {
+                        if (std::find(truth.begin(), truth.begin() + num_truth, hit.docid - 1) != truth.begin() + num_truth) {
+                            ++found;
+                        }
+                    }
+                    recall[thread_id] += (num_truth > 0) ? (double(found) / num_truth) : 1.0;
+                }
+            };
+            auto search_start = clock::now();
+            std::vector<std::thread> threads;
+            for (uint32_t t = 0; t < num_threads; ++t) {
+                threads.emplace_back(search, t);
+            }
+            for (auto &thread : threads) {
+                thread.join();
+            }
+            double search_seconds = seconds_since(search_start);
+            double total_recall = 0.0;
+            double total_latency = 0.0;
+            for (uint32_t t = 0; t < num_threads; ++t) {
+                total_recall += recall[t];
+                total_latency += latency[t];
+            }
+            uint32_t num_queries = _queries.size();
+            printf("{\"max_links_at_level_0\":%u,\"max_links_on_inserts\":%u,\"neighbors_to_explore_at_insert\":%u,"
+                   "\"target_hits\":%u,\"explore_k\":%u,\"threads\":%u,\"docs\":%u,\"queries\":%u,"
+                   "\"recall\":%.6f,\"qps\":%.1f,\"avg_latency_ms\":%.4f,"
+                   "\"inserts_per_second\":%.1f,\"graph_bytes_per_vector\":%.1f,\"bytes_per_vector\":%.1f}\n",
+                   cfg.max_links_at_level_0(), cfg.max_links_on_inserts(), cfg.neighbors_to_explore_at_construction(),
+                   _k, explore_k, num_threads, _base.size(), num_queries,
+                   total_recall / num_queries, num_queries / search_seconds, 1000.0 * total_latency / num_queries,
+                   _base.size() / insert_seconds, double(memory.usedBytes()) / _base.size(),
+                   double(memory.usedBytes()) / _base.size() + vector_bytes);
+            fflush(stdout);
+        }
+    }
+}
+
+int
+HnswBenchmark::Main()
+{
+    if (!parse_args()) {
+        usage();
+        return 1;
+    }
+    read_vectors(_base, _base_file, _max_base);
+    read_vectors(_queries, _query_file, _max_queries);
+    if (_base.dims() != _queries.dims() || _base.size() == 0 || _queries.size() == 0) {
+        std::cerr << "Base vectors (" << _base.size() << " x " << _base.dims() << ") and query vectors ("
+                  << _queries.size() << " x " << _queries.dims() << ") do not match" << std::endl;
+        return 1;
+    }
+    if (!_ground_truth_file.empty() && (_max_base == 0)) {
+        VectorFile<int32_t> truth;
+        truth.read<int32_t>(_ground_truth_file, _queries.size());
+        _ground_truth.resize(_queries.size());
+        for (uint32_t q = 0; q < truth.size(); ++q) {
+            _ground_truth[q].assign(truth.get(q), truth.get(q) + truth.dims());
+        }
+    } else {
+        // The given ground truth is not valid for a subset of the base vectors.
+        calc_ground_truth(std::max(1u, std::thread::hardware_concurrency()));
+    }
+    LOG(info, "%u base vectors and %u queries with %u dimensions, max links at level 0: %s, neighbors to explore at insert: %s",
+        _base.size(), _queries.size(), _base.dims(), format_list(_max_links_at_level_0).c_str(),
+        format_list(_neighbors_to_explore_at_insert).c_str());
+    for (uint32_t max_links : _max_links_at_level_0) {
+        for (uint32_t neighbors_to_explore : _neighbors_to_explore_at_insert) {
+            run_config(max_links, neighbors_to_explore);
+        }
+    }
+    return 0;
+}
+
+}
+
+int main(int argc, char **argv)
+{
+    HnswBenchmark app;
+    return app.Entry(argc, argv);
+}
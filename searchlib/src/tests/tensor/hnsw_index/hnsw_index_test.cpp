@@ -77,12 +77,13 @@ public:
 
     ~HnswIndexTest() {}
 
-    void init(bool heuristic_select_neighbors) {
+    void init(bool heuristic_select_neighbors, uint32_t min_size_before_quantization = 0) {
         auto generator = std::make_unique<LevelGenerator>();
         level_generator = generator.get();
         index = std::make_unique<HnswIndex>(vectors, std::make_unique<FloatSqEuclideanDistance>(),
                                             std::move(generator),
-                                            HnswIndex::Config(5, 2, 10, 0, heuristic_select_neighbors));
+                                            HnswIndex::Config(5, 2, 10, 0, heuristic_select_neighbors,
+                                                              min_size_before_quantization));
     }
     void add_document(uint32_t docid, uint32_t max_level = 0) {
         level_generator->level = max_level;
@@ -151,6 +152,23 @@ public:
             }
         }
     }
+    void expect_batch_top_k_as_single(uint32_t k, const std::vector<uint32_t>& query_docids) {
+        std::vector<vespalib::tensor::TypedCells> queries;
+        for (uint32_t docid : query_docids) {
+            queries.push_back(vectors.get_vector(docid));
+        }
+        auto batch = index->find_top_k_batch(k, queries, global_filter.get(), k);
+        ASSERT_EQ(queries.size(), batch.size());
+        for (size_t i = 0; i < queries.size(); ++i) {
+            auto single = global_filter ? index->find_top_k_with_filter(k, queries[i], *global_filter, k)
+                                        : index->find_top_k(k, queries[i], k);
+            ASSERT_EQ(single.size(), batch[i].size());
+            for (size_t j = 0; j < single.size(); ++j) {
+                EXPECT_EQ(single[j].docid, batch[i][j].docid);
+                EXPECT_DOUBLE_EQ(single[j].distance, batch[i][j].distance);
+            }
+        }
+    }
 };
 
 
@@ -220,6 +238,57 @@ TEST_F(HnswIndexTest, 2d_vectors_inserted_in_level_0_graph_with_simple_select_ne
     expect_top_3(9, {3, 2});
 }
 
+TEST_F(HnswIndexTest, batch_of_query_vectors_is_searched_in_one_traversal)
+{
+    init(true);
+    add_document(1);
+    add_document(2);
+    add_document(3, 1);
+    add_document(4);
+    add_document(5);
+    add_document(6, 2);
+    add_document(7);
+
+    expect_batch_top_k_as_single(3, {2, 5, 8});
+    expect_batch_top_k_as_single(3, {9});
+    expect_batch_top_k_as_single(2, {4, 6, 7});
+    auto batch = index->find_top_k_batch(3, {}, nullptr, 3);
+    EXPECT_TRUE(batch.empty());
+
+    set_filter({2,3,4,6});
+    expect_batch_top_k_as_single(3, {2, 5, 8});
+    expect_batch_top_k_as_single(2, {7, 9});
+}
+
+TEST_F(HnswIndexTest, quantized_vectors_are_trained_and_search_results_are_reranked_with_exact_distances)
+{
+    init(false, 7);
+
+    add_document(1);
+    add_document(2);
+    add_document(3);
+    add_document(4);
+    add_document(5);
+    EXPECT_FALSE(index->use_quantized_vectors());
+    add_document(6);
+    EXPECT_TRUE(index->use_quantized_vectors());
+    add_document(7);
+
+    expect_top_3(2, {2, 1, 3});
+    expect_top_3(4, {4, 1, 3});
+    expect_top_3(5, {5, 6, 2});
+    expect_top_3(6, {6, 5, 2});
+    expect_top_3(8, {4, 3, 1});
+    expect_top_3(9, {7, 3, 2});
+
+    auto qv = vectors.get_vector(9);
+    auto rv = index->top_k_candidates(qv, 3, nullptr).peek();
+    std::sort(rv.begin(), rv.end(), LesserDistance());
+    ASSERT_EQ(3u, rv.size());
+    EXPECT_DOUBLE_EQ(1.0, rv[0].distance);
+    EXPECT_GT(memory_usage().allocatedBytes(), 0u);
+}
+
 TEST_F(HnswIndexTest, 2d_vectors_inserted_and_removed)
 {
     init(false);
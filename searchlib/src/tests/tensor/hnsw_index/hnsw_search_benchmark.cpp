@@ -0,0 +1,113 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/eval/tensor/dense/typed_cells.h>
+#include <vespa/searchlib/tensor/distance_functions.h>
+#include <vespa/searchlib/tensor/doc_vector_access.h>
+#include <vespa/searchlib/tensor/hnsw_index.h>
+#include <vespa/searchlib/tensor/inv_log_level_generator.h>
+#include <vespa/vespalib/testkit/testapp.h>
+#include <vespa/vespalib/util/benchmark_timer.h>
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include <vespa/log/log.h>
+LOG_SETUP("hnsw_search_benchmark");
+
+using namespace search::tensor;
+using vespalib::BenchmarkTimer;
+
+namespace {
+
+constexpr uint32_t num_dims = 64;
+constexpr uint32_t num_docs = 100000;
+constexpr uint32_t num_queries = 1000;
+
+/**
+ * Vector store where the vectors of consecutive docids are placed at random
+ * locations, so that visiting graph neighbors is dominated by cache misses.
+ */
+class ScatteredVectors : public DocVectorAccess {
+private:
+    std::vector<float> _cells;
+    std::vector<uint32_t> _slots;
+    bool _prefetch;
+    const float *vector_ptr(uint32_t docid) const { return &_cells[size_t(_slots[docid]) * num_dims]; }
+public:
+    ScatteredVectors(std::mt19937& rng)
+        : _cells(size_t(num_docs) * num_dims),
+          _slots(num_docs),
+          _prefetch(false)
+    {
+        std::uniform_real_distribution<float> dist(-1.0, 1.0);
+        for (auto& cell : _cells) {
+            cell = dist(rng);
+        }
+        for (uint32_t i = 0; i < num_docs; ++i) {
+            _slots[i] = i;
+        }
+        std::shuffle(_slots.begin(), _slots.end(), rng);
+    }
+    void set_prefetch(bool value) { _prefetch = value; }
+    vespalib::tensor::TypedCells get_vector(uint32_t docid) const override {
+        return vespalib::tensor::TypedCells(vespalib::ConstArrayRef<float>(vector_ptr(docid), num_dims));
+    }
+    void prefetch_vector(uint32_t docid) const override {
+        if (_prefetch) {
+            __builtin_prefetch(vector_ptr(docid));
+        }
+    }
+};
+
+struct Fixture {
+    std::mt19937 rng;
+    ScatteredVectors vectors;
+    HnswIndex index;
+    std::vector<std::vector<float>> queries;
+    Fixture()
+        : rng(1234),
+          vectors(rng),
+          index(vectors, std::make_unique<SquaredEuclideanDistance<float>>(),
+                std::make_unique<InvLogLevelGenerator>(16), HnswIndex::Config(32, 16, 200, 0, true)),
+          queries()
+    {
+        for (uint32_t docid = 1; docid < num_docs; ++docid) {
+            index.add_document(docid);
+        }
+        std::uniform_real_distribution<float> dist(-1.0, 1.0);
+        queries.resize(num_queries);
+        for (auto& query : queries) {
+            query.resize(num_dims);
+            for (auto& cell : query) {
+                cell = dist(rng);
+            }
+        }
+    }
+    size_t run_queries() {
+        size_t hits = 0;
+        for (const auto& query : queries) {
+            vespalib::ConstArrayRef<float> query_ref(query);
+            vespalib::tensor::TypedCells input(query_ref);
+            hits += index.find_top_k(10, input, 100).size();
+        }
+        return hits;
+    }
+    double benchmark(bool prefetch) {
+        vectors.set_prefetch(prefetch);
+        return BenchmarkTimer::benchmark([this]() { run_queries(); }, 5.0) / num_queries;
+    }
+};
+
+}
+
+TEST_F("benchmark hnsw search with and without vector prefetch", Fixture)
+{
+    double no_prefetch = f.benchmark(false);
+    double prefetch = f.benchmark(true);
+    fprintf(stderr, "no prefetch: %g us/query\n", no_prefetch * 1000000.0);
+    fprintf(stderr, "prefetch: %g us/query\n", prefetch * 1000000.0);
+    fprintf(stderr, "speedup: %g\n", no_prefetch / prefetch);
+    EXPECT_EQUAL(size_t(num_queries) * 10, f.run_queries());
+}
+
+TEST_MAIN() { TEST_RUN_ALL(); }
@@ -105,7 +105,11 @@ public:
     void load_copy(std::vector<char> data) {
         HnswIndexLoader loader(copy);
         LoadedBuffer buffer(&data[0], data.size());
-        loader.load(buffer);
+        EXPECT_TRUE(loader.load(buffer));
+    }
+    void map_copy(std::vector<char>& data) {
+        HnswIndexLoader loader(copy);
+        EXPECT_TRUE(loader.load(std::make_unique<LoadedBuffer>(&data[0], data.size())));
     }
 
     void expect_copy_as_populated() const {
@@ -148,4 +152,75 @@ TEST_F(CopyGraphTest, later_changes_ignored)
     expect_copy_as_populated();
 }
 
+TEST_F(CopyGraphTest, reconstructs_graph_from_legacy_format)
+{
+    V words = {2, 1, 7,
+               0,
+               1, 3, 2, 4, 6,
+               2, 3, 1, 4, 6, 1, 4,
+               0,
+               2, 3, 1, 2, 6, 1, 2,
+               0,
+               1, 3, 1, 2, 4};
+    std::vector<char> data(reinterpret_cast<const char *>(&words[0]),
+                           reinterpret_cast<const char *>(&words[0] + words.size()));
+    load_copy(data);
+    expect_copy_as_populated();
+}
+
+TEST_F(CopyGraphTest, serves_graph_from_mapped_buffer)
+{
+    populate(original);
+    auto data = save_original();
+    map_copy(data);
+    ASSERT_TRUE(copy.mapped);
+    EXPECT_TRUE(copy.is_mapped(1));
+    EXPECT_FALSE(copy.is_mapped(3));
+    expect_copy_as_populated();
+    auto links = copy.get_link_array(1, 0);
+    EXPECT_GE(reinterpret_cast<const char *>(links.cbegin()), &data[0]);
+    EXPECT_LT(reinterpret_cast<const char *>(links.cbegin()), &data[0] + data.size());
+}
+
+TEST_F(CopyGraphTest, mapped_graph_is_copied_on_write)
+{
+    populate(original);
+    auto data = save_original();
+    map_copy(data);
+    copy.set_link_array(2, 0, V{1, 4});
+    EXPECT_FALSE(copy.is_mapped(2));
+    EXPECT_TRUE(copy.is_mapped(4));
+    expect_level_0(2, {1, 4});
+    expect_level_1(2, {4});
+    copy.remove_node_for_document(6);
+    EXPECT_FALSE(copy.is_mapped(6));
+    expect_empty_d(6);
+    copy.make_node_for_document(6, 1);
+    expect_level_0(6, {});
+    expect_level_0(1, {2, 4, 6});
+}
+
+TEST_F(CopyGraphTest, mapped_graph_can_be_saved)
+{
+    populate(original);
+    auto data = save_original();
+    HnswGraph mapped_graph;
+    HnswIndexLoader loader(mapped_graph);
+    ASSERT_TRUE(loader.load(std::make_unique<LoadedBuffer>(&data[0], data.size())));
+    mapped_graph.set_link_array(1, 0, V{2, 4, 6});
+    HnswIndexSaver saver(mapped_graph);
+    VectorBufferWriter vector_writer;
+    saver.save(vector_writer);
+    EXPECT_EQ(data, vector_writer.output);
+}
+
+TEST_F(CopyGraphTest, malformed_mapped_buffer_is_rejected)
+{
+    populate(original);
+    auto data = save_original();
+    data.resize(data.size() / 2);
+    HnswIndexLoader loader(copy);
+    EXPECT_FALSE(loader.load(std::make_unique<LoadedBuffer>(&data[0], data.size())));
+}
+
 GTEST_MAIN_RUN_ALL_TESTS()
@@ -624,7 +624,7 @@ TEST("test sending a lot of data") {
     {
         DummyFileHeaderContext fileHeaderContext;
         TransLogServer tlss("test8", 18377, ".", fileHeaderContext, DomainConfig().setPartSizeLimit(0x80000)
-                .setChunkAgeLimit(100us));
+                .setChunkAgeLimit(100us).setPreallocateSize(0x100000).setDropSyncedFromCache(true));
         TransLogClient tls("tcp/localhost:18377");
 
         createDomainTest(tls, MANY, 0);
@@ -858,6 +858,38 @@ TEST("testSync") {
     EXPECT_EQUAL(syncedTo, TOTAL_NUM_ENTRIES);
 }
 
+TEST("test group commit syncs batches of commits") {
+    const unsigned int NUM_PACKETS = 100;
+    const unsigned int NUM_ENTRIES = 10;
+    const unsigned int TOTAL_NUM_ENTRIES = NUM_PACKETS * NUM_ENTRIES;
+    const vespalib::string GROUP("group");
+
+    DummyFileHeaderContext fileHeaderContext;
+    TransLogServer tlss("test14", 18377, ".", fileHeaderContext, DomainConfig().setPartSizeLimit(0x1000000)
+            .setGroupCommitLatency(5ms));
+    TransLogClient tls("tcp/localhost:18377");
+
+    createDomainTest(tls, GROUP, 0);
+    auto s1 = openDomainTest(tls, GROUP);
+    fillDomainTest(tlss, GROUP, NUM_PACKETS, NUM_ENTRIES);
+    SerialNum b(0), e(0);
+    size_t c(0);
+    EXPECT_TRUE(s1->status(b, e, c));
+    EXPECT_EQUAL(b, 1u);
+    EXPECT_EQUAL(e, TOTAL_NUM_ENTRIES);
+    EXPECT_EQUAL(c, TOTAL_NUM_ENTRIES);
+    SerialNum syncedTo(0);
+    EXPECT_TRUE(s1->sync(2, syncedTo));
+    EXPECT_EQUAL(syncedTo, TOTAL_NUM_ENTRIES);
+
+    DomainInfo info = tlss.getDomainStats()[GROUP];
+    LOG(info, "%zu commits in %zu batches, sync time %1.4f", info.numBatchedCommits, info.numCommitBatches,
+        info.batchSyncTime.count());
+    EXPECT_LESS_EQUAL(NUM_PACKETS, info.numBatchedCommits);
+    EXPECT_LESS(info.numCommitBatches, info.numBatchedCommits);
+    EXPECT_LESS(0u, info.numCommitBatches);
+}
+
 TEST("test truncate on version mismatch") {
     const unsigned int NUM_PACKETS = 3;
     const unsigned int NUM_ENTRIES = 4;
@@ -47,6 +47,7 @@ IMPLEMENT_AGGREGATIONRESULT(AverageAggregationResult, AggregationResult);
 IMPLEMENT_AGGREGATIONRESULT(XorAggregationResult,     AggregationResult);
 IMPLEMENT_AGGREGATIONRESULT(ExpressionCountAggregationResult, AggregationResult);
 IMPLEMENT_AGGREGATIONRESULT(StandardDeviationAggregationResult, AggregationResult);
+IMPLEMENT_AGGREGATIONRESULT(QuantileAggregationResult, AggregationResult);
 
 AggregationResult::AggregationResult() :
     _expressionTree(std::make_shared<ExpressionTree>()),
@@ -637,6 +638,81 @@ StandardDeviationAggregationResult::visitMembers(vespalib::ObjectVisitor &visito
     visit(visitor, "sumOfSquared", _sumOfSquared);
 }
 
+
+QuantileAggregationResult::QuantileAggregationResult()
+    : AggregationResult(), _quantiles(), _sketch(), _rank()
+{
+}
+
+QuantileAggregationResult::~QuantileAggregationResult() = default;
+
+const ResultNode &
+QuantileAggregationResult::onGetRank() const
+{
+    _rank.set(FloatResultNode(_quantiles.empty() ? 0.0 : _sketch.quantile(_quantiles[0])));
+    return _rank;
+}
+
+void
+QuantileAggregationResult::onMerge(const AggregationResult &r)
+{
+    const auto & result = Identifiable::cast<const QuantileAggregationResult &>(r);
+    _sketch.merge(result._sketch);
+}
+
+void
+QuantileAggregationResult::onAggregate(const ResultNode &result)
+{
+    if (result.isMultiValue()) {
+        const auto & values = static_cast<const ResultNodeVector &>(result);
+        for (size_t i(0), m(values.size()); i < m; i++) {
+            _sketch.add(values.get(i).getFloat());
+        }
+    } else {
+        _sketch.add(result.getFloat());
+    }
+}
+
+void
+QuantileAggregationResult::onReset()
+{
+    _sketch.clear();
+}
+
+Serializer &
+QuantileAggregationResult::onSerialize(Serializer & os) const
+{
+    AggregationResult::onSerialize(os);
+    os << static_cast<uint32_t>(_quantiles.size());
+    for (double q : _quantiles) {
+        os << q;
+    }
+    _sketch.serialize(os);
+    return os;
+}
+
+Deserializer &
+QuantileAggregationResult::onDeserialize(Deserializer & is)
+{
+    AggregationResult::onDeserialize(is);
+    uint32_t numQuantiles = 0;
+    is >> numQuantiles;
+    _quantiles.resize(numQuantiles);
+    for (double &q : _quantiles) {
+        is >> q;
+    }
+    _sketch.deserialize(is);
+    return is;
+}
+
+void
+QuantileAggregationResult::visitMembers(vespalib::ObjectVisitor &visitor) const
+{
+    AggregationResult::visitMembers(visitor);
+    visit(visitor, "quantiles", _quantiles);
+    visit(visitor, "count", _sketch.getCount());
+}
+
 }
 
 // this function was added by ../../forcelink.sh
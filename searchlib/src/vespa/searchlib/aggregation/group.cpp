@@ -99,21 +99,22 @@ Group::Value::groupSingle(const ResultNode & selectResult, HitRank rank, const G
 {
     if (_childInfo._childMap == nullptr) {
         assert(getChildrenSize() == 0);
-        _childInfo._childMap = new GroupHash(1, GroupHasher(&_children), GroupEqual(&_children));
+        _childInfo._childMap = new GroupHash(1, GroupHasher(), GroupEqual(&_children));
     }
     GroupHash & childMap = *_childInfo._childMap;
     Group * group(nullptr);
-    GroupHash::iterator found = childMap.find(selectResult);
+    GroupProbe probe(selectResult);
+    GroupHash::iterator found = childMap.find(probe);
     if (found == childMap.end()) { // group not present in child map
         if (level.allowMoreGroups(childMap.size())) {
             group = new Group(level.getGroupPrototype());
             group->setId(selectResult);
             group->setRank(rank);
             addChild(group);
-            childMap.insert(getChildrenSize() - 1);
+            childMap.insert(GroupRef(getChildrenSize() - 1, probe._hash));
         }
     } else {
-        group = _children[(*found)];
+        group = _children[found->_index];
         if ( ! level.isFrozen()) {
             group->updateRank(rank);
         }
@@ -317,11 +318,11 @@ void
 Group::Value::preAggregate()
 {
     assert(_childInfo._childMap == nullptr);
-    _childInfo._childMap = new GroupHash(getChildrenSize()*2, GroupHasher(&_children), GroupEqual(&_children));
+    _childInfo._childMap = new GroupHash(getChildrenSize()*2, GroupHasher(), GroupEqual(&_children));
     GroupHash & childMap = *_childInfo._childMap;
     for (ChildP *it(_children), *mt(_children + getChildrenSize()); it != mt; ++it) {
         (*it)->preAggregate();
-        childMap.insert(it - _children);
+        childMap.insert(GroupRef(it - _children, (*it)->getId().hash()));
     }
 }
 
@@ -39,21 +39,35 @@ public:
     using UP = std::unique_ptr<Group>;
     typedef Group * ChildP;
     typedef ChildP * GroupList;
-    struct GroupEqual : public std::binary_function<ChildP, ChildP, bool> {
+    /**
+     * Entry in the child map used during aggregation. The hash of the
+     * group id is kept with the child index, so growing the map does not
+     * rehash ids, and ids are only compared when their hashes match.
+     **/
+    struct GroupRef {
+        GroupRef() : _index(0), _hash(0) { }
+        GroupRef(uint32_t index, uint32_t hash) : _index(index), _hash(hash) { }
+        uint32_t _index;
+        uint32_t _hash;
+    };
+    struct GroupProbe {
+        GroupProbe(const ResultNode & id) : _id(id), _hash(id.hash()) { }
+        const ResultNode & _id;
+        uint32_t           _hash;
+    };
+    struct GroupEqual {
         GroupEqual(const GroupList * v) : _v(v) { }
-        bool operator()(uint32_t a, uint32_t b) { return (*_v)[a]->getId().cmpFast((*_v)[b]->getId()) == 0; }
-        bool operator()(const Group & a, uint32_t b) { return a.getId().cmpFast((*_v)[b]->getId()) == 0; }
-        bool operator()(uint32_t a, const Group & b) { return (*_v)[a]->getId().cmpFast(b.getId()) == 0; }
-        bool operator()(const ResultNode & a, uint32_t b) { return a.cmpFast((*_v)[b]->getId()) == 0; }
-        bool operator()(uint32_t a, const ResultNode & b) { return (*_v)[a]->getId().cmpFast(b) == 0; }
+        bool operator()(const GroupRef & a, const GroupRef & b) const {
+            return (a._hash == b._hash) && ((*_v)[a._index]->getId().cmpFast((*_v)[b._index]->getId()) == 0);
+        }
+        bool operator()(const GroupRef & a, const GroupProbe & b) const {
+            return (a._hash == b._hash) && ((*_v)[a._index]->getId().cmpFast(b._id) == 0);
+        }
         const GroupList *_v;
     };
     struct GroupHasher {
-        GroupHasher(const GroupList * v) : _v(v) { }
-        size_t operator() (uint32_t arg) const { return (*_v)[arg]->getId().hash(); }
-        size_t operator() (const Group & arg) const { return arg.getId().hash(); }
-        size_t operator() (const ResultNode & arg) const { return arg.hash(); }
-        const GroupList *_v;
+        size_t operator() (const GroupRef & arg) const { return arg._hash; }
+        size_t operator() (const GroupProbe & arg) const { return arg._hash; }
     };
 
     using GroupingLevelList = std::vector<GroupingLevel>;
@@ -118,7 +132,7 @@ private:
     private:
 
         using  ExpressionVector = ExpressionNode::CP *;
-        using GroupHash = vespalib::hash_set<uint32_t, GroupHasher, GroupEqual >;
+        using GroupHash = vespalib::hash_set<GroupRef, GroupHasher, GroupEqual >;
         void setAggrSize(uint32_t v)    { _packedLength = (_packedLength & ~0x0f) | v; }
         void setExprSize(uint32_t v)    { _packedLength = (_packedLength & ~0x30) | (v << 4); }
         void setOrderBySize(uint32_t v) { _packedLength = (_packedLength & ~0xc0) | (v << 6); }
@@ -0,0 +1,38 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#pragma once
+
+#include "aggregationresult.h"
+#include <vespa/searchlib/grouping/quantile_sketch.h>
+#include <vespa/searchlib/expression/floatresultnode.h>
+
+namespace search::aggregation {
+
+/**
+ * Estimates quantiles (like p50 and p99) of an expression. This class
+ * keeps a mergeable sketch of bounded size, so partial results can be
+ * merged across match threads and content nodes without collecting
+ * the values. The rank is the estimate of the first requested quantile.
+ */
+class QuantileAggregationResult : public AggregationResult
+{
+public:
+    DECLARE_AGGREGATIONRESULT(QuantileAggregationResult);
+    QuantileAggregationResult();
+    ~QuantileAggregationResult();
+
+    QuantileAggregationResult &addQuantile(double q) { _quantiles.push_back(q); return *this; }
+    const std::vector<double> &getQuantiles() const { return _quantiles; }
+    double getQuantile(double q) const { return _sketch.quantile(q); }
+    const QuantileSketch &getSketch() const { return _sketch; }
+
+    void visitMembers(vespalib::ObjectVisitor &visitor) const override;
+private:
+    const ResultNode &onGetRank() const override;
+    void onPrepare(const ResultNode &, bool) override { }
+
+    std::vector<double>                 _quantiles;
+    QuantileSketch                      _sketch;
+    mutable expression::FloatResultNode _rank;
+};
+
+}
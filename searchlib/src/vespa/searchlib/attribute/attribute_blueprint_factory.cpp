@@ -23,6 +23,7 @@
 #include <vespa/searchlib/queryeval/emptysearch.h>
 #include <vespa/searchlib/queryeval/field_spec.hpp>
 #include <vespa/searchlib/queryeval/filter_wrapper.h>
+#include <vespa/searchlib/queryeval/flat_posting_merger.h>
 #include <vespa/searchlib/queryeval/get_weight_from_node.h>
 #include <vespa/searchlib/queryeval/intermediate_blueprints.h>
 #include <vespa/searchlib/queryeval/leaf_blueprints.h>
@@ -298,11 +299,26 @@ make_location_blueprint(const FieldSpec &field, const IAttributeVector &attribut
     {
         return std::make_unique<queryeval::EmptyBlueprint>(field);
     }
-    ZCurve::RangeVector rangeVector = ZCurve::find_ranges(
-            location.bounding_box.x.low,
-            location.bounding_box.y.low,
-            location.bounding_box.x.high,
-            location.bounding_box.y.high);
+    ZCurve::RangeVector rangeVector;
+    if (location.has_point && location.has_radius()) {
+        // cover the circle instead of its bounding box, so that
+        // fewer documents just outside the radius need post filtering
+        rangeVector = ZCurve::find_ranges(
+                location.bounding_box.x.low,
+                location.bounding_box.y.low,
+                location.bounding_box.x.high,
+                location.bounding_box.y.high,
+                [&location](const ZCurve::Area &area) {
+                    return !location.may_be_inside_limit(common::GeoLocation::Box{
+                                {area.min.x, area.max.x}, {area.min.y, area.max.y}});
+                });
+    } else {
+        rangeVector = ZCurve::find_ranges(
+                location.bounding_box.x.low,
+                location.bounding_box.y.low,
+                location.bounding_box.x.high,
+                location.bounding_box.y.high);
+    }
     auto pre_filter = std::make_unique<LocationPreFilterBlueprint>(field, attribute, rangeVector);
     if (!pre_filter->should_use()) {
         LOG(debug, "only use post filter");
@@ -371,7 +387,8 @@ public:
         for (const IDocumentWeightAttribute::LookupResult &r : _terms) {
             _attr.create(r.posting_idx, iterators);
         }
-        return SearchType::create(*tfmda[0], _weights, std::move(iterators));
+        return SearchType::create(*tfmda[0], _weights, std::move(iterators),
+                                  queryeval::FlatPostingMergerBase::should_use(numChildren));
     }
 
     std::unique_ptr<SearchIterator> createFilterSearch(bool strict, FilterConstraint constraint) const override;
@@ -537,6 +554,26 @@ is_compatible_for_nearest_neighbor(const vespalib::eval::ValueType& lhs,
     return (lhs.dimensions() == rhs.dimensions());
 }
 
+/**
+ * A batch of query points has one extra indexed dimension in addition to the attribute tensor dimension.
+ */
+bool
+is_compatible_for_batch_nearest_neighbor(const vespalib::eval::ValueType& lhs,
+                                         const vespalib::eval::ValueType& rhs)
+{
+    if ((lhs.dimensions().size() != 1) || (rhs.dimensions().size() != 2)) {
+        return false;
+    }
+    const auto& vector_dim = lhs.dimensions()[0];
+    for (size_t i = 0; i < 2; ++i) {
+        const auto& batch_dim = rhs.dimensions()[1 - i];
+        if ((rhs.dimensions()[i] == vector_dim) && batch_dim.is_indexed() && (batch_dim.name != vector_dim.name)) {
+            return true;
+        }
+    }
+    return false;
+}
+
 //-----------------------------------------------------------------------------
 
 
@@ -729,7 +766,8 @@ public:
             return fail_nearest_neighbor_term(n, make_string("Query tensor is not a dense tensor (type=%s)",
                                                              query_tensor->type().to_spec().c_str()));
         }
-        if (!is_compatible_for_nearest_neighbor(dense_attr_tensor->getTensorType(), dense_query_tensor->type())) {
+        if (!is_compatible_for_nearest_neighbor(dense_attr_tensor->getTensorType(), dense_query_tensor->type()) &&
+            !is_compatible_for_batch_nearest_neighbor(dense_attr_tensor->getTensorType(), dense_query_tensor->type())) {
             return fail_nearest_neighbor_term(n, make_string("Attribute tensor type (%s) and query tensor type (%s) are not compatible",
                                                              dense_attr_tensor->getTensorType().to_spec().c_str(), dense_query_tensor->type().to_spec().c_str()));
         }
@@ -740,7 +778,8 @@ public:
                                                                         n.get_target_num_hits(),
                                                                         n.get_allow_approximate(),
                                                                         n.get_explore_additional_hits(),
-                                                                        getRequestContext().get_attribute_blueprint_params().nearest_neighbor_brute_force_limit));
+                                                                        getRequestContext().get_attribute_blueprint_params().nearest_neighbor_brute_force_limit,
+                                                                        getRequestContext().get_attribute_blueprint_params().nearest_neighbor_extended_exploration_limit));
     }
 };
 
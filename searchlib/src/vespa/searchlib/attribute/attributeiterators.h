@@ -7,6 +7,7 @@
 #include <vespa/searchlib/queryeval/searchiterator.h>
 #include <vespa/searchlib/fef/termfieldmatchdata.h>
 #include <vespa/searchcommon/attribute/i_search_context.h>
+#include <limits>
 
 namespace search {
 
@@ -165,6 +166,73 @@ public:
     { }
 };
 
+/**
+ * Helper for strict iterators scanning a search context that can
+ * match a block of 64 consecutive documents at a time (matchBlock),
+ * which lets the compiler vectorize the value comparisons. The hit
+ * mask of the current block is kept between seeks.
+ */
+class BlockScanner
+{
+public:
+    static constexpr uint32_t block_size = 64;
+private:
+    uint32_t _block;
+    uint64_t _mask;
+public:
+    BlockScanner() : _block(std::numeric_limits<uint32_t>::max()), _mask(0) { }
+    // Returns the first matching document in [docId, endId), or endId if none
+    template <typename SC>
+    uint32_t next(const SC &sc, uint32_t docId, uint32_t endId);
+    template <typename SC>
+    std::unique_ptr<BitVector> get_hits(const SC &sc, uint32_t begin_id, uint32_t docId, uint32_t endId);
+};
+
+/**
+ * Strict iterator using a BlockScanner to find the next hit.
+ *
+ * @param SC the specialized search context type associated with this iterator
+ */
+template <typename SC>
+class AttributeIteratorScanStrict : public AttributeIteratorT<SC>
+{
+private:
+    using AttributeIteratorT<SC>::_concreteSearchCtx;
+    using AttributeIteratorT<SC>::setDocId;
+    using AttributeIteratorT<SC>::setAtEnd;
+    using AttributeIteratorT<SC>::isAtEnd;
+    using Trinary=vespalib::Trinary;
+    BlockScanner _scanner;
+    void doSeek(uint32_t docId) override;
+    std::unique_ptr<BitVector> get_hits(uint32_t begin_id) override;
+    Trinary is_strict() const override { return Trinary::True; }
+public:
+    AttributeIteratorScanStrict(const SC &concreteSearchCtx, fef::TermFieldMatchData * matchData)
+        : AttributeIteratorT<SC>(concreteSearchCtx, matchData),
+          _scanner()
+    { }
+};
+
+template <typename SC>
+class FilterAttributeIteratorScanStrict : public FilterAttributeIteratorT<SC>
+{
+private:
+    using FilterAttributeIteratorT<SC>::_concreteSearchCtx;
+    using FilterAttributeIteratorT<SC>::setDocId;
+    using FilterAttributeIteratorT<SC>::setAtEnd;
+    using FilterAttributeIteratorT<SC>::isAtEnd;
+    using Trinary=vespalib::Trinary;
+    BlockScanner _scanner;
+    void doSeek(uint32_t docId) override;
+    std::unique_ptr<BitVector> get_hits(uint32_t begin_id) override;
+    Trinary is_strict() const override { return Trinary::True; }
+public:
+    FilterAttributeIteratorScanStrict(const SC &concreteSearchCtx, fef::TermFieldMatchData *matchData)
+        : FilterAttributeIteratorT<SC>(concreteSearchCtx, matchData),
+          _scanner()
+    { }
+};
+
 /**
  * This class acts as an iterator over documents that are results for
  * the subquery represented by the search context object associated
@@ -224,6 +292,8 @@ private:
     std::unique_ptr<BitVector> get_hits(uint32_t begin_id) override;
     void or_hits_into(BitVector &result, uint32_t begin_id) override;
     void and_hits_into(BitVector &result, uint32_t begin_id) override;
+    uint32_t fill_docid_block(uint32_t begin_id, uint32_t *docids, uint32_t max_docids) override;
+    bool has_fast_docid_block() const override { return true; }
 
 public:
     template <typename... Args>
@@ -242,6 +312,8 @@ public:
     std::unique_ptr<BitVector> get_hits(uint32_t begin_id) override;
     void or_hits_into(BitVector &result, uint32_t begin_id) override;
     void and_hits_into(BitVector &result, uint32_t begin_id) override;
+    uint32_t fill_docid_block(uint32_t begin_id, uint32_t *docids, uint32_t max_docids) override;
+    bool has_fast_docid_block() const override { return true; }
 
 private:
     queryeval::MinMaxPostingInfo           _postingInfo;
@@ -158,6 +158,16 @@ void or_hits_helper(BitVector& result, PL& iterator, uint32_t end_id)
                                });
     iterator = end_itr;
 }
+
+template <typename PL>
+uint32_t fill_docid_block_helper(PL& iterator, uint32_t end_id, uint32_t *docids, uint32_t max_docids)
+{
+    uint32_t num_docids = 0;
+    for (; (num_docids < max_docids) && iterator.valid() && (iterator.getKey() < end_id); ++iterator) {
+        docids[num_docids++] = iterator.getKey();
+    }
+    return num_docids;
+}
  
 }
 
@@ -198,6 +208,20 @@ AttributePostingListIteratorT<PL>::and_hits_into(BitVector &result, uint32_t beg
     result.andWith(*get_hits(begin_id));
 }
 
+template <typename PL>
+uint32_t
+AttributePostingListIteratorT<PL>::fill_docid_block(uint32_t begin_id, uint32_t *docids, uint32_t max_docids)
+{
+    seek(begin_id);
+    uint32_t num_docids = fill_docid_block_helper(_iterator, getEndId(), docids, max_docids);
+    if (_iterator.valid()) {
+        setDocId(_iterator.getKey());
+    } else {
+        setAtEnd();
+    }
+    return num_docids;
+}
+
 template <typename PL>
 std::unique_ptr<BitVector>
 FilterAttributePostingListIteratorT<PL>::get_hits(uint32_t begin_id) {
@@ -236,6 +260,20 @@ FilterAttributePostingListIteratorT<PL>::and_hits_into(BitVector &result, uint32
     result.andWith(*get_hits(begin_id));
 }
 
+template <typename PL>
+uint32_t
+FilterAttributePostingListIteratorT<PL>::fill_docid_block(uint32_t begin_id, uint32_t *docids, uint32_t max_docids)
+{
+    seek(begin_id);
+    uint32_t num_docids = fill_docid_block_helper(_iterator, getEndId(), docids, max_docids);
+    if (_iterator.valid()) {
+        setDocId(_iterator.getKey());
+    } else {
+        setAtEnd();
+    }
+    return num_docids;
+}
+
 template <typename PL>
 void
 FilterAttributePostingListIteratorT<PL>::doSeek(uint32_t docId)
@@ -456,6 +494,83 @@ FilterAttributeIteratorStrict<SC>::doSeek(uint32_t docId)
     setAtEnd();
 }
 
+template <typename SC>
+uint32_t
+BlockScanner::next(const SC &sc, uint32_t docId, uint32_t endId)
+{
+    while (docId < endId) {
+        uint32_t block = docId & ~(block_size - 1);
+        if (block + block_size > endId) {
+            // last partial block
+            for (; docId < endId; ++docId) {
+                if (sc.find(docId, 0) >= 0) {
+                    return docId;
+                }
+            }
+            break;
+        }
+        if (block != _block) {
+            _mask = sc.matchBlock(block);
+            _block = block;
+        }
+        uint64_t mask = _mask & (std::numeric_limits<uint64_t>::max() << (docId - block));
+        if (mask != 0) {
+            return block + __builtin_ctzll(mask);
+        }
+        docId = block + block_size;
+    }
+    return endId;
+}
+
+template <typename SC>
+std::unique_ptr<BitVector>
+BlockScanner::get_hits(const SC &sc, uint32_t begin_id, uint32_t docId, uint32_t endId)
+{
+    BitVector::UP result = BitVector::create(begin_id, endId);
+    for (docId = next(sc, std::max(begin_id, docId), endId); docId < endId; docId = next(sc, docId + 1, endId)) {
+        result->setBit(docId);
+    }
+    result->invalidateCachedCount();
+    return result;
+}
+
+template <typename SC>
+void
+AttributeIteratorScanStrict<SC>::doSeek(uint32_t docId)
+{
+    uint32_t nextId = _scanner.next(_concreteSearchCtx, docId, this->getEndId());
+    if (!isAtEnd(nextId)) {
+        this->matches(nextId, this->_weight);
+        setDocId(nextId);
+    } else {
+        setAtEnd();
+    }
+}
+
+template <typename SC>
+BitVector::UP
+AttributeIteratorScanStrict<SC>::get_hits(uint32_t begin_id) {
+    return _scanner.get_hits(_concreteSearchCtx, begin_id, this->getDocId(), this->getEndId());
+}
+
+template <typename SC>
+void
+FilterAttributeIteratorScanStrict<SC>::doSeek(uint32_t docId)
+{
+    uint32_t nextId = _scanner.next(_concreteSearchCtx, docId, this->getEndId());
+    if (!isAtEnd(nextId)) {
+        setDocId(nextId);
+    } else {
+        setAtEnd();
+    }
+}
+
+template <typename SC>
+BitVector::UP
+FilterAttributeIteratorScanStrict<SC>::get_hits(uint32_t begin_id) {
+    return _scanner.get_hits(_concreteSearchCtx, begin_id, this->getDocId(), this->getEndId());
+}
+
 template <typename SC>
 void
 AttributeIteratorT<SC>::or_hits_into(BitVector & result, uint32_t begin_id) {
@@ -21,6 +21,7 @@
 #include <vespa/searchlib/query/query_term_decoder.h>
 #include <vespa/searchlib/queryeval/emptysearch.h>
 #include <vespa/vespalib/util/exceptions.h>
+#include <vespa/vespalib/util/mmap_file_allocator.h>
 #include <vespa/searchlib/util/logutil.h>
 
 #include <vespa/log/log.h>
@@ -372,8 +373,13 @@ AttributeVector::isEnumeratedSaveFormat() const
 
 bool
 AttributeVector::load() {
+    return load(nullptr);
+}
+
+bool
+AttributeVector::load(vespalib::Executor * executor) {
     assert(!_loaded);
-    bool loaded = onLoad();
+    bool loaded = onLoad(executor);
     if (loaded) {
         commit();
     }
@@ -381,7 +387,7 @@ AttributeVector::load() {
     return _loaded;
 }
 
-bool AttributeVector::onLoad() { return false; }
+bool AttributeVector::onLoad(vespalib::Executor *) { return false; }
 int32_t AttributeVector::getWeight(DocId, uint32_t) const { return 1; }
 
 bool AttributeVector::findEnum(const char *, EnumHandle &) const { return false; }
@@ -509,6 +515,18 @@ AttributeVector::performCompactionWarning()
         _genHandler.getCurrentGeneration());
 }
 
+std::unique_ptr<vespalib::alloc::MemoryAllocator>
+AttributeVector::make_memory_allocator() const
+{
+    if (getConfig().paged()) {
+        return vespalib::alloc::MmapFileAllocatorFactory::instance().make_memory_allocator(getName());
+    }
+    if (getConfig().huge_page_policy() != vespalib::alloc::HugePagePolicy::DEFAULT) {
+        return vespalib::alloc::MemoryAllocator::make_auto_allocator(getConfig().huge_page_policy());
+    }
+    return {};
+}
+
 
 void
 AttributeVector::addReservedDoc()
@@ -37,6 +37,7 @@ namespace document {
 
 namespace vespalib {
     class GenericHeader;
+    class Executor;
 }
 
 namespace search {
@@ -169,6 +170,13 @@ protected:
 
     void performCompactionWarning();
 
+    /**
+     * Returns an allocator using a memory mapped file if this attribute is configured as paged,
+     * an allocator using the configured huge page policy if one is set,
+     * otherwise an empty pointer (use the default allocator).
+     */
+    std::unique_ptr<vespalib::alloc::MemoryAllocator> make_memory_allocator() const;
+
     void getByType(DocId doc, const char *&v) const {
         char tmp[1024]; v = getString(doc, tmp, sizeof(tmp));
     }
@@ -447,6 +455,12 @@ public:
 
     bool isEnumeratedSaveFormat() const;
     bool load();
+    /**
+     * Loads this attribute vector. The given executor (if any) can be used
+     * by the attribute to parallelize parts of the load, e.g. rebuilding of
+     * auxiliary structures.
+     */
+    bool load(vespalib::Executor * executor);
     void commit(bool forceStatUpdate = false);
     void commit(uint64_t firstSyncToken, uint64_t lastSyncToken);
     void setCreateSerialNum(uint64_t createSerialNum);
@@ -569,7 +583,7 @@ private:
     virtual bool applyWeight(DocId doc, const FieldValue &fv, const ArithmeticValueUpdate &wAdjust);
     virtual bool applyWeight(DocId doc, const FieldValue& fv, const document::AssignValueUpdate& wAdjust);
     virtual void onSave(IAttributeSaveTarget & saveTarget);
-    virtual bool onLoad();
+    virtual bool onLoad(vespalib::Executor *executor);
 
 
     BaseName                              _baseFileName;
@@ -3,14 +3,22 @@
 #include "bitvector_search_cache.h"
 #include <vespa/searchlib/common/bitvector.h>
 #include <vespa/vespalib/stllike/hash_map.hpp>
+#include <vector>
 
 namespace search::attribute {
 
 using BitVectorSP = BitVectorSearchCache::BitVectorSP;
 
+size_t
+BitVectorSearchCache::Entry::memoryUsage() const
+{
+    return (bitVector ? bitVector->getFileBytes() : 0);
+}
+
 BitVectorSearchCache::BitVectorSearchCache()
     : _mutex(),
-      _cache()
+      _cache(),
+      _memoryUsage(0)
 {
 }
 
@@ -22,7 +30,10 @@ void
 BitVectorSearchCache::insert(const vespalib::string &term, Entry::SP entry)
 {
     LockGuard guard(_mutex);
-    _cache.insert(std::make_pair(term, std::move(entry)));
+    size_t bytes = entry->memoryUsage();
+    if (_cache.insert(std::make_pair(term, std::move(entry))).second) {
+        _memoryUsage += bytes;
+    }
 }
 
 BitVectorSearchCache::Entry::SP
@@ -36,6 +47,17 @@ BitVectorSearchCache::find(const vespalib::string &term) const
     return Entry::SP();
 }
 
+void
+BitVectorSearchCache::erase(const vespalib::string &term)
+{
+    LockGuard guard(_mutex);
+    auto itr = _cache.find(term);
+    if (itr != _cache.end()) {
+        _memoryUsage -= itr->second->memoryUsage();
+        _cache.erase(itr);
+    }
+}
+
 size_t
 BitVectorSearchCache::size() const
 {
@@ -43,11 +65,36 @@ BitVectorSearchCache::size() const
     return _cache.size();
 }
 
+size_t
+BitVectorSearchCache::memoryUsage() const
+{
+    LockGuard guard(_mutex);
+    return _memoryUsage;
+}
+
 void
 BitVectorSearchCache::clear()
 {
     LockGuard guard(_mutex);
     _cache.clear();
+    _memoryUsage = 0;
+}
+
+void
+BitVectorSearchCache::removeOlderThan(vespalib::steady_time limit)
+{
+    LockGuard guard(_mutex);
+    std::vector<vespalib::string> old;
+    for (const auto &elem : _cache) {
+        if (elem.second->created < limit) {
+            old.push_back(elem.first);
+        }
+    }
+    for (const auto &term : old) {
+        auto itr = _cache.find(term);
+        _memoryUsage -= itr->second->memoryUsage();
+        _cache.erase(itr);
+    }
 }
 
 }
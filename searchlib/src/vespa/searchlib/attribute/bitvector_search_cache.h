@@ -5,6 +5,7 @@
 #include <vespa/searchlib/common/i_document_meta_store_context.h>
 #include <vespa/vespalib/stllike/hash_map.h>
 #include <vespa/vespalib/stllike/string.h>
+#include <vespa/vespalib/util/time.h>
 #include <memory>
 #include <mutex>
 
@@ -17,7 +18,8 @@ namespace attribute {
 /**
  * Class that caches posting lists (as bit vectors) for a set of search terms.
  *
- * Lifetime of cached bit vectors is controlled by calling clear() at regular intervals.
+ * Lifetime of cached bit vectors is controlled by calling clear() at regular intervals,
+ * or by removing entries older than a given time.
  */
 class BitVectorSearchCache {
 public:
@@ -31,8 +33,12 @@ public:
         ReadGuardUP dmsReadGuard;
         BitVectorSP bitVector;
         uint32_t docIdLimit;
-        Entry(ReadGuardUP dmsReadGuard_, BitVectorSP bitVector_, uint32_t docIdLimit_)
-            : dmsReadGuard(std::move(dmsReadGuard_)), bitVector(std::move(bitVector_)), docIdLimit(docIdLimit_) {}
+        vespalib::steady_time created;
+        Entry(ReadGuardUP dmsReadGuard_, BitVectorSP bitVector_, uint32_t docIdLimit_,
+              vespalib::steady_time created_ = vespalib::steady_time())
+            : dmsReadGuard(std::move(dmsReadGuard_)), bitVector(std::move(bitVector_)), docIdLimit(docIdLimit_),
+              created(created_) {}
+        size_t memoryUsage() const;
     };
 
 private:
@@ -41,14 +47,18 @@ private:
 
     mutable std::mutex _mutex;
     Cache _cache;
+    size_t _memoryUsage;
 
 public:
     BitVectorSearchCache();
     ~BitVectorSearchCache();
     void insert(const vespalib::string &term, Entry::SP entry);
     Entry::SP find(const vespalib::string &term) const;
+    void erase(const vespalib::string &term);
     size_t size() const;
+    size_t memoryUsage() const;
     void clear();
+    void removeOlderThan(vespalib::steady_time limit);
 };
 
 }
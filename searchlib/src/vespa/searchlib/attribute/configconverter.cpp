@@ -46,6 +46,19 @@ getCollectionTypeMap()
     return map;
 }
 
+template <typename CfgHugePages>
+vespalib::alloc::HugePagePolicy
+convert_huge_page_policy(CfgHugePages value)
+{
+    using vespalib::alloc::HugePagePolicy;
+    switch (value) {
+    case CfgHugePages::NONE:    return HugePagePolicy::NONE;
+    case CfgHugePages::HUGETLB: return HugePagePolicy::HUGETLB;
+    case CfgHugePages::MADVISE: return HugePagePolicy::MADVISE;
+    default:                    return HugePagePolicy::DEFAULT;
+    }
+}
+
 static DataTypeMap _dataTypeMap = getDataTypeMap();
 static CollectionTypeMap _collectionTypeMap = getCollectionTypeMap();
 
@@ -64,6 +77,9 @@ ConfigConverter::convert(const AttributesConfig::Attribute & cfg)
     PredicateParams predicateParams;
     retval.setFastSearch(cfg.fastsearch);
     retval.setHuge(cfg.huge);
+    retval.setPaged(cfg.paged);
+    retval.setCompressed(cfg.compressed);
+    retval.set_huge_page_policy(convert_huge_page_policy(cfg.hugepages));
     retval.setEnableBitVectors(cfg.enablebitvectors);
     retval.setEnableOnlyBitVector(cfg.enableonlybitvector);
     retval.setIsFilter(cfg.enableonlybitvector);
@@ -96,7 +112,9 @@ ConfigConverter::convert(const AttributesConfig::Attribute & cfg)
     if (cfg.index.hnsw.enabled) {
         retval.set_hnsw_index_params(HnswIndexParams(cfg.index.hnsw.maxlinkspernode,
                                                      cfg.index.hnsw.neighborstoexploreatinsert,
-                                                     dm, cfg.index.hnsw.multithreadedindexing));
+                                                     dm, cfg.index.hnsw.multithreadedindexing,
+                                                     cfg.index.hnsw.relinkdistancethreshold,
+                                                     convert_huge_page_policy(cfg.index.hnsw.hugepages)));
     }
     if (retval.basicType().type() == BasicType::Type::TENSOR) {
         if (!cfg.tensortype.empty()) {
@@ -3,6 +3,7 @@
 #include "attributefactory.h"
 #include "predicate_attribute.h"
 #include "singlesmallnumericattribute.h"
+#include "singlecompressedintegerattribute.h"
 #include "reference_attribute.h"
 #include "singlenumericattribute.hpp"
 #include "singlestringattribute.h"
@@ -31,8 +32,14 @@ AttributeFactory::createSingleStd(stringref name, const Config & info)
         // XXX: Unneeded since we don't have short document fields in java.
         return std::make_shared<SingleValueNumericAttribute<IntegerAttributeTemplate<int16_t>>>(name, info);
     case BasicType::INT32:
+        if (info.compressed()) {
+            return std::make_shared<SingleValueCompressedIntegerAttribute<IntegerAttributeTemplate<int32_t>>>(name, info);
+        }
         return std::make_shared<SingleValueNumericAttribute<IntegerAttributeTemplate<int32_t>>>(name, info);
     case BasicType::INT64:
+        if (info.compressed()) {
+            return std::make_shared<SingleValueCompressedIntegerAttribute<IntegerAttributeTemplate<int64_t>>>(name, info);
+        }
         return std::make_shared<SingleValueNumericAttribute<IntegerAttributeTemplate<int64_t>>>(name, info);
     case BasicType::FLOAT:
         return std::make_shared<SingleValueNumericAttribute<FloatingPointAttributeTemplate<float>>>(name, info);
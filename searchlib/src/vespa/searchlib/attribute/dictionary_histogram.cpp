@@ -0,0 +1,55 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "dictionary_histogram.h"
+#include <algorithm>
+
+namespace search::attribute {
+
+DictionaryHistogram::DictionaryHistogram(uint32_t expected_ranks, uint64_t expected_count)
+    : _samples(),
+      _rankStep(std::max(expected_ranks / TARGET_SAMPLES, 1u)),
+      _countStep(std::max(expected_count / TARGET_SAMPLES, uint64_t(1))),
+      _ranks(0),
+      _count(0)
+{
+    _samples.reserve(3 * TARGET_SAMPLES + 2);
+    _samples.emplace_back(0, 0);
+}
+
+DictionaryHistogram::~DictionaryHistogram() = default;
+
+void
+DictionaryHistogram::done()
+{
+    if (_samples.back().rank != _ranks) {
+        _samples.emplace_back(_ranks, _count);
+    }
+    _samples.shrink_to_fit();
+}
+
+double
+DictionaryHistogram::cumulative(uint32_t rank) const
+{
+    if (rank >= _ranks) {
+        return _count;
+    }
+    auto next = std::upper_bound(_samples.begin(), _samples.end(), rank,
+                                 [](uint32_t r, const Sample &s) { return r < s.rank; });
+    const Sample &prev = *(next - 1);
+    if (next == _samples.end()) {
+        return prev.count;
+    }
+    return prev.count + static_cast<double>(next->count - prev.count) * (rank - prev.rank) / (next->rank - prev.rank);
+}
+
+uint64_t
+DictionaryHistogram::estimate(uint32_t lower_rank, uint32_t upper_rank) const
+{
+    if (upper_rank <= lower_rank) {
+        return 0;
+    }
+    double result = cumulative(upper_rank) - cumulative(lower_rank);
+    return (result > 0.0) ? static_cast<uint64_t>(result + 0.5) : 0;
+}
+
+}
@@ -0,0 +1,79 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace search::attribute {
+
+/**
+ * Sampled cumulative distribution of posting list sizes over the
+ * ranks (positions) of the values in an attribute dictionary.
+ *
+ * A sample is taken every time either the rank or the cumulative
+ * count has advanced by a fixed step since the previous sample, and
+ * just before any value with a posting list larger than the count
+ * step, bounding both the memory usage and the estimation error. The
+ * number of postings for a range of ranks is estimated by linear
+ * interpolation between the samples surrounding each end of the
+ * range, which gives tight estimates for range and prefix terms
+ * also when the values are unevenly distributed over the documents.
+ **/
+class DictionaryHistogram
+{
+    struct Sample {
+        uint32_t rank;
+        uint64_t count;
+        Sample(uint32_t rank_, uint64_t count_) : rank(rank_), count(count_) {}
+    };
+    std::vector<Sample> _samples;
+    uint32_t            _rankStep;
+    uint64_t            _countStep;
+    uint32_t            _ranks;
+    uint64_t            _count;
+
+    double cumulative(uint32_t rank) const;
+
+public:
+    static constexpr uint32_t TARGET_SAMPLES = 1024;
+
+    /**
+     * @param expected_ranks number of values in the dictionary
+     * @param expected_count expected sum of posting list sizes
+     **/
+    DictionaryHistogram(uint32_t expected_ranks, uint64_t expected_count);
+    ~DictionaryHistogram();
+
+    /**
+     * Add the posting list size for the next value in the dictionary.
+     **/
+    void add(uint64_t count) {
+        const Sample &last = _samples.back();
+        if ((_ranks - last.rank >= _rankStep) || (_count - last.count >= _countStep) ||
+            ((count >= _countStep) && (last.rank != _ranks)))
+        {
+            _samples.emplace_back(_ranks, _count);
+        }
+        ++_ranks;
+        _count += count;
+    }
+
+    /**
+     * Must be called after the last value has been added.
+     **/
+    void done();
+
+    /**
+     * Estimate the sum of posting list sizes for the values with
+     * ranks in [lower_rank, upper_rank>.
+     **/
+    uint64_t estimate(uint32_t lower_rank, uint32_t upper_rank) const;
+
+    uint32_t num_ranks() const { return _ranks; }
+    uint64_t total_count() const { return _count; }
+    size_t num_samples() const { return _samples.size(); }
+};
+
+}
@@ -13,7 +13,7 @@ EnumAttribute<B>::
 EnumAttribute(const vespalib::string &baseFileName,
               const AttributeVector::Config &cfg)
     : B(baseFileName, cfg),
-      _enumStore(cfg.fastSearch())
+      _enumStore(cfg.fastSearch(), this->make_memory_allocator())
 {
     this->setEnum(true);
 }
@@ -74,6 +74,10 @@ private:
 
 public:
     EnumStoreT(bool has_postings);
+    /**
+     * The given memory allocator (if any) is used for the buffers holding the values.
+     */
+    EnumStoreT(bool has_postings, std::unique_ptr<vespalib::alloc::MemoryAllocator> memory_allocator);
     virtual ~EnumStoreT();
 
     uint32_t get_ref_count(Index idx) const { return get_entry_base(idx).get_ref_count(); }
@@ -73,7 +73,13 @@ EnumStoreT<EntryT>::load_unique_value(const void* src, size_t available, Index&
 
 template <typename EntryT>
 EnumStoreT<EntryT>::EnumStoreT(bool has_postings)
-    : _store(),
+    : EnumStoreT<EntryT>(has_postings, std::unique_ptr<vespalib::alloc::MemoryAllocator>())
+{
+}
+
+template <typename EntryT>
+EnumStoreT<EntryT>::EnumStoreT(bool has_postings, std::unique_ptr<vespalib::alloc::MemoryAllocator> memory_allocator)
+    : _store(std::make_unique<vespalib::datastore::uniquestore::DefaultUniqueStoreDictionary>(), std::move(memory_allocator)),
       _dict(),
       _cached_values_memory_usage(),
       _cached_values_address_space_usage(0, 0, (1ull << 32))
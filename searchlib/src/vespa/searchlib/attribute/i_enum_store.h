@@ -76,7 +76,11 @@ public:
     }
 
     enumstore::EnumeratedPostingsLoader make_enumerated_postings_loader() {
-        return enumstore::EnumeratedPostingsLoader(*this);
+        return enumstore::EnumeratedPostingsLoader(*this, nullptr);
+    }
+
+    enumstore::EnumeratedPostingsLoader make_enumerated_postings_loader(vespalib::Executor* executor) {
+        return enumstore::EnumeratedPostingsLoader(*this, executor);
     }
 
     virtual std::unique_ptr<Enumerator> make_enumerator() const = 0;
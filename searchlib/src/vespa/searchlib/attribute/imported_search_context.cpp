@@ -44,7 +44,11 @@ ImportedSearchContext::ImportedSearchContext(
       _target_search_context(_target_attribute.createSearchContext(std::move(term), params)),
       _targetLids(_reference_attribute.getTargetLids()),
       _merger(_reference_attribute.getCommittedDocIdLimit()),
-      _params(params)
+      _params(params),
+      _lastTargetLid(0),
+      _lastElemId(-1),
+      _lastResult(-1),
+      _lastWeight(0)
 {
 }
 
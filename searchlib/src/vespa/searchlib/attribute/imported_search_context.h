@@ -38,11 +38,21 @@ class ImportedSearchContext : public ISearchContext {
     TargetLids                                      _targetLids;
     PostingListMerger<int32_t>                      _merger;
     SearchContextParams                             _params;
+    // result of the last target search context lookup, reused for
+    // consecutive referring documents with the same target document
+    mutable uint32_t                                _lastTargetLid;
+    mutable int32_t                                 _lastElemId;
+    mutable int32_t                                 _lastResult;
+    mutable int32_t                                 _lastWeight;
 
     uint32_t getTargetLid(uint32_t lid) const {
         return _targetLids[lid];
     }
 
+    bool isLastLookup(uint32_t targetLid, int32_t elemId) const {
+        return (targetLid == _lastTargetLid) && (elemId == _lastElemId);
+    }
+
     void makeMergedPostings(bool isFilter);
     void considerAddSearchCacheEntry();
 public:
@@ -65,11 +75,27 @@ public:
     using DocId = IAttributeVector::DocId;
 
     int32_t find(DocId docId, int32_t elemId, int32_t& weight) const {
-        return _target_search_context->find(getTargetLid(docId), elemId, weight);
+        uint32_t targetLid = getTargetLid(docId);
+        if (!isLastLookup(targetLid, elemId)) {
+            int32_t lastWeight = 0;
+            _lastResult = _target_search_context->find(targetLid, elemId, lastWeight);
+            _lastWeight = lastWeight;
+            _lastTargetLid = targetLid;
+            _lastElemId = elemId;
+        }
+        if (_lastResult >= 0) {
+            weight = _lastWeight;
+        }
+        return _lastResult;
     }
 
     int32_t find(DocId docId, int32_t elemId) const {
-        return _target_search_context->find(getTargetLid(docId), elemId);
+        uint32_t targetLid = getTargetLid(docId);
+        if (isLastLookup(targetLid, elemId)) {
+            return _lastResult;
+        }
+        int32_t weight = 0;
+        return find(docId, elemId, weight);
     }
 
     int32_t onFind(uint32_t docId, int32_t elemId, int32_t &weight) const override { return find(docId, elemId, weight); }
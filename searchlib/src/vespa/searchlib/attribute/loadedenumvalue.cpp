@@ -2,21 +2,111 @@
 
 #include "loadedenumvalue.h"
 #include <vespa/searchlib/common/sort.h>
+#include <vespa/vespalib/util/count_down_latch.h>
+#include <vespa/vespalib/util/executor.h>
+#include <vespa/vespalib/util/lambdatask.h>
+#include <algorithm>
+#include <vector>
 
 namespace search {
 namespace attribute {
 
+namespace {
+
+// vectors smaller than this are sorted by the calling thread
+constexpr size_t min_values_per_partition = 64 * 1024;
+// more partitions than threads evens out the load between threads
+constexpr size_t max_partitions = 64;
+// granularity used when balancing partition sizes
+constexpr size_t num_bins = 4096;
+
 void
-sortLoadedByEnum(LoadedEnumAttributeVector &loaded)
+sortRange(LoadedEnumAttribute *begin, size_t size)
 {
     ShiftBasedRadixSorter<LoadedEnumAttribute,
         LoadedEnumAttribute::EnumRadix,
         LoadedEnumAttribute::EnumCompare, 56>::
         radix_sort(LoadedEnumAttribute::EnumRadix(),
                    LoadedEnumAttribute::EnumCompare(),
-                   &loaded[0], loaded.size(), 16);
+                   begin, size, 16);
+}
+
+/*
+ * Partition the loaded enums in place into ranges of enum values with
+ * roughly the same number of entries, then sort each range using the
+ * executor. All entries in a range have lower enum values than the
+ * entries in the next range, so the concatenation is sorted.
+ */
+void
+parallelSortLoadedByEnum(LoadedEnumAttributeVector &loaded, size_t num_partitions, vespalib::Executor &executor)
+{
+    uint32_t max_enum = 0;
+    for (const auto &elem : loaded) {
+        max_enum = std::max(max_enum, elem.getEnum());
+    }
+    uint32_t bin_shift = 0;
+    while ((max_enum >> bin_shift) >= num_bins) {
+        ++bin_shift;
+    }
+    std::vector<size_t> bin_count((max_enum >> bin_shift) + 1, 0);
+    for (const auto &elem : loaded) {
+        ++bin_count[elem.getEnum() >> bin_shift];
+    }
+    // assign consecutive bins to partitions
+    size_t target = (loaded.size() + num_partitions - 1) / num_partitions;
+    std::vector<uint32_t> bin_partition(bin_count.size());
+    std::vector<size_t> start(1, 0);
+    size_t acc = 0;
+    for (size_t bin = 0; bin < bin_count.size(); ++bin) {
+        if (acc >= target) {
+            start.push_back(start.back() + acc);
+            acc = 0;
+        }
+        bin_partition[bin] = start.size() - 1;
+        acc += bin_count[bin];
+    }
+    start.push_back(start.back() + acc);
+    size_t partitions = start.size() - 1;
+    // move entries to their partition (in place)
+    std::vector<size_t> next(start.begin(), start.end() - 1);
+    for (size_t p = 0; p < partitions; ++p) {
+        while (next[p] < start[p + 1]) {
+            uint32_t dst = bin_partition[loaded[next[p]].getEnum() >> bin_shift];
+            if (dst == p) {
+                ++next[p];
+            } else {
+                std::swap(loaded[next[p]], loaded[next[dst]++]);
+            }
+        }
+    }
+    vespalib::CountDownLatch latch(partitions);
+    for (size_t p = 0; p < partitions; ++p) {
+        LoadedEnumAttribute *begin = &loaded[0] + start[p];
+        size_t size = start[p + 1] - start[p];
+        auto task = vespalib::makeLambdaTask([begin, size, &latch]() {
+            sortRange(begin, size);
+            latch.countDown();
+        });
+        auto rejected = executor.execute(std::move(task));
+        if (rejected) {
+            rejected->run();
+        }
+    }
+    latch.await();
+}
+
+}
+
+void
+sortLoadedByEnum(LoadedEnumAttributeVector &loaded, vespalib::Executor *executor)
+{
+    size_t num_partitions = std::min(max_partitions, loaded.size() / min_values_per_partition);
+    if (executor != nullptr && num_partitions > 1) {
+        parallelSortLoadedByEnum(loaded, num_partitions, *executor);
+    } else if (!loaded.empty()) {
+        sortRange(&loaded[0], loaded.size());
+    }
 }
 
 } // namespace attribute
 } // namespace search
-
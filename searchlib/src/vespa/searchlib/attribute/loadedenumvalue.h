@@ -8,6 +8,8 @@
 #include <cassert>
 #include <limits>
 
+namespace vespalib { class Executor; }
+
 namespace search
 {
 
@@ -144,8 +146,13 @@ public:
     }
 };
 
+/**
+ * Sort loaded enums by enum value and document id. If an executor is
+ * given, large vectors are partitioned into enum value ranges that
+ * are sorted in parallel.
+ */
 void
-sortLoadedByEnum(LoadedEnumAttributeVector &loaded);
+sortLoadedByEnum(LoadedEnumAttributeVector &loaded, vespalib::Executor *executor);
 
 } // namespace attribute
 
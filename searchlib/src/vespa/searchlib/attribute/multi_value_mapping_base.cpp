@@ -2,6 +2,8 @@
 
 #include "multi_value_mapping_base.h"
 #include <vespa/searchcommon/common/compaction_strategy.h>
+#include <cassert>
+#include <limits>
 
 namespace search::attribute {
 
@@ -10,6 +12,8 @@ namespace {
 // minimum dead bytes in multi value mapping before consider compaction
 constexpr size_t DEAD_BYTES_SLACK = 0x10000u;
 constexpr size_t DEAD_ARRAYS_SLACK = 0x10000u;
+// maximum number of documents visited by each compaction step
+constexpr uint32_t COMPACT_DOCS_PER_STEP = 0x10000u;
 
 }
 
@@ -18,7 +22,8 @@ MultiValueMappingBase::MultiValueMappingBase(const vespalib::GrowStrategy &gs,
     : _indices(gs, genHolder),
       _totalValues(0u),
       _cachedArrayStoreMemoryUsage(),
-      _cachedArrayStoreAddressSpaceUsage(0, 0, (1ull << 32))
+      _cachedArrayStoreAddressSpaceUsage(0, 0, (1ull << 32)),
+      _compaction()
 {
 }
 
@@ -81,9 +86,33 @@ MultiValueMappingBase::updateStat()
     return retval;
 }
 
+void
+MultiValueMappingBase::compactWorst(bool compactMemory, bool compactAddressSpace)
+{
+    compactStep(std::numeric_limits<uint32_t>::max());
+    startCompactWorst(compactMemory, compactAddressSpace);
+    compactStep(std::numeric_limits<uint32_t>::max());
+}
+
+void
+MultiValueMappingBase::startCompactWorst(bool compactMemory, bool compactAddressSpace)
+{
+    _compaction.start(makeCompactionContext(compactMemory, compactAddressSpace));
+}
+
+void
+MultiValueMappingBase::compactStep(uint32_t maxDocs)
+{
+    _compaction.step(vespalib::ArrayRef<EntryRef>(&_indices[0], _indices.size()), maxDocs);
+}
+
 bool
 MultiValueMappingBase::considerCompact(const CompactionStrategy &compactionStrategy)
 {
+    if (_compaction.in_progress()) {
+        compactStep(COMPACT_DOCS_PER_STEP);
+        return true;
+    }
     size_t usedBytes = _cachedArrayStoreMemoryUsage.usedBytes();
     size_t deadBytes = _cachedArrayStoreMemoryUsage.deadBytes();
     size_t usedArrays = _cachedArrayStoreAddressSpaceUsage.used();
@@ -93,7 +122,8 @@ MultiValueMappingBase::considerCompact(const CompactionStrategy &compactionStrat
     bool compactAddressSpace = ((deadArrays >= DEAD_ARRAYS_SLACK) &&
                                 (usedArrays * compactionStrategy.getMaxDeadAddressSpaceRatio() < deadArrays));
     if (compactMemory || compactAddressSpace) {
-        compactWorst(compactMemory, compactAddressSpace);
+        startCompactWorst(compactMemory, compactAddressSpace);
+        compactStep(COMPACT_DOCS_PER_STEP);
         return true;
     }
     return false;
@@ -3,6 +3,8 @@
 #pragma once
 
 #include <vespa/vespalib/datastore/entryref.h>
+#include <vespa/vespalib/datastore/i_compaction_context.h>
+#include <vespa/vespalib/datastore/incremental_compaction.h>
 #include <vespa/vespalib/util/address_space.h>
 #include <vespa/vespalib/util/rcuvector.h>
 #include <functional>
@@ -25,6 +27,7 @@ protected:
     size_t    _totalValues;
     vespalib::MemoryUsage _cachedArrayStoreMemoryUsage;
     vespalib::AddressSpace _cachedArrayStoreAddressSpaceUsage;
+    vespalib::datastore::IncrementalCompaction _compaction;
 
     MultiValueMappingBase(const vespalib::GrowStrategy &gs, vespalib::GenerationHolder &genHolder);
     virtual ~MultiValueMappingBase();
@@ -32,6 +35,7 @@ protected:
     void updateValueCount(size_t oldValues, size_t newValues) {
         _totalValues += newValues - oldValues;
     }
+    virtual vespalib::datastore::ICompactionContext::UP makeCompactionContext(bool compactMemory, bool compactAddressSpace) = 0;
 public:
     using RefCopyVector = vespalib::Array<EntryRef>;
 
@@ -51,7 +55,30 @@ public:
 
     uint32_t getNumKeys() const { return _indices.size(); }
     uint32_t getCapacityKeys() const { return _indices.capacity(); }
-    virtual void compactWorst(bool compatMemory, bool compactAddressSpace) = 0;
+
+    /**
+     * Compact the worst buffers in one go, blocking until all
+     * documents refer to arrays outside the compacted buffers.
+     */
+    void compactWorst(bool compactMemory, bool compactAddressSpace);
+
+    /**
+     * Start incremental compaction of the worst buffers. The arrays
+     * are moved by subsequent calls to compactStep(), and the
+     * compacted buffers are put on hold when all documents have been
+     * visited.
+     */
+    void startCompactWorst(bool compactMemory, bool compactAddressSpace);
+    void compactStep(uint32_t maxDocs);
+    bool compactionInProgress() const { return _compaction.in_progress(); }
+    uint32_t getCompactNextDocId() const { return _compaction.next(); }
+
+    /**
+     * Continue an ongoing compaction, or start a new one if the
+     * compaction strategy says so. At most a bounded number of
+     * documents are visited per call. Returns true if the mapping was
+     * changed, in which case the caller must bump the generation.
+     */
     bool considerCompact(const CompactionStrategy &compactionStrategy);
 };
 
@@ -110,6 +110,7 @@ PostingListAttributeBase<P>::handle_load_posting_lists_and_update_enum_store(enu
                        &postings._removals[0] + postings._removals.size());
     posting_itr.writeData(newIndex.ref());
     loader.free_unused_values();
+    _postingList.rebuild_dictionary_histogram();
 }
 
 template <typename P>
@@ -117,6 +118,7 @@ void
 PostingListAttributeBase<P>::updatePostings(PostingMap &changePost,
                                             vespalib::datastore::EntryComparator &cmp)
 {
+    uint64_t num_changes = 0;
     for (auto& elem : changePost) {
         auto& change = elem.second;
         EnumIndex idx = elem.first.getEnumIdx();
@@ -130,10 +132,13 @@ PostingListAttributeBase<P>::updatePostings(PostingMap &changePost,
                            &change._additions[0] + change._additions.size(),
                            &change._removals[0],
                            &change._removals[0] + change._removals.size());
+        num_changes += change._additions.size() + change._removals.size();
         
         _dict.thaw(dictItr);
         dictItr.writeData(newPosting.ref());
     }
+    _postingList.update_dictionary_histogram(num_changes);
+    _postingList.adapt_bitvector_trees(num_changes);
 }
 
 template <typename P>
@@ -18,7 +18,8 @@ PostingListSearchContext(const Dictionary &dictionary,
                          const IEnumStore &esb,
                          uint32_t minBvDocFreq,
                          bool useBitVector,
-                         const ISearchContext &baseSearchCtx)
+                         const ISearchContext &baseSearchCtx,
+                         std::shared_ptr<const DictionaryHistogram> histogram)
     : _frozenDictionary(dictionary.getFrozenView()),
       _lowerDictItr(BTreeNode::Ref(), dictionary.getAllocator()),
       _upperDictItr(BTreeNode::Ref(), dictionary.getAllocator()),
@@ -35,7 +36,8 @@ PostingListSearchContext(const Dictionary &dictionary,
       _esb(esb),
       _minBvDocFreq(minBvDocFreq),
       _gbv(nullptr),
-      _baseSearchCtx(baseSearchCtx)
+      _baseSearchCtx(baseSearchCtx),
+      _histogram(std::move(histogram))
 {
 }
 
@@ -2,6 +2,7 @@
 
 #pragma once
 
+#include "dictionary_histogram.h"
 #include "enumstore.h"
 #include "postinglisttraits.h"
 #include "postingstore.h"
@@ -46,10 +47,12 @@ protected:
     uint32_t                _minBvDocFreq;
     const GrowableBitVector *_gbv; // bitvector if _useBitVector has been set
     const ISearchContext    &_baseSearchCtx;
+    std::shared_ptr<const DictionaryHistogram> _histogram;
 
 
     PostingListSearchContext(const Dictionary &dictionary, uint32_t docIdLimit, uint64_t numValues, bool hasWeight,
-                             const IEnumStore &esb, uint32_t minBvDocFreq, bool useBitVector, const ISearchContext &baseSearchCtx);
+                             const IEnumStore &esb, uint32_t minBvDocFreq, bool useBitVector, const ISearchContext &baseSearchCtx,
+                             std::shared_ptr<const DictionaryHistogram> histogram);
 
     ~PostingListSearchContext();
 
@@ -74,6 +77,12 @@ protected:
     }
 
     uint32_t calculateApproxNumHits() const {
+        if (_histogram && (_uniqueValues >= 2u) && _lowerDictItr.valid()) {
+            // posting list sizes are unevenly distributed over the dictionary
+            uint32_t lowerRank = _lowerDictItr.position();
+            uint64_t numHits = _histogram->estimate(lowerRank, lowerRank + _uniqueValues);
+            return static_cast<uint32_t>(std::min(numHits, static_cast<uint64_t>(_docIdLimit)));
+        }
         float docsPerUniqueValue = static_cast<float>(_docIdLimit) /
                                    static_cast<float>(_dictSize);
         return static_cast<uint32_t>(docsPerUniqueValue * _uniqueValues);
@@ -188,9 +197,13 @@ private:
     using Parent::_enumStore;
     using Parent::isRegex;
     using Parent::getRegex;
-    bool useThis(const PostingListSearchContext::DictionaryConstIterator & it) const override {
-        return isRegex() ? (getRegex() ? getRegex()->partial_match(_enumStore.get_value(it.getKey())) : false ) : true;
+    using DictionaryConstIterator = PostingListSearchContext::DictionaryConstIterator;
+    std::vector<bool> _regexMatches; // regex match for each word in the dictionary range
+
+    bool useThis(const DictionaryConstIterator & it) const override {
+        return isRegex() ? _regexMatches[it - this->_lowerDictItr] : true;
     }
+    void lookupRegexMatches();
 public:
     StringPostingSearchContext(QueryTermSimpleUP qTerm, bool useBitVector, const AttrT &toBeSearched);
 };
@@ -272,7 +285,8 @@ PostingSearchContext<BaseSC, BaseSC2, AttrT>::~PostingSearchContext() = default;
 template <typename BaseSC, typename AttrT, typename DataT>
 StringPostingSearchContext<BaseSC, AttrT, DataT>::
 StringPostingSearchContext(QueryTermSimpleUP qTerm, bool useBitVector, const AttrT &toBeSearched)
-    : Parent(std::move(qTerm), useBitVector, toBeSearched)
+    : Parent(std::move(qTerm), useBitVector, toBeSearched),
+      _regexMatches()
 {
     // after benchmarking prefix search performance on single, array, and weighted set fast-aggregate string attributes
     // with 1M values the following constant has been derived:
@@ -290,6 +304,7 @@ StringPostingSearchContext(QueryTermSimpleUP qTerm, bool useBitVector, const Att
             vespalib::string prefix(RegexpUtil::get_prefix(this->queryTerm()->getTerm()));
             auto comp = _enumStore.make_folded_comparator(prefix.c_str(), true);
             this->lookupRange(comp, comp);
+            lookupRegexMatches();
         } else {
             auto comp = _enumStore.make_folded_comparator(this->queryTerm()->getTerm());
             this->lookupTerm(comp);
@@ -301,6 +316,44 @@ StringPostingSearchContext(QueryTermSimpleUP qTerm, bool useBitVector, const Att
 }
 
 
+template <typename BaseSC, typename AttrT, typename DataT>
+void
+StringPostingSearchContext<BaseSC, AttrT, DataT>::lookupRegexMatches()
+{
+    // Match the regex once against each word in the prefix range, then
+    // shrink the range to span the matching words only. The number of
+    // unique values is the number of matching words, which gives far
+    // better hit estimates than the size of the prefix range.
+    uint32_t numMatches = 0;
+    DictionaryConstIterator first = this->_upperDictItr;
+    DictionaryConstIterator last = this->_upperDictItr;
+    std::vector<bool> matches;
+    for (auto it(this->_lowerDictItr); it != this->_upperDictItr; ++it) {
+        bool match = getRegex() && getRegex()->partial_match(_enumStore.get_value(it.getKey()));
+        if (match) {
+            if (numMatches == 0) {
+                first = it;
+            }
+            last = it;
+            ++numMatches;
+        }
+        if (numMatches != 0) {
+            matches.push_back(match);
+        }
+    }
+    if (numMatches == 0) {
+        this->_lowerDictItr = this->_upperDictItr;
+    } else {
+        ++last;
+        matches.resize(last - first);
+        this->_lowerDictItr = first;
+        this->_upperDictItr = last;
+    }
+    _regexMatches = std::move(matches);
+    this->_uniqueValues = numMatches;
+}
+
+
 template <typename BaseSC, typename AttrT, typename DataT>
 NumericPostingSearchContext<BaseSC, AttrT, DataT>::
 NumericPostingSearchContext(QueryTermSimpleUP qTerm, const Params & params_in, const AttrT &toBeSearched)
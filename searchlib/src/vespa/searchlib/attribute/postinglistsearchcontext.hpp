@@ -23,7 +23,8 @@ PostingListSearchContextT<DataT>::
 PostingListSearchContextT(const Dictionary &dictionary, uint32_t docIdLimit, uint64_t numValues, bool hasWeight,
                           const PostingList &postingList, const IEnumStore &esb,
                           uint32_t minBvDocFreq, bool useBitVector, const ISearchContext &searchContext)
-    : PostingListSearchContext(dictionary, docIdLimit, numValues, hasWeight, esb, minBvDocFreq, useBitVector, searchContext),
+    : PostingListSearchContext(dictionary, docIdLimit, numValues, hasWeight, esb, minBvDocFreq, useBitVector, searchContext,
+                               postingList.get_dictionary_histogram()),
       _postingList(postingList),
       _merger(docIdLimit)
 {
@@ -48,6 +49,9 @@ PostingListSearchContextT<DataT>::lookupSingle()
             if (_useBitVector) {
                 _gbv = bv;
             } else {
+                if (!_postingList._isFilter) {
+                    _postingList.note_bitvector_tree_lookup();
+                }
                 _pidx = bve->_tree;
                 if (_pidx.valid()) { 
                     auto frozenView = _postingList.getTreeEntry(_pidx)->getFrozenView(_postingList.getAllocator());
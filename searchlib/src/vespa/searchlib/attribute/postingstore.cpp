@@ -1,6 +1,7 @@
 // Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 
 #include "postingstore.h"
+#include "dictionary_histogram.h"
 #include <vespa/searchlib/common/growablebitvector.h>
 #include <vespa/searchcommon/attribute/config.h>
 #include <vespa/searchcommon/attribute/status.h>
@@ -23,6 +24,8 @@ PostingStoreBase2::PostingStoreBase2(EnumPostingTree &dict, Status &status, cons
 #endif
       _enableOnlyBitVector(config.getEnableOnlyBitVector()),
       _isFilter(config.getIsFilter()),
+      _keepBvTrees(!_enableOnlyBitVector),
+      _adaptiveBvTrees(false),
       _bvSize(64u),
       _bvCapacity(128u),
       _minBvDocFreq(64),
@@ -30,7 +33,13 @@ PostingStoreBase2::PostingStoreBase2(EnumPostingTree &dict, Status &status, cons
       _bvs(),
       _dict(dict),
       _status(status),
-      _bvExtraBytes(0)
+      _bvExtraBytes(0),
+      _histogramLock(),
+      _histogram(),
+      _histogramChanges(0),
+      _bvTreeLookups(0),
+      _bvTreeLookupsSeen(0),
+      _bvIdleChanges(0)
 {
 }
 
@@ -38,6 +47,22 @@ PostingStoreBase2::PostingStoreBase2(EnumPostingTree &dict, Status &status, cons
 PostingStoreBase2::~PostingStoreBase2() = default;
 
 
+void
+PostingStoreBase2::set_dictionary_histogram(std::shared_ptr<const DictionaryHistogram> histogram)
+{
+    std::lock_guard<std::mutex> guard(_histogramLock);
+    _histogram = std::move(histogram);
+}
+
+
+std::shared_ptr<const DictionaryHistogram>
+PostingStoreBase2::get_dictionary_histogram() const
+{
+    std::lock_guard<std::mutex> guard(_histogramLock);
+    return _histogram;
+}
+
+
 bool
 PostingStoreBase2::resizeBitVectors(uint32_t newSize, uint32_t newCapacity)
 {
@@ -71,6 +96,11 @@ PostingStore<DataT>::PostingStore(EnumPostingTree &dict, Status &status,
     _store.addType(&_bvType);
     _store.initActiveBuffers();
     _store.enableFreeLists();
+    _adaptiveBvTrees = !_enableOnlyBitVector && std::is_same_v<DataT, BTreeNoLeafData>;
+    if (_adaptiveBvTrees && _isFilter) {
+        // Filter terms never need the btree
+        _keepBvTrees = false;
+    }
 }
 
 
@@ -263,7 +293,7 @@ PostingStore<DataT>::makeBitVector(EntryRef &ref)
     assert(bv.countTrueBits() == expDocFreq);
     BitVectorRefPair bPair(allocBitVector());
     BitVectorEntry *bve = bPair.data;
-    if (_enableOnlyBitVector) {
+    if (!_keepBvTrees) {
         BTreeType *tree = getWTreeEntry(iRef);
         tree->clear(_allocator);
         _store.holdElem(ref, 1);
@@ -303,7 +333,7 @@ PostingStore<DataT>::applyNewBitVector(EntryRef &ref,
     assert(bv.countTrueBits() == expDocFreq);
     BitVectorRefPair bPair(allocBitVector());
     BitVectorEntry *bve = bPair.data;
-    if (!_enableOnlyBitVector) {
+    if (_keepBvTrees) {
         applyNewTree(bve->_tree, aOrg, ae, CompareT());
     }
     bve->_bv = bvsp;
@@ -611,6 +641,101 @@ PostingStore<DataT>::clear(const EntryRef ref)
 }
 
 
+template <typename DataT>
+void
+PostingStore<DataT>::update_dictionary_histogram(uint64_t num_changes)
+{
+    _histogramChanges += num_changes;
+    if (_histogram) {
+        uint64_t limit = std::max(_histogram->total_count(), MIN_HISTOGRAM_REBUILD_CHANGES);
+        if (_histogramChanges * 16 < limit) {
+            return;
+        }
+    }
+    rebuild_dictionary_histogram();
+}
+
+
+template <typename DataT>
+void
+PostingStore<DataT>::rebuild_dictionary_histogram()
+{
+    uint32_t num_ranks = 0;
+    uint64_t total_count = 0;
+    for (auto itr = _dict.begin(); itr.valid(); ++itr) {
+        ++num_ranks;
+        total_count += size(EntryRef(itr.getData()));
+    }
+    auto histogram = std::make_shared<DictionaryHistogram>(num_ranks, total_count);
+    for (auto itr = _dict.begin(); itr.valid(); ++itr) {
+        histogram->add(size(EntryRef(itr.getData())));
+    }
+    histogram->done();
+    _histogramChanges = 0;
+    set_dictionary_histogram(std::move(histogram));
+}
+
+
+template <typename DataT>
+void
+PostingStore<DataT>::dropBitVectorTrees()
+{
+    for (uint32_t bvRef : _bvs) {
+        BitVectorEntry *bve = getWBitVectorEntry(RefType(EntryRef(bvRef)));
+        EntryRef ref2(bve->_tree);
+        if (ref2.valid()) {
+            assert(isBTree(ref2));
+            bve->_tree = EntryRef();
+            std::atomic_thread_fence(std::memory_order_release);
+            BTreeType *tree = getWTreeEntry(ref2);
+            tree->clear(_allocator);
+            _store.holdElem(ref2, 1);
+        }
+    }
+}
+
+
+template <typename DataT>
+void
+PostingStore<DataT>::makeBitVectorTrees()
+{
+    for (uint32_t bvRef : _bvs) {
+        BitVectorEntry *bve = getWBitVectorEntry(RefType(EntryRef(bvRef)));
+        if (!bve->_tree.valid()) {
+            EntryRef ref2;
+            makeDegradedTree(ref2, *bve->_bv);
+            std::atomic_thread_fence(std::memory_order_release);
+            bve->_tree = ref2;
+        }
+    }
+}
+
+
+template <typename DataT>
+void
+PostingStore<DataT>::adapt_bitvector_trees(uint64_t num_changes)
+{
+    if (!_adaptiveBvTrees) {
+        return;
+    }
+    uint64_t lookups = _bvTreeLookups.load(std::memory_order_relaxed);
+    if (lookups != _bvTreeLookupsSeen) {
+        _bvTreeLookupsSeen = lookups;
+        _bvIdleChanges = 0;
+        if (!_keepBvTrees) {
+            _keepBvTrees = true;
+            makeBitVectorTrees();
+        }
+        return;
+    }
+    _bvIdleChanges += num_changes;
+    if (_keepBvTrees && _bvIdleChanges >= std::max(uint64_t(_bvSize), MIN_BV_IDLE_CHANGES)) {
+        _keepBvTrees = false;
+        dropBitVectorTrees();
+    }
+}
+
+
 template <typename DataT>
 vespalib::MemoryUsage
 PostingStore<DataT>::getMemoryUsage() const
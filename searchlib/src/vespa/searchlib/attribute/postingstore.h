@@ -4,6 +4,9 @@
 
 #include "enum_store_dictionary.h"
 #include "postinglisttraits.h"
+#include <atomic>
+#include <memory>
+#include <mutex>
 #include <set>
 
 namespace search {
@@ -15,6 +18,7 @@ namespace search::attribute {
 
 class Status;
 class Config;
+class DictionaryHistogram;
 
 class BitVectorEntry
 {
@@ -36,7 +40,9 @@ public:
     bool _enableBitVectors;
     bool _enableOnlyBitVector;
     bool _isFilter;
+    bool _keepBvTrees; // Keep btree alongside bitvector
 protected:
+    bool _adaptiveBvTrees; // _keepBvTrees follows observed query usage
     uint32_t _bvSize;
     uint32_t _bvCapacity;
 public:
@@ -47,14 +53,38 @@ protected:
     EnumPostingTree   &_dict;
     Status            &_status;
     uint64_t           _bvExtraBytes;
+    mutable std::mutex _histogramLock;
+    std::shared_ptr<const DictionaryHistogram> _histogram;
+    uint64_t           _histogramChanges; // posting changes since histogram was built
+    mutable std::atomic<uint64_t> _bvTreeLookups; // ranked term lookups of bitvector posting lists
+    uint64_t           _bvTreeLookupsSeen;
+    uint64_t           _bvIdleChanges; // posting changes since last ranked term lookup of bitvector posting list
 
     static constexpr uint32_t BUFFERTYPE_BITVECTOR = 9u;
+    static constexpr uint64_t MIN_HISTOGRAM_REBUILD_CHANGES = 1024u;
+    static constexpr uint64_t MIN_BV_IDLE_CHANGES = 65536u;
+
+    void set_dictionary_histogram(std::shared_ptr<const DictionaryHistogram> histogram);
 
 public:
     PostingStoreBase2(EnumPostingTree &dict, Status &status, const Config &config);
     virtual ~PostingStoreBase2();
     bool resizeBitVectors(uint32_t newSize, uint32_t newCapacity);
     virtual bool removeSparseBitVectors() = 0;
+
+    /*
+     * Histogram of posting list sizes over the dictionary, used by
+     * search contexts to estimate the number of hits for range terms.
+     * Might lag somewhat behind the current dictionary.
+     */
+    std::shared_ptr<const DictionaryHistogram> get_dictionary_histogram() const;
+
+    /*
+     * Called by search contexts when a ranked term looks up a posting
+     * list represented as a bitvector, i.e. when the btree alongside
+     * the bitvector is wanted.
+     */
+    void note_bitvector_tree_lookup() const { _bvTreeLookups.fetch_add(1, std::memory_order_relaxed); }
 };
 
 template <typename DataT>
@@ -118,6 +148,8 @@ public:
     void makeDegradedTree(EntryRef &ref, const BitVector &bv);
     void dropBitVector(EntryRef &ref);
     void makeBitVector(EntryRef &ref);
+    void dropBitVectorTrees();
+    void makeBitVectorTrees();
 
     void applyNewBitVector(EntryRef &ref, AddIter aOrg, AddIter ae);
     void apply(BitVector &bv, AddIter a, AddIter ae, RemoveIter r, RemoveIter re);
@@ -130,6 +162,24 @@ public:
      */
     void apply(EntryRef &ref, AddIter a, AddIter ae, RemoveIter r, RemoveIter re);
     void clear(const EntryRef ref);
+
+    /*
+     * Rebuild the dictionary histogram if it is missing or if enough
+     * posting changes have accumulated since it was built.
+     */
+    void update_dictionary_histogram(uint64_t num_changes);
+    void rebuild_dictionary_histogram();
+
+    /*
+     * Decide whether btrees should be kept alongside bitvectors, based
+     * on ranked term lookups seen since the last call. The btrees are
+     * dropped when the bitvector posting lists have not been looked
+     * up by ranked terms for a while, and rebuilt from the bitvectors
+     * when they are. Only done when posting lists have no weights, as
+     * the btrees can then be fully recreated from the bitvectors.
+     */
+    void adapt_bitvector_trees(uint64_t num_changes);
+
     size_t size(const EntryRef ref) const {
         if (!ref.valid())
             return 0;
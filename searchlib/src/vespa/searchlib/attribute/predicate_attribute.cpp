@@ -182,7 +182,7 @@ struct DummyObserver : SimpleIndexDeserializeObserver<> {
 
 }
 
-bool PredicateAttribute::onLoad()
+bool PredicateAttribute::onLoad(vespalib::Executor *)
 {
     auto loaded_buffer = attribute::LoadUtils::loadDAT(*this);
     char *rawBuffer = const_cast<char *>(static_cast<const char *>(loaded_buffer->buffer()));
@@ -0,0 +1,554 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "singlecompressedintegerattribute.h"
+#include "attributeiterators.hpp"
+#include "attributevector.hpp"
+#include "load_utils.h"
+#include "primitivereader.h"
+#include "attributesaver.h"
+#include "iattributesavetarget.h"
+#include <vespa/searchlib/query/query_term_simple.h>
+#include <vespa/searchlib/util/bufferwriter.h>
+#include <vespa/searchlib/queryeval/emptysearch.h>
+#include <vespa/vespalib/util/rcuvector.hpp>
+
+#include <vespa/log/log.h>
+LOG_SETUP(".searchlib.attribute.single_compressed_integer_attribute");
+
+namespace search {
+
+using attribute::compressed::block_shift;
+using attribute::compressed::block_size;
+using attribute::compressed::block_mask;
+using attribute::compressed::raw_width;
+using attribute::compressed::values_per_word;
+using attribute::compressed::packed_words;
+
+namespace {
+
+constexpr size_t DEAD_WORDS_SLACK = 0x10000u / sizeof(uint64_t);
+
+// blocks with a wider value range are stored without frame of reference
+constexpr uint32_t max_packed_width = 32;
+
+uint32_t bits_needed(uint64_t value) {
+    return (value == 0) ? 0 : (64 - __builtin_clzll(value));
+}
+
+uint32_t num_blocks(uint32_t numDocs) {
+    return ((numDocs + block_mask) >> block_shift);
+}
+
+}
+
+template <typename B>
+SingleValueCompressedIntegerAttribute<B>::
+SingleValueCompressedIntegerAttribute(const vespalib::string & baseFileName, const AttributeVector::Config & c)
+    : B(baseFileName, c),
+      _blocks((c.getGrowStrategy().getDocsInitialCapacity() >> block_shift) + 1,
+              c.getGrowStrategy().getDocsGrowPercent(),
+              (c.getGrowStrategy().getDocsGrowDelta() >> block_shift) + 1,
+              getGenerationHolder()),
+      _packed{WordVector(16, 50, 0, getGenerationHolder()),
+              WordVector(16, 50, 0, getGenerationHolder())},
+      _active(0),
+      _deadWords(0),
+      _releasePending(false),
+      _releaseGeneration(0)
+{ }
+
+template <typename B>
+SingleValueCompressedIntegerAttribute<B>::~SingleValueCompressedIntegerAttribute()
+{
+    getGenerationHolder().clearHoldLists();
+}
+
+template <typename B>
+void
+SingleValueCompressedIntegerAttribute<B>::decodeRegion(const Word *src, uint32_t width, T *dst)
+{
+    if (width == 0) {
+        std::fill(dst, dst + block_size, B::defaultValue());
+        return;
+    }
+    if (width == raw_width) {
+        for (uint32_t i = 0; i < block_size; ++i) {
+            dst[i] = static_cast<T>(static_cast<int64_t>(src[i]));
+        }
+        return;
+    }
+    const Word base = *src++;
+    const Word mask = (Word(1) << width) - 1;
+    const uint32_t per_word = values_per_word(width);
+    for (uint32_t i = 0; i < block_size; ++src) {
+        Word bits = *src;
+        uint32_t n = std::min(per_word, block_size - i);
+        for (uint32_t j = 0; j < n; ++j, ++i, bits >>= width) {
+            Word code = (bits & mask);
+            dst[i] = (code == 0) ? B::defaultValue() : static_cast<T>(static_cast<int64_t>(base + code - 1));
+        }
+    }
+}
+
+template <typename B>
+void
+SingleValueCompressedIntegerAttribute<B>::decodeBlock(uint32_t block, T *dst) const
+{
+    Word desc = _blocks[block];
+    uint32_t width = get_width(desc);
+    decodeRegion((width != 0) ? region(desc) : nullptr, width, dst);
+}
+
+/*
+ * Saver holding a copy of the packed blocks (compacted, i.e. without
+ * the words of replaced blocks). Values are decoded one block at a
+ * time while writing, so the extra memory used while saving is
+ * bounded by the compressed size of the attribute instead of the size
+ * of the plain attribute file.
+ */
+template <typename B>
+class SingleValueCompressedIntegerAttribute<B>::Saver : public AttributeSaver
+{
+    std::vector<Word> _blocks;
+    std::vector<Word> _packed;
+    uint32_t          _numDocs;
+
+    bool onSave(IAttributeSaveTarget &saveTarget) override;
+public:
+    Saver(const SingleValueCompressedIntegerAttribute &attr, const attribute::AttributeHeader &header, uint32_t numDocs);
+    ~Saver() override;
+};
+
+template <typename B>
+SingleValueCompressedIntegerAttribute<B>::Saver::Saver(const SingleValueCompressedIntegerAttribute &attr,
+                                                      const attribute::AttributeHeader &header, uint32_t numDocs)
+    : AttributeSaver(vespalib::GenerationHandler::Guard(), header),
+      _blocks(),
+      _packed(),
+      _numDocs(numDocs)
+{
+    uint32_t numBlocks = num_blocks(numDocs);
+    _blocks.reserve(numBlocks);
+    _packed.reserve(attr._packed[attr._active].size() - attr._deadWords);
+    for (uint32_t block = 0; block < numBlocks; ++block) {
+        Word desc = attr._blocks[block];
+        uint32_t width = get_width(desc);
+        _blocks.push_back(make_desc(0, _packed.size(), width));
+        if (width != 0) {
+            const Word *src = attr.region(desc);
+            _packed.insert(_packed.end(), src, src + packed_words(width));
+        }
+    }
+}
+
+template <typename B>
+SingleValueCompressedIntegerAttribute<B>::Saver::~Saver() = default;
+
+template <typename B>
+bool
+SingleValueCompressedIntegerAttribute<B>::Saver::onSave(IAttributeSaveTarget &saveTarget)
+{
+    std::unique_ptr<search::BufferWriter> datWriter(saveTarget.datWriter().allocBufferWriter());
+    std::array<T, block_size> values;
+    for (uint32_t block = 0; block < _blocks.size(); ++block) {
+        Word desc = _blocks[block];
+        uint32_t width = get_width(desc);
+        decodeRegion((width != 0) ? &_packed[get_offset(desc)] : nullptr, width, values.data());
+        uint32_t n = std::min(block_size, _numDocs - (block << block_shift));
+        datWriter->write(values.data(), n * sizeof(T));
+    }
+    datWriter->flush();
+    return true;
+}
+
+template <typename B>
+typename SingleValueCompressedIntegerAttribute<B>::Word
+SingleValueCompressedIntegerAttribute<B>::appendBlock(const T *values)
+{
+    bool has_value = false;
+    int64_t min_value = 0;
+    int64_t max_value = 0;
+    for (uint32_t i = 0; i < block_size; ++i) {
+        if (!attribute::isUndefined(values[i])) {
+            int64_t value = values[i];
+            min_value = has_value ? std::min(min_value, value) : value;
+            max_value = has_value ? std::max(max_value, value) : value;
+            has_value = true;
+        }
+    }
+    if (!has_value) {
+        return make_desc(0, 0, 0);
+    }
+    WordVector &dst = _packed[_active];
+    size_t offset = dst.size();
+    // code 0 is used for undefined values
+    uint64_t span = static_cast<uint64_t>(max_value) - static_cast<uint64_t>(min_value);
+    uint32_t width = (span < std::numeric_limits<uint32_t>::max()) ? bits_needed(span + 1) : raw_width;
+    if (width > max_packed_width) {
+        // no gain from packing values wider than half a word
+        width = raw_width;
+        for (uint32_t i = 0; i < block_size; ++i) {
+            dst.push_back(static_cast<uint64_t>(static_cast<int64_t>(values[i])));
+        }
+    } else {
+        const Word base = static_cast<uint64_t>(min_value);
+        const uint32_t per_word = values_per_word(width);
+        dst.push_back(base);
+        for (uint32_t i = 0; i < block_size;) {
+            Word bits = 0;
+            uint32_t n = std::min(per_word, block_size - i);
+            for (uint32_t j = 0; j < n; ++j, ++i) {
+                if (!attribute::isUndefined(values[i])) {
+                    Word code = static_cast<uint64_t>(static_cast<int64_t>(values[i])) - base + 1;
+                    bits |= (code << (j * width));
+                }
+            }
+            dst.push_back(bits);
+        }
+    }
+    assert(dst.size() == offset + packed_words(width));
+    return make_desc(_active, offset, width);
+}
+
+template <typename B>
+void
+SingleValueCompressedIntegerAttribute<B>::set(DocId doc, T v)
+{
+    Word desc = _blocks[doc >> block_shift];
+    uint32_t width = get_width(desc);
+    uint32_t idx = (doc & block_mask);
+    bool undefined = attribute::isUndefined(v);
+    if (width == 0) {
+        if (undefined) {
+            return;
+        }
+    } else {
+        Word *dst = &_packed[get_buffer(desc)][get_offset(desc)];
+        if (width == raw_width) {
+            dst[idx] = static_cast<uint64_t>(static_cast<int64_t>(v));
+            return;
+        }
+        const Word base = dst[0];
+        const Word mask = (Word(1) << width) - 1;
+        int64_t value = v;
+        if (undefined || ((value >= static_cast<int64_t>(base)) && ((static_cast<uint64_t>(value) - base) < mask))) {
+            Word code = undefined ? 0 : (static_cast<uint64_t>(value) - base + 1);
+            uint32_t word = (idx * attribute::compressed::word_index_mult[width]) >> 16;
+            uint32_t shift = (idx - word * values_per_word(width)) * width;
+            Word &bits = dst[1 + word];
+            bits = (bits & ~(mask << shift)) | (code << shift);
+            return;
+        }
+    }
+    repack(doc, v);
+}
+
+template <typename B>
+void
+SingleValueCompressedIntegerAttribute<B>::repack(DocId doc, T v)
+{
+    uint32_t block = (doc >> block_shift);
+    std::array<T, block_size> values;
+    decodeBlock(block, values.data());
+    values[doc & block_mask] = v;
+    size_t oldWords = packed_words(get_width(_blocks[block]));
+    Word desc = appendBlock(values.data());
+    std::atomic_thread_fence(std::memory_order_release);
+    _blocks[block] = desc;
+    _deadWords += oldWords;
+}
+
+template <typename B>
+void
+SingleValueCompressedIntegerAttribute<B>::build(const std::vector<T> &values)
+{
+    getGenerationHolder().clearHoldLists();
+    _blocks.reset();
+    _packed[0].reset();
+    _packed[1].reset();
+    _active = 0;
+    _deadWords = 0;
+    _releasePending = false;
+    uint32_t numDocs = values.size();
+    _blocks.unsafe_reserve(num_blocks(numDocs));
+    std::array<T, block_size> blockValues;
+    for (uint32_t doc = 0; doc < numDocs; doc += block_size) {
+        uint32_t n = std::min(block_size, numDocs - doc);
+        std::copy(values.begin() + doc, values.begin() + doc + n, blockValues.begin());
+        std::fill(blockValues.begin() + n, blockValues.end(), B::defaultValue());
+        _blocks.push_back(appendBlock(blockValues.data()));
+    }
+    B::setNumDocs(numDocs);
+    B::setCommittedDocIdLimit(numDocs);
+}
+
+template <typename B>
+bool
+SingleValueCompressedIntegerAttribute<B>::considerCompact()
+{
+    const double maxDeadRatio = this->getConfig().getCompactionStrategy().getMaxDeadBytesRatio();
+    size_t usedWords = _packed[_active].size();
+    if (!_releasePending && (_deadWords >= DEAD_WORDS_SLACK) && (usedWords * maxDeadRatio < _deadWords)) {
+        compact();
+        return true;
+    }
+    return false;
+}
+
+template <typename B>
+void
+SingleValueCompressedIntegerAttribute<B>::compact()
+{
+    // Move all blocks to the other (empty) buffer. The old buffer may
+    // still be used by readers until the current generation is no
+    // longer in use, see removeOldGenerations.
+    uint32_t target = 1 - _active;
+    assert(_packed[target].empty());
+    _packed[target].reserve(_packed[_active].size() - _deadWords);
+    _active = target;
+    std::array<T, block_size> values;
+    for (uint32_t block = 0; block < _blocks.size(); ++block) {
+        decodeBlock(block, values.data());
+        Word desc = appendBlock(values.data());
+        std::atomic_thread_fence(std::memory_order_release);
+        _blocks[block] = desc;
+    }
+    _deadWords = 0;
+    _releasePending = true;
+    _releaseGeneration = this->getCurrentGeneration();
+}
+
+template <typename B>
+void
+SingleValueCompressedIntegerAttribute<B>::onCommit()
+{
+    this->checkSetMaxValueCount(1);
+
+    {
+        // apply updates
+        typename B::ValueModifier valueGuard(this->getValueModifier());
+        for (const auto & change : this->_changes) {
+            if (change._type == ChangeBase::UPDATE) {
+                std::atomic_thread_fence(std::memory_order_release);
+                set(change._doc, change._data);
+            } else if (change._type >= ChangeBase::ADD && change._type <= ChangeBase::DIV) {
+                std::atomic_thread_fence(std::memory_order_release);
+                set(change._doc, this->applyArithmetic(getFast(change._doc), change));
+            } else if (change._type == ChangeBase::CLEARDOC) {
+                std::atomic_thread_fence(std::memory_order_release);
+                set(change._doc, B::defaultValue());
+            }
+        }
+    }
+
+    std::atomic_thread_fence(std::memory_order_release);
+    this->incGeneration();
+    if (considerCompact()) {
+        this->incGeneration();
+        this->updateStat(true);
+    }
+
+    this->_changes.clear();
+}
+
+template <typename B>
+void
+SingleValueCompressedIntegerAttribute<B>::onUpdateStat()
+{
+    vespalib::MemoryUsage usage = _blocks.getMemoryUsage();
+    usage.merge(_packed[0].getMemoryUsage());
+    usage.merge(_packed[1].getMemoryUsage());
+    usage.incDeadBytes(_deadWords * sizeof(Word));
+    usage.mergeGenerationHeldBytes(getGenerationHolder().getHeldBytes());
+    usage.merge(this->getChangeVectorMemoryUsage());
+    uint32_t numDocs = B::getNumDocs();
+    this->updateStatistics(numDocs, numDocs,
+                           usage.allocatedBytes(), usage.usedBytes(), usage.deadBytes(), usage.allocatedBytesOnHold());
+}
+
+template <typename B>
+void
+SingleValueCompressedIntegerAttribute<B>::onAddDocs(DocId lidLimit) {
+    _blocks.reserve(num_blocks(lidLimit));
+}
+
+template <typename B>
+bool
+SingleValueCompressedIntegerAttribute<B>::addDoc(DocId & doc) {
+    if ((B::getNumDocs() & block_mask) == 0) {
+        bool incGen = _blocks.isFull();
+        _blocks.push_back(make_desc(0, 0, 0));
+        std::atomic_thread_fence(std::memory_order_release);
+        B::incNumDocs();
+        doc = B::getNumDocs() - 1;
+        this->updateUncommittedDocIdLimit(doc);
+        if (incGen) {
+            this->incGeneration();
+        } else {
+            this->removeAllOldGenerations();
+        }
+    } else {
+        // the slot may still hold a value from before the lid space was shrunk
+        set(B::getNumDocs(), B::defaultValue());
+        std::atomic_thread_fence(std::memory_order_release);
+        B::incNumDocs();
+        doc = B::getNumDocs() - 1;
+        this->updateUncommittedDocIdLimit(doc);
+    }
+    return true;
+}
+
+template <typename B>
+void
+SingleValueCompressedIntegerAttribute<B>::removeOldGenerations(generation_t firstUsed)
+{
+    getGenerationHolder().trimHoldLists(firstUsed);
+    if (_releasePending && (firstUsed > _releaseGeneration)) {
+        // no readers can see the blocks moved away by the last compaction
+        _packed[1 - _active].reset();
+        _releasePending = false;
+    }
+}
+
+template <typename B>
+void
+SingleValueCompressedIntegerAttribute<B>::onGenerationChange(generation_t generation)
+{
+    getGenerationHolder().transferHoldLists(generation - 1);
+}
+
+template <typename B>
+bool
+SingleValueCompressedIntegerAttribute<B>::onLoad(vespalib::Executor *)
+{
+    PrimitiveReader<T> attrReader(*this);
+    bool ok(attrReader.getHasLoadData());
+
+    if (!ok)
+        return false;
+
+    this->setCreateSerialNum(attrReader.getCreateSerialNum());
+
+    std::vector<T> values;
+    if (attrReader.getEnumerated()) {
+        uint32_t numDocs = attrReader.getEnumCount();
+        auto udatBuffer = attribute::LoadUtils::loadUDAT(*this);
+        assert((udatBuffer->size() % sizeof(T)) == 0);
+        vespalib::ConstArrayRef<T> map(reinterpret_cast<const T *>(udatBuffer->buffer()),
+                                       udatBuffer->size() / sizeof(T));
+        values.reserve(numDocs);
+        for (uint32_t doc = 0; doc < numDocs; ++doc) {
+            uint32_t enumValue = attrReader.getNextEnum();
+            assert(enumValue < map.size());
+            values.push_back(map[enumValue]);
+        }
+    } else {
+        const size_t sz(attrReader.getDataCount());
+        values.reserve(sz);
+        for (uint32_t i = 0; i < sz; ++i) {
+            values.push_back(attrReader.getNextData());
+        }
+    }
+    build(values);
+    return true;
+}
+
+template <typename B>
+AttributeVector::SearchContext::UP
+SingleValueCompressedIntegerAttribute<B>::getSearch(QueryTermSimple::UP qTerm,
+                                                    const attribute::SearchContextParams & params) const
+{
+    (void) params;
+    QueryTermSimple::RangeResult<T> res = qTerm->getRange<T>();
+    if (res.isEqual()) {
+        return std::make_unique<SingleSearchContext<NumericAttribute::Equal<T>>>(std::move(qTerm), *this);
+    } else {
+        return std::make_unique<SingleSearchContext<NumericAttribute::Range<T>>>(std::move(qTerm), *this);
+    }
+}
+
+template <typename B>
+void
+SingleValueCompressedIntegerAttribute<B>::clearDocs(DocId lidLow, DocId lidLimit)
+{
+    assert(lidLow <= lidLimit);
+    assert(lidLimit <= this->getNumDocs());
+    uint32_t count = 0;
+    constexpr uint32_t commit_interval = 1000;
+    for (DocId lid = lidLow; lid < lidLimit; ++lid) {
+        if (!attribute::isUndefined(getFast(lid))) {
+            this->clearDoc(lid);
+        }
+        if ((++count % commit_interval) == 0) {
+            this->commit();
+        }
+    }
+}
+
+template <typename B>
+void
+SingleValueCompressedIntegerAttribute<B>::onShrinkLidSpace()
+{
+    uint32_t committedDocIdLimit = this->getCommittedDocIdLimit();
+    uint32_t numBlocks = num_blocks(committedDocIdLimit);
+    assert(_blocks.size() >= numBlocks);
+    for (uint32_t block = numBlocks; block < _blocks.size(); ++block) {
+        _deadWords += packed_words(get_width(_blocks[block]));
+    }
+    _blocks.shrink(numBlocks);
+    this->setNumDocs(committedDocIdLimit);
+}
+
+template <typename B>
+std::unique_ptr<AttributeSaver>
+SingleValueCompressedIntegerAttribute<B>::onInitSave(vespalib::stringref fileName)
+{
+    return std::make_unique<Saver>(*this, this->createAttributeHeader(fileName), this->getCommittedDocIdLimit());
+}
+
+template <typename B>
+template <typename M>
+bool SingleValueCompressedIntegerAttribute<B>::SingleSearchContext<M>::valid() const { return M::isValid(); }
+
+template <typename B>
+template <typename M>
+SingleValueCompressedIntegerAttribute<B>::SingleSearchContext<M>::SingleSearchContext(QueryTermSimple::UP qTerm,
+                                                                                      const NumericAttribute & toBeSearched) :
+    M(*qTerm, true),
+    AttributeVector::SearchContext(toBeSearched),
+    _attr(static_cast<const SingleValueCompressedIntegerAttribute<B> &>(toBeSearched)),
+    _lastBlock(std::numeric_limits<uint32_t>::max()),
+    _decoded(false),
+    _values()
+{ }
+
+template <typename B>
+template <typename M>
+Int64Range
+SingleValueCompressedIntegerAttribute<B>::SingleSearchContext<M>::getAsIntegerTerm() const {
+    return M::getRange();
+}
+
+template <typename B>
+template <typename M>
+std::unique_ptr<queryeval::SearchIterator>
+SingleValueCompressedIntegerAttribute<B>::SingleSearchContext<M>::
+createFilterIterator(fef::TermFieldMatchData * matchData, bool strict)
+{
+    if (!valid()) {
+        return std::make_unique<queryeval::EmptySearch>();
+    }
+    if (getIsFilter()) {
+        return strict
+                 ? std::make_unique<FilterAttributeIteratorStrict<SingleSearchContext<M>>>(*this, matchData)
+                 : std::make_unique<FilterAttributeIteratorT<SingleSearchContext<M>>>(*this, matchData);
+    }
+    return strict
+             ? std::make_unique<AttributeIteratorStrict<SingleSearchContext<M>>>(*this, matchData)
+             : std::make_unique<AttributeIteratorT<SingleSearchContext<M>>>(*this, matchData);
+}
+
+template class SingleValueCompressedIntegerAttribute<IntegerAttributeTemplate<int32_t>>;
+template class SingleValueCompressedIntegerAttribute<IntegerAttributeTemplate<int64_t>>;
+
+}
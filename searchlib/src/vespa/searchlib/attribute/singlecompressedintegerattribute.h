@@ -0,0 +1,291 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include "integerbase.h"
+#include <vespa/vespalib/util/rcuvector.h>
+#include <array>
+#include <limits>
+
+namespace search {
+
+namespace attribute::compressed {
+
+// number of documents per block
+constexpr uint32_t block_shift = 6;
+constexpr uint32_t block_size = 1u << block_shift;
+constexpr uint32_t block_mask = block_size - 1;
+
+// values are stored as-is (without frame of reference) using this width
+constexpr uint32_t raw_width = 64;
+
+// packed values never straddle words; this many values fit in a word
+constexpr uint32_t values_per_word(uint32_t width) { return 64 / width; }
+
+constexpr uint32_t packed_words(uint32_t width) {
+    if (width == 0) {
+        return 0;
+    }
+    if (width == raw_width) {
+        return block_size;
+    }
+    uint32_t per_word = values_per_word(width);
+    return 1 + ((block_size + per_word - 1) / per_word); // base + values
+}
+
+// multipliers used to find the word holding a value without division;
+// (idx * word_index_mult[width]) >> 16 == idx / values_per_word(width)
+// for all idx < block_size
+constexpr std::array<uint32_t, 65> make_word_index_mult() {
+    std::array<uint32_t, 65> result{};
+    for (uint32_t width = 1; width < 65; ++width) {
+        uint32_t per_word = values_per_word(width);
+        result[width] = ((1u << 16) + per_word - 1) / per_word;
+    }
+    return result;
+}
+inline constexpr std::array<uint32_t, 65> word_index_mult = make_word_index_mult();
+
+}
+
+/**
+ * Single value integer attribute storing its values bit packed in
+ * blocks of 64 documents. Each block stores its values as offsets
+ * from the smallest value in the block (frame of reference), using as
+ * many bits per value as needed by the value range of that block.
+ * This saves a lot of memory for attributes with a small value range,
+ * or where documents with nearby local document ids have similar
+ * values (like timestamps). Blocks without values use no memory
+ * except for their descriptor.
+ *
+ * Setting a value outside the range of its block repacks the block
+ * into new memory before switching the block descriptor, so
+ * concurrent readers always see a consistent block. The memory of
+ * replaced blocks is reclaimed by compaction, which moves all blocks
+ * (repacking them with minimal width) into a fresh buffer. The
+ * attribute is saved using the same file format as
+ * SingleValueNumericAttribute. The saver keeps a copy of the packed
+ * blocks and decodes them while writing the file.
+ **/
+template <typename B>
+class SingleValueCompressedIntegerAttribute final : public B {
+private:
+    using T = typename B::BaseType;
+    using Word = uint64_t;
+    using WordVector = vespalib::RcuVectorBase<Word>;
+    using DocId = typename B::DocId;
+    using EnumHandle = typename B::EnumHandle;
+    using Weighted = typename B::Weighted;
+    using WeightedEnum = typename B::WeightedEnum;
+    using WeightedFloat = typename B::WeightedFloat;
+    using WeightedInt = typename B::WeightedInt;
+    using generation_t = typename B::generation_t;
+    using largeint_t = typename B::largeint_t;
+
+    using B::getGenerationHolder;
+
+    // block descriptor: buffer (1 bit), word offset (56 bits), width (7 bits)
+    static constexpr uint32_t width_bits = 7;
+    static constexpr Word width_mask = (Word(1) << width_bits) - 1;
+    static constexpr Word offset_mask = (Word(1) << 56) - 1;
+
+    static uint32_t get_width(Word desc) { return (desc & width_mask); }
+    static uint32_t get_buffer(Word desc) { return (desc >> 63); }
+    static size_t get_offset(Word desc) { return ((desc >> width_bits) & offset_mask); }
+    static Word make_desc(uint32_t buffer, size_t offset, uint32_t width) {
+        return ((Word(buffer) << 63) | (Word(offset) << width_bits) | width);
+    }
+
+    WordVector   _blocks;     // one descriptor per block
+    WordVector   _packed[2];  // packed block data; new blocks go to the active one
+    uint32_t     _active;
+    size_t       _deadWords;  // words used by replaced blocks in the active buffer
+    bool         _releasePending;
+    generation_t _releaseGeneration;
+
+    T getFromEnum(EnumHandle e) const override {
+        (void) e;
+        return T();
+    }
+
+    const Word *region(Word desc) const {
+        return &_packed[get_buffer(desc)][get_offset(desc)];
+    }
+
+    static T decode(const Word *region, uint32_t width, uint32_t idx) {
+        if (width == attribute::compressed::raw_width) {
+            return static_cast<T>(static_cast<int64_t>(region[idx]));
+        }
+        uint32_t word = (idx * attribute::compressed::word_index_mult[width]) >> 16;
+        uint32_t shift = (idx - word * attribute::compressed::values_per_word(width)) * width;
+        Word code = (region[1 + word] >> shift) & ((Word(1) << width) - 1);
+        return (code == 0) ? B::defaultValue() : static_cast<T>(static_cast<int64_t>(region[0] + code - 1));
+    }
+
+    static void decodeRegion(const Word *src, uint32_t width, T *dst);
+    void decodeBlock(uint32_t block, T *dst) const;
+    Word appendBlock(const T *values);
+    void set(DocId doc, T v);
+    void repack(DocId doc, T v);
+    void build(const std::vector<T> &values);
+    bool considerCompact();
+    void compact();
+
+    class Saver;
+
+    /*
+     * Specialization of SearchContext
+     */
+    template <typename M>
+    class SingleSearchContext final : public M, public AttributeVector::SearchContext
+    {
+    private:
+        const SingleValueCompressedIntegerAttribute &_attr;
+        // the most recently accessed block, decoded once it is
+        // accessed a second time
+        mutable uint32_t _lastBlock;
+        mutable bool     _decoded;
+        mutable std::array<T, attribute::compressed::block_size> _values;
+
+        int32_t onFind(DocId docId, int32_t elemId, int32_t & weight) const override {
+            return find(docId, elemId, weight);
+        }
+
+        int32_t onFind(DocId docId, int elemId) const override {
+            return find(docId, elemId);
+        }
+
+        bool valid() const override;
+
+        T get(DocId docId) const {
+            uint32_t block = (docId >> attribute::compressed::block_shift);
+            if (block != _lastBlock) {
+                _lastBlock = block;
+                _decoded = false;
+                return _attr.getFast(docId);
+            }
+            if (!_decoded) {
+                _attr.decodeBlock(block, _values.data());
+                _decoded = true;
+            }
+            return _values[docId & attribute::compressed::block_mask];
+        }
+
+    public:
+        SingleSearchContext(std::unique_ptr<QueryTermSimple> qTerm, const NumericAttribute & toBeSearched);
+        int32_t find(DocId docId, int32_t elemId, int32_t & weight) const {
+            if ( elemId != 0) return -1;
+            const T v = get(docId);
+            weight = 1;
+            return this->match(v) ? 0 : -1;
+        }
+
+        int32_t find(DocId docId, int elemId) const {
+            if ( elemId != 0) return -1;
+            const T v = get(docId);
+            return this->match(v) ? 0 : -1;
+        }
+
+        Int64Range getAsIntegerTerm() const override;
+
+        std::unique_ptr<queryeval::SearchIterator>
+        createFilterIterator(fef::TermFieldMatchData * matchData, bool strict) override;
+    };
+
+protected:
+    bool findEnum(T value, EnumHandle & e) const override {
+        (void) value; (void) e;
+        return false;
+    }
+
+public:
+    SingleValueCompressedIntegerAttribute(const vespalib::string & baseFileName, const AttributeVector::Config & c);
+    ~SingleValueCompressedIntegerAttribute() override;
+
+    uint32_t getValueCount(DocId doc) const override {
+        if (doc >= B::getNumDocs()) {
+            return 0;
+        }
+        return 1;
+    }
+    void onCommit() override;
+    void onAddDocs(DocId lidLimit) override;
+    void onUpdateStat() override;
+    void removeOldGenerations(generation_t firstUsed) override;
+    void onGenerationChange(generation_t generation) override;
+    bool addDoc(DocId & doc) override;
+    bool onLoad(vespalib::Executor *executor) override;
+
+    AttributeVector::SearchContext::UP
+    getSearch(std::unique_ptr<QueryTermSimple> term, const attribute::SearchContextParams & params) const override;
+
+    T getFast(DocId doc) const {
+        Word desc = _blocks[doc >> attribute::compressed::block_shift];
+        uint32_t width = get_width(desc);
+        if (width == 0) {
+            return B::defaultValue();
+        }
+        return decode(region(desc), width, doc & attribute::compressed::block_mask);
+    }
+
+    //-------------------------------------------------------------------------
+    // new read api
+    //-------------------------------------------------------------------------
+    T get(DocId doc) const override {
+        return getFast(doc);
+    }
+    largeint_t getInt(DocId doc) const override {
+        return static_cast<largeint_t>(getFast(doc));
+    }
+    double getFloat(DocId doc) const override {
+        return static_cast<double>(getFast(doc));
+    }
+    uint32_t getEnum(DocId doc) const override {
+        (void) doc;
+        return std::numeric_limits<uint32_t>::max(); // does not have enum
+    }
+    uint32_t getAll(DocId doc, T * v, uint32_t sz) const override {
+        (void) sz;
+        v[0] = getFast(doc);
+        return 1;
+    }
+    uint32_t get(DocId doc, largeint_t * v, uint32_t sz) const override {
+        (void) sz;
+        v[0] = static_cast<largeint_t>(getFast(doc));
+        return 1;
+    }
+    uint32_t get(DocId doc, double * v, uint32_t sz) const override {
+        (void) sz;
+        v[0] = static_cast<double>(getFast(doc));
+        return 1;
+    }
+    uint32_t get(DocId doc, EnumHandle * e, uint32_t sz) const override {
+        (void) sz;
+        e[0] = getEnum(doc);
+        return 1;
+    }
+    uint32_t getAll(DocId doc, Weighted * v, uint32_t sz) const override {
+        (void) doc; (void) v; (void) sz;
+        return 0;
+    }
+    uint32_t get(DocId doc, WeightedInt * v, uint32_t sz) const override {
+        (void) sz;
+        v[0] = WeightedInt(static_cast<largeint_t>(getFast(doc)));
+        return 1;
+    }
+    uint32_t get(DocId doc, WeightedFloat * v, uint32_t sz) const override {
+        (void) sz;
+        v[0] = WeightedFloat(static_cast<double>(getFast(doc)));
+        return 1;
+    }
+    uint32_t get(DocId doc, WeightedEnum * e, uint32_t sz) const override {
+        (void) doc; (void) e; (void) sz;
+        return 0;
+    }
+
+    void clearDocs(DocId lidLow, DocId lidLimit) override;
+    void onShrinkLidSpace() override;
+    std::unique_ptr<AttributeSaver> onInitSave(vespalib::stringref fileName) override;
+};
+
+}
@@ -11,11 +11,14 @@ namespace search {
 using attribute::Config;
 
 SingleValueEnumAttributeBase::
-SingleValueEnumAttributeBase(const Config & c, GenerationHolder &genHolder)
-    : _enumIndices(c.getGrowStrategy().getDocsInitialCapacity(),
+SingleValueEnumAttributeBase(const Config & c, GenerationHolder &genHolder,
+                             std::unique_ptr<vespalib::alloc::MemoryAllocator> memory_allocator)
+    : _memory_allocator(std::move(memory_allocator)),
+      _enumIndices(c.getGrowStrategy().getDocsInitialCapacity(),
                    c.getGrowStrategy().getDocsGrowPercent(),
                    c.getGrowStrategy().getDocsGrowDelta(),
-                   genHolder)
+                   genHolder,
+                   _memory_allocator ? vespalib::alloc::Alloc::alloc_with_allocator(_memory_allocator.get()) : vespalib::alloc::Alloc::alloc())
 {
 }
 
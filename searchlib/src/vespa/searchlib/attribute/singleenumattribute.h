@@ -30,10 +30,12 @@ public:
     IEnumStore::Index getEnumIndex(DocId docId) const { return _enumIndices[docId]; }
     EnumHandle getE(DocId doc) const { return _enumIndices[doc].ref(); }
 protected:
-    SingleValueEnumAttributeBase(const attribute::Config & c, GenerationHolder &genHolder);
+    SingleValueEnumAttributeBase(const attribute::Config & c, GenerationHolder &genHolder,
+                                 std::unique_ptr<vespalib::alloc::MemoryAllocator> memory_allocator);
     ~SingleValueEnumAttributeBase();
     AttributeVector::DocId addDoc(bool & incGeneration);
 
+    std::unique_ptr<vespalib::alloc::MemoryAllocator> _memory_allocator;
     EnumIndexVector _enumIndices;
 
     EnumIndexCopyVector getIndicesCopy(uint32_t size) const;
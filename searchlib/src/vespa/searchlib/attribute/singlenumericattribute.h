@@ -25,6 +25,7 @@ private:
 
     using B::getGenerationHolder;
 
+    std::unique_ptr<vespalib::alloc::MemoryAllocator> _memory_allocator;
     DataVector _data;
 
     T getFromEnum(EnumHandle e) const override {
@@ -66,6 +67,16 @@ private:
             return this->match(v) ? 0 : -1;
         }
 
+        // Returns a bit mask with the matching documents in [first, first + 64)
+        uint64_t matchBlock(DocId first) const {
+            const T *values = _data + first;
+            uint64_t mask = 0;
+            for (uint32_t i = 0; i < 64; ++i) {
+                mask |= (static_cast<uint64_t>(this->match(values[i])) << i);
+            }
+            return mask;
+        }
+
         Int64Range getAsIntegerTerm() const override;
 
         std::unique_ptr<queryeval::SearchIterator>
@@ -101,7 +112,7 @@ public:
     void removeOldGenerations(generation_t firstUsed) override;
     void onGenerationChange(generation_t generation) override;
     bool addDoc(DocId & doc) override;
-    bool onLoad() override;
+    bool onLoad(vespalib::Executor *executor) override;
 
     bool onLoadEnumerated(ReaderBase &attrReader);
 
@@ -115,6 +126,10 @@ public:
     T getFast(DocId doc) const {
         return _data[doc];
     }
+    // Direct access to the values of all documents, valid while a generation guard is held.
+    const T * getFastArray() const {
+        return &_data[0];
+    }
 
     //-------------------------------------------------------------------------
     // new read api
@@ -16,10 +16,12 @@ template <typename B>
 SingleValueNumericAttribute<B>::
 SingleValueNumericAttribute(const vespalib::string & baseFileName, const AttributeVector::Config & c) :
     B(baseFileName, c),
+    _memory_allocator(this->make_memory_allocator()),
     _data(c.getGrowStrategy().getDocsInitialCapacity(),
           c.getGrowStrategy().getDocsGrowPercent(),
           c.getGrowStrategy().getDocsGrowDelta(),
-          getGenerationHolder())
+          getGenerationHolder(),
+          _memory_allocator ? vespalib::alloc::Alloc::alloc_with_allocator(_memory_allocator.get()) : vespalib::alloc::Alloc::alloc())
 { }
 
 template <typename B>
@@ -126,7 +128,7 @@ SingleValueNumericAttribute<B>::onLoadEnumerated(ReaderBase &attrReader)
 
 template <typename B>
 bool
-SingleValueNumericAttribute<B>::onLoad()
+SingleValueNumericAttribute<B>::onLoad(vespalib::Executor *)
 {
     PrimitiveReader<T> attrReader(*this);
     bool ok(attrReader.getHasLoadData());
@@ -238,11 +240,11 @@ createFilterIterator(fef::TermFieldMatchData * matchData, bool strict)
     }
     if (getIsFilter()) {
         return strict
-                 ? std::make_unique<FilterAttributeIteratorStrict<SingleSearchContext<M>>>(*this, matchData)
+                 ? std::make_unique<FilterAttributeIteratorScanStrict<SingleSearchContext<M>>>(*this, matchData)
                  : std::make_unique<FilterAttributeIteratorT<SingleSearchContext<M>>>(*this, matchData);
     }
     return strict
-             ? std::make_unique<AttributeIteratorStrict<SingleSearchContext<M>>>(*this, matchData)
+             ? std::make_unique<AttributeIteratorScanStrict<SingleSearchContext<M>>>(*this, matchData)
              : std::make_unique<AttributeIteratorT<SingleSearchContext<M>>>(*this, matchData);
 }
 }
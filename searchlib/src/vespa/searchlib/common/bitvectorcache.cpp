@@ -177,6 +177,9 @@ BitVectorCache::populate(uint32_t sz, const PopulateInterface & lookup)
     populate(newKeys, *chunk, lookup);
 
     guard.lock();
+    // All keys now refer to the new chunk, so it replaces the previous one.
+    // Readers that copied the chunk list keep the previous chunk alive.
+    _chunks.clear();
     _chunks.push_back(std::move(chunk));
     _keys.swap(newKeys);
     _needPopulation = false;
@@ -198,7 +201,14 @@ BitVectorCache::set(Key key, uint32_t index, bool v)
 bool
 BitVectorCache::get(Key key, uint32_t index) const
 {
-    (void) key; (void) index;
+    std::lock_guard<std::mutex> guard(_lock);
+    auto found = _keys.find(key);
+    if (found != _keys.end()) {
+        const KeyMeta & m(found->second);
+        if (m.isCached()) {
+            return _chunks[m.chunkId()]->get(m.chunkIndex(), index);
+        }
+    }
     return false;
 }
 
@@ -28,6 +28,7 @@ private:
 public:
     virtual bool isInverted() const = 0;
     const void *getBitValues() const { return _bv.getStart(); }
+    const BitVector &getBitVector() const { return _bv; }
 
     Trinary is_strict() const override { return Trinary::False; }
     uint32_t getDocIdLimit() const { return _docIdLimit; }
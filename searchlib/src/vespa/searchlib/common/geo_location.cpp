@@ -1,6 +1,7 @@
 // Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 
 #include "geo_location.h"
+#include <algorithm>
 
 using vespalib::geo::ZCurve;
 
@@ -181,4 +182,18 @@ bool GeoLocation::inside_limit(Point p) const {
     return sq_dist <= _sq_radius;
 }
 
+bool GeoLocation::may_be_inside_limit(Box b) const {
+    if (b.x.high < bounding_box.x.low) return false;
+    if (b.x.low > bounding_box.x.high) return false;
+
+    if (b.y.high < bounding_box.y.low) return false;
+    if (b.y.low > bounding_box.y.high) return false;
+
+    if (! has_point) return true;
+    // the point inside the box closest to our point
+    int32_t x = std::max(b.x.low, std::min(point.x, b.x.high));
+    int32_t y = std::max(b.y.low, std::min(point.y, b.y.high));
+    return sq_distance_to(Point{x, y}) <= _sq_radius;
+}
+
 } // namespace search::common
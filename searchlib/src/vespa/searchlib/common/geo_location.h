@@ -74,6 +74,9 @@ struct GeoLocation
     uint64_t sq_distance_to(Point p) const;
     bool inside_limit(Point p) const;
 
+    // check whether any point inside the given box may be inside limit
+    bool may_be_inside_limit(Box b) const;
+
     bool inside_limit(int64_t zcurve_encoded_xy) const {
         if (_z_bounding_box.getzFailBoundingBoxTest(zcurve_encoded_xy)) return false;
         int32_t x = 0;
@@ -92,6 +92,7 @@
                                                           SEARCHLIB_CID(88)
 #define CID_search_aggregation_StandardDeviationAggregationResult \
                                                           SEARCHLIB_CID(89)
+#define CID_search_aggregation_QuantileAggregationResult  SEARCHLIB_CID(92)
 
 #define CID_search_aggregation_Group                      SEARCHLIB_CID(90)
 #define CID_search_aggregation_Grouping                   SEARCHLIB_CID(91)
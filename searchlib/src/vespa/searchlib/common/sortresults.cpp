@@ -481,6 +481,12 @@ FastS_SortSpec::sortResults(RankedHit a[], uint32_t n, uint32_t topn)
 {
     initSortData(a, n);
     SortData * sortData = &_sortDataArray[0];
+    if ((_method != 2) && (topn > 0) && (topn < n)) {
+        // only the best 'topn' hits need to be in order; move them
+        // to the front before sorting them (radix sort handles topn itself)
+        std::nth_element(sortData, sortData + topn, sortData + n, StdSortDataCompare(&_binarySortData[0]));
+        n = topn;
+    }
     if (_method == 0) {
         search::qsort<7, 40, SortData, FastS_SortSpec>(sortData, n, this);
     } else if (_method == 1) {
@@ -10,12 +10,20 @@
 #include <vespa/vespalib/stllike/hash_set.h>
 #include <vespa/vespalib/stllike/hash_map.hpp>
 #include <vespa/vespalib/stllike/cache.hpp>
+#include <vespa/vespalib/util/lambdatask.h>
+#include <vespa/vespalib/util/threadstackexecutor.h>
 #include "pagedict4randread.h"
 #include "fileheader.h"
 
 #include <vespa/log/log.h>
 LOG_SETUP(".diskindex.diskindex");
 
+namespace {
+
+VESPA_THREAD_STACK_TAG(disk_index_async_read);
+
+}
+
 using namespace search::index;
 using namespace search::query;
 using namespace search::queryeval;
@@ -55,12 +63,26 @@ DiskIndex::DiskIndex(const vespalib::string &indexDir, size_t cacheSize)
       _dicts(),
       _tuneFileSearch(),
       _cache(*this, cacheSize),
-      _size(0)
+      _size(0),
+      _asyncReadExecutor(),
+      _asyncReadsInFlight(0),
+      _asyncReadsIssued(0)
 {
     calculateSize();
 }
 
-DiskIndex::~DiskIndex() = default;
+DiskIndex::~DiskIndex()
+{
+    if (_asyncReadExecutor) {
+        _asyncReadExecutor->shutdown();
+        _asyncReadExecutor->sync();
+    }
+}
+
+DiskIndex::ReadResult::ReadResult() = default;
+DiskIndex::ReadResult::ReadResult(ReadResult &&) noexcept = default;
+DiskIndex::ReadResult & DiskIndex::ReadResult::operator = (ReadResult &&) noexcept = default;
+DiskIndex::ReadResult::~ReadResult() = default;
 
 bool
 DiskIndex::loadSchema()
@@ -321,6 +343,62 @@ DiskIndex::readBitVector(const LookupResult &lookupRes) const
     return dict->lookup(lookupRes.wordNum);
 }
 
+DiskIndex::ReadResult
+DiskIndex::read(const LookupResult &lookupRes, bool useBitVector) const
+{
+    ReadResult result;
+    result.bitVector = readBitVector(lookupRes);
+    if (!useBitVector || !result.bitVector) {
+        result.postingHandle = readPostingList(lookupRes);
+    }
+    return result;
+}
+
+std::future<DiskIndex::ReadResult>
+DiskIndex::readAsync(const LookupResult &lookupRes, bool useBitVector) const
+{
+    auto promise = std::make_shared<std::promise<ReadResult>>();
+    auto future = promise->get_future();
+    if (!_asyncReadExecutor) {
+        promise->set_value(read(lookupRes, useBitVector));
+        return future;
+    }
+    _asyncReadsInFlight.fetch_add(1, std::memory_order_relaxed);
+    _asyncReadsIssued.fetch_add(1, std::memory_order_relaxed);
+    auto task = vespalib::makeLambdaTask([this, lookupRes, useBitVector, promise]() {
+        try {
+            promise->set_value(read(lookupRes, useBitVector));
+        } catch (...) {
+            promise->set_exception(std::current_exception());
+        }
+        _asyncReadsInFlight.fetch_sub(1, std::memory_order_relaxed);
+    });
+    auto rejected = _asyncReadExecutor->execute(std::move(task));
+    if (rejected) {
+        rejected->run();
+    }
+    return future;
+}
+
+void
+DiskIndex::enableAsyncReads(uint32_t numThreads)
+{
+    if ((numThreads > 0) && !_tuneFileSearch._read.getWantMemoryMap()) {
+        _asyncReadExecutor = std::make_unique<vespalib::ThreadStackExecutor>(numThreads, 128 * 1024, disk_index_async_read);
+    } else {
+        _asyncReadExecutor.reset();
+    }
+}
+
+DiskIndex::AsyncReadStats
+DiskIndex::getAsyncReadStats() const
+{
+    AsyncReadStats stats;
+    stats.inFlight = _asyncReadsInFlight.load(std::memory_order_relaxed);
+    stats.issued = _asyncReadsIssued.load(std::memory_order_relaxed);
+    return stats;
+}
+
 void
 DiskIndex::calculateSize()
 {
@@ -9,6 +9,10 @@
 #include <vespa/searchlib/queryeval/searchable.h>
 #include <vespa/vespalib/stllike/string.h>
 #include <vespa/vespalib/stllike/cache.h>
+#include <atomic>
+#include <future>
+
+namespace vespalib { class ThreadStackExecutor; }
 
 namespace search::diskindex {
 
@@ -40,6 +44,27 @@ public:
         }
     };
     typedef std::vector<LookupResult> LookupResultVector;
+
+    /**
+     * The posting list and/or bit vector read for a single lookup result.
+     **/
+    struct ReadResult {
+        index::PostingListHandle::UP postingHandle;
+        BitVector::UP                bitVector;
+        ReadResult();
+        ReadResult(ReadResult &&) noexcept;
+        ReadResult & operator = (ReadResult &&) noexcept;
+        ~ReadResult();
+    };
+
+    /**
+     * Counters for posting list reads issued on the async read executor.
+     **/
+    struct AsyncReadStats {
+        uint64_t inFlight;
+        uint64_t issued;
+        AsyncReadStats() : inFlight(0), issued(0) { }
+    };
     typedef std::vector<uint32_t> IndexList;
 
     class Key {
@@ -80,6 +105,9 @@ private:
     TuneFileSearch                         _tuneFileSearch;
     Cache                                  _cache;
     uint64_t                               _size;
+    std::unique_ptr<vespalib::ThreadStackExecutor> _asyncReadExecutor;
+    mutable std::atomic<uint64_t>          _asyncReadsInFlight;
+    mutable std::atomic<uint64_t>          _asyncReadsIssued;
 
     void calculateSize();
     bool loadSchema();
@@ -132,6 +160,40 @@ public:
      */
     BitVector::UP readBitVector(const LookupResult &lookupRes) const;
 
+    /**
+     * Read the bit vector and, if needed, the posting list corresponding to
+     * the given lookup result. The posting list is read when no bit vector
+     * exists for the word or when the bit vector alone is not sufficient.
+     *
+     * @param lookupRes the result of the previous dictionary lookup.
+     * @param useBitVector whether a bit vector alone is sufficient.
+     */
+    ReadResult read(const LookupResult &lookupRes, bool useBitVector) const;
+
+    /**
+     * Start reading the bit vector and posting list for the given lookup
+     * result on the async read executor. Reading is done in the calling
+     * thread if async reads are not enabled. Pending reads are completed
+     * before this instance is destroyed.
+     *
+     * @param lookupRes the result of the previous dictionary lookup.
+     * @param useBitVector whether a bit vector alone is sufficient.
+     */
+    std::future<ReadResult> readAsync(const LookupResult &lookupRes, bool useBitVector) const;
+
+    /**
+     * Enable reading of posting lists on a pool of the given number of
+     * threads, allowing posting list reads for all terms in a query to be
+     * in flight at the same time. Async reads are only used when the
+     * posting files are not memory mapped; memory mapped posting lists
+     * are prefetched with madvise when read. Call before any searches.
+     *
+     * @param numThreads the number of read threads, 0 disables async reads.
+     */
+    void enableAsyncReads(uint32_t numThreads);
+    bool hasAsyncReads() const { return bool(_asyncReadExecutor); }
+    AsyncReadStats getAsyncReadStats() const;
+
     queryeval::Blueprint::UP createBlueprint(const queryeval::IRequestContext & requestContext,
                                              const queryeval::FieldSpec &field,
                                              const query::Node &term) override;
@@ -46,12 +46,18 @@ DiskTermBlueprint::DiskTermBlueprint(const FieldSpecBase & field,
     _fetchPostingsDone(false),
     _hasEquivParent(false),
     _postingHandle(),
-    _bitVector()
+    _bitVector(),
+    _pendingRead()
 {
     setEstimate(HitEstimate(_lookupRes->counts._numDocs,
                             _lookupRes->counts._numDocs == 0));
+    if (_diskIndex.hasAsyncReads()) {
+        _pendingRead = _diskIndex.readAsync(*_lookupRes, _useBitVector);
+    }
 }
 
+DiskTermBlueprint::~DiskTermBlueprint() = default;
+
 namespace {
 
 bool
@@ -72,10 +78,11 @@ DiskTermBlueprint::fetchPostings(const queryeval::ExecuteInfo &execInfo)
     (void) execInfo;
     if (!_fetchPostingsDone) {
         _hasEquivParent = areAnyParentsEquiv(getParent());
-        _bitVector = _diskIndex.readBitVector(*_lookupRes);
-        if (!_useBitVector || !_bitVector) {
-            _postingHandle = _diskIndex.readPostingList(*_lookupRes);
-        }
+        DiskIndex::ReadResult result = _pendingRead.valid()
+                                       ? _pendingRead.get()
+                                       : _diskIndex.read(*_lookupRes, _useBitVector);
+        _bitVector = std::move(result.bitVector);
+        _postingHandle = std::move(result.postingHandle);
     }
     _fetchPostingsDone = true;
 }
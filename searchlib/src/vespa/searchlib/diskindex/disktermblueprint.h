@@ -21,6 +21,7 @@ private:
     bool                             _hasEquivParent;
     index::PostingListHandle::UP     _postingHandle;
     BitVector::UP                    _bitVector;
+    std::future<DiskIndex::ReadResult> _pendingRead;
 
 public:
     /**
@@ -30,11 +31,16 @@ public:
      * @param diskIndex    the disk index used to read the bit vector or posting list.
      * @param lookupRes    the result after disk dictionary lookup.
      * @param useBitVector whether or not we should use bit vector.
+     *
+     * If the disk index has async reads enabled, reading of the bit vector
+     * and posting list is started here, letting the reads for all terms in
+     * the query overlap before they are waited for in fetchPostings.
      **/
     DiskTermBlueprint(const queryeval::FieldSpecBase & field,
                       const DiskIndex & diskIndex,
                       DiskIndex::LookupResult::UP lookupRes,
                       bool useBitVector);
+    ~DiskTermBlueprint() override;
 
     // Inherit doc from Blueprint.
     // For now, this DiskTermBlueprint instance must have longer lifetime than the created iterator.
@@ -16,6 +16,7 @@
 #include <vespa/vespalib/util/count_down_latch.h>
 #include <vespa/vespalib/stllike/asciistream.h>
 #include <vespa/document/util/queue.h>
+#include <algorithm>
 #include <sstream>
 
 #include <vespa/log/log.h>
@@ -171,17 +172,42 @@ Fusion::renumberFieldWordIds(const vespalib::string & dir, const SchemaUtil::Ind
 }
 
 
+uint64_t
+Fusion::getInputFieldSize(uint32_t id) const
+{
+    SchemaUtil::IndexIterator index(getSchema(), id);
+    uint64_t size = 0;
+    for (const auto &oi : _oldIndexes) {
+        if (index.hasOldFields(oi.getSchema())) {
+            vespalib::string fieldDir = oi.getPath() + "/" + index.getName();
+            search::DirectoryTraverse dt(fieldDir.c_str());
+            size += dt.GetTreeSize();
+        }
+    }
+    return size;
+}
+
 bool
 Fusion::mergeFields(vespalib::ThreadExecutor & executor)
 {
     const Schema &schema = getSchema();
+    // Merge the largest fields first, so a dominant field is not
+    // started last when the other fields are done.
+    std::vector<std::pair<uint64_t, uint32_t>> fields;
+    for (SchemaUtil::IndexIterator iter(schema); iter.isValid(); ++iter) {
+        fields.emplace_back(getInputFieldSize(iter.getIndex()), iter.getIndex());
+    }
+    std::stable_sort(fields.begin(), fields.end(),
+                     [](const auto &lhs, const auto &rhs) { return lhs.first > rhs.first; });
     std::atomic<uint32_t> failed(0);
     uint32_t maxConcurrentThreads = std::max(1ul, executor.getNumThreads()/2);
     document::Semaphore concurrent(maxConcurrentThreads);
     vespalib::CountDownLatch  done(schema.getNumIndexFields());
-    for (SchemaUtil::IndexIterator iter(schema); iter.isValid(); ++iter) {
+    for (const auto &field : fields) {
+        LOG(debug, "Merging field %s (%" PRIu64 " bytes of input)",
+            schema.getIndexField(field.second).getName().c_str(), field.first);
         concurrent.wait();
-        executor.execute(vespalib::makeLambdaTask([this, index=iter.getIndex(), &failed, &done, &concurrent]() {
+        executor.execute(vespalib::makeLambdaTask([this, index=field.second, &failed, &done, &concurrent]() {
             if (!mergeField(index)) {
                 failed++;
             }
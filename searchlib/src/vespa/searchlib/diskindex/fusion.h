@@ -48,6 +48,7 @@ private:
     using SchemaUtil = index::SchemaUtil;
     using WordNumMappingList = std::vector<WordNumMapping>;
 
+    uint64_t getInputFieldSize(uint32_t id) const;
     bool mergeFields(vespalib::ThreadExecutor & executor);
     bool mergeField(uint32_t id);
     std::shared_ptr<FieldLengthScanner> allocate_field_length_scanner(const SchemaUtil::IndexIterator &index);
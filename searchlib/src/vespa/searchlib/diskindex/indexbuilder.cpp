@@ -84,6 +84,44 @@ public:
     uint32_t getIndexId() const { return _fieldId; }
 };
 
+/**
+ * Builder for a single field, writing directly to the files of that
+ * field. Builders for different fields can be used concurrently.
+ */
+class IndexBuilder::FieldBuilder : public index::IndexBuilder {
+private:
+    FieldHandle &_field;
+    bool         _inWord;
+
+public:
+    FieldBuilder(const Schema &schema, FieldHandle &field)
+        : index::IndexBuilder(schema),
+          _field(field),
+          _inWord(false)
+    {
+    }
+
+    void startField(uint32_t fieldId) override {
+        assert(fieldId == _field.getIndexId());
+        (void) fieldId;
+    }
+    void endField() override {
+        assert(!_inWord);
+    }
+    void startWord(vespalib::stringref word) override {
+        assert(!_inWord);
+        _inWord = true;
+        _field.new_word(word);
+    }
+    void endWord() override {
+        assert(_inWord);
+        _inWord = false;
+    }
+    void add_document(const index::DocIdAndFeatures &features) override {
+        assert(_inWord);
+        _field.add_document(features);
+    }
+};
 
 FileHandle::FileHandle()
     : _fieldWriter()
@@ -272,6 +310,14 @@ IndexBuilder::add_document(const index::DocIdAndFeatures &features)
     _currentField->add_document(features);
 }
 
+std::unique_ptr<index::IndexBuilder>
+IndexBuilder::startFieldBuilder(uint32_t fieldId)
+{
+    assert(_currentField == nullptr);
+    assert(fieldId < _fields.size());
+    return std::make_unique<FieldBuilder>(_schema, _fields[fieldId]);
+}
+
 void
 IndexBuilder::setPrefix(vespalib::stringref prefix)
 {
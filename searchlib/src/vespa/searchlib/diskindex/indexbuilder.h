@@ -25,6 +25,8 @@ public:
 
     using Schema = index::Schema;
 private:
+    class FieldBuilder;
+
     // Text fields
     FieldHandle             *_currentField;
     uint32_t                 _curDocId;
@@ -59,6 +61,7 @@ public:
     void startWord(vespalib::stringref word) override;
     void endWord() override;
     void add_document(const index::DocIdAndFeatures &features) override;
+    std::unique_ptr<index::IndexBuilder> startFieldBuilder(uint32_t fieldId) override;
 
     void setPrefix(vespalib::stringref prefix);
 
@@ -4,6 +4,7 @@
 #include <vespa/vespalib/stllike/asciistream.h>
 #include <vespa/vespalib/data/fileheader.h>
 #include <vespa/fastos/file.h>
+#include <cstring>
 
 #include <vespa/log/log.h>
 LOG_SETUP(".diskindex.pagedict4randread");
@@ -28,6 +29,7 @@ PageDict4RandRead::PageDict4RandRead()
       _ssfile(std::make_unique<FastOS_File>()),
       _spfile(std::make_unique<FastOS_File>()),
       _pfile(std::make_unique<FastOS_File>()),
+      _spData(),
       _ssFileBitSize(0u),
       _spFileBitSize(0u),
       _pFileBitSize(0u),
@@ -142,6 +144,18 @@ PageDict4RandRead::readPHeader()
 }
 
 
+void
+PageDict4RandRead::readSparsePages()
+{
+    size_t fileSize = _spfile->GetSize();
+    // padding allows the decoder to prefetch beyond the last page
+    size_t padding = 2 * sizeof(uint64_t);
+    _spData = vespalib::alloc::Alloc::alloc(fileSize + padding);
+    char *data = static_cast<char *>(_spData.get());
+    _spfile->ReadBuf(data, fileSize, 0);
+    memset(data + fileSize, 0, padding);
+}
+
 bool
 PageDict4RandRead::lookup(vespalib::stringref word,
                           uint64_t &wordNum,
@@ -165,7 +179,7 @@ PageDict4RandRead::lookup(vespalib::stringref word,
     } else {
         SPLookupRes spRes;
         size_t pageSize = PageDict4PageParams::getPageByteSize();
-        const char *spData = static_cast<const char *>(_spfile->MemoryMapPtr(0));
+        const char *spData = static_cast<const char *>(_spData.get());
         spRes.lookup(*_ssReader,
                      spData + pageSize * ssRes._sparsePageNum,
                      word,
@@ -207,7 +221,6 @@ PageDict4RandRead::open(const vespalib::string &name,
 
     int mmapFlags(tuneFileRead.getMemoryMapFlags());
     _ssfile->enableMemoryMap(mmapFlags);
-    _spfile->enableMemoryMap(mmapFlags);
     _pfile->enableMemoryMap(mmapFlags);
 
     int fadvise = tuneFileRead.getAdvise();
@@ -239,6 +252,7 @@ PageDict4RandRead::open(const vespalib::string &name,
     readSSHeader();
     readSPHeader();
     readPHeader();
+    readSparsePages();
 
     _ssReader = std::make_unique<SSReader>(_ssReadContext, _ssHeaderLen, _ssFileBitSize, _spHeaderLen,
                                            _spFileBitSize, _pHeaderLen, _pFileBitSize);
@@ -255,6 +269,7 @@ PageDict4RandRead::close()
 
     _ssReadContext.dropComprBuf();
     _ssReadContext.setFile(nullptr);
+    _spData = vespalib::alloc::Alloc();
     _ssfile->Close();
     _spfile->Close();
     _pfile->Close();
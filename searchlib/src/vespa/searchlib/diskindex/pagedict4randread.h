@@ -6,9 +6,16 @@
 #include <vespa/searchlib/bitcompression/compression.h>
 #include <vespa/searchlib/bitcompression/countcompression.h>
 #include <vespa/searchlib/bitcompression/pagedict4.h>
+#include <vespa/vespalib/util/alloc.h>
 
 namespace search::diskindex {
 
+/**
+ * Random access reader for the page dictionary. The sparse sparse file
+ * (.ssdat) and the sparse page file (.spdat) are read into memory when
+ * opened, so each lookup touches at most one page of the page file
+ * (.pdat) on disk.
+ */
 class PageDict4RandRead : public index::DictionaryFileRandRead
 {
     typedef bitcompression::PostingListCountFileDecodeContext DC;
@@ -29,6 +36,7 @@ class PageDict4RandRead : public index::DictionaryFileRandRead
     std::unique_ptr<FastOS_FileInterface> _ssfile;
     std::unique_ptr<FastOS_FileInterface> _spfile;
     std::unique_ptr<FastOS_FileInterface> _pfile;
+    vespalib::alloc::Alloc _spData;
 
     uint64_t _ssFileBitSize;
     uint64_t _spFileBitSize;
@@ -40,6 +48,7 @@ class PageDict4RandRead : public index::DictionaryFileRandRead
     void readSSHeader();
     void readSPHeader();
     void readPHeader();
+    void readSparsePages();
 public:
     PageDict4RandRead();
     ~PageDict4RandRead();
@@ -51,6 +60,7 @@ public:
 
     bool close() override;
     uint64_t getNumWordIds() const override;
+    size_t getSparsePagesMemoryUsage() const { return _spData.size(); }
 };
 
 }
@@ -3,6 +3,8 @@
 #include "zc4_posting_reader_base.h"
 #include "zc4_posting_header.h"
 #include <vespa/searchlib/index/docidandfeatures.h>
+#include <algorithm>
+#include <limits>
 
 namespace search::diskindex {
 
@@ -71,15 +73,19 @@ Zc4PostingReaderBase::NoSkip::check_not_end(uint32_t last_doc_id)
 
 Zc4PostingReaderBase::L1Skip::L1Skip()
     : NoSkipBase(),
-      _l1_skip_pos(0)
+      _l1_skip_pos(0),
+      _decode_block_max_features(false),
+      _block_max_num_occs(0),
+      _block_min_field_length(0)
 {
 }
 
 void
-Zc4PostingReaderBase::L1Skip::setup(DecodeContext &decode_context, uint32_t size, uint32_t doc_id, uint32_t last_doc_id)
+Zc4PostingReaderBase::L1Skip::setup(DecodeContext &decode_context, uint32_t size, uint32_t doc_id, uint32_t last_doc_id, bool decode_block_max_features)
 {
     NoSkipBase::setup(decode_context, size, doc_id);
     _l1_skip_pos = 0;
+    _decode_block_max_features = decode_block_max_features && (size != 0);
     if (size != 0) {
         next_skip_entry();
     } else {
@@ -102,10 +108,23 @@ Zc4PostingReaderBase::L1Skip::check(const NoSkipBase &no_skip, bool top_level, b
     }
 }
 
+void
+Zc4PostingReaderBase::L1Skip::check_block_max_features(uint32_t max_num_occs, uint32_t min_field_length) const
+{
+    if (_decode_block_max_features) {
+        assert(_block_max_num_occs == max_num_occs);
+        assert(_block_min_field_length == min_field_length);
+    }
+}
+
 void
 Zc4PostingReaderBase::L1Skip::next_skip_entry()
 {
     _doc_id += (_zc_buf.decode() + 1);
+    if (_decode_block_max_features) {
+        _block_max_num_occs = _zc_buf.decode() + 1;
+        _block_min_field_length = _zc_buf.decode() + 1;
+    }
 }
 
 Zc4PostingReaderBase::L2Skip::L2Skip()
@@ -190,7 +209,9 @@ Zc4PostingReaderBase::Zc4PostingReaderBase(bool dynamic_k)
       _chunkNo(0),
       _features_size(0),
       _counts(),
-      _residue(0)
+      _residue(0),
+      _block_max_num_occs(0),
+      _block_min_field_length(std::numeric_limits<uint32_t>::max())
 {
 }
 
@@ -198,6 +219,13 @@ Zc4PostingReaderBase::~Zc4PostingReaderBase()
 {
 }
 
+void
+Zc4PostingReaderBase::reset_block_max_features()
+{
+    _block_max_num_occs = 0;
+    _block_min_field_length = std::numeric_limits<uint32_t>::max();
+}
+
 void
 Zc4PostingReaderBase::read_common_word_doc_id(DecodeContext64Base &decode_context)
 {
@@ -205,6 +233,8 @@ Zc4PostingReaderBase::read_common_word_doc_id(DecodeContext64Base &decode_contex
     if (_no_skip.get_doc_id() >= _l1_skip.get_doc_id()) {
         _no_skip.set_features_pos(decode_context.getReadOffset());
         _l1_skip.check(_no_skip, true, _posting_params._encode_features);
+        _l1_skip.check_block_max_features(_block_max_num_occs, _block_min_field_length);
+        reset_block_max_features();
         if (_no_skip.get_doc_id() >= _l2_skip.get_doc_id()) {
             _l2_skip.check(_l1_skip, true, _posting_params._encode_features);
             if (_no_skip.get_doc_id() >= _l3_skip.get_doc_id()) {
@@ -220,7 +250,10 @@ Zc4PostingReaderBase::read_common_word_doc_id(DecodeContext64Base &decode_contex
         _l1_skip.next_skip_entry();
     }
     _no_skip.read(_posting_params._encode_interleaved_features);
+    _block_max_num_occs = std::max(_block_max_num_occs, _no_skip.get_num_occs());
+    _block_min_field_length = std::min(_block_min_field_length, _no_skip.get_field_length());
     if (_residue == 1) {
+        _l1_skip.check_block_max_features(_block_max_num_occs, _block_min_field_length);
         _no_skip.check_end(_last_doc_id);
         _l1_skip.check_end(_last_doc_id);
         _l2_skip.check_end(_last_doc_id);
@@ -249,7 +282,8 @@ Zc4PostingReaderBase::read_word_start_with_skip(DecodeContext64Base &decode_cont
     }
     uint32_t prev_doc_id = _no_skip.get_doc_id();
     _no_skip.setup(decode_context, header._doc_ids_size, prev_doc_id);
-    _l1_skip.setup(decode_context, header._l1_skip_size, prev_doc_id, _last_doc_id);
+    _l1_skip.setup(decode_context, header._l1_skip_size, prev_doc_id, _last_doc_id, _posting_params._encode_block_max_features);
+    reset_block_max_features();
     _l2_skip.setup(decode_context, header._l2_skip_size, prev_doc_id, _last_doc_id);
     _l3_skip.setup(decode_context, header._l3_skip_size, prev_doc_id, _last_doc_id);
     _l4_skip.setup(decode_context, header._l4_skip_size, prev_doc_id, _last_doc_id);
@@ -56,10 +56,14 @@ protected:
     class L1Skip : public NoSkipBase {
     protected:
         uint32_t _l1_skip_pos;
+        bool     _decode_block_max_features;
+        uint32_t _block_max_num_occs;
+        uint32_t _block_min_field_length;
     public:
         L1Skip();
-        void setup(DecodeContext &decode_context, uint32_t size, uint32_t doc_id, uint32_t last_doc_id);
+        void setup(DecodeContext &decode_context, uint32_t size, uint32_t doc_id, uint32_t last_doc_id, bool decode_block_max_features = false);
         void check(const NoSkipBase &no_skip, bool top_level, bool decode_features);
+        void check_block_max_features(uint32_t max_num_occs, uint32_t min_field_length) const;
         void next_skip_entry();
         uint32_t get_l1_skip_pos() const { return _l1_skip_pos; }
     };
@@ -111,6 +115,10 @@ protected:
     index::PostingListCounts _counts;
 
     uint32_t _residue;            // Number of unread documents after word header
+    // Interleaved features seen since last L1 skip entry, used for validating block max features
+    uint32_t _block_max_num_occs;
+    uint32_t _block_min_field_length;
+    void reset_block_max_features();
     void read_common_word_doc_id(bitcompression::DecodeContext64Base &decode_context);
     void read_word_start_with_skip(bitcompression::DecodeContext64Base &decode_context, const Zc4PostingHeader &header);
     void read_word_start(bitcompression::DecodeContext64Base &decode_context);
@@ -2,6 +2,8 @@
 
 #include "zc4_posting_writer_base.h"
 #include <vespa/searchlib/index/postinglistcounts.h>
+#include <algorithm>
+#include <limits>
 
 using search::index::PostingListCounts;
 using search::index::PostingListParams;
@@ -37,16 +39,29 @@ protected:
     uint32_t _stride_check;
     uint32_t _l1_skip_pos;
     const bool _encode_features;
+    // Only set for the L1 skip table, higher levels do not have block max features
+    const bool _encode_block_max_features;
+    uint32_t _block_max_num_occs;
+    uint32_t _block_min_field_length;
 
+    void encode_block_max_features(ZcBuf &zc_buf);
 public:
-    L1SkipEncoder(bool encode_features)
+    L1SkipEncoder(bool encode_features, bool encode_block_max_features = false)
         : DocIdEncoder(),
           _stride_check(0u),
           _l1_skip_pos(0u),
-          _encode_features(encode_features)
+          _encode_features(encode_features),
+          _encode_block_max_features(encode_block_max_features),
+          _block_max_num_occs(0u),
+          _block_min_field_length(std::numeric_limits<uint32_t>::max())
     {
     }
 
+    void add_to_block(const DocIdAndFeatureSize &doc_id_and_feature_size) {
+        _block_max_num_occs = std::max(_block_max_num_occs, doc_id_and_feature_size._num_occs);
+        _block_min_field_length = std::min(_block_min_field_length, doc_id_and_feature_size._field_length);
+    }
+
     void encode_skip(ZcBuf &zc_buf, const DocIdEncoder &doc_id_encoder);
     void write_skip(ZcBuf &zc_buf, const DocIdEncoder &doc_id_encoder);
     bool should_write_skip(uint32_t stride) { return ++_stride_check >= stride; }
@@ -123,6 +138,9 @@ L1SkipEncoder::encode_skip(ZcBuf &zc_buf, const DocIdEncoder &doc_id_encoder)
     assert(static_cast<int32_t>(doc_id_delta) > 0);
     zc_buf.encode(doc_id_delta - 1);
     _doc_id = doc_id_encoder.get_doc_id();
+    if (_encode_block_max_features) {
+        encode_block_max_features(zc_buf);
+    }
     // doc id pos
     zc_buf.encode(doc_id_encoder.get_doc_id_pos() - _doc_id_pos - 1);
     _doc_id_pos = doc_id_encoder.get_doc_id_pos();
@@ -133,6 +151,18 @@ L1SkipEncoder::encode_skip(ZcBuf &zc_buf, const DocIdEncoder &doc_id_encoder)
     }
 }
 
+void
+L1SkipEncoder::encode_block_max_features(ZcBuf &zc_buf)
+{
+    // Bounds for the documents in the block ending with the skip entry doc id
+    assert(_block_max_num_occs > 0);
+    zc_buf.encode(_block_max_num_occs - 1);
+    assert(_block_min_field_length > 0 && _block_min_field_length != std::numeric_limits<uint32_t>::max());
+    zc_buf.encode(_block_min_field_length - 1);
+    _block_max_num_occs = 0u;
+    _block_min_field_length = std::numeric_limits<uint32_t>::max();
+}
+
 void
 L1SkipEncoder::write_skip(ZcBuf &zc_buf, const DocIdEncoder &doc_id_encoder)
 {
@@ -145,6 +175,9 @@ L1SkipEncoder::write_partial_skip(ZcBuf &zc_buf, uint32_t doc_id)
 {
     if (zc_buf.size() > 0) {
         zc_buf.encode(doc_id - _doc_id - 1);
+        if (_encode_block_max_features) {
+            encode_block_max_features(zc_buf);
+        }
     }
 }
 
@@ -238,7 +271,7 @@ void
 Zc4PostingWriterBase::calc_skip_info(bool encode_features)
 {
     DocIdEncoder doc_id_encoder;
-    L1SkipEncoder l1_skip_encoder(encode_features);
+    L1SkipEncoder l1_skip_encoder(encode_features, get_encode_block_max_features());
     L2SkipEncoder l2_skip_encoder(encode_features);
     L3SkipEncoder l3_skip_encoder(encode_features);
     L4SkipEncoder l4_skip_encoder(encode_features);
@@ -265,6 +298,7 @@ Zc4PostingWriterBase::calc_skip_info(bool encode_features)
             }
         }
         doc_id_encoder.write(_zcDocIds, doc_id_and_feature_size, _encode_interleaved_features);
+        l1_skip_encoder.add_to_block(doc_id_and_feature_size);
     }
     // Extra partial entries for skip tables to simplify iterator during search
     l1_skip_encoder.write_partial_skip(_l1Skip, doc_id_encoder.get_doc_id());
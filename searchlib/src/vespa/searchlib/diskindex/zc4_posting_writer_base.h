@@ -73,6 +73,8 @@ public:
     uint64_t get_num_words() const { return _numWords; }
     bool get_dynamic_k() const { return _dynamicK; }
     bool get_encode_interleaved_features() const { return _encode_interleaved_features; }
+    // Block max features are derived from the interleaved features
+    bool get_encode_block_max_features() const { return _encode_interleaved_features; }
     void set_dynamic_k(bool dynamicK) { _dynamicK = dynamicK; }
     void set_encode_interleaved_features(bool encode_interleaved_features) { _encode_interleaved_features = encode_interleaved_features; }
     void set_posting_list_params(const index::PostingListParams &params);
@@ -5,6 +5,8 @@
 #include <vespa/vespalib/data/fileheader.h>
 #include <vespa/searchlib/queryeval/emptysearch.h>
 #include <vespa/fastos/file.h>
+#include <sys/mman.h>
+#include <unistd.h>
 
 #include <vespa/log/log.h>
 LOG_SETUP(".diskindex.zcposoccrandread");
@@ -27,6 +29,7 @@ namespace {
 vespalib::string myId4("Zc.4");
 vespalib::string myId5("Zc.5");
 vespalib::string interleaved_features("interleaved_features");
+vespalib::string block_max_features("block_max_features");
 
 }
 
@@ -84,6 +87,25 @@ createIterator(const PostingListCounts &counts,
 }
 
 
+/*
+ * Ask the kernel to start reading the memory mapped posting list. This
+ * does not block, so the reads for all terms in a query (and for
+ * concurrent queries) are in flight before matching touches the pages.
+ */
+void
+ZcPosOccRandRead::prefetchMapped(void *mapPtr, uint64_t startOffset, const PostingListHandle &handle)
+{
+    uint64_t endOffset = (handle._bitOffset + _headerBitSize + handle._bitLength + 7) >> 3;
+    size_t pageSize = getpagesize();
+    uintptr_t start = reinterpret_cast<uintptr_t>(mapPtr);
+    uintptr_t end = start + (endOffset - startOffset);
+    start -= (start & (pageSize - 1));
+    if (end - start <= pageSize) {
+        return; // a single page is read by the first access anyway
+    }
+    posix_madvise(reinterpret_cast<void *>(start), end - start, POSIX_MADV_WILLNEED);
+}
+
 void
 ZcPosOccRandRead::readPostingList(const PostingListCounts &counts,
                                   uint32_t firstSegment,
@@ -109,6 +131,7 @@ ZcPosOccRandRead::readPostingList(const PostingListCounts &counts,
         handle._mem = mapPtr;
         handle._allocMem = nullptr;
         handle._allocSize = 0;
+        prefetchMapped(mapPtr, startOffset, handle);
     } else {
         uint64_t endOffset = (handle._bitOffset + _headerBitSize +
                               handle._bitLength + 7) >> 3;
@@ -217,6 +240,9 @@ ZcPosOccRandRead::readHeader(const vespalib::string &identifier)
     if (header.hasTag(interleaved_features) && (header.getTag(interleaved_features).asInteger() != 0)) {
         _posting_params._encode_interleaved_features = true;
     }
+    _posting_params._encode_block_max_features = _posting_params._encode_interleaved_features &&
+                                                 header.hasTag(block_max_features) &&
+                                                 (header.getTag(block_max_features).asInteger() != 0);
     // Read feature decoding specific subheader
     d.readHeader(header, "features.");
     // Align on 64-bit unit
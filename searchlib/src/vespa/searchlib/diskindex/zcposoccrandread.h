@@ -22,6 +22,8 @@ protected:
     uint64_t _headerBitSize;
     bitcompression::PosOccFieldsParams _fieldsParams;
 
+    void prefetchMapped(void *mapPtr, uint64_t startOffset, const index::PostingListHandle &handle);
+
 public:
     ZcPosOccRandRead();
     ~ZcPosOccRandRead();
@@ -125,6 +125,16 @@ ZcRareWordPostingIterator<bigEndian, dynamic_k>::doSeek(uint32_t docId)
     return;
 }
 
+template <bool bigEndian, bool dynamic_k>
+uint32_t
+ZcRareWordPostingIterator<bigEndian, dynamic_k>::fill_docid_block(uint32_t begin_id, uint32_t *docids, uint32_t max_docids)
+{
+    uint32_t num_docids = 0;
+    for (this->seek(begin_id); (num_docids < max_docids) && !this->isAtEnd(); ZcRareWordPostingIterator::doSeek(getDocId() + 1)) {
+        docids[num_docids++] = getDocId();
+    }
+    return num_docids;
+}
 
 template <bool bigEndian>
 void
@@ -189,7 +199,8 @@ ZcRareWordPostingIterator<bigEndian, dynamic_k>::readWordStart(uint32_t docIdLim
 
 ZcPostingIteratorBase::ZcPostingIteratorBase(const TermFieldMatchDataArray &matchData, Position start, uint32_t docIdLimit,
                                              bool decode_normal_features, bool decode_interleaved_features,
-                                             bool unpack_normal_features, bool unpack_interleaved_features)
+                                             bool unpack_normal_features, bool unpack_interleaved_features,
+                                             bool decode_block_max_features)
     : ZcIteratorBase(matchData, start, docIdLimit),
       _valI(nullptr),
       _valIBase(nullptr),
@@ -205,6 +216,7 @@ ZcPostingIteratorBase::ZcPostingIteratorBase(const TermFieldMatchDataArray &matc
       _decode_interleaved_features(decode_interleaved_features),
       _unpack_normal_features(unpack_normal_features),
       _unpack_interleaved_features(unpack_interleaved_features),
+      _decode_block_max_features(decode_block_max_features && decode_interleaved_features),
       _chunkNo(0),
       _field_length(0),
       _num_occs(0)
@@ -219,10 +231,12 @@ ZcPostingIterator(uint32_t minChunkDocs,
                   const search::fef::TermFieldMatchDataArray &matchData,
                   Position start, uint32_t docIdLimit,
                   bool decode_normal_features, bool decode_interleaved_features,
-                  bool unpack_normal_features, bool unpack_interleaved_features)
+                  bool unpack_normal_features, bool unpack_interleaved_features,
+                  bool decode_block_max_features)
     : ZcPostingIteratorBase(matchData, start, docIdLimit,
                             decode_normal_features, decode_interleaved_features,
-                            unpack_normal_features, unpack_interleaved_features),
+                            unpack_normal_features, unpack_interleaved_features,
+                            decode_block_max_features),
       _decodeContext(nullptr),
       _minChunkDocs(minChunkDocs),
       _docIdK(0),
@@ -311,6 +325,11 @@ ZcPostingIterator<bigEndian>::readWordStart(uint32_t docIdLimit)
     _valIBase = _valI = bcompr;
     bcompr += docIdsSize;
     _l1.setup(prevDocId, _chunk._lastDocId, bcompr, l1SkipSize);
+    if (_decode_block_max_features && l1SkipSize != 0) {
+        _l1.decodeBlockMaxFeatures();
+    } else {
+        _l1.clearBlockMaxFeatures();
+    }
     _l2.setup(prevDocId, _chunk._lastDocId, bcompr, l2SkipSize);
     _l3.setup(prevDocId, _chunk._lastDocId, bcompr, l3SkipSize);
     _l4.setup(prevDocId, _chunk._lastDocId, bcompr, l4SkipSize);
@@ -385,7 +404,7 @@ ZcPostingIteratorBase::doL4SkipSeek(uint32_t docId)
     _l2._valI = _l3._l2Pos = _l4._l2Pos;
     _l3._valI = _l4._l3Pos;
     nextDocId(lastL4SkipDocId);
-    _l1.nextDocId();
+    l1NextDocId();
     _l2.nextDocId();
     _l3.nextDocId();
 #if DEBUG_ZCPOSTING_PRINTF
@@ -434,7 +453,7 @@ ZcPostingIteratorBase::doL3SkipSeek(uint32_t docId)
     _l1._valI = _l2._l1Pos = _l3._l1Pos;
     _l2._valI = _l3._l2Pos;
     nextDocId(lastL3SkipDocId);
-    _l1.nextDocId();
+    l1NextDocId();
     _l2.nextDocId();
 #if DEBUG_ZCPOSTING_PRINTF
     printf("L3Seek, docId %d docIdPos %d"
@@ -478,7 +497,7 @@ ZcPostingIteratorBase::doL2SkipSeek(uint32_t docId)
     _l1._skipDocId = lastL2SkipDocId;
     _l1._valI = _l2._l1Pos;
     nextDocId(lastL2SkipDocId);
-    _l1.nextDocId();
+    l1NextDocId();
 #if DEBUG_ZCPOSTING_PRINTF
     printf("L2Seek, docId %d docIdPos %d L1SkipPos %d, nextDocId %d\n",
            lastL2SkipDocId,
@@ -504,7 +523,7 @@ ZcPostingIteratorBase::doL1SkipSeek(uint32_t docId)
     do {
         lastL1SkipDocId = _l1._skipDocId;
         _l1.decodeSkipEntry(_decode_normal_features);
-        _l1.nextDocId();
+        l1NextDocId();
 #if DEBUG_ZCPOSTING_PRINTF
         printf("L1Decode docId %d, docIdPos %d, L1SkipPos %d, nextDocId %d\n",
                lastL1SkipDocId,
@@ -525,6 +544,45 @@ ZcPostingIteratorBase::doL1SkipSeek(uint32_t docId)
     clearUnpacked();
 }
 
+uint32_t
+ZcPostingIteratorBase::fill_docid_block(uint32_t begin_id, uint32_t *docids, uint32_t max_docids)
+{
+    uint32_t num_docids = 0;
+    seek(begin_id);
+    while ((num_docids < max_docids) && !isAtEnd()) {
+        docids[num_docids++] = getDocId();
+        // Decode the rest of the current L1 skip interval in a tight
+        // loop; only crossing a skip point needs the full seek logic.
+        uint32_t docId = getDocId();
+        const uint8_t *oCompr = _valI;
+        uint32_t field_length = _field_length;
+        uint32_t num_occs = _num_occs;
+        uint32_t skipDocId = std::min(_l1._skipDocId, getEndId());
+        while ((num_docids < max_docids) && (docId < skipDocId)) {
+            ZCDECODE(oCompr, docId += 1 +);
+            if (_decode_interleaved_features) {
+                ZCDECODE(oCompr, field_length = 1 +);
+                ZCDECODE(oCompr, num_occs = 1 +);
+            }
+            incNeedUnpack();
+            if (isAtEnd(docId)) {
+                break;
+            }
+            docids[num_docids++] = docId;
+        }
+        _valI = oCompr;
+        setDocId(docId);
+        if (_decode_interleaved_features) {
+            _field_length = field_length;
+            _num_occs = num_occs;
+        }
+        if (isAtEnd()) {
+            break;
+        }
+        ZcPostingIteratorBase::doSeek(docId + 1);
+    }
+    return num_docids;
+}
 
 void
 ZcPostingIteratorBase::doSeek(uint32_t docId)
@@ -6,6 +6,7 @@
 #include <vespa/searchlib/bitcompression/compression.h>
 #include <vespa/searchlib/queryeval/iterators.h>
 #include <vespa/fastos/dynamiclibrary.h>
+#include <limits>
 
 namespace search::diskindex {
 
@@ -132,6 +133,8 @@ public:
                               bool decode_normal_features, bool decode_interleaved_features,
                               bool unpack_normal_features, bool unpack_interleaved_features);
     void doSeek(uint32_t docId) override;
+    uint32_t fill_docid_block(uint32_t begin_id, uint32_t *docids, uint32_t max_docids) override;
+    bool has_fast_docid_block() const override { return true; }
     void readWordStart(uint32_t docIdLimit) override;
 };
 
@@ -151,13 +154,18 @@ protected:
         const uint8_t *_docIdPos;
         uint64_t _skipFeaturePos;
         const uint8_t *_valIBase;
+        // Bounds on interleaved features for documents up to and including _skipDocId
+        uint32_t _blockMaxNumOccs;
+        uint32_t _blockMinFieldLength;
 
         L1Skip()
             : _skipDocId(0),
               _valI(nullptr),
               _docIdPos(nullptr),
               _skipFeaturePos(0),
-              _valIBase(nullptr)
+              _valIBase(nullptr),
+              _blockMaxNumOccs(std::numeric_limits<uint32_t>::max()),
+              _blockMinFieldLength(1)
         {
         }
 
@@ -185,6 +193,14 @@ protected:
         void nextDocId() {
             ZCDECODE(_valI, _skipDocId += 1 +);
         }
+        void decodeBlockMaxFeatures() {
+            ZCDECODE(_valI, _blockMaxNumOccs = 1 +);
+            ZCDECODE(_valI, _blockMinFieldLength = 1 +);
+        }
+        void clearBlockMaxFeatures() {
+            _blockMaxNumOccs = std::numeric_limits<uint32_t>::max();
+            _blockMinFieldLength = 1;
+        }
     };
 
     // Helper class for L2 skip info
@@ -279,10 +295,17 @@ protected:
     bool     _decode_interleaved_features;
     bool     _unpack_normal_features;
     bool     _unpack_interleaved_features;
+    bool     _decode_block_max_features;
     uint32_t _chunkNo;
     uint32_t _field_length;
     uint32_t _num_occs;
 
+    void l1NextDocId() {
+        _l1.nextDocId();
+        if (_decode_block_max_features) {
+            _l1.decodeBlockMaxFeatures();
+        }
+    }
     void nextDocId(uint32_t prevDocId) {
         uint32_t docId = prevDocId + 1;
         ZCDECODE(_valI, docId +=);
@@ -302,7 +325,23 @@ protected:
 public:
     ZcPostingIteratorBase(const fef::TermFieldMatchDataArray &matchData, Position start, uint32_t docIdLimit,
                           bool decode_normal_features, bool decode_interleaved_features,
-                          bool unpack_normal_features, bool unpack_interleaved_features);
+                          bool unpack_normal_features, bool unpack_interleaved_features,
+                          bool decode_block_max_features);
+
+    uint32_t fill_docid_block(uint32_t begin_id, uint32_t *docids, uint32_t max_docids) override;
+    bool has_fast_docid_block() const override { return true; }
+
+    /*
+     * Block max features: Upper bound on number of occurrences and lower
+     * bound on field length for the documents from the current position
+     * up to and including get_block_last_doc_id(), taken from the L1 skip
+     * info. Lets a caller skip a block whose best possible score is too low
+     * without decoding it. Without block max features the bounds are trivial.
+     */
+    bool has_block_max_features() const { return _decode_block_max_features; }
+    uint32_t get_block_last_doc_id() const { return _l1._skipDocId; }
+    uint32_t get_block_max_num_occs() const { return _l1._blockMaxNumOccs; }
+    uint32_t get_block_min_field_length() const { return _l1._blockMinFieldLength; }
 };
 
 template <bool bigEndian>
@@ -331,7 +370,8 @@ public:
     ZcPostingIterator(uint32_t minChunkDocs, bool dynamicK, const PostingListCounts &counts,
                       const search::fef::TermFieldMatchDataArray &matchData, Position start, uint32_t docIdLimit,
                       bool decode_normal_features, bool decode_interleaved_features,
-                      bool unpack_normal_features, bool unpack_interleaved_features);
+                      bool unpack_normal_features, bool unpack_interleaved_features,
+                      bool decode_block_max_features);
 
 
     void doUnpack(uint32_t docId) override;
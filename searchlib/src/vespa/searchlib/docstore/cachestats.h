@@ -13,21 +13,25 @@ struct CacheStats {
     size_t elements;
     size_t memory_used;
     size_t invalidations;
+    size_t rejections;
 
     CacheStats()
         : hits(0),
           misses(0),
           elements(0),
           memory_used(0),
-          invalidations(0)
+          invalidations(0),
+          rejections(0)
     { }
 
-    CacheStats(size_t hits_, size_t misses_, size_t elements_, size_t memory_used_, size_t invalidations_)
+    CacheStats(size_t hits_, size_t misses_, size_t elements_, size_t memory_used_, size_t invalidations_,
+               size_t rejections_ = 0)
         : hits(hits_),
           misses(misses_),
           elements(elements_),
           memory_used(memory_used_),
-          invalidations(invalidations_)
+          invalidations(invalidations_),
+          rejections(rejections_)
     { }
 
     CacheStats &
@@ -38,6 +42,7 @@ struct CacheStats {
         elements += rhs.elements;
         memory_used += rhs.memory_used;
         invalidations += rhs.invalidations;
+        rejections += rhs.rejections;
         return *this;
     }
 
@@ -10,8 +10,8 @@ class ChunkFormatV1 : public ChunkFormat
 {
 public:
     enum {VERSION=0};
-    ChunkFormatV1(vespalib::nbostream & is);
-    ChunkFormatV1(vespalib::nbostream & is, uint32_t expectedCrc);
+    ChunkFormatV1(vespalib::nbostream & is, const ZStdDictionary * dictionary);
+    ChunkFormatV1(vespalib::nbostream & is, uint32_t expectedCrc, const ZStdDictionary * dictionary);
     ChunkFormatV1(size_t maxSize);
 private:
     bool includeSerializedSize() const override { return false; }
@@ -27,8 +27,8 @@ class ChunkFormatV2 : public ChunkFormat
 {
 public:
     enum {VERSION=1, MAGIC=0x5ba32de7};
-    ChunkFormatV2(vespalib::nbostream & is);
-    ChunkFormatV2(vespalib::nbostream & is, uint32_t expectedCrc);
+    ChunkFormatV2(vespalib::nbostream & is, const ZStdDictionary * dictionary);
+    ChunkFormatV2(vespalib::nbostream & is, uint32_t expectedCrc, const ZStdDictionary * dictionary);
     ChunkFormatV2(size_t maxSize);
 private:
     bool includeSerializedSize() const override { return true; }
@@ -9,6 +9,7 @@
 #include <vespa/vespalib/stllike/cache.hpp>
 #include <vespa/vespalib/data/databuffer.h>
 #include <vespa/vespalib/util/compressor.h>
+#include <algorithm>
 
 #include <vespa/log/log.h>
 
@@ -21,6 +22,11 @@ namespace search {
 
 namespace {
 
+// used to estimate how many documents the admission filter must track
+constexpr size_t EXPECTED_CACHED_DOCUMENT_SIZE = 1024;
+constexpr size_t MIN_ADMISSION_FILTER_ELEMENTS = 1024;
+constexpr size_t MAX_ADMISSION_FILTER_ELEMENTS = 1024 * 1024;
+
 class DocumentVisitorAdapter : public IBufferVisitor
 {
 public:
@@ -38,7 +44,7 @@ void
 DocumentVisitorAdapter::visit(uint32_t lid, vespalib::ConstBufferRef buf) {
     if (buf.size() > 0) {
         vespalib::nbostream is(buf.c_str(), buf.size());
-        _visitor.visit(lid, std::make_unique<document::Document>(_repo, is));
+        _visitor.visit(lid, std::make_unique<document::Document>(_repo, is), buf.size());
     }
 }
 
@@ -118,6 +124,7 @@ bool
 DocumentStore::Config::operator == (const Config &rhs) const {
     return  (_maxCacheBytes == rhs._maxCacheBytes) &&
             (_allowVisitCaching == rhs._allowVisitCaching) &&
+            (_cacheAdmissionFilter == rhs._cacheAdmissionFilter) &&
             (_initialCacheEntries == rhs._initialCacheEntries) &&
             (_updateStrategy == rhs._updateStrategy) &&
             (_compression == rhs._compression);
@@ -134,6 +141,7 @@ DocumentStore::DocumentStore(const Config & config, IDataStore & store)
       _uncached_lookups(0)
 {
     _cache->reserveElements(config.getInitialCacheEntries());
+    configureAdmissionFilter(config);
 }
 
 DocumentStore::~DocumentStore() = default;
@@ -143,10 +151,26 @@ DocumentStore::reconfigure(const Config & config) {
     _cache->setCapacityBytes(config.getMaxCacheBytes());
     _store->reconfigure(config.getCompression());
     _visitCache->reconfigure(_config.getMaxCacheBytes(), config.getCompression());
+    if (config.cacheAdmissionFilter() != _config.cacheAdmissionFilter()) {
+        configureAdmissionFilter(config);
+    }
 
     _config = config;
 }
 
+void
+DocumentStore::configureAdmissionFilter(const Config & config) {
+    size_t expectedElements = 0;
+    if (config.cacheAdmissionFilter()) {
+        expectedElements = std::max(config.getMaxCacheBytes() / EXPECTED_CACHED_DOCUMENT_SIZE,
+                                    config.getInitialCacheEntries());
+        expectedElements = std::min(std::max(expectedElements, MIN_ADMISSION_FILTER_ELEMENTS),
+                                    MAX_ADMISSION_FILTER_ELEMENTS);
+    }
+    _cache->admissionFilter(expectedElements);
+    _visitCache->admissionFilter(expectedElements);
+}
+
 bool
 DocumentStore::useCache() const {
     return (_cache->capacityBytes() != 0) && (_cache->capacity() != 0);
@@ -416,6 +440,12 @@ DocumentStore::getStorageStats() const
     return _backingStore.getStorageStats();
 }
 
+IoThrottleStats
+DocumentStore::getCompactionThrottleStats() const
+{
+    return _backingStore.getCompactionThrottleStats();
+}
+
 vespalib::MemoryUsage
 DocumentStore::getMemoryUsage() const
 {
@@ -429,13 +459,20 @@ DocumentStore::getFileChunkStats() const
 }
 
 CacheStats DocumentStore::getCacheStats() const {
-    CacheStats visitStats = _visitCache->getCacheStats();
-    CacheStats singleStats(_cache->getHit(), _cache->getMiss() + _uncached_lookups,
-                           _cache->size(), _cache->sizeBytes(), _cache->getInvalidate());
-    singleStats += visitStats;
+    CacheStats singleStats = getLookupCacheStats();
+    singleStats += getVisitCacheStats();
     return singleStats;
 }
 
+CacheStats DocumentStore::getLookupCacheStats() const {
+    return CacheStats(_cache->getHit(), _cache->getMiss() + _uncached_lookups,
+                      _cache->size(), _cache->sizeBytes(), _cache->getInvalidate(), _cache->getReject());
+}
+
+CacheStats DocumentStore::getVisitCacheStats() const {
+    return _visitCache->getCacheStats();
+}
+
 void
 DocumentStore::compactLidSpace(uint32_t wantedDocLidLimit)
 {
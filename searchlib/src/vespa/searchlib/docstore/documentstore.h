@@ -30,20 +30,28 @@ public:
             _maxCacheBytes(1000000000),
             _initialCacheEntries(0),
             _updateStrategy(INVALIDATE),
-            _allowVisitCaching(false)
+            _allowVisitCaching(false),
+            _cacheAdmissionFilter(false)
         { }
         Config(const CompressionConfig & compression, size_t maxCacheBytes, size_t initialCacheEntries) :
             _compression((maxCacheBytes != 0) ? compression : CompressionConfig::NONE),
             _maxCacheBytes(maxCacheBytes),
             _initialCacheEntries(initialCacheEntries),
             _updateStrategy(INVALIDATE),
-            _allowVisitCaching(false)
+            _allowVisitCaching(false),
+            _cacheAdmissionFilter(false)
         { }
         const CompressionConfig & getCompression() const { return _compression; }
         size_t getMaxCacheBytes()   const { return _maxCacheBytes; }
         size_t getInitialCacheEntries() const { return _initialCacheEntries; }
         bool allowVisitCaching() const { return _allowVisitCaching; }
         Config & allowVisitCaching(bool allow) { _allowVisitCaching = allow; return *this; }
+        /**
+         * Only admit objects into the caches when they are read more often than
+         * the objects they would evict, so scans do not flush the caches.
+         */
+        bool cacheAdmissionFilter() const { return _cacheAdmissionFilter; }
+        Config & cacheAdmissionFilter(bool enable) { _cacheAdmissionFilter = enable; return *this; }
         Config & updateStrategy(UpdateStrategy strategy) { _updateStrategy = strategy; return *this; }
         UpdateStrategy updateStrategy() const { return _updateStrategy; }
         bool operator == (const Config &) const;
@@ -53,6 +61,7 @@ public:
         size_t _initialCacheEntries;
         UpdateStrategy _updateStrategy;
         bool   _allowVisitCaching;
+        bool   _cacheAdmissionFilter;
     };
 
     /**
@@ -82,6 +91,8 @@ public:
     size_t      getDiskBloat() const override { return _backingStore.getDiskBloat(); }
     size_t getMaxCompactGain() const override { return _backingStore.getMaxCompactGain(); }
     CacheStats getCacheStats() const override;
+    CacheStats getLookupCacheStats() const override;
+    CacheStats getVisitCacheStats() const override;
     size_t memoryMeta() const override { return _backingStore.memoryMeta(); }
     const vespalib::string & getBaseDir() const override { return _backingStore.getBaseDir(); }
     void accept(IDocumentStoreReadVisitor &visitor, IDocumentStoreVisitorProgress &visitorProgress,
@@ -90,6 +101,7 @@ public:
                 const document::DocumentTypeRepo &repo) override;
     double getVisitCost() const override;
     DataStoreStorageStats getStorageStats() const override;
+    IoThrottleStats getCompactionThrottleStats() const override;
     vespalib::MemoryUsage getMemoryUsage() const override;
     std::vector<DataStoreFileChunkStats> getFileChunkStats() const override;
 
@@ -104,6 +116,7 @@ public:
 
 private:
     bool useCache() const;
+    void configureAdmissionFilter(const Config & config);
 
     template <class> class WrapVisitor;
     class WrapVisitorProgress;
@@ -4,6 +4,7 @@
 #include "data_store_file_chunk_stats.h"
 #include "summaryexceptions.h"
 #include "randreaders.h"
+#include "io_throttle.h"
 #include <vespa/searchlib/util/filekit.h>
 #include <vespa/vespalib/util/lambdatask.h>
 #include <vespa/vespalib/data/fileheader.h>
@@ -29,6 +30,49 @@ namespace {
 constexpr size_t ALIGNMENT=0x1000;
 constexpr size_t ENTRY_BIAS_SIZE=8;
 const vespalib::string DOC_ID_LIMIT_KEY("docIdLimit");
+// String tags can not hold arbitrary bytes, so the dictionary is stored hex encoded.
+const vespalib::string ZSTD_DICTIONARY_KEY("zstdDictionary");
+
+vespalib::string
+hexEncode(const vespalib::string & raw)
+{
+    static const char digits[] = "0123456789abcdef";
+    vespalib::string hex;
+    hex.reserve(raw.size() * 2);
+    for (char c : raw) {
+        uint8_t byte(c);
+        hex.push_back(digits[byte >> 4]);
+        hex.push_back(digits[byte & 0xf]);
+    }
+    return hex;
+}
+
+int
+hexValue(char c)
+{
+    if ((c >= '0') && (c <= '9')) { return c - '0'; }
+    if ((c >= 'a') && (c <= 'f')) { return c - 'a' + 10; }
+    return -1;
+}
+
+vespalib::string
+hexDecode(const vespalib::string & hex)
+{
+    if ((hex.size() % 2) != 0) {
+        throw std::runtime_error(vespalib::make_string("Illegal hex encoded dictionary of length %zu", hex.size()));
+    }
+    vespalib::string raw;
+    raw.reserve(hex.size() / 2);
+    for (size_t i(0); i < hex.size(); i += 2) {
+        int hi = hexValue(hex[i]);
+        int lo = hexValue(hex[i + 1]);
+        if ((hi < 0) || (lo < 0)) {
+            throw std::runtime_error(vespalib::make_string("Illegal character in hex encoded dictionary at %zu", i));
+        }
+        raw.push_back(char((hi << 4) | lo));
+    }
+    return raw;
+}
 
 }
 
@@ -83,7 +127,8 @@ FileChunk::FileChunk(FileId fileId, NameId nameId, const vespalib::string & base
       _idxHeaderLen(0u),
       _numLids(0),
       _docIdLimit(std::numeric_limits<uint32_t>::max()),
-      _modificationTime()
+      _modificationTime(),
+      _dictionary()
 {
     FastOS_File dataFile(_dataFileName.c_str());
     if (dataFile.OpenReadOnly()) {
@@ -276,6 +321,24 @@ FileChunk::enableRead()
     if (_dataHeaderLen == 0u) {
         throw std::runtime_error(make_string("bad file header: %s", _dataFileName.c_str()));
     }
+    if ( ! _dictionary) {
+        loadDictionary();
+    }
+}
+
+void
+FileChunk::loadDictionary()
+{
+    vespalib::DataBuffer h(_dataHeaderLen, ALIGNMENT);
+    FileRandRead::FSP keepAlive(_file->read(0, h, _dataHeaderLen));
+    GenericHeader::BufferReader rd(h);
+    GenericHeader header;
+    header.read(rd);
+    _dictionary = readDictionary(header);
+    if (_dictionary) {
+        LOG(debug, "loadDictionary(): file='%s' uses zstd dictionary %u of %zu bytes",
+            _dataFileName.c_str(), _dictionary->id(), _dictionary->content().size());
+    }
 }
 
 size_t FileChunk::adjustSize(size_t sz) {
@@ -337,7 +400,8 @@ appendChunks(FixedParams * args, Chunk::UP chunk)
 
 void
 FileChunk::appendTo(vespalib::ThreadExecutor & executor, const IGetLid & db, IWriteData & dest,
-                    uint32_t numChunks, IFileChunkVisitorProgress *visitorProgress)
+                    uint32_t numChunks, IFileChunkVisitorProgress *visitorProgress,
+                    docstore::IoThrottle *throttle)
 {
     assert(frozen() || visitorProgress);
     vespalib::GenerationHandler::Guard lidReadGuard(db.getLidReadGuard());
@@ -347,11 +411,22 @@ FileChunk::appendTo(vespalib::ThreadExecutor & executor, const IGetLid & db, IWr
     for (size_t chunkId(0); chunkId < numChunks; chunkId++) {
         std::promise<Chunk::UP> promisedChunk;
         std::future<Chunk::UP> futureChunk = promisedChunk.get_future();
-        executor.execute(vespalib::makeLambdaTask([promise = std::move(promisedChunk), chunkId, this]() mutable {
+        if (throttle != nullptr) {
+            throttle->acquire(_chunkInfo[chunkId].getSize());
+        }
+        executor.execute(vespalib::makeLambdaTask([promise = std::move(promisedChunk), chunkId, throttle, this]() mutable {
             const ChunkInfo & cInfo(_chunkInfo[chunkId]);
             vespalib::DataBuffer whole(0ul, ALIGNMENT);
+            std::unique_ptr<docstore::LowIoPriorityGuard> lowPriority;
+            if (throttle != nullptr) {
+                lowPriority = std::make_unique<docstore::LowIoPriorityGuard>();
+            }
+            vespalib::steady_time start = vespalib::steady_clock::now();
             FileRandRead::FSP keepAlive(_file->read(cInfo.getOffset(), whole, cInfo.getSize()));
-            promise.set_value(std::make_unique<Chunk>(chunkId, whole.getData(), whole.getDataLen()));
+            if (throttle != nullptr) {
+                throttle->reportReadLatency(vespalib::steady_clock::now() - start);
+            }
+            promise.set_value(std::make_unique<Chunk>(chunkId, whole.getData(), whole.getDataLen(), false, _dictionary.get()));
         }));
 
         singleExecutor.execute(vespalib::makeLambdaTask([args = &fixedParams, chunk = std::move(futureChunk)]() mutable {
@@ -366,19 +441,35 @@ void
 FileChunk::read(LidInfoWithLidV::const_iterator begin, size_t count, IBufferVisitor & visitor) const
 {
     if (count == 0) { return; }
+    std::vector<uint32_t> starts;
     uint32_t prevChunk = begin->getChunkId();
-    uint32_t start(0);
+    starts.push_back(0);
     for (size_t i(0); i < count; i++) {
         const LidInfoWithLid & li = *(begin + i);
         if (li.getChunkId() != prevChunk) {
-            ChunkInfo ci = _chunkInfo[prevChunk];
-            read(begin + start, i - start, ci, visitor);
             prevChunk = li.getChunkId();
-            start = i;
+            starts.push_back(i);
         }
     }
-    ChunkInfo ci = _chunkInfo[prevChunk];
-    read(begin + start, count - start, ci, visitor);
+    starts.push_back(count);
+    const size_t numChunks = starts.size() - 1;
+    auto chunkInfo = [&](size_t i) { return _chunkInfo[(begin + starts[i])->getChunkId()]; };
+    // Let the kernel fetch the following chunks while the first ones are read and decompressed.
+    for (size_t i(1); (i <= PREFETCH_CHUNKS) && (i < numChunks); i++) {
+        prefetch(chunkInfo(i));
+    }
+    for (size_t i(0); i < numChunks; i++) {
+        if (i + 1 + PREFETCH_CHUNKS < numChunks) {
+            prefetch(chunkInfo(i + 1 + PREFETCH_CHUNKS));
+        }
+        read(begin + starts[i], starts[i + 1] - starts[i], chunkInfo(i), visitor);
+    }
+}
+
+void
+FileChunk::prefetch(const ChunkInfo & ci) const
+{
+    _file->prefetch(ci.getOffset(), ci.getSize());
 }
 
 void
@@ -386,7 +477,7 @@ FileChunk::read(LidInfoWithLidV::const_iterator begin, size_t count, ChunkInfo c
 {
     vespalib::DataBuffer whole(0ul, ALIGNMENT);
     FileRandRead::FSP keepAlive = _file->read(ci.getOffset(), whole, ci.getSize());
-    Chunk chunk(begin->getChunkId(), whole.getData(), whole.getDataLen(), _skipCrcOnRead);
+    Chunk chunk(begin->getChunkId(), whole.getData(), whole.getDataLen(), _skipCrcOnRead, _dictionary.get());
     for (size_t i(0); i < count; i++) {
         const LidInfoWithLid & li = *(begin + i);
         vespalib::ConstBufferRef buf = chunk.getLid(li.getLid());
@@ -411,7 +502,7 @@ FileChunk::read(uint32_t lid, SubChunkId chunkId, const ChunkInfo & chunkInfo,
 {
     vespalib::DataBuffer whole(0ul, ALIGNMENT);
     FileRandRead::FSP keepAlive(_file->read(chunkInfo.getOffset(), whole, chunkInfo.getSize()));
-    Chunk chunk(chunkId, whole.getData(), whole.getDataLen(), _skipCrcOnRead);
+    Chunk chunk(chunkId, whole.getData(), whole.getDataLen(), _skipCrcOnRead, _dictionary.get());
     return chunk.read(lid, buffer);
 }
 
@@ -473,6 +564,49 @@ FileChunk::writeDocIdLimit(vespalib::GenericHeader &header, uint32_t docIdLimit)
     header.putTag(vespalib::GenericHeader::Tag(DOC_ID_LIMIT_KEY, docIdLimit));
 }
 
+FileChunk::ZStdDictionary::SP
+FileChunk::readDictionary(const vespalib::GenericHeader &header)
+{
+    if (header.hasTag(ZSTD_DICTIONARY_KEY)) {
+        return std::make_shared<ZStdDictionary>(hexDecode(header.getTag(ZSTD_DICTIONARY_KEY).asString()));
+    } else {
+        return ZStdDictionary::SP();
+    }
+}
+
+void
+FileChunk::writeDictionary(vespalib::GenericHeader &header, const ZStdDictionary &dictionary)
+{
+    header.putTag(vespalib::GenericHeader::Tag(ZSTD_DICTIONARY_KEY, hexEncode(dictionary.content())));
+}
+
+std::vector<vespalib::string>
+FileChunk::sampleDocuments(size_t maxBytes) const
+{
+    std::vector<vespalib::string> samples;
+    if (_chunkInfo.empty() || (_addedBytes == 0)) {
+        return samples;
+    }
+    size_t bytesPerChunk = std::max(1ul, _addedBytes / _chunkInfo.size());
+    size_t numSampledChunks = std::min(_chunkInfo.size(), std::max(1ul, maxBytes / bytesPerChunk));
+    size_t collected(0);
+    for (size_t i(0); (i < numSampledChunks) && (collected < maxBytes); i++) {
+        size_t chunkId = (i * _chunkInfo.size()) / numSampledChunks;
+        const ChunkInfo & ci = _chunkInfo[chunkId];
+        vespalib::DataBuffer whole(0ul, ALIGNMENT);
+        FileRandRead::FSP keepAlive(_file->read(ci.getOffset(), whole, ci.getSize()));
+        const Chunk chunk(chunkId, whole.getData(), whole.getDataLen(), _skipCrcOnRead, _dictionary.get());
+        for (const Chunk::Entry & e : chunk.getLids()) {
+            if (e.netSize() > 0) {
+                vespalib::ConstBufferRef buf(chunk.getData().data() + e.getNetOffset(), e.netSize());
+                samples.emplace_back(buf.c_str(), buf.size());
+                collected += buf.size();
+            }
+        }
+    }
+    return samples;
+}
+
 void
 FileChunk::verify(bool reportOnly) const
 {
@@ -487,7 +621,7 @@ FileChunk::verify(bool reportOnly) const
         vespalib::DataBuffer whole(0ul, ALIGNMENT);
         FileRandRead::FSP keepAlive(_file->read(ci.getOffset(), whole, ci.getSize()));
         try {
-            Chunk chunk(chunkId++, whole.getData(), whole.getDataLen());
+            Chunk chunk(chunkId++, whole.getData(), whole.getDataLen(), false, _dictionary.get());
             assert(chunk.getLastSerial() >= lastSerial);
             lastSerial = chunk.getLastSerial();
             if (errorInPrev) {
@@ -13,6 +13,7 @@
 #include <vespa/vespalib/stllike/hash_map.h>
 #include <vespa/vespalib/util/generationhandler.h>
 #include <vespa/vespalib/util/time.h>
+#include <vespa/vespalib/util/zstdcompressor.h>
 
 class FastOS_FileInterface;
 
@@ -26,6 +27,8 @@ namespace search {
 
 class DataStoreFileChunkStats;
 
+namespace docstore { class IoThrottle; }
+
 class IWriteData
 {
 public:
@@ -74,6 +77,7 @@ class FileChunk
 {
 public:
     using LockGuard = vespalib::LockGuard;
+    using ZStdDictionary = vespalib::compression::ZStdDictionary;
     class NameId {
     public:
         explicit NameId(size_t id) : _id(id) { }
@@ -164,8 +168,14 @@ public:
     virtual bool frozen() const { return true; }
     const vespalib::string & getName() const { return _name; }
     void compact(const IGetLid & iGetLid);
+    /**
+     * Read the first numChunks chunks and pass the live entries to dest.
+     * If a throttle is given, the reads are done at low I/O priority and
+     * at the rate allowed by the throttle.
+     */
     void appendTo(vespalib::ThreadExecutor & executor, const IGetLid & db, IWriteData & dest,
-                  uint32_t numChunks, IFileChunkVisitorProgress *visitorProgress);
+                  uint32_t numChunks, IFileChunkVisitorProgress *visitorProgress,
+                  docstore::IoThrottle *throttle);
     /**
      * Must be called after chunk has been created to allow correct
      * underlying file object to be created.  Must be called before
@@ -183,6 +193,14 @@ public:
      */
     void verify(bool reportOnly) const;
 
+    /**
+     * Collect the documents stored in evenly spaced chunks until
+     * approximately maxBytes have been collected. Used as samples
+     * when training a compression dictionary for a new file.
+     */
+    std::vector<vespalib::string> sampleDocuments(size_t maxBytes) const;
+    const ZStdDictionary::SP & getDictionary() const { return _dictionary; }
+
     uint32_t      getNumChunks() const;
     size_t       getNumBuckets() const { return _sumNumBuckets; }
     size_t getNumUniqueBuckets() const { return _numUniqueBuckets; }
@@ -202,6 +220,7 @@ public:
 private:
     typedef std::unique_ptr<FileRandRead> File;
     void loadChunkInfo();
+    void loadDictionary();
     const FileId           _fileId;
     const NameId           _nameId;
     const vespalib::string _name;
@@ -236,8 +255,13 @@ protected:
     void setNumUniqueBuckets(size_t numUniqueBuckets) { _numUniqueBuckets = numUniqueBuckets; }
     ssize_t read(uint32_t lid, SubChunkId chunkId, const ChunkInfo & chunkInfo, vespalib::DataBuffer & buffer) const;
     void read(LidInfoWithLidV::const_iterator begin, size_t count, ChunkInfo ci, IBufferVisitor & visitor) const;
+    // Number of chunks ahead of the one being decompressed that may be in flight from disk.
+    static constexpr size_t PREFETCH_CHUNKS = 32;
+    void prefetch(const ChunkInfo & ci) const;
     static uint32_t readDocIdLimit(vespalib::GenericHeader &header);
     static void writeDocIdLimit(vespalib::GenericHeader &header, uint32_t docIdLimit);
+    static ZStdDictionary::SP readDictionary(const vespalib::GenericHeader &header);
+    static void writeDictionary(vespalib::GenericHeader &header, const ZStdDictionary &dictionary);
 
     typedef vespalib::Array<ChunkInfo> ChunkInfoVector;
     const IBucketizer   * _bucketizer;
@@ -252,6 +276,7 @@ protected:
     uint32_t              _numLids;
     uint32_t              _docIdLimit; // Limit when the file was created. Stored in idx file header.
     vespalib::system_time  _modificationTime;
+    ZStdDictionary::SP    _dictionary; // Used by chunks compressed with a trained dictionary. Stored in dat file header.
 };
 
 } // namespace search
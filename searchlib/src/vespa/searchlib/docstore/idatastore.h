@@ -3,6 +3,7 @@
 #pragma once
 
 #include "data_store_file_chunk_stats.h"
+#include "io_throttle_stats.h"
 #include <vespa/searchlib/common/i_compactable_lid_space.h>
 #include <vespa/vespalib/stllike/string.h>
 #include <vespa/vespalib/util/memoryusage.h>
@@ -162,6 +163,11 @@ public:
      */
     virtual DataStoreStorageStats getStorageStats() const = 0;
 
+    /*
+     * Return the state of the I/O throttling of compaction.
+     */
+    virtual IoThrottleStats getCompactionThrottleStats() const { return IoThrottleStats(); }
+
     /*
      * Return the memory usage for data store.
      */
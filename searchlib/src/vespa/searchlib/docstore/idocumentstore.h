@@ -49,6 +49,14 @@ public:
     using DocumentUP = std::unique_ptr<document::Document>;
     virtual ~IDocumentVisitor() { }
     virtual void visit(uint32_t lid, DocumentUP doc) = 0;
+    /**
+     * Visit a document read from its serialized form, also giving the size of the serialized
+     * document. This can be used instead of serializing the document again when the size is needed.
+     */
+    virtual void visit(uint32_t lid, DocumentUP doc, size_t serializedSize) {
+        (void) serializedSize;
+        visit(lid, std::move(doc));
+    }
     virtual bool allowVisitCaching() const = 0;
 private:
 };
@@ -176,6 +184,16 @@ public:
      */
     virtual CacheStats getCacheStats() const = 0;
 
+    /**
+     * Returns statistics about the part of the cache used for single document lookups.
+     */
+    virtual CacheStats getLookupCacheStats() const = 0;
+
+    /**
+     * Returns statistics about the part of the cache used when visiting a set of documents.
+     */
+    virtual CacheStats getVisitCacheStats() const = 0;
+
     /**
      * Returns the base directory from which all structures are stored.
      **/
@@ -207,6 +225,11 @@ public:
      */
     virtual DataStoreStorageStats getStorageStats() const = 0;
 
+    /*
+     * Return the state of the I/O throttling of compaction.
+     */
+    virtual IoThrottleStats getCompactionThrottleStats() const { return IoThrottleStats(); }
+
     /*
      * Return the memory usage for document store.
      */
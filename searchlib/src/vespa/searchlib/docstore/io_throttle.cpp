@@ -0,0 +1,139 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "io_throttle.h"
+#include <algorithm>
+#include <thread>
+#ifdef __linux__
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace search::docstore {
+
+namespace {
+
+// never throttle below this fraction of the configured rate
+constexpr double MIN_RATE_FACTOR = 1.0/16;
+// rate multiplier applied for each read slower than the latency target
+constexpr double RATE_DECREASE_FACTOR = 0.8;
+// fraction of the configured rate added back for each fast enough read
+constexpr double RATE_INCREASE_FACTOR = 1.0/32;
+// weight of a new latency sample in the smoothed read latency
+constexpr double LATENCY_SMOOTHING = 0.1;
+
+constexpr int IOPRIO_WHO_PROCESS = 1;
+constexpr int IOPRIO_CLASS_SHIFT = 13;
+constexpr int IOPRIO_CLASS_BE = 2;
+constexpr int IOPRIO_BE_LOWEST = 7;
+
+int
+getIoPriority()
+{
+#if defined(__linux__) && defined(SYS_ioprio_get)
+    return syscall(SYS_ioprio_get, IOPRIO_WHO_PROCESS, 0);
+#else
+    return -1;
+#endif
+}
+
+void
+setIoPriority(int priority)
+{
+#if defined(__linux__) && defined(SYS_ioprio_set)
+    syscall(SYS_ioprio_set, IOPRIO_WHO_PROCESS, 0, priority);
+#else
+    (void) priority;
+#endif
+}
+
+}
+
+IoThrottle::IoThrottle()
+    : _lock(),
+      _rateLimit(0),
+      _currentRate(0),
+      _latencyTarget(vespalib::duration::zero()),
+      _nextFree(),
+      _bytes(0),
+      _throttledTime(vespalib::duration::zero()),
+      _readLatency(0),
+      _waiters(0)
+{ }
+
+IoThrottle::~IoThrottle() = default;
+
+void
+IoThrottle::setRateLimit(uint64_t bytesPerSecond, vespalib::duration latencyTarget)
+{
+    Guard guard(_lock);
+    if (bytesPerSecond != _rateLimit) {
+        _rateLimit = bytesPerSecond;
+        _currentRate = bytesPerSecond;
+    }
+    _latencyTarget = latencyTarget;
+}
+
+void
+IoThrottle::acquire(size_t bytes)
+{
+    vespalib::duration wait = vespalib::duration::zero();
+    {
+        Guard guard(_lock);
+        _bytes += bytes;
+        if (_rateLimit == 0) {
+            return;
+        }
+        vespalib::steady_time now = vespalib::steady_clock::now();
+        _nextFree = std::max(_nextFree, now);
+        wait = _nextFree - now;
+        _nextFree += vespalib::from_s(bytes / _currentRate);
+        if (wait <= vespalib::duration::zero()) {
+            return;
+        }
+        ++_waiters;
+    }
+    std::this_thread::sleep_for(wait);
+    Guard guard(_lock);
+    --_waiters;
+    _throttledTime += wait;
+}
+
+void
+IoThrottle::reportReadLatency(vespalib::duration latency)
+{
+    Guard guard(_lock);
+    _readLatency += (vespalib::to_s(latency) - _readLatency) * LATENCY_SMOOTHING;
+    if (_rateLimit == 0 || _latencyTarget <= vespalib::duration::zero()) {
+        return;
+    }
+    if (_readLatency > vespalib::to_s(_latencyTarget)) {
+        _currentRate = std::max(_currentRate * RATE_DECREASE_FACTOR, _rateLimit * MIN_RATE_FACTOR);
+    } else {
+        _currentRate = std::min(_currentRate + _rateLimit * RATE_INCREASE_FACTOR, double(_rateLimit));
+    }
+}
+
+IoThrottleStats
+IoThrottle::getStats() const
+{
+    Guard guard(_lock);
+    return IoThrottleStats(_rateLimit, _currentRate, _bytes, _throttledTime,
+                           vespalib::from_s(_readLatency), _waiters > 0);
+}
+
+LowIoPriorityGuard::LowIoPriorityGuard()
+    : _oldPriority(getIoPriority())
+{
+    if (_oldPriority >= 0) {
+        setIoPriority((IOPRIO_CLASS_BE << IOPRIO_CLASS_SHIFT) | IOPRIO_BE_LOWEST);
+    }
+}
+
+LowIoPriorityGuard::~LowIoPriorityGuard()
+{
+    if (_oldPriority >= 0) {
+        setIoPriority(_oldPriority);
+    }
+}
+
+}
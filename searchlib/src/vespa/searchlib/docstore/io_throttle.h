@@ -0,0 +1,58 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include "io_throttle_stats.h"
+#include <mutex>
+
+namespace search::docstore {
+
+/**
+ * Limits the rate of background reads (compaction) to a number of bytes
+ * per second. The rate is lowered while the observed read latency is above
+ * a target and raised back towards the limit when it drops, so background
+ * work backs off when the disk is busy serving other reads.
+ * A rate limit of 0 disables throttling.
+ */
+class IoThrottle
+{
+public:
+    IoThrottle();
+    ~IoThrottle();
+    void setRateLimit(uint64_t bytesPerSecond, vespalib::duration latencyTarget);
+    /**
+     * Block the calling thread until the given number of bytes can be read
+     * without exceeding the current rate.
+     */
+    void acquire(size_t bytes);
+    void reportReadLatency(vespalib::duration latency);
+    IoThrottleStats getStats() const;
+private:
+    using Guard = std::lock_guard<std::mutex>;
+    mutable std::mutex    _lock;
+    uint64_t              _rateLimit;
+    double                _currentRate;
+    vespalib::duration    _latencyTarget;
+    vespalib::steady_time _nextFree;
+    uint64_t              _bytes;
+    vespalib::duration    _throttledTime;
+    double                _readLatency; // smoothed, in seconds
+    uint32_t              _waiters;
+};
+
+/**
+ * Gives the calling thread the lowest best effort I/O priority while in
+ * scope, where the kernel supports it.
+ */
+class LowIoPriorityGuard
+{
+public:
+    LowIoPriorityGuard();
+    ~LowIoPriorityGuard();
+    LowIoPriorityGuard(const LowIoPriorityGuard &) = delete;
+    LowIoPriorityGuard & operator = (const LowIoPriorityGuard &) = delete;
+private:
+    int _oldPriority;
+};
+
+}
@@ -0,0 +1,43 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <vespa/vespalib/util/time.h>
+#include <cstdint>
+
+namespace search {
+
+/*
+ * Class representing the state of the I/O throttling of background
+ * work (compaction) in a data store.
+ */
+class IoThrottleStats
+{
+    uint64_t           _rateLimit;
+    uint64_t           _currentRate;
+    uint64_t           _bytes;
+    vespalib::duration _throttledTime;
+    vespalib::duration _readLatency;
+    bool               _throttling;
+public:
+    IoThrottleStats()
+        : IoThrottleStats(0, 0, 0, vespalib::duration::zero(), vespalib::duration::zero(), false)
+    { }
+    IoThrottleStats(uint64_t rateLimit_in, uint64_t currentRate_in, uint64_t bytes_in,
+                    vespalib::duration throttledTime_in, vespalib::duration readLatency_in, bool throttling_in)
+        : _rateLimit(rateLimit_in),
+          _currentRate(currentRate_in),
+          _bytes(bytes_in),
+          _throttledTime(throttledTime_in),
+          _readLatency(readLatency_in),
+          _throttling(throttling_in)
+    { }
+    uint64_t rateLimit() const                { return _rateLimit; }
+    uint64_t currentRate() const              { return _currentRate; }
+    uint64_t bytes() const                    { return _bytes; }
+    vespalib::duration throttledTime() const  { return _throttledTime; }
+    vespalib::duration readLatency() const    { return _readLatency; }
+    bool throttling() const                   { return _throttling; }
+};
+
+} // namespace search
@@ -19,6 +19,8 @@ namespace search {
 namespace {
     constexpr size_t DEFAULT_MAX_FILESIZE = 1000000000ul;
     constexpr uint32_t DEFAULT_MAX_LIDS_PER_FILE = 32 * 1024 * 1024;
+    // amount of sample data used per byte of trained dictionary
+    constexpr size_t DICTIONARY_SAMPLE_FACTOR = 100;
 }
 
 using vespalib::LockGuard;
@@ -38,8 +40,12 @@ LogDataStore::Config::Config()
     : _maxFileSize(DEFAULT_MAX_FILESIZE),
       _maxDiskBloatFactor(0.2),
       _maxBucketSpread(2.5),
+      _maxBucketSpreadWhenVisited(0.0),
       _minFileSizeFactor(0.2),
       _maxNumLids(DEFAULT_MAX_LIDS_PER_FILE),
+      _compactDictionarySize(0),
+      _compactIoRateLimit(0),
+      _compactIoLatencyTarget(vespalib::duration::zero()),
       _skipCrcOnRead(false),
       _compactCompression(CompressionConfig::LZ4),
       _fileConfig()
@@ -48,9 +54,13 @@ LogDataStore::Config::Config()
 bool
 LogDataStore::Config::operator == (const Config & rhs) const {
     return (_maxBucketSpread == rhs._maxBucketSpread) &&
+            (_maxBucketSpreadWhenVisited == rhs._maxBucketSpreadWhenVisited) &&
             (_maxDiskBloatFactor == rhs._maxDiskBloatFactor) &&
             (_maxFileSize == rhs._maxFileSize) &&
             (_minFileSizeFactor == rhs._minFileSizeFactor) &&
+            (_compactDictionarySize == rhs._compactDictionarySize) &&
+            (_compactIoRateLimit == rhs._compactIoRateLimit) &&
+            (_compactIoLatencyTarget == rhs._compactIoLatencyTarget) &&
             (_skipCrcOnRead == rhs._skipCrcOnRead) &&
             (_compactCompression == rhs._compactCompression) &&
             (_fileConfig == rhs._fileConfig);
@@ -78,8 +88,11 @@ LogDataStore::LogDataStore(vespalib::ThreadExecutor &executor, const vespalib::s
       _tlSyncer(tlSyncer),
       _bucketizer(std::move(bucketizer)),
       _currentlyCompacting(),
+      _compactThrottle(),
+      _visitedLids(0),
       _compactLidSpaceGeneration()
 {
+    _compactThrottle.setRateLimit(_config.getCompactIoRateLimit(), _config.getCompactIoLatencyTarget());
     // Reserve space for 1TB summary in order to avoid locking.
     _fileChunks.reserve(LidInfo::getFileIdLimit());
     _holdFileChunks.resize(LidInfo::getFileIdLimit());
@@ -91,6 +104,7 @@ LogDataStore::LogDataStore(vespalib::ThreadExecutor &executor, const vespalib::s
 
 void LogDataStore::reconfigure(const Config & config) {
     _config = config;
+    _compactThrottle.setRateLimit(_config.getCompactIoRateLimit(), _config.getCompactIoLatencyTarget());
 }
 
 void
@@ -141,6 +155,7 @@ LogDataStore::read(const LidVector & lids, IBufferVisitor & visitor) const
         }
     }
     if (orderedLids.empty()) { return; }
+    _visitedLids.fetch_add(orderedLids.size(), std::memory_order_relaxed);
 
     std::sort(orderedLids.begin(), orderedLids.end());
     uint32_t prevFile = orderedLids[0].getFileId();
@@ -303,7 +318,8 @@ LogDataStore::compact(uint64_t syncToken)
     const bool doCompact = (_fileChunks.size() > 1);
     if (doCompact) {
         LOG(info, "%s. Will compact", bloatMsg(bloat, usage).c_str());
-        compactWorst(_config.getMaxDiskBloatFactor(), _config.getMaxBucketSpread(), isTotalDiskBloatExceeded(usage, bloat));
+        compactWorst(_config.getMaxDiskBloatFactor(), getBucketSpreadLimit(), isTotalDiskBloatExceeded(usage, bloat));
+        _visitedLids.store(0, std::memory_order_relaxed);
     }
     flushActiveAndWait(syncToken);
     if (doCompact) {
@@ -330,7 +346,7 @@ LogDataStore::getMaxCompactGain() const
 
     const double maxSpread = getMaxBucketSpread();
     size_t spreadAsBloat = diskFootPrint * (1.0 - 1.0/maxSpread);
-    if ( maxSpread < _config.getMaxBucketSpread()) {
+    if ( maxSpread < getBucketSpreadLimit()) {
         spreadAsBloat = 0;
     }
     return (bloat + spreadAsBloat);
@@ -379,6 +395,18 @@ LogDataStore::getMaxBucketSpread() const
     return maxSpread;
 }
 
+double
+LogDataStore::getBucketSpreadLimit() const
+{
+    double limit = _config.getMaxBucketSpread();
+    double visitedLimit = _config.getMaxBucketSpreadWhenVisited();
+    uint64_t visitedLids = _visitedLids.load(std::memory_order_relaxed);
+    if ((visitedLimit > 0.0) && (visitedLids > 0) && (visitedLids >= getDocIdLimit())) {
+        limit = std::min(limit, visitedLimit);
+    }
+    return limit;
+}
+
 std::pair<bool, LogDataStore::FileId>
 LogDataStore::findNextToCompact(double bloatLimit, double spreadLimit, bool prioritizeDiskBloat)
 {
@@ -481,9 +509,11 @@ void LogDataStore::compactFile(FileId fileId)
     FileId destinationFileId = FileId::active();
     if (_bucketizer) {
         if ( ! shouldCompactToActiveFile(fc->getDiskFootprint() - fc->getDiskBloat())) {
+            FileChunk::ZStdDictionary::SP dictionary = trainDictionary(*fc);
             LockGuard guard(_updateLock);
             destinationFileId = allocateFileId(guard);
-            setNewFileChunk(guard, createWritableFile(destinationFileId, fc->getLastPersistedSerialNum(), fc->getNameId().next()));
+            setNewFileChunk(guard, createWritableFile(destinationFileId, fc->getLastPersistedSerialNum(),
+                                                      fc->getNameId().next(), std::move(dictionary)));
         }
         size_t numSignificantBucketBits = computeNumberOfSignificantBucketIdBits(*_bucketizer, fc->getFileId());
         compacter = std::make_unique<BucketCompacter>(numSignificantBucketBits, _config.compactCompression(), *this, _executor,
@@ -492,7 +522,7 @@ void LogDataStore::compactFile(FileId fileId)
         compacter = std::make_unique<docstore::Compacter>(*this);
     }
 
-    fc->appendTo(_executor, *this, *compacter, fc->getNumChunks(), nullptr);
+    fc->appendTo(_executor, *this, *compacter, fc->getNumChunks(), nullptr, &_compactThrottle);
 
     if (destinationFileId.isActive()) {
         flushActiveAndWait(0);
@@ -646,8 +676,36 @@ LogDataStore::createReadOnlyFile(FileId fileId, NameId nameId) {
     return file;
 }
 
+FileChunk::ZStdDictionary::SP
+LogDataStore::trainDictionary(const FileChunk & source) const
+{
+    size_t dictionarySize = _config.getCompactDictionarySize();
+    if ((dictionarySize == 0) || (_config.getFileConfig().getCompression().type != CompressionConfig::ZSTD)) {
+        return FileChunk::ZStdDictionary::SP();
+    }
+    vespalib::BenchmarkTimer timer(0.0);
+    timer.before();
+    std::vector<vespalib::string> samples = source.sampleDocuments(dictionarySize * DICTIONARY_SAMPLE_FACTOR);
+    std::vector<vespalib::ConstBufferRef> refs;
+    refs.reserve(samples.size());
+    for (const vespalib::string & sample : samples) {
+        refs.emplace_back(sample.data(), sample.size());
+    }
+    FileChunk::ZStdDictionary::SP dictionary = FileChunk::ZStdDictionary::train(refs, dictionarySize);
+    timer.after();
+    if (dictionary) {
+        LOG(info, "Trained zstd dictionary of %zu bytes from %zu documents in file '%s' in %1.3f seconds",
+            dictionary->content().size(), samples.size(), source.getName().c_str(), timer.min_time());
+    } else {
+        LOG(warning, "Failed training zstd dictionary from %zu documents in file '%s'. Compacting without dictionary",
+            samples.size(), source.getName().c_str());
+    }
+    return dictionary;
+}
+
 FileChunk::UP
-LogDataStore::createWritableFile(FileId fileId, SerialNum serialNum, NameId nameId)
+LogDataStore::createWritableFile(FileId fileId, SerialNum serialNum, NameId nameId,
+                                 FileChunk::ZStdDictionary::SP dictionary)
 {
     for (const auto & fc : _fileChunks) {
         if (fc && (fc->getNameId() == nameId)) {
@@ -660,7 +718,7 @@ LogDataStore::createWritableFile(FileId fileId, SerialNum serialNum, NameId name
     FileChunk::UP file(new WriteableFileChunk(_executor, fileId, nameId, getBaseDir(),
                                               serialNum, docIdLimit,
                                               _config.getFileConfig(), _tune, _fileHeaderContext,
-                                              _bucketizer.get(), _config.crcOnReadDisabled()));
+                                              _bucketizer.get(), _config.crcOnReadDisabled(), std::move(dictionary)));
     file->enableRead();
     return file;
 }
@@ -1097,7 +1155,7 @@ LogDataStore::accept(IDataStoreVisitor &visitor,
     WrapVisitorProgress wrapProgress(visitorProgress, totalChunks);
     for (FileId fcId : fileChunks) {
         FileChunk & fc = *_fileChunks[fcId.getId()];
-        fc.appendTo(_executor, *this, wrap, fc.getNumChunks(), &wrapProgress);
+        fc.appendTo(_executor, *this, wrap, fc.getNumChunks(), &wrapProgress, nullptr);
         if (prune) {
             internalFlushAll();
             FileChunk::UP toDie;
@@ -1108,7 +1166,7 @@ LogDataStore::accept(IDataStoreVisitor &visitor,
             toDie->erase();
         }
     }
-    lfc.appendTo(_executor, *this, wrap, lastChunks, &wrapProgress);
+    lfc.appendTo(_executor, *this, wrap, lastChunks, &wrapProgress, nullptr);
     if (prune) {
         internalFlushAll();
     }
@@ -1168,6 +1226,12 @@ LogDataStore::getStorageStats() const
                                  lastSerialNum, lastFlushedSerialNum, docIdLimit);
 }
 
+IoThrottleStats
+LogDataStore::getCompactionThrottleStats() const
+{
+    return _compactThrottle.getStats();
+}
+
 vespalib::MemoryUsage
 LogDataStore::getMemoryUsage() const
 {
@@ -3,6 +3,7 @@
 #pragma once
 
 #include "idatastore.h"
+#include "io_throttle.h"
 #include "lid_info.h"
 #include "writeablefilechunk.h"
 #include <vespa/vespalib/util/compressionconfig.h>
@@ -12,6 +13,7 @@
 #include <vespa/vespalib/util/rcuvector.h>
 #include <vespa/vespalib/util/threadexecutor.h>
 
+#include <atomic>
 #include <set>
 
 namespace search {
@@ -44,15 +46,36 @@ public:
         Config & setMaxDiskBloatFactor(double v) { _maxDiskBloatFactor = v; return *this; }
         Config & setMaxBucketSpread(double v) { _maxBucketSpread = v; return *this; }
         Config & setMinFileSizeFactor(double v) { _minFileSizeFactor = v; return *this; }
+        /**
+         * Max bucket spread used instead of the normal one while the store is heavily
+         * visited, i.e. when at least docIdLimit lids have been visited since the last
+         * compaction. Keeps the files bucket ordered for visitors. 0 disables it.
+         */
+        Config & setMaxBucketSpreadWhenVisited(double v) { _maxBucketSpreadWhenVisited = v; return *this; }
 
         Config & compactCompression(CompressionConfig v) { _compactCompression = v; return *this; }
         Config & setFileConfig(WriteableFileChunk::Config v) { _fileConfig = v; return *this; }
+        /**
+         * Size of the zstd dictionary trained from samples of each compacted file.
+         * Only used when compacting to a new file with zstd compression. 0 disables it.
+         */
+        Config & setCompactDictionarySize(size_t v) { _compactDictionarySize = v; return *this; }
+        /**
+         * Max rate in bytes per second for reading files being compacted. 0 means unlimited.
+         * The rate is lowered while the compaction reads are slower than the latency target.
+         */
+        Config & setCompactIoRateLimit(uint64_t v) { _compactIoRateLimit = v; return *this; }
+        Config & setCompactIoLatencyTarget(vespalib::duration v) { _compactIoLatencyTarget = v; return *this; }
 
         size_t getMaxFileSize() const { return _maxFileSize; }
         double getMaxDiskBloatFactor() const { return _maxDiskBloatFactor; }
         double getMaxBucketSpread() const { return _maxBucketSpread; }
+        double getMaxBucketSpreadWhenVisited() const { return _maxBucketSpreadWhenVisited; }
         double getMinFileSizeFactor() const { return _minFileSizeFactor; }
         uint32_t getMaxNumLids() const { return _maxNumLids; }
+        size_t getCompactDictionarySize() const { return _compactDictionarySize; }
+        uint64_t getCompactIoRateLimit() const { return _compactIoRateLimit; }
+        vespalib::duration getCompactIoLatencyTarget() const { return _compactIoLatencyTarget; }
 
         bool crcOnReadDisabled() const { return _skipCrcOnRead; }
         const CompressionConfig & compactCompression() const { return _compactCompression; }
@@ -65,8 +88,12 @@ public:
         size_t                      _maxFileSize;
         double                      _maxDiskBloatFactor;
         double                      _maxBucketSpread;
+        double                      _maxBucketSpreadWhenVisited;
         double                      _minFileSizeFactor;
         uint32_t                    _maxNumLids;
+        size_t                      _compactDictionarySize;
+        uint64_t                    _compactIoRateLimit;
+        vespalib::duration          _compactIoLatencyTarget;
         bool                        _skipCrcOnRead;
         CompressionConfig           _compactCompression;
         WriteableFileChunk::Config  _fileConfig;
@@ -167,6 +194,7 @@ public:
     }
 
     DataStoreStorageStats getStorageStats() const override;
+    IoThrottleStats getCompactionThrottleStats() const override;
     vespalib::MemoryUsage getMemoryUsage() const override;
     std::vector<DataStoreFileChunkStats> getFileChunkStats() const override;
 
@@ -235,10 +263,14 @@ private:
     }
 
     double getMaxBucketSpread() const;
+    // The bucket spread limit for compaction, given the current visit load
+    double getBucketSpreadLimit() const;
 
     FileChunk::UP createReadOnlyFile(FileId fileId, NameId nameId);
     FileChunk::UP createWritableFile(FileId fileId, SerialNum serialNum);
-    FileChunk::UP createWritableFile(FileId fileId, SerialNum serialNum, NameId nameId);
+    FileChunk::UP createWritableFile(FileId fileId, SerialNum serialNum, NameId nameId,
+                                     FileChunk::ZStdDictionary::SP dictionary = FileChunk::ZStdDictionary::SP());
+    FileChunk::ZStdDictionary::SP trainDictionary(const FileChunk & source) const;
     vespalib::string createFileName(NameId id) const;
     vespalib::string createDatFileName(NameId id) const;
     vespalib::string createIdxFileName(NameId id) const;
@@ -289,6 +321,9 @@ private:
     transactionlog::SyncProxy               &_tlSyncer;
     IBucketizer::SP                          _bucketizer;
     NameIdSet                                _currentlyCompacting;
+    docstore::IoThrottle                     _compactThrottle;
+    // lids read by bucket visitors since last compaction
+    mutable std::atomic<uint64_t>            _visitedLids;
     uint64_t                                 _compactLidSpaceGeneration;
 };
 
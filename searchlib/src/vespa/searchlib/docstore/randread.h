@@ -18,6 +18,11 @@ public:
     typedef std::shared_ptr<FastOS_FileInterface> FSP;
     virtual ~FileRandRead() { }
     virtual FSP read(size_t offset, vespalib::DataBuffer & buffer, size_t sz) = 0;
+    /**
+     * Hint that the given range will be read soon. Must not block.
+     * Default is to ignore the hint.
+     */
+    virtual void prefetch(size_t offset, size_t sz) { (void) offset; (void) sz; }
     virtual int64_t getSize() = 0;
 };
 
@@ -84,6 +84,12 @@ MMapRandRead::read(size_t offset, vespalib::DataBuffer & buffer, size_t sz)
     return FSP();
 }
 
+void
+MMapRandRead::prefetch(size_t offset, size_t sz)
+{
+    _file->willNeed(offset, sz);
+}
+
 int64_t
 MMapRandRead::getSize() {
     return _file->GetSize();
@@ -146,6 +152,14 @@ MMapRandReadDynamic::contains(const FastOS_FileInterface & file, size_t sz) {
 }
 
 
+void
+MMapRandReadDynamic::prefetch(size_t offset, size_t sz)
+{
+    // Ranges beyond the current mapping are left for read() to remap.
+    FSP file(_holder.get());
+    file->willNeed(offset, sz);
+}
+
 int64_t
 MMapRandReadDynamic::getSize() {
     return _holder.get()->GetSize();
@@ -161,6 +175,12 @@ NormalRandRead::read(size_t offset, vespalib::DataBuffer & buffer, size_t sz)
     return FSP();
 }
 
+void
+NormalRandRead::prefetch(size_t offset, size_t sz)
+{
+    _file->willNeed(offset, sz);
+}
+
 int64_t
 NormalRandRead::getSize()
 {
@@ -165,6 +165,11 @@ VisitCache::reconfigure(size_t cacheSize, const CompressionConfig &compression)
     _cache->setCapacityBytes(cacheSize);
 }
 
+void
+VisitCache::admissionFilter(size_t expectedElements) {
+    _cache->admissionFilter(expectedElements);
+}
+
 
 VisitCache::Cache::IdSet
 VisitCache::Cache::findSetsContaining(const LockGuard &, const KeySet & keys) const {
@@ -221,7 +226,8 @@ VisitCache::remove(uint32_t key) {
 
 CacheStats
 VisitCache::getCacheStats() const {
-    return CacheStats(_cache->getHit(), _cache->getMiss(), _cache->size(), _cache->sizeBytes(), _cache->getInvalidate());
+    return CacheStats(_cache->getHit(), _cache->getMiss(), _cache->size(), _cache->sizeBytes(),
+                      _cache->getInvalidate(), _cache->getReject());
 }
 
 VisitCache::Cache::Cache(BackingStore & b, size_t maxBytes) :
@@ -107,6 +107,7 @@ public:
 
     CacheStats getCacheStats() const;
     void reconfigure(size_t cacheSize, const CompressionConfig &compression);
+    void admissionFilter(size_t expectedElements);
 private:
     /**
      * This implments the interface the cache uses when it has a cache miss.
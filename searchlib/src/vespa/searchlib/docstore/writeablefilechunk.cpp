@@ -83,7 +83,8 @@ WriteableFileChunk(vespalib::Executor &executor,
                    const TuneFileSummary &tune,
                    const FileHeaderContext &fileHeaderContext,
                    const IBucketizer * bucketizer,
-                   bool skipCrcOnRead)
+                   bool skipCrcOnRead,
+                   ZStdDictionary::SP dictionary)
     : FileChunk(fileId, nameId, baseName, tune, bucketizer, skipCrcOnRead),
       _config(config),
       _serialNum(initialSerialNum),
@@ -118,6 +119,8 @@ WriteableFileChunk(vespalib::Executor &executor,
     if (_dataFile.OpenReadWrite()) {
         readDataHeader();
         if (_dataHeaderLen == 0) {
+            // A dictionary is only used by new files, existing files keep what their header says.
+            _dictionary = std::move(dictionary);
             writeDataHeader(fileHeaderContext);
         }
         _dataFile.SetPosition(_dataFile.GetSize());
@@ -245,6 +248,11 @@ WriteableFileChunk::read(LidInfoWithLidV::const_iterator begin, size_t count, IB
             visitor.visit(entry._lid, vespalib::ConstBufferRef(entry._buf.get(), entry._size));
             entry._buf = vespalib::alloc::Alloc();
         }
+        size_t numPrefetched(0);
+        for (auto & it : chunksOnFile) {
+            if (numPrefetched++ == PREFETCH_CHUNKS) { break; }
+            prefetch(it.second);
+        }
         for (auto & it : chunksOnFile) {
             auto first = find_first(begin, it.first);
             auto last = seek_past(first, begin + count, it.first);
@@ -290,7 +298,7 @@ WriteableFileChunk::internalFlush(uint32_t chunkId, uint64_t serialNum)
     if (_alignment > 1) {
         tmp->getBuf().ensureFree(active->getMaxPackSize(_config.getCompression()) + _alignment - 1);
     }
-    active->pack(serialNum, tmp->getBuf(), _config.getCompression());
+    active->pack(serialNum, tmp->getBuf(), _config.getCompression(), _dictionary.get());
     tmp->setPayLoad();
     if (_alignment > 1) {
         const size_t padAfter((_alignment - tmp->getPayLoad() % _alignment) % _alignment);
@@ -499,6 +507,42 @@ WriteableFileChunk::updateChunkInfo(const ProcessedChunkQ & chunks, const ChunkM
     guard.broadcast();
 }
 
+void
+WriteableFileChunk::waitForGroupCommit(ProcessedChunkQ & chunks, uint32_t & nextChunkId)
+{
+    size_t bytes(0);
+    for (const auto & chunk : chunks) {
+        if (chunk) {
+            bytes += chunk->getBuf().getDataLen();
+        }
+    }
+    const vespalib::steady_time deadline = vespalib::steady_clock::now() + _config.getGroupCommitDelay();
+    MonitorGuard guard(_writeMonitor);
+    // A null chunk terminates the file, it must be written at once.
+    while ((bytes < _config.getGroupCommitBytes()) && chunks.back()) {
+        ProcessedChunkQ newChunks(drainQ(guard));
+        if (newChunks.empty()) {
+            vespalib::steady_time now = vespalib::steady_clock::now();
+            if (now >= deadline) {
+                break;
+            }
+            guard.wait(deadline - now);
+            continue;
+        }
+        guard.unlock();
+        insertChunks(_orderedChunks, newChunks, nextChunkId);
+        ProcessedChunkQ more(fetchNextChain(_orderedChunks, nextChunkId));
+        nextChunkId += more.size();
+        for (auto & chunk : more) {
+            if (chunk) {
+                bytes += chunk->getBuf().getDataLen();
+            }
+            chunks.push_back(std::move(chunk));
+        }
+        guard = MonitorGuard(_writeMonitor);
+    }
+}
+
 void
 WriteableFileChunk::fileWriter(const uint32_t firstChunkId)
 {
@@ -512,7 +556,10 @@ WriteableFileChunk::fileWriter(const uint32_t firstChunkId)
             insertChunks(_orderedChunks, newChunks, nextChunkId);
             ProcessedChunkQ chunks(fetchNextChain(_orderedChunks, nextChunkId));
             nextChunkId += chunks.size();
-            
+            if ((_config.getGroupCommitBytes() > 0) && !chunks.empty()) {
+                waitForGroupCommit(chunks, nextChunkId);
+            }
+
             size_t sz(0);
             ChunkMetaV cmetaV(computeChunkMeta(chunks, getAlignedStartPos(_dataFile), sz, done));
             writeData(chunks, sz);
@@ -724,6 +771,7 @@ WriteableFileChunk::readDataHeader()
         FileHeader h;
         _dataHeaderLen = h.readFile(_dataFile);
         _dataFile.SetPosition(_dataHeaderLen);
+        _dictionary = readDictionary(h);
     } catch (IllegalHeaderException &e) {
         _dataFile.SetPosition(0);
         try {
@@ -790,6 +838,9 @@ WriteableFileChunk::writeDataHeader(const FileHeaderContext &fileHeaderContext)
     assert(_dataFile.GetPosition() == 0);
     fileHeaderContext.addTags(h, _dataFile.GetFileName());
     h.putTag(Tag("desc", "Log data store chunk data"));
+    if (_dictionary) {
+        writeDictionary(h, *_dictionary);
+    }
     _dataHeaderLen = h.writeFile(_dataFile);
 }
 
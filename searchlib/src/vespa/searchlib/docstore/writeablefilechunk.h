@@ -27,17 +27,36 @@ public:
 
         Config(const CompressionConfig &compression, size_t maxChunkBytes)
             : _compression(compression),
-              _maxChunkBytes(maxChunkBytes)
+              _maxChunkBytes(maxChunkBytes),
+              _groupCommitBytes(0),
+              _groupCommitDelay(vespalib::duration::zero())
         { }
 
+        /**
+         * Let the file writer wait up to maxDelay for more chunks until it has
+         * at least minBytes to write, combining them into one larger write.
+         * Queued chunks are served from memory, so this only delays when they
+         * reach disk. 0 bytes disables it.
+         */
+        Config & setGroupCommit(size_t minBytes, vespalib::duration maxDelay) {
+            _groupCommitBytes = minBytes;
+            _groupCommitDelay = maxDelay;
+            return *this;
+        }
+
         const CompressionConfig & getCompression() const { return _compression; }
         size_t getMaxChunkBytes() const { return _maxChunkBytes; }
+        size_t getGroupCommitBytes() const { return _groupCommitBytes; }
+        vespalib::duration getGroupCommitDelay() const { return _groupCommitDelay; }
         bool operator == (const Config & rhs) const {
-            return (_compression == rhs._compression) && (_maxChunkBytes == rhs._maxChunkBytes);
+            return (_compression == rhs._compression) && (_maxChunkBytes == rhs._maxChunkBytes) &&
+                   (_groupCommitBytes == rhs._groupCommitBytes) && (_groupCommitDelay == rhs._groupCommitDelay);
         }
     private:
-        CompressionConfig _compression;
-        size_t _maxChunkBytes;
+        CompressionConfig  _compression;
+        size_t             _maxChunkBytes;
+        size_t             _groupCommitBytes;
+        vespalib::duration _groupCommitDelay;
     };
 
 public:
@@ -46,7 +65,8 @@ public:
                        const vespalib::string & baseName, uint64_t initialSerialNum,
                        uint32_t docIdLimit, const Config & config,
                        const TuneFileSummary &tune, const common::FileHeaderContext &fileHeaderContext,
-                       const IBucketizer * bucketizer, bool crcOnReadDisabled);
+                       const IBucketizer * bucketizer, bool crcOnReadDisabled,
+                       ZStdDictionary::SP dictionary = ZStdDictionary::SP());
     ~WriteableFileChunk() override;
 
     ssize_t read(uint32_t lid, SubChunkId chunk, vespalib::DataBuffer & buffer) const override;
@@ -79,6 +99,7 @@ private:
     void waitForChunkFlushedToDisk(uint32_t chunkId) const;
     void waitForAllChunksFlushedToDisk() const;
     void fileWriter(const uint32_t firstChunkId);
+    void waitForGroupCommit(ProcessedChunkQ & chunks, uint32_t & nextChunkId);
     void internalFlush(uint32_t, uint64_t serialNum);
     void enque(ProcessedChunkUP);
     int32_t flushLastIfNonEmpty(bool force);
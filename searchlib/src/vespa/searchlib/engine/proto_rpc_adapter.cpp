@@ -27,6 +27,7 @@ using ProtoMonitorRequest = ProtoConverter::ProtoMonitorRequest;
 using ProtoMonitorReply = ProtoConverter::ProtoMonitorReply;
 using QueryStats = SearchProtocolMetrics::QueryStats;
 using DocsumStats = SearchProtocolMetrics::DocsumStats;
+using google::protobuf::Arena;
 
 namespace {
 
@@ -36,32 +37,37 @@ CompressionConfig get_compression_config() {
     return CompressionConfig(streamer.getCompressionType(), streamer.getCompressionLevel(), 80, streamer.getCompressionLimit());
 }
 
+// serialize straight into the rpc data value, avoiding an intermediate copy
+template <typename MSG>
+void encode_raw_message(const MSG &src, size_t size, FRT_Values &dst) {
+    dst.AddInt8(CompressionConfig::Type::NONE);
+    dst.AddInt32(size);
+    auto *buf = reinterpret_cast<uint8_t *>(dst.AddData(size));
+    src.SerializeWithCachedSizesToArray(buf);
+}
+
 template <typename MSG>
 void encode_message(const MSG &src, FRT_Values &dst) {
     using vespalib::compression::compress;
+    CompressionConfig config = get_compression_config();
+    size_t size = src.ByteSizeLong();
+    if ((config.type == CompressionConfig::Type::NONE) || (size < config.minSize)) {
+        return encode_raw_message(src, size, dst);
+    }
     auto output = src.SerializeAsString();
     ConstBufferRef buf(output.data(), output.size());
     DataBuffer compressed(output.data(), output.size());
-    CompressionConfig::Type type = compress(get_compression_config(), buf, compressed, true);
+    CompressionConfig::Type type = compress(config, buf, compressed, true);
     dst.AddInt8(type);
     dst.AddInt32(buf.size());
     dst.AddData(compressed.getData(), compressed.getDataLen());
 }
 
 void encode_search_reply(const ProtoSearchReply &src, FRT_Values &dst) {
-    using vespalib::compression::compress;
-    auto output = src.SerializeAsString();
     if (src.grouping_blob().empty()) {
-        dst.AddInt8(CompressionConfig::Type::NONE);
-        dst.AddInt32(output.size());
-        dst.AddData(output.data(), output.size());
+        encode_raw_message(src, src.ByteSizeLong(), dst);
     } else {
-        ConstBufferRef buf(output.data(), output.size());
-        DataBuffer compressed(output.data(), output.size());
-        CompressionConfig::Type type = compress(get_compression_config(), buf, compressed, true);
-        dst.AddInt8(type);
-        dst.AddInt32(buf.size());
-        dst.AddData(compressed.getData(), compressed.getDataLen());
+        encode_message(src, dst);
     }
 }
 
@@ -70,6 +76,9 @@ bool decode_message(const FRT_Values &src, MSG &dst) {
     using vespalib::compression::decompress;
     uint8_t encoding = src[0]._intval8;
     uint32_t uncompressed_size = src[1]._intval32;
+    if (CompressionConfig::toType(encoding) == CompressionConfig::Type::NONE) {
+        return dst.ParseFromArray(src[2]._data._buf, src[2]._data._len);
+    }
     DataBuffer uncompressed(src[2]._data._buf, src[2]._data._len);
     ConstBufferRef blob(src[2]._data._buf, src[2]._data._len);
     decompress(CompressionConfig::toType(encoding), uncompressed_size, blob, uncompressed, true);
@@ -86,7 +95,8 @@ struct SearchRequestDecoder : SearchRequest::Source::Decoder {
     SearchRequestDecoder(FRT_RPCRequest &rpc_in, QueryStats &stats_in)
         : rpc(rpc_in), stats(stats_in), relative_time(std::make_unique<SteadyClock>()) {}
     std::unique_ptr<SearchRequest> decode() override {
-        ProtoSearchRequest msg;
+        Arena arena;
+        auto &msg = *Arena::CreateMessage<ProtoSearchRequest>(&arena);
         stats.request_size = (*rpc.GetParams())[2]._data._len;
         if (!decode_message(*rpc.GetParams(), msg)) {
             LOG(warning, "got bad protobuf search request over rpc (unable to decode)");
@@ -110,7 +120,8 @@ struct SearchCompletionHandler : SearchClient {
     SearchCompletionHandler(FRT_RPCRequest &req_in, SearchProtocolMetrics &metrics_in)
         : req(req_in), metrics(metrics_in), stats() {}
     void searchDone(SearchReply::UP reply) override {
-        ProtoSearchReply msg;
+        Arena arena;
+        auto &msg = *Arena::CreateMessage<ProtoSearchReply>(&arena);
         ProtoConverter::search_reply_to_proto(*reply, msg);
         encode_search_reply(msg, *req.GetReturn());
         stats.reply_size = (*req.GetReturn())[2]._data._len;
@@ -131,7 +142,8 @@ struct DocsumRequestDecoder : DocsumRequest::Source::Decoder {
     DocsumRequestDecoder(FRT_RPCRequest &rpc_in, DocsumStats &stats_in)
         : rpc(rpc_in), stats(stats_in), relative_time(std::make_unique<SteadyClock>()) {}
     std::unique_ptr<DocsumRequest> decode() override {
-        ProtoDocsumRequest msg;
+        Arena arena;
+        auto &msg = *Arena::CreateMessage<ProtoDocsumRequest>(&arena);
         stats.request_size = (*rpc.GetParams())[2]._data._len;
         if (!decode_message(*rpc.GetParams(), msg)) {
             LOG(warning, "got bad protobuf docsum request over rpc (unable to decode)");
@@ -156,7 +168,8 @@ struct GetDocsumsCompletionHandler : DocsumClient {
     GetDocsumsCompletionHandler(FRT_RPCRequest &req_in, SearchProtocolMetrics &metrics_in)
         : req(req_in), metrics(metrics_in), stats() {}
     void getDocsumsDone(DocsumReply::UP reply) override {
-        ProtoDocsumReply msg;
+        Arena arena;
+        auto &msg = *Arena::CreateMessage<ProtoDocsumReply>(&arena);
         ProtoConverter::docsum_reply_to_proto(*reply, msg);
         encode_message(msg, *req.GetReturn());
         stats.reply_size = (*req.GetReturn())[2]._data._len;
@@ -121,6 +121,10 @@ public:
         o[3].as_number = 1;  // count
     }
     void execute(uint32_t docId) override;
+    bool supports_batch() const override { return true; }
+    void execute_batch(vespalib::ConstArrayRef<uint32_t> docids,
+                       vespalib::ConstArrayRef<NumberColumn> inputs,
+                       vespalib::ConstArrayRef<feature_t *> outputs) override;
 };
 
 class BoolAttributeExecutor final : public fef::FeatureExecutor {
@@ -133,6 +137,15 @@ public:
     void execute(uint32_t docId) override {
         outputs().set_number(0, _attribute.getFloat(docId));
     }
+    bool supports_batch() const override { return true; }
+    void execute_batch(vespalib::ConstArrayRef<uint32_t> docids,
+                       vespalib::ConstArrayRef<NumberColumn>,
+                       vespalib::ConstArrayRef<feature_t *> outputs_in) override
+    {
+        for (size_t j = 0; j < docids.size(); ++j) {
+            outputs_in[0][j] = _attribute.getFloat(docids[j]);
+        }
+    }
 };
 
 /**
@@ -237,6 +250,26 @@ SingleAttributeExecutor<T>::execute(uint32_t docId)
                      : util::getAsFeature(v);
 }
 
+template <typename T>
+void
+SingleAttributeExecutor<T>::execute_batch(vespalib::ConstArrayRef<uint32_t> docids,
+                                          vespalib::ConstArrayRef<NumberColumn>,
+                                          vespalib::ConstArrayRef<feature_t *> outputs_in)
+{
+    feature_t *value = outputs_in[0];
+    for (size_t j = 0; j < docids.size(); ++j) {
+        typename T::LoadedValueType v = _attribute.getFast(docids[j]);
+        value[j] = __builtin_expect(attribute::isUndefined(v), false)
+                   ? attribute::getUndefined<feature_t>()
+                   : util::getAsFeature(v);
+    }
+    for (size_t j = 0; j < docids.size(); ++j) {
+        outputs_in[1][j] = 0;  // weight
+        outputs_in[2][j] = 0;  // contains
+        outputs_in[3][j] = 1;  // count
+    }
+}
+
 template <typename T>
 void
 MultiAttributeExecutor<T>::execute(uint32_t docId)
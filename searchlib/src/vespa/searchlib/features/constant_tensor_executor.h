@@ -40,4 +40,23 @@ public:
     }
 };
 
+/**
+ * Feature executor that returns a constant tensor owned by someone
+ * else, like a query tensor shared between match threads.
+ */
+class ConstantTensorRefExecutor : public fef::FeatureExecutor
+{
+private:
+    const vespalib::eval::Value &_tensor;
+
+public:
+    ConstantTensorRefExecutor(const vespalib::eval::Value &tensor)
+        : _tensor(tensor)
+    {}
+    bool isPure() override { return true; }
+    void execute(uint32_t) override {
+        outputs().set_object(0, _tensor);
+    }
+};
+
 }
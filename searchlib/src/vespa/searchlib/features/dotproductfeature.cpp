@@ -11,6 +11,8 @@
 #include <vespa/searchlib/attribute/multinumericattribute.h>
 #include <vespa/searchlib/attribute/multienumattribute.h>
 #include <vespa/eval/tensor/serialization/typed_binary_format.h>
+#include <vespa/eval/tensor/tensor.h>
+#include <vespa/eval/tensor/tensor_visitor.h>
 #include <vespa/vespalib/objects/nbostream.h>
 #include <vespa/vespalib/util/stash.h>
 
@@ -937,6 +939,58 @@ DotProductBlueprint::upgradeIfNecessary(const IAttributeVector * attribute, cons
 
 namespace {
 
+/**
+ * Feeds the cells of a sparse query tensor into a weighted set query vector.
+ **/
+template <typename Vector>
+struct WeightedSetTensorInserter : vespalib::tensor::TensorVisitor {
+    Vector &vector;
+    WeightedSetTensorInserter(Vector &vector_in) : vector(vector_in) {}
+    void visit(const vespalib::tensor::TensorAddress &address, double value) override {
+        vector.insert(address.elements()[0].label(), value);
+    }
+};
+
+/**
+ * The query vector for a weighted set attribute is either a weighted
+ * set string or a sparse tensor with a single dimension; the tensor
+ * is used when it is present.
+ **/
+class WeightedSetQuerySource {
+private:
+    const Property &_prop;
+    std::unique_ptr<vespalib::tensor::Tensor> _tensor;
+public:
+    WeightedSetQuerySource(const Property &prop, const Property &tensorBlob)
+        : _prop(prop),
+          _tensor()
+    {
+        if (tensorBlob.found() && !tensorBlob.get().empty()) {
+            const Property::Value &blob = tensorBlob.get();
+            vespalib::nbostream stream(blob.data(), blob.size());
+            _tensor = vespalib::tensor::TypedBinaryFormat::deserialize(stream);
+            const auto &type = _tensor->type();
+            if (!type.is_sparse() || (type.dimensions().size() != 1)) {
+                LOG(warning, "Weighted set query vector must be a sparse tensor with one dimension, not '%s'",
+                    type.to_spec().c_str());
+                _tensor.reset();
+            }
+        }
+    }
+    bool found() const {
+        return (_tensor || (_prop.found() && !_prop.get().empty()));
+    }
+    template <typename Vector>
+    void fill(Vector &vector) const {
+        if (_tensor) {
+            WeightedSetTensorInserter<Vector> inserter(vector);
+            _tensor->accept(inserter);
+        } else {
+            WeightedSetParser::parse(_prop.get(), vector);
+        }
+    }
+};
+
 fef::Anything::UP
 createQueryVector(const IQueryEnvironment & env, const IAttributeVector * attribute,
                   const vespalib::string & baseName, const vespalib::string & queryVector)
@@ -960,32 +1014,34 @@ createQueryVector(const IQueryEnvironment & env, const IAttributeVector * attrib
         }
     } else if (attribute->getCollectionType() == attribute::CollectionType::WSET) {
         Property prop = env.getProperties().lookup(baseName, queryVector);
-        if (prop.found() && !prop.get().empty()) {
+        Property tensorBlob = env.getProperties().lookup(baseName, queryVector, "tensor");
+        WeightedSetQuerySource source(prop, tensorBlob);
+        if (source.found()) {
             if (attribute->isStringType() && attribute->hasEnum()) {
                 auto vector = std::make_unique<dotproduct::wset::EnumVector>(attribute);
-                WeightedSetParser::parse(prop.get(), *vector);
+                source.fill(*vector);
                 vector->syncMap();
                 arguments = std::move(vector);
             } else if (attribute->isIntegerType()) {
                 if (attribute->hasEnum()) {
                     auto vector = std::make_unique<dotproduct::wset::EnumVector>(attribute);
-                    WeightedSetParser::parse(prop.get(), *vector);
+                    source.fill(*vector);
                     vector->syncMap();
                     arguments = std::move(vector);
                 } else {
                     if (attribute->getBasicType() == BasicType::INT32) {
                         auto vector = std::make_unique<dotproduct::wset::IntegerVectorT<int32_t>>();
-                        WeightedSetParser::parse(prop.get(), *vector);
+                        source.fill(*vector);
                         vector->syncMap();
                         arguments = std::move(vector);
                     } else if (attribute->getBasicType() == BasicType::INT64) {
                         auto vector = std::make_unique<dotproduct::wset::IntegerVectorT<int64_t>>();
-                        WeightedSetParser::parse(prop.get(), *vector);
+                        source.fill(*vector);
                         vector->syncMap();
                         arguments = std::move(vector);
                     } else if (attribute->getBasicType() == BasicType::INT8) {
                         auto vector = std::make_unique<dotproduct::wset::IntegerVectorT<int8_t>>();
-                        WeightedSetParser::parse(prop.get(), *vector);
+                        source.fill(*vector);
                         vector->syncMap();
                         arguments = std::move(vector);
                     }
@@ -1093,6 +1149,12 @@ DotProductBlueprint::createExecutor(const IQueryEnvironment & env, vespalib::Sta
         if (prop.found() && !prop.get().empty()) {
             return createFromString(attribute, prop, stash);
         }
+        fef::Anything::UP arguments = createQueryVector(env, attribute, getBaseName(), _queryVector);
+        if (arguments) {
+            // query vector only given as tensor; the executor refers to it
+            const fef::Anything &owned = *stash.create<fef::Anything::UP>(std::move(arguments));
+            return createFromObject(attribute, owned, stash);
+        }
     }
     return stash.create<SingleZeroValueExecutor>();
 }
@@ -71,7 +71,10 @@ template<typename T>
 class IntegerVectorT : public VectorBase<T, T, feature_t> {
 public:
     void insert(vespalib::stringref label, vespalib::stringref value) {
-        this->_vector.emplace_back(util::strToNum<T>(label), util::strToNum<feature_t>(value));
+        insert(label, util::strToNum<feature_t>(value));
+    }
+    void insert(vespalib::stringref label, feature_t value) {
+        this->_vector.emplace_back(util::strToNum<T>(label), value);
     }
 };
 
@@ -91,7 +94,10 @@ public:
     StringVector & operator = (StringVector &&) = default;
     ~StringVector();
     void insert(vespalib::stringref label, vespalib::stringref value) {
-        _vector.emplace_back(label, util::strToNum<feature_t>(value));
+        insert(label, util::strToNum<feature_t>(value));
+    }
+    void insert(vespalib::stringref label, feature_t value) {
+        _vector.emplace_back(label, value);
     }
 };
 
@@ -104,9 +110,12 @@ private:
 public:
     EnumVector(const attribute::IAttributeVector * attribute) : _attribute(attribute) {}
     void insert(vespalib::stringref label, vespalib::stringref value) {
+        insert(label, util::strToNum<feature_t>(value));
+    }
+    void insert(vespalib::stringref label, feature_t value) {
         attribute::EnumHandle e;
         if (_attribute->findEnum(label.data(), e)) {
-            _vector.emplace_back(e, util::strToNum<feature_t>(value));
+            _vector.emplace_back(e, value);
         }
     }
 };
@@ -46,26 +46,80 @@ vespalib::string normalize_name(const vespalib::string &name, const char *contex
 }
 
 /**
- * Feature executor that evaluates an onnx model
+ * Feature executor that evaluates an onnx model. If the model has a
+ * batch dimension, the model may be evaluated for multiple
+ * documents at once by prefetching them.
  */
 class OnnxFeatureExecutor : public FeatureExecutor
 {
 private:
-    Onnx::EvalContext _eval_context;
+    const Onnx                              &_model;
+    const Onnx::WireInfo                    &_wire_info;
+    Onnx::EvalContext                        _eval_context;
+    std::unique_ptr<Onnx::BatchEvalContext>  _batch_context;
+    std::vector<uint32_t>                    _batch_docids;
+    size_t                                   _batch_pos;
+    vespalib::ConstArrayRef<fef::LazyValue>  _input_values;
+
+    void bind_single_outputs() {
+        for (size_t i = 0; i < _eval_context.num_results(); ++i) {
+            outputs().set_object(i, _eval_context.get_result(i));
+        }
+    }
+    bool bind_batch_outputs(uint32_t docid) {
+        while ((_batch_pos < _batch_docids.size()) && (_batch_docids[_batch_pos] < docid)) {
+            ++_batch_pos;
+        }
+        if ((_batch_pos == _batch_docids.size()) || (_batch_docids[_batch_pos] != docid)) {
+            return false;
+        }
+        for (size_t i = 0; i < _batch_context->num_results(); ++i) {
+            outputs().set_object(i, _batch_context->get_result(_batch_pos, i));
+        }
+        return true;
+    }
 public:
     OnnxFeatureExecutor(const Onnx &model, const Onnx::WireInfo &wire_info)
-        : _eval_context(model, wire_info) {}
+        : _model(model), _wire_info(wire_info), _eval_context(model, wire_info),
+          _batch_context(), _batch_docids(), _batch_pos(0), _input_values() {}
     bool isPure() override { return true; }
+    void handle_bind_inputs(vespalib::ConstArrayRef<fef::LazyValue> inputs) override {
+        _input_values = inputs;
+    }
     void handle_bind_outputs(vespalib::ArrayRef<fef::NumberOrObject>) override {
-        for (size_t i = 0; i < _eval_context.num_results(); ++i) {
-            outputs().set_object(i, _eval_context.get_result(i));
-        }
+        bind_single_outputs();
     }
-    void execute(uint32_t) override {
+    void execute(uint32_t docid) override {
+        if (bind_batch_outputs(docid)) {
+            return;
+        }
         for (size_t i = 0; i < _eval_context.num_params(); ++i) {
             _eval_context.bind_param(i, inputs().get_object(i).get());
         }
         _eval_context.eval();
+        bind_single_outputs();
+    }
+    bool supports_prefetch() const override { return _wire_info.has_batch_dimension; }
+    void start_prefetch(size_t num_docs) override {
+        if ((num_docs > 0) && (!_batch_context || (_batch_context->batch_size() != num_docs))) {
+            _batch_context = std::make_unique<Onnx::BatchEvalContext>(_model, _wire_info, num_docs);
+        }
+        _batch_docids.clear();
+        _batch_pos = 0;
+    }
+    void prefetch(size_t idx, uint32_t docid) override {
+        assert(idx == _batch_docids.size());
+        for (size_t i = 0; i < _batch_context->num_params(); ++i) {
+            _batch_context->bind_param(idx, i, _input_values[i].as_object(docid).get());
+        }
+        _batch_docids.push_back(docid);
+    }
+    void finish_prefetch() override {
+        if (_batch_docids.empty()) {
+            return;
+        }
+        assert(_batch_docids.size() == _batch_context->batch_size());
+        _batch_context->eval();
     }
 };
 
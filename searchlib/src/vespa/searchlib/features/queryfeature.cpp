@@ -8,6 +8,7 @@
 #include <vespa/document/datatype/tensor_data_type.h>
 #include <vespa/searchlib/fef/featureexecutor.h>
 #include <vespa/searchlib/fef/indexproperties.h>
+#include <vespa/searchlib/fef/objectstore.h>
 #include <vespa/searchlib/fef/properties.h>
 #include <vespa/searchlib/fef/feature_type.h>
 #include <vespa/vespalib/objects/nbostream.h>
@@ -60,6 +61,7 @@ QueryBlueprint::QueryBlueprint() :
     Blueprint("query"),
     _key(),
     _key2(),
+    _stateKey(),
     _defaultValue(0),
     _valueType(ValueType::double_type())
 {
@@ -84,6 +86,7 @@ QueryBlueprint::setup(const IIndexEnvironment &env, const ParameterList &params)
     _key = params[0].getValue();
     _key2 = "$";
     _key2.append(_key);
+    _stateKey = getBaseName() + ".tensor." + _key;
 
     vespalib::string key3;
     key3.append("query(");
@@ -112,10 +115,8 @@ QueryBlueprint::setup(const IIndexEnvironment &env, const ParameterList &params)
 
 namespace {
 
-FeatureExecutor &
-createTensorExecutor(const IQueryEnvironment &env,
-                     const vespalib::string &queryKey,
-                     const ValueType &valueType, vespalib::Stash &stash)
+vespalib::eval::Value::UP
+decodeTensor(const IQueryEnvironment &env, const vespalib::string &queryKey, const ValueType &valueType)
 {
     Property prop = env.getProperties().lookup(queryKey);
     if (prop.found() && !prop.get().empty()) {
@@ -125,19 +126,47 @@ createTensorExecutor(const IQueryEnvironment &env,
         if (!TensorDataType::isAssignableType(valueType, tensor->type())) {
             LOG(warning, "Query feature type is '%s' but other tensor type is '%s'",
                 valueType.to_spec().c_str(), tensor->type().to_spec().c_str());
-            return ConstantTensorExecutor::createEmpty(valueType, stash);
+            return {};
         }
-        return ConstantTensorExecutor::create(std::move(tensor), stash);
+        return tensor;
+    }
+    return {};
+}
+
+FeatureExecutor &
+createTensorExecutor(const IQueryEnvironment &env,
+                     const vespalib::string &queryKey,
+                     const ValueType &valueType, vespalib::Stash &stash)
+{
+    auto tensor = decodeTensor(env, queryKey, valueType);
+    if (tensor) {
+        return stash.create<ConstantTensorExecutor>(std::move(tensor));
     }
     return ConstantTensorExecutor::createEmpty(valueType, stash);
 }
 
 }
 
+void
+QueryBlueprint::prepareSharedState(const IQueryEnvironment &env, IObjectStore &store) const
+{
+    if (_valueType.is_tensor() && (env.getObjectStore().get(_stateKey) == nullptr)) {
+        auto tensor = decodeTensor(env, _key, _valueType);
+        if (tensor) {
+            store.add(_stateKey, std::make_unique<AnyWrapper<vespalib::eval::Value::UP>>(std::move(tensor)));
+        }
+    }
+}
+
 FeatureExecutor &
 QueryBlueprint::createExecutor(const IQueryEnvironment &env, vespalib::Stash &stash) const
 {
     if (_valueType.is_tensor()) {
+        const Anything *shared = env.getObjectStore().get(_stateKey);
+        if (shared != nullptr) {
+            // decoded once per query in prepareSharedState; owned by the object store
+            return stash.create<ConstantTensorRefExecutor>(*objectstore::as_value<vespalib::eval::Value::UP>(*shared));
+        }
         return createTensorExecutor(env, _key, _valueType, stash);
     } else {
         std::vector<feature_t> values;
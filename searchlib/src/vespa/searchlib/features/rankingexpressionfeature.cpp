@@ -52,11 +52,15 @@ private:
     const FastForest &_forest;
     FastForest::Context::UP _ctx;
     ArrayRef<float> _params;
+    std::vector<float> _batch_params;
 
 public:
     FastForestExecutor(ArrayRef<float> param_space, const FastForest &forest);
     bool isPure() override { return true; }
     void execute(uint32_t docId) override;
+    bool supports_batch() const override { return true; }
+    void execute_batch(ConstArrayRef<uint32_t> docids, ConstArrayRef<NumberColumn> inputs,
+                       ConstArrayRef<feature_t *> outputs) override;
 };
 
 //-----------------------------------------------------------------------------
@@ -75,6 +79,9 @@ public:
     CompiledRankingExpressionExecutor(const CompiledFunction &compiled_function);
     bool isPure() override { return true; }
     void execute(uint32_t docId) override;
+    bool supports_batch() const override { return true; }
+    void execute_batch(ConstArrayRef<uint32_t> docids, ConstArrayRef<NumberColumn> inputs,
+                       ConstArrayRef<feature_t *> outputs) override;
 };
 
 //-----------------------------------------------------------------------------
@@ -132,7 +139,8 @@ public:
 FastForestExecutor::FastForestExecutor(ArrayRef<float> param_space, const FastForest &forest)
     : _forest(forest),
       _ctx(_forest.create_context()),
-      _params(param_space)
+      _params(param_space),
+      _batch_params()
 {
 }
 
@@ -152,6 +160,22 @@ FastForestExecutor::execute(uint32_t)
     outputs().set_number(0, _forest.eval(*_ctx, &_params[0]));
 }
 
+void
+FastForestExecutor::execute_batch(ConstArrayRef<uint32_t> docids,
+                                  ConstArrayRef<NumberColumn> inputs_in,
+                                  ConstArrayRef<feature_t *> outputs_in)
+{
+    size_t num_params = _params.size();
+    _batch_params.resize(docids.size() * num_params);
+    for (size_t i = 0; i < num_params; ++i) {
+        const NumberColumn &input = inputs_in[i];
+        for (size_t j = 0; j < docids.size(); ++j) {
+            _batch_params[(j * num_params) + i] = input[j];
+        }
+    }
+    _forest.eval_batch(*_ctx, _batch_params.data(), num_params, docids.size(), outputs_in[0]);
+}
+
 //-----------------------------------------------------------------------------
 
 CompiledRankingExpressionExecutor::CompiledRankingExpressionExecutor(const CompiledFunction &compiled_function)
@@ -176,6 +200,20 @@ CompiledRankingExpressionExecutor::execute(uint32_t)
     outputs().set_number(0, _ranking_function(&_params[0]));
 }
 
+void
+CompiledRankingExpressionExecutor::execute_batch(ConstArrayRef<uint32_t> docids,
+                                                 ConstArrayRef<NumberColumn> inputs_in,
+                                                 ConstArrayRef<feature_t *> outputs_in)
+{
+    feature_t *result = outputs_in[0];
+    for (size_t j = 0; j < docids.size(); ++j) {
+        for (size_t i = 0; i < _params.size(); ++i) {
+            _params[i] = inputs_in[i][j];
+        }
+        result[j] = _ranking_function(&_params[0]);
+    }
+}
+
 //-----------------------------------------------------------------------------
 
 namespace {
@@ -0,0 +1,58 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "feature_profiler.h"
+#include <vespa/vespalib/data/slime/slime.h>
+#include <vespa/vespalib/stllike/hash_map.hpp>
+#include <algorithm>
+#include <cassert>
+
+namespace search::fef {
+
+FeatureProfiler::FeatureProfiler(uint32_t sample_interval)
+    : _sample_interval(sample_interval),
+      _stats(),
+      _name_map(),
+      _stack()
+{
+    assert(_sample_interval > 0);
+}
+
+FeatureProfiler::~FeatureProfiler() = default;
+
+uint32_t
+FeatureProfiler::resolve(const vespalib::string &name)
+{
+    auto pos = _name_map.find(name);
+    if (pos != _name_map.end()) {
+        return pos->second;
+    }
+    uint32_t id = _stats.size();
+    _stats.emplace_back(name);
+    _name_map[name] = id;
+    return id;
+}
+
+void
+FeatureProfiler::report(vespalib::slime::Cursor &obj) const
+{
+    std::vector<uint32_t> order;
+    for (uint32_t id = 0; id < _stats.size(); ++id) {
+        if (_stats[id].count > 0) {
+            order.push_back(id);
+        }
+    }
+    std::sort(order.begin(), order.end(),
+              [this](uint32_t a, uint32_t b) { return (_stats[a].self_time > _stats[b].self_time); });
+    obj.setLong("sample_interval", _sample_interval);
+    auto &features = obj.setArray("features");
+    for (uint32_t id: order) {
+        const Stats &stats = _stats[id];
+        auto &entry = features.addObject();
+        entry.setString("name", stats.name);
+        entry.setLong("count", stats.count);
+        entry.setDouble("self_time_ms", vespalib::count_ns(stats.self_time) / 1000000.0);
+        entry.setDouble("total_time_ms", vespalib::count_ns(stats.total_time) / 1000000.0);
+    }
+}
+
+}
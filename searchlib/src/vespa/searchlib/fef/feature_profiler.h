@@ -0,0 +1,93 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <vespa/vespalib/stllike/string.h>
+#include <vespa/vespalib/stllike/hash_map.h>
+#include <vespa/vespalib/util/time.h>
+#include <vector>
+
+namespace vespalib::slime { struct Cursor; }
+
+namespace search::fef {
+
+/**
+ * Collects the time spent executing each feature of one or more rank
+ * programs. Features are identified by name, so that executors for
+ * the same feature in different rank programs (like first and second
+ * phase) are aggregated together. Executions are nested (a feature
+ * calculates its inputs while being executed), and the time spent in
+ * nested executions is tracked separately to be able to report self
+ * time in addition to total time for each feature.
+ *
+ * Only every sample_interval'th document (by docid) is profiled. A
+ * profiler is not thread safe; use one per match thread.
+ **/
+class FeatureProfiler
+{
+private:
+    struct Stats {
+        vespalib::string   name;
+        size_t             count;
+        vespalib::duration total_time;
+        vespalib::duration self_time;
+        Stats(const vespalib::string &name_in)
+            : name(name_in), count(0), total_time(vespalib::duration::zero()), self_time(vespalib::duration::zero()) {}
+    };
+    struct Frame {
+        uint32_t              id;
+        vespalib::steady_time start;
+        vespalib::duration    nested_time;
+        Frame(uint32_t id_in, vespalib::steady_time start_in)
+            : id(id_in), start(start_in), nested_time(vespalib::duration::zero()) {}
+    };
+
+    using NameMap = vespalib::hash_map<vespalib::string, uint32_t>;
+
+    uint32_t           _sample_interval;
+    std::vector<Stats> _stats;
+    NameMap            _name_map;
+    std::vector<Frame> _stack;
+
+public:
+    FeatureProfiler(uint32_t sample_interval);
+    ~FeatureProfiler();
+
+    bool sample(uint32_t docid) const { return ((docid % _sample_interval) == 0); }
+    uint32_t sample_interval() const { return _sample_interval; }
+
+    /**
+     * Obtain the id used to profile the feature with the given name.
+     **/
+    uint32_t resolve(const vespalib::string &name);
+
+    void start(uint32_t id) {
+        _stack.emplace_back(id, vespalib::steady_clock::now());
+    }
+    void complete() {
+        const Frame &frame = _stack.back();
+        vespalib::duration time = vespalib::steady_clock::now() - frame.start;
+        Stats &stats = _stats[frame.id];
+        ++stats.count;
+        stats.total_time += time;
+        stats.self_time += (time - frame.nested_time);
+        _stack.pop_back();
+        if (!_stack.empty()) {
+            _stack.back().nested_time += time;
+        }
+    }
+
+    size_t num_features() const { return _stats.size(); }
+    const vespalib::string &name(uint32_t id) const { return _stats[id].name; }
+    size_t count(uint32_t id) const { return _stats[id].count; }
+    vespalib::duration total_time(uint32_t id) const { return _stats[id].total_time; }
+    vespalib::duration self_time(uint32_t id) const { return _stats[id].self_time; }
+
+    /**
+     * Report all profiled features into the given object, ordered by
+     * decreasing self time.
+     **/
+    void report(vespalib::slime::Cursor &obj) const;
+};
+
+}
@@ -2,6 +2,7 @@
 
 #include "featureexecutor.h"
 #include <vespa/vespalib/util/classname.h>
+#include <cassert>
 
 namespace search::fef {
 
@@ -20,6 +21,41 @@ FeatureExecutor::isPure()
     return false;
 }
 
+bool
+FeatureExecutor::supports_batch() const
+{
+    return false;
+}
+
+void
+FeatureExecutor::execute_batch(vespalib::ConstArrayRef<uint32_t>,
+                               vespalib::ConstArrayRef<NumberColumn>,
+                               vespalib::ConstArrayRef<feature_t *>)
+{
+    assert(!"execute_batch called on executor without batch support");
+}
+
+bool
+FeatureExecutor::supports_prefetch() const
+{
+    return false;
+}
+
+void
+FeatureExecutor::start_prefetch(size_t)
+{
+}
+
+void
+FeatureExecutor::prefetch(size_t, uint32_t)
+{
+}
+
+void
+FeatureExecutor::finish_prefetch()
+{
+}
+
 void
 FeatureExecutor::handle_bind_inputs(vespalib::ConstArrayRef<LazyValue>)
 {
@@ -91,6 +91,20 @@ public:
         vespalib::ArrayRef<NumberOrObject> _outputs;
     };
 
+    /**
+     * Number values of a single feature for a block of documents
+     * being executed as a batch. Constant values are represented
+     * with a stride of 0.
+     **/
+    class NumberColumn {
+        const feature_t *_values;
+        uint32_t         _stride;
+    public:
+        NumberColumn() : _values(nullptr), _stride(0) {}
+        NumberColumn(const feature_t *values, uint32_t stride) : _values(values), _stride(stride) {}
+        feature_t operator[](size_t idx) const { return _values[idx * _stride]; }
+    };
+
 private:
     FeatureExecutor(const FeatureExecutor &);
     FeatureExecutor &operator=(const FeatureExecutor &);
@@ -150,6 +164,67 @@ public:
      **/
     virtual bool isPure();
 
+    /**
+     * Check if this feature executor is able to calculate its
+     * outputs for a block of documents at a time (see
+     * execute_batch). Only executors with number inputs and outputs
+     * that do not use match data may support batch execution, since
+     * match data is only unpacked for a single document at a time.
+     *
+     * @return true if this feature executor supports batch execution
+     **/
+    virtual bool supports_batch() const;
+
+    /**
+     * Calculate the outputs of this feature executor for a block of
+     * documents. The value of input i for document j is found as
+     * inputs[i][j] and the value of output i for document j is to be
+     * stored in outputs[i][j]. Only called for executors supporting
+     * batch execution. This does not affect the values calculated by
+     * lazy_execute.
+     *
+     * @param docids the local document ids being evaluated
+     * @param inputs input values for all documents
+     * @param outputs where to store output values for all documents
+     **/
+    virtual void execute_batch(vespalib::ConstArrayRef<uint32_t> docids,
+                               vespalib::ConstArrayRef<NumberColumn> inputs,
+                               vespalib::ConstArrayRef<feature_t *> outputs);
+
+    /**
+     * Check if this feature executor is able to calculate its
+     * outputs for a set of documents up front, using a single
+     * combined calculation (see prefetch). This is useful for
+     * executors with a high fixed cost per invocation.
+     *
+     * @return true if this feature executor supports prefetching
+     **/
+    virtual bool supports_prefetch() const;
+
+    /**
+     * Start collecting the inputs for a set of documents that will
+     * be executed in the order they are prefetched.
+     *
+     * @param num_docs the number of documents to be prefetched
+     **/
+    virtual void start_prefetch(size_t num_docs);
+
+    /**
+     * Collect the inputs for a single document. Match data has been
+     * unpacked for the document when this function is called.
+     *
+     * @param idx the index of the document within the prefetched set
+     * @param docid the local document id being prefetched
+     **/
+    virtual void prefetch(size_t idx, uint32_t docid);
+
+    /**
+     * Calculate the outputs for all prefetched documents. A later
+     * call to execute for a prefetched document should use these
+     * outputs instead of calculating them again.
+     **/
+    virtual void finish_prefetch();
+
     /**
      * Make sure this executor has been executed for the given
      * document.
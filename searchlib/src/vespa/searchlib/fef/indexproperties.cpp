@@ -244,6 +244,21 @@ NumThreadsPerSearch::lookup(const Properties &props, uint32_t defaultValue)
     return lookupUint32(props, NAME, defaultValue);
 }
 
+const vespalib::string MinThreadsPerSearch::NAME("vespa.matching.minthreadspersearch");
+const uint32_t MinThreadsPerSearch::DEFAULT_VALUE(1);
+
+uint32_t
+MinThreadsPerSearch::lookup(const Properties &props)
+{
+    return lookup(props, DEFAULT_VALUE);
+}
+
+uint32_t
+MinThreadsPerSearch::lookup(const Properties &props, uint32_t defaultValue)
+{
+    return lookupUint32(props, NAME, defaultValue);
+}
+
 const vespalib::string NumSearchPartitions::NAME("vespa.matching.numsearchpartitions");
 const uint32_t NumSearchPartitions::DEFAULT_VALUE(1);
 
@@ -290,6 +305,22 @@ NearestNeighborBruteForceLimit::lookup(const Properties &props, double defaultVa
     return lookupDouble(props, NAME, defaultValue);
 }
 
+const vespalib::string NearestNeighborExtendedExplorationLimit::NAME("vespa.matching.nearest_neighbor.extended_exploration_limit");
+
+const double NearestNeighborExtendedExplorationLimit::DEFAULT_VALUE(0.2);
+
+double
+NearestNeighborExtendedExplorationLimit::lookup(const Properties &props)
+{
+    return lookup(props, DEFAULT_VALUE);
+}
+
+double
+NearestNeighborExtendedExplorationLimit::lookup(const Properties &props, double defaultValue)
+{
+    return lookupDouble(props, NAME, defaultValue);
+}
+
 const vespalib::string GlobalFilterLimit::NAME("vespa.matching.global_filter_limit");
 
 const double GlobalFilterLimit::DEFAULT_VALUE(0.0);
@@ -306,6 +337,81 @@ GlobalFilterLimit::lookup(const Properties &props, double defaultValue)
     return lookupDouble(props, NAME, defaultValue);
 }
 
+const vespalib::string AdaptiveReorderSeeks::NAME("vespa.matching.adaptive_reorder_seeks");
+const uint32_t AdaptiveReorderSeeks::DEFAULT_VALUE(0);
+
+uint32_t
+AdaptiveReorderSeeks::lookup(const Properties &props)
+{
+    return lookup(props, DEFAULT_VALUE);
+}
+
+uint32_t
+AdaptiveReorderSeeks::lookup(const Properties &props, uint32_t defaultValue)
+{
+    return lookupUint32(props, NAME, defaultValue);
+}
+
+const vespalib::string ResultCacheMaxBytes::NAME("vespa.matching.result_cache.max_bytes");
+const uint32_t ResultCacheMaxBytes::DEFAULT_VALUE(0);
+
+uint32_t
+ResultCacheMaxBytes::lookup(const Properties &props)
+{
+    return lookup(props, DEFAULT_VALUE);
+}
+
+uint32_t
+ResultCacheMaxBytes::lookup(const Properties &props, uint32_t defaultValue)
+{
+    return lookupUint32(props, NAME, defaultValue);
+}
+
+const vespalib::string ResultCacheMaxAge::NAME("vespa.matching.result_cache.max_age");
+const double ResultCacheMaxAge::DEFAULT_VALUE(1.0);
+
+double
+ResultCacheMaxAge::lookup(const Properties &props)
+{
+    return lookup(props, DEFAULT_VALUE);
+}
+
+double
+ResultCacheMaxAge::lookup(const Properties &props, double defaultValue)
+{
+    return lookupDouble(props, NAME, defaultValue);
+}
+
+const vespalib::string GlobalFilterCacheMaxBytes::NAME("vespa.matching.global_filter_cache.max_bytes");
+const uint32_t GlobalFilterCacheMaxBytes::DEFAULT_VALUE(0);
+
+uint32_t
+GlobalFilterCacheMaxBytes::lookup(const Properties &props)
+{
+    return lookup(props, DEFAULT_VALUE);
+}
+
+uint32_t
+GlobalFilterCacheMaxBytes::lookup(const Properties &props, uint32_t defaultValue)
+{
+    return lookupUint32(props, NAME, defaultValue);
+}
+
+const vespalib::string GlobalFilterCacheMaxAge::NAME("vespa.matching.global_filter_cache.max_age");
+const double GlobalFilterCacheMaxAge::DEFAULT_VALUE(1.0);
+
+double
+GlobalFilterCacheMaxAge::lookup(const Properties &props)
+{
+    return lookup(props, DEFAULT_VALUE);
+}
+
+double
+GlobalFilterCacheMaxAge::lookup(const Properties &props, double defaultValue)
+{
+    return lookupDouble(props, NAME, defaultValue);
+}
+
 } // namespace matching
 
 namespace softtimeout {
@@ -364,6 +470,9 @@ const double DegradationMaxFilterCoverage::DEFAULT_VALUE(0.2);
 const vespalib::string DegradationPostFilterMultiplier::NAME("vespa.matchphase.degradation.postfiltermultiplier");
 const double DegradationPostFilterMultiplier::DEFAULT_VALUE(1.0);
 
+const vespalib::string DegradationOrderedEvaluation::NAME("vespa.matchphase.degradation.orderedevaluation");
+const bool DegradationOrderedEvaluation::DEFAULT_VALUE(false);
+
 const vespalib::string DiversityAttribute::NAME("vespa.matchphase.diversity.attribute");
 const vespalib::string DiversityAttribute::DEFAULT_VALUE("");
 
@@ -412,6 +521,12 @@ DegradationPostFilterMultiplier::lookup(const Properties &props, double defaultV
     return lookupDouble(props, NAME, defaultValue);
 }
 
+bool
+DegradationOrderedEvaluation::lookup(const Properties &props, bool defaultValue)
+{
+    return lookupBool(props, NAME, defaultValue);
+}
+
 vespalib::string
 DiversityAttribute::lookup(const Properties &props, const vespalib::string & defaultValue)
 {
@@ -455,6 +570,37 @@ Level::lookup(const Properties &props, uint32_t defaultValue)
     return lookupUint32(props, NAME, defaultValue);
 }
 
+const vespalib::string ProfileFeatures::NAME("vespa.trace.profile_features");
+const uint32_t ProfileFeatures::DEFAULT_VALUE(0);
+
+uint32_t
+ProfileFeatures::lookup(const Properties &props)
+{
+    return lookupUint32(props, NAME, DEFAULT_VALUE);
+}
+
+const vespalib::string ProfileSearch::NAME("vespa.trace.profile_search");
+const uint32_t ProfileSearch::DEFAULT_VALUE(0);
+
+uint32_t
+ProfileSearch::lookup(const Properties &props)
+{
+    return lookupUint32(props, NAME, DEFAULT_VALUE);
+}
+
+}
+
+namespace admission {
+
+const vespalib::string Priority::NAME("vespa.admission.priority");
+const uint32_t Priority::DEFAULT_VALUE(0);
+
+uint32_t
+Priority::lookup(const Properties &props)
+{
+    return lookupUint32(props, NAME, DEFAULT_VALUE);
+}
+
 }
 
 namespace hitcollector {
@@ -185,6 +185,16 @@ namespace matching {
         static uint32_t lookup(const Properties &props);
         static uint32_t lookup(const Properties &props, uint32_t defaultValue);
     };
+    /**
+     * Property for the minimum number of threads used per search when
+     * the number of threads is reduced due to high search load.
+     **/
+    struct MinThreadsPerSearch {
+        static const vespalib::string NAME;
+        static const uint32_t DEFAULT_VALUE;
+        static uint32_t lookup(const Properties &props);
+        static uint32_t lookup(const Properties &props, uint32_t defaultValue);
+    };
     /**
      * Property for the minimum number of hits per thread.
      **/
@@ -219,6 +229,19 @@ namespace matching {
         static double lookup(const Properties &props, double defaultValue);
     };
 
+    /**
+     * Property to control HNSW search with extended exploration. If the
+     * ratio of documents matching the global filter is less than this
+     * limit (but not below the brute force limit) then the number of
+     * nodes explored in the graph is scaled up by the inverse ratio.
+     **/
+    struct NearestNeighborExtendedExplorationLimit {
+        static const vespalib::string NAME;
+        static const double DEFAULT_VALUE;
+        static double lookup(const Properties &props);
+        static double lookup(const Properties &props, double defaultValue);
+    };
+
     /**
      * Property to control fallback to not building a global filter
      * for a query with a blueprint that wants a global filter. If the
@@ -231,6 +254,66 @@ namespace matching {
         static double lookup(const Properties &props);
         static double lookup(const Properties &props, double defaultValue);
     };
+
+    /**
+     * Number of seeks during which AND and ANDNOT searches count how
+     * often each child rejects a candidate, before reordering their
+     * children by decreasing rejection rate. The default value 0
+     * disables adaptive child reordering.
+     **/
+    struct AdaptiveReorderSeeks {
+        static const vespalib::string NAME;
+        static const uint32_t DEFAULT_VALUE;
+        static uint32_t lookup(const Properties &props);
+        static uint32_t lookup(const Properties &props, uint32_t defaultValue);
+    };
+
+    /**
+     * Max number of bytes used to cache search replies for this rank
+     * profile on the content node. The default value 0 disables the
+     * result cache.
+     **/
+    struct ResultCacheMaxBytes {
+        static const vespalib::string NAME;
+        static const uint32_t DEFAULT_VALUE;
+        static uint32_t lookup(const Properties &props);
+        static uint32_t lookup(const Properties &props, uint32_t defaultValue);
+    };
+
+    /**
+     * Max age (in seconds) of a cached search reply before it is no
+     * longer returned from the result cache.
+     **/
+    struct ResultCacheMaxAge {
+        static const vespalib::string NAME;
+        static const double DEFAULT_VALUE;
+        static double lookup(const Properties &props);
+        static double lookup(const Properties &props, double defaultValue);
+    };
+
+    /**
+     * Max number of bytes used to cache global filters (as bit
+     * vectors) for this rank profile, sharing them between queries
+     * with the same query tree. The default value 0 disables the
+     * global filter cache.
+     **/
+    struct GlobalFilterCacheMaxBytes {
+        static const vespalib::string NAME;
+        static const uint32_t DEFAULT_VALUE;
+        static uint32_t lookup(const Properties &props);
+        static uint32_t lookup(const Properties &props, uint32_t defaultValue);
+    };
+
+    /**
+     * Max age (in seconds) of a cached global filter before it is no
+     * longer used.
+     **/
+    struct GlobalFilterCacheMaxAge {
+        static const vespalib::string NAME;
+        static const double DEFAULT_VALUE;
+        static double lookup(const Properties &props);
+        static double lookup(const Properties &props, double defaultValue);
+    };
 }
 
 namespace softtimeout {
@@ -328,6 +411,19 @@ namespace matchphase {
         static double lookup(const Properties &props, double defaultValue);
     };
 
+    /**
+     * Property for evaluating the query in the order of the
+     * degradation attribute (using its posting lists) until max hits
+     * are found, instead of limiting to an estimated number of
+     * documents. Not used together with diversity.
+     **/
+    struct DegradationOrderedEvaluation {
+        static const vespalib::string NAME;
+        static const bool DEFAULT_VALUE;
+        static bool lookup(const Properties &props) { return lookup(props, DEFAULT_VALUE); }
+        static bool lookup(const Properties &props, bool defaultValue);
+    };
+
     /**
      * The name of the attribute used to ensure result diversity
      * during match phase limiting. If this property is "" (empty
@@ -379,6 +475,47 @@ namespace trace {
         static uint32_t lookup(const Properties &props, uint32_t defaultValue);
     };
 
+    /**
+     * Property for profiling the execution of rank features. When set
+     * to N > 0, every N'th document is profiled and the time spent in
+     * each feature is reported in the trace of each match thread
+     * (tracelevel 4 or higher is needed to see it). Default is 0 (off).
+     **/
+    struct ProfileFeatures {
+        static const vespalib::string NAME;
+        static const uint32_t DEFAULT_VALUE;
+        static uint32_t lookup(const Properties &props);
+    };
+
+    /**
+     * Property for profiling the search iterator tree. When set to
+     * N > 0, seeks and unpacks are counted for each iterator and
+     * every N'th call into the iterator tree is timed. The result is
+     * reported as a tree in the trace of each match thread (tracelevel
+     * 4 or higher is needed to see it). Default is 0 (off).
+     **/
+    struct ProfileSearch {
+        static const vespalib::string NAME;
+        static const uint32_t DEFAULT_VALUE;
+        static uint32_t lookup(const Properties &props);
+    };
+
+}
+
+namespace admission {
+
+    /**
+     * Property for the priority of a query when waiting for a search
+     * thread on a content node. Queries with higher priority are
+     * performed first when search admission control is enabled.
+     * Default is 0.
+     **/
+    struct Priority {
+        static const vespalib::string NAME;
+        static const uint32_t DEFAULT_VALUE;
+        static uint32_t lookup(const Properties &props);
+    };
+
 }
 
 
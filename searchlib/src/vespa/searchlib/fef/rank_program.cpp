@@ -2,6 +2,7 @@
 
 #include "rank_program.h"
 #include "featureoverrider.h"
+#include "feature_profiler.h"
 #include <vespa/vespalib/locale/c.h>
 #include <vespa/vespalib/stllike/hash_set.hpp>
 #include <algorithm>
@@ -68,6 +69,56 @@ struct UnboxingExecutor : FeatureExecutor {
     }
 };
 
+// Times the wrapped executor for sampled documents. Batch execution
+// and prefetching are passed through, timing each batch (prefetch
+// is timed when it is finished, since that is where the work is done).
+class ProfiledExecutor : public FeatureExecutor {
+private:
+    FeatureExecutor &_executor;
+    FeatureProfiler &_profiler;
+    uint32_t         _id;
+
+    void handle_bind_inputs(vespalib::ConstArrayRef<LazyValue> inputs) override {
+        _executor.bind_inputs(inputs);
+    }
+    void handle_bind_outputs(vespalib::ArrayRef<NumberOrObject> outputs) override {
+        _executor.bind_outputs(outputs);
+    }
+    void handle_bind_match_data(const MatchData &md) override {
+        _executor.bind_match_data(md);
+    }
+public:
+    ProfiledExecutor(FeatureExecutor &executor, FeatureProfiler &profiler, uint32_t id)
+        : _executor(executor), _profiler(profiler), _id(id) {}
+    bool isPure() override { return _executor.isPure(); }
+    void execute(uint32_t docid) override {
+        if (_profiler.sample(docid)) {
+            _profiler.start(_id);
+            _executor.lazy_execute(docid);
+            _profiler.complete();
+        } else {
+            _executor.lazy_execute(docid);
+        }
+    }
+    bool supports_batch() const override { return _executor.supports_batch(); }
+    void execute_batch(vespalib::ConstArrayRef<uint32_t> docids,
+                       vespalib::ConstArrayRef<NumberColumn> inputs,
+                       vespalib::ConstArrayRef<feature_t *> outputs) override
+    {
+        _profiler.start(_id);
+        _executor.execute_batch(docids, inputs, outputs);
+        _profiler.complete();
+    }
+    bool supports_prefetch() const override { return _executor.supports_prefetch(); }
+    void start_prefetch(size_t num_docs) override { _executor.start_prefetch(num_docs); }
+    void prefetch(size_t idx, uint32_t docid) override { _executor.prefetch(idx, docid); }
+    void finish_prefetch() override {
+        _profiler.start(_id);
+        _executor.finish_prefetch();
+        _profiler.complete();
+    }
+};
+
 class StashSelector {
 private:
     Stash &_primary;
@@ -131,6 +182,86 @@ RankProgram::unbox(BlueprintResolver::FeatureRef seed, const MatchData &md)
     }
 }
 
+void
+RankProgram::setup_batch()
+{
+    const auto &seeds = _resolver->getSeedMap();
+    if (seeds.size() != 1) {
+        return;
+    }
+    const auto &specs = _resolver->getExecutorSpecs();
+    auto seed = seeds.begin()->second;
+    if (specs[seed.executor].output_types[seed.output].is_object()) {
+        return;
+    }
+    const NumberOrObject *seed_value = _executors[seed.executor]->outputs().get_raw(seed.output);
+    std::vector<bool> needed(specs.size(), false);
+    needed[seed.executor] = !check_const(seed_value);
+    for (size_t i = specs.size(); i-- > 0; ) {
+        if (!needed[i]) {
+            continue;
+        }
+        if (!_executors[i]->supports_batch()) {
+            return;
+        }
+        for (const auto &ref: specs[i].inputs) {
+            if (specs[ref.executor].output_types[ref.output].is_object()) {
+                return;
+            }
+            if (!check_const(_executors[ref.executor]->outputs().get_raw(ref.output))) {
+                needed[ref.executor] = true;
+            }
+        }
+    }
+    std::map<const NumberOrObject *, const feature_t *> columns;
+    auto make_column = [&](const NumberOrObject *value) {
+        return check_const(value)
+            ? FeatureExecutor::NumberColumn(&value->as_number, 0)
+            : FeatureExecutor::NumberColumn(columns[value], 1);
+    };
+    for (size_t i = 0; i < specs.size(); ++i) {
+        if (!needed[i]) {
+            continue;
+        }
+        const auto &outputs = _executors[i]->outputs();
+        auto inputs = _hot_stash.create_array<FeatureExecutor::NumberColumn>(specs[i].inputs.size());
+        for (size_t input_idx = 0; input_idx < inputs.size(); ++input_idx) {
+            auto ref = specs[i].inputs[input_idx];
+            inputs[input_idx] = make_column(_executors[ref.executor]->outputs().get_raw(ref.output));
+        }
+        auto output_columns = _hot_stash.create_array<feature_t *>(outputs.size(), nullptr);
+        for (size_t out_idx = 0; out_idx < outputs.size(); ++out_idx) {
+            output_columns[out_idx] = &_hot_stash.create_array<feature_t>(BATCH_SIZE, 0.0)[0];
+            columns[outputs.get_raw(out_idx)] = output_columns[out_idx];
+        }
+        _batch_steps.push_back(BatchStep{_executors[i], inputs, output_columns});
+    }
+    _batch_seed = make_column(seed_value);
+    _can_batch = true;
+}
+
+void
+RankProgram::setup_prefetch()
+{
+    const auto &specs = _resolver->getExecutorSpecs();
+    std::vector<bool> after_prefetch(specs.size(), false);
+    for (size_t i = 0; i < specs.size(); ++i) {
+        FeatureExecutor *executor = _executors[i];
+        if ((executor->outputs().size() > 0) && check_const(executor->outputs().get_raw(0))) {
+            continue;
+        }
+        for (const auto &ref: specs[i].inputs) {
+            if (after_prefetch[ref.executor]) {
+                after_prefetch[i] = true;
+            }
+        }
+        if (!after_prefetch[i] && executor->supports_prefetch()) {
+            _prefetch_executors.push_back(executor);
+            after_prefetch[i] = true;
+        }
+    }
+}
+
 FeatureResolver
 RankProgram::resolve(const BlueprintResolver::FeatureMap &features, bool unbox_seeds) const
 {
@@ -161,7 +292,11 @@ RankProgram::RankProgram(BlueprintResolver::SP resolver)
       _cold_stash(),
       _executors(),
       _unboxed_seeds(),
-      _is_const()
+      _is_const(),
+      _batch_steps(),
+      _batch_seed(),
+      _can_batch(false),
+      _prefetch_executors()
 {
 }
 
@@ -170,7 +305,8 @@ RankProgram::~RankProgram() = default;
 void
 RankProgram::setup(const MatchData &md,
                    const IQueryEnvironment &queryEnv,
-                   const Properties &featureOverrides)
+                   const Properties &featureOverrides,
+                   FeatureProfiler *profiler)
 {
     assert(_executors.empty());
     std::vector<Override> overrides = prepare_overrides(_resolver->getFeatureMap(), featureOverrides);
@@ -206,6 +342,10 @@ RankProgram::setup(const MatchData &md,
             FeatureExecutor *tmp = executor;
             executor = &(stash.get().create<FeatureOverrider>(*tmp, override->ref.output, override->value));
         }
+        if ((profiler != nullptr) && !is_const) {
+            uint32_t id = profiler->resolve(specs[i].blueprint->getName());
+            executor = &(stash.get().create<ProfiledExecutor>(*executor, *profiler, id));
+        }
         executor->bind_inputs(inputs);
         executor->bind_outputs(outputs);
         executor->bind_match_data(md);
@@ -221,8 +361,12 @@ RankProgram::setup(const MatchData &md,
         }
     }
     assert(_executors.size() == specs.size());
-    LOG(debug, "Num executors = %ld, hot stash = %ld, cold stash = %ld, match data fields = %d",
-               _executors.size(), _hot_stash.count_used(), _cold_stash.count_used(), md.getNumTermFields());
+    setup_batch();
+    setup_prefetch();
+    LOG(debug, "Num executors = %ld, hot stash = %ld, cold stash = %ld, match data fields = %d, can batch = %s, "
+               "prefetch executors = %zu",
+               _executors.size(), _hot_stash.count_used(), _cold_stash.count_used(), md.getNumTermFields(),
+               _can_batch ? "true" : "false", _prefetch_executors.size());
     if (LOG_WOULD_LOG(debug)) {
         vespalib::hash_map<vespalib::string, size_t> executorStats;
         for (const FeatureExecutor * executor : _executors) {
@@ -239,6 +383,20 @@ RankProgram::setup(const MatchData &md,
     }
 }
 
+void
+RankProgram::reset()
+{
+    _prefetch_executors.clear();
+    _can_batch = false;
+    _batch_seed = FeatureExecutor::NumberColumn();
+    _batch_steps.clear();
+    _is_const.clear();
+    _unboxed_seeds.clear();
+    _executors.clear();
+    _cold_stash.clear();
+    _hot_stash.clear();
+}
+
 FeatureResolver
 RankProgram::get_seeds(bool unbox_seeds) const
 {
@@ -251,4 +409,39 @@ RankProgram::get_all_features(bool unbox_seeds) const
     return resolve(_resolver->getFeatureMap(), unbox_seeds);
 }
 
+FeatureExecutor::NumberColumn
+RankProgram::run_batch(vespalib::ConstArrayRef<uint32_t> docids)
+{
+    assert(_can_batch && (docids.size() <= BATCH_SIZE));
+    for (const auto &step: _batch_steps) {
+        step.executor->execute_batch(docids, step.inputs, step.outputs);
+    }
+    return _batch_seed;
+}
+
+void
+RankProgram::start_prefetch(size_t num_docs)
+{
+    assert(num_docs <= BATCH_SIZE);
+    for (FeatureExecutor *executor: _prefetch_executors) {
+        executor->start_prefetch(num_docs);
+    }
+}
+
+void
+RankProgram::prefetch(size_t idx, uint32_t docid)
+{
+    for (FeatureExecutor *executor: _prefetch_executors) {
+        executor->prefetch(idx, docid);
+    }
+}
+
+void
+RankProgram::finish_prefetch()
+{
+    for (FeatureExecutor *executor: _prefetch_executors) {
+        executor->finish_prefetch();
+    }
+}
+
 }
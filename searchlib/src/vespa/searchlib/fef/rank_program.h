@@ -14,6 +14,8 @@
 
 namespace search::fef {
 
+class FeatureProfiler;
+
 /**
  * A rank program is able to lazily calculate a set of feature
  * values. In order to access (and thereby calculate) output features
@@ -26,6 +28,11 @@ namespace search::fef {
  **/
 class RankProgram
 {
+public:
+    // max number of documents calculated by a single run_batch call
+    // or prefetched together
+    static constexpr size_t BATCH_SIZE = 64;
+
 private:
     RankProgram(const RankProgram &) = delete;
     RankProgram &operator=(const RankProgram &) = delete;
@@ -34,17 +41,29 @@ private:
     using ValueSet = vespalib::hash_set<const NumberOrObject *, vespalib::hash<const NumberOrObject *>,
                                         std::equal_to<>, vespalib::hashtable_base::and_modulator>;
 
+    struct BatchStep {
+        FeatureExecutor                                       *executor;
+        vespalib::ConstArrayRef<FeatureExecutor::NumberColumn> inputs;
+        vespalib::ConstArrayRef<feature_t *>                   outputs;
+    };
+
     BlueprintResolver::SP            _resolver;
     vespalib::Stash                  _hot_stash;
     vespalib::Stash                  _cold_stash;
     std::vector<FeatureExecutor *>   _executors;
     MappedValues                     _unboxed_seeds;
     ValueSet                         _is_const;
+    std::vector<BatchStep>           _batch_steps;
+    FeatureExecutor::NumberColumn    _batch_seed;
+    bool                             _can_batch;
+    std::vector<FeatureExecutor *>   _prefetch_executors;
 
     bool check_const(const NumberOrObject *value) const { return (_is_const.count(value) == 1); }
     bool check_const(FeatureExecutor *executor, const std::vector<BlueprintResolver::FeatureRef> &inputs) const;
     void run_const(FeatureExecutor *executor);
     void unbox(BlueprintResolver::FeatureRef seed, const MatchData &md);
+    void setup_batch();
+    void setup_prefetch();
     FeatureResolver resolve(const BlueprintResolver::FeatureMap &features, bool unbox_seeds) const;
 
 public:
@@ -65,10 +84,25 @@ public:
      * Set up this rank program by creating the needed feature
      * executors and wiring them together. This function will also
      * pre-calculate all constant features.
+     *
+     * If a profiler is given, the time spent executing each
+     * non-constant feature is collected in it. The profiler must
+     * outlive this rank program.
      **/
     void setup(const MatchData &md,
                const IQueryEnvironment &queryEnv,
-               const Properties &featureOverrides = Properties());
+               const Properties &featureOverrides = Properties(),
+               FeatureProfiler *profiler = nullptr);
+
+    /**
+     * Tear down the executors created by setup, while keeping the
+     * memory used to hold them. After this, setup may be called again
+     * (typically for another query) without allocating a new rank
+     * program.
+     **/
+    void reset();
+
+    const BlueprintResolver &get_resolver() const { return *_resolver; }
 
     /**
      * Obtain the names and storage locations of all seed features for
@@ -88,6 +122,46 @@ public:
      * @params unbox_seeds make sure seeds values are numbers
      **/
     FeatureResolver get_all_features(bool unbox_seeds = true) const;
+
+    /**
+     * Check if the value of the single seed of this program can be
+     * calculated for a block of documents at a time using
+     * run_batch. This is the case when all non-const executors
+     * needed to calculate the seed support batch execution, which
+     * also means that no match data is needed.
+     **/
+    bool can_batch() const { return _can_batch; }
+
+    /**
+     * Calculate the value of the single seed of this program for a
+     * block of at most BATCH_SIZE documents. Must only be used if
+     * can_batch returns true. The returned values are valid until
+     * the next call to this function.
+     *
+     * @return seed values for all documents
+     * @param docids the local document ids being evaluated
+     **/
+    FeatureExecutor::NumberColumn run_batch(vespalib::ConstArrayRef<uint32_t> docids);
+
+    /**
+     * Check if this program contains executors that are able to
+     * calculate their outputs for a set of documents up front (like
+     * onnx models evaluated with a batch dimension). Executors
+     * depending on the outputs of other prefetching executors are
+     * not prefetched.
+     **/
+    bool can_prefetch() const { return !_prefetch_executors.empty(); }
+
+    /**
+     * Prefetch a set of at most BATCH_SIZE documents that will
+     * later be evaluated in the same order: call start_prefetch with
+     * the number of documents, then prefetch for each document
+     * (after unpacking match data for it) and finally
+     * finish_prefetch.
+     **/
+    void start_prefetch(size_t num_docs);
+    void prefetch(size_t idx, uint32_t docid);
+    void finish_prefetch();
 };
 
 }
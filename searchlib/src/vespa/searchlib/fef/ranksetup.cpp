@@ -38,6 +38,7 @@ RankSetup::RankSetup(const BlueprintFactory &factory, const IIndexEnvironment &i
       _delay_unpacking_iterators(false),
       _termwise_limit(1.0),
       _numThreads(0),
+      _minNumThreads(0),
       _minHitsPerThread(0),
       _numSearchPartitions(0),
       _heapSize(0),
@@ -55,6 +56,7 @@ RankSetup::RankSetup(const BlueprintFactory &factory, const IIndexEnvironment &i
       _compiled(false),
       _compileError(false),
       _degradationAscendingOrder(false),
+      _degradationOrderedEvaluation(false),
       _diversityAttribute(),
       _diversityMinGroups(1),
       _diversityCutoffFactor(10.0),
@@ -63,11 +65,48 @@ RankSetup::RankSetup(const BlueprintFactory &factory, const IIndexEnvironment &i
       _softTimeoutTailCost(0.1),
       _softTimeoutFactor(0.5),
       _nearest_neighbor_brute_force_limit(0.05),
-      _global_filter_limit(0.0)
+      _nearest_neighbor_extended_exploration_limit(0.2),
+      _global_filter_limit(0.0),
+      _program_pool_lock(),
+      _first_phase_pool(),
+      _second_phase_pool()
 { }
 
 RankSetup::~RankSetup() = default;
 
+RankProgram::UP
+RankSetup::reuse_program(std::vector<RankProgram::UP> &pool, const BlueprintResolver::SP &resolver) const
+{
+    {
+        std::lock_guard<std::mutex> guard(_program_pool_lock);
+        if (!pool.empty()) {
+            RankProgram::UP program = std::move(pool.back());
+            pool.pop_back();
+            return program;
+        }
+    }
+    return std::make_unique<RankProgram>(resolver);
+}
+
+void
+RankSetup::recycle_program(RankProgram::UP program) const
+{
+    std::vector<RankProgram::UP> *pool = nullptr;
+    if (&program->get_resolver() == _first_phase_resolver.get()) {
+        pool = &_first_phase_pool;
+    } else if (&program->get_resolver() == _second_phase_resolver.get()) {
+        pool = &_second_phase_pool;
+    }
+    if (pool == nullptr) {
+        return;
+    }
+    program->reset();
+    std::lock_guard<std::mutex> guard(_program_pool_lock);
+    if (pool->size() < MAX_POOLED_PROGRAMS) {
+        pool->push_back(std::move(program));
+    }
+}
+
 void
 RankSetup::configure()
 {
@@ -86,6 +125,7 @@ RankSetup::configure()
     delay_unpacking_iterators(matching::DelayUnpackingIterators::check(_indexEnv.getProperties()));
     set_termwise_limit(matching::TermwiseLimit::lookup(_indexEnv.getProperties()));
     setNumThreadsPerSearch(matching::NumThreadsPerSearch::lookup(_indexEnv.getProperties()));
+    setMinThreadsPerSearch(matching::MinThreadsPerSearch::lookup(_indexEnv.getProperties()));
     setMinHitsPerThread(matching::MinHitsPerThread::lookup(_indexEnv.getProperties()));
     setNumSearchPartitions(matching::NumSearchPartitions::lookup(_indexEnv.getProperties()));
     setHeapSize(hitcollector::HeapSize::lookup(_indexEnv.getProperties()));
@@ -96,6 +136,7 @@ RankSetup::configure()
     setDegradationMaxFilterCoverage(matchphase::DegradationMaxFilterCoverage::lookup(_indexEnv.getProperties()));
     setDegradationSamplePercentage(matchphase::DegradationSamplePercentage::lookup(_indexEnv.getProperties()));
     setDegradationPostFilterMultiplier(matchphase::DegradationPostFilterMultiplier::lookup(_indexEnv.getProperties()));
+    setDegradationOrderedEvaluation(matchphase::DegradationOrderedEvaluation::lookup(_indexEnv.getProperties()));
     setDiversityAttribute(matchphase::DiversityAttribute::lookup(_indexEnv.getProperties()));
     setDiversityMinGroups(matchphase::DiversityMinGroups::lookup(_indexEnv.getProperties()));
     setDiversityCutoffFactor(matchphase::DiversityCutoffFactor::lookup(_indexEnv.getProperties()));
@@ -107,6 +148,7 @@ RankSetup::configure()
     setSoftTimeoutTailCost(softtimeout::TailCost::lookup(_indexEnv.getProperties()));
     setSoftTimeoutFactor(softtimeout::Factor::lookup(_indexEnv.getProperties()));
     set_nearest_neighbor_brute_force_limit(matching::NearestNeighborBruteForceLimit::lookup(_indexEnv.getProperties()));
+    set_nearest_neighbor_extended_exploration_limit(matching::NearestNeighborExtendedExplorationLimit::lookup(_indexEnv.getProperties()));
     set_global_filter_limit(matching::GlobalFilterLimit::lookup(_indexEnv.getProperties()));
 }
 
@@ -7,6 +7,7 @@
 #include "iqueryenvironment.h"
 #include "blueprintresolver.h"
 #include "rank_program.h"
+#include <mutex>
 
 namespace search::fef {
 
@@ -35,6 +36,7 @@ private:
     bool                     _delay_unpacking_iterators;
     double                   _termwise_limit;
     uint32_t                 _numThreads;
+    uint32_t                 _minNumThreads;
     uint32_t                 _minHitsPerThread;
     uint32_t                 _numSearchPartitions;
     uint32_t                 _heapSize;
@@ -52,6 +54,7 @@ private:
     bool                     _compiled;
     bool                     _compileError;
     bool                     _degradationAscendingOrder;
+    bool                     _degradationOrderedEvaluation;
     vespalib::string         _diversityAttribute;
     uint32_t                 _diversityMinGroups;
     double                   _diversityCutoffFactor;
@@ -60,10 +63,18 @@ private:
     double                   _softTimeoutTailCost;
     double                   _softTimeoutFactor;
     double                   _nearest_neighbor_brute_force_limit;
+    double                   _nearest_neighbor_extended_exploration_limit;
     double                   _global_filter_limit;
+    mutable std::mutex                   _program_pool_lock;
+    mutable std::vector<RankProgram::UP> _first_phase_pool;
+    mutable std::vector<RankProgram::UP> _second_phase_pool;
 
+    RankProgram::UP reuse_program(std::vector<RankProgram::UP> &pool, const BlueprintResolver::SP &resolver) const;
 
 public:
+    // max number of recycled rank programs kept per ranking phase
+    static constexpr size_t MAX_POOLED_PROGRAMS = 32;
+
     RankSetup(const RankSetup &) = delete;
     RankSetup &operator=(const RankSetup &) = delete;
     /**
@@ -160,6 +171,13 @@ public:
      * @return the number of threads
      **/
     uint32_t getNumThreadsPerSearch() const { return _numThreads; }
+
+    /**
+     * Sets/returns the minimum number of threads per search used when
+     * the number of threads is reduced due to high search load.
+     **/
+    void setMinThreadsPerSearch(uint32_t minNumThreads) { _minNumThreads = minNumThreads; }
+    uint32_t getMinThreadsPerSearch() const { return _minNumThreads; }
     uint32_t getMinHitsPerThread() const { return _minHitsPerThread; }
     void setMinHitsPerThread(uint32_t minHitsPerThread) { _minHitsPerThread = minHitsPerThread; }
 
@@ -224,6 +242,9 @@ public:
         return _degradationPostFilterMultiplier;
     }
 
+    /** check whether the query should be evaluated in degradation attribute order in match phase */
+    bool isDegradationOrderedEvaluation() const { return _degradationOrderedEvaluation; }
+
     /** get the attribute used to ensure diversity during match phase limiting **/
     vespalib::string getDiversityAttribute() const {
         return _diversityAttribute;
@@ -269,6 +290,9 @@ public:
         _degradationPostFilterMultiplier = samplePercentage;
     }
 
+    /** set whether the query should be evaluated in degradation attribute order in match phase */
+    void setDegradationOrderedEvaluation(bool ordered) { _degradationOrderedEvaluation = ordered; }
+
     /** set the attribute used to ensure diversity during match phase limiting **/
     void setDiversityAttribute(const vespalib::string &value) {
         _diversityAttribute = value;
@@ -370,6 +394,9 @@ public:
     void set_nearest_neighbor_brute_force_limit(double v) { _nearest_neighbor_brute_force_limit = v; }
     double get_nearest_neighbor_brute_force_limit() const { return _nearest_neighbor_brute_force_limit; }
 
+    void set_nearest_neighbor_extended_exploration_limit(double v) { _nearest_neighbor_extended_exploration_limit = v; }
+    double get_nearest_neighbor_extended_exploration_limit() const { return _nearest_neighbor_extended_exploration_limit; }
+
     void set_global_filter_limit(double v) { _global_filter_limit = v; }
     double get_global_filter_limit() const { return _global_filter_limit; }
 
@@ -404,12 +431,22 @@ public:
     // that the setup function must be called on rank programs for
     // them to be ready to use. Also keep in mind that creating a rank
     // program is cheap while setting it up is more expensive.
+    // Ranking phase programs given back with recycle_program are
+    // handed out again, keeping the memory from earlier setups.
 
-    RankProgram::UP create_first_phase_program() const { return std::make_unique<RankProgram>(_first_phase_resolver); }
-    RankProgram::UP create_second_phase_program() const { return std::make_unique<RankProgram>(_second_phase_resolver); }
+    RankProgram::UP create_first_phase_program() const { return reuse_program(_first_phase_pool, _first_phase_resolver); }
+    RankProgram::UP create_second_phase_program() const { return reuse_program(_second_phase_pool, _second_phase_resolver); }
     RankProgram::UP create_summary_program() const { return std::make_unique<RankProgram>(_summary_resolver); }
     RankProgram::UP create_dump_program() const { return std::make_unique<RankProgram>(_dumpResolver); }
 
+    /**
+     * Give back a rank program created by this rank setup when it is
+     * no longer needed. Its executors are torn down right away, so
+     * this must be done while the query environment it was set up
+     * with is still alive.
+     **/
+    void recycle_program(RankProgram::UP program) const;
+
     /**
      * Here you can do some preprocessing. State must be stored in the IObjectStore.
      * This is called before creating multiple execution threads.
@@ -16,6 +16,22 @@ SumExecutor::execute(uint32_t)
     outputs().set_number(0, sum);
 }
 
+void
+SumExecutor::execute_batch(vespalib::ConstArrayRef<uint32_t> docids,
+                           vespalib::ConstArrayRef<NumberColumn> inputs_in,
+                           vespalib::ConstArrayRef<feature_t *> outputs_in)
+{
+    feature_t *sum = outputs_in[0];
+    for (size_t j = 0; j < docids.size(); ++j) {
+        sum[j] = 0.0f;
+    }
+    for (const NumberColumn &input: inputs_in) {
+        for (size_t j = 0; j < docids.size(); ++j) {
+            sum[j] += input[j];
+        }
+    }
+}
+
 
 SumBlueprint::SumBlueprint() :
     Blueprint("mysum")
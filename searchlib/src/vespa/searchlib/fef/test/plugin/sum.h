@@ -14,6 +14,10 @@ class SumExecutor : public FeatureExecutor
 public:
     bool isPure() override { return true; }
     void execute(uint32_t docId) override;
+    bool supports_batch() const override { return true; }
+    void execute_batch(vespalib::ConstArrayRef<uint32_t> docids,
+                       vespalib::ConstArrayRef<NumberColumn> inputs,
+                       vespalib::ConstArrayRef<feature_t *> outputs) override;
 };
 
 
@@ -38,6 +38,15 @@ ImpureValueBlueprint::createExecutor(const IQueryEnvironment &, vespalib::Stash
 
 struct DocidExecutor : FeatureExecutor {
     void execute(uint32_t docid) override { outputs().set_number(0, docid); }
+    bool supports_batch() const override { return true; }
+    void execute_batch(vespalib::ConstArrayRef<uint32_t> docids,
+                       vespalib::ConstArrayRef<NumberColumn>,
+                       vespalib::ConstArrayRef<feature_t *> outputs_in) override
+    {
+        for (size_t j = 0; j < docids.size(); ++j) {
+            outputs_in[0][j] = docids[j];
+        }
+    }
 };
 
 bool
@@ -109,4 +118,46 @@ TrackingBlueprint::createExecutor(const IQueryEnvironment &, vespalib::Stash &st
 
 //-----------------------------------------------------------------------------
 
+struct PrefetchExecutor : FeatureExecutor {
+    size_t &ext_cnt;
+    vespalib::ConstArrayRef<LazyValue> input_values;
+    std::vector<std::pair<uint32_t,feature_t>> prefetched;
+    PrefetchExecutor(size_t &ext_cnt_in) : ext_cnt(ext_cnt_in), input_values(), prefetched() {}
+    bool isPure() override { return true; }
+    void handle_bind_inputs(vespalib::ConstArrayRef<LazyValue> inputs) override { input_values = inputs; }
+    void execute(uint32_t docid) override {
+        for (const auto &entry: prefetched) {
+            if (entry.first == docid) {
+                outputs().set_number(0, entry.second);
+                return;
+            }
+        }
+        ++ext_cnt;
+        outputs().set_number(0, inputs().get_number(0));
+    }
+    bool supports_prefetch() const override { return true; }
+    void start_prefetch(size_t) override { prefetched.clear(); }
+    void prefetch(size_t idx, uint32_t docid) override {
+        ASSERT_EQUAL(idx, prefetched.size());
+        prefetched.emplace_back(docid, input_values[0].as_number(docid));
+    }
+};
+
+bool
+PrefetchBlueprint::setup(const IIndexEnvironment &, const std::vector<vespalib::string> &params)
+{
+    ASSERT_EQUAL(1u, params.size());
+    defineInput(params[0]);
+    describeOutput("out", "prefetched value");
+    return true;
+}
+
+FeatureExecutor &
+PrefetchBlueprint::createExecutor(const IQueryEnvironment &, vespalib::Stash &stash) const
+{
+    return stash.create<PrefetchExecutor>(ext_cnt);
+}
+
+//-----------------------------------------------------------------------------
+
 }
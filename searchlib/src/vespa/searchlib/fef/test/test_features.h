@@ -57,6 +57,20 @@ struct TrackingBlueprint : Blueprint {
 
 //-----------------------------------------------------------------------------
 
+// "prefetch(docid)" calculates docid, using values collected by
+// prefetching when possible. Counts executions that were not
+// prefetched as a side-effect
+struct PrefetchBlueprint : Blueprint {
+    size_t &ext_cnt;
+    PrefetchBlueprint(size_t &ext_cnt_in) : Blueprint("prefetch"), ext_cnt(ext_cnt_in) {}
+    void visitDumpFeatures(const IIndexEnvironment &, IDumpFeatureVisitor &) const override {}
+    Blueprint::UP createInstance() const override { return Blueprint::UP(new PrefetchBlueprint(ext_cnt)); }
+    bool setup(const IIndexEnvironment &, const std::vector<vespalib::string> &params) override;
+    FeatureExecutor &createExecutor(const IQueryEnvironment &, vespalib::Stash &stash) const override;
+};
+
+//-----------------------------------------------------------------------------
+
 } // namespace test
 } // namespace fef
 } // namespace search
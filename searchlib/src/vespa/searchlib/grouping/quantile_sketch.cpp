@@ -0,0 +1,182 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "quantile_sketch.h"
+#include <algorithm>
+#include <cmath>
+
+namespace search {
+
+namespace {
+
+// capacity of each level relative to the level above it
+constexpr double capacityDecay = 2.0 / 3.0;
+// smallest capacity of a level
+constexpr uint32_t minCapacity = 2;
+
+}
+
+QuantileSketch::QuantileSketch(uint32_t k)
+    : _k(std::max(k, minCapacity)),
+      _count(0),
+      _levels(1),
+      _oddOffset(1, false)
+{
+}
+
+QuantileSketch::~QuantileSketch() = default;
+
+uint32_t
+QuantileSketch::capacity(size_t level) const
+{
+    size_t depth = _levels.size() - 1 - level;
+    auto result = static_cast<uint32_t>(std::ceil(_k * std::pow(capacityDecay, depth)));
+    return std::max(result, minCapacity);
+}
+
+size_t
+QuantileSketch::size() const
+{
+    size_t result = 0;
+    for (const auto &level : _levels) {
+        result += level.size();
+    }
+    return result;
+}
+
+size_t
+QuantileSketch::totalCapacity() const
+{
+    size_t result = 0;
+    for (size_t level = 0; level < _levels.size(); ++level) {
+        result += capacity(level);
+    }
+    return result;
+}
+
+void
+QuantileSketch::compactLevel(size_t level)
+{
+    if (level + 1 == _levels.size()) {
+        _levels.emplace_back();
+        _oddOffset.push_back(false);
+    }
+    Level &values = _levels[level];
+    std::sort(values.begin(), values.end());
+    // an odd value out stays at this level
+    size_t end = values.size() & ~size_t(1);
+    size_t offset = _oddOffset[level] ? 1 : 0;
+    _oddOffset[level] = !_oddOffset[level];
+    Level &next = _levels[level + 1];
+    for (size_t i = offset; i < end; i += 2) {
+        next.push_back(values[i]);
+    }
+    values.erase(values.begin(), values.begin() + end);
+}
+
+void
+QuantileSketch::compress()
+{
+    while (size() > totalCapacity()) {
+        for (size_t level = 0; level < _levels.size(); ++level) {
+            if (_levels[level].size() >= capacity(level)) {
+                compactLevel(level);
+                break;
+            }
+        }
+    }
+}
+
+void
+QuantileSketch::add(double value)
+{
+    _levels[0].push_back(value);
+    ++_count;
+    if (_levels[0].size() >= capacity(0)) {
+        compress();
+    }
+}
+
+void
+QuantileSketch::merge(const QuantileSketch &other)
+{
+    while (_levels.size() < other._levels.size()) {
+        _levels.emplace_back();
+        _oddOffset.push_back(false);
+    }
+    for (size_t level = 0; level < other._levels.size(); ++level) {
+        const Level &values = other._levels[level];
+        _levels[level].insert(_levels[level].end(), values.begin(), values.end());
+    }
+    _count += other._count;
+    compress();
+}
+
+void
+QuantileSketch::clear()
+{
+    _count = 0;
+    _levels.assign(1, Level());
+    _oddOffset.assign(1, false);
+}
+
+double
+QuantileSketch::quantile(double q) const
+{
+    std::vector<std::pair<double, uint64_t>> weighted;
+    weighted.reserve(size());
+    uint64_t totalWeight = 0;
+    for (size_t level = 0; level < _levels.size(); ++level) {
+        uint64_t weight = uint64_t(1) << level;
+        for (double value : _levels[level]) {
+            weighted.emplace_back(value, weight);
+            totalWeight += weight;
+        }
+    }
+    if (weighted.empty()) {
+        return 0.0;
+    }
+    std::sort(weighted.begin(), weighted.end());
+    double target = std::clamp(q, 0.0, 1.0) * totalWeight;
+    uint64_t acc = 0;
+    for (const auto &entry : weighted) {
+        acc += entry.second;
+        if (acc >= target) {
+            return entry.first;
+        }
+    }
+    return weighted.back().first;
+}
+
+void
+QuantileSketch::serialize(vespalib::Serializer &os) const
+{
+    os << _k << _count << static_cast<uint32_t>(_levels.size());
+    for (size_t level = 0; level < _levels.size(); ++level) {
+        os << static_cast<uint8_t>(_oddOffset[level] ? 1 : 0) << static_cast<uint32_t>(_levels[level].size());
+        for (double value : _levels[level]) {
+            os << value;
+        }
+    }
+}
+
+void
+QuantileSketch::deserialize(vespalib::Deserializer &is)
+{
+    uint32_t numLevels = 0;
+    is >> _k >> _count >> numLevels;
+    _levels.assign(std::max(numLevels, 1u), Level());
+    _oddOffset.assign(_levels.size(), false);
+    for (size_t level = 0; level < numLevels; ++level) {
+        uint8_t oddOffset = 0;
+        uint32_t numValues = 0;
+        is >> oddOffset >> numValues;
+        _oddOffset[level] = (oddOffset != 0);
+        Level &values = _levels[level];
+        values.resize(numValues);
+        for (double &value : values) {
+            is >> value;
+        }
+    }
+}
+
+}  // namespace search
@@ -0,0 +1,64 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <vespa/vespalib/objects/deserializer.h>
+#include <vespa/vespalib/objects/serializer.h>
+#include <cstdint>
+#include <vector>
+
+namespace search {
+
+/**
+ * Mergeable sketch used to estimate quantiles of a stream of values
+ * (KLL sketch). Values are kept in a hierarchy of compactors, where a
+ * value at level h represents 2^h observed values. When the sketch is
+ * full, the lowest full level is sorted and every other value is
+ * promoted to the next level. The size of the sketch is bounded by
+ * about 3 * k values regardless of the number of observed values, and
+ * the rank error of estimated quantiles is roughly proportional to 1/k.
+ *
+ * Compaction alternates between keeping odd and even positions
+ * instead of flipping a coin, which keeps results deterministic.
+ */
+class QuantileSketch {
+public:
+    static constexpr uint32_t DEFAULT_K = 200;
+
+private:
+    using Level = std::vector<double>;
+
+    uint32_t           _k;
+    uint64_t           _count;
+    std::vector<Level> _levels;
+    std::vector<bool>  _oddOffset; // next compaction offset per level
+
+    uint32_t capacity(size_t level) const;
+    size_t size() const;
+    size_t totalCapacity() const;
+    void compactLevel(size_t level);
+    void compress();
+
+public:
+    explicit QuantileSketch(uint32_t k = DEFAULT_K);
+    ~QuantileSketch();
+
+    void add(double value);
+    void merge(const QuantileSketch &other);
+    void clear();
+
+    /**
+     * Returns the estimated q-quantile (0 <= q <= 1) of the observed
+     * values, or 0 if no values have been observed.
+     */
+    double quantile(double q) const;
+
+    uint64_t getCount() const { return _count; }
+    uint32_t getK() const { return _k; }
+    size_t getNumRetained() const { return size(); }
+
+    void serialize(vespalib::Serializer &os) const;
+    void deserialize(vespalib::Deserializer &is);
+};
+
+}  // namespace search
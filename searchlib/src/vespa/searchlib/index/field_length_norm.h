@@ -0,0 +1,46 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <cstdint>
+
+namespace search::index {
+
+/**
+ * Quantization of field lengths into a single byte per document.
+ *
+ * Field lengths below 32 are stored exactly. Larger field lengths
+ * keep their 5 most significant bits, giving a relative error below
+ * 1/16. Field lengths that are too large to be represented are
+ * stored as the largest representable value (507904). Decoding
+ * returns the smallest field length having the given code.
+ */
+class FieldLengthNorm {
+    static constexpr uint32_t exact_limit = 16;
+    static constexpr uint32_t mantissa_bits = 4;
+
+    static uint32_t msb(uint32_t value) { return 31 - __builtin_clz(value); }
+
+public:
+    static constexpr uint8_t max_code = 255;
+
+    static uint8_t encode(uint32_t field_length) {
+        if (field_length < exact_limit) {
+            return field_length;
+        }
+        uint32_t shift = msb(field_length) - mantissa_bits;
+        uint32_t code = exact_limit + (shift << mantissa_bits) + ((field_length >> shift) & (exact_limit - 1));
+        return (code < max_code) ? code : max_code;
+    }
+
+    static uint32_t decode(uint8_t code) {
+        if (code < exact_limit) {
+            return code;
+        }
+        uint32_t shift = (code - exact_limit) >> mantissa_bits;
+        uint32_t mantissa = (code - exact_limit) & (exact_limit - 1);
+        return (exact_limit + mantissa) << shift;
+    }
+};
+
+}
@@ -2,6 +2,7 @@
 #pragma once
 
 #include <vespa/vespalib/stllike/string.h>
+#include <memory>
 
 namespace search::index {
 
@@ -30,6 +31,14 @@ public:
     virtual void startWord(vespalib::stringref word) = 0;
     virtual void endWord() = 0;
     virtual void add_document(const DocIdAndFeatures &features) = 0;
+
+    /**
+     * Returns a builder for a single field that can be used concurrently
+     * with the builders for other fields, or nullptr if this is not
+     * supported. The returned builder must be used as this builder for
+     * the given field, and all fields must be built if any are.
+     */
+    virtual std::unique_ptr<IndexBuilder> startFieldBuilder(uint32_t fieldId);
 };
 
 }
@@ -49,6 +49,7 @@ DocumentInverter::DocumentInverter(const Schema &schema,
       _dataType(nullptr),
       _schemaIndexFields(),
       _inverters(),
+      _shardInverters(),
       _urlInverters(),
       _invertThreads(invertThreads),
       _pushThreads(pushThreads)
@@ -62,6 +63,16 @@ DocumentInverter::DocumentInverter(const Schema &schema,
         auto &calculator(fieldIndexes.get_calculator(fieldId));
         _inverters.push_back(std::make_unique<FieldInverter>(_schema, fieldId, remover, inserter, calculator));
     }
+    _shardInverters.resize(_inverters.size());
+    uint32_t shards = numShards(_invertThreads.getNumExecutors(), _schemaIndexFields._textFields.size());
+    for (uint32_t fieldId : _schemaIndexFields._textFields) {
+        auto &remover(fieldIndexes.get_remover(fieldId));
+        auto &inserter(fieldIndexes.get_inserter(fieldId));
+        auto &calculator(fieldIndexes.get_calculator(fieldId));
+        for (uint32_t shard = 1; shard < shards; ++shard) {
+            _shardInverters[fieldId].push_back(std::make_unique<FieldInverter>(_schema, fieldId, remover, inserter, calculator));
+        }
+    }
     for (auto &urlField : _schemaIndexFields._uriFields) {
         Schema::CollectionType collectionType =
             _schema.getIndexField(urlField._all).getCollectionType();
@@ -84,6 +95,16 @@ DocumentInverter::~DocumentInverter()
     _pushThreads.sync();
 }
 
+uint32_t
+DocumentInverter::numShards(uint32_t numInvertThreads, uint32_t numTextFields)
+{
+    constexpr uint32_t max_shards = 8;
+    if (numTextFields == 0) {
+        return 1;
+    }
+    return std::max(1u, std::min(max_shards, numInvertThreads / numTextFields));
+}
+
 void
 DocumentInverter::addFieldPath(const document::DocumentType &docType,
                                uint32_t fieldId)
@@ -132,8 +153,8 @@ DocumentInverter::invertDocument(uint32_t docId, const Document &doc)
             // FieldValue::UP fv = doc.getNestedFieldValue(fieldPath.begin(), fieldPath.end());
             fv = doc.getValue(*fieldPath);
         }
-        FieldInverter *inverter = _inverters[fieldId].get();
-        _invertThreads.execute(fieldId,
+        FieldInverter *inverter = getInverter(fieldId, docId);
+        _invertThreads.execute(getComponentId(fieldId, docId),
                                [inverter, docId, fv(std::move(fv))]()
                                { inverter->invertField(docId, fv); });
     }
@@ -159,8 +180,8 @@ void
 DocumentInverter::removeDocument(uint32_t docId)
 {
     for (uint32_t fieldId : _schemaIndexFields._textFields) {
-        FieldInverter *inverter = _inverters[fieldId].get();
-        _invertThreads.execute(fieldId,
+        FieldInverter *inverter = getInverter(fieldId, docId);
+        _invertThreads.execute(getComponentId(fieldId, docId),
                                [inverter, docId]()
                                { inverter->removeDocument(docId); });
     }
@@ -180,11 +201,17 @@ DocumentInverter::pushDocuments(const std::shared_ptr<IDestructorCallback> &onWr
 {
     uint32_t fieldId = 0;
     for (auto &inverter : _inverters) {
+        const auto &shards = _shardInverters[fieldId];
         _pushThreads.execute(fieldId,
                              [inverter(inverter.get()),
+                              &shards,
                               onWriteDone]()
                              {   inverter->applyRemoves();
-                                 inverter->pushDocuments(); });
+                                 inverter->pushDocuments();
+                                 for (auto &shard : shards) {
+                                     shard->applyRemoves();
+                                     shard->pushDocuments();
+                                 } });
         ++fieldId;
     }
 }
@@ -31,6 +31,10 @@ class IFieldIndexCollection;
  * Class used to invert the fields for a set of documents, preparing for pushing changes info field indexes.
  *
  * Each text and uri field in the document is handled separately by a FieldInverter and UrlFieldInverter.
+ *
+ * When the 'invert threads' executor has more threads than there are text fields, each text field
+ * is split into several shards (by docId), each with its own FieldInverter and invert thread.
+ * The shards of a field are pushed to the field index one after another by the same push thread.
  */
 class DocumentInverter {
 private:
@@ -53,12 +57,26 @@ private:
     index::SchemaIndexFields  _schemaIndexFields;
 
     std::vector<std::unique_ptr<FieldInverter>> _inverters;
+    // inverters for the shards (except the first one) of each field
+    std::vector<std::vector<std::unique_ptr<FieldInverter>>> _shardInverters;
     std::vector<std::unique_ptr<UrlFieldInverter>> _urlInverters;
     ISequencedTaskExecutor &_invertThreads;
     ISequencedTaskExecutor &_pushThreads;
 
     const index::Schema &getSchema() const { return _schema; }
 
+    FieldInverter *getInverter(uint32_t fieldId, uint32_t docId) const {
+        const auto &shards = _shardInverters[fieldId];
+        uint32_t shard = shards.empty() ? 0u : (docId % (shards.size() + 1));
+        return (shard == 0) ? _inverters[fieldId].get() : shards[shard - 1].get();
+    }
+
+    uint64_t getComponentId(uint32_t fieldId, uint32_t docId) const {
+        const auto &shards = _shardInverters[fieldId];
+        uint32_t shard = shards.empty() ? 0u : (docId % (shards.size() + 1));
+        return static_cast<uint64_t>(shard) * _inverters.size() + fieldId;
+    }
+
 public:
     /**
      * Create a new document inverter based on the given schema.
@@ -75,6 +93,11 @@ public:
 
     ~DocumentInverter();
 
+    /**
+     * Returns the number of shards a text field is split into, based on the number of invert threads.
+     */
+    static uint32_t numShards(uint32_t numInvertThreads, uint32_t numTextFields);
+
     /**
      * Push the current batch of inverted documents to corresponding field indexes.
      *
@@ -43,8 +43,9 @@ FieldIndex<interleaved_features>::FieldIndex(const index::Schema& schema, uint32
 
 template <bool interleaved_features>
 FieldIndex<interleaved_features>::FieldIndex(const index::Schema& schema, uint32_t fieldId,
-                                             const index::FieldLengthInfo& info)
-    : FieldIndexBase(schema, fieldId, info),
+                                             const index::FieldLengthInfo& info,
+                                             std::shared_ptr<WordStore> sharedWordStore)
+    : FieldIndexBase(schema, fieldId, info, std::move(sharedWordStore)),
       _postingListStore()
 {
     using InserterType = OrderedFieldIndexInserter<interleaved_features>;
@@ -212,11 +213,15 @@ vespalib::MemoryUsage
 FieldIndex<interleaved_features>::getMemoryUsage() const
 {
     vespalib::MemoryUsage usage;
-    usage.merge(_wordStore.getMemoryUsage());
+    if (!_wordStore.isShared()) {
+        // a shared word store is accounted for by the field index collection
+        usage.merge(_wordStore.getMemoryUsage());
+    }
     usage.merge(_dict.getMemoryUsage());
     usage.merge(_postingListStore.getMemoryUsage());
     usage.merge(_featureStore.getMemoryUsage());
     usage.merge(_remover.getStore().getMemoryUsage());
+    usage.merge(_field_length_norms.getMemoryUsage());
     return usage;
 }
 
@@ -227,7 +232,7 @@ FieldIndex<interleaved_features>::make_search_iterator(const vespalib::string& t
                                                        const fef::TermFieldMatchDataArray& match_data) const
 {
     return search::memoryindex::make_search_iterator<interleaved_features>
-            (find(term), getFeatureStore(), field_id, match_data);
+            (find(term), getFeatureStore(), field_id, match_data, &get_field_length_norms());
 }
 
 namespace {
@@ -240,6 +245,7 @@ private:
     GenerationHandler::Guard _guard;
     PostingListIteratorType _posting_itr;
     const FeatureStore& _feature_store;
+    const FieldLengthNorms& _field_length_norms;
     const uint32_t _field_id;
     const bool _use_bit_vector;
 
@@ -247,6 +253,7 @@ public:
     MemoryTermBlueprint(GenerationHandler::Guard&& guard,
                         PostingListIteratorType posting_itr,
                         const FeatureStore& feature_store,
+                        const FieldLengthNorms& field_length_norms,
                         const FieldSpecBase& field,
                         uint32_t field_id,
                         bool use_bit_vector)
@@ -254,6 +261,7 @@ public:
           _guard(),
           _posting_itr(posting_itr),
           _feature_store(feature_store),
+          _field_length_norms(field_length_norms),
           _field_id(field_id),
           _use_bit_vector(use_bit_vector)
     {
@@ -263,7 +271,8 @@ public:
     }
 
     SearchIterator::UP createLeafSearch(const TermFieldMatchDataArray& tfmda, bool) const override {
-        auto result = make_search_iterator<interleaved_features>(_posting_itr, _feature_store, _field_id, tfmda);
+        auto result = make_search_iterator<interleaved_features>(_posting_itr, _feature_store, _field_id, tfmda,
+                                                                 &_field_length_norms);
         if (_use_bit_vector) {
             LOG(debug, "Return BooleanMatchIteratorWrapper: field_id(%u), doc_count(%zu)",
                 _field_id, _posting_itr.size());
@@ -277,7 +286,8 @@ public:
     SearchIterator::UP createFilterSearch(bool, FilterConstraint) const override {
         auto wrapper = std::make_unique<queryeval::FilterWrapper>(getState().numFields());
         auto & tfmda = wrapper->tfmda();
-        wrapper->wrap(make_search_iterator<interleaved_features>(_posting_itr, _feature_store, _field_id, tfmda));
+        wrapper->wrap(make_search_iterator<interleaved_features>(_posting_itr, _feature_store, _field_id, tfmda,
+                                                                 &_field_length_norms));
         return wrapper;
     }
 };
@@ -294,7 +304,7 @@ FieldIndex<interleaved_features>::make_term_blueprint(const vespalib::string& te
     auto posting_itr = findFrozen(term);
     bool use_bit_vector = field.isFilter();
     return std::make_unique<MemoryTermBlueprint<interleaved_features>>
-            (std::move(guard), posting_itr, getFeatureStore(), field, field_id, use_bit_vector);
+            (std::move(guard), posting_itr, getFeatureStore(), get_field_length_norms(), field, field_id, use_bit_vector);
 }
 
 template class FieldIndex<false>;
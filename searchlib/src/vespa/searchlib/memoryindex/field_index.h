@@ -58,6 +58,7 @@ private:
         _postingListStore.trimHoldLists(usedGen);
         _dict.getAllocator().trimHoldLists(usedGen);
         _featureStore.trimHoldLists(usedGen);
+        _field_length_norms.trimHoldLists(usedGen);
     }
 
     void transferHoldLists() {
@@ -66,6 +67,7 @@ private:
         _postingListStore.transferHoldLists(generation);
         _dict.getAllocator().transferHoldLists(generation);
         _featureStore.transferHoldLists(generation);
+        _field_length_norms.transferHoldLists(generation);
     }
 
     void incGeneration() {
@@ -74,7 +76,8 @@ private:
 
 public:
     FieldIndex(const index::Schema& schema, uint32_t fieldId);
-    FieldIndex(const index::Schema& schema, uint32_t fieldId, const index::FieldLengthInfo& info);
+    FieldIndex(const index::Schema& schema, uint32_t fieldId, const index::FieldLengthInfo& info,
+               std::shared_ptr<WordStore> sharedWordStore = std::shared_ptr<WordStore>());
     ~FieldIndex();
 
     typename PostingList::Iterator find(const vespalib::stringref word) const;
@@ -19,8 +19,10 @@ FieldIndexBase::FieldIndexBase(const index::Schema& schema, uint32_t fieldId)
 }
 
 FieldIndexBase::FieldIndexBase(const index::Schema& schema, uint32_t fieldId,
-                               const index::FieldLengthInfo& info)
-    : _wordStore(),
+                               const index::FieldLengthInfo& info,
+                               std::shared_ptr<WordStore> sharedWordStore)
+    : _wordStorePtr(sharedWordStore ? std::move(sharedWordStore) : std::make_shared<WordStore>()),
+      _wordStore(*_wordStorePtr),
       _numUniqueWords(0),
       _generationHandler(),
       _dict(),
@@ -28,7 +30,8 @@ FieldIndexBase::FieldIndexBase(const index::Schema& schema, uint32_t fieldId,
       _fieldId(fieldId),
       _remover(_wordStore),
       _inserter(),
-      _calculator(info)
+      _calculator(info),
+      _field_length_norms()
 {
 }
 
@@ -4,6 +4,7 @@
 
 #include "feature_store.h"
 #include "field_index_remover.h"
+#include "field_length_norms.h"
 #include "i_field_index.h"
 #include "word_store.h"
 #include <vespa/searchlib/index/docidandfeatures.h>
@@ -73,7 +74,8 @@ public:
 protected:
     using GenerationHandler = vespalib::GenerationHandler;
 
-    WordStore               _wordStore;
+    std::shared_ptr<WordStore> _wordStorePtr;
+    WordStore&              _wordStore;
     uint64_t                _numUniqueWords;
     GenerationHandler       _generationHandler;
     DictionaryTree          _dict;
@@ -82,6 +84,7 @@ protected:
     FieldIndexRemover       _remover;
     std::unique_ptr<IOrderedFieldIndexInserter> _inserter;
     index::FieldLengthCalculator _calculator;
+    FieldLengthNorms        _field_length_norms;
 
     void incGeneration() {
         _generationHandler.incGeneration();
@@ -98,7 +101,12 @@ public:
     }
 
     FieldIndexBase(const index::Schema& schema, uint32_t fieldId);
-    FieldIndexBase(const index::Schema& schema, uint32_t fieldId, const index::FieldLengthInfo& info);
+    /**
+     * The given shared word store is used instead of a word store owned
+     * by this field index, if present.
+     */
+    FieldIndexBase(const index::Schema& schema, uint32_t fieldId, const index::FieldLengthInfo& info,
+                   std::shared_ptr<WordStore> sharedWordStore = std::shared_ptr<WordStore>());
     ~FieldIndexBase();
 
     uint64_t getNumUniqueWords() const override { return _numUniqueWords; }
@@ -106,6 +114,8 @@ public:
     const WordStore& getWordStore() const override { return _wordStore; }
     IOrderedFieldIndexInserter& getInserter() override { return *_inserter; }
     index::FieldLengthCalculator& get_calculator() override { return _calculator; }
+    const FieldLengthNorms& get_field_length_norms() const { return _field_length_norms; }
+    void set_field_length(uint32_t docId, uint32_t field_length) { _field_length_norms.set(docId, field_length); }
 
     GenerationHandler::Guard takeGenerationGuard() override {
         return _generationHandler.takeGuard();
@@ -12,8 +12,12 @@
 #include <vespa/vespalib/btree/btreenodestore.hpp>
 #include <vespa/vespalib/btree/btreeroot.hpp>
 #include <vespa/vespalib/btree/btreestore.hpp>
+#include <vespa/vespalib/util/count_down_latch.h>
+#include <vespa/vespalib/util/executor.h>
+#include <vespa/vespalib/util/lambdatask.h>
 #include <vespa/vespalib/util/exceptions.h>
 #include <vespa/vespalib/util/stringfmt.h>
+#include <algorithm>
 
 #include <vespa/log/log.h>
 LOG_SETUP(".searchlib.memoryindex.field_index_collection");
@@ -28,18 +32,22 @@ using index::WordDocElementFeatures;
 
 namespace memoryindex {
 
-FieldIndexCollection::FieldIndexCollection(const Schema& schema, const IFieldLengthInspector& inspector)
-    : _fieldIndexes(),
+FieldIndexCollection::FieldIndexCollection(const Schema& schema, const IFieldLengthInspector& inspector,
+                                           bool shareWordStore)
+    : _sharedWordStore(shareWordStore ? std::make_shared<WordStore>(true) : std::shared_ptr<WordStore>()),
+      _fieldIndexes(),
       _numFields(schema.getNumIndexFields())
 {
     for (uint32_t fieldId = 0; fieldId < _numFields; ++fieldId) {
         const auto& field = schema.getIndexField(fieldId);
         if (field.use_interleaved_features()) {
             _fieldIndexes.push_back(std::make_unique<FieldIndex<true>>(schema, fieldId,
-                                                                       inspector.get_field_length_info(field.getName())));
+                                                                       inspector.get_field_length_info(field.getName()),
+                                                                       _sharedWordStore));
         } else {
             _fieldIndexes.push_back(std::make_unique<FieldIndex<false>>(schema, fieldId,
-                                                                        inspector.get_field_length_info(field.getName())));
+                                                                        inspector.get_field_length_info(field.getName()),
+                                                                        _sharedWordStore));
         }
     }
 }
@@ -49,8 +57,23 @@ FieldIndexCollection::~FieldIndexCollection()
 }
 
 void
-FieldIndexCollection::dump(search::index::IndexBuilder &indexBuilder)
+FieldIndexCollection::dump(search::index::IndexBuilder &indexBuilder, vespalib::Executor *executor)
 {
+    std::vector<std::unique_ptr<search::index::IndexBuilder>> fieldBuilders;
+    if (executor != nullptr && _numFields > 1) {
+        for (uint32_t fieldId = 0; fieldId < _numFields; ++fieldId) {
+            auto fieldBuilder = indexBuilder.startFieldBuilder(fieldId);
+            if (!fieldBuilder) {
+                fieldBuilders.clear();
+                break;
+            }
+            fieldBuilders.push_back(std::move(fieldBuilder));
+        }
+    }
+    if (!fieldBuilders.empty()) {
+        dumpParallel(fieldBuilders, *executor);
+        return;
+    }
     for (uint32_t fieldId = 0; fieldId < _numFields; ++fieldId) {
         indexBuilder.startField(fieldId);
         _fieldIndexes[fieldId]->dump(indexBuilder);
@@ -58,10 +81,42 @@ FieldIndexCollection::dump(search::index::IndexBuilder &indexBuilder)
     }
 }
 
+void
+FieldIndexCollection::dumpParallel(std::vector<std::unique_ptr<search::index::IndexBuilder>> &fieldBuilders,
+                                   vespalib::Executor &executor)
+{
+    // dump the largest fields first, so a dominant field is not started last
+    std::vector<std::pair<size_t, uint32_t>> fields;
+    for (uint32_t fieldId = 0; fieldId < _numFields; ++fieldId) {
+        fields.emplace_back(_fieldIndexes[fieldId]->getMemoryUsage().usedBytes(), fieldId);
+    }
+    std::stable_sort(fields.begin(), fields.end(),
+                     [](const auto &lhs, const auto &rhs) { return lhs.first > rhs.first; });
+    vespalib::CountDownLatch latch(_numFields);
+    for (const auto &field : fields) {
+        search::index::IndexBuilder *fieldBuilder = fieldBuilders[field.second].get();
+        IFieldIndex *fieldIndex = _fieldIndexes[field.second].get();
+        auto task = vespalib::makeLambdaTask([fieldBuilder, fieldIndex, fieldId = field.second, &latch]() {
+            fieldBuilder->startField(fieldId);
+            fieldIndex->dump(*fieldBuilder);
+            fieldBuilder->endField();
+            latch.countDown();
+        });
+        auto rejected = executor.execute(std::move(task));
+        if (rejected) {
+            rejected->run();
+        }
+    }
+    latch.await();
+}
+
 vespalib::MemoryUsage
 FieldIndexCollection::getMemoryUsage() const
 {
     vespalib::MemoryUsage usage;
+    if (_sharedWordStore) {
+        usage.merge(_sharedWordStore->getMemoryUsage());
+    }
     for (auto &fieldIndex : _fieldIndexes) {
         usage.merge(fieldIndex->getMemoryUsage());
     }
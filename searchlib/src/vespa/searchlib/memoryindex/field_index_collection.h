@@ -12,6 +12,8 @@ namespace search::index {
     class Schema;
 }
 
+namespace vespalib { class Executor; }
+
 namespace search::memoryindex {
 
 class IFieldIndexRemoveListener;
@@ -27,11 +29,20 @@ class FieldIndexCollection : public IFieldIndexCollection {
 private:
     using GenerationHandler = vespalib::GenerationHandler;
 
+    std::shared_ptr<WordStore> _sharedWordStore;
     std::vector<std::unique_ptr<IFieldIndex>> _fieldIndexes;
     uint32_t                _numFields;
 
+    void dumpParallel(std::vector<std::unique_ptr<search::index::IndexBuilder>> &fieldBuilders,
+                      vespalib::Executor &executor);
+
 public:
-    FieldIndexCollection(const index::Schema& schema, const index::IFieldLengthInspector& inspector);
+    /**
+     * When shareWordStore is set, the words of all fields are stored
+     * once in a common word store instead of once per field.
+     */
+    FieldIndexCollection(const index::Schema& schema, const index::IFieldLengthInspector& inspector,
+                         bool shareWordStore = false);
     ~FieldIndexCollection();
 
     uint64_t getNumUniqueWords() const {
@@ -42,7 +53,12 @@ public:
         return numUniqueWords;
     }
 
-    void dump(search::index::IndexBuilder & indexBuilder);
+    /**
+     * Dump all fields into the given index builder. When an executor is
+     * given and the builder supports it, the fields are dumped in
+     * parallel, starting with the largest ones.
+     */
+    void dump(search::index::IndexBuilder & indexBuilder, vespalib::Executor *executor = nullptr);
 
     vespalib::MemoryUsage getMemoryUsage() const;
 
@@ -169,6 +169,7 @@ FieldInverter::reset()
     _pendingDocs.clear();
     _abortedDocs.clear();
     _removeDocs.clear();
+    _fieldLengths.clear();
     _oldPosSize = 0u;
 }
 
@@ -294,7 +295,7 @@ FieldInverter::endDoc()
             ++itr;
         }
     }
-    _calculator.add_field_length(field_length);
+    _fieldLengths.push_back(field_length);
     uint32_t newPosSize = static_cast<uint32_t>(_positions.size());
     _pendingDocs.insert({ _docId,
                              { _oldPosSize, newPosSize - _oldPosSize } });
@@ -361,6 +362,7 @@ FieldInverter::FieldInverter(const Schema &schema, uint32_t fieldId,
       _abortedDocs(),
       _pendingDocs(),
       _removeDocs(),
+      _fieldLengths(),
       _remover(remover),
       _inserter(inserter),
       _calculator(calculator)
@@ -502,6 +504,9 @@ FieldInverter::applyRemoves()
 void
 FieldInverter::pushDocuments()
 {
+    for (auto field_length : _fieldLengths) {
+        _calculator.add_field_length(field_length);
+    }
     trimAbortedDocs();
 
     if (_positions.empty()) {
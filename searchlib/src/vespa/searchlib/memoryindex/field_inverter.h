@@ -186,6 +186,8 @@ private:
     std::vector<PositionRange>        _abortedDocs;
     std::map<uint32_t, PositionRange> _pendingDocs;
     UInt32Vector                      _removeDocs;
+    // field lengths of inverted documents, added to the calculator when pushing
+    UInt32Vector                      _fieldLengths;
 
     FieldIndexRemover                &_remover;
     IOrderedFieldIndexInserter       &_inserter;
@@ -0,0 +1,26 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "field_length_norms.h"
+
+namespace search::memoryindex {
+
+FieldLengthNorms::FieldLengthNorms()
+    : _genHolder(),
+      _norms(vespalib::GrowStrategy(1024, 0.5, 0), _genHolder)
+{
+}
+
+FieldLengthNorms::~FieldLengthNorms()
+{
+    _genHolder.clearHoldLists();
+}
+
+vespalib::MemoryUsage
+FieldLengthNorms::getMemoryUsage() const
+{
+    vespalib::MemoryUsage usage = _norms.getMemoryUsage();
+    usage.mergeGenerationHeldBytes(_genHolder.getHeldBytes());
+    return usage;
+}
+
+}
@@ -0,0 +1,50 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <vespa/searchlib/index/field_length_norm.h>
+#include <vespa/vespalib/util/generationhandler.h>
+#include <vespa/vespalib/util/memoryusage.h>
+#include <vespa/vespalib/util/rcuvector.h>
+
+namespace search::memoryindex {
+
+/**
+ * Field length of each document in a memory field index, quantized to
+ * a single byte per document (see index::FieldLengthNorm).
+ *
+ * Field lengths are set by the push thread while inserting features
+ * and become visible to readers when the field index is committed.
+ * Replaced vectors are kept alive until no reader can observe them,
+ * using the generation handler of the field index.
+ */
+class FieldLengthNorms {
+private:
+    using generation_t = vespalib::GenerationHandler::generation_t;
+
+    vespalib::GenerationHolder       _genHolder;
+    vespalib::RcuVectorBase<uint8_t> _norms;
+
+public:
+    FieldLengthNorms();
+    ~FieldLengthNorms();
+
+    void set(uint32_t docId, uint32_t field_length) {
+        _norms.ensure_size(docId + 1);
+        _norms[docId] = index::FieldLengthNorm::encode(field_length);
+    }
+
+    /**
+     * Returns the (approximate) field length of the given document,
+     * or 0 if unknown.
+     */
+    uint32_t get(uint32_t docId) const {
+        return (docId < _norms.size()) ? index::FieldLengthNorm::decode(_norms[docId]) : 0;
+    }
+
+    void transferHoldLists(generation_t generation) { _genHolder.transferHoldLists(generation); }
+    void trimHoldLists(generation_t usedGen) { _genHolder.trimHoldLists(usedGen); }
+    vespalib::MemoryUsage getMemoryUsage() const;
+};
+
+}
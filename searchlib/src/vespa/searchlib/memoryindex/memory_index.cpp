@@ -129,9 +129,9 @@ MemoryIndex::freeze()
 }
 
 void
-MemoryIndex::dump(IndexBuilder &indexBuilder)
+MemoryIndex::dump(IndexBuilder &indexBuilder, vespalib::Executor *executor)
 {
-    _fieldIndexes->dump(indexBuilder);
+    _fieldIndexes->dump(indexBuilder, executor);
 }
 
 namespace {
@@ -14,7 +14,10 @@ namespace search::index {
     class IndexBuilder;
 }
 
-namespace vespalib { class ISequencedTaskExecutor; }
+namespace vespalib {
+    class Executor;
+    class ISequencedTaskExecutor;
+}
 
 namespace document { class Document; }
 
@@ -137,8 +140,10 @@ public:
 
     /**
      * Dump the contents of this index into the given index builder.
+     * Fields are dumped in parallel using the given executor when the
+     * index builder supports it.
      */
-    void dump(index::IndexBuilder &indexBuilder);
+    void dump(index::IndexBuilder &indexBuilder, vespalib::Executor *executor = nullptr);
 
     // Implements Searchable
     queryeval::Blueprint::UP createBlueprint(const queryeval::IRequestContext & requestContext,
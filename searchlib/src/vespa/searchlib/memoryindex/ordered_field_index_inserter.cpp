@@ -120,6 +120,7 @@ OrderedFieldIndexInserter<interleaved_features>::add(uint32_t docId,
     assert(_prevDocId == noDocId || _prevDocId < docId ||
            (_prevDocId == docId && !_prevAdd));
     vespalib::datastore::EntryRef featureRef = _fieldIndex.addFeatures(features);
+    _fieldIndex.set_field_length(docId, features.field_length());
     _adds.push_back(PostingListKeyDataType(docId, PostingListEntryType(featureRef,
                                                                        cap_u16(features.num_occs()),
                                                                        cap_u16(features.field_length()))));
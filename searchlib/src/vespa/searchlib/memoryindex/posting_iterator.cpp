@@ -9,6 +9,8 @@
 #include <vespa/vespalib/btree/btreenodestore.hpp>
 #include <vespa/vespalib/btree/btreeroot.hpp>
 #include <vespa/vespalib/btree/btreestore.hpp>
+#include <algorithm>
+#include <limits>
 
 #include <vespa/log/log.h>
 LOG_SETUP(".searchlib.memoryindex.posting_iterator");
@@ -28,12 +30,14 @@ protected:
     PostingListIteratorType _itr;
     const FeatureStore& _feature_store;
     FeatureStore::DecodeContextCooked _feature_decoder;
+    const FieldLengthNorms* _field_length_norms;
 
 public:
     PostingIteratorBase(PostingListIteratorType itr,
                         const FeatureStore& feature_store,
                         uint32_t field_id,
-                        const fef::TermFieldMatchDataArray& match_data);
+                        const fef::TermFieldMatchDataArray& match_data,
+                        const FieldLengthNorms* field_length_norms);
     ~PostingIteratorBase();
 
     void doSeek(uint32_t docId) override;
@@ -45,11 +49,13 @@ template <bool interleaved_features>
 PostingIteratorBase<interleaved_features>::PostingIteratorBase(PostingListIteratorType itr,
                                                                const FeatureStore& feature_store,
                                                                uint32_t field_id,
-                                                               const fef::TermFieldMatchDataArray& match_data) :
+                                                               const fef::TermFieldMatchDataArray& match_data,
+                                                               const FieldLengthNorms* field_length_norms) :
     queryeval::RankedSearchIteratorBase(match_data),
     _itr(itr),
     _feature_store(feature_store),
-    _feature_decoder(nullptr)
+    _feature_decoder(nullptr),
+    _field_length_norms(field_length_norms)
 {
     _feature_store.setupForField(field_id, _feature_decoder);
 }
@@ -102,6 +108,7 @@ public:
     using ParentType::ParentType;
     using ParentType::_feature_decoder;
     using ParentType::_feature_store;
+    using ParentType::_field_length_norms;
     using ParentType::_itr;
     using ParentType::_matchData;
     using ParentType::getDocId;
@@ -132,6 +139,10 @@ PostingIterator<interleaved_features, unpack_normal_features, unpack_interleaved
         auto* tfmd = _matchData[0];
         tfmd->setNumOccs(_itr.getData().get_num_occs());
         tfmd->setFieldLength(_itr.getData().get_field_length());
+    } else if (!interleaved_features && unpack_interleaved_features && (_field_length_norms != nullptr)) {
+        auto* tfmd = _matchData[0];
+        tfmd->setNumOccs(std::min(tfmd->size(), size_t(std::numeric_limits<uint16_t>::max())));
+        tfmd->setFieldLength(std::min(_field_length_norms->get(docId), uint32_t(std::numeric_limits<uint16_t>::max())));
     }
     setUnpacked();
 }
@@ -141,25 +152,32 @@ queryeval::SearchIterator::UP
 make_search_iterator(typename FieldIndex<interleaved_features>::PostingList::ConstIterator itr,
                      const FeatureStore& feature_store,
                      uint32_t field_id,
-                     const fef::TermFieldMatchDataArray& match_data)
+                     const fef::TermFieldMatchDataArray& match_data,
+                     const FieldLengthNorms* field_length_norms)
 {
     assert(match_data.size() == 1);
     auto* tfmd = match_data[0];
+    // Without interleaved features in the posting list, they are derived from
+    // the normal features (number of occurrences) and the field length norms.
+    if (!interleaved_features && tfmd->needs_interleaved_features() && (field_length_norms != nullptr)) {
+        return std::make_unique<PostingIterator<interleaved_features, true, true>>
+                (itr, feature_store, field_id, match_data, field_length_norms);
+    }
     if (tfmd->needs_normal_features()) {
        if (tfmd->needs_interleaved_features()) {
            return std::make_unique<PostingIterator<interleaved_features, true, true>>
-                   (itr, feature_store, field_id, match_data);
+                   (itr, feature_store, field_id, match_data, field_length_norms);
        } else {
            return std::make_unique<PostingIterator<interleaved_features, true, false>>
-                   (itr, feature_store, field_id, match_data);
+                   (itr, feature_store, field_id, match_data, field_length_norms);
        }
     } else {
         if (tfmd->needs_interleaved_features()) {
             return std::make_unique<PostingIterator<interleaved_features, false, true>>
-                    (itr, feature_store, field_id, match_data);
+                    (itr, feature_store, field_id, match_data, field_length_norms);
         } else {
             return std::make_unique<PostingIterator<interleaved_features, false, false>>
-                    (itr, feature_store, field_id, match_data);
+                    (itr, feature_store, field_id, match_data, field_length_norms);
         }
     }
 }
@@ -169,14 +187,16 @@ queryeval::SearchIterator::UP
 make_search_iterator<false>(typename FieldIndex<false>::PostingList::ConstIterator,
                             const FeatureStore&,
                             uint32_t,
-                            const fef::TermFieldMatchDataArray&);
+                            const fef::TermFieldMatchDataArray&,
+                            const FieldLengthNorms*);
 
 template
 queryeval::SearchIterator::UP
 make_search_iterator<true>(typename FieldIndex<true>::PostingList::ConstIterator,
                            const FeatureStore&,
                            uint32_t,
-                           const fef::TermFieldMatchDataArray&);
+                           const fef::TermFieldMatchDataArray&,
+                           const FieldLengthNorms*);
 
 template class PostingIteratorBase<false>;
 template class PostingIteratorBase<true>;
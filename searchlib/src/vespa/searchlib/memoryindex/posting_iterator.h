@@ -16,13 +16,16 @@ namespace search::memoryindex {
  * @param feature_store reference to store for features.
  * @param field_id      the id of the field searched.
  * @param match_data    the match data to unpack features into.
+ * @param field_length_norms per document field lengths, used to unpack interleaved
+ *                      features from posting lists without them (may be nullptr).
  */
 template <bool interleaved_features>
 queryeval::SearchIterator::UP
 make_search_iterator(typename FieldIndex<interleaved_features>::PostingList::ConstIterator itr,
                      const FeatureStore& feature_store,
                      uint32_t field_id,
-                     const fef::TermFieldMatchDataArray& match_data);
+                     const fef::TermFieldMatchDataArray& match_data,
+                     const FieldLengthNorms* field_length_norms = nullptr);
 
 }
 
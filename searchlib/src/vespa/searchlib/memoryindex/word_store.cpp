@@ -2,21 +2,53 @@
 
 #include "word_store.h"
 #include <vespa/vespalib/datastore/datastore.hpp>
+#include <vespa/vespalib/stllike/hash_fun.h>
+#include <vespa/vespalib/stllike/hash_set.hpp>
+#include <cstring>
 
 namespace search::memoryindex {
 
 constexpr size_t MIN_BUFFER_ARRAYS = 1024;
 
-WordStore::WordStore()
+size_t
+WordStore::WordHash::operator()(vespalib::datastore::EntryRef ref) const
+{
+    return (*this)(vespalib::stringref(_store->getWord(ref)));
+}
+
+size_t
+WordStore::WordHash::operator()(vespalib::stringref word) const
+{
+    return vespalib::hashValue(word.data(), word.size());
+}
+
+bool
+WordStore::WordEqual::operator()(vespalib::datastore::EntryRef lhs, vespalib::datastore::EntryRef rhs) const
+{
+    return (lhs == rhs) || (strcmp(_store->getWord(lhs), _store->getWord(rhs)) == 0);
+}
+
+bool
+WordStore::WordEqual::operator()(vespalib::datastore::EntryRef lhs, vespalib::stringref rhs) const
+{
+    return (vespalib::stringref(_store->getWord(lhs)) == rhs);
+}
+
+WordStore::WordStore(bool shared)
     : _store(),
       _numWords(0),
       _type(RefType::align(1),
             MIN_BUFFER_ARRAYS,
             RefType::offsetSize() / RefType::align(1)),
-      _typeId(0)
+      _typeId(0),
+      _words(),
+      _lock()
 {
     _store.addType(&_type);
     _store.initActiveBuffers();
+    if (shared) {
+        _words = std::make_unique<WordSet>(0, WordHash(this), WordEqual(this));
+    }
 }
 
 
@@ -27,6 +59,22 @@ WordStore::~WordStore()
 
 vespalib::datastore::EntryRef
 WordStore::addWord(const vespalib::stringref word)
+{
+    if (!_words) {
+        return appendWord(word);
+    }
+    std::lock_guard<std::mutex> guard(_lock);
+    auto itr = _words->find(word);
+    if (itr != _words->end()) {
+        return *itr;
+    }
+    auto ref = appendWord(word);
+    _words->insert(ref);
+    return ref;
+}
+
+vespalib::datastore::EntryRef
+WordStore::appendWord(const vespalib::stringref word)
 {
     size_t wordSize = word.size() + 1;
     size_t bufferSize = RefType::align(wordSize);
@@ -43,4 +91,17 @@ WordStore::addWord(const vespalib::stringref word)
     return result.ref;
 }
 
+vespalib::MemoryUsage
+WordStore::getMemoryUsage() const
+{
+    vespalib::MemoryUsage usage = _store.getMemoryUsage();
+    if (_words) {
+        std::lock_guard<std::mutex> guard(_lock);
+        size_t bytes = _words->getMemoryConsumption();
+        usage.incAllocatedBytes(bytes);
+        usage.incUsedBytes(bytes);
+    }
+    return usage;
+}
+
 }
@@ -3,33 +3,62 @@
 #pragma once
 
 #include <vespa/vespalib/datastore/datastore.h>
+#include <vespa/vespalib/stllike/hash_set.h>
 #include <vespa/vespalib/stllike/string.h>
+#include <mutex>
 
 namespace search::memoryindex {
 
+/**
+ * Store of the words in a memory index, referenced from the dictionary.
+ *
+ * A shared word store is used by the field indexes of several fields.
+ * It is safe to add words from several threads, and each unique word is
+ * only stored once.
+ */
 class WordStore {
 public:
     using DataStoreType = vespalib::datastore::DataStoreT<vespalib::datastore::AlignedEntryRefT<22, 2>>;
     using RefType = DataStoreType::RefType;
 
 private:
+    class WordHash {
+        const WordStore *_store;
+    public:
+        explicit WordHash(const WordStore *store) : _store(store) {}
+        size_t operator()(vespalib::datastore::EntryRef ref) const;
+        size_t operator()(vespalib::stringref word) const;
+    };
+    class WordEqual {
+        const WordStore *_store;
+    public:
+        explicit WordEqual(const WordStore *store) : _store(store) {}
+        bool operator()(vespalib::datastore::EntryRef lhs, vespalib::datastore::EntryRef rhs) const;
+        bool operator()(vespalib::datastore::EntryRef lhs, vespalib::stringref rhs) const;
+    };
+    using WordSet = vespalib::hash_set<vespalib::datastore::EntryRef, WordHash, WordEqual>;
+
     DataStoreType           _store;
     uint32_t                _numWords;
     vespalib::datastore::BufferType<char> _type;
     const uint32_t          _typeId;
+    // only used by a shared word store
+    std::unique_ptr<WordSet> _words;
+    mutable std::mutex      _lock;
+
+    vespalib::datastore::EntryRef appendWord(const vespalib::stringref word);
 
 public:
-    WordStore();
+    explicit WordStore(bool shared = false);
     ~WordStore();
     vespalib::datastore::EntryRef addWord(const vespalib::stringref word);
+    bool isShared() const { return bool(_words); }
     const char *getWord(vespalib::datastore::EntryRef ref) const {
         RefType internalRef(ref);
         return _store.getEntry<char>(internalRef);
     }
 
-    vespalib::MemoryUsage getMemoryUsage() const {
-        return _store.getMemoryUsage();
-    }
+    vespalib::MemoryUsage getMemoryUsage() const;
 };
 
 }
@@ -41,14 +41,18 @@ PredicateBoundsPostingList<Iterator>::PredicateBoundsPostingList(
 }
 
 namespace {
+    // Bounds are either a lower bound (bit 31 set), an upper bound
+    // (bit 30 set) or a 16 bit [begin, end) range. All three are
+    // decoded into a [low, high) range that is checked without
+    // branching on the encoding, which is unpredictable when scanning
+    // the intervals of a document.
     bool checkBounds(uint32_t bounds, uint32_t diff) {
-        if (bounds & 0x80000000) {
-            return diff >= (bounds & 0x3fffffff);
-        } else if (bounds & 0x40000000) {
-            return diff < (bounds & 0x3fffffff);
-        } else {
-            return (diff >= (bounds >> 16)) && (diff < (bounds & 0xffff));
-        }
+        uint32_t value = bounds & 0x3fffffff;
+        bool lower_only = (bounds & 0x80000000) != 0;
+        bool upper_only = (bounds & 0xc0000000) == 0x40000000;
+        uint32_t low = lower_only ? value : (upper_only ? 0 : (bounds >> 16));
+        uint64_t high = lower_only ? (uint64_t(1) << 32) : (upper_only ? value : (bounds & 0xffff));
+        return (diff >= low) & (uint64_t(diff) < high);
     }
 }  // namespace
 
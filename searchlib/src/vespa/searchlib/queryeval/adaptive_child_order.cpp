@@ -0,0 +1,55 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "adaptive_child_order.h"
+#include <algorithm>
+#include <numeric>
+
+namespace search::queryeval {
+
+AdaptiveChildOrder::AdaptiveChildOrder(size_t num_children, uint32_t num_seeks)
+    : _seeks(num_children, 0),
+      _rejects(num_children, 0),
+      _seeks_left(num_seeks),
+      _reordered(false)
+{
+}
+
+AdaptiveChildOrder::~AdaptiveChildOrder() = default;
+
+double
+AdaptiveChildOrder::reject_rate(size_t child) const
+{
+    return (_seeks[child] > 0) ? (double(_rejects[child]) / _seeks[child]) : 0.0;
+}
+
+AdaptiveChildOrder::Order
+AdaptiveChildOrder::make_order(size_t first) const
+{
+    Order order(_seeks.size());
+    std::iota(order.begin(), order.end(), 0);
+    if (first < order.size()) {
+        std::stable_sort(order.begin() + first, order.end(),
+                         [this](size_t a, size_t b) { return reject_rate(a) > reject_rate(b); });
+    }
+    return order;
+}
+
+void
+AdaptiveChildOrder::apply_order(const Order &order)
+{
+    std::vector<uint32_t> seeks;
+    std::vector<uint32_t> rejects;
+    seeks.reserve(order.size());
+    rejects.reserve(order.size());
+    for (size_t i = 0; i < order.size(); ++i) {
+        seeks.push_back(_seeks[order[i]]);
+        rejects.push_back(_rejects[order[i]]);
+        if (order[i] != i) {
+            _reordered = true;
+        }
+    }
+    _seeks = std::move(seeks);
+    _rejects = std::move(rejects);
+}
+
+}
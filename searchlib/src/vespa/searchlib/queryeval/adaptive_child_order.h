@@ -0,0 +1,53 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace search::queryeval {
+
+/**
+ * Keeps track of how often each child of an AND-like search rejects
+ * the candidates it is asked about, for a limited number of seeks.
+ * When sampling is done, the reorderable children can be sorted by
+ * decreasing rejection rate, so that children that prune the most are
+ * asked first. For ANDNOT, a negative child 'rejects' when it matches.
+ **/
+class AdaptiveChildOrder
+{
+public:
+    using Order = std::vector<size_t>;
+
+    AdaptiveChildOrder(size_t num_children, uint32_t num_seeks);
+    ~AdaptiveChildOrder();
+    bool sampling() const { return _seeks_left > 0; }
+    void record(size_t child, bool rejected) {
+        ++_seeks[child];
+        _rejects[child] += rejected ? 1 : 0;
+    }
+    // returns true when the last seek to sample was just done
+    bool seek_done() { return (--_seeks_left == 0); }
+
+    /**
+     * Children before 'first' keep their place, the rest are stably
+     * sorted by decreasing rejection rate. order[i] is the old index of
+     * the child that should be placed at index i.
+     **/
+    Order make_order(size_t first) const;
+    void apply_order(const Order &order);
+
+    const std::vector<uint32_t> &seeks() const { return _seeks; }
+    const std::vector<uint32_t> &rejects() const { return _rejects; }
+    bool reordered() const { return _reordered; }
+private:
+    double reject_rate(size_t child) const;
+
+    std::vector<uint32_t> _seeks;
+    std::vector<uint32_t> _rejects;
+    uint32_t              _seeks_left;
+    bool                  _reordered;
+};
+
+}
@@ -9,6 +9,10 @@ namespace search::queryeval {
 void
 AndNotSearch::doSeek(uint32_t docid)
 {
+    if (__builtin_expect(sampling_child_order(), false)) {
+        sampledSeek(docid);
+        return;
+    }
     const Children & children(getChildren());
     if (!children[0]->seek(docid)) {
         return; // not match in positive subtree
@@ -21,6 +25,22 @@ AndNotSearch::doSeek(uint32_t docid)
     setDocId(docid); // we have a match
 }
 
+void
+AndNotSearch::sampledSeek(uint32_t docid)
+{
+    const Children & children(getChildren());
+    bool hit = children[0]->seek(docid);
+    record_child_seek(0, !hit);
+    for (uint32_t i = 1; hit && (i < children.size()); ++i) {
+        hit = !children[i]->seek(docid);
+        record_child_seek(i, !hit);
+    }
+    if (hit) {
+        setDocId(docid);
+    }
+    sampled_seek_done();
+}
+
 void
 AndNotSearch::doUnpack(uint32_t docid)
 {
@@ -39,8 +59,13 @@ class AndNotSearchStrict : public AndNotSearchStrictBase
 private:
     template<bool doSeekOnlyOnPositiveChild>
     void internalSeek(uint32_t docid);
+    void strictSampledSeek(uint32_t docid);
 protected:
     void doSeek(uint32_t docid) override {
+        if (__builtin_expect(sampling_child_order(), false)) {
+            strictSampledSeek(docid);
+            return;
+        }
         internalSeek<true>(docid);
     }
 public:
@@ -103,6 +128,35 @@ AndNotSearchStrict::internalSeek(uint32_t docid)
     setDocId(nextId);
 }
 
+void
+AndNotSearchStrict::strictSampledSeek(uint32_t docid)
+{
+    const Children & children(getChildren());
+    uint32_t nextId = docid;
+    for (;;) {
+        children[0]->seek(nextId);
+        nextId = children[0]->getDocId();
+        if (isAtEnd(nextId)) {
+            setAtEnd();
+            break;
+        }
+        uint32_t i = 1;
+        for (; i < children.size(); ++i) {
+            bool negative_hit = children[i]->seek(nextId);
+            record_child_seek(i, negative_hit);
+            if (negative_hit) {
+                break;
+            }
+        }
+        if (i == children.size()) {
+            setDocId(nextId);
+            break;
+        }
+        ++nextId;
+    }
+    sampled_seek_done();
+}
+
 }  // namespace
 
 OptimizedAndNotForBlackListing::OptimizedAndNotForBlackListing(MultiSearch::Children children) :
@@ -17,6 +17,7 @@ protected:
     void doSeek(uint32_t docid) override;
     void doUnpack(uint32_t docid) override;
     Trinary is_strict() const override { return Trinary::False; }
+    void sampledSeek(uint32_t docid);
 
     /**
      * Create a new AndNot Search with the given children.
@@ -37,6 +38,7 @@ private:
     bool needUnpack(size_t index) const override {
         return index == 0;
     }
+    size_t first_reorderable_child() const override { return 1; }
 };
 
 class AndNotSearchStrictBase : public AndNotSearch
@@ -92,6 +94,7 @@ private:
     }
     void doSeek(uint32_t docid) override;
     void doUnpack(uint32_t docid) override;
+    size_t first_reorderable_child() const override { return getChildren().size(); }
 };
 
 }
@@ -71,6 +71,7 @@ public:
     }
     void onRemove(size_t index) { (void) index; }
     void onInsert(size_t index) { (void) index; }
+    void onReorder(const AdaptiveChildOrder::Order &order) { (void) order; }
 };
 
 class SelectiveUnpack
@@ -93,6 +94,15 @@ public:
     void onInsert(size_t index) {
         _unpackInfo.insert(index);
     }
+    void onReorder(const AdaptiveChildOrder::Order &order) {
+        UnpackInfo reordered;
+        for (size_t i = 0; i < order.size(); ++i) {
+            if (_unpackInfo.needUnpack(order[i])) {
+                reordered.add(i);
+            }
+        }
+        _unpackInfo = reordered;
+    }
 private:
     UnpackInfo _unpackInfo;
 };
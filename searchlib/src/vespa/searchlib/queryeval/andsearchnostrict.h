@@ -29,6 +29,10 @@ public:
 
 protected:
     void doSeek(uint32_t docid) override {
+        if (__builtin_expect(this->sampling_child_order(), false)) {
+            sampledSeek(docid);
+            return;
+        }
         const Children & children(getChildren());
         for (uint32_t i = 0; i < children.size(); ++i) {
             if (!children[i]->seek(docid)) {
@@ -51,8 +55,24 @@ protected:
     bool needUnpack(size_t index) const override {
         return _unpacker.needUnpack(index);
     }
+    void onReorder(const AdaptiveChildOrder::Order &order) override {
+        _unpacker.onReorder(order);
+    }
 
 private:
+    size_t first_reorderable_child() const override { return 0; }
+    void sampledSeek(uint32_t docid) {
+        const Children & children(getChildren());
+        bool hit = true;
+        for (uint32_t i = 0; hit && (i < children.size()); ++i) {
+            hit = children[i]->seek(docid);
+            this->record_child_seek(i, !hit);
+        }
+        if (hit) {
+            setDocId(docid);
+        }
+        this->sampled_seek_done();
+    }
     Unpack _unpacker;
 };
 
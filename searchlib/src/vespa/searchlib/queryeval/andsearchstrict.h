@@ -17,6 +17,8 @@ class AndSearchStrict : public AndSearchNoStrict<Unpack>
 private:
     template<bool doSeekOnly>
     VESPA_DLL_LOCAL void advance(uint32_t failedChildIndexd) __attribute__((noinline));
+    VESPA_DLL_LOCAL void sampledSeek(uint32_t docid) __attribute__((noinline));
+    size_t first_reorderable_child() const override { return 1; }
     using Trinary=vespalib::Trinary;
 protected:
     void doSeek(uint32_t docid) override;
@@ -72,10 +74,49 @@ AndSearchStrict<Unpack>::advance(uint32_t failedChildIndex)
     this->setDocId(nextId);
 }
 
+template<typename Unpack>
+void
+AndSearchStrict<Unpack>::sampledSeek(uint32_t docid)
+{
+    const MultiSearch::Children & children(this->getChildren());
+    SearchIterator & firstChild(*children[0]);
+    uint32_t nextId(docid);
+    for (;;) {
+        firstChild.seek(nextId);
+        nextId = firstChild.getDocId();
+        if (this->isAtEnd(nextId)) {
+            this->setAtEnd();
+            break;
+        }
+        uint32_t i(1);
+        for (; i < children.size(); ++i) {
+            bool hit = children[i]->seek(nextId);
+            this->record_child_seek(i, !hit);
+            if (!hit) {
+                break;
+            }
+        }
+        if (i == children.size()) {
+            this->setDocId(nextId);
+            break;
+        }
+        if (__builtin_expect(children[i]->isAtEnd(), false)) {
+            this->setAtEnd();
+            break;
+        }
+        nextId = std::max(nextId + 1, children[i]->getDocId());
+    }
+    this->sampled_seek_done();
+}
+
 template<typename Unpack>
 void
 AndSearchStrict<Unpack>::doSeek(uint32_t docid)
 {
+    if (__builtin_expect(this->sampling_child_order(), false)) {
+        sampledSeek(docid);
+        return;
+    }
     const MultiSearch::Children & children(this->getChildren());
     for (uint32_t i(0); i < children.size(); ++i) {
         children[i]->doSeek(docid);
@@ -2,6 +2,7 @@
 
 #include "dot_product_blueprint.h"
 #include "dot_product_search.h"
+#include "flat_posting_merger.h"
 #include "field_spec.hpp"
 #include <vespa/vespalib/objects/visit.hpp>
 
@@ -62,7 +63,8 @@ DotProductBlueprint::createLeafSearch(const search::fef::TermFieldMatchDataArray
         // TODO: pass ownership with unique_ptr
         children[i] = _terms[i]->createSearch(*md, true).release();
     }
-    return DotProductSearch::create(children, *tfmda[0], childMatch, _weights, std::move(md));
+    return DotProductSearch::create(children, *tfmda[0], childMatch, _weights, std::move(md),
+                                    FlatPostingMergerBase::should_use(_terms.size()));
 }
 
 SearchIterator::UP
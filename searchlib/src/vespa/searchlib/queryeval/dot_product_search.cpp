@@ -2,6 +2,7 @@
 
 #include "dot_product_search.h"
 #include "iterator_pack.h"
+#include "flat_posting_merger.h"
 #include <vespa/vespalib/objects/visit.h>
 
 
@@ -107,6 +108,56 @@ public:
     void visitMembers(vespalib::ObjectVisitor &) const override {}
 };
 
+/**
+ * Dot product search merging its children with a FlatPostingMerger
+ * instead of a heap.
+ **/
+template <typename IteratorPack>
+class FlatDotProductSearchImpl : public DotProductSearch
+{
+private:
+    using Merger = FlatPostingMerger<IteratorPack>;
+    using Entry = typename Merger::Entry;
+
+    TermFieldMatchData     &_tmd;
+    std::vector<int32_t>    _weights;
+    Merger                  _children;
+
+public:
+    FlatDotProductSearchImpl(TermFieldMatchData &tmd,
+                             const std::vector<int32_t> &weights,
+                             IteratorPack &&iteratorPack)
+        : _tmd(tmd),
+          _weights(weights),
+          _children(std::move(iteratorPack), true)
+    {
+        assert(_weights.size() > 0);
+        assert(_weights.size() == _children.size());
+    }
+
+    void doSeek(uint32_t docId) override {
+        setDocId(_children.seek(docId));
+    }
+
+    void doUnpack(uint32_t docId) override {
+        feature_t score = 0.0;
+        for (const Entry *entry = _children.current(); (entry < _children.window_end()) && (entry->docid == docId); ++entry) {
+            double tmp = _weights[entry->child];
+            tmp *= entry->weight;
+            score += tmp;
+        }
+        _tmd.setRawScore(docId, score);
+    }
+
+    void initRange(uint32_t begin, uint32_t end) override {
+        DotProductSearch::initRange(begin, end);
+        _children.initRange(begin, end);
+    }
+    Trinary is_strict() const override { return Trinary::True; }
+
+    void visitMembers(vespalib::ObjectVisitor &) const override {}
+};
+
 class SingleTermDotProductSearch : public DotProductSearch {
 public:
     SingleTermDotProductSearch(TermFieldMatchData &tmd, SearchIterator::UP child,
@@ -148,15 +199,20 @@ DotProductSearch::create(const std::vector<SearchIterator*> &children,
                          TermFieldMatchData &tmd,
                          const std::vector<TermFieldMatchData*> &childMatch,
                          const std::vector<int32_t> &weights,
-                         MatchData::UP md)
+                         MatchData::UP md,
+                         bool use_flat_merge)
 {
     typedef DotProductSearchImpl<vespalib::LeftArrayHeap, SearchIteratorPack> ArrayHeapImpl;
     typedef DotProductSearchImpl<vespalib::LeftHeap, SearchIteratorPack> HeapImpl;
+    typedef FlatDotProductSearchImpl<SearchIteratorPack> FlatImpl;
 
     if (childMatch.size() == 1) {
         return std::make_unique<SingleTermDotProductSearch>(tmd, SearchIterator::UP(children[0]),
                                                              *childMatch[0], weights[0], std::move(md));
     }
+    if (use_flat_merge && (childMatch.size() == children.size())) {
+        return SearchIterator::UP(new FlatImpl(tmd, weights, SearchIteratorPack(children, childMatch, std::move(md))));
+    }
     if (childMatch.size() < 128) {
         return SearchIterator::UP(new ArrayHeapImpl(tmd, weights, SearchIteratorPack(children, childMatch, std::move(md))));
     }
@@ -168,10 +224,16 @@ DotProductSearch::create(const std::vector<SearchIterator*> &children,
 SearchIterator::UP
 DotProductSearch::create(TermFieldMatchData &tmd,
                          const std::vector<int32_t> &weights,
-                         std::vector<DocumentWeightIterator> &&iterators)
+                         std::vector<DocumentWeightIterator> &&iterators,
+                         bool use_flat_merge)
 {
     typedef DotProductSearchImpl<vespalib::LeftArrayHeap, AttributeIteratorPack> ArrayHeapImpl;
     typedef DotProductSearchImpl<vespalib::LeftHeap, AttributeIteratorPack> HeapImpl;
+    typedef FlatDotProductSearchImpl<AttributeIteratorPack> FlatImpl;
+
+    if (use_flat_merge) {
+        return SearchIterator::UP(new FlatImpl(tmd, weights, AttributeIteratorPack(std::move(iterators))));
+    }
 
     if (iterators.size() < 128) {
         return SearchIterator::UP(new ArrayHeapImpl(tmd, weights, AttributeIteratorPack(std::move(iterators))));
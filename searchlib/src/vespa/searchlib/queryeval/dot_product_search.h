@@ -26,15 +26,18 @@ protected:
 
 public:
     // TODO: use MultiSearch::Children to pass ownership
+    // use_flat_merge selects FlatPostingMerger instead of a heap to merge the children
     static SearchIterator::UP create(const std::vector<SearchIterator*> &children,
                                      search::fef::TermFieldMatchData &tmd,
                                      const std::vector<fef::TermFieldMatchData*> &childMatch,
                                      const std::vector<int32_t> &weights,
-                                     fef::MatchData::UP md);
+                                     fef::MatchData::UP md,
+                                     bool use_flat_merge = false);
 
     static SearchIterator::UP create(search::fef::TermFieldMatchData &tmd,
                                      const std::vector<int32_t> &weights,
-                                     std::vector<DocumentWeightIterator> &&iterators);
+                                     std::vector<DocumentWeightIterator> &&iterators,
+                                     bool use_flat_merge = false);
 };
 
 }
@@ -0,0 +1,160 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <vespa/searchlib/common/sort.h>
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+namespace search::queryeval {
+
+/**
+ * Non-templated part of FlatPostingMerger; hit layout and the policy
+ * used to select flat merging instead of merging through a heap.
+ **/
+struct FlatPostingMergerBase {
+    struct Entry {
+        uint32_t docid;
+        uint32_t child;
+        int32_t  weight;
+    };
+
+    // Merging through a heap costs about log2(n) compares of
+    // scattered child positions per hit, while flat merging costs
+    // a small constant per hit (one append and one radix sort
+    // pass). The heap loses once there are more than 2^8 children.
+    static constexpr size_t MIN_CHILDREN = 256;
+
+    static bool should_use(size_t num_children) {
+        return (num_children >= MIN_CHILDREN);
+    }
+
+protected:
+    struct DocIdRadix {
+        uint32_t operator () (const Entry &e) const { return e.docid; }
+    };
+    struct DocIdComparator {
+        bool operator() (const Entry &a, const Entry &b) const {
+            return (a.docid < b.docid);
+        }
+    };
+    static constexpr uint32_t MIN_WINDOW_SIZE = 1024;
+    static constexpr uint32_t MAX_WINDOW_SIZE = (1u << 30);
+    static constexpr uint32_t INITIAL_WINDOW_SIZE = 64 * 1024;
+    static constexpr size_t MIN_ENTRIES_PER_WINDOW = 64 * 1024;
+    static constexpr size_t ENTRIES_PER_CHILD_PER_WINDOW = 16;
+};
+
+/**
+ * Merges the hits of a large number of child iterators without
+ * keeping the children in a heap. All hits within a window of docids
+ * are collected up front, one child at a time, into a single array
+ * that is radix sorted on docid and then iterated. The window size is
+ * adjusted so that each window holds enough hits to amortize visiting
+ * all children, while keeping memory usage bounded.
+ *
+ * The weight of each hit is only fetched from the child if
+ * requested, since it is not needed for weighted set terms.
+ **/
+template <typename IteratorPack>
+class FlatPostingMerger : public FlatPostingMergerBase
+{
+private:
+    IteratorPack          _children;
+    std::vector<uint32_t> _childPos;
+    std::vector<Entry>    _entries;
+    size_t                _pos;
+    size_t                _targetEntries;
+    uint32_t              _windowSize;
+    uint32_t              _windowEnd;
+    uint32_t              _end;
+    bool                  _fetchWeight;
+
+    void fill_window(uint32_t from) __attribute__((noinline));
+
+public:
+    FlatPostingMerger(IteratorPack &&children, bool fetch_weight)
+        : _children(std::move(children)),
+          _childPos(_children.size(), 0),
+          _entries(),
+          _pos(0),
+          _targetEntries(std::max(MIN_ENTRIES_PER_WINDOW, ENTRIES_PER_CHILD_PER_WINDOW * _children.size())),
+          _windowSize(INITIAL_WINDOW_SIZE),
+          _windowEnd(0),
+          _end(0),
+          _fetchWeight(fetch_weight)
+    { }
+
+    size_t size() const { return _children.size(); }
+
+    void initRange(uint32_t begin, uint32_t end) {
+        _children.initRange(begin, end);
+        for (size_t i = 0; i < _childPos.size(); ++i) {
+            _childPos[i] = _children.get_docid(i);
+        }
+        _entries.clear();
+        _pos = 0;
+        _windowEnd = begin;
+        _end = end;
+    }
+
+    /**
+     * Position at the first hit with docid >= the given docid.
+     *
+     * @return docid of that hit, or end of range
+     **/
+    uint32_t seek(uint32_t docid) {
+        for (;;) {
+            for (size_t steps = 0; (_pos < _entries.size()) && (_entries[_pos].docid < docid); ++steps) {
+                if (steps == 4) {
+                    _pos = std::lower_bound(_entries.begin() + _pos, _entries.end(), Entry{docid, 0, 0},
+                                            DocIdComparator()) - _entries.begin();
+                    break;
+                }
+                ++_pos;
+            }
+            if (_pos < _entries.size()) {
+                return _entries[_pos].docid;
+            }
+            if ((_windowEnd >= _end) || (docid >= _end)) {
+                return _end;
+            }
+            fill_window(std::max(docid, _windowEnd));
+        }
+    }
+
+    // all hits for the docid last returned by seek are in [current, window_end>
+    const Entry *current() const { return _entries.data() + _pos; }
+    const Entry *window_end() const { return _entries.data() + _entries.size(); }
+};
+
+template <typename IteratorPack>
+void
+FlatPostingMerger<IteratorPack>::fill_window(uint32_t from)
+{
+    _entries.clear();
+    _pos = 0;
+    uint32_t window_end = ((_end - from) > _windowSize) ? (from + _windowSize) : _end;
+    for (uint32_t i = 0; i < _childPos.size(); ++i) {
+        uint32_t docid = _childPos[i];
+        if (docid < from) {
+            docid = _children.seek(i, from);
+        }
+        while (docid < window_end) {
+            _entries.push_back(Entry{docid, i, _fetchWeight ? _children.get_weight(i, docid) : 0});
+            docid = _children.seek(i, docid + 1);
+        }
+        _childPos[i] = docid;
+    }
+    _windowEnd = window_end;
+    ShiftBasedRadixSorter<Entry, DocIdRadix, DocIdComparator, 24>::
+        radix_sort(DocIdRadix(), DocIdComparator(), _entries.data(), _entries.size(), 16);
+    if ((_entries.size() < (_targetEntries / 2)) && (_windowSize < MAX_WINDOW_SIZE)) {
+        _windowSize *= 2;
+    } else if ((_entries.size() > (_targetEntries * 2)) && (_windowSize > MIN_WINDOW_SIZE)) {
+        _windowSize /= 2;
+    }
+}
+
+}
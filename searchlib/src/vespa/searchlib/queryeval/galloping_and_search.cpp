@@ -0,0 +1,201 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "galloping_and_search.h"
+#include "sourceblendersearch.h"
+#include <algorithm>
+
+namespace search::queryeval {
+
+using vespalib::Trinary;
+
+namespace {
+
+/**
+ * Returns the index of the first docid >= target in docids[pos, size),
+ * or size if there is none. Steps are doubled until the target is passed,
+ * then a binary search is done inside the last step.
+ **/
+uint32_t gallop(const uint32_t *docids, uint32_t pos, uint32_t size, uint32_t target)
+{
+    if ((pos >= size) || (docids[pos] >= target)) {
+        return pos;
+    }
+    uint32_t lo = pos;
+    uint32_t step = 1;
+    uint32_t hi = pos + 1;
+    while ((hi < size) && (docids[hi] < target)) {
+        lo = hi;
+        step <<= 1;
+        hi = lo + step;
+    }
+    hi = std::min(hi, size);
+    return std::lower_bound(docids + lo + 1, docids + hi, target) - docids;
+}
+
+bool canSteal(const MultiSearch &parent, size_t index)
+{
+    const auto &child = *parent.getChildren()[index];
+    return child.has_fast_docid_block() && (child.is_strict() == Trinary::True) && !parent.needUnpack(index);
+}
+
+bool canOptimize(const MultiSearch &parent)
+{
+    if (!parent.isAnd() || (parent.is_strict() != Trinary::True)) {
+        return false;
+    }
+    size_t count(0);
+    for (size_t i(0); i < parent.getChildren().size(); ++i) {
+        if (canSteal(parent, i)) {
+            ++count;
+        }
+    }
+    return count >= 2;
+}
+
+}
+
+GallopingAndSearch::GallopingAndSearch(Children children)
+    : MultiSearch(std::move(children)),
+      _blocks(getChildren().size()),
+      _hits(),
+      _hit_pos(0),
+      _window_end(0)
+{
+    _hits.reserve(block_size);
+}
+
+GallopingAndSearch::~GallopingAndSearch() = default;
+
+void
+GallopingAndSearch::initRange(uint32_t beginId, uint32_t endId)
+{
+    MultiSearch::initRange(beginId, endId);
+    for (auto &block : _blocks) {
+        block.pos = 0;
+        block.size = 0;
+        block.exhausted = false;
+    }
+    _hits.clear();
+    _hit_pos = 0;
+    _window_end = 0;
+}
+
+bool
+GallopingAndSearch::intersect_window(uint32_t begin_id)
+{
+    const Children &children = getChildren();
+    uint32_t window_end = getEndId();
+    for (size_t i(0); i < _blocks.size(); ++i) {
+        Block &block = _blocks[i];
+        block.pos = gallop(block.docids.data(), block.pos, block.size, begin_id);
+        if (block.pos == block.size) {
+            if (block.exhausted) {
+                return false;
+            }
+            block.size = children[i]->fill_docid_block(begin_id, block.docids.data(), block_size);
+            block.pos = 0;
+            block.exhausted = (block.size < block_size);
+            if (block.size == 0) {
+                return false;
+            }
+        }
+        if (!block.exhausted) {
+            window_end = std::min(window_end, block.docids[block.size - 1] + 1);
+        }
+    }
+    // All hits in [begin_id, window_end) are now present in the blocks.
+    _hits.clear();
+    _hit_pos = 0;
+    _window_end = window_end;
+    Block &lead = _blocks[0];
+    uint32_t i = lead.pos;
+    while ((i < lead.size) && (lead.docids[i] < window_end)) {
+        uint32_t candidate = lead.docids[i];
+        size_t j(1);
+        for (; j < _blocks.size(); ++j) {
+            Block &block = _blocks[j];
+            block.pos = gallop(block.docids.data(), block.pos, block.size, candidate);
+            if (block.pos == block.size) {
+                lead.pos = lead.size;
+                return true;
+            }
+            uint32_t docid = block.docids[block.pos];
+            if (docid != candidate) {
+                i = gallop(lead.docids.data(), i, lead.size, docid);
+                break;
+            }
+        }
+        if (j == _blocks.size()) {
+            _hits.push_back(candidate);
+            ++i;
+        }
+    }
+    lead.pos = i;
+    return true;
+}
+
+void
+GallopingAndSearch::doSeek(uint32_t docid)
+{
+    for (;;) {
+        if (docid < _window_end) {
+            _hit_pos = gallop(_hits.data(), _hit_pos, _hits.size(), docid);
+            if (_hit_pos < _hits.size()) {
+                setDocId(_hits[_hit_pos]);
+                return;
+            }
+            docid = _window_end;
+        }
+        if (isAtEnd(docid) || !intersect_window(docid)) {
+            setAtEnd();
+            return;
+        }
+    }
+}
+
+SearchIterator::UP
+GallopingAndSearch::optimize(SearchIterator::UP parentIt)
+{
+    if (parentIt->isSourceBlender()) {
+        auto & parent(static_cast<SourceBlenderSearch &>(*parentIt));
+        for (size_t i(0); i < parent.getNumChildren(); i++) {
+            parent.setChild(i, optimize(parent.steal(i)));
+        }
+    } else if (parentIt->isMultiSearch()) {
+        parentIt = optimizeMultiSearch(std::move(parentIt));
+    }
+    return parentIt;
+}
+
+SearchIterator::UP
+GallopingAndSearch::optimizeMultiSearch(SearchIterator::UP parentIt)
+{
+    auto & parent(static_cast<MultiSearch &>(*parentIt));
+    if (canOptimize(parent)) {
+        MultiSearch::Children stolen;
+        size_t insertPosition(0);
+        for (size_t it(0); it != parent.getChildren().size(); ) {
+            if (canSteal(parent, it)) {
+                if (stolen.empty()) {
+                    insertPosition = it;
+                }
+                stolen.push_back(parent.remove(it));
+            } else {
+                it++;
+            }
+        }
+        auto next = std::make_unique<GallopingAndSearch>(std::move(stolen));
+        if (parent.getChildren().empty()) {
+            return next;
+        } else {
+            parent.insert(insertPosition, std::move(next));
+        }
+    }
+    auto & toOptimize(const_cast<MultiSearch::Children &>(parent.getChildren()));
+    for (auto & search : toOptimize) {
+        search = optimize(std::move(search));
+    }
+    return parentIt;
+}
+
+}
@@ -0,0 +1,53 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include "multisearch.h"
+
+namespace search::queryeval {
+
+/**
+ * Strict AND over children that can hand out blocks of decoded docids
+ * (see SearchIterator::fill_docid_block), typically attribute and disk
+ * index posting lists. Instead of calling virtual seek on each child per
+ * candidate, a block of docids is fetched from each child and the blocks
+ * are intersected with galloping search. Only children that do not need
+ * unpacking are handled, so unpack is a no-op.
+ **/
+class GallopingAndSearch : public MultiSearch
+{
+public:
+    static constexpr uint32_t block_size = 256;
+
+    explicit GallopingAndSearch(Children children);
+    ~GallopingAndSearch() override;
+    void initRange(uint32_t beginId, uint32_t endId) override;
+    Trinary is_strict() const override { return Trinary::True; }
+
+    /**
+     * Will steal children of strict AND searches that can fill docid
+     * blocks, when there are at least 2 of them and they need no unpacking.
+     * Might return itself or a new structure.
+     */
+    static SearchIterator::UP optimize(SearchIterator::UP parent);
+private:
+    struct Block {
+        std::vector<uint32_t> docids;
+        uint32_t              pos;
+        uint32_t              size;
+        bool                  exhausted;
+        Block() : docids(block_size), pos(0), size(0), exhausted(false) {}
+    };
+
+    void doSeek(uint32_t docid) override;
+    void doUnpack(uint32_t docid) override { (void) docid; }
+    bool intersect_window(uint32_t begin_id);
+    static SearchIterator::UP optimizeMultiSearch(SearchIterator::UP parent);
+
+    std::vector<Block>    _blocks;
+    std::vector<uint32_t> _hits;
+    uint32_t              _hit_pos;
+    uint32_t              _window_end;
+};
+
+}
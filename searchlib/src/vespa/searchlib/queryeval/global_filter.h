@@ -13,19 +13,20 @@ namespace search::queryeval {
  * bitvector should be a white-list (documents that may
  * possibly become hits have their bit set, documents
  * that are certain to be filtered away should have theirs
- * cleared).
+ * cleared). The bitvector may be shared with other global
+ * filters, like when it is cached between queries.
  **/
 class GlobalFilter : public std::enable_shared_from_this<GlobalFilter>
 {
 private:
     struct ctor_tag {};
-    std::unique_ptr<search::BitVector> bit_vector;
+    std::shared_ptr<const search::BitVector> bit_vector;
 
     GlobalFilter(const GlobalFilter &) = delete;
     GlobalFilter(GlobalFilter &&) = delete;
 public:
 
-    GlobalFilter(ctor_tag, std::unique_ptr<search::BitVector> bit_vector_in)
+    GlobalFilter(ctor_tag, std::shared_ptr<const search::BitVector> bit_vector_in)
       : bit_vector(std::move(bit_vector_in))
     {}
 
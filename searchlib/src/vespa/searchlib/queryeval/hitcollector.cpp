@@ -1,6 +1,7 @@
 // Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 
 #include "hitcollector.h"
+#include "idiversifier.h"
 #include <vespa/searchlib/common/bitvector.h>
 #include <vespa/searchlib/common/sort.h>
 
@@ -46,6 +47,7 @@ HitCollector::HitCollector(uint32_t numDocs,
       _reRankedHits(),
       _scale(1.0),
       _adjust(0),
+      _scoreThreshold(-HUGE_VAL),
       _hasReRanked(false),
       _needReScore(false)
 {
@@ -174,6 +176,21 @@ HitCollector::getSortedHitSequence(size_t max_hits)
     return SortedHitSequence(&_hits[0], &_scoreOrder[0], num_hits);
 }
 
+SortedHitSequence
+HitCollector::getSortedHitSequence(size_t max_hits, IDiversifier &diversifier)
+{
+    size_t num_hits = std::min(_hits.size(), max_hits);
+    sortHitsByScore(num_hits);
+    _diversifiedOrder.clear();
+    _diversifiedOrder.reserve(num_hits);
+    for (size_t i = 0; i < num_hits; ++i) {
+        if (diversifier.accepted(_hits[_scoreOrder[i]].first)) {
+            _diversifiedOrder.push_back(_scoreOrder[i]);
+        }
+    }
+    return SortedHitSequence(_hits.data(), _diversifiedOrder.data(), _diversifiedOrder.size());
+}
+
 size_t
 HitCollector::reRank(DocumentScorer &scorer, std::vector<Hit> hits) {
     if (hits.empty()) { return 0; }
@@ -186,8 +203,8 @@ HitCollector::reRank(DocumentScorer &scorer, std::vector<Hit> hits) {
                          -std::numeric_limits<feature_t>::max());
 
     std::sort(hits.begin(), hits.end()); // sort on docId
-    for (auto &hit : hits) {
-        hit.second = scorer.score(hit.first);
+    scorer.scoreHits(hits);
+    for (const auto &hit : hits) {
         finalScores.low = std::min(finalScores.low, hit.second);
         finalScores.high = std::max(finalScores.high, hit.second);
     }
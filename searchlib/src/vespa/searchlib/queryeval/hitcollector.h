@@ -6,13 +6,17 @@
 #include <vespa/searchlib/common/hitrank.h>
 #include <vespa/searchlib/common/resultset.h>
 #include <algorithm>
+#include <cmath>
 #include <vector>
+#include <vespa/vespalib/util/arrayref.h>
 #include <vespa/vespalib/util/sort.h>
 #include <vespa/fastos/dynamiclibrary.h>
 #include "sorted_hit_sequence.h"
 
 namespace search::queryeval {
 
+struct IDiversifier;
+
 /**
  * This class is used to store all hits found during parallel query evaluation.
  **/
@@ -26,6 +30,15 @@ public:
     struct DocumentScorer {
         virtual ~DocumentScorer() {}
         virtual feature_t score(uint32_t docId) = 0;
+        /**
+         * Calculate the score of all the given hits, sorted on docid.
+         * Override to score multiple documents together.
+         **/
+        virtual void scoreHits(vespalib::ArrayRef<Hit> hits) {
+            for (auto &hit : hits) {
+                hit.second = score(hit.first);
+            }
+        }
     };
 
 private:
@@ -37,6 +50,7 @@ private:
 
     std::vector<Hit>            _hits;  // used as a heap when _hits.size == _maxHitsSize
     std::vector<uint32_t>       _scoreOrder; // Holds an indirection to the N best hits
+    std::vector<uint32_t>       _diversifiedOrder; // The best hits accepted by a diversifier
     SortOrder                   _hitsSortOrder;
     bool                        _unordered;
     std::vector<uint32_t>       _docIdVector;
@@ -46,6 +60,7 @@ private:
     std::pair<Scores, Scores> _ranges;
     feature_t _scale;
     feature_t _adjust;
+    feature_t _scoreThreshold;
 
     bool _hasReRanked;
     bool _needReScore;
@@ -101,7 +116,7 @@ private:
     public:
         CollectorBase(HitCollector &hc) : _hc(hc) { }
         void considerForHitVector(uint32_t docId, feature_t score) {
-            if (__builtin_expect((score > _hc._hits[0].second), false)) {
+            if (__builtin_expect((score > _hc._hits[0].second) && (score >= _hc._scoreThreshold), false)) {
                 replaceHitInVector(docId, score);
             }
         }
@@ -167,6 +182,25 @@ public:
         _collector->collect(docId, score);
     }
 
+    /**
+     * Returns the lowest score stored among the n best hits once all
+     * n slots are in use, and -inf before that. No hit with a lower
+     * score will ever be stored as a ranked hit by this collector.
+     **/
+    feature_t getLowestRankedScore() const {
+        return (_hitsSortOrder == SortOrder::HEAP) ? _hits[0].second : -HUGE_VAL;
+    }
+
+    /**
+     * Sets a lower bound for scores of hits replacing ranked hits
+     * once all n slots are in use. Hits scoring below it are stored
+     * with doc id only. This is used to share the lowest score
+     * needed to enter the global top n between match threads.
+     *
+     * @param score the score threshold
+     **/
+    void setScoreThreshold(feature_t score) { _scoreThreshold = score; }
+
     /**
      * Returns a sorted sequence of hits that reference internal
      * data. The number of hits returned in the sequence is controlled
@@ -177,6 +211,16 @@ public:
      */
     SortedHitSequence getSortedHitSequence(size_t max_hits);
 
+    /**
+     * Same as above, but hits not accepted by the given diversifier
+     * are left out of the sequence. The diversifier is asked about
+     * the hits in score order.
+     *
+     * @param max_hits maximum number of hits considered for the sequence.
+     * @param diversifier decides which hits to keep.
+     */
+    SortedHitSequence getSortedHitSequence(size_t max_hits, IDiversifier &diversifier);
+
     const std::vector<Hit> & getReRankedHits() const { return _reRankedHits; }
 
     /**
@@ -3,6 +3,8 @@
 #pragma once
 
 #include <vespa/searchlib/attribute/singlenumericattribute.h>
+#include <algorithm>
+#include <cstring>
 
 namespace search::queryeval {
 
@@ -33,6 +35,26 @@ public:
     uint32_t getDocIdLimit() const {
         return _source.getCommittedDocIdLimit();
     }
+
+    /**
+     * Find the first document in [docId, endId) that should be taken
+     * from the given source. The selector array is scanned with
+     * memchr, which checks many documents per step.
+     *
+     * @return document id, or min(endId, doc id limit) if there is none
+     * @param docId where to start looking
+     * @param endId where to stop looking
+     * @param source the wanted source
+     **/
+    uint32_t findNextForSource(uint32_t docId, uint32_t endId, queryeval::Source source) const {
+        uint32_t limit = std::min(endId, getDocIdLimit());
+        if (docId >= limit) {
+            return limit;
+        }
+        const char *sources = reinterpret_cast<const char *>(_source.getFastArray());
+        const void *found = memchr(sources + docId, source, limit - docId);
+        return (found != nullptr) ? (static_cast<const char *>(found) - sources) : limit;
+    }
 private:
     const SourceStore & _source;
 };
@@ -4,6 +4,7 @@
 #include "andsearch.h"
 #include "andnotsearch.h"
 #include "sourceblendersearch.h"
+#include "termwise_helper.h"
 #include <vespa/searchlib/common/bitvectoriterator.h>
 #include <vespa/searchlib/fef/termfieldmatchdataarray.h>
 #include <vespa/vespalib/util/optimized.h>
@@ -32,9 +33,15 @@ public:
     }
 protected:
     void updateLastValue(uint32_t docId);
+    uint32_t nextCandidate(uint32_t docId) const;
     void strictSeek(uint32_t docId);
 private:
     void doSeek(uint32_t docId) override;
+    BitVector::UP get_hits(uint32_t begin_id) override;
+    void or_hits_into(BitVector &result, uint32_t begin_id) override;
+    void and_hits_into(BitVector &result, uint32_t begin_id) override;
+    // docids below the current position are no longer hits
+    uint32_t firstHitLimit() const { return std::min(getDocId(), getEndId()); }
     Trinary is_strict() const override { return Trinary::False; }
     bool acceptExtraFilter() const override { return Update::isAnd(); }
     Update              _update;
@@ -55,11 +62,24 @@ private:
     Trinary is_strict() const override { return Trinary::True; }
 };
 
+/*
+ * Termwise evaluation combines whole bitvectors word by word instead
+ * of going through the batch buffer.
+ */
 struct And {
     using Word = BitWord::Word;
     void operator () (const IAccelrated & accel, size_t offset, const std::vector<std::pair<const void *, bool>> & src, void *dest) {
         accel.and64(offset, src, dest);
     }
+    BitVector::UP get_hits(const MultiSearch::Children & children, uint32_t begin_id) {
+        return TermwiseHelper::andChildren(children.begin(), children.end(), begin_id);
+    }
+    void or_hits_into(BitVector & result, const MultiSearch::Children & children, uint32_t begin_id) {
+        result.orWith(*get_hits(children, begin_id));
+    }
+    void and_hits_into(BitVector & result, const MultiSearch::Children & children, uint32_t begin_id) {
+        TermwiseHelper::andChildren(result, children.begin(), children.end(), begin_id);
+    }
     static bool isAnd() { return true; }
 };
 
@@ -68,6 +88,15 @@ struct Or {
     void operator () (const IAccelrated & accel, size_t offset, const std::vector<std::pair<const void *, bool>> & src, void *dest) {
         accel.or64(offset, src, dest);
     }
+    BitVector::UP get_hits(const MultiSearch::Children & children, uint32_t begin_id) {
+        return TermwiseHelper::orChildren(children.begin(), children.end(), begin_id);
+    }
+    void or_hits_into(BitVector & result, const MultiSearch::Children & children, uint32_t begin_id) {
+        TermwiseHelper::orChildren(result, children.begin(), children.end(), begin_id);
+    }
+    void and_hits_into(BitVector & result, const MultiSearch::Children & children, uint32_t begin_id) {
+        result.andWith(*get_hits(children, begin_id));
+    }
     static bool isAnd() { return false; }
 };
 
@@ -102,13 +131,58 @@ MultiBitVectorIterator<Update>::doSeek(uint32_t docId)
     }
 }
 
+template<typename Update>
+BitVector::UP
+MultiBitVectorIterator<Update>::get_hits(uint32_t begin_id)
+{
+    BitVector::UP result = _update.get_hits(getChildren(), begin_id);
+    if (begin_id < firstHitLimit()) {
+        result->clearInterval(begin_id, firstHitLimit());
+    }
+    return result;
+}
+
+template<typename Update>
+void
+MultiBitVectorIterator<Update>::or_hits_into(BitVector &result, uint32_t begin_id)
+{
+    if (begin_id < firstHitLimit()) {
+        result.orWith(*get_hits(begin_id));
+    } else {
+        _update.or_hits_into(result, getChildren(), begin_id);
+    }
+}
+
+template<typename Update>
+void
+MultiBitVectorIterator<Update>::and_hits_into(BitVector &result, uint32_t begin_id)
+{
+    _update.and_hits_into(result, getChildren(), begin_id);
+    if (begin_id < firstHitLimit()) {
+        result.clearInterval(begin_id, firstHitLimit());
+    }
+}
+
+template<typename Update>
+uint32_t
+MultiBitVectorIterator<Update>::nextCandidate(uint32_t docId) const
+{
+    if (Update::isAnd() && (_skipVector != nullptr)) {
+        // All hits must be in the skip vector, jump past regions where it is empty.
+        uint32_t next = (docId < _skipVector->size()) ? _skipVector->getFirstTrueBit(docId) : _skipVector->size();
+        return (next < _skipVector->size()) ? next : _numDocs;
+    }
+    return docId;
+}
+
 template<typename Update>
 void
 MultiBitVectorIterator<Update>::strictSeek(uint32_t docId)
 {
+    docId = nextCandidate(docId);
     for (updateLastValue(docId), _lastValue = _lastValue & checkTab(docId);
          (_lastValue == 0) && __builtin_expect(! isAtEnd(), true);
-         updateLastValue(_lastMaxDocIdLimit));
+         docId = nextCandidate(_lastMaxDocIdLimit), updateLastValue(docId), _lastValue = _lastValue & checkTab(docId));
     if (__builtin_expect(!isAtEnd(), true)) {
         docId = _lastMaxDocIdLimit - WordLen + vespalib::Optimized::lsbIdx(_lastValue);
         if (__builtin_expect(docId >= _numDocs, false)) {
@@ -155,13 +229,17 @@ MultiBitVectorIteratorBase::MultiBitVectorIteratorBase(Children children) :
     _lastMaxDocIdLimit(0),
     _lastMaxDocIdLimitRequireFetch(0),
     _lastValue(0),
-    _bvs()
+    _bvs(),
+    _skipVector(nullptr)
 {
     _bvs.reserve(getChildren().size());
     for (const auto & child : getChildren()) {
         const auto * bv = static_cast<const BitVectorIterator *>(child.get());
         _bvs.emplace_back(bv->getBitValues(), bv->isInverted());
         _numDocs = std::min(_numDocs, bv->getDocIdLimit());
+        if ((_skipVector == nullptr) && !bv->isInverted()) {
+            _skipVector = &bv->getBitVector();
+        }
     }
 }
 
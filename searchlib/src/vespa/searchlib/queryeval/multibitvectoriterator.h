@@ -6,6 +6,8 @@
 #include "unpackinfo.h"
 #include <vespa/searchlib/common/bitword.h>
 
+namespace search { class BitVector; }
+
 namespace search::queryeval {
 
 class MultiBitVectorIteratorBase : public MultiSearch, protected BitWord
@@ -28,6 +30,8 @@ protected:
     uint32_t                _lastMaxDocIdLimitRequireFetch;
     Word                    _lastValue; // Last value computed
     std::vector<MetaWord>   _bvs;
+    // First non-inverted bitvector, used by strict AND to skip regions without hits
+    const BitVector        *_skipVector;
 private:
     virtual bool acceptExtraFilter() const = 0;
     UP andWith(UP filter, uint32_t estimate) override;
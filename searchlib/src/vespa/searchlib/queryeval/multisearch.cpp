@@ -1,6 +1,7 @@
 // Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 
 #include "multisearch.h"
+#include "sourceblendersearch.h"
 #include <vespa/vespalib/objects/visit.hpp>
 #include <cassert>
 
@@ -11,6 +12,7 @@ MultiSearch::insert(size_t index, SearchIterator::UP search)
 {
     assert(index <= _children.size());
     _children.insert(_children.begin()+index, std::move(search));
+    _child_order.reset();
     onInsert(index);
 }
 
@@ -20,6 +22,7 @@ MultiSearch::remove(size_t index)
     assert(index < _children.size());
     SearchIterator::UP search = std::move(_children[index]);
     _children.erase(_children.begin() + index);
+    _child_order.reset();
     onRemove(index);
     return search;
 }
@@ -38,7 +41,8 @@ MultiSearch::doUnpack(uint32_t docid)
 }
 
 MultiSearch::MultiSearch(Children children)
-    : _children(std::move(children))
+    : _children(std::move(children)),
+      _child_order()
 {
 }
 
@@ -59,6 +63,45 @@ void
 MultiSearch::visitMembers(vespalib::ObjectVisitor &visitor) const
 {
     visit(visitor, "children", _children);
+    if (_child_order) {
+        visit(visitor, "child_seeks", _child_order->seeks());
+        visit(visitor, "child_rejects", _child_order->rejects());
+        visit(visitor, "reordered", _child_order->reordered());
+    }
+}
+
+void
+MultiSearch::reorder_children()
+{
+    AdaptiveChildOrder::Order order = _child_order->make_order(first_reorderable_child());
+    Children reordered;
+    reordered.reserve(_children.size());
+    for (size_t index : order) {
+        reordered.push_back(std::move(_children[index]));
+    }
+    _children = std::move(reordered);
+    _child_order->apply_order(order);
+    onReorder(order);
+}
+
+SearchIterator::UP
+MultiSearch::enable_adaptive_reorder(SearchIterator::UP search, uint32_t num_seeks)
+{
+    if (search->isSourceBlender()) {
+        auto & blender(static_cast<SourceBlenderSearch &>(*search));
+        for (size_t i(0); i < blender.getNumChildren(); i++) {
+            blender.setChild(i, enable_adaptive_reorder(blender.steal(i), num_seeks));
+        }
+    } else if (search->isMultiSearch()) {
+        auto & multi(static_cast<MultiSearch &>(*search));
+        for (auto & child : multi._children) {
+            child = enable_adaptive_reorder(std::move(child), num_seeks);
+        }
+        if ((num_seeks > 0) && (multi.first_reorderable_child() + 1 < multi._children.size())) {
+            multi._child_order = std::make_unique<AdaptiveChildOrder>(multi._children.size(), num_seeks);
+        }
+    }
+    return search;
 }
 
 }
@@ -4,12 +4,14 @@
 
 #include "searchiterator.h"
 #include "children_iterators.h"
+#include "adaptive_child_order.h"
 
 struct MultiSearchRemoveTest;
 
 namespace search::queryeval {
 
 class MultiBitVectorIteratorBase;
+class GallopingAndSearch;
 
 /**
  * A virtual intermediate class that serves as the basis for combining searches
@@ -19,6 +21,7 @@ class MultiSearch : public SearchIterator
 {
     friend struct ::MultiSearchRemoveTest;
     friend class ::search::queryeval::MultiBitVectorIteratorBase;
+    friend class ::search::queryeval::GallopingAndSearch;
     friend class MySearch;
 public:
     /**
@@ -41,11 +44,35 @@ public:
     void insert(size_t index, SearchIterator::UP search);
     virtual bool needUnpack(size_t index) const { (void) index; return true; }
     void initRange(uint32_t beginId, uint32_t endId) override;
+
+    /**
+     * Opt in to adaptive child ordering for all AND and ANDNOT searches
+     * in the given tree. Each of them counts how often its children
+     * reject candidates during its first 'num_seeks' seeks, and then
+     * orders the children that may be moved by decreasing rejection
+     * rate. The counts are part of the iterator dump.
+     */
+    static SearchIterator::UP enable_adaptive_reorder(SearchIterator::UP search, uint32_t num_seeks);
 protected:
     MultiSearch() {}
     void doUnpack(uint32_t docid) override;
     void visitMembers(vespalib::ObjectVisitor &visitor) const override;
+
+    bool sampling_child_order() const { return _child_order && _child_order->sampling(); }
+    void record_child_seek(size_t index, bool rejected) { _child_order->record(index, rejected); }
+    void sampled_seek_done() {
+        if (_child_order->seek_done()) {
+            reorder_children();
+        }
+    }
 private:
+    /**
+     * Index of the first child that may be moved by adaptive child
+     * ordering. Searches that do not support it return the number of
+     * children.
+     */
+    virtual size_t first_reorderable_child() const { return _children.size(); }
+    void reorder_children();
     SearchIterator::UP remove(size_t index); // friends only
     /**
      * Call back when children are removed / inserted after the Iterator has been constructed.
@@ -54,9 +81,15 @@ private:
      */
     virtual void onRemove(size_t index) { (void) index; }
     virtual void onInsert(size_t index) { (void) index; }
+    /**
+     * Call back when children have been reordered; order[i] is the old
+     * index of the child now at index i.
+     */
+    virtual void onReorder(const AdaptiveChildOrder::Order &order) { (void) order; }
 
     bool isMultiSearch() const override { return true; }
-    Children _children;
+    Children                            _children;
+    std::unique_ptr<AdaptiveChildOrder> _child_order;
 };
 
 }
@@ -10,11 +10,16 @@
 #include <vespa/searchlib/tensor/dense_tensor_attribute.h>
 #include <vespa/searchlib/tensor/distance_function_factory.h>
 #include <vespa/log/log.h>
+#include <algorithm>
+#include <ostream>
+#include <queue>
 
 LOG_SETUP(".searchlib.queryeval.nearest_neighbor_blueprint");
 
 using vespalib::tensor::DenseTensorView;
 using vespalib::tensor::DenseTensor;
+using vespalib::tensor::TypedCells;
+using Neighbor = search::tensor::NearestNeighborIndex::Neighbor;
 
 namespace search::queryeval {
 
@@ -42,18 +47,91 @@ template<>
 void
 convert_cells<double,double>(std::unique_ptr<DenseTensorView> &, vespalib::eval::ValueType) {}
 
+template<>
+void
+convert_cells<int8_t,int8_t>(std::unique_ptr<DenseTensorView> &, vespalib::eval::ValueType) {}
+
+template<>
+void
+convert_cells<vespalib::BFloat16,vespalib::BFloat16>(std::unique_ptr<DenseTensorView> &, vespalib::eval::ValueType) {}
+
 struct ConvertCellsSelector
 {
     template <typename LCT, typename RCT>
     static auto invoke() { return convert_cells<LCT, RCT>; }
 };
 
+/**
+ * Splits a batch of query points (dense tensor of order 2) into one tensor per query point,
+ * using the type (and cell type) of the attribute tensor.
+ */
+template<typename LCT, typename RCT>
+std::vector<std::unique_ptr<DenseTensorView>>
+split_batch(const DenseTensorView &batch, size_t batch_dim_idx, const vespalib::eval::ValueType &want_type)
+{
+    auto cells = batch.cellsRef().typify<LCT>();
+    const auto &dims = batch.fast_type().dimensions();
+    size_t num_queries = dims[batch_dim_idx].size;
+    size_t vector_size = dims[1 - batch_dim_idx].size;
+    std::vector<std::unique_ptr<DenseTensorView>> result;
+    result.reserve(num_queries);
+    for (size_t q = 0; q < num_queries; ++q) {
+        std::vector<RCT> new_cells;
+        new_cells.reserve(vector_size);
+        for (size_t i = 0; i < vector_size; ++i) {
+            size_t idx = (batch_dim_idx == 0) ? (q * vector_size + i) : (i * num_queries + q);
+            RCT conv = cells[idx];
+            new_cells.push_back(conv);
+        }
+        result.push_back(std::make_unique<DenseTensor<RCT>>(want_type, std::move(new_cells)));
+    }
+    return result;
+}
+
+struct SplitBatchSelector
+{
+    template <typename LCT, typename RCT>
+    static auto invoke() { return split_batch<LCT, RCT>; }
+};
+
+std::vector<Neighbor>
+merge_batch_hits(const std::vector<std::vector<Neighbor>> &per_query)
+{
+    std::vector<Neighbor> result;
+    for (const auto &hits : per_query) {
+        result.insert(result.end(), hits.begin(), hits.end());
+    }
+    std::sort(result.begin(), result.end(), [](const Neighbor &lhs, const Neighbor &rhs) {
+        return (lhs.docid < rhs.docid) || ((lhs.docid == rhs.docid) && (lhs.distance < rhs.distance));
+    });
+    // keep the closest distance for each document
+    auto last = std::unique(result.begin(), result.end(), [](const Neighbor &lhs, const Neighbor &rhs) {
+        return (lhs.docid == rhs.docid);
+    });
+    result.erase(last, result.end());
+    return result;
+}
+
+const char *
+to_string(NearestNeighborBlueprint::Algorithm algorithm)
+{
+    using NNBA = NearestNeighborBlueprint::Algorithm;
+    switch (algorithm) {
+    case NNBA::EXACT: return "exact";
+    case NNBA::EXACT_FALLBACK: return "exact_fallback";
+    case NNBA::INDEX_TOP_K: return "index_top_k";
+    case NNBA::INDEX_TOP_K_EXTENDED: return "index_top_k_extended";
+    }
+    return "unknown";
+}
+
 } // namespace <unnamed>
 
 NearestNeighborBlueprint::NearestNeighborBlueprint(const queryeval::FieldSpec& field,
                                                    const tensor::DenseTensorAttribute& attr_tensor,
                                                    std::unique_ptr<vespalib::tensor::DenseTensorView> query_tensor,
-                                                   uint32_t target_num_hits, bool approximate, uint32_t explore_additional_hits, double brute_force_limit)
+                                                   uint32_t target_num_hits, bool approximate, uint32_t explore_additional_hits,
+                                                   double brute_force_limit, double extended_exploration_limit)
     : ComplexLeafBlueprint(field),
       _attr_tensor(attr_tensor),
       _query_tensor(std::move(query_tensor)),
@@ -61,21 +139,37 @@ NearestNeighborBlueprint::NearestNeighborBlueprint(const queryeval::FieldSpec& f
       _approximate(approximate),
       _explore_additional_hits(explore_additional_hits),
       _brute_force_limit(brute_force_limit),
+      _extended_exploration_limit(extended_exploration_limit),
+      _explore_k(target_num_hits + explore_additional_hits),
+      _algorithm(Algorithm::EXACT),
       _fallback_dist_fun(),
       _distance_heap(target_num_hits),
       _found_hits(),
-      _global_filter(GlobalFilter::create())
+      _global_filter(GlobalFilter::create()),
+      _batch_query_tensors(),
+      _batch_top_k_done(false)
 {
     auto lct = _query_tensor->cellsRef().type;
     auto rct = _attr_tensor.getTensorType().cell_type();
     using MyTypify = vespalib::eval::TypifyCellType;
-    auto fixup_fun = vespalib::typify_invoke<2,MyTypify,ConvertCellsSelector>(lct, rct);
-    fixup_fun(_query_tensor, _attr_tensor.getTensorType());
+    const auto &query_dims = _query_tensor->fast_type().dimensions();
+    if (query_dims.size() == 2) {
+        const auto &vector_dim_name = _attr_tensor.getTensorType().dimensions()[0].name;
+        size_t batch_dim_idx = (query_dims[0].name == vector_dim_name) ? 1 : 0;
+        auto split_fun = vespalib::typify_invoke<2,MyTypify,SplitBatchSelector>(lct, rct);
+        _batch_query_tensors = split_fun(*_query_tensor, batch_dim_idx, _attr_tensor.getTensorType());
+    } else {
+        auto fixup_fun = vespalib::typify_invoke<2,MyTypify,ConvertCellsSelector>(lct, rct);
+        fixup_fun(_query_tensor, _attr_tensor.getTensorType());
+    }
     _fallback_dist_fun = search::tensor::make_distance_function(_attr_tensor.getConfig().distance_metric(), rct);
     _dist_fun = _fallback_dist_fun.get();
     auto nns_index = _attr_tensor.nearest_neighbor_index();
     if (nns_index) {
         _dist_fun = nns_index->distance_function();
+        if (_approximate) {
+            _algorithm = Algorithm::INDEX_TOP_K;
+        }
     }
     uint32_t est_hits = _attr_tensor.getNumDocs();
     setEstimate(HitEstimate(est_hits, false));
@@ -98,21 +192,100 @@ NearestNeighborBlueprint::set_global_filter(const GlobalFilter &global_filter)
         if (_global_filter->has_filter()) {
             uint32_t max_hits = _global_filter->filter()->countTrueBits();
             LOG(debug, "set_global_filter getNumDocs: %u / max_hits %u", est_hits, max_hits);
-            double max_hit_ratio = static_cast<double>(max_hits) / est_hits;
+            double max_hit_ratio = (est_hits > 0) ? (static_cast<double>(max_hits) / est_hits) : 0.0;
             if (max_hit_ratio < _brute_force_limit) {
                 _approximate = false;
+                _algorithm = Algorithm::EXACT_FALLBACK;
                 LOG(debug, "too many hits filtered out, using brute force implementation");
             } else {
                 est_hits = std::min(est_hits, max_hits);
+                if (max_hit_ratio < _extended_exploration_limit) {
+                    // Compensate for the filtered out part of the graph so that
+                    // roughly the same number of matching nodes are explored.
+                    double scaled = (_target_num_hits + _explore_additional_hits) / max_hit_ratio;
+                    _explore_k = std::max(_explore_k, static_cast<uint32_t>(std::min(scaled, static_cast<double>(max_hits))));
+                    _algorithm = Algorithm::INDEX_TOP_K_EXTENDED;
+                    LOG(debug, "restrictive filter (hit ratio %f), extending exploration to %u", max_hit_ratio, _explore_k);
+                }
             }
         }
-        if (_approximate) {
+        if (_approximate && !is_batch()) {
             est_hits = std::min(est_hits, _target_num_hits);
             setEstimate(HitEstimate(est_hits, false));
             perform_top_k();
             LOG(debug, "perform_top_k found %zu hits", _found_hits.size());
         }
     }
+    if (is_batch()) {
+        perform_batch_top_k();
+        LOG(debug, "perform_batch_top_k found %zu hits for %zu query points", _found_hits.size(), get_batch_size());
+    }
+}
+
+void
+NearestNeighborBlueprint::fetchPostings(const ExecuteInfo &)
+{
+    // A batch is searched up front, also when no global filter is set.
+    if (is_batch() && !_batch_top_k_done) {
+        perform_batch_top_k();
+    }
+}
+
+void
+NearestNeighborBlueprint::perform_batch_top_k()
+{
+    std::vector<TypedCells> vectors;
+    vectors.reserve(_batch_query_tensors.size());
+    for (const auto &query_tensor : _batch_query_tensors) {
+        vectors.push_back(query_tensor->cellsRef());
+    }
+    const BitVector *filter = _global_filter->has_filter() ? _global_filter->filter() : nullptr;
+    auto nns_index = _attr_tensor.nearest_neighbor_index();
+    if (_approximate && nns_index) {
+        _found_hits = merge_batch_hits(nns_index->find_top_k_batch(_target_num_hits, vectors, filter, _explore_k));
+    } else {
+        _found_hits = merge_batch_hits(exact_batch_top_k(vectors, filter));
+    }
+    _batch_top_k_done = true;
+    setEstimate(HitEstimate(_found_hits.size(), _found_hits.empty()));
+}
+
+std::vector<std::vector<Neighbor>>
+NearestNeighborBlueprint::exact_batch_top_k(const std::vector<TypedCells> &vectors, const BitVector *filter) const
+{
+    using DistDocid = std::pair<double, uint32_t>;
+    std::vector<std::priority_queue<DistDocid>> best(vectors.size());
+    uint32_t docid_limit = _attr_tensor.getCommittedDocIdLimit();
+    if (filter) {
+        docid_limit = std::min(docid_limit, filter->size());
+    }
+    for (uint32_t docid = 1; docid < docid_limit; ++docid) {
+        if (filter && !filter->testBit(docid)) {
+            continue;
+        }
+        // the document vector is compared against all query points while it is in cache
+        TypedCells vector = _attr_tensor.get_vector(docid);
+        for (size_t i = 0; i < vectors.size(); ++i) {
+            double dist = _dist_fun->calc(vectors[i], vector);
+            auto &heap = best[i];
+            if (heap.size() < _target_num_hits) {
+                heap.emplace(dist, docid);
+            } else if (!heap.empty() && dist < heap.top().first) {
+                heap.pop();
+                heap.emplace(dist, docid);
+            }
+        }
+    }
+    std::vector<std::vector<Neighbor>> result(vectors.size());
+    for (size_t i = 0; i < vectors.size(); ++i) {
+        auto &heap = best[i];
+        result[i].reserve(heap.size());
+        while (!heap.empty()) {
+            result[i].emplace_back(heap.top().second, heap.top().first);
+            heap.pop();
+        }
+    }
+    return result;
 }
 
 void
@@ -128,9 +301,9 @@ NearestNeighborBlueprint::perform_top_k()
             uint32_t k = _target_num_hits;
             if (_global_filter->has_filter()) {
                 auto filter = _global_filter->filter();
-                _found_hits = nns_index->find_top_k_with_filter(k, lhs, *filter, k + _explore_additional_hits);
+                _found_hits = nns_index->find_top_k_with_filter(k, lhs, *filter, _explore_k);
             } else {
-                _found_hits = nns_index->find_top_k(k, lhs, k + _explore_additional_hits);
+                _found_hits = nns_index->find_top_k(k, lhs, _explore_k);
             }
         }
     }
@@ -144,6 +317,9 @@ NearestNeighborBlueprint::createLeafSearch(const search::fef::TermFieldMatchData
     if (! _found_hits.empty()) {
         return NnsIndexIterator::create(tfmd, _found_hits, _dist_fun);
     }
+    if (is_batch()) {
+        return std::make_unique<EmptySearch>();
+    }
     const vespalib::tensor::DenseTensorView &qT = *_query_tensor;
     return NearestNeighborIterator::create(strict, tfmd, qT, _attr_tensor,
                                            _distance_heap, _global_filter->filter(), _dist_fun);
@@ -158,6 +334,11 @@ NearestNeighborBlueprint::visitMembers(vespalib::ObjectVisitor& visitor) const
     visitor.visitInt("target_num_hits", _target_num_hits);
     visitor.visitBool("approximate", _approximate);
     visitor.visitInt("explore_additional_hits", _explore_additional_hits);
+    visitor.visitString("algorithm", to_string(_algorithm));
+    visitor.visitInt("explore_k", _explore_k);
+    if (is_batch()) {
+        visitor.visitInt("batch_size", get_batch_size());
+    }
 }
 
 bool
@@ -166,4 +347,11 @@ NearestNeighborBlueprint::always_needs_unpack() const
     return true;
 }
 
+std::ostream&
+operator<<(std::ostream& out, NearestNeighborBlueprint::Algorithm algorithm)
+{
+    out << to_string(algorithm);
+    return out;
+}
+
 }
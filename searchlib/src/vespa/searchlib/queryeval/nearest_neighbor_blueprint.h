@@ -5,6 +5,7 @@
 #include "nearest_neighbor_distance_heap.h"
 #include <vespa/searchlib/tensor/distance_function.h>
 #include <vespa/searchlib/tensor/nearest_neighbor_index.h>
+#include <iosfwd>
 
 namespace vespalib::tensor { class DenseTensorView; }
 namespace search::tensor { class DenseTensorAttribute; }
@@ -16,8 +17,20 @@ namespace search::queryeval {
  *
  * The search iterator matches the K nearest neighbors in a multi-dimensional vector space,
  * where the query point and document points are dense tensors of order 1.
+ *
+ * The query tensor may also be a batch of query points, given as a dense tensor of order 2
+ * where one dimension matches the attribute tensor and the other enumerates the query points.
+ * The K nearest neighbors of each query point are then found in a single search,
+ * and the iterator matches the union of them, scored by the closest query point.
  */
 class NearestNeighborBlueprint : public ComplexLeafBlueprint {
+public:
+    enum class Algorithm {
+        EXACT,
+        EXACT_FALLBACK,
+        INDEX_TOP_K,
+        INDEX_TOP_K_EXTENDED
+    };
 private:
     const tensor::DenseTensorAttribute& _attr_tensor;
     std::unique_ptr<vespalib::tensor::DenseTensorView> _query_tensor;
@@ -25,18 +38,27 @@ private:
     bool _approximate;
     uint32_t _explore_additional_hits;
     double _brute_force_limit;
+    double _extended_exploration_limit;
+    uint32_t _explore_k;
+    Algorithm _algorithm;
     search::tensor::DistanceFunction::UP _fallback_dist_fun;
     const search::tensor::DistanceFunction *_dist_fun;
     mutable NearestNeighborDistanceHeap _distance_heap;
     std::vector<search::tensor::NearestNeighborIndex::Neighbor> _found_hits;
     std::shared_ptr<const GlobalFilter> _global_filter;
+    std::vector<std::unique_ptr<vespalib::tensor::DenseTensorView>> _batch_query_tensors;
+    bool _batch_top_k_done;
 
     void perform_top_k();
+    void perform_batch_top_k();
+    std::vector<std::vector<search::tensor::NearestNeighborIndex::Neighbor>>
+    exact_batch_top_k(const std::vector<vespalib::tensor::TypedCells>& vectors, const BitVector *filter) const;
 public:
     NearestNeighborBlueprint(const queryeval::FieldSpec& field,
                              const tensor::DenseTensorAttribute& attr_tensor,
                              std::unique_ptr<vespalib::tensor::DenseTensorView> query_tensor,
-                             uint32_t target_num_hits, bool approximate, uint32_t explore_additional_hits, double brute_force_limit);
+                             uint32_t target_num_hits, bool approximate, uint32_t explore_additional_hits,
+                             double brute_force_limit, double extended_exploration_limit);
     NearestNeighborBlueprint(const NearestNeighborBlueprint&) = delete;
     NearestNeighborBlueprint& operator=(const NearestNeighborBlueprint&) = delete;
     ~NearestNeighborBlueprint();
@@ -45,6 +67,11 @@ public:
     uint32_t get_target_num_hits() const { return _target_num_hits; }
     void set_global_filter(const GlobalFilter &global_filter) override;
     bool may_approximate() const { return _approximate; }
+    Algorithm get_algorithm() const { return _algorithm; }
+    uint32_t get_explore_k() const { return _explore_k; }
+    bool is_batch() const { return !_batch_query_tensors.empty(); }
+    size_t get_batch_size() const { return _batch_query_tensors.size(); }
+    void fetchPostings(const ExecuteInfo &execInfo) override;
 
     std::unique_ptr<SearchIterator> createLeafSearch(const search::fef::TermFieldMatchDataArray& tfmda,
                                                      bool strict) const override;
@@ -52,4 +79,7 @@ public:
     bool always_needs_unpack() const override;
 };
 
+std::ostream&
+operator<<(std::ostream& out, NearestNeighborBlueprint::Algorithm algorithm);
+
 }
@@ -2,6 +2,7 @@
 
 #include "nearest_neighbor_iterator.h"
 #include <vespa/searchlib/common/bitvector.h>
+#include <array>
 
 using search::tensor::DenseTensorAttribute;
 using vespalib::ConstArrayRef;
@@ -29,6 +30,9 @@ is_compatible(const vespalib::eval::ValueType& lhs,
  * Uses unpack() as feedback mechanism to track which matches actually became hits.
  * Keeps a heap of the K best hit distances.
  * Currently always does brute-force scanning, which is very expensive.
+ * When strict, candidates are scored in blocks of docids ahead of the
+ * current seek position, letting the distance function work on many
+ * vectors for the same query vector in one call.
  **/
 template <bool strict, bool has_filter>
 class NearestNeighborImpl : public NearestNeighborIterator
@@ -39,14 +43,31 @@ public:
         : NearestNeighborIterator(params_in),
           _lhs(params().queryTensor.cellsRef()),
           _fieldTensor(params().tensorAttribute.getTensorType()),
-          _lastScore(0.0)
+          _lastScore(0.0),
+          _block_docids(),
+          _block_cells(),
+          _block_distances(),
+          _block_pos(0),
+          _block_size(0),
+          _block_next(0)
     {
         assert(is_compatible(_fieldTensor.fast_type(), params().queryTensor.fast_type()));
     }
 
     ~NearestNeighborImpl();
 
+    void initRange(uint32_t begin_id, uint32_t end_id) override {
+        NearestNeighborIterator::initRange(begin_id, end_id);
+        _block_pos = 0;
+        _block_size = 0;
+        _block_next = begin_id;
+    }
+
     void doSeek(uint32_t docId) override {
+        if (strict) {
+            seek_in_blocks(docId);
+            return;
+        }
         double distanceLimit = params().distanceHeap.distanceLimit();
         while (__builtin_expect((docId < getEndId()), true)) {
             if ((!has_filter) || params().filter->testBit(docId)) {
@@ -75,6 +96,68 @@ public:
     Trinary is_strict() const override { return strict ? Trinary::True : Trinary::False ; }
 
 private:
+    static constexpr uint32_t block_capacity = 32;
+
+    void seek_in_blocks(uint32_t docId) {
+        double distanceLimit = params().distanceHeap.distanceLimit();
+        for (;;) {
+            for (; _block_pos < _block_size; ++_block_pos) {
+                uint32_t candidate = _block_docids[_block_pos];
+                if ((candidate >= docId) && (_block_distances[_block_pos] <= distanceLimit)) {
+                    _lastScore = _block_distances[_block_pos];
+                    setDocId(candidate);
+                    return;
+                }
+            }
+            if (!fill_block(std::max(docId, _block_next))) {
+                setAtEnd();
+                return;
+            }
+            // hits from the previous block may have tightened the limit
+            distanceLimit = params().distanceHeap.distanceLimit();
+        }
+    }
+
+    bool fill_block(uint32_t docId) {
+        const auto &attr = params().tensorAttribute;
+        uint32_t end_id = getEndId();
+        uint32_t committed_limit = std::min(end_id, attr.getCommittedDocIdLimit());
+        if (has_filter) {
+            end_id = std::min(end_id, params().filter->size());
+        }
+        _block_pos = 0;
+        _block_size = 0;
+        while ((_block_size < block_capacity) && (docId < end_id)) {
+            if (has_filter) {
+                docId = params().filter->getNextTrueBit(docId);
+                if (docId >= end_id) {
+                    break;
+                }
+            }
+            _block_docids[_block_size++] = docId++;
+        }
+        _block_next = docId;
+        if (_block_size == 0) {
+            return false;
+        }
+        for (uint32_t i = 0; i < _block_size; ++i) {
+            if (_block_docids[i] < committed_limit) {
+                attr.prefetch_vector(_block_docids[i]);
+            }
+        }
+        for (uint32_t i = 0; i < _block_size; ++i) {
+            uint32_t candidate = _block_docids[i];
+            if (candidate < committed_limit) {
+                _block_cells[i] = attr.get_vector(candidate);
+            } else {
+                attr.extract_dense_view(candidate, _fieldTensor);
+                _block_cells[i] = _fieldTensor.cellsRef();
+            }
+        }
+        params().distanceFunction->calc_batch(_lhs, _block_cells.data(), _block_size, _block_distances.data());
+        return true;
+    }
+
     double computeDistance(uint32_t docId, double limit) {
         params().tensorAttribute.extract_dense_view(docId, _fieldTensor);
         auto rhs = _fieldTensor.cellsRef();
@@ -84,6 +167,12 @@ private:
     TypedCells             _lhs;
     MutableDenseTensorView _fieldTensor;
     double                 _lastScore;
+    std::array<uint32_t, block_capacity>   _block_docids;
+    std::array<TypedCells, block_capacity> _block_cells;
+    std::array<double, block_capacity>     _block_distances;
+    uint32_t               _block_pos;
+    uint32_t               _block_size;
+    uint32_t               _block_next;
 };
 
 template <bool strict, bool has_filter>
@@ -1,7 +1,7 @@
 // Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 #include "nearsearch.h"
 #include <vespa/vespalib/objects/visit.h>
-#include <vespa/vespalib/util/priority_queue.h>
+#include <algorithm>
 #include <limits>
 #include <set>
 
@@ -14,7 +14,6 @@ namespace queryeval {
 namespace {
 
 using search::fef::TermFieldMatchDataArray;
-using search::fef::TermFieldMatchDataPositionKey;
 
 template<typename T>
 void setup_fields(uint32_t window, std::vector<T> &matchers, const TermFieldMatchDataArray &in) {
@@ -38,8 +37,22 @@ NearSearchBase::NearSearchBase(Children terms,
     : AndSearch(std::move(terms)),
       _data_size(data.size()),
       _window(window),
-      _strict(strict)
+      _strict(strict),
+      _childMatch(),
+      _childField(),
+      _fieldFailed()
 {
+    if (data.size() == getChildren().size()) {
+        std::set<uint32_t> fields;
+        for (size_t i = 0; i < data.size(); ++i) {
+            fields.insert(data[i]->getFieldId());
+        }
+        for (size_t i = 0; i < data.size(); ++i) {
+            _childMatch.add(data[i]);
+            _childField.push_back(std::distance(fields.begin(), fields.find(data[i]->getFieldId())));
+        }
+        _fieldFailed.resize(fields.size());
+    }
 }
 
 void
@@ -100,6 +113,49 @@ NearSearchBase::seekNext(uint32_t docId)
     }
 }
 
+bool
+NearSearchBase::unpackChildren(uint32_t docId)
+{
+    if (_childField.empty()) {
+        AndSearch::doUnpack(docId);
+        return true;
+    }
+    const Children & terms(getChildren());
+    std::fill(_fieldFailed.begin(), _fieldFailed.end(), false);
+    uint32_t liveFields = _fieldFailed.size();
+    for (uint32_t i = 0, len = terms.size(); i < len; ++i) {
+        terms[i]->doUnpack(docId);
+        const search::fef::TermFieldMatchData &tfmd = *_childMatch[i];
+        if ((tfmd.getDocId() != docId || tfmd.begin() == tfmd.end()) && !_fieldFailed[_childField[i]]) {
+            _fieldFailed[_childField[i]] = true;
+            if (--liveFields == 0) {
+                LOG(debug, "Term %d leaves no field able to match document %d.", i, docId);
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+bool
+NearSearchBase::MatcherBase::decodePositions(uint32_t docId)
+{
+    _keys.clear();
+    _ends.clear();
+    for (uint32_t i = 0, len = _inputs.size(); i < len; ++i) {
+        const search::fef::TermFieldMatchData *term = _inputs[i];
+        if (term->getDocId() != docId || term->begin() == term->end()) {
+            LOG(debug, "No occurrences found for term %d.", i);
+            return false;
+        }
+        for (const auto &pos : *term) {
+            _keys.push_back(makeKey(pos.getElementId(), pos.getPosition()));
+        }
+        _ends.push_back(_keys.size());
+    }
+    return true;
+}
+
 void
 NearSearchBase::doSeek(uint32_t docId)
 {
@@ -132,89 +188,51 @@ NearSearch::NearSearch(Children terms,
     setup_fields(window, _matchers, data);
 }
 
-namespace {
-
-struct PosIter {
-    search::fef::TermFieldMatchData::PositionsIterator curPos;
-    search::fef::TermFieldMatchData::PositionsIterator endPos;
-
-    bool operator< (const PosIter &other) const {
-        // assumes none is at end
-        TermFieldMatchDataPositionKey mykey = *curPos;
-        TermFieldMatchDataPositionKey otherkey = *other.curPos;
-        return mykey < otherkey;
-    }
-};
-
-struct Iterators
+bool
+NearSearch::Matcher::match(uint32_t docId)
 {
-    vespalib::PriorityQueue<PosIter> _queue;
-    TermFieldMatchDataPositionKey _maxOcc;
-
-    void update(TermFieldMatchDataPositionKey occ)
-    {
-        if (_queue.size() == 1 || _maxOcc < occ) { _maxOcc = occ; }
+    if (!decodePositions(docId)) {
+        return false;
     }
-
-    void add(const search::fef::TermFieldMatchData *term)
-    {
-        PosIter iter;
-        iter.curPos = term->begin();
-        iter.endPos = term->end();
-        LOG_ASSERT(iter.curPos != iter.endPos);
-        _queue.push(iter);
-        update(*iter.curPos);
+    // Current position and end for each term, kept in small flat
+    // arrays so that the term with the smallest current key is found
+    // with a linear scan instead of maintaining a priority queue.
+    uint32_t numTerms = _ends.size();
+    _cur.resize(numTerms);
+    uint64_t maxOcc = 0;
+    for (uint32_t i = 0; i < numTerms; ++i) {
+        _cur[i] = (i == 0) ? 0 : _ends[i - 1];
+        maxOcc = std::max(maxOcc, _keys[_cur[i]]);
     }
-
-    bool match(uint32_t window) {
-        for (;;) {
-            PosIter &front = _queue.front();
-            TermFieldMatchDataPositionKey lastAllowed = *front.curPos;
-            lastAllowed.setPosition(front.curPos->getPosition() + window);
-
-            if (!(lastAllowed < _maxOcc)) {
-                return true;
+    const uint64_t *keys = _keys.data();
+    for (;;) {
+        uint32_t front = 0;
+        for (uint32_t i = 1; i < numTerms; ++i) {
+            if (keys[_cur[i]] < keys[_cur[front]]) {
+                front = i;
             }
-            do {
-                ++front.curPos;
-                if (front.curPos == front.endPos) {
-                    return false;
-                }
-                lastAllowed = *front.curPos;
-                lastAllowed.setPosition(front.curPos->getPosition() + window);
-            } while (lastAllowed < _maxOcc);
-
-            update(*front.curPos);
-            _queue.adjust();
         }
-    }
-};
-
-} // namespace <unnamed>
-
-bool
-NearSearch::Matcher::match(uint32_t docId)
-{
-    Iterators pos;
-    for (uint32_t i = 0, len = inputs().size(); i < len; ++i) {
-        const search::fef::TermFieldMatchData *term = inputs()[i];
-        if (term->getDocId() != docId || term->begin() == term->end()) {
-            LOG(debug, "No occurrences found for term %d.", i);
-            return false;
+        uint32_t pos = _cur[front];
+        if (!(windowEnd(keys[pos], window()) < maxOcc)) {
+            return true;
         }
-        LOG(debug, "Got positions iterator for term %d.", i);
-        pos.add(term);
+        uint32_t end = _ends[front];
+        do {
+            if (++pos == end) {
+                return false;
+            }
+        } while (windowEnd(keys[pos], window()) < maxOcc);
+        maxOcc = std::max(maxOcc, keys[pos]);
+        _cur[front] = pos;
     }
-
-    // Look for matching window.
-    return pos.match(window());
 }
 
 bool
 NearSearch::match(uint32_t docId)
 {
-    // Retrieve position iterators for each term.
-    doUnpack(docId);
+    if (!unpackChildren(docId)) {
+        return false;
+    }
     for (size_t i = 0; i < _matchers.size(); ++i) {
         if (_matchers[i].match(docId)) {
             return true;
@@ -236,52 +254,44 @@ ONearSearch::ONearSearch(Children terms,
 bool
 ONearSearch::Matcher::match(uint32_t docId)
 {
-    uint32_t numTerms = inputs().size();
-    PositionsIteratorList pos;
-    for (uint32_t i = 0; i < numTerms; ++i) {
-        const search::fef::TermFieldMatchData *term = inputs()[i];
-        if (term->getDocId() != docId || term->begin() == term->end()) {
-            LOG(debug, "No occurrences found for term %d.", i);
-            return false;
-        }
-        LOG(debug, "Got positions iterator for term %d.", i);
-        pos.push_back(term->begin());
+    if (!decodePositions(docId)) {
+        return false;
     }
+    uint32_t numTerms = _ends.size();
     if (numTerms < 2) return true; // 1 term is always near itself
 
-    int32_t remain = window();
-
-    TermFieldMatchDataPositionKey prevTermPos;
-    TermFieldMatchDataPositionKey curTermPos;
-    TermFieldMatchDataPositionKey lastAllowed;
+    _cur.resize(numTerms);
+    for (uint32_t i = 0; i < numTerms; ++i) {
+        _cur[i] = (i == 0) ? 0 : _ends[i - 1];
+    }
+    const uint64_t *keys = _keys.data();
+    uint64_t curTermPos = 0;
 
     // Look for match for every occurrence of the first term.
-    for ( ; pos[0] != inputs()[0]->end(); ++pos[0]) {
-        TermFieldMatchDataPositionKey firstTermPos = *pos[0];
-        lastAllowed = firstTermPos;
-        lastAllowed.setPosition(firstTermPos.getPosition() + remain);
+    for (uint32_t first = 0; first < _ends[0]; ++first) {
+        uint64_t firstTermPos = keys[first];
+        uint64_t lastAllowed = windowEnd(firstTermPos, window());
         if (lastAllowed < curTermPos) {
             // if we already know that we must seek onwards:
             continue;
         }
-        prevTermPos = firstTermPos;
-        LOG(spam, "Looking for match in window [%d, %d].",
-            firstTermPos.getPosition(), lastAllowed.getPosition());
+        uint64_t prevTermPos = firstTermPos;
         for (uint32_t i = 1; i < numTerms; ++i) {
-            LOG(spam, "Forwarding iterator for term %d beyond %d.", i, prevTermPos.getPosition());
-            while (pos[i] != inputs()[i]->end() && !(prevTermPos < *pos[i])) {
-                ++pos[i];
+            uint32_t pos = _cur[i];
+            uint32_t end = _ends[i];
+            while (pos != end && !(prevTermPos < keys[pos])) {
+                ++pos;
             }
-            if (pos[i] == inputs()[i]->end()) {
+            _cur[i] = pos;
+            if (pos == end) {
                 LOG(debug, "Reached end of occurrences for term %d without matching ONEAR.", i);
                 return false;
             }
-            curTermPos = *pos[i];
+            curTermPos = keys[pos];
             if (lastAllowed < curTermPos) {
                 // outside window
                 break;
             }
-            LOG(spam, "Current position for term %d is %d.", i, curTermPos.getPosition());
             if (i + 1 == numTerms) {
                 LOG(debug, "ONEAR match found for document %d.", docId);
                 // OK for all terms
@@ -297,8 +307,9 @@ ONearSearch::Matcher::match(uint32_t docId)
 bool
 ONearSearch::match(uint32_t docId)
 {
-    // Retrieve position iterators for each term.
-    doUnpack(docId);
+    if (!unpackChildren(docId)) {
+        return false;
+    }
     for (size_t i = 0; i < _matchers.size(); ++i) {
         if (_matchers[i].match(docId)) {
             return true;
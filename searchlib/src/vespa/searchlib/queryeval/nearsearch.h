@@ -20,18 +20,54 @@ protected:
 
     typedef search::fef::TermFieldMatchDataArray TermFieldMatchDataArray;
 
+    /**
+     * Term match data for each child, only set up when each child
+     * has exactly one term field (the common case). Used to stop
+     * unpacking children as soon as no field can match.
+     */
+    TermFieldMatchDataArray _childMatch;
+    std::vector<uint32_t>   _childField;  // field index for each child
+    std::vector<bool>       _fieldFailed; // per field, reused between documents
+
     class MatcherBase
     {
     private:
         uint32_t                _window;
         TermFieldMatchDataArray _inputs;
     protected:
+        /**
+         * The positions of all inputs are decoded into a single flat
+         * array of keys, ordered by element id and then position,
+         * to make the window checks plain integer compares.
+         */
+        std::vector<uint64_t>   _keys;
+        std::vector<uint32_t>   _ends; // end of the keys for each input
+        std::vector<uint32_t>   _cur;  // current key for each input
+
         uint32_t window() const { return _window; }
         const TermFieldMatchDataArray &inputs() const { return _inputs; }
+
+        static uint64_t makeKey(uint32_t elementId, uint32_t position) {
+            return (static_cast<uint64_t>(elementId) << 32) | position;
+        }
+        // last key allowed within the window starting at the given key
+        static uint64_t windowEnd(uint64_t key, uint32_t win) {
+            return (key & 0xffffffff00000000ul) | static_cast<uint32_t>(static_cast<uint32_t>(key) + win);
+        }
+
+        /**
+         * Decode the positions of all inputs for the given document.
+         *
+         * @return false if any input has no positions in the document
+         */
+        bool decodePositions(uint32_t docId);
     public:
         MatcherBase(uint32_t win, uint32_t fieldId, const TermFieldMatchDataArray &in)
             : _window(win),
-              _inputs()
+              _inputs(),
+              _keys(),
+              _ends(),
+              _cur()
         {
             for (size_t i = 0; i < in.size(); ++i) {
                 if (in[i]->getFieldId() == fieldId) {
@@ -41,11 +77,6 @@ protected:
         }
     };
 
-    /**
-     * Typedef the list of positions iterators because it takes far too much space to write out :-)
-     */
-    typedef std::vector<search::fef::TermFieldMatchData::PositionsIterator> PositionsIteratorList;
-
     /**
      * Returns whether or not given document matches. This should only be called when all child terms are all
      * at the same document.
@@ -63,6 +94,15 @@ protected:
      */
     void seekNext(uint32_t docId);
 
+    /**
+     * Unpacks all child terms for the given document. When term match
+     * data is known per child, unpacking stops as soon as a child
+     * without occurrences has made a match impossible in all fields.
+     *
+     * @return False if the document can not match.
+     */
+    bool unpackChildren(uint32_t docId);
+
 public:
     /**
      * Constructs a new search for the given term match data.
@@ -0,0 +1,157 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "search_profiler.h"
+#include "blueprint.h"
+#include "intermediate_blueprints.h"
+#include <vespa/searchlib/common/bitvector.h>
+#include <vespa/vespalib/data/slime/slime.h>
+#include <vespa/vespalib/objects/visit.h>
+#include <cassert>
+
+namespace search::queryeval {
+
+namespace {
+
+/**
+ * Forwards all calls to the wrapped iterator, counting seeks and
+ * unpacks and timing the calls selected by the profiler.
+ **/
+class ProfiledIterator : public SearchIterator
+{
+private:
+    SearchIterator::UP _search;
+    SearchProfiler    &_profiler;
+    uint32_t           _id;
+
+public:
+    ProfiledIterator(SearchIterator::UP search, SearchProfiler &profiler, uint32_t id)
+        : _search(std::move(search)), _profiler(profiler), _id(id) {}
+    void initRange(uint32_t begin_id, uint32_t end_id) override {
+        _search->initRange(begin_id, end_id);
+        SearchIterator::initRange(_search->getDocId() + 1, _search->getEndId());
+    }
+    void doSeek(uint32_t docid) override {
+        _profiler.seek(_id);
+        bool timed = _profiler.start(_id);
+        _search->seek(docid);
+        _profiler.complete(timed);
+        setDocId(_search->getDocId());
+    }
+    void doUnpack(uint32_t docid) override {
+        _profiler.unpack(_id);
+        bool timed = _profiler.start(_id);
+        _search->unpack(docid);
+        _profiler.complete(timed);
+    }
+    std::unique_ptr<BitVector> get_hits(uint32_t begin_id) override {
+        return _search->get_hits(begin_id);
+    }
+    void or_hits_into(BitVector &result, uint32_t begin_id) override {
+        _search->or_hits_into(result, begin_id);
+    }
+    void and_hits_into(BitVector &result, uint32_t begin_id) override {
+        _search->and_hits_into(result, begin_id);
+    }
+    Trinary is_strict() const override { return _search->is_strict(); }
+    const PostingInfo *getPostingInfo() const override { return _search->getPostingInfo(); }
+    void visitMembers(vespalib::ObjectVisitor &visitor) const override {
+        visit(visitor, "search", *_search);
+    }
+};
+
+// position based intermediate blueprints need normal features for
+// their children, and are profiled as a single node
+bool
+profile_children(const Blueprint &blueprint)
+{
+    return (blueprint.isIntermediate() &&
+            (dynamic_cast<const NearBlueprint *>(&blueprint) == nullptr) &&
+            (dynamic_cast<const ONearBlueprint *>(&blueprint) == nullptr));
+}
+
+}
+
+SearchProfiler::SearchProfiler(uint32_t sample_interval)
+    : _sample_interval(sample_interval),
+      _calls(0),
+      _depth(0),
+      _sampling(false),
+      _nodes(),
+      _stack()
+{
+    assert(_sample_interval > 0);
+}
+
+SearchProfiler::~SearchProfiler() = default;
+
+SearchIterator::UP
+SearchProfiler::create(const Blueprint &blueprint, fef::MatchData &md, bool strict, int32_t parent)
+{
+    uint32_t id = _nodes.size();
+    const Blueprint::State &state = blueprint.getState();
+    _nodes.emplace_back(blueprint.getClassName(), parent, strict, state.estimate().estHits, state.estimate().empty);
+    SearchIterator::UP search;
+    if (profile_children(blueprint)) {
+        const auto &intermediate = static_cast<const IntermediateBlueprint &>(blueprint);
+        MultiSearch::Children children;
+        children.reserve(intermediate.childCnt());
+        for (size_t i = 0; i < intermediate.childCnt(); ++i) {
+            bool strict_child = (strict && intermediate.inheritStrict(i));
+            children.push_back(create(intermediate.getChild(i), md, strict_child, id));
+        }
+        search = intermediate.createIntermediateSearch(std::move(children), strict, md);
+    } else {
+        search = blueprint.createSearch(md, strict);
+    }
+    _nodes[id].iterator = search->getClassName();
+    return std::make_unique<ProfiledIterator>(std::move(search), *this, id);
+}
+
+SearchIterator::UP
+SearchProfiler::create_search(const Blueprint &blueprint, fef::MatchData &md, bool strict)
+{
+    return create(blueprint, md, strict, -1);
+}
+
+void
+SearchProfiler::report_node(uint32_t id, const std::vector<std::vector<uint32_t>> &children,
+                            vespalib::slime::Cursor &obj) const
+{
+    const Node &node = _nodes[id];
+    obj.setString("blueprint", node.blueprint);
+    obj.setString("iterator", node.iterator);
+    obj.setBool("strict", node.strict);
+    obj.setLong("estimate", node.estimate);
+    obj.setBool("empty", node.empty);
+    obj.setLong("seeks", node.seeks);
+    obj.setLong("unpacks", node.unpacks);
+    obj.setLong("sampled_calls", node.sampled_calls);
+    obj.setDouble("self_time_ms", vespalib::count_ns(node.self_time) / 1000000.0);
+    obj.setDouble("total_time_ms", vespalib::count_ns(node.total_time) / 1000000.0);
+    if (!children[id].empty()) {
+        auto &arr = obj.setArray("children");
+        for (uint32_t child: children[id]) {
+            report_node(child, children, arr.addObject());
+        }
+    }
+}
+
+void
+SearchProfiler::report(vespalib::slime::Cursor &obj) const
+{
+    std::vector<std::vector<uint32_t>> children(_nodes.size());
+    obj.setLong("sample_interval", _sample_interval);
+    auto &roots = obj.setArray("roots");
+    for (uint32_t id = 0; id < _nodes.size(); ++id) {
+        if (_nodes[id].parent >= 0) {
+            children[_nodes[id].parent].push_back(id);
+        }
+    }
+    for (uint32_t id = 0; id < _nodes.size(); ++id) {
+        if (_nodes[id].parent < 0) {
+            report_node(id, children, roots.addObject());
+        }
+    }
+}
+
+}
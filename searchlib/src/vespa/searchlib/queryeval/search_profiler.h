@@ -0,0 +1,128 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include "searchiterator.h"
+#include <vespa/vespalib/stllike/string.h>
+#include <vespa/vespalib/util/time.h>
+#include <vector>
+
+namespace vespalib::slime { struct Cursor; }
+namespace search::fef { class MatchData; }
+
+namespace search::queryeval {
+
+class Blueprint;
+
+/**
+ * Profiles the search iterator tree created from a blueprint. Each
+ * iterator is wrapped in an iterator counting the seeks and unpacks
+ * done on it. Every sample_interval'th call into the profiled tree
+ * (with all nested calls done during that call) is also timed, to
+ * be able to report self time in addition to total time for each
+ * iterator. The report is a tree matching the iterator tree, with
+ * the blueprint estimates next to the actual counts.
+ *
+ * Iterators not created through this profiler are not affected, so
+ * there is no cost when profiling is not requested. A profiler is not
+ * thread safe; use one per match thread.
+ **/
+class SearchProfiler
+{
+private:
+    struct Node {
+        vespalib::string   blueprint;
+        vespalib::string   iterator;
+        int32_t            parent;
+        bool               strict;
+        uint32_t           estimate;
+        bool               empty;
+        size_t             seeks;
+        size_t             unpacks;
+        size_t             sampled_calls;
+        vespalib::duration total_time;
+        vespalib::duration self_time;
+        Node(const vespalib::string &blueprint_in, int32_t parent_in, bool strict_in,
+             uint32_t estimate_in, bool empty_in)
+            : blueprint(blueprint_in), iterator(), parent(parent_in), strict(strict_in), estimate(estimate_in),
+              empty(empty_in), seeks(0), unpacks(0), sampled_calls(0),
+              total_time(vespalib::duration::zero()), self_time(vespalib::duration::zero()) {}
+    };
+    struct Frame {
+        uint32_t              id;
+        vespalib::steady_time start;
+        vespalib::duration    nested_time;
+        Frame(uint32_t id_in, vespalib::steady_time start_in)
+            : id(id_in), start(start_in), nested_time(vespalib::duration::zero()) {}
+    };
+
+    uint32_t           _sample_interval;
+    size_t             _calls;
+    uint32_t           _depth;
+    bool               _sampling;
+    std::vector<Node>  _nodes;
+    std::vector<Frame> _stack;
+
+    SearchIterator::UP create(const Blueprint &blueprint, fef::MatchData &md, bool strict, int32_t parent);
+    void report_node(uint32_t id, const std::vector<std::vector<uint32_t>> &children,
+                     vespalib::slime::Cursor &obj) const;
+
+public:
+    SearchProfiler(uint32_t sample_interval);
+    ~SearchProfiler();
+
+    uint32_t sample_interval() const { return _sample_interval; }
+
+    /**
+     * Create a profiled search iterator tree for the given blueprint.
+     * Each call adds a new root to the profile.
+     **/
+    SearchIterator::UP create_search(const Blueprint &blueprint, fef::MatchData &md, bool strict);
+
+    void seek(uint32_t id) { ++_nodes[id].seeks; }
+    void unpack(uint32_t id) { ++_nodes[id].unpacks; }
+
+    /**
+     * Start a call to the given iterator. Returns true if the call is
+     * timed; only top-level calls into the profiled tree are selected
+     * for timing, and nested calls are timed along with them. Each
+     * start must be followed by a complete with the returned value.
+     **/
+    bool start(uint32_t id) {
+        if (_depth++ == 0) {
+            _sampling = ((++_calls % _sample_interval) == 0);
+        }
+        if (_sampling) {
+            _stack.emplace_back(id, vespalib::steady_clock::now());
+        }
+        return _sampling;
+    }
+    void complete(bool timed) {
+        --_depth;
+        if (!timed) {
+            return;
+        }
+        const Frame &frame = _stack.back();
+        vespalib::duration time = vespalib::steady_clock::now() - frame.start;
+        Node &node = _nodes[frame.id];
+        ++node.sampled_calls;
+        node.total_time += time;
+        node.self_time += (time - frame.nested_time);
+        _stack.pop_back();
+        if (!_stack.empty()) {
+            _stack.back().nested_time += time;
+        }
+    }
+
+    size_t num_nodes() const { return _nodes.size(); }
+    size_t seeks(uint32_t id) const { return _nodes[id].seeks; }
+    size_t unpacks(uint32_t id) const { return _nodes[id].unpacks; }
+    size_t sampled_calls(uint32_t id) const { return _nodes[id].sampled_calls; }
+
+    /**
+     * Report the profiled iterator trees into the given object.
+     **/
+    void report(vespalib::slime::Cursor &obj) const;
+};
+
+}
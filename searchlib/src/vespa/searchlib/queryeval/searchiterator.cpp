@@ -8,9 +8,54 @@
 #include <vespa/vespalib/util/classname.h>
 #include <vespa/searchlib/common/bitvector.h>
 #include <vespa/vespalib/data/slime/inserter.h>
+#include <vespa/vespalib/util/stash.h>
 
 namespace search::queryeval {
 
+namespace {
+
+// Every iterator is prefixed with the stash it was allocated from,
+// or nullptr when allocated from the heap.
+constexpr size_t ALLOC_HEADER_SIZE = 16;
+
+thread_local vespalib::Stash *_arena = nullptr;
+
+}
+
+SearchIterator::ArenaScope::ArenaScope(vespalib::Stash &stash)
+    : _prev(_arena)
+{
+    _arena = &stash;
+}
+
+SearchIterator::ArenaScope::~ArenaScope()
+{
+    _arena = _prev;
+}
+
+void *
+SearchIterator::operator new(size_t size)
+{
+    vespalib::Stash *arena = _arena;
+    char *mem = (arena != nullptr)
+                ? arena->alloc(ALLOC_HEADER_SIZE + size)
+                : static_cast<char *>(::operator new(ALLOC_HEADER_SIZE + size));
+    *reinterpret_cast<vespalib::Stash **>(mem) = arena;
+    return mem + ALLOC_HEADER_SIZE;
+}
+
+void
+SearchIterator::operator delete(void *ptr) noexcept
+{
+    if (ptr == nullptr) {
+        return;
+    }
+    char *mem = static_cast<char *>(ptr) - ALLOC_HEADER_SIZE;
+    if (*reinterpret_cast<vespalib::Stash **>(mem) == nullptr) {
+        ::operator delete(mem);
+    }
+}
+
 BitVector::UP
 SearchIterator::get_hits(uint32_t begin_id)
 {
@@ -87,6 +132,16 @@ SearchIterator::and_hits_into(BitVector &result, uint32_t begin_id)
     }
 }
 
+uint32_t
+SearchIterator::fill_docid_block(uint32_t begin_id, uint32_t *docids, uint32_t max_docids)
+{
+    uint32_t num_docids = 0;
+    for (seek(begin_id); (num_docids < max_docids) && !isAtEnd(); seek(getDocId() + 1)) {
+        docids[num_docids++] = getDocId();
+    }
+    return num_docids;
+}
+
 vespalib::string
 SearchIterator::asString() const
 {
@@ -9,7 +9,10 @@
 #include <memory>
 #include <vector>
 
-namespace vespalib { class ObjectVisitor; }
+namespace vespalib {
+    class ObjectVisitor;
+    class Stash;
+}
 namespace vespalib::slime {
     struct Cursor;
     struct Inserter;
@@ -174,6 +177,23 @@ public:
      **/
     virtual void and_hits_into(BitVector &result, uint32_t begin_id);
 
+    /**
+     * Copy the next hits, starting at begin_id, into the given
+     * buffer in increasing order. At most max_docids hits are copied,
+     * and only hits inside the currently searched range. Returning
+     * fewer than max_docids hits means that this iterator has no more
+     * hits in the range. Afterwards the iterator is positioned at the
+     * first hit that was not copied (or at the end). This should only
+     * be called on strict iterators, and is used to intersect posting
+     * lists a block at a time without a virtual seek per document.
+     *
+     * @return number of hits copied into docids
+     * @param begin_id the lowest document id that may be copied
+     * @param docids buffer receiving the hits
+     * @param max_docids capacity of the buffer
+     **/
+    virtual uint32_t fill_docid_block(uint32_t begin_id, uint32_t *docids, uint32_t max_docids);
+
 public:
     typedef std::unique_ptr<SearchIterator> UP;
 
@@ -328,6 +348,28 @@ public:
      **/
     virtual ~SearchIterator() = default;
 
+    /**
+     * While an ArenaScope is alive, search iterators created by the
+     * current thread are allocated from the given stash instead of
+     * the heap. Deleting such an iterator only runs its destructor,
+     * the memory is released together with the stash, which must
+     * outlive all iterators created in the scope. Used to build the
+     * iterator tree of a query with a single bump allocator.
+     **/
+    class ArenaScope {
+    private:
+        vespalib::Stash *_prev;
+    public:
+        explicit ArenaScope(vespalib::Stash &stash);
+        ArenaScope(const ArenaScope &) = delete;
+        ArenaScope &operator=(const ArenaScope &) = delete;
+        ~ArenaScope();
+    };
+    static void *operator new(size_t size);
+    static void *operator new(size_t, void *ptr) noexcept { return ptr; }
+    static void operator delete(void *ptr) noexcept;
+    static void operator delete(void *, void *) noexcept { }
+
     /**
      * @return true if it is a bitvector
      */
@@ -340,6 +382,11 @@ public:
      * @return true if it is a multi search
      */
     virtual bool isMultiSearch() const { return false; }
+    /**
+     * @return true if fill_docid_block is implemented without seeking
+     *         through the virtual seek interface for each hit
+     */
+    virtual bool has_fast_docid_block() const { return false; }
 
     /**
      * This is used for adding an extra filter. If it is accepted it will return an empty UP.
@@ -64,6 +64,14 @@ SimplePhraseBlueprint::createLeafSearch(const fef::TermFieldMatchDataArray &tfmd
     SimplePhraseSearch::Children children;
     children.reserve(_terms.size());
     std::multimap<uint32_t, uint32_t> order_map;
+    for (size_t i = 0; i < _terms.size(); ++i) {
+        order_map.insert(std::make_pair(_terms[i]->getState().estimate().estHits, i));
+    }
+    std::vector<uint32_t> eval_order;
+    for (const auto & child : order_map) {
+        eval_order.push_back(child.second);
+    }
+    // only the term with fewest hits drives a strict phrase search
     for (size_t i = 0; i < _terms.size(); ++i) {
         const State &childState = _terms[i]->getState();
         assert(childState.numFields() == 1);
@@ -71,14 +79,9 @@ SimplePhraseBlueprint::createLeafSearch(const fef::TermFieldMatchDataArray &tfmd
         child_term_field_match_data->setNeedInterleavedFeatures(tfmda[0]->needs_interleaved_features());
         child_term_field_match_data->setNeedNormalFeatures(true);
         childMatch.add(child_term_field_match_data);
-        children.push_back(_terms[i]->createSearch(*md, strict));
-        order_map.insert(std::make_pair(childState.estimate().estHits, i));
-    }
-    std::vector<uint32_t> eval_order;
-    for (const auto & child : order_map) {
-        eval_order.push_back(child.second);
+        children.push_back(_terms[i]->createSearch(*md, strict && (i == eval_order[0])));
     }
-    
+
     auto phrase = std::make_unique<SimplePhraseSearch>(std::move(children),
                                                        std::move(md), childMatch,
                                                        eval_order, *tfmda[0], strict);
@@ -90,11 +93,16 @@ SearchIterator::UP
 SimplePhraseBlueprint::createFilterSearch(bool strict, FilterConstraint constraint) const
 {
     if (constraint == FilterConstraint::UPPER_BOUND) {
+        // the term with fewest hits goes first, driving a strict search
+        std::multimap<uint32_t, uint32_t> order_map;
+        for (size_t i = 0; i < _terms.size(); ++i) {
+            order_map.insert(std::make_pair(_terms[i]->getState().estimate().estHits, i));
+        }
         MultiSearch::Children children;
         children.reserve(_terms.size());
-        for (size_t i = 0; i < _terms.size(); ++i) {
-            bool child_strict = strict && (i == 0);
-            children.push_back(_terms[i]->createFilterSearch(child_strict, constraint));
+        for (const auto & child : order_map) {
+            bool child_strict = strict && children.empty();
+            children.push_back(_terms[child.second]->createFilterSearch(child_strict, constraint));
         }
         UnpackInfo unpack_info;
         return AndSearch::create(std::move(children), strict, unpack_info);
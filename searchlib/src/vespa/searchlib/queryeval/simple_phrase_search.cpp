@@ -140,6 +140,22 @@ allTermsHaveMatch(const SimplePhraseSearch::Children &terms, const vector<uint32
     }
     return true;
 }
+
+// Unpack terms in evaluation order. A phrase with more than one term
+// can not match if any term lacks positions, so stop at the first one.
+bool
+unpackAllTerms(const SimplePhraseSearch::Children &terms, const fef::TermFieldMatchDataArray &childMatch,
+               const vector<uint32_t> &eval_order, uint32_t doc_id)
+{
+    for (uint32_t i = 0; i < terms.size(); ++i) {
+        uint32_t word_index = eval_order[i];
+        terms[word_index]->doUnpack(doc_id);
+        if ((terms.size() > 1) && (childMatch[word_index]->begin() == childMatch[word_index]->end())) {
+            return false;
+        }
+    }
+    return true;
+}
 }  // namespace
 
 void
@@ -148,8 +164,9 @@ SimplePhraseSearch::phraseSeek(uint32_t doc_id) {
         if (doom()) {
             setAtEnd();
         } else {
-            AndSearch::doUnpack(doc_id);
-            if (PhraseMatcher(_childMatch, _eval_order, _iterators).hasMatch()) {
+            if (unpackAllTerms(getChildren(), _childMatch, _eval_order, doc_id) &&
+                PhraseMatcher(_childMatch, _eval_order, _iterators).hasMatch())
+            {
                 setDocId(doc_id);
             }
         }
@@ -180,10 +197,11 @@ void
 SimplePhraseSearch::doSeek(uint32_t doc_id) {
     phraseSeek(doc_id);
     if (_strict) {
+        SearchIterator &driver = *getChildren()[_eval_order[0]];
         uint32_t next_candidate = doc_id;
         while (getDocId() < doc_id || getDocId() == beginId()) {
-            getChildren()[0]->seek(next_candidate + 1);
-            next_candidate = getChildren()[0]->getDocId();
+            driver.seek(next_candidate + 1);
+            next_candidate = driver.getDocId();
             if (isAtEnd(next_candidate)) {
                 setAtEnd();
                 return;
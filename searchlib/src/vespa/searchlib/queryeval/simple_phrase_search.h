@@ -35,7 +35,9 @@ class SimplePhraseSearch : public AndSearch
 public:
     /**
      * Takes ownership of the contents of children.
-     * If this iterator is strict, the first child also needs to be strict.
+     * If this iterator is strict, the first child in evaluation order
+     * also needs to be strict. It drives the search, while the other
+     * children are only used to verify candidates.
      *
      * @param children SearchIterator objects for each child.
      * @param tmds TermFieldMatchData for the children.
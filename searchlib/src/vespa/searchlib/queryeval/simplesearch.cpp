@@ -31,6 +31,13 @@ SimpleSearch::SimpleSearch(const SimpleResult &result)
 {
 }
 
+void
+SimpleSearch::initRange(uint32_t begin_id, uint32_t end_id)
+{
+    SearchIterator::initRange(begin_id, end_id);
+    _index = 0;
+}
+
 void
 SimpleSearch::visitMembers(vespalib::ObjectVisitor &visitor) const
 {
@@ -31,6 +31,7 @@ public:
         _tag = t;
         return *this;
     }
+    void initRange(uint32_t begin_id, uint32_t end_id) override;
     void visitMembers(vespalib::ObjectVisitor &visitor) const override;
     ~SimpleSearch();
 };
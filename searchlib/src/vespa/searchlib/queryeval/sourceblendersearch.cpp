@@ -24,7 +24,8 @@ public:
     SourceBlenderSearchStrict(std::unique_ptr<Iterator> sourceSelector, const Children &children);
 private:
     VESPA_DLL_LOCAL void advance() __attribute__((noinline));
-    vespalib::Array<SearchIterator *>  _nextChildren;
+    VESPA_DLL_LOCAL void seekChild(Source source, uint32_t docid);
+    vespalib::Array<Source>  _nextChildren;
 
     void doSeek(uint32_t docid) override;
     Trinary is_strict() const override { return Trinary::True; }
@@ -64,29 +65,41 @@ SourceBlenderSearchStrict::doSeek(uint32_t docid)
         setDocId(docid);
     } else {
         for (auto & child : _children) {
-            getSearch(child)->seek(docid);
+            seekChild(child, docid);
         }
         advance();
     }
 }
 
+/**
+ * Hits for documents selected from other sources are never used, so
+ * a child only needs to look for hits from the first document after
+ * docid that is selected from its own source.
+ **/
+void
+SourceBlenderSearchStrict::seekChild(Source source, uint32_t docid)
+{
+    SearchIterator * search = getSearch(source);
+    if (search->getDocId() < docid) {
+        search->seek(_sourceSelector->findNextForSource(docid, getEndId(), source));
+    }
+}
+
 void
 SourceBlenderSearchStrict::advance()
 {
     for (;;) {
-        SearchIterator * search = getSearch(_children[0]);
-        uint32_t minNextId = search->getDocId();
+        uint32_t minNextId = getSearch(_children[0])->getDocId();
         _nextChildren.clear();
-        _nextChildren.push_back_fast(search);
+        _nextChildren.push_back_fast(_children[0]);
         for (uint32_t i = 1; i < _children.size(); ++i) {
-            search = getSearch(_children[i]);
-            uint32_t nextId = search->getDocId();
+            uint32_t nextId = getSearch(_children[i])->getDocId();
             if (nextId < minNextId) {
                 minNextId = nextId;
                 _nextChildren.clear();
-                _nextChildren.push_back_fast(search);
+                _nextChildren.push_back_fast(_children[i]);
             } else if (nextId == minNextId) {
-                _nextChildren.push_back_fast(search);
+                _nextChildren.push_back_fast(_children[i]);
             }
         }
         if (isAtEnd(minNextId)) {
@@ -97,14 +110,14 @@ SourceBlenderSearchStrict::advance()
             setAtEnd();
             return;
         }
-        search = getSearch(_sourceSelector->getSource(minNextId));
-        for (SearchIterator * child : _nextChildren) {
-            if (child == search) {
-                _matchedChild = search;
+        Source source = _sourceSelector->getSource(minNextId);
+        for (Source child : _nextChildren) {
+            if (child == source) {
+                _matchedChild = getSearch(source);
                 setDocId(minNextId);
                 return;
             }
-            child->seek(minNextId + 1);
+            seekChild(child, minNextId + 1);
         }
     }
 }
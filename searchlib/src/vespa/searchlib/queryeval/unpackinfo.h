@@ -3,6 +3,7 @@
 #pragma once
 
 #include <vespa/vespalib/stllike/string.h>
+#include <vector>
 
 namespace search::queryeval {
 
@@ -61,6 +62,7 @@ struct NoUnpack {
     }
     void onRemove(size_t index) { (void) index; }
     void onInsert(size_t index) { (void) index; }
+    void onReorder(const std::vector<size_t> &order) { (void) order; }
     bool needUnpack(size_t index) const { (void) index; return false; }
 };
 
@@ -3,6 +3,7 @@
 #include "weighted_set_term_blueprint.h"
 #include "weighted_set_term_search.h"
 #include "orsearch.h"
+#include "flat_posting_merger.h"
 #include "matching_elements_search.h"
 #include <vespa/searchlib/common/matching_elements.h>
 #include <vespa/searchlib/common/matching_elements_fields.h>
@@ -107,7 +108,8 @@ WeightedSetTermBlueprint::createLeafSearch(const fef::TermFieldMatchDataArray &t
         // TODO: pass ownership with unique_ptr
         children[i] = _terms[i]->createSearch(*md, true).release();
     }
-    return SearchIterator::UP(WeightedSetTermSearch::create(children, *tfmda[0], _weights, std::move(md)));
+    return SearchIterator::UP(WeightedSetTermSearch::create(children, *tfmda[0], _weights, std::move(md),
+                                                            FlatPostingMergerBase::should_use(_terms.size())));
 }
 
 SearchIterator::UP
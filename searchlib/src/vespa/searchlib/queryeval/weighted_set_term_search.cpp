@@ -1,6 +1,7 @@
 // Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 
 #include "weighted_set_term_search.h"
+#include "flat_posting_merger.h"
 #include <vespa/searchlib/common/bitvector.h>
 #include <vespa/vespalib/objects/visit.h>
 #include <vespa/searchcommon/attribute/i_search_context.h>
@@ -13,6 +14,22 @@ using vespalib::ObjectVisitor;
 
 namespace search::queryeval {
 
+namespace {
+
+void
+get_matching_elements_child(uint32_t child, uint32_t docId, const std::vector<Blueprint *> &child_blueprints, std::vector<uint32_t> &dst)
+{
+    auto *sc = child_blueprints[child]->get_attribute_search_context();
+    if (sc != nullptr) {
+        int32_t weight(0);
+        for (int32_t id = sc->find(docId, 0, weight); id >= 0; id = sc->find(docId, id + 1, weight)) {
+            dst.push_back(id);
+        }
+    }
+}
+
+}
+
 template <typename HEAP, typename IteratorPack>
 class WeightedSetTermSearchImpl : public WeightedSetTermSearch
 {
@@ -49,15 +66,6 @@ private:
     void seek_child(ref_t child, uint32_t docId) {
         _termPos[child] = _children.seek(child, docId);
     }
-    void get_matching_elements_child(ref_t child, uint32_t docId, const std::vector<Blueprint *> &child_blueprints, std::vector<uint32_t> &dst) {
-        auto *sc = child_blueprints[child]->get_attribute_search_context();
-        if (sc != nullptr) {
-            int32_t weight(0);
-            for (int32_t id = sc->find(docId, 0, weight); id >= 0; id = sc->find(docId, id + 1, weight)) {
-                dst.push_back(id);
-            }
-        }
-    }
 
 public:
     WeightedSetTermSearchImpl(search::fef::TermFieldMatchData &tmd,
@@ -152,15 +160,88 @@ public:
 
 //-----------------------------------------------------------------------------
 
+/**
+ * Weighted set term search merging its children with a
+ * FlatPostingMerger instead of a heap.
+ **/
+template <typename IteratorPack>
+class FlatWeightedSetTermSearchImpl : public WeightedSetTermSearch
+{
+private:
+    using Merger = FlatPostingMerger<IteratorPack>;
+    using Entry = typename Merger::Entry;
+
+    fef::TermFieldMatchData &_tmd;
+    std::vector<int32_t>     _weights;
+    std::vector<int32_t>     _matchingWeights;
+    Merger                   _children;
+
+public:
+    FlatWeightedSetTermSearchImpl(search::fef::TermFieldMatchData &tmd,
+                                  const std::vector<int32_t> &weights,
+                                  IteratorPack &&iteratorPack)
+        : _tmd(tmd),
+          _weights(weights),
+          _matchingWeights(),
+          _children(std::move(iteratorPack), false)
+    {
+        assert(_children.size() > 0);
+        assert(_children.size() == _weights.size());
+        _tmd.reservePositions(_children.size());
+    }
+
+    void doSeek(uint32_t docId) override {
+        setDocId(_children.seek(docId));
+    }
+
+    void doUnpack(uint32_t docId) override {
+        _tmd.reset(docId);
+        _matchingWeights.clear();
+        for (const Entry *entry = _children.current(); (entry < _children.window_end()) && (entry->docid == docId); ++entry) {
+            _matchingWeights.push_back(_weights[entry->child]);
+        }
+        std::sort(_matchingWeights.begin(), _matchingWeights.end(), std::greater<int32_t>());
+        for (int32_t weight : _matchingWeights) {
+            fef::TermFieldMatchDataPosition pos;
+            pos.setElementWeight(weight);
+            _tmd.appendPosition(pos);
+        }
+    }
+
+    void initRange(uint32_t begin, uint32_t end) override {
+        WeightedSetTermSearch::initRange(begin, end);
+        _children.initRange(begin, end);
+    }
+    Trinary is_strict() const override { return Trinary::True; }
+
+    void visitMembers(vespalib::ObjectVisitor &) const override { }
+
+    void find_matching_elements(uint32_t docId, const std::vector<Blueprint *>& child_blueprints, std::vector<uint32_t> &dst) override {
+        if (_children.seek(docId) != docId) {
+            return;
+        }
+        for (const Entry *entry = _children.current(); (entry < _children.window_end()) && (entry->docid == docId); ++entry) {
+            get_matching_elements_child(entry->child, docId, child_blueprints, dst);
+        }
+    }
+};
+
+//-----------------------------------------------------------------------------
+
 SearchIterator::UP
 WeightedSetTermSearch::create(const std::vector<SearchIterator *> &children,
                               TermFieldMatchData &tmd,
                               const std::vector<int32_t> &weights,
-                              fef::MatchData::UP match_data)
+                              fef::MatchData::UP match_data,
+                              bool use_flat_merge)
 {
     typedef WeightedSetTermSearchImpl<vespalib::LeftArrayHeap, SearchIteratorPack> ArrayHeapImpl;
     typedef WeightedSetTermSearchImpl<vespalib::LeftHeap, SearchIteratorPack> HeapImpl;
+    typedef FlatWeightedSetTermSearchImpl<SearchIteratorPack> FlatImpl;
 
+    if (use_flat_merge) {
+        return SearchIterator::UP(new FlatImpl(tmd, weights, SearchIteratorPack(children, std::move(match_data))));
+    }
     if (children.size() < 128) {
         return SearchIterator::UP(new ArrayHeapImpl(tmd, weights, SearchIteratorPack(children, std::move(match_data))));
     }
@@ -172,10 +253,16 @@ WeightedSetTermSearch::create(const std::vector<SearchIterator *> &children,
 SearchIterator::UP
 WeightedSetTermSearch::create(search::fef::TermFieldMatchData &tmd,
                               const std::vector<int32_t> &weights,
-                              std::vector<DocumentWeightIterator> &&iterators)
+                              std::vector<DocumentWeightIterator> &&iterators,
+                              bool use_flat_merge)
 {
     typedef WeightedSetTermSearchImpl<vespalib::LeftArrayHeap, AttributeIteratorPack> ArrayHeapImpl;
     typedef WeightedSetTermSearchImpl<vespalib::LeftHeap, AttributeIteratorPack> HeapImpl;
+    typedef FlatWeightedSetTermSearchImpl<AttributeIteratorPack> FlatImpl;
+
+    if (use_flat_merge) {
+        return SearchIterator::UP(new FlatImpl(tmd, weights, AttributeIteratorPack(std::move(iterators))));
+    }
 
     if (iterators.size() < 128) {
         return SearchIterator::UP(new ArrayHeapImpl(tmd, weights, AttributeIteratorPack(std::move(iterators))));
@@ -30,14 +30,17 @@ protected:
 
 public:
     // TODO: pass ownership with unique_ptr
+    // use_flat_merge selects FlatPostingMerger instead of a heap to merge the children
     static SearchIterator::UP create(const std::vector<SearchIterator *> &children,
                                      search::fef::TermFieldMatchData &tmd,
                                      const std::vector<int32_t> &weights,
-                                     fef::MatchData::UP match_data);
+                                     fef::MatchData::UP match_data,
+                                     bool use_flat_merge = false);
 
     static SearchIterator::UP create(search::fef::TermFieldMatchData &tmd,
                                      const std::vector<int32_t> &weights,
-                                     std::vector<DocumentWeightIterator> &&iterators);
+                                     std::vector<DocumentWeightIterator> &&iterators,
+                                     bool use_flat_merge = false);
 
     // used during docsum fetching to identify matching elements
     // initRange must be called before use.
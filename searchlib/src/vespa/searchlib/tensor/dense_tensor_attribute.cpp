@@ -5,6 +5,8 @@
 #include "nearest_neighbor_index.h"
 #include "nearest_neighbor_index_saver.h"
 #include "tensor_attribute.hpp"
+#include <vespa/eval/tensor/cell_values.h>
+#include <vespa/eval/tensor/dense/dense_tensor_address_mapper.h>
 #include <vespa/eval/tensor/dense/dense_tensor_view.h>
 #include <vespa/eval/tensor/dense/mutable_dense_tensor_view.h>
 #include <vespa/eval/tensor/tensor.h>
@@ -12,6 +14,11 @@
 #include <vespa/searchlib/attribute/load_utils.h>
 #include <vespa/searchlib/attribute/readerbase.h>
 #include <vespa/vespalib/data/slime/inserter.h>
+#include <vespa/vespalib/util/count_down_latch.h>
+#include <vespa/vespalib/util/executor.h>
+#include <vespa/vespalib/util/lambdatask.h>
+#include <algorithm>
+#include <cstring>
 
 #include <vespa/log/log.h>
 LOG_SETUP(".searchlib.tensor.dense_tensor_attribute");
@@ -19,6 +26,8 @@ LOG_SETUP(".searchlib.tensor.dense_tensor_attribute");
 using search::attribute::LoadUtils;
 using vespalib::eval::ValueType;
 using vespalib::slime::ObjectInserter;
+using vespalib::tensor::CellValues;
+using vespalib::tensor::DenseTensorAddressMapper;
 using vespalib::tensor::DenseTensorView;
 using vespalib::tensor::MutableDenseTensorView;
 using vespalib::tensor::Tensor;
@@ -28,6 +37,8 @@ namespace search::tensor {
 namespace {
 
 constexpr uint32_t DENSE_TENSOR_ATTRIBUTE_VERSION = 1;
+// Upper bound on documents prepared concurrently when rebuilding the nearest neighbor index.
+constexpr uint32_t MAX_INDEX_BUILD_BATCH_SIZE = 512;
 const vespalib::string tensorTypeTag("tensortype");
 
 class BlobSequenceReader : public ReaderBase
@@ -76,6 +87,42 @@ can_use_index_save_file(const search::attribute::Config &config, const search::a
     return true;
 }
 
+/*
+ * Applies a join function to the cells visited, in a cell buffer that
+ * is not yet visible to readers.
+ */
+template <typename CT>
+class CellModifier : public vespalib::tensor::TensorVisitor
+{
+    TensorAttribute::join_fun_t _op;
+    const ValueType &_type;
+    CT *_cells;
+public:
+    CellModifier(TensorAttribute::join_fun_t op, const ValueType &type, CT *cells)
+        : _op(op),
+          _type(type),
+          _cells(cells)
+    {
+    }
+    void visit(const vespalib::tensor::TensorAddress &address, double value) override {
+        uint32_t idx = DenseTensorAddressMapper::mapAddressToIndex(address, _type);
+        if (idx != DenseTensorAddressMapper::BAD_ADDRESS) {
+            _cells[idx] = (CT) _op(_cells[idx], value);
+        }
+    }
+};
+
+struct CallModifyCells
+{
+    template <typename CT>
+    static void
+    call(const vespalib::ConstArrayRef<CT> &arr, TensorAttribute::join_fun_t op, const ValueType &type, const CellValues &cells)
+    {
+        CellModifier<CT> modifier(op, type, const_cast<CT *>(arr.begin()));
+        cells.accept(modifier);
+    }
+};
+
 }
 
 void
@@ -108,7 +155,7 @@ DenseTensorAttribute::memory_usage() const
 DenseTensorAttribute::DenseTensorAttribute(vespalib::stringref baseFileName, const Config& cfg,
                                            const NearestNeighborIndexFactory& index_factory)
     : TensorAttribute(baseFileName, cfg, _denseTensorStore),
-      _denseTensorStore(cfg.tensorType()),
+      _denseTensorStore(cfg.tensorType(), make_memory_allocator()),
       _index()
 {
     if (cfg.hnsw_index_params().has_value()) {
@@ -164,6 +211,39 @@ DenseTensorAttribute::complete_set_tensor(DocId docid, const Tensor& tensor,
     }
 }
 
+bool
+DenseTensorAttribute::modify_tensor(DocId docid, join_fun_t op, const CellValues& cells)
+{
+    EntryRef old_ref;
+    if (docid < _refVector.size()) {
+        old_ref = _refVector[docid];
+    }
+    if (!old_ref.valid()) {
+        return false;
+    }
+    // Readers may still use the old cells, so they are modified in a copy
+    // that is published by swapping the reference, as when setting a tensor.
+    auto raw = _denseTensorStore.allocRawBuffer();
+    memcpy(raw.data, _denseTensorStore.getRawBuffer(old_ref), _denseTensorStore.getBufSize());
+    vespalib::tensor::TypedCells new_cells(raw.data, _denseTensorStore.type().cell_type(), _denseTensorStore.getNumCells());
+    vespalib::tensor::dispatch_1<CallModifyCells>(new_cells, op, _denseTensorStore.type(), cells);
+    bool relink = false;
+    if (_index) {
+        double threshold = getConfig().hnsw_index_params().value().relink_distance_threshold();
+        const auto *distance_function = _index->distance_function();
+        relink = (distance_function == nullptr) ||
+                 (distance_function->calc(_denseTensorStore.get_typed_cells(old_ref), new_cells) > threshold);
+    }
+    if (relink) {
+        _index->remove_document(docid);
+    }
+    setTensorRef(docid, raw.ref);
+    if (relink) {
+        _index->add_document(docid);
+    }
+    return true;
+}
+
 std::unique_ptr<Tensor>
 DenseTensorAttribute::getTensor(DocId docId) const
 {
@@ -188,7 +268,7 @@ DenseTensorAttribute::extract_dense_view(DocId docId, MutableDenseTensorView &te
 }
 
 bool
-DenseTensorAttribute::onLoad()
+DenseTensorAttribute::onLoad(vespalib::Executor *executor)
 {
     BlobSequenceReader tensorReader(*this);
     if (!tensorReader.hasData()) {
@@ -209,7 +289,7 @@ DenseTensorAttribute::onLoad()
             auto raw = _denseTensorStore.allocRawBuffer();
             tensorReader.readTensor(raw.data, _denseTensorStore.getBufSize());
             _refVector.push_back(raw.ref);
-            if (_index && !use_index_file) {
+            if (_index && !use_index_file && executor == nullptr) {
                 // This ensures that get_vector() (via getTensor()) is able to find the newly added tensor.
                 setCommittedDocIdLimit(lid + 1);
                 _index->add_document(lid);
@@ -220,15 +300,58 @@ DenseTensorAttribute::onLoad()
     }
     setNumDocs(numDocs);
     setCommittedDocIdLimit(numDocs);
+    if (_index && !use_index_file && executor != nullptr) {
+        build_index(*executor, numDocs);
+    }
     if (_index && use_index_file) {
         auto buffer = LoadUtils::loadFile(*this, DenseTensorAttributeSaver::index_file_suffix());
-        if (!_index->load(*buffer)) {
+        if (!_index->load(std::move(buffer))) {
             return false;
         }
     }
     return true;
 }
 
+void
+DenseTensorAttribute::build_index(vespalib::Executor& executor, uint32_t docid_limit)
+{
+    // The prepare step (graph search) is run in parallel for a batch of documents,
+    // while the complete step (link updates) is done by this thread in docid order.
+    // Documents in the same batch cannot see each other, so the batch size is kept
+    // small compared to the number of documents already in the index.
+    std::vector<uint32_t> batch;
+    std::vector<std::unique_ptr<PrepareResult>> prepared;
+    uint32_t indexed = 0;
+    uint32_t docid = 0;
+    while (docid < docid_limit) {
+        uint32_t batch_size = std::clamp(indexed / 16, 1u, MAX_INDEX_BUILD_BATCH_SIZE);
+        batch.clear();
+        for (; docid < docid_limit && batch.size() < batch_size; ++docid) {
+            if (_refVector[docid].valid()) {
+                batch.push_back(docid);
+            }
+        }
+        prepared.clear();
+        prepared.resize(batch.size());
+        vespalib::CountDownLatch latch(batch.size());
+        for (size_t i = 0; i < batch.size(); ++i) {
+            auto task = vespalib::makeLambdaTask([this, &batch, &prepared, &latch, i]() {
+                prepared[i] = _index->prepare_add_document(batch[i], get_vector(batch[i]),
+                                                           getGenerationHandler().takeGuard());
+                latch.countDown();
+            });
+            auto rejected = executor.execute(std::move(task));
+            if (rejected) {
+                rejected->run();
+            }
+        }
+        latch.await();
+        for (size_t i = 0; i < batch.size(); ++i) {
+            _index->complete_add_document(batch[i], std::move(prepared[i]));
+        }
+        indexed += batch.size();
+    }
+}
 
 std::unique_ptr<AttributeSaver>
 DenseTensorAttribute::onInitSave(vespalib::stringref fileName)
@@ -295,4 +418,10 @@ DenseTensorAttribute::get_vector(uint32_t docid) const
     return _denseTensorStore.get_typed_cells(ref);
 }
 
+void
+DenseTensorAttribute::prefetch_vector(uint32_t docid) const
+{
+    _denseTensorStore.prefetch(_refVector[docid]);
+}
+
 }
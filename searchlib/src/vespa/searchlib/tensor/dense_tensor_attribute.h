@@ -25,6 +25,7 @@ private:
 
     void internal_set_tensor(DocId docid, const Tensor& tensor);
     void consider_remove_from_index(DocId docid);
+    void build_index(vespalib::Executor& executor, uint32_t docid_limit);
     vespalib::MemoryUsage memory_usage() const override;
 
 public:
@@ -36,10 +37,11 @@ public:
     void setTensor(DocId docId, const Tensor &tensor) override;
     std::unique_ptr<PrepareResult> prepare_set_tensor(DocId docid, const Tensor& tensor) const override;
     void complete_set_tensor(DocId docid, const Tensor& tensor, std::unique_ptr<PrepareResult> prepare_result) override;
+    bool modify_tensor(DocId docid, join_fun_t op, const vespalib::tensor::CellValues& cells) override;
     std::unique_ptr<Tensor> getTensor(DocId docId) const override;
     void extract_dense_view(DocId docId, vespalib::tensor::MutableDenseTensorView &tensor) const override;
     bool supports_extract_dense_view() const override { return true; }
-    bool onLoad() override;
+    bool onLoad(vespalib::Executor *executor) override;
     std::unique_ptr<AttributeSaver> onInitSave(vespalib::stringref fileName) override;
     void compactWorst() override;
     uint32_t getVersion() const override;
@@ -49,6 +51,7 @@ public:
 
     // Implements DocVectorAccess
     vespalib::tensor::TypedCells get_vector(uint32_t docid) const override;
+    void prefetch_vector(uint32_t docid) const override;
 
     const NearestNeighborIndex* nearest_neighbor_index() const { return _index.get(); }
 };
@@ -7,6 +7,8 @@
 #include <vespa/eval/tensor/dense/dense_tensor.h>
 #include <vespa/eval/tensor/serialization/typed_binary_format.h>
 #include <vespa/vespalib/datastore/datastore.hpp>
+#include <sys/mman.h>
+#include <unistd.h>
 
 using vespalib::datastore::Handle;
 using vespalib::tensor::Tensor;
@@ -21,14 +23,7 @@ namespace {
 
 constexpr size_t MIN_BUFFER_ARRAYS = 1024;
 constexpr size_t DENSE_TENSOR_ALIGNMENT = 32;
-
-size_t size_of(CellType type) {
-    switch (type) {
-    case CellType::DOUBLE: return sizeof(double);
-    case CellType::FLOAT: return sizeof(float);
-    }
-    abort();
-}
+const size_t page_size = getpagesize();
 
 size_t my_align(size_t size, size_t alignment) {
     size += alignment - 1;
@@ -39,7 +34,7 @@ size_t my_align(size_t size, size_t alignment) {
 
 DenseTensorStore::TensorSizeCalc::TensorSizeCalc(const ValueType &type)
     : _numCells(1u),
-      _cellSize(size_of(type.cell_type()))
+      _cellSize(ValueType::cell_size(type.cell_type()))
 {
     for (const auto &dim: type.dimensions()) {
         _numCells *= dim.size;
@@ -52,8 +47,10 @@ DenseTensorStore::TensorSizeCalc::alignedSize() const
     return my_align(bufSize(), DENSE_TENSOR_ALIGNMENT);
 }
 
-DenseTensorStore::BufferType::BufferType(const TensorSizeCalc &tensorSizeCalc)
-    : vespalib::datastore::BufferType<char>(tensorSizeCalc.alignedSize(), MIN_BUFFER_ARRAYS, RefType::offsetSize())
+DenseTensorStore::BufferType::BufferType(const TensorSizeCalc &tensorSizeCalc,
+                                         const vespalib::alloc::MemoryAllocator* allocator)
+    : vespalib::datastore::BufferType<char>(tensorSizeCalc.alignedSize(), MIN_BUFFER_ARRAYS, RefType::offsetSize()),
+      _allocator(allocator)
 {}
 
 DenseTensorStore::BufferType::~BufferType() = default;
@@ -65,11 +62,12 @@ DenseTensorStore::BufferType::cleanHold(void *buffer, size_t offset,
     memset(static_cast<char *>(buffer) + offset, 0, numElems);
 }
 
-DenseTensorStore::DenseTensorStore(const ValueType &type)
+DenseTensorStore::DenseTensorStore(const ValueType &type, std::unique_ptr<vespalib::alloc::MemoryAllocator> allocator)
     : TensorStore(_concreteStore),
+      _allocator(std::move(allocator)),
       _concreteStore(),
       _tensorSizeCalc(type),
-      _bufferType(_tensorSizeCalc),
+      _bufferType(_tensorSizeCalc, _allocator.get()),
       _type(type),
       _emptySpace()
 {
@@ -162,6 +160,23 @@ DenseTensorStore::get_typed_cells(EntryRef ref) const
     return vespalib::tensor::TypedCells(getRawBuffer(ref), _type.cell_type(), getNumCells());
 }
 
+void
+DenseTensorStore::prefetch(EntryRef ref) const
+{
+    if (!ref.valid()) {
+        return;
+    }
+    const char *buf = static_cast<const char *>(getRawBuffer(ref));
+    if (_allocator) {
+        // The pages might not be resident, let the kernel start reading them.
+        uintptr_t start = reinterpret_cast<uintptr_t>(buf) & ~(page_size - 1);
+        uintptr_t end = reinterpret_cast<uintptr_t>(buf) + getBufSize();
+        madvise(reinterpret_cast<void *>(start), end - start, MADV_WILLNEED);
+    } else {
+        __builtin_prefetch(buf);
+    }
+}
+
 template <class TensorType>
 TensorStore::EntryRef
 DenseTensorStore::setDenseTensor(const TensorType &tensor)
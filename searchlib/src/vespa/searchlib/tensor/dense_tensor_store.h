@@ -5,6 +5,7 @@
 #include "tensor_store.h"
 #include <vespa/eval/eval/value_type.h>
 #include <vespa/eval/tensor/dense/typed_cells.h>
+#include <vespa/vespalib/util/alloc.h>
 
 namespace vespalib { namespace tensor { class MutableDenseTensorView; }}
 
@@ -34,12 +35,15 @@ public:
     class BufferType : public vespalib::datastore::BufferType<char>
     {
         using CleanContext = vespalib::datastore::BufferType<char>::CleanContext;
+        const vespalib::alloc::MemoryAllocator* _allocator;
     public:
-        BufferType(const TensorSizeCalc &tensorSizeCalc);
+        BufferType(const TensorSizeCalc &tensorSizeCalc, const vespalib::alloc::MemoryAllocator* allocator);
         ~BufferType() override;
         void cleanHold(void *buffer, size_t offset, size_t numElems, CleanContext cleanCtx) override;
+        const vespalib::alloc::MemoryAllocator* get_memory_allocator() const override { return _allocator; }
     };
 private:
+    std::unique_ptr<vespalib::alloc::MemoryAllocator> _allocator;
     DataStoreType _concreteStore;
     TensorSizeCalc _tensorSizeCalc;
     BufferType _bufferType;
@@ -53,7 +57,11 @@ private:
     setDenseTensor(const TensorType &tensor);
 
 public:
-    DenseTensorStore(const ValueType &type);
+    /**
+     * The optional allocator is used for the buffers holding the tensors,
+     * e.g. to keep them in memory mapped files.
+     */
+    DenseTensorStore(const ValueType &type, std::unique_ptr<vespalib::alloc::MemoryAllocator> allocator = {});
     ~DenseTensorStore() override;
 
     const ValueType &type() const { return _type; }
@@ -67,6 +75,12 @@ public:
     std::unique_ptr<Tensor> getTensor(EntryRef ref) const;
     void getTensor(EntryRef ref, vespalib::tensor::MutableDenseTensorView &tensor) const;
     vespalib::tensor::TypedCells get_typed_cells(EntryRef ref) const;
+    /**
+     * Hints that the given tensor will be read soon.
+     * Tensors in file backed buffers are read ahead from disk if not resident.
+     */
+    void prefetch(EntryRef ref) const;
+    bool has_custom_allocator() const { return static_cast<bool>(_allocator); }
     EntryRef setTensor(const Tensor &tensor);
     // The following method is meant to be used only for unit tests.
     uint32_t getArraySize() const { return _bufferType.getArraySize(); }
@@ -2,16 +2,16 @@
 
 #pragma once
 
+#include <vespa/eval/tensor/dense/typed_cells.h>
 #include <memory>
 
-namespace vespalib::tensor { struct TypedCells; }
-
 namespace search::tensor {
 
 /**
  * Interface used to calculate the distance between two n-dimensional vectors.
  *
- * The vectors must be of same size and same type (float or double).
+ * The vectors must be of same size and same type (float or double);
+ * vectors with int8 or bfloat16 cells are promoted to float.
  * The actual implementation must know which type the vectors are.
  */
 class DistanceFunction {
@@ -23,6 +23,20 @@ public:
     virtual double calc_with_limit(const vespalib::tensor::TypedCells& lhs,
                                    const vespalib::tensor::TypedCells& rhs,
                                    double limit) const = 0;
+
+    /**
+     * Calculates the distance between lhs and each of the count vectors in rhs,
+     * storing the distances in result. Used when scoring many candidates for
+     * the same query vector, allowing per query work to be done only once.
+     */
+    virtual void calc_batch(const vespalib::tensor::TypedCells& lhs,
+                            const vespalib::tensor::TypedCells* rhs,
+                            size_t count, double* result) const
+    {
+        for (size_t i = 0; i < count; ++i) {
+            result[i] = calc(lhs, rhs[i]);
+        }
+    }
 };
 
 }
@@ -2,15 +2,68 @@
 
 #include "distance_function_factory.h"
 #include "distance_functions.h"
+#include <vector>
 
 using search::attribute::DistanceMetric;
 using vespalib::eval::ValueType;
+using vespalib::tensor::TypedCells;
 
 namespace search::tensor {
 
+namespace {
+
+/**
+ * Distance function for vectors with storage-only cell types (int8
+ * and bfloat16); cells are promoted to float before calculating the
+ * distance with the wrapped float distance function.
+ */
+class PromoteToFloatDistance : public DistanceFunction {
+private:
+    DistanceFunction::UP _float_fun;
+
+    static TypedCells promote(const TypedCells &cells, std::vector<float> &tmp) {
+        if (cells.type == ValueType::CellType::FLOAT) {
+            return cells;
+        }
+        tmp.resize(cells.size);
+        for (size_t i = 0; i < cells.size; ++i) {
+            tmp[i] = cells.get(i);
+        }
+        return TypedCells(vespalib::ConstArrayRef<float>(tmp));
+    }
+public:
+    PromoteToFloatDistance(DistanceFunction::UP float_fun) : _float_fun(std::move(float_fun)) {}
+    double calc(const TypedCells& lhs, const TypedCells& rhs) const override {
+        std::vector<float> lhs_tmp;
+        std::vector<float> rhs_tmp;
+        return _float_fun->calc(promote(lhs, lhs_tmp), promote(rhs, rhs_tmp));
+    }
+    double to_rawscore(double distance) const override {
+        return _float_fun->to_rawscore(distance);
+    }
+    double calc_with_limit(const TypedCells& lhs, const TypedCells& rhs, double limit) const override {
+        std::vector<float> lhs_tmp;
+        std::vector<float> rhs_tmp;
+        return _float_fun->calc_with_limit(promote(lhs, lhs_tmp), promote(rhs, rhs_tmp), limit);
+    }
+    void calc_batch(const TypedCells& lhs, const TypedCells* rhs, size_t count, double* result) const override {
+        std::vector<float> lhs_tmp;
+        std::vector<float> rhs_tmp;
+        TypedCells lhs_float = promote(lhs, lhs_tmp);
+        for (size_t i = 0; i < count; ++i) {
+            result[i] = _float_fun->calc(lhs_float, promote(rhs[i], rhs_tmp));
+        }
+    }
+};
+
+}
+
 DistanceFunction::UP
 make_distance_function(DistanceMetric variant, ValueType::CellType cell_type)
 {
+    if (ValueType::is_storage_cell_type(cell_type)) {
+        return std::make_unique<PromoteToFloatDistance>(make_distance_function(variant, ValueType::CellType::FLOAT));
+    }
     switch (variant) {
         case DistanceMetric::Euclidean:
             if (cell_type == ValueType::CellType::FLOAT) {
@@ -5,6 +5,7 @@
 #include "distance_function.h"
 #include <vespa/eval/tensor/dense/typed_cells.h>
 #include <vespa/vespalib/hwaccelrated/iaccelrated.h>
+#include <algorithm>
 #include <cmath>
 
 namespace search::tensor {
@@ -40,12 +41,28 @@ public:
         double sum = 0.0;
         size_t sz = lhs_vector.size();
         assert(sz == rhs_vector.size());
-        for (size_t i = 0; i < sz && sum <= limit; ++i) {
-            double diff = lhs_vector[i] - rhs_vector[i];
-            sum += diff*diff;
+        // check the limit once per block, letting the accelerator do the inner work
+        for (size_t i = 0; i < sz && sum <= limit; i += limit_check_block_size) {
+            size_t len = std::min(limit_check_block_size, sz - i);
+            sum += _computer.squaredEuclideanDistance(&lhs_vector[i], &rhs_vector[i], len);
         }
         return sum;
     }
+    void calc_batch(const vespalib::tensor::TypedCells& lhs,
+                    const vespalib::tensor::TypedCells* rhs,
+                    size_t count, double* result) const override
+    {
+        auto lhs_vector = lhs.typify<FloatType>();
+        const FloatType *a = &lhs_vector[0];
+        size_t sz = lhs_vector.size();
+        for (size_t i = 0; i < count; ++i) {
+            auto rhs_vector = rhs[i].typify<FloatType>();
+            assert(sz == rhs_vector.size());
+            result[i] = _computer.squaredEuclideanDistance(a, &rhs_vector[0], sz);
+        }
+    }
+
+    static constexpr size_t limit_check_block_size = 64;
 
     const vespalib::hwaccelrated::IAccelrated & _computer;
 };
@@ -90,6 +107,26 @@ public:
     {
         return calc(lhs, rhs);
     }
+    void calc_batch(const vespalib::tensor::TypedCells& lhs,
+                    const vespalib::tensor::TypedCells* rhs,
+                    size_t count, double* result) const override
+    {
+        auto lhs_vector = lhs.typify<FloatType>();
+        const FloatType *a = &lhs_vector[0];
+        size_t sz = lhs_vector.size();
+        // the query norm is shared by all candidates
+        double a_norm_sq = _computer.dotProduct(a, a, sz);
+        for (size_t i = 0; i < count; ++i) {
+            auto rhs_vector = rhs[i].typify<FloatType>();
+            assert(sz == rhs_vector.size());
+            const FloatType *b = &rhs_vector[0];
+            double b_norm_sq = _computer.dotProduct(b, b, sz);
+            double squared_norms = a_norm_sq * b_norm_sq;
+            double dot_product = _computer.dotProduct(a, b, sz);
+            double div = (squared_norms > 0) ? sqrt(squared_norms) : 1.0;
+            result[i] = 1.0 - (dot_product / div);
+        }
+    }
 
     const vespalib::hwaccelrated::IAccelrated & _computer;
 };
@@ -122,6 +159,19 @@ public:
     {
         return calc(lhs, rhs);
     }
+    void calc_batch(const vespalib::tensor::TypedCells& lhs,
+                    const vespalib::tensor::TypedCells* rhs,
+                    size_t count, double* result) const override
+    {
+        auto lhs_vector = lhs.typify<FloatType>();
+        const FloatType *a = &lhs_vector[0];
+        size_t sz = lhs_vector.size();
+        for (size_t i = 0; i < count; ++i) {
+            auto rhs_vector = rhs[i].typify<FloatType>();
+            assert(sz == rhs_vector.size());
+            result[i] = std::max(0.0, 1.0 - _computer.dotProduct(a, &rhs_vector[0], sz));
+        }
+    }
 
     const vespalib::hwaccelrated::IAccelrated & _computer;
 };
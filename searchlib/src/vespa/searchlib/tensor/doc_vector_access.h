@@ -16,6 +16,12 @@ class DocVectorAccess {
 public:
     virtual ~DocVectorAccess() {}
     virtual vespalib::tensor::TypedCells get_vector(uint32_t docid) const = 0;
+
+    /**
+     * Hint that the vector for the given document id will soon be accessed.
+     * Used to overlap memory latency when many vectors are visited.
+     */
+    virtual void prefetch_vector(uint32_t docid) const { (void) docid; }
 };
 
 }
@@ -2,15 +2,18 @@
 
 #include "hnsw_graph.h"
 #include "hnsw_index.h"
+#include "hnsw_mapped_graph.h"
 #include <vespa/vespalib/datastore/array_store.hpp>
 #include <vespa/vespalib/util/rcuvector.hpp>
 
 namespace search::tensor {
 
-HnswGraph::HnswGraph()
+HnswGraph::HnswGraph(vespalib::alloc::HugePagePolicy huge_page_policy)
   : node_refs(),
-    nodes(HnswIndex::make_default_node_store_config()),
-    links(HnswIndex::make_default_link_store_config()),
+    nodes(HnswIndex::make_default_node_store_config().huge_page_policy(huge_page_policy)),
+    links(HnswIndex::make_default_link_store_config().huge_page_policy(huge_page_policy)),
+    mapped(),
+    mapped_nodes(),
     entry_docid_and_level()
 {
     node_refs.ensure_size(1, AtomicEntryRef());
@@ -41,6 +44,10 @@ HnswGraph::remove_node_for_document(uint32_t docid)
     auto levels = nodes.get(node_ref);
     vespalib::datastore::EntryRef invalid;
     node_refs[docid].store_release(invalid);
+    if (is_mapped(docid)) {
+        // The level array only contains invalid link refs.
+        mapped_nodes[docid].store(false, std::memory_order_release);
+    }
     // Ensure data referenced through the old ref can be recycled:
     nodes.remove(node_ref);
     for (size_t i = 0; i < levels.size(); ++i) {
@@ -57,11 +64,45 @@ HnswGraph::set_link_array(uint32_t docid, uint32_t level, const LinkArrayRef& ne
     assert(node_ref.valid());
     auto levels = nodes.get_writable(node_ref);
     assert(level < levels.size());
+    if (is_mapped(docid)) {
+        // Copy-on-write: all levels of the node are moved to the link store before
+        // readers are directed away from the mapped graph.
+        for (uint32_t i = 0; i < levels.size(); ++i) {
+            if (i != level) {
+                levels[i].store_release(links.add(mapped->get_link_array(docid, i)));
+            }
+        }
+        levels[level].store_release(new_links_ref);
+        mapped_nodes[docid].store(false, std::memory_order_release);
+        return;
+    }
     auto old_links_ref = levels[level].load_acquire();
     levels[level].store_release(new_links_ref);
     links.remove(old_links_ref);
 }
 
+void
+HnswGraph::set_mapped(std::unique_ptr<const HnswMappedGraph> mapped_in)
+{
+    mapped = std::move(mapped_in);
+    uint32_t num_nodes = mapped->num_nodes();
+    mapped_nodes = std::vector<std::atomic<bool>>(num_nodes);
+    for (uint32_t docid = 0; docid < num_nodes; ++docid) {
+        uint32_t num_levels = mapped->num_levels(docid);
+        if (num_levels > 0) {
+            make_node_for_document(docid, num_levels);
+            mapped_nodes[docid].store(true, std::memory_order_relaxed);
+        }
+    }
+    node_refs.ensure_size(num_nodes);
+}
+
+HnswGraph::LinkArrayRef
+HnswGraph::get_mapped_link_array(uint32_t docid, uint32_t level) const
+{
+    return mapped->get_link_array(docid, level);
+}
+
 HnswGraph::Histograms
 HnswGraph::histograms() const
 {
@@ -75,9 +116,7 @@ HnswGraph::histograms() const
             auto level_array = nodes.get(node_ref);
             levels = level_array.size();
             if (levels > 0) {
-                auto links_ref = level_array[0].load_acquire();
-                auto link_array = links.get(links_ref);
-                l0links = link_array.size();
+                l0links = get_link_array(i, level_array, 0).size();
             }
             while (result.level_histogram.size() <= levels) {
                 result.level_histogram.push_back(0);
@@ -6,9 +6,13 @@
 #include <vespa/vespalib/datastore/atomic_entry_ref.h>
 #include <vespa/vespalib/datastore/entryref.h>
 #include <vespa/vespalib/util/rcuvector.h>
+#include <memory>
+#include <vector>
 
 namespace search::tensor {
 
+class HnswMappedGraph;
+
 /**
  * Stroage of a hierarchical navigable small world graph (HNSW)
  * that is used for approximate K-nearest neighbor search.
@@ -40,9 +44,14 @@ struct HnswGraph {
     NodeStore     nodes;
     LinkStore     links;
 
+    // Optional read-only graph loaded from file. The link arrays of a node are served
+    // from here until the node is modified (copy-on-write into the link store) or removed.
+    std::unique_ptr<const HnswMappedGraph> mapped;
+    std::vector<std::atomic<bool>>         mapped_nodes;
+
     std::atomic<uint64_t> entry_docid_and_level;
 
-    HnswGraph();
+    HnswGraph(vespalib::alloc::HugePagePolicy huge_page_policy = vespalib::alloc::HugePagePolicy::DEFAULT);
 
     ~HnswGraph();
 
@@ -50,6 +59,16 @@ struct HnswGraph {
 
     void remove_node_for_document(uint32_t docid);
 
+    /**
+     * Uses the given mapped graph as backing for all nodes it contains.
+     * Nodes are created in the node store, but no link arrays are copied.
+     **/
+    void set_mapped(std::unique_ptr<const HnswMappedGraph> mapped_in);
+
+    bool is_mapped(uint32_t docid) const {
+        return (docid < mapped_nodes.size()) && mapped_nodes[docid].load(std::memory_order_acquire);
+    }
+
     NodeRef get_node_ref(uint32_t docid) const {
         return node_refs[docid].load_acquire();
     }
@@ -70,7 +89,12 @@ struct HnswGraph {
         return get_level_array(node_ref);
     }
 
-    LinkArrayRef get_link_array(LevelArrayRef levels, uint32_t level) const {
+    LinkArrayRef get_mapped_link_array(uint32_t docid, uint32_t level) const;
+
+    LinkArrayRef get_link_array(uint32_t docid, LevelArrayRef levels, uint32_t level) const {
+        if (__builtin_expect(is_mapped(docid), false)) {
+            return get_mapped_link_array(docid, level);
+        }
         if (level < levels.size()) {
             auto links_ref = levels[level].load_acquire();
             if (links_ref.valid()) {
@@ -82,12 +106,12 @@ struct HnswGraph {
 
     LinkArrayRef get_link_array(uint32_t docid, uint32_t level) const {
         auto levels = get_level_array(docid);
-        return get_link_array(levels, level);
+        return get_link_array(docid, levels, level);
     }
 
-    LinkArrayRef get_link_array(NodeRef node_ref, uint32_t level) const {
+    LinkArrayRef get_link_array(uint32_t docid, NodeRef node_ref, uint32_t level) const {
         auto levels = get_level_array(node_ref);
-        return get_link_array(levels, level);
+        return get_link_array(docid, levels, level);
     }
 
     void set_link_array(uint32_t docid, uint32_t level, const LinkArrayRef& new_links);
@@ -4,7 +4,9 @@
 #include "hnsw_index.h"
 #include "hnsw_index_loader.h"
 #include "hnsw_index_saver.h"
+#include "hnsw_mapped_graph.h"
 #include "random_level_generator.h"
+#include <vespa/searchlib/util/fileutil.h>
 #include <vespa/searchlib/util/state_explorer_utils.h>
 #include <vespa/eval/tensor/dense/typed_cells.h>
 #include <vespa/vespalib/data/slime/cursor.h>
@@ -29,6 +31,8 @@ constexpr float alloc_grow_factor = 0.2;
 // TODO: Adjust these numbers to what we accept as max in config.
 constexpr size_t max_level_array_size = 16;
 constexpr size_t max_link_array_size = 64;
+// Number of hits found using quantized vectors per requested hit, before re-ranking with exact distances.
+constexpr uint32_t quantized_rerank_factor = 2;
 
 bool has_link_to(vespalib::ConstArrayRef<uint32_t> links, uint32_t id) {
     for (uint32_t link : links) {
@@ -49,6 +53,39 @@ bool operator< (const PairDist &a, const PairDist &b) {
     return (a.distance < b.distance);
 }
 
+/**
+ * Calculates exact distances between the input vector and the vectors of documents.
+ */
+class ExactDistanceCalc {
+private:
+    const DistanceFunction& _func;
+    const DocVectorAccess& _vectors;
+    vespalib::tensor::TypedCells _input;
+public:
+    ExactDistanceCalc(const DistanceFunction& func, const DocVectorAccess& vectors,
+                      const vespalib::tensor::TypedCells& input)
+        : _func(func), _vectors(vectors), _input(input)
+    {}
+    double calc(uint32_t docid) const { return _func.calc(_input, _vectors.get_vector(docid)); }
+    void prefetch(uint32_t docid) const { _vectors.prefetch_vector(docid); }
+};
+
+/**
+ * Calculates approximate distances between the input vector and the vectors of documents,
+ * using quantized codes for both.
+ */
+class QuantizedDistanceCalc {
+private:
+    const QuantizedVectorStore& _store;
+    QuantizedVectorStore::Codes _input;
+public:
+    QuantizedDistanceCalc(const QuantizedVectorStore& store, const vespalib::tensor::TypedCells& input)
+        : _store(store), _input(store.encode(input))
+    {}
+    double calc(uint32_t docid) const { return _store.calc_distance(_input, docid); }
+    void prefetch(uint32_t docid) const { _store.prefetch(docid); }
+};
+
 }
 
 vespalib::datastore::ArrayStoreConfig
@@ -201,14 +238,28 @@ HnswIndex::calc_distance(const TypedCells& lhs, uint32_t rhs_docid) const
 
 HnswCandidate
 HnswIndex::find_nearest_in_layer(const TypedCells& input, const HnswCandidate& entry_point, uint32_t level) const
+{
+    return find_nearest_in_layer_with(ExactDistanceCalc(*_distance_func, _vectors, input), entry_point, level);
+}
+
+void
+HnswIndex::search_layer(const TypedCells& input, uint32_t neighbors_to_find,
+                        FurthestPriQ& best_neighbors, uint32_t level, const search::BitVector *filter) const
+{
+    search_layer_with(ExactDistanceCalc(*_distance_func, _vectors, input), neighbors_to_find, best_neighbors, level, filter);
+}
+
+template <typename DistanceCalc>
+HnswCandidate
+HnswIndex::find_nearest_in_layer_with(const DistanceCalc& dist_calc, const HnswCandidate& entry_point, uint32_t level) const
 {
     HnswCandidate nearest = entry_point;
     bool keep_searching = true;
     while (keep_searching) {
         keep_searching = false;
-        for (uint32_t neighbor_docid : _graph.get_link_array(nearest.node_ref, level)) {
+        for (uint32_t neighbor_docid : _graph.get_link_array(nearest.docid, nearest.node_ref, level)) {
             auto neighbor_ref = _graph.get_node_ref(neighbor_docid);
-            double dist = calc_distance(input, neighbor_docid);
+            double dist = dist_calc.calc(neighbor_docid);
             if (_graph.still_valid(neighbor_docid, neighbor_ref)
                 && dist < nearest.distance)
             {
@@ -220,9 +271,10 @@ HnswIndex::find_nearest_in_layer(const TypedCells& input, const HnswCandidate& e
     return nearest;
 }
 
+template <typename DistanceCalc>
 void
-HnswIndex::search_layer(const TypedCells& input, uint32_t neighbors_to_find,
-                        FurthestPriQ& best_neighbors, uint32_t level, const search::BitVector *filter) const
+HnswIndex::search_layer_with(const DistanceCalc& dist_calc, uint32_t neighbors_to_find,
+                             FurthestPriQ& best_neighbors, uint32_t level, const search::BitVector *filter) const
 {
     NearestPriQ candidates;
     uint32_t doc_id_limit = _graph.node_refs.size();
@@ -242,6 +294,7 @@ HnswIndex::search_layer(const TypedCells& input, uint32_t neighbors_to_find,
         }
     }
     double limit_dist = std::numeric_limits<double>::max();
+    HnswCandidateVector to_visit;
 
     while (!candidates.empty()) {
         auto cand = candidates.top();
@@ -249,7 +302,10 @@ HnswIndex::search_layer(const TypedCells& input, uint32_t neighbors_to_find,
             break;
         }
         candidates.pop();
-        for (uint32_t neighbor_docid : _graph.get_link_array(cand.node_ref, level)) {
+        // Collect the unvisited neighbors first and prefetch their vectors,
+        // so the memory accesses overlap instead of being serialized by the distance calculations.
+        to_visit.clear();
+        for (uint32_t neighbor_docid : _graph.get_link_array(cand.docid, cand.node_ref, level)) {
             auto neighbor_ref = _graph.get_node_ref(neighbor_docid);
             if ((! neighbor_ref.valid())
                 || (neighbor_docid >= doc_id_limit)
@@ -258,7 +314,13 @@ HnswIndex::search_layer(const TypedCells& input, uint32_t neighbors_to_find,
                 continue;
             }
             visited.mark(neighbor_docid);
-            double dist_to_input = calc_distance(input, neighbor_docid);
+            dist_calc.prefetch(neighbor_docid);
+            to_visit.emplace_back(neighbor_docid, neighbor_ref, 0.0);
+        }
+        for (const auto& neighbor : to_visit) {
+            uint32_t neighbor_docid = neighbor.docid;
+            auto neighbor_ref = neighbor.node_ref;
+            double dist_to_input = dist_calc.calc(neighbor_docid);
             if (dist_to_input < limit_dist) {
                 candidates.emplace(neighbor_docid, neighbor_ref, dist_to_input);
                 if ((!filter) || filter->testBit(neighbor_docid)) {
@@ -273,14 +335,93 @@ HnswIndex::search_layer(const TypedCells& input, uint32_t neighbors_to_find,
     }
 }
 
+void
+HnswIndex::search_layer_batch(const std::vector<TypedCells>& inputs, uint32_t neighbors_to_find,
+                              std::vector<FurthestPriQ>& best_neighbors, const search::BitVector *filter) const
+{
+    // Candidates are ordered by their smallest distance to any of the inputs.
+    NearestPriQ candidates;
+    uint32_t doc_id_limit = _graph.node_refs.size();
+    if (filter) {
+        doc_id_limit = std::min(filter->size(), doc_id_limit);
+    }
+    auto visited = _visited_set_pool.get(doc_id_limit);
+    std::vector<double> limit_dist(inputs.size(), std::numeric_limits<double>::max());
+    double max_limit_dist = std::numeric_limits<double>::max();
+    auto consider = [&](uint32_t docid, HnswGraph::NodeRef node_ref) {
+        TypedCells vector = _vectors.get_vector(docid);
+        bool filter_ok = (!filter) || filter->testBit(docid);
+        bool limits_changed = false;
+        double min_dist = std::numeric_limits<double>::max();
+        for (size_t i = 0; i < inputs.size(); ++i) {
+            double dist = _distance_func->calc(inputs[i], vector);
+            min_dist = std::min(min_dist, dist);
+            if (filter_ok && dist < limit_dist[i]) {
+                auto& best = best_neighbors[i];
+                best.emplace(docid, node_ref, dist);
+                if (best.size() > neighbors_to_find) {
+                    best.pop();
+                    limit_dist[i] = best.top().distance;
+                    limits_changed = true;
+                }
+            }
+        }
+        if (limits_changed) {
+            max_limit_dist = *std::max_element(limit_dist.begin(), limit_dist.end());
+        }
+        if (min_dist < max_limit_dist) {
+            candidates.emplace(docid, node_ref, min_dist);
+        }
+    };
+    std::vector<HnswCandidate> entry_points;
+    for (auto& best : best_neighbors) {
+        if (!best.empty()) {
+            entry_points.push_back(best.top());
+            best.pop();
+        }
+    }
+    for (const auto& entry : entry_points) {
+        if ((entry.docid < doc_id_limit) && !visited.is_marked(entry.docid)) {
+            visited.mark(entry.docid);
+            consider(entry.docid, entry.node_ref);
+        }
+    }
+    HnswCandidateVector to_visit;
+    while (!candidates.empty()) {
+        auto cand = candidates.top();
+        if (cand.distance > max_limit_dist) {
+            break;
+        }
+        candidates.pop();
+        to_visit.clear();
+        for (uint32_t neighbor_docid : _graph.get_link_array(cand.docid, cand.node_ref, 0)) {
+            auto neighbor_ref = _graph.get_node_ref(neighbor_docid);
+            if ((! neighbor_ref.valid())
+                || (neighbor_docid >= doc_id_limit)
+                || visited.is_marked(neighbor_docid))
+            {
+                continue;
+            }
+            visited.mark(neighbor_docid);
+            _vectors.prefetch_vector(neighbor_docid);
+            to_visit.emplace_back(neighbor_docid, neighbor_ref, 0.0);
+        }
+        for (const auto& neighbor : to_visit) {
+            consider(neighbor.docid, neighbor.node_ref);
+        }
+    }
+}
+
 HnswIndex::HnswIndex(const DocVectorAccess& vectors, DistanceFunction::UP distance_func,
                      RandomLevelGenerator::UP level_generator, const Config& cfg)
     :
-      _graph(),
+      _graph(cfg.huge_page_policy()),
       _vectors(vectors),
       _distance_func(std::move(distance_func)),
       _level_generator(std::move(level_generator)),
-      _cfg(cfg)
+      _cfg(cfg),
+      _visited_set_pool(),
+      _quantized((cfg.min_size_before_quantization() > 0) ? std::make_unique<QuantizedVectorStore>() : nullptr)
 {
 }
 
@@ -359,6 +500,10 @@ HnswIndex::filter_valid_docids(uint32_t level, const PreparedAddDoc::Links &neig
 void
 HnswIndex::internal_complete_add(uint32_t docid, PreparedAddDoc &op)
 {
+    if (use_quantized_vectors()) {
+        // must be in place before the node is reachable by search threads
+        _quantized->set(docid, get_vector(docid));
+    }
     auto node_ref = _graph.make_node_for_document(docid, op.max_level + 1);
     for (int level = 0; level <= op.max_level; ++level) {
         auto neighbors = filter_valid_docids(level, op.connections[level], docid);
@@ -367,6 +512,22 @@ HnswIndex::internal_complete_add(uint32_t docid, PreparedAddDoc &op)
     if (op.max_level > get_entry_level()) {
         _graph.set_entry_node({docid, node_ref, op.max_level});
     }
+    consider_train_quantized_vectors();
+}
+
+void
+HnswIndex::consider_train_quantized_vectors()
+{
+    if (!_quantized || _quantized->trained() || (_graph.size() < _cfg.min_size_before_quantization())) {
+        return;
+    }
+    std::vector<uint32_t> docids;
+    for (uint32_t docid = 1; docid < _graph.size(); ++docid) {
+        if (_graph.get_node_ref(docid).valid()) {
+            docids.push_back(docid);
+        }
+    }
+    _quantized->train(_vectors, docids);
 }
 
 std::unique_ptr<PrepareResult>
@@ -459,6 +620,9 @@ HnswIndex::transfer_hold_lists(generation_t current_gen)
     _graph.node_refs.setGeneration(current_gen + 1);
     _graph.nodes.transferHoldLists(current_gen);
     _graph.links.transferHoldLists(current_gen);
+    if (_quantized) {
+        _quantized->transfer_hold_lists(current_gen);
+    }
 }
 
 void
@@ -467,6 +631,9 @@ HnswIndex::trim_hold_lists(generation_t first_used_gen)
     _graph.node_refs.removeOldGenerations(first_used_gen);
     _graph.nodes.trimHoldLists(first_used_gen);
     _graph.links.trimHoldLists(first_used_gen);
+    if (_quantized) {
+        _quantized->trim_hold_lists(first_used_gen);
+    }
 }
 
 vespalib::MemoryUsage
@@ -477,6 +644,9 @@ HnswIndex::memory_usage() const
     result.merge(_graph.nodes.getMemoryUsage());
     result.merge(_graph.links.getMemoryUsage());
     result.merge(_visited_set_pool.memory_usage());
+    if (_quantized) {
+        result.merge(_quantized->memory_usage());
+    }
     return result;
 }
 
@@ -504,11 +674,14 @@ HnswIndex::get_state(const vespalib::slime::Inserter& inserter) const
     auto entry_node = _graph.get_entry_node();
     object.setLong("entry_docid", entry_node.docid);
     object.setLong("entry_level", entry_node.level);
+    object.setLong("mapped_graph_bytes", _graph.mapped ? _graph.mapped->size_bytes() : 0);
     auto& cfgObj = object.setObject("cfg");
     cfgObj.setLong("max_links_at_level_0", _cfg.max_links_at_level_0());
     cfgObj.setLong("max_links_on_inserts", _cfg.max_links_on_inserts());
     cfgObj.setLong("neighbors_to_explore_at_construction",
                    _cfg.neighbors_to_explore_at_construction());
+    cfgObj.setLong("min_size_before_quantization", _cfg.min_size_before_quantization());
+    object.setBool("quantized_vectors", use_quantized_vectors());
 }
 
 std::unique_ptr<NearestNeighborIndexSaver>
@@ -522,9 +695,27 @@ HnswIndex::load(const fileutil::LoadedBuffer& buf)
 {
     assert(get_entry_docid() == 0); // cannot load after index has data
     HnswIndexLoader loader(_graph);
-    return loader.load(buf);
+    if (!loader.load(buf)) {
+        return false;
+    }
+    consider_train_quantized_vectors();
+    return true;
+}
+
+bool
+HnswIndex::load(std::unique_ptr<fileutil::LoadedBuffer> buf)
+{
+    assert(get_entry_docid() == 0); // cannot load after index has data
+    HnswIndexLoader loader(_graph);
+    if (!loader.load(std::move(buf))) {
+        return false;
+    }
+    consider_train_quantized_vectors();
+    return true;
 }
 
+namespace {
+
 struct NeighborsByDocId {
     bool operator() (const NearestNeighborIndex::Neighbor &lhs,
                      const NearestNeighborIndex::Neighbor &rhs)
@@ -534,11 +725,9 @@ struct NeighborsByDocId {
 };
 
 std::vector<NearestNeighborIndex::Neighbor>
-HnswIndex::top_k_by_docid(uint32_t k, TypedCells vector,
-                          const BitVector *filter, uint32_t explore_k) const
+to_neighbors_by_docid(FurthestPriQ& candidates, uint32_t k)
 {
-    std::vector<Neighbor> result;
-    FurthestPriQ candidates = top_k_candidates(vector, std::max(k, explore_k), filter);
+    std::vector<NearestNeighborIndex::Neighbor> result;
     while (candidates.size() > k) {
         candidates.pop();
     }
@@ -550,6 +739,16 @@ HnswIndex::top_k_by_docid(uint32_t k, TypedCells vector,
     return result;
 }
 
+}
+
+std::vector<NearestNeighborIndex::Neighbor>
+HnswIndex::top_k_by_docid(uint32_t k, TypedCells vector,
+                          const BitVector *filter, uint32_t explore_k) const
+{
+    FurthestPriQ candidates = top_k_candidates(vector, std::max(k, explore_k), filter);
+    return to_neighbors_by_docid(candidates, k);
+}
+
 std::vector<NearestNeighborIndex::Neighbor>
 HnswIndex::find_top_k(uint32_t k, TypedCells vector, uint32_t explore_k) const
 {
@@ -563,8 +762,41 @@ HnswIndex::find_top_k_with_filter(uint32_t k, TypedCells vector,
     return top_k_by_docid(k, vector, &filter, explore_k);
 }
 
+std::vector<std::vector<NearestNeighborIndex::Neighbor>>
+HnswIndex::find_top_k_batch(uint32_t k, const std::vector<TypedCells>& vectors,
+                            const BitVector *filter, uint32_t explore_k) const
+{
+    auto candidates = top_k_candidates_batch(vectors, std::max(k, explore_k), filter);
+    std::vector<std::vector<Neighbor>> result;
+    result.reserve(candidates.size());
+    for (auto& query_candidates : candidates) {
+        result.push_back(to_neighbors_by_docid(query_candidates, k));
+    }
+    return result;
+}
+
 FurthestPriQ
 HnswIndex::top_k_candidates(const TypedCells &vector, uint32_t k, const BitVector *filter) const
+{
+    if (!use_quantized_vectors()) {
+        return top_k_candidates_with(ExactDistanceCalc(*_distance_func, _vectors, vector), k, filter);
+    }
+    // Oversample as the approximate distances may order the hits around the k'th hit wrongly.
+    auto approx = top_k_candidates_with(QuantizedDistanceCalc(*_quantized, vector), k * quantized_rerank_factor, filter);
+    // re-rank the hits found using exact distances
+    FurthestPriQ result;
+    for (const HnswCandidate & hit : approx.peek()) {
+        result.emplace(hit.docid, hit.node_ref, calc_distance(vector, hit.docid));
+        if (result.size() > k) {
+            result.pop();
+        }
+    }
+    return result;
+}
+
+template <typename DistanceCalc>
+FurthestPriQ
+HnswIndex::top_k_candidates_with(const DistanceCalc& dist_calc, uint32_t k, const BitVector *filter) const
 {
     FurthestPriQ best_neighbors;
     auto entry = _graph.get_entry_node();
@@ -573,15 +805,38 @@ HnswIndex::top_k_candidates(const TypedCells &vector, uint32_t k, const BitVecto
         return best_neighbors;
     }
     int search_level = entry.level;
-    double entry_dist = calc_distance(vector, entry.docid);
+    double entry_dist = dist_calc.calc(entry.docid);
     // TODO: check if entry docid/node_ref is still valid here
     HnswCandidate entry_point(entry.docid, entry.node_ref, entry_dist);
     while (search_level > 0) {
-        entry_point = find_nearest_in_layer(vector, entry_point, search_level);
+        entry_point = find_nearest_in_layer_with(dist_calc, entry_point, search_level);
         --search_level;
     }
     best_neighbors.push(entry_point);
-    search_layer(vector, k, best_neighbors, 0, filter);
+    search_layer_with(dist_calc, k, best_neighbors, 0, filter);
+    return best_neighbors;
+}
+
+std::vector<FurthestPriQ>
+HnswIndex::top_k_candidates_batch(const std::vector<TypedCells>& vectors, uint32_t k, const BitVector *filter) const
+{
+    std::vector<FurthestPriQ> best_neighbors(vectors.size());
+    auto entry = _graph.get_entry_node();
+    if (entry.docid == 0) {
+        // graph has no entry point
+        return best_neighbors;
+    }
+    // The upper levels are small, so each query descends them on its own.
+    for (size_t i = 0; i < vectors.size(); ++i) {
+        int search_level = entry.level;
+        HnswCandidate entry_point(entry.docid, entry.node_ref, calc_distance(vectors[i], entry.docid));
+        while (search_level > 0) {
+            entry_point = find_nearest_in_layer(vectors[i], entry_point, search_level);
+            --search_level;
+        }
+        best_neighbors[i].push(entry_point);
+    }
+    search_layer_batch(vectors, k, best_neighbors, filter);
     return best_neighbors;
 }
 
@@ -594,8 +849,8 @@ HnswIndex::get_node(uint32_t docid) const
     }
     auto levels = _graph.nodes.get(node_ref);
     HnswNode::LevelArray result;
-    for (const auto& links_ref : levels) {
-        auto links = _graph.links.get(links_ref.load_acquire());
+    for (uint32_t level = 0; level < levels.size(); ++level) {
+        auto links = _graph.get_link_array(docid, levels, level);
         HnswNode::LinkArray result_links(links.begin(), links.end());
         std::sort(result_links.begin(), result_links.end());
         result.push_back(result_links);
@@ -626,9 +881,8 @@ HnswIndex::check_link_symmetry() const
         auto node_ref = _graph.node_refs[docid].load_acquire();
         if (node_ref.valid()) {
             auto levels = _graph.nodes.get(node_ref);
-            uint32_t level = 0;
-            for (const auto& links_ref : levels) {
-                auto links = _graph.links.get(links_ref.load_acquire());
+            for (uint32_t level = 0; level < levels.size(); ++level) {
+                auto links = _graph.get_link_array(docid, levels, level);
                 for (auto neighbor_docid : links) {
                     auto neighbor_links = _graph.get_link_array(neighbor_docid, level);
                     if (! has_link_to(neighbor_links, docid)) {
@@ -637,7 +891,6 @@ HnswIndex::check_link_symmetry() const
                             docid, neighbor_docid, level);
                     }
                 }
-                ++level;
             }
         }
     }
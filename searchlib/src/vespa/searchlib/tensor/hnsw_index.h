@@ -9,6 +9,7 @@
 #include "nearest_neighbor_index.h"
 #include "random_level_generator.h"
 #include "hnsw_graph.h"
+#include "quantized_vector_store.h"
 #include <vespa/eval/tensor/dense/typed_cells.h>
 #include <vespa/searchlib/common/bitvector.h>
 #include <vespa/vespalib/datastore/array_store.h>
@@ -41,24 +42,38 @@ public:
         uint32_t _neighbors_to_explore_at_construction;
         uint32_t _min_size_before_two_phase;
         bool _heuristic_select_neighbors;
+        uint32_t _min_size_before_quantization;
+        vespalib::alloc::HugePagePolicy _huge_page_policy;
 
     public:
+        /**
+         * If min_size_before_quantization is non-zero, int8 codes for all vectors are
+         * trained when the graph reaches this size, and used when searching the graph.
+         * The hits found are then re-ranked using the exact vectors.
+         * Only supported for euclidean distance.
+         */
         Config(uint32_t max_links_at_level_0_in,
                uint32_t max_links_on_inserts_in,
                uint32_t neighbors_to_explore_at_construction_in,
                uint32_t min_size_before_two_phase_in,
-               bool heuristic_select_neighbors_in)
+               bool heuristic_select_neighbors_in,
+               uint32_t min_size_before_quantization_in = 0,
+               vespalib::alloc::HugePagePolicy huge_page_policy_in = vespalib::alloc::HugePagePolicy::DEFAULT)
             : _max_links_at_level_0(max_links_at_level_0_in),
               _max_links_on_inserts(max_links_on_inserts_in),
               _neighbors_to_explore_at_construction(neighbors_to_explore_at_construction_in),
               _min_size_before_two_phase(min_size_before_two_phase_in),
-              _heuristic_select_neighbors(heuristic_select_neighbors_in)
+              _heuristic_select_neighbors(heuristic_select_neighbors_in),
+              _min_size_before_quantization(min_size_before_quantization_in),
+              _huge_page_policy(huge_page_policy_in)
         {}
         uint32_t max_links_at_level_0() const { return _max_links_at_level_0; }
         uint32_t max_links_on_inserts() const { return _max_links_on_inserts; }
         uint32_t neighbors_to_explore_at_construction() const { return _neighbors_to_explore_at_construction; }
         uint32_t min_size_before_two_phase() const { return _min_size_before_two_phase; }
         bool heuristic_select_neighbors() const { return _heuristic_select_neighbors; }
+        uint32_t min_size_before_quantization() const { return _min_size_before_quantization; }
+        vespalib::alloc::HugePagePolicy huge_page_policy() const { return _huge_page_policy; }
     };
 
 protected:
@@ -80,6 +95,7 @@ protected:
     RandomLevelGenerator::UP _level_generator;
     Config _cfg;
     mutable vespalib::ReusableSetPool _visited_set_pool;
+    std::unique_ptr<QuantizedVectorStore> _quantized;
 
     uint32_t max_links_for_level(uint32_t level) const;
     void add_link_to(uint32_t docid, uint32_t level, const LinkArrayRef& old_links, uint32_t new_link) {
@@ -122,6 +138,21 @@ protected:
     HnswCandidate find_nearest_in_layer(const TypedCells& input, const HnswCandidate& entry_point, uint32_t level) const;
     void search_layer(const TypedCells& input, uint32_t neighbors_to_find, FurthestPriQ& found_neighbors,
                       uint32_t level, const search::BitVector *filter = nullptr) const;
+    template <typename DistanceCalc>
+    HnswCandidate find_nearest_in_layer_with(const DistanceCalc& dist_calc, const HnswCandidate& entry_point, uint32_t level) const;
+    template <typename DistanceCalc>
+    void search_layer_with(const DistanceCalc& dist_calc, uint32_t neighbors_to_find, FurthestPriQ& found_neighbors,
+                           uint32_t level, const search::BitVector *filter) const;
+    template <typename DistanceCalc>
+    FurthestPriQ top_k_candidates_with(const DistanceCalc& dist_calc, uint32_t k, const BitVector *filter) const;
+    /**
+     * Searches level 0 for the nearest neighbors of all the input vectors in one traversal.
+     * Each node visited has its vector loaded once and compared against all input vectors.
+     * best_neighbors[i] holds the entry point for input i on entry, and the nearest neighbors found on return.
+     */
+    void search_layer_batch(const std::vector<TypedCells>& inputs, uint32_t neighbors_to_find,
+                            std::vector<FurthestPriQ>& best_neighbors, const search::BitVector *filter) const;
+    void consider_train_quantized_vectors();
     std::vector<Neighbor> top_k_by_docid(uint32_t k, TypedCells vector,
                                          const BitVector *filter, uint32_t explore_k) const;
 
@@ -165,14 +196,20 @@ public:
 
     std::unique_ptr<NearestNeighborIndexSaver> make_saver() const override;
     bool load(const fileutil::LoadedBuffer& buf) override;
+    bool load(std::unique_ptr<fileutil::LoadedBuffer> buf) override;
 
     std::vector<Neighbor> find_top_k(uint32_t k, TypedCells vector, uint32_t explore_k) const override;
     std::vector<Neighbor> find_top_k_with_filter(uint32_t k, TypedCells vector,
                                                  const BitVector &filter, uint32_t explore_k) const override;
+    std::vector<std::vector<Neighbor>> find_top_k_batch(uint32_t k, const std::vector<TypedCells>& vectors,
+                                                        const BitVector *filter, uint32_t explore_k) const override;
     const DistanceFunction *distance_function() const override { return _distance_func.get(); }
 
     FurthestPriQ top_k_candidates(const TypedCells &vector, uint32_t k, const BitVector *filter) const;
+    std::vector<FurthestPriQ> top_k_candidates_batch(const std::vector<TypedCells>& vectors, uint32_t k,
+                                                     const BitVector *filter) const;
 
+    bool use_quantized_vectors() const { return _quantized && _quantized->trained(); }
     uint32_t get_entry_docid() const { return _graph.get_entry_node().docid; }
     int32_t get_entry_level() const { return _graph.get_entry_node().level; }
 
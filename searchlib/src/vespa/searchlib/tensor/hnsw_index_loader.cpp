@@ -2,6 +2,7 @@
 
 #include "hnsw_index_loader.h"
 #include "hnsw_graph.h"
+#include "hnsw_mapped_graph.h"
 #include <vespa/searchlib/util/fileutil.h>
 
 namespace search::tensor {
@@ -15,6 +16,35 @@ HnswIndexLoader::HnswIndexLoader(HnswGraph &graph)
 
 bool
 HnswIndexLoader::load(const fileutil::LoadedBuffer& buf)
+{
+    if (!HnswMappedGraph::has_header(buf)) {
+        return load_legacy(buf);
+    }
+    // The view does not own the buffer as it is only used while copying.
+    HnswMappedGraph mapped(std::make_unique<fileutil::LoadedBuffer>(const_cast<void *>(buf.buffer()), buf.size()));
+    return mapped.valid() && copy_from(mapped);
+}
+
+bool
+HnswIndexLoader::load(std::unique_ptr<fileutil::LoadedBuffer> buf)
+{
+    if (!HnswMappedGraph::has_header(*buf)) {
+        return load_legacy(*buf);
+    }
+    auto mapped = std::make_unique<HnswMappedGraph>(std::move(buf));
+    if (!mapped->valid()) {
+        return false;
+    }
+    uint32_t entry_docid = mapped->entry_docid();
+    int32_t entry_level = mapped->entry_level();
+    uint32_t num_nodes = mapped->num_nodes();
+    _graph.set_mapped(std::move(mapped));
+    set_entry_node(entry_docid, entry_level, num_nodes);
+    return true;
+}
+
+bool
+HnswIndexLoader::load_legacy(const fileutil::LoadedBuffer& buf)
 {
     size_t num_readable = buf.size(sizeof(uint32_t));
     _ptr = static_cast<const uint32_t *>(buf.buffer());
@@ -38,11 +68,33 @@ HnswIndexLoader::load(const fileutil::LoadedBuffer& buf)
         }
     }
     if (_failed) return false;
+    set_entry_node(entry_docid, entry_level, num_nodes);
+    return true;
+}
+
+bool
+HnswIndexLoader::copy_from(const HnswMappedGraph& mapped)
+{
+    uint32_t num_nodes = mapped.num_nodes();
+    for (uint32_t docid = 0; docid < num_nodes; ++docid) {
+        uint32_t num_levels = mapped.num_levels(docid);
+        if (num_levels > 0) {
+            _graph.make_node_for_document(docid, num_levels);
+            for (uint32_t level = 0; level < num_levels; ++level) {
+                _graph.set_link_array(docid, level, mapped.get_link_array(docid, level));
+            }
+        }
+    }
+    set_entry_node(mapped.entry_docid(), mapped.entry_level(), num_nodes);
+    return true;
+}
+
+void
+HnswIndexLoader::set_entry_node(uint32_t entry_docid, int32_t entry_level, uint32_t num_nodes)
+{
     _graph.node_refs.ensure_size(num_nodes);
     auto entry_node_ref = _graph.get_node_ref(entry_docid);
     _graph.set_entry_node({entry_docid, entry_node_ref, entry_level});
-    return true;
 }
 
-
 }
@@ -3,21 +3,34 @@
 #pragma once
 
 #include <cstdint>
+#include <memory>
 
 namespace search::fileutil { class LoadedBuffer; }
 
 namespace search::tensor {
 
 struct HnswGraph;
+class HnswMappedGraph;
 
 /**
  * Implements loading of HNSW graph structure from binary format.
+ *
+ * Both the mappable format (see HnswMappedGraph) and the legacy format
+ * (without header) are supported.
  **/
 class HnswIndexLoader {
 public:
     HnswIndexLoader(HnswGraph &graph);
     ~HnswIndexLoader();
+    /**
+     * Loads the graph by copying all link arrays into the graph stores.
+     **/
     bool load(const fileutil::LoadedBuffer& buf);
+    /**
+     * Loads the graph without copying the link arrays if the buffer is in the mappable format.
+     * The graph then takes ownership of the buffer.
+     **/
+    bool load(std::unique_ptr<fileutil::LoadedBuffer> buf);
 private:
     HnswGraph &_graph;
     const uint32_t *_ptr;
@@ -30,6 +43,9 @@ private:
         }
         return *_ptr++;
     }
+    bool load_legacy(const fileutil::LoadedBuffer& buf);
+    bool copy_from(const HnswMappedGraph& mapped);
+    void set_entry_node(uint32_t entry_docid, int32_t entry_level, uint32_t num_nodes);
 };
 
 }
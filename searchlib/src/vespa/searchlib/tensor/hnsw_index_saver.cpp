@@ -2,6 +2,7 @@
 
 #include "hnsw_index_saver.h"
 #include "hnsw_graph.h"
+#include "hnsw_mapped_graph.h"
 #include <vespa/searchlib/util/bufferwriter.h>
 
 namespace search::tensor {
@@ -9,17 +10,20 @@ namespace search::tensor {
 HnswIndexSaver::~HnswIndexSaver() {}
 
 HnswIndexSaver::HnswIndexSaver(const HnswGraph &graph)
-    : _graph_links(graph.links), _meta_data()
+    : _graph(graph), _meta_data()
 {
     auto entry = graph.get_entry_node();
     _meta_data.entry_docid = entry.docid;
     _meta_data.entry_level = entry.level;
     size_t num_nodes = graph.node_refs.size();
     _meta_data.nodes.reserve(num_nodes);
+    _meta_data.mapped.resize(num_nodes, false);
     for (size_t i = 0; i < num_nodes; ++i) {
         LevelVector node;
         auto node_ref = graph.node_refs[i].load_acquire();
         if (node_ref.valid()) {
+            // Check mapped state before reading the level array, see HnswGraph::set_link_array().
+            _meta_data.mapped[i] = graph.is_mapped(i);
             auto levels = graph.nodes.get(node_ref);
             for (const auto& links_ref : levels) {
                 auto level = links_ref.load_acquire();
@@ -30,26 +34,50 @@ HnswIndexSaver::HnswIndexSaver(const HnswGraph &graph)
     }
 }
 
+HnswGraph::LinkArrayRef
+HnswIndexSaver::get_link_array(uint32_t docid, uint32_t level) const
+{
+    if (_meta_data.mapped[docid]) {
+        return _graph.mapped->get_link_array(docid, level);
+    }
+    auto links_ref = _meta_data.nodes[docid][level];
+    if (links_ref.valid()) {
+        return _graph.links.get(links_ref);
+    }
+    return HnswGraph::LinkArrayRef();
+}
+
 void
 HnswIndexSaver::save(BufferWriter& writer) const
 {
-    writer.write(&_meta_data.entry_docid, sizeof(uint32_t));
-    writer.write(&_meta_data.entry_level, sizeof(int32_t));
     uint32_t num_nodes = _meta_data.nodes.size();
-    writer.write(&num_nodes, sizeof(uint32_t));
+    uint32_t header[HnswMappedGraph::header_words] = { HnswMappedGraph::magic, HnswMappedGraph::version,
+                                                       _meta_data.entry_docid, uint32_t(_meta_data.entry_level),
+                                                       num_nodes, 0 };
+    writer.write(header, sizeof(header));
     for (const auto &node : _meta_data.nodes) {
         uint32_t num_levels = node.size();
         writer.write(&num_levels, sizeof(uint32_t));
-        for (auto links_ref : node) {
-            if (links_ref.valid()) {
-                vespalib::ConstArrayRef<uint32_t> link_array = _graph_links.get(links_ref);
-                uint32_t num_links = link_array.size();
-                writer.write(&num_links, sizeof(uint32_t));
-                writer.write(link_array.cbegin(), sizeof(uint32_t)*num_links);
-            } else {
-                uint32_t num_links = 0;
-                writer.write(&num_links, sizeof(uint32_t));
-            }
+    }
+    uint64_t offset = HnswMappedGraph::header_words + 3 * uint64_t(num_nodes) + 2;
+    uint32_t offset_words[2];
+    for (uint32_t docid = 0; docid < num_nodes; ++docid) {
+        HnswMappedGraph::write_offset(offset_words, offset);
+        writer.write(offset_words, sizeof(offset_words));
+        uint32_t num_levels = _meta_data.nodes[docid].size();
+        for (uint32_t level = 0; level < num_levels; ++level) {
+            offset += 1 + get_link_array(docid, level).size();
+        }
+    }
+    HnswMappedGraph::write_offset(offset_words, offset);
+    writer.write(offset_words, sizeof(offset_words));
+    for (uint32_t docid = 0; docid < num_nodes; ++docid) {
+        uint32_t num_levels = _meta_data.nodes[docid].size();
+        for (uint32_t level = 0; level < num_levels; ++level) {
+            auto link_array = get_link_array(docid, level);
+            uint32_t num_links = link_array.size();
+            writer.write(&num_links, sizeof(uint32_t));
+            writer.write(link_array.cbegin(), sizeof(uint32_t)*num_links);
         }
     }
     writer.flush();
@@ -14,6 +14,8 @@ namespace search::tensor {
  * The constructor takes a snapshot of all meta-data, but
  * the links will be fetched from the graph in the save()
  * method.
+ *
+ * The graph is saved in the mappable format described in HnswMappedGraph.
  **/
 class HnswIndexSaver : public NearestNeighborIndexSaver {
 public:
@@ -28,10 +30,14 @@ private:
         uint32_t entry_docid;
         int32_t  entry_level;
         std::vector<LevelVector> nodes;
-        MetaData() : entry_docid(0), entry_level(-1), nodes() {}
+        // Nodes with link arrays still served from the mapped graph.
+        std::vector<bool> mapped;
+        MetaData() : entry_docid(0), entry_level(-1), nodes(), mapped() {}
     };
-    const HnswGraph::LinkStore &_graph_links;
+    const HnswGraph &_graph;
     MetaData _meta_data;
+
+    HnswGraph::LinkArrayRef get_link_array(uint32_t docid, uint32_t level) const;
 };
 
 }
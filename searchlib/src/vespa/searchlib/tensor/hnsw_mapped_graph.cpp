@@ -0,0 +1,79 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "hnsw_mapped_graph.h"
+#include <vespa/searchlib/util/fileutil.h>
+#include <algorithm>
+
+namespace search::tensor {
+
+HnswMappedGraph::HnswMappedGraph(std::unique_ptr<fileutil::LoadedBuffer> buf)
+    : _buf(std::move(buf)),
+      _words(static_cast<const uint32_t *>(_buf->buffer())),
+      _num_words(_buf->size(sizeof(uint32_t))),
+      _num_nodes(0),
+      _levels(nullptr),
+      _offsets(nullptr)
+{
+    if (_num_words >= header_words) {
+        _num_nodes = _words[4];
+        _levels = _words + header_words;
+        _offsets = _levels + _num_nodes;
+    }
+}
+
+HnswMappedGraph::~HnswMappedGraph() = default;
+
+bool
+HnswMappedGraph::has_header(const fileutil::LoadedBuffer& buf)
+{
+    // Note: The legacy format starts with the entry docid and entry level.
+    if (buf.size(sizeof(uint32_t)) < header_words) {
+        return false;
+    }
+    const auto *words = static_cast<const uint32_t *>(buf.buffer());
+    return (words[0] == magic) && (words[1] == version);
+}
+
+bool
+HnswMappedGraph::valid() const
+{
+    if (!has_header(*_buf)) {
+        return false;
+    }
+    uint64_t data_start = header_words + 3 * uint64_t(_num_nodes) + 2;
+    if ((data_start > _num_words) || (entry_docid() >= std::max(_num_nodes, 1u))) {
+        return false;
+    }
+    uint64_t prev = data_start;
+    for (uint32_t docid = 0; docid <= _num_nodes; ++docid) {
+        uint64_t cur = offset(docid);
+        if (cur < prev || cur > _num_words) {
+            return false;
+        }
+        prev = cur;
+    }
+    return true;
+}
+
+HnswMappedGraph::LinkArrayRef
+HnswMappedGraph::get_link_array(uint32_t docid, uint32_t level) const
+{
+    if (level >= num_levels(docid)) {
+        return LinkArrayRef();
+    }
+    const uint32_t *ptr = _words + offset(docid);
+    const uint32_t *end = _words + offset(docid + 1);
+    for (uint32_t l = 0; ptr < end; ++l) {
+        uint32_t num_links = *ptr++;
+        if (num_links > size_t(end - ptr)) {
+            break;
+        }
+        if (l == level) {
+            return LinkArrayRef(ptr, num_links);
+        }
+        ptr += num_links;
+    }
+    return LinkArrayRef();
+}
+
+}
@@ -0,0 +1,71 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <vespa/vespalib/util/arrayref.h>
+#include <cstdint>
+#include <memory>
+
+namespace search::fileutil { class LoadedBuffer; }
+
+namespace search::tensor {
+
+/**
+ * Read-only view of a HNSW graph saved in the mappable binary format.
+ *
+ * The layout (in 32-bit words) is:
+ *   header:  magic, version, entry docid, entry level, num nodes, reserved
+ *   levels:  num levels for each node (num nodes words)
+ *   offsets: 64-bit word offset of the link data for each node (num nodes + 1 entries)
+ *   data:    for each node and level: num links, followed by the links
+ *
+ * The link arrays are served directly from the underlying (memory mapped) buffer.
+ **/
+class HnswMappedGraph {
+public:
+    using LinkArrayRef = vespalib::ConstArrayRef<uint32_t>;
+
+    static constexpr uint32_t magic = 0x57534e48; // "HNSW" in little endian
+    static constexpr uint32_t version = 1;
+    static constexpr uint32_t header_words = 6;
+
+private:
+    std::unique_ptr<fileutil::LoadedBuffer> _buf;
+    const uint32_t *_words;
+    size_t          _num_words;
+    uint32_t        _num_nodes;
+    const uint32_t *_levels;
+    const uint32_t *_offsets;
+
+    uint64_t offset(uint32_t docid) const {
+        return (static_cast<uint64_t>(_offsets[2 * docid + 1]) << 32) | _offsets[2 * docid];
+    }
+
+public:
+    HnswMappedGraph(std::unique_ptr<fileutil::LoadedBuffer> buf);
+    ~HnswMappedGraph();
+
+    /**
+     * Returns true if the buffer starts with the header of the mappable format.
+     **/
+    static bool has_header(const fileutil::LoadedBuffer& buf);
+
+    /**
+     * Validates the header and offset table, and returns false if the buffer is malformed.
+     **/
+    bool valid() const;
+
+    uint32_t entry_docid() const { return _words[2]; }
+    int32_t entry_level() const { return static_cast<int32_t>(_words[3]); }
+    uint32_t num_nodes() const { return _num_nodes; }
+    uint32_t num_levels(uint32_t docid) const { return (docid < _num_nodes) ? _levels[docid] : 0; }
+    LinkArrayRef get_link_array(uint32_t docid, uint32_t level) const;
+    size_t size_bytes() const { return _num_words * sizeof(uint32_t); }
+
+    static void write_offset(uint32_t *dst, uint64_t offset) {
+        dst[0] = static_cast<uint32_t>(offset);
+        dst[1] = static_cast<uint32_t>(offset >> 32);
+    }
+};
+
+}
@@ -71,6 +71,11 @@ public:
      */
     virtual std::unique_ptr<NearestNeighborIndexSaver> make_saver() const = 0;
     virtual bool load(const fileutil::LoadedBuffer& buf) = 0;
+    /**
+     * Loads the index from the given buffer, which the index may keep and serve data from.
+     * The default implementation loads from the buffer and then releases it.
+     */
+    virtual bool load(std::unique_ptr<fileutil::LoadedBuffer> buf);
 
     virtual std::vector<Neighbor> find_top_k(uint32_t k,
                                              vespalib::tensor::TypedCells vector,
@@ -82,6 +87,17 @@ public:
                                                          const BitVector &filter,
                                                          uint32_t explore_k) const = 0;
 
+    /**
+     * Finds the top k neighbors for each of the given query vectors.
+     * The result contains one vector of neighbors (sorted on docid) per query vector.
+     * If a filter is given, only neighbors where the corresponding filter bit is set are returned.
+     * The default implementation performs one search per query vector.
+     */
+    virtual std::vector<std::vector<Neighbor>> find_top_k_batch(uint32_t k,
+                                                                const std::vector<vespalib::tensor::TypedCells>& vectors,
+                                                                const BitVector *filter,
+                                                                uint32_t explore_k) const;
+
     virtual const DistanceFunction *distance_function() const = 0;
 };
 
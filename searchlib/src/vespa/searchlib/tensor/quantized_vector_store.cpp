@@ -0,0 +1,88 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "quantized_vector_store.h"
+#include "doc_vector_access.h"
+#include <vespa/vespalib/util/rcuvector.hpp>
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <limits>
+
+using vespalib::tensor::TypedCells;
+
+namespace search::tensor {
+
+namespace {
+
+constexpr double max_code = 127.0;
+
+}
+
+QuantizedVectorStore::QuantizedVectorStore()
+    : _vector_size(0),
+      _offset(0.0),
+      _scale(1.0),
+      _trained(false),
+      _codes(),
+      _computer(vespalib::hwaccelrated::IAccelrated::getAccelerator())
+{
+}
+
+QuantizedVectorStore::~QuantizedVectorStore() = default;
+
+int8_t
+QuantizedVectorStore::encode_cell(double value) const
+{
+    double code = std::round((value - _offset) / _scale);
+    return static_cast<int8_t>(std::clamp(code, -max_code, max_code));
+}
+
+void
+QuantizedVectorStore::train(const DocVectorAccess& vectors, const std::vector<uint32_t>& docids)
+{
+    assert(!trained());
+    if (docids.empty()) {
+        return;
+    }
+    double min_value = std::numeric_limits<double>::max();
+    double max_value = std::numeric_limits<double>::lowest();
+    for (uint32_t docid : docids) {
+        auto vector = vectors.get_vector(docid);
+        _vector_size = vector.size;
+        for (size_t i = 0; i < vector.size; ++i) {
+            double value = vector.get(i);
+            min_value = std::min(min_value, value);
+            max_value = std::max(max_value, value);
+        }
+    }
+    _offset = (min_value + max_value) / 2;
+    double range = max_value - min_value;
+    _scale = (range > 0.0) ? (range / (2 * max_code)) : 1.0;
+    for (uint32_t docid : docids) {
+        set(docid, vectors.get_vector(docid));
+    }
+    _trained.store(true, std::memory_order_release);
+}
+
+void
+QuantizedVectorStore::set(uint32_t docid, const TypedCells& vector)
+{
+    assert(vector.size == _vector_size);
+    size_t start = size_t(docid) * _vector_size;
+    _codes.ensure_size(start + _vector_size, 0);
+    for (size_t i = 0; i < _vector_size; ++i) {
+        _codes[start + i] = encode_cell(vector.get(i));
+    }
+}
+
+QuantizedVectorStore::Codes
+QuantizedVectorStore::encode(const TypedCells& vector) const
+{
+    Codes result(_vector_size, 0);
+    for (size_t i = 0; i < _vector_size && i < vector.size; ++i) {
+        result[i] = encode_cell(vector.get(i));
+    }
+    return result;
+}
+
+}
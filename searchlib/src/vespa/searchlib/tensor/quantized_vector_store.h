@@ -0,0 +1,79 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <vespa/eval/tensor/dense/typed_cells.h>
+#include <vespa/vespalib/hwaccelrated/iaccelrated.h>
+#include <vespa/vespalib/util/memoryusage.h>
+#include <vespa/vespalib/util/rcuvector.h>
+#include <atomic>
+#include <vector>
+
+namespace search::tensor {
+
+class DocVectorAccess;
+
+/**
+ * Stores scalar quantized (int8) codes for the vectors in a nearest neighbor index.
+ *
+ * All cells of all vectors are mapped to codes in [-127, 127] using one offset and scale,
+ * which are trained from the vectors present when train() is called.
+ * Squared euclidean distances calculated between codes are approximate,
+ * and results found using them should be re-ranked using the exact vectors.
+ *
+ * Supports 1 write thread and multiple search threads, in the same way as HnswGraph.
+ */
+class QuantizedVectorStore {
+public:
+    using Codes = std::vector<int8_t>;
+    using generation_t = vespalib::GenerationHandler::generation_t;
+
+private:
+    size_t _vector_size;
+    double _offset;
+    double _scale;
+    std::atomic<bool> _trained;
+    vespalib::RcuVector<int8_t> _codes;
+    const vespalib::hwaccelrated::IAccelrated & _computer;
+
+    int8_t encode_cell(double value) const;
+
+public:
+    QuantizedVectorStore();
+    ~QuantizedVectorStore();
+
+    bool trained() const { return _trained.load(std::memory_order_acquire); }
+    size_t vector_size() const { return _vector_size; }
+
+    /**
+     * Trains the quantization parameters from the vectors of the given documents,
+     * and stores codes for all of them. Is only called once, by the write thread.
+     */
+    void train(const DocVectorAccess& vectors, const std::vector<uint32_t>& docids);
+
+    /**
+     * Stores codes for the given document. Must be called before the document is
+     * made reachable for search threads.
+     */
+    void set(uint32_t docid, const vespalib::tensor::TypedCells& vector);
+
+    Codes encode(const vespalib::tensor::TypedCells& vector) const;
+
+    /**
+     * Returns the approximate squared euclidean distance between the given codes
+     * and the codes stored for the given document.
+     */
+    void prefetch(uint32_t docid) const {
+        __builtin_prefetch(&_codes[size_t(docid) * _vector_size]);
+    }
+    double calc_distance(const Codes& lhs, uint32_t rhs_docid) const {
+        const int8_t* rhs = &_codes[size_t(rhs_docid) * _vector_size];
+        return _scale * _scale * _computer.squaredEuclideanDistance(lhs.data(), rhs, _vector_size);
+    }
+
+    void transfer_hold_lists(generation_t current_gen) { _codes.setGeneration(current_gen + 1); }
+    void trim_hold_lists(generation_t first_used_gen) { _codes.removeOldGenerations(first_used_gen); }
+    vespalib::MemoryUsage memory_usage() const { return _codes.getMemoryUsage(); }
+};
+
+}
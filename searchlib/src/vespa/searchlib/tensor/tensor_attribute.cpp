@@ -30,6 +30,8 @@ constexpr uint32_t TENSOR_ATTRIBUTE_VERSION = 0;
 
 // minimum dead bytes in tensor attribute before consider compaction
 constexpr size_t DEAD_SLACK = 0x10000u;
+// maximum number of documents visited by each compaction step
+constexpr uint32_t COMPACT_DOCS_PER_STEP = 0x10000u;
 
 struct CallMakeEmptyTensor {
     template <typename CT>
@@ -69,7 +71,8 @@ TensorAttribute::TensorAttribute(vespalib::stringref name, const Config &cfg, Te
                  getGenerationHolder()),
       _tensorStore(tensorStore),
       _emptyTensor(createEmptyTensor(cfg.tensorType())),
-      _compactGeneration(0)
+      _compactGeneration(0),
+      _compaction()
 {
 }
 
@@ -99,17 +102,31 @@ TensorAttribute::onCommit()
 {
     // Note: Cost can be reduced if unneeded generation increments are dropped
     incGeneration();
-    if (getFirstUsedGeneration() > _compactGeneration) {
+    if (_compaction.in_progress()) {
+        compactStep(COMPACT_DOCS_PER_STEP);
+    } else if (getFirstUsedGeneration() > _compactGeneration) {
         // No data held from previous compact operation
         Status &status = getStatus();
         size_t used = status.getUsed();
         size_t dead = status.getDead();
         if ((dead >= DEAD_SLACK) && (dead * 5 > used)) {
             compactWorst();
+            compactStep(COMPACT_DOCS_PER_STEP);
         }
     }
 }
 
+void
+TensorAttribute::compactStep(uint32_t maxDocs)
+{
+    if (_compaction.step(vespalib::ArrayRef<EntryRef>(&_refVector[0], _refVector.size()), maxDocs)) {
+        // compacted buffer has been put on hold
+        _compactGeneration = getCurrentGeneration();
+        incGeneration();
+        updateStat(true);
+    }
+}
+
 void
 TensorAttribute::onUpdateStat()
 {
@@ -286,6 +303,15 @@ TensorAttribute::complete_set_tensor(DocId docid, const Tensor& tensor,
     (void) prepare_result;
 }
 
+bool
+TensorAttribute::modify_tensor(DocId docid, join_fun_t op, const vespalib::tensor::CellValues& cells)
+{
+    (void) docid;
+    (void) op;
+    (void) cells;
+    return false;
+}
+
 IMPLEMENT_IDENTIFIABLE_ABSTRACT(TensorAttribute, AttributeVector);
 
 }
@@ -6,8 +6,11 @@
 #include "prepare_result.h"
 #include "tensor_store.h"
 #include <vespa/searchlib/attribute/not_implemented_attribute.h>
+#include <vespa/vespalib/datastore/incremental_compaction.h>
 #include <vespa/vespalib/util/rcuvector.h>
 
+namespace vespalib::tensor { class CellValues; }
+
 namespace search::tensor {
 
 /**
@@ -23,9 +26,11 @@ protected:
     TensorStore &_tensorStore; // data store for serialized tensors
     std::unique_ptr<Tensor> _emptyTensor;
     uint64_t    _compactGeneration; // Generation when last compact occurred
+    vespalib::datastore::IncrementalCompaction _compaction;
 
     template <typename RefType>
     void doCompactWorst();
+    void compactStep(uint32_t maxDocs);
     void checkTensorType(const Tensor &tensor);
     void setTensorRef(DocId docId, EntryRef ref);
     virtual vespalib::MemoryUsage memory_usage() const;
@@ -73,6 +78,21 @@ public:
      */
     virtual void complete_set_tensor(DocId docid, const Tensor& tensor, std::unique_ptr<PrepareResult> prepare_result);
 
+    using join_fun_t = double (*)(double, double);
+    /**
+     * Modifies the cells of the tensor for a document that are matched by the given cell values,
+     * combining the old and new cell values with the given function.
+     *
+     * Returns false if not supported for this attribute or document, in which case the caller
+     * must apply the modification to a copy of the tensor and set that instead.
+     */
+    virtual bool modify_tensor(DocId docid, join_fun_t op, const vespalib::tensor::CellValues& cells);
+
+    /**
+     * Start compaction of the worst buffer in the tensor store. The
+     * tensors are moved by subsequent commits, a bounded number of
+     * documents at a time.
+     */
     virtual void compactWorst() = 0;
 };
 
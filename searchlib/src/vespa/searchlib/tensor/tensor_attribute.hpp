@@ -2,30 +2,47 @@
 
 #pragma once
 
+#include <atomic>
+
 namespace search {
 
 namespace tensor {
 
+/**
+ * Compaction context moving the tensors in the worst buffer of a
+ * tensor store. The buffer is put on hold when the context is destroyed.
+ */
+template <typename RefType>
+class TensorStoreCompactionContext : public vespalib::datastore::ICompactionContext {
+    TensorStore &_store;
+    uint32_t     _bufferId;
+public:
+    TensorStoreCompactionContext(TensorStore &store)
+        : _store(store),
+          _bufferId(store.startCompactWorstBuffer())
+    {
+    }
+    ~TensorStoreCompactionContext() override {
+        _store.finishCompactWorstBuffer(_bufferId);
+    }
+    void compact(vespalib::ArrayRef<vespalib::datastore::EntryRef> refs) override {
+        for (auto &ref : refs) {
+            RefType internalRef(ref);
+            if (internalRef.valid() && internalRef.bufferId() == _bufferId) {
+                auto newRef = _store.move(ref);
+                // TODO: validate if following fence is sufficient.
+                std::atomic_thread_fence(std::memory_order_release);
+                ref = newRef;
+            }
+        }
+    }
+};
+
 template <typename RefType>
 void
 TensorAttribute::doCompactWorst()
 {
-    uint32_t bufferId = _tensorStore.startCompactWorstBuffer();
-    size_t lidLimit = _refVector.size();
-    for (uint32_t lid = 0; lid < lidLimit; ++lid) {
-        RefType ref = _refVector[lid];
-        (void) ref;
-        if (ref.valid() && ref.bufferId() == bufferId) {
-            RefType newRef = _tensorStore.move(ref);
-            // TODO: validate if following fence is sufficient.
-            std::atomic_thread_fence(std::memory_order_release);
-            _refVector[lid] = newRef;
-        }
-    }
-    _tensorStore.finishCompactWorstBuffer(bufferId);
-    _compactGeneration = getCurrentGeneration();
-    incGeneration();
-    updateStat(true);
+    _compaction.start(std::make_unique<TensorStoreCompactionContext<RefType>>(_tensorStore));
 }
 
 }  // namespace search::tensor
@@ -2,16 +2,23 @@
 
 #include "fake_match_loop.h"
 #include "fakeposting.h"
+#include <vespa/searchlib/fef/matchdata.h>
 #include <vespa/searchlib/fef/termfieldmatchdataarray.h>
 #include <vespa/searchlib/queryeval/andsearch.h>
 #include <vespa/searchlib/queryeval/orsearch.h>
 #include <vespa/searchlib/queryeval/searchiterator.h>
+#include <vespa/searchlib/queryeval/simple_phrase_search.h>
+#include <vespa/searchlib/queryeval/wand/weak_and_search.h>
+#include <algorithm>
 
+using search::fef::MatchData;
 using search::fef::TermFieldMatchData;
 using search::fef::TermFieldMatchDataArray;
 using search::queryeval::AndSearch;
 using search::queryeval::OrSearch;
 using search::queryeval::SearchIterator;
+using search::queryeval::SimplePhraseSearch;
+using search::queryeval::WeakAndSearch;
 
 namespace search::fakedata {
 
@@ -40,13 +47,44 @@ public:
     SearchIterator* release() { return _itr.release(); }
 };
 
+// number of hits kept in the weak and heap
+constexpr uint32_t weak_and_heap_size = 100;
+
+std::unique_ptr<SearchIterator>
+make_weak_and(IteratorState& state_1, IteratorState& state_2)
+{
+    WeakAndSearch::Terms terms;
+    terms.emplace_back(state_1.release(), 1, 0);
+    terms.emplace_back(state_2.release(), 1, 0);
+    return WeakAndSearch::create(terms, weak_and_heap_size, true);
+}
+
+std::unique_ptr<SearchIterator>
+make_phrase(const FakePosting& posting_1, const FakePosting& posting_2, TermFieldMatchData& tmd)
+{
+    auto md = MatchData::makeTestInstance(2, 1);
+    TermFieldMatchDataArray child_match;
+    SimplePhraseSearch::Children children;
+    for (const FakePosting* posting : {&posting_1, &posting_2}) {
+        TermFieldMatchData* child_tmd = md->resolveTermField(child_match.size());
+        child_tmd->setNeedNormalFeatures(posting->enable_unpack_normal_features());
+        child_tmd->setNeedInterleavedFeatures(posting->enable_unpack_interleaved_features());
+        child_match.add(child_tmd);
+        TermFieldMatchDataArray tfmda;
+        tfmda.add(child_tmd);
+        children.emplace_back(posting->createIterator(tfmda));
+    }
+    return std::make_unique<SimplePhraseSearch>(std::move(children), std::move(md), child_match,
+                                                std::vector<uint32_t>{0, 1}, tmd, true);
+}
+
 template <bool do_unpack>
 int
 do_match_loop(SearchIterator& itr, uint32_t doc_id_limit)
 {
     uint32_t hits = 0;
     itr.initFullRange();
-    uint32_t doc_id = itr.getDocId();
+    uint32_t doc_id = std::max(1u, itr.getDocId());
     while (doc_id < doc_id_limit) {
         if (itr.seek(doc_id)) {
             ++hits;
@@ -115,5 +153,38 @@ FakeMatchLoop::or_pair_posting_scan_with_unpack(const FakePosting& posting_1, co
     return do_match_loop<true>(*iterator, doc_id_limit);
 }
 
+int
+FakeMatchLoop::weak_and_pair_posting_scan(const FakePosting& posting_1, const FakePosting& posting_2, uint32_t doc_id_limit)
+{
+    IteratorState state_1(posting_1);
+    IteratorState state_2(posting_2);
+    auto iterator = make_weak_and(state_1, state_2);
+    return do_match_loop<false>(*iterator, doc_id_limit);
 }
 
+int
+FakeMatchLoop::weak_and_pair_posting_scan_with_unpack(const FakePosting& posting_1, const FakePosting& posting_2, uint32_t doc_id_limit)
+{
+    IteratorState state_1(posting_1);
+    IteratorState state_2(posting_2);
+    auto iterator = make_weak_and(state_1, state_2);
+    return do_match_loop<true>(*iterator, doc_id_limit);
+}
+
+int
+FakeMatchLoop::phrase_pair_posting_scan(const FakePosting& posting_1, const FakePosting& posting_2, uint32_t doc_id_limit)
+{
+    TermFieldMatchData tmd;
+    auto iterator = make_phrase(posting_1, posting_2, tmd);
+    return do_match_loop<false>(*iterator, doc_id_limit);
+}
+
+int
+FakeMatchLoop::phrase_pair_posting_scan_with_unpack(const FakePosting& posting_1, const FakePosting& posting_2, uint32_t doc_id_limit)
+{
+    TermFieldMatchData tmd;
+    auto iterator = make_phrase(posting_1, posting_2, tmd);
+    return do_match_loop<true>(*iterator, doc_id_limit);
+}
+
+}
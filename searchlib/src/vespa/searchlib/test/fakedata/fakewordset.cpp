@@ -4,6 +4,8 @@
 #include "fakeword.h"
 #include <vespa/vespalib/util/time.h>
 #include <vespa/searchlib/bitcompression/posocc_fields_params.h>
+#include <algorithm>
+#include <cmath>
 #include <sstream>
 
 #include <vespa/log/log.h>
@@ -125,6 +127,44 @@ FakeWordSet::setupWords(vespalib::Rand48 &rnd,
     LOG(info, "leave setupWords, elapsed %10.6f s", vespalib::to_s(tv.elapsed()));
 }
 
+void
+FakeWordSet::setupZipfianWords(vespalib::Rand48 &rnd,
+                               uint32_t numDocs,
+                               uint32_t maxDocFreq,
+                               uint32_t mediumDocFreq,
+                               uint32_t rareDocFreq,
+                               double exponent,
+                               uint32_t numWords)
+{
+    std::string zipf = "zipf";
+    _numDocs = numDocs;
+
+    LOG(info, "enter setupZipfianWords");
+    vespalib::Timer tv;
+
+    uint32_t packedIndex = _fieldsParams.size() - 1;
+    for (uint32_t i = 0; i < numWords; ++i) {
+        std::ostringstream vi;
+
+        vi << (i + 1);
+        uint32_t docFreq = std::max(1.0, std::floor(maxDocFreq / std::pow(i + 1, exponent)));
+        uint32_t wordClass = RARE_WORD;
+        if (docFreq >= mediumDocFreq) {
+            wordClass = COMMON_WORD;
+        } else if (docFreq >= rareDocFreq) {
+            wordClass = MEDIUM_WORD;
+        }
+        _words[wordClass].push_back(std::make_unique<FakeWord>(numDocs, docFreq, docFreq / 2,
+                                                               zipf + vi.str(), rnd,
+                                                               _fieldsParams[packedIndex],
+                                                               packedIndex));
+    }
+
+    LOG(info, "leave setupZipfianWords, elapsed %10.6f s (%zu common, %zu medium, %zu rare words)",
+        vespalib::to_s(tv.elapsed()), _words[COMMON_WORD].size(),
+        _words[MEDIUM_WORD].size(), _words[RARE_WORD].size());
+}
+
 int
 FakeWordSet::getNumWords() const
 {
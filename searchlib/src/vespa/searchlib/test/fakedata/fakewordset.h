@@ -58,6 +58,20 @@ public:
                     uint32_t rareDocFreq,
                     uint32_t numWordsPerWordClass);
 
+    /*
+     * Setup words with a zipfian document frequency distribution, where
+     * the word with rank r occurs in maxDocFreq / r^exponent documents.
+     * Words are assigned to word classes based on their document
+     * frequency using mediumDocFreq and rareDocFreq as lower limits.
+     */
+    void setupZipfianWords(vespalib::Rand48 &rnd,
+                           uint32_t numDocs,
+                           uint32_t maxDocFreq,
+                           uint32_t mediumDocFreq,
+                           uint32_t rareDocFreq,
+                           double exponent,
+                           uint32_t numWords);
+
     const std::vector<FakeWordVector>& words() const { return _words; }
 
     int getNumWords() const;
@@ -44,6 +44,11 @@ Domain::Domain(const string &domainName, const string & baseDir, Executor & exec
       _parts(),
       _lock(),
       _currentChunkMonitor(),
+      _currentChunk(std::make_unique<CommitChunk>(cfg.getChunkSizeLimit(), 16)),
+      _pendingChunkCommit(false),
+      _numCommitBatches(0),
+      _numBatchedCommits(0),
+      _batchSyncTime(),
       _sessionLock(),
       _sessions(),
       _maxSessionRunTime(),
@@ -69,6 +74,7 @@ Domain::Domain(const string &domainName, const string & baseDir, Executor & exec
     if (_parts.empty() || _parts.crbegin()->second->isClosed()) {
         _parts[lastPart] = std::make_shared<DomainPart>(_name, dir(), lastPart, _config.getEncoding(),
                                                         _config.getCompressionlevel(), _fileHeaderContext, false);
+        _parts[lastPart]->setWriteOptions(_config.getPreallocateSize(), _config.getDropSyncedFromCache());
         vespalib::File::sync(dir());
     }
     _lastSerial = end();
@@ -82,6 +88,10 @@ Domain::execute(vespalib::Executor::Task::UP task) {
 Domain &
 Domain::setConfig(const DomainConfig & cfg) {
     _config = cfg;
+    LockGuard guard(_lock);
+    if ( ! _parts.empty()) {
+        _parts.rbegin()->second->setWriteOptions(_config.getPreallocateSize(), _config.getDropSyncedFromCache());
+    }
     return *this;
 }
 
@@ -89,6 +99,7 @@ void
 Domain::addPart(SerialNum partId, bool isLastPart) {
     auto dp = std::make_shared<DomainPart>(_name, dir(), partId, _config.getEncoding(),
                                            _config.getCompressionlevel(), _fileHeaderContext, isLastPart);
+    dp->setWriteOptions(_config.getPreallocateSize(), _config.getDropSyncedFromCache());
     if (dp->size() == 0) {
         // Only last domain part is allowed to be truncated down to
         // empty size.
@@ -105,13 +116,18 @@ Domain::addPart(SerialNum partId, bool isLastPart) {
     }
 }
 
-Domain::~Domain() { }
+Domain::~Domain() {
+    _singleCommiter->sync();
+}
 
 DomainInfo
 Domain::getDomainInfo() const
 {
     LockGuard guard(_lock);
     DomainInfo info(SerialNumRange(begin(guard), end(guard)), size(guard), byteSize(guard), _maxSessionRunTime);
+    info.numCommitBatches = _numCommitBatches;
+    info.numBatchedCommits = _numBatchedCommits;
+    info.batchSyncTime = _batchSyncTime;
     for (const auto &entry: _parts) {
         const DomainPart &part = *entry.second;
         info.parts.emplace_back(PartInfo(part.range(), part.size(), part.byteSize(), part.fileName()));
@@ -300,6 +316,7 @@ Domain::optionallyRotateFile(SerialNum serialNum) {
         dp->close();
         dp = std::make_shared<DomainPart>(_name, dir(), serialNum, _config.getEncoding(),
                                           _config.getCompressionlevel(), _fileHeaderContext, false);
+        dp->setWriteOptions(_config.getPreallocateSize(), _config.getDropSyncedFromCache());
         {
             LockGuard guard(_lock);
             _parts[serialNum] = dp;
@@ -313,13 +330,79 @@ Domain::optionallyRotateFile(SerialNum serialNum) {
 void
 Domain::commit(const Packet & packet, Writer::DoneCallback onDone)
 {
-    (void) onDone;
+    if (_config.getGroupCommitLatency() > vespalib::duration::zero()) {
+        groupCommit(packet, std::move(onDone));
+        return;
+    }
+    // Drain any batch left over from group commit mode to keep serial numbers in order
+    _singleCommiter->sync();
+    doCommit(packet);
+    _lastSerial = std::max(_lastSerial, packet.range().to());
+}
+
+DomainPart::SP
+Domain::doCommit(const Packet & packet)
+{
     vespalib::nbostream_longlivedbuf is(packet.getHandle().data(), packet.getHandle().size());
     Packet::Entry entry;
     entry.deserialize(is);
     DomainPart::SP dp = optionallyRotateFile(entry.serial());
     dp->commit(entry.serial(), packet);
     cleanSessions();
+    return dp;
+}
+
+/*
+ * Commits from all writers are appended to the current chunk. The first commit
+ * of a chunk schedules a task on the single committer that writes and syncs the
+ * whole chunk once the group commit latency has passed (or the chunk is full).
+ * All callbacks of the chunk complete when it is destroyed after the sync.
+ */
+void
+Domain::groupCommit(const Packet & packet, Writer::DoneCallback onDone)
+{
+    if (packet.empty()) {
+        return;
+    }
+    MonitorGuard guard(_currentChunkMonitor);
+    if (packet.range().from() <= _lastSerial) {
+        throw runtime_error(fmt("Incoming serial number(%" PRIu64 ") must be bigger than the last one (%" PRIu64 ").",
+                                packet.range().from(), _lastSerial));
+    }
+    _lastSerial = packet.range().to();
+    _currentChunk->add(packet, std::move(onDone));
+    if ( ! _pendingChunkCommit) {
+        _pendingChunkCommit = true;
+        _singleCommiter->execute(makeLambdaTask([this]() { commitChunk(); }));
+    } else if (_currentChunk->sizeBytes() >= _config.getChunkSizeLimit()) {
+        guard.signal();
+    }
+}
+
+void
+Domain::commitChunk()
+{
+    std::unique_ptr<CommitChunk> chunk;
+    {
+        MonitorGuard guard(_currentChunkMonitor);
+        vespalib::duration latency = _config.getGroupCommitLatency();
+        while ((_currentChunk->age() < latency) && (_currentChunk->sizeBytes() < _config.getChunkSizeLimit())) {
+            guard.wait(latency - _currentChunk->age());
+        }
+        chunk = std::move(_currentChunk);
+        _currentChunk = std::make_unique<CommitChunk>(_config.getChunkSizeLimit(), chunk->getNumCallBacks());
+        _pendingChunkCommit = false;
+    }
+    DomainPart::SP dp = doCommit(chunk->getPacket());
+    vespalib::steady_time start = vespalib::steady_clock::now();
+    dp->sync();
+    DurationSeconds syncTime = vespalib::steady_clock::now() - start;
+    {
+        LockGuard guard(_lock);
+        ++_numCommitBatches;
+        _numBatchedCommits += chunk->getNumCallBacks();
+        _batchSyncTime += syncTime;
+    }
 }
 
 bool
@@ -60,6 +60,9 @@ private:
     size_t byteSize(const vespalib::LockGuard & guard) const;
     uint64_t size(const vespalib::LockGuard & guard) const;
     void cleanSessions();
+    DomainPartSP doCommit(const Packet & packet);
+    void groupCommit(const Packet & packet, Writer::DoneCallback onDone);
+    void commitChunk();
     vespalib::string dir() const { return getDir(_baseDir, _name); }
     void addPart(SerialNum partId, bool isLastPart);
     DomainPartSP optionallyRotateFile(SerialNum serialNum);
@@ -83,6 +86,11 @@ private:
     DomainPartList         _parts;
     vespalib::Lock         _lock;
     vespalib::Monitor      _currentChunkMonitor;
+    std::unique_ptr<CommitChunk> _currentChunk;
+    bool                   _pendingChunkCommit;
+    size_t                 _numCommitBatches;
+    size_t                 _numBatchedCommits;
+    DurationSeconds        _batchSyncTime;
     vespalib::Lock         _sessionLock;
     SessionList            _sessions;
     DurationSeconds        _maxSessionRunTime;
@@ -10,7 +10,10 @@ DomainConfig::DomainConfig()
       _fSyncOnCommit(false),
       _partSizeLimit(0x10000000), // 256M
       _chunkSizeLimit(0x40000),   // 256k
-      _chunkAgeLimit(10ms)
+      _chunkAgeLimit(10ms),
+      _groupCommitLatency(0ms),
+      _preallocateSize(0),
+      _dropSyncedFromCache(false)
 { }
 
 }
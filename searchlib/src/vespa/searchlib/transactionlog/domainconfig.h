@@ -17,12 +17,18 @@ public:
     DomainConfig & setChunkAgeLimit(vespalib::duration v) { _chunkAgeLimit = v; return *this; }
     DomainConfig & setCompressionLevel(uint8_t v)   { _compressionLevel = v; return *this; }
     DomainConfig & setFSyncOnCommit(bool v)         { _fSyncOnCommit = v; return *this; }
+    DomainConfig & setGroupCommitLatency(duration v) { _groupCommitLatency = v; return *this; }
+    DomainConfig & setPreallocateSize(size_t v)     { _preallocateSize = v; return *this; }
+    DomainConfig & setDropSyncedFromCache(bool v)   { _dropSyncedFromCache = v; return *this; }
     Encoding          getEncoding() const { return _encoding; }
     size_t       getPartSizeLimit() const { return _partSizeLimit; }
     size_t      getChunkSizeLimit() const { return _chunkSizeLimit; }
     duration     getChunkAgeLimit() const { return _chunkAgeLimit; }
     uint8_t   getCompressionlevel() const { return _compressionLevel; }
     bool         getFSyncOnCommit() const { return _fSyncOnCommit; }
+    duration getGroupCommitLatency() const { return _groupCommitLatency; }
+    size_t     getPreallocateSize() const { return _preallocateSize; }
+    bool   getDropSyncedFromCache() const { return _dropSyncedFromCache; }
 private:
     Encoding     _encoding;
     uint8_t      _compressionLevel;
@@ -30,6 +36,9 @@ private:
     size_t       _partSizeLimit;
     size_t       _chunkSizeLimit;
     duration     _chunkAgeLimit;
+    duration     _groupCommitLatency;
+    size_t       _preallocateSize;
+    bool         _dropSyncedFromCache;
 };
 
 struct PartInfo {
@@ -51,11 +60,17 @@ struct DomainInfo {
     size_t numEntries;
     size_t byteSize;
     DurationSeconds maxSessionRunTime;
+    // accumulated since start, only updated in group commit mode
+    size_t numCommitBatches;
+    size_t numBatchedCommits;
+    DurationSeconds batchSyncTime;
     std::vector<PartInfo> parts;
     DomainInfo(SerialNumRange range_in, size_t numEntries_in, size_t byteSize_in, DurationSeconds maxSessionRunTime_in)
-            : range(range_in), numEntries(numEntries_in), byteSize(byteSize_in), maxSessionRunTime(maxSessionRunTime_in), parts() {}
+            : range(range_in), numEntries(numEntries_in), byteSize(byteSize_in), maxSessionRunTime(maxSessionRunTime_in),
+              numCommitBatches(0), numBatchedCommits(0), batchSyncTime(), parts() {}
     DomainInfo()
-            : range(), numEntries(0), byteSize(0), maxSessionRunTime(), parts() {}
+            : range(), numEntries(0), byteSize(0), maxSessionRunTime(),
+              numCommitBatches(0), numBatchedCommits(0), batchSyncTime(), parts() {}
 };
 
 using DomainStats = std::map<vespalib::string, DomainInfo>;
@@ -266,7 +266,10 @@ DomainPart::DomainPart(const string & name, const string & baseDir, SerialNum s,
       _headerLen(0),
       _writeLock(),
       _writtenSerial(0),
-      _syncedSerial(0)
+      _syncedSerial(0),
+      _preallocateSize(0),
+      _preallocatedEnd(0),
+      _dropSyncedFromCache(false)
 {
     if (_transLog->OpenReadOnly()) {
         int64_t currPos = buildPacketMapping(allowTruncate);
@@ -311,6 +314,15 @@ DomainPart::~DomainPart()
     close();
 }
 
+DomainPart &
+DomainPart::setWriteOptions(size_t preallocateSize, bool dropSyncedFromCache)
+{
+    LockGuard guard(_writeLock);
+    _preallocateSize = preallocateSize;
+    _dropSyncedFromCache = dropSyncedFromCache;
+    return *this;
+}
+
 void
 DomainPart::writeHeader(const FileHeaderContext &fileHeaderContext)
 {
@@ -335,6 +347,10 @@ DomainPart::close()
          * hole.  XXX: Feed latency spike due to lack of delayed open
          * for new domainpart.
          */
+        if (_transLog->IsOpened() && (_preallocatedEnd > int64_t(byteSize()))) {
+            // Release the disk space preallocated beyond the end of the file
+            _transLog->SetSize(byteSize());
+        }
         handleSync(*_transLog);
         _transLog->dropFromCache();
         retval = _transLog->Close();
@@ -443,6 +459,9 @@ DomainPart::sync()
     if (_syncedSerial < syncSerial) {
         _syncedSerial = syncSerial;
     }
+    if (_dropSyncedFromCache) {
+        _transLog->dropFromCache();
+    }
 }
 
 bool
@@ -544,6 +563,7 @@ DomainPart::write(FastOS_FileInterface &file, const IChunk & chunk)
     os << uint32_t(end - (begin + sizeof(uint32_t) + sizeof(uint8_t))); // Patching actual size.
     os.wp(end);
     LockGuard guard(_writeLock);
+    ensurePreallocated(file, byteSize() + os.size());
     if ( ! file.CheckedWrite(os.data(), os.size()) ) {
         throw runtime_error(handleWriteError("Failed writing the entry.", file, byteSize(), chunk.range(), os.size()));
     }
@@ -553,6 +573,23 @@ DomainPart::write(FastOS_FileInterface &file, const IChunk & chunk)
     _byteSize.fetch_add(os.size(), std::memory_order_release);
 }
 
+void
+DomainPart::ensurePreallocated(FastOS_FileInterface &file, int64_t end)
+{
+    if ((_preallocateSize == 0) || (end <= _preallocatedEnd)) {
+        return;
+    }
+    int64_t start = std::max(_preallocatedEnd, int64_t(byteSize()));
+    int64_t newEnd = end + _preallocateSize;
+    if (file.preallocate(start, newEnd - start)) {
+        _preallocatedEnd = newEnd;
+    } else {
+        LOG(debug, "Could not preallocate %" PRId64 " bytes at pos %" PRId64 " of file '%s', disabling preallocation",
+            newEnd - start, start, file.GetFileName());
+        _preallocateSize = 0;
+    }
+}
+
 bool
 DomainPart::read(FastOS_FileInterface &file, IChunk::UP & chunk, Alloc & buf, bool allowTruncate)
 {
@@ -22,6 +22,12 @@ public:
     DomainPart(const vespalib::string &name, const vespalib::string &baseDir, SerialNum s, Encoding defaultEncoding,
                uint8_t compressionLevel, const common::FileHeaderContext &FileHeaderContext, bool allowTruncate);
 
+    /**
+     * Preallocate disk space for the file in extents of the given size (0 disables),
+     * and optionally drop synced data from the page cache.
+     */
+    DomainPart & setWriteOptions(size_t preallocateSize, bool dropSyncedFromCache);
+
     ~DomainPart();
 
     const vespalib::string &fileName() const { return _fileName; }
@@ -51,6 +57,7 @@ private:
     static bool read(FastOS_FileInterface &file, IChunk::UP & chunk, Alloc &buf, bool allowTruncate);
 
     void write(FastOS_FileInterface &file, const IChunk & entry);
+    void ensurePreallocated(FastOS_FileInterface &file, int64_t end);
     void writeHeader(const common::FileHeaderContext &fileHeaderContext);
 
     class SkipInfo
@@ -88,6 +95,9 @@ private:
     // Protected by _writeLock
     SerialNum             _writtenSerial;
     SerialNum             _syncedSerial;
+    size_t                _preallocateSize;
+    int64_t               _preallocatedEnd;
+    bool                  _dropSyncedFromCache;
 };
 
 }
@@ -6,6 +6,8 @@
 
 namespace search::docsummary {
 
+class ResultClass;
+
 /**
  * Interface for object able to fetch docsum blobs based on local
  * document id.
@@ -38,6 +40,20 @@ public:
      **/
     virtual DocsumStoreValue getMappedDocsum(uint32_t docid) = 0;
 
+    /**
+     * Get a docsum blob where only the fields that are also part of
+     * the given output class need to be filled in. Other fields may
+     * be left empty, saving the work of converting them.
+     *
+     * @return docsum blob location and size
+     * @param docid local document id
+     * @param outputClass the result class that will be produced from the blob
+     **/
+    virtual DocsumStoreValue getMappedDocsum(uint32_t docid, const ResultClass &outputClass) {
+        (void) outputClass;
+        return getMappedDocsum(docid);
+    }
+
     /**
      * Will return default input class used.
      **/
@@ -76,6 +76,9 @@ DynamicDocsumWriter::resolveInputClass(ResolveClassInfo &rci, uint32_t id) const
         rci.outputClass = rci.inputClass;
         rci.outputClassInfo = rci.inputClass->getDynamicInfo();
     }
+    // field writers that are not generated may read any input field
+    rci.outputFieldsOnly = (rci.outputClass != rci.inputClass) &&
+                           (rci.outputClassInfo->_overrideCnt == rci.outputClassInfo->_generateCnt);
 }
 
 constexpr uint32_t default_32bits_int = search::attribute::getUndefined<int32_t>();
@@ -163,7 +166,9 @@ DynamicDocsumWriter::insertDocsum(const ResolveClassInfo & rci, uint32_t docid,
         }
     } else {
         // look up docsum entry
-        DocsumStoreValue value = docinfos->getMappedDocsum(docid);
+        DocsumStoreValue value = rci.outputFieldsOnly
+                                 ? docinfos->getMappedDocsum(docid, *rci.outputClass)
+                                 : docinfos->getMappedDocsum(docid);
         // re-pack docsum blob
         GeneralResult gres(rci.inputClass);
         if (! gres.inplaceUnpack(value)) {
@@ -24,12 +24,14 @@ public:
     struct ResolveClassInfo {
         bool mustSkip;
         bool allGenerated;
+        // only the fields of the input class also found in the output class are needed
+        bool outputFieldsOnly;
         uint32_t outputClassId;
         const ResultClass *outputClass;
         const ResultClass::DynamicInfo *outputClassInfo;
         const ResultClass *inputClass;
         ResolveClassInfo()
-            : mustSkip(false), allGenerated(false),
+            : mustSkip(false), allGenerated(false), outputFieldsOnly(false),
               outputClassId(ResultConfig::NoClassID()),
               outputClass(nullptr), outputClassInfo(nullptr), inputClass(nullptr)
         { }
@@ -3,6 +3,8 @@
 #include "sbmirror.h"
 #include <vespa/fnet/frt/supervisor.h>
 #include <vespa/fnet/frt/target.h>
+#include <algorithm>
+#include <unordered_set>
 
 #include <vespa/log/log.h>
 LOG_SETUP(".slobrok.mirror");
@@ -29,7 +31,8 @@ MirrorAPI::MirrorAPI(FRT_Supervisor &orb, const ConfiguratorFactory & config)
       _idx(0),
       _backOff(),
       _target(0),
-      _req(0)
+      _req(0),
+      _loadStart(vespalib::steady_clock::now())
 {
     _configurator->poll();
     LOG_ASSERT(_slobrokSpecs.ok());
@@ -167,28 +170,31 @@ MirrorAPI::handleIncrementalFetch()
                 diff_from, diff_to, numRemove, numNames);
         }
         SpecList specs;
+        specs.reserve(numNames);
         for (uint32_t idx = 0; idx < numNames; idx++) {
             specs.push_back(
                     std::make_pair(std::string(n[idx]._str),
                                    std::string(s[idx]._str)));
         }
         updateTo(specs, diff_to);
+        LOG(debug, "loaded %u services from %s in %.3f seconds",
+            numNames, _currSlobrok.c_str(), vespalib::to_s(vespalib::steady_clock::now() - _loadStart));
     } else if (_specsGen == diff_from) {
         // incremental update
+        std::unordered_set<std::string> changed;
+        changed.reserve(numRemove + numNames);
+        for (uint32_t idx = 0; idx < numRemove; idx++) {
+            changed.emplace(r[idx]._str, r[idx]._len);
+        }
+        for (uint32_t idx = 0; idx < numNames; idx++) {
+            changed.emplace(n[idx]._str, n[idx]._len);
+        }
         SpecList specs;
-        SpecList::const_iterator end = _specs.end();
-        for (SpecList::const_iterator it = _specs.begin();
-             it != end;
-             ++it)
-        {
-            bool keep = true;
-            for (uint32_t idx = 0; idx < numRemove; idx++) {
-                if (it->first == r[idx]._str) keep = false;
+        specs.reserve(_specs.size() + numNames);
+        for (const auto & entry : _specs) {
+            if (changed.find(entry.first) == changed.end()) {
+                specs.push_back(entry);
             }
-            for (uint32_t idx = 0; idx < numNames; idx++) {
-                if (it->first == n[idx]._str) keep = false;
-            }
-            if (keep) specs.push_back(*it);
         }
         for (uint32_t idx = 0; idx < numNames; idx++) {
             specs.push_back(
@@ -224,6 +230,11 @@ MirrorAPI::handleReqDone()
         bool reconn = (_target == 0);
 
         if (_req->IsError()) {
+            if (_req->GetErrorCode() == FRTE_RPC_TIMEOUT && _rpc_ms < 15000) {
+                // the answer did not make it within the short timeout used until the
+                // first answer (e.g. a large initial dump); allow more time next try
+                _rpc_ms = std::min(2 * _rpc_ms, 15000);
+            }
             reconn = true;
         } else {
             reconn = handleIncrementalFetch();
@@ -253,6 +264,7 @@ MirrorAPI::handleReconnect()
             _target = _orb.GetTarget(_currSlobrok.c_str());
         }
         _specsGen.reset();
+        _loadStart = vespalib::steady_clock::now();
         if (_target == 0) {
             if (_rpc_ms < 50000) {
                 _rpc_ms += 100;
@@ -5,6 +5,7 @@
 #include "backoff.h"
 #include "sblist.h"
 #include <vespa/vespalib/util/gencnt.h>
+#include <vespa/vespalib/util/time.h>
 #include <vespa/fnet/frt/invoker.h>
 
 class FRT_Target;
@@ -103,6 +104,7 @@ private:
     BackOff                  _backOff;
     FRT_Target              *_target;
     FRT_RPCRequest          *_req;
+    vespalib::steady_time    _loadStart;
 };
 
 } // namespace slobrok::api
@@ -53,9 +53,12 @@ History::since(vespalib::GenCnt gen) const
 {
     citer_t i = _entries.cbegin();
     citer_t end = _entries.cend();
-    while (i != end) {
-        if (i->gen == gen) break;
-        ++i;
+    if (has(gen)) {
+        // entries have consecutive generations, see verify()
+        i += _entries.front().gen.distance(gen);
+        LOG_ASSERT(i->gen == gen);
+    } else {
+        i = end;
     }
     std::set<std::string> ret;
     while (i != end) {
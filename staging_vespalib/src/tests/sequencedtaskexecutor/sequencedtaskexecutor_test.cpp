@@ -2,6 +2,7 @@
 
 #include <vespa/vespalib/util/sequencedtaskexecutor.h>
 #include <vespa/vespalib/util/adaptive_sequenced_executor.h>
+#include <vespa/vespalib/util/gate.h>
 
 #include <vespa/vespalib/testkit/testapp.h>
 #include <vespa/vespalib/test/insertion_operators.h>
@@ -250,6 +251,45 @@ TEST("require that you distribute well") {
     EXPECT_EQUAL(97u, seq.getComponentEffectiveHashSize());
 }
 
+TEST("require that strands multiply the number of executor ids") {
+    auto iseq = SequencedTaskExecutor::create(2, 1000, Executor::OptimizeFor::LATENCY, 0, 10ms, 4);
+    const auto & seq = dynamic_cast<const SequencedTaskExecutor &>(*iseq);
+    EXPECT_EQUAL(8u, iseq->getNumExecutors());
+    for (uint32_t id = 0; id < 8; ++id) {
+        EXPECT_EQUAL(id % 2, seq.getThreadForExecutorId(ISequencedTaskExecutor::ExecutorId(id)));
+    }
+}
+
+TEST("require that idle strand is moved away from thread busy with other strand") {
+    auto iseq = SequencedTaskExecutor::create(2, 1000, Executor::OptimizeFor::LATENCY, 0, 10ms, 4);
+    const auto & seq = dynamic_cast<const SequencedTaskExecutor &>(*iseq);
+    ISequencedTaskExecutor::ExecutorId hot(0);
+    ISequencedTaskExecutor::ExecutorId cold(2);
+    EXPECT_EQUAL(seq.getThreadForExecutorId(hot), seq.getThreadForExecutorId(cold));
+    Gate hotGate;
+    std::shared_ptr<TestObj> tv(std::make_shared<TestObj>());
+    iseq->execute(hot, [&]() { hotGate.await(); });
+    iseq->execute(cold, [=]() { tv->modify(0, 14); });
+    iseq->execute(cold, [=]() { tv->modify(14, 42); });
+    tv->wait(2);
+    EXPECT_NOT_EQUAL(seq.getThreadForExecutorId(hot), seq.getThreadForExecutorId(cold));
+    EXPECT_EQUAL(0,  tv->_fail);
+    EXPECT_EQUAL(42, tv->_val);
+    hotGate.countDown();
+    iseq->sync();
+}
+
+TEST("require that accepted tasks are counted per executor id") {
+    auto iseq = SequencedTaskExecutor::create(2, 1000, Executor::OptimizeFor::LATENCY, 0, 10ms, 2);
+    for (uint32_t i = 0; i < 3; ++i) {
+        iseq->execute(ISequencedTaskExecutor::ExecutorId(1), []() {});
+    }
+    iseq->execute(ISequencedTaskExecutor::ExecutorId(3), []() {});
+    iseq->sync();
+    EXPECT_EQUAL(std::vector<size_t>({0, 3, 0, 1}), iseq->getAcceptedTasksPerExecutorId());
+    EXPECT_EQUAL(std::vector<size_t>({0, 0, 0, 0}), iseq->getAcceptedTasksPerExecutorId());
+}
+
 TEST("Test creation of different types") {
     auto iseq = SequencedTaskExecutor::create(1);
 
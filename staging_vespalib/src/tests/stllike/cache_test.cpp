@@ -136,4 +136,66 @@ TEST("testThatMultipleRemoveOnOverflowIsFine") {
     EXPECT_EQUAL(2924u, cache.sizeBytes());
 }
 
+TEST("require that frequency sketch counts recent accesses") {
+    FrequencySketch sketch(1000);
+    for (uint32_t i(0); i < 5; i++) {
+        sketch.increment(42);
+    }
+    sketch.increment(7);
+    EXPECT_EQUAL(5u, sketch.frequency(42));
+    EXPECT_EQUAL(1u, sketch.frequency(7));
+    EXPECT_EQUAL(0u, sketch.frequency(1000000));
+    for (uint32_t i(0); i < 100; i++) {
+        sketch.increment(42);
+    }
+    EXPECT_EQUAL(15u, sketch.frequency(42));
+    for (uint64_t key(100); sketch.getResetCount() == 0; key++) {
+        sketch.increment(key);
+    }
+    EXPECT_EQUAL(7u, sketch.frequency(42));
+}
+
+TEST("require that admission filter protects frequently read objects from a scan") {
+    B m;
+    for (uint32_t i(0); i < 1000; i++) {
+        m[i] = "10 bytes s";
+    }
+    cache< CacheParam<P, B, zero<uint32_t>, size<string> > > cache(m, 900);
+    cache.admissionFilter(100);
+    EXPECT_TRUE(cache.hasAdmissionFilter());
+    for (uint32_t round(0); round < 3; round++) {
+        for (uint32_t i(0); i < 5; i++) {
+            cache.read(i);
+        }
+    }
+    EXPECT_EQUAL(5u, cache.size());
+    for (uint32_t i(100); i < 1000; i++) {
+        cache.read(i);
+    }
+    for (uint32_t i(0); i < 5; i++) {
+        EXPECT_TRUE(cache.hasKey(i));
+    }
+    EXPECT_LESS_EQUAL(cache.sizeBytes(), 900u);
+    EXPECT_GREATER(cache.getReject(), 800u);
+}
+
+TEST("require that all objects are admitted without admission filter") {
+    B m;
+    for (uint32_t i(0); i < 1000; i++) {
+        m[i] = "10 bytes s";
+    }
+    cache< CacheParam<P, B, zero<uint32_t>, size<string> > > cache(m, 900);
+    EXPECT_FALSE(cache.hasAdmissionFilter());
+    for (uint32_t i(0); i < 5; i++) {
+        cache.read(i);
+        cache.read(i);
+    }
+    for (uint32_t i(100); i < 1000; i++) {
+        cache.read(i);
+    }
+    EXPECT_FALSE(cache.hasKey(0));
+    EXPECT_TRUE(cache.hasKey(999));
+    EXPECT_EQUAL(0u, cache.getReject());
+}
+
 TEST_MAIN() { TEST_RUN_ALL(); }
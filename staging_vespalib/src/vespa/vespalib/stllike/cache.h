@@ -2,8 +2,10 @@
 #pragma once
 
 #include <vespa/vespalib/stllike/lrucache_map.h>
+#include <vespa/vespalib/stllike/frequency_sketch.h>
 #include <vespa/vespalib/util/sync.h>
 #include <atomic>
+#include <memory>
 
 namespace vespalib {
 
@@ -73,6 +75,17 @@ public:
 
     cache & setCapacityBytes(size_t sz);
 
+    /**
+     * Enable a TinyLFU admission filter. When the cache is full, an object read from
+     * the backing store is only inserted if it has been accessed more often recently
+     * than the object it would evict. This keeps a scan of many objects that are only
+     * accessed once (e.g. a visitor) from evicting the frequently accessed ones.
+     * Access frequencies are approximated for about expectedElements objects.
+     * 0 disables the filter.
+     */
+    cache & admissionFilter(size_t expectedElements);
+    bool hasAdmissionFilter() const { return bool(_sketch); }
+
     size_t capacity()                  const { return Lru::capacity(); }
     size_t capacityBytes()             const { return _maxBytes; }
     size_t size()                      const { return Lru::size(); }
@@ -118,6 +131,7 @@ public:
     size_t        getErase() const { return _erase; }
     size_t   getInvalidate() const { return _invalidate; }
     size_t       getlookup() const { return _lookup; }
+    size_t       getReject() const { return _reject; }
 
 protected:
     vespalib::LockGuard getGuard();
@@ -133,6 +147,7 @@ private:
      */
     bool removeOldest(const value_type & v) override;
     size_t calcSize(const K & k, const V & v) const { return sizeof(value_type) + _sizeK(k) + _sizeV(v); }
+    bool admit(const vespalib::LockGuard & guard, const K & key, size_t sz) const;
     vespalib::Lock & getLock(const K & k) {
         size_t h(_hasher(k));
         return _addLocks[h%(sizeof(_addLocks)/sizeof(_addLocks[0]))];
@@ -152,6 +167,8 @@ private:
     mutable size_t      _erase;
     mutable size_t      _invalidate;
     mutable size_t      _lookup;
+    size_t              _reject;
+    std::unique_ptr<FrequencySketch> _sketch;
     BackingStore      & _store;
     vespalib::Lock      _hashLock;
     /// Striped locks that can be used for having a locked access to the backing store.
@@ -27,6 +27,14 @@ cache<P>::setCapacityBytes(size_t sz) {
     return *this;
 }
 
+template< typename P >
+cache<P> &
+cache<P>::admissionFilter(size_t expectedElements) {
+    vespalib::LockGuard guard(_hashLock);
+    _sketch = (expectedElements != 0) ? std::make_unique<FrequencySketch>(expectedElements) : std::unique_ptr<FrequencySketch>();
+    return *this;
+}
+
 template< typename P >
 void
 cache<P>::invalidate(const K & key) {
@@ -65,6 +73,8 @@ cache<P>::cache(BackingStore & b, size_t maxBytes) :
     _erase(0),
     _invalidate(0),
     _lookup(0),
+    _reject(0),
+    _sketch(),
     _store(b)
 { }
 
@@ -84,12 +94,26 @@ cache<P>::getGuard() {
     return vespalib::LockGuard(_hashLock);
 }
 
+template< typename P >
+bool
+cache<P>::admit(const vespalib::LockGuard & guard, const K & key, size_t sz) const
+{
+    (void) guard;
+    if ( ! _sketch || Lru::empty() || ((_sizeBytes + sz < _maxBytes) && (Lru::size() < Lru::capacity()))) {
+        return true;
+    }
+    return _sketch->frequency(_hasher(key)) > _sketch->frequency(_hasher(Lru::oldestKey()));
+}
+
 template< typename P >
 typename P::Value
 cache<P>::read(const K & key)
 {
     {
         vespalib::LockGuard guard(_hashLock);
+        if (_sketch) {
+            _sketch->increment(_hasher(key));
+        }
         if (Lru::hasKey(key)) {
             _hit++;
             return (*this)[key];
@@ -110,9 +134,13 @@ cache<P>::read(const K & key)
     V value;
     if (_store.read(key, value)) {
         vespalib::LockGuard guard(_hashLock);
-        Lru::insert(key, value);
-        _sizeBytes += calcSize(key, value);
-        _insert++;
+        if (admit(guard, key, calcSize(key, value))) {
+            Lru::insert(key, value);
+            _sizeBytes += calcSize(key, value);
+            _insert++;
+        } else {
+            _reject++;
+        }
     } else {
         _noneExisting.fetch_add(1);
     }
@@ -0,0 +1,81 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "frequency_sketch.h"
+#include <algorithm>
+
+namespace vespalib {
+
+namespace {
+
+constexpr uint64_t SEEDS[] = { 0xc3a5c85c97cb3127ul, 0xb492b66fbe98f273ul, 0x9ae16a3b2f90404ful, 0xcbf29ce484222325ul };
+
+size_t
+roundUp2inN(size_t n)
+{
+    size_t result = 64;
+    while (result < n) {
+        result <<= 1;
+    }
+    return result;
+}
+
+}
+
+FrequencySketch::FrequencySketch(size_t expectedElements)
+    : _table(roundUp2inN(expectedElements), 0),
+      _mask(_table.size() - 1),
+      _sampleSize(10 * std::max(expectedElements, size_t(1))),
+      _size(0),
+      _resets(0)
+{
+}
+
+FrequencySketch::~FrequencySketch() = default;
+
+uint64_t
+FrequencySketch::probe(uint64_t hash, uint32_t i)
+{
+    // Mix the hash so each probe picks an independent word and counter.
+    uint64_t h = (hash + SEEDS[i]) * 0x9e3779b97f4a7c15ul;
+    return h ^ (h >> 32);
+}
+
+void
+FrequencySketch::increment(uint64_t hash)
+{
+    bool added = false;
+    for (uint32_t i = 0; i < NUM_PROBES; ++i) {
+        uint64_t h = probe(hash, i);
+        uint32_t shift = (h >> 60) << 2;
+        uint64_t & word = _table[h & _mask];
+        if (((word >> shift) & 0xf) < 0xf) {
+            word += (uint64_t(1) << shift);
+            added = true;
+        }
+    }
+    if (added && (++_size >= _sampleSize)) {
+        reset();
+    }
+}
+
+uint32_t
+FrequencySketch::frequency(uint64_t hash) const
+{
+    uint32_t result = 0xf;
+    for (uint32_t i = 0; i < NUM_PROBES; ++i) {
+        result = std::min(result, counter(probe(hash, i)));
+    }
+    return result;
+}
+
+void
+FrequencySketch::reset()
+{
+    for (uint64_t & word : _table) {
+        word = (word >> 1) & 0x7777777777777777ul;
+    }
+    _size /= 2;
+    ++_resets;
+}
+
+}
@@ -0,0 +1,47 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+namespace vespalib {
+
+/**
+ * Approximate access frequency of a large set of keys, using a
+ * count-min sketch of 4 bit counters. When the number of recorded
+ * accesses reaches 10 times the expected number of elements, all
+ * counters are halved, so the frequencies reflect recent history.
+ * Used by the TinyLFU admission filter of the cache to decide if a
+ * new element is more valuable than the element it would evict.
+ * Not thread safe.
+ */
+class FrequencySketch
+{
+public:
+    FrequencySketch(size_t expectedElements);
+    ~FrequencySketch();
+    /**
+     * Record an access of the key with the given hash.
+     */
+    void increment(uint64_t hash);
+    /**
+     * Return the estimated number of recent accesses of the key with the given hash, at most 15.
+     */
+    uint32_t frequency(uint64_t hash) const;
+    size_t getSampleSize() const { return _sampleSize; }
+    size_t getResetCount() const { return _resets; }
+private:
+    static constexpr uint32_t NUM_PROBES = 4;
+    static uint64_t probe(uint64_t hash, uint32_t i);
+    uint32_t counter(uint64_t h) const { return (_table[h & _mask] >> ((h >> 60) << 2)) & 0xf; }
+    void reset();
+
+    std::vector<uint64_t> _table;
+    uint64_t              _mask;
+    size_t                _sampleSize;
+    size_t                _size;
+    size_t                _resets;
+};
+
+}
@@ -152,6 +152,12 @@ public:
      */
     bool hasKey(const K & key) const { return HashTable::find(key) != HashTable::end(); }
 
+    /**
+     * Return the key of the least recently used object, which is the next one to be evicted.
+     * Must not be called when empty.
+     */
+    const K & oldestKey() const { return HashTable::getByInternalIndex(_tail).first; }
+
     /**
      * Called when an object is inserted, to see if the LRU should be removed.
      * Default is to obey the maxsize given in constructor.
@@ -8,7 +8,8 @@ namespace vespalib {
 
 AdaptiveSequencedExecutor::Strand::Strand()
     : state(State::IDLE),
-      queue()
+      queue(),
+      accepted_tasks(0)
 {
 }
 
@@ -277,6 +278,7 @@ AdaptiveSequencedExecutor::executeTask(ExecutorId id, Task::UP task)
     strand.queue.push(TaggedTask(std::move(task), _barrier.startEvent()));
     _stats.queueSize.add(++_self.pending_tasks);
     ++_stats.acceptedTasks;
+    ++strand.accepted_tasks;
     if (strand.state == Strand::State::WAITING) {
         ++_self.waiting_tasks;
     } else if (strand.state == Strand::State::IDLE) {
@@ -334,4 +336,17 @@ AdaptiveSequencedExecutor::getStats()
     return stats;
 }
 
+std::vector<size_t>
+AdaptiveSequencedExecutor::getAcceptedTasksPerExecutorId()
+{
+    auto guard = std::lock_guard(_mutex);
+    std::vector<size_t> result;
+    result.reserve(_strands.size());
+    for (auto &strand : _strands) {
+        result.push_back(strand.accepted_tasks);
+        strand.accepted_tasks = 0;
+    }
+    return result;
+}
+
 }
@@ -73,6 +73,7 @@ private:
         enum class State { IDLE, WAITING, ACTIVE };
         State state;
         vespalib::ArrayQueue<TaggedTask> queue;
+        size_t accepted_tasks;
         Strand();
         ~Strand();
     };
@@ -149,6 +150,7 @@ public:
     void sync() override;
     void setTaskLimit(uint32_t task_limit) override;
     vespalib::ExecutorStats getStats() override;
+    std::vector<size_t> getAcceptedTasksPerExecutorId() override;
 };
 
 }
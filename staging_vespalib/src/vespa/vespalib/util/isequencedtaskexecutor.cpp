@@ -12,6 +12,12 @@ ISequencedTaskExecutor::ISequencedTaskExecutor(uint32_t numExecutors)
 
 ISequencedTaskExecutor::~ISequencedTaskExecutor() = default;
 
+std::vector<size_t>
+ISequencedTaskExecutor::getAcceptedTasksPerExecutorId()
+{
+    return {};
+}
+
 ISequencedTaskExecutor::ExecutorId
 ISequencedTaskExecutor::getExecutorIdFromName(vespalib::stringref componentId) const {
     vespalib::hash<vespalib::stringref> hashfun;
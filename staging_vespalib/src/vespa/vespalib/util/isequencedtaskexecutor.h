@@ -72,6 +72,13 @@ public:
 
     virtual vespalib::ExecutorStats getStats() = 0;
 
+    /**
+     * Get the number of tasks accepted for each executor id since the
+     * previous call. Used to observe how evenly the tasks are spread
+     * over the executor ids. Empty if not tracked by the executor.
+     */
+    virtual std::vector<size_t> getAcceptedTasksPerExecutorId();
+
     /**
      * Wrap lambda function into a task and schedule it to be run.
      * Caller must ensure that pointers and references are valid and
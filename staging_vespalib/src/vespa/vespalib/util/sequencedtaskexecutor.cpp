@@ -16,9 +16,34 @@ constexpr uint8_t MAGIC = 255;
 
 }
 
+/**
+ * Wrapper of a task, tracking that its strand and thread have one
+ * less pending task after it has run.
+ */
+class SequencedTaskExecutor::StrandTask : public vespalib::Executor::Task {
+    vespalib::Executor::Task::UP _task;
+    std::atomic<uint32_t>       &_strandPending;
+    std::atomic<uint32_t>       &_threadPending;
+public:
+    StrandTask(vespalib::Executor::Task::UP task, std::atomic<uint32_t> &strandPending, std::atomic<uint32_t> &threadPending)
+        : _task(std::move(task)),
+          _strandPending(strandPending),
+          _threadPending(threadPending)
+    {
+    }
+    void run() override {
+        _task->run();
+        // The task is destroyed before the strand can be moved to another thread
+        _task.reset();
+        _threadPending.fetch_sub(1, std::memory_order_relaxed);
+        _strandPending.fetch_sub(1, std::memory_order_release);
+    }
+};
+
 
 std::unique_ptr<ISequencedTaskExecutor>
-SequencedTaskExecutor::create(uint32_t threads, uint32_t taskLimit, OptimizeFor optimize, uint32_t kindOfWatermark, duration reactionTime)
+SequencedTaskExecutor::create(uint32_t threads, uint32_t taskLimit, OptimizeFor optimize, uint32_t kindOfWatermark, duration reactionTime,
+                              uint32_t strandsPerThread)
 {
     if (optimize == OptimizeFor::ADAPTIVE) {
         size_t num_strands = std::min(taskLimit, threads*32);
@@ -34,7 +59,7 @@ SequencedTaskExecutor::create(uint32_t threads, uint32_t taskLimit, OptimizeFor
                 executors->push_back(std::make_unique<BlockingThreadStackExecutor>(1, stackSize, taskLimit));
             }
         }
-        return std::unique_ptr<ISequencedTaskExecutor>(new SequencedTaskExecutor(std::move(executors)));
+        return std::unique_ptr<ISequencedTaskExecutor>(new SequencedTaskExecutor(std::move(executors), std::max(1u, strandsPerThread)));
     }
 }
 
@@ -43,14 +68,21 @@ SequencedTaskExecutor::~SequencedTaskExecutor()
     sync();
 }
 
-SequencedTaskExecutor::SequencedTaskExecutor(std::unique_ptr<std::vector<std::unique_ptr<vespalib::SyncableThreadExecutor>>> executors)
-    : ISequencedTaskExecutor(executors->size()),
+SequencedTaskExecutor::SequencedTaskExecutor(std::unique_ptr<std::vector<std::unique_ptr<vespalib::SyncableThreadExecutor>>> executors,
+                                             uint32_t strandsPerThread)
+    : ISequencedTaskExecutor(executors->size() * strandsPerThread),
       _executors(std::move(executors)),
+      _strands(getNumExecutors()),
+      _threadPending(_executors->size()),
+      _remapStrands(strandsPerThread > 1),
       _component2Id(vespalib::hashtable_base::getModuloStl(getNumExecutors()*8), MAGIC),
       _mutex(),
       _nextId(0)
 {
     assert(getNumExecutors() < 256);
+    for (uint32_t id = 0; id < _strands.size(); ++id) {
+        _strands[id].thread = id % _executors->size();
+    }
 }
 
 void
@@ -64,11 +96,37 @@ SequencedTaskExecutor::setTaskLimit(uint32_t taskLimit)
 void
 SequencedTaskExecutor::executeTask(ExecutorId id, vespalib::Executor::Task::UP task)
 {
-    assert(id.getId() < _executors->size());
-    auto rejectedTask = (*_executors)[id.getId()]->execute(std::move(task));
+    assert(id.getId() < _strands.size());
+    Strand &strand = _strands[id.getId()];
+    strand.accepted.fetch_add(1, std::memory_order_relaxed);
+    uint32_t thread = id.getId();
+    if (_remapStrands) {
+        thread = selectThread(strand);
+        task = std::make_unique<StrandTask>(std::move(task), strand.pending, _threadPending[thread]);
+    }
+    auto rejectedTask = (*_executors)[thread]->execute(std::move(task));
     assert(!rejectedTask);
 }
 
+uint32_t
+SequencedTaskExecutor::selectThread(Strand &strand)
+{
+    std::lock_guard guard(_mutex);
+    if (strand.pending.load(std::memory_order_acquire) == 0) {
+        // No tasks to keep in sequence with, use the least loaded thread.
+        uint32_t best = strand.thread;
+        for (uint32_t thread = 0; thread < _threadPending.size(); ++thread) {
+            if (_threadPending[thread].load(std::memory_order_relaxed) < _threadPending[best].load(std::memory_order_relaxed)) {
+                best = thread;
+            }
+        }
+        strand.thread = best;
+    }
+    strand.pending.fetch_add(1, std::memory_order_relaxed);
+    _threadPending[strand.thread].fetch_add(1, std::memory_order_relaxed);
+    return strand.thread;
+}
+
 void
 SequencedTaskExecutor::sync()
 {
@@ -94,6 +152,17 @@ SequencedTaskExecutor::getStats()
     return accumulatedStats;
 }
 
+std::vector<size_t>
+SequencedTaskExecutor::getAcceptedTasksPerExecutorId()
+{
+    std::vector<size_t> result;
+    result.reserve(_strands.size());
+    for (auto &strand : _strands) {
+        result.push_back(strand.accepted.exchange(0, std::memory_order_relaxed));
+    }
+    return result;
+}
+
 ISequencedTaskExecutor::ExecutorId
 SequencedTaskExecutor::getExecutorId(uint64_t componentId) const {
     uint32_t shrunkId = componentId % _component2Id.size();
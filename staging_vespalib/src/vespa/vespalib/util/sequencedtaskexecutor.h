@@ -3,6 +3,7 @@
 
 #include "isequencedtaskexecutor.h"
 #include <vespa/vespalib/util/time.h>
+#include <atomic>
 
 namespace vespalib {
 
@@ -11,6 +12,12 @@ class SyncableThreadExecutor;
 /**
  * Class to run multiple tasks in parallel, but tasks with same
  * id has to be run in sequence.
+ *
+ * With more than one strand per thread, each executor id (strand) is
+ * mapped to a thread while it has pending tasks. A strand without
+ * pending tasks is moved to the thread with the fewest pending tasks
+ * when it gets a new task, so strands sharing a thread with a hot
+ * strand do not have to wait for it.
  */
 class SequencedTaskExecutor final : public ISequencedTaskExecutor
 {
@@ -26,22 +33,38 @@ public:
     ExecutorId getExecutorId(uint64_t componentId) const override;
     void sync() override;
     Stats getStats() override;
+    std::vector<size_t> getAcceptedTasksPerExecutorId() override;
 
     /*
      * Note that if you choose Optimize::THROUGHPUT, you must ensure only a single producer, or synchronize on the outside.
      *
      */
     static std::unique_ptr<ISequencedTaskExecutor>
-    create(uint32_t threads, uint32_t taskLimit = 1000, OptimizeFor optimize = OptimizeFor::LATENCY, uint32_t kindOfWatermark = 0, duration reactionTime = 10ms);
+    create(uint32_t threads, uint32_t taskLimit = 1000, OptimizeFor optimize = OptimizeFor::LATENCY, uint32_t kindOfWatermark = 0, duration reactionTime = 10ms, uint32_t strandsPerThread = 1);
     /**
      * For testing only
      */
     uint32_t getComponentHashSize() const { return _component2Id.size(); }
     uint32_t getComponentEffectiveHashSize() const { return _nextId; }
+    uint32_t getThreadForExecutorId(ExecutorId id) const { return _strands[id.getId()].thread; }
 private:
-    SequencedTaskExecutor(std::unique_ptr<std::vector<std::unique_ptr<vespalib::SyncableThreadExecutor>>> executor);
+    class StrandTask;
+
+    struct Strand {
+        uint32_t              thread;   // guarded by _mutex
+        std::atomic<uint32_t> pending;
+        std::atomic<size_t>   accepted;
+        Strand() : thread(0), pending(0), accepted(0) {}
+    };
+
+    SequencedTaskExecutor(std::unique_ptr<std::vector<std::unique_ptr<vespalib::SyncableThreadExecutor>>> executor,
+                          uint32_t strandsPerThread);
+    uint32_t selectThread(Strand &strand);
 
     std::unique_ptr<std::vector<std::unique_ptr<vespalib::SyncableThreadExecutor>>> _executors;
+    std::vector<Strand>                    _strands;
+    std::vector<std::atomic<uint32_t>>     _threadPending;
+    bool                                   _remapStrands;
     mutable std::vector<uint8_t> _component2Id;
     mutable std::mutex           _mutex;
     mutable uint32_t             _nextId;
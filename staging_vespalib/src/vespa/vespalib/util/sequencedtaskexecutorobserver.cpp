@@ -49,6 +49,11 @@ vespalib::ExecutorStats SequencedTaskExecutorObserver::getStats() {
     return _executor.getStats();
 }
 
+std::vector<size_t>
+SequencedTaskExecutorObserver::getAcceptedTasksPerExecutorId() {
+    return _executor.getAcceptedTasksPerExecutorId();
+}
+
 ISequencedTaskExecutor::ExecutorId
 SequencedTaskExecutorObserver::getExecutorId(uint64_t componentId) const {
     return _executor.getExecutorId(componentId);
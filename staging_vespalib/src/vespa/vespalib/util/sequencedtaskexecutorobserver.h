@@ -28,6 +28,7 @@ public:
     void sync() override;
     void setTaskLimit(uint32_t taskLimit) override;
     vespalib::ExecutorStats getStats() override;
+    std::vector<size_t> getAcceptedTasksPerExecutorId() override;
 
     uint32_t getExecuteCnt() const { return _executeCnt; }
     uint32_t getSyncCnt() const { return _syncCnt; }
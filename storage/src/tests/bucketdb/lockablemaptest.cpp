@@ -563,6 +563,30 @@ TYPED_TEST(LockableMapTest, find_all) {
 
     guard_results = guard->find_parents_self_and_children(BucketId(16, 0xffff));
     EXPECT_THAT(guard_results, ElementsAre(A(9,10,11)));
+
+    std::vector<std::pair<BucketId, A>> keyed_results;
+    guard->for_each_parent_self_and_child(BucketId(17, 0x1aaaa), [&keyed_results](uint64_t key, const A& value) {
+        keyed_results.emplace_back(BucketId(BucketId::keyToBucketId(key)), value);
+    });
+    EXPECT_THAT(keyed_results, UnorderedElementsAre(Pair(id1.stripUnused(), A(1,2,3)),
+                                                    Pair(id5.stripUnused(), A(5,6,7)),
+                                                    Pair(id6.stripUnused(), A(6,7,8)),
+                                                    Pair(id7.stripUnused(), A(7,8,9))));
+}
+
+TYPED_TEST(LockableMapTest, can_find_exact_bucket_via_read_guard) {
+    TypeParam map;
+    document::BucketId id1(16, 0x1234);
+    document::BucketId id2(17, 0x1234);
+    bool pre_existed;
+    map.insert(id1.toKey(), A(1, 2, 3), "foo", pre_existed);
+    map.insert(id2.toKey(), A(4, 5, 6), "foo", pre_existed);
+
+    auto guard = map.acquire_read_guard();
+    EXPECT_EQ(std::optional<A>(A(1, 2, 3)), guard->find(id1));
+    EXPECT_EQ(std::optional<A>(A(4, 5, 6)), guard->find(id2));
+    EXPECT_FALSE(guard->find(document::BucketId(18, 0x1234)).has_value());
+    EXPECT_FALSE(guard->find(document::BucketId(16, 0x4321)).has_value());
 }
 
 TYPED_TEST(LockableMapTest, find_all_2) { // Ticket 3121525
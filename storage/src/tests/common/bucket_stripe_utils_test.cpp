@@ -0,0 +1,64 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/storage/common/bucket_stripe_utils.h>
+#include <vespa/vespalib/gtest/gtest.h>
+
+using document::BucketId;
+using namespace ::testing;
+
+namespace storage {
+
+TEST(BucketStripeUtilsTest, stripe_is_given_by_lowest_location_bits) {
+    EXPECT_EQ(0, stripe_of_bucket(BucketId(16, 0x1230), 4));
+    EXPECT_EQ(1, stripe_of_bucket(BucketId(16, 0x1238), 4)); // bit 3 set -> reversed to msb 0
+    EXPECT_EQ(8, stripe_of_bucket(BucketId(16, 0x1231), 4)); // bit 0 set -> reversed to msb 3
+    EXPECT_EQ(15, stripe_of_bucket(BucketId(16, 0x123f), 4));
+}
+
+TEST(BucketStripeUtilsTest, all_buckets_map_to_stripe_zero_with_zero_stripe_bits) {
+    EXPECT_EQ(0, stripe_of_bucket(BucketId(16, 0x123f), 0));
+    EXPECT_EQ(0, stripe_of_bucket_key(UINT64_MAX, 0));
+}
+
+TEST(BucketStripeUtilsTest, parent_and_child_buckets_map_to_same_stripe) {
+    BucketId parent(8, 0x5a);
+    BucketId child_0(9, 0x05a);
+    BucketId child_1(9, 0x15a);
+    BucketId grandchild(20, 0xabc5a);
+    for (uint8_t bits = 0; bits <= MaxStripeBits; ++bits) {
+        uint32_t stripe = stripe_of_bucket(parent, bits);
+        EXPECT_EQ(stripe, stripe_of_bucket(child_0, bits));
+        EXPECT_EQ(stripe, stripe_of_bucket(child_1, bits));
+        EXPECT_EQ(stripe, stripe_of_bucket(grandchild, bits));
+    }
+}
+
+TEST(BucketStripeUtilsTest, all_stripes_are_used) {
+    std::vector<uint32_t> seen(1u << MaxStripeBits, 0);
+    for (uint64_t location = 0; location < 256; ++location) {
+        ++seen[stripe_of_bucket(BucketId(8, location), MaxStripeBits)];
+    }
+    for (uint32_t count : seen) {
+        EXPECT_EQ(1, count);
+    }
+}
+
+TEST(BucketStripeUtilsTest, num_stripe_bits_is_calculated_from_num_stripes) {
+    EXPECT_EQ(0, calc_num_stripe_bits(1));
+    EXPECT_EQ(1, calc_num_stripe_bits(2));
+    EXPECT_EQ(2, calc_num_stripe_bits(4));
+    EXPECT_EQ(4, calc_num_stripe_bits(16));
+    EXPECT_EQ(MaxStripeBits, calc_num_stripe_bits(1u << MaxStripeBits));
+}
+
+TEST(BucketStripeUtilsTest, num_stripes_is_adjusted_to_valid_value) {
+    EXPECT_EQ(1, adjusted_num_stripes(0));
+    EXPECT_EQ(1, adjusted_num_stripes(1));
+    EXPECT_EQ(2, adjusted_num_stripes(2));
+    EXPECT_EQ(4, adjusted_num_stripes(3));
+    EXPECT_EQ(8, adjusted_num_stripes(5));
+    EXPECT_EQ(16, adjusted_num_stripes(16));
+    EXPECT_EQ(256, adjusted_num_stripes(300));
+}
+
+}
@@ -119,4 +119,31 @@ TEST(IdempotentStateTransitionTest, may_elide_changed_startup_timestamps) {
                                          state_of("distributor:3 storage:3 .0.t:654321")));
 }
 
+TEST(OwnershipRecheckElisionTest, changed_storage_node_states_allow_elision) {
+    EXPECT_TRUE(ownership_recheck_may_be_elided(state_of("distributor:3 storage:3"),
+                                                state_of("distributor:3 storage:3 .0.s:d")));
+    EXPECT_TRUE(ownership_recheck_may_be_elided(state_of("distributor:3 storage:3 .0.s:d"),
+                                                state_of("distributor:3 storage:4")));
 }
+
+TEST(OwnershipRecheckElisionTest, changed_cluster_state_or_bit_count_disallows_elision) {
+    EXPECT_FALSE(ownership_recheck_may_be_elided(state_of("cluster:d distributor:3 storage:3"),
+                                                 state_of("distributor:3 storage:3")));
+    EXPECT_FALSE(ownership_recheck_may_be_elided(state_of("bits:8 distributor:3 storage:3"),
+                                                 state_of("bits:9 distributor:3 storage:3")));
+}
+
+TEST(OwnershipRecheckElisionTest, changed_distributor_availability_disallows_elision) {
+    EXPECT_FALSE(ownership_recheck_may_be_elided(state_of("distributor:3 storage:3"),
+                                                 state_of("distributor:4 storage:3")));
+    EXPECT_FALSE(ownership_recheck_may_be_elided(state_of("distributor:3 storage:3"),
+                                                 state_of("distributor:3 .1.s:d storage:3")));
+    // Maintenance is an up state when calculating the ideal distributor
+    EXPECT_TRUE(ownership_recheck_may_be_elided(state_of("distributor:3 storage:3"),
+                                                state_of("distributor:3 .1.s:m storage:3")));
+    EXPECT_TRUE(ownership_recheck_may_be_elided(state_of("distributor:3 .1.s:d storage:3"),
+                                                state_of("distributor:3 .1.s:r storage:3")));
+}
+
+}
+
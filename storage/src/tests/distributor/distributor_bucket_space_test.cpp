@@ -0,0 +1,71 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/storage/distributor/distributor_bucket_space.h>
+#include <vespa/document/bucket/bucketid.h>
+#include <vespa/vdslib/distribution/distribution.h>
+#include <vespa/vdslib/state/clusterstate.h>
+#include <vespa/vespalib/util/stringfmt.h>
+#include <gtest/gtest.h>
+
+using document::BucketId;
+
+namespace storage::distributor {
+
+struct DistributorBucketSpaceTest : ::testing::Test {
+    DistributorBucketSpace bucket_space;
+
+    DistributorBucketSpaceTest() : bucket_space() {
+        bucket_space.setDistribution(std::make_shared<lib::Distribution>(
+                lib::Distribution::getDefaultDistributionConfig(2, 10)));
+        set_state("bits:8 distributor:10 storage:10");
+    }
+
+    void set_state(const char* state) {
+        bucket_space.setClusterState(std::make_shared<lib::ClusterState>(state));
+    }
+
+    std::vector<uint16_t> uncached_ideal_nodes(const BucketId& bucket, const char* up_states = "uim") const {
+        return bucket_space.getDistribution().getIdealStorageNodes(bucket_space.getClusterState(), bucket, up_states);
+    }
+
+    void assert_ideal_nodes_match_distribution(const char* up_states) {
+        for (uint32_t used_bits : {8u, 16u, 33u, 34u, 40u}) {
+            for (uint64_t i = 0; i < 64; ++i) {
+                BucketId bucket(used_bits, (i * 0x9e3779b97f4a7c15ULL) >> (64 - used_bits));
+                // Look up twice, so that the second lookup hits the cache
+                ASSERT_EQ(uncached_ideal_nodes(bucket, up_states), bucket_space.get_ideal_nodes(bucket, up_states))
+                    << bucket << " up states " << up_states;
+                ASSERT_EQ(uncached_ideal_nodes(bucket, up_states), bucket_space.get_ideal_nodes(bucket, up_states))
+                    << bucket << " up states " << up_states;
+            }
+        }
+    }
+};
+
+TEST_F(DistributorBucketSpaceTest, cached_ideal_nodes_match_distribution) {
+    assert_ideal_nodes_match_distribution("uim");
+    assert_ideal_nodes_match_distribution("ui");
+}
+
+TEST_F(DistributorBucketSpaceTest, cached_ideal_nodes_are_invalidated_by_cluster_state_change) {
+    BucketId bucket(16, 0x1234);
+    auto before = bucket_space.get_ideal_nodes(bucket);
+    ASSERT_EQ(2u, before.size());
+    set_state(vespalib::make_string("bits:8 distributor:10 storage:10 .%u.s:d", before[0]).c_str());
+    auto after = bucket_space.get_ideal_nodes(bucket);
+    EXPECT_EQ(uncached_ideal_nodes(bucket), after);
+    EXPECT_NE(before, after);
+    assert_ideal_nodes_match_distribution("uim");
+}
+
+TEST_F(DistributorBucketSpaceTest, ideal_nodes_are_correct_with_disks_down) {
+    set_state("bits:8 distributor:10 storage:10 .3.d:4 .3.d.1.s:d .7.d:4 .7.d.2.s:d");
+    assert_ideal_nodes_match_distribution("uim");
+}
+
+TEST_F(DistributorBucketSpaceTest, too_few_used_bits_is_not_cached) {
+    EXPECT_THROW(bucket_space.get_ideal_nodes(BucketId(4, 0)), lib::TooFewBucketBitsInUseException);
+    EXPECT_THROW(bucket_space.get_ideal_nodes(BucketId(4, 0)), lib::TooFewBucketBitsInUseException);
+}
+
+}
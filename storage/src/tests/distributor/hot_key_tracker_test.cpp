@@ -0,0 +1,79 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/storage/distributor/hot_key_tracker.h>
+#include <vespa/vespalib/gtest/gtest.h>
+
+namespace storage::distributor {
+
+namespace {
+
+struct IdentityHash {
+    size_t operator()(uint64_t key) const noexcept { return key; }
+};
+
+using Tracker = HotKeyTracker<uint64_t, IdentityHash>;
+
+}
+
+TEST(HotKeyTrackerTest, estimate_is_never_less_than_actual_count) {
+    Tracker tracker(64, 4, 1, 1000000);
+    for (uint64_t key = 0; key < 500; ++key) {
+        for (uint64_t i = 0; i <= (key % 5); ++i) {
+            tracker.add(key);
+        }
+    }
+    for (uint64_t key = 0; key < 500; ++key) {
+        EXPECT_GE(tracker.estimate(key), (key % 5) + 1) << "key " << key;
+    }
+    EXPECT_EQ(1500u, tracker.events());
+}
+
+TEST(HotKeyTrackerTest, hottest_keys_are_tracked_in_descending_order) {
+    Tracker tracker(1024, 3, 1, 1000000);
+    for (uint64_t key = 0; key < 100; ++key) {
+        tracker.add(key);
+    }
+    for (int i = 0; i < 50; ++i) {
+        tracker.add(1000);
+        if (i < 30) {
+            tracker.add(2000);
+        }
+        if (i < 20) {
+            tracker.add(3000);
+        }
+    }
+    auto hottest = tracker.hottest();
+    ASSERT_EQ(3u, hottest.size());
+    EXPECT_EQ(1000u, hottest[0].key);
+    EXPECT_EQ(50u, hottest[0].count);
+    EXPECT_EQ(2000u, hottest[1].key);
+    EXPECT_EQ(30u, hottest[1].count);
+    EXPECT_EQ(3000u, hottest[2].key);
+    EXPECT_EQ(20u, hottest[2].count);
+    EXPECT_EQ(50u, tracker.hottest_count());
+}
+
+TEST(HotKeyTrackerTest, only_every_nth_event_is_sampled) {
+    Tracker tracker(1024, 4, 10, 1000000);
+    for (int i = 0; i < 100; ++i) {
+        tracker.add(7);
+    }
+    EXPECT_EQ(10u, tracker.estimate(7));
+    EXPECT_EQ(100u, tracker.events());
+}
+
+TEST(HotKeyTrackerTest, counts_are_halved_when_decay_threshold_is_reached) {
+    Tracker tracker(1024, 4, 1, 10);
+    for (int i = 0; i < 9; ++i) {
+        tracker.add(1);
+    }
+    tracker.add(2);
+    EXPECT_EQ(4u, tracker.estimate(1));
+    EXPECT_EQ(0u, tracker.estimate(2));
+    auto hottest = tracker.hottest();
+    ASSERT_EQ(1u, hottest.size());
+    EXPECT_EQ(1u, hottest[0].key);
+    EXPECT_EQ(4u, hottest[0].count);
+}
+
+}
@@ -43,4 +43,21 @@ TEST(OperationSequencerTest, releasing_handle_allows_for_getting_new_handles_for
     EXPECT_TRUE(third_handle.valid());
 }
 
+TEST(OperationSequencerTest, failed_acquisitions_are_tracked_as_conflicts) {
+    OperationSequencer sequencer;
+    DocumentId id("id:foo:test::abcd");
+    auto first_handle = sequencer.try_acquire(id);
+    for (int i = 0; i < 3; ++i) {
+        auto handle = sequencer.try_acquire(id);
+        EXPECT_FALSE(handle.valid());
+    }
+    auto other_handle = sequencer.try_acquire(DocumentId("id:foo:test::efgh"));
+    EXPECT_EQ(2u, sequencer.num_active());
+    EXPECT_EQ(3u, sequencer.conflicts().events());
+    auto hottest = sequencer.conflicts().hottest();
+    ASSERT_EQ(1u, hottest.size());
+    EXPECT_EQ(id.getGlobalId(), hottest[0].key);
+    EXPECT_EQ(3u, hottest[0].count);
+}
+
 } // storage::distributor
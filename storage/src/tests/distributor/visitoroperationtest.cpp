@@ -784,6 +784,44 @@ TEST_F(VisitorOperationTest, parallel_visitors_to_one_storage_node_one_super_buc
               _sender.getLastReply());
 }
 
+TEST_F(VisitorOperationTest, parallel_visitors_to_one_storage_node_are_balanced_on_document_count) {
+    enableDistributorClusterState("distributor:1 storage:1");
+
+    addNodesToBucketDB(document::BucketId(21, 0x00001), "0=1/100/100/t");
+    addNodesToBucketDB(document::BucketId(21, 0x10001), "0=1/1/1/t");
+    addNodesToBucketDB(document::BucketId(21, 0x20001), "0=1/1/1/t");
+    addNodesToBucketDB(document::BucketId(21, 0x30001), "0=1/1/1/t");
+
+    document::BucketId id(16, 1);
+
+    auto op = createOpWithConfig(
+            createVisitorCommand("balancedbuckets", id, nullId),
+            VisitorOperation::Config(1, 2));
+
+    op->start(_sender, framework::MilliSecTime(0));
+
+    ASSERT_EQ("Visitor Create => 0,Visitor Create => 0",
+              _sender.getCommands(true));
+
+    // The large bucket gets a visitor of its own, instead of sharing one
+    // with every other bucket in visit order.
+    ASSERT_EQ("CreateVisitorCommand(dumpvisitor, , 1 buckets) Buckets: [ "
+              "BucketId(0x5400000000000001) ]",
+              serializeVisitorCommand(0));
+    ASSERT_EQ("CreateVisitorCommand(dumpvisitor, , 3 buckets) Buckets: [ "
+              "BucketId(0x5400000000020001) BucketId(0x5400000000010001) "
+              "BucketId(0x5400000000030001) ]",
+              serializeVisitorCommand(1));
+
+    for (uint32_t i = 0; i < 2; ++i) {
+        sendReply(*op, i);
+    }
+
+    EXPECT_EQ("CreateVisitorReply(last=BucketId(0x000000007fffffff)) "
+              "ReturnCode(NONE)",
+              _sender.getLastReply());
+}
+
 TEST_F(VisitorOperationTest, visit_when_one_bucket_copy_is_invalid) {
     enableDistributorClusterState("distributor:1 storage:2");
 
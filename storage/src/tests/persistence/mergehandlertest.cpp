@@ -241,6 +241,8 @@ MergeHandlerTest::testGetBucketDiffChain(bool midChain)
         auto diff = cmd2.getDiff();
         EXPECT_EQ(17, diff.size());
         EXPECT_EQ(1, cmd2.getAddress()->getIndex());
+        // The diff sent on is not also kept in the pending reply
+        EXPECT_TRUE(getEnv()._fileStorHandler.editMergeStatus(_bucket).pendingGetDiff->getDiff().empty());
 
         LOG(debug, "Verifying that replying the diff sends on back");
         auto reply = std::make_unique<api::GetBucketDiffReply>(cmd2);
@@ -127,6 +127,16 @@ public:
         return dynamic_cast<api::StorageReply &>(*msg).getResult();
     }
 
+    api::StorageReply::SP
+    fetchReply(MessageTracker::UP tracker) {
+        if (tracker) {
+            return std::move(*tracker).stealReplySP();
+        }
+        std::shared_ptr<api::StorageMessage> msg;
+        _replySender.queue.getNext(msg, 60000);
+        return std::dynamic_pointer_cast<api::StorageReply>(msg);
+    }
+
     /**
        Performs a put to the given disk.
        Returns the document that was inserted.
@@ -254,13 +254,11 @@ TestAndSetTest::createTestDocument()
 document::Document::SP TestAndSetTest::retrieveTestDocument()
 {
     auto get = std::make_shared<api::GetCommand>(BUCKET, testDocId, document::AllFields::NAME);
-    auto tracker = thread->handleGet(*get, createTracker(get, BUCKET));
-    assert(tracker->getResult() == api::ReturnCode::Result::OK);
+    auto reply = std::dynamic_pointer_cast<api::GetReply>(fetchReply(thread->handleGet(*get, createTracker(get, BUCKET))));
+    assert(reply && (reply->getResult() == api::ReturnCode::Result::OK));
+    assert(reply->wasFound());
 
-    auto & reply = static_cast<api::GetReply &>(tracker->getReply());
-    assert(reply.wasFound());
-
-    return reply.getDocument();
+    return reply->getDocument();
 }
 
 void TestAndSetTest::setTestCondition(api::TestAndSetCommand & command)
@@ -203,6 +203,9 @@ public:
 
     std::vector<Entry> find_parents_and_self(const document::BucketId& bucket) const override;
     std::vector<Entry> find_parents_self_and_children(const document::BucketId& bucket) const override;
+    void for_each_parent_self_and_child(const document::BucketId& bucket,
+                                        std::function<void(uint64_t, const Entry&)> func) const override;
+    std::optional<Entry> find(const document::BucketId& bucket) const override;
     void for_each(std::function<void(uint64_t, const Entry&)> func) const override;
     [[nodiscard]] uint64_t generation() const noexcept override;
 };
@@ -231,6 +234,21 @@ BTreeBucketDatabase::ReadGuardImpl::find_parents_self_and_children(const documen
     return entries;
 }
 
+void
+BTreeBucketDatabase::ReadGuardImpl::for_each_parent_self_and_child(const document::BucketId& bucket,
+                                                                   std::function<void(uint64_t, const Entry&)> func) const {
+    _snapshot.find_parents_self_and_children<ByValue>(bucket, std::move(func));
+}
+
+std::optional<Entry>
+BTreeBucketDatabase::ReadGuardImpl::find(const document::BucketId& bucket) const {
+    std::optional<Entry> result;
+    _snapshot.find<ByValue>(bucket, [&result]([[maybe_unused]] uint64_t key, Entry entry){
+        result = std::move(entry);
+    });
+    return result;
+}
+
 void BTreeBucketDatabase::ReadGuardImpl::for_each(std::function<void(uint64_t, const Entry&)> func) const {
     _snapshot.for_each<ByValue>(std::move(func));
 }
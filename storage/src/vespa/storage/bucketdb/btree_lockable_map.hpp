@@ -364,6 +364,9 @@ public:
 
     std::vector<T> find_parents_and_self(const document::BucketId& bucket) const override;
     std::vector<T> find_parents_self_and_children(const document::BucketId& bucket) const override;
+    void for_each_parent_self_and_child(const document::BucketId& bucket,
+                                        std::function<void(uint64_t, const T&)> func) const override;
+    std::optional<T> find(const document::BucketId& bucket) const override;
     void for_each(std::function<void(uint64_t, const T&)> func) const override;
     [[nodiscard]] uint64_t generation() const noexcept override;
 };
@@ -400,6 +403,25 @@ BTreeLockableMap<T>::ReadGuardImpl::find_parents_self_and_children(const documen
     return entries;
 }
 
+template <typename T>
+void
+BTreeLockableMap<T>::ReadGuardImpl::for_each_parent_self_and_child(const document::BucketId& bucket,
+                                                                   std::function<void(uint64_t, const T&)> func) const {
+    _snapshot.template find_parents_self_and_children<ByConstRef>(bucket, std::move(func));
+}
+
+template <typename T>
+std::optional<T>
+BTreeLockableMap<T>::ReadGuardImpl::find(const document::BucketId& bucket) const {
+    std::optional<T> result;
+    _snapshot.template find<ByConstRef>(
+            bucket,
+            [&result]([[maybe_unused]] uint64_t key, const T& entry){
+                result = entry;
+            });
+    return result;
+}
+
 template <typename T>
 void BTreeLockableMap<T>::ReadGuardImpl::for_each(std::function<void(uint64_t, const T&)> func) const {
     _snapshot.template for_each<ByConstRef>(std::move(func));
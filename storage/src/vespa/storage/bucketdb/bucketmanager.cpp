@@ -220,9 +220,8 @@ namespace {
 StorBucketDatabase::Entry
 BucketManager::getBucketInfo(const document::Bucket &bucket) const
 {
-    StorBucketDatabase::WrappedEntry entry(
-            _component.getBucketDatabase(bucket.getBucketSpace()).get(bucket.getBucketId(), "BucketManager::getBucketInfo"));
-    return *entry;
+    auto guard = _component.getBucketDatabase(bucket.getBucketSpace()).acquire_read_guard();
+    return guard->find(bucket.getBucketId()).value_or(StorBucketDatabase::Entry());
 }
 
 void
@@ -439,18 +438,13 @@ bool BucketManager::onRequestBucketInfo(
     BucketSpace bucketSpace(cmd->getBucketSpace());
     api::RequestBucketInfoReply::EntryVector info;
     if (cmd->getBuckets().size()) {
-        typedef std::map<document::BucketId,
-                         StorBucketDatabase::WrappedEntry> BucketMap;
+        auto guard = _component.getBucketDatabase(bucketSpace).acquire_read_guard();
         for (uint32_t i = 0; i < cmd->getBuckets().size(); i++) {
-            BucketMap entries(_component.getBucketDatabase(bucketSpace).getAll(
-                                    cmd->getBuckets()[i],
-                                    "BucketManager::onRequestBucketInfo"));
-            for (BucketMap::iterator it = entries.begin();
-                 it != entries.end(); ++it)
-            {
-                info.push_back(api::RequestBucketInfoReply::Entry(
-                            it->first, it->second->getBucketInfo()));
-            }
+            guard->for_each_parent_self_and_child(cmd->getBuckets()[i],
+                    [&info](uint64_t key, const StorBucketDatabase::Entry& entry) {
+                        info.emplace_back(document::BucketId(document::BucketId::keyToBucketId(key)),
+                                          entry.getBucketInfo());
+                    });
         }
     } else {
         LOG(error, "We don't support fetching bucket info without bucket "
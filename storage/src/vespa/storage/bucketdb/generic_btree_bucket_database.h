@@ -131,6 +131,9 @@ public:
         void find_parents_self_and_children(const document::BucketId& bucket, Func func) const;
         template <typename IterValueExtractor, typename Func>
         void for_each(Func func) const;
+        // Invokes func with the entry of the exact given bucket iff it exists. Returns whether it exists.
+        template <typename IterValueExtractor, typename Func>
+        bool find(const document::BucketId& bucket, Func func) const;
         [[nodiscard]] uint64_t generation() const noexcept;
     };
 private:
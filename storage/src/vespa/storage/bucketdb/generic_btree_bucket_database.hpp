@@ -555,6 +555,17 @@ void GenericBTreeBucketDatabase<DataStoreTraitsT>::ReadSnapshot::for_each(Func f
     }
 }
 
+template <typename DataStoreTraitsT>
+template <typename IterValueExtractor, typename Func>
+bool GenericBTreeBucketDatabase<DataStoreTraitsT>::ReadSnapshot::find(const BucketId& bucket, Func func) const {
+    auto iter = _frozen_view.find(bucket.toKey());
+    if (!iter.valid()) {
+        return false;
+    }
+    func(iter.getKey(), IterValueExtractor::apply(*_db, iter));
+    return true;
+}
+
 template <typename DataStoreTraitsT>
 uint64_t GenericBTreeBucketDatabase<DataStoreTraitsT>::ReadSnapshot::generation() const noexcept {
     return _guard.getGeneration();
@@ -325,6 +325,24 @@ public:
         return entries;
     }
 
+    void for_each_parent_self_and_child(const document::BucketId& bucket,
+                                        std::function<void(uint64_t, const mapped_type&)> func) const override {
+        auto& mutable_map = const_cast<LockableMap<Map>&>(_map); // _map is thread safe.
+        auto locked_entries = mutable_map.getAll(bucket, "ReadGuardImpl::for_each_parent_self_and_child");
+        for (auto& e : locked_entries) {
+            func(e.first.toKey(), *e.second);
+        }
+    }
+
+    std::optional<mapped_type> find(const document::BucketId& bucket) const override {
+        auto& mutable_map = const_cast<LockableMap<Map>&>(_map); // _map is thread safe.
+        auto entry = mutable_map.get(bucket.toKey(), "ReadGuardImpl::find");
+        if (!entry.exist()) {
+            return std::nullopt;
+        }
+        return *entry;
+    }
+
     void for_each(std::function<void(uint64_t, const mapped_type&)> func) const override {
         auto decision_wrapper = [&func](uint64_t key, const mapped_type& value) -> Decision {
             func(key, value);
@@ -3,6 +3,7 @@
 
 #include <vespa/document/bucket/bucketid.h>
 #include <functional>
+#include <optional>
 #include <vector>
 
 namespace storage::bucketdb {
@@ -39,6 +40,12 @@ public:
 
     virtual std::vector<ValueT> find_parents_and_self(const document::BucketId& bucket) const = 0;
     virtual std::vector<ValueT> find_parents_self_and_children(const document::BucketId& bucket) const = 0;
+    // Same as find_parents_self_and_children(), but invokes func with the raw bucket key
+    // of each entry, in key order.
+    virtual void for_each_parent_self_and_child(const document::BucketId& bucket,
+                                                std::function<void(uint64_t, const ValueT&)> func) const = 0;
+    // Returns the value of the exact given bucket, if present in the database.
+    [[nodiscard]] virtual std::optional<ValueT> find(const document::BucketId& bucket) const = 0;
     virtual void for_each(std::function<void(uint64_t, const ValueT&)> func) const = 0;
     // If the underlying guard represents a snapshot, returns its monotonically
     // increasing generation. Otherwise returns 0.
@@ -70,6 +70,12 @@ public:
                   const key_type& first = key_type(),
                   const key_type& last = key_type() - 1);
 
+    /**
+     * Returns a guard for read-only lookups that do not take any bucket locks
+     * when the database is backed by a B-tree, as the guard then reads from a
+     * snapshot of the database. Prefer this over get() for code that does
+     * not mutate the entries it reads.
+     */
     std::unique_ptr<bucketdb::ReadGuard<Entry>> acquire_read_guard() const;
 
     /**
@@ -0,0 +1,47 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "bucket_stripe_utils.h"
+#include <cassert>
+
+namespace storage {
+
+uint32_t
+stripe_of_bucket_key(uint64_t key, uint8_t n_stripe_bits) noexcept
+{
+    assert(n_stripe_bits <= MaxStripeBits);
+    if (n_stripe_bits == 0) {
+        return 0;
+    }
+    return (key >> (64 - n_stripe_bits));
+}
+
+uint8_t
+calc_num_stripe_bits(uint32_t n_stripes) noexcept
+{
+    assert(n_stripes > 0);
+    assert((n_stripes & (n_stripes - 1)) == 0);
+    assert(n_stripes <= (1u << MaxStripeBits));
+    uint8_t result = 0;
+    while ((1u << result) < n_stripes) {
+        ++result;
+    }
+    return result;
+}
+
+uint32_t
+adjusted_num_stripes(uint32_t n_stripes) noexcept
+{
+    if (n_stripes <= 1) {
+        return 1;
+    }
+    if (n_stripes >= (1u << MaxStripeBits)) {
+        return (1u << MaxStripeBits);
+    }
+    uint32_t result = 1;
+    while (result < n_stripes) {
+        result <<= 1;
+    }
+    return result;
+}
+
+}
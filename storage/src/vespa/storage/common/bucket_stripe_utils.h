@@ -0,0 +1,44 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#pragma once
+
+#include <vespa/document/bucket/bucketid.h>
+#include <cstdint>
+
+namespace storage {
+
+/**
+ * Utilities for partitioning buckets into a power of two number of stripes.
+ *
+ * The stripe of a bucket is given by the lowest (location) bits of its bucket
+ * id, i.e. the most significant bits of its bucket key. All buckets of a
+ * subtree in the bucket tree (with at least MaxStripeBits used bits) therefore
+ * map to the same stripe, so splits and joins never move a bucket between
+ * stripes, and each stripe covers a contiguous range of bucket keys.
+ */
+
+// Buckets are never split below this number of used bits, so the stripe of a
+// bucket is always fully determined by its used bits.
+constexpr uint8_t MaxStripeBits = 8;
+
+/**
+ * Returns the stripe of the given bucket key. n_stripe_bits must be at most MaxStripeBits.
+ */
+uint32_t stripe_of_bucket_key(uint64_t key, uint8_t n_stripe_bits) noexcept;
+
+inline uint32_t stripe_of_bucket(const document::BucketId& bucket, uint8_t n_stripe_bits) noexcept {
+    return stripe_of_bucket_key(bucket.stripUnused().toKey(), n_stripe_bits);
+}
+
+/**
+ * Returns the number of stripe bits needed for the given number of stripes,
+ * which must be a power of two not larger than 2^MaxStripeBits.
+ */
+uint8_t calc_num_stripe_bits(uint32_t n_stripes) noexcept;
+
+/**
+ * Returns the given number of stripes adjusted to the closest valid value,
+ * i.e. rounded up to a power of two and capped at 2^MaxStripeBits.
+ */
+uint32_t adjusted_num_stripes(uint32_t n_stripes) noexcept;
+
+}
@@ -55,4 +55,28 @@ bool db_pruning_may_be_elided(const lib::ClusterState& a, const lib::ClusterStat
             node_states_are_idempotent_for_pruning(lib::NodeType::STORAGE, a, b, up_states));
 }
 
+bool ownership_recheck_may_be_elided(const lib::ClusterState& a, const lib::ClusterState& b) {
+    if (a.getClusterState() != b.getClusterState()) {
+        return false;
+    }
+    if (a.getDistributionBitCount() != b.getDistributionBitCount()) {
+        return false;
+    }
+    if (a.getNodeCount(lib::NodeType::DISTRIBUTOR) != b.getNodeCount(lib::NodeType::DISTRIBUTOR)) {
+        return false;
+    }
+    // Must match the up states used when calculating the ideal distributor for a bucket
+    const char* distributor_up_states = "uim";
+    const uint16_t node_count = a.getNodeCount(lib::NodeType::DISTRIBUTOR);
+    for (uint16_t i = 0; i < node_count; ++i) {
+        lib::Node node(lib::NodeType::DISTRIBUTOR, i);
+        const auto& a_s = a.getNodeState(node);
+        const auto& b_s = b.getNodeState(node);
+        if (a_s.getState().oneOf(distributor_up_states) != b_s.getState().oneOf(distributor_up_states)) {
+            return false;
+        }
+    }
+    return true;
+}
+
 }
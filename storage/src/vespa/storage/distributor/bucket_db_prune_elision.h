@@ -24,4 +24,16 @@ bool db_pruning_may_be_elided(const lib::ClusterState& a,
                               const lib::ClusterState& b,
                               const char* up_states = "uri");
 
+/*
+ * Returns whether the state transition from a -> b leaves the ownership of
+ * every bucket with the same distributor, given that the distribution config
+ * is unchanged. This is the case when the cluster state, the distribution bit
+ * count and the availability of every distributor are the same in both
+ * states, i.e. when only storage nodes differ. Pruning buckets for
+ * such a transition only has to consider which storage nodes are available,
+ * and may skip calculating the ideal distributor of each bucket.
+ */
+bool ownership_recheck_may_be_elided(const lib::ClusterState& a,
+                                     const lib::ClusterState& b);
+
 }
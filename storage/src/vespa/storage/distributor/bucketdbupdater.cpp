@@ -234,6 +234,11 @@ BucketDBUpdater::removeSuperfluousBuckets(
         auto& bucketDb(elem.second->getBucketDatabase());
         auto& readOnlyDb(_distributorComponent.getReadOnlyBucketSpaceRepo().get(elem.first).getBucketDatabase());
 
+        // Bucket ownership can only change if the distribution or the set of available
+        // distributors changes. If only storage nodes change, we only have to remove
+        // the replicas on nodes that are no longer up.
+        const bool check_ownership = (is_distribution_config_change
+                                      || !ownership_recheck_may_be_elided(oldClusterState, *new_cluster_state));
         // Remove all buckets not belonging to this distributor, or
         // being on storage nodes that are no longer up.
         MergingNodeRemover proc(
@@ -242,7 +247,8 @@ BucketDBUpdater::removeSuperfluousBuckets(
                 _distributorComponent.getIndex(),
                 newDistribution,
                 up_states,
-                move_to_read_only_db);
+                move_to_read_only_db,
+                check_ownership);
 
         bucketDb.merge(proc);
         if (move_to_read_only_db) {
@@ -906,7 +912,8 @@ BucketDBUpdater::MergingNodeRemover::MergingNodeRemover(
         uint16_t localIndex,
         const lib::Distribution& distribution,
         const char* upStates,
-        bool track_non_owned_entries)
+        bool track_non_owned_entries,
+        bool check_ownership)
     : _oldState(oldState),
       _state(s),
       _available_nodes(),
@@ -916,6 +923,7 @@ BucketDBUpdater::MergingNodeRemover::MergingNodeRemover(
       _distribution(distribution),
       _upStates(upStates),
       _track_non_owned_entries(track_non_owned_entries),
+      _check_ownership(check_ownership),
       _cachedDecisionSuperbucket(UINT64_MAX),
       _cachedOwned(false)
 {
@@ -1009,7 +1017,7 @@ BucketDBUpdater::MergingNodeRemover::merge(storage::BucketDatabase::Merger& merg
 {
     document::BucketId bucketId(merger.bucket_id());
     LOG(spam, "Check for remove: bucket %s", bucketId.toString().c_str());
-    if (!distributorOwnsBucket(bucketId)) {
+    if (_check_ownership && !distributorOwnsBucket(bucketId)) {
         // TODO remove in favor of DB snapshotting
         if (_track_non_owned_entries) {
             _nonOwnedBuckets.emplace_back(merger.current_entry());
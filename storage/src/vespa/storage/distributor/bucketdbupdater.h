@@ -212,7 +212,8 @@ private:
                            uint16_t localIndex,
                            const lib::Distribution& distribution,
                            const char* upStates,
-                           bool track_non_owned_entries);
+                           bool track_non_owned_entries,
+                           bool check_ownership = true);
         ~MergingNodeRemover() override;
 
         Result merge(BucketDatabase::Merger&) override;
@@ -238,6 +239,7 @@ private:
         const lib::Distribution& _distribution;
         const char* _upStates;
         bool _track_non_owned_entries;
+        bool _check_ownership;
 
         mutable uint64_t _cachedDecisionSuperbucket;
         mutable bool _cachedOwned;
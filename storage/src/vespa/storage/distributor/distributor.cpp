@@ -100,6 +100,8 @@ Distributor::Distributor(DistributorComponentRegister& compReg,
       _maintenanceStats(),
       _bucketSpacesStats(),
       _bucketDbStats(),
+      _hottest_document_sequencing_conflicts(0),
+      _hottest_bucket_mutations(0),
       _hostInfoReporter(*this, *this),
       _ownershipSafeTimeCalc(std::make_unique<OwnershipTransferSafeTimePointCalculator>(0s)), // Set by config later
       _db_memory_sample_interval(30s),
@@ -703,6 +705,8 @@ Distributor::propagateInternalScanMetricsToExternal()
                                         getMetrics());
         _idealStateManager.getMetrics().setPendingOperations(
                 _maintenanceStats.global.pending);
+        getMetrics().hottest_document_sequencing_conflicts.set(_hottest_document_sequencing_conflicts);
+        getMetrics().hottest_bucket_mutations.set(_hottest_bucket_mutations);
     }
 }
 
@@ -766,6 +770,14 @@ Distributor::updateInternalMetricsForCompletedScan()
     }
     _bucketSpacesStats = std::move(new_space_stats);
     maybe_update_bucket_db_memory_usage_stats();
+    update_hot_key_stats();
+}
+
+void Distributor::update_hot_key_stats() {
+    const auto& conflicts = _externalOperationHandler.mutation_sequencer().conflicts();
+    const auto& bucket_feed = _externalOperationHandler.bucket_feed_tracker();
+    _hottest_document_sequencing_conflicts = static_cast<uint64_t>(conflicts.hottest_count()) * conflicts.sample_interval();
+    _hottest_bucket_mutations = static_cast<uint64_t>(bucket_feed.hottest_count()) * bucket_feed.sample_interval();
 }
 
 void Distributor::maybe_update_bucket_db_memory_usage_stats() {
@@ -957,7 +969,9 @@ Distributor::reportStatus(std::ostream& out,
                 << "storage nodes</a><br><a href=\"?page=maintenance&show=50\">"
                 << "List maintenance queue (adjust show parameter to see more "
                 << "operations, -1 for all)</a><br>\n<a href=\"?page=buckets\">"
-                << "List all buckets, highlight non-ideal state</a><br>\n";
+                << "List all buckets, highlight non-ideal state</a><br>\n"
+                << "<a href=\"?page=hotkeys\">List documents and buckets with the "
+                << "most recent mutations and mutation conflicts</a><br>\n";
         } else {
             const_cast<IdealStateManager&>(_idealStateManager)
                 .getBucketStatus(out);
@@ -976,12 +990,43 @@ Distributor::reportStatus(std::ostream& out,
                         << XmlEndTag();
         } else if (page == "maintenance") {
             // Need new page
+        } else if (page == "hotkeys") {
+            reportHotKeys(xmlReporter.getStream());
         }
     }
 
     return true;
 }
 
+void
+Distributor::reportHotKeys(vespalib::xml::XmlOutputStream& xos) const
+{
+    using namespace vespalib::xml;
+    const auto& sequencer = _externalOperationHandler.mutation_sequencer();
+    const auto& conflicts = sequencer.conflicts();
+    xos << XmlTag("sequencingconflicts")
+        << XmlAttribute("activedocuments", sequencer.num_active())
+        << XmlAttribute("conflicts", conflicts.events());
+    for (const auto& entry : conflicts.hottest()) {
+        xos << XmlTag("document")
+            << XmlAttribute("gid", entry.key.toString())
+            << XmlAttribute("estimatedconflicts", static_cast<uint64_t>(entry.count) * conflicts.sample_interval())
+            << XmlEndTag();
+    }
+    xos << XmlEndTag();
+    const auto& bucket_feed = _externalOperationHandler.bucket_feed_tracker();
+    xos << XmlTag("bucketmutations")
+        << XmlAttribute("mutations", bucket_feed.events())
+        << XmlAttribute("sampleinterval", bucket_feed.sample_interval());
+    for (const auto& entry : bucket_feed.hottest()) {
+        xos << XmlTag("bucket")
+            << XmlAttribute("id", entry.key.toString())
+            << XmlAttribute("estimatedmutations", static_cast<uint64_t>(entry.count) * bucket_feed.sample_interval())
+            << XmlEndTag();
+    }
+    xos << XmlEndTag();
+}
+
 bool
 Distributor::handleStatusRequest(const DelegatedStatusRequest& request) const
 {
@@ -24,6 +24,8 @@
 #include <queue>
 #include <unordered_map>
 
+namespace vespalib::xml { class XmlOutputStream; }
+
 namespace storage {
     struct DoneInitializeHandler;
     class HostInfo;
@@ -230,6 +232,8 @@ private:
      */
     void updateInternalMetricsForCompletedScan();
     void maybe_update_bucket_db_memory_usage_stats();
+    void update_hot_key_stats();
+    void reportHotKeys(vespalib::xml::XmlOutputStream& xos) const;
     void scanAllBuckets();
     MaintenanceScanner::ScanResult scanNextBucket();
     bool should_inhibit_current_maintenance_scan_tick() const noexcept;
@@ -334,6 +338,9 @@ private:
     SimpleMaintenanceScanner::PendingMaintenanceStats _maintenanceStats;
     BucketSpacesStatsProvider::PerNodeBucketSpacesStats _bucketSpacesStats;
     BucketDBMetricUpdater::Stats _bucketDbStats;
+    // Estimated counts for the hottest document and bucket, also protected by _metricLock.
+    uint64_t _hottest_document_sequencing_conflicts;
+    uint64_t _hottest_bucket_mutations;
     DistributorHostInfoReporter _hostInfoReporter;
     std::unique_ptr<OwnershipTransferSafeTimePointCalculator> _ownershipSafeTimeCalc;
     std::chrono::steady_clock::duration _db_memory_sample_interval;
@@ -4,13 +4,53 @@
 #include <vespa/storage/bucketdb/btree_bucket_database.h>
 #include <vespa/vdslib/state/clusterstate.h>
 #include <vespa/vdslib/distribution/distribution.h>
+#include <vespa/document/bucket/bucketid.h>
+#include <vespa/vespalib/stllike/hash_map.hpp>
+#include <cstring>
 
 namespace storage::distributor {
 
+namespace {
+
+bool any_storage_disk_down(const lib::ClusterState& state) {
+    const uint16_t node_count = state.getNodeCount(lib::NodeType::STORAGE);
+    for (uint16_t i = 0; i < node_count; ++i) {
+        if (state.getNodeState(lib::Node(lib::NodeType::STORAGE, i)).isAnyDiskDown()) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Everything the ideal storage nodes of a bucket depend on, given that no
+// disks are down. Mirrors the group and storage seeds of lib::Distribution.
+uint64_t ideal_nodes_key(const document::BucketId& bucket, uint16_t distribution_bits) {
+    const uint64_t raw = bucket.getRawId();
+    const uint64_t super_bucket = raw & ((1ull << distribution_bits) - 1);
+    uint64_t extra_seed_bits = 0;
+    if (bucket.getUsedBits() > 33) {
+        extra_seed_bits = (raw >> 32) & ((1ull << (bucket.getUsedBits() - 33)) - 1);
+    }
+    return (extra_seed_bits << 32) | super_bucket;
+}
+
+}
+
+DistributorBucketSpace::IdealNodesCache::IdealNodesCache(vespalib::stringref up_states_in)
+    : up_states(up_states_in),
+      nodes()
+{
+}
+
+DistributorBucketSpace::IdealNodesCache::IdealNodesCache(IdealNodesCache&&) noexcept = default;
+DistributorBucketSpace::IdealNodesCache::~IdealNodesCache() = default;
+
 DistributorBucketSpace::DistributorBucketSpace()
     : _bucketDatabase(std::make_unique<BTreeBucketDatabase>()),
       _clusterState(),
-      _distribution()
+      _distribution(),
+      _ideal_nodes_cacheable(false),
+      _ideal_nodes_cache()
 {
 }
 
@@ -20,12 +60,52 @@ void
 DistributorBucketSpace::setClusterState(std::shared_ptr<const lib::ClusterState> clusterState)
 {
     _clusterState = std::move(clusterState);
+    clear_ideal_nodes_cache();
 }
 
 
 void
 DistributorBucketSpace::setDistribution(std::shared_ptr<const lib::Distribution> distribution) {
     _distribution = std::move(distribution);
+    clear_ideal_nodes_cache();
+}
+
+void
+DistributorBucketSpace::clear_ideal_nodes_cache()
+{
+    _ideal_nodes_cache.clear();
+    _ideal_nodes_cacheable = (_clusterState && !any_storage_disk_down(*_clusterState));
+}
+
+DistributorBucketSpace::IdealNodesCache&
+DistributorBucketSpace::ideal_nodes_cache_for(const char* up_states) const
+{
+    for (auto& cache : _ideal_nodes_cache) {
+        if (cache.up_states == up_states) {
+            return cache;
+        }
+    }
+    _ideal_nodes_cache.emplace_back(vespalib::stringref(up_states, strlen(up_states)));
+    return _ideal_nodes_cache.back();
+}
+
+std::vector<uint16_t>
+DistributorBucketSpace::get_ideal_nodes(const document::BucketId& bucket, const char* up_states) const
+{
+    const uint16_t distribution_bits = _clusterState->getDistributionBitCount();
+    if (!_ideal_nodes_cacheable || (bucket.getUsedBits() < distribution_bits)) {
+        // Too few used bits throws from the distribution
+        return _distribution->getIdealStorageNodes(*_clusterState, bucket, up_states);
+    }
+    auto& cache = ideal_nodes_cache_for(up_states);
+    const uint64_t key = ideal_nodes_key(bucket, distribution_bits);
+    auto itr = cache.nodes.find(key);
+    if (itr != cache.nodes.end()) {
+        return itr->second;
+    }
+    auto nodes = _distribution->getIdealStorageNodes(*_clusterState, bucket, up_states);
+    cache.nodes[key] = nodes;
+    return nodes;
 }
 
 }
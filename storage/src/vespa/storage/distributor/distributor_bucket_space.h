@@ -1,12 +1,17 @@
 // Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 #pragma once
 
+#include <vespa/vespalib/stllike/hash_map.h>
+#include <vespa/vespalib/stllike/string.h>
 #include <memory>
+#include <vector>
 
 namespace storage {
 class BucketDatabase;
 }
 
+namespace document { class BucketId; }
+
 namespace storage::lib {
     class ClusterState;
     class Distribution;
@@ -24,11 +29,27 @@ namespace storage::distributor {
  *   Each bucket space _may_ operate with its own distribution config, in
  *   particular so that redundancy, ready copies etc can differ across
  *   bucket spaces.
+ * Ideal state cache
+ *   Ideal storage nodes are cached for the current cluster state and
+ *   distribution, as they are asked for repeatedly for the same buckets
+ *   during maintenance scanning and operation handling.
  */
 class DistributorBucketSpace {
+    struct IdealNodesCache {
+        vespalib::string up_states;
+        vespalib::hash_map<uint64_t, std::vector<uint16_t>> nodes;
+        explicit IdealNodesCache(vespalib::stringref up_states_in);
+        IdealNodesCache(IdealNodesCache&&) noexcept;
+        ~IdealNodesCache();
+    };
     std::unique_ptr<BucketDatabase>  _bucketDatabase;
     std::shared_ptr<const lib::ClusterState> _clusterState;
     std::shared_ptr<const lib::Distribution> _distribution;
+    bool _ideal_nodes_cacheable;
+    mutable std::vector<IdealNodesCache> _ideal_nodes_cache;
+
+    void clear_ideal_nodes_cache();
+    IdealNodesCache& ideal_nodes_cache_for(const char* up_states) const;
 public:
     explicit DistributorBucketSpace();
     ~DistributorBucketSpace();
@@ -62,6 +83,21 @@ public:
         return _distribution;
     }
 
+    /**
+     * Returns the ideal storage nodes of the given bucket in the current
+     * cluster state, as lib::Distribution::getIdealStorageNodes would.
+     *
+     * Results are cached on the bits the distribution actually depends on
+     * (the superbucket, and the extra storage seed bits of buckets split
+     * beyond 33 bits), so all buckets within a superbucket share an entry.
+     * The cache is cleared whenever the cluster state or distribution is
+     * changed, and is not used while any storage node has a disk down, as
+     * the ideal disk then depends on the full bucket id.
+     *
+     * Precondition: setClusterState and setDistribution have been called.
+     */
+    std::vector<uint16_t> get_ideal_nodes(const document::BucketId& bucket,
+                                          const char* up_states = "uim") const;
 };
 
 }
@@ -50,10 +50,7 @@ std::vector<uint16_t>
 DistributorComponent::getIdealNodes(const document::Bucket &bucket) const
 {
     auto &bucketSpace(_bucketSpaceRepo.get(bucket.getBucketSpace()));
-    return bucketSpace.getDistribution().getIdealStorageNodes(
-            bucketSpace.getClusterState(),
-            bucket.getBucketId(),
-            _distributor.getStorageNodeUpStates());
+    return bucketSpace.get_ideal_nodes(bucket.getBucketId(), _distributor.getStorageNodeUpStates());
 }
 
 BucketOwnership
@@ -50,6 +50,12 @@ DistributorMetricSet::DistributorMetricSet(const metrics::LoadTypeSet& lt)
               {{"logdefault"},{"yamasdefault"}},
               "Number of bytes stored in all buckets controlled by "
               "this distributor", this),
+      hottest_document_sequencing_conflicts("hottest_document_sequencing_conflicts", {},
+              "Estimated number of recent mutations rejected due to another mutation "
+              "already being in progress, for the document with the most such rejections", this),
+      hottest_bucket_mutations("hottest_bucket_mutations", {},
+              "Estimated number of recent mutations received for the bucket (at "
+              "minimal split level) receiving the most mutations", this),
       mutable_dbs("mutable", this),
       read_only_dbs("read_only", this)
 {}
@@ -38,6 +38,8 @@ public:
     metrics::DoubleAverageMetric recoveryModeTime;
     metrics::LongValueMetric docsStored;
     metrics::LongValueMetric bytesStored;
+    metrics::LongValueMetric hottest_document_sequencing_conflicts;
+    metrics::LongValueMetric hottest_bucket_mutations;
     BucketDbMetrics mutable_dbs;
     BucketDbMetrics read_only_dbs;
 
@@ -59,6 +59,8 @@ ExternalOperationHandler::ExternalOperationHandler(Distributor& owner,
     : DistributorComponent(owner, bucketSpaceRepo, readOnlyBucketSpaceRepo, compReg, "External operation handler"),
       _direct_dispatch_sender(std::make_unique<DirectDispatchSender>(owner)),
       _operationGenerator(gen),
+      _mutationSequencer(),
+      _bucket_feed_tracker(4096, 16, 8, 16384),
       _rejectFeedBeforeTimeReached(), // At epoch
       _non_main_thread_ops_mutex(),
       _non_main_thread_ops_owner(*_direct_dispatch_sender, getClock()),
@@ -184,6 +186,7 @@ ExternalOperationHandler::checkTimestampMutationPreconditions(api::StorageComman
         persistenceMetrics.failures.safe_time_not_reached.inc();
         return false;
     }
+    _bucket_feed_tracker.add(bucketId);
     return true;
 }
 
@@ -1,6 +1,7 @@
 // Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 #pragma once
 
+#include "hot_key_tracker.h"
 #include "operation_sequencer.h"
 #include <vespa/document/bucket/bucketid.h>
 #include <vespa/document/bucket/bucketidfactory.h>
@@ -28,6 +29,7 @@ class ExternalOperationHandler : public DistributorComponent,
 public:
     using Clock = std::chrono::system_clock;
     using TimePoint = std::chrono::time_point<Clock>;
+    using BucketFeedTracker = HotKeyTracker<document::BucketId, document::BucketId::hash>;
 
     DEF_MSG_COMMAND_H(Get);
     DEF_MSG_COMMAND_H(Put);
@@ -74,10 +76,15 @@ public:
         return _use_weak_internal_read_consistency_for_gets.load(std::memory_order_relaxed);
     }
 
+    const OperationSequencer& mutation_sequencer() const noexcept { return _mutationSequencer; }
+    // Sampled tracking of which buckets (at minimal split level) receive the most mutating operations.
+    const BucketFeedTracker& bucket_feed_tracker() const noexcept { return _bucket_feed_tracker; }
+
 private:
     std::unique_ptr<DirectDispatchSender> _direct_dispatch_sender;
     const MaintenanceOperationGenerator& _operationGenerator;
     OperationSequencer _mutationSequencer;
+    BucketFeedTracker _bucket_feed_tracker;
     Operation::SP _op;
     TimePoint _rejectFeedBeforeTimeReached;
     mutable std::mutex _non_main_thread_ops_mutex;
@@ -0,0 +1,160 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace storage::distributor {
+
+/**
+ * Tracks approximately which keys are seen most often in a stream of
+ * events, using bounded memory regardless of the number of distinct keys.
+ *
+ * Event counts per key are estimated by a count-min sketch, which may
+ * over-estimate (when keys collide in all rows) but never under-estimate.
+ * The max_tracked keys with the highest estimates are kept as candidates
+ * for reporting. Only every sample_interval'th event is recorded, and all
+ * counts are halved every time decay_threshold sampled events have been
+ * recorded, so that estimates reflect recent traffic rather than the total
+ * since process start.
+ *
+ * Not thread safe.
+ */
+template <typename KeyT, typename HashT>
+class HotKeyTracker {
+public:
+    struct Entry {
+        KeyT     key;
+        uint32_t count;
+        Entry(const KeyT& key_in, uint32_t count_in) : key(key_in), count(count_in) {}
+    };
+    using EntryVector = std::vector<Entry>;
+
+    static constexpr uint32_t Depth = 4;
+
+    HotKeyTracker(uint32_t width, uint32_t max_tracked, uint32_t sample_interval, uint64_t decay_threshold)
+        : _width(width),
+          _max_tracked(max_tracked),
+          _sample_interval(sample_interval),
+          _decay_threshold(decay_threshold),
+          _counters(static_cast<size_t>(Depth) * width, 0),
+          _top(),
+          _events(0),
+          _sampled(0)
+    {
+        assert(_width > 0);
+        assert(_sample_interval > 0);
+        _top.reserve(_max_tracked);
+    }
+
+    // Records an event for `key`, subject to sampling.
+    void add(const KeyT& key) {
+        if ((_events++ % _sample_interval) != 0) {
+            return;
+        }
+        const uint32_t count = increment(key);
+        update_top(key, count);
+        if (++_sampled >= _decay_threshold) {
+            decay();
+        }
+    }
+
+    // Estimated number of sampled events for `key` since last decay(s).
+    uint32_t estimate(const KeyT& key) const noexcept {
+        const uint64_t hash = HashT()(key);
+        uint32_t result = UINT32_MAX;
+        for (uint32_t row = 0; row < Depth; ++row) {
+            result = std::min(result, _counters[slot(hash, row)]);
+        }
+        return result;
+    }
+
+    // The tracked hottest keys, ordered by descending estimated count.
+    EntryVector hottest() const {
+        EntryVector result(_top);
+        std::sort(result.begin(), result.end(), [](const Entry& a, const Entry& b) {
+            return (a.count > b.count);
+        });
+        return result;
+    }
+
+    // Estimated count of the single hottest key, or 0 if none tracked.
+    uint32_t hottest_count() const noexcept {
+        uint32_t result = 0;
+        for (const auto& e : _top) {
+            result = std::max(result, e.count);
+        }
+        return result;
+    }
+
+    uint64_t events() const noexcept { return _events; }
+    uint32_t sample_interval() const noexcept { return _sample_interval; }
+
+    void decay() {
+        for (auto& c : _counters) {
+            c >>= 1;
+        }
+        for (auto& e : _top) {
+            e.count >>= 1;
+        }
+        _top.erase(std::remove_if(_top.begin(), _top.end(), [](const Entry& e) { return (e.count == 0); }),
+                   _top.end());
+        _sampled = 0;
+    }
+
+private:
+    uint32_t _width;
+    uint32_t _max_tracked;
+    uint32_t _sample_interval;
+    uint64_t _decay_threshold;
+    std::vector<uint32_t> _counters;
+    EntryVector _top;
+    uint64_t _events;
+    uint64_t _sampled;
+
+    size_t slot(uint64_t hash, uint32_t row) const noexcept {
+        // Derive one independent-ish hash per row by remixing the key hash (splitmix64 finalizer).
+        uint64_t h = hash + 0x9e3779b97f4a7c15ULL * (row + 1);
+        h = (h ^ (h >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        h = (h ^ (h >> 27)) * 0x94d049bb133111ebULL;
+        h ^= (h >> 31);
+        return static_cast<size_t>(row) * _width + (h % _width);
+    }
+
+    // Conservative update: only raise the counters that are at the current minimum.
+    uint32_t increment(const KeyT& key) noexcept {
+        const uint64_t hash = HashT()(key);
+        const uint32_t new_count = estimate(key) + 1;
+        for (uint32_t row = 0; row < Depth; ++row) {
+            auto& c = _counters[slot(hash, row)];
+            c = std::max(c, new_count);
+        }
+        return new_count;
+    }
+
+    void update_top(const KeyT& key, uint32_t count) {
+        if (_max_tracked == 0) {
+            return;
+        }
+        auto min_iter = _top.end();
+        for (auto iter = _top.begin(); iter != _top.end(); ++iter) {
+            if (iter->key == key) {
+                iter->count = count;
+                return;
+            }
+            if ((min_iter == _top.end()) || (iter->count < min_iter->count)) {
+                min_iter = iter;
+            }
+        }
+        if (_top.size() < _max_tracked) {
+            _top.emplace_back(key, count);
+        } else if (count > min_iter->count) {
+            *min_iter = Entry(key, count);
+        }
+    }
+};
+
+}
@@ -14,7 +14,10 @@ void SequencingHandle::release() {
     }
 }
 
-OperationSequencer::OperationSequencer() {
+OperationSequencer::OperationSequencer()
+    : _active_gids(),
+      _conflicts(1024, 16, 1, 4096)
+{
 }
 
 OperationSequencer::~OperationSequencer() {
@@ -26,6 +29,7 @@ SequencingHandle OperationSequencer::try_acquire(const document::DocumentId& id)
     if (inserted.second) {
         return SequencingHandle(*this, gid);
     } else {
+        _conflicts.add(gid);
         return SequencingHandle();
     }
 }
@@ -1,6 +1,7 @@
 // Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 #pragma once
 
+#include "hot_key_tracker.h"
 #include <vespa/document/base/globalid.h>
 #include <vespa/vespalib/stllike/hash_set.h>
 #include <utility>
@@ -65,10 +66,17 @@ public:
  *
  * When a SequencingHandle is acquired for a given ID, no further valid handles
  * can be acquired for that ID until the original handle has been destroyed.
+ *
+ * Failed acquisitions are recorded in a hot key tracker, making it possible to
+ * find the documents that are most often rejected due to concurrent mutations.
  */
 class OperationSequencer {
+public:
+    using ConflictTracker = HotKeyTracker<document::GlobalId, document::GlobalId::hash>;
+private:
     using GidSet = vespalib::hash_set<document::GlobalId, document::GlobalId::hash>;
     GidSet _active_gids;
+    ConflictTracker _conflicts;
 
     friend class SequencingHandle;
 public:
@@ -78,6 +86,9 @@ public:
     // Returns a handle with valid() == true iff no concurrent operations are
     // already active for `id`.
     SequencingHandle try_acquire(const document::DocumentId& id);
+
+    const ConflictTracker& conflicts() const noexcept { return _conflicts; }
+    size_t num_active() const noexcept { return _active_gids.size(); }
 private:
     void release(const SequencingHandle& handle);
 };
@@ -9,6 +9,8 @@
 #include <vespa/storage/distributor/visitormetricsset.h>
 #include <vespa/document/base/exceptions.h>
 #include <vespa/vespalib/stllike/asciistream.h>
+#include <algorithm>
+#include <numeric>
 #include <sstream>
 
 #include <vespa/log/log.h>
@@ -744,6 +746,49 @@ VisitorOperation::getNumVisitorsToSendForNode(uint16_t node,
     return visitorCount;
 }
 
+std::vector<std::vector<document::BucketId>>
+VisitorOperation::distributeBucketsAcrossVisitors(uint16_t node,
+                                                  const std::vector<document::BucketId>& buckets,
+                                                  uint32_t visitorCount) const
+{
+    std::vector<std::vector<document::BucketId>> bucketsVector(visitorCount);
+    if (visitorCount == 1) {
+        bucketsVector[0] = buckets;
+        return bucketsVector;
+    }
+    // The parallel visitors towards a node finish no sooner than the one
+    // with the most documents to process, so hand out the largest buckets
+    // first, each to the visitor with the fewest documents so far. Ties are
+    // broken on bucket count, which gives plain round-robin when all
+    // buckets are equally large.
+    std::vector<uint32_t> docCounts(buckets.size(), 0);
+    for (uint32_t i = 0; i < buckets.size(); ++i) {
+        BucketDatabase::Entry entry(_bucketSpace.getBucketDatabase().get(buckets[i]));
+        const BucketCopy* copy = entry.valid() ? entry->getNode(node) : nullptr;
+        if (copy != nullptr) {
+            docCounts[i] = copy->getDocumentCount();
+        }
+    }
+    std::vector<uint32_t> order(buckets.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&docCounts](uint32_t a, uint32_t b) {
+        return docCounts[a] > docCounts[b];
+    });
+    std::vector<std::pair<uint64_t, uint32_t>> load(visitorCount, std::make_pair(0, 0));
+    std::vector<uint32_t> assignedVisitor(buckets.size());
+    for (uint32_t i : order) {
+        uint32_t target = std::min_element(load.begin(), load.end()) - load.begin();
+        load[target].first += docCounts[i];
+        ++load[target].second;
+        assignedVisitor[i] = target;
+    }
+    // Keep the visit order within each visitor
+    for (uint32_t i = 0; i < buckets.size(); ++i) {
+        bucketsVector[assignedVisitor[i]].push_back(buckets[i]);
+    }
+    return bucketsVector;
+}
+
 bool
 VisitorOperation::sendStorageVisitors(const NodeToBucketsMap& nodeToBucketsMap,
                                       DistributorMessageSender& sender)
@@ -755,10 +800,7 @@ VisitorOperation::sendStorageVisitors(const NodeToBucketsMap& nodeToBucketsMap,
         if (iter->second.size() > 0) {
             int visitorCount(getNumVisitorsToSendForNode(iter->first, iter->second.size()));
 
-            std::vector<std::vector<document::BucketId> > bucketsVector(visitorCount);
-            for (unsigned int i = 0; i < iter->second.size(); i++) {
-                bucketsVector[i % visitorCount].push_back(iter->second[i]);
-            }
+            auto bucketsVector(distributeBucketsAcrossVisitors(iter->first, iter->second, visitorCount));
             for (int i = 0; i < visitorCount; i++) {
                 LOG(spam,
                     "Send visitor to node %d with %u buckets",
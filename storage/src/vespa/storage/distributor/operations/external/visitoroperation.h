@@ -110,6 +110,10 @@ private:
     bool shouldAbortDueToTimeout() const noexcept;
     bool assignBucketsToNodes(NodeToBucketsMap& nodeToBucketsMap);
     int getNumVisitorsToSendForNode(uint16_t node, uint32_t totalBucketsOnNode) const;
+    std::vector<std::vector<document::BucketId>> distributeBucketsAcrossVisitors(
+            uint16_t node,
+            const std::vector<document::BucketId>& buckets,
+            uint32_t visitorCount) const;
     vespalib::duration computeVisitorQueueTimeoutMs() const noexcept;
     bool sendStorageVisitors(const NodeToBucketsMap& nodeToBucketsMap,
                              DistributorMessageSender& sender);
@@ -75,7 +75,7 @@ StateChecker::Context::Context(const DistributorComponent& c,
       db(distributorBucketSpace.getBucketDatabase()),
       stats(statsTracker)
 {
-    idealState = distribution.getIdealStorageNodes(systemState, bucket.getBucketId());
+    idealState = distributorBucketSpace.get_ideal_nodes(bucket.getBucketId());
     unorderedIdealState.insert(idealState.begin(), idealState.end());
 }
 
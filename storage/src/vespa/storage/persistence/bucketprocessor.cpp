@@ -43,12 +43,25 @@ BucketProcessor::iterateAll(spi::PersistenceProvider& provider,
                             EntryProcessor& processor,
                             spi::IncludedVersions versions,
                             spi::Context& context)
+{
+    iterateAll(provider, bucket, documentSelection, std::make_shared<document::AllFields>(),
+               processor, versions, context);
+}
+
+void
+BucketProcessor::iterateAll(spi::PersistenceProvider& provider,
+                            const spi::Bucket& bucket,
+                            const std::string& documentSelection,
+                            std::shared_ptr<document::FieldSet> fieldSet,
+                            EntryProcessor& processor,
+                            spi::IncludedVersions versions,
+                            spi::Context& context)
 {
     spi::Selection sel
         = spi::Selection(spi::DocumentSelection(documentSelection));
     spi::CreateIteratorResult createIterResult(provider.createIterator(
             bucket,
-            std::make_shared<document::AllFields>(),
+            std::move(fieldSet),
             sel,
             versions,
             context));
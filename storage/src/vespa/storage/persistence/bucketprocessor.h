@@ -25,6 +25,15 @@ public:
                            EntryProcessor&,
                            spi::IncludedVersions,
                            spi::Context&);
+
+    // Only returns the fields in the given field set for each document
+    static void iterateAll(spi::PersistenceProvider&,
+                           const spi::Bucket&,
+                           const std::string& documentSelection,
+                           std::shared_ptr<document::FieldSet> fieldSet,
+                           EntryProcessor&,
+                           spi::IncludedVersions,
+                           spi::Context&);
 };
 
 }
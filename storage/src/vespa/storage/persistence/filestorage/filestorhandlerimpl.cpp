@@ -921,9 +921,27 @@ FileStorHandlerImpl::Disk::schedule(const std::shared_ptr<api::StorageMessage>&
 FileStorHandlerImpl::Stripe::Stripe(const FileStorHandlerImpl & owner, MessageSender & messageSender)
     : _owner(owner),
       _messageSender(messageSender),
-      _active_merges(0)
+      _active_merges(0),
+      _waiters(0),
+      _message_waiters(0)
 {}
 
+void
+FileStorHandlerImpl::Stripe::wait(vespalib::MonitorGuard & guard) const
+{
+    ++_waiters;
+    guard.wait();
+    --_waiters;
+}
+
+void
+FileStorHandlerImpl::Stripe::wait(vespalib::MonitorGuard & guard, uint32_t timeout) const
+{
+    ++_waiters;
+    guard.wait(timeout);
+    --_waiters;
+}
+
 FileStorHandler::LockedMessage
 FileStorHandlerImpl::Stripe::getNextMessage(uint32_t timeout, Disk & disk)
 {
@@ -943,7 +961,11 @@ FileStorHandlerImpl::Stripe::getNextMessage(uint32_t timeout, Disk & disk)
             return getMessage(guard, idx, iter);
         }
         if (attempt == 0) {
-            guard.wait(timeout);
+            metrics::MetricTimer timer;
+            ++_message_waiters;
+            wait(guard, timeout);
+            --_message_waiters;
+            timer.stop(_metrics->averageThreadWaitTime);
         }
     }
     return {}; // No message fetched.
@@ -967,7 +989,9 @@ FileStorHandlerImpl::Stripe::getMessage(vespalib::MonitorGuard & guard, Priority
         return FileStorHandler::LockedMessage(std::move(locker), std::move(msg));
     } else {
         std::shared_ptr<api::StorageReply> msgReply(makeQueueTimeoutReply(*msg));
-        guard.broadcast(); // XXX: needed here?
+        if (_waiters > 0) {
+            guard.broadcast(); // Queue may now be empty
+        }
         guard.unlock();
         _messageSender.sendReply(msgReply);
         return {};
@@ -987,7 +1011,7 @@ FileStorHandlerImpl::Stripe::waitUntilNoLocks() const
 {
     vespalib::MonitorGuard lockGuard(_lock);
     while (!_lockedBuckets.empty()) {
-        lockGuard.wait();
+        wait(lockGuard);
     }
 }
 
@@ -1002,7 +1026,7 @@ void
 FileStorHandlerImpl::Stripe::waitInactive(const AbortBucketOperationsCommand& cmd) const {
     vespalib::MonitorGuard lockGuard(_lock);
     while (hasActive(lockGuard, cmd)) {
-        lockGuard.wait();
+        wait(lockGuard);
     }
 }
 
@@ -1047,7 +1071,16 @@ bool FileStorHandlerImpl::Stripe::schedule(MessageEntry messageEntry)
 {
     vespalib::MonitorGuard lockGuard(_lock);
     _queue.emplace_back(std::move(messageEntry));
-    lockGuard.broadcast();
+    // A single new message can only be processed by a single thread, so
+    // wake just one if all waiters are persistence threads.
+    if (_waiters == 0) {
+        return true;
+    }
+    if (_waiters == _message_waiters) {
+        lockGuard.signal();
+    } else {
+        lockGuard.broadcast();
+    }
     return true;
 }
 
@@ -1057,7 +1090,7 @@ FileStorHandlerImpl::Stripe::flush()
     vespalib::MonitorGuard lockGuard(_lock);
     while (!(_queue.empty() && _lockedBuckets.empty())) {
         LOG(debug, "Still %ld in queue and %ld locked buckets", _queue.size(), _lockedBuckets.size());
-        lockGuard.wait(100);
+        wait(lockGuard, 100);
     }
 }
 
@@ -1104,7 +1137,9 @@ void FileStorHandlerImpl::Stripe::release(const document::Bucket & bucket,
     if (!entry._exclusiveLock && entry._sharedLocks.empty()) {
         _lockedBuckets.erase(iter); // No more locks held
     }
-    guard.broadcast();
+    if (_waiters > 0) {
+        guard.broadcast();
+    }
 }
 
 void FileStorHandlerImpl::Stripe::lock(const vespalib::MonitorGuard &, const document::Bucket & bucket,
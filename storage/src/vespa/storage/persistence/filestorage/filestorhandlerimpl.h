@@ -138,6 +138,8 @@ public:
         void setMetrics(FileStorStripeMetrics * metrics) { _metrics = metrics; }
     private:
         bool hasActive(vespalib::MonitorGuard & monitor, const AbortBucketOperationsCommand& cmd) const;
+        void wait(vespalib::MonitorGuard & guard) const;
+        void wait(vespalib::MonitorGuard & guard, uint32_t timeout) const;
         // Precondition: the bucket used by `iter`s operation is not locked in a way that conflicts
         // with its locking requirements.
         FileStorHandler::LockedMessage getMessage(vespalib::MonitorGuard & guard, PriorityIdx & idx,
@@ -150,6 +152,12 @@ public:
         PriorityQueue             _queue;
         LockedBuckets             _lockedBuckets;
         uint32_t                  _active_merges;
+        // Number of threads waiting on _lock, and how many of those are
+        // persistence threads waiting for a message to process. Used to
+        // avoid signalling when nobody waits, and to wake a single thread
+        // instead of all of them when a message is scheduled.
+        mutable uint32_t          _waiters;
+        uint32_t                  _message_waiters;
     };
     struct Disk {
         FileStorDiskMetrics * metrics;
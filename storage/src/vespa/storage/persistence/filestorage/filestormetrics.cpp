@@ -167,7 +167,10 @@ FileStorStripeMetrics::FileStorStripeMetrics(const std::string& name, const std:
       averageQueueWaitingTime(loadTypes,
                               metrics::DoubleAverageMetric("averagequeuewait", {},
                                                            "Average time an operation spends in input queue."),
-                              this)
+                              this),
+      averageThreadWaitTime("averagethreadwait", {},
+                            "Average time a persistence thread waits for a message to process in this stripe.",
+                            this)
 {
 }
 
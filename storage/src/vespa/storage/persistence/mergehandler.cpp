@@ -107,10 +107,10 @@ struct DiffEntryTimestampPredicate {
 } // anonymous namespace
 
 void
-MergeHandler::populateMetaData(
+MergeHandler::iterateMetaData(
         const spi::Bucket& bucket,
         Timestamp maxTimestamp,
-        std::vector<spi::DocEntry::UP>& entries,
+        const std::function<void(spi::IterateResult::List)>& consumer,
         spi::Context& context)
 {
     spi::DocumentSelection docSel("");
@@ -136,7 +136,7 @@ MergeHandler::populateMetaData(
     IteratorGuard iteratorGuard(_spi, iteratorId, context);
 
     while (true) {
-        spi::IterateResult result(_spi.iterate(iteratorId, UINT64_MAX, context));
+        spi::IterateResult result(_spi.iterate(iteratorId, _maxChunkSize, context));
         if (result.getErrorCode() != spi::Result::ErrorType::NONE) {
             std::ostringstream ss;
             ss << "Failed to iterate for "
@@ -145,12 +145,23 @@ MergeHandler::populateMetaData(
                << result.getErrorMessage();
             throw std::runtime_error(ss.str());
         }
-        auto list = result.steal_entries();
-        std::move(list.begin(), list.end(), std::back_inserter(entries));
+        consumer(result.steal_entries());
         if (result.isCompleted()) {
             break;
         }
     }
+}
+
+void
+MergeHandler::populateMetaData(
+        const spi::Bucket& bucket,
+        Timestamp maxTimestamp,
+        std::vector<spi::DocEntry::UP>& entries,
+        spi::Context& context)
+{
+    iterateMetaData(bucket, maxTimestamp, [&entries](spi::IterateResult::List list) {
+        std::move(list.begin(), list.end(), std::back_inserter(entries));
+    }, context);
     std::sort(entries.begin(), entries.end(),
               IndirectDocEntryTimestampPredicate());
 }
@@ -219,25 +230,31 @@ MergeHandler::buildBucketInfoList(
         }
     }
 
-    std::vector<spi::DocEntry::UP> entries;
-    populateMetaData(bucket, maxTimestamp, entries, context);
-
-    for (size_t i = 0; i < entries.size(); ++i) {
-        api::GetBucketDiffCommand::Entry diff;
-        const spi::DocEntry& entry(*entries[i]);
-        diff._gid = GlobalId();
-        // We do not know doc sizes at this point, so just set to 0
-        diff._headerSize = 0;
-        diff._bodySize = 0;
-        diff._timestamp = entry.getTimestamp();
-        diff._flags = IN_USE
-                      | (entry.isRemove() ? DELETED : 0);
-        diff._hasMask = 1 << myNodeIndex;
-        output.push_back(diff);
-
-        LOG(spam, "bucket info list of %s: Adding entry %s to diff",
-            bucket.toString().c_str(), diff.toString(true).c_str());
-    }
+    // Convert each iterated chunk of metadata to diff entries right away, so
+    // that only the compact diff entries are kept for the whole bucket.
+    iterateMetaData(bucket, maxTimestamp, [&](spi::IterateResult::List entries) {
+        output.reserve(output.size() + entries.size());
+        for (const auto& entryUP : entries) {
+            api::GetBucketDiffCommand::Entry diff;
+            const spi::DocEntry& entry(*entryUP);
+            diff._gid = GlobalId();
+            // We do not know doc sizes at this point, so just set to 0
+            diff._headerSize = 0;
+            diff._bodySize = 0;
+            diff._timestamp = entry.getTimestamp();
+            diff._flags = IN_USE
+                          | (entry.isRemove() ? DELETED : 0);
+            diff._hasMask = 1 << myNodeIndex;
+            output.push_back(diff);
+
+            LOG(spam, "bucket info list of %s: Adding entry %s to diff",
+                bucket.toString().c_str(), diff.toString(true).c_str());
+        }
+    }, context);
+    std::sort(output.begin(), output.end(),
+              [](const api::GetBucketDiffCommand::Entry& a, const api::GetBucketDiffCommand::Entry& b) {
+                  return (a._timestamp < b._timestamp);
+              });
     LOG(spam, "Built bucket info list of %s. Got %u entries.",
         bucket.toString().c_str(), (uint32_t) (output.size() - oldSize));
     return true;
@@ -1103,6 +1120,11 @@ MergeHandler::handleGetBucketDiff(api::GetBucketDiffCommand& cmd, MessageTracker
     if (!mergeLists(remote, local, local)) {
         LOG(error, "Diffing %s found suspect entries.", bucket.toString().c_str());
     }
+    // The remote entries are now part of the local list. Release them, so
+    // that they are neither held by the command nor copied into the reply
+    // created from it below.
+    size_t remoteSize = remote.size();
+    std::vector<api::GetBucketDiffCommand::Entry>().swap(remote);
     _env._metrics.merge_handler_metrics.mergeMetadataReadLatency.addValue(startTime.getElapsedTimeAsDouble());
 
     // If last node in merge chain, we can send reply straight away
@@ -1143,7 +1165,7 @@ MergeHandler::handleGetBucketDiff(api::GetBucketDiffCommand& cmd, MessageTracker
 
         LOG(spam, "Sending GetBucketDiff for %s on to node %d, added %zu new entries to diff.",
             bucket.toString().c_str(), cmd.getNodes()[index + 1].index,
-            local.size() - remote.size());
+            local.size() - remoteSize);
         auto cmd2 = std::make_shared<api::GetBucketDiffCommand>(bucket.getBucket(), cmd.getNodes(), cmd.getMaxTimestamp());
         cmd2->setAddress(createAddress(_env._component.getClusterName(), cmd.getNodes()[index + 1].index));
         cmd2->getDiff().swap(local);
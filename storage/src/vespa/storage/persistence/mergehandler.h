@@ -18,6 +18,7 @@
 #include <vespa/storage/persistence/persistenceutil.h>
 #include <vespa/storageapi/message/bucket.h>
 #include <vespa/storage/common/messagesender.h>
+#include <functional>
 
 namespace storage {
 
@@ -81,6 +82,16 @@ private:
                         spi::Context& context,
                         const document::DocumentTypeRepo& repo);
 
+    /**
+     * Iterate metadata for bucket up to maxTimestamp, passing each chunk of
+     * at most (approximately) max chunk size bytes to consumer, in iteration
+     * order. Throws std::runtime_error upon iteration failure.
+     */
+    void iterateMetaData(const spi::Bucket&,
+                         Timestamp maxTimestamp,
+                         const std::function<void(spi::IterateResult::List)>& consumer,
+                         spi::Context& context);
+
     /**
      * Fill entries-vector with metadata for bucket up to maxTimestamp,
      * sorted ascendingly on entry timestamp.
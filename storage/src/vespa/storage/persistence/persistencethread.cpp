@@ -295,31 +295,48 @@ getFieldSet(const document::FieldSetRepo & repo, vespalib::stringref name, Messa
     return document::FieldSet::SP();
 }
 
+void
+handleGetResult(api::GetCommand& cmd, const document::FieldSet& fieldSet, spi::GetResult& result,
+                FileStorThreadMetrics::OpWithNotFound& metrics, MessageTracker& tracker)
+{
+    if (tracker.checkForError(result)) {
+        if (!result.hasDocument() && (document::FieldSet::Type::NONE != fieldSet.getType())) {
+            metrics.notFound.inc();
+        }
+        tracker.setReply(std::make_shared<api::GetReply>(cmd, result.getDocumentPtr(), result.getTimestamp(),
+                                                         false, result.is_tombstone()));
+    }
+}
+
 }
 
 MessageTracker::UP
-PersistenceThread::handleGet(api::GetCommand& cmd, MessageTracker::UP tracker)
+PersistenceThread::handleGet(api::GetCommand& cmd, MessageTracker::UP trackerUP)
 {
+    MessageTracker & tracker = *trackerUP;
     auto& metrics = _env._metrics.get[cmd.getLoadType()];
-    tracker->setMetric(metrics);
+    tracker.setMetric(metrics);
     metrics.request_size.addValue(cmd.getApproxByteSize());
 
-    auto fieldSet = getFieldSet(*_env._component.getTypeRepo()->fieldSetRepo, cmd.getFieldSet(), *tracker);
-    if ( ! fieldSet) { return tracker; }
-
-    tracker->context().setReadConsistency(api_read_consistency_to_spi(cmd.internal_read_consistency()));
-    spi::GetResult result =
-        _spi.get(getBucket(cmd.getDocumentId(), cmd.getBucket()), *fieldSet, cmd.getDocumentId(), tracker->context());
+    auto fieldSet = getFieldSet(*_env._component.getTypeRepo()->fieldSetRepo, cmd.getFieldSet(), tracker);
+    if ( ! fieldSet) { return trackerUP; }
 
-    if (tracker->checkForError(result)) {
-        if (!result.hasDocument() && (document::FieldSet::Type::NONE != fieldSet->getType())) {
-            metrics.notFound.inc();
-        }
-        tracker->setReply(std::make_shared<api::GetReply>(cmd, result.getDocumentPtr(), result.getTimestamp(),
-                                                          false, result.is_tombstone()));
+    tracker.context().setReadConsistency(api_read_consistency_to_spi(cmd.internal_read_consistency()));
+    spi::Bucket bucket = getBucket(cmd.getDocumentId(), cmd.getBucket());
+    if (_sequencedExecutor == nullptr) {
+        spi::GetResult result = _spi.get(bucket, *fieldSet, cmd.getDocumentId(), tracker.context());
+        handleGetResult(cmd, *fieldSet, result, metrics, tracker);
+    } else {
+        // Note that the &cmd capture is OK since its lifetime is guaranteed by the tracker
+        auto task = makeResultTask([&cmd, &metrics, fieldSet, tracker = std::move(trackerUP)](spi::Result::UP responseUP) {
+            auto & result = dynamic_cast<spi::GetResult &>(*responseUP);
+            handleGetResult(cmd, *fieldSet, result, metrics, *tracker);
+            tracker->sendReply();
+        });
+        _spi.getAsync(bucket, *fieldSet, cmd.getDocumentId(), tracker.context(),
+                      std::make_unique<ResultTaskOperationDone>(*_sequencedExecutor, cmd.getBucketId(), std::move(task)));
     }
-
-    return tracker;
+    return trackerUP;
 }
 
 MessageTracker::UP
@@ -430,22 +447,45 @@ PersistenceThread::handleDeleteBucket(api::DeleteBucketCommand& cmd, MessageTrac
     return tracker;
 }
 
-MessageTracker::UP
-PersistenceThread::handleGetIter(GetIterCommand& cmd, MessageTracker::UP tracker)
+namespace {
+
+void
+handleIterateResult(GetIterCommand& cmd, spi::IterateResult& result, FileStorThreadMetrics::Visitor& metrics,
+                    MessageTracker& tracker)
 {
-    tracker->setMetric(_env._metrics.visit[cmd.getLoadType()]);
-    spi::IterateResult result(_spi.iterate(cmd.getIteratorId(), cmd.getMaxByteSize(), tracker->context()));
-    if (tracker->checkForError(result)) {
+    if (tracker.checkForError(result)) {
         auto reply = std::make_shared<GetIterReply>(cmd);
         reply->getEntries() = result.steal_entries();
-        _env._metrics.visit[cmd.getLoadType()].
-            documentsPerIterate.addValue(reply->getEntries().size());
+        metrics.documentsPerIterate.addValue(reply->getEntries().size());
         if (result.isCompleted()) {
             reply->setCompleted();
         }
-        tracker->setReply(reply);
+        tracker.setReply(reply);
     }
-    return tracker;
+}
+
+}
+
+MessageTracker::UP
+PersistenceThread::handleGetIter(GetIterCommand& cmd, MessageTracker::UP trackerUP)
+{
+    MessageTracker & tracker = *trackerUP;
+    auto& metrics = _env._metrics.visit[cmd.getLoadType()];
+    tracker.setMetric(metrics);
+    if (_sequencedExecutor == nullptr) {
+        spi::IterateResult result(_spi.iterate(cmd.getIteratorId(), cmd.getMaxByteSize(), tracker.context()));
+        handleIterateResult(cmd, result, metrics, tracker);
+    } else {
+        // Note that the &cmd capture is OK since its lifetime is guaranteed by the tracker
+        auto task = makeResultTask([&cmd, &metrics, tracker = std::move(trackerUP)](spi::Result::UP responseUP) {
+            auto & result = dynamic_cast<spi::IterateResult &>(*responseUP);
+            handleIterateResult(cmd, result, metrics, *tracker);
+            tracker->sendReply();
+        });
+        _spi.iterateAsync(cmd.getIteratorId(), cmd.getMaxByteSize(), tracker.context(),
+                          std::make_unique<ResultTaskOperationDone>(*_sequencedExecutor, cmd.getBucketId(), std::move(task)));
+    }
+    return trackerUP;
 }
 
 MessageTracker::UP
@@ -791,10 +831,17 @@ PersistenceThread::handleRecheckBucketInfo(RecheckBucketInfoCommand& cmd, Messag
     document::Bucket bucket(cmd.getBucket());
     api::BucketInfo info(_env.getBucketInfo(bucket));
     NotificationGuard notifyGuard(*_bucketOwnershipNotifier);
+    StorBucketDatabase& db(_component->getBucketDatabase(bucket.getBucketSpace()));
+    {
+        // Only take the bucket lock if the bucket info has actually changed
+        auto current = db.acquire_read_guard()->find(bucket.getBucketId());
+        if (!current || (current->getBucketInfo() == info)) {
+            return tracker;
+        }
+    }
     {
         // Update bucket database
-        StorBucketDatabase::WrappedEntry entry(
-                _component->getBucketDatabase(bucket.getBucketSpace()).get(bucket.getBucketId(), "handleRecheckBucketInfo"));
+        StorBucketDatabase::WrappedEntry entry(db.get(bucket.getBucketId(), "handleRecheckBucketInfo"));
 
         if (entry.exist()) {
             api::BucketInfo prevInfo(entry->getBucketInfo());
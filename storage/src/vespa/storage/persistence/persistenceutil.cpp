@@ -217,11 +217,19 @@ PersistenceUtil::lockAndGetDisk(const document::Bucket &bucket,
         // TODO disks are no longer used in practice, can we safely discard this?
         // Might need it for synchronization purposes if something has taken the
         // disk lock _and_ the bucket lock...?
-        StorBucketDatabase::WrappedEntry entry(getBucketDatabase(bucket.getBucketSpace()).get(
-                bucket.getBucketId(), "join-lockAndGetDisk-1", flags));
-        if (entry.exist() && entry->disk != result.disk) {
-            result.disk = entry->disk;
-            continue;
+        if (flags == StorBucketDatabase::NONE) {
+            auto entry = getBucketDatabase(bucket.getBucketSpace()).acquire_read_guard()->find(bucket.getBucketId());
+            if (entry && entry->disk != result.disk) {
+                result.disk = entry->disk;
+                continue;
+            }
+        } else {
+            StorBucketDatabase::WrappedEntry entry(getBucketDatabase(bucket.getBucketSpace()).get(
+                    bucket.getBucketId(), "join-lockAndGetDisk-1", flags));
+            if (entry.exist() && entry->disk != result.disk) {
+                result.disk = entry->disk;
+                continue;
+            }
         }
 
         result.lock = lock;
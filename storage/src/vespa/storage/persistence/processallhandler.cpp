@@ -2,6 +2,7 @@
 
 #include "processallhandler.h"
 #include "bucketprocessor.h"
+#include <vespa/document/fieldset/fieldsets.h>
 #include <vespa/vespalib/stllike/hash_map.hpp>
 
 #include <vespa/log/log.h>
@@ -90,7 +91,9 @@ ProcessAllHandler::handleRemoveLocation(api::RemoveLocationCommand& cmd, Message
 
     spi::Bucket bucket(cmd.getBucket(), spi::PartitionId(_env._partition));
     UnrevertableRemoveEntryProcessor processor(_spi, bucket, tracker->context());
+    // Only the document ids are needed for removing the matching documents.
     BucketProcessor::iterateAll(_spi, bucket, cmd.getDocumentSelection(),
+                                std::make_shared<document::DocIdOnly>(),
                                 processor, spi::NEWEST_DOCUMENT_ONLY,tracker->context());
 
     tracker->setReply(std::make_shared<api::RemoveLocationReply>(cmd, processor._n_removed));
@@ -205,4 +205,21 @@ ProviderErrorWrapper::updateAsync(const spi::Bucket &bucket, spi::Timestamp ts,
     _impl.updateAsync(bucket, ts, std::move(upd), context, std::move(onComplete));
 }
 
+void
+ProviderErrorWrapper::getAsync(const spi::Bucket &bucket, const document::FieldSet &fieldSet,
+                               const document::DocumentId &docId, spi::Context &context,
+                               spi::OperationComplete::UP onComplete) const
+{
+    onComplete->addResultHandler(this);
+    _impl.getAsync(bucket, fieldSet, docId, context, std::move(onComplete));
+}
+
+void
+ProviderErrorWrapper::iterateAsync(spi::IteratorId iteratorId, uint64_t maxByteSize, spi::Context &context,
+                                   spi::OperationComplete::UP onComplete) const
+{
+    onComplete->addResultHandler(this);
+    _impl.iterateAsync(iteratorId, maxByteSize, context, std::move(onComplete));
+}
+
 } // ns storage
@@ -78,6 +78,9 @@ public:
     void removeAsync(const spi::Bucket&, spi::Timestamp, const document::DocumentId&, spi::Context&, spi::OperationComplete::UP) override;
     void removeIfFoundAsync(const spi::Bucket&, spi::Timestamp, const document::DocumentId&, spi::Context&, spi::OperationComplete::UP) override;
     void updateAsync(const spi::Bucket &, spi::Timestamp, spi::DocumentUpdateSP, spi::Context &, spi::OperationComplete::UP) override;
+    void getAsync(const spi::Bucket&, const document::FieldSet&, const document::DocumentId&, spi::Context&,
+                  spi::OperationComplete::UP) const override;
+    void iterateAsync(spi::IteratorId, uint64_t maxByteSize, spi::Context&, spi::OperationComplete::UP) const override;
 
 private:
     template <typename ResultType>
@@ -6,7 +6,12 @@ namespace storage {
 
 FnetMetricsWrapper::FnetMetricsWrapper(metrics::MetricSet* owner)
     : metrics::MetricSet("fnet", {}, "transport layer metrics", owner),
-      _num_connections("num-connections", {}, "total number of connection objects", this)
+      _num_connections("num-connections", {}, "total number of connection objects", this),
+      _event_loop_iterations("event-loop-iterations", {}, "number of transport thread event loop iterations", this),
+      _event_loop_busy_ms("event-loop-busy-time", {}, "average time (ms) spent handling events per event loop iteration", this),
+      _event_queue_delay_ms("event-queue-delay", {}, "average time (ms) posted events waited before a transport thread picked them up", this),
+      _blocked_writes("blocked-writes", {}, "number of connection writes that could not empty the output buffer", this),
+      _last_snapshot()
 {
 }
 
@@ -16,6 +21,17 @@ void
 FnetMetricsWrapper::update_metrics()
 {
     _num_connections.set(FNET_Connection::get_num_connections());
+    auto current = fnet::TransportStatistics::get().snapshot();
+    auto delta = current.subtract(_last_snapshot);
+    _event_loop_iterations.set(delta.event_loop_iterations);
+    if (delta.event_loop_iterations > 0) {
+        _event_loop_busy_ms.set(delta.event_loop_busy_us / (1000.0 * delta.event_loop_iterations));
+    }
+    if (delta.event_queue_flushes > 0) {
+        _event_queue_delay_ms.set(delta.event_queue_delay_us / (1000.0 * delta.event_queue_flushes));
+    }
+    _blocked_writes.set(delta.blocked_writes);
+    _last_snapshot = current;
 }
 
 }
@@ -4,14 +4,22 @@
 
 #include <vespa/metrics/metrics.h>
 #include <vespa/fnet/connection.h>
+#include <vespa/fnet/transport_statistics.h>
 
 namespace storage {
 
-// Simple wrapper around low-level fnet network metrics
+// Simple wrapper around low-level fnet network metrics. Monotonically
+// increasing transport counters are converted to deltas during periodic
+// metric snapshotting.
 class FnetMetricsWrapper : public metrics::MetricSet
 {
 private:
     metrics::LongValueMetric _num_connections;
+    metrics::LongCountMetric _event_loop_iterations;
+    metrics::DoubleValueMetric _event_loop_busy_ms;
+    metrics::DoubleValueMetric _event_queue_delay_ms;
+    metrics::LongCountMetric _blocked_writes;
+    fnet::TransportStatistics::Snapshot _last_snapshot;
 
 public:
     explicit FnetMetricsWrapper(metrics::MetricSet* owner);
@@ -5,10 +5,11 @@
 using namespace vbench;
 
 void post(double latency, Handler<Request> &handler,
-          double startTime = 0.0, Request::Status status = Request::STATUS_OK)
+          double startTime = 0.0, Request::Status status = Request::STATUS_OK,
+          double scheduledTime = 0.0)
 {
     Request::UP req(new Request());
-    req->status(status).startTime(startTime).endTime(startTime + latency);
+    req->scheduledTime(scheduledTime).status(status).startTime(startTime).endTime(startTime + latency);
     handler.handle(std::move(req));
 }
 
@@ -30,7 +31,27 @@ TEST_FF("verify percentiles", RequestSink(), LatencyAnalyzer(f1)) {
     EXPECT_APPROX(5.0, stats.per50, 10e-6);
     EXPECT_APPROX(9.5, stats.per95, 10e-6);
     EXPECT_APPROX(9.9, stats.per99, 10e-6);
+    EXPECT_APPROX(9.99, stats.per999, 10e-6);
     fprintf(stderr, "%s", stats.toString().c_str());
 }
 
+TEST_FF("verify percentiles of latencies above 10 seconds", RequestSink(), LatencyAnalyzer(f1)) {
+    for (size_t i = 1; i <= 1000; ++i) {
+        post(0.1 * i, f2);
+    }
+    LatencyAnalyzer::Stats stats = f2.getStats();
+    EXPECT_APPROX(50.05, stats.per50, 0.01);
+    EXPECT_APPROX(90.01, stats.per90, 0.01);
+    EXPECT_APPROX(99.001, stats.per99, 0.02);
+    EXPECT_APPROX(100.0, stats.max, 10e-6);
+}
+
+TEST_FF("require that corrected latency is measured from scheduled time", RequestSink(), LatencyAnalyzer(f1, true)) {
+    post(1.0, f2, 5.0, Request::STATUS_OK, 2.0);
+    post(1.0, f2, 6.0, Request::STATUS_OK, 6.0);
+    EXPECT_APPROX(1.0, f2.getStats().min, 10e-6);
+    EXPECT_APPROX(2.5, f2.getStats().avg, 10e-6);
+    EXPECT_APPROX(4.0, f2.getStats().max, 10e-6);
+}
+
 TEST_MAIN() { TEST_RUN_ALL(); }
@@ -5,6 +5,28 @@
 
 namespace vbench {
 
+size_t
+LatencyAnalyzer::getIndex(double latency)
+{
+    uint64_t ms = (latency > 0.0) ? (uint64_t)(latency * 1000.0 + 0.5) : 0;
+    if (ms < (uint64_t(2) << SUB_BUCKET_BITS)) {
+        return ms;
+    }
+    uint32_t shift = (63 - __builtin_clzl(ms)) - SUB_BUCKET_BITS;
+    return (size_t(shift) << SUB_BUCKET_BITS) + (ms >> shift);
+}
+
+double
+LatencyAnalyzer::getLatency(size_t idx)
+{
+    if (idx < (size_t(2) << SUB_BUCKET_BITS)) {
+        return (((double)idx) / 1000.0);
+    }
+    size_t shift = (idx >> SUB_BUCKET_BITS) - 1;
+    uint64_t sub = (idx & ((size_t(1) << SUB_BUCKET_BITS) - 1)) + (size_t(1) << SUB_BUCKET_BITS);
+    return (((double)(sub << shift)) / 1000.0);
+}
+
 double
 LatencyAnalyzer::getN(size_t n) const
 {
@@ -12,7 +34,7 @@ LatencyAnalyzer::getN(size_t n) const
     for (size_t i = 0; i < _hist.size(); ++i) {
         acc += _hist[i];
         if (acc > n) {
-            return (((double)i) / 1000.0);
+            return getLatency(i);
         }
     }
     return _max;
@@ -36,19 +58,22 @@ LatencyAnalyzer::Stats::toString() const
     str += strfmt("  avg: %g\n", avg);
     str += strfmt("  max: %g\n", max);
     str += strfmt("  50%%: %g\n", per50);
+    str += strfmt("  90%%: %g\n", per90);
     str += strfmt("  95%%: %g\n", per95);
     str += strfmt("  99%%: %g\n", per99);
+    str += strfmt("  99.9%%: %g\n", per999);
     str += "}\n";
     return str;
 }
 
-LatencyAnalyzer::LatencyAnalyzer(Handler<Request> &next)
+LatencyAnalyzer::LatencyAnalyzer(Handler<Request> &next, bool corrected)
     : _next(next),
+      _corrected(corrected),
       _cnt(0),
       _min(0.0),
       _max(0.0),
       _total(0.0),
-      _hist(10000, 0)
+      _hist(size_t(2) << SUB_BUCKET_BITS, 0)
 {
 }
 
@@ -56,7 +81,7 @@ void
 LatencyAnalyzer::handle(Request::UP request)
 {
     if (request->status() == Request::STATUS_OK) {
-        addLatency(request->latency());
+        addLatency(_corrected ? (request->endTime() - request->scheduledTime()) : request->latency());
     }
     _next.handle(std::move(request));
 }
@@ -78,10 +103,11 @@ LatencyAnalyzer::addLatency(double latency)
     }
     ++_cnt;
     _total += latency;
-    size_t idx = (size_t)(latency * 1000.0 + 0.5);
-    if (idx < _hist.size()) {
-        ++_hist[idx];
+    size_t idx = getIndex(latency);
+    if (idx >= _hist.size()) {
+        _hist.resize(idx + 1, 0);
     }
+    ++_hist[idx];
 }
 
 LatencyAnalyzer::Stats
@@ -94,8 +120,10 @@ LatencyAnalyzer::getStats() const
     }
     stats.max = _max;
     stats.per50 = getPercentile(50.0);
+    stats.per90 = getPercentile(90.0);
     stats.per95 = getPercentile(95.0);
     stats.per99 = getPercentile(99.0);
+    stats.per999 = getPercentile(99.9);
     return stats;
 }
 
@@ -9,17 +9,33 @@ namespace vbench {
 /**
  * Component picking up the latency of successful requests and
  * calculating relevant aggregated values.
+ *
+ * Latencies are counted in a log-linear histogram with millisecond
+ * resolution; exact below 16 seconds and within 1/8192 of the latency
+ * above that, so percentiles stay meaningful under heavy overload.
+ *
+ * With 'corrected' set, latency is measured from when the request
+ * was scheduled to be sent rather than from when it was actually
+ * sent. This corrects for coordinated omission, where requests
+ * delayed behind slow ones would otherwise hide the queueing time
+ * they were subjected to. This requires requests to be scheduled,
+ * for example by a QpsTagger.
  **/
 class LatencyAnalyzer : public Analyzer
 {
 private:
+    static constexpr size_t SUB_BUCKET_BITS = 13;
+
     Handler<Request>    &_next;
+    bool                 _corrected;
     size_t               _cnt;
     double               _min;
     double               _max;
     double               _total;
     std::vector<size_t>  _hist;
 
+    static size_t getIndex(double latency);
+    static double getLatency(size_t idx);
     double getN(size_t n) const;
     double getPercentile(double per) const;
 
@@ -29,12 +45,14 @@ public:
         double avg;
         double max;
         double per50;
+        double per90;
         double per95;
         double per99;
-        Stats() : min(0), avg(0), max(0), per50(0), per95(0), per99(0) {}
+        double per999;
+        Stats() : min(0), avg(0), max(0), per50(0), per90(0), per95(0), per99(0), per999(0) {}
         string toString() const;
     };
-    LatencyAnalyzer(Handler<Request> &next);
+    LatencyAnalyzer(Handler<Request> &next, bool corrected = false);
     void handle(Request::UP request) override;
     void report() override;
     void addLatency(double latency);
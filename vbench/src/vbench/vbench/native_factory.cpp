@@ -44,7 +44,7 @@ NativeFactory::createAnalyzer(const vespalib::slime::Inspector &spec,
 {
     std::string type = spec["type"].asString().make_string();
     if (type == "LatencyAnalyzer") {
-        return Analyzer::UP(new LatencyAnalyzer(next));
+        return Analyzer::UP(new LatencyAnalyzer(next, spec["corrected"].asBool()));
     }
     if (type == "QpsAnalyzer") {
         return Analyzer::UP(new QpsAnalyzer(next));
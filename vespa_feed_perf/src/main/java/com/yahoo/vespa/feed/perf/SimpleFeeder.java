@@ -45,7 +45,9 @@ import java.io.OutputStream;
 import java.io.PrintStream;
 import java.nio.ByteBuffer;
 import java.util.Arrays;
+import java.util.EnumMap;
 import java.util.List;
+import java.util.Map;
 import java.util.concurrent.ArrayBlockingQueue;
 import java.util.concurrent.Executor;
 import java.util.concurrent.ExecutorService;
@@ -78,6 +80,30 @@ public class SimpleFeeder implements ReplyHandler {
     private long minLatency = Long.MAX_VALUE;
     private long nextReport = startTime + REPORT_INTERVAL;
     private long sumLatency = 0;
+    private final Map<FeedOperation.Type, OperationStats> operationStats = new EnumMap<>(FeedOperation.Type.class);
+
+    /** Context attached to each message, so that replies can be accounted per operation type. */
+    private static class SendContext {
+        final FeedOperation.Type type;
+        final long sendTime;
+        SendContext(FeedOperation.Type type, long sendTime) {
+            this.type = type;
+            this.sendTime = sendTime;
+        }
+    }
+
+    private static class OperationStats {
+        long numReplies = 0;
+        long minLatency = Long.MAX_VALUE;
+        long maxLatency = Long.MIN_VALUE;
+        long sumLatency = 0;
+        void add(long latency) {
+            ++numReplies;
+            minLatency = Math.min(minLatency, latency);
+            maxLatency = Math.max(maxLatency, latency);
+            sumLatency += latency;
+        }
+    }
 
     static class Metrics {
 
@@ -146,7 +172,7 @@ public class SimpleFeeder implements ReplyHandler {
                 return;
             }
             msg.setTimeRemaining(timeoutMS);
-            msg.setContext(System.currentTimeMillis());
+            msg.setContext(new SendContext(op.getType(), System.currentTimeMillis()));
             msg.setRoute(route);
             try {
                 Error err = session.sendBlocking(msg).getError();
@@ -407,6 +433,7 @@ public class SimpleFeeder implements ReplyHandler {
         if (failure.get() != null) {
             throw failure.get();
         }
+        printOperationReport(out);
         printReport(out);
         return this;
     }
@@ -448,11 +475,13 @@ public class SimpleFeeder implements ReplyHandler {
             return;
         }
         long now = System.currentTimeMillis();
-        long latency = now - (long) reply.getContext();
+        SendContext context = (SendContext) reply.getContext();
+        long latency = now - context.sendTime;
+        accumulateReplies(now, latency, context.type);
         numReplies.incrementAndGet();
-        accumulateReplies(now, latency);
     }
-    private synchronized void accumulateReplies(long now, long latency) {
+    private synchronized void accumulateReplies(long now, long latency, FeedOperation.Type type) {
+        operationStats.computeIfAbsent(type, t -> new OperationStats()).add(latency);
         minLatency = Math.min(minLatency, latency);
         maxLatency = Math.max(maxLatency, latency);
         sumLatency += latency;
@@ -471,6 +500,17 @@ public class SimpleFeeder implements ReplyHandler {
                 numReplies.get(), minLatency, maxLatency, sumLatency / Long.max(1, numReplies.get()));
     }
 
+    private synchronized void printOperationReport(PrintStream out) {
+        double seconds = Double.max(1, System.currentTimeMillis() - startTime) / 1000.0;
+        out.println("# Operation, num ok, ops/s, min latency, max latency, average latency");
+        for (Map.Entry<FeedOperation.Type, OperationStats> entry : operationStats.entrySet()) {
+            OperationStats stats = entry.getValue();
+            out.format("# %8s, %12d, %10.1f, %11d, %11d, %11d\n", entry.getKey().name().toLowerCase(),
+                       stats.numReplies, stats.numReplies / seconds, stats.minLatency, stats.maxLatency,
+                       stats.sumLatency / stats.numReplies);
+        }
+    }
+
     private static String formatErrors(Reply reply) {
         StringBuilder out = new StringBuilder();
         out.append(reply.getMessage().toString()).append('\n');
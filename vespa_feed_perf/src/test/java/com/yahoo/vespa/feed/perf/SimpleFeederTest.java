@@ -61,6 +61,38 @@ public class SimpleFeederTest {
                    "\\s*\\d+,\\s*3,.+\n");
     }
 
+    @Test
+    public void requireThatRepliesAreReportedPerOperationType() throws Throwable {
+        assertFeed("<vespafeed>" +
+                   "    <document documenttype='simple' documentid='id:scheme:simple::0'>" +
+                   "        <my_str>foo</my_str>" +
+                   "    </document>" +
+                   "    <document documenttype='simple' documentid='id:scheme:simple::1'>" +
+                   "        <my_str>bar</my_str>" +
+                   "    </document>" +
+                   "    <update documenttype='simple' documentid='id:scheme:simple::1'>" +
+                   "        <assign field='my_str'>baz</assign>" +
+                   "    </update>" +
+                   "    <remove documenttype='simple' documentid='id:scheme:simple::0'/>" +
+                   "</vespafeed>",
+                   new MessageHandler() {
+
+                       @Override
+                       public void handleMessage(Message msg) {
+                           Reply reply = ((DocumentMessage)msg).createReply();
+                           reply.swapState(msg);
+                           reply.popHandler().handleReply(reply);
+                       }
+                   },
+                   "",
+                   "(.+\n)*" +
+                   "# Operation, num ok, ops/s, min latency, max latency, average latency\n" +
+                   "#\\s+document,\\s+2,.+\n" +
+                   "#\\s+remove,\\s+1,.+\n" +
+                   "#\\s+update,\\s+1,.+\n" +
+                   "\\s*\\d+,\\s*4,.+\n");
+    }
+
     @Test
     public void requireThatXML2JsonFeederWorks() throws Throwable {
         ByteArrayOutputStream dump = new ByteArrayOutputStream();
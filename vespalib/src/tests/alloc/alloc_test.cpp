@@ -3,6 +3,9 @@
 #include <vespa/vespalib/testkit/testapp.h>
 #include <vespa/vespalib/util/alloc.h>
 #include <vespa/vespalib/util/exceptions.h>
+#include <vespa/vespalib/util/mmap_file_allocator.h>
+#include <vespa/vespalib/io/fileutil.h>
+#include <cstring>
 #include <cstddef>
 
 using namespace vespalib;
@@ -279,4 +282,76 @@ TEST("auto alloced mmap alloc can not be shrinked below HUGEPAGE_SIZE/2 + 1 ") {
     EXPECT_EQUAL(SZ, buf.size());
 }
 
+TEST("huge page policy selects separate allocators") {
+    const MemoryAllocator * def = MemoryAllocator::select_allocator();
+    EXPECT_EQUAL(def, MemoryAllocator::select_allocator(MemoryAllocator::HUGEPAGE_SIZE, 0, HugePagePolicy::DEFAULT));
+    EXPECT_NOT_EQUAL(def, MemoryAllocator::select_allocator(MemoryAllocator::HUGEPAGE_SIZE, 0, HugePagePolicy::NONE));
+    EXPECT_NOT_EQUAL(def, MemoryAllocator::select_allocator(MemoryAllocator::HUGEPAGE_SIZE, 0, HugePagePolicy::HUGETLB));
+    EXPECT_NOT_EQUAL(def, MemoryAllocator::select_allocator(MemoryAllocator::HUGEPAGE_SIZE, 0, HugePagePolicy::MADVISE));
+}
+
+TEST("mmap allocations are made with all huge page policies") {
+    for (HugePagePolicy policy : {HugePagePolicy::DEFAULT, HugePagePolicy::NONE, HugePagePolicy::HUGETLB, HugePagePolicy::MADVISE}) {
+        Alloc buf = Alloc::alloc(MemoryAllocator::HUGEPAGE_SIZE * 2, MemoryAllocator::HUGEPAGE_SIZE, 0, policy);
+        EXPECT_EQUAL(MemoryAllocator::HUGEPAGE_SIZE * 2, buf.size());
+        memset(buf.get(), 0x55, buf.size());
+        Alloc mmapped = Alloc::allocMMap(100, policy);
+        EXPECT_EQUAL(4096u, mmapped.size());
+        Alloc created = buf.create(MemoryAllocator::HUGEPAGE_SIZE);
+        EXPECT_EQUAL(MemoryAllocator::HUGEPAGE_SIZE, created.size());
+    }
+    auto allocator = MemoryAllocator::make_auto_allocator(HugePagePolicy::MADVISE);
+    Alloc buf = Alloc::alloc_with_allocator(allocator.get()).create(MemoryAllocator::HUGEPAGE_SIZE * 3);
+    EXPECT_EQUAL(MemoryAllocator::HUGEPAGE_SIZE * 3, buf.size());
+    memset(buf.get(), 0x55, buf.size());
+}
+
+TEST("mmap file allocator hands out file backed memory") {
+    {
+        MmapFileAllocator allocator("mmap-file-allocator-dir");
+        EXPECT_TRUE(isDirectory("mmap-file-allocator-dir"));
+        auto buf = allocator.alloc(300);
+        EXPECT_EQUAL(4096u, buf.second);
+        EXPECT_EQUAL(4096u, allocator.get_end_offset());
+        EXPECT_EQUAL(1u, allocator.get_num_allocations());
+        memset(buf.first, 0x55, buf.second);
+        auto buf2 = allocator.alloc(5000);
+        EXPECT_EQUAL(8192u, buf2.second);
+        EXPECT_EQUAL(12288u, allocator.get_end_offset());
+        EXPECT_EQUAL(0x55, static_cast<unsigned char *>(buf.first)[4095]);
+        EXPECT_EQUAL(0u, allocator.resize_inplace(buf, 8192));
+        allocator.free(buf);
+        allocator.free(buf2.first, 5000);
+        EXPECT_EQUAL(0u, allocator.get_num_allocations());
+    }
+    EXPECT_FALSE(fileExists("mmap-file-allocator-dir"));
+}
+
+TEST("alloc with mmap file allocator creates allocations from the same allocator") {
+    MmapFileAllocator allocator("mmap-file-allocator-dir");
+    {
+        Alloc empty = Alloc::alloc_with_allocator(&allocator);
+        EXPECT_EQUAL(0u, empty.size());
+        Alloc buf = empty.create(10000);
+        EXPECT_EQUAL(12288u, buf.size());
+        EXPECT_EQUAL(1u, allocator.get_num_allocations());
+        EXPECT_FALSE(buf.resize_inplace(20000));
+    }
+    EXPECT_EQUAL(0u, allocator.get_num_allocations());
+}
+
+TEST("mmap file allocator factory only makes allocators when set up") {
+    auto& factory = MmapFileAllocatorFactory::instance();
+    EXPECT_TRUE(factory.make_memory_allocator("foo").get() == nullptr);
+    factory.setup("mmap-file-allocator-factory-dir");
+    {
+        auto allocator = factory.make_memory_allocator("foo");
+        EXPECT_TRUE(allocator.get() != nullptr);
+        EXPECT_TRUE(isDirectory("mmap-file-allocator-factory-dir/0.foo"));
+    }
+    EXPECT_FALSE(fileExists("mmap-file-allocator-factory-dir/0.foo"));
+    factory.setup("");
+    rmdir("mmap-file-allocator-factory-dir", true);
+}
+
 TEST_MAIN() { TEST_RUN_ALL(); }
@@ -0,0 +1,47 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#include <vespa/vespalib/testkit/test_kit.h>
+#include <vespa/vespalib/util/bfloat16.h>
+#include <cmath>
+#include <limits>
+
+using vespalib::BFloat16;
+
+TEST("require that bfloat16 takes 2 bytes") {
+    EXPECT_EQUAL(sizeof(BFloat16), 2u);
+}
+
+TEST("require that values with 8 bits of precision are exact") {
+    for (float value: {0.0f, 1.0f, -1.0f, 0.5f, 3.0f, 255.0f, -128.0f, 0x1p100f, -0x1.8p-100f}) {
+        EXPECT_EQUAL(float(BFloat16(value)), value);
+    }
+    for (int value = -256; value <= 256; ++value) {
+        EXPECT_EQUAL(float(BFloat16(float(value))), float(value));
+    }
+}
+
+TEST("require that conversion from float rounds to nearest even") {
+    // 1 + 2^-7 is the smallest bfloat16 above 1
+    float step = 1.0f / 128.0f;
+    EXPECT_EQUAL(float(BFloat16(1.0f + step * 0.25f)), 1.0f);
+    EXPECT_EQUAL(float(BFloat16(1.0f + step * 0.75f)), 1.0f + step);
+    EXPECT_EQUAL(float(BFloat16(1.0f + step * 0.5f)), 1.0f);
+    EXPECT_EQUAL(float(BFloat16(1.0f + step * 1.5f)), 1.0f + 2.0f * step);
+}
+
+TEST("require that special values are preserved") {
+    float inf = std::numeric_limits<float>::infinity();
+    EXPECT_EQUAL(float(BFloat16(inf)), inf);
+    EXPECT_EQUAL(float(BFloat16(-inf)), -inf);
+    EXPECT_TRUE(std::isnan(float(BFloat16(std::numeric_limits<float>::quiet_NaN()))));
+    EXPECT_TRUE(std::signbit(float(BFloat16(-0.0f))));
+    EXPECT_EQUAL(float(BFloat16(std::numeric_limits<float>::max())), inf);
+}
+
+TEST("require that raw bits can be inspected and restored") {
+    BFloat16 value(-2.5f);
+    EXPECT_EQUAL(value.get_bits(), 0xc020);
+    EXPECT_EQUAL(float(BFloat16::from_bits(value.get_bits())), -2.5f);
+    EXPECT_EQUAL(float(BFloat16()), 0.0f);
+}
+
+TEST_MAIN() { TEST_RUN_ALL(); }
@@ -2,6 +2,7 @@
 #include <vespa/log/log.h>
 LOG_SETUP("btree_test");
 #include <vespa/vespalib/testkit/testapp.h>
+#include <limits>
 #include <string>
 #include <vespa/vespalib/btree/btreeroot.h>
 #include <vespa/vespalib/btree/btreebuilder.h>
@@ -232,6 +233,9 @@ private:
     void requireThatTreeRemoveStealWorks();
     void requireThatNodeRemoveWorks();
     void requireThatNodeLowerBoundWorks();
+    template <typename KeyT>
+    void requireThatNodeKeySearchWorksT();
+    void requireThatNodeKeySearchWorks();
     void requireThatWeCanInsertAndRemoveFromTree();
     void requireThatSortedTreeInsertWorks();
     void requireThatCornerCaseTreeFindWorks();
@@ -718,6 +722,44 @@ Test::requireThatNodeLowerBoundWorks()
     cleanup(g, m, nPair.ref, n);
 }
 
+template <typename KeyT>
+void
+Test::requireThatNodeKeySearchWorksT()
+{
+    using TreeType = BTree<KeyT, BTreeNoLeafData, btree::NoAggregated>;
+    using CompareT = std::less<KeyT>;
+    TreeType t;
+    KeyT big = std::numeric_limits<KeyT>::max() - 1000;
+    for (KeyT i = 1; i <= 7; ++i) {
+        t.insert(i * 10, BTreeNoLeafData());
+        t.insert(big + i * 10, BTreeNoLeafData());
+    }
+    ASSERT_TRUE(t.getAllocator().isLeafRef(t.getRoot()));
+    const auto *n = t.getAllocator().mapLeafRef(t.getRoot());
+    ASSERT_EQUAL(14u, n->validSlots());
+    const KeyT *keys = &n->getKey(0);
+    std::vector<KeyT> probes = { 0, 9, 10, 11, 40, 70, 71, big, big + 10, big + 35, big + 70, std::numeric_limits<KeyT>::max() };
+    for (uint32_t sidx = 0; sidx <= n->validSlots(); ++sidx) {
+        for (KeyT key : probes) {
+            uint32_t exp_lower = std::lower_bound(keys + sidx, keys + n->validSlots(), key) - keys;
+            uint32_t exp_upper = std::upper_bound(keys + sidx, keys + n->validSlots(), key) - keys;
+            EXPECT_EQUAL(exp_lower, n->lower_bound(sidx, key, CompareT()));
+            EXPECT_EQUAL(exp_upper, n->upper_bound(sidx, key, CompareT()));
+            if (sidx == 0) {
+                EXPECT_EQUAL(exp_lower, n->lower_bound(key, CompareT()));
+            }
+        }
+    }
+}
+
+void
+Test::requireThatNodeKeySearchWorks()
+{
+    requireThatNodeKeySearchWorksT<uint32_t>();
+    requireThatNodeKeySearchWorksT<uint64_t>();
+    requireThatNodeKeySearchWorksT<int32_t>();
+}
+
 void
 generateData(std::vector<LeafPair> & data, size_t numEntries)
 {
@@ -1578,6 +1620,7 @@ Test::Main()
     requireThatTreeRemoveStealWorks();
     requireThatNodeRemoveWorks();
     requireThatNodeLowerBoundWorks();
+    requireThatNodeKeySearchWorks();
     requireThatWeCanInsertAndRemoveFromTree();
     requireThatSortedTreeInsertWorks();
     requireThatCornerCaseTreeFindWorks();
@@ -3,6 +3,8 @@
 #include <vespa/vespalib/testkit/test_kit.h>
 #include <vespa/vespalib/stllike/string.h>
 #include <vespa/vespalib/util/compressor.h>
+#include <vespa/vespalib/util/stringfmt.h>
+#include <vespa/vespalib/util/zstdcompressor.h>
 #include <vespa/vespalib/data/databuffer.h>
 
 #include <vespa/log/log.h>
@@ -67,6 +69,74 @@ TEST("requiret that zstd compression/decompression works") {
     EXPECT_EQUAL(_G_compressableText, vespalib::string(decompress.data(), decompress.size()));
 }
 
+vespalib::string
+makeSmallDocument(uint32_t id)
+{
+    return make_string("{\"id\":\"id:music:song::%u\",\"fields\":{\"title\":\"Title number %u\","
+                       "\"artist\":\"Artist %u\",\"year\":%u,\"genre\":\"rock\",\"duration\":%u}}",
+                       id, id * 7, id % 97, 1950 + (id % 70), 120 + (id % 300));
+}
+
+ZStdDictionary::SP
+trainDictionary()
+{
+    std::vector<vespalib::string> docs;
+    for (uint32_t i = 0; i < 2000; ++i) {
+        docs.push_back(makeSmallDocument(i));
+    }
+    std::vector<ConstBufferRef> samples;
+    for (const auto & doc : docs) {
+        samples.emplace_back(doc.data(), doc.size());
+    }
+    return ZStdDictionary::train(samples, 4096);
+}
+
+TEST("require that zstd dictionary compresses small documents better") {
+    ZStdDictionary::SP dictionary = trainDictionary();
+    ASSERT_TRUE(dictionary);
+    EXPECT_NOT_EQUAL(0u, dictionary->id());
+    EXPECT_GREATER_EQUAL(4096u, dictionary->content().size());
+    CompressionConfig cfg(CompressionConfig::Type::ZSTD, 9, 100);
+    vespalib::string doc = makeSmallDocument(100000);
+    ConstBufferRef ref(doc.data(), doc.size());
+    DataBuffer plain;
+    DataBuffer withDictionary;
+    compress(cfg, ref, plain, false);
+    EXPECT_EQUAL(CompressionConfig::Type::ZSTD, compress(cfg, ref, withDictionary, false, dictionary.get()));
+    EXPECT_LESS(withDictionary.getDataLen() * 2, plain.getDataLen());
+    EXPECT_EQUAL(dictionary->id(), ZStdDictionary::getDictionaryId(withDictionary.getData(), withDictionary.getDataLen()));
+    EXPECT_EQUAL(0u, ZStdDictionary::getDictionaryId(plain.getData(), plain.getDataLen()));
+
+    DataBuffer decompressed;
+    decompress(CompressionConfig::Type::ZSTD, doc.size(), ConstBufferRef(withDictionary.getData(), withDictionary.getDataLen()),
+               decompressed, false, dictionary.get());
+    EXPECT_EQUAL(doc, vespalib::string(decompressed.getData(), decompressed.getDataLen()));
+    DataBuffer missing;
+    EXPECT_EXCEPTION(decompress(CompressionConfig::Type::ZSTD, doc.size(),
+                                ConstBufferRef(withDictionary.getData(), withDictionary.getDataLen()), missing, false),
+                     std::runtime_error, "Missing zstd dictionary");
+}
+
+TEST("require that data compressed without dictionary can be decompressed with one") {
+    ZStdDictionary::SP dictionary = trainDictionary();
+    ASSERT_TRUE(dictionary);
+    CompressionConfig cfg(CompressionConfig::Type::ZSTD);
+    ConstBufferRef ref(_G_compressableText.c_str(), _G_compressableText.size());
+    DataBuffer compressed;
+    EXPECT_EQUAL(CompressionConfig::Type::ZSTD, compress(cfg, ref, compressed, false));
+    DataBuffer decompressed;
+    decompress(CompressionConfig::Type::ZSTD, _G_compressableText.size(), ConstBufferRef(compressed.getData(), compressed.getDataLen()),
+               decompressed, false, dictionary.get());
+    EXPECT_EQUAL(_G_compressableText, vespalib::string(decompressed.getData(), decompressed.getDataLen()));
+}
+
+TEST("require that dictionary training fails without enough samples") {
+    vespalib::string doc = makeSmallDocument(1);
+    std::vector<ConstBufferRef> samples;
+    samples.emplace_back(doc.data(), doc.size());
+    EXPECT_FALSE(ZStdDictionary::train(samples, 4096));
+}
+
 TEST_MAIN() {
     TEST_RUN_ALL();
 }
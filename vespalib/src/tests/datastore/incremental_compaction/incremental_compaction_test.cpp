@@ -0,0 +1,128 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/vespalib/datastore/incremental_compaction.h>
+#include <vespa/vespalib/gtest/gtest.h>
+#include <vector>
+
+using namespace vespalib::datastore;
+
+namespace {
+
+/*
+ * Compaction context that moves refs below the limit by adding 1000,
+ * and records the number of refs visited by each call to compact().
+ */
+class MyCompactionContext : public ICompactionContext {
+    std::vector<uint32_t> &_steps;
+    bool                  &_finished;
+public:
+    MyCompactionContext(std::vector<uint32_t> &steps, bool &finished)
+        : _steps(steps),
+          _finished(finished)
+    {
+    }
+    ~MyCompactionContext() override { _finished = true; }
+    void compact(vespalib::ArrayRef<EntryRef> refs) override {
+        _steps.push_back(refs.size());
+        for (auto &ref : refs) {
+            if (ref.valid() && ref.ref() < 1000) {
+                ref = EntryRef(ref.ref() + 1000);
+            }
+        }
+    }
+};
+
+}
+
+struct IncrementalCompactionTest : public ::testing::Test {
+    std::vector<EntryRef> refs;
+    std::vector<uint32_t> steps;
+    bool finished;
+    IncrementalCompaction compaction;
+
+    IncrementalCompactionTest()
+        : refs(),
+          steps(),
+          finished(false),
+          compaction()
+    {
+        for (uint32_t i = 0; i < 10; ++i) {
+            refs.emplace_back(i);
+        }
+    }
+    ~IncrementalCompactionTest() override;
+    void start() {
+        compaction.start(std::make_unique<MyCompactionContext>(steps, finished));
+    }
+    bool step(uint32_t max_refs) {
+        return compaction.step(vespalib::ArrayRef<EntryRef>(refs), max_refs);
+    }
+    void assert_moved(uint32_t limit) {
+        for (uint32_t i = 1; i < refs.size(); ++i) {
+            EXPECT_EQ((i < limit) ? (i + 1000) : i, refs[i].ref());
+        }
+    }
+};
+
+IncrementalCompactionTest::~IncrementalCompactionTest() = default;
+
+TEST_F(IncrementalCompactionTest, step_without_compaction_is_noop)
+{
+    EXPECT_FALSE(compaction.in_progress());
+    EXPECT_FALSE(step(4));
+    EXPECT_TRUE(steps.empty());
+    assert_moved(0);
+}
+
+TEST_F(IncrementalCompactionTest, refs_are_moved_in_bounded_steps)
+{
+    start();
+    EXPECT_TRUE(compaction.in_progress());
+    EXPECT_FALSE(step(4));
+    EXPECT_EQ(4u, compaction.next());
+    assert_moved(4);
+    EXPECT_FALSE(finished);
+    EXPECT_FALSE(step(4));
+    EXPECT_EQ(8u, compaction.next());
+    assert_moved(8);
+    EXPECT_TRUE(step(4));
+    assert_moved(10);
+    EXPECT_TRUE(finished);
+    EXPECT_FALSE(compaction.in_progress());
+    EXPECT_EQ(0u, compaction.next());
+    EXPECT_EQ((std::vector<uint32_t>{4, 4, 2}), steps);
+}
+
+TEST_F(IncrementalCompactionTest, refs_added_during_compaction_are_visited)
+{
+    start();
+    EXPECT_FALSE(step(8));
+    refs.emplace_back(10);
+    refs.emplace_back(11);
+    EXPECT_FALSE(step(2));
+    EXPECT_TRUE(step(2));
+    assert_moved(12);
+    EXPECT_EQ((std::vector<uint32_t>{8, 2, 2}), steps);
+}
+
+TEST_F(IncrementalCompactionTest, finish_moves_remaining_refs)
+{
+    start();
+    EXPECT_FALSE(step(3));
+    EXPECT_TRUE(compaction.finish(vespalib::ArrayRef<EntryRef>(refs)));
+    assert_moved(10);
+    EXPECT_TRUE(finished);
+    EXPECT_EQ((std::vector<uint32_t>{3, 7}), steps);
+}
+
+TEST_F(IncrementalCompactionTest, shrunk_refs_ends_compaction)
+{
+    start();
+    EXPECT_FALSE(step(6));
+    refs.resize(4);
+    EXPECT_TRUE(step(6));
+    EXPECT_TRUE(finished);
+    EXPECT_EQ((std::vector<uint32_t>{6}), steps);
+}
+
+GTEST_MAIN_RUN_ALL_TESTS()
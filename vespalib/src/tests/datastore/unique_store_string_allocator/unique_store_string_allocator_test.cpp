@@ -4,6 +4,7 @@
 #include <vespa/vespalib/gtest/gtest.h>
 #include <vespa/vespalib/test/datastore/buffer_stats.h>
 #include <vespa/vespalib/test/insertion_operators.h>
+#include <vespa/vespalib/util/mmap_file_allocator.h>
 #include <vespa/vespalib/util/traits.h>
 #include <vector>
 
@@ -170,6 +171,23 @@ TEST_F(StringTest, free_list_is_never_used_for_move)
     assert_buffer_state(ref2, BufferStats().used(4).hold(0).dead(2).extra_used(2002));
 }
 
+TEST(MemoryAllocatorTest, given_memory_allocator_is_used_for_buffers)
+{
+    auto memory_allocator = std::make_unique<vespalib::alloc::MmapFileAllocator>("unique-store-string-allocator-dir");
+    auto &mmap_allocator = *memory_allocator;
+    {
+        UniqueStoreStringAllocator<EntryRefT<22>> allocator(std::move(memory_allocator));
+        // one buffer per buffer type is made active at startup
+        size_t initial_allocations = mmap_allocator.get_num_allocations();
+        EXPECT_LT(0u, initial_allocations);
+        EntryRef ref = allocator.allocate(middle.c_str());
+        EXPECT_STREQ(middle.c_str(), allocator.get(ref));
+        EntryRef large_ref = allocator.allocate(spaces1000.c_str());
+        EXPECT_STREQ(spaces1000.c_str(), allocator.get(large_ref));
+        EXPECT_EQ(initial_allocations, mmap_allocator.get_num_allocations());
+    }
+}
+
 TEST_F(SmallOffsetStringTest, new_underlying_buffer_is_allocated_when_current_is_full)
 {
     uint32_t first_buffer_id = get_buffer_id(add(small.c_str()));
@@ -0,0 +1,227 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#include <vespa/vespalib/testkit/test_kit.h>
+
+#include <vespa/vespalib/util/lockfree_executor.h>
+#include <vespa/vespalib/util/mpmc_queue.h>
+#include <vespa/vespalib/util/threadstackexecutorbase.h>
+#include <vespa/vespalib/util/sync.h>
+#include <vespa/vespalib/util/backtrace.h>
+#include <atomic>
+#include <thread>
+
+using namespace vespalib;
+
+typedef Executor::Task Task;
+
+struct MyTask : public Executor::Task {
+    Gate &gate;
+    CountDownLatch &latch;
+    static std::atomic<uint32_t> runCnt;
+    static std::atomic<uint32_t> deleteCnt;
+    MyTask(Gate &g, CountDownLatch &l) : gate(g), latch(l) {}
+    void run() override {
+        runCnt.fetch_add(1);
+        latch.countDown();
+        gate.await();
+    }
+    ~MyTask() {
+        deleteCnt.fetch_add(1);
+    }
+    static void resetStats() {
+        runCnt = 0;
+        deleteCnt = 0;
+    }
+};
+std::atomic<uint32_t> MyTask::runCnt(0);
+std::atomic<uint32_t> MyTask::deleteCnt(0);
+
+struct MyState {
+    Gate             gate;     // to block workers
+    CountDownLatch   latch;    // to wait for workers
+    LockFreeExecutor executor;
+    bool             checked;
+    MyState() : gate(), latch(10), executor(10, 128000, 20), checked(false)
+    {
+        MyTask::resetStats();
+    }
+    MyState &execute(uint32_t cnt) {
+        for (uint32_t i = 0; i < cnt; ++i) {
+            executor.execute(Task::UP(new MyTask(gate, latch)));
+        }
+        return *this;
+    }
+    MyState &sync() {
+        executor.sync();
+        return *this;
+    }
+    MyState &shutdown() {
+        executor.shutdown();
+        return *this;
+    }
+    MyState &open() {
+        gate.countDown();
+        return *this;
+    }
+    MyState &wait() {
+        latch.await();
+        return *this;
+    }
+    MyState &check(uint32_t expect_rejected,
+                   uint32_t expect_queue,
+                   uint32_t expect_running,
+                   uint32_t expect_deleted)
+    {
+        ASSERT_TRUE(!checked);
+        checked = true;
+        LockFreeExecutor::Stats stats = executor.getStats();
+        EXPECT_EQUAL(expect_running + expect_deleted, MyTask::runCnt);
+        EXPECT_EQUAL(expect_rejected + expect_deleted, MyTask::deleteCnt);
+        EXPECT_EQUAL(expect_queue + expect_running + expect_deleted,
+                     stats.acceptedTasks);
+        EXPECT_EQUAL(expect_rejected, stats.rejectedTasks);
+        EXPECT_TRUE(!(gate.getCount() == 1) || (expect_deleted == 0));
+        if (expect_deleted == 0) {
+            EXPECT_EQUAL(expect_queue + expect_running, stats.queueSize.max());
+            EXPECT_EQUAL(expect_queue + expect_running, executor.num_pending_tasks());
+        }
+        stats = executor.getStats();
+        EXPECT_EQUAL(0u, stats.acceptedTasks);
+        EXPECT_EQUAL(0u, stats.rejectedTasks);
+        return *this;
+    }
+};
+
+TEST("require that mpmc queue keeps fifo order and capacity") {
+    MpmcQueue<int> queue(5);
+    EXPECT_EQUAL(8u, queue.capacity());
+    int value = 0;
+    EXPECT_FALSE(queue.try_pop(value));
+    for (int round = 0; round < 3; ++round) {
+        for (int i = 0; i < 8; ++i) {
+            int in = round * 10 + i;
+            EXPECT_TRUE(queue.try_push(std::move(in)));
+        }
+        int extra = 42;
+        EXPECT_FALSE(queue.try_push(std::move(extra)));
+        for (int i = 0; i < 8; ++i) {
+            EXPECT_TRUE(queue.try_pop(value));
+            EXPECT_EQUAL(round * 10 + i, value);
+        }
+        EXPECT_FALSE(queue.try_pop(value));
+    }
+    EXPECT_EQUAL(24u, queue.push_count());
+    EXPECT_EQUAL(24u, queue.pop_count());
+}
+
+TEST_F("require that tasks are run and deleted", MyState()) {
+    TEST_DO(f1.open().execute(5).sync().check(0, 0, 0, 5));
+}
+
+TEST_F("require that tasks run concurrently", MyState()) {
+    TEST_DO(f1.execute(10).wait().check(0, 0, 10, 0).open());
+}
+
+TEST_F("require that thread count is respected", MyState()) {
+    TEST_DO(f1.execute(20).wait().check(0, 10, 10, 0).open());
+}
+
+TEST_F("require that extra tasks are dropped", MyState()) {
+    TEST_DO(f1.execute(40).wait().check(20, 10, 10, 0).open());
+}
+
+TEST_F("require that active workers drain input queue", MyState()) {
+    TEST_DO(f1.execute(20).wait().open().sync().check(0, 0, 0, 20));
+}
+
+TEST_F("require that pending tasks are run after shutdown", MyState()) {
+    TEST_DO(f1.execute(20).wait().shutdown().open().sync().check(0, 0, 0, 20));
+}
+
+TEST_F("require that new tasks are dropped after shutdown", MyState()) {
+    TEST_DO(f1.open().shutdown().execute(5).sync().check(5, 0, 0, 0));
+}
+
+TEST("require that blocking executor waits for room instead of rejecting") {
+    Gate gate;
+    CountDownLatch latch(2);
+    MyTask::resetStats();
+    LockFreeExecutor executor(2, 128000, 4, true);
+    for (uint32_t i = 0; i < 4; ++i) {
+        EXPECT_TRUE(executor.execute(std::make_unique<MyTask>(gate, latch)).get() == nullptr);
+    }
+    latch.await();
+    Gate producerDone;
+    Gate noWait;
+    noWait.countDown();
+    CountDownLatch noLatch(1);
+    Task::UP rejected;
+    std::thread producer([&]() {
+        rejected = executor.execute(std::make_unique<MyTask>(noWait, noLatch));
+        producerDone.countDown();
+    });
+    EXPECT_FALSE(producerDone.await(20));
+    gate.countDown();
+    EXPECT_TRUE(producerDone.await(25000));
+    producer.join();
+    EXPECT_TRUE(rejected.get() == nullptr);
+    executor.sync();
+    LockFreeExecutor::Stats stats = executor.getStats();
+    EXPECT_EQUAL(5u, stats.acceptedTasks);
+    EXPECT_EQUAL(0u, stats.rejectedTasks);
+    EXPECT_EQUAL(5u, MyTask::runCnt);
+}
+
+TEST("require that wait for task count returns when tasks complete") {
+    Gate gate;
+    CountDownLatch latch(1);
+    LockFreeExecutor executor(1, 128000, 10);
+    executor.execute(std::make_unique<MyTask>(gate, latch));
+    executor.execute(std::make_unique<MyTask>(gate, latch));
+    latch.await();
+    EXPECT_EQUAL(2u, executor.num_pending_tasks());
+    std::thread opener([&gate]() { gate.countDown(); });
+    executor.wait_for_task_count(0);
+    EXPECT_EQUAL(0u, executor.num_pending_tasks());
+    opener.join();
+}
+
+struct CountTask : public Executor::Task {
+    std::atomic<uint64_t> &sum;
+    uint64_t value;
+    CountTask(std::atomic<uint64_t> &s, uint64_t v) : sum(s), value(v) {}
+    void run() override { sum.fetch_add(value, std::memory_order_relaxed); }
+};
+
+TEST_MT_F("require that many producers can feed the executor", 4, LockFreeExecutor(3, 128000, 64, true)) {
+    static std::atomic<uint64_t> sum(0);
+    constexpr uint64_t num_tasks = 20000;
+    for (uint64_t i = 1; i <= num_tasks; ++i) {
+        EXPECT_TRUE(f1.execute(std::make_unique<CountTask>(sum, i)).get() == nullptr);
+    }
+    TEST_BARRIER();
+    f1.sync();
+    EXPECT_EQUAL(num_threads * (num_tasks * (num_tasks + 1) / 2), sum.load());
+}
+
+vespalib::string get_worker_stack_trace(LockFreeExecutor &executor) {
+    struct StackTraceTask : public Executor::Task {
+        vespalib::string &trace;
+        explicit StackTraceTask(vespalib::string &t) : trace(t) {}
+        void run() override { trace = getStackTrace(0); }
+    };
+    vespalib::string trace;
+    executor.execute(std::make_unique<StackTraceTask>(trace));
+    executor.sync();
+    return trace;
+}
+
+VESPA_THREAD_STACK_TAG(my_stack_tag);
+
+TEST_F("require that executor thread stack tag can be set", LockFreeExecutor(1, 128*1024, 16, false, my_stack_tag)) {
+    vespalib::string trace = get_worker_stack_trace(f1);
+    if (!EXPECT_TRUE(trace.find("my_stack_tag") != vespalib::string::npos)) {
+        fprintf(stderr, "%s\n", trace.c_str());
+    }
+}
+
+TEST_MAIN() { TEST_RUN_ALL(); }
@@ -31,10 +31,51 @@ void verifyEuclideanDistance(const hwaccelrated::IAccelrated & accel) {
     }
 }
 
+void verifyInt8EuclideanDistance(const hwaccelrated::IAccelrated & accel) {
+    const size_t testLength(1000);
+    srand(1);
+    std::vector<int8_t> a(testLength);
+    std::vector<int8_t> b(testLength);
+    for (size_t i(0); i < testLength; i++) {
+        a[i] = (i % 7 == 0) ? -128 : rand();
+        b[i] = (i % 7 == 0) ? 127 : rand();
+    }
+    for (size_t j(0); j < 0x40; j++) {
+        double sum(0);
+        for (size_t i(j); i < testLength; i++) {
+            double diff = double(a[i]) - double(b[i]);
+            sum += diff * diff;
+        }
+        EXPECT_EQUAL(sum, accel.squaredEuclideanDistance(&a[j], &b[j], testLength - j));
+    }
+}
+
+void verifyBinaryHammingDistance(const hwaccelrated::IAccelrated & accel) {
+    const size_t testLength(255);
+    srand(1);
+    std::vector<uint8_t> a = createAndFill<uint8_t>(testLength);
+    std::vector<uint8_t> b = createAndFill<uint8_t>(testLength);
+    for (size_t j(0); j < 0x20; j++) {
+        size_t sum(0);
+        for (size_t i(j); i < testLength; i++) {
+            sum += __builtin_popcount(a[i] ^ b[i]);
+        }
+        EXPECT_EQUAL(sum, accel.binaryHammingDistance(&a[j], &b[j], testLength - j));
+    }
+}
+
 TEST("test euclidean distance") {
     hwaccelrated::GenericAccelrator genericAccelrator;
     verifyEuclideanDistance<float>(genericAccelrator);
     verifyEuclideanDistance<double >(genericAccelrator);
+    verifyInt8EuclideanDistance(genericAccelrator);
+    verifyInt8EuclideanDistance(hwaccelrated::IAccelrated::getAccelerator());
+}
+
+TEST("test binary hamming distance") {
+    hwaccelrated::GenericAccelrator genericAccelrator;
+    verifyBinaryHammingDistance(genericAccelrator);
+    verifyBinaryHammingDistance(hwaccelrated::IAccelrated::getAccelerator());
 }
 
 TEST_MAIN() { TEST_RUN_ALL(); }
@@ -8,6 +8,7 @@
 #include <vespa/vespalib/net/tls/statistics.h>
 #include <vespa/vespalib/net/tls/tls_context.h>
 #include <vespa/vespalib/net/tls/transport_security_options.h>
+#include <vespa/vespalib/net/tls/impl/iana_cipher_map.h>
 #include <vespa/vespalib/net/tls/impl/openssl_crypto_codec_impl.h>
 #include <vespa/vespalib/net/tls/impl/openssl_tls_context_impl.h>
 #include <vespa/vespalib/test/make_tls_options_for_testing.h>
@@ -769,6 +770,14 @@ TEST_F("Success statistics are incremented on OK authorization", CertFixture) {
     EXPECT_EQUAL(1u, client_stats.tls_connections);
 }
 
+TEST("Default cipher suites are listed with hardware accelerated AES-GCM first") {
+    auto ciphers = modern_iana_cipher_suites();
+    ASSERT_EQUAL(9u, ciphers.size());
+    EXPECT_EQUAL("TLS_AES_128_GCM_SHA256", ciphers[0]);
+    EXPECT_EQUAL("TLS_ECDHE_ECDSA_WITH_AES_128_GCM_SHA256", ciphers[3]);
+    EXPECT_EQUAL("TLS_ECDHE_RSA_WITH_CHACHA20_POLY1305_SHA256", ciphers[8]);
+}
+
 // TODO we can't test embedded nulls since the OpenSSL v3 extension APIs
 // take in null terminated strings as arguments... :I
 
@@ -0,0 +1,56 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#include <vespa/vespalib/testkit/test_kit.h>
+#include <vespa/vespalib/util/numa_topology.h>
+#include <vespa/vespalib/util/simple_thread_bundle.h>
+#include <atomic>
+
+using namespace vespalib;
+using CpuList = NumaTopology::CpuList;
+
+TEST("require that cpu lists can be parsed") {
+    EXPECT_TRUE(CpuList({0}) == NumaTopology::parseCpuList("0"));
+    EXPECT_TRUE(CpuList({0, 1, 2, 5, 7, 8}) == NumaTopology::parseCpuList("0-2,5,7-8\n"));
+    EXPECT_TRUE(CpuList() == NumaTopology::parseCpuList(""));
+    EXPECT_TRUE(CpuList() == NumaTopology::parseCpuList("0-"));
+    EXPECT_TRUE(CpuList() == NumaTopology::parseCpuList("3-1"));
+    EXPECT_TRUE(CpuList() == NumaTopology::parseCpuList("a,b"));
+}
+
+TEST("require that cpus of online nodes are found") {
+    auto nodes = NumaTopology::getNodeCpus(TEST_PATH("sysfs"));
+    ASSERT_EQUAL(2u, nodes.size());
+    EXPECT_TRUE(CpuList({0, 1, 2, 3, 8, 9, 10, 11}) == nodes[0]);
+    EXPECT_TRUE(CpuList({4, 5, 6, 7}) == nodes[1]);
+}
+
+TEST("require that missing topology gives no nodes") {
+    EXPECT_EQUAL(0u, NumaTopology::getNodeCpus(TEST_PATH("no_such_dir")).size());
+}
+
+TEST("require that pinning to no cpus fails") {
+    EXPECT_FALSE(NumaTopology::pinCurrentThread(CpuList()));
+}
+
+struct Count : Runnable {
+    std::atomic<size_t> &count;
+    Count(std::atomic<size_t> &c) : count(c) {}
+    void run() override { ++count; }
+};
+
+TEST("require that bundles with pinned threads work") {
+    auto nodes = NumaTopology::getNodeCpus();
+    CpuList cpus = nodes.empty() ? CpuList({0}) : nodes[0];
+    SimpleThreadBundle::Pool pool(4, cpus);
+    auto bundle = pool.obtain();
+    std::atomic<size_t> count(0);
+    std::vector<Count> targets(4, Count(count));
+    std::vector<Runnable*> refs;
+    for (auto &target : targets) {
+        refs.push_back(&target);
+    }
+    bundle->run(refs);
+    EXPECT_EQUAL(4u, count.load());
+    pool.release(std::move(bundle));
+}
+
+TEST_MAIN() { TEST_RUN_ALL(); }
@@ -172,4 +172,11 @@ TEST("require that additional query and key/value separators are not special") {
     EXPECT_EQUAL(req.get_param("?"), "=");
 }
 
+TEST("require that keep-alive must be requested explicitly") {
+    EXPECT_TRUE(!make_request("GET / HTTP/1.1\r\n\r\n").keep_alive());
+    EXPECT_TRUE(!make_request("GET / HTTP/1.1\r\nConnection: close\r\n\r\n").keep_alive());
+    EXPECT_TRUE(make_request("GET / HTTP/1.1\r\nConnection: keep-alive\r\n\r\n").keep_alive());
+    EXPECT_TRUE(make_request("GET / HTTP/1.0\r\nConnection: Upgrade, Keep-Alive\r\n\r\n").keep_alive());
+}
+
 TEST_MAIN() { TEST_RUN_ALL(); }
@@ -38,15 +38,33 @@ vespalib::string do_http(int port, CryptoEngine::SP crypto, const vespalib::stri
     return result;
 }
 
+vespalib::string do_raw(int port, CryptoEngine::SP crypto, const vespalib::string &data) {
+    auto socket = SocketSpec::from_port(port).client_address().connect();
+    ASSERT_TRUE(socket.valid());
+    auto conn = SyncCryptoSocket::create_client(*crypto, std::move(socket), local_spec);
+    ASSERT_EQUAL(conn->write(data.data(), data.size()), ssize_t(data.size()));
+    char buf[1024];
+    vespalib::string result;
+    ssize_t res = conn->read(buf, sizeof(buf));
+    while (res > 0) {
+        result.append(vespalib::stringref(buf, res));
+        res = conn->read(buf, sizeof(buf));
+    }
+    ASSERT_EQUAL(res, 0);
+    return result;
+}
+
 vespalib::string fetch(int port, CryptoEngine::SP crypto, const vespalib::string &path, bool send_host = true) {
     return do_http(port, std::move(crypto), "GET", path, send_host);
 }
 
 //-----------------------------------------------------------------------------
 
-vespalib::string make_expected_response(const vespalib::string &content_type, const vespalib::string &content) {
+vespalib::string make_expected_response(const vespalib::string &content_type, const vespalib::string &content,
+                                        const vespalib::string &connection = "close")
+{
     return vespalib::make_string("HTTP/1.1 200 OK\r\n"
-                                 "Connection: close\r\n"
+                                 "Connection: %s\r\n"
                                  "Content-Type: %s\r\n"
                                  "Content-Length: %zu\r\n"
                                  "X-XSS-Protection: 1; mode=block\r\n"
@@ -56,7 +74,7 @@ vespalib::string make_expected_response(const vespalib::string &content_type, co
                                  "Cache-Control: no-store\r\n"
                                  "Pragma: no-cache\r\n"
                                  "\r\n"
-                                 "%s", content_type.c_str(), content.size(), content.c_str());
+                                 "%s", connection.c_str(), content_type.c_str(), content.size(), content.c_str());
 }
 
 vespalib::string make_expected_error(int code, const vespalib::string &message) {
@@ -390,4 +408,31 @@ TEST("require that request path is dequoted before handler dispatching") {
     EXPECT_EQUAL(result, make_expected_response("a", "b"));
 }
 
+TEST("require that pipelined keep-alive requests are served on the same connection") {
+    MyGetHandler handler([](Portal::GetRequest request)
+                         {
+                             request.respond_with_content("text/plain", request.get_path());
+                         });
+    for (const Encryption &crypto: crypto_list) {
+        fprintf(stderr, "... testing keep-alive with encryption: '%s'\n", crypto.name.c_str());
+        auto portal = Portal::create(crypto.engine, 0);
+        auto bound = portal->bind("/", handler);
+        auto result = do_raw(portal->listen_port(), crypto.engine,
+                             "GET /a HTTP/1.1\r\nConnection: keep-alive\r\n\r\n"
+                             "GET /b HTTP/1.1\r\nConnection: keep-alive\r\n\r\n"
+                             "GET /c HTTP/1.1\r\n\r\n");
+        auto expect = make_expected_response("text/plain", "/a", "keep-alive") +
+                      make_expected_response("text/plain", "/b", "keep-alive") +
+                      make_expected_response("text/plain", "/c");
+        EXPECT_EQUAL(result, expect);
+    }
+}
+
+TEST("require that errors close keep-alive connections") {
+    auto portal = Portal::create(null_crypto(), 0);
+    auto result = do_raw(portal->listen_port(), null_crypto(),
+                         "GET /a HTTP/1.1\r\nConnection: keep-alive\r\n\r\n");
+    EXPECT_EQUAL(result, make_expected_error(404, "Not Found"));
+}
+
 TEST_MAIN() { TEST_RUN_ALL(); }
@@ -0,0 +1,190 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/vespalib/stllike/flat_hash_map.hpp>
+#include <vespa/vespalib/gtest/gtest.h>
+#include <vespa/vespalib/util/stringfmt.h>
+#include <map>
+#include <memory>
+#include <random>
+
+using namespace vespalib;
+
+namespace {
+
+struct BadHash {
+    size_t operator() (uint32_t key) const { return key % 4; }
+};
+
+template <typename Map>
+void assert_same(const std::map<uint32_t, uint32_t> &exp, const Map &map)
+{
+    ASSERT_EQ(exp.size(), map.size());
+    for (const auto &kv : exp) {
+        auto itr = map.find(kv.first);
+        ASSERT_TRUE(itr != map.end());
+        EXPECT_EQ(kv.second, itr->second);
+    }
+    size_t visited = 0;
+    for (const auto &kv : map) {
+        EXPECT_EQ(1u, exp.count(kv.first));
+        ++visited;
+    }
+    EXPECT_EQ(exp.size(), visited);
+}
+
+template <typename Map>
+void random_insert_and_erase()
+{
+    std::mt19937 rnd(42);
+    std::map<uint32_t, uint32_t> exp;
+    Map map;
+    for (uint32_t i = 0; i < 20000; ++i) {
+        uint32_t key = rnd() % 2000;
+        if (rnd() % 3 == 0) {
+            exp.erase(key);
+            map.erase(key);
+        } else {
+            auto res = map.insert(std::make_pair(key, i));
+            EXPECT_EQ(exp.insert(std::make_pair(key, i)).second, res.second);
+            EXPECT_EQ(key, res.first->first);
+        }
+    }
+    assert_same(exp, map);
+    for (const auto &kv : exp) {
+        map.erase(kv.first);
+    }
+    EXPECT_TRUE(map.empty());
+    EXPECT_TRUE(map.begin() == map.end());
+}
+
+}
+
+TEST(FlatHashMapTest, empty_map)
+{
+    flat_hash_map<uint32_t, uint32_t> map;
+    EXPECT_TRUE(map.empty());
+    EXPECT_EQ(0u, map.size());
+    EXPECT_EQ(0u, map.capacity());
+    EXPECT_TRUE(map.begin() == map.end());
+    EXPECT_TRUE(map.find(7) == map.end());
+    map.erase(7);
+    map.clear();
+    EXPECT_TRUE(map.empty());
+}
+
+TEST(FlatHashMapTest, insert_find_and_erase)
+{
+    flat_hash_map<uint32_t, uint32_t> map;
+    EXPECT_TRUE(map.insert(std::make_pair(7u, 70u)).second);
+    EXPECT_FALSE(map.insert(std::make_pair(7u, 71u)).second);
+    EXPECT_EQ(1u, map.size());
+    EXPECT_EQ(70u, map.find(7)->second);
+    EXPECT_TRUE(map.find(8) == map.end());
+    map[8] = 80;
+    EXPECT_EQ(80u, map[8]);
+    EXPECT_EQ(2u, map.size());
+    map.erase(7);
+    EXPECT_TRUE(map.find(7) == map.end());
+    EXPECT_EQ(1u, map.size());
+    map.erase(map.find(8));
+    EXPECT_TRUE(map.empty());
+}
+
+TEST(FlatHashMapTest, random_insert_and_erase)
+{
+    random_insert_and_erase<flat_hash_map<uint32_t, uint32_t>>();
+}
+
+TEST(FlatHashMapTest, random_insert_and_erase_with_colliding_hash)
+{
+    random_insert_and_erase<flat_hash_map<uint32_t, uint32_t, BadHash>>();
+}
+
+TEST(FlatHashMapTest, keys_differing_only_in_high_bits)
+{
+    flat_hash_map<uint64_t, uint64_t> map;
+    for (uint64_t i = 0; i < 1000; ++i) {
+        map[i << 32] = i;
+    }
+    for (uint64_t i = 0; i < 1000; ++i) {
+        EXPECT_EQ(i, map[i << 32]);
+    }
+    EXPECT_EQ(1000u, map.size());
+}
+
+TEST(FlatHashMapTest, resize_reserves_capacity)
+{
+    flat_hash_map<uint32_t, uint32_t> map(100);
+    size_t capacity = map.capacity();
+    EXPECT_LE(100u, flat_hash_table_base::capacity_to_growth(capacity));
+    for (uint32_t i = 0; i < 100; ++i) {
+        map[i] = i;
+    }
+    EXPECT_EQ(capacity, map.capacity());
+    map.resize(1000);
+    EXPECT_LE(1000u, flat_hash_table_base::capacity_to_growth(map.capacity()));
+    for (uint32_t i = 0; i < 100; ++i) {
+        EXPECT_EQ(i, map[i]);
+    }
+}
+
+TEST(FlatHashMapTest, erase_and_insert_does_not_grow_table)
+{
+    flat_hash_map<uint32_t, uint32_t> map;
+    for (uint32_t i = 0; i < 10; ++i) {
+        map[i] = i;
+    }
+    size_t capacity = map.capacity();
+    for (uint32_t i = 10; i < 100000; ++i) {
+        map.erase(i - 10);
+        map[i] = i;
+    }
+    EXPECT_EQ(capacity, map.capacity());
+    EXPECT_EQ(10u, map.size());
+}
+
+TEST(FlatHashMapTest, copy_move_swap_and_equal)
+{
+    flat_hash_map<vespalib::string, uint32_t> a;
+    for (uint32_t i = 0; i < 100; ++i) {
+        a[vespalib::make_string("key%u", i)] = i;
+    }
+    flat_hash_map<vespalib::string, uint32_t> b(a);
+    EXPECT_TRUE(a == b);
+    b["key7"] = 8;
+    EXPECT_FALSE(a == b);
+    flat_hash_map<vespalib::string, uint32_t> c(std::move(b));
+    EXPECT_TRUE(b.empty());
+    EXPECT_EQ(100u, c.size());
+    EXPECT_EQ(8u, c["key7"]);
+    c = a;
+    EXPECT_TRUE(a == c);
+    flat_hash_map<vespalib::string, uint32_t> d;
+    d.swap(c);
+    EXPECT_TRUE(c.empty());
+    EXPECT_TRUE(a == d);
+    EXPECT_TRUE(d.find(vespalib::stringref("key42")) != d.end());
+}
+
+TEST(FlatHashMapTest, non_copyable_value)
+{
+    flat_hash_map<uint32_t, std::unique_ptr<uint32_t>> map;
+    for (uint32_t i = 0; i < 100; ++i) {
+        map.insert(std::make_pair(i, std::make_unique<uint32_t>(i)));
+    }
+    for (uint32_t i = 0; i < 100; ++i) {
+        EXPECT_EQ(i, *map.find(i)->second);
+    }
+}
+
+TEST(FlatHashMapTest, initializer_list_and_for_each)
+{
+    flat_hash_map<uint32_t, uint32_t> map({{1, 10}, {2, 20}, {3, 30}});
+    uint32_t sum = 0;
+    map.for_each([&sum](const auto &kv) { sum += kv.second; });
+    EXPECT_EQ(60u, sum);
+    flat_hash_map<uint32_t, uint32_t>::const_iterator itr = map.begin();
+    EXPECT_TRUE(itr != map.end());
+}
+
+GTEST_MAIN_RUN_ALL_TESTS()
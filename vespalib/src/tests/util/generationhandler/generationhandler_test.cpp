@@ -3,6 +3,8 @@
 #include <vespa/vespalib/testkit/testapp.h>
 #include <vespa/vespalib/util/generationhandler.h>
 #include <deque>
+#include <thread>
+#include <vector>
 
 namespace vespalib {
 
@@ -15,6 +17,7 @@ private:
     void requireThatGuardsCanBeCopied();
     void requireThatTheFirstUsedGenerationIsCorrect();
     void requireThatGenerationCanGrowLarge();
+    void requireThatGuardsFromManyThreadsAreCounted();
 public:
     int Main() override;
 };
@@ -138,6 +141,36 @@ Test::requireThatGenerationCanGrowLarge()
     }
 }
 
+void
+Test::requireThatGuardsFromManyThreadsAreCounted()
+{
+    // More threads than reader count shards, guards are copied across threads.
+    constexpr uint32_t numThreads = 2 * GenerationHandler::GenerationHold::NUM_SHARDS + 1;
+    GenerationHandler gh;
+    std::vector<GenGuard> guards(numThreads);
+    std::vector<std::thread> threads;
+    for (uint32_t i = 0; i < numThreads; ++i) {
+        threads.emplace_back([&gh, &guards, i]() { guards[i] = gh.takeGuard(); });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    EXPECT_EQUAL(numThreads, gh.getGenerationRefCount(0));
+    gh.incGeneration();
+    GenGuard copy(guards[1]);
+    EXPECT_EQUAL(numThreads + 1, gh.getGenerationRefCount(0));
+    for (uint32_t i = 0; i < numThreads; ++i) {
+        guards[i] = GenGuard();
+        gh.updateFirstUsedGeneration();
+        EXPECT_EQUAL(0u, gh.getFirstUsedGeneration());
+    }
+    EXPECT_EQUAL(1u, gh.getGenerationRefCount(0));
+    copy = GenGuard();
+    gh.updateFirstUsedGeneration();
+    EXPECT_EQUAL(1u, gh.getFirstUsedGeneration());
+    EXPECT_FALSE(gh.hasReaders());
+}
+
 int
 Test::Main()
 {
@@ -148,6 +181,7 @@ Test::Main()
     TEST_DO(requireThatGuardsCanBeCopied());
     TEST_DO(requireThatTheFirstUsedGenerationIsCorrect());
     TEST_DO(requireThatGenerationCanGrowLarge());
+    TEST_DO(requireThatGuardsFromManyThreadsAreCounted());
 
     TEST_DONE();
 }
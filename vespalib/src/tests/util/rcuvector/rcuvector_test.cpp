@@ -2,6 +2,8 @@
 
 #include <vespa/vespalib/testkit/testapp.h>
 #include <vespa/vespalib/util/rcuvector.h>
+#include <vespa/vespalib/util/segmented_rcuvector.hpp>
+#include <vespa/vespalib/util/mmap_file_allocator.h>
 
 using namespace vespalib;
 
@@ -293,4 +295,100 @@ TEST("test small expand")
     g.trimHoldLists(2);
 }
 
+TEST("require that initial allocator is used when vector is reallocated")
+{
+    alloc::MmapFileAllocator allocator("rcuvector-mmap-file-allocator-dir");
+    {
+        GenerationHolder g;
+        RcuVectorBase<int32_t> v(16, 100, 0, g, alloc::Alloc::alloc_with_allocator(&allocator));
+        EXPECT_EQUAL(1u, allocator.get_num_allocations());
+        for (int32_t i = 0; i < 1000; ++i) {
+            v.push_back(i);
+        }
+        EXPECT_LESS(16u, v.capacity());
+        // old vectors are on hold until the hold lists are trimmed
+        g.transferHoldLists(1);
+        g.trimHoldLists(2);
+        EXPECT_EQUAL(1u, allocator.get_num_allocations());
+        v.shrink(10);
+        g.transferHoldLists(2);
+        g.trimHoldLists(3);
+        EXPECT_EQUAL(1u, allocator.get_num_allocations());
+        EXPECT_EQUAL(9, v[9]);
+        v.reset();
+        EXPECT_EQUAL(1u, allocator.get_num_allocations());
+    }
+    EXPECT_EQUAL(0u, allocator.get_num_allocations());
+}
+
+using SmallChunkVector = SegmentedRcuVector<int32_t, 2>;
+
+TEST("require that segmented vector grows without moving elements")
+{
+    SmallChunkVector v;
+    EXPECT_EQUAL(0u, v.capacity());
+    EXPECT_TRUE(v.empty());
+    v.push_back(0);
+    const int32_t *first = &v[0];
+    EXPECT_EQUAL(4u, v.capacity());
+    for (int32_t i = 1; i < 100; ++i) {
+        v.push_back(i * 10);
+    }
+    EXPECT_EQUAL(100u, v.size());
+    EXPECT_EQUAL(100u, v.capacity());
+    EXPECT_EQUAL(first, &v[0]);
+    for (int32_t i = 0; i < 100; ++i) {
+        EXPECT_EQUAL(i * 10, v[i]);
+    }
+    v.ensure_size(103, 7);
+    EXPECT_EQUAL(103u, v.size());
+    EXPECT_EQUAL(104u, v.capacity());
+    EXPECT_EQUAL(7, v[102]);
+    EXPECT_FALSE(v.isFull());
+}
+
+TEST("require that segmented vector only holds directory on growth")
+{
+    SmallChunkVector v(64);
+    EXPECT_EQUAL(64u, v.capacity());
+    v.ensure_size(64);
+    EXPECT_EQUAL(0u, v.getMemoryUsage().allocatedBytesOnHold());
+    v.push_back(64); // new chunk and new directory
+    EXPECT_EQUAL(68u, v.capacity());
+    EXPECT_EQUAL(16u * sizeof(int32_t *), v.getMemoryUsage().allocatedBytesOnHold());
+    v.setGeneration(1);
+    v.reserve(128);
+    EXPECT_EQUAL(16u * sizeof(int32_t *), v.getMemoryUsage().allocatedBytesOnHold());
+    v.removeOldGenerations(1);
+    EXPECT_EQUAL(0u, v.getMemoryUsage().allocatedBytesOnHold());
+    EXPECT_EQUAL(64, v[64]);
+}
+
+TEST("require that segmented vector shrink holds unused chunks")
+{
+    SmallChunkVector v;
+    for (int32_t i = 0; i < 10; ++i) {
+        v.push_back(i);
+    }
+    EXPECT_TRUE(assertUsage(MemoryUsage(3 * 16 + 16 * 8, 10 * 4 + 3 * 8, 0, 0), v.getMemoryUsage()));
+    v.shrink(5);
+    EXPECT_EQUAL(5u, v.size());
+    EXPECT_EQUAL(8u, v.capacity());
+    EXPECT_TRUE(assertUsage(MemoryUsage(3 * 16 + 16 * 8, 5 * 4 + 2 * 8 + 16, 0, 16), v.getMemoryUsage()));
+    v.setGeneration(1);
+    v.removeOldGenerations(1);
+    EXPECT_TRUE(assertUsage(MemoryUsage(2 * 16 + 16 * 8, 5 * 4 + 2 * 8, 0, 0), v.getMemoryUsage()));
+    v.push_back(5);
+    v.push_back(6);
+    v.push_back(7);
+    v.push_back(8);
+    EXPECT_EQUAL(12u, v.capacity());
+    for (int32_t i = 0; i < 9; ++i) {
+        EXPECT_EQUAL(i, v[i]);
+    }
+    v.reset();
+    EXPECT_EQUAL(0u, v.size());
+    EXPECT_EQUAL(0u, v.capacity());
+}
+
 TEST_MAIN() { TEST_RUN_ALL(); }
@@ -1,6 +1,7 @@
 // Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 #include <vespa/vespalib/testkit/test_kit.h>
 #include <vespa/vespalib/geo/zcurve.h>
+#include <algorithm>
 #include <vector>
 #include <cinttypes>
 
@@ -55,4 +56,60 @@ TEST("require that silly bounding box does not explode") {
     EXPECT_EQUAL(42u, ranges.size());
 }
 
+struct Circle {
+    int64_t x;
+    int64_t y;
+    int64_t r;
+    Circle(int64_t x_in, int64_t y_in, int64_t r_in) : x(x_in), y(y_in), r(r_in) {}
+    bool contains(int64_t px, int64_t py) const {
+        return ((px - x) * (px - x) + (py - y) * (py - y)) <= (r * r);
+    }
+    bool outside(const Z::Area &area) const {
+        int64_t px = std::max(int64_t(area.min.x), std::min(x, int64_t(area.max.x)));
+        int64_t py = std::max(int64_t(area.min.y), std::min(y, int64_t(area.max.y)));
+        return !contains(px, py);
+    }
+    Z::RangeVector find_ranges() const {
+        return Z::find_ranges(x - r, y - r, x + r, y + r,
+                              [this](const Z::Area &area){ return outside(area); });
+    }
+};
+
+int64_t total_size(const Z::RangeVector &ranges) {
+    int64_t size = 0;
+    for (auto range: ranges) {
+        size += (range.max() - range.min() + 1);
+    }
+    return size;
+}
+
+TEST("require that returned ranges contains circle") {
+    for (const Circle &circle: {Circle(0, 0, 13), Circle(-7, 5, 9), Circle(1000, 1000, 100)}) {
+        Z::RangeVector ranges = circle.find_ranges();
+        EXPECT_LESS_EQUAL(ranges.size(), 42u);
+        for (int64_t x = circle.x - circle.r; x <= circle.x + circle.r; ++x) {
+            for (int64_t y = circle.y - circle.r; y <= circle.y + circle.r; ++y) {
+                if (circle.contains(x, y) && !EXPECT_TRUE(inside(x, y, ranges))) {
+                    fprintf(stderr, "CIRCLE: (%" PRId64 ", %" PRId64 ") r=%" PRId64 "\n",
+                            circle.x, circle.y, circle.r);
+                    return;
+                }
+            }
+        }
+    }
+}
+
+TEST("require that circle ranges are tighter than bounding box ranges") {
+    Circle circle(1000, 1000, 100);
+    Z::RangeVector box_ranges = Z::find_ranges(900, 900, 1100, 1100);
+    Z::RangeVector circle_ranges = circle.find_ranges();
+    EXPECT_LESS(total_size(circle_ranges), total_size(box_ranges));
+    EXPECT_LESS_EQUAL(total_size(circle_ranges), 201 * 201);
+}
+
+TEST("require that nothing is covered when the whole shape is outside") {
+    Z::RangeVector ranges = Z::find_ranges(-13, -13, 13, 13, [](const Z::Area &){ return true; });
+    EXPECT_EQUAL(0u, ranges.size());
+}
+
 TEST_MAIN() { TEST_RUN_ALL(); }
@@ -175,7 +175,8 @@ protected:
     ~BTreeNodeT() {}
 
     BTreeNodeT(const BTreeNodeT &rhs)
-        : BTreeNode(rhs)
+        : BTreeNode(rhs),
+          _keys()
     {
         const KeyT *rkeys = rhs._keys;
         KeyT *lkeys = _keys;
@@ -201,6 +202,12 @@ public:
     const KeyT & getLastKey() const { return _keys[validSlots() - 1]; }
     void writeKey(uint32_t idx, const KeyT & key) { _keys[idx] = key; }
 
+    /*
+     * Integer keys ordered by std::less are searched by counting the
+     * keys below the search key over all slots, which is branch-free
+     * and vectorized by the compiler. Other keys and comparators use a
+     * binary search.
+     */
     template <typename CompareT>
     uint32_t lower_bound(uint32_t sidx, const KeyT & key, CompareT comp) const;
 
@@ -4,6 +4,8 @@
 
 #include "btreenode.h"
 #include <algorithm>
+#include <functional>
+#include <type_traits>
 
 namespace vespalib::btree {
 
@@ -34,6 +36,29 @@ public:
     }
 };
 
+template <typename KeyT, typename CompareT>
+constexpr bool use_counting_key_search = std::is_integral_v<KeyT> &&
+                                         (sizeof(KeyT) == 4 || sizeof(KeyT) == 8) &&
+                                         std::is_same_v<CompareT, std::less<KeyT>>;
+
+/*
+ * Returns the number of keys in [sidx, eidx) that are below key
+ * (inclusive = false) or not above key (inclusive = true). All slots
+ * are visited, giving a fixed trip count the compiler turns into
+ * vector compares. Unused slots are always initialized since the key
+ * array is value initialized when the node is constructed.
+ */
+template <typename KeyT, uint32_t NumSlots, bool inclusive>
+uint32_t
+count_keys_below(const KeyT *keys, uint32_t sidx, uint32_t eidx, KeyT key)
+{
+    uint32_t count = 0;
+    for (uint32_t i = 0; i < NumSlots; ++i) {
+        bool below = inclusive ? (keys[i] <= key) : (keys[i] < key);
+        count += ((i >= sidx) & (i < eidx) & below);
+    }
+    return count;
+}
 
 }
 
@@ -43,9 +68,13 @@ uint32_t
 BTreeNodeT<KeyT, NumSlots>::
 lower_bound(uint32_t sidx, const KeyT & key, CompareT comp) const
 {
-    const KeyT * itr = std::lower_bound<const KeyT *, KeyT, CompareT>
-        (_keys + sidx, _keys + validSlots(), key, comp);
-    return itr - _keys;
+    if constexpr (use_counting_key_search<KeyT, CompareT>) {
+        return sidx + count_keys_below<KeyT, NumSlots, false>(_keys, sidx, validSlots(), key);
+    } else {
+        const KeyT * itr = std::lower_bound<const KeyT *, KeyT, CompareT>
+            (_keys + sidx, _keys + validSlots(), key, comp);
+        return itr - _keys;
+    }
 }
 
 template <typename KeyT, uint32_t NumSlots>
@@ -53,10 +82,7 @@ template <typename CompareT>
 uint32_t
 BTreeNodeT<KeyT, NumSlots>::lower_bound(const KeyT & key, CompareT comp) const
 {
-    
-    const KeyT * itr = std::lower_bound<const KeyT *, KeyT, CompareT>
-        (_keys, _keys + validSlots(), key, comp);
-    return itr - _keys;
+    return lower_bound(0, key, comp);
 }
 
 
@@ -66,9 +92,13 @@ uint32_t
 BTreeNodeT<KeyT, NumSlots>::
 upper_bound(uint32_t sidx, const KeyT & key, CompareT comp) const
 {
-    const KeyT * itr = std::upper_bound<const KeyT *, KeyT, CompareT>
-        (_keys + sidx, _keys + validSlots(), key, comp);
-    return itr - _keys;
+    if constexpr (use_counting_key_search<KeyT, CompareT>) {
+        return sidx + count_keys_below<KeyT, NumSlots, true>(_keys, sidx, validSlots(), key);
+    } else {
+        const KeyT * itr = std::upper_bound<const KeyT *, KeyT, CompareT>
+            (_keys + sidx, _keys + validSlots(), key, comp);
+        return itr - _keys;
+    }
 }
 
 
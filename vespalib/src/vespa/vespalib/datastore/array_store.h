@@ -28,19 +28,28 @@ public:
     using ArrayRef = vespalib::ArrayRef<EntryT>;
     using ConstArrayRef = vespalib::ConstArrayRef<EntryT>;
     using DataStoreType  = DataStoreT<RefT>;
-    using SmallArrayType = BufferType<EntryT>;
     using LargeArray = vespalib::Array<EntryT>;
     using AllocSpec = ArrayStoreConfig::AllocSpec;
 
+    class SmallArrayType : public BufferType<EntryT> {
+    private:
+        const alloc::MemoryAllocator* _memory_allocator;
+    public:
+        SmallArrayType(uint32_t arraySize, const AllocSpec &spec, const alloc::MemoryAllocator* memory_allocator);
+        const alloc::MemoryAllocator* get_memory_allocator() const override { return _memory_allocator; }
+    };
+
 private:
     class LargeArrayType : public BufferType<LargeArray> {
     private:
         using ParentType = BufferType<LargeArray>;
         using ParentType::_emptyEntry;
         using CleanContext = typename ParentType::CleanContext;
+        const alloc::MemoryAllocator* _memory_allocator;
     public:
-        LargeArrayType(const AllocSpec &spec);
+        LargeArrayType(const AllocSpec &spec, const alloc::MemoryAllocator* memory_allocator);
         virtual void cleanHold(void *buffer, size_t offset, size_t numElems, CleanContext cleanCtx) override;
+        const alloc::MemoryAllocator* get_memory_allocator() const override { return _memory_allocator; }
     };
 
 
@@ -10,8 +10,17 @@
 namespace vespalib::datastore {
 
 template <typename EntryT, typename RefT>
-ArrayStore<EntryT, RefT>::LargeArrayType::LargeArrayType(const AllocSpec &spec)
-    : BufferType<LargeArray>(1, spec.minArraysInBuffer, spec.maxArraysInBuffer, spec.numArraysForNewBuffer, spec.allocGrowFactor)
+ArrayStore<EntryT, RefT>::SmallArrayType::SmallArrayType(uint32_t arraySize, const AllocSpec &spec,
+                                                         const alloc::MemoryAllocator* memory_allocator)
+    : BufferType<EntryT>(arraySize, spec.minArraysInBuffer, spec.maxArraysInBuffer, spec.numArraysForNewBuffer, spec.allocGrowFactor),
+      _memory_allocator(memory_allocator)
+{
+}
+
+template <typename EntryT, typename RefT>
+ArrayStore<EntryT, RefT>::LargeArrayType::LargeArrayType(const AllocSpec &spec, const alloc::MemoryAllocator* memory_allocator)
+    : BufferType<LargeArray>(1, spec.minArraysInBuffer, spec.maxArraysInBuffer, spec.numArraysForNewBuffer, spec.allocGrowFactor),
+      _memory_allocator(memory_allocator)
 {
 }
 
@@ -35,9 +44,7 @@ ArrayStore<EntryT, RefT>::initArrayTypes(const ArrayStoreConfig &cfg)
     assert(_largeArrayTypeId == 0);
     for (uint32_t arraySize = 1; arraySize <= _maxSmallArraySize; ++arraySize) {
         const AllocSpec &spec = cfg.specForSize(arraySize);
-        _smallArrayTypes.push_back(std::make_unique<SmallArrayType>
-                                           (arraySize, spec.minArraysInBuffer, spec.maxArraysInBuffer,
-                                            spec.numArraysForNewBuffer, spec.allocGrowFactor));
+        _smallArrayTypes.push_back(std::make_unique<SmallArrayType>(arraySize, spec, cfg.memory_allocator()));
         uint32_t typeId = _store.addType(_smallArrayTypes.back().get());
         assert(typeId == arraySize); // Enforce 1-to-1 mapping between type ids and sizes for small arrays
     }
@@ -49,7 +56,7 @@ ArrayStore<EntryT, RefT>::ArrayStore(const ArrayStoreConfig &cfg)
       _maxSmallArraySize(cfg.maxSmallArraySize()),
       _store(),
       _smallArrayTypes(),
-      _largeArrayType(cfg.specForSize(0))
+      _largeArrayType(cfg.specForSize(0), cfg.memory_allocator())
 {
     initArrayTypes(cfg);
     _store.initActiveBuffers();
@@ -7,7 +7,8 @@ namespace vespalib::datastore {
 
 ArrayStoreConfig::ArrayStoreConfig(size_t maxSmallArraySize, const AllocSpec &defaultSpec)
     : _allocSpecs(),
-      _enable_free_lists(false)
+      _enable_free_lists(false),
+      _huge_page_policy(alloc::HugePagePolicy::DEFAULT)
 {
     for (size_t i = 0; i < (maxSmallArraySize + 1); ++i) {
         _allocSpecs.push_back(defaultSpec);
@@ -16,10 +17,20 @@ ArrayStoreConfig::ArrayStoreConfig(size_t maxSmallArraySize, const AllocSpec &de
 
 ArrayStoreConfig::ArrayStoreConfig(const AllocSpecVector &allocSpecs)
     : _allocSpecs(allocSpecs),
-      _enable_free_lists(false)
+      _enable_free_lists(false),
+      _huge_page_policy(alloc::HugePagePolicy::DEFAULT)
 {
 }
 
+const alloc::MemoryAllocator*
+ArrayStoreConfig::memory_allocator() const
+{
+    if (_huge_page_policy == alloc::HugePagePolicy::DEFAULT) {
+        return nullptr;
+    }
+    return alloc::MemoryAllocator::select_allocator(alloc::MemoryAllocator::HUGEPAGE_SIZE, 0, _huge_page_policy);
+}
+
 const ArrayStoreConfig::AllocSpec &
 ArrayStoreConfig::specForSize(size_t arraySize) const
 {
@@ -113,6 +113,12 @@ BufferTypeBase::clampMaxArrays(uint32_t maxArrays)
     _numArraysForNewBuffer = std::min(_numArraysForNewBuffer, _maxArrays);
 }
 
+const alloc::MemoryAllocator*
+BufferTypeBase::get_memory_allocator() const
+{
+    return nullptr;
+}
+
 size_t
 BufferTypeBase::calcArraysToAlloc(uint32_t bufferId, size_t elemsNeeded, bool resizing) const
 {
@@ -5,6 +5,8 @@
 #include <cstdint>
 #include <cstddef>
 
+namespace vespalib::alloc { class MemoryAllocator; }
+
 namespace vespalib::datastore {
 
 /**
@@ -67,6 +69,10 @@ public:
     virtual size_t calcArraysToAlloc(uint32_t bufferId, size_t elementsNeeded, bool resizing) const;
 
     void clampMaxArrays(uint32_t maxArrays);
+    /**
+     * Returns the allocator used for buffers of this type, or nullptr to use the default allocator.
+     */
+    virtual const alloc::MemoryAllocator* get_memory_allocator() const;
 
     uint32_t getActiveBuffers() const { return _activeBuffers; }
     size_t getMaxArrays() const { return _maxArrays; }
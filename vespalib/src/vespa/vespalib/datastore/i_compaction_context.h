@@ -2,7 +2,10 @@
 
 #pragma once
 
+#include "entryref.h"
 #include <vespa/vespalib/util/array.h>
+#include <vespa/vespalib/util/arrayref.h>
+#include <memory>
 
 namespace vespalib::datastore {
 
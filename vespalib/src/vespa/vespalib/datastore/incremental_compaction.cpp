@@ -0,0 +1,54 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "incremental_compaction.h"
+#include <algorithm>
+#include <cassert>
+#include <limits>
+
+namespace vespalib::datastore {
+
+IncrementalCompaction::IncrementalCompaction()
+    : _context(),
+      _next(0u)
+{
+}
+
+IncrementalCompaction::~IncrementalCompaction() = default;
+
+void
+IncrementalCompaction::start(ICompactionContext::UP context)
+{
+    assert(!_context);
+    _context = std::move(context);
+    _next = 0u;
+}
+
+bool
+IncrementalCompaction::step(vespalib::ArrayRef<EntryRef> refs, uint32_t max_refs)
+{
+    if (!_context) {
+        return false;
+    }
+    uint32_t limit = refs.size();
+    uint32_t start = std::min(_next, limit);
+    uint32_t end = start + std::min(max_refs, limit - start);
+    if (start < end) {
+        _context->compact(vespalib::ArrayRef<EntryRef>(&refs[start], end - start));
+    }
+    _next = end;
+    if (end == limit) {
+        // puts compacted buffers on hold
+        _context.reset();
+        _next = 0u;
+        return true;
+    }
+    return false;
+}
+
+bool
+IncrementalCompaction::finish(vespalib::ArrayRef<EntryRef> refs)
+{
+    return step(refs, std::numeric_limits<uint32_t>::max());
+}
+
+}
@@ -0,0 +1,47 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include "i_compaction_context.h"
+
+namespace vespalib::datastore {
+
+/**
+ * Driver for compacting data store buffers in bounded steps.
+ *
+ * The owner of a vector of entry refs starts a compaction with a
+ * compaction context, and then calls step() once per commit. Each step
+ * passes at most a given number of refs to the compaction context,
+ * continuing where the previous step stopped. When all refs have been
+ * visited the compaction context is destroyed, putting the compacted
+ * buffers on hold, and the owner must bump the generation.
+ *
+ * Entries moved by a step are still present in the compacted buffers,
+ * thus readers observing either the old or the new ref are safe until
+ * the hold lists are trimmed.
+ */
+class IncrementalCompaction {
+    ICompactionContext::UP _context;
+    uint32_t               _next;
+public:
+    IncrementalCompaction();
+    ~IncrementalCompaction();
+    void start(ICompactionContext::UP context);
+    bool in_progress() const { return static_cast<bool>(_context); }
+    uint32_t next() const { return _next; }
+
+    /**
+     * Compact at most max_refs refs starting at next(). Refs added
+     * after the compaction started refer to entries outside the
+     * compacted buffers, but are visited anyway for simplicity.
+     * Returns true if the compaction finished by this step.
+     */
+    bool step(vespalib::ArrayRef<EntryRef> refs, uint32_t max_refs);
+
+    /**
+     * Compact all remaining refs.
+     */
+    bool finish(vespalib::ArrayRef<EntryRef> refs);
+};
+
+}
@@ -48,6 +48,7 @@ private:
 public:
     UniqueStore();
     UniqueStore(std::unique_ptr<IUniqueStoreDictionary> dict);
+    UniqueStore(std::unique_ptr<IUniqueStoreDictionary> dict, std::unique_ptr<alloc::MemoryAllocator> memory_allocator);
     ~UniqueStore();
     void set_dictionary(std::unique_ptr<IUniqueStoreDictionary> dict);
     UniqueStoreAddResult add(EntryConstRefType value);
@@ -34,7 +34,14 @@ UniqueStore<EntryT, RefT, Compare, Allocator>::UniqueStore()
 
 template <typename EntryT, typename RefT, typename Compare, typename Allocator>
 UniqueStore<EntryT, RefT, Compare, Allocator>::UniqueStore(std::unique_ptr<IUniqueStoreDictionary> dict)
-    : _allocator(),
+    : UniqueStore<EntryT, RefT, Compare, Allocator>(std::move(dict), std::unique_ptr<alloc::MemoryAllocator>())
+{
+}
+
+template <typename EntryT, typename RefT, typename Compare, typename Allocator>
+UniqueStore<EntryT, RefT, Compare, Allocator>::UniqueStore(std::unique_ptr<IUniqueStoreDictionary> dict,
+                                                           std::unique_ptr<alloc::MemoryAllocator> memory_allocator)
+    : _allocator(std::move(memory_allocator)),
       _store(_allocator.get_data_store()),
       _dict(std::move(dict))
 {
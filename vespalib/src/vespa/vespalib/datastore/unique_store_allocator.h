@@ -7,9 +7,27 @@
 #include "unique_store_add_result.h"
 #include "unique_store_entry.h"
 #include "i_compactable.h"
+#include <vespa/vespalib/util/alloc.h>
 
 namespace vespalib::datastore {
 
+/*
+ * Buffer type for values in unique store, using the given memory
+ * allocator (if any) for its buffers.
+ */
+template <typename WrappedEntryT>
+class UniqueStoreBufferType : public BufferType<WrappedEntryT> {
+    const alloc::MemoryAllocator* _memory_allocator;
+public:
+    UniqueStoreBufferType(uint32_t min_arrays, uint32_t max_arrays, uint32_t num_arrays_for_new_buffer,
+                          float alloc_grow_factor, const alloc::MemoryAllocator* memory_allocator)
+        : BufferType<WrappedEntryT>(1, min_arrays, max_arrays, num_arrays_for_new_buffer, alloc_grow_factor),
+          _memory_allocator(memory_allocator)
+    {
+    }
+    const alloc::MemoryAllocator* get_memory_allocator() const override { return _memory_allocator; }
+};
+
 /**
  * Allocator for unique values of type EntryT that is accessed via a
  * 32-bit EntryRef.
@@ -23,13 +41,15 @@ public:
     using EntryConstRefType = const EntryType &;
     using WrappedEntryType = UniqueStoreEntry<EntryType>;
     using RefType = RefT;
-    using UniqueStoreBufferType = BufferType<WrappedEntryType>;
+    using UniqueStoreBufferType = datastore::UniqueStoreBufferType<WrappedEntryType>;
 private:
+    std::unique_ptr<alloc::MemoryAllocator> _memory_allocator;
     DataStoreType _store;
     UniqueStoreBufferType _typeHandler;
 
 public:
     UniqueStoreAllocator();
+    UniqueStoreAllocator(std::unique_ptr<alloc::MemoryAllocator> memory_allocator);
     ~UniqueStoreAllocator() override;
     EntryRef allocate(const EntryType& value);
     void hold(EntryRef ref);
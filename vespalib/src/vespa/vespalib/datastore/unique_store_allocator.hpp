@@ -13,9 +13,16 @@ constexpr float ALLOC_GROW_FACTOR = 0.2;
 
 template <typename EntryT, typename RefT>
 UniqueStoreAllocator<EntryT, RefT>::UniqueStoreAllocator()
+    : UniqueStoreAllocator(std::unique_ptr<alloc::MemoryAllocator>())
+{
+}
+
+template <typename EntryT, typename RefT>
+UniqueStoreAllocator<EntryT, RefT>::UniqueStoreAllocator(std::unique_ptr<alloc::MemoryAllocator> memory_allocator)
     : ICompactable(),
+      _memory_allocator(std::move(memory_allocator)),
       _store(),
-      _typeHandler(1, 2u, RefT::offsetSize(), NUM_ARRAYS_FOR_NEW_UNIQUESTORE_BUFFER, ALLOC_GROW_FACTOR)
+      _typeHandler(2u, RefT::offsetSize(), NUM_ARRAYS_FOR_NEW_UNIQUESTORE_BUFFER, ALLOC_GROW_FACTOR, _memory_allocator.get())
 {
     auto typeId = _store.addType(&_typeHandler);
     assert(typeId == 0u);
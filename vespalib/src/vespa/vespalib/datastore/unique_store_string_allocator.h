@@ -7,6 +7,7 @@
 #include "unique_store_add_result.h"
 #include "unique_store_entry.h"
 #include "i_compactable.h"
+#include <vespa/vespalib/util/alloc.h>
 #include <cassert>
 #include <string>
 
@@ -56,22 +57,26 @@ public:
  * bytes
  */
 class UniqueStoreSmallStringBufferType : public BufferType<char> {
+    const alloc::MemoryAllocator* _memory_allocator;
 public:
-    UniqueStoreSmallStringBufferType(uint32_t array_size, uint32_t max_arrays);
+    UniqueStoreSmallStringBufferType(uint32_t array_size, uint32_t max_arrays, const alloc::MemoryAllocator* memory_allocator);
     ~UniqueStoreSmallStringBufferType() override;
     void destroyElements(void *, size_t) override;
     void fallbackCopy(void *newBuffer, const void *oldBuffer, size_t numElems) override;
     void cleanHold(void *buffer, size_t offset, size_t numElems, CleanContext) override;
+    const alloc::MemoryAllocator* get_memory_allocator() const override { return _memory_allocator; }
 };
 
 /*
  * Buffer type for external strings in unique store.
  */
 class UniqueStoreExternalStringBufferType : public BufferType<UniqueStoreEntry<std::string>> {
+    const alloc::MemoryAllocator* _memory_allocator;
 public:
-    UniqueStoreExternalStringBufferType(uint32_t array_size, uint32_t max_arrays);
+    UniqueStoreExternalStringBufferType(uint32_t array_size, uint32_t max_arrays, const alloc::MemoryAllocator* memory_allocator);
     ~UniqueStoreExternalStringBufferType() override;
     void cleanHold(void *buffer, size_t offset, size_t numElems, CleanContext cleanCtx) override;
+    const alloc::MemoryAllocator* get_memory_allocator() const override { return _memory_allocator; }
 };
 
 /**
@@ -83,7 +88,9 @@ public:
  * different buffer type handler where buffer contains meta data
  * (reference count) and an std::string, while the string value is on
  * the heap.  string_allocator::get_type_id() is used to map from
- * string length to type id.
+ * string length to type id. If a memory allocator is given, it is
+ * used for all buffers. The value of a large string is still
+ * allocated on the heap.
  */
 template <typename RefT = EntryRefT<22> >
 class UniqueStoreStringAllocator : public ICompactable
@@ -95,6 +102,7 @@ public:
     using WrappedExternalEntryType = UniqueStoreEntry<std::string>;
     using RefType = RefT;
 private:
+    std::unique_ptr<alloc::MemoryAllocator> _memory_allocator;
     DataStoreType _store;
     std::vector<std::unique_ptr<BufferTypeBase>> _type_handlers;
 
@@ -102,6 +110,7 @@ private:
 
 public:
     UniqueStoreStringAllocator();
+    UniqueStoreStringAllocator(std::unique_ptr<alloc::MemoryAllocator> memory_allocator);
     ~UniqueStoreStringAllocator() override;
     EntryRef allocate(const char *value);
     void hold(EntryRef ref);
@@ -9,13 +9,20 @@ namespace vespalib::datastore {
 
 template <typename RefT>
 UniqueStoreStringAllocator<RefT>::UniqueStoreStringAllocator()
+    : UniqueStoreStringAllocator(std::unique_ptr<alloc::MemoryAllocator>())
+{
+}
+
+template <typename RefT>
+UniqueStoreStringAllocator<RefT>::UniqueStoreStringAllocator(std::unique_ptr<alloc::MemoryAllocator> memory_allocator)
     : ICompactable(),
+      _memory_allocator(std::move(memory_allocator)),
       _store(),
       _type_handlers()
 {
-    _type_handlers.emplace_back(std::make_unique<UniqueStoreExternalStringBufferType>(1, RefT::offsetSize()));
+    _type_handlers.emplace_back(std::make_unique<UniqueStoreExternalStringBufferType>(1, RefT::offsetSize(), _memory_allocator.get()));
     for (auto size : string_allocator::array_sizes) {
-        _type_handlers.emplace_back(std::make_unique<UniqueStoreSmallStringBufferType>(size, RefT::offsetSize()));
+        _type_handlers.emplace_back(std::make_unique<UniqueStoreSmallStringBufferType>(size, RefT::offsetSize(), _memory_allocator.get()));
     }
     uint32_t exp_type_id = 0;
     for (auto &type_handler : _type_handlers) {
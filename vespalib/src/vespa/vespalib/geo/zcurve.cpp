@@ -60,32 +60,43 @@ class ZAreaSplitter
 {
 private:
     typedef ZCurve::Area Area;
+    typedef ZCurve::AreaFilter AreaFilter;
     typedef ZCurve::RangeVector RangeVector;
 
-    ZAreaQueue _queue;
+    ZAreaQueue        _queue;
+    const AreaFilter *_outside;
+
+    void put(Area area) {
+        if ((_outside == nullptr) || !(*_outside)(area)) {
+            _queue.put(std::move(area));
+        }
+    }
 
 public:
-    ZAreaSplitter(int min_x, int min_y, int max_x, int max_y) : _queue() {
+    ZAreaSplitter(int min_x, int min_y, int max_x, int max_y, const AreaFilter *outside)
+        : _queue(),
+          _outside(outside)
+    {
         assert(min_x <= max_x);
         assert(min_y <= max_y);
         bool cross_x = (min_x < 0) != (max_x < 0);
         bool cross_y = (min_y < 0) != (max_y < 0);
         if (cross_x) {
             if (cross_y) {
-                _queue.put(Area(min_x, min_y,    -1,    -1));
-                _queue.put(Area(    0, min_y, max_x,    -1));
-                _queue.put(Area(min_x,     0,    -1, max_y));
-                _queue.put(Area(    0,     0, max_x, max_y));
+                put(Area(min_x, min_y,    -1,    -1));
+                put(Area(    0, min_y, max_x,    -1));
+                put(Area(min_x,     0,    -1, max_y));
+                put(Area(    0,     0, max_x, max_y));
             } else {
-                _queue.put(Area(min_x, min_y,    -1, max_y));
-                _queue.put(Area(    0, min_y, max_x, max_y));
+                put(Area(min_x, min_y,    -1, max_y));
+                put(Area(    0, min_y, max_x, max_y));
             }
         } else {
             if (cross_y) {
-                _queue.put(Area(min_x, min_y, max_x,    -1));
-                _queue.put(Area(min_x,     0, max_x, max_y));
+                put(Area(min_x, min_y, max_x,    -1));
+                put(Area(min_x,     0, max_x, max_y));
             } else {
-                _queue.put(Area(min_x, min_y, max_x, max_y));
+                put(Area(min_x, min_y, max_x, max_y));
             }
         }
     }
@@ -101,12 +112,12 @@ public:
         uint32_t x_bits = bits::split_range(area.min.x, area.max.x, x_first_max, x_last_min);
         uint32_t y_bits = bits::split_range(area.min.y, area.max.y, y_first_max, y_last_min);
         if (x_bits > y_bits) {
-            _queue.put(Area(area.min.x, area.min.y, x_first_max, area.max.y));
-            _queue.put(Area(x_last_min, area.min.y,  area.max.x, area.max.y));
+            put(Area(area.min.x, area.min.y, x_first_max, area.max.y));
+            put(Area(x_last_min, area.min.y,  area.max.x, area.max.y));
         } else {
             assert(y_bits > 0);
-            _queue.put(Area(area.min.x, area.min.y, area.max.x, y_first_max));
-            _queue.put(Area(area.min.x, y_last_min, area.max.x,  area.max.y));
+            put(Area(area.min.x, area.min.y, area.max.x, y_first_max));
+            put(Area(area.min.x, y_last_min, area.max.x,  area.max.y));
         }
     }
 
@@ -132,7 +143,7 @@ ZCurve::find_ranges(int min_x, int min_y,
 {
     int64_t total_size = ((max_x - min_x + 1L) * (max_y - min_y + 1L));
     int64_t estimate_target = (total_size * 4);
-    ZAreaSplitter splitter(min_x, min_y, max_x, max_y);
+    ZAreaSplitter splitter(min_x, min_y, max_x, max_y, nullptr);
     while (splitter.total_estimate() > estimate_target && splitter.num_ranges() < 42) {
         splitter.split_worst();
     }
@@ -141,6 +152,21 @@ ZCurve::find_ranges(int min_x, int min_y,
     return ranges;
 }
 
+ZCurve::RangeVector
+ZCurve::find_ranges(int min_x, int min_y,
+                    int max_x, int max_y,
+                    const AreaFilter &outside)
+{
+    int64_t total_size = ((max_x - min_x + 1L) * (max_y - min_y + 1L));
+    ZAreaSplitter splitter(min_x, min_y, max_x, max_y, &outside);
+    while (splitter.total_estimate() > total_size && splitter.num_ranges() < 42) {
+        splitter.split_worst();
+    }
+    RangeVector ranges = splitter.extract_ranges();
+    std::sort(ranges.begin(), ranges.end());
+    return ranges;
+}
+
 int64_t
 ZCurve::encodeSlow(int32_t x, int32_t y)
 {
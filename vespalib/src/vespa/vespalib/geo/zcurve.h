@@ -4,6 +4,7 @@
 
 #include <cstdint>
 #include <cassert>
+#include <functional>
 #include <vector>
 
 namespace vespalib::geo {
@@ -212,6 +213,23 @@ public:
     static RangeVector find_ranges(int min_x, int min_y,
                                    int max_x, int max_y);
 
+    /**
+     * Tells whether an area is known to be completely outside the
+     * query shape, meaning that it does not need to be covered.
+     **/
+    using AreaFilter = std::function<bool(const Area &area)>;
+
+    /**
+     * Same as above, but areas found to be outside the query shape
+     * are dropped while splitting, giving a tighter covering of
+     * shapes that do not fill their bounding box (like a circle).
+     * Splitting goes on until the ranges cover no more points than
+     * the bounding box itself, or the range limit is reached.
+     **/
+    static RangeVector find_ranges(int min_x, int min_y,
+                                   int max_x, int max_y,
+                                   const AreaFilter &outside);
+
     static int64_t
     encodeSlow(int32_t x, int32_t y);
 
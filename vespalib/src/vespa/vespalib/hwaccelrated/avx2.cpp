@@ -20,6 +20,16 @@ Avx2Accelrator::squaredEuclideanDistance(const double * a, const double * b, siz
     return avx::euclideanDistanceSelectAlignment<double, 32>(a, b, sz);
 }
 
+double
+Avx2Accelrator::squaredEuclideanDistance(const int8_t * a, const int8_t * b, size_t sz) const {
+    return avx::euclideanDistanceWidenedT<int8_t, int32_t, 32>(a, b, sz);
+}
+
+size_t
+Avx2Accelrator::binaryHammingDistance(const void * a, const void * b, size_t sz) const {
+    return helper::binaryHammingDistance(a, b, sz);
+}
+
 void
 Avx2Accelrator::and64(size_t offset, const std::vector<std::pair<const void *, bool>> &src, void *dest) const {
     helper::andChunks<32u, 2u>(offset, src, dest);
@@ -32,6 +32,16 @@ Avx512Accelrator::squaredEuclideanDistance(const double * a, const double * b, s
     return avx::euclideanDistanceSelectAlignment<double, 64>(a, b, sz);
 }
 
+double
+Avx512Accelrator::squaredEuclideanDistance(const int8_t * a, const int8_t * b, size_t sz) const {
+    return avx::euclideanDistanceWidenedT<int8_t, int32_t, 64>(a, b, sz);
+}
+
+size_t
+Avx512Accelrator::binaryHammingDistance(const void * a, const void * b, size_t sz) const {
+    return helper::binaryHammingDistance(a, b, sz);
+}
+
 void
 Avx512Accelrator::and64(size_t offset, const std::vector<std::pair<const void *, bool>> &src, void *dest) const {
     helper::andChunks<64, 1>(offset, src, dest);
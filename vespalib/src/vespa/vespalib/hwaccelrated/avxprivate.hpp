@@ -4,6 +4,7 @@
 
 #include "private_helpers.hpp"
 #include <vespa/fastos/dynamiclibrary.h>
+#include <algorithm>
 
 namespace vespalib::hwaccelrated::avx {
 
@@ -134,4 +135,45 @@ double euclideanDistanceSelectAlignment(const T * af, const T * bf, size_t sz)
     }
 }
 
+/**
+ * Squared euclidean distance for small integer cells. Cells of type T are
+ * widened to lanes of type W, and the partial sums are flushed to a double
+ * every BlockSize chunks so the lanes can never overflow.
+ **/
+template <typename T, typename W, unsigned VLEN>
+double euclideanDistanceWidenedT(const T * af, const T * bf, size_t sz)
+{
+    constexpr unsigned Lanes = VLEN/sizeof(W);
+    constexpr unsigned VectorsPerChunk = 4;
+    constexpr unsigned ChunkSize = Lanes*VectorsPerChunk;
+    constexpr size_t BlockSize = 4096; // VectorsPerChunk * 255^2 * BlockSize < 2^31
+    typedef T N __attribute__ ((vector_size (Lanes*sizeof(T))));
+    typedef W V __attribute__ ((vector_size (VLEN)));
+    V partial[VectorsPerChunk];
+    double sum(0);
+    const size_t numChunks(sz/ChunkSize);
+    for (size_t block(0); block < numChunks; block += BlockSize) {
+        memset(partial, 0, sizeof(partial));
+        const size_t end = std::min(numChunks, block + BlockSize);
+        for (size_t i(block); i < end; i++) {
+            for (size_t j(0); j < VectorsPerChunk; j++) {
+                N na, nb;
+                memcpy(&na, af + (VectorsPerChunk*i + j)*Lanes, sizeof(N));
+                memcpy(&nb, bf + (VectorsPerChunk*i + j)*Lanes, sizeof(N));
+                V d = __builtin_convertvector(na, V) - __builtin_convertvector(nb, V);
+                partial[j] += d * d;
+            }
+        }
+        partial[0] = sumR<V, VectorsPerChunk>(partial);
+        for (size_t j(0); j < Lanes; j++) {
+            sum += partial[0][j];
+        }
+    }
+    for (size_t i(numChunks*ChunkSize); i < sz; i++) {
+        W d = W(af[i]) - W(bf[i]);
+        sum += d * d;
+    }
+    return sum;
+}
+
 }
@@ -56,6 +56,32 @@ euclideanDistanceT(const T * a, const T * b, size_t sz)
     return sum;
 }
 
+template <size_t UNROLL>
+double
+euclideanDistanceInt8(const int8_t * a, const int8_t * b, size_t sz)
+{
+    int64_t partial[UNROLL];
+    for (size_t i(0); i < UNROLL; i++) {
+        partial[i] = 0;
+    }
+    size_t i(0);
+    for (; i + UNROLL <= sz; i += UNROLL) {
+        for (size_t j(0); j < UNROLL; j++) {
+            int32_t d = int32_t(a[i+j]) - int32_t(b[i+j]);
+            partial[j] += d * d;
+        }
+    }
+    for (;i < sz; i++) {
+        int32_t d = int32_t(a[i]) - int32_t(b[i]);
+        partial[i%UNROLL] += d * d;
+    }
+    int64_t sum(0);
+    for (size_t j(0); j < UNROLL; j++) {
+        sum += partial[j];
+    }
+    return sum;
+}
+
 template<size_t UNROLL, typename Operation>
 void
 bitOperation(Operation operation, void * aOrg, const void * bOrg, size_t bytes) {
@@ -165,6 +191,16 @@ GenericAccelrator::squaredEuclideanDistance(const double * a, const double * b,
     return euclideanDistanceT<double, 4>(a, b, sz);
 }
 
+double
+GenericAccelrator::squaredEuclideanDistance(const int8_t * a, const int8_t * b, size_t sz) const {
+    return euclideanDistanceInt8<8>(a, b, sz);
+}
+
+size_t
+GenericAccelrator::binaryHammingDistance(const void * a, const void * b, size_t sz) const {
+    return helper::binaryHammingDistance(a, b, sz);
+}
+
 void
 GenericAccelrator::and64(size_t offset, const std::vector<std::pair<const void *, bool>> &src, void *dest) const {
     helper::andChunks<16, 4>(offset, src, dest);
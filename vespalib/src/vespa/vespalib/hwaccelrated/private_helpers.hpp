@@ -24,6 +24,33 @@ populationCount(const uint64_t *a, size_t sz) {
     return count;
 }
 
+inline size_t
+binaryHammingDistance(const void * lhs, const void * rhs, size_t sz) {
+    auto a = static_cast<const uint8_t *>(lhs);
+    auto b = static_cast<const uint8_t *>(rhs);
+    size_t count(0);
+    size_t i(0);
+    for (; (i + 4*sizeof(uint64_t)) <= sz; i += 4*sizeof(uint64_t)) {
+        uint64_t x[4], y[4];
+        memcpy(x, a + i, sizeof(x));
+        memcpy(y, b + i, sizeof(y));
+        count += Optimized::popCount(x[0] ^ y[0]) +
+                 Optimized::popCount(x[1] ^ y[1]) +
+                 Optimized::popCount(x[2] ^ y[2]) +
+                 Optimized::popCount(x[3] ^ y[3]);
+    }
+    for (; (i + sizeof(uint64_t)) <= sz; i += sizeof(uint64_t)) {
+        uint64_t x, y;
+        memcpy(&x, a + i, sizeof(x));
+        memcpy(&y, b + i, sizeof(y));
+        count += Optimized::popCount(x ^ y);
+    }
+    for (; i < sz; i++) {
+        count += Optimized::popCount(uint64_t(a[i] ^ b[i]));
+    }
+    return count;
+}
+
 template<typename T>
 T get(const void * base, bool invert) {
     T v;
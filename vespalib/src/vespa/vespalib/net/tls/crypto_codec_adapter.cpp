@@ -141,7 +141,7 @@ CryptoCodecAdapter::drain(char *buf, size_t len)
 ssize_t
 CryptoCodecAdapter::write(const char *buf, size_t len)
 {
-    if (_output.obtain().size >= _codec->min_encode_buffer_size()) {
+    if ((_output.obtain().size + _codec->min_encode_buffer_size()) > output_batch_size) {
         if (flush() < 0) {
             return -1;
         }
@@ -16,6 +16,10 @@ namespace vespalib::net::tls {
 class CryptoCodecAdapter : public TlsCryptoSocket
 {
 private:
+    // Encoded output is gathered until the next record might not fit
+    // within this size, to send several records with each socket write.
+    static constexpr size_t output_batch_size = 64 * 1024;
+
     SmartBuffer                  _input;
     SmartBuffer                  _output;
     SocketHandle                 _socket;
@@ -32,7 +36,7 @@ private:
     ssize_t flush_all();  // -1/0 -> error/ok
 public:
     CryptoCodecAdapter(SocketHandle socket, std::unique_ptr<CryptoCodec> codec)
-        : _input(64 * 1024), _output(64 * 1024), _socket(std::move(socket)), _codec(std::move(codec)),
+        : _input(64 * 1024), _output(output_batch_size), _socket(std::move(socket)), _codec(std::move(codec)),
           _got_tls_close(false), _encoded_tls_close(false) {}
     void inject_read_data(const char *buf, size_t len) override;
     int get_fd() const override { return _socket.get(); }
@@ -16,7 +16,8 @@ namespace vespalib::net::tls {
 const char* iana_cipher_suite_to_openssl(vespalib::stringref iana_name);
 
 /**
- * Returns a vector of all IANA cipher suite names that we support internally.
+ * Returns a vector of all IANA cipher suite names that we support internally,
+ * in order of preference (most preferred first).
  * It is guaranteed that any cipher suite name returned from this function will
  * have a non-nullptr return value from iana_cipher_suite_to_openssl(name).
  */
@@ -215,6 +215,7 @@ OpenSslTlsContextImpl::OpenSslTlsContextImpl(
     disable_session_resumption();
     enforce_peer_certificate_verification();
     set_ssl_ctx_self_reference();
+    prefer_fastest_cipher_suites();
     if (!ts_opts.accepted_ciphers().empty()) {
         // Due to how we resolve provided ciphers, this implicitly provides an
         // _intersection_ between our default cipher suite and the configured one.
@@ -330,6 +331,19 @@ void OpenSslTlsContextImpl::disable_session_resumption() {
     SSL_CTX_set_options(_ctx.get(), SSL_OP_NO_TICKET);
 }
 
+void OpenSslTlsContextImpl::prefer_fastest_cipher_suites() {
+    // Use our own order of preference, which puts hardware accelerated
+    // AES-GCM first, also when acting as a server.
+    SSL_CTX_set_options(_ctx.get(), SSL_OP_CIPHER_SERVER_PREFERENCE);
+#if (OPENSSL_VERSION_NUMBER >= 0x10101000L) // v1.1.1 and beyond has TLSv1.3
+    // Same set of TLSv1.3 suites as the OpenSSL default, but with AES-128 first.
+    if (::SSL_CTX_set_ciphersuites(_ctx.get(), "TLS_AES_128_GCM_SHA256:TLS_AES_256_GCM_SHA384:"
+                                               "TLS_CHACHA20_POLY1305_SHA256") != 1) {
+        throw CryptoException("SSL_CTX_set_ciphersuites");
+    }
+#endif
+}
+
 namespace {
 
 // There's no good reason for entries to contain embedded nulls, aside from
@@ -45,6 +45,9 @@ private:
     void disable_session_resumption();
     void enforce_peer_certificate_verification();
     void set_ssl_ctx_self_reference();
+    // Prefer the ciphers that are cheapest to encrypt and decrypt with, regardless
+    // of the order the peer listed them in.
+    void prefer_fastest_cipher_suites();
     void set_accepted_cipher_suites(const std::vector<vespalib::string>& ciphers);
 
     bool verify_trusted_certificate(::X509_STORE_CTX* store_ctx, const SocketAddress& peer_address);
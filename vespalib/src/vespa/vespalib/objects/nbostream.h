@@ -4,6 +4,7 @@
 #include <vector>
 #include <vespa/vespalib/stllike/string.h>
 #include <vespa/vespalib/util/array.h>
+#include <vespa/vespalib/util/bfloat16.h>
 #include <vespa/vespalib/util/buffer.h>
 #include "nbo.h"
 
@@ -50,6 +51,8 @@ public:
     nbostream & operator >> (int16_t & v)  { int16_t n; read2(&n); v = nbo::n2h(n); return *this; }
     nbostream & operator << (uint16_t v)   { uint16_t n(nbo::n2h(v)); write2(&n); return *this; }
     nbostream & operator >> (uint16_t & v) { uint16_t n; read2(&n); v = nbo::n2h(n); return *this; }
+    nbostream & operator << (BFloat16 v)   { return (*this) << v.get_bits(); }
+    nbostream & operator >> (BFloat16 & v) { uint16_t n; (*this) >> n; v = BFloat16::from_bits(n); return *this; }
     nbostream & operator << (int8_t v)     { write1(&v); return *this; }
     nbostream & operator >> (int8_t & v)   { read1(&v); return *this; }
     nbostream & operator << (uint8_t v)    { write1(&v); return *this; }
@@ -119,6 +119,15 @@ HttpConnection::set_state(State state, bool read, bool write)
     _state = state;
 }
 
+bool
+HttpConnection::parse_request()
+{
+    auto data = _input.obtain();
+    auto consumed = _request.handle_data(data.data, data.size);
+    _input.evict(consumed);
+    return !_request.need_more_data();
+}
+
 void
 HttpConnection::do_handshake()
 {
@@ -139,10 +148,7 @@ HttpConnection::do_read_request()
     if (read(*_socket, _input) != ReadRes::OK) {
         return set_state(State::NOTIFY, false, false);
     }
-    auto data = _input.obtain();
-    auto consumed = _request.handle_data(data.data, data.size);
-    _input.evict(consumed);
-    if (!_request.need_more_data()) {
+    if (parse_request()) {
         set_state(State::DISPATCH, false, false);
     }
 }
@@ -150,6 +156,7 @@ HttpConnection::do_read_request()
 void
 HttpConnection::do_dispatch()
 {
+    _keep_alive = (_request.valid() && _request.keep_alive());
     set_state(State::WAIT, false, false);
     return _handler(this); // callback is final touch
 }
@@ -169,7 +176,23 @@ HttpConnection::do_write_reply()
         return set_state(State::NOTIFY, false, false);
     }
     if (_output.obtain().size == 0) {
-        set_state(State::CLOSE, false, true);
+        if (_keep_alive) {
+            do_next_request();
+        } else {
+            set_state(State::CLOSE, false, true);
+        }
+    }
+}
+
+void
+HttpConnection::do_next_request()
+{
+    _request = HttpRequest();
+    _reply_ready = false;
+    if (parse_request()) {
+        set_state(State::DISPATCH, false, false); // pipelined request
+    } else {
+        set_state(State::READ_REQUEST, true, false);
     }
 }
 
@@ -197,6 +220,7 @@ HttpConnection::HttpConnection(HandleGuard guard, Reactor &reactor, CryptoSocket
       _request(),
       _handler(std::move(handler)),
       _reply_ready(false),
+      _keep_alive(false),
       _token()
 {
     _token = reactor.attach(*this, _socket->get_fd(), true, true);
@@ -225,6 +249,9 @@ HttpConnection::handle_event(bool, bool)
     if (_state == State::WRITE_REPLY) { 
         do_write_reply();
     }
+    if (_state == State::DISPATCH) {
+        return do_dispatch(); // callback is final touch
+    }
     if (_state == State::CLOSE) {
         do_close();
     }
@@ -240,7 +267,7 @@ HttpConnection::respond_with_content(const vespalib::string &content_type,
     {
         OutputWriter dst(_output, CHUNK_SIZE);
         dst.printf("HTTP/1.1 200 OK\r\n");
-        dst.printf("Connection: close\r\n");
+        dst.printf("Connection: %s\r\n", _keep_alive ? "keep-alive" : "close");
         dst.printf("Content-Type: %s\r\n", content_type.c_str());
         dst.printf("Content-Length: %zu\r\n", content.size());
         emit_http_security_headers(dst);
@@ -254,6 +281,7 @@ HttpConnection::respond_with_content(const vespalib::string &content_type,
 void
 HttpConnection::respond_with_error(int code, const vespalib::string &msg)
 {
+    _keep_alive = false;
     {
         OutputWriter dst(_output, CHUNK_SIZE);
         dst.printf("HTTP/1.1 %d %s\r\n", code, msg.c_str());
@@ -27,15 +27,18 @@ private:
     HttpRequest        _request;
     handler_fun_t      _handler;
     std::atomic<bool>  _reply_ready;
+    bool               _keep_alive;
     Reactor::Token::UP _token;
 
     void set_state(State state, bool read, bool write);
+    bool parse_request();
 
     void do_handshake();
     void do_read_request();
     void do_dispatch();
     void do_wait();
     void do_write_reply();
+    void do_next_request();
     void do_close();
     void do_notify();
 
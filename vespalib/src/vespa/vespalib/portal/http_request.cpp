@@ -75,6 +75,20 @@ vespalib::string dequote(vespalib::stringref src) {
     return dst;
 }
 
+vespalib::string trim_lower(vespalib::stringref src) {
+    size_t pos = 0;
+    size_t end = src.size();
+    while ((pos < end) && (isspace(src[pos]))) {
+        ++pos;
+    }
+    while ((pos < end) && (isspace(src[end - 1]))) {
+        --end;
+    }
+    vespalib::string dst(src.substr(pos, end - pos));
+    std::transform(dst.begin(), dst.end(), dst.begin(), ::tolower);
+    return dst;
+}
+
 } // namespace vespalib::portal::<unnamed>
 
 void
@@ -213,6 +227,19 @@ HttpRequest::resolve_host(const vespalib::string &my_host)
     }
 }
 
+bool
+HttpRequest::keep_alive() const
+{
+    // persistent connections are only used when explicitly requested
+    // by the client, since older clients read replies until EOF
+    for (const auto &token: split(get_header("connection"), ',')) {
+        if (trim_lower(token) == "keep-alive") {
+            return true;
+        }
+    }
+    return false;
+}
+
 const vespalib::string &
 HttpRequest::get_header(const vespalib::string &name) const
 {
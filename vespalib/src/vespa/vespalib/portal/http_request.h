@@ -41,6 +41,7 @@ public:
     bool need_more_data() const { return (!_error && !_done); }
     bool valid() const { return (!_error && _done); }
     bool is_get() const { return _method == "GET"; }
+    bool keep_alive() const;
     void resolve_host(const vespalib::string &my_host);
     const vespalib::string &get_header(const vespalib::string &name) const;
     const vespalib::string &get_host() const { return _host; }
@@ -0,0 +1,23 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "flat_hash_map.hpp"
+
+namespace vespalib {
+
+size_t
+flat_hash_table_base::capacity_for(size_t size)
+{
+    size_t capacity = GROUP_WIDTH;
+    while (capacity_to_growth(capacity) < size) {
+        capacity *= 2;
+    }
+    return capacity;
+}
+
+}
+
+VESPALIB_FLAT_HASH_MAP_INSTANTIATE(vespalib::string, vespalib::string);
+VESPALIB_FLAT_HASH_MAP_INSTANTIATE(vespalib::string, uint32_t);
+VESPALIB_FLAT_HASH_MAP_INSTANTIATE(uint32_t, uint32_t);
+VESPALIB_FLAT_HASH_MAP_INSTANTIATE(uint64_t, uint32_t);
+VESPALIB_FLAT_HASH_MAP_INSTANTIATE(uint64_t, uint64_t);
@@ -0,0 +1,237 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#pragma once
+
+#include "hash_fun.h"
+#include <vespa/vespalib/util/alloc.h>
+#include <cstring>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+namespace vespalib {
+
+/**
+   Open addressing hash table storing the elements inline in a flat
+   array, next to an array of one byte control entries per slot.
+
+   The control byte of a slot is either EMPTY, DELETED or the 7 low
+   bits of the hash of the element stored in the slot. Lookups scan
+   groups of 16 control bytes at a time with vector compares, and only
+   compare keys for slots with matching hash bits. Groups are probed
+   in a triangular sequence, and a lookup stops at the first group
+   containing an EMPTY slot.
+
+   Compared to hashtable, there are no per element next indexes and no
+   separate bucket array, and a successful lookup normally touches one
+   cache line of control bytes and one cache line of elements.
+
+   Like hashtable, insert might invalidate iterators. Erase does not.
+**/
+class flat_hash_table_base
+{
+public:
+    using ctrl_t = int8_t;
+    static constexpr ctrl_t EMPTY = -128;
+    static constexpr ctrl_t DELETED = -2;
+    static constexpr size_t GROUP_WIDTH = 16;
+
+    /**
+     * A group of control bytes starting at any slot. The match
+     * functions return a bitmask with one bit per slot in the group.
+     **/
+    class Group {
+        typedef ctrl_t V __attribute__((vector_size(GROUP_WIDTH)));
+        V _ctrl;
+        static uint32_t to_mask(V v) {
+#ifdef __SSE2__
+            return _mm_movemask_epi8(reinterpret_cast<__m128i>(v));
+#else
+            uint32_t mask = 0;
+            for (size_t i = 0; i < GROUP_WIDTH; ++i) {
+                mask |= uint32_t(v[i] & 1) << i;
+            }
+            return mask;
+#endif
+        }
+    public:
+        explicit Group(const ctrl_t *pos) { memcpy(&_ctrl, pos, sizeof(_ctrl)); }
+        uint32_t match(ctrl_t h2) const { return to_mask(_ctrl == h2); }
+        uint32_t match_empty() const { return to_mask(_ctrl == EMPTY); }
+        uint32_t match_empty_or_deleted() const { return to_mask(_ctrl < ctrl_t(-1)); }
+    };
+
+    static bool is_full(ctrl_t ctrl) { return ctrl >= 0; }
+    /**
+     * Many hash functions in vespalib are the identity function, so the
+     * hash is mixed before splitting it into probe start and control byte.
+     **/
+    static size_t mix(size_t hash) {
+        __uint128_t m = __uint128_t(hash) * 0x9e3779b97f4a7c15ul;
+        return size_t(m) ^ size_t(m >> 64);
+    }
+    static size_t h1(size_t mixed) { return mixed >> 7; }
+    static ctrl_t h2(size_t mixed) { return mixed & 0x7f; }
+    /// Number of elements that can be stored before the table must grow.
+    static size_t capacity_to_growth(size_t capacity) { return capacity - capacity / 8; }
+    /// Smallest capacity (power of 2) that can hold the given number of elements.
+    static size_t capacity_for(size_t size);
+};
+
+template< typename K, typename V, typename H = vespalib::hash<K>, typename EQ = std::equal_to<> >
+class flat_hash_map : public flat_hash_table_base
+{
+public:
+    typedef std::pair<K, V> value_type;
+    typedef K key_type;
+    typedef V mapped_type;
+
+    template <typename Value>
+    class iterator_base {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = std::remove_const_t<Value>;
+        using difference_type = ptrdiff_t;
+        using pointer = Value *;
+        using reference = Value &;
+        iterator_base() : _ctrl(nullptr), _end(nullptr), _slot(nullptr) { }
+        iterator_base(const ctrl_t *ctrl, const ctrl_t *end, Value *slot)
+            : _ctrl(ctrl), _end(end), _slot(slot)
+        {
+            skip_free();
+        }
+        template <typename OtherValue, typename = std::enable_if_t<std::is_const_v<Value> && !std::is_const_v<OtherValue>>>
+        iterator_base(const iterator_base<OtherValue> &rhs)
+            : _ctrl(rhs._ctrl), _end(rhs._end), _slot(rhs._slot)
+        { }
+        Value & operator * () const { return *_slot; }
+        Value * operator -> () const { return _slot; }
+        iterator_base & operator ++ () {
+            ++_ctrl;
+            ++_slot;
+            skip_free();
+            return *this;
+        }
+        iterator_base operator ++ (int) {
+            iterator_base prev = *this;
+            ++(*this);
+            return prev;
+        }
+        bool operator == (const iterator_base &rhs) const { return _slot == rhs._slot; }
+        bool operator != (const iterator_base &rhs) const { return _slot != rhs._slot; }
+    private:
+        template <typename> friend class iterator_base;
+        friend class flat_hash_map;
+        void skip_free() {
+            while ((_ctrl != _end) && !is_full(*_ctrl)) {
+                ++_ctrl;
+                ++_slot;
+            }
+        }
+        const ctrl_t *_ctrl;
+        const ctrl_t *_end;
+        Value        *_slot;
+    };
+    using iterator = iterator_base<value_type>;
+    using const_iterator = iterator_base<const value_type>;
+    using insert_result = std::pair<iterator, bool>;
+
+    flat_hash_map(flat_hash_map &&rhs) noexcept;
+    flat_hash_map & operator = (flat_hash_map &&rhs) noexcept;
+    flat_hash_map(const flat_hash_map &rhs);
+    flat_hash_map & operator = (const flat_hash_map &rhs);
+    flat_hash_map(size_t reserveSize=0);
+    flat_hash_map(size_t reserveSize, H hasher, EQ equality);
+    flat_hash_map(std::initializer_list<value_type> input);
+    ~flat_hash_map();
+    iterator begin()                         { return iterator(_ctrl, _ctrl + _capacity, _slots); }
+    iterator end()                           { return iterator(_ctrl + _capacity, _ctrl + _capacity, _slots + _capacity); }
+    const_iterator begin()             const { return const_iterator(_ctrl, _ctrl + _capacity, _slots); }
+    const_iterator end()               const { return const_iterator(_ctrl + _capacity, _ctrl + _capacity, _slots + _capacity); }
+    size_t capacity()                  const { return _capacity; }
+    size_t size()                      const { return _size; }
+    bool empty()                       const { return _size == 0; }
+    insert_result insert(const value_type & value);
+    insert_result insert(value_type &&value);
+    template <typename InputIt>
+    void insert(InputIt first, InputIt last);
+
+    /// This gives faster iteration than can be achieved by the iterators.
+    template <typename Func>
+    void for_each(Func func) const {
+        for (size_t i = 0; i < _capacity; ++i) {
+            if (is_full(_ctrl[i])) {
+                func(_slots[i]);
+            }
+        }
+    }
+    const V & operator [] (const K & key) const { return find(key)->second; }
+    V & operator [] (const K & key);
+    void erase(const K & key);
+    void erase(iterator it)                     { erase_at(it._slot - _slots); }
+    void erase(const_iterator it)               { erase_at(it._slot - _slots); }
+    iterator find(const K & key);
+    const_iterator find(const K & key) const;
+
+    template< typename AltKey >
+    const_iterator find(const AltKey & key) const { return make_iterator(find_index(key)); }
+    template< typename AltKey>
+    iterator find(const AltKey & key)           { return make_iterator(find_index(key)); }
+
+    void clear();
+    void resize(size_t newSize);
+    void swap(flat_hash_map & rhs);
+    bool operator == (const flat_hash_map & rhs) const;
+    size_t getMemoryConsumption() const;
+    size_t getMemoryUsed() const;
+private:
+    static constexpr size_t npos = -1;
+    static size_t ctrl_bytes(size_t capacity) {
+        size_t bytes = capacity + GROUP_WIDTH;
+        return (bytes + alignof(value_type) - 1) & ~(alignof(value_type) - 1);
+    }
+    iterator make_iterator(size_t idx) {
+        return (idx != npos) ? iterator(_ctrl + idx, _ctrl + _capacity, _slots + idx) : end();
+    }
+    const_iterator make_iterator(size_t idx) const {
+        return (idx != npos) ? const_iterator(_ctrl + idx, _ctrl + _capacity, _slots + idx) : end();
+    }
+    void set_ctrl(size_t idx, ctrl_t ctrl) {
+        _ctrl[idx] = ctrl;
+        if (idx < GROUP_WIDTH) {
+            // mirrored after the last slot to let groups wrap around
+            _ctrl[_capacity + idx] = ctrl;
+        }
+    }
+    template <typename AltKey>
+    size_t find_index(const AltKey & key) const;
+    size_t find_first_free(size_t hash) const;
+    size_t prepare_insert(size_t hash);
+    template <typename Value>
+    insert_result insert_internal(const K & key, Value && value);
+    void erase_at(size_t idx);
+    void rehash(size_t newCapacity);
+    void allocate(size_t capacity);
+    void destroy_all();
+
+    alloc::Alloc _buffer;
+    ctrl_t      *_ctrl;
+    value_type  *_slots;
+    size_t       _capacity;
+    size_t       _size;
+    size_t       _growthLeft;
+    H            _hasher;
+    EQ           _equal;
+};
+
+template< typename K, typename V, typename H, typename EQ >
+void swap(flat_hash_map<K, V, H, EQ> & a, flat_hash_map<K, V, H, EQ> & b)
+{
+    a.swap(b);
+}
+
+}
@@ -0,0 +1,381 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#pragma once
+
+#include "flat_hash_map.h"
+#include <cassert>
+#include <new>
+
+namespace vespalib {
+
+template <typename K, typename V, typename H, typename EQ>
+flat_hash_map<K, V, H, EQ>::flat_hash_map(size_t reserveSize, H hasher, EQ equality)
+    : _buffer(),
+      _ctrl(nullptr),
+      _slots(nullptr),
+      _capacity(0),
+      _size(0),
+      _growthLeft(0),
+      _hasher(hasher),
+      _equal(equality)
+{
+    if (reserveSize > 0) {
+        resize(reserveSize);
+    }
+}
+
+template <typename K, typename V, typename H, typename EQ>
+flat_hash_map<K, V, H, EQ>::flat_hash_map(size_t reserveSize)
+    : flat_hash_map(reserveSize, H(), EQ())
+{ }
+
+template <typename K, typename V, typename H, typename EQ>
+flat_hash_map<K, V, H, EQ>::flat_hash_map(std::initializer_list<value_type> input)
+    : flat_hash_map(input.size())
+{
+    insert(input.begin(), input.end());
+}
+
+template <typename K, typename V, typename H, typename EQ>
+flat_hash_map<K, V, H, EQ>::flat_hash_map(flat_hash_map &&rhs) noexcept
+    : _buffer(std::move(rhs._buffer)),
+      _ctrl(rhs._ctrl),
+      _slots(rhs._slots),
+      _capacity(rhs._capacity),
+      _size(rhs._size),
+      _growthLeft(rhs._growthLeft),
+      _hasher(std::move(rhs._hasher)),
+      _equal(std::move(rhs._equal))
+{
+    rhs._ctrl = nullptr;
+    rhs._slots = nullptr;
+    rhs._capacity = 0;
+    rhs._size = 0;
+    rhs._growthLeft = 0;
+}
+
+template <typename K, typename V, typename H, typename EQ>
+flat_hash_map<K, V, H, EQ> &
+flat_hash_map<K, V, H, EQ>::operator = (flat_hash_map &&rhs) noexcept
+{
+    flat_hash_map tmp(std::move(rhs));
+    swap(tmp);
+    return *this;
+}
+
+template <typename K, typename V, typename H, typename EQ>
+flat_hash_map<K, V, H, EQ>::flat_hash_map(const flat_hash_map &rhs)
+    : flat_hash_map(0, rhs._hasher, rhs._equal)
+{
+    if (rhs._capacity > 0) {
+        // Keep the exact layout, no rehashing needed.
+        allocate(rhs._capacity);
+        memcpy(_ctrl, rhs._ctrl, _capacity + GROUP_WIDTH);
+        for (size_t i = 0; i < _capacity; ++i) {
+            if (is_full(_ctrl[i])) {
+                new (_slots + i) value_type(rhs._slots[i]);
+            }
+        }
+        _size = rhs._size;
+        _growthLeft = rhs._growthLeft;
+    }
+}
+
+template <typename K, typename V, typename H, typename EQ>
+flat_hash_map<K, V, H, EQ> &
+flat_hash_map<K, V, H, EQ>::operator = (const flat_hash_map &rhs)
+{
+    flat_hash_map tmp(rhs);
+    swap(tmp);
+    return *this;
+}
+
+template <typename K, typename V, typename H, typename EQ>
+flat_hash_map<K, V, H, EQ>::~flat_hash_map()
+{
+    destroy_all();
+}
+
+template <typename K, typename V, typename H, typename EQ>
+template <typename InputIt>
+void
+flat_hash_map<K, V, H, EQ>::insert(InputIt first, InputIt last)
+{
+    for (; first != last; ++first) {
+        insert(*first);
+    }
+}
+
+template <typename K, typename V, typename H, typename EQ>
+typename flat_hash_map<K, V, H, EQ>::insert_result
+flat_hash_map<K, V, H, EQ>::insert(const value_type & value)
+{
+    return insert_internal(value.first, value);
+}
+
+template <typename K, typename V, typename H, typename EQ>
+typename flat_hash_map<K, V, H, EQ>::insert_result
+flat_hash_map<K, V, H, EQ>::insert(value_type && value)
+{
+    return insert_internal(value.first, std::move(value));
+}
+
+template <typename K, typename V, typename H, typename EQ>
+typename flat_hash_map<K, V, H, EQ>::iterator
+flat_hash_map<K, V, H, EQ>::find(const K & key)
+{
+    return make_iterator(find_index(key));
+}
+
+template <typename K, typename V, typename H, typename EQ>
+typename flat_hash_map<K, V, H, EQ>::const_iterator
+flat_hash_map<K, V, H, EQ>::find(const K & key) const
+{
+    return make_iterator(find_index(key));
+}
+
+template <typename K, typename V, typename H, typename EQ>
+V &
+flat_hash_map<K, V, H, EQ>::operator [] (const K & key)
+{
+    size_t idx = find_index(key);
+    if (idx != npos) {
+        return _slots[idx].second;
+    }
+    return insert_internal(key, value_type(key, V())).first->second;
+}
+
+template <typename K, typename V, typename H, typename EQ>
+void
+flat_hash_map<K, V, H, EQ>::erase(const K & key)
+{
+    size_t idx = find_index(key);
+    if (idx != npos) {
+        erase_at(idx);
+    }
+}
+
+template <typename K, typename V, typename H, typename EQ>
+void
+flat_hash_map<K, V, H, EQ>::clear()
+{
+    if (_capacity > 0) {
+        for (size_t i = 0; i < _capacity; ++i) {
+            if (is_full(_ctrl[i])) {
+                _slots[i].~value_type();
+            }
+        }
+        memset(_ctrl, EMPTY, _capacity + GROUP_WIDTH);
+        _size = 0;
+        _growthLeft = capacity_to_growth(_capacity);
+    }
+}
+
+template <typename K, typename V, typename H, typename EQ>
+void
+flat_hash_map<K, V, H, EQ>::resize(size_t newSize)
+{
+    size_t newCapacity = capacity_for(std::max(newSize, _size));
+    if (newCapacity > _capacity) {
+        rehash(newCapacity);
+    }
+}
+
+template <typename K, typename V, typename H, typename EQ>
+void
+flat_hash_map<K, V, H, EQ>::swap(flat_hash_map & rhs)
+{
+    _buffer.swap(rhs._buffer);
+    std::swap(_ctrl, rhs._ctrl);
+    std::swap(_slots, rhs._slots);
+    std::swap(_capacity, rhs._capacity);
+    std::swap(_size, rhs._size);
+    std::swap(_growthLeft, rhs._growthLeft);
+    std::swap(_hasher, rhs._hasher);
+    std::swap(_equal, rhs._equal);
+}
+
+template <typename K, typename V, typename H, typename EQ>
+bool
+flat_hash_map<K, V, H, EQ>::operator == (const flat_hash_map & rhs) const
+{
+    if (size() != rhs.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < _capacity; ++i) {
+        if (is_full(_ctrl[i])) {
+            auto found = rhs.find(_slots[i].first);
+            if ((found == rhs.end()) || !(found->second == _slots[i].second)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+template <typename K, typename V, typename H, typename EQ>
+size_t
+flat_hash_map<K, V, H, EQ>::getMemoryConsumption() const
+{
+    return sizeof(flat_hash_map) + _buffer.size();
+}
+
+template <typename K, typename V, typename H, typename EQ>
+size_t
+flat_hash_map<K, V, H, EQ>::getMemoryUsed() const
+{
+    return sizeof(flat_hash_map) + ((_capacity > 0) ? ctrl_bytes(_capacity) : 0) + _size * sizeof(value_type);
+}
+
+template <typename K, typename V, typename H, typename EQ>
+template <typename AltKey>
+size_t
+flat_hash_map<K, V, H, EQ>::find_index(const AltKey & key) const
+{
+    if (_size == 0) {
+        return npos;
+    }
+    size_t hash = mix(_hasher(key));
+    ctrl_t tag = h2(hash);
+    size_t mask = _capacity - 1;
+    size_t pos = h1(hash) & mask;
+    for (size_t step = GROUP_WIDTH; ; pos = (pos + step) & mask, step += GROUP_WIDTH) {
+        Group group(_ctrl + pos);
+        for (uint32_t match = group.match(tag); match != 0; match &= match - 1) {
+            size_t idx = (pos + __builtin_ctz(match)) & mask;
+            if (__builtin_expect(_equal(_slots[idx].first, key), true)) {
+                return idx;
+            }
+        }
+        if (__builtin_expect(group.match_empty() != 0, true)) {
+            return npos;
+        }
+    }
+}
+
+template <typename K, typename V, typename H, typename EQ>
+size_t
+flat_hash_map<K, V, H, EQ>::find_first_free(size_t hash) const
+{
+    size_t mask = _capacity - 1;
+    size_t pos = h1(hash) & mask;
+    for (size_t step = GROUP_WIDTH; ; pos = (pos + step) & mask, step += GROUP_WIDTH) {
+        uint32_t match = Group(_ctrl + pos).match_empty_or_deleted();
+        if (match != 0) {
+            return (pos + __builtin_ctz(match)) & mask;
+        }
+    }
+}
+
+template <typename K, typename V, typename H, typename EQ>
+size_t
+flat_hash_map<K, V, H, EQ>::prepare_insert(size_t hash)
+{
+    size_t idx = (_capacity > 0) ? find_first_free(hash) : npos;
+    if ((_growthLeft == 0) && ((idx == npos) || (_ctrl[idx] != DELETED))) {
+        if ((_capacity > 0) && (_size <= capacity_to_growth(_capacity) / 2)) {
+            // Mostly deleted slots, reclaim them without growing.
+            rehash(_capacity);
+        } else {
+            rehash(std::max(GROUP_WIDTH, _capacity * 2));
+        }
+        idx = find_first_free(hash);
+    }
+    return idx;
+}
+
+template <typename K, typename V, typename H, typename EQ>
+template <typename Value>
+typename flat_hash_map<K, V, H, EQ>::insert_result
+flat_hash_map<K, V, H, EQ>::insert_internal(const K & key, Value && value)
+{
+    size_t found = find_index(key);
+    if (found != npos) {
+        return insert_result(make_iterator(found), false);
+    }
+    size_t hash = mix(_hasher(key));
+    size_t idx = prepare_insert(hash);
+    new (_slots + idx) value_type(std::forward<Value>(value));
+    if (_ctrl[idx] == EMPTY) {
+        --_growthLeft;
+    }
+    set_ctrl(idx, h2(hash));
+    ++_size;
+    return insert_result(make_iterator(idx), true);
+}
+
+template <typename K, typename V, typename H, typename EQ>
+void
+flat_hash_map<K, V, H, EQ>::erase_at(size_t idx)
+{
+    _slots[idx].~value_type();
+    --_size;
+    // The slot can be marked empty if no probe sequence can have
+    // passed it, i.e. there is no full group window containing it.
+    size_t mask = _capacity - 1;
+    uint32_t emptyAfter = Group(_ctrl + idx).match_empty();
+    uint32_t emptyBefore = Group(_ctrl + ((idx - GROUP_WIDTH) & mask)).match_empty();
+    bool wasNeverFull = (emptyBefore != 0) && (emptyAfter != 0) &&
+                        ((__builtin_ctz(emptyAfter) + (__builtin_clz(emptyBefore) - (32 - GROUP_WIDTH))) < GROUP_WIDTH);
+    if (wasNeverFull) {
+        set_ctrl(idx, EMPTY);
+        ++_growthLeft;
+    } else {
+        set_ctrl(idx, DELETED);
+    }
+}
+
+template <typename K, typename V, typename H, typename EQ>
+void
+flat_hash_map<K, V, H, EQ>::rehash(size_t newCapacity)
+{
+    assert(capacity_to_growth(newCapacity) >= _size);
+    flat_hash_map tmp(0, _hasher, _equal);
+    tmp.allocate(newCapacity);
+    for (size_t i = 0; i < _capacity; ++i) {
+        if (is_full(_ctrl[i])) {
+            size_t hash = mix(_hasher(_slots[i].first));
+            size_t idx = tmp.find_first_free(hash);
+            new (tmp._slots + idx) value_type(std::move(_slots[i]));
+            tmp.set_ctrl(idx, h2(hash));
+        }
+    }
+    tmp._size = _size;
+    tmp._growthLeft -= _size;
+    swap(tmp);
+}
+
+template <typename K, typename V, typename H, typename EQ>
+void
+flat_hash_map<K, V, H, EQ>::allocate(size_t capacity)
+{
+    assert((capacity >= GROUP_WIDTH) && ((capacity & (capacity - 1)) == 0));
+    _buffer = alloc::Alloc::alloc(ctrl_bytes(capacity) + capacity * sizeof(value_type));
+    _ctrl = static_cast<ctrl_t *>(_buffer.get());
+    _slots = reinterpret_cast<value_type *>(static_cast<char *>(_buffer.get()) + ctrl_bytes(capacity));
+    _capacity = capacity;
+    _size = 0;
+    _growthLeft = capacity_to_growth(capacity);
+    memset(_ctrl, EMPTY, capacity + GROUP_WIDTH);
+}
+
+template <typename K, typename V, typename H, typename EQ>
+void
+flat_hash_map<K, V, H, EQ>::destroy_all()
+{
+    if constexpr (!std::is_trivially_destructible_v<value_type>) {
+        for (size_t i = 0; i < _capacity; ++i) {
+            if (is_full(_ctrl[i])) {
+                _slots[i].~value_type();
+            }
+        }
+    }
+}
+
+}
+
+#define VESPALIB_FLAT_HASH_MAP_INSTANTIATE_H_E(K, V, H, E) \
+    template class vespalib::flat_hash_map<K, V, H, E>;
+
+#define VESPALIB_FLAT_HASH_MAP_INSTANTIATE_H(K, V, H) VESPALIB_FLAT_HASH_MAP_INSTANTIATE_H_E(K, V, H, std::equal_to<>)
+
+#define VESPALIB_FLAT_HASH_MAP_INSTANTIATE(K, V) VESPALIB_FLAT_HASH_MAP_INSTANTIATE_H(K, V, vespalib::hash<K>)
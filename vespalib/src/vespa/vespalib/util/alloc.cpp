@@ -94,7 +94,7 @@ size_t sum(const MMapStore & s)
 
 class MMapLimitAndAlignment {
 public:
-    MMapLimitAndAlignment(size_t mmapLimit, size_t alignment);
+    MMapLimitAndAlignment(size_t mmapLimit, size_t alignment, alloc::HugePagePolicy hugePagePolicy);
     uint32_t hash() const { return _key; }
     bool operator == (MMapLimitAndAlignment rhs) const { return _key == rhs._key; }
 private:
@@ -112,8 +112,8 @@ void verifyMMapLimitAndAlignment(size_t mmapLimit, size_t alignment) {
     }
 }
 
-MMapLimitAndAlignment::MMapLimitAndAlignment(size_t mmapLimit, size_t alignment) :
-    _key(Optimized::msbIdx(mmapLimit) | Optimized::msbIdx(alignment) << 6)
+MMapLimitAndAlignment::MMapLimitAndAlignment(size_t mmapLimit, size_t alignment, alloc::HugePagePolicy hugePagePolicy) :
+    _key(Optimized::msbIdx(mmapLimit) | Optimized::msbIdx(alignment) << 6 | static_cast<uint32_t>(hugePagePolicy) << 12)
 {
     verifyMMapLimitAndAlignment(mmapLimit, alignment);
 }
@@ -145,27 +145,32 @@ private:
 
 class MMapAllocator : public MemoryAllocator {
 public:
+    MMapAllocator(HugePagePolicy hugePagePolicy = HugePagePolicy::DEFAULT) : _hugePagePolicy(hugePagePolicy) { }
     PtrAndSize alloc(size_t sz) const override;
     void free(PtrAndSize alloc) const override;
     size_t resize_inplace(PtrAndSize current, size_t newSize) const override;
-    static size_t sresize_inplace(PtrAndSize current, size_t newSize);
-    static PtrAndSize salloc(size_t sz, void * wantedAddress);
+    static size_t sresize_inplace(PtrAndSize current, size_t newSize, HugePagePolicy hugePagePolicy);
+    static PtrAndSize salloc(size_t sz, void * wantedAddress, HugePagePolicy hugePagePolicy);
     static void sfree(PtrAndSize alloc);
     static MemoryAllocator & getDefault();
+    static MemoryAllocator & getAllocator(HugePagePolicy hugePagePolicy);
 private:
-    static size_t extend_inplace(PtrAndSize current, size_t newSize);
+    static size_t extend_inplace(PtrAndSize current, size_t newSize, HugePagePolicy hugePagePolicy);
     static size_t shrink_inplace(PtrAndSize current, size_t newSize);
+    HugePagePolicy _hugePagePolicy;
 };
 
 class AutoAllocator : public MemoryAllocator {
 public:
-    AutoAllocator(size_t mmapLimit, size_t alignment) : _mmapLimit(mmapLimit), _alignment(alignment) { }
+    AutoAllocator(size_t mmapLimit, size_t alignment, HugePagePolicy hugePagePolicy)
+        : _mmapLimit(mmapLimit), _alignment(alignment), _hugePagePolicy(hugePagePolicy)
+    { }
     PtrAndSize alloc(size_t sz) const override;
     void free(PtrAndSize alloc) const override;
     void free(void * ptr, size_t sz) const override;
     size_t resize_inplace(PtrAndSize current, size_t newSize) const override;
     static MemoryAllocator & getDefault();
-    static MemoryAllocator & getAllocator(size_t mmapLimit, size_t alignment);
+    static MemoryAllocator & getAllocator(size_t mmapLimit, size_t alignment, HugePagePolicy hugePagePolicy);
 private:
     size_t roundUpToHugePages(size_t sz) const {
         return (_mmapLimit >= MemoryAllocator::HUGEPAGE_SIZE)
@@ -180,6 +185,7 @@ private:
     }
     size_t _mmapLimit;
     size_t _alignment;
+    HugePagePolicy _hugePagePolicy;
 };
 
 
@@ -190,20 +196,24 @@ struct MMapLimitAndAlignmentHash {
 using AutoAllocatorsMap = std::unordered_map<MMapLimitAndAlignment, AutoAllocator::UP, MMapLimitAndAlignmentHash>;
 using AutoAllocatorsMapWithDefault = std::pair<AutoAllocatorsMap, alloc::MemoryAllocator *>;
 
+constexpr HugePagePolicy _G_hugePagePolicies[] = { HugePagePolicy::DEFAULT, HugePagePolicy::NONE,
+                                                   HugePagePolicy::HUGETLB, HugePagePolicy::MADVISE };
+
 void createAlignedAutoAllocators(AutoAllocatorsMap & map, size_t mmapLimit) {
     for (size_t alignment : {0,0x200, 0x400, 0x1000}) {
-        MMapLimitAndAlignment key(mmapLimit, alignment);
-        auto result = map.emplace(key, AutoAllocator::UP(new AutoAllocator(mmapLimit, alignment)));
-        (void) result;
-        assert( result.second );
-
+        for (HugePagePolicy hugePagePolicy : _G_hugePagePolicies) {
+            MMapLimitAndAlignment key(mmapLimit, alignment, hugePagePolicy);
+            auto result = map.emplace(key, AutoAllocator::UP(new AutoAllocator(mmapLimit, alignment, hugePagePolicy)));
+            (void) result;
+            assert( result.second );
+        }
     }
 }
 
 AutoAllocatorsMap
 createAutoAllocators() {
     AutoAllocatorsMap map;
-    map.reserve(3*5);
+    map.reserve(5*4*std::size(_G_hugePagePolicies));
     for (size_t pages : {1,2,4,8,16}) {
         size_t mmapLimit = pages * MemoryAllocator::HUGEPAGE_SIZE;
         createAlignedAutoAllocators(map, mmapLimit);
@@ -212,8 +222,8 @@ createAutoAllocators() {
 }
 
 MemoryAllocator &
-getAutoAllocator(AutoAllocatorsMap & map, size_t mmapLimit, size_t alignment) {
-    MMapLimitAndAlignment key(mmapLimit, alignment);
+getAutoAllocator(AutoAllocatorsMap & map, size_t mmapLimit, size_t alignment, HugePagePolicy hugePagePolicy) {
+    MMapLimitAndAlignment key(mmapLimit, alignment, hugePagePolicy);
     auto found = map.find(key);
     if (found == map.end()) {
         throw IllegalArgumentException(make_string("We currently have no support for mmapLimit(%0lx) and alignment(%0lx)", mmapLimit, alignment));
@@ -223,7 +233,7 @@ getAutoAllocator(AutoAllocatorsMap & map, size_t mmapLimit, size_t alignment) {
 
 MemoryAllocator &
 getDefaultAutoAllocator(AutoAllocatorsMap & map) {
-    return getAutoAllocator(map, 1 * MemoryAllocator::HUGEPAGE_SIZE, 0);
+    return getAutoAllocator(map, 1 * MemoryAllocator::HUGEPAGE_SIZE, 0, HugePagePolicy::DEFAULT);
 }
 
 AutoAllocatorsMapWithDefault
@@ -240,6 +250,9 @@ alloc::AlignedHeapAllocator _G_4KalignedHeapAllocator(1024);
 alloc::AlignedHeapAllocator _G_1KalignedHeapAllocator(4096);
 alloc::AlignedHeapAllocator _G_512BalignedHeapAllocator(512);
 alloc::MMapAllocator _G_mmapAllocatorDefault;
+alloc::MMapAllocator _G_mmapAllocatorNoHugePages(HugePagePolicy::NONE);
+alloc::MMapAllocator _G_mmapAllocatorHugeTLB(HugePagePolicy::HUGETLB);
+alloc::MMapAllocator _G_mmapAllocatorMAdviseHugePages(HugePagePolicy::MADVISE);
 
 MemoryAllocator &
 HeapAllocator::getDefault() {
@@ -265,14 +278,24 @@ MMapAllocator::getDefault() {
     return _G_mmapAllocatorDefault;
 }
 
+MemoryAllocator &
+MMapAllocator::getAllocator(HugePagePolicy hugePagePolicy) {
+    switch (hugePagePolicy) {
+    case HugePagePolicy::NONE:    return _G_mmapAllocatorNoHugePages;
+    case HugePagePolicy::HUGETLB: return _G_mmapAllocatorHugeTLB;
+    case HugePagePolicy::MADVISE: return _G_mmapAllocatorMAdviseHugePages;
+    default:                      return _G_mmapAllocatorDefault;
+    }
+}
+
 MemoryAllocator &
 AutoAllocator::getDefault() {
     return *_G_availableAutoAllocators.second;
 }
 
 MemoryAllocator &
-AutoAllocator::getAllocator(size_t mmapLimit, size_t alignment) {
-    return getAutoAllocator(_G_availableAutoAllocators.first, mmapLimit, alignment);
+AutoAllocator::getAllocator(size_t mmapLimit, size_t alignment, HugePagePolicy hugePagePolicy) {
+    return getAutoAllocator(_G_availableAutoAllocators.first, mmapLimit, alignment, hugePagePolicy);
 }
 
 MemoryAllocator::PtrAndSize
@@ -306,16 +329,27 @@ AlignedHeapAllocator::alloc(size_t sz) const {
 
 size_t
 MMapAllocator::resize_inplace(PtrAndSize current, size_t newSize) const {
-    return sresize_inplace(current, newSize);
+    return sresize_inplace(current, newSize, _hugePagePolicy);
 }
 
 MemoryAllocator::PtrAndSize
 MMapAllocator::alloc(size_t sz) const {
-    return salloc(sz, nullptr);
+    return salloc(sz, nullptr, _hugePagePolicy);
+}
+
+int
+hugePageFlags(HugePagePolicy hugePagePolicy) {
+    switch (hugePagePolicy) {
+    case HugePagePolicy::DEFAULT: return _G_HugeFlags;
+#ifdef __linux__
+    case HugePagePolicy::HUGETLB: return MAP_HUGETLB;
+#endif
+    default:                      return 0;
+    }
 }
 
 MemoryAllocator::PtrAndSize
-MMapAllocator::salloc(size_t sz, void * wantedAddress)
+MMapAllocator::salloc(size_t sz, void * wantedAddress, HugePagePolicy hugePagePolicy)
 {
     void * buf(nullptr);
     sz = roundUp2PageSize(sz);
@@ -328,7 +362,8 @@ MMapAllocator::salloc(size_t sz, void * wantedAddress)
             stackTrace = getStackTrace(1);
             LOG(info, "mmap %ld of size %ld from %s", mmapId, sz, stackTrace.c_str());
         }
-        buf = mmap(wantedAddress, sz, prot, flags | _G_HugeFlags, -1, 0);
+        const int hugeFlags(hugePageFlags(hugePagePolicy));
+        buf = mmap(wantedAddress, sz, prot, flags | hugeFlags, -1, 0);
         if (buf == MAP_FAILED) {
             if ( ! _G_hasHugePageFailureJustHappened ) {
                 _G_hasHugePageFailureJustHappened = true;
@@ -354,6 +389,11 @@ MMapAllocator::salloc(size_t sz, void * wantedAddress)
             }
         }
 #ifdef __linux__
+        if (hugePagePolicy == HugePagePolicy::MADVISE) {
+            if (madvise(buf, sz, MADV_HUGEPAGE) != 0) {
+                LOG(debug, "Failed madvise(%p, %ld, MADV_HUGEPAGE) = '%s'", buf, sz, FastOS_FileInterface::getLastErrorString().c_str());
+            }
+        }
         if (sz >= _G_MMapNoCoreLimit) {
             if (madvise(buf, sz, MADV_DONTDUMP) != 0) {
                 LOG(warning, "Failed madvise(%p, %ld, MADV_DONTDUMP) = '%s'", buf, sz, FastOS_FileInterface::getLastErrorString().c_str());
@@ -370,10 +410,10 @@ MMapAllocator::salloc(size_t sz, void * wantedAddress)
 }
 
 size_t
-MMapAllocator::sresize_inplace(PtrAndSize current, size_t newSize) {
+MMapAllocator::sresize_inplace(PtrAndSize current, size_t newSize, HugePagePolicy hugePagePolicy) {
     newSize = roundUp2PageSize(newSize);
     if (newSize > current.second) {
-        return extend_inplace(current, newSize);
+        return extend_inplace(current, newSize, hugePagePolicy);
     } else if (newSize < current.second) {
         return shrink_inplace(current, newSize);
     } else {
@@ -382,8 +422,8 @@ MMapAllocator::sresize_inplace(PtrAndSize current, size_t newSize) {
 }
 
 size_t
-MMapAllocator::extend_inplace(PtrAndSize current, size_t newSize) {
-    PtrAndSize got = MMapAllocator::salloc(newSize - current.second, static_cast<char *>(current.first)+current.second);
+MMapAllocator::extend_inplace(PtrAndSize current, size_t newSize, HugePagePolicy hugePagePolicy) {
+    PtrAndSize got = MMapAllocator::salloc(newSize - current.second, static_cast<char *>(current.first)+current.second, hugePagePolicy);
     if ((static_cast<const char *>(current.first) + current.second) == static_cast<const char *>(got.first)) {
         return current.second + got.second;
     } else {
@@ -425,7 +465,7 @@ size_t
 AutoAllocator::resize_inplace(PtrAndSize current, size_t newSize) const {
     if (useMMap(current.second) && useMMap(newSize)) {
         newSize = roundUpToHugePages(newSize);
-        return MMapAllocator::sresize_inplace(current, newSize);
+        return MMapAllocator::sresize_inplace(current, newSize, _hugePagePolicy);
     } else {
         return 0;
     }
@@ -435,7 +475,7 @@ MMapAllocator::PtrAndSize
 AutoAllocator::alloc(size_t sz) const {
     if (useMMap(sz)) {
         sz = roundUpToHugePages(sz);
-        return MMapAllocator::salloc(sz, nullptr);
+        return MMapAllocator::salloc(sz, nullptr, _hugePagePolicy);
     } else {
         if (_alignment == 0) {
             return HeapAllocator::salloc(sz);
@@ -466,8 +506,13 @@ AutoAllocator::free(void * ptr, size_t sz) const {
 }
 
 const MemoryAllocator *
-MemoryAllocator::select_allocator(size_t mmapLimit, size_t alignment) {
-    return & AutoAllocator::getAllocator(mmapLimit, alignment);
+MemoryAllocator::select_allocator(size_t mmapLimit, size_t alignment, HugePagePolicy hugePagePolicy) {
+    return & AutoAllocator::getAllocator(mmapLimit, alignment, hugePagePolicy);
+}
+
+MemoryAllocator::UP
+MemoryAllocator::make_auto_allocator(HugePagePolicy hugePagePolicy) {
+    return std::make_unique<AutoAllocator>(MemoryAllocator::HUGEPAGE_SIZE, 0, hugePagePolicy);
 }
 
 Alloc
@@ -504,9 +549,9 @@ Alloc::allocAlignedHeap(size_t sz, size_t alignment)
 }
 
 Alloc
-Alloc::allocMMap(size_t sz)
+Alloc::allocMMap(size_t sz, HugePagePolicy hugePagePolicy)
 {
-    return Alloc(&MMapAllocator::getDefault(), sz);
+    return Alloc(&MMapAllocator::getAllocator(hugePagePolicy), sz);
 }
 
 Alloc
@@ -516,9 +561,15 @@ Alloc::alloc()
 }
 
 Alloc
-Alloc::alloc(size_t sz, size_t mmapLimit, size_t alignment)
+Alloc::alloc_with_allocator(const MemoryAllocator* allocator)
+{
+    return Alloc(allocator);
+}
+
+Alloc
+Alloc::alloc(size_t sz, size_t mmapLimit, size_t alignment, HugePagePolicy hugePagePolicy)
 {
-    return Alloc(&AutoAllocator::getAllocator(mmapLimit, alignment), sz);
+    return Alloc(&AutoAllocator::getAllocator(mmapLimit, alignment, hugePagePolicy), sz);
 }
 
 }
@@ -6,6 +6,15 @@
 
 namespace vespalib::alloc {
 
+/**
+ * How memory mapped allocations should be backed by huge pages.
+ * DEFAULT follows the process wide VESPA_USE_HUGEPAGES setting.
+ * HUGETLB uses explicit huge pages (MAP_HUGETLB) when available, falling back to normal pages.
+ * MADVISE uses normal pages marked with MADV_HUGEPAGE, letting transparent huge pages back them.
+ * NONE never uses huge pages.
+ */
+enum class HugePagePolicy { DEFAULT, NONE, HUGETLB, MADVISE };
+
 class MemoryAllocator {
 public:
     enum {HUGEPAGE_SIZE=0x200000u};
@@ -34,7 +43,12 @@ public:
     static size_t roundUpToHugePages(size_t sz) {
         return (sz+(HUGEPAGE_SIZE-1)) & ~(HUGEPAGE_SIZE-1);
     }
-    static const MemoryAllocator * select_allocator(size_t mmapLimit = MemoryAllocator::HUGEPAGE_SIZE, size_t alignment=0);
+    static const MemoryAllocator * select_allocator(size_t mmapLimit = MemoryAllocator::HUGEPAGE_SIZE, size_t alignment=0,
+                                                    HugePagePolicy hugePagePolicy = HugePagePolicy::DEFAULT);
+    /**
+     * Creates an allocator with the default mmap limit that uses the given huge page policy for its mappings.
+     */
+    static UP make_auto_allocator(HugePagePolicy hugePagePolicy);
 };
 
 /**
@@ -98,13 +112,19 @@ public:
 
     static Alloc allocAlignedHeap(size_t sz, size_t alignment);
     static Alloc allocHeap(size_t sz=0);
-    static Alloc allocMMap(size_t sz=0);
+    static Alloc allocMMap(size_t sz=0, HugePagePolicy hugePagePolicy = HugePagePolicy::DEFAULT);
     /**
      * Optional alignment is assumed to be <= system page size, since mmap
      * is always used when size is above limit.
      */
-    static Alloc alloc(size_t sz, size_t mmapLimit = MemoryAllocator::HUGEPAGE_SIZE, size_t alignment=0);
+    static Alloc alloc(size_t sz, size_t mmapLimit = MemoryAllocator::HUGEPAGE_SIZE, size_t alignment=0,
+                       HugePagePolicy hugePagePolicy = HugePagePolicy::DEFAULT);
     static Alloc alloc();
+    /**
+     * Creates an empty allocation using the given allocator, which must outlive it
+     * and all allocations created from it.
+     */
+    static Alloc alloc_with_allocator(const MemoryAllocator* allocator);
 private:
     Alloc(const MemoryAllocator * allocator, size_t sz) : _alloc(allocator->alloc(sz)), _allocator(allocator) { }
     Alloc(const MemoryAllocator * allocator) : _alloc(nullptr, 0), _allocator(allocator) { }
@@ -141,6 +141,8 @@ public:
     bool operator == (const Array & rhs) const;
     bool operator != (const Array & rhs) const;
 
+    // The allocation backing this array, used to make new arrays with the same allocator
+    const Alloc & get_alloc() const { return _array; }
     static Alloc stealAlloc(Array && rhs) {
         rhs._sz = 0;
         return std::move(rhs._array);
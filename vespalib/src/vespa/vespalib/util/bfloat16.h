@@ -0,0 +1,50 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+
+namespace vespalib {
+
+/**
+ * Brain floating point; the upper 16 bits of an IEEE 754 single
+ * precision float. It has the same range as float, but only 8 bits
+ * of precision. Used as a compact storage format for tensor cells;
+ * all computation is done after converting to float. Conversion from
+ * float rounds to nearest even and keeps NaN values as NaN.
+ **/
+class BFloat16 {
+private:
+    uint16_t _bits;
+
+    static uint32_t float_to_bits(float value) {
+        uint32_t bits;
+        memcpy(&bits, &value, sizeof(bits));
+        return bits;
+    }
+    static float bits_to_float(uint32_t bits) {
+        float value;
+        memcpy(&value, &bits, sizeof(value));
+        return value;
+    }
+    static uint16_t round_to_bfloat16(uint32_t bits) {
+        if ((bits & 0x7fffffff) > 0x7f800000) {
+            return ((bits >> 16) | 0x0040); // quiet NaN
+        }
+        uint32_t rounding_bias = 0x7fff + ((bits >> 16) & 1);
+        return ((bits + rounding_bias) >> 16);
+    }
+    struct FromBits {};
+    constexpr BFloat16(uint16_t bits, FromBits) noexcept : _bits(bits) {}
+public:
+    constexpr BFloat16() noexcept : _bits(0) {}
+    BFloat16(float value) noexcept : _bits(round_to_bfloat16(float_to_bits(value))) {}
+    operator float() const noexcept { return bits_to_float(uint32_t(_bits) << 16); }
+    uint16_t get_bits() const noexcept { return _bits; }
+    static constexpr BFloat16 from_bits(uint16_t bits) noexcept { return BFloat16(bits, FromBits()); }
+};
+
+static_assert(sizeof(BFloat16) == sizeof(uint16_t));
+
+}
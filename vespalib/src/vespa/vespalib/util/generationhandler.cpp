@@ -4,14 +4,35 @@
 
 namespace vespalib {
 
+namespace {
+
+std::atomic<uint32_t> nextShard(0u);
+
+/*
+ * Reader threads are spread over the shards in the order they first
+ * take a guard.
+ */
+uint32_t
+threadShard()
+{
+    thread_local uint32_t shard = nextShard.fetch_add(1u, std::memory_order_relaxed) %
+                                  GenerationHandler::GenerationHold::NUM_SHARDS;
+    return shard;
+}
+
+}
+
 GenerationHandler::Guard::Guard()
-    : _hold(nullptr)
+    : _hold(nullptr),
+      _shard(0u)
 {
 }
 
 GenerationHandler::Guard::Guard(GenerationHold *hold)
-    : _hold(hold->acquire())
+    : _hold(nullptr),
+      _shard(threadShard())
 {
+    _hold = hold->acquire(_shard);
 }
 
 GenerationHandler::Guard::~Guard()
@@ -20,12 +41,14 @@ GenerationHandler::Guard::~Guard()
 }
 
 GenerationHandler::Guard::Guard(const Guard & rhs)
-    : _hold(GenerationHold::copy(rhs._hold))
+    : _hold(GenerationHold::copy(rhs._hold, rhs._shard)),
+      _shard(rhs._shard)
 {
 }
 
 GenerationHandler::Guard::Guard(Guard &&rhs)
-    : _hold(rhs._hold)
+    : _hold(rhs._hold),
+      _shard(rhs._shard)
 {
     rhs._hold = nullptr;
 }
@@ -35,7 +58,8 @@ GenerationHandler::Guard::operator=(const Guard & rhs)
 {
     if (&rhs != this) {
         cleanup();
-        _hold = GenerationHold::copy(rhs._hold);
+        _hold = GenerationHold::copy(rhs._hold, rhs._shard);
+        _shard = rhs._shard;
     }
     return *this;
 }
@@ -46,6 +70,7 @@ GenerationHandler::Guard::operator=(Guard &&rhs)
     if (&rhs != this) {
         cleanup();
         _hold = rhs._hold;
+        _shard = rhs._shard;
         rhs._hold = nullptr;
     }
     return *this;
@@ -23,11 +23,24 @@ public:
      * This must be type stable memory, and cannot be freed before the
      * GenerationHandler is freed (i.e. when external methods ensure that
      * no readers are still active).
+     *
+     * The reader count is split into shards on separate cache lines,
+     * and each reader thread uses its own shard, to avoid all reader
+     * threads bouncing the same cache line when taking guards. Each
+     * shard has its own invalid flag, and the hold is only invalid when
+     * the writer has managed to set the flag in all shards.
      */
     class GenerationHold
     {
-        // least significant bit is invalid flag
-        std::atomic<uint32_t> _refCount;
+    public:
+        static constexpr uint32_t NUM_SHARDS = 16;
+    private:
+        struct alignas(64) Shard {
+            // least significant bit is invalid flag
+            std::atomic<uint32_t> _refCount;
+            Shard() : _refCount(1) { }
+        };
+        Shard _shards[NUM_SHARDS];
 
         static bool valid(uint32_t refCount) { return (refCount & 1) == 0u; }
     public:
@@ -35,7 +48,7 @@ public:
         GenerationHold *_next;	// next free element or next newer element.
 
         GenerationHold(void)
-            : _refCount(1),
+            : _shards(),
               _generation(0),
               _next(0)
         { }
@@ -46,38 +59,52 @@ public:
         }
 
         void setValid() {
-            assert(!valid(_refCount));
-            _refCount.fetch_sub(1);
+            for (auto &shard : _shards) {
+                assert(!valid(shard._refCount));
+                shard._refCount.fetch_sub(1);
+            }
         }
         bool setInvalid() {
-            uint32_t refs = _refCount;
-            assert(valid(refs));
-            if (refs != 0) {
-                return false;
+            for (uint32_t i = 0; i < NUM_SHARDS; ++i) {
+                uint32_t refs = _shards[i]._refCount;
+                assert(valid(refs));
+                if (refs != 0 ||
+                    !_shards[i]._refCount.compare_exchange_strong(refs, 1, std::memory_order_seq_cst)) {
+                    // Still in use, readers that saw the invalid flag will retry on a newer hold.
+                    while (i > 0) {
+                        _shards[--i]._refCount.fetch_sub(1);
+                    }
+                    return false;
+                }
             }
-            return _refCount.compare_exchange_strong(refs, 1,
-                                                     std::memory_order_seq_cst);
+            return true;
         }
-        void release() { _refCount.fetch_sub(2); }
-        GenerationHold *acquire() {
-            if (valid(_refCount.fetch_add(2))) {
+        void release(uint32_t shard) { _shards[shard]._refCount.fetch_sub(2); }
+        GenerationHold *acquire(uint32_t shard) {
+            if (valid(_shards[shard]._refCount.fetch_add(2))) {
                 return this;
             } else {
-                release();
+                release(shard);
                 return nullptr;
             }
         }
-        static GenerationHold *copy(GenerationHold *self) {
+        static GenerationHold *copy(GenerationHold *self, uint32_t shard) {
             if (self == nullptr) {
                 return nullptr;
             } else {
-                uint32_t oldRefCount = self->_refCount.fetch_add(2);
+                uint32_t oldRefCount = self->_shards[shard]._refCount.fetch_add(2);
                 (void) oldRefCount;
                 assert(valid(oldRefCount));
                 return self;
             }
         }
-        uint32_t getRefCount() const { return _refCount / 2; }
+        uint32_t getRefCount() const {
+            uint32_t refCount = 0;
+            for (const auto &shard : _shards) {
+                refCount += shard._refCount / 2;
+            }
+            return refCount;
+        }
     };
 
     /**
@@ -86,9 +113,10 @@ public:
     class Guard {
     private:
         GenerationHold *_hold;
+        uint32_t        _shard;
         void cleanup() {
             if (_hold != nullptr) {
-                _hold->release();
+                _hold->release(_shard);
                 _hold = nullptr;
             }
         }
@@ -0,0 +1,301 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "lockfree_executor.h"
+#include <vespa/fastos/thread.h>
+#include <algorithm>
+#include <cassert>
+#include <thread>
+
+namespace vespalib {
+
+namespace {
+
+int unnamed_lockfree_executor(Runnable &worker) {
+    worker.run();
+    return 1;
+}
+
+struct ThreadInit : public FastOS_Runnable {
+    Runnable &worker;
+    LockFreeExecutor::init_fun_t init_fun;
+
+    ThreadInit(Runnable &worker_in, LockFreeExecutor::init_fun_t init_fun_in)
+        : worker(worker_in), init_fun(std::move(init_fun_in)) {}
+
+    void Run(FastOS_ThreadInterface *, void *) override { init_fun(worker); }
+};
+
+}
+
+bool
+LockFreeExecutor::try_obtain_task(Worker &worker, Task::UP &task)
+{
+    // Publish a lower bound of the position we might pop before
+    // popping, so that sync() never misses a task in flight.
+    worker.position.store(_queue.pop_count());
+    if (_queue.try_pop(task)) {
+        return true;
+    }
+    worker.position.store(IDLE);
+    return false;
+}
+
+bool
+LockFreeExecutor::obtain_task(Worker &worker, Task::UP &task)
+{
+    for (;;) {
+        for (uint32_t i = 0; i < SPIN_ROUNDS; ++i) {
+            if (try_obtain_task(worker, task)) {
+                return true;
+            }
+            if (is_done()) {
+                return false;
+            }
+            std::this_thread::yield();
+        }
+        std::unique_lock<std::mutex> guard(_lock);
+        _sleepers.fetch_add(1);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        bool found = try_obtain_task(worker, task);
+        if (!found && !is_done()) {
+            _workerCond.wait(guard);
+        }
+        _sleepers.fetch_sub(1);
+        if (found) {
+            return true;
+        }
+    }
+}
+
+void
+LockFreeExecutor::complete_task()
+{
+    uint32_t prev = _taskCount.fetch_sub(1);
+    assert(prev != 0);
+    wake_waiters();
+    if ((prev == 1) && _closed.load()) {
+        std::lock_guard<std::mutex> guard(_lock);
+        _workerCond.notify_all();
+    }
+}
+
+bool
+LockFreeExecutor::is_done() const
+{
+    return _closed.load() && (_taskCount.load() == 0);
+}
+
+bool
+LockFreeExecutor::is_synced(uint64_t target) const
+{
+    if (_queue.pop_count() < target) {
+        return false;
+    }
+    for (uint32_t i = 0; i < _numWorkers; ++i) {
+        if (_workers[i].position.load() < target) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void
+LockFreeExecutor::wait_for_room()
+{
+    std::unique_lock<std::mutex> guard(_lock);
+    _waiters.fetch_add(1);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    while (!_closed.load() && (_taskCount.load() >= _taskLimit.load(std::memory_order_relaxed))) {
+        _waiterCond.wait(guard);
+    }
+    _waiters.fetch_sub(1);
+}
+
+void
+LockFreeExecutor::wake_worker()
+{
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (_sleepers.load(std::memory_order_relaxed) != 0) {
+        std::lock_guard<std::mutex> guard(_lock);
+        _workerCond.notify_one();
+    }
+}
+
+void
+LockFreeExecutor::wake_waiters()
+{
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (_waiters.load(std::memory_order_relaxed) != 0) {
+        std::lock_guard<std::mutex> guard(_lock);
+        _waiterCond.notify_all();
+    }
+}
+
+void
+LockFreeExecutor::run()
+{
+    uint32_t id = _nextWorker.fetch_add(1);
+    assert(id < _numWorkers);
+    Worker &worker = _workers[id];
+    Task::UP task;
+    while (obtain_task(worker, task)) {
+        task->run();
+        task.reset();
+        worker.position.store(IDLE);
+        complete_task();
+    }
+}
+
+LockFreeExecutor::LockFreeExecutor(uint32_t threads, uint32_t stackSize, uint32_t taskLimit, bool blocking)
+    : LockFreeExecutor(threads, stackSize, taskLimit, blocking, unnamed_lockfree_executor)
+{
+}
+
+LockFreeExecutor::LockFreeExecutor(uint32_t threads, uint32_t stackSize, uint32_t taskLimit, bool blocking,
+                                   init_fun_t init_fun)
+    : SyncableThreadExecutor(),
+      Runnable(),
+      _queue(taskLimit),
+      _workers(std::make_unique<Worker[]>(threads)),
+      _numWorkers(threads),
+      _nextWorker(0),
+      _blocking(blocking),
+      _closed(false),
+      _taskLimit(taskLimit),
+      _taskCount(0),
+      _maxTaskCount(0),
+      _rejectedTasks(0),
+      _sleepers(0),
+      _waiters(0),
+      _lock(),
+      _workerCond(),
+      _waiterCond(),
+      _lastAccepted(0),
+      _thread_init(std::make_unique<ThreadInit>(*this, std::move(init_fun))),
+      _pool(std::make_unique<FastOS_ThreadPool>(stackSize))
+{
+    assert(threads > 0);
+    assert(taskLimit > 0);
+    for (uint32_t i = 0; i < threads; ++i) {
+        FastOS_ThreadInterface *thread = _pool->NewThread(_thread_init.get());
+        assert(thread != nullptr);
+        (void)thread;
+    }
+}
+
+LockFreeExecutor::~LockFreeExecutor()
+{
+    shutdown().sync();
+    _pool->Close();
+    assert(_taskCount.load() == 0);
+}
+
+LockFreeExecutor::Task::UP
+LockFreeExecutor::execute(Task::UP task)
+{
+    uint32_t count = _taskCount.load(std::memory_order_relaxed);
+    for (;;) {
+        if (count < _taskLimit.load(std::memory_order_relaxed)) {
+            if (_taskCount.compare_exchange_weak(count, count + 1)) {
+                break;
+            }
+        } else if (_blocking && !_closed.load(std::memory_order_relaxed)) {
+            wait_for_room();
+            count = _taskCount.load(std::memory_order_relaxed);
+        } else {
+            _rejectedTasks.fetch_add(1, std::memory_order_relaxed);
+            return task;
+        }
+    }
+    // Checked after the task is counted, so that workers never see
+    // the executor as done while a task is about to be queued.
+    if (_closed.load()) {
+        complete_task();
+        _rejectedTasks.fetch_add(1, std::memory_order_relaxed);
+        return task;
+    }
+    if (count + 1 > _maxTaskCount.load(std::memory_order_relaxed)) {
+        _maxTaskCount.store(count + 1, std::memory_order_relaxed);
+    }
+    while (!_queue.try_push(std::move(task))) {
+        // the counted task limit fits in the queue, so this only
+        // happens while a worker is still moving out of the slot.
+        std::this_thread::yield();
+    }
+    wake_worker();
+    return task;
+}
+
+LockFreeExecutor &
+LockFreeExecutor::sync()
+{
+    uint64_t target = _queue.push_count();
+    if (is_synced(target)) {
+        return *this;
+    }
+    std::unique_lock<std::mutex> guard(_lock);
+    _waiters.fetch_add(1);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    while (!is_synced(target)) {
+        _waiterCond.wait(guard);
+    }
+    _waiters.fetch_sub(1);
+    return *this;
+}
+
+LockFreeExecutor &
+LockFreeExecutor::shutdown()
+{
+    std::lock_guard<std::mutex> guard(_lock);
+    _closed.store(true);
+    _taskLimit.store(0, std::memory_order_relaxed);
+    _workerCond.notify_all();
+    _waiterCond.notify_all();
+    return *this;
+}
+
+void
+LockFreeExecutor::wait_for_task_count(uint32_t task_count)
+{
+    if (_taskCount.load() <= task_count) {
+        return;
+    }
+    std::unique_lock<std::mutex> guard(_lock);
+    _waiters.fetch_add(1);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    while (_taskCount.load() > task_count) {
+        _waiterCond.wait(guard);
+    }
+    _waiters.fetch_sub(1);
+}
+
+size_t
+LockFreeExecutor::getNumThreads() const
+{
+    return _numWorkers;
+}
+
+LockFreeExecutor::Stats
+LockFreeExecutor::getStats()
+{
+    std::lock_guard<std::mutex> guard(_lock);
+    uint64_t accepted = _queue.push_count();
+    size_t queueSize = _taskCount.load(std::memory_order_relaxed);
+    size_t maxQueueSize = std::max(queueSize, size_t(_maxTaskCount.exchange(0, std::memory_order_relaxed)));
+    Stats stats(Stats::QueueSizeT(1, queueSize, queueSize, maxQueueSize),
+                accepted - _lastAccepted, _rejectedTasks.exchange(0, std::memory_order_relaxed));
+    _lastAccepted = accepted;
+    return stats;
+}
+
+void
+LockFreeExecutor::setTaskLimit(uint32_t taskLimit)
+{
+    std::lock_guard<std::mutex> guard(_lock);
+    if (!_closed.load()) {
+        _taskLimit.store(std::min(size_t(taskLimit), _queue.capacity()), std::memory_order_relaxed);
+        _waiterCond.notify_all();
+    }
+}
+
+} // namespace vespalib
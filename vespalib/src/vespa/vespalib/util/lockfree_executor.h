@@ -0,0 +1,146 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include "threadexecutor.h"
+#include "mpmc_queue.h"
+#include "runnable.h"
+#include <condition_variable>
+#include <functional>
+#include <limits>
+#include <mutex>
+
+class FastOS_ThreadPool;
+class FastOS_Runnable;
+
+namespace vespalib {
+
+/**
+ * An executor service that executes tasks in multiple threads, like
+ * ThreadStackExecutor, but without a shared lock on the path of
+ * accepting and running tasks.
+ *
+ * Tasks are passed through a bounded lock-free queue. The number of
+ * accepted tasks is kept in an atomic counter that is checked against
+ * the task limit. Idle workers spin for a short while before parking,
+ * and producers only touch the lock to wake a parked worker. The
+ * queue is sized after the task limit, so the task limit can not be
+ * raised above the initial one.
+ *
+ * With 'blocking' set, execute() waits for room instead of rejecting
+ * the task when the task limit is reached, like
+ * BlockingThreadStackExecutor.
+ **/
+class LockFreeExecutor : public SyncableThreadExecutor,
+                         public Runnable
+{
+public:
+    using init_fun_t = std::function<int(Runnable&)>;
+
+    /**
+     * @param threads number of worker threads (concurrent tasks)
+     * @param stackSize stack size per worker thread
+     * @param taskLimit upper limit on accepted tasks, also the queue capacity
+     * @param blocking whether execute() should wait for room instead of rejecting tasks
+     **/
+    LockFreeExecutor(uint32_t threads, uint32_t stackSize, uint32_t taskLimit, bool blocking = false);
+
+    // same as above, but enables you to specify a custom function
+    // used to wrap the main loop of all worker threads
+    LockFreeExecutor(uint32_t threads, uint32_t stackSize, uint32_t taskLimit, bool blocking,
+                     init_fun_t init_fun);
+
+    LockFreeExecutor(const LockFreeExecutor &) = delete;
+    LockFreeExecutor & operator = (const LockFreeExecutor &) = delete;
+
+    /**
+     * Will invoke shutdown then sync.
+     **/
+    ~LockFreeExecutor() override;
+
+    Task::UP execute(Task::UP task) override;
+
+    /**
+     * Block until all previously accepted tasks have been executed.
+     **/
+    LockFreeExecutor &sync() override;
+
+    /**
+     * Reject all new tasks. Already accepted tasks are still executed.
+     **/
+    LockFreeExecutor &shutdown() override;
+
+    /**
+     * Block the calling thread until the current task count is equal
+     * to or lower than the given value.
+     **/
+    void wait_for_task_count(uint32_t task_count);
+
+    /**
+     * Returns the number of accepted tasks that are queued or
+     * currently being executed.
+     **/
+    size_t num_pending_tasks() const { return _taskCount.load(std::memory_order_relaxed); }
+
+    size_t getNumThreads() const override;
+
+    /**
+     * Observe and reset stats. The queue size is sampled when the stats
+     * are observed, while the max queue size is tracked as tasks are
+     * accepted.
+     **/
+    Stats getStats() override;
+
+    /**
+     * Sets a new upper limit for accepted number of tasks, capped by
+     * the queue capacity.
+     **/
+    void setTaskLimit(uint32_t taskLimit) override;
+
+private:
+    static constexpr uint64_t IDLE = std::numeric_limits<uint64_t>::max();
+    static constexpr uint32_t SPIN_ROUNDS = 256;
+
+    /**
+     * Lower bound of the queue position of the task a worker is
+     * running, or IDLE. Used by sync() to wait for tasks that have
+     * been taken out of the queue but not completed yet.
+     **/
+    struct alignas(64) Worker {
+        std::atomic<uint64_t> position;
+        Worker() : position(IDLE) {}
+    };
+
+    bool try_obtain_task(Worker &worker, Task::UP &task);
+    bool obtain_task(Worker &worker, Task::UP &task);
+    void complete_task();
+    bool is_done() const;
+    bool is_synced(uint64_t target) const;
+    void wait_for_room();
+    void wake_worker();
+    void wake_waiters();
+
+    // Runnable (all workers live here)
+    void run() override;
+
+    MpmcQueue<Task::UP>                _queue;
+    std::unique_ptr<Worker[]>          _workers;
+    const uint32_t                     _numWorkers;
+    std::atomic<uint32_t>              _nextWorker;
+    const bool                         _blocking;
+    std::atomic<bool>                  _closed;
+    std::atomic<uint32_t>              _taskLimit;
+    alignas(64) std::atomic<uint32_t> _taskCount;
+    std::atomic<uint32_t>              _maxTaskCount;
+    std::atomic<size_t>                _rejectedTasks;
+    alignas(64) std::atomic<uint32_t> _sleepers;
+    std::atomic<uint32_t>              _waiters;
+    std::mutex                         _lock;
+    std::condition_variable            _workerCond;
+    std::condition_variable            _waiterCond;
+    uint64_t                           _lastAccepted;
+    std::unique_ptr<FastOS_Runnable>   _thread_init;
+    std::unique_ptr<FastOS_ThreadPool> _pool;
+};
+
+} // namespace vespalib
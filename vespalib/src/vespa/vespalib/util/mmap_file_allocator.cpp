@@ -0,0 +1,159 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "mmap_file_allocator.h"
+#include <vespa/vespalib/io/fileutil.h>
+#include <vespa/vespalib/stllike/asciistream.h>
+#include <vespa/vespalib/util/exceptions.h>
+#include <vespa/vespalib/util/stringfmt.h>
+#include <cassert>
+#include <cinttypes>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+namespace vespalib::alloc {
+
+namespace {
+
+const size_t page_size = getpagesize();
+
+size_t round_up_to_page_size(size_t sz) {
+    return ((sz + (page_size - 1)) / page_size) * page_size;
+}
+
+}
+
+MmapFileAllocator::MmapFileAllocator(const vespalib::string& dir_name)
+    : _dir_name(dir_name),
+      _fd(-1),
+      _lock(),
+      _end_offset(0),
+      _allocations()
+{
+    mkdir(_dir_name, true);
+    vespalib::string file_name = _dir_name + "/swapfile";
+    _fd = ::open(file_name.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (_fd < 0) {
+        throw IllegalStateException(make_string("Failed to create file '%s', errno(%d)", file_name.c_str(), errno));
+    }
+    ::unlink(file_name.c_str());
+}
+
+MmapFileAllocator::~MmapFileAllocator()
+{
+    assert(_allocations.empty());
+    ::close(_fd);
+    rmdir(_dir_name, true);
+}
+
+uint64_t
+MmapFileAllocator::get_end_offset() const
+{
+    std::lock_guard guard(_lock);
+    return _end_offset;
+}
+
+size_t
+MmapFileAllocator::get_num_allocations() const
+{
+    std::lock_guard guard(_lock);
+    return _allocations.size();
+}
+
+MemoryAllocator::PtrAndSize
+MmapFileAllocator::alloc(size_t sz) const
+{
+    if (sz == 0) {
+        return PtrAndSize(nullptr, 0);
+    }
+    sz = round_up_to_page_size(sz);
+    std::lock_guard guard(_lock);
+    uint64_t offset = _end_offset;
+    if (::ftruncate(_fd, offset + sz) != 0) {
+        throw OOMException(make_string("Failed to extend file in '%s' to %" PRIu64 " bytes, errno(%d)",
+                                       _dir_name.c_str(), offset + sz, errno));
+    }
+    void *buf = ::mmap(nullptr, sz, PROT_READ | PROT_WRITE, MAP_SHARED, _fd, offset);
+    if (buf == MAP_FAILED) {
+        throw OOMException(make_string("Failed mmap of size %zu at offset %" PRIu64 " in '%s', errno(%d)",
+                                       sz, offset, _dir_name.c_str(), errno));
+    }
+    // Vectors are looked up in random order, read ahead would only pollute the page cache.
+    ::madvise(buf, sz, MADV_RANDOM);
+    _end_offset = offset + sz;
+    _allocations.emplace(buf, std::make_pair(sz, offset));
+    return PtrAndSize(buf, sz);
+}
+
+void
+MmapFileAllocator::free(PtrAndSize alloc) const
+{
+    free(alloc.first, alloc.second);
+}
+
+void
+MmapFileAllocator::free(void * ptr, size_t sz) const
+{
+    if (ptr == nullptr) {
+        return;
+    }
+    std::lock_guard guard(_lock);
+    auto itr = _allocations.find(ptr);
+    assert(itr != _allocations.end());
+    size_t alloc_size = itr->second.first;
+    uint64_t offset = itr->second.second;
+    assert(round_up_to_page_size(sz) <= alloc_size);
+    int retval = ::munmap(ptr, alloc_size);
+    assert(retval == 0);
+#ifdef __linux__
+    // Release the disk space used by the freed range.
+    ::fallocate(_fd, FALLOC_FL_PUNCH_HOLE | FALLOC_FL_KEEP_SIZE, offset, alloc_size);
+#else
+    (void) offset;
+#endif
+    _allocations.erase(itr);
+}
+
+size_t
+MmapFileAllocator::resize_inplace(PtrAndSize, size_t) const
+{
+    return 0;
+}
+
+MmapFileAllocatorFactory::MmapFileAllocatorFactory()
+    : _dir_name(),
+      _generation(0)
+{
+}
+
+MmapFileAllocatorFactory::~MmapFileAllocatorFactory() = default;
+
+void
+MmapFileAllocatorFactory::setup(const vespalib::string& dir_name)
+{
+    _dir_name = dir_name;
+    _generation = 0;
+    if (!_dir_name.empty()) {
+        rmdir(_dir_name, true);
+    }
+}
+
+std::unique_ptr<MemoryAllocator>
+MmapFileAllocatorFactory::make_memory_allocator(const vespalib::string& name)
+{
+    if (_dir_name.empty()) {
+        return {};
+    }
+    vespalib::asciistream os;
+    os << _dir_name << "/" << _generation.fetch_add(1) << "." << name;
+    return std::make_unique<MmapFileAllocator>(os.str());
+}
+
+MmapFileAllocatorFactory&
+MmapFileAllocatorFactory::instance()
+{
+    static MmapFileAllocatorFactory instance;
+    return instance;
+}
+
+}
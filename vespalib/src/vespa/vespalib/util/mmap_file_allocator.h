@@ -0,0 +1,67 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include "alloc.h"
+#include <vespa/vespalib/stllike/string.h>
+#include <atomic>
+#include <mutex>
+#include <unordered_map>
+
+namespace vespalib::alloc {
+
+/*
+ * Class handling memory allocations backed by a file. The memory is
+ * mapped with MAP_SHARED, so the page cache can write it back and
+ * drop it under memory pressure instead of keeping it resident.
+ *
+ * The file is unlinked right after it has been created, thus its disk
+ * space is released when the allocator is destroyed or the process
+ * dies. Freed ranges are punched out of the file. The allocator must
+ * not be destroyed before all its allocations have been freed.
+ */
+class MmapFileAllocator : public MemoryAllocator {
+    vespalib::string _dir_name;
+    int _fd;
+    mutable std::mutex _lock;
+    mutable uint64_t _end_offset;
+    mutable std::unordered_map<const void *, std::pair<size_t, uint64_t>> _allocations;
+
+public:
+    MmapFileAllocator(const vespalib::string& dir_name);
+    ~MmapFileAllocator() override;
+    PtrAndSize alloc(size_t sz) const override;
+    void free(PtrAndSize alloc) const override;
+    void free(void * ptr, size_t sz) const override;
+    size_t resize_inplace(PtrAndSize current, size_t newSize) const override;
+
+    // For unit test
+    uint64_t get_end_offset() const;
+    size_t get_num_allocations() const;
+};
+
+/*
+ * Factory for memory allocators backed by files, placed in a common
+ * directory which is set up once at startup. Allocators are only made
+ * when the factory has been set up.
+ */
+class MmapFileAllocatorFactory {
+    vespalib::string _dir_name;
+    std::atomic<uint64_t> _generation;
+
+    MmapFileAllocatorFactory();
+    ~MmapFileAllocatorFactory();
+    MmapFileAllocatorFactory(const MmapFileAllocatorFactory &) = delete;
+    MmapFileAllocatorFactory& operator=(const MmapFileAllocatorFactory &) = delete;
+public:
+    /*
+     * Removes any leftovers from a previous process and makes the
+     * factory place its files below the given directory.
+     */
+    void setup(const vespalib::string &dir_name);
+    std::unique_ptr<MemoryAllocator> make_memory_allocator(const vespalib::string& name);
+
+    static MmapFileAllocatorFactory& instance();
+};
+
+}
@@ -0,0 +1,108 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include "alloc.h"
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+namespace vespalib {
+
+/**
+ * Bounded lock-free multi-producer multi-consumer queue.
+ *
+ * Each slot carries a sequence number telling which lap around the
+ * ring it is ready to be written or read in, so producers only
+ * contend on the enqueue position and consumers only contend on the
+ * dequeue position (D. Vyukov's bounded MPMC queue). The capacity is
+ * rounded up to a power of 2.
+ *
+ * Both positions are updated with sequentially consistent operations,
+ * so a consumer that has read the dequeue position before a pop
+ * attempt knows that it will pop a position at or after that one.
+ **/
+template <typename T>
+class MpmcQueue
+{
+private:
+    struct Slot {
+        std::atomic<uint64_t> seq;
+        T                     value;
+        Slot() : seq(0), value() {}
+    };
+    std::unique_ptr<Slot[]>            _slots;
+    const uint64_t                     _mask;
+    alignas(64) std::atomic<uint64_t> _enqueuePos;
+    alignas(64) std::atomic<uint64_t> _dequeuePos;
+
+public:
+    explicit MpmcQueue(size_t capacity)
+        : _slots(std::make_unique<Slot[]>(roundUp2inN(capacity))),
+          _mask(roundUp2inN(capacity) - 1),
+          _enqueuePos(0),
+          _dequeuePos(0)
+    {
+        for (uint64_t i = 0; i <= _mask; ++i) {
+            _slots[i].seq.store(i, std::memory_order_relaxed);
+        }
+    }
+    MpmcQueue(const MpmcQueue &) = delete;
+    MpmcQueue & operator=(const MpmcQueue &) = delete;
+
+    size_t capacity() const { return _mask + 1; }
+
+    /**
+     * Try to add a value to the queue. The value is only moved from
+     * if this returns true. Returns false if the queue is full.
+     **/
+    bool try_push(T &&value) {
+        uint64_t pos = _enqueuePos.load(std::memory_order_relaxed);
+        for (;;) {
+            Slot &slot = _slots[pos & _mask];
+            int64_t diff = int64_t(slot.seq.load(std::memory_order_acquire)) - int64_t(pos);
+            if (diff == 0) {
+                if (_enqueuePos.compare_exchange_weak(pos, pos + 1)) {
+                    slot.value = std::move(value);
+                    slot.seq.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false;
+            } else {
+                pos = _enqueuePos.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    /**
+     * Try to take the oldest value out of the queue. Returns false if
+     * the queue is empty, or the oldest value is not completely
+     * written yet.
+     **/
+    bool try_pop(T &value) {
+        uint64_t pos = _dequeuePos.load(std::memory_order_relaxed);
+        for (;;) {
+            Slot &slot = _slots[pos & _mask];
+            int64_t diff = int64_t(slot.seq.load(std::memory_order_acquire)) - int64_t(pos + 1);
+            if (diff == 0) {
+                if (_dequeuePos.compare_exchange_weak(pos, pos + 1)) {
+                    value = std::move(slot.value);
+                    slot.seq.store(pos + _mask + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false;
+            } else {
+                pos = _dequeuePos.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    /// Number of positions claimed by producers so far.
+    uint64_t push_count() const { return _enqueuePos.load(); }
+    /// Number of positions claimed by consumers so far.
+    uint64_t pop_count() const { return _dequeuePos.load(); }
+};
+
+}
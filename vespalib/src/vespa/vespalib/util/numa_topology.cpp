@@ -0,0 +1,95 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "numa_topology.h"
+#include <fstream>
+#include <pthread.h>
+#include <sched.h>
+
+namespace vespalib {
+
+namespace {
+
+bool parseNumber(vespalib::stringref str, int &value) {
+    if (str.empty() || (str.size() > 6)) {
+        return false;
+    }
+    value = 0;
+    for (char c : str) {
+        if ((c < '0') || (c > '9')) {
+            return false;
+        }
+        value = (value * 10) + (c - '0');
+    }
+    return true;
+}
+
+vespalib::string readLine(const vespalib::string &fileName) {
+    std::ifstream file(fileName);
+    std::string line;
+    std::getline(file, line);
+    return line;
+}
+
+}
+
+NumaTopology::CpuList
+NumaTopology::parseCpuList(vespalib::stringref str)
+{
+    CpuList result;
+    while (!str.empty() && ((str[str.size() - 1] == '\n') || (str[str.size() - 1] == ' '))) {
+        str = str.substr(0, str.size() - 1);
+    }
+    while (!str.empty()) {
+        size_t end = str.find(',');
+        vespalib::stringref range = str.substr(0, end);
+        str = (end == vespalib::stringref::npos) ? vespalib::stringref() : str.substr(end + 1);
+        size_t dash = range.find('-');
+        int first = 0;
+        int last = 0;
+        if (dash == vespalib::stringref::npos) {
+            if (!parseNumber(range, first)) {
+                return CpuList();
+            }
+            last = first;
+        } else if (!parseNumber(range.substr(0, dash), first) ||
+                   !parseNumber(range.substr(dash + 1), last) || (last < first))
+        {
+            return CpuList();
+        }
+        for (int cpu = first; cpu <= last; ++cpu) {
+            result.push_back(cpu);
+        }
+    }
+    return result;
+}
+
+std::vector<NumaTopology::CpuList>
+NumaTopology::getNodeCpus(const vespalib::string &nodeDir)
+{
+    std::vector<CpuList> result;
+    for (int node : parseCpuList(readLine(nodeDir + "/online"))) {
+        CpuList cpus = parseCpuList(readLine(nodeDir + "/node" + std::to_string(node) + "/cpulist"));
+        if (!cpus.empty()) {
+            result.push_back(std::move(cpus));
+        }
+    }
+    return result;
+}
+
+bool
+NumaTopology::pinCurrentThread(const CpuList &cpus)
+{
+    if (cpus.empty()) {
+        return false;
+    }
+    cpu_set_t cpuSet;
+    CPU_ZERO(&cpuSet);
+    for (int cpu : cpus) {
+        if (cpu < CPU_SETSIZE) {
+            CPU_SET(cpu, &cpuSet);
+        }
+    }
+    return (pthread_setaffinity_np(pthread_self(), sizeof(cpuSet), &cpuSet) == 0);
+}
+
+} // namespace vespalib
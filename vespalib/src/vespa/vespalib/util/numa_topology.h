@@ -0,0 +1,40 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <vespa/vespalib/stllike/string.h>
+#include <vector>
+
+namespace vespalib {
+
+/**
+ * Simple utility used to find the CPUs belonging to each NUMA node of
+ * this host and to pin threads to them. The topology is read from
+ * sysfs; hosts where it cannot be read are treated as a single node.
+ **/
+class NumaTopology
+{
+public:
+    using CpuList = std::vector<int>;
+
+    /**
+     * Parse a cpu list on the form used by sysfs (like "0-3,8,10-11").
+     * Returns an empty list if the input is malformed.
+     **/
+    static CpuList parseCpuList(vespalib::stringref str);
+
+    /**
+     * Returns the CPUs of each online NUMA node found below the given
+     * sysfs directory. Nodes without CPUs are skipped.
+     **/
+    static std::vector<CpuList> getNodeCpus(const vespalib::string &nodeDir);
+    static std::vector<CpuList> getNodeCpus() { return getNodeCpus("/sys/devices/system/node"); }
+
+    /**
+     * Restrict the calling thread to run on the given CPUs. Returns
+     * false if the affinity could not be changed.
+     **/
+    static bool pinCurrentThread(const CpuList &cpus);
+};
+
+} // namespace vespalib
@@ -70,6 +70,9 @@ public:
      *
      * New capacity is calculated based on old capacity and grow parameters:
      * nc = oc + (oc * growPercent / 100) + growDelta.
+     *
+     * The allocator used by initialAlloc is also used when the vector
+     * is reallocated.
      **/
     RcuVectorBase(size_t initialCapacity, size_t growPercent, size_t growDelta,
                   GenerationHolderType &genHolder,
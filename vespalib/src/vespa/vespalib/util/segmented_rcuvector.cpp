@@ -0,0 +1,29 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "segmented_rcuvector.hpp"
+
+namespace vespalib {
+
+template class SegmentedRcuVectorBase<uint8_t>;
+template class SegmentedRcuVectorBase<uint16_t>;
+template class SegmentedRcuVectorBase<uint32_t>;
+template class SegmentedRcuVectorBase<int8_t>;
+template class SegmentedRcuVectorBase<int16_t>;
+template class SegmentedRcuVectorBase<int32_t>;
+template class SegmentedRcuVectorBase<int64_t>;
+template class SegmentedRcuVectorBase<float>;
+template class SegmentedRcuVectorBase<double>;
+
+template class SegmentedRcuVector<uint8_t>;
+template class SegmentedRcuVector<uint16_t>;
+template class SegmentedRcuVector<uint32_t>;
+template class SegmentedRcuVector<int8_t>;
+template class SegmentedRcuVector<int16_t>;
+template class SegmentedRcuVector<int32_t>;
+template class SegmentedRcuVector<int64_t>;
+template class SegmentedRcuVector<float>;
+template class SegmentedRcuVector<double>;
+
+template class RcuVectorHeld<alloc::Alloc>;
+
+}
@@ -0,0 +1,146 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include "rcuvector.h"
+#include <vector>
+
+namespace vespalib {
+
+/**
+ * Vector class for elements of type T using the read-copy-update
+ * mechanism, like RcuVectorBase, but storing the elements in fixed
+ * size chunks of 2^ChunkBits elements referenced from a directory.
+ *
+ * Growing the vector allocates new chunks and never copies or moves
+ * existing elements, so there is no transient doubling of memory
+ * usage and no long copy in the update thread. Only the directory
+ * (one pointer per chunk) is reallocated when it is full, and the
+ * old directory is put on hold until readers are done with it.
+ *
+ * Indexed access is O(1): one directory lookup and one chunk lookup.
+ * Elements are not contiguous, so there is no data pointer accessor.
+ **/
+template <typename T, uint32_t ChunkBits = 16>
+class SegmentedRcuVectorBase
+{
+private:
+    static_assert(std::is_trivially_destructible<T>::value,
+                  "Value type must be trivially destructible");
+    static_assert(ChunkBits < 32, "Chunk size must be less than 2^32 elements");
+
+    using Alloc = alloc::Alloc;
+protected:
+    using generation_t = GenerationHandler::generation_t;
+    using GenerationHolderType = GenerationHolder;
+public:
+    using ValueType = T;
+    static constexpr size_t CHUNK_SIZE = size_t(1) << ChunkBits;
+private:
+    static constexpr size_t CHUNK_MASK = CHUNK_SIZE - 1;
+
+    T                   **_dir;       // chunk pointers seen by readers
+    Alloc                 _dirAlloc;
+    std::vector<Alloc>    _chunks;
+    size_t                _size;
+    GenerationHolderType &_genHolder;
+
+    size_t dirCapacity() const { return _dirAlloc.size() / sizeof(T *); }
+    void addChunk();
+    void growDirectory();
+    void addChunkAndInsert(const T & v);
+    virtual void onReallocation();
+
+public:
+    SegmentedRcuVectorBase(GenerationHolderType &genHolder,
+                           const Alloc &initialAlloc = Alloc::alloc());
+
+    /**
+     * Construct a new vector with room for at least the given number
+     * of elements.  The allocator used by initialAlloc is used for
+     * all chunks and directories.
+     **/
+    SegmentedRcuVectorBase(size_t initialCapacity,
+                           GenerationHolderType &genHolder,
+                           const Alloc &initialAlloc = Alloc::alloc());
+
+    SegmentedRcuVectorBase(GrowStrategy growStrategy,
+                           GenerationHolderType &genHolder,
+                           const Alloc &initialAlloc = Alloc::alloc());
+
+    SegmentedRcuVectorBase(const SegmentedRcuVectorBase &) = delete;
+    SegmentedRcuVectorBase & operator=(const SegmentedRcuVectorBase &) = delete;
+    virtual ~SegmentedRcuVectorBase();
+
+    /**
+     * Return whether all capacity has been used.  If true the next
+     * call to push_back() will allocate a new chunk.
+     **/
+    bool isFull() const { return _size == capacity(); }
+
+    /**
+     * Return the combined memory usage for this instance.
+     **/
+    virtual MemoryUsage getMemoryUsage() const;
+
+    // vector interface
+    // no swap method, use reset() to forget old capacity and holds
+    void ensure_size(size_t n, T fill = T());
+    void reserve(size_t n) {
+        while (n > capacity()) {
+            addChunk();
+        }
+    }
+    void push_back(const T & v) {
+        if (_size < capacity()) {
+            (*this)[_size] = v;
+            ++_size;
+        } else {
+            addChunkAndInsert(v);
+        }
+    }
+
+    bool empty() const { return _size == 0; }
+    size_t size() const { return _size; }
+    size_t capacity() const { return _chunks.size() << ChunkBits; }
+    void clear() { _size = 0; }
+    T & operator[](size_t i) { return _dir[i >> ChunkBits][i & CHUNK_MASK]; }
+    const T & operator[](size_t i) const { return _dir[i >> ChunkBits][i & CHUNK_MASK]; }
+
+    void reset();
+    /**
+     * Shrink the vector to the given size, putting chunks that are no
+     * longer needed on hold.  Users must ensure that no readers use
+     * the old size afterwards.
+     **/
+    void shrink(size_t newSize) __attribute__((noinline));
+};
+
+template <typename T, uint32_t ChunkBits = 16>
+class SegmentedRcuVector : public SegmentedRcuVectorBase<T, ChunkBits>
+{
+private:
+    using generation_t         = typename SegmentedRcuVectorBase<T, ChunkBits>::generation_t;
+    using GenerationHolderType = typename SegmentedRcuVectorBase<T, ChunkBits>::GenerationHolderType;
+    generation_t         _generation;
+    GenerationHolderType _genHolderStore;
+
+    void onReallocation() override;
+
+public:
+    SegmentedRcuVector();
+    SegmentedRcuVector(size_t initialCapacity);
+    ~SegmentedRcuVector();
+
+    generation_t getGeneration() const { return _generation; }
+    void setGeneration(generation_t generation) { _generation = generation; }
+
+    /**
+     * Remove all old directories and chunks where generation < firstUsed.
+     **/
+    void removeOldGenerations(generation_t firstUsed);
+
+    MemoryUsage getMemoryUsage() const override;
+};
+
+}
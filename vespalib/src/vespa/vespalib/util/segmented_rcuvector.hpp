@@ -0,0 +1,182 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include "segmented_rcuvector.h"
+#include "rcuvector.hpp"
+#include <cstring>
+
+namespace vespalib {
+
+template <typename T, uint32_t ChunkBits>
+void
+SegmentedRcuVectorBase<T, ChunkBits>::growDirectory()
+{
+    size_t newCapacity = std::max(dirCapacity() * 2, size_t(16));
+    Alloc newDir = _dirAlloc.create(newCapacity * sizeof(T *));
+    if (!_chunks.empty()) {
+        memcpy(newDir.get(), _dir, _chunks.size() * sizeof(T *));
+    }
+    newDir.swap(_dirAlloc);
+    _dir = static_cast<T **>(_dirAlloc.get()); // atomic switch of directory
+    if (newDir.size() != 0) {
+        size_t holdSize = newDir.size();
+        GenerationHeldBase::UP hold(new RcuVectorHeld<Alloc>(holdSize, std::make_unique<Alloc>(std::move(newDir))));
+        _genHolder.hold(std::move(hold));
+        onReallocation();
+    }
+}
+
+template <typename T, uint32_t ChunkBits>
+void
+SegmentedRcuVectorBase<T, ChunkBits>::addChunk()
+{
+    if (_chunks.size() == dirCapacity()) {
+        growDirectory();
+    }
+    _chunks.push_back(_dirAlloc.create(CHUNK_SIZE * sizeof(T)));
+    _dir[_chunks.size() - 1] = static_cast<T *>(_chunks.back().get());
+}
+
+template <typename T, uint32_t ChunkBits>
+void
+SegmentedRcuVectorBase<T, ChunkBits>::addChunkAndInsert(const T & v)
+{
+    addChunk();
+    assert(_size < capacity());
+    (*this)[_size] = v;
+    ++_size;
+}
+
+template <typename T, uint32_t ChunkBits>
+void
+SegmentedRcuVectorBase<T, ChunkBits>::ensure_size(size_t n, T fill)
+{
+    reserve(n);
+    while (_size < n) {
+        (*this)[_size] = fill;
+        ++_size;
+    }
+}
+
+template <typename T, uint32_t ChunkBits>
+void
+SegmentedRcuVectorBase<T, ChunkBits>::reset()
+{
+    // Assumes no readers at this moment
+    _chunks.clear();
+    _dirAlloc = _dirAlloc.create(0);
+    _dir = nullptr;
+    _size = 0;
+}
+
+template <typename T, uint32_t ChunkBits>
+void
+SegmentedRcuVectorBase<T, ChunkBits>::shrink(size_t newSize)
+{
+    assert(newSize <= _size);
+    _size = newSize;
+    size_t wantedChunks = (newSize + CHUNK_MASK) >> ChunkBits;
+    if (wantedChunks >= _chunks.size()) {
+        return;
+    }
+    // Directory entries for the dropped chunks are left as is, readers
+    // limited by the old size might still use them until the chunks
+    // are removed from the hold list.
+    while (_chunks.size() > wantedChunks) {
+        size_t holdSize = _chunks.back().size();
+        GenerationHeldBase::UP hold(new RcuVectorHeld<Alloc>(holdSize, std::make_unique<Alloc>(std::move(_chunks.back()))));
+        _genHolder.hold(std::move(hold));
+        _chunks.pop_back();
+    }
+    onReallocation();
+}
+
+template <typename T, uint32_t ChunkBits>
+SegmentedRcuVectorBase<T, ChunkBits>::SegmentedRcuVectorBase(GenerationHolderType &genHolder,
+                                                             const Alloc &initialAlloc)
+    : SegmentedRcuVectorBase(0, genHolder, initialAlloc)
+{
+}
+
+template <typename T, uint32_t ChunkBits>
+SegmentedRcuVectorBase<T, ChunkBits>::SegmentedRcuVectorBase(size_t initialCapacity,
+                                                             GenerationHolderType &genHolder,
+                                                             const Alloc &initialAlloc)
+    : _dir(nullptr),
+      _dirAlloc(initialAlloc.create(0)),
+      _chunks(),
+      _size(0),
+      _genHolder(genHolder)
+{
+    reserve(initialCapacity);
+}
+
+template <typename T, uint32_t ChunkBits>
+SegmentedRcuVectorBase<T, ChunkBits>::SegmentedRcuVectorBase(GrowStrategy growStrategy,
+                                                             GenerationHolderType &genHolder,
+                                                             const Alloc &initialAlloc)
+    : SegmentedRcuVectorBase(growStrategy.getInitialCapacity(), genHolder, initialAlloc)
+{
+}
+
+template <typename T, uint32_t ChunkBits>
+SegmentedRcuVectorBase<T, ChunkBits>::~SegmentedRcuVectorBase() = default;
+
+template <typename T, uint32_t ChunkBits>
+MemoryUsage
+SegmentedRcuVectorBase<T, ChunkBits>::getMemoryUsage() const
+{
+    MemoryUsage retval;
+    retval.incAllocatedBytes(_chunks.size() * CHUNK_SIZE * sizeof(T) + _dirAlloc.size());
+    retval.incUsedBytes(_size * sizeof(T) + _chunks.size() * sizeof(T *));
+    return retval;
+}
+
+template <typename T, uint32_t ChunkBits>
+void
+SegmentedRcuVectorBase<T, ChunkBits>::onReallocation() { }
+
+template <typename T, uint32_t ChunkBits>
+void
+SegmentedRcuVector<T, ChunkBits>::onReallocation() {
+    _genHolderStore.transferHoldLists(_generation);
+}
+
+template <typename T, uint32_t ChunkBits>
+SegmentedRcuVector<T, ChunkBits>::SegmentedRcuVector()
+    : SegmentedRcuVectorBase<T, ChunkBits>(_genHolderStore),
+      _generation(0),
+      _genHolderStore()
+{ }
+
+template <typename T, uint32_t ChunkBits>
+SegmentedRcuVector<T, ChunkBits>::SegmentedRcuVector(size_t initialCapacity)
+    : SegmentedRcuVectorBase<T, ChunkBits>(initialCapacity, _genHolderStore),
+      _generation(0),
+      _genHolderStore()
+{ }
+
+template <typename T, uint32_t ChunkBits>
+SegmentedRcuVector<T, ChunkBits>::~SegmentedRcuVector()
+{
+    _genHolderStore.clearHoldLists();
+}
+
+template <typename T, uint32_t ChunkBits>
+void
+SegmentedRcuVector<T, ChunkBits>::removeOldGenerations(generation_t firstUsed)
+{
+    _genHolderStore.trimHoldLists(firstUsed);
+}
+
+template <typename T, uint32_t ChunkBits>
+MemoryUsage
+SegmentedRcuVector<T, ChunkBits>::getMemoryUsage() const
+{
+    MemoryUsage retval(SegmentedRcuVectorBase<T, ChunkBits>::getMemoryUsage());
+    retval.mergeGenerationHeldBytes(_genHolderStore.getHeldBytes());
+    return retval;
+}
+
+}
@@ -49,9 +49,10 @@ Runnable::UP chain(Runnable::UP first, Runnable::UP second) {
 
 //-----------------------------------------------------------------------------
 
-SimpleThreadBundle::Pool::Pool(size_t bundleSize)
+SimpleThreadBundle::Pool::Pool(size_t bundleSize, NumaTopology::CpuList cpus)
     : _lock(),
       _bundleSize(bundleSize),
+      _cpus(std::move(cpus)),
       _bundles()
 {
 }
@@ -75,7 +76,7 @@ SimpleThreadBundle::Pool::obtain()
             return ret;
         }
     }
-    return SimpleThreadBundle::UP(new SimpleThreadBundle(_bundleSize));
+    return SimpleThreadBundle::UP(new SimpleThreadBundle(_bundleSize, _cpus));
 }
 
 void
@@ -89,7 +90,13 @@ SimpleThreadBundle::Pool::release(SimpleThreadBundle::UP bundle)
 //-----------------------------------------------------------------------------
 
 SimpleThreadBundle::SimpleThreadBundle(size_t size_in, Strategy strategy)
-    : _work(),
+    : SimpleThreadBundle(size_in, NumaTopology::CpuList(), strategy)
+{
+}
+
+SimpleThreadBundle::SimpleThreadBundle(size_t size_in, NumaTopology::CpuList cpus, Strategy strategy)
+    : _cpus(std::move(cpus)),
+      _work(),
       _signals(),
       _workers(),
       _hook()
@@ -123,7 +130,7 @@ SimpleThreadBundle::SimpleThreadBundle(size_t size_in, Strategy strategy)
             _hook = std::move(hook);
         } else {
             size_t signal_idx = (strategy == USE_BROADCAST) ? 0 : (i - 1);
-            _workers.push_back(std::make_unique<Worker>(_signals[signal_idx], std::move(hook)));
+            _workers.push_back(std::make_unique<Worker>(_signals[signal_idx], std::move(hook), _cpus));
         }
     }
 }
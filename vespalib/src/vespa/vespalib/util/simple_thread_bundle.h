@@ -8,6 +8,7 @@
 #include "runnable.h"
 #include "thread_bundle.h"
 #include "noncopyable.hpp"
+#include "numa_topology.h"
 
 namespace vespalib {
 
@@ -81,6 +82,8 @@ struct Signal {
 /**
  * A ThreadBundle implementation employing a fixed set of internal
  * threads. The internal Pool class can be used to recycle bundles.
+ * The internal threads can be pinned to a set of CPUs (typically
+ * the CPUs of a single NUMA node).
  **/
 class SimpleThreadBundle : public ThreadBundle
 {
@@ -96,10 +99,11 @@ public:
     private:
         Lock _lock;
         size_t _bundleSize;
+        NumaTopology::CpuList _cpus;
         std::vector<SimpleThreadBundle*> _bundles;
 
     public:
-        Pool(size_t bundleSize);
+        Pool(size_t bundleSize, NumaTopology::CpuList cpus = NumaTopology::CpuList());
         ~Pool();
         SimpleThreadBundle::UP obtain();
         void release(SimpleThreadBundle::UP bundle);
@@ -111,16 +115,23 @@ private:
         Thread thread;
         Signal &signal;
         Runnable::UP hook;
-        Worker(Signal &s, Runnable::UP h) : thread(*this), signal(s), hook(std::move(h)) {
+        const NumaTopology::CpuList &cpus;
+        Worker(Signal &s, Runnable::UP h, const NumaTopology::CpuList &c)
+            : thread(*this), signal(s), hook(std::move(h)), cpus(c)
+        {
             thread.start();
         }
         void run() override {
+            if (!cpus.empty()) {
+                NumaTopology::pinCurrentThread(cpus);
+            }
             for (size_t gen = 0; signal.wait(gen) > 0; ) {
                 hook->run();
             }
         }
     };
 
+    NumaTopology::CpuList   _cpus;
     Work                    _work;
     std::vector<Signal>     _signals;
     std::vector<Worker::UP> _workers;
@@ -128,6 +139,7 @@ private:
 
 public:
     SimpleThreadBundle(size_t size, Strategy strategy = USE_SIGNAL_LIST);
+    SimpleThreadBundle(size_t size, NumaTopology::CpuList cpus, Strategy strategy = USE_SIGNAL_LIST);
     ~SimpleThreadBundle();
     size_t size() const override;
     void run(const std::vector<Runnable*> &targets) override;
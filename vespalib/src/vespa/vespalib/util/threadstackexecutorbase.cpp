@@ -190,6 +190,13 @@ ThreadStackExecutorBase::num_idle_workers() const
     return _workers.size();
 }
 
+size_t
+ThreadStackExecutorBase::num_pending_tasks() const
+{
+    LockGuard lock(_monitor);
+    return _taskCount;
+}
+
 ThreadStackExecutorBase::Stats
 ThreadStackExecutorBase::getStats()
 {
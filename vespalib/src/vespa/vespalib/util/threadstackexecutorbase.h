@@ -196,6 +196,12 @@ public:
      **/
     size_t num_idle_workers() const;
 
+    /**
+     * Returns the number of accepted tasks that are queued or
+     * currently being executed.
+     **/
+    size_t num_pending_tasks() const;
+
     Stats getStats() override;
 
     Task::UP execute(Task::UP task) override;
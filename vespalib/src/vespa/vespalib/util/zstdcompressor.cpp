@@ -3,9 +3,12 @@
 #include "zstdcompressor.h"
 #include <vespa/vespalib/util/alloc.h>
 #include <vespa/vespalib/util/sync.h>
+#include <vespa/vespalib/util/stringfmt.h>
 #include <zstd.h>
+#include <zdict.h>
 #include <vector>
 #include <cassert>
+#include <stdexcept>
 
 using vespalib::alloc::Alloc;
 
@@ -35,6 +38,58 @@ thread_local std::unique_ptr<DecompressContext> _tlDecompressState;
 
 }
 
+ZStdDictionary::ZStdDictionary(const vespalib::string & content)
+    : _content(content),
+      _id(ZDICT_getDictID(_content.data(), _content.size())),
+      _cdictOnce(),
+      _cdict(nullptr),
+      _ddict(ZSTD_createDDict(_content.data(), _content.size()))
+{
+    if (_ddict == nullptr) {
+        throw std::runtime_error(make_string("Failed creating zstd dictionary of %zu bytes", _content.size()));
+    }
+}
+
+ZStdDictionary::~ZStdDictionary()
+{
+    ZSTD_freeCDict(_cdict);
+    ZSTD_freeDDict(_ddict);
+}
+
+const ZSTD_CDict *
+ZStdDictionary::compressionDictionary(int compressionLevel) const
+{
+    std::call_once(_cdictOnce, [this, compressionLevel]() {
+        _cdict = ZSTD_createCDict(_content.data(), _content.size(), compressionLevel);
+    });
+    return _cdict;
+}
+
+ZStdDictionary::SP
+ZStdDictionary::train(const std::vector<ConstBufferRef> & samples, size_t maxSize)
+{
+    vespalib::string samplesBuffer;
+    std::vector<size_t> sampleSizes;
+    sampleSizes.reserve(samples.size());
+    for (const ConstBufferRef & sample : samples) {
+        samplesBuffer.append(sample.c_str(), sample.size());
+        sampleSizes.push_back(sample.size());
+    }
+    vespalib::string content(maxSize, '\0');
+    size_t sz = ZDICT_trainFromBuffer(&content[0], content.size(), samplesBuffer.data(), sampleSizes.data(), sampleSizes.size());
+    if (ZDICT_isError(sz)) {
+        return SP();
+    }
+    content.resize(sz);
+    return std::make_shared<ZStdDictionary>(content);
+}
+
+uint32_t
+ZStdDictionary::getDictionaryId(const void * input, size_t inputLen)
+{
+    return ZSTD_getDictID_fromFrame(input, inputLen);
+}
+
 size_t ZStdCompressor::adjustProcessLen(uint16_t, size_t len)   const { return ZSTD_compressBound(len); }
 
 bool
@@ -44,7 +99,10 @@ ZStdCompressor::process(const CompressionConfig& config, const void * inputV, si
     if ( ! _tlCompressState) {
         _tlCompressState = std::make_unique<CompressContext>();
     }
-    size_t sz = ZSTD_compressCCtx(_tlCompressState->get(), outputV, maxOutputLen, inputV, inputLen, config.compressionLevel);
+    size_t sz = (_dictionary != nullptr)
+        ? ZSTD_compress_usingCDict(_tlCompressState->get(), outputV, maxOutputLen, inputV, inputLen,
+                                   _dictionary->compressionDictionary(config.compressionLevel))
+        : ZSTD_compressCCtx(_tlCompressState->get(), outputV, maxOutputLen, inputV, inputLen, config.compressionLevel);
     assert( ! ZSTD_isError(sz) );
     outputLenV = sz;
     return ! ZSTD_isError(sz);
@@ -56,7 +114,16 @@ ZStdCompressor::unprocess(const void * inputV, size_t inputLen, void * outputV,
     if ( ! _tlDecompressState) {
         _tlDecompressState = std::make_unique<DecompressContext>();
     }
-    size_t sz = ZSTD_decompressDCtx(_tlDecompressState->get(), outputV, outputLenV, inputV, inputLen);
+    uint32_t dictionaryId = ZStdDictionary::getDictionaryId(inputV, inputLen);
+    if (dictionaryId != 0) {
+        if ((_dictionary == nullptr) || (_dictionary->id() != dictionaryId)) {
+            throw std::runtime_error(make_string("Missing zstd dictionary with id %u", dictionaryId));
+        }
+    }
+    size_t sz = (dictionaryId != 0)
+        ? ZSTD_decompress_usingDDict(_tlDecompressState->get(), outputV, outputLenV, inputV, inputLen,
+                                     _dictionary->decompressionDictionary())
+        : ZSTD_decompressDCtx(_tlDecompressState->get(), outputV, outputLenV, inputV, inputLen);
     assert( ! ZSTD_isError(sz) );
     outputLenV = sz;
     return ! ZSTD_isError(sz);
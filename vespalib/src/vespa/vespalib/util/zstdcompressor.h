@@ -2,16 +2,70 @@
 #pragma once
 
 #include "compressor.h"
+#include <vespa/vespalib/stllike/string.h>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+struct ZSTD_CDict_s;
+struct ZSTD_DDict_s;
 
 namespace vespalib::compression {
 
+/**
+ * A zstd dictionary, normally trained from samples of the data it will
+ * be used for. Small buffers compress a lot better when they share a
+ * dictionary than when each of them is compressed on its own. The
+ * digested dictionary used for decompression is created up front; the
+ * one used for compression is created on first use with the
+ * compression level of that use. Both are shared by all threads.
+ */
+class ZStdDictionary
+{
+public:
+    using SP = std::shared_ptr<const ZStdDictionary>;
+    explicit ZStdDictionary(const vespalib::string & content);
+    ZStdDictionary(const ZStdDictionary &) = delete;
+    ZStdDictionary & operator=(const ZStdDictionary &) = delete;
+    ~ZStdDictionary();
+
+    /**
+     * Train a dictionary of at most maxSize bytes from the given samples.
+     * Returns an empty pointer if there is not enough sample data.
+     */
+    static SP train(const std::vector<ConstBufferRef> & samples, size_t maxSize);
+    /**
+     * Returns the id of the dictionary needed to decompress the given
+     * zstd frame, or 0 if it was compressed without a dictionary.
+     */
+    static uint32_t getDictionaryId(const void * input, size_t inputLen);
+
+    const vespalib::string & content() const { return _content; }
+    uint32_t id() const { return _id; }
+    const ZSTD_CDict_s * compressionDictionary(int compressionLevel) const;
+    const ZSTD_DDict_s * decompressionDictionary() const { return _ddict; }
+private:
+    vespalib::string        _content;
+    uint32_t                _id;
+    mutable std::once_flag  _cdictOnce;
+    mutable ZSTD_CDict_s  * _cdict;
+    ZSTD_DDict_s          * _ddict;
+};
+
+/**
+ * Compressor for zstd. When given a dictionary it is used for
+ * compression, and for decompressing frames that were compressed with it.
+ */
 class ZStdCompressor : public ICompressor
 {
 public:
+    ZStdCompressor() : _dictionary(nullptr) { }
+    explicit ZStdCompressor(const ZStdDictionary * dictionary) : _dictionary(dictionary) { }
     bool process(const CompressionConfig& config, const void * input, size_t inputLen, void * output, size_t & outputLen) override;
     bool unprocess(const void * input, size_t inputLen, void * output, size_t & outputLen) override;
     size_t adjustProcessLen(uint16_t options, size_t len)   const override;
+private:
+    const ZStdDictionary * _dictionary;
 };
 
 }
-
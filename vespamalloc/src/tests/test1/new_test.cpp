@@ -1,6 +1,8 @@
 // Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 #include <vespa/vespalib/testkit/testapp.h>
 #include <vespa/log/log.h>
+#include <dlfcn.h>
+#include <vector>
 
 LOG_SETUP("new_test");
 
@@ -105,5 +107,31 @@ TEST("verify new with alignment = 64 with single element") {
     LOG(info, "&s=%p", s.get());
 }
 
+TEST("verify sampled allocations are reported when running with vespamalloc") {
+    using SetInterval = void (*)(size_t);
+    using DumpSamples = void (*)(FILE *, size_t);
+    auto setInterval = reinterpret_cast<SetInterval>(dlsym(RTLD_DEFAULT, "vespamalloc_set_sampling_interval"));
+    auto dumpSamples = reinterpret_cast<DumpSamples>(dlsym(RTLD_DEFAULT, "vespamalloc_dump_samples"));
+    if ((setInterval == nullptr) || (dumpSamples == nullptr)) {
+        LOG(info, "Not running with vespamalloc, skipping");
+        return;
+    }
+    setInterval(0x1000);
+    std::vector<std::unique_ptr<char[]>> kept;
+    for (size_t i(0); i < 1000; i++) {
+        kept.emplace_back(new char[0x100]);
+    }
+    FILE * fp = tmpfile();
+    ASSERT_TRUE(fp != nullptr);
+    dumpSamples(fp, 8);
+    setInterval(0);
+    char buf[0x400];
+    rewind(fp);
+    ASSERT_TRUE(fgets(buf, sizeof(buf), fp) != nullptr);
+    EXPECT_TRUE(strstr(buf, "Allocation sampling: interval(4096)") != nullptr);
+    EXPECT_TRUE(fgets(buf, sizeof(buf), fp) != nullptr);
+    EXPECT_TRUE(strstr(buf, "Site live(") == buf);
+    fclose(fp);
+}
 
 TEST_MAIN() { TEST_RUN_ALL(); }
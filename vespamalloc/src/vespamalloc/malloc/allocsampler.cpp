@@ -0,0 +1,197 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#include "allocsampler.h"
+#include <algorithm>
+#include <time.h>
+
+namespace vespamalloc {
+
+__thread ssize_t AllocSampler::_bytesUntilSample __attribute__((visibility("hidden"), tls_model("initial-exec"))) = 0;
+__thread bool AllocSampler::_inSample __attribute__((visibility("hidden"), tls_model("initial-exec"))) = false;
+
+const void * const AllocSampler::Tombstone = reinterpret_cast<const void *>(1);
+
+namespace {
+
+uint64_t
+hashStack(const AllocSampler::Stack * stack, size_t depth)
+{
+    uint64_t h(depth);
+    const uint64_t * raw = reinterpret_cast<const uint64_t *>(stack);
+    for (size_t i(0); i < depth; i++) {
+        h = (h ^ raw[i]) * 0x100000001b3ul;
+    }
+    return h ? h : 1;
+}
+
+}
+
+AllocSampler::AllocSampler() :
+    _interval(0),
+    _random(0x2545f4914f6cdd1dul),
+    _lastInfo(0),
+    _numSamples(0),
+    _numLostSites(0),
+    _numLostLive(0),
+    _numLive(0),
+    _mutex()
+{
+    memset(static_cast<void *>(_sites), 0, sizeof(_sites));
+    memset(static_cast<void *>(_live), 0, sizeof(_live));
+}
+
+void
+AllocSampler::setInterval(size_t interval)
+{
+    if ((interval != 0) && (_interval == 0)) {
+        // backtrace might allocate on first use when it loads the unwinder, so get that done before sampling starts.
+        Stack stack[StackDepth];
+        _inSample = true;
+        Stack::fillStack(stack, StackDepth);
+        _inSample = false;
+        _lastInfo = time(nullptr);
+    }
+    _interval = interval;
+}
+
+size_t
+AllocSampler::nextCountdown()
+{
+    // Jitter the distance between samples to avoid aliasing with periodic allocation patterns.
+    _random ^= _random >> 12;
+    _random ^= _random << 25;
+    _random ^= _random >> 27;
+    return _interval/2 + (_random * 0x2545f4914f6cdd1dul) % (_interval + 1);
+}
+
+AllocSampler::Site *
+AllocSampler::findSite(uint64_t hash, const Stack * stack, size_t depth)
+{
+    for (size_t i(0), s(hash % NumSites); i < MaxProbe; i++, s = (s + 1) % NumSites) {
+        Site & site = _sites[s];
+        if (site.hash == 0) {
+            site.hash = hash;
+            site.depth = depth;
+            std::copy(stack, stack + depth, site.stack);
+            return &site;
+        }
+        if ((site.hash == hash) && (site.depth == depth) && std::equal(stack, stack + depth, site.stack)) {
+            return &site;
+        }
+    }
+    return nullptr;
+}
+
+void
+AllocSampler::sample(const void * ptr, size_t sz)
+{
+    const bool firstInThread(_bytesUntilSample + ssize_t(sz) == 0);
+    if (_inSample || (_interval == 0)) {
+        return;
+    }
+    _inSample = true;
+    Stack stack[StackDepth];
+    size_t depth(firstInThread ? 0 : Stack::fillStack(stack, StackDepth));
+    Guard sync(_mutex);
+    _bytesUntilSample = nextCountdown();
+    if ( ! firstInThread) {
+        const size_t bytes(std::max(sz, _interval));
+        _numSamples++;
+        Site * site = findSite(hashStack(stack, depth), stack, depth);
+        if (site != nullptr) {
+            site->allocCount++;
+            site->allocBytes += bytes;
+            bool tracked(false);
+            for (size_t i(0), s(liveSlot(ptr)); !tracked && (i < MaxProbe); i++, s = (s + 1) % NumLive) {
+                Live & live = _live[s];
+                const void * old = live.ptr.load(std::memory_order_relaxed);
+                if ((old == nullptr) || (old == Tombstone)) {
+                    live.site = site - _sites;
+                    live.bytes = bytes;
+                    live.ptr.store(ptr, std::memory_order_release);
+                    _numLive.fetch_add(1, std::memory_order_relaxed);
+                    site->liveCount++;
+                    site->liveBytes += bytes;
+                    tracked = true;
+                }
+            }
+            if ( ! tracked) {
+                _numLostLive++;
+            }
+        } else {
+            _numLostSites++;
+        }
+    }
+    _inSample = false;
+}
+
+void
+AllocSampler::forget(const void * ptr)
+{
+    if (_inSample) {
+        return;
+    }
+    for (size_t i(0), s(liveSlot(ptr)); i < MaxProbe; i++, s = (s + 1) % NumLive) {
+        const void * found = _live[s].ptr.load(std::memory_order_acquire);
+        if (found == nullptr) {
+            return;
+        }
+        if (found == ptr) {
+            Guard sync(_mutex);
+            Live & live = _live[s];
+            if (live.ptr.load(std::memory_order_relaxed) == ptr) {
+                Site & site = _sites[live.site];
+                site.liveCount--;
+                site.liveBytes -= live.bytes;
+                live.ptr.store(Tombstone, std::memory_order_relaxed);
+                _numLive.fetch_sub(1, std::memory_order_relaxed);
+            }
+            return;
+        }
+    }
+}
+
+void
+AllocSampler::info(FILE * os, size_t maxSites)
+{
+    if (_interval == 0) {
+        return;
+    }
+    uint16_t order[NumSites];
+    size_t numSites(0);
+    // Symbol lookup and printing might allocate, keep that away from the sampler while holding the lock.
+    _inSample = true;
+    Guard sync(_mutex);
+    time_t now(time(nullptr));
+    double elapsed(std::max(1.0, double(now - _lastInfo)));
+    size_t liveBytes(0), allocBytes(0);
+    for (size_t i(0); i < NumSites; i++) {
+        if (_sites[i].hash != 0) {
+            order[numSites++] = i;
+            liveBytes += _sites[i].liveBytes;
+            allocBytes += _sites[i].allocBytes;
+        }
+    }
+    fprintf(os, "Allocation sampling: interval(%ld) samples(%ld) sites(%ld) live(%ld bytes in %ld samples) allocated(%ld bytes) "
+                "lostSites(%ld) lostLive(%ld)\n",
+            _interval, _numSamples, numSites, liveBytes, _numLive.load(std::memory_order_relaxed), allocBytes,
+            _numLostSites, _numLostLive);
+    std::sort(order, order + numSites, [this](uint16_t a, uint16_t b) { return _sites[a].liveBytes > _sites[b].liveBytes; });
+    for (size_t i(0); i < std::min(numSites, maxSites); i++) {
+        Site & site = _sites[order[i]];
+        fprintf(os, "Site live(%ld bytes, %ld samples) allocated(%ld bytes, %ld samples) rate(%.0f bytes/s) :",
+                site.liveBytes, site.liveCount, site.allocBytes, site.allocCount,
+                (site.allocBytes - site.allocBytesAtLastInfo)/elapsed);
+        for (size_t j(0); j < site.depth; j++) {
+            fprintf(os, " ");
+            site.stack[j].info(os);
+        }
+        fprintf(os, "\n");
+    }
+    for (size_t i(0); i < numSites; i++) {
+        _sites[order[i]].allocBytesAtLastInfo = _sites[order[i]].allocBytes;
+    }
+    _lastInfo = now;
+    _inSample = false;
+}
+
+}
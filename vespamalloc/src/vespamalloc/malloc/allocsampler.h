@@ -0,0 +1,77 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#pragma once
+
+#include <vespamalloc/malloc/common.h>
+#include <vespamalloc/util/callstack.h>
+#include <sys/types.h>
+#include <stdio.h>
+
+namespace vespamalloc {
+
+/**
+ * Samples roughly one in every 'interval' bytes allocated and records the call stack of the sampled allocation.
+ * Each sample is accounted with the number of bytes it represents, both as allocated and as live until it is freed.
+ * Intended to be cheap enough to leave on in production, the fast path is a thread local countdown.
+ * Disabled when interval is 0.
+ */
+class AllocSampler
+{
+public:
+    using Stack = StackEntry<StackReturnEntry>;
+    enum { StackDepth = 16, NumSites = 0x1000, NumLive = 0x10000, MaxProbe = 32 };
+    AllocSampler();
+    void setInterval(size_t interval) __attribute__((noinline));
+    size_t getInterval() const { return _interval; }
+    void enableThreadSupport() { _mutex.init(); }
+    void onMalloc(const void * ptr, size_t sz) {
+        if (__builtin_expect(_interval != 0, false)) {
+            _bytesUntilSample -= sz;
+            if (_bytesUntilSample < 0) {
+                sample(ptr, sz);
+            }
+        }
+    }
+    void onFree(const void * ptr) {
+        if (__builtin_expect(_numLive.load(std::memory_order_relaxed) != 0, false)) {
+            forget(ptr);
+        }
+    }
+    void info(FILE * os, size_t maxSites) __attribute__((noinline));
+private:
+    struct Site {
+        uint64_t hash;
+        size_t   depth;
+        size_t   allocCount;
+        size_t   allocBytes;
+        size_t   allocBytesAtLastInfo;
+        size_t   liveCount;
+        size_t   liveBytes;
+        Stack    stack[StackDepth];
+    };
+    struct Live {
+        std::atomic<const void *> ptr;
+        uint32_t site;
+        size_t   bytes;
+    };
+    static const void * const Tombstone;
+    void sample(const void * ptr, size_t sz) __attribute__((noinline));
+    void forget(const void * ptr) __attribute__((noinline));
+    size_t nextCountdown();
+    Site * findSite(uint64_t hash, const Stack * stack, size_t depth);
+    static size_t liveSlot(const void * ptr) { return (size_t(ptr) >> 4) * 0x9e3779b97f4a7c15ul >> 48; }
+
+    size_t               _interval;
+    uint64_t             _random;
+    time_t               _lastInfo;
+    size_t               _numSamples;
+    size_t               _numLostSites;
+    size_t               _numLostLive;
+    std::atomic<size_t>  _numLive;
+    Mutex                _mutex;
+    Site                 _sites[NumSites];
+    Live                 _live[NumLive];
+    static __thread ssize_t _bytesUntilSample __attribute__((visibility("hidden"), tls_model("initial-exec")));
+    static __thread bool    _inSample __attribute__((visibility("hidden"), tls_model("initial-exec")));
+};
+
+}
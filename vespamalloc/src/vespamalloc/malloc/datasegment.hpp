@@ -49,6 +49,7 @@ void * DataSegment<MemBlockPtrT>::getBlock(size_t & oldBlockSize, SizeClassT sc)
     size_t numBlocks((oldBlockSize + (BlockSize-1))/BlockSize);
     size_t blockSize = BlockSize * numBlocks;
     void * newBlock(NULL);
+    bool reused(false);
     {
         Guard sync(_mutex);
         newBlock = _freeList.sub(numBlocks);
@@ -76,8 +77,12 @@ void * DataSegment<MemBlockPtrT>::getBlock(size_t & oldBlockSize, SizeClassT sc)
             }
         } else {
             DEBUG(fprintf(stderr, "Reuse segment %p(%d, %d)\n", newBlock, sc, numBlocks));
+            reused = true;
         }
     }
+    if (reused) {
+        _osMemory.collapse(newBlock, blockSize);
+    }
     if (newBlock == (void *) -1) {
         newBlock = NULL;
         blockSize = 0;
@@ -230,6 +235,7 @@ void DataSegment<MemBlockPtrT>::info(FILE * os, size_t level)
 {
     fprintf(os, "Start at %p, End at %p(%p) size(%ld) partialExtension(%ld) NextLogLimit(%lx) logLevel(%ld)\n",
             _osMemory.getStart(), _osMemory.getEnd(), sbrk(0), dataSize(), _partialExtension, _nextLogLimit, level);
+    _osMemory.info(os);
     size_t numFreeBlocks(0), numAllocatedBlocks(0);
     {
         // Guard sync(_mutex);
@@ -8,6 +8,7 @@
 #include "threadpool.h"
 #include "threadlist.h"
 #include "threadproxy.h"
+#include "allocsampler.h"
 
 namespace vespamalloc {
 
@@ -49,6 +50,7 @@ public:
     }
 
     void info(FILE * os, size_t level=0) __attribute__ ((noinline));
+    void infoSamples(FILE * os, size_t maxSites) { _sampler.info(os, maxSites); }
 
     void setupSegmentLog(size_t noMemLogLevel,
                          size_t bigMemLogLevel,
@@ -67,6 +69,7 @@ public:
         _threadList.setParams(alwayReuseLimit, threadCacheLimit);
         _allocPool.setParams(alwayReuseLimit, threadCacheLimit);
     }
+    void setSamplingInterval(size_t interval) { _sampler.setInterval(interval); }
 private:
     void freeSC(void *ptr, SizeClassT sc);
     void crash() __attribute__((noinline));;
@@ -78,6 +81,7 @@ private:
     DataSegment<MemBlockPtrT>  _segment;
     AllocPool                  _allocPool;
     ThreadListT                _threadList;
+    AllocSampler               _sampler;
 };
 
 template <typename MemBlockPtrT, typename ThreadListT>
@@ -88,7 +92,8 @@ MemoryManager<MemBlockPtrT, ThreadListT>::MemoryManager(size_t logLimitAtStart)
     _prAllocLimit(logLimitAtStart),
     _segment(),
     _allocPool(_segment),
-    _threadList(_allocPool)
+    _threadList(_allocPool),
+    _sampler()
 {
     setAllocatorForThreads(this);
     initThisThread();
@@ -123,6 +128,7 @@ void MemoryManager<MemBlockPtrT, ThreadListT>::enableThreadSupport()
     _segment.enableThreadSupport();
     _allocPool.enableThreadSupport();
     _threadList.enableThreadSupport();
+    _sampler.enableThreadSupport();
 }
 
 template <typename MemBlockPtrT, typename ThreadListT>
@@ -152,6 +158,7 @@ void MemoryManager<MemBlockPtrT, ThreadListT>::info(FILE * os, size_t level)
     _segment.info(os, level);
     _allocPool.info(os, level);
     _threadList.info(os, level);
+    _sampler.info(os, 32);
     fflush(os);
 }
 
@@ -167,6 +174,7 @@ void * MemoryManager<MemBlockPtrT, ThreadListT>::malloc(size_t sz)
     }
     mem.setExact(sz);
     mem.alloc(_prAllocLimit<=mem.adjustSize(sz));
+    _sampler.onMalloc(mem.ptr(), sz);
     return mem.ptr();
 }
 
@@ -182,6 +190,7 @@ void * MemoryManager<MemBlockPtrT, ThreadListT>::malloc(size_t sz, std::align_va
     }
     mem.setExact(sz, alignment);
     mem.alloc(_prAllocLimit<=mem.adjustSize(sz, alignment));
+    _sampler.onMalloc(mem.ptr(), sz);
     return mem.ptr();
 }
 
@@ -193,6 +202,7 @@ void MemoryManager<MemBlockPtrT, ThreadListT>::freeSC(void *ptr, SizeClassT sc)
         MemBlockPtrT mem(ptr);
         mem.readjustAlignment(_segment);
         if (mem.validAlloc()) {
+            _sampler.onFree(ptr);
             mem.free();
             tp.free(mem, sc);
         } else if (mem.validFree()) {
@@ -162,6 +162,23 @@ void free(void * ptr) {
     if (ptr) { vespamalloc::_GmemP->free(ptr); }
 }
 
+/**
+ * Hooks for looking at sampled allocations from a running process, e.g. from a state handler.
+ * Resolve them with dlsym(RTLD_DEFAULT, ...) as they only exist when vespamalloc is preloaded.
+ */
+void vespamalloc_set_sampling_interval(size_t interval) __attribute__((visibility ("default")));
+void vespamalloc_set_sampling_interval(size_t interval)
+{
+    vespamalloc::createAllocator()->setSamplingInterval(interval);
+}
+
+void vespamalloc_dump_samples(FILE * os, size_t maxSites) __attribute__((visibility ("default")));
+void vespamalloc_dump_samples(FILE * os, size_t maxSites)
+{
+    vespamalloc::createAllocator()->infoSamples(os, maxSites);
+    fflush(os);
+}
+
 #define ALIAS(x) __attribute__ ((weak, alias (x), visibility ("default")))
 #ifdef __clang__
 void* __libc_malloc(size_t sz)                       __THROW __attribute__((malloc, alloc_size(1))) ALIAS("malloc");
@@ -5,9 +5,14 @@
 #include <sys/statfs.h>
 #include <sys/mman.h>
 #include <linux/mman.h>
+#include <sys/syscall.h>
 #include <algorithm>
 #include <errno.h>
 
+#ifndef MADV_COLLAPSE
+#define MADV_COLLAPSE 25
+#endif
+
 namespace vespamalloc {
 
 void *
@@ -66,12 +71,17 @@ verifyHugePagesMount(const char * mount)
 MmapMemory::MmapMemory(size_t blockSize) :
     Memory(blockSize),
     _useMAdvLimit(getBlockAlignment()*32),
+    _thpPolicy(THP_NEVER),
+    _thpLimit(getBlockAlignment()*32),
+    _thpAdvisedBytes(0),
+    _thpCollapsedBytes(0),
     _hugePagesFd(-1),
     _hugePagesOffset(0),
     _hugePageSize(0)
 {
     setupFAdvise();
     setupHugePages();
+    setupTransparentHugePages();
 }
 
 void
@@ -83,6 +93,26 @@ MmapMemory::setupFAdvise()
     }
 }
 
+void
+MmapMemory::setupTransparentHugePages()
+{
+    // never    : Leave it to the system wide THP setting.
+    // madvise  : Mark large ranges with MADV_HUGEPAGE when they are mapped, khugepaged collapses them lazily.
+    // collapse : As madvise, and also collapse already populated large ranges synchronously when they are reused.
+    const char * thp = getenv("VESPA_MALLOC_THP");
+    if (thp) {
+        if (strcmp(thp, "madvise") == 0) {
+            _thpPolicy = THP_MADVISE;
+        } else if (strcmp(thp, "collapse") == 0) {
+            _thpPolicy = THP_COLLAPSE;
+        }
+    }
+    const char * thpLimit = getenv("VESPA_MALLOC_THP_LIMIT");
+    if (thpLimit) {
+        _thpLimit = std::max(strtoul(thpLimit, nullptr, 0), getBlockAlignment());
+    }
+}
+
 void
 MmapMemory::setupHugePages()
 {
@@ -182,7 +212,80 @@ MmapMemory::getHugePages(size_t len)
 void *
 MmapMemory::getNormalPages(size_t len)
 {
-    return getBasePages(len, MAP_ANON | MAP_PRIVATE, -1, 0);
+    void * memory = getBasePages(len, MAP_ANON | MAP_PRIVATE, -1, 0);
+    if (memory != nullptr) {
+        adviseHugePages(memory, len);
+    }
+    return memory;
+}
+
+void
+MmapMemory::adviseHugePages(void * mem, size_t len)
+{
+    if ((_thpPolicy != THP_NEVER) && (_thpLimit <= len)) {
+        int prevErrno = errno;
+        if (madvise(mem, len, MADV_HUGEPAGE) == 0) {
+            _thpAdvisedBytes += len;
+        }
+        errno = prevErrno; // THP is only a hint, running without it is fine.
+    }
+}
+
+void
+MmapMemory::collapse(void * mem, size_t len)
+{
+    if ((_thpPolicy == THP_COLLAPSE) && (_thpLimit <= len)) {
+        int prevErrno = errno;
+        if (madvise(mem, len, MADV_COLLAPSE) == 0) {
+            _thpCollapsedBytes += len;
+        }
+        errno = prevErrno; // Requires linux 6.1, older kernels will just fail with EINVAL.
+    }
+}
+
+void
+MmapMemory::info(FILE * os) const
+{
+    static const char * policyNames[] = { "never", "madvise", "collapse" };
+    fprintf(os, "THP policy(%s) limit(%lx) advised(%ld) collapsed(%ld)\n",
+            policyNames[_thpPolicy], _thpLimit, _thpAdvisedBytes, _thpCollapsedBytes);
+    infoNumaNodes(os);
+}
+
+void
+MmapMemory::infoNumaNodes(FILE * os) const
+{
+    // Sample the first page of every block to see which node backs it. Pages not yet touched are counted as absent.
+    const size_t MaxNodes(64);
+    const size_t BatchSize(1024);
+    size_t perNode[MaxNodes];
+    memset(perNode, 0, sizeof(perNode));
+    size_t absent(0);
+    void * pages[BatchSize];
+    int status[BatchSize];
+    const size_t step(getBlockAlignment());
+    for (char * m(static_cast<char *>(getStart())), * e(static_cast<char *>(getEnd())); (m != nullptr) && (m < e); ) {
+        size_t count(0);
+        for (; (count < BatchSize) && (m < e); count++, m += step) {
+            pages[count] = m;
+        }
+        if (syscall(SYS_move_pages, 0, count, pages, nullptr, status, 0) != 0) {
+            return;
+        }
+        for (size_t i(0); i < count; i++) {
+            if ((status[i] >= 0) && (size_t(status[i]) < MaxNodes)) {
+                perNode[status[i]]++;
+            } else {
+                absent++;
+            }
+        }
+    }
+    for (size_t node(0); node < MaxNodes; node++) {
+        if (perNode[node]) {
+            fprintf(os, "NUMA node %ld : %ld blocks(%ld bytes)\n", node, perNode[node], perNode[node]*step);
+        }
+    }
+    fprintf(os, "NUMA absent : %ld blocks\n", absent);
 }
 
 void *
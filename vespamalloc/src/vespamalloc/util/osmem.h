@@ -7,6 +7,7 @@
 #include <cassert>
 #include <cstring>
 #include <algorithm>
+#include <cstdio>
 
 namespace vespamalloc {
 
@@ -38,13 +39,23 @@ public:
     bool release(void * mem, size_t len);
     bool reclaim(void * mem, size_t len);
     bool freeTail(void * mem, size_t len);
+    void collapse(void * mem, size_t len);
+    void info(FILE * os) const;
 private:
+    enum ThpPolicy { THP_NEVER, THP_MADVISE, THP_COLLAPSE };
     void * getHugePages(size_t len);
     void * getNormalPages(size_t len);
     void * getBasePages(size_t len, int mmapOpt, int fd, size_t offset);
     void setupFAdvise();
     void setupHugePages();
+    void setupTransparentHugePages();
+    void adviseHugePages(void * mem, size_t len);
+    void infoNumaNodes(FILE * os) const;
     size_t   _useMAdvLimit;
+    ThpPolicy _thpPolicy;
+    size_t   _thpLimit;
+    size_t   _thpAdvisedBytes;
+    size_t   _thpCollapsedBytes;
     int      _hugePagesFd;
     size_t   _hugePagesOffset;
     size_t   _hugePageSize;
@@ -537,6 +537,17 @@ TEST("utf8 substring search") {
     }
 }
 
+TEST("utf8 substring search over long mixed text") {
+    UTF8SubStringFieldSearcher fs(0);
+    // Long runs of plain ASCII mixed with upper case, separator and non-ASCII characters.
+    std::string field = "xxxxxxxxxxxxxxxxxxxx yyyyyyyyyyyyyyyyyyyy\nOperators\x01" "AND\t\xc3\x86RE overloading";
+    assertString(fs, "yyyyyyyyyyyyyyyyyyyy", field, Hits().add(1));
+    assertString(fs, "rsand", field, Hits().add(2));
+    assertString(fs, "\xc3\xa6re", field, Hits().add(3));
+    assertString(fs, "load", field, Hits().add(4));
+    assertString(fs, "xy", field, Hits());
+}
+
 TEST("utf8 substring search with empty term")
 {
     UTF8SubStringFieldSearcher fs(0);
@@ -2,6 +2,9 @@
 
 #include "utf8stringfieldsearcherbase.h"
 #include <cassert>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
 
 using search::streaming::QueryTerm;
 using search::streaming::QueryTermList;
@@ -9,6 +12,33 @@ using search::byte;
 
 namespace vsm {
 
+namespace {
+
+constexpr size_t PLAIN_ASCII_BLOCK = 16;
+
+/**
+ * Returns true if the block starting at p only contains ASCII characters
+ * that are not separator characters, so that each byte can be folded
+ * by table lookup without further checks.
+ **/
+inline bool
+isPlainAsciiBlock(const byte * p)
+{
+#ifdef __SSE2__
+    __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+    // Signed compare, so bytes >= 0x80 are caught along with control characters.
+    __m128i special = _mm_cmplt_epi8(v, _mm_set1_epi8(0x20));
+    __m128i allowed = _mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8('\n')),
+                                   _mm_cmpeq_epi8(v, _mm_set1_epi8('\t')));
+    return (_mm_movemask_epi8(_mm_andnot_si128(allowed, special)) == 0);
+#else
+    (void) p;
+    return false;
+#endif
+}
+
+}
+
 const byte *
 UTF8StringFieldSearcherBase::tokenize(const byte * p, size_t maxSz, cmptype_t * dstbuf, size_t & tokenlen)
 {
@@ -275,6 +305,12 @@ UTF8StringFieldSearcherBase::skipSeparators(const search::byte * p, size_t sz, T
     const search::byte * b(p);
 
     for(; p < e; ) {
+        if (((e - p) >= ssize_t(PLAIN_ASCII_BLOCK)) && isPlainAsciiBlock(p)) {
+            for (const search::byte * be(p + PLAIN_ASCII_BLOCK); p < be; p++) {
+                dstbuf.onCharacter(_foldCase[*p], (p - b));
+            }
+            continue;
+        }
         ucs4_t c(*p);
         const search::byte * oldP(p);
         if (c < 128) {